@@ -1,7 +1,15 @@
 #include "app_main.h"
 #include "services.h"
+#include "state_machine.h"
 #include "event_bus.h"
+#include "os_workqueue.h"
 #include "portable_log.h"
+#include "hal_rtc.h"
+#include "hal_timebase.h"
+#include "hal_power.h"
+#include "hal_clock.h"
+#include "pc_sampler.h"
+#include "bsp.h"
 
 static const char *TAG = "APP";
 
@@ -9,23 +17,58 @@ void app_init(void)
 {
     //LOG_I(TAG, "Application initializing...");
 
+    // Microsecond timebase first: events and samples are stamped with it
+    hal_rtc_init();
+    hal_timebase_init();
+
+    // RTC wakeup for tickless idle; STOP stays off until a deployment enables it
+    hal_power_init();
+
+    // Performance levels; the services loop drops to the idle level once up
+    hal_clock_init();
+
+    // Profile from here on (no-op unless built with PC_SAMPLER_ENABLE=1)
+    pc_sampler_start(PC_SAMPLER_RATE_HZ);
+
     // Initialize event bus first
     event_bus_init();
     LOG_I(TAG, "Event bus initialized");
 
+    if (event_bus_start_dispatch_task()) {
+        LOG_I(TAG, "Event dispatch task started");
+    }
+
+    // USER button presses as EVENT_BUTTON_PRESSED (wakes SLEEP)
+    BSP_Button_Init();
+
+    // Bottom halves of driver interrupts (UART service, sensor ALERTs)
+    if (os_workqueue_start()) {
+        LOG_I(TAG, "Work queue started");
+    }
+
     // Initialize services (including display service which subscribes to events)
     services_init();
     LOG_I(TAG, "Services initialized");
 
+    // Event-driven from here on (subscribes to the events of its table)
+    state_machine_init();
+
     LOG_I(TAG, "Application initialized successfully");
 }
 
+void app_wait_period(void)
+{
+    services_wait_period();
+}
+
 void app_run(void)
 {
     
     // Run services (they publish events)
     services_run();
-    // Process any pending events
-    event_bus_process();
+    // Process any pending events (unless the dispatch task delivers them)
+    if (!event_bus_is_dispatch_task_running()) {
+        event_bus_process();
+    }
     
 }
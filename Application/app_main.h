@@ -3,5 +3,6 @@
 
 void app_init(void);
 void app_run(void);
+void app_wait_period(void);
 
 #endif
@@ -1,54 +1,136 @@
 #include "state_machine.h"
 #include "config.h"
+#include "event_hsm.h"
+#include "active_object.h"
+#include "serv_current_monitor.h"
+#include "portable_log.h"
+
+static const char *TAG = "APP_SM";
+
+#define APP_SM_STACK_SIZE       1024
+#define APP_SM_QUEUE_DEPTH      8
+
+// Posted by state_machine_set_state(); private, never on the bus
+#define APP_SM_EVENT_SET_STATE  ((event_type_t)(EVENT_USER_DEFINED_START + 0))
 
 // Private variables
-static app_state_t current_state = APP_STATE_INIT;
-static app_state_t previous_state = APP_STATE_INIT;
+static hsm_t app_hsm;
+
+static void enter_state(hsm_t *hsm, const event_t *event);
+static void app_event_handler(active_object_t *ao, const event_t *event);
+
+AO_DEFINE(app_sm, "app_sm", APP_SM_STACK_SIZE, APP_SM_QUEUE_DEPTH,
+          app_event_handler, OS_PRIORITY_NORMAL);
+
+// ============================================================================
+// State Table
+// ============================================================================
+
+static const hsm_transition_t active_transitions[] = {
+    { EVENT_SENSOR_ERROR,        APP_STATE_ERROR,   NULL },
+};
+
+static const hsm_transition_t idle_transitions[] = {
+    { EVENT_MEASUREMENT_STARTED, APP_STATE_RUNNING, NULL },
+};
+
+static const hsm_transition_t running_transitions[] = {
+    { EVENT_MEASUREMENT_STOPPED, APP_STATE_IDLE,    NULL },
+};
+
+static const hsm_transition_t error_transitions[] = {
+    { EVENT_TEMPERATURE_UPDATED, APP_STATE_ACTIVE,  NULL },   // Sensor reads again
+};
+
+static const hsm_transition_t sleep_transitions[] = {
+    { EVENT_BUTTON_PRESSED,      APP_STATE_ACTIVE,  NULL },
+};
+
+#define TRANSITIONS(table)  (table), (uint8_t)(sizeof(table) / sizeof((table)[0]))
+
+static const hsm_state_t app_states[APP_STATE_COUNT] = {
+    [APP_STATE_INIT]    = { "INIT",    HSM_STATE_NONE,   HSM_STATE_NONE, enter_state, NULL, NULL, 0 },
+    [APP_STATE_ACTIVE]  = { "ACTIVE",  HSM_STATE_NONE,   APP_STATE_IDLE, NULL, NULL,
+                            TRANSITIONS(active_transitions) },
+    [APP_STATE_IDLE]    = { "IDLE",    APP_STATE_ACTIVE, HSM_STATE_NONE, enter_state, NULL,
+                            TRANSITIONS(idle_transitions) },
+    [APP_STATE_RUNNING] = { "RUNNING", APP_STATE_ACTIVE, HSM_STATE_NONE, enter_state, NULL,
+                            TRANSITIONS(running_transitions) },
+    [APP_STATE_ERROR]   = { "ERROR",   HSM_STATE_NONE,   HSM_STATE_NONE, enter_state, NULL,
+                            TRANSITIONS(error_transitions) },
+    [APP_STATE_SLEEP]   = { "SLEEP",   HSM_STATE_NONE,   HSM_STATE_NONE, enter_state, NULL,
+                            TRANSITIONS(sleep_transitions) },
+};
+
+static const hsm_def_t app_hsm_def = {
+    .states = app_states,
+    .state_count = APP_STATE_COUNT,
+    .initial = APP_STATE_INIT,
+};
+
+// ============================================================================
+// Actions
+// ============================================================================
 
 /**
- * @brief Initialize the state machine
+ * @brief Entry action of the leaf states: tag current samples with the state
+ */
+static void enter_state(hsm_t *hsm, const event_t *event)
+{
+    (void)event;
+
+    current_monitor_set_state(hsm->state);
+    LOG_I(TAG, "State %s", hsm_get_state_name(hsm, hsm->state));
+}
+
+/**
+ * @brief Active object handler: table events and set-state requests
  */
-void state_machine_init(void)
+static void app_event_handler(active_object_t *ao, const event_t *event)
 {
-    current_state = APP_STATE_INIT;
-    previous_state = APP_STATE_INIT;
+    (void)ao;
+
+    if (event->type == APP_SM_EVENT_SET_STATE) {
+        if (event->data_size == sizeof(uint8_t)) {
+            hsm_transition(&app_hsm, *(const uint8_t *)event->data);
+        }
+        return;
+    }
+
+    hsm_dispatch(&app_hsm, event);
 }
 
+// ============================================================================
+// Public API
+// ============================================================================
+
 /**
- * @brief Run the state machine (called periodically)
+ * @brief Initialize the state machine
  */
-void state_machine_run(void)
+bool state_machine_init(void)
 {
-    switch (current_state)
-    {
-        case APP_STATE_INIT:
-            // Initialization logic
-            // Transition to IDLE after init complete
-            current_state = APP_STATE_IDLE;
-            break;
-            
-        case APP_STATE_IDLE:
-            // Idle state logic
-            // Wait for events or conditions to start running
-            break;
-            
-        case APP_STATE_RUNNING:
-            // Main running state logic
-            break;
-            
-        case APP_STATE_ERROR:
-            // Error handling logic
-            break;
-            
-        case APP_STATE_SLEEP:
-            // Low-power sleep state logic
-            break;
-            
-        default:
-            // Invalid state - go to error
-            current_state = APP_STATE_ERROR;
-            break;
+    if (!hsm_init(&app_hsm, &app_hsm_def, NULL)) {
+        LOG_E(TAG, "Invalid state table");
+        return false;
+    }
+
+    // Initialization complete; before the task runs, so no race with it
+    hsm_transition(&app_hsm, APP_STATE_IDLE);
+
+    if (!ao_start(&app_sm_ao)) {
+        return false;
     }
+
+    event_type_t types[AO_MAX_SUBSCRIPTIONS];
+    uint8_t count = hsm_get_events(&app_hsm, types, AO_MAX_SUBSCRIPTIONS);
+    bool ok = (count <= AO_MAX_SUBSCRIPTIONS);
+    for (uint8_t i = 0; i < count && i < AO_MAX_SUBSCRIPTIONS; i++) {
+        ok = ao_subscribe(&app_sm_ao, types[i]) && ok;
+    }
+    if (!ok) {
+        LOG_W(TAG, "Not all state machine events subscribed");
+    }
+    return true;
 }
 
 /**
@@ -57,15 +139,27 @@ void state_machine_run(void)
  */
 app_state_t state_machine_get_state(void)
 {
-    return current_state;
+    return (app_state_t)hsm_get_state(&app_hsm);
 }
 
 /**
  * @brief Set new state
  * @param new_state New application state to transition to
  */
-void state_machine_set_state(app_state_t new_state)
+bool state_machine_set_state(app_state_t new_state)
+{
+    if (new_state >= APP_STATE_COUNT) {
+        return false;
+    }
+
+    uint8_t target = (uint8_t)new_state;
+    return ao_post(&app_sm_ao, APP_SM_EVENT_SET_STATE, &target, sizeof(target));
+}
+
+/**
+ * @brief Get the state machine's queue and handler statistics
+ */
+void state_machine_get_stats(ao_stats_t *stats)
 {
-    previous_state = current_state;
-    current_state = new_state;
+    ao_get_stats(&app_sm_ao, stats);
 }
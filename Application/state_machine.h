@@ -2,27 +2,62 @@
 #define STATE_MACHINE_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "active_object.h"
 
 /**
  * @file state_machine.h
  * @brief Application state machine for business logic
  * 
- * This module manages the main application states and transitions.
+ * This module manages the main application states and transitions. The
+ * states and their transitions are a const table run by the event HSM
+ * (OS/event_hsm.h); transitions are driven by event bus events:
+ *
+ *   ACTIVE (composite, starts in IDLE)
+ *     IDLE     EVENT_MEASUREMENT_STARTED -> RUNNING
+ *     RUNNING  EVENT_MEASUREMENT_STOPPED -> IDLE
+ *     any      EVENT_SENSOR_ERROR        -> ERROR
+ *   ERROR      EVENT_TEMPERATURE_UPDATED -> ACTIVE (IDLE)
+ *   SLEEP      EVENT_BUTTON_PRESSED      -> ACTIVE (IDLE)
+ *
+ * Entering a state tags the current monitor's samples with it
+ * (current_monitor_set_state()).
+ *
+ * The machine is an active object (OS/active_object.h): the bus only
+ * queues its events, and its own task runs the transitions, so slow entry
+ * actions do not hold up the other subscribers.
  */
 
-// Application States
+// Application States (values are recorded with each current sample)
 typedef enum {
     APP_STATE_INIT,
     APP_STATE_IDLE,
     APP_STATE_RUNNING,
     APP_STATE_ERROR,
-    APP_STATE_SLEEP
+    APP_STATE_SLEEP,
+    APP_STATE_ACTIVE,       // Parent of IDLE and RUNNING; never current itself
+    APP_STATE_COUNT
 } app_state_t;
 
 // State Machine Functions
-void state_machine_init(void);
-void state_machine_run(void);
+
+/**
+ * @brief Enter INIT, move on to IDLE, then start the task and subscribe it
+ *        to the table's events
+ *
+ * Call after event_bus_init() and services_init().
+ */
+bool state_machine_init(void);
 app_state_t state_machine_get_state(void);
-void state_machine_set_state(app_state_t new_state);
+
+/**
+ * @brief Force a transition (exit/entry actions run as for an event)
+ * @note ASYNCHRONOUS: queued to the state machine task, in order with the
+ *       table's events; state_machine_get_state() changes once it ran
+ * @return false if new_state is out of range or the queue is full
+ */
+bool state_machine_set_state(app_state_t new_state);
+
+void state_machine_get_stats(ao_stats_t *stats);
 
 #endif // STATE_MACHINE_H
@@ -52,7 +52,7 @@
   #include <stdint.h>
   extern uint32_t SystemCoreClock;
 #endif
-#define configENABLE_FPU                         0
+#define configENABLE_FPU                         1
 #define configENABLE_MPU                         0
 
 #define configUSE_PREEMPTION                     1
@@ -64,7 +64,7 @@
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 56 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
-#define configTOTAL_HEAP_SIZE                    ((size_t)65536)
+#define configTOTAL_HEAP_SIZE                    ((size_t)65536) /* Unused: os_heap.c is the heap, regions in main.c */
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
 #define configUSE_16_BIT_TICKS                   0
@@ -162,16 +162,48 @@ standard names. */
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
 
+// Hardware floating point. The ARM_CM7 port enables the FPU and lazy context
+// stacking (FPCCR ASPEN|LSPEN) in xPortStartScheduler(), so a task only
+// gets the extended 17-word frame saved once it has used an FP instruction.
+// That requires a hard-float build with the double-precision FPv5-D16 unit
+// (cmake/gcc-arm-none-eabi.cmake: -mfpu=fpv5-d16 -mfloat-abi=hard); catch a
+// soft-float or single-precision toolchain file here rather than in libgcc.
+#if defined(__GNUC__) && defined(__arm__) && (!defined(__ARM_PCS_VFP) || !defined(__ARM_FP) || !(__ARM_FP & 0x8))
+  #error "Build with -mcpu=cortex-m7 -mfpu=fpv5-d16 -mfloat-abi=hard"
+#endif
+
 // Performance monitoring features
 #define configUSE_STATS_FORMATTING_FUNCTIONS     1
 #define INCLUDE_xTaskGetIdleTaskHandle           1
 #define INCLUDE_pxTaskGetStackStart              1
 
-// Runtime statistics - disabled for now (SystemView provides same info)
-// Can be enabled later for production monitoring without debugger attached
-//#define configGENERATE_RUN_TIME_STATS            1
-//#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() // Already initialized in main.c
-//#define portGET_RUN_TIME_COUNTER_VALUE()         DWT->CYCCNT
+// Queue sets (os_queue_set_*): tasks with several inputs block on all of
+// them at once. Costs a set check on every queue and semaphore send.
+#define configUSE_QUEUE_SETS                     1
+
+// Runtime statistics on the TIM5 microsecond counter (1000x the tick rate).
+// Kernel V10.2 keeps 32-bit counters, so cumulative totals wrap after ~71
+// minutes (DWT->CYCCNT would wrap every 36 s); performance_monitor reports
+// deltas over sample windows, which are unaffected.
+extern _Bool hal_timer_init(void);
+extern uint32_t hal_timer_get_us(void);
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() hal_timer_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()         hal_timer_get_us()
+
+// Tickless idle (OS/os_power.c): with no task due, the idle task stops the
+// SysTick and sleeps on the RTC wakeup timer (SLEEP, or STOP once
+// hal_power_set_stop_enabled(true)). Build with OS_TICKLESS_IDLE=0 for the
+// plain 1 kHz tick, e.g. when a debugger must stay attached through STOP.
+#ifndef OS_TICKLESS_IDLE
+#define OS_TICKLESS_IDLE                         1
+#endif
+#if OS_TICKLESS_IDLE
+extern void os_power_suppress_ticks_and_sleep(uint32_t expected_idle_ticks);
+#define configUSE_TICKLESS_IDLE                  2
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP    2
+#define portSUPPRESS_TICKS_AND_SLEEP( x )        os_power_suppress_ticks_and_sleep( x )
+#endif
 
 // SEGGER SystemView integration
 // This must be at the end of FreeRTOSConfig.h to override trace macros
@@ -6,12 +6,19 @@
  * - Task execution and timing
  * - Stack usage per task
  * - Heap memory consumption
- * - CPU load
+ * - CPU load, overall and per task
+ * 
+ * CPU time comes from the FreeRTOS run-time counters (TIM5 microseconds,
+ * see FreeRTOSConfig.h). perf_runtime_sample() records them every
+ * PERF_SAMPLE_PERIOD_MS; shares are computed from the deltas of the last
+ * interval and of a sliding window of PERF_WINDOW_SAMPLES intervals.
  * 
  * Usage:
  * 1. Enable USE_PERFORMANCE_MONITOR in your build
  * 2. Call perf_print_full_report() periodically or on demand
- * 3. Or create automatic monitoring task with perf_create_monitor_task()
+ * 3. Or create automatic monitoring task with perf_create_monitor_task(),
+ *    which also takes the runtime samples
+ * 4. Read numbers with perf_get_runtime_snapshot()
  */
 
 #ifndef PERFORMANCE_MONITOR_H
@@ -30,8 +37,149 @@ extern "C" {
 #define USE_PERFORMANCE_MONITOR 1
 #endif
 
+// ============================================================================
+// Binary snapshot (wire format of CMD_GET_PERF)
+// ============================================================================
+
+#define PERF_SNAPSHOT_VERSION       2
+#define PERF_SNAPSHOT_MAX_TASKS     12      // Keeps the snapshot in one protocol frame
+#define PERF_SNAPSHOT_NAME_LEN      8       // Task names are truncated, not terminated
+
+/** One task; cpu shares are of the last sample window, in 1/1000 */
+typedef struct {
+    char     name[PERF_SNAPSHOT_NAME_LEN];
+    uint16_t stack_high_water;      /**< Words never used */
+    uint16_t cpu_permille;
+} __attribute__((packed)) perf_snapshot_task_t;
+
+/**
+ * System metrics in one fixed-layout, little-endian struct
+ *
+ * Only the first task_count entries of tasks[] are valid; the protocol
+ * sends PERF_SNAPSHOT_SIZE(task_count) bytes.
+ */
+typedef struct {
+    uint8_t  version;               /**< PERF_SNAPSHOT_VERSION */
+    uint8_t  task_count;            /**< Valid entries in tasks[] */
+    uint8_t  tasks_total;           /**< Tasks in the system (may exceed task_count) */
+    uint8_t  reserved;
+    uint32_t uptime_ms;
+    // Heap
+    uint32_t heap_free;
+    uint32_t heap_min_free;
+    // CPU load, 0 until two runtime samples were taken
+    uint16_t cpu_load_interval_permille;
+    uint16_t cpu_load_window_permille;
+    uint32_t cpu_window_ms;
+    // Event bus
+    uint32_t events_published;
+    uint32_t events_publish_failed;
+    uint32_t events_processed;
+    uint32_t events_queue_overflow;
+    uint32_t events_isr_publish_failed;
+    uint32_t events_coalesced;
+    uint16_t events_max_queue_depth;
+    uint16_t events_timer_failed;
+    // Host link (esp32_packet_framing)
+    uint32_t uart_packets_sent;
+    uint32_t uart_packets_received;
+    uint32_t uart_crc_errors;
+    uint32_t uart_framing_errors;
+    uint32_t uart_overflow_errors;
+    uint32_t uart_timeout_errors;
+    // ISR counters (hal_uart)
+    uint32_t isr_uart_idle;
+    uint32_t isr_uart_dma_half;
+    uint32_t isr_uart_dma_complete;
+    uint32_t isr_uart_rx_timeout;
+    uint32_t isr_uart_char_match;
+    uint32_t uart_rx_hw_overruns;
+    uint32_t uart_rx_dma_overruns;
+    uint32_t uart_rx_dropped_bytes;
+    uint32_t uart_rx_high_water;
+    perf_snapshot_task_t tasks[PERF_SNAPSHOT_MAX_TASKS];
+} __attribute__((packed)) perf_snapshot_t;
+
+#define PERF_SNAPSHOT_SIZE(task_count) \
+    (sizeof(perf_snapshot_t) - sizeof(perf_snapshot_task_t) * (PERF_SNAPSHOT_MAX_TASKS - (task_count)))
+
 #ifdef USE_PERFORMANCE_MONITOR
 
+// Runtime statistics sampling
+#define PERF_SAMPLE_PERIOD_MS       1000    // One interval
+#define PERF_WINDOW_SAMPLES         10      // Sliding window, in intervals
+#define PERF_MAX_TASKS              20      // Tasks tracked (uxTaskGetSystemState fails beyond)
+
+// Stack tuning: least free stack per task name over the whole run
+#ifndef PERF_STACK_TUNING
+#define PERF_STACK_TUNING           1
+#endif
+#define PERF_STACK_TRACK_SLOTS      24      // Names remembered, deleted tasks included
+#define PERF_STACK_MARGIN_PERCENT   25      // Recommended size: used + 25%...
+#define PERF_STACK_MIN_SLACK_BYTES  256     // ...but at least this much on top
+#define PERF_STACK_ROUND_BYTES      64
+
+/**
+ * @brief CPU time of one task
+ */
+typedef struct {
+    char name[configMAX_TASK_NAME_LEN];
+    UBaseType_t task_number;
+    eTaskState state;
+    UBaseType_t priority;
+    UBaseType_t stack_high_water;   /**< Words */
+    uint32_t interval_us;           /**< Run time in the last interval */
+    uint32_t window_us;             /**< Run time in the window */
+    uint16_t interval_permille;     /**< Share of the last interval, 0..1000 */
+    uint16_t window_permille;       /**< Share of the window, 0..1000 */
+} perf_task_runtime_t;
+
+/**
+ * @brief Runtime statistics as of the last sample
+ */
+typedef struct {
+    uint32_t sample_count;          /**< Samples taken so far */
+    uint32_t timestamp_us;          /**< Run-time counter at the sample */
+    uint32_t interval_us;           /**< Length of the last interval */
+    uint32_t window_us;             /**< Length of the window (shorter until it fills) */
+    uint16_t cpu_load_interval_permille;  /**< 1000 minus the idle task's share */
+    uint16_t cpu_load_window_permille;
+    uint32_t task_count;
+    perf_task_runtime_t tasks[PERF_MAX_TASKS];
+} perf_runtime_snapshot_t;
+
+/**
+ * @brief Record the run-time counters of all tasks
+ * 
+ * Call every PERF_SAMPLE_PERIOD_MS from one task (the monitor task does).
+ * Intervals are measured, so a late sample only lengthens its interval.
+ * Requires: configGENERATE_RUN_TIME_STATS = 1
+ * 
+ * @return pdPASS, or pdFAIL if more than PERF_MAX_TASKS tasks exist
+ */
+BaseType_t perf_runtime_sample(void);
+
+/**
+ * @brief Copy the statistics of the last sample
+ * 
+ * @param snapshot Output
+ * @return pdPASS, or pdFAIL until two samples have been taken
+ */
+BaseType_t perf_get_runtime_snapshot(perf_runtime_snapshot_t *snapshot);
+
+/**
+ * @brief Fill the binary metrics snapshot
+ * 
+ * Cheap enough to poll: no formatting, no allocation. Tasks, their stack
+ * high-water marks and CPU shares are those of the last
+ * perf_runtime_sample() (none before two samples), at most
+ * PERF_SNAPSHOT_MAX_TASKS of them.
+ * 
+ * @param snapshot Output
+ * @return pdPASS, or pdFAIL if snapshot is NULL
+ */
+BaseType_t perf_get_snapshot(perf_snapshot_t *snapshot);
+
 /**
  * @brief Print information about all tasks in the system
  * 
@@ -43,7 +191,8 @@ void perf_print_task_list(void);
 /**
  * @brief Print runtime statistics for all tasks
  * 
- * Shows percentage of CPU time each task has consumed.
+ * Shows each task's share of CPU time over the last interval and the
+ * sliding window, from the last perf_runtime_sample().
  * Requires: configGENERATE_RUN_TIME_STATS = 1
  */
 void perf_print_runtime_stats(void);
@@ -74,6 +223,39 @@ void perf_check_all_task_stacks(void);
  */
 UBaseType_t perf_check_task_stack(TaskHandle_t task_handle);
 
+/**
+ * @brief Print recommended stack sizes from the soak so far
+ * 
+ * perf_runtime_sample() keeps, per task name, the least free stack ever
+ * seen, so a task that is deleted and created again (stream, bulk) keeps
+ * its worst case. Sizes come from os_task_get_info(). The recommendation
+ * is the worst use plus PERF_STACK_MARGIN_PERCENT, at least
+ * PERF_STACK_MIN_SLACK_BYTES, rounded up to PERF_STACK_ROUND_BYTES. Lines
+ * start with "stack <name>:" for tools/stack_report.py --log, which puts
+ * them next to the static -fstack-usage worst case.
+ * Requires: PERF_STACK_TUNING = 1 and configGENERATE_RUN_TIME_STATS = 1
+ */
+void perf_print_stack_recommendations(void);
+
+/**
+ * @brief Print event bus latency histograms
+ * 
+ * Shows, per event type, publish->dispatch time and per-callback run time
+ * as log2 histograms plus worst case and the slowest callback address.
+ * Requires: EVENT_BUS_LATENCY_HISTOGRAMS = 1
+ */
+void perf_print_event_latency(void);
+
+/**
+ * @brief Print energy per task and per app state
+ * 
+ * Integrates the buffered current monitor samples (current_monitor_energy_by())
+ * of the last completed measurement; tasks are named from the current
+ * run-time stats.
+ * Requires: CURRENT_MONITOR_TASK_TAGS = 1 for the per-task part
+ */
+void perf_print_energy_report(void);
+
 /**
  * @brief Print comprehensive performance report
  * 
@@ -83,9 +265,9 @@ UBaseType_t perf_check_task_stack(TaskHandle_t task_handle);
 void perf_print_full_report(void);
 
 /**
- * @brief Get approximate CPU load percentage
+ * @brief Get CPU load percentage over the last sample interval
  * 
- * @return CPU load percentage (0-100)
+ * @return CPU load percentage (0-100), 0 until two samples were taken
  * 
  * Requires: configGENERATE_RUN_TIME_STATS = 1 and
  *           INCLUDE_xTaskGetIdleTaskHandle = 1
@@ -105,7 +287,8 @@ void perf_monitor_task(void *pvParameters);
 /**
  * @brief Create the performance monitoring task
  * 
- * Creates a low-priority task that periodically prints performance reports.
+ * Creates a low-priority task that takes a runtime sample every
+ * PERF_SAMPLE_PERIOD_MS and prints a performance report every 10 seconds.
  * 
  * Example usage in main():
  * @code
@@ -134,11 +317,17 @@ BaseType_t perf_create_monitor_task(UBaseType_t priority);
 #else // !USE_PERFORMANCE_MONITOR
 
 // Stub functions when performance monitoring is disabled
+#define perf_runtime_sample()           (pdFAIL)
+#define perf_get_runtime_snapshot(s)    (pdFAIL)
+#define perf_get_snapshot(s)            (pdFAIL)
 #define perf_print_task_list()          do {} while(0)
 #define perf_print_runtime_stats()      do {} while(0)
 #define perf_print_heap_info()          do {} while(0)
 #define perf_check_all_task_stacks()    do {} while(0)
+#define perf_print_stack_recommendations() do {} while(0)
 #define perf_check_task_stack(h)        (0)
+#define perf_print_event_latency()      do {} while(0)
+#define perf_print_energy_report()      do {} while(0)
 #define perf_print_full_report()        do {} while(0)
 #define perf_get_cpu_load_percent()     (0)
 #define perf_create_monitor_task(p)     (pdFAIL)
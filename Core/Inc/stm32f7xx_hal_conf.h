@@ -148,8 +148,11 @@
 #define  VDD_VALUE                    3300U /*!< Value of VDD in mv */
 #define  TICK_INT_PRIORITY            ((uint32_t)15U) /*!< tick interrupt priority */
 #define  USE_RTOS                     0U
-#define  PREFETCH_ENABLE              0U
-#define  ART_ACCELERATOR_ENABLE        0U /* To enable instruction cache and prefetch */
+/* ART and prefetch serve flash fetches over the ITCM interface (0x00200000).
+   The image runs from the AXIM alias behind the L1 caches; the hot paths are
+   copied to ITCM RAM (HAL_ITCM_FUNC, .itcm_text in STM32F767XX_FLASH.ld) */
+#define  PREFETCH_ENABLE              1U
+#define  ART_ACCELERATOR_ENABLE        1U /* To enable instruction cache and prefetch */
 
 #define  USE_HAL_ADC_REGISTER_CALLBACKS         0U /* ADC register callback disabled       */
 #define  USE_HAL_CAN_REGISTER_CALLBACKS         0U /* CAN register callback disabled       */
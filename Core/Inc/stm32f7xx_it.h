@@ -57,6 +57,23 @@ void DMA1_Stream6_IRQHandler(void);
 void USART2_IRQHandler(void);
 void TIM6_DAC_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void EXTI0_IRQHandler(void);
+void EXTI1_IRQHandler(void);
+void EXTI2_IRQHandler(void);
+void EXTI3_IRQHandler(void);
+void EXTI4_IRQHandler(void);
+void EXTI9_5_IRQHandler(void);
+void EXTI15_10_IRQHandler(void);
+void I2C2_EV_IRQHandler(void);
+void I2C2_ER_IRQHandler(void);
+void I2C4_EV_IRQHandler(void);
+void I2C4_ER_IRQHandler(void);
+void TIM5_IRQHandler(void);
+void DMA2_Stream1_IRQHandler(void);
+void SPI4_IRQHandler(void);
+void DMA2_Stream3_IRQHandler(void);
+void SPI1_IRQHandler(void);
+void OTG_FS_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -0,0 +1,25 @@
+/**
+ * @file sysmem.h
+ * @brief C library heap routed to the FreeRTOS heap (sysmem.c)
+ */
+
+#ifndef SYSMEM_H
+#define SYSMEM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct {
+    size_t in_use_bytes;        // Requested by malloc() callers, now
+    size_t peak_bytes;
+    uint32_t alloc_count;
+    uint32_t free_count;
+    uint32_t fail_count;
+} sysmem_malloc_stats_t;
+
+/**
+ * @brief Usage of malloc() and friends (their blocks are part of the FreeRTOS heap)
+ */
+void sysmem_get_malloc_stats(sysmem_malloc_stats_t *stats);
+
+#endif // SYSMEM_H
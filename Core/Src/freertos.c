@@ -85,6 +85,33 @@ void vApplicationMallocFailedHook(void)
 
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
-
+/**
+ * @brief HAL_Delay() that sleeps when it can (overrides the weak HAL one)
+ *
+ * Driver power-up and reset delays (ST7735 command list, AHT25 warm-up)
+ * then leave the CPU to other tasks, so inits on the boot workers overlap.
+ * Before the scheduler runs, in ISRs and with interrupts masked it spins
+ * on the HAL tick as the HAL version does.
+ */
+void HAL_Delay(uint32_t Delay)
+{
+  if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING && __get_IPSR() == 0U &&
+      __get_PRIMASK() == 0U && __get_BASEPRI() == 0U)
+  {
+    /* One more tick: vTaskDelay(n) may return just after a tick boundary */
+    vTaskDelay(pdMS_TO_TICKS(Delay) + 1U);
+    return;
+  }
+
+  uint32_t tickstart = HAL_GetTick();
+  uint32_t wait = Delay;
+  if (wait < HAL_MAX_DELAY)
+  {
+    wait += (uint32_t)(uwTickFreq);
+  }
+  while ((HAL_GetTick() - tickstart) < wait)
+  {
+  }
+}
 /* USER CODE END Application */
 
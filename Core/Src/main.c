@@ -24,8 +24,15 @@
 /* USER CODE BEGIN Includes */
 #include "app_main.h"
 #include "os_wrapper.h"
+#include "hal_mem.h"
+#include "os_heap.h"
+#include "os_boot.h"
 #include "SEGGER_SYSVIEW.h"
+#include "sysview_trace.h"
 #include "SEGGER_RTT.h"
+#include "pinout.h"
+#include "hal_gpio.h"
+#include "hal_i2c.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -64,7 +71,16 @@ const osThreadAttr_t defaultTask_attributes = {
   .priority = (osPriority_t) osPriorityNormal,
 };
 /* USER CODE BEGIN PV */
+// Heap regions (os_heap.h), shared by the kernel (FAST first) and malloc()
+// (BULK first). Together the 64 KB heap_4 had, plus the SRAM2 tail
+#define APP_HEAP_FAST_SIZE  (16U * 1024U)   // DTCM: task stacks, queues, event pools
+#define APP_HEAP_BULK_SIZE  (48U * 1024U)   // SRAM1: capture buffers, overflow
 
+static uint8_t app_heap_fast[APP_HEAP_FAST_SIZE] HAL_DTCM_BSS __attribute__((aligned(OS_HEAP_ALIGN)));
+static uint8_t app_heap_bulk[APP_HEAP_BULK_SIZE] __attribute__((aligned(OS_HEAP_ALIGN)));
+
+// End of the .dma_buffer section: SRAM2 above it is unused
+extern uint8_t __dma_buffer_end[];
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -95,7 +111,15 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
-
+  // Load ITCM code and DTCM data before anything can use them
+  hal_mem_init_tcm();
+
+  // DTCM is cleared now; the regions must be in place before the first
+  // pvPortMalloc(). The SRAM2 tail is non-cacheable: fine for DMA capture
+  os_heap_add_region(OS_HEAP_FAST, app_heap_fast, sizeof(app_heap_fast));
+  os_heap_add_region(OS_HEAP_BULK, app_heap_bulk, sizeof(app_heap_bulk));
+  os_heap_add_region(OS_HEAP_BULK, __dma_buffer_end,
+                     (HAL_DMA_REGION_BASE + HAL_DMA_REGION_SIZE) - (uintptr_t)__dma_buffer_end);
   /* USER CODE END 1 */
 
   /* MPU Configuration--------------------------------------------------------*/
@@ -107,17 +131,19 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-
+  // Map the .dma_buffer section as non-cacheable (MPU region 1), then enable caches
+  hal_mem_init_dma_region();
+  hal_mem_enable_caches();
   /* USER CODE END Init */
 
   /* Configure the system clock */
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
-  SEGGER_RTT_WriteString(0, "=== Clock configured to 216MHz (8MHz HSE) ===\n");
+  SEGGER_RTT_WriteString(0, "=== Clock configured to 120MHz (8MHz HSE) ===\n");
 
   // CRITICAL: Reinitialize HAL tick timer after clock config
-  // HAL_Init() configured TIM6 at 16MHz, but now we're at 216MHz
+  // HAL_Init() configured TIM6 at 16MHz, but now we're at 120MHz
   HAL_InitTick(TICK_INT_PRIORITY);
 
   SEGGER_RTT_printf(0, "HAL tick reinitialized successfully\n");
@@ -126,6 +152,7 @@ int main(void)
   CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
   DWT->CYCCNT = 0;
   DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  os_boot_mark("clock");
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
@@ -137,6 +164,7 @@ int main(void)
   MX_RTC_Init();
   MX_USART2_UART_Init();
   /* USER CODE BEGIN 2 */
+  os_boot_mark("peripherals");
   SEGGER_RTT_WriteString(0, "\n=== STM32F767 Application Starting ===\n");
   SEGGER_RTT_printf(0, "System Clock: %lu Hz\n", HAL_RCC_GetSysClockFreq());
   SEGGER_RTT_printf(0, "HAL Tick: %lu ms\n", HAL_GetTick());
@@ -162,6 +190,7 @@ int main(void)
   // Initialize SEGGER SystemView configuration (recording starts after scheduler)
 #if USE_SEGGER_SYSTEMVIEW
   SEGGER_SYSVIEW_Conf();
+  sysview_trace_init();
   SEGGER_RTT_WriteString(0, "SEGGER SystemView configured (will start after scheduler init)\n");
 #else
   SEGGER_RTT_WriteString(0, "SEGGER SystemView: Disabled\n");
@@ -199,6 +228,7 @@ int main(void)
 
   /* USER CODE BEGIN RTOS_EVENTS */
   /* add events, ... */
+  os_boot_mark("kernel start");
   /* USER CODE END RTOS_EVENTS */
 
   /* Start scheduler */
@@ -546,7 +576,15 @@ static void MX_GPIO_Init(void)
   HAL_GPIO_Init(temperature_sensor_on_off_GPIO_Port, &GPIO_InitStruct);
 
   /* USER CODE BEGIN MX_GPIO_Init_2 */
+  // INA226 ALERT (open-drain, active low): conversion-ready interrupt
+  __HAL_RCC_GPIOB_CLK_ENABLE();
+  GPIO_InitStruct.Pin = INA226_ALERT_PIN;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
+  GPIO_InitStruct.Pull = GPIO_PULLUP;
+  HAL_GPIO_Init(INA226_ALERT_PORT, &GPIO_InitStruct);
 
+  HAL_NVIC_SetPriority(EXTI15_10_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
 
   /* USER CODE END MX_GPIO_Init_2 */
 }
@@ -578,10 +616,12 @@ void StartDefaultTask(void *argument)
 
   /* Initialize OS wrapper */
   os_init();
+  os_task_note_info(NULL, StartDefaultTask, defaultTask_attributes.stack_size);
 
   /* Initialize application AFTER FreeRTOS scheduler is running
    * This is critical because app_init() creates FreeRTOS tasks/queues via UART driver init */
   SEGGER_RTT_WriteString(0, "Initializing application (post-scheduler)...\n");
+  os_boot_mark("default task");
   app_init();
   SEGGER_RTT_WriteString(0, "Application initialized successfully\n");
 
@@ -590,8 +630,8 @@ void StartDefaultTask(void *argument)
   {
     /* Run your application logic here */
     app_run();
-    /* Small delay to yield to other tasks */
-    osDelay(10);
+    /* Yield until the next fixed-period deadline (no drift from app_run time) */
+    app_wait_period();
   }
   /* USER CODE END 5 */
 }
@@ -643,6 +683,14 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
+  if (htim->Instance == TIM6)
+  {
+    hal_gpio_exti_tick();     // EXTI debouncing runs on the 1 ms tick
+    hal_i2c_tick();           // I2C transfer deadlines
+#if !configUSE_TIMERS
+    os_timer_tick();          // Software timers, without the kernel's timer task
+#endif
+  }
 
   /* USER CODE END Callback 1 */
 }
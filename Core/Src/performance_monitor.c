@@ -9,6 +9,19 @@
 #include "performance_monitor.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include "event_bus.h"
+#include "os_heap.h"
+#include "sysmem.h"
+#include "hal_uart.h"
+#include "pinout.h"
+#include "esp32_packet_framing.h"
+#include "cycle_probe.h"
+#include "isr_probe.h"
+#include "deadline_monitor.h"
+#include "latency_trace.h"
+#include "event_trace.h"
+#include "serv_current_monitor.h"
+#include "os_wrapper.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -18,6 +31,322 @@
 #include "portable_log.h"
 static const char *TAG = "PERF";
 
+#define PERF_REPORT_INTERVAL_MS     10000
+#define PERF_ENERGY_MAX_BINS        16      // Beyond this, the rest is lumped into the last bin
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+// Run-time counters of one sample, matched across samples by task number
+typedef struct {
+    uint32_t timestamp_us;
+    uint32_t task_count;
+    UBaseType_t task_number[PERF_MAX_TASKS];
+    uint32_t run_time_us[PERF_MAX_TASKS];
+} runtime_sample_t;
+
+// End points of the last PERF_WINDOW_SAMPLES intervals
+#define RUNTIME_HISTORY_LEN     (PERF_WINDOW_SAMPLES + 1)
+static runtime_sample_t runtime_history[RUNTIME_HISTORY_LEN];
+static uint32_t runtime_newest = 0;
+static uint32_t runtime_samples = 0;
+
+static TaskStatus_t runtime_status[PERF_MAX_TASKS];
+
+#if PERF_STACK_TUNING
+#define TIMER_TASK_NAME     "Tmr Svc"       // timers.c, created without the wrapper
+
+// Worst case per task name, kept after the task is deleted
+typedef struct {
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t stack_size;        // Bytes, 0 if unknown
+    uintptr_t entry;            // Task function, 0 if unknown
+    uint32_t min_free;          // Bytes
+    uint32_t samples;
+} stack_track_t;
+
+static stack_track_t stack_track[PERF_STACK_TRACK_SLOTS];
+static uint32_t stack_track_count = 0;
+#endif
+static perf_runtime_snapshot_t runtime_snapshot;    // Guarded by suspending the scheduler
+static perf_runtime_snapshot_t print_snapshot;      // Too big for the monitor task's stack
+
+/**
+ * @brief Counter of a task in a sample; 0 if it did not exist yet
+ */
+static uint32_t sample_run_time(const runtime_sample_t *sample, UBaseType_t task_number)
+{
+    for (uint32_t i = 0; i < sample->task_count; i++) {
+        if (sample->task_number[i] == task_number) {
+            return sample->run_time_us[i];
+        }
+    }
+    return 0;
+}
+
+static uint16_t to_permille(uint32_t part, uint32_t whole)
+{
+    if (whole == 0) {
+        return 0;
+    }
+    uint64_t permille = (uint64_t)part * 1000U / whole;
+    return (uint16_t)((permille > 1000U) ? 1000U : permille);
+}
+
+/**
+ * @brief Rebuild the snapshot from the newest sample (scheduler suspended)
+ */
+static void update_snapshot(TaskHandle_t idle_handle)
+{
+    const runtime_sample_t *newest = &runtime_history[runtime_newest];
+    const runtime_sample_t *previous =
+        &runtime_history[(runtime_newest + RUNTIME_HISTORY_LEN - 1) % RUNTIME_HISTORY_LEN];
+    const runtime_sample_t *oldest = (runtime_samples > RUNTIME_HISTORY_LEN)
+        ? &runtime_history[(runtime_newest + 1) % RUNTIME_HISTORY_LEN]
+        : &runtime_history[0];
+    perf_runtime_snapshot_t *snap = &runtime_snapshot;
+
+    // Unsigned differences stay right across a counter wrap
+    snap->sample_count = runtime_samples;
+    snap->timestamp_us = newest->timestamp_us;
+    snap->interval_us = newest->timestamp_us - previous->timestamp_us;
+    snap->window_us = newest->timestamp_us - oldest->timestamp_us;
+    snap->cpu_load_interval_permille = 0;
+    snap->cpu_load_window_permille = 0;
+    snap->task_count = newest->task_count;
+
+    for (uint32_t i = 0; i < newest->task_count; i++) {
+        const TaskStatus_t *status = &runtime_status[i];
+        perf_task_runtime_t *task = &snap->tasks[i];
+        uint32_t run_time = newest->run_time_us[i];
+
+        strncpy(task->name, status->pcTaskName, sizeof(task->name) - 1);
+        task->name[sizeof(task->name) - 1] = '\0';
+        task->task_number = status->xTaskNumber;
+        task->state = status->eCurrentState;
+        task->priority = status->uxCurrentPriority;
+        task->stack_high_water = status->usStackHighWaterMark;
+        task->interval_us = run_time - sample_run_time(previous, status->xTaskNumber);
+        task->window_us = run_time - sample_run_time(oldest, status->xTaskNumber);
+        task->interval_permille = to_permille(task->interval_us, snap->interval_us);
+        task->window_permille = to_permille(task->window_us, snap->window_us);
+
+        if (status->xHandle == idle_handle) {
+            snap->cpu_load_interval_permille = 1000U - task->interval_permille;
+            snap->cpu_load_window_permille = 1000U - task->window_permille;
+        }
+    }
+}
+
+#if PERF_STACK_TUNING
+/**
+ * @brief Fold the high-water marks of a sample into the per-name table
+ *        (scheduler suspended)
+ */
+static void stack_track_update(const TaskStatus_t *status, UBaseType_t count,
+                               TaskHandle_t idle_handle)
+{
+    for (UBaseType_t i = 0; i < count; i++) {
+        uint32_t free_bytes = (uint32_t)status[i].usStackHighWaterMark * sizeof(StackType_t);
+        stack_track_t *track = NULL;
+
+        for (uint32_t j = 0; j < stack_track_count; j++) {
+            if (strncmp(stack_track[j].name, status[i].pcTaskName, sizeof(track->name)) == 0) {
+                track = &stack_track[j];
+                break;
+            }
+        }
+        if (track == NULL) {
+            if (stack_track_count >= PERF_STACK_TRACK_SLOTS) {
+                continue;
+            }
+            track = &stack_track[stack_track_count++];
+            strncpy(track->name, status[i].pcTaskName, sizeof(track->name) - 1);
+            track->name[sizeof(track->name) - 1] = '\0';
+            track->min_free = UINT32_MAX;
+        }
+
+        os_task_info_t info;
+        if (os_task_get_info((os_task_handle_t)status[i].xHandle, &info)) {
+            track->stack_size = info.stack_size;
+            track->entry = (uintptr_t)info.entry;
+        } else if (status[i].xHandle == idle_handle) {
+            track->stack_size = configMINIMAL_STACK_SIZE * sizeof(StackType_t);
+        } else if (strcmp(track->name, TIMER_TASK_NAME) == 0) {
+            track->stack_size = configTIMER_TASK_STACK_DEPTH * sizeof(StackType_t);
+        }
+        if (free_bytes < track->min_free) {
+            track->min_free = free_bytes;
+        }
+        track->samples++;
+    }
+}
+
+static uint32_t stack_recommendation(uint32_t used)
+{
+    uint32_t slack = used * PERF_STACK_MARGIN_PERCENT / 100U;
+    if (slack < PERF_STACK_MIN_SLACK_BYTES) {
+        slack = PERF_STACK_MIN_SLACK_BYTES;
+    }
+    return (used + slack + PERF_STACK_ROUND_BYTES - 1U) / PERF_STACK_ROUND_BYTES * PERF_STACK_ROUND_BYTES;
+}
+#endif
+#endif
+
+/**
+ * @brief Record the run-time counters of all tasks
+ * 
+ * @return pdPASS, or pdFAIL if the counters could not be read
+ */
+BaseType_t perf_runtime_sample(void)
+{
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    uint32_t total_run_time = 0;
+    UBaseType_t task_count = uxTaskGetSystemState(runtime_status, PERF_MAX_TASKS, &total_run_time);
+
+    if (task_count == 0) {
+        LOG_W(TAG, "More than %d tasks, runtime sample skipped", PERF_MAX_TASKS);
+        return pdFAIL;
+    }
+
+    vTaskSuspendAll();
+
+    uint32_t next = (runtime_samples == 0) ? 0 : (runtime_newest + 1) % RUNTIME_HISTORY_LEN;
+    runtime_sample_t *sample = &runtime_history[next];
+
+    sample->timestamp_us = total_run_time;
+    sample->task_count = task_count;
+    for (UBaseType_t i = 0; i < task_count; i++) {
+        sample->task_number[i] = runtime_status[i].xTaskNumber;
+        sample->run_time_us[i] = runtime_status[i].ulRunTimeCounter;
+    }
+    runtime_newest = next;
+    runtime_samples++;
+
+    if (runtime_samples >= 2) {
+        update_snapshot(xTaskGetIdleTaskHandle());
+    }
+#if PERF_STACK_TUNING
+    stack_track_update(runtime_status, task_count, xTaskGetIdleTaskHandle());
+#endif
+
+    (void)xTaskResumeAll();
+    return pdPASS;
+#else
+    return pdFAIL;
+#endif
+}
+
+/**
+ * @brief Copy the statistics of the last sample
+ * 
+ * @param snapshot Output
+ * @return pdPASS, or pdFAIL until two samples have been taken
+ */
+BaseType_t perf_get_runtime_snapshot(perf_runtime_snapshot_t *snapshot)
+{
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    BaseType_t result = pdFAIL;
+
+    if (snapshot == NULL) {
+        return pdFAIL;
+    }
+
+    vTaskSuspendAll();
+    if (runtime_samples >= 2) {
+        *snapshot = runtime_snapshot;
+        result = pdPASS;
+    }
+    (void)xTaskResumeAll();
+
+    return result;
+#else
+    (void)snapshot;
+    return pdFAIL;
+#endif
+}
+
+/**
+ * @brief Fill the binary metrics snapshot
+ * 
+ * @param snapshot Output
+ * @return pdPASS, or pdFAIL if snapshot is NULL
+ */
+BaseType_t perf_get_snapshot(perf_snapshot_t *snapshot)
+{
+    if (snapshot == NULL) {
+        return pdFAIL;
+    }
+
+    memset(snapshot, 0, sizeof(*snapshot));
+    snapshot->version = PERF_SNAPSHOT_VERSION;
+    snapshot->uptime_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+    snapshot->heap_free = (uint32_t)xPortGetFreeHeapSize();
+    snapshot->heap_min_free = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+
+    UBaseType_t tasks_total = uxTaskGetNumberOfTasks();
+    snapshot->tasks_total = (uint8_t)((tasks_total > UINT8_MAX) ? UINT8_MAX : tasks_total);
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    // Straight from the sampler's snapshot, without a copy of all of it
+    vTaskSuspendAll();
+    if (runtime_samples >= 2) {
+        const perf_runtime_snapshot_t *runtime = &runtime_snapshot;
+        uint32_t count = (runtime->task_count < PERF_SNAPSHOT_MAX_TASKS)
+                         ? runtime->task_count : PERF_SNAPSHOT_MAX_TASKS;
+
+        snapshot->cpu_load_interval_permille = runtime->cpu_load_interval_permille;
+        snapshot->cpu_load_window_permille = runtime->cpu_load_window_permille;
+        snapshot->cpu_window_ms = runtime->window_us / 1000U;
+        snapshot->task_count = (uint8_t)count;
+        for (uint32_t i = 0; i < count; i++) {
+            const perf_task_runtime_t *task = &runtime->tasks[i];
+            UBaseType_t stack = task->stack_high_water;
+
+            memcpy(snapshot->tasks[i].name, task->name, PERF_SNAPSHOT_NAME_LEN);
+            snapshot->tasks[i].stack_high_water = (uint16_t)((stack > UINT16_MAX) ? UINT16_MAX : stack);
+            snapshot->tasks[i].cpu_permille = task->window_permille;
+        }
+    }
+    (void)xTaskResumeAll();
+#endif
+
+    event_bus_stats_t events = event_bus_get_stats();
+    snapshot->events_published = events.publish_success_count;
+    snapshot->events_publish_failed = events.publish_fail_count;
+    snapshot->events_processed = events.process_count;
+    snapshot->events_queue_overflow = events.queue_overflow_count;
+    snapshot->events_isr_publish_failed = events.isr_publish_fail_count;
+    snapshot->events_coalesced = events.coalesced_count;
+    snapshot->events_max_queue_depth =
+        (uint16_t)((events.max_queue_depth > UINT16_MAX) ? UINT16_MAX : events.max_queue_depth);
+    snapshot->events_timer_failed =
+        (uint16_t)((events.timer_fail_count > UINT16_MAX) ? UINT16_MAX : events.timer_fail_count);
+
+    stm32_uart_stats_t uart;
+    if (stm32_uart_get_stats(&uart) == UART_DRV_OK) {
+        snapshot->uart_packets_sent = uart.packets_sent;
+        snapshot->uart_packets_received = uart.packets_received;
+        snapshot->uart_crc_errors = uart.crc_errors;
+        snapshot->uart_framing_errors = uart.framing_errors;
+        snapshot->uart_overflow_errors = uart.overflow_errors;
+        snapshot->uart_timeout_errors = uart.timeout_errors;
+    }
+
+    hal_uart_isr_counters_t isr;
+    if (hal_uart_get_isr_counters((hal_uart_port_t)STM32_UART_PORT, &isr)) {
+        snapshot->isr_uart_idle = isr.idle;
+        snapshot->isr_uart_dma_half = isr.dma_half;
+        snapshot->isr_uart_dma_complete = isr.dma_complete;
+        snapshot->isr_uart_rx_timeout = isr.rx_timeout;
+        snapshot->isr_uart_char_match = isr.char_match;
+        snapshot->uart_rx_hw_overruns = isr.hw_overruns;
+        snapshot->uart_rx_dma_overruns = isr.dma_overruns;
+        snapshot->uart_rx_dropped_bytes = isr.rx_dropped_bytes;
+        snapshot->uart_rx_high_water = isr.rx_high_water;
+    }
+
+    return pdPASS;
+}
+
 /**
  * @brief Print information about all tasks in the system
  * 
@@ -47,24 +376,109 @@ void perf_print_task_list(void)
 /**
  * @brief Print runtime statistics for all tasks
  * 
- * Shows percentage of CPU time each task has consumed.
+ * Shows each task's share of CPU time over the last sample interval and
+ * over the sliding window, in tenths of a percent.
  * Requires: configGENERATE_RUN_TIME_STATS = 1 in FreeRTOSConfig.h
  */
 void perf_print_runtime_stats(void)
 {
 #if (configGENERATE_RUN_TIME_STATS == 1)
-    char buffer[512];
-    
+    if (perf_get_runtime_snapshot(&print_snapshot) != pdPASS) {
+        LOG_W(TAG, "Runtime stats: fewer than two samples taken");
+        return;
+    }
+
+    const perf_runtime_snapshot_t *snap = &print_snapshot;
+
     LOG_I(TAG, "=== Runtime Statistics ===");
-    vTaskGetRunTimeStats(buffer);
-    LOG_I(TAG, "\n%s", buffer);
-    
-    // Shows: Task name, absolute runtime, percentage of total time
+    LOG_I(TAG, "CPU load: %u.%u%% last %lu ms, %u.%u%% last %lu ms",
+          snap->cpu_load_interval_permille / 10U, snap->cpu_load_interval_permille % 10U,
+          (unsigned long)(snap->interval_us / 1000U),
+          snap->cpu_load_window_permille / 10U, snap->cpu_load_window_permille % 10U,
+          (unsigned long)(snap->window_us / 1000U));
+
+    for (uint32_t i = 0; i < snap->task_count; i++) {
+        const perf_task_runtime_t *task = &snap->tasks[i];
+        LOG_I(TAG, "  %s: %u.%u%% last, %u.%u%% window (%lu us)",
+              task->name,
+              task->interval_permille / 10U, task->interval_permille % 10U,
+              task->window_permille / 10U, task->window_permille % 10U,
+              (unsigned long)task->window_us);
+    }
 #else
     LOG_W(TAG, "Runtime stats unavailable. Set configGENERATE_RUN_TIME_STATS=1");
 #endif
 }
 
+static void print_energy_bins(const char *title, current_energy_key_t by, uint32_t first, uint32_t count)
+{
+    static current_energy_bin_t bins[PERF_ENERGY_MAX_BINS];
+    uint32_t used = current_monitor_energy_by(by, first, count, bins, PERF_ENERGY_MAX_BINS);
+    if (used == 0) {
+        return;
+    }
+
+    float total_mJ = 0.0f;
+    for (uint32_t i = 0; i < used; i++) {
+        total_mJ += bins[i].energy_mJ;
+    }
+
+    LOG_I(TAG, "%s", title);
+    for (uint32_t i = 0; i < used; i++) {
+        const current_energy_bin_t *bin = &bins[i];
+        const char *name = NULL;
+#if (configGENERATE_RUN_TIME_STATS == 1)
+        if (by == CURRENT_ENERGY_BY_TASK) {
+            // Names of the last runtime sample; a task made since shows its number
+            for (uint32_t t = 0; t < print_snapshot.task_count; t++) {
+                if (print_snapshot.tasks[t].task_number == bin->key) {
+                    name = print_snapshot.tasks[t].name;
+                    break;
+                }
+            }
+        }
+#endif
+        uint32_t permille = (total_mJ > 0.0f) ? (uint32_t)(bin->energy_mJ * 1000.0f / total_mJ) : 0U;
+        if (name != NULL) {
+            LOG_I(TAG, "  %-12s %8lu uJ %3lu.%lu%%  %7lu uC over %lu ms", name,
+                  (unsigned long)(bin->energy_mJ * 1000.0f), (unsigned long)(permille / 10U),
+                  (unsigned long)(permille % 10U), (unsigned long)(bin->charge_mC * 1000.0f),
+                  (unsigned long)(bin->duration_us / 1000U));
+        } else {
+            LOG_I(TAG, "  %s %-6u %8lu uJ %3lu.%lu%%  %7lu uC over %lu ms",
+                  (by == CURRENT_ENERGY_BY_TASK) ? "task " : "state", (unsigned)bin->key,
+                  (unsigned long)(bin->energy_mJ * 1000.0f), (unsigned long)(permille / 10U),
+                  (unsigned long)(permille % 10U), (unsigned long)(bin->charge_mC * 1000.0f),
+                  (unsigned long)(bin->duration_us / 1000U));
+        }
+    }
+}
+
+/**
+ * @brief Print energy per task and per app state
+ *
+ * Over every buffered sample of the last completed measurement.
+ */
+void perf_print_energy_report(void)
+{
+    uint32_t first = 0;
+    uint32_t count = 0;
+    if (!current_monitor_get_buffered_range(&first, &count) || count == 0) {
+        LOG_W(TAG, "Energy report: no current samples");
+        return;
+    }
+
+#if (configGENERATE_RUN_TIME_STATS == 1)
+    if (perf_get_runtime_snapshot(&print_snapshot) != pdPASS) {
+        print_snapshot.task_count = 0;
+    }
+#endif
+
+    LOG_I(TAG, "=== Energy (last %lu samples) ===", (unsigned long)count);
+    print_energy_bins("By task:", CURRENT_ENERGY_BY_TASK, first, count);
+    print_energy_bins("By state:", CURRENT_ENERGY_BY_STATE, first, count);
+}
+
 /**
  * @brief Print heap memory usage information
  * 
@@ -72,25 +486,51 @@ void perf_print_runtime_stats(void)
  */
 void perf_print_heap_info(void)
 {
+    size_t total_heap = 0;
+    for (uint8_t heap_class = 0; heap_class < OS_HEAP_CLASS_COUNT; heap_class++) {
+        os_heap_stats_t stats;
+        if (os_heap_get_stats((os_heap_class_t)heap_class, &stats)) {
+            total_heap += stats.total_bytes;
+        }
+    }
     size_t free_heap = xPortGetFreeHeapSize();
     
     LOG_I(TAG, "=== Heap Memory Info ===");
-    LOG_I(TAG, "Total heap size:     %lu bytes", (unsigned long)configTOTAL_HEAP_SIZE);
+    LOG_I(TAG, "Total heap size:     %lu bytes", (unsigned long)total_heap);
     LOG_I(TAG, "Free heap:           %lu bytes", (unsigned long)free_heap);
     LOG_I(TAG, "Used heap:           %lu bytes", 
-          (unsigned long)(configTOTAL_HEAP_SIZE - free_heap));
+          (unsigned long)(total_heap - free_heap));
     
 #if (configUSE_TRACE_FACILITY == 1)
     size_t min_heap = xPortGetMinimumEverFreeHeapSize();
     LOG_I(TAG, "Min free heap ever:  %lu bytes", (unsigned long)min_heap);
     LOG_I(TAG, "Peak heap usage:     %lu bytes", 
-          (unsigned long)(configTOTAL_HEAP_SIZE - min_heap));
+          (unsigned long)(total_heap - min_heap));
     
     // Warning if heap is getting tight
-    if (min_heap < (configTOTAL_HEAP_SIZE / 10)) {
+    if (min_heap < (total_heap / 10)) {
         LOG_W(TAG, "WARNING: Heap usage > 90%% - consider increasing heap size!");
     }
 #endif
+
+    // malloc() blocks are part of the heap figures above (sysmem.c, bulk class)
+    sysmem_malloc_stats_t libc;
+    sysmem_get_malloc_stats(&libc);
+    LOG_I(TAG, "malloc in use:       %lu bytes (peak %lu, %lu allocs, %lu failed)",
+          (unsigned long)libc.in_use_bytes, (unsigned long)libc.peak_bytes,
+          (unsigned long)libc.alloc_count, (unsigned long)libc.fail_count);
+
+    static const char *const class_names[OS_HEAP_CLASS_COUNT] = { "fast", "bulk" };
+    for (uint8_t heap_class = 0; heap_class < OS_HEAP_CLASS_COUNT; heap_class++) {
+        os_heap_stats_t stats;
+        if (os_heap_get_stats((os_heap_class_t)heap_class, &stats) && stats.total_bytes > 0) {
+            LOG_I(TAG, "Heap %s: %lu/%lu free (min %lu, largest %lu), %lu fallback, %lu failed",
+                  class_names[heap_class], (unsigned long)stats.free_bytes,
+                  (unsigned long)stats.total_bytes, (unsigned long)stats.min_free_bytes,
+                  (unsigned long)stats.largest_free, (unsigned long)stats.fallback_count,
+                  (unsigned long)stats.fail_count);
+        }
+    }
 }
 
 /**
@@ -172,6 +612,123 @@ UBaseType_t perf_check_task_stack(TaskHandle_t task_handle)
 #endif
 }
 
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+/**
+ * @brief Format one log2 histogram as "<=Nus:count" pairs
+ */
+static void format_latency_hist(char *buffer, size_t size, const uint32_t *hist)
+{
+    uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    size_t len = 0;
+
+    buffer[0] = '\0';
+    for (uint8_t i = 0; i < EVENT_LATENCY_BUCKET_COUNT && len < size; i++) {
+        if (hist[i] == 0) {
+            continue;
+        }
+
+        uint32_t upper_cycles = (uint32_t)1U << (EVENT_LATENCY_BUCKET_BASE_SHIFT + i + 1);
+        int written;
+        if (i == EVENT_LATENCY_BUCKET_COUNT - 1) {
+            written = snprintf(buffer + len, size - len, " >%luus:%lu",
+                               (unsigned long)(upper_cycles / 2 / cycles_per_us),
+                               (unsigned long)hist[i]);
+        } else {
+            written = snprintf(buffer + len, size - len, " <%luus:%lu",
+                               (unsigned long)((upper_cycles + cycles_per_us - 1) / cycles_per_us),
+                               (unsigned long)hist[i]);
+        }
+        if (written < 0) {
+            break;
+        }
+        len += (size_t)written;
+    }
+}
+#endif
+
+/**
+ * @brief Print event bus latency histograms
+ * 
+ * Only event types that have been dispatched at least once are shown.
+ */
+void perf_print_event_latency(void)
+{
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+    char line[256];
+    uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    event_bus_latency_t latency;
+
+    LOG_I(TAG, "=== Event Bus Latency ===");
+
+    for (uint32_t type = 0; type < EVENT_USER_DEFINED_START; type++) {
+        if (!event_bus_get_latency((event_type_t)type, &latency) || latency.sample_count == 0) {
+            continue;
+        }
+
+        LOG_I(TAG, "Event %lu: %lu dispatched, queue max %lu us, callback max %lu us (cb @%p)",
+              (unsigned long)type, (unsigned long)latency.sample_count,
+              (unsigned long)(latency.queue_max_cycles / cycles_per_us),
+              (unsigned long)(latency.callback_max_cycles / cycles_per_us),
+              (void *)latency.slowest_callback);
+
+        format_latency_hist(line, sizeof(line), latency.queue_hist);
+        LOG_I(TAG, "  queue   :%s", line);
+        format_latency_hist(line, sizeof(line), latency.callback_hist);
+        LOG_I(TAG, "  callback:%s", line);
+    }
+#else
+    LOG_W(TAG, "Event latency unavailable. Set EVENT_BUS_LATENCY_HISTOGRAMS=1");
+#endif
+}
+
+/**
+ * @brief Print recommended stack sizes from the soak so far
+ */
+void perf_print_stack_recommendations(void)
+{
+#if PERF_STACK_TUNING && (configGENERATE_RUN_TIME_STATS == 1)
+    int32_t reclaimable = 0;
+    uint32_t grow = 0;
+
+    LOG_I(TAG, "=== Stack Tuning (%lu samples) ===", (unsigned long)runtime_samples);
+
+    for (uint32_t i = 0; i < PERF_STACK_TRACK_SLOTS; i++) {
+        stack_track_t track = { 0 };
+
+        vTaskSuspendAll();
+        bool valid = (i < stack_track_count);
+        if (valid) {
+            track = stack_track[i];
+        }
+        (void)xTaskResumeAll();
+        if (!valid) {
+            break;
+        }
+
+        if (track.stack_size == 0) {
+            LOG_I(TAG, "stack %s: size ?, min free %lu", track.name, (unsigned long)track.min_free);
+            continue;
+        }
+
+        uint32_t used = (track.min_free < track.stack_size) ? track.stack_size - track.min_free : 0;
+        uint32_t recommend = stack_recommendation(used);
+        LOG_I(TAG, "stack %s: size %lu, min free %lu, used %lu, recommend %lu, entry 0x%08lx",
+              track.name, (unsigned long)track.stack_size, (unsigned long)track.min_free,
+              (unsigned long)used, (unsigned long)recommend, (unsigned long)track.entry);
+        reclaimable += (int32_t)track.stack_size - (int32_t)recommend;
+        if (recommend > track.stack_size) {
+            grow++;
+        }
+    }
+
+    LOG_I(TAG, "Recommended sizes save %ld bytes; %lu task(s) should grow",
+          (long)reclaimable, (unsigned long)grow);
+    LOG_I(TAG, "Soak figures cover only the paths that ran; compare with tools/stack_report.py");
+#else
+    LOG_W(TAG, "Stack tuning unavailable. Set PERF_STACK_TUNING=1 and configGENERATE_RUN_TIME_STATS=1");
+#endif
+}
+
 /**
  * @brief Print comprehensive performance report
  * 
@@ -194,49 +751,55 @@ void perf_print_full_report(void)
     perf_check_all_task_stacks();
     LOG_I(TAG, "");
     
+    perf_print_stack_recommendations();
+    LOG_I(TAG, "");
+    
     perf_print_runtime_stats();
+    LOG_I(TAG, "");
+    
+    perf_print_event_latency();
+    LOG_I(TAG, "");
+    
+    cycle_probe_dump();
+    LOG_I(TAG, "");
+
+    isr_probe_dump();
+    LOG_I(TAG, "");
+    
+    deadline_monitor_dump();
+    
+#if LATENCY_TRACE_ENABLE
+    LOG_I(TAG, "");
+    latency_trace_dump();
+#endif
+
+#if EVENT_TRACE_ENABLE
+    LOG_I(TAG, "");
+    event_trace_dump(false);
+#endif
     
     LOG_I(TAG, "========================================\n");
 }
 
 /**
- * @brief Get CPU load percentage (approximate)
+ * @brief Get CPU load percentage over the last sample interval
  * 
- * This uses the idle task's runtime to calculate CPU load.
- * Formula: CPU_Load = 100 - (Idle_Time_Percentage)
+ * CPU_Load = 100 - idle task's share of the interval.
  * 
- * @return CPU load percentage (0-100)
- * 
- * Note: Requires runtime statistics to be enabled.
+ * @return CPU load percentage (0-100), 0 until two samples were taken
  */
 uint8_t perf_get_cpu_load_percent(void)
 {
 #if (configGENERATE_RUN_TIME_STATS == 1) && (INCLUDE_xTaskGetIdleTaskHandle == 1)
-    static uint32_t last_idle_time = 0;
-    static uint32_t last_total_time = 0;
-    
-    TaskHandle_t idle_handle = xTaskGetIdleTaskHandle();
-    TaskStatus_t idle_status;
-    uint32_t total_runtime;
-    
-    // Get idle task status
-    vTaskGetInfo(idle_handle, &idle_status, pdTRUE, eInvalid);
-    
-    // Get total runtime
-    vTaskGetRunTimeStats(NULL);  // Updates internal counters
-    
-    uint32_t idle_time_delta = idle_status.ulRunTimeCounter - last_idle_time;
-    
-    // For simplicity, we'll calculate based on a snapshot
-    // More accurate method would track deltas over time
-    
-    last_idle_time = idle_status.ulRunTimeCounter;
-    
-    // Calculate CPU load (rough estimate)
-    // This is simplified - a production version would track deltas properly
-    uint8_t cpu_load = 100;  // Placeholder
-    
-    return cpu_load;
+    uint16_t permille = 0;
+
+    vTaskSuspendAll();
+    if (runtime_samples >= 2) {
+        permille = runtime_snapshot.cpu_load_interval_permille;
+    }
+    (void)xTaskResumeAll();
+
+    return (uint8_t)((permille + 5U) / 10U);
 #else
     LOG_W(TAG, "CPU load calculation unavailable. Set configGENERATE_RUN_TIME_STATS=1");
     return 0;
@@ -246,8 +809,8 @@ uint8_t perf_get_cpu_load_percent(void)
 /**
  * @brief Performance monitoring task
  * 
- * This task runs periodically and prints performance reports.
- * Create this task in your main initialization to enable automatic monitoring.
+ * This task samples the run-time counters every PERF_SAMPLE_PERIOD_MS
+ * and prints performance reports. Create this task in your main initialization to enable automatic monitoring.
  * 
  * @param pvParameters Task parameters (unused)
  */
@@ -255,16 +818,25 @@ void perf_monitor_task(void *pvParameters)
 {
     (void)pvParameters;
     
-    const TickType_t report_interval = pdMS_TO_TICKS(10000);  // 10 seconds
+    const TickType_t sample_period = pdMS_TO_TICKS(PERF_SAMPLE_PERIOD_MS);
+    const uint32_t samples_per_report = PERF_REPORT_INTERVAL_MS / PERF_SAMPLE_PERIOD_MS;
+    TickType_t last_wake = xTaskGetTickCount();
+    uint32_t samples = 0;
     
     LOG_I(TAG, "Performance monitor task started");
+    perf_runtime_sample();
     
     while (1)
     {
-        vTaskDelay(report_interval);
+        // Fixed cadence, so the intervals stay comparable
+        vTaskDelayUntil(&last_wake, sample_period);
+        perf_runtime_sample();
         
-        // Print full performance report
-        perf_print_full_report();
+        // Print full performance report every 10 seconds
+        if (++samples >= samples_per_report) {
+            samples = 0;
+            perf_print_full_report();
+        }
     }
 }
 
@@ -279,18 +851,23 @@ void perf_monitor_task(void *pvParameters)
  */
 BaseType_t perf_create_monitor_task(UBaseType_t priority)
 {
+    static StackType_t monitor_stack[512];  // Stack size in words
+    static StaticTask_t monitor_tcb;
     BaseType_t result;
     
-    result = xTaskCreate(
+    TaskHandle_t handle = xTaskCreateStatic(
         perf_monitor_task,
         "PerfMon",
-        512,  // Stack size in words
+        sizeof(monitor_stack) / sizeof(StackType_t),
         NULL,
         priority,
-        NULL
+        monitor_stack,
+        &monitor_tcb
     );
+    result = (handle != NULL) ? pdPASS : pdFAIL;
     
     if (result == pdPASS) {
+        os_task_note_info((os_task_handle_t)handle, perf_monitor_task, sizeof(monitor_stack));
         LOG_I(TAG, "Performance monitoring task created");
     } else {
         LOG_E(TAG, "Failed to create performance monitoring task");
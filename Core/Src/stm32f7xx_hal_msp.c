@@ -122,6 +122,11 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef* hi2c)
     /* Peripheral clock enable */
     __HAL_RCC_I2C2_CLK_ENABLE();
     /* USER CODE BEGIN I2C2_MspInit 1 */
+    // Event/error interrupts for the queued I2C transfers (hal_i2c)
+    HAL_NVIC_SetPriority(I2C2_EV_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C2_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C2_ER_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C2_ER_IRQn);
 
     /* USER CODE END I2C2_MspInit 1 */
   }
@@ -163,6 +168,11 @@ void HAL_I2C_MspInit(I2C_HandleTypeDef* hi2c)
     /* Peripheral clock enable */
     __HAL_RCC_I2C4_CLK_ENABLE();
     /* USER CODE BEGIN I2C4_MspInit 1 */
+    // Event/error interrupts for the queued I2C transfers (hal_i2c)
+    HAL_NVIC_SetPriority(I2C4_EV_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C4_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C4_ER_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C4_ER_IRQn);
 
     /* USER CODE END I2C4_MspInit 1 */
   }
@@ -194,6 +204,8 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef* hi2c)
     HAL_GPIO_DeInit(GPIOF, GPIO_PIN_1);
 
     /* USER CODE BEGIN I2C2_MspDeInit 1 */
+    HAL_NVIC_DisableIRQ(I2C2_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C2_ER_IRQn);
 
     /* USER CODE END I2C2_MspDeInit 1 */
   }
@@ -214,6 +226,8 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef* hi2c)
     HAL_GPIO_DeInit(GPIOD, GPIO_PIN_13);
 
     /* USER CODE BEGIN I2C4_MspDeInit 1 */
+    HAL_NVIC_DisableIRQ(I2C4_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C4_ER_IRQn);
 
     /* USER CODE END I2C4_MspDeInit 1 */
   }
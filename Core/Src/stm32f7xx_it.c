@@ -24,6 +24,10 @@
 /* USER CODE BEGIN Includes */
 #include "portable_log.h"
 #include "SEGGER_SYSVIEW.h"
+#include "hal_timer.h"
+#include "hal_usb.h"
+#include "hal_gpio.h"
+#include "isr_probe.h"
 
 // Forward declaration for HAL UART IDLE interrupt handler
 extern void hal_uart_idle_isr(void *huart);
@@ -66,6 +70,13 @@ extern UART_HandleTypeDef huart2;
 extern TIM_HandleTypeDef htim6;
 
 /* USER CODE BEGIN EV */
+extern I2C_HandleTypeDef hi2c2;
+extern I2C_HandleTypeDef hi2c4;
+extern SPI_HandleTypeDef hspi4;
+extern DMA_HandleTypeDef hdma_spi4_tx;
+extern SPI_HandleTypeDef hspi1;
+extern DMA_HandleTypeDef hdma_spi1_tx;
+extern RTC_HandleTypeDef hrtc;
 
 /* USER CODE END EV */
 
@@ -174,9 +185,11 @@ void DMA1_Stream5_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream5_IRQn 0 */
   SEGGER_SYSVIEW_RecordEnterISR();
+  ISR_PROBE_ENTER(ISR_PROBE_UART_RX_DMA);
   /* USER CODE END DMA1_Stream5_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart2_rx);
   /* USER CODE BEGIN DMA1_Stream5_IRQn 1 */
+  ISR_PROBE_EXIT(ISR_PROBE_UART_RX_DMA);
   SEGGER_SYSVIEW_RecordExitISR();
   /* USER CODE END DMA1_Stream5_IRQn 1 */
 }
@@ -188,9 +201,11 @@ void DMA1_Stream6_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream6_IRQn 0 */
   SEGGER_SYSVIEW_RecordEnterISR();
+  ISR_PROBE_ENTER(ISR_PROBE_UART_TX_DMA);
   /* USER CODE END DMA1_Stream6_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart2_tx);
   /* USER CODE BEGIN DMA1_Stream6_IRQn 1 */
+  ISR_PROBE_EXIT(ISR_PROBE_UART_TX_DMA);
   SEGGER_SYSVIEW_RecordExitISR();
   /* USER CODE END DMA1_Stream6_IRQn 1 */
 }
@@ -202,13 +217,19 @@ void USART2_IRQHandler(void)
 {
   /* USER CODE BEGIN USART2_IRQn 0 */
   SEGGER_SYSVIEW_RecordEnterISR();
+  ISR_PROBE_ENTER(ISR_PROBE_USART2);
 
   // Handle UART IDLE interrupt for ISR-based RX triggering
-  hal_uart_idle_isr(&huart2);
+  {
+    ISR_PROBE_ENTER(ISR_PROBE_UART_IDLE);
+    hal_uart_idle_isr(&huart2);
+    ISR_PROBE_EXIT(ISR_PROBE_UART_IDLE);
+  }
   /* USER CODE END USART2_IRQn 0 */
   HAL_UART_IRQHandler(&huart2);
   /* USER CODE BEGIN USART2_IRQn 1 */
 
+  ISR_PROBE_EXIT(ISR_PROBE_USART2);
   SEGGER_SYSVIEW_RecordExitISR();
   /* USER CODE END USART2_IRQn 1 */
 }
@@ -229,4 +250,138 @@ void TIM6_DAC_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief EXTI vectors: the hal_gpio router dispatches each pending line.
+  */
+#define EXTI_VECTOR(name, lines)            \
+  void name(void)                           \
+  {                                         \
+    SEGGER_SYSVIEW_RecordEnterISR();        \
+    hal_gpio_exti_irq_handler(lines);       \
+    SEGGER_SYSVIEW_RecordExitISR();         \
+  }
+
+EXTI_VECTOR(EXTI0_IRQHandler, 0x0001U)
+EXTI_VECTOR(EXTI1_IRQHandler, 0x0002U)
+EXTI_VECTOR(EXTI2_IRQHandler, 0x0004U)
+EXTI_VECTOR(EXTI3_IRQHandler, 0x0008U)
+EXTI_VECTOR(EXTI4_IRQHandler, 0x0010U)
+EXTI_VECTOR(EXTI9_5_IRQHandler, 0x03E0U)
+
+/**
+  * @brief EXTI lines 10..15 (line 10: INA226 ALERT).
+  */
+void EXTI15_10_IRQHandler(void)
+{
+  SEGGER_SYSVIEW_RecordEnterISR();
+  ISR_PROBE_ENTER(ISR_PROBE_EXTI);
+  hal_gpio_exti_irq_handler(0xFC00U);
+  ISR_PROBE_EXIT(ISR_PROBE_EXTI);
+  SEGGER_SYSVIEW_RecordExitISR();
+}
+
+/**
+  * @brief This function handles I2C2 event interrupt.
+  */
+void I2C2_EV_IRQHandler(void)
+{
+  ISR_PROBE_ENTER(ISR_PROBE_I2C2_EV);
+  HAL_I2C_EV_IRQHandler(&hi2c2);
+  ISR_PROBE_EXIT(ISR_PROBE_I2C2_EV);
+}
+
+/**
+  * @brief This function handles I2C2 error interrupt.
+  */
+void I2C2_ER_IRQHandler(void)
+{
+  HAL_I2C_ER_IRQHandler(&hi2c2);
+}
+
+/**
+  * @brief This function handles I2C4 event interrupt.
+  */
+void I2C4_EV_IRQHandler(void)
+{
+  ISR_PROBE_ENTER(ISR_PROBE_I2C4_EV);
+  HAL_I2C_EV_IRQHandler(&hi2c4);
+  ISR_PROBE_EXIT(ISR_PROBE_I2C4_EV);
+}
+
+/**
+  * @brief This function handles I2C4 error interrupt.
+  */
+void I2C4_ER_IRQHandler(void)
+{
+  HAL_I2C_ER_IRQHandler(&hi2c4);
+}
+
+/**
+  * @brief This function handles TIM5 global interrupt (microsecond timer).
+  */
+void TIM5_IRQHandler(void)
+{
+  SEGGER_SYSVIEW_RecordEnterISR();
+  ISR_PROBE_ENTER(ISR_PROBE_TIMER_US);
+  hal_timer_irq_handler();
+  ISR_PROBE_EXIT(ISR_PROBE_TIMER_US);
+  SEGGER_SYSVIEW_RecordExitISR();
+}
+
+/**
+  * @brief This function handles DMA2 stream1 global interrupt (SPI4 TX, storage).
+  */
+void DMA2_Stream1_IRQHandler(void)
+{
+  ISR_PROBE_ENTER(ISR_PROBE_STORAGE_DMA);
+  HAL_DMA_IRQHandler(&hdma_spi4_tx);
+  ISR_PROBE_EXIT(ISR_PROBE_STORAGE_DMA);
+}
+
+/**
+  * @brief This function handles SPI4 global interrupt (storage).
+  */
+void SPI4_IRQHandler(void)
+{
+  HAL_SPI_IRQHandler(&hspi4);
+}
+
+/**
+  * @brief This function handles DMA2 stream3 global interrupt (SPI1 TX, display).
+  */
+void DMA2_Stream3_IRQHandler(void)
+{
+  ISR_PROBE_ENTER(ISR_PROBE_DISPLAY_DMA);
+  HAL_DMA_IRQHandler(&hdma_spi1_tx);
+  ISR_PROBE_EXIT(ISR_PROBE_DISPLAY_DMA);
+}
+
+/**
+  * @brief This function handles SPI1 global interrupt (display).
+  */
+void SPI1_IRQHandler(void)
+{
+  HAL_SPI_IRQHandler(&hspi1);
+}
+
+/**
+  * @brief This function handles the RTC wakeup timer interrupt (tickless idle).
+  */
+void RTC_WKUP_IRQHandler(void)
+{
+  HAL_RTCEx_WakeUpTimerIRQHandler(&hrtc);
+}
+
+/**
+  * @brief This function handles USB OTG FS global interrupt (CDC link).
+  */
+void OTG_FS_IRQHandler(void)
+{
+  SEGGER_SYSVIEW_RecordEnterISR();
+  ISR_PROBE_ENTER(ISR_PROBE_USB);
+  hal_usb_irq_handler();
+  ISR_PROBE_EXIT(ISR_PROBE_USB);
+  SEGGER_SYSVIEW_RecordExitISR();
+}
+
 /* USER CODE END 1 */
@@ -24,6 +24,12 @@
 #include <errno.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "os_heap.h"
+#include "sysmem.h"
 
 /**
  * Pointer to the current high watermark of the heap usage
@@ -85,3 +91,214 @@ void *_sbrk(ptrdiff_t incr)
   // calls to `sbrk()` are resolved to our `_sbrk()` implementation.
   __strong_reference(_sbrk, sbrk);
 #endif
+
+/**
+ * @brief C library malloc() and friends on the FreeRTOS heap (os_heap.c)
+ *
+ * Replaces the newlib allocator, so the C library and the kernel share
+ * the os_heap regions instead of splitting RAM between two heaps, and the
+ * heap's scheduler lock makes malloc() safe from any task. Blocks are
+ * hinted OS_HEAP_BULK: malloc() serves buffers, the kernel keeps DTCM.
+ * _sbrk() above is no longer reached. Each block carries its requested
+ * size in front, for realloc() and the usage counters. A failed malloc()
+ * returns NULL without the kernel's malloc-failed hook. Not callable from
+ * ISRs.
+ */
+typedef union
+{
+  size_t size;
+  uint64_t align; /* Keeps the caller's block OS_HEAP_ALIGN-aligned */
+} malloc_header_t;
+
+static sysmem_malloc_stats_t malloc_stats;
+
+static void malloc_account(size_t allocated, size_t freed)
+{
+  vTaskSuspendAll();
+  malloc_stats.in_use_bytes += allocated;
+  malloc_stats.in_use_bytes -= freed;
+  if (malloc_stats.in_use_bytes > malloc_stats.peak_bytes)
+  {
+    malloc_stats.peak_bytes = malloc_stats.in_use_bytes;
+  }
+  if (allocated > 0)
+  {
+    malloc_stats.alloc_count++;
+  }
+  if (freed > 0)
+  {
+    malloc_stats.free_count++;
+  }
+  (void)xTaskResumeAll();
+}
+
+static void *heap_malloc(size_t size)
+{
+  if (size > SIZE_MAX - sizeof(malloc_header_t))
+  {
+    return NULL;
+  }
+
+  malloc_header_t *header = os_heap_alloc(sizeof(malloc_header_t) + size, OS_HEAP_BULK);
+  if (header == NULL)
+  {
+    vTaskSuspendAll();
+    malloc_stats.fail_count++;
+    (void)xTaskResumeAll();
+    return NULL;
+  }
+
+  header->size = size;
+  malloc_account(size, 0);
+  return header + 1;
+}
+
+static void heap_free(void *ptr)
+{
+  if (ptr == NULL)
+  {
+    return;
+  }
+
+  malloc_header_t *header = (malloc_header_t *)ptr - 1;
+  malloc_account(0, header->size);
+  os_heap_free(header);
+}
+
+static void *heap_realloc(void *ptr, size_t size)
+{
+  if (ptr == NULL)
+  {
+    return heap_malloc(size);
+  }
+  if (size == 0)
+  {
+    heap_free(ptr);
+    return NULL;
+  }
+
+  size_t old_size = ((malloc_header_t *)ptr - 1)->size;
+  if (size <= old_size)
+  {
+    return ptr;
+  }
+
+  void *grown = heap_malloc(size);
+  if (grown != NULL)
+  {
+    memcpy(grown, ptr, old_size);
+    heap_free(ptr);
+  }
+  return grown;
+}
+
+static void *heap_calloc(size_t count, size_t size)
+{
+  if (size != 0 && count > SIZE_MAX / size)
+  {
+    return NULL;
+  }
+
+  void *ptr = heap_malloc(count * size);
+  if (ptr != NULL)
+  {
+    memset(ptr, 0, count * size);
+  }
+  return ptr;
+}
+
+void *malloc(size_t size)
+{
+  void *ptr = heap_malloc(size);
+  if (ptr == NULL)
+  {
+    errno = ENOMEM;
+  }
+  return ptr;
+}
+
+void free(void *ptr)
+{
+  heap_free(ptr);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+  void *grown = heap_realloc(ptr, size);
+  if (grown == NULL && size != 0)
+  {
+    errno = ENOMEM;
+  }
+  return grown;
+}
+
+void *calloc(size_t count, size_t size)
+{
+  void *ptr = heap_calloc(count, size);
+  if (ptr == NULL)
+  {
+    errno = ENOMEM;
+  }
+  return ptr;
+}
+
+#if !defined(__PICOLIBC__)
+#include <reent.h>
+
+/* newlib's stdio and other internals allocate through the reentrant entry points */
+void *_malloc_r(struct _reent *reent, size_t size)
+{
+  void *ptr = heap_malloc(size);
+  if (ptr == NULL)
+  {
+    reent->_errno = ENOMEM;
+  }
+  return ptr;
+}
+
+void _free_r(struct _reent *reent, void *ptr)
+{
+  (void)reent;
+  heap_free(ptr);
+}
+
+void *_realloc_r(struct _reent *reent, void *ptr, size_t size)
+{
+  void *grown = heap_realloc(ptr, size);
+  if (grown == NULL && size != 0)
+  {
+    reent->_errno = ENOMEM;
+  }
+  return grown;
+}
+
+void *_calloc_r(struct _reent *reent, size_t count, size_t size)
+{
+  void *ptr = heap_calloc(count, size);
+  if (ptr == NULL)
+  {
+    reent->_errno = ENOMEM;
+  }
+  return ptr;
+}
+
+/* Anything still linked against newlib's allocator shares the same lock */
+void __malloc_lock(struct _reent *reent)
+{
+  (void)reent;
+  vTaskSuspendAll();
+}
+
+void __malloc_unlock(struct _reent *reent)
+{
+  (void)reent;
+  (void)xTaskResumeAll();
+}
+#endif
+
+void sysmem_get_malloc_stats(sysmem_malloc_stats_t *stats)
+{
+  vTaskSuspendAll();
+  *stats = malloc_stats;
+  (void)xTaskResumeAll();
+}
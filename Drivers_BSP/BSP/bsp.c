@@ -1,9 +1,18 @@
 #include "bsp.h"
 #include "hal_gpio.h"
+#include "event_bus.h"
 #include "main.h" // For hi2c2
 
 extern I2C_HandleTypeDef hi2c2;
 extern I2C_HandleTypeDef hi2c4;
+extern SPI_HandleTypeDef hspi1;
+
+// Not part of the CubeMX configuration; set up by BSP_Storage_SPI_Init()
+SPI_HandleTypeDef hspi4;
+DMA_HandleTypeDef hdma_spi4_tx;
+
+// Set up by BSP_Display_SPI_DMA_Init()
+DMA_HandleTypeDef hdma_spi1_tx;
 
 /**
  * @brief Initialize the Board Support Package
@@ -58,6 +67,23 @@ void BSP_LED_Toggle(void)
     hal_gpio_toggle_pin((hal_gpio_port_t)EXT_LED_GPIO_PORT, EXT_LED_PIN);
 }
 
+/**
+ * @brief Route the USER button through the EXTI router
+ * @return false if the line could not be set up
+ */
+bool BSP_Button_Init(void)
+{
+    static const hal_gpio_exti_config_t button = {
+        .port = (hal_gpio_port_t)USER_BUTTON_PORT,
+        .pin = USER_BUTTON_PIN,
+        .edge = HAL_GPIO_EDGE_RISING,
+        .pull = HAL_GPIO_PULL_NONE,
+        .debounce_ms = USER_BUTTON_DEBOUNCE_MS,
+        .event_type = EVENT_BUTTON_PRESSED,
+    };
+    return hal_gpio_exti_register(&button);
+}
+
 /**
  * @brief Get I2C handle for temperature sensor
  * @return I2C handle for temperature sensor peripheral
@@ -75,3 +101,119 @@ hal_i2c_handle_t BSP_Get_CurrentSensor_I2C(void)
 {
     return (hal_i2c_handle_t)&hi2c4;
 }
+
+/**
+ * @brief Bring up the external storage SPI bus
+ *
+ * SPI4 master, mode 0, 30 MHz (APB2 60 MHz / 2), software chip select,
+ * TX on DMA2 Stream1 Channel 4. Reads stay polled. Safe to call again.
+ *
+ * @return SPI handle for the storage bus, or NULL on failure
+ */
+hal_spi_handle_t BSP_Storage_SPI_Init(void)
+{
+    if (hspi4.State != HAL_SPI_STATE_RESET) {
+        return (hal_spi_handle_t)&hspi4;
+    }
+
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOE_CLK_ENABLE();
+    __HAL_RCC_SPI4_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    // Chip select idles high
+    HAL_GPIO_WritePin(STORAGE_CS_PORT, STORAGE_CS_PIN, GPIO_PIN_SET);
+    gpio.Pin = STORAGE_CS_PIN;
+    gpio.Mode = GPIO_MODE_OUTPUT_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    HAL_GPIO_Init(STORAGE_CS_PORT, &gpio);
+
+    gpio.Pin = STORAGE_SPI_SCK_PIN | STORAGE_SPI_MISO_PIN | STORAGE_SPI_MOSI_PIN;
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Alternate = GPIO_AF5_SPI4;
+    HAL_GPIO_Init(STORAGE_SPI_PORT, &gpio);
+
+    hdma_spi4_tx.Instance = DMA2_Stream1;
+    hdma_spi4_tx.Init.Channel = DMA_CHANNEL_4;
+    hdma_spi4_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_spi4_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_spi4_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_spi4_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi4_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_spi4_tx.Init.Mode = DMA_NORMAL;
+    hdma_spi4_tx.Init.Priority = DMA_PRIORITY_MEDIUM;
+    hdma_spi4_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_spi4_tx) != HAL_OK) {
+        return NULL;
+    }
+    __HAL_LINKDMA(&hspi4, hdmatx, hdma_spi4_tx);
+
+    hspi4.Instance = SPI4;
+    hspi4.Init.Mode = SPI_MODE_MASTER;
+    hspi4.Init.Direction = SPI_DIRECTION_2LINES;
+    hspi4.Init.DataSize = SPI_DATASIZE_8BIT;
+    hspi4.Init.CLKPolarity = SPI_POLARITY_LOW;
+    hspi4.Init.CLKPhase = SPI_PHASE_1EDGE;
+    hspi4.Init.NSS = SPI_NSS_SOFT;
+    hspi4.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_2;
+    hspi4.Init.FirstBit = SPI_FIRSTBIT_MSB;
+    hspi4.Init.TIMode = SPI_TIMODE_DISABLE;
+    hspi4.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+    hspi4.Init.CRCPolynomial = 7;
+    hspi4.Init.CRCLength = SPI_CRC_LENGTH_DATASIZE;
+    hspi4.Init.NSSPMode = SPI_NSS_PULSE_DISABLE;
+    if (HAL_SPI_Init(&hspi4) != HAL_OK) {
+        return NULL;
+    }
+
+    HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+    HAL_NVIC_SetPriority(SPI4_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(SPI4_IRQn);
+
+    return (hal_spi_handle_t)&hspi4;
+}
+
+/**
+ * @brief Link a TX DMA stream to the display SPI bus
+ *
+ * SPI1 itself is configured by CubeMX (MX_SPI1_Init); this adds DMA2
+ * Stream3 Channel 3 for transmits. Safe to call again.
+ *
+ * @return SPI handle for the display bus, or NULL on failure
+ */
+hal_spi_handle_t BSP_Display_SPI_DMA_Init(void)
+{
+    if (hspi1.State == HAL_SPI_STATE_RESET) {
+        return NULL;  // MX_SPI1_Init() has not run
+    }
+    if (hspi1.hdmatx != NULL) {
+        return (hal_spi_handle_t)&hspi1;
+    }
+
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    hdma_spi1_tx.Instance = DMA2_Stream3;
+    hdma_spi1_tx.Init.Channel = DMA_CHANNEL_3;
+    hdma_spi1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_spi1_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_spi1_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_spi1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_spi1_tx.Init.Mode = DMA_NORMAL;
+    hdma_spi1_tx.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_spi1_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_spi1_tx) != HAL_OK) {
+        return NULL;
+    }
+    __HAL_LINKDMA(&hspi1, hdmatx, hdma_spi1_tx);
+
+    HAL_NVIC_SetPriority(DMA2_Stream3_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream3_IRQn);
+    HAL_NVIC_SetPriority(SPI1_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(SPI1_IRQn);
+
+    return (hal_spi_handle_t)&hspi1;
+}
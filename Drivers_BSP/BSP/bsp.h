@@ -15,6 +15,7 @@
 #include "stm32f7xx_hal.h"
 #include "pinout.h"
 #include "hal_i2c.h"
+#include "hal_spi.h"
 
 // BSP Initialization
 void BSP_Init(void);
@@ -25,8 +26,17 @@ void BSP_LED_On(void);
 void BSP_LED_Off(void);
 void BSP_LED_Toggle(void);
 
+// USER button: publishes EVENT_BUTTON_PRESSED per debounced press (after event_bus_init)
+bool BSP_Button_Init(void);
+
 // Peripheral access functions
 hal_i2c_handle_t BSP_Get_TempSensor_I2C(void);
 hal_i2c_handle_t BSP_Get_CurrentSensor_I2C(void);
 
+// External storage bus (SPI4 + TX DMA), brought up on first use
+hal_spi_handle_t BSP_Storage_SPI_Init(void);
+
+// Display bus (CubeMX SPI1) with TX DMA linked
+hal_spi_handle_t BSP_Display_SPI_DMA_Init(void);
+
 #endif // BSP_H
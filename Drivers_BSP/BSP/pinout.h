@@ -31,6 +31,19 @@
 #define INA226_ALERT_PIN    GPIO_PIN_10
 #define INA226_ALERT_PORT   GPIOB
 
+// Nucleo USER button B1 (active high, pull-down on the board)
+#define USER_BUTTON_PIN     GPIO_PIN_13
+#define USER_BUTTON_PORT    GPIOC
+#define USER_BUTTON_DEBOUNCE_MS 20
+
+// External SPI NOR flash (SPI4, recorder storage) - PE2/PE4/PE5/PE6
+#define STORAGE_SPI_SCK_PIN     GPIO_PIN_2
+#define STORAGE_SPI_MISO_PIN    GPIO_PIN_5
+#define STORAGE_SPI_MOSI_PIN    GPIO_PIN_6
+#define STORAGE_SPI_PORT        GPIOE
+#define STORAGE_CS_PIN          GPIO_PIN_4
+#define STORAGE_CS_PORT         GPIOE
+
 // ESP32 UART (USART2) - PD3/PD4/PD5/PD6
 #define STM32_UART_PORT         HAL_UART_PORT_1  // Maps to USART2 in hal_uart.c
 #define STM32_UART_TX_PIN       GPIO_PIN_5
@@ -42,4 +55,8 @@
 #define STM32_UART_CTS_PIN      GPIO_PIN_3
 #define STM32_UART_CTS_PORT     GPIOD
 
+// Ethernet (RMII to the Nucleo's LAN8742A) is not usable as wired: SPI1
+// MOSI for the display is on PA7, which is also the PHY's RMII_CRS_DV.
+// UM1974 lists the solder bridges that move Arduino D11 to PB5.
+
 #endif // PINOUT_H
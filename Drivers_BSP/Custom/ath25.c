@@ -1,5 +1,7 @@
 #include "ath25.h"
 #include "pinout.h"
+#include "crc8.h"
+#include "hal_crc.h"
 
 ath25_sensor_t default_ath25_sensor = {
     .initialized = false,
@@ -15,18 +17,12 @@ void ath25_init() {
 
 static uint8_t ath25_crc8(uint8_t *data, uint8_t len)
 {
-    uint8_t crc = 0xFF;
-
-    for (uint8_t i = 0; i < len; i++) {
-        crc ^= data[i];
-        for (uint8_t bit = 0; bit < 8; bit++) {
-            if (crc & 0x80)
-                crc = (crc << 1) ^ 0x31;  // polynomial: x8 + x5 + x4 + 1 (0x31)
-            else
-                crc <<= 1;
-        }
+#if ATH25_USE_HW_CRC
+    if (hal_crc_is_available()) {
+        return hal_crc_crc8(CRC8_POLY31, CRC8_POLY31_INIT, data, len);
     }
-    return crc;
+#endif
+    return crc8_poly31(CRC8_POLY31_INIT, data, len);  // polynomial: x8 + x5 + x4 + 1 (0x31)
 }
 
 hal_i2c_status_t ath25_open(ath25_sensor_t *sensor, hal_i2c_handle_t hi2c) {
@@ -35,6 +31,7 @@ hal_i2c_status_t ath25_open(ath25_sensor_t *sensor, hal_i2c_handle_t hi2c) {
 
     sensor->hi2c = hi2c;
     sensor->initialized = false; 
+    sensor->phase = ATH25_PHASE_IDLE;
     
     // Power on the sensor
     hal_gpio_write_pin(sensor->power_port, sensor->power_pin, HAL_GPIO_PIN_SET);
@@ -58,6 +55,28 @@ hal_i2c_status_t ath25_open(ath25_sensor_t *sensor, hal_i2c_handle_t hi2c) {
     return HAL_I2C_OK;
 }
 
+// Check and convert a 7-byte measurement result
+static hal_i2c_status_t ath25_parse(const uint8_t *recv, ath_data_t *data) {
+        // Check if busy bit clear
+    if (recv[0] & 0x80)
+        return HAL_I2C_BUSY;
+
+    // Verify CRC
+    if (ath25_crc8((uint8_t *)recv, 6) != recv[6]) {
+        return HAL_I2C_ERROR;
+    }
+
+    //combine bytes to get raw temperature and humidity
+    uint32_t raw_temp = ((uint32_t)(recv[3] & 0x0F) << 16) | ((uint32_t)recv[4] << 8) | (uint32_t)recv[5];
+    uint32_t raw_hum = ((uint32_t)recv[1] << 12) | ((uint32_t)recv[2] << 4) | ((uint32_t)(recv[3] >> 4));
+
+    // Convert raw values to physical values
+    data->temperature = ((float)raw_temp / 1048576.0f) * 200.0f - 50.0f; // -50 to 150 C
+    data->humidity = ((float)raw_hum / 1048576.0f) * 100.0f; // 0 to 100 %
+
+    return HAL_I2C_OK;
+}
+
 hal_i2c_status_t ath25_read(ath25_sensor_t *sensor, ath_data_t *data) {
     uint8_t cmd[3] = {0xAC, 0x33, 0x00};
     uint8_t recv[7];
@@ -70,30 +89,109 @@ hal_i2c_status_t ath25_read(ath25_sensor_t *sensor, ath_data_t *data) {
         return HAL_I2C_ERROR;
     }
 
-    hal_delay_ms(80); // wait for measurement to complete
+    hal_delay_ms(ATH25_CONVERSION_TIME_MS); // wait for measurement to complete
 
     if (hal_i2c_master_receive(sensor->hi2c, sensor->i2c_address, recv, 7, MAX_ATH25_I2C_TRANSFER_TIME) != HAL_I2C_OK) {
         return HAL_I2C_ERROR;
     }
 
-        // Check if busy bit clear
-    if (recv[0] & 0x80)
-        return HAL_I2C_BUSY;
+    return ath25_parse(recv, data);
+}
 
-    // Verify CRC
-    if (ath25_crc8(recv, 6) != recv[6]) {
+// ========== Non-blocking Measurement ==========
+
+// I2C completion (ISR context): move to the next phase
+static void ath25_transfer_done(hal_i2c_handle_t handle, hal_i2c_status_t status, void *user_data) {
+    (void)handle;
+    ath25_sensor_t *sensor = (ath25_sensor_t *)user_data;
+
+    if (status != HAL_I2C_OK) {
+        sensor->phase = ATH25_PHASE_FAILED;
+        return;
+    }
+
+    if (sensor->phase == ATH25_PHASE_TRIGGERING) {
+        sensor->phase_tick = hal_get_tick();
+        sensor->phase = ATH25_PHASE_CONVERTING;
+    } else if (sensor->phase == ATH25_PHASE_FETCHING) {
+        sensor->phase = ATH25_PHASE_FETCHED;
+    }
+}
+
+static hal_i2c_status_t ath25_submit(ath25_sensor_t *sensor, hal_i2c_xfer_type_t type,
+                                     uint8_t *data, uint16_t size) {
+    hal_i2c_transaction_t xfer = {
+        .type = type,
+        .dev_address = sensor->i2c_address,
+        .data = data,
+        .size = size,
+        .callback = ath25_transfer_done,
+        .user_data = sensor
+    };
+    return hal_i2c_submit(sensor->hi2c, &xfer);
+}
+
+hal_i2c_status_t ath25_start_measurement(ath25_sensor_t *sensor) {
+    if (sensor->initialized == false || ath25_measurement_pending(sensor)) {
         return HAL_I2C_ERROR;
     }
 
-    //combine bytes to get raw temperature and humidity
-    uint32_t raw_temp = ((uint32_t)(recv[3] & 0x0F) << 16) | ((uint32_t)recv[4] << 8) | (uint32_t)recv[5];
-    uint32_t raw_hum = ((uint32_t)recv[1] << 12) | ((uint32_t)recv[2] << 4) | ((uint32_t)(recv[3] >> 4));
+    sensor->cmd[0] = 0xAC;
+    sensor->cmd[1] = 0x33;
+    sensor->cmd[2] = 0x00;
+    sensor->busy_retries = 0;
+    sensor->phase = ATH25_PHASE_TRIGGERING;
 
-    // Convert raw values to physical values
-    data->temperature = ((float)raw_temp / 1048576.0f) * 200.0f - 50.0f; // -50 to 150 C
-    data->humidity = ((float)raw_hum / 1048576.0f) * 100.0f; // 0 to 100 %
+    hal_i2c_status_t status = ath25_submit(sensor, HAL_I2C_XFER_TRANSMIT, sensor->cmd, 3);
+    if (status != HAL_I2C_OK) {
+        sensor->phase = ATH25_PHASE_IDLE;
+    }
+    return status;
+}
 
-    return HAL_I2C_OK;
+hal_i2c_status_t ath25_poll_measurement(ath25_sensor_t *sensor, ath_data_t *data) {
+    switch (sensor->phase) {
+        case ATH25_PHASE_CONVERTING: {
+            uint32_t wait_ms = (sensor->busy_retries == 0) ? ATH25_CONVERSION_TIME_MS : ATH25_BUSY_RETRY_MS;
+            if ((hal_get_tick() - sensor->phase_tick) < wait_ms) {
+                return HAL_I2C_BUSY;
+            }
+            sensor->phase = ATH25_PHASE_FETCHING;
+            if (ath25_submit(sensor, HAL_I2C_XFER_RECEIVE, sensor->recv, 7) != HAL_I2C_OK) {
+                // Bus queue full: try again on the next poll
+                sensor->phase = ATH25_PHASE_CONVERTING;
+            }
+            return HAL_I2C_BUSY;
+        }
+
+        case ATH25_PHASE_FETCHED: {
+            hal_i2c_status_t status = ath25_parse(sensor->recv, data);
+            if (status == HAL_I2C_BUSY && sensor->busy_retries < ATH25_MAX_BUSY_RETRIES) {
+                // Conversion not finished yet: fetch again shortly
+                sensor->busy_retries++;
+                sensor->phase_tick = hal_get_tick();
+                sensor->phase = ATH25_PHASE_CONVERTING;
+                return HAL_I2C_BUSY;
+            }
+            sensor->phase = ATH25_PHASE_IDLE;
+            return (status == HAL_I2C_OK) ? HAL_I2C_OK : HAL_I2C_ERROR;
+        }
+
+        case ATH25_PHASE_FAILED:
+            sensor->phase = ATH25_PHASE_IDLE;
+            return HAL_I2C_ERROR;
+
+        case ATH25_PHASE_IDLE:
+            return HAL_I2C_ERROR;
+
+        default:
+            // Transfer on the bus
+            return HAL_I2C_BUSY;
+    }
+}
+
+bool ath25_measurement_pending(const ath25_sensor_t *sensor) {
+    return sensor->phase != ATH25_PHASE_IDLE;
 }
 
 hal_i2c_status_t ath25_close(ath25_sensor_t *sensor) {
@@ -9,6 +9,16 @@
 
 // sensor is -40 to 80 degrees with an resolution of 0.01 degrees conversion -> (St / 2^20) * 200 - 50
 
+// Phases of a non-blocking measurement
+typedef enum {
+    ATH25_PHASE_IDLE = 0,
+    ATH25_PHASE_TRIGGERING,           // measurement command on the bus
+    ATH25_PHASE_CONVERTING,           // waiting out the conversion time
+    ATH25_PHASE_FETCHING,             // result read on the bus
+    ATH25_PHASE_FETCHED,              // result received, not parsed yet
+    ATH25_PHASE_FAILED                // I2C transfer failed
+} ath25_phase_t;
+
 typedef struct {
     bool initialized;
     hal_i2c_handle_t hi2c;        // I2C handle
@@ -16,6 +26,12 @@ typedef struct {
     hal_gpio_port_t power_port;       // power control pin port
     hal_gpio_pin_t power_pin;         // power control pin number
     uint8_t resolution;               // sensor resolution (bits)
+    // Non-blocking measurement state
+    volatile ath25_phase_t phase;
+    uint32_t phase_tick;              // when the conversion started
+    uint8_t busy_retries;             // fetches that found the sensor still busy
+    uint8_t cmd[3];
+    uint8_t recv[7];
 } ath25_sensor_t;
 
 extern ath25_sensor_t default_ath25_sensor;
@@ -26,6 +42,15 @@ typedef struct {
 }ath_data_t;
 
 #define MAX_ATH25_I2C_TRANSFER_TIME 100
+#define ATH25_CONVERSION_TIME_MS    80  // measurement time after the trigger
+#define ATH25_BUSY_RETRY_MS         10  // re-fetch delay when still busy
+#define ATH25_MAX_BUSY_RETRIES      3
+
+// Check results with the CRC peripheral's 8-bit mode when available
+// (7 bytes per reading, so the table-driven CRC is usually as fast)
+#ifndef ATH25_USE_HW_CRC
+#define ATH25_USE_HW_CRC            0
+#endif
 
 // Initialize the temperature sensor (i2nc setup, GPIOs, etc.)
 void ath25_init();
@@ -36,6 +61,17 @@ hal_i2c_status_t ath25_open(ath25_sensor_t *sensor, hal_i2c_handle_t hi2c);
 // Read the current temperature value from the sensor
 hal_i2c_status_t ath25_read(ath25_sensor_t *sensor, ath_data_t *data);
 
+// Start a measurement without waiting for it (trigger phase)
+hal_i2c_status_t ath25_start_measurement(ath25_sensor_t *sensor);
+
+// Advance a started measurement; never blocks. Returns HAL_I2C_BUSY while
+// it is still converting or on the bus, HAL_I2C_OK once data is filled in,
+// or HAL_I2C_ERROR (the sensor is then idle again)
+hal_i2c_status_t ath25_poll_measurement(ath25_sensor_t *sensor, ath_data_t *data);
+
+// True between ath25_start_measurement() and its final poll result
+bool ath25_measurement_pending(const ath25_sensor_t *sensor);
+
 // Close the connection and power down the temperature sensor
 hal_i2c_status_t ath25_close(ath25_sensor_t *sensor);
 
@@ -0,0 +1,183 @@
+/**
+ * @file display_chart.c
+ * @brief Scrolling live chart on the ST7735, one SPI column per sample
+ */
+
+#include "display_chart.h"
+#include <math.h>
+#include <string.h>
+
+typedef struct {
+    bool enabled;
+    uint16_t pixel;             // Panel order
+    float min;
+    float scale;                // Rows per unit
+    int32_t last_row;           // Row of the previous value, -1 after a gap
+} chart_series_t;
+
+static display_chart_config_t chart;
+static chart_series_t series[DISPLAY_CHART_MAX_SERIES];
+static bool chart_open = false;
+static uint16_t slot = 0;       // Column the next sample goes to, 0..w-1
+
+// One column, panel order
+static uint16_t column[ST7735_HEIGHT];
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static inline uint16_t to_panel(uint16_t color)
+{
+    return (uint16_t)((color >> 8) | (color << 8));
+}
+
+// Frame memory line holding a screen column
+static uint16_t memory_line(uint16_t x)
+{
+#if ST7735_SCROLL_REVERSED
+    return (uint16_t)(ST7735_FRAME_LINES - 1 - (x + ST7735_XSTART));
+#else
+    return (uint16_t)(x + ST7735_XSTART);
+#endif
+}
+
+static void column_background(void)
+{
+    uint16_t bg = to_panel(chart.bg_color);
+    uint16_t grid = to_panel(chart.grid_color);
+
+    for (uint32_t row = 0; row < ST7735_HEIGHT; row++) {
+        // Grid rows counted from the bottom, where min sits
+        uint32_t from_bottom = ST7735_HEIGHT - 1 - row;
+        column[row] = (chart.grid_step > 0 && from_bottom % chart.grid_step == 0) ? grid : bg;
+    }
+}
+
+static int32_t value_row(const chart_series_t *s, float value)
+{
+    int32_t row = (int32_t)(ST7735_HEIGHT - 1) - (int32_t)lroundf((value - s->min) * s->scale);
+    if (row < 0) {
+        return 0;
+    }
+    if (row > ST7735_HEIGHT - 1) {
+        return ST7735_HEIGHT - 1;
+    }
+    return row;
+}
+
+// Vertical segment from the previous row to this one, so steps stay joined
+static void column_plot(chart_series_t *s, float value)
+{
+    if (!s->enabled || isnan(value)) {
+        s->last_row = -1;
+        return;
+    }
+
+    int32_t row = value_row(s, value);
+    int32_t from = (s->last_row >= 0) ? s->last_row : row;
+    int32_t lo = (from < row) ? from : row;
+    int32_t hi = (from < row) ? row : from;
+    for (int32_t r = lo; r <= hi; r++) {
+        column[r] = s->pixel;
+    }
+    s->last_row = row;
+}
+
+static void scroll_to_slot(void)
+{
+#if ST7735_SCROLL_REVERSED
+    // The first line of the scroll area is the rightmost column: the newest
+    ST7735_SetScrollStart(memory_line(chart.x + slot));
+#else
+    // The first line is the leftmost column: the oldest, next to be replaced
+    ST7735_SetScrollStart(memory_line(chart.x + (slot + 1) % chart.w));
+#endif
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+bool display_chart_open(const display_chart_config_t *config)
+{
+    if (config == NULL || config->w < 2 || config->x + config->w > ST7735_WIDTH) {
+        return false;
+    }
+
+    chart = *config;
+    memset(series, 0, sizeof(series));
+    slot = 0;
+
+    ST7735_FillRectangleFast(chart.x, 0, chart.w, ST7735_HEIGHT, chart.bg_color);
+
+    if (ST7735_SCROLL_HORIZONTAL) {
+        // Lines outside the strip stay fixed
+#if ST7735_SCROLL_REVERSED
+        uint16_t top_fixed = memory_line(chart.x + chart.w - 1);
+#else
+        uint16_t top_fixed = memory_line(chart.x);
+#endif
+        ST7735_SetScrollArea(top_fixed, chart.w, ST7735_FRAME_LINES - top_fixed - chart.w);
+        scroll_to_slot();
+    }
+
+    chart_open = true;
+    return true;
+}
+
+bool display_chart_set_series(uint8_t index, uint16_t color, float min, float max)
+{
+    if (index >= DISPLAY_CHART_MAX_SERIES || !(max > min)) {
+        return false;
+    }
+
+    chart_series_t *s = &series[index];
+    s->enabled = true;
+    s->pixel = to_panel(color);
+    s->min = min;
+    s->scale = (float)(ST7735_HEIGHT - 1) / (max - min);
+    s->last_row = -1;
+    return true;
+}
+
+void display_chart_push(const float *values)
+{
+    if (!chart_open || values == NULL) {
+        return;
+    }
+
+    column_background();
+    for (uint8_t i = 0; i < DISPLAY_CHART_MAX_SERIES; i++) {
+        column_plot(&series[i], values[i]);
+    }
+    ST7735_DrawImage(chart.x + slot, 0, 1, ST7735_HEIGHT, column);
+
+    if (ST7735_SCROLL_HORIZONTAL) {
+        scroll_to_slot();
+    } else {
+        // Sweep: blank the column ahead so the newest one stands out
+        column_background();
+        ST7735_DrawImage(chart.x + (slot + 1) % chart.w, 0, 1, ST7735_HEIGHT, column);
+    }
+    slot = (slot + 1) % chart.w;
+}
+
+bool display_chart_hw_scroll(void)
+{
+    return chart_open && ST7735_SCROLL_HORIZONTAL;
+}
+
+void display_chart_close(void)
+{
+    if (!chart_open) {
+        return;
+    }
+
+    if (ST7735_SCROLL_HORIZONTAL) {
+        // Whole frame memory as one unscrolled area
+        ST7735_SetScrollArea(0, ST7735_FRAME_LINES, 0);
+        ST7735_SetScrollStart(0);
+    }
+    chart_open = false;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file display_chart.h
+ * @brief Scrolling live chart on the ST7735, one SPI column per sample
+ *
+ * The chart occupies a strip of screen columns over the full height. Each
+ * display_chart_push() draws only the newest column (background, grid and
+ * a line from each series' previous value to its new one) and then moves
+ * the panel's vertical scroll start (VSCRDEF / VSCRSADD) by one line, so
+ * the older columns shift without being resent. A sample costs one
+ * ST7735_HEIGHT x 1 transfer and a 2-byte command, which leaves room for
+ * hundreds of samples per second.
+ *
+ * Hardware scrolling needs a rotation where frame memory lines are screen
+ * columns (ST7735_SCROLL_HORIZONTAL). Otherwise the chart sweeps instead:
+ * columns are overwritten left to right, with a blank column ahead of the
+ * newest one.
+ *
+ * The scroll area covers the strip's whole height, so nothing else may be
+ * drawn in those columns while the chart is open. There is one chart at a
+ * time (the scroll registers are global). Not thread safe: push and close
+ * from the task that draws to the panel.
+ *
+ * Usage example:
+ * @code
+ * display_chart_config_t chart = { 0, ST7735_WIDTH, ST7735_BLACK, DISPLAY_CHART_GRID_COLOR, 20 };
+ * display_chart_open(&chart);
+ * display_chart_set_series(0, ST7735_YELLOW, 0.0f, 500.0f);
+ * float values[DISPLAY_CHART_MAX_SERIES] = { current_mA, NAN };   // NAN: gap
+ * display_chart_push(values);
+ * @endcode
+ */
+
+#ifndef DISPLAY_CHART_H
+#define DISPLAY_CHART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "main.h"      // st7735.h needs the HAL types
+#include "st7735.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define DISPLAY_CHART_MAX_SERIES    2
+#define DISPLAY_CHART_GRID_COLOR    ST7735_COLOR565(40, 40, 40)
+
+// ============================================================================
+// Types
+// ============================================================================
+
+typedef struct {
+    uint16_t x;                 // First screen column of the strip
+    uint16_t w;                 // Columns (samples on screen)
+    uint16_t bg_color;
+    uint16_t grid_color;
+    uint16_t grid_step;         // Rows between horizontal grid lines, 0 for none
+} display_chart_config_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Clear the strip and set up the scroll area
+ * @return false if the strip does not fit the screen
+ */
+bool display_chart_open(const display_chart_config_t *config);
+
+/**
+ * @brief Enable a series, drawn from min (bottom row) to max (top row)
+ *
+ * display_chart_open() disables all series.
+ */
+bool display_chart_set_series(uint8_t series, uint16_t color, float min, float max);
+
+/**
+ * @brief Append one column
+ * @param values DISPLAY_CHART_MAX_SERIES values; NAN leaves a gap
+ */
+void display_chart_push(const float *values);
+
+/**
+ * @brief Whether the open chart scrolls in hardware (false: sweep mode)
+ */
+bool display_chart_hw_scroll(void);
+
+/**
+ * @brief Restore the unscrolled screen; the strip keeps the last columns
+ *        in memory order until redrawn
+ */
+void display_chart_close(void);
+
+#endif // DISPLAY_CHART_H
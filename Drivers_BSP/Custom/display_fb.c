@@ -0,0 +1,304 @@
+/**
+ * @file display_fb.c
+ * @brief RAM framebuffer with dirty-rectangle flushing for the ST7735
+ */
+
+#include "display_fb.h"
+#include "hal_mem.h"
+#if DISPLAY_FB_USE_DMA2D
+#include "hal_dma2d.h"
+#endif
+#include <string.h>
+
+// Pixels are stored byte swapped (panel order), so a run of them can be
+// handed to ST7735_DrawImage() as is. Line aligned: DMA2D writes both.
+static uint16_t framebuffer[ST7735_HEIGHT][ST7735_WIDTH] __attribute__((aligned(HAL_CACHE_LINE_SIZE)));
+static uint16_t flush_buffer[DISPLAY_FB_FLUSH_PIXELS] __attribute__((aligned(HAL_CACHE_LINE_SIZE)));
+
+static display_fb_rect_t dirty[DISPLAY_FB_MAX_DIRTY];
+static uint32_t dirty_count = 0;
+
+// Bounding box of changed pixels, inclusive; empty while x1 < x0
+typedef struct {
+    int32_t x0, y0, x1, y1;
+} change_box_t;
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static inline uint16_t to_panel(uint16_t color)
+{
+    return (uint16_t)((color >> 8) | (color << 8));
+}
+
+static inline void box_reset(change_box_t *box)
+{
+    box->x0 = ST7735_WIDTH;
+    box->y0 = ST7735_HEIGHT;
+    box->x1 = -1;
+    box->y1 = -1;
+}
+
+static inline void put_pixel(int32_t x, int32_t y, uint16_t pixel, change_box_t *box)
+{
+    if (x < 0 || y < 0 || x >= ST7735_WIDTH || y >= ST7735_HEIGHT || framebuffer[y][x] == pixel) {
+        return;
+    }
+    framebuffer[y][x] = pixel;
+    if (x < box->x0) box->x0 = x;
+    if (x > box->x1) box->x1 = x;
+    if (y < box->y0) box->y0 = y;
+    if (y > box->y1) box->y1 = y;
+}
+
+// Everything inside the rectangle counts as changed
+static inline void box_add_rect(change_box_t *box, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    if (x < box->x0) box->x0 = x;
+    if (x + w - 1 > box->x1) box->x1 = x + w - 1;
+    if (y < box->y0) box->y0 = y;
+    if (y + h - 1 > box->y1) box->y1 = y + h - 1;
+}
+
+// Whole rectangle on screen
+static inline bool rect_on_screen(uint32_t x, uint32_t y, uint32_t w, uint32_t h)
+{
+    return w > 0 && h > 0 && x + w <= ST7735_WIDTH && y + h <= ST7735_HEIGHT;
+}
+
+/**
+ * @brief Copy a block of panel-order pixels in with the blitter
+ * @return false if the CPU has to do it (blitter off, or not fully on screen)
+ */
+static bool blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *pixels,
+                 change_box_t *box)
+{
+#if DISPLAY_FB_USE_DMA2D
+    if (rect_on_screen(x, y, w, h) &&
+        hal_dma2d_copy(&framebuffer[y][x], ST7735_WIDTH, pixels, w, w, h)) {
+        // No per-pixel compare: the whole block is resent
+        box_add_rect(box, x, y, w, h);
+        return true;
+    }
+#endif
+    (void)x; (void)y; (void)w; (void)h; (void)pixels; (void)box;
+    return false;
+}
+
+static uint32_t rect_area(const display_fb_rect_t *r)
+{
+    return (uint32_t)r->w * r->h;
+}
+
+static display_fb_rect_t rect_union(const display_fb_rect_t *a, const display_fb_rect_t *b)
+{
+    uint16_t x0 = (a->x < b->x) ? a->x : b->x;
+    uint16_t y0 = (a->y < b->y) ? a->y : b->y;
+    uint16_t x1 = (a->x + a->w > b->x + b->w) ? a->x + a->w : b->x + b->w;
+    uint16_t y1 = (a->y + a->h > b->y + b->h) ? a->y + a->h : b->y + b->h;
+    display_fb_rect_t r = { x0, y0, (uint16_t)(x1 - x0), (uint16_t)(y1 - y0) };
+    return r;
+}
+
+// Overlapping or touching
+static bool rect_meets(const display_fb_rect_t *a, const display_fb_rect_t *b)
+{
+    return a->x <= b->x + b->w && b->x <= a->x + a->w &&
+           a->y <= b->y + b->h && b->y <= a->y + a->h;
+}
+
+static void mark_dirty(const change_box_t *box)
+{
+    if (box->x1 < box->x0) {
+        return;
+    }
+
+    display_fb_rect_t r = {
+        (uint16_t)box->x0, (uint16_t)box->y0,
+        (uint16_t)(box->x1 - box->x0 + 1), (uint16_t)(box->y1 - box->y0 + 1)
+    };
+
+    for (;;) {
+        // Absorb everything it meets; a union can meet further rectangles
+        bool merged = false;
+        for (uint32_t i = 0; i < dirty_count; i++) {
+            if (rect_meets(&dirty[i], &r)) {
+                r = rect_union(&dirty[i], &r);
+                dirty[i] = dirty[--dirty_count];
+                merged = true;
+                break;
+            }
+        }
+        if (merged) {
+            continue;
+        }
+        if (dirty_count < DISPLAY_FB_MAX_DIRTY) {
+            break;
+        }
+
+        // List full: merge with the rectangle that grows least
+        uint32_t best = 0;
+        uint32_t best_growth = UINT32_MAX;
+        for (uint32_t i = 0; i < dirty_count; i++) {
+            display_fb_rect_t u = rect_union(&dirty[i], &r);
+            uint32_t growth = rect_area(&u) - rect_area(&dirty[i]);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        r = rect_union(&dirty[best], &r);
+        dirty[best] = dirty[--dirty_count];
+    }
+
+    dirty[dirty_count++] = r;
+}
+
+static void draw_glyph(uint16_t x, uint16_t y, char ch, FontDef font, uint16_t color,
+                       uint16_t bgcolor, change_box_t *box)
+{
+    // Cached for digits and units, already in panel order
+    const uint16_t *pixels = ST7735_RenderGlyph(ch, font, color, bgcolor);
+
+    if (blit(x, y, font.width, font.height, pixels, box)) {
+        return;
+    }
+    for (uint32_t i = 0; i < font.height; i++) {
+        for (uint32_t j = 0; j < font.width; j++) {
+            put_pixel(x + j, y + i, *pixels++, box);
+        }
+    }
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+void display_fb_init(uint16_t color)
+{
+    uint16_t pixel = to_panel(color);
+
+#if DISPLAY_FB_USE_DMA2D
+    if (hal_dma2d_init() &&
+        hal_dma2d_fill(&framebuffer[0][0], ST7735_WIDTH, ST7735_WIDTH, ST7735_HEIGHT, pixel)) {
+        dirty[0] = (display_fb_rect_t){ 0, 0, ST7735_WIDTH, ST7735_HEIGHT };
+        dirty_count = 1;
+        return;
+    }
+#endif
+    for (uint32_t y = 0; y < ST7735_HEIGHT; y++) {
+        for (uint32_t x = 0; x < ST7735_WIDTH; x++) {
+            framebuffer[y][x] = pixel;
+        }
+    }
+
+    dirty[0] = (display_fb_rect_t){ 0, 0, ST7735_WIDTH, ST7735_HEIGHT };
+    dirty_count = 1;
+}
+
+void display_fb_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    uint16_t pixel = to_panel(color);
+    change_box_t box;
+
+    box_reset(&box);
+#if DISPLAY_FB_USE_DMA2D
+    uint16_t cw = (x < ST7735_WIDTH) ? ((x + w > ST7735_WIDTH) ? ST7735_WIDTH - x : w) : 0;
+    uint16_t ch = (y < ST7735_HEIGHT) ? ((y + h > ST7735_HEIGHT) ? ST7735_HEIGHT - y : h) : 0;
+    if (rect_on_screen(x, y, cw, ch) &&
+        hal_dma2d_fill(&framebuffer[y][x], ST7735_WIDTH, cw, ch, pixel)) {
+        box_add_rect(&box, x, y, cw, ch);
+        mark_dirty(&box);
+        return;
+    }
+#endif
+    for (uint32_t row = y; row < (uint32_t)y + h && row < ST7735_HEIGHT; row++) {
+        for (uint32_t col = x; col < (uint32_t)x + w && col < ST7735_WIDTH; col++) {
+            put_pixel(col, row, pixel, &box);
+        }
+    }
+    mark_dirty(&box);
+}
+
+void display_fb_write_string(uint16_t x, uint16_t y, const char *str, FontDef font,
+                             uint16_t color, uint16_t bgcolor)
+{
+    change_box_t box;
+
+    box_reset(&box);
+    while (*str) {
+        if (x + font.width >= ST7735_WIDTH) {
+            x = 0;
+            y += font.height;
+            if (y + font.height >= ST7735_HEIGHT) {
+                break;
+            }
+
+            if (*str == ' ') {
+                // skip spaces in the beginning of the new line
+                str++;
+                continue;
+            }
+        }
+
+        draw_glyph(x, y, *str, font, color, bgcolor, &box);
+        x += font.width;
+        str++;
+    }
+    mark_dirty(&box);
+}
+
+void display_fb_draw_image(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data)
+{
+    change_box_t box;
+
+    box_reset(&box);
+    if (!blit(x, y, w, h, data, &box)) {
+        for (uint32_t i = 0; i < h; i++) {
+            for (uint32_t j = 0; j < w; j++) {
+                put_pixel(x + j, y + i, data[i * w + j], &box);
+            }
+        }
+    }
+    mark_dirty(&box);
+}
+
+bool display_fb_is_dirty(void)
+{
+    return dirty_count > 0;
+}
+
+uint32_t display_fb_flush(void)
+{
+    uint32_t sent = 0;
+
+    for (uint32_t i = 0; i < dirty_count; i++) {
+        const display_fb_rect_t *r = &dirty[i];
+
+        if (r->w == ST7735_WIDTH) {
+            // Full rows are contiguous in the framebuffer
+            ST7735_DrawImage(0, r->y, r->w, r->h, &framebuffer[r->y][0]);
+        } else {
+            // Pack rows into the staging buffer, in bands that fit it
+            uint16_t band = DISPLAY_FB_FLUSH_PIXELS / r->w;
+            for (uint16_t y = r->y; y < r->y + r->h; y += band) {
+                uint16_t rows = (r->y + r->h - y < band) ? (r->y + r->h - y) : band;
+#if DISPLAY_FB_USE_DMA2D
+                if (hal_dma2d_copy(flush_buffer, r->w, &framebuffer[y][r->x], ST7735_WIDTH, r->w, rows)) {
+                    ST7735_DrawImage(r->x, y, r->w, rows, flush_buffer);
+                    continue;
+                }
+#endif
+                for (uint16_t row = 0; row < rows; row++) {
+                    memcpy(&flush_buffer[row * r->w], &framebuffer[y + row][r->x], r->w * sizeof(uint16_t));
+                }
+                ST7735_DrawImage(r->x, y, r->w, rows, flush_buffer);
+            }
+        }
+        sent += rect_area(r);
+    }
+
+    dirty_count = 0;
+    return sent;
+}
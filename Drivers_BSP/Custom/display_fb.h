@@ -0,0 +1,101 @@
+/**
+ * @file display_fb.h
+ * @brief RAM framebuffer with dirty-rectangle flushing for the ST7735
+ *
+ * Drawing goes into a full-screen RAM copy (2 bytes per pixel, already in
+ * the panel's byte order) instead of straight to the panel. Primitives
+ * compare against what is there and only record the bounding box of the
+ * pixels that actually changed, so redrawing "23.45 C" as "23.46 C" marks
+ * one glyph dirty. display_fb_flush() then sends each dirty rectangle
+ * with a single address window and one (DMA) transfer.
+ *
+ * Up to DISPLAY_FB_MAX_DIRTY rectangles are tracked; a new one is merged
+ * into an overlapping one, or when the list is full into the one whose
+ * bounding box grows least. Rectangles larger than the flush buffer are
+ * sent in row bands that fit.
+ *
+ * With DISPLAY_FB_USE_DMA2D, fills, glyphs, images and the flush packing
+ * are done by the DMA2D engine (hal_dma2d.h) instead of CPU loops. The
+ * engine writes without comparing, so a fill, glyph or image block is marked
+ * dirty as a whole; callers that only redraw changed characters (as
+ * ips_display_write_field() does) lose nothing by that.
+ *
+ * Not thread safe: draw and flush from one task.
+ *
+ * Usage example:
+ * @code
+ * display_fb_init(ST7735_BLACK);
+ * display_fb_write_string(80, 10, text, Font_11x18, ST7735_WHITE, ST7735_BLACK);
+ * display_fb_flush();
+ * @endcode
+ */
+
+#ifndef DISPLAY_FB_H
+#define DISPLAY_FB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "main.h"      // st7735.h needs the HAL types
+#include "st7735.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define DISPLAY_FB_MAX_DIRTY        4
+#define DISPLAY_FB_FLUSH_PIXELS     (ST7735_WIDTH * 32)  // Staging for one transfer
+
+#ifndef DISPLAY_FB_USE_DMA2D
+#define DISPLAY_FB_USE_DMA2D        1
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+} display_fb_rect_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Clear the framebuffer to a color and mark the whole screen dirty
+ */
+void display_fb_init(uint16_t color);
+
+/**
+ * @brief Fill a rectangle (clipped to the screen)
+ */
+void display_fb_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+
+/**
+ * @brief Draw a string, wrapping like ST7735_WriteString()
+ */
+void display_fb_write_string(uint16_t x, uint16_t y, const char *str, FontDef font,
+                             uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Copy an image in, pixels in panel order as for ST7735_DrawImage()
+ *        (clipped to the screen)
+ */
+void display_fb_draw_image(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data);
+
+/**
+ * @brief Check whether anything is waiting to be flushed
+ */
+bool display_fb_is_dirty(void);
+
+/**
+ * @brief Send the dirty rectangles to the panel
+ *
+ * @return Pixels sent
+ */
+uint32_t display_fb_flush(void);
+
+#endif // DISPLAY_FB_H
@@ -0,0 +1,396 @@
+/**
+ * @file display_ui.c
+ * @brief Retained widgets for the ST7735: text, fixed-point numbers, bars, sparklines
+ */
+
+#include "display_ui.h"
+#include "fixed_format.h"
+#if DISPLAY_UI_USE_FRAMEBUFFER
+#include "display_fb.h"
+#endif
+#include <string.h>
+
+typedef enum {
+    WIDGET_TEXT = 0,
+    WIDGET_BAR,
+    WIDGET_SPARK
+} widget_type_t;
+
+typedef struct {
+    char text[DISPLAY_UI_TEXT_LEN];
+    char shown[DISPLAY_UI_TEXT_LEN];   // What the screen holds
+    const uint16_t *font_data;         // FontDef has a const member: kept apart
+    const uint8_t *font_bits;
+    const uint16_t *font_offsets;
+    const char *font_chars;
+    uint8_t font_width;
+    uint8_t font_format;
+} text_state_t;
+
+typedef struct {
+    int32_t min;
+    int32_t max;
+    uint16_t length;                    // Filled pixels wanted
+    uint16_t shown;                     // Filled pixels on screen
+} bar_state_t;
+
+typedef struct {
+    int32_t min;
+    int32_t max;
+    uint8_t rows[DISPLAY_UI_SPARK_POINTS];  // Ring of w rows above the bottom
+    uint8_t head;                       // Oldest point
+    uint8_t count;
+} spark_state_t;
+
+typedef struct {
+    widget_type_t type;
+    bool dirty;
+    bool full;                          // Redraw everything, not just the change
+    uint16_t x, y, w, h;
+    uint16_t color;
+    uint16_t bgcolor;
+    union {
+        text_state_t text;
+        bar_state_t bar;
+        spark_state_t spark;
+    };
+} widget_t;
+
+static widget_t widgets[DISPLAY_UI_MAX_WIDGETS];
+static uint8_t widget_count = 0;
+
+// One sparkline column, panel order
+static uint16_t column[ST7735_HEIGHT];
+
+// ============================================================================
+// Drawing Backend
+// ============================================================================
+
+static void ui_fill(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    if (w == 0 || h == 0) {
+        return;
+    }
+#if DISPLAY_UI_USE_FRAMEBUFFER
+    display_fb_fill_rect(x, y, w, h, color);
+#else
+    ST7735_FillRectangleFast(x, y, w, h, color);
+#endif
+}
+
+static void ui_char(uint16_t x, uint16_t y, char ch, FontDef font, uint16_t color, uint16_t bgcolor)
+{
+    char one[2] = { ch, '\0' };
+#if DISPLAY_UI_USE_FRAMEBUFFER
+    display_fb_write_string(x, y, one, font, color, bgcolor);
+#else
+    ST7735_WriteString(x, y, one, font, color, bgcolor);
+#endif
+}
+
+static void ui_column(uint16_t x, uint16_t y, uint16_t h, const uint16_t *pixels)
+{
+#if DISPLAY_UI_USE_FRAMEBUFFER
+    display_fb_draw_image(x, y, 1, h, pixels);
+#else
+    ST7735_DrawImage(x, y, 1, h, pixels);
+#endif
+}
+
+static void ui_flush(void)
+{
+#if DISPLAY_UI_USE_FRAMEBUFFER
+    display_fb_flush();
+#endif
+}
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static inline uint16_t to_panel(uint16_t color)
+{
+    return (uint16_t)((color >> 8) | (color << 8));
+}
+
+static widget_t *widget_get(display_ui_id_t id, widget_type_t type)
+{
+    return (id < widget_count && widgets[id].type == type) ? &widgets[id] : NULL;
+}
+
+static widget_t *widget_new(widget_type_t type, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                            uint16_t color, uint16_t bgcolor, display_ui_id_t *id)
+{
+    if (widget_count >= DISPLAY_UI_MAX_WIDGETS) {
+        *id = DISPLAY_UI_INVALID;
+        return NULL;
+    }
+
+    *id = widget_count;
+    widget_t *widget = &widgets[widget_count++];
+    memset(widget, 0, sizeof(*widget));
+    widget->type = type;
+    widget->dirty = true;
+    widget->full = true;
+    widget->x = x;
+    widget->y = y;
+    widget->w = w;
+    widget->h = h;
+    widget->color = color;
+    widget->bgcolor = bgcolor;
+    return widget;
+}
+
+// Scale value in min..max to 0..span (clamped)
+static uint32_t scale(int32_t value, int32_t min, int32_t max, uint32_t span)
+{
+    if (value <= min) {
+        return 0;
+    }
+    if (value >= max) {
+        return span;
+    }
+    return (uint32_t)(((int64_t)(value - min) * span) / ((int64_t)max - min));
+}
+
+/**
+ * @brief Draw the characters that differ from what is shown, blanking the
+ *        tail of a longer previous text
+ */
+static void render_text(widget_t *widget)
+{
+    text_state_t *t = &widget->text;
+    const FontDef font = { t->font_width, (uint8_t)widget->h, t->font_data, t->font_format,
+                           t->font_chars, t->font_bits, t->font_offsets };
+    if (widget->full) {
+        t->shown[0] = '\0';
+    }
+
+    size_t len = strlen(t->text);
+    size_t shown_len = strlen(t->shown);
+    size_t end = (len > shown_len) ? len : shown_len;
+    uint16_t x = widget->x;
+
+    for (size_t i = 0; i < end; i++, x += font.width) {
+        // Same clipping as ST7735_WriteString(), without its wrap
+        if (x + font.width >= ST7735_WIDTH) {
+            break;
+        }
+        char ch = (i < len) ? t->text[i] : ' ';
+        char was = (i < shown_len) ? t->shown[i] : '\0';
+        if (ch != was) {
+            ui_char(x, widget->y, ch, font, widget->color, widget->bgcolor);
+        }
+    }
+    memcpy(t->shown, t->text, len + 1);
+}
+
+static void render_bar(widget_t *widget)
+{
+    bar_state_t *b = &widget->bar;
+    uint16_t from = widget->full ? 0 : b->shown;
+    uint16_t to = b->length;
+
+    if (widget->full) {
+        ui_fill(widget->x, widget->y, to, widget->h, widget->color);
+        ui_fill(widget->x + to, widget->y, widget->w - to, widget->h, widget->bgcolor);
+    } else if (to > from) {
+        ui_fill(widget->x + from, widget->y, to - from, widget->h, widget->color);
+    } else {
+        ui_fill(widget->x + to, widget->y, from - to, widget->h, widget->bgcolor);
+    }
+    b->shown = to;
+}
+
+// Every column moves on each push, so the whole sparkline is redrawn
+static void render_spark(widget_t *widget)
+{
+    spark_state_t *s = &widget->spark;
+    uint16_t bg = to_panel(widget->bgcolor);
+    uint16_t fg = to_panel(widget->color);
+    uint32_t blank = widget->w - s->count;     // Columns before the oldest point
+    int32_t previous = -1;
+
+    for (uint32_t c = 0; c < widget->w; c++) {
+        for (uint32_t r = 0; r < widget->h; r++) {
+            column[r] = bg;
+        }
+        if (c >= blank) {
+            // Top row first in the column; joined to the previous point
+            int32_t row = (int32_t)widget->h - 1 - s->rows[(s->head + c - blank) % widget->w];
+            int32_t from = (previous >= 0) ? previous : row;
+            int32_t lo = (from < row) ? from : row;
+            int32_t hi = (from < row) ? row : from;
+            for (int32_t r = lo; r <= hi; r++) {
+                column[r] = fg;
+            }
+            previous = row;
+        }
+        ui_column(widget->x + c, widget->y, widget->h, column);
+    }
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+void display_ui_init(uint16_t bg_color)
+{
+    widget_count = 0;
+#if DISPLAY_UI_USE_FRAMEBUFFER
+    display_fb_init(bg_color);
+#else
+    ST7735_FillScreen(bg_color);
+#endif
+}
+
+display_ui_id_t display_ui_add_text(uint16_t x, uint16_t y, const char *text, FontDef font,
+                                    uint16_t color, uint16_t bgcolor)
+{
+    display_ui_id_t id;
+    widget_t *widget = widget_new(WIDGET_TEXT, x, y, 0, font.height, color, bgcolor, &id);
+    if (widget != NULL) {
+        widget->text.font_data = font.data;
+        widget->text.font_bits = font.bits;
+        widget->text.font_offsets = font.offsets;
+        widget->text.font_chars = font.chars;
+        widget->text.font_width = font.width;
+        widget->text.font_format = font.format;
+        display_ui_set_text(id, text);
+    }
+    return id;
+}
+
+display_ui_id_t display_ui_add_bar(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                                   int32_t min, int32_t max, uint16_t color, uint16_t bgcolor)
+{
+    display_ui_id_t id = DISPLAY_UI_INVALID;
+    if (max <= min || w == 0 || h == 0) {
+        return id;
+    }
+
+    widget_t *widget = widget_new(WIDGET_BAR, x, y, w, h, color, bgcolor, &id);
+    if (widget != NULL) {
+        widget->bar.min = min;
+        widget->bar.max = max;
+    }
+    return id;
+}
+
+display_ui_id_t display_ui_add_spark(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                                     int32_t min, int32_t max, uint16_t color, uint16_t bgcolor)
+{
+    display_ui_id_t id = DISPLAY_UI_INVALID;
+    if (max <= min || w == 0 || w > DISPLAY_UI_SPARK_POINTS || h == 0 || h > ST7735_HEIGHT) {
+        return id;
+    }
+
+    widget_t *widget = widget_new(WIDGET_SPARK, x, y, w, h, color, bgcolor, &id);
+    if (widget != NULL) {
+        widget->spark.min = min;
+        widget->spark.max = max;
+    }
+    return id;
+}
+
+void display_ui_set_text(display_ui_id_t id, const char *text)
+{
+    widget_t *widget = widget_get(id, WIDGET_TEXT);
+    if (widget == NULL || text == NULL) {
+        return;
+    }
+
+    text_state_t *t = &widget->text;
+    size_t len = strlen(text);
+    if (len > sizeof(t->text) - 1) {
+        len = sizeof(t->text) - 1;
+    }
+    if (strncmp(t->text, text, len) == 0 && t->text[len] == '\0') {
+        return;     // Unchanged, no SPI traffic
+    }
+    memcpy(t->text, text, len);
+    t->text[len] = '\0';
+    widget->dirty = true;
+}
+
+void display_ui_set_fixed(display_ui_id_t id, int32_t value, uint8_t decimals, const char *suffix)
+{
+    char text[DISPLAY_UI_TEXT_LEN];
+
+    // Integer formatting, no float printf
+    fixed_format(text, sizeof(text), value, decimals, suffix);
+    display_ui_set_text(id, text);
+}
+
+void display_ui_set_bar(display_ui_id_t id, int32_t value)
+{
+    widget_t *widget = widget_get(id, WIDGET_BAR);
+    if (widget == NULL) {
+        return;
+    }
+
+    uint16_t length = (uint16_t)scale(value, widget->bar.min, widget->bar.max, widget->w);
+    if (length != widget->bar.length) {
+        widget->bar.length = length;
+        widget->dirty = true;
+    }
+}
+
+void display_ui_push_spark(display_ui_id_t id, int32_t value)
+{
+    widget_t *widget = widget_get(id, WIDGET_SPARK);
+    if (widget == NULL) {
+        return;
+    }
+
+    spark_state_t *s = &widget->spark;
+    uint8_t row = (uint8_t)scale(value, s->min, s->max, widget->h - 1U);
+    if (s->count < widget->w) {
+        s->rows[(s->head + s->count) % widget->w] = row;
+        s->count++;
+    } else {
+        s->rows[s->head] = row;
+        s->head = (uint8_t)((s->head + 1) % widget->w);
+    }
+    widget->dirty = true;
+}
+
+void display_ui_invalidate(void)
+{
+    for (uint8_t i = 0; i < widget_count; i++) {
+        widgets[i].dirty = true;
+        widgets[i].full = true;
+    }
+}
+
+uint32_t display_ui_render(void)
+{
+    uint32_t drawn = 0;
+
+    for (uint8_t i = 0; i < widget_count; i++) {
+        widget_t *widget = &widgets[i];
+        if (!widget->dirty) {
+            continue;
+        }
+
+        switch (widget->type) {
+            case WIDGET_TEXT:
+                render_text(widget);
+                break;
+            case WIDGET_BAR:
+                render_bar(widget);
+                break;
+            case WIDGET_SPARK:
+                render_spark(widget);
+                break;
+        }
+        widget->dirty = false;
+        widget->full = false;
+        drawn++;
+    }
+
+    if (drawn > 0) {
+        ui_flush();
+    }
+    return drawn;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file display_ui.h
+ * @brief Retained widgets for the ST7735: text, fixed-point numbers, bars, sparklines
+ *
+ * Screens are built once from widgets; later updates only change a
+ * widget's value and set its dirty flag when the visible result differs
+ * (same text, same bar length: nothing to do). display_ui_render() then
+ * redraws the dirty widgets, each doing the least it can: a text widget
+ * redraws only the characters that changed, a bar only the stretch
+ * between its old and new end. With the framebuffer the pass ends in one
+ * display_fb_flush(), which merges adjacent dirty regions into as few
+ * SPI windows as it can.
+ *
+ * Not thread safe: build, update and render from one task.
+ *
+ * Usage example:
+ * @code
+ * display_ui_init(ST7735_BLACK);
+ * display_ui_add_text(10, 10, "Temp: ", Font_11x18, ST7735_WHITE, ST7735_BLACK);
+ * display_ui_id_t temp = display_ui_add_text(80, 10, "", Font_11x18, ST7735_WHITE, ST7735_BLACK);
+ * display_ui_id_t load = display_ui_add_bar(10, 60, 140, 6, 0, 100, ST7735_GREEN, ST7735_BLACK);
+ * ...
+ * display_ui_set_fixed(temp, 2345, 2, " C");      // "23.45 C"
+ * display_ui_set_bar(load, 42);
+ * display_ui_render();
+ * @endcode
+ */
+
+#ifndef DISPLAY_UI_H
+#define DISPLAY_UI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "main.h"      // st7735.h needs the HAL types
+#include "st7735.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+// Draw into the RAM framebuffer (display_fb.h, ~50 KB) and flush only the
+// changed pixels; 0 draws each widget straight to the panel
+#ifndef DISPLAY_UI_USE_FRAMEBUFFER
+#define DISPLAY_UI_USE_FRAMEBUFFER  1
+#endif
+
+#define DISPLAY_UI_MAX_WIDGETS      12
+#define DISPLAY_UI_TEXT_LEN         16      // Including the terminator
+#define DISPLAY_UI_SPARK_POINTS     64      // Widest sparkline, in columns
+
+// ============================================================================
+// Types
+// ============================================================================
+
+typedef uint8_t display_ui_id_t;
+
+#define DISPLAY_UI_INVALID          ((display_ui_id_t)0xFF)
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Drop all widgets and clear the screen to a color
+ */
+void display_ui_init(uint16_t bg_color);
+
+/**
+ * @brief Add a text widget (also for numbers, see display_ui_set_fixed())
+ * @return Widget id, or DISPLAY_UI_INVALID if the table is full
+ */
+display_ui_id_t display_ui_add_text(uint16_t x, uint16_t y, const char *text, FontDef font,
+                                    uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Add a horizontal bar showing min..max over w pixels
+ */
+display_ui_id_t display_ui_add_bar(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                                   int32_t min, int32_t max, uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Add a sparkline: the last w values, min on the bottom row
+ * @param w Columns, at most DISPLAY_UI_SPARK_POINTS
+ */
+display_ui_id_t display_ui_add_spark(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                                     int32_t min, int32_t max, uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Set a text widget's text (truncated to DISPLAY_UI_TEXT_LEN - 1)
+ */
+void display_ui_set_text(display_ui_id_t id, const char *text);
+
+/**
+ * @brief Set a text widget to value / 10^decimals plus suffix (fixed_format())
+ */
+void display_ui_set_fixed(display_ui_id_t id, int32_t value, uint8_t decimals, const char *suffix);
+
+/**
+ * @brief Set a bar's value (clamped to its range)
+ */
+void display_ui_set_bar(display_ui_id_t id, int32_t value);
+
+/**
+ * @brief Append a value to a sparkline, dropping its oldest
+ */
+void display_ui_push_spark(display_ui_id_t id, int32_t value);
+
+/**
+ * @brief Mark every widget for a full redraw (e.g. after the panel slept)
+ */
+void display_ui_invalidate(void);
+
+/**
+ * @brief Redraw the dirty widgets
+ * @return Widgets redrawn
+ */
+uint32_t display_ui_render(void);
+
+#endif // DISPLAY_UI_H
@@ -1,5 +1,8 @@
 #include "ina226.h"
 #include "pinout.h"
+#include "cycle_probe.h"
+#include "latency_trace.h"
+#include "sysview_trace.h"
 #include <math.h>
 
 ina226_sensor_t default_ina226_sensor = {
@@ -13,15 +16,30 @@ ina226_sensor_t default_ina226_sensor = {
     .current_lsb = 0.0f,
     .calibration_value = 0,
     .alert_flag = false,
-    .data_callback = NULL
+    .alert_work = NULL,
+    .data_callback = NULL,
+    .async_active = false,
+    .async_step = INA226_ASYNC_IDLE,
+    .async_errors = 0,
+    .limit_active = false,
+    .read_fields = INA226_READ_ALL,
+    .pointer_reg = INA226_POINTER_UNKNOWN
 };
 
+static void ina226_async_start_chain(ina226_sensor_t *sensor);
+
+// Settings index these tables (AVG bits 11-9, VBUSCT bits 8-6, VSHCT bits 5-3)
+static const uint16_t ina226_avg_counts[8] = { 1, 4, 16, 64, 128, 256, 512, 1024 };
+static const uint16_t ina226_conv_times_us[8] = { 140, 204, 332, 588, 1100, 2116, 4156, 8244 };
+
 // Helper function to write 16-bit register
 static hal_i2c_status_t ina226_write_register(ina226_sensor_t *sensor, uint8_t reg, uint16_t value) {
     uint8_t data[2];
     data[0] = (value >> 8) & 0xFF;  // MSB first
     data[1] = value & 0xFF;         // LSB second
     
+    // A write also moves the register pointer
+    sensor->pointer_reg = reg;
     return hal_i2c_mem_write(sensor->hi2c, sensor->i2c_address, reg, data, 2, INA226_I2C_TIMEOUT_MS);
 }
 
@@ -30,7 +48,18 @@ static hal_i2c_status_t ina226_read_register(ina226_sensor_t *sensor, uint8_t re
     uint8_t data[2];
     hal_i2c_status_t status;
     
-    status = hal_i2c_mem_read(sensor->hi2c, sensor->i2c_address, reg, data, 2, INA226_I2C_TIMEOUT_MS);
+    // The pointer persists, so re-reading the same register skips the
+    // pointer write and costs a single receive transaction (not while the
+    // interrupt-driven chain may queue reads in between)
+    if (sensor->pointer_reg == reg && !sensor->async_active) {
+        status = hal_i2c_master_receive(sensor->hi2c, sensor->i2c_address, data, 2, INA226_I2C_TIMEOUT_MS);
+    } else {
+        sensor->pointer_reg = INA226_POINTER_UNKNOWN;
+        status = hal_i2c_mem_read(sensor->hi2c, sensor->i2c_address, reg, data, 2, INA226_I2C_TIMEOUT_MS);
+        if (status == HAL_I2C_OK) {
+            sensor->pointer_reg = reg;
+        }
+    }
     if (status == HAL_I2C_OK) {
         *value = ((uint16_t)data[0] << 8) | data[1];
     }
@@ -38,6 +67,45 @@ static hal_i2c_status_t ina226_read_register(ina226_sensor_t *sensor, uint8_t re
     return status;
 }
 
+uint16_t ina226_averaging_count(uint16_t averaging) {
+    return ina226_avg_counts[(averaging & INA226_CONFIG_AVG_MASK) >> 9];
+}
+
+uint32_t ina226_conversion_time_us(uint16_t conv_time, bool is_shunt) {
+    if (is_shunt) {
+        return ina226_conv_times_us[(conv_time & INA226_CONFIG_VSHCT_MASK) >> 3];
+    }
+    return ina226_conv_times_us[(conv_time & INA226_CONFIG_VBUSCT_MASK) >> 6];
+}
+
+uint32_t ina226_conversion_cycle_us(const ina226_config_t *config) {
+    uint32_t per_average = 0;
+    
+    if (config->mode & INA226_CONFIG_MODE_SHUNT_TRIG) {
+        per_average += ina226_conversion_time_us(config->shunt_conv_time, true);
+    }
+    if (config->mode & INA226_CONFIG_MODE_BUS_TRIG) {
+        per_average += ina226_conversion_time_us(config->bus_conv_time, false);
+    }
+    return per_average * ina226_averaging_count(config->averaging);
+}
+
+void ina226_sensor_init(ina226_sensor_t *sensor, uint16_t i2c_address,
+                        hal_gpio_port_t alert_port, hal_gpio_pin_t alert_pin) {
+    *sensor = (ina226_sensor_t){
+        .initialized = true,
+        .active = false,
+        .hi2c = NULL,
+        .i2c_address = i2c_address,
+        .alert_port = alert_port,
+        .alert_pin = alert_pin,
+        .shunt_resistor_ohms = 0.1f,
+        .async_step = INA226_ASYNC_IDLE,
+        .read_fields = INA226_READ_ALL,
+        .pointer_reg = INA226_POINTER_UNKNOWN
+    };
+}
+
 void ina226_init(void) {
     // Basic driver initialization
     // GPIO and I2C peripheral configuration would be done by HAL layer
@@ -46,8 +114,9 @@ void ina226_init(void) {
 }
 
 static hal_i2c_status_t ina226_read_data(ina226_sensor_t *sensor, INA226_Data *data) {
-    uint16_t raw_current, raw_voltage, raw_power;
+    uint16_t raw_current = 0, raw_voltage = 0, raw_power = 0;
     hal_i2c_status_t status;
+    uint8_t fields = sensor->read_fields;
     
     if (!sensor->active) {
         return HAL_I2C_ERROR;
@@ -55,30 +124,41 @@ static hal_i2c_status_t ina226_read_data(ina226_sensor_t *sensor, INA226_Data *d
     
     // Read bus voltage (register 0x02)
     // LSB = 1.25 mV
-    status = ina226_read_register(sensor, INA226_REG_BUS_VOLTAGE, &raw_voltage);
-    if (status != HAL_I2C_OK) {
-        return status;
+    if (fields & INA226_READ_BUS) {
+        status = ina226_read_register(sensor, INA226_REG_BUS_VOLTAGE, &raw_voltage);
+        if (status != HAL_I2C_OK) {
+            return status;
+        }
     }
-    data->voltage_V = (float)raw_voltage * 0.00125f; // Convert to volts
+    data->bus_voltage_raw = raw_voltage;
+    data->voltage_V = (float)raw_voltage * INA226_BUS_VOLTAGE_LSB_V; // Convert to volts
     
     // Read current (register 0x04)
     // Value is in Current_LSB units (can be negative for bidirectional measurements)
-    status = ina226_read_register(sensor, INA226_REG_CURRENT, &raw_current);
-    if (status != HAL_I2C_OK) {
-        return status;
+    if (fields & INA226_READ_CURRENT) {
+        status = ina226_read_register(sensor, INA226_REG_CURRENT, &raw_current);
+        if (status != HAL_I2C_OK) {
+            return status;
+        }
     }
     
     // Handle signed value
     int16_t signed_current = (int16_t)raw_current;
+    data->current_raw = signed_current;
     data->current_mA = (float)signed_current * sensor->current_lsb * 1000.0f; // Convert to mA
     
     // Read power (register 0x03)
     // LSB = 25 * Current_LSB
-    status = ina226_read_register(sensor, INA226_REG_POWER, &raw_power);
-    if (status != HAL_I2C_OK) {
-        return status;
+    if (fields & INA226_READ_POWER) {
+        status = ina226_read_register(sensor, INA226_REG_POWER, &raw_power);
+        if (status != HAL_I2C_OK) {
+            return status;
+        }
+        data->power_mW = (float)raw_power * 25.0f * sensor->current_lsb * 1000.0f; // Convert to mW
+    } else {
+        // Derived, as the device does (|I| x V)
+        data->power_mW = fabsf(data->current_mA) * data->voltage_V;
     }
-    data->power_mW = (float)raw_power * 25.0f * sensor->current_lsb * 1000.0f; // Convert to mW
     
     return HAL_I2C_OK;
 }
@@ -96,6 +176,7 @@ hal_i2c_status_t ina226_open(ina226_sensor_t *sensor, hal_i2c_handle_t hi2c,
     sensor->hi2c = hi2c;
     sensor->shunt_resistor_ohms = shunt_resistor_ohms;
     sensor->data_callback = data_callback;
+    sensor->pointer_reg = INA226_POINTER_UNKNOWN;
     
     // Verify device ID (should be 0x5449 for INA226)
     status = ina226_read_register(sensor, INA226_REG_MANUFACTURER_ID, &device_id);
@@ -139,6 +220,7 @@ hal_i2c_status_t ina226_open(ina226_sensor_t *sensor, hal_i2c_handle_t hi2c,
                       config->bus_conv_time | 
                       config->shunt_conv_time | 
                       config->mode;
+        sensor->read_fields = (config->read_fields != 0) ? config->read_fields : INA226_READ_ALL;
     } else {
         // Use default configuration:
         // - Averaging: 16 samples
@@ -149,6 +231,7 @@ hal_i2c_status_t ina226_open(ina226_sensor_t *sensor, hal_i2c_handle_t hi2c,
                       INA226_CONFIG_VBUSCT_1100US |
                       INA226_CONFIG_VSHCT_1100US |
                       INA226_CONFIG_MODE_SHUNT_BUS_CONT;
+        sensor->read_fields = INA226_READ_ALL;
     }
     
     status = ina226_write_register(sensor, INA226_REG_CONFIG, config_value);
@@ -171,46 +254,17 @@ hal_i2c_status_t ina226_configure(ina226_sensor_t *sensor, const ina226_config_t
                            config->shunt_conv_time | 
                            config->mode;
     
+    sensor->read_fields = (config->read_fields != 0) ? config->read_fields : INA226_READ_ALL;
+    
     // Write configuration to sensor
     return ina226_write_register(sensor, INA226_REG_CONFIG, config_value);
 }
 
 hal_i2c_status_t ina226_read(ina226_sensor_t *sensor, INA226_Data *data) {
-    uint16_t raw_current, raw_voltage, raw_power;
-    hal_i2c_status_t status;
-    
-    if (!sensor->active) {
-        return HAL_I2C_ERROR;
-    }
-    
-    // Read bus voltage (register 0x02)
-    // LSB = 1.25 mV
-    status = ina226_read_register(sensor, INA226_REG_BUS_VOLTAGE, &raw_voltage);
-    if (status != HAL_I2C_OK) {
-        return status;
-    }
-    data->voltage_V = (float)raw_voltage * 0.00125f; // Convert to volts
-    
-    // Read current (register 0x04)
-    // Value is in Current_LSB units (can be negative for bidirectional measurements)
-    status = ina226_read_register(sensor, INA226_REG_CURRENT, &raw_current);
-    if (status != HAL_I2C_OK) {
-        return status;
-    }
-    
-    // Handle signed value
-    int16_t signed_current = (int16_t)raw_current;
-    data->current_mA = (float)signed_current * sensor->current_lsb * 1000.0f; // Convert to mA
-    
-    // Read power (register 0x03)
-    // LSB = 25 * Current_LSB
-    status = ina226_read_register(sensor, INA226_REG_POWER, &raw_power);
-    if (status != HAL_I2C_OK) {
-        return status;
-    }
-    data->power_mW = (float)raw_power * 25.0f * sensor->current_lsb * 1000.0f; // Convert to mW
-    
-    return HAL_I2C_OK;
+    CYCLE_PROBE_BEGIN(CYCLE_PROBE_INA226_READ);
+    hal_i2c_status_t status = ina226_read_data(sensor, data);
+    CYCLE_PROBE_END(CYCLE_PROBE_INA226_READ);
+    return status;
 }
 
 hal_i2c_status_t ina226_close(ina226_sensor_t *sensor) {
@@ -218,6 +272,13 @@ hal_i2c_status_t ina226_close(ina226_sensor_t *sensor) {
         return HAL_I2C_ERROR;
     }
     
+    if (sensor->async_active) {
+        ina226_stop_async(sensor);
+    }
+    if (sensor->limit_active) {
+        ina226_stop_limit_alert(sensor);
+    }
+    
     // Put sensor in power-down mode
     hal_i2c_status_t status = ina226_write_register(sensor, INA226_REG_CONFIG, INA226_CONFIG_MODE_POWERDOWN);
     if (status != HAL_I2C_OK) {
@@ -241,11 +302,31 @@ void ina226_deinit(ina226_sensor_t *sensor) {
 
 void ina226_alert_callback(ina226_sensor_t *sensor) {
     // This function is called from ISR context
-    // Keep it minimal - just set the flag
+    // Keep it minimal - set the flag and defer the read
+    SYSVIEW_TRACE(SYSVIEW_EVT_SENSOR_ALERT);
     sensor->alert_flag = true;
+    if (sensor->alert_work != NULL) {
+        os_work_submit(sensor->alert_work);
+    }
+}
+
+void ina226_set_alert_work(ina226_sensor_t *sensor, os_work_t *work) {
+    sensor->alert_work = work;
 }
 
 void ina226_process_alert(ina226_sensor_t *sensor) {
+    // Async mode: only recover from a missed edge (ALERT still asserted
+    // with no chain running, e.g. after a failed transfer)
+    if (sensor->async_active) {
+        __disable_irq();
+        if (sensor->async_step == INA226_ASYNC_IDLE &&
+            hal_gpio_read_pin(sensor->alert_port, sensor->alert_pin) == HAL_GPIO_PIN_RESET) {
+            ina226_async_start_chain(sensor);
+        }
+        __enable_irq();
+        return;
+    }
+    
     // Check if alert flag is set
     if (sensor->alert_flag) {
         // Clear the flag
@@ -253,9 +334,12 @@ void ina226_process_alert(ina226_sensor_t *sensor) {
         
         // Read sensor data
         INA226_Data data;
+        SYSVIEW_MARK_START(SYSVIEW_MARKER_SENSOR_READ);
         hal_i2c_status_t status = ina226_read_data(sensor, &data);
+        SYSVIEW_MARK_STOP(SYSVIEW_MARKER_SENSOR_READ);
         
         if (status == HAL_I2C_OK) {
+            SYSVIEW_TRACE_U32(SYSVIEW_EVT_SENSOR_SAMPLE, SYSVIEW_SENSOR_INA226);
             // Direct callback for high-frequency data acquisition
             if (sensor->data_callback != NULL) {
                 sensor->data_callback(sensor, &data);
@@ -263,3 +347,245 @@ void ina226_process_alert(ina226_sensor_t *sensor) {
         }
     }
 }
+
+// ========== Interrupt-Driven Acquisition ==========
+
+static void ina226_async_read_next(ina226_sensor_t *sensor, uint8_t step, uint8_t reg);
+
+static void ina226_async_alert_isr(hal_gpio_pin_t pin, void *user_data) {
+    (void)pin;
+    ina226_sensor_t *sensor = (ina226_sensor_t *)user_data;
+    
+    SYSVIEW_TRACE(SYSVIEW_EVT_SENSOR_ALERT);
+    LATENCY_TRACE_MARK(LATENCY_STAGE_TRIGGER);
+
+    // An edge during a chain is picked up when the chain finishes
+    if (sensor->async_active && sensor->async_step == INA226_ASYNC_IDLE) {
+        ina226_async_start_chain(sensor);
+    }
+}
+
+static void ina226_async_complete(hal_i2c_handle_t handle, hal_i2c_status_t status, void *user_data) {
+    (void)handle;
+    ina226_sensor_t *sensor = (ina226_sensor_t *)user_data;
+    
+    if (status != HAL_I2C_OK) {
+        // process_alert() restarts the chain if ALERT stays asserted
+        sensor->async_errors++;
+        sensor->pointer_reg = INA226_POINTER_UNKNOWN;
+        sensor->async_step = INA226_ASYNC_IDLE;
+        return;
+    }
+    
+    uint16_t value = ((uint16_t)sensor->async_rx[0] << 8) | sensor->async_rx[1];
+    
+    switch (sensor->async_step) {
+        case INA226_ASYNC_MASK:
+            // Reading Mask/Enable released ALERT; fetch the conversion
+            sensor->async_bus_raw = 0;
+            if (sensor->read_fields & INA226_READ_BUS) {
+                ina226_async_read_next(sensor, INA226_ASYNC_BUS, INA226_REG_BUS_VOLTAGE);
+                return;
+            }
+            value = 0;
+            /* fall through */
+            
+        case INA226_ASYNC_BUS:
+            sensor->async_bus_raw = value;
+            if (sensor->read_fields & INA226_READ_CURRENT) {
+                ina226_async_read_next(sensor, INA226_ASYNC_CURRENT, INA226_REG_CURRENT);
+                return;
+            }
+            value = 0;
+            /* fall through */
+            
+        case INA226_ASYNC_CURRENT: {
+            INA226_Data data;
+            data.current_raw = (int16_t)value;
+            data.bus_voltage_raw = sensor->async_bus_raw;
+            data.current_mA = (float)data.current_raw * sensor->current_lsb * 1000.0f;
+            data.voltage_V = (float)data.bus_voltage_raw * INA226_BUS_VOLTAGE_LSB_V;
+            data.power_mW = fabsf(data.current_mA) * data.voltage_V;
+            
+            sensor->async_step = INA226_ASYNC_IDLE;
+            SYSVIEW_TRACE_U32(SYSVIEW_EVT_SENSOR_SAMPLE, SYSVIEW_SENSOR_INA226);
+            LATENCY_TRACE_MARK(LATENCY_STAGE_I2C_DONE);
+            
+            if (sensor->data_callback != NULL) {
+                sensor->data_callback(sensor, &data);
+            }
+            
+            // The next conversion may have asserted ALERT while reading
+            if (sensor->async_active &&
+                hal_gpio_read_pin(sensor->alert_port, sensor->alert_pin) == HAL_GPIO_PIN_RESET) {
+                ina226_async_start_chain(sensor);
+            }
+            return;
+        }
+            
+        default:
+            sensor->async_step = INA226_ASYNC_IDLE;
+            return;
+    }
+}
+
+static void ina226_async_read_next(ina226_sensor_t *sensor, uint8_t step, uint8_t reg) {
+    sensor->async_step = step;
+    sensor->pointer_reg = reg;
+    if (hal_i2c_mem_read_async(sensor->hi2c, sensor->i2c_address, reg, sensor->async_rx, 2,
+                               ina226_async_complete, sensor) != HAL_I2C_OK) {
+        sensor->async_errors++;
+        sensor->async_step = INA226_ASYNC_IDLE;
+    }
+}
+
+static void ina226_async_start_chain(ina226_sensor_t *sensor) {
+    ina226_async_read_next(sensor, INA226_ASYNC_MASK, INA226_REG_MASK_ENABLE);
+}
+
+hal_i2c_status_t ina226_read_async(ina226_sensor_t *sensor) {
+    if (!sensor->active || sensor->async_active) {
+        return HAL_I2C_ERROR;
+    }
+    if (sensor->async_step != INA226_ASYNC_IDLE) {
+        return HAL_I2C_BUSY;
+    }
+    
+    // Same chain as the ALERT path minus the Mask/Enable read; it does not
+    // restart itself because async_active is false
+    sensor->async_bus_raw = 0;
+    if (sensor->read_fields & INA226_READ_BUS) {
+        ina226_async_read_next(sensor, INA226_ASYNC_BUS, INA226_REG_BUS_VOLTAGE);
+    } else {
+        ina226_async_read_next(sensor, INA226_ASYNC_CURRENT, INA226_REG_CURRENT);
+    }
+    
+    return (sensor->async_step != INA226_ASYNC_IDLE) ? HAL_I2C_OK : HAL_I2C_ERROR;
+}
+
+bool ina226_read_pending(const ina226_sensor_t *sensor) {
+    return sensor->async_step != INA226_ASYNC_IDLE;
+}
+
+hal_i2c_status_t ina226_start_async(ina226_sensor_t *sensor) {
+    if (!sensor->active || sensor->limit_active) {
+        return HAL_I2C_ERROR;
+    }
+    if (sensor->async_active) {
+        return HAL_I2C_OK;
+    }
+    
+    // ALERT (active low, transparent) on every conversion-ready
+    hal_i2c_status_t status = ina226_write_register(sensor, INA226_REG_MASK_ENABLE, INA226_MASK_CNVR);
+    if (status != HAL_I2C_OK) {
+        return status;
+    }
+    
+    sensor->async_errors = 0;
+    sensor->async_step = INA226_ASYNC_IDLE;
+    hal_gpio_register_irq_callback(sensor->alert_pin, ina226_async_alert_isr, sensor);
+    sensor->async_active = true;
+    
+    // A conversion may already be pending (no edge will come for it)
+    ina226_process_alert(sensor);
+    return HAL_I2C_OK;
+}
+
+void ina226_stop_async(ina226_sensor_t *sensor) {
+    if (!sensor->async_active) {
+        return;
+    }
+    
+    sensor->async_active = false;
+    hal_gpio_register_irq_callback(sensor->alert_pin, NULL, NULL);
+    
+    // Let a chain in flight finish before the bus is used blocking again
+    uint32_t start = hal_get_tick();
+    while (sensor->async_step != INA226_ASYNC_IDLE &&
+           (hal_get_tick() - start) < INA226_I2C_TIMEOUT_MS) {
+    }
+    sensor->async_step = INA226_ASYNC_IDLE;
+    
+    ina226_write_register(sensor, INA226_REG_MASK_ENABLE, 0);
+}
+
+// ========== Limit Alert ==========
+
+static void ina226_limit_alert_isr(hal_gpio_pin_t pin, void *user_data) {
+    (void)pin;
+    ina226_sensor_t *sensor = (ina226_sensor_t *)user_data;
+    
+    SYSVIEW_TRACE(SYSVIEW_EVT_SENSOR_ALERT);
+    sensor->alert_flag = true;
+    if (sensor->alert_work != NULL) {
+        os_work_submit(sensor->alert_work);
+    }
+}
+
+uint16_t ina226_shunt_limit_from_mA(const ina226_sensor_t *sensor, float current_mA) {
+    float raw = (current_mA / 1000.0f) * sensor->shunt_resistor_ohms / INA226_SHUNT_VOLTAGE_LSB_V;
+    if (raw >= 32767.0f) {
+        return 0x7FFF;
+    }
+    if (raw <= -32768.0f) {
+        return 0x8000;
+    }
+    return (uint16_t)(int16_t)lroundf(raw);
+}
+
+hal_i2c_status_t ina226_start_limit_alert(ina226_sensor_t *sensor, uint16_t function, uint16_t limit) {
+    if (!sensor->active || sensor->async_active ||
+        (function & ~INA226_MASK_LIMIT_FUNCTIONS) != 0 || function == 0) {
+        return HAL_I2C_ERROR;
+    }
+    
+    // Limit first: the function compares against it from the next conversion
+    hal_i2c_status_t status = ina226_write_register(sensor, INA226_REG_ALERT_LIMIT, limit);
+    if (status != HAL_I2C_OK) {
+        return status;
+    }
+    status = ina226_write_register(sensor, INA226_REG_MASK_ENABLE, function | INA226_MASK_LEN);
+    if (status != HAL_I2C_OK) {
+        return status;
+    }
+    
+    if (!sensor->limit_active) {
+        sensor->alert_flag = false;
+        hal_gpio_register_irq_callback(sensor->alert_pin, ina226_limit_alert_isr, sensor);
+        sensor->limit_active = true;
+    }
+    return HAL_I2C_OK;
+}
+
+hal_i2c_status_t ina226_check_limit_alert(ina226_sensor_t *sensor, bool *tripped) {
+    *tripped = false;
+    if (!sensor->limit_active) {
+        return HAL_I2C_ERROR;
+    }
+    
+    // Latched and active low: the level also covers a missed edge
+    if (!sensor->alert_flag &&
+        hal_gpio_read_pin(sensor->alert_port, sensor->alert_pin) != HAL_GPIO_PIN_RESET) {
+        return HAL_I2C_OK;
+    }
+    sensor->alert_flag = false;
+    
+    // Reading Mask/Enable releases the latch
+    uint16_t mask;
+    hal_i2c_status_t status = ina226_read_register(sensor, INA226_REG_MASK_ENABLE, &mask);
+    if (status == HAL_I2C_OK) {
+        *tripped = (mask & INA226_MASK_AFF) != 0;
+    }
+    return status;
+}
+
+void ina226_stop_limit_alert(ina226_sensor_t *sensor) {
+    if (!sensor->limit_active) {
+        return;
+    }
+    
+    sensor->limit_active = false;
+    hal_gpio_register_irq_callback(sensor->alert_pin, NULL, NULL);
+    ina226_write_register(sensor, INA226_REG_MASK_ENABLE, 0);
+    sensor->alert_flag = false;
+}
@@ -5,6 +5,7 @@
 #include "hal_gpio.h"
 #include "hal_delay.h"
 #include "pinout.h"
+#include "os_workqueue.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -23,6 +24,33 @@
 #define INA226_REG_MANUFACTURER_ID  0xFE
 #define INA226_REG_DIE_ID           0xFF
 
+// Mask/Enable Register Bits
+#define INA226_MASK_SOL             0x8000  // ALERT on shunt voltage over limit
+#define INA226_MASK_SUL             0x4000  // ALERT on shunt voltage under limit
+#define INA226_MASK_BOL             0x2000  // ALERT on bus voltage over limit
+#define INA226_MASK_BUL             0x1000  // ALERT on bus voltage under limit
+#define INA226_MASK_POL             0x0800  // ALERT on power over limit
+#define INA226_MASK_CNVR            0x0400  // ALERT on conversion ready
+#define INA226_MASK_AFF             0x0010  // Alert function flag (limit functions)
+#define INA226_MASK_CVRF            0x0008  // Conversion ready flag (cleared by reading)
+#define INA226_MASK_LEN             0x0001  // Latch ALERT until Mask/Enable is read
+#define INA226_MASK_LIMIT_FUNCTIONS (INA226_MASK_SOL | INA226_MASK_SUL | INA226_MASK_BOL | \
+                                     INA226_MASK_BUL | INA226_MASK_POL)
+
+// Registers fetched per sample (ina226_config_t.read_fields)
+#define INA226_READ_BUS             0x01
+#define INA226_READ_CURRENT         0x02
+#define INA226_READ_POWER           0x04    // Otherwise derived as |I| x V
+#define INA226_READ_ALL             (INA226_READ_BUS | INA226_READ_CURRENT | INA226_READ_POWER)
+
+#define INA226_POINTER_UNKNOWN      0xFFFF  // Register pointer not known
+
+// Interrupt-driven acquisition steps (register read in flight)
+#define INA226_ASYNC_IDLE           0
+#define INA226_ASYNC_MASK           1
+#define INA226_ASYNC_BUS            2
+#define INA226_ASYNC_CURRENT        3
+
 // Configuration Register Bits
 #define INA226_CONFIG_RESET         0x8000
 #define INA226_CONFIG_MODE_MASK     0x0007
@@ -64,6 +92,11 @@
 #define INA226_CONFIG_VSHCT_4156US  0x0030
 #define INA226_CONFIG_VSHCT_8244US  0x0038
 
+// Field masks for the timing settings above
+#define INA226_CONFIG_AVG_MASK      0x0E00
+#define INA226_CONFIG_VBUSCT_MASK   0x01C0
+#define INA226_CONFIG_VSHCT_MASK    0x0038
+
 // Default I2C timeout
 #define INA226_I2C_TIMEOUT_MS       100
 
@@ -73,13 +106,20 @@ typedef struct {
     uint16_t bus_conv_time;     // Use INA226_CONFIG_VBUSCT_* defines
     uint16_t shunt_conv_time;   // Use INA226_CONFIG_VSHCT_* defines
     uint16_t mode;              // Use INA226_CONFIG_MODE_* defines
+    uint8_t read_fields;        // INA226_READ_* to fetch per sample (0 = all)
 } ina226_config_t;
 
+// Bus and shunt voltage register LSBs (fixed by the device)
+#define INA226_BUS_VOLTAGE_LSB_V    0.00125f
+#define INA226_SHUNT_VOLTAGE_LSB_V  0.0000025f
+
 // Data structure for measurements
 typedef struct {
     float current_mA;
     float voltage_V;
     float power_mW;
+    int16_t current_raw;        // Current register (Current_LSB units)
+    uint16_t bus_voltage_raw;   // Bus voltage register (1.25 mV units)
 } INA226_Data;
 
 // Forward declaration
@@ -100,13 +140,62 @@ typedef struct ina226_sensor {
     float current_lsb;          // Current LSB in A
     uint16_t calibration_value; // Calibration register value
     volatile bool alert_flag;   // Set by ISR, cleared by application
+    os_work_t *alert_work;      // Submitted by the ISR (ina226_set_alert_work), NULL = polled
     ina226_data_callback_t data_callback; // Direct callback for high-frequency data
+    // Interrupt-driven acquisition (ina226_start_async)
+    volatile bool async_active;         // ALERT starts a register-read chain
+    volatile uint8_t async_step;        // INA226_ASYNC_* read in flight
+    uint8_t async_rx[2];                // Register value being received
+    uint16_t async_bus_raw;             // Bus voltage read earlier in the chain
+    volatile uint32_t async_errors;     // Failed chain transfers
+    // Limit alert (ina226_start_limit_alert)
+    volatile bool limit_active;
+    // Fast read
+    uint8_t read_fields;                // INA226_READ_* fetched per sample
+    uint16_t pointer_reg;               // Register the device pointer is at
 } ina226_sensor_t;
 
 extern ina226_sensor_t default_ina226_sensor;
 
 // Driver functions
 
+/**
+ * @brief Number of samples averaged for an INA226_CONFIG_AVG_* setting
+ */
+uint16_t ina226_averaging_count(uint16_t averaging);
+
+/**
+ * @brief Nominal conversion time of an INA226_CONFIG_VBUSCT_* or
+ * INA226_CONFIG_VSHCT_* setting
+ * 
+ * @param conv_time Setting, either field
+ * @param is_shunt true for a VSHCT value, false for VBUSCT
+ * @return Conversion time in microseconds
+ */
+uint32_t ina226_conversion_time_us(uint16_t conv_time, bool is_shunt);
+
+/**
+ * @brief Nominal time between conversion-ready events for a configuration
+ * (averaging x (bus + shunt conversion time) in shunt-and-bus modes)
+ * 
+ * @param config Measurement configuration
+ * @return Cycle time in microseconds
+ */
+uint32_t ina226_conversion_cycle_us(const ina226_config_t *config);
+
+/**
+ * @brief Set up an additional sensor instance
+ * Gives the structure the same defaults as default_ina226_sensor, for a
+ * device at another address (A0/A1 straps) or on another bus.
+ * 
+ * @param sensor Pointer to INA226 sensor structure
+ * @param i2c_address 8-bit I2C address (e.g. INA226_I2C_ADDRESS)
+ * @param alert_port ALERT pin port (NULL if ALERT is not wired)
+ * @param alert_pin ALERT pin
+ */
+void ina226_sensor_init(ina226_sensor_t *sensor, uint16_t i2c_address,
+                        hal_gpio_port_t alert_port, hal_gpio_pin_t alert_pin);
+
 /**
  * @brief Initialize INA226 driver
  * Configures I2C, shunt resistor scaling, mode defaults, prepares ALERT pin interrupt
@@ -143,7 +232,9 @@ hal_i2c_status_t ina226_configure(ina226_sensor_t *sensor, const ina226_config_t
 
 /**
  * @brief Read current measurements from sensor
- * Reads actual current, bus voltage and calculates power
+ * Reads only the registers selected in read_fields; fields not read are
+ * 0, and power is derived from current and voltage unless it is read.
+ * Re-reading the register the pointer is at skips the pointer write.
  * 
  * @param sensor Pointer to INA226 sensor structure
  * @param data Pointer to data structure to store measurements
@@ -170,10 +261,106 @@ hal_i2c_status_t ina226_close(ina226_sensor_t *sensor);
  */
 void ina226_deinit(ina226_sensor_t *sensor);
 
+/**
+ * @brief Switch an open sensor to interrupt-driven acquisition
+ * Enables the conversion-ready ALERT. Each ALERT edge then starts a
+ * non-blocking chain of register reads (Mask/Enable to clear the alert,
+ * bus voltage, current) and the completion interrupt calls data_callback
+ * with raw and converted values. data_callback then runs in ISR context;
+ * power is computed as |I| x V instead of reading the power register.
+ * 
+ * @param sensor Pointer to an open INA226 sensor structure
+ * @return hal_i2c_status_t Status of operation
+ */
+hal_i2c_status_t ina226_start_async(ina226_sensor_t *sensor);
+
+/**
+ * @brief Return to polled acquisition (also done by ina226_close)
+ * Disables the ALERT and waits for a chain in flight to finish.
+ * 
+ * @param sensor Pointer to INA226 sensor structure
+ */
+void ina226_stop_async(ina226_sensor_t *sensor);
+
+/**
+ * @brief Start one non-blocking read of the selected registers
+ * For sensors polled on a schedule instead of via ALERT: reads bus
+ * voltage and current with queued transfers and calls data_callback from
+ * the completion interrupt, as in async mode.
+ * 
+ * @param sensor Pointer to an open INA226 sensor structure
+ * @return HAL_I2C_OK if started, HAL_I2C_BUSY if a read is still in flight
+ */
+hal_i2c_status_t ina226_read_async(ina226_sensor_t *sensor);
+
+/**
+ * @brief Check whether a non-blocking read is in flight
+ * 
+ * @param sensor Pointer to INA226 sensor structure
+ * @return true while a register-read chain is running
+ */
+bool ina226_read_pending(const ina226_sensor_t *sensor);
+
+/**
+ * @brief Shunt voltage limit register value for a current
+ * For INA226_MASK_SOL/SUL: the device compares the shunt voltage register
+ * (2.5 uV LSB) against the limit, so no current register read is needed.
+ * 
+ * @param sensor Open sensor (shunt resistor known)
+ * @param current_mA Current at the limit
+ * @return Limit register value (two's complement, clamped)
+ */
+uint16_t ina226_shunt_limit_from_mA(const ina226_sensor_t *sensor, float current_mA);
+
+/**
+ * @brief Raise ALERT when a conversion crosses a limit
+ * The device compares every (averaged) conversion against the limit, so
+ * steady state costs no I2C traffic. ALERT latches until
+ * ina226_check_limit_alert() reads Mask/Enable. Not together with
+ * ina226_start_async() (one ALERT function at a time).
+ * 
+ * @param sensor Pointer to an open INA226 sensor structure
+ * @param function One of INA226_MASK_SOL/SUL/BOL/BUL/POL
+ * @param limit Alert limit register value, in the units of that register
+ * @return hal_i2c_status_t Status of operation
+ */
+hal_i2c_status_t ina226_start_limit_alert(ina226_sensor_t *sensor, uint16_t function, uint16_t limit);
+
+/**
+ * @brief Check for a latched limit alert and release it
+ * Touches the bus only when the ALERT edge or level says the limit was
+ * crossed (blocking Mask/Enable read).
+ * 
+ * @param sensor Pointer to INA226 sensor structure
+ * @param tripped Output: true if the limit was crossed since the last check
+ * @return hal_i2c_status_t Status of operation
+ */
+hal_i2c_status_t ina226_check_limit_alert(ina226_sensor_t *sensor, bool *tripped);
+
+/**
+ * @brief Run a work item on every ALERT edge instead of being polled
+ * The ALERT ISRs of ina226_alert_callback() and ina226_start_limit_alert()
+ * submit it to the shared work queue (os_workqueue.h), where it calls
+ * ina226_process_alert() or ina226_check_limit_alert(). The edge flag is
+ * kept, so polling still works alongside.
+ * 
+ * @param sensor Pointer to INA226 sensor structure
+ * @param work Work item, NULL to go back to polling only
+ */
+void ina226_set_alert_work(ina226_sensor_t *sensor, os_work_t *work);
+
+/**
+ * @brief Disable the limit alert (also done by ina226_close)
+ * 
+ * @param sensor Pointer to INA226 sensor structure
+ */
+void ina226_stop_limit_alert(ina226_sensor_t *sensor);
+
 /**
  * @brief ALERT pin interrupt callback
  * Should be called from GPIO EXTI interrupt handler.
- * Sets alert flag for processing in main context.
+ * Sets alert flag for processing in task context, and submits the
+ * alert work item if one is set.
  * 
  * @param sensor Pointer to INA226 sensor structure
  */
@@ -182,7 +369,8 @@ void ina226_alert_callback(ina226_sensor_t *sensor);
 /**
  * @brief Process pending ALERT and call data callback
  * Should be called periodically (e.g., from timer interrupt or high-priority task).
- * Reads sensor data and calls data_callback if configured.
+ * Reads sensor data and calls data_callback if configured. In async mode
+ * it never blocks: it only restarts a chain if an ALERT was missed.
  * 
  * @param sensor Pointer to INA226 sensor structure
  */
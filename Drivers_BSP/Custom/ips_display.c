@@ -1,40 +1,87 @@
 
 #include <pinout.h>
-#include <stdio.h>
+#include <string.h>
 #include "ips_display.h"
 #include "st7735.h"
 #include "hal_gpio.h"
+#include "hal_delay.h"
+#include "display_ui.h"
 
 static bool display_initialized = false;
+static bool display_opening = false;     // Between open_begin and the last open_poll
+
+// Where each value field and its label are drawn, and the field widget
+static const struct {
+    uint16_t x;
+    uint16_t y;
+    const char *label;
+} field_pos[IPS_DISPLAY_FIELD_COUNT] = {
+    [IPS_DISPLAY_FIELD_TEMPERATURE] = { 80, 10, "Temp: " },
+    [IPS_DISPLAY_FIELD_HUMIDITY]    = { 80, 40, "Hum:  " },
+};
+static display_ui_id_t field_widget[IPS_DISPLAY_FIELD_COUNT];
 
 ips_display_status_t ips_display_init() {
     // Basic driver initialization
     display_initialized = false;
+    display_opening = false;
     return IPS_DISPLAY_OK;
 }
 
-ips_display_status_t ips_display_open() {
-    if (display_initialized) {
+ips_display_status_t ips_display_open_begin() {
+    if (display_initialized || display_opening) {
         return IPS_DISPLAY_ERROR; // Already open
     }
 
-    // Initialize ST7735 hardware
-    ST7735_Init();
-    
-    // Fill background
-    ST7735_FillScreen(ST7735_BLACK);
+    // Initialize ST7735 hardware, one command batch per poll
+    ST7735_InitBegin();
+    display_opening = true;
+    return IPS_DISPLAY_OK;
+}
+
+ips_display_status_t ips_display_open_poll(uint32_t *wait_ms) {
+    if (display_initialized) {
+        return IPS_DISPLAY_OK;
+    }
+    if (!display_opening) {
+        return IPS_DISPLAY_ERROR;
+    }
+    if (!ST7735_InitContinue(wait_ms)) {
+        return IPS_DISPLAY_BUSY;
+    }
+    display_opening = false;
 
-    // Draw static labels
-    ST7735_WriteString(10, 10, "Temp: ", Font_11x18, ST7735_WHITE, ST7735_BLACK);
-    ST7735_WriteString(10, 40, "Hum:  ", Font_11x18, ST7735_WHITE, ST7735_BLACK);
+    // Static labels and empty value fields, sent in one render pass
+    display_ui_init(ST7735_BLACK);
+    for (uint32_t field = 0; field < IPS_DISPLAY_FIELD_COUNT; field++) {
+        display_ui_add_text(10, field_pos[field].y, field_pos[field].label, Font_11x18,
+                            ST7735_WHITE, ST7735_BLACK);
+        field_widget[field] = display_ui_add_text(field_pos[field].x, field_pos[field].y, "",
+                                                  Font_11x18, ST7735_WHITE, ST7735_BLACK);
+    }
+    display_ui_render();
     
     // Enable backlight
     hal_gpio_write_pin((hal_gpio_port_t)DISPLAY_BACKLIGHT_PORT, DISPLAY_BACKLIGHT_PIN, HAL_GPIO_PIN_SET);
     
     display_initialized = true;
+    if (wait_ms != NULL) {
+        *wait_ms = 0;
+    }
     return IPS_DISPLAY_OK;
 }
 
+ips_display_status_t ips_display_open() {
+    ips_display_status_t status = ips_display_open_begin();
+    uint32_t wait_ms;
+
+    while (status == IPS_DISPLAY_OK &&
+           (status = ips_display_open_poll(&wait_ms)) == IPS_DISPLAY_BUSY) {
+        hal_delay_ms(wait_ms);
+    }
+    return status;
+}
+
 ips_display_status_t ips_display_close() {
     if (!display_initialized) {
         return IPS_DISPLAY_ERROR;
@@ -56,21 +103,25 @@ void ips_display_deinit() {
     }
 }
 
-ips_display_status_t ips_display_write_temp_data(float temperature, float humidity) {
+ips_display_status_t ips_display_write_temp_data(int32_t temperature_centi, int32_t humidity_centi) {
     if (!display_initialized) {
         return IPS_DISPLAY_ERROR;
     }
-    
-    char temp_val[16];
-    char hum_val[16];
 
-    // Format the numeric values using floats
-    snprintf(temp_val, sizeof(temp_val), "%.2f C", temperature);
-    snprintf(hum_val, sizeof(hum_val), "%.2f %%", humidity);
+    // Both fields in one render pass
+    display_ui_set_fixed(field_widget[IPS_DISPLAY_FIELD_TEMPERATURE], temperature_centi, 2, " C");
+    display_ui_set_fixed(field_widget[IPS_DISPLAY_FIELD_HUMIDITY], humidity_centi, 2, " %");
+    display_ui_render();
+    return IPS_DISPLAY_OK;
+}
 
-    // Overwrite only the numeric values on the display
-    ST7735_WriteString(80, 10, temp_val, Font_11x18, ST7735_WHITE, ST7735_BLACK);
-    ST7735_WriteString(80, 40, hum_val, Font_11x18, ST7735_WHITE, ST7735_BLACK);
+ips_display_status_t ips_display_write_field(ips_display_field_t field, const char *text) {
+    if (!display_initialized || field >= IPS_DISPLAY_FIELD_COUNT || text == NULL) {
+        return IPS_DISPLAY_ERROR;
+    }
 
+    // An unchanged text leaves the widget clean: no SPI traffic
+    display_ui_set_text(field_widget[field], text);
+    display_ui_render();
     return IPS_DISPLAY_OK;
 }
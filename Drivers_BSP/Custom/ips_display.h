@@ -3,24 +3,49 @@
 
 #include "hal_spi.h"
 
+// The screen is built from display_ui.h widgets; DISPLAY_UI_USE_FRAMEBUFFER
+// selects whether they draw through the RAM framebuffer
+
 typedef enum {
     IPS_DISPLAY_OK = 0,
-    IPS_DISPLAY_ERROR
+    IPS_DISPLAY_ERROR,
+    IPS_DISPLAY_BUSY            // Open in progress, poll again
 } ips_display_status_t;
 
 // Initialize driver only (no hardware setup)
 ips_display_status_t ips_display_init();
 
-// Open connection and configure display (power on, initialize, draw UI)
+// Open connection and configure display (power on, initialize, draw UI);
+// blocks for the panel's power-up delays, ~800 ms
 ips_display_status_t ips_display_open();
 
+// Non-blocking open: after ips_display_open_begin(), call
+// ips_display_open_poll() again *wait_ms later while it returns
+// IPS_DISPLAY_BUSY. IPS_DISPLAY_OK means the UI is drawn.
+ips_display_status_t ips_display_open_begin();
+ips_display_status_t ips_display_open_poll(uint32_t *wait_ms);
+
 // Close connection and power down display
 ips_display_status_t ips_display_close();
 
 // Deinitialize driver
 void ips_display_deinit();
 
-ips_display_status_t ips_display_write_temp_data(float temperature, float humidity);
+// Value fields, each remembering the text it shows
+typedef enum {
+    IPS_DISPLAY_FIELD_TEMPERATURE = 0,
+    IPS_DISPLAY_FIELD_HUMIDITY,
+    IPS_DISPLAY_FIELD_COUNT
+} ips_display_field_t;
+
+#define IPS_DISPLAY_FIELD_LEN   16      // Including the terminator (DISPLAY_UI_TEXT_LEN)
+
+// Format and show both values, in hundredths (see ips_display_write_field)
+ips_display_status_t ips_display_write_temp_data(int32_t temperature_centi, int32_t humidity_centi);
+
+// Show a value; only characters that differ from what the field shows are
+// redrawn, and an unchanged text causes no SPI traffic at all
+ips_display_status_t ips_display_write_field(ips_display_field_t field, const char *text);
 
 
 #endif // IPS_DISPLAY_H
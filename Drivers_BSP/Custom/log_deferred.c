@@ -0,0 +1,65 @@
+/**
+ * @file log_deferred.c
+ * @brief Deferred (tokenized) binary logging over RTT
+ */
+
+#include "log_deferred.h"
+#include "SEGGER_RTT.h"
+#include "stm32f7xx_hal.h"
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define RECORD_HEADER_WORDS     4
+
+static uint8_t rtt_buffer[LOG_DEFERRED_BUFFER_SIZE];
+static volatile bool channel_ready = false;
+static uint16_t sequence = 0;           // Under the RTT lock
+static volatile uint32_t dropped = 0;
+
+void log_deferred_init(void)
+{
+    SEGGER_RTT_ConfigUpBuffer(LOG_DEFERRED_RTT_CHANNEL, "LogBin", rtt_buffer, sizeof(rtt_buffer),
+                              SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    channel_ready = true;
+}
+
+void log_deferred_write(uint8_t level, const char *tag, const char *format, uint32_t arg_count, ...)
+{
+    uint32_t record[RECORD_HEADER_WORDS + LOG_DEFERRED_MAX_ARGS];
+    va_list args;
+
+    if (!channel_ready) {
+        log_deferred_init();    // Idempotent, a race only configures twice
+    }
+    if (arg_count > LOG_DEFERRED_MAX_ARGS) {
+        arg_count = LOG_DEFERRED_MAX_ARGS;
+    }
+
+    record[1] = HAL_GetTick();
+    record[2] = (uint32_t)(uintptr_t)format;
+    record[3] = (uint32_t)(uintptr_t)tag;
+
+    va_start(args, arg_count);
+    for (uint32_t i = 0; i < arg_count; i++) {
+        record[RECORD_HEADER_WORDS + i] = va_arg(args, uint32_t);
+    }
+    va_end(args);
+
+    unsigned bytes = (RECORD_HEADER_WORDS + arg_count) * sizeof(uint32_t);
+
+    // Sequence and write under one lock, so records appear in sequence order
+    SEGGER_RTT_LOCK();
+    record[0] = LOG_DEFERRED_MAGIC | ((uint32_t)(level & 0x0F) << 8) |
+                ((arg_count & 0x0F) << 12) | ((uint32_t)sequence << 16);
+    sequence++;
+    if (SEGGER_RTT_WriteNoLock(LOG_DEFERRED_RTT_CHANNEL, record, bytes) != bytes) {
+        dropped++;
+    }
+    SEGGER_RTT_UNLOCK();
+}
+
+uint32_t log_deferred_get_dropped(void)
+{
+    return dropped;
+}
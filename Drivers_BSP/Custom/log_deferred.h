@@ -0,0 +1,91 @@
+/**
+ * @file log_deferred.h
+ * @brief Deferred (tokenized) binary logging over RTT
+ *
+ * Instead of formatting on the target, a log call stores the address of
+ * its format string, the tag pointer and the raw 32-bit arguments as one
+ * binary record on RTT up-channel LOG_DEFERRED_RTT_CHANNEL. Format strings
+ * are placed in the non-loaded .log_fmt section, so they cost no flash and
+ * their address is their ID; tools/log_decode.py reads them (and the tags)
+ * back from the ELF and prints the text on the host.
+ *
+ * Record, little-endian 32-bit words:
+ *   [0] magic (8) | level (4) | argument count (4) | sequence (16)
+ *   [1] HAL tick (ms)
+ *   [2] format string ID (.log_fmt address)
+ *   [3] tag address
+ *   [4..] arguments
+ *
+ * The channel runs in no-block-skip mode: a record that does not fit is
+ * dropped whole, and the host sees the gap in the sequence numbers.
+ *
+ * Limitations: arguments must be 32 bits or narrower (no %f, %ll); %s is
+ * only decoded for strings in flash (literals, const tables), others are
+ * shown as their address.
+ *
+ * Enabled for all LOG_x macros with LOG_DEFERRED=1 (see portable_log.h).
+ */
+
+#ifndef LOG_DEFERRED_H
+#define LOG_DEFERRED_H
+
+#include <stdint.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define LOG_DEFERRED_RTT_CHANNEL    2       // 0 is text, 1 is SystemView
+#define LOG_DEFERRED_BUFFER_SIZE    2048
+#define LOG_DEFERRED_MAX_ARGS       8
+#define LOG_DEFERRED_MAGIC          0xD1
+
+// Levels, as in the record
+#define LOG_DEFERRED_LEVEL_E        1
+#define LOG_DEFERRED_LEVEL_W        2
+#define LOG_DEFERRED_LEVEL_I        3
+#define LOG_DEFERRED_LEVEL_D        4
+#define LOG_DEFERRED_LEVEL_V        5
+
+// ============================================================================
+// Log Macro
+// ============================================================================
+
+// Number of variadic arguments (counts up to 16, so too many is caught)
+#define LOG_DEFERRED_NARGS(...) \
+    LOG_DEFERRED_NARGS_(0, ##__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LOG_DEFERRED_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, n, ...) n
+
+#define LOG_DEFERRED_WRITE(level, tag, format, ...) \
+    do { \
+        _Static_assert(LOG_DEFERRED_NARGS(__VA_ARGS__) <= LOG_DEFERRED_MAX_ARGS, \
+                       "too many deferred log arguments"); \
+        static const char _log_fmt[] __attribute__((section(".log_fmt"), used)) = format; \
+        log_deferred_write((level), (tag), _log_fmt, \
+                           LOG_DEFERRED_NARGS(__VA_ARGS__), ##__VA_ARGS__); \
+    } while (0)
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Set up the RTT channel (also done by the first record)
+ */
+void log_deferred_init(void);
+
+/**
+ * @brief Emit one record; use LOG_DEFERRED_WRITE() instead
+ *
+ * Safe from tasks and ISRs; does not block.
+ *
+ * @param arg_count Number of 32-bit arguments that follow
+ */
+void log_deferred_write(uint8_t level, const char *tag, const char *format, uint32_t arg_count, ...);
+
+/**
+ * @brief Records dropped because the channel was full
+ */
+uint32_t log_deferred_get_dropped(void);
+
+#endif // LOG_DEFERRED_H
@@ -0,0 +1,83 @@
+/**
+ * @file portable_log.c
+ * @brief Runtime per-tag log levels (see portable_log.h)
+ */
+
+#include "portable_log.h"
+
+#ifndef PLATFORM_ESP32
+
+#include <stddef.h>
+#include <string.h>
+
+typedef struct {
+    const char *tag;
+    volatile uint8_t level;
+} log_tag_level_t;
+
+// Entries are only appended, and an entry is complete before tag_count
+// covers it, so the hot path reads without locking
+static log_tag_level_t tag_levels[LOG_TAG_LEVEL_MAX];
+static volatile uint8_t tag_count = 0;
+static volatile uint8_t default_level = LOG_DEFAULT_LEVEL;
+
+static log_tag_level_t *find_tag(const char *tag)
+{
+    uint8_t count = tag_count;
+
+    // Tags are string literals, usually the same pointer as when registered
+    for (uint8_t i = 0; i < count; i++) {
+        if (tag_levels[i].tag == tag) {
+            return &tag_levels[i];
+        }
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (strcmp(tag_levels[i].tag, tag) == 0) {
+            return &tag_levels[i];
+        }
+    }
+    return NULL;
+}
+
+bool log_set_level(const char *tag, uint8_t level)
+{
+    if (level > LOG_LVL_VERBOSE) {
+        level = LOG_LVL_VERBOSE;
+    }
+    if (tag == NULL || strcmp(tag, "*") == 0) {
+        default_level = level;
+        return true;
+    }
+
+    log_tag_level_t *entry = find_tag(tag);
+    if (entry != NULL) {
+        entry->level = level;
+        return true;
+    }
+    if (tag_count >= LOG_TAG_LEVEL_MAX) {
+        return false;
+    }
+
+    // Callers (shell, protocol handler, init) set levels from one task at a time
+    tag_levels[tag_count].tag = tag;
+    tag_levels[tag_count].level = level;
+    tag_count++;
+    return true;
+}
+
+uint8_t log_get_level(const char *tag)
+{
+    if (tag_count == 0 || tag == NULL) {
+        return default_level;
+    }
+
+    const log_tag_level_t *entry = find_tag(tag);
+    return (entry != NULL) ? entry->level : default_level;
+}
+
+bool log_level_enabled(const char *tag, uint8_t level)
+{
+    return level <= log_get_level(tag);
+}
+
+#endif // !PLATFORM_ESP32
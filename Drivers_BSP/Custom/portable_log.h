@@ -4,14 +4,50 @@
  * 
  * Provides unified logging API that works on both platforms:
  * - ESP32: Uses esp_log (colored output, log levels, timestamps)
- * - STM32: Uses printf, SEGGER RTT, or ITM (configurable)
+ * - STM32: Uses printf, SEGGER RTT, or ITM (configurable), or with
+ *   LOG_DEFERRED=1 binary records formatted on the host (log_deferred.h)
+ *
+ * Levels are filtered twice:
+ * - At compile time by LOG_LOCAL_LEVEL (define it before including this
+ *   header, or project wide): calls above it expand to nothing, so neither
+ *   code nor format strings end up in the image.
+ * - At run time per tag (STM32): log_set_level("PROTO", LOG_LVL_DEBUG)
+ *   raises one module's verbosity, the others keep the default level.
+ *   A disabled call costs one level lookup and formats nothing.
+ *
+ * Error paths that can fire per packet use the rate-limited variants, which
+ * print at most one line per interval and call site:
+ *   LOG_W_LIMITED(TAG, 1000, "CRC error");  ->  "CRC error (x137 suppressed)"
  */
 
 #ifndef PORTABLE_LOG_H
 #define PORTABLE_LOG_H
 
+// Host builds (Tests/host) log through printf
+#ifndef HOST_BUILD
 #define STM32F7
 #define USE_SEGGER_RTT
+#endif
+
+// ============================================================================
+// Levels
+// ============================================================================
+
+#define LOG_LVL_NONE        0
+#define LOG_LVL_ERROR       1
+#define LOG_LVL_WARN        2
+#define LOG_LVL_INFO        3
+#define LOG_LVL_DEBUG       4
+#define LOG_LVL_VERBOSE     5
+
+// Compile-time maximum level; LOG_LEVEL_DEBUG (legacy switch) includes all
+#ifndef LOG_LOCAL_LEVEL
+    #ifdef LOG_LEVEL_DEBUG
+        #define LOG_LOCAL_LEVEL  LOG_LVL_VERBOSE
+    #else
+        #define LOG_LOCAL_LEVEL  LOG_LVL_INFO
+    #endif
+#endif
 
 // ============================================================================
 // Platform Detection
@@ -26,6 +62,8 @@
       defined(STM32G4) || defined(STM32WB) || defined(STM32MP1)
     #define PLATFORM_STM32
     #include "stm32f7xx_hal.h"
+#elif defined(HOST_BUILD)
+    #define PLATFORM_GENERIC
 #else
     #warning "Unknown platform - defaulting to generic logging"
     #define PLATFORM_GENERIC
@@ -44,6 +82,11 @@
     #define LOG_D(tag, format, ...)  ESP_LOGD(tag, format, ##__VA_ARGS__)
     #define LOG_V(tag, format, ...)  ESP_LOGV(tag, format, ##__VA_ARGS__)
 
+    // esp_log keeps its own per-tag levels, with the same numbering
+    #define log_set_level(tag, level)  esp_log_level_set((tag) ? (tag) : "*", (esp_log_level_t)(level))
+
+    #define LOG_TIME_MS()  esp_log_timestamp()
+
 // ============================================================================
 // STM32 Implementation (configurable backend)
 // ============================================================================
@@ -98,25 +141,29 @@
             } while(0)
     #endif
 
-    // Log macros
-    #define LOG_I(tag, format, ...)  _LOG_PRINTF('I', "", tag, format, ##__VA_ARGS__)
-    #define LOG_W(tag, format, ...)  _LOG_PRINTF('W', LOG_COLOR_YELLOW, tag, format, ##__VA_ARGS__)
-    #define LOG_E(tag, format, ...)  _LOG_PRINTF('E', LOG_COLOR_RED, tag, format, ##__VA_ARGS__)
-    
-    // Debug logs (can be compiled out for size optimization)
-    #ifdef LOG_LEVEL_DEBUG
-        #if defined(USE_SEGGER_RTT)
-            #define LOG_D(tag, format, ...)  SEGGER_RTT_printf(0, "D (%lu) %s: " format "\n", \
-                                                              (unsigned long)(HAL_GetTick()), tag, ##__VA_ARGS__)
-            #define LOG_V(tag, format, ...)  SEGGER_RTT_printf(0, "V (%lu) %s: " format "\n", \
-                                                              (unsigned long)(HAL_GetTick()), tag, ##__VA_ARGS__)
-        #else
-            #define LOG_D(tag, format, ...)  _LOG_PRINTF('D', "", tag, format, ##__VA_ARGS__)
-            #define LOG_V(tag, format, ...)  _LOG_PRINTF('V', "", tag, format, ##__VA_ARGS__)
-        #endif
+    #define LOG_TIME_MS()  HAL_GetTick()
+
+    // Deferred mode: binary records decoded on the host by
+    // tools/log_decode.py instead of on-target formatting (log_deferred.h)
+    #ifndef LOG_DEFERRED
+        #define LOG_DEFERRED 0
+    #endif
+
+    // Emitters, called once the level check passed
+    #if LOG_DEFERRED && defined(USE_SEGGER_RTT)
+        #include "log_deferred.h"
+
+        #define _LOG_EMIT_I(tag, format, ...)  LOG_DEFERRED_WRITE(LOG_DEFERRED_LEVEL_I, tag, format, ##__VA_ARGS__)
+        #define _LOG_EMIT_W(tag, format, ...)  LOG_DEFERRED_WRITE(LOG_DEFERRED_LEVEL_W, tag, format, ##__VA_ARGS__)
+        #define _LOG_EMIT_E(tag, format, ...)  LOG_DEFERRED_WRITE(LOG_DEFERRED_LEVEL_E, tag, format, ##__VA_ARGS__)
+        #define _LOG_EMIT_D(tag, format, ...)  LOG_DEFERRED_WRITE(LOG_DEFERRED_LEVEL_D, tag, format, ##__VA_ARGS__)
+        #define _LOG_EMIT_V(tag, format, ...)  LOG_DEFERRED_WRITE(LOG_DEFERRED_LEVEL_V, tag, format, ##__VA_ARGS__)
     #else
-        #define LOG_D(tag, format, ...)  ((void)0)
-        #define LOG_V(tag, format, ...)  ((void)0)
+        #define _LOG_EMIT_I(tag, format, ...)  _LOG_PRINTF('I', "", tag, format, ##__VA_ARGS__)
+        #define _LOG_EMIT_W(tag, format, ...)  _LOG_PRINTF('W', LOG_COLOR_YELLOW, tag, format, ##__VA_ARGS__)
+        #define _LOG_EMIT_E(tag, format, ...)  _LOG_PRINTF('E', LOG_COLOR_RED, tag, format, ##__VA_ARGS__)
+        #define _LOG_EMIT_D(tag, format, ...)  _LOG_PRINTF('D', "", tag, format, ##__VA_ARGS__)
+        #define _LOG_EMIT_V(tag, format, ...)  _LOG_PRINTF('V', "", tag, format, ##__VA_ARGS__)
     #endif
 
 // ============================================================================
@@ -125,12 +172,161 @@
 
 #else
     #include <stdio.h>
+    #include <time.h>
+
+    #define LOG_TIME_MS()  ((uint32_t)((uint64_t)clock() * 1000U / CLOCKS_PER_SEC))
     
-    #define LOG_I(tag, format, ...)  printf("I [%s] " format "\n", tag, ##__VA_ARGS__)
-    #define LOG_W(tag, format, ...)  printf("W [%s] " format "\n", tag, ##__VA_ARGS__)
-    #define LOG_E(tag, format, ...)  printf("E [%s] " format "\n", tag, ##__VA_ARGS__)
-    #define LOG_D(tag, format, ...)  printf("D [%s] " format "\n", tag, ##__VA_ARGS__)
-    #define LOG_V(tag, format, ...)  printf("V [%s] " format "\n", tag, ##__VA_ARGS__)
+    #define _LOG_EMIT_I(tag, format, ...)  printf("I [%s] " format "\n", tag, ##__VA_ARGS__)
+    #define _LOG_EMIT_W(tag, format, ...)  printf("W [%s] " format "\n", tag, ##__VA_ARGS__)
+    #define _LOG_EMIT_E(tag, format, ...)  printf("E [%s] " format "\n", tag, ##__VA_ARGS__)
+    #define _LOG_EMIT_D(tag, format, ...)  printf("D [%s] " format "\n", tag, ##__VA_ARGS__)
+    #define _LOG_EMIT_V(tag, format, ...)  printf("V [%s] " format "\n", tag, ##__VA_ARGS__)
+#endif
+
+// ============================================================================
+// Runtime Per-Tag Levels (STM32 and generic; see portable_log.c)
+// ============================================================================
+
+#ifndef PLATFORM_ESP32
+    #include <stdint.h>
+    #include <stdbool.h>
+
+    #define LOG_TAG_LEVEL_MAX   8       // Tags with their own level
+    #define LOG_DEFAULT_LEVEL   LOG_LVL_INFO
+
+    /**
+     * @brief Set the run-time level of one tag, or of all others (tag NULL or "*")
+     * @return false if the tag table is full
+     * @note The tag is stored by pointer, pass the module's TAG string
+     * @note Levels above LOG_LOCAL_LEVEL stay compiled out
+     */
+    bool log_set_level(const char *tag, uint8_t level);
+
+    /**
+     * @brief Run-time level that applies to a tag
+     */
+    uint8_t log_get_level(const char *tag);
+
+    /**
+     * @brief Check a call against the run-time level of its tag
+     */
+    bool log_level_enabled(const char *tag, uint8_t level);
+
+    #define _LOG_FILTERED(level, emit, tag, format, ...) \
+        do { \
+            if (log_level_enabled((tag), (level))) { \
+                emit(tag, format, ##__VA_ARGS__); \
+            } \
+        } while (0)
+
+    #define LOG_E(tag, format, ...)  _LOG_FILTERED(LOG_LVL_ERROR, _LOG_EMIT_E, tag, format, ##__VA_ARGS__)
+    #define LOG_W(tag, format, ...)  _LOG_FILTERED(LOG_LVL_WARN, _LOG_EMIT_W, tag, format, ##__VA_ARGS__)
+    #define LOG_I(tag, format, ...)  _LOG_FILTERED(LOG_LVL_INFO, _LOG_EMIT_I, tag, format, ##__VA_ARGS__)
+    #define LOG_D(tag, format, ...)  _LOG_FILTERED(LOG_LVL_DEBUG, _LOG_EMIT_D, tag, format, ##__VA_ARGS__)
+    #define LOG_V(tag, format, ...)  _LOG_FILTERED(LOG_LVL_VERBOSE, _LOG_EMIT_V, tag, format, ##__VA_ARGS__)
+#endif
+
+// ============================================================================
+// Compile-Time Level Filter (all platforms)
+// ============================================================================
+
+#if LOG_LOCAL_LEVEL < LOG_LVL_ERROR
+    #undef LOG_E
+    #define LOG_E(tag, format, ...)  ((void)0)
+#endif
+
+#if LOG_LOCAL_LEVEL < LOG_LVL_WARN
+    #undef LOG_W
+    #define LOG_W(tag, format, ...)  ((void)0)
+#endif
+
+#if LOG_LOCAL_LEVEL < LOG_LVL_INFO
+    #undef LOG_I
+    #define LOG_I(tag, format, ...)  ((void)0)
+#endif
+
+#if LOG_LOCAL_LEVEL < LOG_LVL_DEBUG
+    #undef LOG_D
+    #define LOG_D(tag, format, ...)  ((void)0)
+#endif
+
+#if LOG_LOCAL_LEVEL < LOG_LVL_VERBOSE
+    #undef LOG_V
+    #define LOG_V(tag, format, ...)  ((void)0)
+#endif
+
+// ============================================================================
+// Rate-Limited Logging (all platforms)
+// ============================================================================
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Per-call-site limiter state (one static instance per macro use)
+ */
+typedef struct {
+    uint32_t last_ms;       /**< Time of the last printed line */
+    uint32_t suppressed;    /**< Calls dropped since then */
+    bool started;
+} log_rate_limit_t;
+
+/**
+ * @brief Let one call per interval through
+ *
+ * Unlocked: concurrent callers of the same site can at worst both print or
+ * miscount a suppression, never block or corrupt the data path.
+ *
+ * @param suppressed Set to the number of calls dropped before this one
+ * @return true if the call should print
+ */
+static inline bool log_rate_limit_pass(log_rate_limit_t *limit, uint32_t interval_ms, uint32_t *suppressed)
+{
+    uint32_t now = LOG_TIME_MS();
+
+    if (limit->started && (now - limit->last_ms) < interval_ms) {
+        limit->suppressed++;
+        return false;
+    }
+    limit->started = true;
+    limit->last_ms = now;
+    *suppressed = limit->suppressed;
+    limit->suppressed = 0;
+    return true;
+}
+
+// __VA_OPT__ (GCC 8+) appends the count after the caller's own arguments
+#define _LOG_LIMITED(log, tag, interval_ms, format, ...) \
+    do { \
+        static log_rate_limit_t _log_limit; \
+        uint32_t _log_suppressed; \
+        if (log_rate_limit_pass(&_log_limit, (interval_ms), &_log_suppressed)) { \
+            if (_log_suppressed == 0) { \
+                log(tag, format __VA_OPT__(,) __VA_ARGS__); \
+            } else { \
+                log(tag, format " (x%lu suppressed)" __VA_OPT__(,) __VA_ARGS__, \
+                    (unsigned long)_log_suppressed); \
+            } \
+        } \
+    } while (0)
+
+// Compiled out together with their level
+#if LOG_LOCAL_LEVEL >= LOG_LVL_ERROR
+    #define LOG_E_LIMITED(tag, interval_ms, format, ...)  _LOG_LIMITED(LOG_E, tag, interval_ms, format, ##__VA_ARGS__)
+#else
+    #define LOG_E_LIMITED(tag, interval_ms, format, ...)  ((void)0)
+#endif
+
+#if LOG_LOCAL_LEVEL >= LOG_LVL_WARN
+    #define LOG_W_LIMITED(tag, interval_ms, format, ...)  _LOG_LIMITED(LOG_W, tag, interval_ms, format, ##__VA_ARGS__)
+#else
+    #define LOG_W_LIMITED(tag, interval_ms, format, ...)  ((void)0)
+#endif
+
+#if LOG_LOCAL_LEVEL >= LOG_LVL_INFO
+    #define LOG_I_LIMITED(tag, interval_ms, format, ...)  _LOG_LIMITED(LOG_I, tag, interval_ms, format, ##__VA_ARGS__)
+#else
+    #define LOG_I_LIMITED(tag, interval_ms, format, ...)  ((void)0)
 #endif
 
 // ============================================================================
@@ -138,6 +334,7 @@
 // ============================================================================
 
 // Log buffer as hex dump
+#if LOG_LOCAL_LEVEL >= LOG_LVL_DEBUG
 #define LOG_BUFFER_HEX(tag, buffer, length) \
     do { \
         const uint8_t *_buf = (const uint8_t *)(buffer); \
@@ -152,25 +349,8 @@
             LOG_D(tag, "%s", _line); \
         } \
     } while(0)
-
-// Compile-time log level control
-#ifndef LOG_LOCAL_LEVEL
-    #define LOG_LOCAL_LEVEL  3  // 0=None, 1=Error, 2=Warn, 3=Info, 4=Debug, 5=Verbose
-#endif
-
-#if LOG_LOCAL_LEVEL < 3
-    #undef LOG_I
-    #define LOG_I(tag, format, ...)  ((void)0)
-#endif
-
-#if LOG_LOCAL_LEVEL < 4
-    #undef LOG_D
-    #define LOG_D(tag, format, ...)  ((void)0)
-#endif
-
-#if LOG_LOCAL_LEVEL < 5
-    #undef LOG_V
-    #define LOG_V(tag, format, ...)  ((void)0)
+#else
+#define LOG_BUFFER_HEX(tag, buffer, length)  do { (void)(buffer); (void)(length); } while (0)
 #endif
 
 #endif // PORTABLE_LOG_H
@@ -0,0 +1,279 @@
+#include "spi_nor.h"
+#include "hal_delay.h"
+#include <stddef.h>
+
+// Command set shared by the common 25-series parts
+#define CMD_WRITE_ENABLE        0x06
+#define CMD_READ_STATUS1        0x05
+#define CMD_READ_JEDEC_ID       0x9F
+#define CMD_RELEASE_POWER_DOWN  0xAB
+#define CMD_READ                0x03
+#define CMD_READ_4B             0x13
+#define CMD_PAGE_PROGRAM        0x02
+#define CMD_PAGE_PROGRAM_4B     0x12
+#define CMD_SECTOR_ERASE        0x20
+#define CMD_SECTOR_ERASE_4B     0x21
+
+#define STATUS_BUSY             0x01
+
+#define CMD_TIMEOUT_MS          10
+#define PAGES_PER_SECTOR        (SPI_NOR_SECTOR_SIZE / SPI_NOR_PAGE_SIZE)
+
+// Task context only: device_select may reprogram a shared bus
+static inline void cs_low(spi_nor_t *nor)
+{
+    hal_spi_device_select(&nor->device);
+    hal_gpio_reset_fast(nor->cs_port, nor->cs_pin);
+}
+
+static inline void cs_high(spi_nor_t *nor)
+{
+    hal_gpio_set_fast(nor->cs_port, nor->cs_pin);
+}
+
+// Opcode plus 3 or 4 address bytes into nor->cmd, returns the length
+static uint16_t build_cmd(spi_nor_t *nor, uint8_t op3, uint8_t op4, uint32_t addr)
+{
+    uint16_t len = 0;
+    nor->cmd[len++] = nor->addr_4byte ? op4 : op3;
+    if (nor->addr_4byte) {
+        nor->cmd[len++] = (uint8_t)(addr >> 24);
+    }
+    nor->cmd[len++] = (uint8_t)(addr >> 16);
+    nor->cmd[len++] = (uint8_t)(addr >> 8);
+    nor->cmd[len++] = (uint8_t)addr;
+    return len;
+}
+
+static hal_spi_status_t send_simple(spi_nor_t *nor, uint8_t op)
+{
+    cs_low(nor);
+    hal_spi_status_t status = hal_spi_transmit(nor->hspi, &op, 1, CMD_TIMEOUT_MS);
+    cs_high(nor);
+    return status;
+}
+
+static hal_spi_status_t read_status(spi_nor_t *nor, uint8_t *status_reg)
+{
+    uint8_t tx[2] = { CMD_READ_STATUS1, 0xFF };
+    uint8_t rx[2] = { 0 };
+
+    cs_low(nor);
+    hal_spi_status_t status = hal_spi_transmit_receive(nor->hspi, tx, rx, 2, CMD_TIMEOUT_MS);
+    cs_high(nor);
+
+    *status_reg = rx[1];
+    return status;
+}
+
+// DMA completion of a page payload (ISR context)
+static void page_done(hal_spi_handle_t handle, hal_spi_status_t status, void *user_data)
+{
+    (void)handle;
+    spi_nor_t *nor = (spi_nor_t *)user_data;
+
+    cs_high(nor);   // Ends the page program command, programming starts
+    if (status != HAL_SPI_OK) {
+        nor->phase = SPI_NOR_PHASE_FAILED;
+    }
+    nor->dma_active = false;
+}
+
+static hal_spi_status_t start_page(spi_nor_t *nor)
+{
+    if (send_simple(nor, CMD_WRITE_ENABLE) != HAL_SPI_OK) {
+        return HAL_SPI_ERROR;
+    }
+
+    uint32_t offset = nor->write_page * SPI_NOR_PAGE_SIZE;
+    uint16_t len = build_cmd(nor, CMD_PAGE_PROGRAM, CMD_PAGE_PROGRAM_4B, nor->write_addr + offset);
+
+    cs_low(nor);
+    if (hal_spi_transmit(nor->hspi, nor->cmd, len, CMD_TIMEOUT_MS) != HAL_SPI_OK) {
+        cs_high(nor);
+        return HAL_SPI_ERROR;
+    }
+
+    nor->dma_active = true;
+    nor->phase_tick = hal_get_tick();
+    if (hal_spi_transmit_dma(nor->hspi, nor->write_data + offset, SPI_NOR_PAGE_SIZE,
+                             page_done, nor) != HAL_SPI_OK) {
+        nor->dma_active = false;
+        cs_high(nor);
+        return HAL_SPI_ERROR;
+    }
+    return HAL_SPI_OK;
+}
+
+hal_spi_status_t spi_nor_open(spi_nor_t *nor, hal_spi_handle_t hspi,
+                              hal_gpio_port_t cs_port, hal_gpio_pin_t cs_pin)
+{
+    if (nor == NULL || hspi == NULL) {
+        return HAL_SPI_ERROR;
+    }
+
+    nor->hspi = hspi;
+    nor->device.bus = hspi;
+    nor->device.mode = 0;
+    hal_spi_device_set_max_hz(&nor->device, SPI_NOR_SPI_MAX_HZ);
+    nor->cs_port = cs_port;
+    nor->cs_pin = cs_pin;
+    nor->initialized = false;
+    nor->phase = SPI_NOR_PHASE_IDLE;
+    nor->dma_active = false;
+    nor->addr_4byte = false;
+    cs_high(nor);
+
+    if (send_simple(nor, CMD_RELEASE_POWER_DOWN) != HAL_SPI_OK) {
+        return HAL_SPI_ERROR;
+    }
+    hal_delay_ms(1);    // tRES1 is a few us
+
+    uint8_t tx[4] = { CMD_READ_JEDEC_ID, 0xFF, 0xFF, 0xFF };
+    uint8_t rx[4] = { 0 };
+    cs_low(nor);
+    hal_spi_status_t status = hal_spi_transmit_receive(hspi, tx, rx, 4, CMD_TIMEOUT_MS);
+    cs_high(nor);
+    if (status != HAL_SPI_OK) {
+        return status;
+    }
+
+    nor->jedec_id[0] = rx[1];
+    nor->jedec_id[1] = rx[2];
+    nor->jedec_id[2] = rx[3];
+
+    // Capacity byte is log2 of the size; no chip or a floating bus reads 0x00/0xFF
+    uint8_t capacity = rx[3];
+    if (capacity < 0x10 || capacity > 0x1F) {
+        return HAL_SPI_ERROR;
+    }
+    nor->size_bytes = 1UL << capacity;
+    nor->addr_4byte = nor->size_bytes > (16UL * 1024UL * 1024UL);
+
+    nor->initialized = true;
+    return HAL_SPI_OK;
+}
+
+hal_spi_status_t spi_nor_read(spi_nor_t *nor, uint32_t addr, uint8_t *data, uint32_t len)
+{
+    if (nor == NULL || !nor->initialized || data == NULL || addr + len > nor->size_bytes) {
+        return HAL_SPI_ERROR;
+    }
+    if (nor->phase != SPI_NOR_PHASE_IDLE) {
+        return HAL_SPI_BUSY;
+    }
+
+    uint16_t cmd_len = build_cmd(nor, CMD_READ, CMD_READ_4B, addr);
+
+    cs_low(nor);
+    hal_spi_status_t status = hal_spi_transmit(nor->hspi, nor->cmd, cmd_len, CMD_TIMEOUT_MS);
+    // The read command streams on for as long as chip select stays low
+    while (status == HAL_SPI_OK && len > 0) {
+        uint16_t chunk = (len > 0xFFFFU) ? 0xFFFFU : (uint16_t)len;
+        status = hal_spi_receive(nor->hspi, data, chunk, SPI_NOR_READ_TIMEOUT_MS);
+        data += chunk;
+        len -= chunk;
+    }
+    cs_high(nor);
+
+    return status;
+}
+
+hal_spi_status_t spi_nor_write_sector_async(spi_nor_t *nor, uint32_t addr, const uint8_t *data)
+{
+    if (nor == NULL || !nor->initialized || data == NULL ||
+        (addr % SPI_NOR_SECTOR_SIZE) != 0 || addr + SPI_NOR_SECTOR_SIZE > nor->size_bytes) {
+        return HAL_SPI_ERROR;
+    }
+    if (nor->phase != SPI_NOR_PHASE_IDLE) {
+        return HAL_SPI_BUSY;
+    }
+
+    if (send_simple(nor, CMD_WRITE_ENABLE) != HAL_SPI_OK) {
+        return HAL_SPI_ERROR;
+    }
+    uint16_t len = build_cmd(nor, CMD_SECTOR_ERASE, CMD_SECTOR_ERASE_4B, addr);
+    cs_low(nor);
+    hal_spi_status_t status = hal_spi_transmit(nor->hspi, nor->cmd, len, CMD_TIMEOUT_MS);
+    cs_high(nor);
+    if (status != HAL_SPI_OK) {
+        return status;
+    }
+
+    nor->write_data = data;
+    nor->write_addr = addr;
+    nor->write_page = 0;
+    nor->phase_tick = hal_get_tick();
+    nor->phase = SPI_NOR_PHASE_ERASING;
+    return HAL_SPI_OK;
+}
+
+hal_spi_status_t spi_nor_poll(spi_nor_t *nor)
+{
+    if (nor == NULL) {
+        return HAL_SPI_ERROR;
+    }
+
+    switch (nor->phase) {
+        case SPI_NOR_PHASE_IDLE:
+            return HAL_SPI_OK;
+
+        case SPI_NOR_PHASE_FAILED:
+            nor->phase = SPI_NOR_PHASE_IDLE;
+            return HAL_SPI_ERROR;
+
+        default:
+            break;
+    }
+
+    uint32_t timeout = (nor->phase == SPI_NOR_PHASE_ERASING) ?
+                       SPI_NOR_ERASE_TIMEOUT_MS : SPI_NOR_PROGRAM_TIMEOUT_MS;
+    bool timed_out = (hal_get_tick() - nor->phase_tick) > timeout;
+
+    if (nor->dma_active) {
+        if (timed_out) {
+            cs_high(nor);
+            nor->phase = SPI_NOR_PHASE_IDLE;
+            return HAL_SPI_ERROR;
+        }
+        return HAL_SPI_BUSY;
+    }
+    if (nor->phase == SPI_NOR_PHASE_FAILED) {   // Set by page_done() before dma_active cleared
+        nor->phase = SPI_NOR_PHASE_IDLE;
+        return HAL_SPI_ERROR;
+    }
+
+    uint8_t status_reg;
+    if (read_status(nor, &status_reg) != HAL_SPI_OK) {
+        nor->phase = SPI_NOR_PHASE_IDLE;
+        return HAL_SPI_ERROR;
+    }
+    if (status_reg & STATUS_BUSY) {
+        if (timed_out) {
+            nor->phase = SPI_NOR_PHASE_IDLE;
+            return HAL_SPI_ERROR;
+        }
+        return HAL_SPI_BUSY;
+    }
+
+    // Erase finished or the previous page is programmed
+    if (nor->phase == SPI_NOR_PHASE_PROGRAMMING) {
+        nor->write_page++;
+    }
+    if (nor->write_page >= PAGES_PER_SECTOR) {
+        nor->phase = SPI_NOR_PHASE_IDLE;
+        return HAL_SPI_OK;
+    }
+
+    nor->phase = SPI_NOR_PHASE_PROGRAMMING;
+    if (start_page(nor) != HAL_SPI_OK) {
+        nor->phase = SPI_NOR_PHASE_IDLE;
+        return HAL_SPI_ERROR;
+    }
+    return HAL_SPI_BUSY;
+}
+
+bool spi_nor_write_pending(const spi_nor_t *nor)
+{
+    return nor->phase != SPI_NOR_PHASE_IDLE;
+}
@@ -0,0 +1,71 @@
+#ifndef SPI_NOR_H
+#define SPI_NOR_H
+
+#include "hal_spi.h"
+#include "hal_gpio.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// JEDEC serial NOR flash (W25Qxx and compatibles) on a plain SPI bus.
+// Sectors are written without blocking: spi_nor_write_sector_async() starts
+// a 4 KB erase, spi_nor_poll() then checks the busy flag and feeds the
+// sector page by page over DMA. Reads are polled.
+
+#define SPI_NOR_SECTOR_SIZE         4096U
+#define SPI_NOR_PAGE_SIZE           256U
+
+#define SPI_NOR_ERASE_TIMEOUT_MS    500     // 4 KB sector erase, max 400 ms
+#define SPI_NOR_PROGRAM_TIMEOUT_MS  20      // Page program, max 3 ms
+#define SPI_NOR_READ_TIMEOUT_MS     100
+
+// SCK cap for the flash, selected on every chip select (W25Q: 50 MHz for
+// the plain 0x03 read, the lowest of its limits)
+#ifndef SPI_NOR_SPI_MAX_HZ
+#define SPI_NOR_SPI_MAX_HZ          50000000U
+#endif
+
+// Phases of a non-blocking sector write
+typedef enum {
+    SPI_NOR_PHASE_IDLE = 0,
+    SPI_NOR_PHASE_ERASING,            // waiting for the sector erase
+    SPI_NOR_PHASE_PROGRAMMING,        // page on the bus or being programmed
+    SPI_NOR_PHASE_FAILED              // transfer failed or timed out
+} spi_nor_phase_t;
+
+typedef struct {
+    bool initialized;
+    hal_spi_handle_t hspi;
+    hal_spi_device_t device;          // clock and mode for this chip
+    hal_gpio_port_t cs_port;
+    hal_gpio_pin_t cs_pin;
+    uint8_t jedec_id[3];              // manufacturer, type, capacity
+    uint32_t size_bytes;
+    bool addr_4byte;                  // above 16 MB: 4-byte address opcodes
+    // Non-blocking sector write state
+    volatile spi_nor_phase_t phase;
+    volatile bool dma_active;         // page payload on the bus
+    const uint8_t *write_data;        // SPI_NOR_SECTOR_SIZE bytes, caller-owned
+    uint32_t write_addr;
+    uint32_t write_page;              // next page to program
+    uint32_t phase_tick;
+    uint8_t cmd[5];
+} spi_nor_t;
+
+// Identify the chip (JEDEC ID) and release it from power-down
+hal_spi_status_t spi_nor_open(spi_nor_t *nor, hal_spi_handle_t hspi,
+                              hal_gpio_port_t cs_port, hal_gpio_pin_t cs_pin);
+
+// Read any number of bytes (blocking; not while a write is in progress)
+hal_spi_status_t spi_nor_read(spi_nor_t *nor, uint32_t addr, uint8_t *data, uint32_t len);
+
+// Start erasing and programming one sector; data must stay valid until done
+hal_spi_status_t spi_nor_write_sector_async(spi_nor_t *nor, uint32_t addr, const uint8_t *data);
+
+// Advance a sector write: HAL_SPI_BUSY while running, then HAL_SPI_OK or
+// HAL_SPI_ERROR once (the driver is idle again afterwards)
+hal_spi_status_t spi_nor_poll(spi_nor_t *nor);
+
+// True while a sector write is in progress
+bool spi_nor_write_pending(const spi_nor_t *nor);
+
+#endif // SPI_NOR_H
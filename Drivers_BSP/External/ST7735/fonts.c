@@ -1,6 +1,9 @@
 /* vim: set ai et ts=4 sw=4: */
 #include "fonts.h"
 
+// Source of the packed tables in fonts_packed.c (tools/font_pack.py)
+#if !FONTS_PACKED
+
 static const uint16_t Font7x10 [] = {
 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // sp
 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x0000, 0x1000, 0x0000, 0x0000,  // !
@@ -296,6 +299,8 @@ static const uint16_t Font16x26 [] = {
 };
 
 
-FontDef Font_7x10 = {7,10,Font7x10};
-FontDef Font_11x18 = {11,18,Font11x18};
-FontDef Font_16x26 = {16,26,Font16x26};
+const FontDef Font_7x10 = {7,10,Font7x10};
+const FontDef Font_11x18 = {11,18,Font11x18};
+const FontDef Font_16x26 = {16,26,Font16x26};
+
+#endif // !FONTS_PACKED
@@ -3,16 +3,137 @@
 #define __FONTS_H__
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
 
+// Glyph storage. ROWS16 is the original one uint16_t per row (MSB = left
+// column); the packed forms come from tools/font_pack.py (fonts_packed.c):
+//   PACKED1  width * height bits per glyph, row-major, MSB first
+//   RLE      bytes of (pixel << 7 | run length) over the same bit stream,
+//            glyph starts in offsets[]
+typedef enum {
+    FONT_FORMAT_ROWS16 = 0,
+    FONT_FORMAT_PACKED1,
+    FONT_FORMAT_RLE
+} FontFormat;
+
+// {width, height, data} initializers keep meaning a ROWS16 font over ASCII 32..126
 typedef struct {
     const uint8_t width;
     uint8_t height;
-    const uint16_t *data;
+    const uint16_t *data;       // ROWS16 rows
+    uint8_t format;             // FontFormat
+    const char *chars;          // Atlas characters in glyph order, NULL for ASCII 32..126
+    const uint8_t *bits;        // PACKED1 / RLE glyph data
+    const uint16_t *offsets;    // RLE: byte offset of each glyph in bits
 } FontDef;
 
+// 1: Font_7x10/11x18/16x26 are the packed tables of fonts_packed.c (7.9 KB
+// instead of 10.3 KB of flash); 0: the uint16_t rows of fonts.c
+#ifndef FONTS_PACKED
+#define FONTS_PACKED 1
+#endif
+
+extern const FontDef Font_7x10;
+extern const FontDef Font_11x18;
+extern const FontDef Font_16x26;
+
+// Reading atlases " +-.0123456789:%ACVWm" (other characters draw blank)
+extern const FontDef Font_11x18_Digits;
+extern const FontDef Font_16x26_Digits;
+
+// Row-by-row decoder, so renderers never hold an unpacked glyph bitmap
+typedef struct {
+    uint8_t format;
+    uint8_t width;
+    const uint16_t *rows;       // ROWS16
+    const uint8_t *bits;        // PACKED1: glyph start / RLE: next run
+    uint32_t bit;               // PACKED1: next bit
+    uint8_t run_left;           // RLE: pixels left in the current run
+    uint8_t run_value;
+} FontGlyph;
+
+/**
+ * @brief Start decoding a glyph
+ * @return false if the font has no such character (decodes as blank rows)
+ */
+static inline bool Font_GlyphBegin(FontGlyph *glyph, const FontDef *font, char ch) {
+    int32_t index = -1;
+    if(font->chars != NULL) {
+        const char *hit = (ch != '\0') ? strchr(font->chars, ch) : NULL;
+        if(hit != NULL)
+            index = (int32_t)(hit - font->chars);
+    } else if(ch >= 32 && ch <= 126) {
+        index = ch - 32;
+    }
+
+    glyph->format = font->format;
+    glyph->width = font->width;
+    glyph->rows = NULL;
+    glyph->bits = NULL;
+    glyph->run_left = 0;
+    glyph->run_value = 0;
+    glyph->bit = 0;
+    if(index < 0) {
+        // Blank: zero columns to decode, every row reads 0
+        glyph->format = FONT_FORMAT_RLE;
+        glyph->width = 0;
+        return false;
+    }
+
+    switch(font->format) {
+    case FONT_FORMAT_PACKED1:
+        glyph->bits = font->bits;
+        glyph->bit = (uint32_t)index * font->width * font->height;
+        break;
+    case FONT_FORMAT_RLE:
+        glyph->bits = font->bits + font->offsets[index];
+        break;
+    default:
+        glyph->rows = font->data + (uint32_t)index * font->height;
+        break;
+    }
+    return true;
+}
+
+/**
+ * @brief Next row of the glyph, MSB = left column (as a ROWS16 row)
+ */
+static inline uint16_t Font_GlyphRow(FontGlyph *glyph) {
+    uint16_t row = 0;
 
-extern FontDef Font_7x10;
-extern FontDef Font_11x18;
-extern FontDef Font_16x26;
+    switch(glyph->format) {
+    case FONT_FORMAT_PACKED1: {
+        // At most 16 bits from up to three bytes (tables are padded)
+        const uint8_t *p = glyph->bits + (glyph->bit >> 3);
+        uint32_t window = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8);
+        row = (uint16_t)((window << (glyph->bit & 7)) >> 16);
+        row &= (uint16_t)(0xFFFF << (16 - glyph->width));
+        glyph->bit += glyph->width;
+        break;
+    }
+    case FONT_FORMAT_RLE:
+        for(uint32_t col = 0; col < glyph->width; ) {
+            if(glyph->run_left == 0) {
+                uint8_t run = *glyph->bits++;
+                glyph->run_value = run >> 7;
+                glyph->run_left = run & 0x7F;
+            }
+            // Whole stretch of the run inside this row at once
+            uint32_t span = glyph->width - col;
+            if(span > glyph->run_left)
+                span = glyph->run_left;
+            if(glyph->run_value)
+                row |= (uint16_t)(((0xFFFFU << (16 - span)) & 0xFFFFU) >> col);
+            glyph->run_left -= span;
+            col += span;
+        }
+        break;
+    default:
+        row = *glyph->rows++;
+        break;
+    }
+    return row;
+}
 
 #endif // __FONTS_H__
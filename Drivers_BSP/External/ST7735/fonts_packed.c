@@ -0,0 +1,631 @@
+/* vim: set ai et ts=4 sw=4: */
+// Generated by tools/font_pack.py from fonts.c; do not edit.
+#include "fonts.h"
+#include <stddef.h>
+
+#if FONTS_PACKED
+
+// Font_7x10: 95 glyphs, 1bpp, 834 bytes (1900 as uint16_t rows)
+static const uint8_t packed_Font7x10_bits[] = {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x81, 0x02, 0x04, 0x08, 0x00, 0x20,
+0x00, 0x02, 0x85, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x12, 0x7C, 0x49, 0x23, 0xE4,
+0x89, 0x00, 0x00, 0x38, 0xA9, 0x41, 0xC1, 0x4A, 0x95, 0x1C, 0x10, 0x00, 0x82, 0xA5, 0x86, 0x0A,
+0x2A, 0x14, 0x10, 0x00, 0x01, 0x05, 0x0A, 0x08, 0x34, 0x91, 0x21, 0xA0, 0x00, 0x04, 0x08, 0x10,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x20, 0x81, 0x02, 0x04, 0x08, 0x10, 0x10, 0x10, 0x80,
+0x80, 0x81, 0x02, 0x04, 0x08, 0x10, 0x41, 0x01, 0x07, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x10, 0x21, 0xF0, 0x81, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08,
+0x10, 0x20, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x80, 0x00, 0x02, 0x04, 0x10, 0x20, 0x40, 0x82, 0x04, 0x00, 0x00, 0x38, 0x89, 0x12, 0xA4,
+0x48, 0x91, 0x1C, 0x00, 0x00, 0x41, 0x85, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x03, 0x88, 0x91,
+0x02, 0x08, 0x20, 0x83, 0xE0, 0x00, 0x0E, 0x22, 0x04, 0x30, 0x10, 0x24, 0x47, 0x00, 0x00, 0x08,
+0x30, 0xA1, 0x44, 0x8F, 0x82, 0x04, 0x00, 0x01, 0xF2, 0x04, 0x0F, 0x01, 0x02, 0x44, 0x70, 0x00,
+0x03, 0x88, 0x90, 0x3C, 0x44, 0x89, 0x11, 0xC0, 0x00, 0x1F, 0x02, 0x08, 0x20, 0x41, 0x02, 0x04,
+0x00, 0x00, 0x38, 0x89, 0x11, 0xC4, 0x48, 0x91, 0x1C, 0x00, 0x00, 0xE2, 0x24, 0x48, 0x8F, 0x02,
+0x44, 0x70, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x20,
+0x00, 0x00, 0x02, 0x04, 0x08, 0x00, 0x00, 0x31, 0x84, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x0F, 0x80, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x0C, 0x04, 0x31, 0x80, 0x00, 0x00, 0x0E,
+0x22, 0x04, 0x10, 0x40, 0x80, 0x02, 0x00, 0x00, 0x38, 0x89, 0x32, 0xA5, 0xC8, 0x10, 0x1C, 0x00,
+0x00, 0x41, 0x42, 0x85, 0x0A, 0x3E, 0x44, 0x88, 0x00, 0x07, 0x88, 0x91, 0x3C, 0x44, 0x89, 0x13,
+0xC0, 0x00, 0x0E, 0x22, 0x40, 0x81, 0x02, 0x04, 0x47, 0x00, 0x00, 0x70, 0x91, 0x12, 0x24, 0x48,
+0x92, 0x38, 0x00, 0x01, 0xF2, 0x04, 0x0F, 0x90, 0x20, 0x40, 0xF8, 0x00, 0x07, 0xC8, 0x10, 0x3C,
+0x40, 0x81, 0x02, 0x00, 0x00, 0x0E, 0x22, 0x40, 0x81, 0x72, 0x24, 0x47, 0x00, 0x00, 0x44, 0x89,
+0x13, 0xE4, 0x48, 0x91, 0x22, 0x00, 0x00, 0xE0, 0x81, 0x02, 0x04, 0x08, 0x10, 0x70, 0x00, 0x00,
+0x40, 0x81, 0x02, 0x04, 0x09, 0x11, 0xC0, 0x00, 0x11, 0x24, 0x50, 0xC1, 0x42, 0x44, 0x88, 0x80,
+0x00, 0x40, 0x81, 0x02, 0x04, 0x08, 0x10, 0x3E, 0x00, 0x01, 0x13, 0x66, 0xCA, 0x91, 0x22, 0x44,
+0x88, 0x00, 0x04, 0x4C, 0x99, 0x2A, 0x54, 0x99, 0x32, 0x20, 0x00, 0x0E, 0x22, 0x44, 0x89, 0x12,
+0x24, 0x47, 0x00, 0x00, 0x78, 0x89, 0x12, 0x27, 0x88, 0x10, 0x20, 0x00, 0x00, 0xE2, 0x24, 0x48,
+0x91, 0x22, 0x54, 0x70, 0x10, 0x07, 0x88, 0x91, 0x22, 0x78, 0x91, 0x22, 0x20, 0x00, 0x0E, 0x22,
+0x40, 0x60, 0x20, 0x24, 0x47, 0x00, 0x00, 0x7C, 0x20, 0x40, 0x81, 0x02, 0x04, 0x08, 0x00, 0x01,
+0x12, 0x24, 0x48, 0x91, 0x22, 0x44, 0x70, 0x00, 0x04, 0x48, 0x91, 0x14, 0x28, 0x50, 0x40, 0x80,
+0x00, 0x11, 0x22, 0x54, 0xA9, 0x53, 0x62, 0x85, 0x00, 0x00, 0x44, 0x50, 0xA0, 0x81, 0x05, 0x0A,
+0x22, 0x00, 0x01, 0x12, 0x22, 0x85, 0x04, 0x08, 0x10, 0x20, 0x00, 0x07, 0xC0, 0x82, 0x08, 0x10,
+0x41, 0x03, 0xE0, 0x00, 0x06, 0x08, 0x10, 0x20, 0x40, 0x81, 0x02, 0x04, 0x0C, 0x20, 0x40, 0x40,
+0x81, 0x02, 0x02, 0x04, 0x00, 0x00, 0xC0, 0x81, 0x02, 0x04, 0x08, 0x10, 0x20, 0x41, 0x81, 0x05,
+0x0A, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F,
+0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x88, 0x8F, 0x22, 0x4C, 0x68,
+0x00, 0x04, 0x08, 0x16, 0x32, 0x44, 0x89, 0x92, 0xC0, 0x00, 0x00, 0x00, 0x38, 0x89, 0x02, 0x04,
+0x47, 0x00, 0x00, 0x04, 0x08, 0xD2, 0x64, 0x48, 0x93, 0x1A, 0x00, 0x00, 0x00, 0x03, 0x88, 0x9F,
+0x20, 0x44, 0x70, 0x00, 0x00, 0xC2, 0x1F, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x34,
+0x99, 0x12, 0x24, 0xC6, 0x81, 0x3C, 0x40, 0x81, 0x63, 0x24, 0x48, 0x91, 0x22, 0x00, 0x00, 0x40,
+0x07, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x01, 0x00, 0x1C, 0x08, 0x10, 0x20, 0x40, 0x81, 0x1C,
+0x10, 0x20, 0x48, 0xA1, 0x82, 0x84, 0x88, 0x80, 0x00, 0x70, 0x20, 0x40, 0x81, 0x02, 0x04, 0x08,
+0x00, 0x00, 0x00, 0x07, 0x8A, 0x95, 0x2A, 0x54, 0xA8, 0x00, 0x00, 0x00, 0x16, 0x32, 0x44, 0x89,
+0x12, 0x20, 0x00, 0x00, 0x00, 0x38, 0x89, 0x12, 0x24, 0x47, 0x00, 0x00, 0x00, 0x01, 0x63, 0x24,
+0x48, 0x99, 0x2C, 0x40, 0x80, 0x00, 0x03, 0x49, 0x91, 0x22, 0x4C, 0x68, 0x10, 0x20, 0x00, 0x16,
+0x32, 0x40, 0x81, 0x02, 0x00, 0x00, 0x00, 0x00, 0x38, 0x88, 0xC0, 0x44, 0x47, 0x00, 0x00, 0x20,
+0x41, 0xE1, 0x02, 0x04, 0x08, 0x0C, 0x00, 0x00, 0x00, 0x04, 0x48, 0x91, 0x22, 0x4C, 0x68, 0x00,
+0x00, 0x00, 0x11, 0x22, 0x28, 0x50, 0xA0, 0x80, 0x00, 0x00, 0x00, 0x54, 0xA9, 0x53, 0x62, 0x85,
+0x00, 0x00, 0x00, 0x01, 0x11, 0x41, 0x02, 0x0A, 0x22, 0x00, 0x00, 0x00, 0x04, 0x48, 0x8A, 0x14,
+0x10, 0x20, 0x43, 0x00, 0x00, 0x1F, 0x04, 0x10, 0x41, 0x03, 0xE0, 0x00, 0x06, 0x08, 0x10, 0x20,
+0x81, 0x01, 0x02, 0x04, 0x0C, 0x10, 0x20, 0x40, 0x81, 0x02, 0x04, 0x08, 0x10, 0x20, 0xC0, 0x81,
+0x02, 0x02, 0x04, 0x10, 0x20, 0x41, 0x80, 0x00, 0x00, 0x3A, 0x4C, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00,
+};
+
+// Font_11x18: 95 glyphs, 1bpp, 2354 bytes (3420 as uint16_t rows)
+static const uint8_t packed_Font11x18_bits[] = {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00,
+0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x00, 0x00, 0x60, 0x0C, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x36, 0x06, 0xC0, 0xD8, 0x1B, 0x03, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x19, 0x83, 0x30,
+0x66, 0x3F, 0xE7, 0xFC, 0x33, 0x0C, 0xC3, 0xFE, 0x7F, 0xC6, 0x60, 0xCC, 0x19, 0x83, 0x30, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x03, 0xC0, 0xFC, 0x3A, 0xC6, 0x58, 0xE8, 0x0F, 0x00, 0xF0, 0x07, 0x00,
+0xB1, 0x96, 0x32, 0xC7, 0x58, 0x7E, 0x07, 0x80, 0x20, 0x04, 0x00, 0x00, 0x00, 0x38, 0x0D, 0x81,
+0xB0, 0xB6, 0x36, 0xCC, 0x73, 0x00, 0xC0, 0x30, 0x0D, 0xC3, 0x6C, 0xCD, 0x91, 0xB0, 0x36, 0x03,
+0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x0F, 0xC1, 0x98, 0x33, 0x06, 0x60, 0x78, 0x06, 0x03,
+0xCC, 0xCD, 0x98, 0xE3, 0x0C, 0x63, 0x87, 0xD8, 0x72, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x20, 0x0C, 0x03, 0x00, 0x60, 0x08, 0x03, 0x00,
+0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0x40, 0x0C, 0x01, 0x80, 0x18, 0x01, 0x00, 0x10, 0x80,
+0x08, 0x01, 0x80, 0x18, 0x03, 0x00, 0x20, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01,
+0x00, 0x60, 0x0C, 0x03, 0x00, 0x40, 0x10, 0x00, 0x00, 0x18, 0x0B, 0x41, 0xF8, 0x1E, 0x06, 0x60,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC1, 0xFF, 0xBF, 0xF0, 0x60, 0x0C, 0x01,
+0x80, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x03, 0x00, 0x20, 0x04,
+0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x01,
+0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x30, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x03, 0x00, 0x60, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x03, 0x00,
+0x60, 0x0C, 0x01, 0x80, 0x60, 0x0C, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xC0, 0xFC,
+0x19, 0x86, 0x18, 0xC3, 0x18, 0x63, 0x6C, 0x6D, 0x8C, 0x31, 0x86, 0x30, 0xC3, 0x30, 0x7E, 0x07,
+0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0xE0, 0x3C, 0x0D, 0x81, 0x30, 0x06, 0x00, 0xC0,
+0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C,
+0x0F, 0xC3, 0x9C, 0x61, 0x8C, 0x30, 0x06, 0x01, 0x80, 0x60, 0x18, 0x06, 0x01, 0x80, 0x60, 0x0F,
+0xF1, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x3E, 0x0C, 0x61, 0x8C, 0x01, 0x80, 0xE0,
+0x1C, 0x00, 0xC0, 0x0C, 0x01, 0x8C, 0x31, 0xCE, 0x1F, 0x81, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0xC0, 0x38, 0x07, 0x01, 0xE0, 0x3C, 0x05, 0x81, 0xB0, 0x36, 0x0C, 0xC1, 0xFE, 0x3F, 0xC0,
+0x60, 0x0C, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x87, 0xF0, 0xC0, 0x18, 0x03, 0x00,
+0x6E, 0x0F, 0xE1, 0x8E, 0x00, 0xC0, 0x18, 0xC3, 0x1C, 0xE1, 0xF8, 0x1E, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x3C, 0x0F, 0xC1, 0x9C, 0x61, 0x8C, 0x01, 0xB8, 0x3F, 0x87, 0x38, 0xC3, 0x18, 0x63,
+0x0C, 0x33, 0x87, 0xE0, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xFC, 0x7F, 0x80, 0x30, 0x0C,
+0x01, 0x80, 0x60, 0x0C, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x03, 0xC0, 0xFC, 0x31, 0xC6, 0x18, 0xC3, 0x08, 0x40, 0xF0, 0x3F, 0x0C, 0x31,
+0x86, 0x30, 0xC6, 0x18, 0x7E, 0x07, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x03, 0xF0, 0xE6,
+0x18, 0x63, 0x0C, 0x61, 0x8E, 0x70, 0xFE, 0x0E, 0xC0, 0x18, 0xC3, 0x1C, 0xC1, 0xF8, 0x1E, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x30, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00,
+0xC0, 0x08, 0x01, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x07, 0x03, 0x81, 0xC0,
+0x60, 0x07, 0x00, 0x38, 0x01, 0xC0, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x03, 0xFC, 0x7F, 0x80, 0x00, 0x00, 0x3F, 0xC7, 0xF8, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x0E, 0x00, 0x70,
+0x03, 0x80, 0x18, 0x0E, 0x07, 0x03, 0x80, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0xF8, 0x3F, 0x8E, 0x39, 0x83, 0x00, 0x60, 0x1C, 0x07, 0x01, 0xC0, 0x70, 0x0C, 0x01, 0x80,
+0x00, 0x06, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xC0, 0xFC, 0x18, 0xC7, 0x18, 0xC7,
+0x1B, 0xE3, 0x6C, 0x6D, 0x8D, 0xF1, 0x9E, 0x30, 0x03, 0x20, 0x7C, 0x07, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x07, 0x00, 0xE0, 0x36, 0x06, 0xC0, 0xD8, 0x1B, 0x06, 0x30, 0xC6, 0x1F, 0xC3, 0xF8,
+0x63, 0x18, 0x33, 0x06, 0x60, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x1F, 0x83, 0x18, 0x63,
+0x0C, 0x61, 0x8C, 0x3F, 0x07, 0xE0, 0xC6, 0x18, 0x63, 0x0C, 0x63, 0x8F, 0xE1, 0xF8, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0xF0, 0x3F, 0x06, 0x31, 0x86, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00,
+0x60, 0x0C, 0x30, 0xC6, 0x1F, 0x81, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x81, 0xFC, 0x31,
+0x86, 0x38, 0xC3, 0x18, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x86, 0x31, 0x86, 0x30, 0xFC, 0x1F, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xC7, 0xF8, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0F, 0xE1, 0xFC,
+0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0xFC, 0x7F, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x1F,
+0xE3, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x3F, 0x87, 0xF0, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01,
+0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x3F, 0x06, 0x31, 0x86, 0x30, 0x06, 0x00, 0xC0,
+0x18, 0xE3, 0x1C, 0x61, 0x8C, 0x30, 0xC6, 0x1F, 0xC1, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C,
+0x31, 0x86, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0x63, 0xFC, 0x7F, 0x8C, 0x31, 0x86, 0x30, 0xC6, 0x18,
+0xC3, 0x18, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x83, 0xF0, 0x18, 0x03, 0x00, 0x60, 0x0C,
+0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x01, 0xF8, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x18, 0x63, 0x0C,
+0x73, 0x87, 0xE0, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x06, 0x61, 0x8C, 0x61, 0x98, 0x33,
+0x06, 0xC0, 0xF0, 0x1F, 0x03, 0x30, 0x66, 0x0C, 0x61, 0x86, 0x30, 0xC6, 0x0C, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80,
+0x30, 0x06, 0x00, 0xFF, 0x1F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0xE7, 0x1C, 0xF7, 0x9E,
+0xB3, 0x56, 0x6A, 0xCD, 0xD9, 0x93, 0x30, 0x66, 0x0C, 0xC1, 0x98, 0x33, 0x06, 0x60, 0xC0, 0x00,
+0x00, 0x00, 0x00, 0x00, 0xE3, 0x1C, 0x63, 0xCC, 0x79, 0x8F, 0x31, 0xB6, 0x36, 0xC6, 0xD8, 0xCB,
+0x19, 0xE3, 0x3C, 0x67, 0x8C, 0x71, 0x8E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x3F, 0x06,
+0x61, 0x86, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0x63, 0x0C, 0x61, 0x8C, 0x30, 0xCC, 0x1F, 0x81, 0xE0,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xC1, 0xFC, 0x31, 0xC6, 0x18, 0xC3, 0x18, 0x63, 0x1C, 0x7F,
+0x0F, 0xC1, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x03,
+0xF0, 0x66, 0x18, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x86, 0x30, 0xC6, 0x58, 0xCF, 0x0C, 0xC1, 0xFC,
+0x1E, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x1F, 0xC3, 0x1C, 0x61, 0x8C, 0x31, 0x8E, 0x3F,
+0x87, 0xE0, 0xCC, 0x18, 0xC3, 0x18, 0x61, 0x8C, 0x31, 0x83, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x70, 0x1F, 0x06, 0x30, 0xC6, 0x18, 0x03, 0x80, 0x3C, 0x01, 0xC0, 0x1C, 0x61, 0x8C, 0x30, 0xC6,
+0x1F, 0x81, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0xFB, 0xFF, 0x06, 0x00, 0xC0, 0x18, 0x03,
+0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x86, 0x30, 0xC6, 0x18, 0xC3,
+0x1C, 0xE1, 0xF8, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC1, 0x98, 0x33, 0x06, 0x31, 0x86,
+0x30, 0xC6, 0x0D, 0x81, 0xB0, 0x36, 0x06, 0xC0, 0x70, 0x0E, 0x01, 0xC0, 0x10, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x06, 0x06, 0xC0, 0xD8, 0x1B, 0x03, 0x60, 0x6C, 0xCC, 0x99, 0x13, 0x22, 0xF4, 0x52,
+0x8A, 0x51, 0xCE, 0x30, 0xC6, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x19, 0x82, 0x30, 0xC3,
+0x30, 0x76, 0x07, 0x80, 0x60, 0x0C, 0x03, 0xC0, 0x7C, 0x1D, 0x87, 0x18, 0xC3, 0x30, 0x30, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x60, 0x66, 0x18, 0xC3, 0x0C, 0xC1, 0x98, 0x1E, 0x03, 0xC0, 0x30, 0x06,
+0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x0F, 0xE0,
+0x0C, 0x03, 0x00, 0x60, 0x18, 0x06, 0x00, 0xC0, 0x30, 0x06, 0x01, 0x80, 0x60, 0x0F, 0xF1, 0xFE,
+0x00, 0x00, 0x00, 0x00, 0x03, 0xC0, 0x78, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03,
+0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0xC0, 0x78, 0x00, 0x03, 0x00,
+0x60, 0x0C, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x30, 0x06,
+0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x78, 0x0F, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00,
+0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x78, 0x0F, 0x00, 0x00,
+0x18, 0x03, 0x00, 0xF0, 0x12, 0x06, 0x60, 0xCC, 0x30, 0xC6, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xF8, 0x00,
+0x00, 0x07, 0x00, 0x60, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0xF8, 0x3F, 0x8C, 0x30, 0x06, 0x0F, 0xC3, 0xF8, 0xC3, 0x18, 0xE3, 0xFC, 0x38, 0xC0, 0x00, 0x00,
+0x00, 0x00, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0D, 0xC1, 0xFC, 0x39, 0xC6, 0x18, 0xC3, 0x18,
+0x63, 0x0C, 0x73, 0x8F, 0xE1, 0xB8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x0F, 0x03, 0xF0, 0xE7, 0x18, 0x63, 0x00, 0x60, 0x0C, 0x31, 0xCE, 0x1F, 0x81, 0xE0, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x3B, 0x0F, 0xE3, 0x9C, 0x61, 0x8C,
+0x31, 0x86, 0x30, 0xC7, 0x38, 0x7F, 0x07, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0xF0, 0x3F, 0x0E, 0x61, 0x86, 0x3F, 0xC7, 0xF8, 0xC0, 0x1C, 0x61, 0xF8, 0x1E,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x83, 0xF0, 0x60, 0x0C, 0x0F, 0xF1, 0xFE, 0x06, 0x00,
+0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x76, 0x1F, 0xC7, 0x38, 0xC3, 0x18, 0x63, 0x0C, 0x61, 0x8E, 0x70, 0xFE, 0x0E,
+0xC0, 0x18, 0xC7, 0x1F, 0xC1, 0xF0, 0x00, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xDE, 0x1F, 0xE3,
+0x8C, 0x61, 0x8C, 0x31, 0x86, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x03, 0x00, 0x60, 0x00, 0x00, 0x01, 0xF0, 0x3E, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01,
+0x80, 0x30, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x0C, 0x00, 0x00, 0x00, 0x3E, 0x07, 0xC0,
+0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x23, 0x07, 0xE0, 0x78,
+0x00, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0xC6, 0x30, 0xCC, 0x1B, 0x03, 0xE0, 0x76, 0x0C,
+0x61, 0x8C, 0x30, 0xC6, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xC0, 0xF8, 0x03, 0x00, 0x60,
+0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0xEC, 0xFF, 0xD9, 0xDB, 0x33, 0x66, 0x6C,
+0xCD, 0x99, 0xB3, 0x36, 0x66, 0xCC, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x0D, 0xE1, 0xFE, 0x38, 0xC6, 0x18, 0xC3, 0x18, 0x63, 0x0C, 0x61, 0x8C, 0x31, 0x86, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x03, 0xF0, 0xE7, 0x18, 0x63,
+0x0C, 0x61, 0x8C, 0x31, 0xCE, 0x1F, 0x81, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x06, 0xE0, 0xFE, 0x1C, 0xE3, 0x0C, 0x61, 0x8C, 0x31, 0x86, 0x39, 0xC7, 0xF0, 0xDC, 0x18,
+0x03, 0x00, 0x60, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x61, 0xFC, 0x73, 0x8C, 0x31,
+0x86, 0x30, 0xC6, 0x18, 0xE7, 0x0F, 0xE0, 0xEC, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x0C, 0xE0, 0xFE, 0x1C, 0x83, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06,
+0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x03, 0xF8,
+0xC3, 0x18, 0x03, 0xF8, 0x3F, 0x80, 0x31, 0x86, 0x3F, 0x81, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x20, 0x0C, 0x01, 0x80, 0xFE, 0x1F, 0xC0, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01,
+0x80, 0x3F, 0x03, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x0C,
+0x61, 0x8C, 0x31, 0x86, 0x30, 0xC6, 0x18, 0xC3, 0x18, 0xE3, 0xFC, 0x3D, 0x80, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x18, 0xC6, 0x18, 0xC3, 0x18, 0x36, 0x06, 0xC0,
+0xD8, 0x0E, 0x01, 0xC0, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x6E, 0xCD, 0xD9, 0xBB, 0x15, 0x42, 0xA8, 0x55, 0x0E, 0xE1, 0xDC, 0x11, 0x02, 0x20, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC3, 0x0C, 0xC1, 0x98, 0x1E, 0x01, 0x80,
+0x30, 0x0F, 0x03, 0x30, 0x66, 0x18, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x18, 0x63, 0x0C, 0x31, 0x86, 0x60, 0xCC, 0x0D, 0x81, 0xB0, 0x36, 0x03, 0x80, 0x70, 0x0E, 0x03,
+0x81, 0xF0, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF9, 0xFF, 0x00, 0xC0, 0x30,
+0x0C, 0x03, 0x00, 0xC0, 0x30, 0x0F, 0xF9, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0, 0x3C, 0x06,
+0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x1C, 0x07, 0x00, 0xE0, 0x0E, 0x00, 0xC0, 0x18, 0x03, 0x00,
+0x60, 0x0C, 0x01, 0xE0, 0x1C, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30,
+0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06, 0x00, 0xC0, 0xE0, 0x1E,
+0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0xC0, 0x1C, 0x03, 0x80, 0xE0, 0x18, 0x03, 0x00,
+0x60, 0x0C, 0x01, 0x80, 0xF0, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x1C, 0x47, 0xF8, 0x8E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00,
+};
+
+// Font_16x26: 95 glyphs, RLE, 4735 bytes (4940 as uint16_t rows)
+static const uint8_t packed_Font16x26_bits[] = {
+0x7F, 0x7F, 0x7F, 0x23, 0x06, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83,
+0x0D, 0x83, 0x3C, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x55, 0x03, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03,
+0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03,
+0x84, 0x05, 0x84, 0x03, 0x84, 0x7F, 0x7F, 0x34, 0x07, 0x83, 0x02, 0x83, 0x07, 0x84, 0x02, 0x83,
+0x07, 0x84, 0x01, 0x84, 0x07, 0x83, 0x02, 0x84, 0x07, 0x83, 0x02, 0x83, 0x07, 0x84, 0x02, 0x83,
+0x04, 0x8E, 0x01, 0x8F, 0x05, 0x83, 0x02, 0x83, 0x07, 0x84, 0x02, 0x83, 0x07, 0x84, 0x01, 0x84,
+0x07, 0x84, 0x01, 0x84, 0x07, 0x83, 0x02, 0x84, 0x03, 0xA0, 0x03, 0x84, 0x01, 0x84, 0x07, 0x83,
+0x02, 0x84, 0x07, 0x83, 0x02, 0x83, 0x07, 0x84, 0x02, 0x83, 0x07, 0x84, 0x01, 0x84, 0x07, 0x83,
+0x02, 0x84, 0x55, 0x06, 0x88, 0x06, 0x8B, 0x04, 0x88, 0x01, 0x83, 0x04, 0x84, 0x01, 0x83, 0x08,
+0x84, 0x01, 0x83, 0x08, 0x84, 0x01, 0x83, 0x08, 0x84, 0x01, 0x83, 0x08, 0x88, 0x09, 0x87, 0x0A,
+0x86, 0x0B, 0x86, 0x0B, 0x87, 0x09, 0x88, 0x08, 0x88, 0x08, 0x88, 0x08, 0x88, 0x08, 0x88, 0x08,
+0x88, 0x03, 0x84, 0x01, 0x88, 0x03, 0x8C, 0x06, 0x88, 0x0B, 0x84, 0x0C, 0x84, 0x35, 0x02, 0x85,
+0x07, 0x86, 0x01, 0x83, 0x05, 0x86, 0x02, 0x84, 0x03, 0x87, 0x02, 0x84, 0x03, 0x83, 0x01, 0x83,
+0x03, 0x83, 0x02, 0x84, 0x01, 0x83, 0x03, 0x83, 0x01, 0x84, 0x02, 0x83, 0x02, 0x84, 0x01, 0x83,
+0x03, 0x83, 0x02, 0x88, 0x03, 0x84, 0x01, 0x87, 0x06, 0x89, 0x0C, 0x83, 0x0C, 0x8A, 0x05, 0x8B,
+0x05, 0x87, 0x02, 0x82, 0x04, 0x88, 0x02, 0x82, 0x03, 0x84, 0x01, 0x84, 0x02, 0x82, 0x02, 0x84,
+0x02, 0x84, 0x02, 0x82, 0x02, 0x83, 0x03, 0x84, 0x02, 0x82, 0x01, 0x84, 0x03, 0x84, 0x02, 0x86,
+0x05, 0x8A, 0x07, 0x86, 0x50, 0x05, 0x86, 0x09, 0x89, 0x07, 0x84, 0x01, 0x84, 0x06, 0x85, 0x01,
+0x84, 0x06, 0x85, 0x01, 0x84, 0x06, 0x85, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x88, 0x08,
+0x87, 0x08, 0x86, 0x08, 0x89, 0x04, 0x87, 0x01, 0x84, 0x04, 0x86, 0x02, 0x85, 0x02, 0x87, 0x03,
+0x85, 0x01, 0x87, 0x04, 0x84, 0x01, 0x87, 0x04, 0x8C, 0x05, 0x8C, 0x05, 0x85, 0x02, 0x85, 0x03,
+0x87, 0x02, 0x8E, 0x03, 0x88, 0x01, 0x84, 0x50, 0x06, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x84, 0x0D, 0x83, 0x7F, 0x7F, 0x38, 0x0A, 0x86, 0x09, 0x85, 0x09, 0x85, 0x0B,
+0x84, 0x0B, 0x84, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x85, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x85, 0x0C,
+0x84, 0x0D, 0x84, 0x0C, 0x85, 0x0D, 0x85, 0x0C, 0x86, 0x0C, 0x84, 0x10, 0x01, 0x86, 0x0C, 0x85,
+0x0D, 0x85, 0x0C, 0x84, 0x0D, 0x84, 0x0C, 0x85, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x85, 0x0C, 0x84,
+0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84,
+0x0B, 0x85, 0x0B, 0x84, 0x0B, 0x84, 0x0B, 0x85, 0x09, 0x85, 0x09, 0x86, 0x0A, 0x84, 0x1B, 0x06,
+0x85, 0x0B, 0x84, 0x0D, 0x83, 0x08, 0x83, 0x02, 0x83, 0x02, 0x83, 0x03, 0x8E, 0x02, 0x86, 0x01,
+0x87, 0x06, 0x82, 0x02, 0x81, 0x0B, 0x82, 0x01, 0x83, 0x09, 0x88, 0x07, 0x84, 0x01, 0x84, 0x06,
+0x85, 0x02, 0x84, 0x07, 0x82, 0x03, 0x83, 0x7F, 0x64, 0x67, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D,
+0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x06, 0xA0, 0x07, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D,
+0x83, 0x0D, 0x83, 0x0D, 0x83, 0x56, 0x7F, 0x7F, 0x18, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x83, 0x0C, 0x83, 0x07, 0x7F, 0x33, 0x8D, 0x03, 0x8D,
+0x7F, 0x52, 0x7F, 0x7F, 0x18, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x55, 0x0C, 0x84, 0x0C,
+0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C,
+0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C,
+0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x1C,
+0x05, 0x87, 0x08, 0x89, 0x06, 0x85, 0x01, 0x85, 0x04, 0x85, 0x03, 0x85, 0x03, 0x84, 0x05, 0x84,
+0x02, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84,
+0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84,
+0x01, 0x84, 0x07, 0x84, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x02, 0x84, 0x05, 0x84,
+0x03, 0x85, 0x03, 0x85, 0x04, 0x85, 0x01, 0x85, 0x06, 0x89, 0x08, 0x87, 0x54, 0x08, 0x84, 0x09,
+0x87, 0x06, 0x8A, 0x06, 0x8A, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x06, 0x8E, 0x02, 0x8E, 0x50, 0x04, 0x87, 0x07, 0x8B, 0x05, 0x84, 0x03, 0x85,
+0x0C, 0x84, 0x0C, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x85, 0x0A, 0x85,
+0x0A, 0x85, 0x0A, 0x85, 0x0A, 0x85, 0x0B, 0x84, 0x0B, 0x84, 0x0B, 0x84, 0x0B, 0x85, 0x0B, 0x84,
+0x0C, 0x8D, 0x03, 0x8D, 0x51, 0x04, 0x88, 0x07, 0x8A, 0x06, 0x83, 0x03, 0x85, 0x0C, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0A, 0x85, 0x07, 0x88, 0x08, 0x89, 0x0C, 0x85, 0x0C,
+0x85, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0B, 0x85, 0x04, 0x83, 0x03, 0x85, 0x05,
+0x8A, 0x06, 0x88, 0x55, 0x09, 0x84, 0x0B, 0x85, 0x0B, 0x85, 0x0A, 0x86, 0x09, 0x87, 0x08, 0x88,
+0x08, 0x88, 0x07, 0x84, 0x01, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x05, 0x84,
+0x03, 0x84, 0x04, 0x84, 0x04, 0x84, 0x04, 0x84, 0x04, 0x84, 0x03, 0xA0, 0x09, 0x84, 0x0C, 0x84,
+0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x53, 0x03, 0x8B, 0x05, 0x8B, 0x05, 0x8B, 0x05,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x88, 0x08, 0x8A, 0x0B, 0x86, 0x0B,
+0x85, 0x0C, 0x85, 0x0B, 0x85, 0x0C, 0x84, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x84, 0x05, 0x83, 0x03,
+0x85, 0x05, 0x8A, 0x06, 0x88, 0x55, 0x07, 0x87, 0x07, 0x8A, 0x05, 0x85, 0x03, 0x83, 0x04, 0x85,
+0x0B, 0x84, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x01, 0x86, 0x05, 0x8C, 0x03, 0x87,
+0x02, 0x85, 0x02, 0x86, 0x04, 0x85, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84,
+0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x85, 0x05, 0x84, 0x03, 0x84, 0x04, 0x85, 0x03, 0x85,
+0x02, 0x85, 0x05, 0x8A, 0x08, 0x86, 0x54, 0x02, 0x8E, 0x02, 0x8E, 0x02, 0x8E, 0x0C, 0x84, 0x0B,
+0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x83, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C,
+0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x84, 0x0B, 0x85, 0x0B,
+0x85, 0x58, 0x05, 0x88, 0x07, 0x8A, 0x05, 0x85, 0x02, 0x85, 0x04, 0x84, 0x04, 0x84, 0x03, 0x85,
+0x04, 0x84, 0x03, 0x85, 0x04, 0x84, 0x04, 0x84, 0x04, 0x84, 0x04, 0x85, 0x02, 0x84, 0x06, 0x89,
+0x08, 0x87, 0x08, 0x89, 0x06, 0x84, 0x01, 0x86, 0x04, 0x85, 0x03, 0x85, 0x03, 0x84, 0x05, 0x85,
+0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x02, 0x84, 0x05, 0x85,
+0x02, 0x86, 0x02, 0x85, 0x04, 0x8B, 0x07, 0x87, 0x54, 0x05, 0x87, 0x08, 0x89, 0x06, 0x84, 0x02,
+0x85, 0x04, 0x84, 0x04, 0x85, 0x03, 0x84, 0x05, 0x84, 0x02, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05,
+0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x85, 0x03,
+0x86, 0x03, 0x8D, 0x05, 0x86, 0x01, 0x84, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x85, 0x0B,
+0x84, 0x04, 0x83, 0x03, 0x85, 0x05, 0x8A, 0x07, 0x88, 0x55, 0x66, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x7B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x55, 0x66, 0x85, 0x0B, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x7B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0C, 0x84, 0x0C, 0x84, 0x0C,
+0x84, 0x0B, 0x84, 0x0C, 0x83, 0x07, 0x6E, 0x82, 0x0C, 0x84, 0x0A, 0x86, 0x08, 0x86, 0x08, 0x86,
+0x08, 0x86, 0x08, 0x86, 0x08, 0x87, 0x0B, 0x86, 0x0C, 0x86, 0x0C, 0x86, 0x0C, 0x86, 0x0C, 0x86,
+0x0C, 0x84, 0x0E, 0x82, 0x50, 0x7F, 0x21, 0xA0, 0x30, 0xA0, 0x7F, 0x11, 0x60, 0x83, 0x0D, 0x85,
+0x0C, 0x86, 0x0C, 0x86, 0x0C, 0x86, 0x0C, 0x86, 0x0C, 0x86, 0x0C, 0x85, 0x09, 0x86, 0x08, 0x86,
+0x08, 0x86, 0x08, 0x86, 0x08, 0x86, 0x09, 0x85, 0x0B, 0x83, 0x5D, 0x03, 0x89, 0x06, 0x8C, 0x04,
+0x83, 0x05, 0x85, 0x03, 0x83, 0x06, 0x85, 0x02, 0x83, 0x06, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0B,
+0x84, 0x0B, 0x84, 0x0B, 0x84, 0x0B, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x85, 0x0B, 0x85, 0x3B,
+0x85, 0x0B, 0x85, 0x0B, 0x85, 0x56, 0x06, 0x87, 0x07, 0x8B, 0x04, 0x85, 0x03, 0x84, 0x03, 0x85,
+0x05, 0x84, 0x02, 0x84, 0x03, 0x87, 0x01, 0x84, 0x03, 0x88, 0x01, 0x84, 0x02, 0x84, 0x01, 0x84,
+0x01, 0x83, 0x02, 0x84, 0x03, 0x87, 0x02, 0x84, 0x03, 0x87, 0x02, 0x83, 0x03, 0x88, 0x02, 0x83,
+0x03, 0x88, 0x02, 0x83, 0x03, 0x88, 0x02, 0x83, 0x02, 0x89, 0x02, 0x83, 0x02, 0x85, 0x01, 0x83,
+0x02, 0x8A, 0x01, 0x84, 0x01, 0x8A, 0x01, 0x84, 0x02, 0x85, 0x01, 0x83, 0x02, 0x84, 0x0D, 0x85,
+0x03, 0x83, 0x06, 0x8A, 0x08, 0x87, 0x53, 0x36, 0x85, 0x0B, 0x85, 0x0A, 0x87, 0x09, 0x87, 0x09,
+0x87, 0x08, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x83, 0x02, 0x85, 0x05, 0x84, 0x03,
+0x84, 0x05, 0x84, 0x03, 0x84, 0x04, 0x84, 0x04, 0x85, 0x03, 0x8D, 0x03, 0x8E, 0x01, 0x84, 0x06,
+0x85, 0x01, 0x84, 0x07, 0x88, 0x08, 0x88, 0x09, 0x87, 0x09, 0x83, 0x50, 0x32, 0x8B, 0x05, 0x8C,
+0x04, 0x84, 0x04, 0x85, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84,
+0x03, 0x84, 0x04, 0x85, 0x03, 0x84, 0x03, 0x85, 0x04, 0x8A, 0x06, 0x8B, 0x05, 0x84, 0x03, 0x86,
+0x03, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84,
+0x02, 0x84, 0x05, 0x85, 0x02, 0x8D, 0x03, 0x8B, 0x53, 0x37, 0x89, 0x05, 0x8B, 0x03, 0x86, 0x04,
+0x83, 0x02, 0x85, 0x0B, 0x84, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x85, 0x0B, 0x85, 0x0C, 0x85, 0x0B, 0x86, 0x0B, 0x86, 0x05, 0x82, 0x05, 0x8B, 0x07,
+0x89, 0x50, 0x31, 0x8B, 0x05, 0x8D, 0x03, 0x84, 0x04, 0x86, 0x02, 0x84, 0x06, 0x85, 0x01, 0x84,
+0x06, 0x85, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84,
+0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84,
+0x07, 0x84, 0x01, 0x84, 0x06, 0x85, 0x01, 0x84, 0x06, 0x84, 0x02, 0x84, 0x04, 0x86, 0x02, 0x8C,
+0x04, 0x8A, 0x55, 0x32, 0x8E, 0x02, 0x8E, 0x02, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x0B, 0x8D, 0x03, 0x8D, 0x03, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x0B, 0x8E, 0x02, 0x8E, 0x50, 0x33, 0x8D, 0x03, 0x8D, 0x03, 0x84, 0x0C, 0x84,
+0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x8D, 0x03, 0x8D, 0x03, 0x84, 0x0C, 0x84,
+0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x59, 0x36, 0x89, 0x05,
+0x8C, 0x03, 0x86, 0x04, 0x83, 0x02, 0x85, 0x0A, 0x85, 0x0B, 0x85, 0x0B, 0x84, 0x0B, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x04, 0x8C, 0x04, 0x87, 0x01, 0x84, 0x07, 0x84, 0x01, 0x85, 0x06, 0x84, 0x01,
+0x85, 0x06, 0x84, 0x02, 0x85, 0x05, 0x84, 0x03, 0x86, 0x03, 0x84, 0x04, 0x8C, 0x06, 0x89, 0x51,
+0x31, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85,
+0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85,
+0x01, 0x8F, 0x01, 0x8F, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85,
+0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85,
+0x01, 0x85, 0x05, 0x85, 0x50, 0x32, 0x8E, 0x02, 0x8E, 0x06, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x0B, 0x85, 0x07, 0x8E, 0x02, 0x8E, 0x50, 0x33, 0x8B, 0x05, 0x8B, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x05, 0x83, 0x03, 0x85, 0x05, 0x8A, 0x06, 0x88,
+0x56, 0x32, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x84, 0x03, 0x84, 0x04, 0x84, 0x04, 0x84, 0x03,
+0x84, 0x05, 0x84, 0x02, 0x84, 0x06, 0x84, 0x01, 0x84, 0x07, 0x89, 0x07, 0x88, 0x08, 0x87, 0x09,
+0x88, 0x08, 0x89, 0x07, 0x84, 0x01, 0x85, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x03, 0x84, 0x05,
+0x84, 0x03, 0x85, 0x04, 0x84, 0x04, 0x85, 0x03, 0x84, 0x05, 0x85, 0x02, 0x84, 0x06, 0x84, 0x50,
+0x32, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x8E, 0x02, 0x8E, 0x50, 0x30, 0x85, 0x06, 0x8B, 0x05, 0x8B, 0x05, 0x8C, 0x03, 0x8D, 0x03,
+0x8D, 0x03, 0x8E, 0x01, 0x8F, 0x01, 0x83, 0x01, 0x8B, 0x01, 0x83, 0x01, 0x87, 0x01, 0x87, 0x01,
+0x87, 0x01, 0x86, 0x02, 0x87, 0x02, 0x85, 0x02, 0x87, 0x02, 0x85, 0x02, 0x87, 0x02, 0x84, 0x03,
+0x87, 0x09, 0x87, 0x09, 0x87, 0x09, 0x87, 0x09, 0x83, 0x50, 0x31, 0x85, 0x06, 0x84, 0x01, 0x85,
+0x06, 0x84, 0x01, 0x86, 0x05, 0x84, 0x01, 0x87, 0x04, 0x84, 0x01, 0x87, 0x04, 0x84, 0x01, 0x88,
+0x03, 0x84, 0x01, 0x88, 0x03, 0x84, 0x01, 0x89, 0x02, 0x84, 0x01, 0x84, 0x01, 0x85, 0x01, 0x84,
+0x01, 0x84, 0x02, 0x84, 0x01, 0x84, 0x01, 0x84, 0x02, 0x89, 0x01, 0x84, 0x03, 0x88, 0x01, 0x84,
+0x03, 0x88, 0x01, 0x84, 0x04, 0x87, 0x01, 0x84, 0x05, 0x86, 0x01, 0x84, 0x05, 0x86, 0x01, 0x84,
+0x06, 0x85, 0x01, 0x84, 0x06, 0x85, 0x50, 0x35, 0x87, 0x07, 0x8B, 0x04, 0x85, 0x03, 0x85, 0x02,
+0x85, 0x05, 0x85, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x89, 0x07, 0x89, 0x07, 0x89, 0x07,
+0x89, 0x07, 0x89, 0x07, 0x89, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01,
+0x85, 0x05, 0x85, 0x02, 0x85, 0x03, 0x85, 0x04, 0x8B, 0x07, 0x87, 0x54, 0x32, 0x8C, 0x04, 0x8E,
+0x02, 0x85, 0x04, 0x85, 0x02, 0x85, 0x05, 0x84, 0x02, 0x85, 0x05, 0x84, 0x02, 0x85, 0x05, 0x84,
+0x02, 0x85, 0x05, 0x84, 0x02, 0x85, 0x04, 0x85, 0x02, 0x85, 0x03, 0x86, 0x02, 0x8C, 0x04, 0x8A,
+0x06, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x59, 0x35,
+0x87, 0x07, 0x8B, 0x04, 0x85, 0x03, 0x85, 0x02, 0x85, 0x05, 0x85, 0x01, 0x84, 0x07, 0x84, 0x01,
+0x84, 0x07, 0x89, 0x07, 0x89, 0x07, 0x89, 0x07, 0x89, 0x07, 0x89, 0x07, 0x89, 0x07, 0x84, 0x01,
+0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x85, 0x05, 0x85, 0x02, 0x85, 0x03, 0x85, 0x04,
+0x8B, 0x07, 0x88, 0x0C, 0x85, 0x0C, 0x86, 0x0C, 0x84, 0x0E, 0x82, 0x10, 0x32, 0x8A, 0x06, 0x8C,
+0x04, 0x84, 0x03, 0x86, 0x03, 0x84, 0x04, 0x85, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84,
+0x03, 0x84, 0x04, 0x85, 0x03, 0x84, 0x04, 0x84, 0x04, 0x84, 0x02, 0x86, 0x04, 0x8A, 0x06, 0x89,
+0x07, 0x84, 0x01, 0x85, 0x06, 0x84, 0x02, 0x85, 0x05, 0x84, 0x03, 0x85, 0x04, 0x84, 0x04, 0x85,
+0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x85, 0x02, 0x84, 0x06, 0x84, 0x50, 0x35, 0x89, 0x05,
+0x8C, 0x03, 0x85, 0x05, 0x83, 0x03, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x85, 0x0C, 0x87, 0x0A,
+0x89, 0x09, 0x89, 0x0A, 0x87, 0x0B, 0x85, 0x0C, 0x84, 0x0C, 0x84, 0x02, 0x81, 0x08, 0x85, 0x02,
+0x84, 0x04, 0x85, 0x03, 0x8C, 0x05, 0x89, 0x54, 0x30, 0xA0, 0x06, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x55, 0x31, 0x85, 0x06, 0x84, 0x01,
+0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x01,
+0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x01,
+0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x02,
+0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x85, 0x03, 0x85, 0x04, 0x8B, 0x07, 0x87, 0x54,
+0x30, 0x84, 0x09, 0x87, 0x09, 0x88, 0x08, 0x83, 0x01, 0x84, 0x07, 0x84, 0x01, 0x85, 0x06, 0x84,
+0x02, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x85, 0x04, 0x84, 0x04, 0x84, 0x03, 0x84,
+0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x89, 0x08, 0x87,
+0x09, 0x87, 0x09, 0x87, 0x0A, 0x85, 0x0B, 0x85, 0x55, 0x30, 0x83, 0x0B, 0x86, 0x0A, 0x86, 0x0A,
+0x86, 0x09, 0x87, 0x02, 0x85, 0x02, 0x87, 0x02, 0x85, 0x02, 0x87, 0x02, 0x85, 0x02, 0x83, 0x01,
+0x83, 0x02, 0x85, 0x02, 0x83, 0x01, 0x84, 0x01, 0x86, 0x01, 0x83, 0x01, 0x8B, 0x01, 0x83, 0x01,
+0x8F, 0x01, 0x87, 0x01, 0x87, 0x01, 0x87, 0x01, 0x87, 0x01, 0x87, 0x01, 0x86, 0x03, 0x86, 0x01,
+0x86, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x51, 0x30, 0x85,
+0x08, 0x83, 0x01, 0x85, 0x06, 0x84, 0x02, 0x85, 0x04, 0x84, 0x03, 0x85, 0x03, 0x85, 0x04, 0x85,
+0x02, 0x84, 0x06, 0x89, 0x08, 0x87, 0x09, 0x86, 0x0B, 0x85, 0x0B, 0x85, 0x0A, 0x87, 0x08, 0x89,
+0x07, 0x84, 0x01, 0x85, 0x05, 0x84, 0x02, 0x85, 0x04, 0x84, 0x04, 0x85, 0x02, 0x84, 0x06, 0x85,
+0x01, 0x84, 0x07, 0x88, 0x08, 0x84, 0x50, 0x30, 0x85, 0x08, 0x83, 0x01, 0x84, 0x08, 0x83, 0x01,
+0x85, 0x06, 0x84, 0x02, 0x84, 0x05, 0x84, 0x03, 0x85, 0x04, 0x84, 0x04, 0x85, 0x02, 0x84, 0x06,
+0x84, 0x01, 0x84, 0x07, 0x89, 0x08, 0x87, 0x0A, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x55, 0x31, 0x8F, 0x01, 0x8F, 0x0C, 0x84,
+0x0B, 0x85, 0x0A, 0x85, 0x0A, 0x85, 0x0A, 0x85, 0x0B, 0x84, 0x0B, 0x84, 0x0B, 0x85, 0x0A, 0x85,
+0x0A, 0x85, 0x0B, 0x84, 0x0B, 0x84, 0x0B, 0x85, 0x0A, 0x85, 0x0B, 0x8F, 0x01, 0x8F, 0x50, 0x05,
+0x8B, 0x05, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x8B, 0x05,
+0x8B, 0x10, 0x01, 0x84, 0x0C, 0x84, 0x0D, 0x84, 0x0C, 0x84, 0x0D, 0x84, 0x0C, 0x84, 0x0D, 0x84,
+0x0C, 0x84, 0x0D, 0x84, 0x0C, 0x84, 0x0D, 0x84, 0x0C, 0x84, 0x0D, 0x84, 0x0C, 0x84, 0x0D, 0x84,
+0x0C, 0x84, 0x0D, 0x84, 0x0C, 0x84, 0x0D, 0x84, 0x0C, 0x84, 0x0D, 0x84, 0x0C, 0x84, 0x0D, 0x84,
+0x0C, 0x84, 0x0D, 0x83, 0x10, 0x01, 0x8B, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x05, 0x8B, 0x05, 0x8B, 0x14, 0x08, 0x82, 0x0D, 0x83, 0x0D, 0x83, 0x0C, 0x85,
+0x0B, 0x85, 0x0A, 0x87, 0x09, 0x87, 0x09, 0x83, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84,
+0x02, 0x83, 0x06, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x04, 0x84, 0x05, 0x84, 0x03, 0x84,
+0x05, 0x84, 0x03, 0x83, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x08, 0x83, 0x7F, 0x11,
+0x7F, 0x7F, 0x52, 0xA0, 0x30, 0x08, 0x84, 0x7F, 0x7F, 0x7F, 0x17, 0x64, 0x89, 0x05, 0x8C, 0x04,
+0x84, 0x03, 0x85, 0x0C, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x06, 0x8A, 0x04, 0x8C, 0x03, 0x85, 0x03,
+0x85, 0x02, 0x85, 0x04, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x85, 0x04, 0x85, 0x02, 0x85, 0x03,
+0x86, 0x03, 0x8E, 0x03, 0x87, 0x02, 0x84, 0x50, 0x02, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84,
+0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x01, 0x86, 0x05, 0x8D, 0x03, 0x86, 0x02, 0x85, 0x03, 0x85,
+0x04, 0x85, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84,
+0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x05, 0x85, 0x02, 0x84,
+0x05, 0x84, 0x03, 0x86, 0x02, 0x85, 0x03, 0x8C, 0x04, 0x83, 0x01, 0x86, 0x54, 0x66, 0x89, 0x05,
+0x8C, 0x03, 0x86, 0x04, 0x83, 0x02, 0x85, 0x0B, 0x85, 0x0B, 0x84, 0x0B, 0x85, 0x0B, 0x85, 0x0B,
+0x85, 0x0C, 0x84, 0x0C, 0x85, 0x0B, 0x85, 0x0C, 0x86, 0x04, 0x83, 0x04, 0x8C, 0x06, 0x89, 0x51,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x05, 0x8B, 0x03, 0x8D,
+0x02, 0x85, 0x03, 0x86, 0x02, 0x84, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85,
+0x01, 0x85, 0x05, 0x85, 0x01, 0x84, 0x06, 0x85, 0x01, 0x84, 0x06, 0x85, 0x01, 0x85, 0x05, 0x85,
+0x01, 0x85, 0x05, 0x85, 0x02, 0x84, 0x04, 0x86, 0x02, 0x85, 0x02, 0x87, 0x03, 0x8D, 0x04, 0x86,
+0x01, 0x85, 0x50, 0x66, 0x87, 0x07, 0x8A, 0x05, 0x85, 0x02, 0x85, 0x03, 0x85, 0x04, 0x84, 0x03,
+0x84, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x8F, 0x01, 0x8F, 0x01, 0x85, 0x0B, 0x85, 0x0C,
+0x84, 0x0C, 0x85, 0x0C, 0x85, 0x05, 0x83, 0x04, 0x8C, 0x06, 0x89, 0x51, 0x07, 0x89, 0x06, 0x85,
+0x04, 0x81, 0x06, 0x84, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x07, 0x8F, 0x01, 0x8F, 0x05, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x56, 0x65, 0x86, 0x01, 0x84, 0x03, 0x8D, 0x02,
+0x85, 0x02, 0x87, 0x02, 0x84, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01,
+0x84, 0x06, 0x85, 0x01, 0x84, 0x06, 0x85, 0x01, 0x84, 0x06, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01,
+0x85, 0x05, 0x85, 0x02, 0x84, 0x04, 0x86, 0x02, 0x85, 0x02, 0x87, 0x03, 0x8D, 0x04, 0x86, 0x01,
+0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x03, 0x83, 0x04, 0x85, 0x04, 0x8B, 0x03, 0x02, 0x84,
+0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x01, 0x87, 0x04, 0x8D,
+0x03, 0x87, 0x02, 0x84, 0x03, 0x86, 0x03, 0x85, 0x02, 0x85, 0x04, 0x85, 0x02, 0x84, 0x05, 0x85,
+0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85,
+0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85,
+0x02, 0x84, 0x05, 0x85, 0x50, 0x07, 0x85, 0x0B, 0x85, 0x45, 0x8A, 0x06, 0x8A, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x55, 0x08, 0x85, 0x0B, 0x85, 0x45, 0x8B, 0x05, 0x8B,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x84,
+0x05, 0x83, 0x03, 0x85, 0x05, 0x8A, 0x05, 0x02, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x05, 0x85, 0x02, 0x84, 0x04, 0x85, 0x03, 0x84, 0x03, 0x85, 0x04,
+0x84, 0x02, 0x85, 0x05, 0x84, 0x01, 0x85, 0x06, 0x84, 0x01, 0x84, 0x07, 0x88, 0x08, 0x88, 0x08,
+0x89, 0x07, 0x84, 0x01, 0x85, 0x06, 0x84, 0x02, 0x85, 0x05, 0x84, 0x03, 0x85, 0x04, 0x84, 0x04,
+0x85, 0x03, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x50, 0x01, 0x8B, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x54, 0x60, 0x84, 0x01, 0x84, 0x02, 0x84, 0x01, 0xB5, 0x01, 0x85, 0x02,
+0x88, 0x02, 0x84, 0x02, 0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03,
+0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03,
+0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03, 0x83, 0x50, 0x62, 0x84, 0x01, 0x87, 0x04, 0x8D,
+0x03, 0x87, 0x02, 0x84, 0x03, 0x86, 0x03, 0x85, 0x02, 0x85, 0x04, 0x85, 0x02, 0x84, 0x05, 0x85,
+0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85,
+0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85,
+0x02, 0x84, 0x05, 0x85, 0x50, 0x65, 0x87, 0x07, 0x8B, 0x04, 0x85, 0x03, 0x85, 0x03, 0x84, 0x05,
+0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07,
+0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x85, 0x05, 0x85, 0x02, 0x84, 0x05,
+0x85, 0x02, 0x85, 0x03, 0x85, 0x04, 0x8B, 0x07, 0x87, 0x54, 0x62, 0x84, 0x01, 0x86, 0x05, 0x8D,
+0x03, 0x86, 0x02, 0x85, 0x03, 0x85, 0x04, 0x85, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84,
+0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84,
+0x02, 0x84, 0x05, 0x85, 0x02, 0x85, 0x04, 0x84, 0x03, 0x86, 0x02, 0x85, 0x03, 0x8C, 0x04, 0x8B,
+0x05, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0A, 0x65, 0x86, 0x01, 0x83, 0x04,
+0x8C, 0x03, 0x85, 0x02, 0x86, 0x03, 0x84, 0x05, 0x84, 0x02, 0x85, 0x05, 0x84, 0x02, 0x84, 0x06,
+0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06,
+0x84, 0x02, 0x85, 0x05, 0x84, 0x02, 0x85, 0x04, 0x85, 0x03, 0x85, 0x02, 0x86, 0x04, 0x8C, 0x05,
+0x86, 0x01, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x01, 0x63, 0x85,
+0x01, 0x87, 0x03, 0x8D, 0x03, 0x88, 0x02, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03, 0x86, 0x04, 0x83,
+0x03, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x58, 0x65, 0x89, 0x05, 0x8C, 0x04, 0x84, 0x05, 0x83, 0x03, 0x85, 0x0B,
+0x85, 0x0B, 0x86, 0x0B, 0x88, 0x0A, 0x89, 0x0A, 0x87, 0x0B, 0x85, 0x0C, 0x84, 0x0C, 0x84, 0x03,
+0x84, 0x04, 0x85, 0x03, 0x8C, 0x05, 0x89, 0x54, 0x35, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x08, 0x8F,
+0x01, 0x8F, 0x05, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84,
+0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x85, 0x0C, 0x8A, 0x07, 0x89, 0x50, 0x62, 0x84, 0x05,
+0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05,
+0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05,
+0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x04, 0x85, 0x03, 0x84, 0x03, 0x86, 0x03, 0x85, 0x01,
+0x87, 0x04, 0x8C, 0x05, 0x86, 0x01, 0x84, 0x51, 0x60, 0x84, 0x09, 0x83, 0x01, 0x84, 0x07, 0x84,
+0x01, 0x84, 0x07, 0x84, 0x02, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x85, 0x04, 0x84,
+0x04, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x84, 0x06, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84,
+0x07, 0x88, 0x09, 0x87, 0x09, 0x87, 0x0A, 0x85, 0x0B, 0x85, 0x55, 0x60, 0x84, 0x0A, 0x86, 0x03,
+0x84, 0x03, 0x86, 0x02, 0x85, 0x03, 0x86, 0x02, 0x85, 0x02, 0x87, 0x02, 0x86, 0x01, 0x87, 0x02,
+0x86, 0x01, 0x83, 0x01, 0x8B, 0x01, 0x83, 0x01, 0x87, 0x01, 0x83, 0x01, 0x83, 0x01, 0x87, 0x01,
+0x87, 0x01, 0x87, 0x01, 0x87, 0x01, 0x87, 0x01, 0x87, 0x02, 0x85, 0x03, 0x85, 0x03, 0x85, 0x03,
+0x85, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x51, 0x61, 0x85, 0x06, 0x84, 0x02, 0x85,
+0x04, 0x84, 0x03, 0x85, 0x03, 0x84, 0x05, 0x85, 0x02, 0x84, 0x06, 0x89, 0x08, 0x87, 0x09, 0x87,
+0x0A, 0x85, 0x0A, 0x87, 0x09, 0x88, 0x07, 0x89, 0x06, 0x84, 0x02, 0x85, 0x04, 0x85, 0x03, 0x85,
+0x03, 0x84, 0x05, 0x85, 0x01, 0x84, 0x06, 0x85, 0x50, 0x60, 0x85, 0x08, 0x83, 0x01, 0x84, 0x07,
+0x84, 0x01, 0x85, 0x06, 0x84, 0x02, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x04, 0x84, 0x03,
+0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x85, 0x02, 0x84, 0x06, 0x84, 0x01, 0x84, 0x07, 0x89, 0x08,
+0x87, 0x09, 0x87, 0x0A, 0x85, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0B,
+0x85, 0x08, 0x87, 0x08, 0x62, 0x8E, 0x02, 0x8E, 0x0B, 0x85, 0x0A, 0x85, 0x0A, 0x85, 0x0A, 0x85,
+0x0A, 0x85, 0x0A, 0x85, 0x0A, 0x85, 0x0A, 0x85, 0x0A, 0x85, 0x0B, 0x84, 0x0B, 0x84, 0x0B, 0x8F,
+0x01, 0x8F, 0x50, 0x07, 0x88, 0x07, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0D,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x83, 0x0C, 0x84, 0x08, 0x87, 0x09, 0x87, 0x0D, 0x84, 0x0D,
+0x83, 0x0D, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C,
+0x85, 0x0C, 0x88, 0x0A, 0x86, 0x11, 0x07, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83,
+0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83,
+0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83,
+0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x16, 0x02, 0x88, 0x0C, 0x85, 0x0C, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x83, 0x0C, 0x84, 0x0C, 0x84, 0x0D, 0x83, 0x0D, 0x84, 0x0D,
+0x87, 0x09, 0x87, 0x08, 0x84, 0x0C, 0x83, 0x0C, 0x84, 0x0C, 0x84, 0x0D, 0x83, 0x0D, 0x84, 0x0C,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0B, 0x85, 0x07, 0x88, 0x08, 0x86, 0x18, 0x7F, 0x33, 0x86, 0x05,
+0x83, 0x01, 0x89, 0x03, 0x83, 0x01, 0x83, 0x02, 0x85, 0x02, 0x87, 0x03, 0x8D, 0x05, 0x86, 0x7F,
+0x22,
+};
+static const uint16_t packed_Font16x26_offsets[] = {
+0, 4, 41, 72, 147, 206, 293, 360, 377, 428, 479, 521,
+550, 571, 578, 589, 640, 717, 760, 805, 852, 905, 950, 1015,
+1058, 1129, 1194, 1211, 1238, 1269, 1276, 1307, 1350, 1431, 1484, 1545,
+1586, 1651, 1688, 1725, 1776, 1845, 1882, 1921, 1984, 2021, 2074, 2151,
+2204, 2255, 2316, 2381, 2424, 2459, 2528, 2585, 2654, 2711, 2762, 2799,
+2850, 2901, 2952, 3008, 3013, 3019, 3064, 3133, 3168, 3235, 3276, 3321,
+3390, 3461, 3496, 3543, 3610, 3653, 3706, 3765, 3818, 3883, 3950, 3989,
+4024, 4061, 4120, 4171, 4234, 4281, 4340, 4371, 4422, 4473, 4524,
+};
+
+const FontDef Font_7x10 = {7,10,NULL,FONT_FORMAT_PACKED1,NULL,packed_Font7x10_bits,NULL};
+const FontDef Font_11x18 = {11,18,NULL,FONT_FORMAT_PACKED1,NULL,packed_Font11x18_bits,NULL};
+const FontDef Font_16x26 = {16,26,NULL,FONT_FORMAT_RLE,NULL,packed_Font16x26_bits,packed_Font16x26_offsets};
+
+#endif // FONTS_PACKED
+
+// Font_11x18_Digits: 21 glyphs, 1bpp, 522 bytes (756 as uint16_t rows)
+static const uint8_t digits_Font11x18_bits[] = {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x03, 0x00,
+0x60, 0x0C, 0x1F, 0xFB, 0xFF, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x07,
+0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0xC0, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x03, 0xC0, 0xFC, 0x19, 0x86, 0x18, 0xC3, 0x18, 0x63, 0x6C, 0x6D, 0x8C,
+0x31, 0x86, 0x30, 0xC3, 0x30, 0x7E, 0x07, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0xE0,
+0x3C, 0x0D, 0x81, 0x30, 0x06, 0x00, 0xC0, 0x18, 0x03, 0x00, 0x60, 0x0C, 0x01, 0x80, 0x30, 0x06,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x0F, 0xC3, 0x9C, 0x61, 0x8C, 0x30, 0x06, 0x01, 0x80,
+0x60, 0x18, 0x06, 0x01, 0x80, 0x60, 0x0F, 0xF1, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE0,
+0x3E, 0x0C, 0x61, 0x8C, 0x01, 0x80, 0xE0, 0x1C, 0x00, 0xC0, 0x0C, 0x01, 0x8C, 0x31, 0xCE, 0x1F,
+0x81, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x38, 0x07, 0x01, 0xE0, 0x3C, 0x05, 0x81,
+0xB0, 0x36, 0x0C, 0xC1, 0xFE, 0x3F, 0xC0, 0x60, 0x0C, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x3F, 0x87, 0xF0, 0xC0, 0x18, 0x03, 0x00, 0x6E, 0x0F, 0xE1, 0x8E, 0x00, 0xC0, 0x18, 0xC3, 0x1C,
+0xE1, 0xF8, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x0F, 0xC1, 0x9C, 0x61, 0x8C, 0x01,
+0xB8, 0x3F, 0x87, 0x38, 0xC3, 0x18, 0x63, 0x0C, 0x33, 0x87, 0xE0, 0x78, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x03, 0xFC, 0x7F, 0x80, 0x30, 0x0C, 0x01, 0x80, 0x60, 0x0C, 0x03, 0x00, 0x60, 0x0C, 0x01,
+0x00, 0x60, 0x0C, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xC0, 0xFC, 0x31, 0xC6, 0x18,
+0xC3, 0x08, 0x40, 0xF0, 0x3F, 0x0C, 0x31, 0x86, 0x30, 0xC6, 0x18, 0x7E, 0x07, 0x80, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x0F, 0x03, 0xF0, 0xE6, 0x18, 0x63, 0x0C, 0x61, 0x8E, 0x70, 0xFE, 0x0E, 0xC0,
+0x18, 0xC3, 0x1C, 0xC1, 0xF8, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x01, 0x80, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x80, 0x30, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0xD8, 0x1B, 0x0B, 0x63, 0x6C, 0xC7, 0x30, 0x0C, 0x03, 0x00,
+0xDC, 0x36, 0xCC, 0xD9, 0x1B, 0x03, 0x60, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xC0, 0x38,
+0x0D, 0x81, 0xB0, 0x36, 0x06, 0xC1, 0x8C, 0x31, 0x87, 0xF0, 0xFE, 0x18, 0xC6, 0x0C, 0xC1, 0x98,
+0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x03, 0xF0, 0x63, 0x18, 0x63, 0x00, 0x60, 0x0C, 0x01,
+0x80, 0x30, 0x06, 0x00, 0xC3, 0x0C, 0x61, 0xF8, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC1,
+0x98, 0x33, 0x06, 0x31, 0x86, 0x30, 0xC6, 0x0D, 0x81, 0xB0, 0x36, 0x06, 0xC0, 0x70, 0x0E, 0x01,
+0xC0, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x06, 0xC0, 0xD8, 0x1B, 0x03, 0x60, 0x6C, 0xCC,
+0x99, 0x13, 0x22, 0xF4, 0x52, 0x8A, 0x51, 0xCE, 0x30, 0xC6, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xBB, 0x3F, 0xF6, 0x76, 0xCC, 0xD9, 0x9B, 0x33, 0x66, 0x6C,
+0xCD, 0x99, 0xB3, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const FontDef Font_11x18_Digits = {11,18,NULL,FONT_FORMAT_PACKED1," +-.0123456789:%ACVWm",digits_Font11x18_bits,NULL};
+
+// Font_16x26_Digits: 21 glyphs, RLE, 1024 bytes (1092 as uint16_t rows)
+static const uint8_t digits_Font16x26_bits[] = {
+0x7F, 0x7F, 0x7F, 0x23, 0x67, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83,
+0x0D, 0x83, 0x06, 0xA0, 0x07, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83, 0x0D, 0x83,
+0x56, 0x7F, 0x33, 0x8D, 0x03, 0x8D, 0x7F, 0x52, 0x7F, 0x7F, 0x18, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x55, 0x05, 0x87, 0x08, 0x89, 0x06, 0x85, 0x01, 0x85, 0x04, 0x85, 0x03, 0x85, 0x03,
+0x84, 0x05, 0x84, 0x02, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x84, 0x07, 0x84, 0x01,
+0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01,
+0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x02,
+0x84, 0x05, 0x84, 0x03, 0x85, 0x03, 0x85, 0x04, 0x85, 0x01, 0x85, 0x06, 0x89, 0x08, 0x87, 0x54,
+0x08, 0x84, 0x09, 0x87, 0x06, 0x8A, 0x06, 0x8A, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85,
+0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x06, 0x8E, 0x02, 0x8E, 0x50, 0x04, 0x87, 0x07, 0x8B, 0x05,
+0x84, 0x03, 0x85, 0x0C, 0x84, 0x0C, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0B,
+0x85, 0x0A, 0x85, 0x0A, 0x85, 0x0A, 0x85, 0x0A, 0x85, 0x0B, 0x84, 0x0B, 0x84, 0x0B, 0x84, 0x0B,
+0x85, 0x0B, 0x84, 0x0C, 0x8D, 0x03, 0x8D, 0x51, 0x04, 0x88, 0x07, 0x8A, 0x06, 0x83, 0x03, 0x85,
+0x0C, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0A, 0x85, 0x07, 0x88, 0x08, 0x89,
+0x0C, 0x85, 0x0C, 0x85, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0B, 0x85, 0x04, 0x83,
+0x03, 0x85, 0x05, 0x8A, 0x06, 0x88, 0x55, 0x09, 0x84, 0x0B, 0x85, 0x0B, 0x85, 0x0A, 0x86, 0x09,
+0x87, 0x08, 0x88, 0x08, 0x88, 0x07, 0x84, 0x01, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02,
+0x84, 0x05, 0x84, 0x03, 0x84, 0x04, 0x84, 0x04, 0x84, 0x04, 0x84, 0x04, 0x84, 0x03, 0xA0, 0x09,
+0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x53, 0x03, 0x8B, 0x05, 0x8B,
+0x05, 0x8B, 0x05, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x88, 0x08, 0x8A,
+0x0B, 0x86, 0x0B, 0x85, 0x0C, 0x85, 0x0B, 0x85, 0x0C, 0x84, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x84,
+0x05, 0x83, 0x03, 0x85, 0x05, 0x8A, 0x06, 0x88, 0x55, 0x07, 0x87, 0x07, 0x8A, 0x05, 0x85, 0x03,
+0x83, 0x04, 0x85, 0x0B, 0x84, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x01, 0x86, 0x05,
+0x8C, 0x03, 0x87, 0x02, 0x85, 0x02, 0x86, 0x04, 0x85, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06,
+0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x84, 0x06, 0x84, 0x02, 0x85, 0x05, 0x84, 0x03, 0x84, 0x04,
+0x85, 0x03, 0x85, 0x02, 0x85, 0x05, 0x8A, 0x08, 0x86, 0x54, 0x02, 0x8E, 0x02, 0x8E, 0x02, 0x8E,
+0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x83, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84,
+0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0C, 0x84, 0x0B, 0x84, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x84,
+0x0B, 0x85, 0x0B, 0x85, 0x58, 0x05, 0x88, 0x07, 0x8A, 0x05, 0x85, 0x02, 0x85, 0x04, 0x84, 0x04,
+0x84, 0x03, 0x85, 0x04, 0x84, 0x03, 0x85, 0x04, 0x84, 0x04, 0x84, 0x04, 0x84, 0x04, 0x85, 0x02,
+0x84, 0x06, 0x89, 0x08, 0x87, 0x08, 0x89, 0x06, 0x84, 0x01, 0x86, 0x04, 0x85, 0x03, 0x85, 0x03,
+0x84, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x06, 0x84, 0x01, 0x85, 0x06, 0x84, 0x02,
+0x84, 0x05, 0x85, 0x02, 0x86, 0x02, 0x85, 0x04, 0x8B, 0x07, 0x87, 0x54, 0x05, 0x87, 0x08, 0x89,
+0x06, 0x84, 0x02, 0x85, 0x04, 0x84, 0x04, 0x85, 0x03, 0x84, 0x05, 0x84, 0x02, 0x85, 0x05, 0x85,
+0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x01, 0x85, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85,
+0x02, 0x85, 0x03, 0x86, 0x03, 0x8D, 0x05, 0x86, 0x01, 0x84, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84,
+0x0B, 0x85, 0x0B, 0x84, 0x04, 0x83, 0x03, 0x85, 0x05, 0x8A, 0x07, 0x88, 0x55, 0x66, 0x85, 0x0B,
+0x85, 0x0B, 0x85, 0x0B, 0x85, 0x7B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x0B, 0x85, 0x55, 0x02, 0x85,
+0x07, 0x86, 0x01, 0x83, 0x05, 0x86, 0x02, 0x84, 0x03, 0x87, 0x02, 0x84, 0x03, 0x83, 0x01, 0x83,
+0x03, 0x83, 0x02, 0x84, 0x01, 0x83, 0x03, 0x83, 0x01, 0x84, 0x02, 0x83, 0x02, 0x84, 0x01, 0x83,
+0x03, 0x83, 0x02, 0x88, 0x03, 0x84, 0x01, 0x87, 0x06, 0x89, 0x0C, 0x83, 0x0C, 0x8A, 0x05, 0x8B,
+0x05, 0x87, 0x02, 0x82, 0x04, 0x88, 0x02, 0x82, 0x03, 0x84, 0x01, 0x84, 0x02, 0x82, 0x02, 0x84,
+0x02, 0x84, 0x02, 0x82, 0x02, 0x83, 0x03, 0x84, 0x02, 0x82, 0x01, 0x84, 0x03, 0x84, 0x02, 0x86,
+0x05, 0x8A, 0x07, 0x86, 0x50, 0x36, 0x85, 0x0B, 0x85, 0x0A, 0x87, 0x09, 0x87, 0x09, 0x87, 0x08,
+0x84, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07, 0x83, 0x02, 0x85, 0x05, 0x84, 0x03, 0x84, 0x05,
+0x84, 0x03, 0x84, 0x04, 0x84, 0x04, 0x85, 0x03, 0x8D, 0x03, 0x8E, 0x01, 0x84, 0x06, 0x85, 0x01,
+0x84, 0x07, 0x88, 0x08, 0x88, 0x09, 0x87, 0x09, 0x83, 0x50, 0x37, 0x89, 0x05, 0x8B, 0x03, 0x86,
+0x04, 0x83, 0x02, 0x85, 0x0B, 0x84, 0x0B, 0x85, 0x0B, 0x84, 0x0C, 0x84, 0x0C, 0x84, 0x0C, 0x84,
+0x0C, 0x84, 0x0C, 0x85, 0x0B, 0x85, 0x0C, 0x85, 0x0B, 0x86, 0x0B, 0x86, 0x05, 0x82, 0x05, 0x8B,
+0x07, 0x89, 0x50, 0x30, 0x84, 0x09, 0x87, 0x09, 0x88, 0x08, 0x83, 0x01, 0x84, 0x07, 0x84, 0x01,
+0x85, 0x06, 0x84, 0x02, 0x84, 0x05, 0x84, 0x03, 0x84, 0x05, 0x84, 0x03, 0x85, 0x04, 0x84, 0x04,
+0x84, 0x03, 0x84, 0x05, 0x85, 0x02, 0x84, 0x05, 0x85, 0x01, 0x84, 0x07, 0x84, 0x01, 0x84, 0x07,
+0x89, 0x08, 0x87, 0x09, 0x87, 0x09, 0x87, 0x0A, 0x85, 0x0B, 0x85, 0x55, 0x30, 0x83, 0x0B, 0x86,
+0x0A, 0x86, 0x0A, 0x86, 0x09, 0x87, 0x02, 0x85, 0x02, 0x87, 0x02, 0x85, 0x02, 0x87, 0x02, 0x85,
+0x02, 0x83, 0x01, 0x83, 0x02, 0x85, 0x02, 0x83, 0x01, 0x84, 0x01, 0x86, 0x01, 0x83, 0x01, 0x8B,
+0x01, 0x83, 0x01, 0x8F, 0x01, 0x87, 0x01, 0x87, 0x01, 0x87, 0x01, 0x87, 0x01, 0x87, 0x01, 0x86,
+0x03, 0x86, 0x01, 0x86, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85, 0x03, 0x85,
+0x51, 0x60, 0x84, 0x01, 0x84, 0x02, 0x84, 0x01, 0xB5, 0x01, 0x85, 0x02, 0x88, 0x02, 0x84, 0x02,
+0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03,
+0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03, 0x87, 0x03, 0x83, 0x03,
+0x87, 0x03, 0x83, 0x03, 0x83, 0x50,
+};
+static const uint16_t digits_Font16x26_offsets[] = {
+0, 4, 33, 40, 51, 128, 171, 216, 263, 316, 361, 426,
+469, 540, 605, 622, 709, 762, 803, 860, 929,
+};
+
+const FontDef Font_16x26_Digits = {16,26,NULL,FONT_FORMAT_RLE," +-.0123456789:%ACVWm",digits_Font16x26_bits,digits_Font16x26_offsets};
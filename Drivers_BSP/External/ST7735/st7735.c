@@ -1,11 +1,48 @@
 /* vim: set ai et ts=4 sw=4: */
 #include "main.h"
 #include "st7735.h"
-#include "malloc.h"
 #include "string.h"
+#include "cycle_probe.h"
+#if ST7735_USE_DMA
+#include "bsp.h"
+#include "hal_spi.h"
+#include "hal_gpio.h"
+#include "hal_mem.h"
+#if ST7735_USE_DMA2D
+#include "hal_dma2d.h"
+#endif
+#include "os_wrapper.h"
+#endif
 
 #define DELAY 0x80
 
+#define ST7735_MAX_LINE  ((ST7735_WIDTH > ST7735_HEIGHT) ? ST7735_WIDTH : ST7735_HEIGHT)
+#define ST7735_MAX_GLYPH (16 * 26)  // Pixels of the largest font
+
+// Staging for fills and glyphs, so each goes out as one transfer
+// (line aligned: DMA2D writes the fill buffer)
+static uint8_t fill_buffer[2 * ST7735_MAX_LINE * ST7735_FILL_LINES] __attribute__((aligned(HAL_CACHE_LINE_SIZE)));
+static uint16_t glyph_buffer[ST7735_MAX_GLYPH];
+
+#if ST7735_GLYPH_CACHE
+// Rendered ST7735_GLYPH_CACHE_CHARS for the last font and color pair used
+static const char glyph_cache_chars[] = ST7735_GLYPH_CACHE_CHARS;
+static uint16_t glyph_cache[sizeof(glyph_cache_chars) - 1][ST7735_GLYPH_CACHE_PIXELS];
+static const void *glyph_cache_font = NULL;      // data or bits of the font
+static uint16_t glyph_cache_color;
+static uint16_t glyph_cache_bgcolor;
+static uint32_t glyph_cache_valid = 0;     // Bit per entry
+#endif
+
+#if ST7735_USE_DMA
+static hal_spi_handle_t dma_spi = NULL;
+static os_semaphore_handle_t dma_done = NULL;
+OS_SEMAPHORE_DEFINE(dma_done);
+static bool dma_enabled = true;
+#endif
+
+static uint32_t bytes_sent = 0;    // Commands and data, for SPI utilisation
+
 // based on Adafruit ST7735 library for Arduino
 static const uint8_t
   init_cmds1[] = {            // Init for 7735R, part 1 (red or green tab)
@@ -85,23 +122,82 @@ static const uint8_t
     ST7735_DISPON ,    DELAY, //  4: Main screen turn on, no args w/delay
       100 };                  //     100 ms delay
 
+// Bus set up once ST7735_InitBegin() ran
+static hal_spi_device_t spi_device = { NULL, HAL_SPI_PRESCALER_4, 0, 0, 0 };
+
 static void ST7735_Select() {
-    HAL_GPIO_WritePin(ST7735_CS_GPIO_Port, ST7735_CS_Pin, GPIO_PIN_RESET);
+    hal_spi_device_select(&spi_device);
+    hal_gpio_reset_fast(ST7735_CS_GPIO_Port, ST7735_CS_Pin);
 }
 
 void ST7735_Unselect() {
-    HAL_GPIO_WritePin(ST7735_CS_GPIO_Port, ST7735_CS_Pin, GPIO_PIN_SET);
+    hal_gpio_set_fast(ST7735_CS_GPIO_Port, ST7735_CS_Pin);
+}
+
+
+#if ST7735_USE_DMA
+static void ST7735_DmaComplete(hal_spi_handle_t handle, hal_spi_status_t status, void *user_data) {
+    bool woken = false;
+    os_semaphore_give_from_isr(dma_done, &woken);
+    os_yield_from_isr(woken);
 }
 
+static void ST7735_DmaInit() {
+    if (dma_done == NULL) {
+        dma_done = OS_SEMAPHORE_CREATE_BINARY_STATIC(dma_done);
+    }
+    if (dma_done != NULL) {
+        dma_spi = BSP_Display_SPI_DMA_Init();
+    }
+}
+
+// DMA in chunks of at most 64 KB - 1; false falls back to polling
+static bool ST7735_TransmitDma(const uint8_t* buff, size_t buff_size) {
+    while (buff_size > 0) {
+        uint16_t chunk = (buff_size > 0xFFFF) ? 0xFFFF : (uint16_t)buff_size;
+
+        if (hal_spi_transmit_dma(dma_spi, buff, chunk, ST7735_DmaComplete, NULL) != HAL_SPI_OK) {
+            return false;
+        }
+        if (os_semaphore_take(dma_done, ST7735_DMA_TIMEOUT_MS) != OS_SUCCESS) {
+            HAL_SPI_Abort(&ST7735_SPI_PORT);
+            os_semaphore_take(dma_done, 0);  // Drop a completion that raced the abort
+            return false;
+        }
+        buff += chunk;
+        buff_size -= chunk;
+    }
+    return true;
+}
+#endif
+
+// Returns once the last byte is on the wire, so DC and CS can change
+static void ST7735_Transmit(const uint8_t* buff, size_t buff_size) {
+    bytes_sent += buff_size;
+#if ST7735_USE_DMA
+    if (dma_spi != NULL && dma_enabled && buff_size >= ST7735_DMA_MIN_BYTES) {
+        if (ST7735_TransmitDma(buff, buff_size)) {
+            return;
+        }
+    }
+#endif
+    while (buff_size > 0) {
+        uint16_t chunk = (buff_size > 0xFFFF) ? 0xFFFF : (uint16_t)buff_size;
+        HAL_SPI_Transmit(&ST7735_SPI_PORT, (uint8_t*)buff, chunk, HAL_MAX_DELAY);
+        buff += chunk;
+        buff_size -= chunk;
+    }
+}
 
 static void ST7735_WriteCommand(uint8_t cmd) {
-    HAL_GPIO_WritePin(ST7735_DC_GPIO_Port, ST7735_DC_Pin, GPIO_PIN_RESET);
+    hal_gpio_reset_fast(ST7735_DC_GPIO_Port, ST7735_DC_Pin);
     HAL_SPI_Transmit(&ST7735_SPI_PORT, &cmd, sizeof(cmd), HAL_MAX_DELAY);
+    bytes_sent++;
 }
 
-static void ST7735_WriteData(uint8_t* buff, size_t buff_size) {
-    HAL_GPIO_WritePin(ST7735_DC_GPIO_Port, ST7735_DC_Pin, GPIO_PIN_SET);
-    HAL_SPI_Transmit(&ST7735_SPI_PORT, buff, buff_size, HAL_MAX_DELAY);
+static void ST7735_WriteData(const uint8_t* buff, size_t buff_size) {
+    hal_gpio_set_fast(ST7735_DC_GPIO_Port, ST7735_DC_Pin);
+    ST7735_Transmit(buff, buff_size);
 }
 
 static void ST7735_Reset() {
@@ -112,30 +208,40 @@ static void ST7735_Reset() {
     HAL_Delay(5);
 }
 
-static void ST7735_ExecuteCommandList(const uint8_t *addr) {
-    uint8_t numCommands, numArgs;
+// Position in init_cmds1..3 while ST7735_InitContinue() walks them
+static const uint8_t *const init_lists[] = { init_cmds1, init_cmds2, init_cmds3 };
+static struct {
+    uint8_t list;
+    uint8_t remaining;          // Commands left in the current list
+    const uint8_t *addr;
+} init_state;
+
+/**
+ * @brief Send the next command of the list
+ * @return its delay in ms (0 if none)
+ */
+static uint16_t ST7735_ExecuteCommand(const uint8_t **addr) {
+    const uint8_t *p = *addr;
+    uint8_t numArgs;
     uint16_t ms;
 
-    numCommands = *addr++;
-    while(numCommands--) {
-        uint8_t cmd = *addr++;
-        ST7735_WriteCommand(cmd);
-
-        numArgs = *addr++;
-        // If high bit set, delay follows args
-        ms = numArgs & DELAY;
-        numArgs &= ~DELAY;
-        if(numArgs) {
-            ST7735_WriteData((uint8_t*)addr, numArgs);
-            addr += numArgs;
-        }
+    ST7735_WriteCommand(*p++);
 
-        if(ms) {
-            ms = *addr++;
-            if(ms == 255) ms = 500;
-            HAL_Delay(ms);
-        }
+    numArgs = *p++;
+    // If high bit set, delay follows args
+    ms = numArgs & DELAY;
+    numArgs &= ~DELAY;
+    if(numArgs) {
+        ST7735_WriteData(p, numArgs);
+        p += numArgs;
     }
+
+    if(ms) {
+        ms = *p++;
+        if(ms == 255) ms = 500;
+    }
+    *addr = p;
+    return ms;
 }
 
 static void ST7735_SetAddressWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
@@ -154,12 +260,51 @@ static void ST7735_SetAddressWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t
     ST7735_WriteCommand(ST7735_RAMWR);
 }
 
-void ST7735_Init() {
+void ST7735_InitBegin() {
+    spi_device.bus = (hal_spi_handle_t)&ST7735_SPI_PORT;
+    hal_spi_device_set_max_hz(&spi_device, ST7735_SPI_MAX_HZ);
+#if ST7735_USE_DMA
+    ST7735_DmaInit();
+#endif
+#if ST7735_USE_DMA2D
+    hal_dma2d_init();
+#endif
+    init_state.list = 0;
+    init_state.addr = init_lists[0];
+    init_state.remaining = *init_state.addr++;
+}
+
+bool ST7735_InitContinue(uint32_t *wait_ms) {
+    uint16_t ms = 0;
+
     ST7735_Select();
-    ST7735_ExecuteCommandList(init_cmds1);
-    ST7735_ExecuteCommandList(init_cmds2);
-    ST7735_ExecuteCommandList(init_cmds3);
+    while (ms == 0 && init_state.list < sizeof(init_lists) / sizeof(init_lists[0])) {
+        if (init_state.remaining == 0) {
+            if (++init_state.list < sizeof(init_lists) / sizeof(init_lists[0])) {
+                init_state.addr = init_lists[init_state.list];
+                init_state.remaining = *init_state.addr++;
+            }
+            continue;
+        }
+        ms = ST7735_ExecuteCommand(&init_state.addr);
+        init_state.remaining--;
+    }
     ST7735_Unselect();
+
+    if (wait_ms != NULL) {
+        *wait_ms = ms;
+    }
+    // A delay after the last command still has to run out
+    return ms == 0;
+}
+
+void ST7735_Init() {
+    uint32_t wait_ms;
+
+    ST7735_InitBegin();
+    while (!ST7735_InitContinue(&wait_ms)) {
+        HAL_Delay(wait_ms);
+    }
 }
 
 void ST7735_Sleep() {
@@ -189,25 +334,54 @@ void ST7735_DrawPixel(uint16_t x, uint16_t y, uint16_t color) {
     ST7735_Unselect();
 }
 
-static void ST7735_WriteChar(uint16_t x, uint16_t y, char ch, FontDef font, uint16_t color, uint16_t bgcolor) {
+static void ST7735_RenderGlyphInto(uint16_t *out, char ch, FontDef font, uint16_t color, uint16_t bgcolor) {
     uint32_t i, b, j;
+    // Panel byte order (high byte first in memory)
+    uint16_t fg = (uint16_t)((color >> 8) | (color << 8));
+    uint16_t bg = (uint16_t)((bgcolor >> 8) | (bgcolor << 8));
 
-    ST7735_SetAddressWindow(x, y, x+font.width-1, y+font.height-1);
-
+    // Rows decoded straight into the pixels, whatever the font's format
+    FontGlyph glyph;
+    Font_GlyphBegin(&glyph, &font, ch);
     for(i = 0; i < font.height; i++) {
-        b = font.data[(ch - 32) * font.height + i];
+        b = Font_GlyphRow(&glyph);
         for(j = 0; j < font.width; j++) {
-            if((b << j) & 0x8000)  {
-                uint8_t data[] = { color >> 8, color & 0xFF };
-                ST7735_WriteData(data, sizeof(data));
-            } else {
-                uint8_t data[] = { bgcolor >> 8, bgcolor & 0xFF };
-                ST7735_WriteData(data, sizeof(data));
-            }
+            *out++ = ((b << j) & 0x8000) ? fg : bg;
         }
     }
 }
 
+const uint16_t* ST7735_RenderGlyph(char ch, FontDef font, uint16_t color, uint16_t bgcolor) {
+#if ST7735_GLYPH_CACHE
+    const char *hit = (ch != '\0') ? strchr(glyph_cache_chars, ch) : NULL;
+    if(hit != NULL && font.width * font.height <= ST7735_GLYPH_CACHE_PIXELS) {
+        const void *id = (font.data != NULL) ? (const void*)font.data : (const void*)font.bits;
+        if(id != glyph_cache_font || color != glyph_cache_color || bgcolor != glyph_cache_bgcolor) {
+            glyph_cache_font = id;
+            glyph_cache_color = color;
+            glyph_cache_bgcolor = bgcolor;
+            glyph_cache_valid = 0;
+        }
+        uint32_t index = hit - glyph_cache_chars;
+        if(!(glyph_cache_valid & (1UL << index))) {
+            ST7735_RenderGlyphInto(glyph_cache[index], ch, font, color, bgcolor);
+            glyph_cache_valid |= 1UL << index;
+        }
+        return glyph_cache[index];
+    }
+#endif
+    ST7735_RenderGlyphInto(glyph_buffer, ch, font, color, bgcolor);
+    return glyph_buffer;
+}
+
+static void ST7735_WriteChar(uint16_t x, uint16_t y, char ch, FontDef font, uint16_t color, uint16_t bgcolor) {
+    const uint16_t *pixels = ST7735_RenderGlyph(ch, font, color, bgcolor);
+
+    // One address window and one transfer per glyph
+    ST7735_SetAddressWindow(x, y, x+font.width-1, y+font.height-1);
+    ST7735_WriteData((const uint8_t*)pixels, sizeof(uint16_t) * font.width * font.height);
+}
+
 /*
 Simpler (and probably slower) implementation:
 
@@ -226,6 +400,7 @@ static void ST7735_WriteChar(uint16_t x, uint16_t y, char ch, FontDef font, uint
 */
 
 void ST7735_WriteString(uint16_t x, uint16_t y, const char* str, FontDef font, uint16_t color, uint16_t bgcolor) {
+    CYCLE_PROBE_BEGIN(CYCLE_PROBE_ST7735_WRITE_STRING);
     ST7735_Select();
 
     while(*str) {
@@ -249,26 +424,25 @@ void ST7735_WriteString(uint16_t x, uint16_t y, const char* str, FontDef font, u
     }
 
     ST7735_Unselect();
+    CYCLE_PROBE_END(CYCLE_PROBE_ST7735_WRITE_STRING);
 }
 
 void ST7735_FillRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
-    // clipping
-    if((x >= ST7735_WIDTH) || (y >= ST7735_HEIGHT)) return;
-    if((x + w - 1) >= ST7735_WIDTH) w = ST7735_WIDTH - x;
-    if((y + h - 1) >= ST7735_HEIGHT) h = ST7735_HEIGHT - y;
-
-    ST7735_Select();
-    ST7735_SetAddressWindow(x, y, x+w-1, y+h-1);
+    // The line-buffered path is faster for every size
+    ST7735_FillRectangleFast(x, y, w, h, color);
+}
 
-    uint8_t data[] = { color >> 8, color & 0xFF };
-    HAL_GPIO_WritePin(ST7735_DC_GPIO_Port, ST7735_DC_Pin, GPIO_PIN_SET);
-    for(y = h; y > 0; y--) {
-        for(x = w; x > 0; x--) {
-            HAL_SPI_Transmit(&ST7735_SPI_PORT, data, sizeof(data), HAL_MAX_DELAY);
-        }
+// w x lines pixels of color into fill_buffer, in panel byte order
+static void ST7735_PrepareFill(uint16_t w, uint16_t lines, uint16_t color) {
+#if ST7735_USE_DMA2D
+    if(hal_dma2d_fill((uint16_t*)fill_buffer, w, w, lines, (uint16_t)((color >> 8) | (color << 8))))
+        return;
+#endif
+    size_t pixels = (size_t)w * lines;
+    for(size_t i = 0; i < pixels; ++i) {
+        fill_buffer[2 * i] = color >> 8;
+        fill_buffer[2 * i + 1] = color & 0xFF;
     }
-
-    ST7735_Unselect();
 }
 
 void ST7735_FillRectangleFast(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
@@ -280,17 +454,17 @@ void ST7735_FillRectangleFast(uint16_t x, uint16_t y, uint16_t w, uint16_t h, ui
     ST7735_Select();
     ST7735_SetAddressWindow(x, y, x+w-1, y+h-1);
 
-    // Prepare whole line in a single buffer
-    uint8_t pixel[] = { color >> 8, color & 0xFF };
-    uint8_t *line = malloc(w * sizeof(pixel));
-    for(x = 0; x < w; ++x)
-    	memcpy(line + x * sizeof(pixel), pixel, sizeof(pixel));
+    // Prepare up to ST7735_FILL_LINES whole lines in a single buffer
+    uint16_t lines = (h < ST7735_FILL_LINES) ? h : ST7735_FILL_LINES;
+    ST7735_PrepareFill(w, lines, color);
 
-    HAL_GPIO_WritePin(ST7735_DC_GPIO_Port, ST7735_DC_Pin, GPIO_PIN_SET);
-    for(y = h; y > 0; y--)
-        HAL_SPI_Transmit(&ST7735_SPI_PORT, line, w * sizeof(pixel), HAL_MAX_DELAY);
+    hal_gpio_set_fast(ST7735_DC_GPIO_Port, ST7735_DC_Pin);
+    for(y = h; y > 0; y -= lines) {
+        if(y < lines)
+            lines = y;
+        ST7735_Transmit(fill_buffer, (size_t)w * lines * 2);
+    }
 
-    free(line);
     ST7735_Unselect();
 }
 
@@ -309,7 +483,7 @@ void ST7735_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint
 
     ST7735_Select();
     ST7735_SetAddressWindow(x, y, x+w-1, y+h-1);
-    ST7735_WriteData((uint8_t*)data, sizeof(uint16_t)*w*h);
+    ST7735_WriteData((const uint8_t*)data, sizeof(uint16_t)*w*h);
     ST7735_Unselect();
 }
 
@@ -319,10 +493,53 @@ void ST7735_InvertColors(bool invert) {
     ST7735_Unselect();
 }
 
+void ST7735_SetScrollArea(uint16_t top_fixed, uint16_t scroll_lines, uint16_t bottom_fixed) {
+    uint8_t data[] = { top_fixed >> 8, top_fixed & 0xFF, scroll_lines >> 8, scroll_lines & 0xFF,
+                       bottom_fixed >> 8, bottom_fixed & 0xFF };
+    ST7735_Select();
+    ST7735_WriteCommand(ST7735_VSCRDEF);
+    ST7735_WriteData(data, sizeof(data));
+    ST7735_Unselect();
+}
+
+void ST7735_SetScrollStart(uint16_t line) {
+    uint8_t data[] = { line >> 8, line & 0xFF };
+    ST7735_Select();
+    ST7735_WriteCommand(ST7735_VSCRSADD);
+    ST7735_WriteData(data, sizeof(data));
+    ST7735_Unselect();
+}
+
+void ST7735_SetSpiPrescaler(hal_spi_prescaler_t prescaler) {
+    spi_device.prescaler = prescaler;
+    spi_device.max_hz = 0;      // Fixed from now on, also across clock changes
+}
+
+hal_spi_prescaler_t ST7735_GetSpiPrescaler(void) {
+    return spi_device.prescaler;
+}
+
+uint32_t ST7735_GetSpiClockHz(void) {
+    return hal_spi_device_clock_hz(&spi_device);
+}
+
+bool ST7735_SetDmaEnabled(bool enable) {
+#if ST7735_USE_DMA
+    dma_enabled = enable;
+    return dma_spi != NULL || !enable;
+#else
+    return !enable;
+#endif
+}
+
+uint32_t ST7735_GetBytesSent(void) {
+    return bytes_sent;
+}
+
 void ST7735_SetGamma(GammaDef gamma)
 {
 	ST7735_Select();
 	ST7735_WriteCommand(ST7735_GAMSET);
-	ST7735_WriteData((uint8_t *) &gamma, sizeof(gamma));
+	ST7735_WriteData((const uint8_t *) &gamma, sizeof(gamma));
 	ST7735_Unselect();
 }
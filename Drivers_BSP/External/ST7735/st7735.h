@@ -3,6 +3,7 @@
 #define __ST7735_H__
 
 #include "fonts.h"
+#include "hal_spi.h"
 #include <stdbool.h>
 
 #define ST7735_MADCTL_MY  0x80
@@ -22,6 +23,38 @@ extern SPI_HandleTypeDef ST7735_SPI_PORT;
 #define ST7735_DC_Pin        spi_display_dc_Pin
 #define ST7735_DC_GPIO_Port  spi_display_dc_GPIO_Port
 
+// Fastest SCK the panel gets, applied on each ST7735_Select() so other
+// devices on the bus keep their own clocks. The ST7735 write cycle
+// (tSCYCW 66 ns) allows ~15 MHz; some panels take more, see the
+// lcd_fill_div* cases of the perf suite.
+#ifndef ST7735_SPI_MAX_HZ
+#define ST7735_SPI_MAX_HZ     15000000
+#endif
+
+// Pixel data goes out by DMA (SPI1 TX, linked by ST7735_Init); the calling
+// task sleeps on a semaphore until the transfer completes. Commands and
+// transfers shorter than ST7735_DMA_MIN_BYTES stay polled.
+#ifndef ST7735_USE_DMA
+#define ST7735_USE_DMA        1
+#endif
+#define ST7735_DMA_MIN_BYTES  32
+#define ST7735_DMA_TIMEOUT_MS 100   // 64 KB take ~35 ms at 15 MHz
+#define ST7735_FILL_LINES     8     // Rows per fill transfer (buffer: 2 x width x lines)
+
+// Fill buffers are written by the DMA2D engine (hal_dma2d.h) rather than
+// a CPU loop; falls back to the loop if the engine is unavailable
+#ifndef ST7735_USE_DMA2D
+#define ST7735_USE_DMA2D      1
+#endif
+
+// Pre-rendered glyphs for value updates: these characters, for the last
+// font and color pair drawn, in fonts up to ST7735_GLYPH_CACHE_PIXELS
+#ifndef ST7735_GLYPH_CACHE
+#define ST7735_GLYPH_CACHE          1
+#endif
+#define ST7735_GLYPH_CACHE_CHARS    "0123456789.-+ %C"
+#define ST7735_GLYPH_CACHE_PIXELS   (11 * 18)   // 16 x 396 bytes
+
 // AliExpress/eBay 1.8" display, default orientation
 /*
 #define ST7735_IS_160X128 1
@@ -174,6 +207,16 @@ extern SPI_HandleTypeDef ST7735_SPI_PORT;
 
 /****************************/
 
+// Vertical scrolling moves frame memory lines, 162 on the ST7735R/S. With
+// MV set those lines are screen columns, so the scroll runs horizontally.
+// ST7735_SCROLL_REVERSED: memory line numbers fall as screen x rises
+// (set it to 1 if a scrolling chart moves the wrong way)
+#define ST7735_FRAME_LINES          162
+#define ST7735_SCROLL_HORIZONTAL    ((ST7735_ROTATION & ST7735_MADCTL_MV) != 0)
+#ifndef ST7735_SCROLL_REVERSED
+#define ST7735_SCROLL_REVERSED      ((ST7735_ROTATION & ST7735_MADCTL_MY) != 0)
+#endif
+
 #define ST7735_NOP     0x00
 #define ST7735_SWRESET 0x01
 #define ST7735_RDDID   0x04
@@ -195,6 +238,8 @@ extern SPI_HandleTypeDef ST7735_SPI_PORT;
 #define ST7735_RAMRD   0x2E
 
 #define ST7735_PTLAR   0x30
+#define ST7735_VSCRDEF 0x33
+#define ST7735_VSCRSADD 0x37
 #define ST7735_COLMOD  0x3A
 #define ST7735_MADCTL  0x36
 
@@ -247,6 +292,12 @@ extern "C" {
 void ST7735_Unselect();
 
 void ST7735_Init(void);
+
+// Non-blocking init: after ST7735_InitBegin(), call ST7735_InitContinue()
+// again *wait_ms later until it returns true. ST7735_Init() does the same
+// with HAL_Delay().
+void ST7735_InitBegin(void);
+bool ST7735_InitContinue(uint32_t *wait_ms);
 void ST7735_Sleep(void);
 void ST7735_Wakeup(void);
 void ST7735_DrawPixel(uint16_t x, uint16_t y, uint16_t color);
@@ -256,8 +307,24 @@ void ST7735_FillRectangleFast(uint16_t x, uint16_t y, uint16_t w, uint16_t h, ui
 void ST7735_FillScreen(uint16_t color);
 void ST7735_FillScreenFast(uint16_t color);
 void ST7735_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t* data);
+// Glyph pixels in panel byte order (font.width x font.height); valid until the next call
+const uint16_t* ST7735_RenderGlyph(char ch, FontDef font, uint16_t color, uint16_t bgcolor);
 void ST7735_InvertColors(bool invert);
+// Frame memory lines: fixed at the start, scrolling, fixed at the end (sum ST7735_FRAME_LINES)
+void ST7735_SetScrollArea(uint16_t top_fixed, uint16_t scroll_lines, uint16_t bottom_fixed);
+// Memory line shown first in the scroll area
+void ST7735_SetScrollStart(uint16_t line);
 void ST7735_SetGamma(GammaDef gamma);
+// SCK prescaler for the panel (ST7735_InitBegin() picks it from ST7735_SPI_MAX_HZ
+// and follows clock changes; a prescaler set here stays fixed)
+void ST7735_SetSpiPrescaler(hal_spi_prescaler_t prescaler);
+hal_spi_prescaler_t ST7735_GetSpiPrescaler(void);
+uint32_t ST7735_GetSpiClockHz(void);
+// Polled transfers only while disabled, for comparing the paths; false if
+// the DMA path is unavailable (ST7735_USE_DMA 0 or no DMA channel)
+bool ST7735_SetDmaEnabled(bool enable);
+// Bytes clocked out since boot (commands and data), wraps
+uint32_t ST7735_GetBytesSent(void);
 
 #ifdef __cplusplus
 }
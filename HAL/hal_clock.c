@@ -0,0 +1,302 @@
+#include "hal_clock.h"
+#include "hal_timer.h"
+#include "hal_uart.h"
+#include "hal_i2c.h"
+#include "hal_spi.h"
+#include "hal_usb.h"
+
+// STM32-specific implementation
+#include "stm32f7xx_hal.h"
+#include "../OS/os_wrapper.h"
+
+// One row per level; the NORMAL row matches SystemClock_Config() (main.c)
+typedef struct {
+    uint32_t pll_n;             // 8 MHz HSE / PLLM 8 = 1 MHz PLL input
+    uint32_t pll_q;             // 48 MHz domain, unused on this board
+    uint32_t ahb_div;
+    uint32_t apb1_div;
+    uint32_t apb2_div;
+    uint32_t voltage;
+    bool overdrive;
+    uint32_t latency;           // At 2.7-3.6 V: 30 MHz per wait state
+    uint32_t hclk_hz;
+} clock_config_t;
+
+static const clock_config_t configs[HAL_CLOCK_LEVEL_COUNT] = {
+    [HAL_CLOCK_LOW]    = { 240, 2, RCC_SYSCLK_DIV2, RCC_HCLK_DIV2, RCC_HCLK_DIV1,
+                           PWR_REGULATOR_VOLTAGE_SCALE3, false, FLASH_LATENCY_1, 60000000 },
+    [HAL_CLOCK_NORMAL] = { 240, 2, RCC_SYSCLK_DIV1, RCC_HCLK_DIV4, RCC_HCLK_DIV2,
+                           PWR_REGULATOR_VOLTAGE_SCALE3, false, FLASH_LATENCY_3, 120000000 },
+    [HAL_CLOCK_FULL]   = { 432, 9, RCC_SYSCLK_DIV1, RCC_HCLK_DIV4, RCC_HCLK_DIV2,
+                           PWR_REGULATOR_VOLTAGE_SCALE1, true, FLASH_LATENCY_7, 216000000 },
+};
+
+static const char *const level_names[HAL_CLOCK_LEVEL_COUNT] = {
+    [HAL_CLOCK_LOW]    = "low",
+    [HAL_CLOCK_NORMAL] = "normal",
+    [HAL_CLOCK_FULL]   = "full",
+};
+
+static bool clock_initialized = false;
+static hal_clock_stats_t stats = {
+    .level = HAL_CLOCK_NORMAL,
+    .target = HAL_CLOCK_NORMAL,
+    .forced = HAL_CLOCK_LEVEL_COUNT,
+};
+static uint64_t level_since_us = 0;
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static hal_clock_level_t target_level(void)
+{
+    if (stats.forced != HAL_CLOCK_LEVEL_COUNT) {
+        return stats.forced;
+    }
+    for (int level = HAL_CLOCK_LEVEL_COUNT - 1; level >= 0; level--) {
+        if (stats.requests[level] > 0) {
+            return (hal_clock_level_t)level;
+        }
+    }
+    return HAL_CLOCK_IDLE_LEVEL;
+}
+
+static bool same_pll(const clock_config_t *a, const clock_config_t *b)
+{
+    return a->pll_n == b->pll_n && a->voltage == b->voltage && a->overdrive == b->overdrive;
+}
+
+/**
+ * @brief Run from the PLL at a level's configuration (interrupts masked)
+ *
+ * A new PLL or regulator setting goes through HSE: VOS only changes with
+ * the PLL off, and the overdrive only switches off the PLL. HAL timeouts
+ * cannot expire with interrupts masked, but the ready flags come up within
+ * a few hundred microseconds. HAL_RCC_ClockConfig() updates SystemCoreClock
+ * and re-programs the HAL tick.
+ */
+static bool apply_config(const clock_config_t *config, bool relock)
+{
+    RCC_ClkInitTypeDef clk = {0};
+    clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK |
+                    RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+
+    if (relock) {
+        __HAL_RCC_HSE_CONFIG(RCC_HSE_ON);
+        while (__HAL_RCC_GET_FLAG(RCC_FLAG_HSERDY) == RESET) {
+        }
+
+        clk.SYSCLKSource = RCC_SYSCLKSOURCE_HSE;
+        clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+        clk.APB1CLKDivider = RCC_HCLK_DIV1;
+        clk.APB2CLKDivider = RCC_HCLK_DIV1;
+        if (HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_0) != HAL_OK) {
+            return false;
+        }
+
+        if (__HAL_PWR_GET_FLAG(PWR_FLAG_ODRDY) != RESET &&
+            HAL_PWREx_DisableOverDrive() != HAL_OK) {
+            return false;
+        }
+        __HAL_RCC_PLL_DISABLE();
+        while (__HAL_RCC_GET_FLAG(RCC_FLAG_PLLRDY) != RESET) {
+        }
+        __HAL_RCC_PWR_CLK_ENABLE();
+        __HAL_PWR_VOLTAGESCALING_CONFIG(config->voltage);
+
+        RCC_OscInitTypeDef osc = {0};
+        osc.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+        osc.PLL.PLLState = RCC_PLL_ON;
+        osc.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+        osc.PLL.PLLM = 8;
+        osc.PLL.PLLN = config->pll_n;
+        osc.PLL.PLLP = RCC_PLLP_DIV2;
+        osc.PLL.PLLQ = config->pll_q;
+        osc.PLL.PLLR = 2;
+        if (HAL_RCC_OscConfig(&osc) != HAL_OK) {
+            return false;
+        }
+        if (config->overdrive && HAL_PWREx_EnableOverDrive() != HAL_OK) {
+            return false;
+        }
+    }
+
+    clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+    clk.AHBCLKDivider = config->ahb_div;
+    clk.APB1CLKDivider = config->apb1_div;
+    clk.APB2CLKDivider = config->apb2_div;
+    return HAL_RCC_ClockConfig(&clk, config->latency) == HAL_OK;
+}
+
+/**
+ * @brief Move the FreeRTOS tick to the new core clock, keeping the share
+ *        of the running tick already counted (as the tickless idle does)
+ */
+static void retime_systick(void)
+{
+    uint32_t old_load = SysTick->LOAD + 1U;
+    uint32_t new_load = SystemCoreClock / os_ms_to_ticks(1000U);
+    uint32_t remaining = (uint32_t)(((uint64_t)SysTick->VAL * new_load) / old_load);
+
+    if (remaining < 2U) {
+        remaining = new_load;
+    }
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = remaining - 1U;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = new_load - 1U;
+}
+
+/**
+ * @brief Switch to the target level if the drivers allow it now
+ */
+static hal_clock_status_t update(void)
+{
+#if HAL_CLOCK_SCALING_ENABLE
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    hal_clock_level_t target = target_level();
+    stats.target = target;
+    if (!clock_initialized || target == stats.level) {
+        __set_PRIMASK(primask);
+        return HAL_CLOCK_OK;
+    }
+
+    // Retiming rewrites the bit clocks: nothing may be on the wire. A relock
+    // also runs HCLK at 8 MHz for a moment, too slow to feed the USB FIFO.
+    if (!hal_i2c_is_idle() || !hal_spi_is_idle() || !hal_uart_tx_is_idle() ||
+        !hal_usb_cdc_tx_is_idle()) {
+        stats.busy_retries++;
+        __set_PRIMASK(primask);
+        return HAL_CLOCK_BUSY;
+    }
+
+    const clock_config_t *from = &configs[stats.level];
+    const clock_config_t *to = &configs[target];
+    uint32_t old_pclk1_hz = HAL_RCC_GetPCLK1Freq();
+
+    if (!apply_config(to, !same_pll(from, to))) {
+        // Back to the level we came from; the peripherals never saw another
+        apply_config(from, true);
+        __set_PRIMASK(primask);
+        return HAL_CLOCK_ERROR;
+    }
+
+    retime_systick();
+    hal_timer_clock_changed();
+    hal_uart_clock_changed();
+    hal_i2c_clock_changed(old_pclk1_hz);
+    hal_spi_clock_changed();
+
+    uint64_t now = hal_timer_get_us64();
+    stats.time_in_level_us[stats.level] += now - level_since_us;
+    level_since_us = now;
+    stats.level = target;
+    stats.changes++;
+
+    __set_PRIMASK(primask);
+#endif
+    return HAL_CLOCK_OK;
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+bool hal_clock_init(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    level_since_us = hal_timer_get_us64();
+    clock_initialized = true;
+    __set_PRIMASK(primask);
+    return true;
+}
+
+hal_clock_status_t hal_clock_request(hal_clock_level_t level)
+{
+    if (level >= HAL_CLOCK_LEVEL_COUNT) {
+        return HAL_CLOCK_ERROR;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    stats.requests[level]++;
+    __set_PRIMASK(primask);
+
+    return update();
+}
+
+hal_clock_status_t hal_clock_release(hal_clock_level_t level)
+{
+    if (level >= HAL_CLOCK_LEVEL_COUNT) {
+        return HAL_CLOCK_ERROR;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (stats.requests[level] > 0) {
+        stats.requests[level]--;
+    }
+    __set_PRIMASK(primask);
+
+    return update();
+}
+
+void hal_clock_process(void)
+{
+    (void)update();
+}
+
+hal_clock_status_t hal_clock_force(hal_clock_level_t level)
+{
+    if (level > HAL_CLOCK_LEVEL_COUNT) {
+        return HAL_CLOCK_ERROR;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    stats.forced = level;
+    __set_PRIMASK(primask);
+
+    return update();
+}
+
+hal_clock_level_t hal_clock_get_level(void)
+{
+    return stats.level;
+}
+
+uint32_t hal_clock_level_hz(hal_clock_level_t level)
+{
+    return (level < HAL_CLOCK_LEVEL_COUNT) ? configs[level].hclk_hz : 0;
+}
+
+const char *hal_clock_level_name(hal_clock_level_t level)
+{
+    return (level < HAL_CLOCK_LEVEL_COUNT) ? level_names[level] : "?";
+}
+
+void hal_clock_restore(void)
+{
+    // From HSI: HSE, PLL, regulator and overdrive as the level had them
+    apply_config(&configs[stats.level], true);
+}
+
+void hal_clock_get_stats(hal_clock_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = stats;
+    if (clock_initialized) {
+        out->time_in_level_us[stats.level] += hal_timer_get_us64() - level_since_us;
+    }
+    __set_PRIMASK(primask);
+}
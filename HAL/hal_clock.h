@@ -0,0 +1,123 @@
+#ifndef HAL_CLOCK_H
+#define HAL_CLOCK_H
+
+/**
+ * @file hal_clock.h
+ * @brief Performance levels: system clock scaling at runtime
+ *
+ * The board boots at HAL_CLOCK_NORMAL (SystemClock_Config(): 8 MHz HSE,
+ * PLL 120 MHz, regulator scale 3). Two more levels trade speed for energy:
+ *
+ *   level    HCLK     PCLK1   PCLK2   regulator         flash
+ *   LOW      60 MHz   30 MHz  60 MHz  scale 3           1 WS
+ *   NORMAL  120 MHz   30 MHz  60 MHz  scale 3           3 WS
+ *   FULL    216 MHz   54 MHz 108 MHz  scale 1, overdrive 7 WS
+ *
+ * LOW only divides the AHB clock, so it keeps every peripheral clock of
+ * NORMAL and is entered without touching the PLL. FULL runs the PLL at
+ * 432 MHz VCO: the core switches to HSE while the PLL relocks and the
+ * overdrive ramps up, a few hundred microseconds with interrupts masked.
+ *
+ * After a change the clock users are retimed: SystemCoreClock and the
+ * SysTick reload (the FreeRTOS tick), the HAL tick (TIM6), the microsecond
+ * timer (TIM5, in phase), UART baud rates, I2C timings and the SCK of SPI
+ * devices opened with a maximum rate (hal_spi_device_set_max_hz()). A
+ * change waits for a quiet moment: no I2C transaction queued, no SPI,
+ * UART or USB IN transmission in flight. A byte the UART receives during
+ * the switch itself can be lost; the protocol CRC catches it. The USB
+ * clock (PLLSAI) is not touched; the bus only stalls for the switch.
+ *
+ * Users request levels; the highest requested one runs, HAL_CLOCK_IDLE_LEVEL
+ * when nobody asks. Requests are counted, so each hal_clock_request() needs
+ * its hal_clock_release(). A request that finds the system busy is applied
+ * by hal_clock_process() (services loop) once it is quiet.
+ *
+ * Not retimed: the PC sampler (TIM7), set up on its first start, and the
+ * SystemView timestamp rate sent once at start.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef HAL_CLOCK_SCALING_ENABLE
+#define HAL_CLOCK_SCALING_ENABLE    1
+#endif
+
+typedef enum {
+    HAL_CLOCK_LOW = 0,          // Half speed: idle and low-rate logging
+    HAL_CLOCK_NORMAL,           // Board default
+    HAL_CLOCK_FULL,             // 216 MHz with overdrive
+    HAL_CLOCK_LEVEL_COUNT
+} hal_clock_level_t;
+
+// Level with no requests
+#ifndef HAL_CLOCK_IDLE_LEVEL
+#define HAL_CLOCK_IDLE_LEVEL        HAL_CLOCK_LOW
+#endif
+
+typedef enum {
+    HAL_CLOCK_OK = 0,
+    HAL_CLOCK_BUSY,             // A transfer is in flight; retried by hal_clock_process()
+    HAL_CLOCK_ERROR
+} hal_clock_status_t;
+
+typedef struct {
+    hal_clock_level_t level;    // Running now
+    hal_clock_level_t target;   // Highest request (or HAL_CLOCK_IDLE_LEVEL)
+    hal_clock_level_t forced;   // HAL_CLOCK_LEVEL_COUNT when following the requests
+    uint16_t requests[HAL_CLOCK_LEVEL_COUNT];
+    uint32_t changes;
+    uint32_t busy_retries;      // Attempts deferred by a transfer in flight
+    uint64_t time_in_level_us[HAL_CLOCK_LEVEL_COUNT];
+} hal_clock_stats_t;
+
+/**
+ * @brief Take over the clock set up by SystemClock_Config() (NORMAL)
+ *
+ * Call once the HAL drivers are initialized; later requests are applied.
+ */
+bool hal_clock_init(void);
+
+/**
+ * @brief Ask for at least a level (nestable, task context)
+ * @return HAL_CLOCK_OK if the level runs now or was already covered,
+ *         HAL_CLOCK_BUSY if it will be applied by hal_clock_process()
+ */
+hal_clock_status_t hal_clock_request(hal_clock_level_t level);
+
+/**
+ * @brief Drop a hal_clock_request() (task context)
+ */
+hal_clock_status_t hal_clock_release(hal_clock_level_t level);
+
+/**
+ * @brief Apply a pending change once the drivers are quiet (services loop)
+ */
+void hal_clock_process(void);
+
+/**
+ * @brief Pin a level regardless of the requests (tests, benchmarks, host
+ *        command); HAL_CLOCK_LEVEL_COUNT returns to the requests
+ */
+hal_clock_status_t hal_clock_force(hal_clock_level_t level);
+
+hal_clock_level_t hal_clock_get_level(void);
+
+/**
+ * @brief HCLK of a level in Hz
+ */
+uint32_t hal_clock_level_hz(hal_clock_level_t level);
+
+const char *hal_clock_level_name(hal_clock_level_t level);
+
+/**
+ * @brief Bring back the running level after STOP mode (interrupts masked)
+ *
+ * STOP leaves the core on HSI with the PLL and the overdrive off; the
+ * peripheral clocks come back as they were, so nothing is retimed.
+ */
+void hal_clock_restore(void);
+
+void hal_clock_get_stats(hal_clock_stats_t *stats);
+
+#endif // HAL_CLOCK_H
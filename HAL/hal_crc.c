@@ -0,0 +1,123 @@
+#include "hal_crc.h"
+#include "../OS/os_wrapper.h"
+
+// STM32-specific implementation
+#include "stm32f7xx_hal.h"
+
+#define CRC_CCITT_POLY      0x1021U
+
+static os_mutex_handle_t crc_mutex = NULL;
+OS_MUTEX_DEFINE(crc);
+static bool crc_available = false;
+
+/**
+ * @brief Enable the CRC peripheral for 16-bit CCITT
+ * @return true if successful (also when already initialized), false otherwise
+ */
+bool hal_crc_init(void)
+{
+    if (crc_available) {
+        return true;
+    }
+
+    crc_mutex = OS_MUTEX_CREATE_STATIC(crc);
+    if (crc_mutex == NULL) {
+        return false;
+    }
+
+    __HAL_RCC_CRC_CLK_ENABLE();
+
+    CRC->POL = CRC_CCITT_POLY;
+    CRC->CR = CRC_CR_POLYSIZE_0;  // 16-bit polynomial, no input/output reversal
+
+    crc_available = true;
+    return true;
+}
+
+/**
+ * @brief Check whether the hardware CRC is initialized
+ * @return true if hal_crc_ccitt16() can be used
+ */
+bool hal_crc_is_available(void)
+{
+    return crc_available;
+}
+
+/**
+ * @brief Compute CRC-16/CCITT in hardware
+ * @param init Initial CRC value (0xFFFF for CCITT-FALSE)
+ * @param data Data buffer
+ * @param length Number of bytes
+ * @return CRC value, or init if the peripheral is not available
+ */
+uint16_t hal_crc_ccitt16(uint16_t init, const uint8_t *data, size_t length)
+{
+    if (!crc_available || (data == NULL && length > 0)) {
+        return init;
+    }
+
+    os_mutex_take(crc_mutex, OS_WAIT_FOREVER);
+
+    CRC->INIT = init;
+    CRC->CR |= CRC_CR_RESET;
+
+    // Bytes until word aligned
+    while (length > 0 && ((uintptr_t)data & 3U) != 0) {
+        *(volatile uint8_t *)&CRC->DR = *data++;
+        length--;
+    }
+
+    // Whole words, MSB first as the CCITT bit order expects
+    while (length >= 4) {
+        CRC->DR = __REV(*(const uint32_t *)data);
+        data += 4;
+        length -= 4;
+    }
+
+    // Tail
+    while (length > 0) {
+        *(volatile uint8_t *)&CRC->DR = *data++;
+        length--;
+    }
+
+    uint16_t crc = (uint16_t)CRC->DR;
+
+    os_mutex_give(crc_mutex);
+    return crc;
+}
+
+/**
+ * @brief Compute an 8-bit CRC in hardware (no reflection, no final XOR)
+ * @param poly Polynomial (e.g. 0x31)
+ * @param init Initial CRC value
+ * @param data Data buffer
+ * @param length Number of bytes
+ * @return CRC value, or init if the peripheral is not available
+ */
+uint8_t hal_crc_crc8(uint8_t poly, uint8_t init, const uint8_t *data, size_t length)
+{
+    if (!crc_available || (data == NULL && length > 0)) {
+        return init;
+    }
+
+    os_mutex_take(crc_mutex, OS_WAIT_FOREVER);
+
+    CRC->POL = poly;
+    CRC->CR = CRC_CR_POLYSIZE_1;  // 8-bit polynomial
+    CRC->INIT = init;
+    CRC->CR |= CRC_CR_RESET;
+
+    while (length > 0) {
+        *(volatile uint8_t *)&CRC->DR = *data++;
+        length--;
+    }
+
+    uint8_t crc = (uint8_t)CRC->DR;
+
+    // Back to the CCITT configuration the other users expect
+    CRC->POL = CRC_CCITT_POLY;
+    CRC->CR = CRC_CR_POLYSIZE_0;
+
+    os_mutex_give(crc_mutex);
+    return crc;
+}
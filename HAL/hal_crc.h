@@ -0,0 +1,25 @@
+#ifndef HAL_CRC_H
+#define HAL_CRC_H
+
+/**
+ * @file hal_crc.h
+ * @brief Platform-independent hardware CRC abstraction layer
+ *
+ * Wraps the STM32F7 CRC peripheral configured for CRC-16/CCITT
+ * (poly 0x1021, no reflection). hal_crc_crc8() switches it to an 8-bit
+ * polynomial for one call and restores CCITT afterwards. The peripheral
+ * is shared, so calls are serialized with a mutex and must not be made
+ * from ISR context.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// CRC Functions
+bool hal_crc_init(void);
+bool hal_crc_is_available(void);
+uint16_t hal_crc_ccitt16(uint16_t init, const uint8_t *data, size_t length);
+uint8_t hal_crc_crc8(uint8_t poly, uint8_t init, const uint8_t *data, size_t length);
+
+#endif // HAL_CRC_H
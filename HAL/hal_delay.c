@@ -20,3 +20,21 @@ uint32_t hal_get_tick(void)
 {
     return HAL_GetTick();
 }
+
+/**
+ * @brief Get current CPU cycle count
+ * @return DWT cycle counter value (wraps every 2^32 cycles)
+ */
+uint32_t hal_get_cycle_count(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief Get CPU core clock frequency
+ * @return Core clock in Hz (cycles per second)
+ */
+uint32_t hal_get_cpu_freq_hz(void)
+{
+    return SystemCoreClock;
+}
@@ -12,4 +12,8 @@
 void hal_delay_ms(uint32_t milliseconds);
 uint32_t hal_get_tick(void);
 
+// Cycle Counter Functions (DWT, enabled at boot)
+uint32_t hal_get_cycle_count(void);
+uint32_t hal_get_cpu_freq_hz(void);
+
 #endif // HAL_DELAY_H
@@ -0,0 +1,155 @@
+#include "hal_dma2d.h"
+#include "hal_mem.h"
+#include "../OS/os_wrapper.h"
+
+// STM32-specific implementation
+#include "stm32f7xx_hal.h"
+
+#define DMA2D_MODE_M2M          0U
+#define DMA2D_MODE_R2M          (DMA2D_CR_MODE_0 | DMA2D_CR_MODE_1)
+#define DMA2D_CM_RGB565         2U          // OPFCCR / FGPFCCR color mode
+#define DMA2D_TIMEOUT_MS        10U
+
+static os_mutex_handle_t dma2d_mutex = NULL;
+OS_MUTEX_DEFINE(dma2d);
+static bool dma2d_available = false;
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static bool geometry_ok(uint16_t pitch, uint16_t w, uint16_t h)
+{
+    return w > 0 && h > 0 && w <= HAL_DMA2D_MAX_WIDTH && pitch >= w &&
+           pitch - w <= HAL_DMA2D_MAX_PITCH;
+}
+
+static size_t span_bytes(uint16_t pitch, uint16_t w, uint16_t h)
+{
+    return ((size_t)(h - 1) * pitch + w) * sizeof(uint16_t);
+}
+
+/**
+ * @brief Start the programmed transfer and wait for it
+ * @return false on a configuration or transfer error, or a timeout
+ */
+static bool run_transfer(void)
+{
+    DMA2D->IFCR = DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTEIF | DMA2D_IFCR_CCEIF;
+    DMA2D->CR |= DMA2D_CR_START;
+
+    uint32_t start = HAL_GetTick();
+    while ((DMA2D->ISR & (DMA2D_ISR_TCIF | DMA2D_ISR_TEIF | DMA2D_ISR_CEIF)) == 0) {
+        if (HAL_GetTick() - start > DMA2D_TIMEOUT_MS) {
+            DMA2D->CR |= DMA2D_CR_ABORT;
+            while (DMA2D->CR & DMA2D_CR_START) {
+            }
+            return false;
+        }
+    }
+
+    bool ok = (DMA2D->ISR & (DMA2D_ISR_TEIF | DMA2D_ISR_CEIF)) == 0;
+    DMA2D->IFCR = DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTEIF | DMA2D_IFCR_CCEIF;
+    return ok;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Enable the DMA2D clock
+ * @return true if successful (also when already initialized), false otherwise
+ */
+bool hal_dma2d_init(void)
+{
+    if (dma2d_available) {
+        return true;
+    }
+
+    dma2d_mutex = OS_MUTEX_CREATE_STATIC(dma2d);
+    if (dma2d_mutex == NULL) {
+        return false;
+    }
+
+    __HAL_RCC_DMA2D_CLK_ENABLE();
+
+    DMA2D->OPFCCR = DMA2D_CM_RGB565;
+    DMA2D->FGPFCCR = DMA2D_CM_RGB565;
+
+    dma2d_available = true;
+    return true;
+}
+
+/**
+ * @brief Check whether the blitter is initialized
+ */
+bool hal_dma2d_is_available(void)
+{
+    return dma2d_available;
+}
+
+/**
+ * @brief Set every pixel of a rectangle to one value
+ * @param dst First pixel of the rectangle (2-byte aligned)
+ * @param dst_pitch Pixels from one line of dst to the next
+ * @param pixel Value stored as is
+ * @return false if the CPU has to do it
+ */
+bool hal_dma2d_fill(uint16_t *dst, uint16_t dst_pitch, uint16_t w, uint16_t h, uint16_t pixel)
+{
+    if (!dma2d_available || dst == NULL || !geometry_ok(dst_pitch, w, h)) {
+        return false;
+    }
+
+    size_t dst_bytes = span_bytes(dst_pitch, w, h);
+
+    os_mutex_take(dma2d_mutex, OS_WAIT_FOREVER);
+    hal_cache_clean(dst, dst_bytes);
+
+    DMA2D->CR = DMA2D_MODE_R2M;
+    DMA2D->OCOLR = pixel;
+    DMA2D->OMAR = (uint32_t)dst;
+    DMA2D->OOR = (uint32_t)(dst_pitch - w);
+    DMA2D->NLR = ((uint32_t)w << DMA2D_NLR_PL_Pos) | h;
+    bool ok = run_transfer();
+
+    hal_cache_invalidate(dst, dst_bytes);
+    os_mutex_give(dma2d_mutex);
+    return ok;
+}
+
+/**
+ * @brief Copy a rectangle of pixels
+ * @param dst First destination pixel (2-byte aligned)
+ * @param dst_pitch Pixels from one line of dst to the next
+ * @param src First source pixel (2-byte aligned, RAM or flash)
+ * @param src_pitch Pixels from one line of src to the next
+ * @return false if the CPU has to do it
+ */
+bool hal_dma2d_copy(uint16_t *dst, uint16_t dst_pitch, const uint16_t *src, uint16_t src_pitch,
+                    uint16_t w, uint16_t h)
+{
+    if (!dma2d_available || dst == NULL || src == NULL ||
+        !geometry_ok(dst_pitch, w, h) || !geometry_ok(src_pitch, w, h)) {
+        return false;
+    }
+
+    size_t dst_bytes = span_bytes(dst_pitch, w, h);
+
+    os_mutex_take(dma2d_mutex, OS_WAIT_FOREVER);
+    hal_cache_clean(src, span_bytes(src_pitch, w, h));
+    hal_cache_clean(dst, dst_bytes);
+
+    DMA2D->CR = DMA2D_MODE_M2M;
+    DMA2D->FGMAR = (uint32_t)src;
+    DMA2D->FGOR = (uint32_t)(src_pitch - w);
+    DMA2D->OMAR = (uint32_t)dst;
+    DMA2D->OOR = (uint32_t)(dst_pitch - w);
+    DMA2D->NLR = ((uint32_t)w << DMA2D_NLR_PL_Pos) | h;
+    bool ok = run_transfer();
+
+    hal_cache_invalidate(dst, dst_bytes);
+    os_mutex_give(dma2d_mutex);
+    return ok;
+}
@@ -0,0 +1,38 @@
+#ifndef HAL_DMA2D_H
+#define HAL_DMA2D_H
+
+/**
+ * @file hal_dma2d.h
+ * @brief Platform-independent 2D blitter abstraction layer
+ *
+ * Wraps the STM32F7 DMA2D (Chrom-ART) engine for 16-bit pixels: fill a
+ * rectangle with one value (register to memory) and copy a rectangle
+ * between buffers of different pitch (memory to memory). Pixels are
+ * moved as is, without format conversion, so panel byte order is kept.
+ *
+ * Calls are synchronous: they start the transfer and poll for its end,
+ * about 100 µs for a full 160x128 screen. The engine
+ * is shared, so calls are serialized with a mutex and must not be made
+ * from ISR context. Cache maintenance is done here: the source is
+ * cleaned, the destination cleaned before and invalidated after, so a
+ * destination must not share cache lines with data written concurrently.
+ *
+ * A false return (not initialized, bad geometry, timeout) leaves the
+ * caller to do the job with the CPU.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HAL_DMA2D_MAX_WIDTH     0x3FFFU     // Pixels per line
+#define HAL_DMA2D_MAX_PITCH     0x3FFFU     // Line offset limit, pitch - width
+
+bool hal_dma2d_init(void);
+bool hal_dma2d_is_available(void);
+
+// Pitches are in pixels
+bool hal_dma2d_fill(uint16_t *dst, uint16_t dst_pitch, uint16_t w, uint16_t h, uint16_t pixel);
+bool hal_dma2d_copy(uint16_t *dst, uint16_t dst_pitch, const uint16_t *src, uint16_t src_pitch,
+                    uint16_t w, uint16_t h);
+
+#endif // HAL_DMA2D_H
@@ -0,0 +1,74 @@
+#include "hal_flash.h"
+#include "hal_mem.h"
+#include <string.h>
+
+// STM32-specific implementation
+#include "stm32f7xx_hal.h"
+
+static bool in_data_area(uint32_t address, size_t length)
+{
+    uint32_t end = HAL_FLASH_DATA_BASE + HAL_FLASH_DATA_SECTOR_COUNT * HAL_FLASH_DATA_SECTOR_SIZE;
+    return address >= HAL_FLASH_DATA_BASE && length <= end - address;
+}
+
+/**
+ * @brief Erase one sector of the reserved data area
+ * @param index Sector within the area (0..HAL_FLASH_DATA_SECTOR_COUNT-1)
+ * @return true if successful, false otherwise
+ * @note Blocks, and stalls all flash reads, for the whole erase (~1-2 s)
+ */
+bool hal_flash_erase_data_sector(uint32_t index)
+{
+    if (index >= HAL_FLASH_DATA_SECTOR_COUNT) {
+        return false;
+    }
+
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_SECTORS,
+        .Sector = HAL_FLASH_DATA_FIRST_SECTOR + index,
+        .NbSectors = 1,
+        .VoltageRange = FLASH_VOLTAGE_RANGE_3,  // 2.7-3.6 V, 32-bit parallelism
+    };
+    uint32_t sector_error = 0;
+
+    HAL_FLASH_Unlock();
+    HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &sector_error);
+    HAL_FLASH_Lock();
+
+    // Reads go through the D-cache; drop stale lines
+    hal_cache_invalidate((void *)(HAL_FLASH_DATA_BASE + index * HAL_FLASH_DATA_SECTOR_SIZE),
+                         HAL_FLASH_DATA_SECTOR_SIZE);
+
+    return status == HAL_OK;
+}
+
+/**
+ * @brief Program erased flash in the reserved data area
+ * @param address Word-aligned destination
+ * @param data Source data
+ * @param length Number of bytes (multiple of 4)
+ * @return true if successful, false otherwise
+ * @note Programs one word at a time, so other code only waits for one
+ *       word program at a time between the words
+ */
+bool hal_flash_program(uint32_t address, const void *data, size_t length)
+{
+    if (data == NULL || (address & 3U) != 0 || (length & 3U) != 0 || !in_data_area(address, length)) {
+        return false;
+    }
+
+    const uint8_t *src = (const uint8_t *)data;
+    HAL_StatusTypeDef status = HAL_OK;
+
+    HAL_FLASH_Unlock();
+    for (size_t offset = 0; offset < length && status == HAL_OK; offset += 4) {
+        uint32_t word;
+        memcpy(&word, src + offset, sizeof(word));
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + offset, word);
+    }
+    HAL_FLASH_Lock();
+
+    hal_cache_invalidate((void *)address, length);
+
+    return status == HAL_OK;
+}
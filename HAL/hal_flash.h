@@ -0,0 +1,41 @@
+#ifndef HAL_FLASH_H
+#define HAL_FLASH_H
+
+/**
+ * @file hal_flash.h
+ * @brief Internal flash erase/program for the reserved data area
+ *
+ * The upper megabyte of flash (sectors 8-11, 256 KB each, single-bank
+ * layout) is kept out of the image by the linker script (LOG_FLASH) and
+ * can be erased and programmed through these calls at run time. Data is
+ * read back directly through the memory map.
+ *
+ * The F767 runs single-bank, so flash reads stall while the array is busy:
+ * a 32-bit word program holds the bus ~20 us, a 256 KB sector erase ~1-2 s.
+ * Callers batch their writes and place erases where a long stall is
+ * acceptable. Not reentrant; use from one task.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Reserved data area (must match LOG_FLASH in the linker script)
+#define HAL_FLASH_DATA_BASE             0x08100000UL
+#define HAL_FLASH_DATA_SECTOR_SIZE      (256U * 1024U)
+#define HAL_FLASH_DATA_SECTOR_COUNT     4U
+#define HAL_FLASH_DATA_FIRST_SECTOR     8U
+
+// Last two sectors of the area: the config store (serv_config.h), which
+// alternates between them; the sample log has the ones before them
+#define HAL_FLASH_CONFIG_SECTOR_COUNT   2U
+#define HAL_FLASH_CONFIG_SECTOR         (HAL_FLASH_DATA_SECTOR_COUNT - HAL_FLASH_CONFIG_SECTOR_COUNT)
+
+// Erased flash reads as all ones
+#define HAL_FLASH_ERASED_WORD           0xFFFFFFFFUL
+
+// Flash Functions
+bool hal_flash_erase_data_sector(uint32_t index);
+bool hal_flash_program(uint32_t address, const void *data, size_t length);
+
+#endif // HAL_FLASH_H
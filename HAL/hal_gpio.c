@@ -1,8 +1,29 @@
 #include "hal_gpio.h"
+#include "hal_mem.h"
+#include "../OS/event_bus.h"
+#include <string.h>
 
 // STM32-specific implementation
 #include "stm32f7xx_hal.h"
 
+#define GPIO_PORT_STRIDE    (GPIOB_BASE - GPIOA_BASE)
+#define GPIO_PORT_COUNT     11U     // GPIOA..GPIOK
+
+// EXTI lines, indexed by line (pin number)
+typedef struct {
+    hal_gpio_irq_callback_t callback;
+    void *user_data;
+    hal_gpio_port_t port;           // NULL: set up by the board init, callback only
+    hal_gpio_edge_t edge;
+    uint16_t debounce_ms;
+    uint16_t event_type;
+    uint8_t stable_level;           // Debounced level
+    uint32_t last_edge_tick;        // HAL tick of the latest edge (debounced lines)
+} exti_line_t;
+
+static exti_line_t exti_lines[HAL_GPIO_EXTI_LINES];
+static volatile uint16_t debounce_pending;     // Lines waiting for their level to settle
+
 /**
  * @brief Write to a GPIO pin
  * @param port GPIO port handle
@@ -34,3 +55,212 @@ void hal_gpio_toggle_pin(hal_gpio_port_t port, hal_gpio_pin_t pin)
 {
     HAL_GPIO_TogglePin((GPIO_TypeDef*)port, pin);
 }
+
+/**
+ * @brief Register a callback for a pin's external interrupt line
+ * @param pin GPIO pin (single pin mask)
+ * @param callback Callback, or NULL
+ * @param user_data Context passed to the callback
+ */
+void hal_gpio_register_irq_callback(hal_gpio_pin_t pin, hal_gpio_irq_callback_t callback, void *user_data)
+{
+    if (pin == 0) {
+        return;
+    }
+    
+    uint32_t line = (uint32_t)__builtin_ctz(pin);
+    __disable_irq();
+    exti_lines[line].callback = callback;
+    exti_lines[line].user_data = user_data;
+    __enable_irq();
+}
+
+// ============================================================================
+// EXTI Router
+// ============================================================================
+
+static IRQn_Type exti_irq(uint32_t line)
+{
+    if (line < 5U) {
+        return (IRQn_Type)(EXTI0_IRQn + (int32_t)line);
+    }
+    return (line < 10U) ? EXTI9_5_IRQn : EXTI15_10_IRQn;
+}
+
+static uint32_t gpio_mode(hal_gpio_edge_t edge)
+{
+    switch (edge) {
+        case HAL_GPIO_EDGE_RISING:  return GPIO_MODE_IT_RISING;
+        case HAL_GPIO_EDGE_FALLING: return GPIO_MODE_IT_FALLING;
+        default:                    return GPIO_MODE_IT_RISING_FALLING;
+    }
+}
+
+static void report_edge(uint32_t line, uint8_t level)
+{
+    exti_line_t *l = &exti_lines[line];
+    hal_gpio_pin_t pin = (hal_gpio_pin_t)(1U << line);
+
+    if (l->callback != NULL) {
+        l->callback(pin, l->user_data);
+    }
+    if (l->event_type != EVENT_NONE) {
+        hal_gpio_exti_event_t event = { .pin = pin, .level = level };
+        event_bus_publish_from_isr((event_type_t)l->event_type, &event, sizeof(event));
+    }
+}
+
+static HAL_ITCM_FUNC void exti_edge(uint32_t line)
+{
+    exti_line_t *l = &exti_lines[line];
+
+    if (l->port == NULL) {
+        // Board-configured line: the callback reads what it needs
+        if (l->callback != NULL) {
+            l->callback((hal_gpio_pin_t)(1U << line), l->user_data);
+        }
+        return;
+    }
+
+    if (l->debounce_ms == 0) {
+        report_edge(line, (uint8_t)HAL_GPIO_ReadPin((GPIO_TypeDef *)l->port, (uint16_t)(1U << line)));
+        return;
+    }
+
+    // Every bounce restarts the quiet time; the tick decides
+    l->last_edge_tick = HAL_GetTick();
+    __atomic_fetch_or(&debounce_pending, (uint16_t)(1U << line), __ATOMIC_RELAXED);
+}
+
+bool hal_gpio_exti_register(const hal_gpio_exti_config_t *config)
+{
+    if (config == NULL || config->port == NULL || config->pin == 0 ||
+        (config->pin & (config->pin - 1U)) != 0 ||
+        config->edge < HAL_GPIO_EDGE_RISING || config->edge > HAL_GPIO_EDGE_BOTH) {
+        return false;
+    }
+    uint32_t port_index = ((uint32_t)config->port - GPIOA_BASE) / GPIO_PORT_STRIDE;
+    if ((uint32_t)config->port < GPIOA_BASE || port_index >= GPIO_PORT_COUNT) {
+        return false;
+    }
+
+    uint32_t line = (uint32_t)__builtin_ctz(config->pin);
+    uint32_t bit = 1UL << line;
+
+    // Quiet line while its slot changes
+    __disable_irq();
+    EXTI->IMR &= ~bit;
+    debounce_pending &= (uint16_t)~bit;
+    exti_lines[line] = (exti_line_t){
+        .callback = config->callback,
+        .user_data = config->user_data,
+        .port = config->port,
+        .edge = config->edge,
+        .debounce_ms = config->debounce_ms,
+        .event_type = config->event_type,
+    };
+    __enable_irq();
+
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN << port_index;
+    (void)RCC->AHB1ENR;     // Clock on before the port is touched
+
+    // Debounced lines follow both edges to track the settled level
+    GPIO_InitTypeDef init = {
+        .Pin = config->pin,
+        .Mode = gpio_mode((config->debounce_ms != 0) ? HAL_GPIO_EDGE_BOTH : config->edge),
+        .Pull = (config->pull == HAL_GPIO_PULL_UP) ? GPIO_PULLUP
+              : (config->pull == HAL_GPIO_PULL_DOWN) ? GPIO_PULLDOWN : GPIO_NOPULL,
+        .Speed = GPIO_SPEED_FREQ_LOW,
+    };
+    EXTI->PR = bit;
+    HAL_GPIO_Init((GPIO_TypeDef *)config->port, &init);
+    exti_lines[line].stable_level = (uint8_t)HAL_GPIO_ReadPin((GPIO_TypeDef *)config->port, config->pin);
+
+    HAL_NVIC_SetPriority(exti_irq(line), HAL_GPIO_EXTI_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(exti_irq(line));
+    return true;
+}
+
+void hal_gpio_exti_unregister(hal_gpio_pin_t pin)
+{
+    if (pin == 0) {
+        return;
+    }
+
+    uint32_t line = (uint32_t)__builtin_ctz(pin);
+    uint32_t bit = 1UL << line;
+
+    __disable_irq();
+    EXTI->IMR &= ~bit;
+    EXTI->RTSR &= ~bit;
+    EXTI->FTSR &= ~bit;
+    EXTI->PR = bit;
+    debounce_pending &= (uint16_t)~bit;
+    memset(&exti_lines[line], 0, sizeof(exti_lines[line]));
+    __enable_irq();
+}
+
+HAL_ITCM_FUNC void hal_gpio_exti_irq_handler(uint16_t lines)
+{
+    uint32_t pending = EXTI->PR & EXTI->IMR & lines;
+    EXTI->PR = pending;
+
+    while (pending != 0) {
+        uint32_t line = (uint32_t)__builtin_ctz(pending);
+        pending &= pending - 1U;
+        exti_edge(line);
+    }
+}
+
+void hal_gpio_exti_tick(void)
+{
+    if (debounce_pending == 0) {
+        return;
+    }
+
+    uint32_t now = HAL_GetTick();
+    uint32_t waiting = debounce_pending;
+    while (waiting != 0) {
+        uint32_t line = (uint32_t)__builtin_ctz(waiting);
+        waiting &= waiting - 1U;
+        exti_line_t *l = &exti_lines[line];
+
+        // An edge in between restarts the wait; decide with it held off
+        __disable_irq();
+        bool settled = (now - l->last_edge_tick) >= l->debounce_ms;
+        if (settled) {
+            debounce_pending &= (uint16_t)~(1U << line);
+        }
+        __enable_irq();
+        if (!settled) {
+            continue;
+        }
+
+        uint8_t level = (uint8_t)HAL_GPIO_ReadPin((GPIO_TypeDef *)l->port, (uint16_t)(1U << line));
+        if (level == l->stable_level) {
+            continue;   // Bounced back
+        }
+        l->stable_level = level;
+        if ((level == HAL_GPIO_PIN_SET) ? (l->edge & HAL_GPIO_EDGE_RISING) : (l->edge & HAL_GPIO_EDGE_FALLING)) {
+            report_edge(line, level);
+        }
+    }
+}
+
+bool hal_gpio_exti_debouncing(void)
+{
+    return debounce_pending != 0;
+}
+
+/**
+ * @brief EXTI callback - called from STM32 HAL (ISR context)
+ *
+ * For IRQ handlers that still go through HAL_GPIO_EXTI_IRQHandler().
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    uint32_t line = (uint32_t)__builtin_ctz(GPIO_Pin);
+    if (line < HAL_GPIO_EXTI_LINES) {
+        exti_edge(line);
+    }
+}
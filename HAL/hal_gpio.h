@@ -27,4 +27,145 @@ void hal_gpio_write_pin(hal_gpio_port_t port, hal_gpio_pin_t pin, hal_gpio_pin_s
 hal_gpio_pin_state_t hal_gpio_read_pin(hal_gpio_port_t port, hal_gpio_pin_t pin);
 void hal_gpio_toggle_pin(hal_gpio_port_t port, hal_gpio_pin_t pin);
 
+/*
+ * Fast path for pins toggled per transfer (chip selects, D/C lines): a
+ * single store to the port's set/reset register, inlined at the call
+ * site. BSRR writes are atomic, so no lock is needed against other pins
+ * of the port. This is the platform-specific part a port replaces.
+ */
+#ifndef HOST_BUILD
+#include "stm32f7xx.h"
+
+static inline void hal_gpio_set_fast(hal_gpio_port_t port, hal_gpio_pin_t pin)
+{
+    ((GPIO_TypeDef *)port)->BSRR = pin;
+}
+
+static inline void hal_gpio_reset_fast(hal_gpio_port_t port, hal_gpio_pin_t pin)
+{
+    ((GPIO_TypeDef *)port)->BSRR = (uint32_t)pin << 16;
+}
+
+static inline void hal_gpio_write_fast(hal_gpio_port_t port, hal_gpio_pin_t pin, hal_gpio_pin_state_t state)
+{
+    ((GPIO_TypeDef *)port)->BSRR = (state == HAL_GPIO_PIN_SET) ? (uint32_t)pin : (uint32_t)pin << 16;
+}
+#else
+#define hal_gpio_set_fast(port, pin)            hal_gpio_write_pin((port), (pin), HAL_GPIO_PIN_SET)
+#define hal_gpio_reset_fast(port, pin)          hal_gpio_write_pin((port), (pin), HAL_GPIO_PIN_RESET)
+#define hal_gpio_write_fast(port, pin, state)   hal_gpio_write_pin((port), (pin), (state))
+#endif
+
+/**
+ * @brief External interrupt callback (ISR context)
+ * @param pin Pin that triggered the interrupt
+ * @param user_data Context passed at registration
+ */
+typedef void (*hal_gpio_irq_callback_t)(hal_gpio_pin_t pin, void *user_data);
+
+/**
+ * @brief Register a callback for a pin's external interrupt line
+ * 
+ * The pin itself (mode, edge, pull) and its EXTI IRQ are configured in
+ * the board init. One callback per line; register NULL to remove it.
+ * 
+ * @param pin GPIO pin (single pin mask)
+ * @param callback Callback, or NULL
+ * @param user_data Context passed to the callback
+ */
+void hal_gpio_register_irq_callback(hal_gpio_pin_t pin, hal_gpio_irq_callback_t callback, void *user_data);
+
+/*
+ * EXTI router: lines set up at run time, so another sensor ALERT or a
+ * button needs no board init or IRQ handler edit. Every line has one
+ * slot in a table indexed by its number, so an interrupt finds its
+ * handler in constant time.
+ *
+ * A line with debounce_ms takes both edges and restarts a quiet timer on
+ * each; the 1 ms HAL tick (TIM6) samples the pin once no edge came for
+ * debounce_ms and reports the edge from that timer interrupt, only if the
+ * settled level really changed. Lines without debounce report every edge straight from
+ * the EXTI interrupt. Reporting calls the callback and, if event_type is
+ * set, publishes it with a hal_gpio_exti_event_t through
+ * event_bus_publish_from_isr().
+ *
+ *   static const hal_gpio_exti_config_t button = {
+ *       .port = BUTTON_PORT, .pin = BUTTON_PIN,
+ *       .edge = HAL_GPIO_EDGE_FALLING, .pull = HAL_GPIO_PULL_UP,
+ *       .debounce_ms = 20, .event_type = EVENT_BUTTON_PRESSED,
+ *   };
+ *   hal_gpio_exti_register(&button);
+ */
+
+#define HAL_GPIO_EXTI_LINES         16
+#define HAL_GPIO_EXTI_IRQ_PRIORITY  5       // At the RTOS syscall limit: handlers may use _from_isr calls
+
+typedef enum {
+    HAL_GPIO_EDGE_RISING = 1,
+    HAL_GPIO_EDGE_FALLING = 2,
+    HAL_GPIO_EDGE_BOTH = 3
+} hal_gpio_edge_t;
+
+typedef enum {
+    HAL_GPIO_PULL_NONE = 0,
+    HAL_GPIO_PULL_UP,
+    HAL_GPIO_PULL_DOWN
+} hal_gpio_pull_t;
+
+typedef struct {
+    hal_gpio_port_t port;
+    hal_gpio_pin_t pin;                 /**< Single pin mask; its number is the EXTI line */
+    hal_gpio_edge_t edge;               /**< Edges reported */
+    hal_gpio_pull_t pull;
+    uint16_t debounce_ms;               /**< Quiet time before an edge counts, 0 = none */
+    hal_gpio_irq_callback_t callback;   /**< ISR context (EXTI or HAL tick), may be NULL */
+    void *user_data;
+    uint16_t event_type;                /**< event_type_t published per edge, 0 = none */
+} hal_gpio_exti_config_t;
+
+/**
+ * @brief Payload of a published EXTI event
+ */
+typedef struct {
+    hal_gpio_pin_t pin;
+    uint8_t level;                      /**< hal_gpio_pin_state_t after the edge */
+} hal_gpio_exti_event_t;
+
+/**
+ * @brief Configure a pin as an interrupt input and route its line
+ *
+ * Sets the pin's mode, pull and edges, enables its EXTI IRQ at
+ * HAL_GPIO_EXTI_IRQ_PRIORITY and takes over the line's table slot
+ * (replacing hal_gpio_register_irq_callback() for that line).
+ *
+ * @param config Line setup (copied)
+ * @return false for a bad pin, port or edge
+ */
+bool hal_gpio_exti_register(const hal_gpio_exti_config_t *config);
+
+/**
+ * @brief Stop a line's interrupts and clear its slot
+ *
+ * The pin stays an input; the shared IRQ stays enabled for its other lines.
+ */
+void hal_gpio_exti_unregister(hal_gpio_pin_t pin);
+
+/**
+ * @brief Dispatch the pending lines among 'lines' (EXTIx_IRQHandler)
+ * @param lines Mask of the lines the vector serves
+ */
+void hal_gpio_exti_irq_handler(uint16_t lines);
+
+/**
+ * @brief Advance debouncing (1 ms HAL tick interrupt)
+ */
+void hal_gpio_exti_tick(void);
+
+/**
+ * @brief Whether a line waits for its level to settle
+ *
+ * Sleep suspends the HAL tick that ends the wait, so idle stays awake.
+ */
+bool hal_gpio_exti_debouncing(void);
+
 #endif // HAL_GPIO_H
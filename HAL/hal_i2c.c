@@ -1,18 +1,94 @@
 #include "hal_i2c.h"
+#include "hal_delay.h"
+#include "hal_power.h"
+#include "hal_timer.h"
 
 // STM32-specific implementation
 #include "stm32f7xx_hal.h"
 #include "stm32f7xx_hal_i2c.h"
 
-/**
- * @brief Transmit data over I2C
- */
-hal_i2c_status_t hal_i2c_master_transmit(hal_i2c_handle_t handle, uint16_t dev_address,
-                                          uint8_t* data, uint16_t size, uint32_t timeout_ms)
-{
-    HAL_StatusTypeDef status = HAL_I2C_Master_Transmit((I2C_HandleTypeDef*)handle, 
-                                                        dev_address, data, size, timeout_ms);
-    
+// Queued transaction (copied from the caller)
+typedef struct {
+    hal_i2c_transaction_t xfer;
+    volatile hal_i2c_status_t *result;  // Blocking waiter, NULL once it gave up
+    bool cancelled;                     // Waiter timed out before the start
+} i2c_queue_entry_t;
+
+// Per-bus scheduler: FIFO of transactions, head is the one in flight
+typedef struct {
+    I2C_HandleTypeDef *hi2c;
+    i2c_queue_entry_t queue[HAL_I2C_QUEUE_DEPTH];
+    uint8_t head;
+    uint8_t count;
+    bool in_flight;
+    // Deadline of the transfer in flight (hal_i2c_tick())
+    uint32_t xfer_start_us;
+    uint32_t xfer_budget_us;
+    uint32_t bit_ns;                        // SCL period at the current timing
+    hal_i2c_stats_t stats;
+    // Speed profiles
+    hal_i2c_speed_t speed;
+    uint32_t default_timing;                // Board init TIMINGR
+    uint32_t timing_clock_hz;               // Kernel clock the cache is for
+    uint32_t timing_cache[HAL_I2C_SPEED_COUNT];
+    uint32_t timing_epoch;                  // clock_epoch TIMINGR was written for
+} i2c_bus_t;
+
+// I2C bus timing requirements per profile (I2C specification, UM10204)
+typedef struct {
+    uint32_t scl_hz;
+    uint16_t low_min_ns;        // tLOW
+    uint16_t high_min_ns;       // tHIGH
+    uint16_t su_dat_min_ns;     // tSU;DAT
+    uint16_t rise_ns;           // tr (max)
+    uint16_t fall_ns;           // tf (max)
+} i2c_speed_spec_t;
+
+static const i2c_speed_spec_t speed_specs[HAL_I2C_SPEED_COUNT] = {
+    [HAL_I2C_SPEED_STANDARD]  = { 100000, 4700, 4000, 250, 1000, 300 },
+    [HAL_I2C_SPEED_FAST]      = { 400000, 1300,  600, 100,  300, 300 },
+    [HAL_I2C_SPEED_FAST_PLUS] = { 1000000, 500,  260,  50,  120, 120 },
+};
+
+#define I2C_ANALOG_FILTER_MIN_NS    50  // tAF(min), analog filter enabled
+
+// Transfer deadline: twice the bits on the wire, plus interrupt latency
+#define I2C_DEADLINE_MARGIN         2
+#define I2C_DEADLINE_SLACK_US       500
+
+// Bus clear (UM10204 3.1.16), bit-banged at 100 kHz
+#define I2C_CLEAR_CLOCKS            9
+#define I2C_CLEAR_HALF_PERIOD_US    5
+#define I2C_CLEAR_STRETCH_US        100     // Longest a slave may hold SCL low per clock
+
+#define I2C_BUS_ERRORS  (HAL_I2C_ERROR_BERR | HAL_I2C_ERROR_ARLO | HAL_I2C_ERROR_OVR)
+
+// Bus pins, as HAL_I2C_MspInit() configures them
+typedef struct {
+    I2C_TypeDef *instance;
+    GPIO_TypeDef *scl_port;
+    uint16_t scl_pin;
+    GPIO_TypeDef *sda_port;
+    uint16_t sda_pin;
+    uint8_t alternate;
+} i2c_pins_t;
+
+static const i2c_pins_t bus_pins[] = {
+    { I2C2, GPIOF, GPIO_PIN_1,  GPIOF, GPIO_PIN_0,  GPIO_AF4_I2C2 },
+    { I2C4, GPIOF, GPIO_PIN_14, GPIOD, GPIO_PIN_13, GPIO_AF4_I2C4 },
+};
+
+static i2c_bus_t buses[HAL_I2C_MAX_BUSES];
+
+// Kernel clock changes (hal_i2c_clock_changed()); buses catch up before
+// their next transfer, including those not claimed yet
+static volatile uint32_t clock_epoch = 0;
+static uint32_t board_clock_hz = 0;         // Kernel clock of the board init timings
+
+static void retime(i2c_bus_t *bus);
+static uint32_t timing_bit_ns(uint32_t timing);
+
+static hal_i2c_status_t convert_status(HAL_StatusTypeDef status) {
     switch (status) {
         case HAL_OK:      return HAL_I2C_OK;
         case HAL_BUSY:    return HAL_I2C_BUSY;
@@ -21,21 +97,322 @@ hal_i2c_status_t hal_i2c_master_transmit(hal_i2c_handle_t handle, uint16_t dev_a
     }
 }
 
+// Call with interrupts disabled when claiming
+static i2c_bus_t *bus_for(I2C_HandleTypeDef *hi2c, bool claim) {
+    i2c_bus_t *free_bus = NULL;
+    for (int i = 0; i < HAL_I2C_MAX_BUSES; i++) {
+        if (buses[i].hi2c == hi2c) {
+            return &buses[i];
+        }
+        if (buses[i].hi2c == NULL && free_bus == NULL) {
+            free_bus = &buses[i];
+        }
+    }
+    if (claim && free_bus != NULL) {
+        free_bus->hi2c = hi2c;
+        free_bus->speed = HAL_I2C_SPEED_DEFAULT;
+        free_bus->default_timing = hi2c->Init.Timing;
+        free_bus->timing_epoch = 0;
+        free_bus->bit_ns = timing_bit_ns(hi2c->Init.Timing);
+        return free_bus;
+    }
+    return NULL;
+}
+
+static HAL_StatusTypeDef start_transfer(I2C_HandleTypeDef *hi2c, const hal_i2c_transaction_t *xfer) {
+    switch (xfer->type) {
+        case HAL_I2C_XFER_TRANSMIT:
+            return HAL_I2C_Master_Transmit_IT(hi2c, xfer->dev_address, xfer->data, xfer->size);
+        case HAL_I2C_XFER_RECEIVE:
+            return HAL_I2C_Master_Receive_IT(hi2c, xfer->dev_address, xfer->data, xfer->size);
+        case HAL_I2C_XFER_MEM_WRITE:
+            return HAL_I2C_Mem_Write_IT(hi2c, xfer->dev_address, xfer->mem_address,
+                                        I2C_MEMADD_SIZE_8BIT, xfer->data, xfer->size);
+        case HAL_I2C_XFER_MEM_READ:
+            return HAL_I2C_Mem_Read_IT(hi2c, xfer->dev_address, xfer->mem_address,
+                                       I2C_MEMADD_SIZE_8BIT, xfer->data, xfer->size);
+        default:
+            return HAL_ERROR;
+    }
+}
+
+// Time the transfer may take on the wire at the bus's current timing
+static uint32_t transfer_budget_us(const i2c_bus_t *bus, const hal_i2c_transaction_t *xfer) {
+    // Address byte, then the register byte and the repeated START's address
+    uint32_t bytes = 1U + xfer->size;
+    if (xfer->type == HAL_I2C_XFER_MEM_WRITE || xfer->type == HAL_I2C_XFER_MEM_READ) {
+        bytes += 2U;
+    }
+    uint32_t bits = bytes * 9U + 2U;    // ACK per byte, START and STOP
+    return (uint32_t)(((uint64_t)bits * bus->bit_ns * I2C_DEADLINE_MARGIN) / 1000U) +
+           I2C_DEADLINE_SLACK_US;
+}
+
+static void wait_us(uint32_t us) {
+    uint32_t start = hal_timer_get_us();
+    while ((hal_timer_get_us() - start) <= us) {
+    }
+}
+
+static bool pin_high(GPIO_TypeDef *port, uint16_t pin) {
+    return HAL_GPIO_ReadPin(port, pin) == GPIO_PIN_SET;
+}
+
+// Release SCL and wait for a stretching slave to let go of it
+static void scl_release(const i2c_pins_t *pins) {
+    HAL_GPIO_WritePin(pins->scl_port, pins->scl_pin, GPIO_PIN_SET);
+    uint32_t start = hal_timer_get_us();
+    while (!pin_high(pins->scl_port, pins->scl_pin) &&
+           (hal_timer_get_us() - start) < I2C_CLEAR_STRETCH_US) {
+    }
+    wait_us(I2C_CLEAR_HALF_PERIOD_US);
+}
+
+/**
+ * Clock a slave out of the byte it is stuck in, then send a STOP.
+ * @return true if both lines are released afterwards
+ */
+static bool bus_clear(const i2c_pins_t *pins) {
+    GPIO_InitTypeDef gpio = {0};
+    
+    // Outputs released before the pins leave the peripheral: no glitch
+    HAL_GPIO_WritePin(pins->scl_port, pins->scl_pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(pins->sda_port, pins->sda_pin, GPIO_PIN_SET);
+    gpio.Mode = GPIO_MODE_OUTPUT_OD;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_LOW;
+    gpio.Pin = pins->scl_pin;
+    HAL_GPIO_Init(pins->scl_port, &gpio);
+    gpio.Pin = pins->sda_pin;
+    HAL_GPIO_Init(pins->sda_port, &gpio);
+    
+    for (int i = 0; i < I2C_CLEAR_CLOCKS && !pin_high(pins->sda_port, pins->sda_pin); i++) {
+        HAL_GPIO_WritePin(pins->scl_port, pins->scl_pin, GPIO_PIN_RESET);
+        wait_us(I2C_CLEAR_HALF_PERIOD_US);
+        scl_release(pins);
+    }
+    
+    // STOP: SDA rises while SCL is high
+    HAL_GPIO_WritePin(pins->scl_port, pins->scl_pin, GPIO_PIN_RESET);
+    wait_us(I2C_CLEAR_HALF_PERIOD_US);
+    HAL_GPIO_WritePin(pins->sda_port, pins->sda_pin, GPIO_PIN_RESET);
+    wait_us(I2C_CLEAR_HALF_PERIOD_US);
+    scl_release(pins);
+    HAL_GPIO_WritePin(pins->sda_port, pins->sda_pin, GPIO_PIN_SET);
+    wait_us(I2C_CLEAR_HALF_PERIOD_US);
+    
+    bool released = pin_high(pins->sda_port, pins->sda_pin) &&
+                    pin_high(pins->scl_port, pins->scl_pin);
+    
+    gpio.Mode = GPIO_MODE_AF_OD;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = pins->alternate;
+    gpio.Pin = pins->scl_pin;
+    HAL_GPIO_Init(pins->scl_port, &gpio);
+    gpio.Pin = pins->sda_pin;
+    HAL_GPIO_Init(pins->sda_port, &gpio);
+    
+    return released;
+}
+
+/**
+ * Reset the peripheral and clear the bus after a stall or bus error
+ * (ISR context or interrupts disabled; about 100 us).
+ */
+static void bus_recover(i2c_bus_t *bus) {
+    I2C_HandleTypeDef *hi2c = bus->hi2c;
+    
+    // PE=0 is the peripheral's software reset: it lets go of both lines.
+    // The configuration registers keep their values.
+    __HAL_I2C_DISABLE(hi2c);
+    CLEAR_BIT(hi2c->Instance->CR1, I2C_CR1_TXIE | I2C_CR1_RXIE | I2C_CR1_ADDRIE | I2C_CR1_NACKIE |
+                                   I2C_CR1_STOPIE | I2C_CR1_TCIE | I2C_CR1_ERRIE);
+    
+    bus->stats.recoveries++;
+    const i2c_pins_t *pins = NULL;
+    for (uint32_t i = 0; i < sizeof(bus_pins) / sizeof(bus_pins[0]); i++) {
+        if (bus_pins[i].instance == hi2c->Instance) {
+            pins = &bus_pins[i];
+        }
+    }
+    if (pins == NULL || !bus_clear(pins)) {
+        bus->stats.recovery_failures++;
+    }
+    
+    hi2c->State = HAL_I2C_STATE_READY;
+    hi2c->PreviousState = 0;
+    hi2c->Mode = HAL_I2C_MODE_NONE;
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    hi2c->XferISR = NULL;
+    __HAL_UNLOCK(hi2c);
+    __HAL_I2C_ENABLE(hi2c);
+}
+
+static void notify(i2c_bus_t *bus, const i2c_queue_entry_t *entry, hal_i2c_status_t status) {
+    if (entry->result != NULL) {
+        *entry->result = status;
+    }
+    if (entry->xfer.callback != NULL) {
+        entry->xfer.callback((hal_i2c_handle_t)bus->hi2c, status, entry->xfer.user_data);
+    }
+}
+
+// Start the next queued transaction (ISR context or interrupts disabled)
+static void start_next(i2c_bus_t *bus) {
+    if (bus->count > 0 && !bus->in_flight && bus->timing_epoch != clock_epoch) {
+        retime(bus);
+    }
+    while (bus->count > 0 && !bus->in_flight) {
+        i2c_queue_entry_t *entry = &bus->queue[bus->head];
+        
+        if (!entry->cancelled) {
+            HAL_StatusTypeDef status = start_transfer(bus->hi2c, &entry->xfer);
+            if (status == HAL_BUSY && __HAL_I2C_GET_FLAG(bus->hi2c, I2C_FLAG_BUSY)) {
+                // A slave holds SDA low since an earlier transfer: clear and retry once
+                bus_recover(bus);
+                status = start_transfer(bus->hi2c, &entry->xfer);
+            }
+            if (status == HAL_OK) {
+                bus->in_flight = true;
+                bus->xfer_start_us = hal_timer_get_us();
+                bus->xfer_budget_us = transfer_budget_us(bus, &entry->xfer);
+                hal_power_stop_lock();  // STOP would freeze the transfer
+                return;
+            }
+            bus->stats.bus_errors++;
+        }
+        
+        // Cancelled or failed to start: retire it and try the next one
+        i2c_queue_entry_t failed = *entry;
+        bus->head = (bus->head + 1) % HAL_I2C_QUEUE_DEPTH;
+        bus->count--;
+        if (!failed.cancelled) {
+            notify(bus, &failed, HAL_I2C_ERROR);
+        }
+    }
+}
+
+static void transfer_complete(I2C_HandleTypeDef *hi2c, hal_i2c_status_t status) {
+    i2c_bus_t *bus = bus_for(hi2c, false);
+    if (bus == NULL || !bus->in_flight) {
+        return;
+    }
+    
+    if (status == HAL_I2C_OK) {
+        uint32_t elapsed_us = hal_timer_get_us() - bus->xfer_start_us;
+        bus->stats.transfers++;
+        if (elapsed_us > bus->stats.max_transfer_us) {
+            bus->stats.max_transfer_us = elapsed_us;
+        }
+    } else if (status == HAL_I2C_ERROR) {
+        // The HAL has ended the transfer; a bus error may leave a slave mid-byte
+        uint32_t error = hi2c->ErrorCode;
+        if ((error & HAL_I2C_ERROR_AF) != 0) {
+            bus->stats.nacks++;
+        }
+        if ((error & I2C_BUS_ERRORS) != 0) {
+            bus->stats.bus_errors++;
+            bus_recover(bus);
+        }
+    }
+    
+    // Retire before notifying so the callback can chain the next transfer
+    i2c_queue_entry_t done = bus->queue[bus->head];
+    bus->head = (bus->head + 1) % HAL_I2C_QUEUE_DEPTH;
+    bus->count--;
+    bus->in_flight = false;
+    hal_power_stop_unlock();
+    
+    notify(bus, &done, status);
+    start_next(bus);
+}
+
+static hal_i2c_status_t enqueue(I2C_HandleTypeDef *hi2c, const hal_i2c_transaction_t *xfer,
+                                volatile hal_i2c_status_t *result, i2c_queue_entry_t **queued) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    
+    i2c_bus_t *bus = bus_for(hi2c, true);
+    if (bus == NULL || bus->count >= HAL_I2C_QUEUE_DEPTH) {
+        __set_PRIMASK(primask);
+        return (bus == NULL) ? HAL_I2C_ERROR : HAL_I2C_BUSY;
+    }
+    
+    i2c_queue_entry_t *entry = &bus->queue[(bus->head + bus->count) % HAL_I2C_QUEUE_DEPTH];
+    entry->xfer = *xfer;
+    entry->result = result;
+    entry->cancelled = false;
+    bus->count++;
+    if (queued != NULL) {
+        *queued = entry;
+    }
+    
+    start_next(bus);
+    
+    __set_PRIMASK(primask);
+    return HAL_I2C_OK;
+}
+
+// Queue a transaction and wait for it (not from ISR context)
+static hal_i2c_status_t transfer_blocking(hal_i2c_handle_t handle, const hal_i2c_transaction_t *xfer,
+                                          uint32_t timeout_ms) {
+    I2C_HandleTypeDef *hi2c = (I2C_HandleTypeDef*)handle;
+    volatile hal_i2c_status_t result = HAL_I2C_BUSY;
+    i2c_queue_entry_t *entry = NULL;
+    
+    hal_i2c_status_t status = enqueue(hi2c, xfer, &result, &entry);
+    if (status != HAL_I2C_OK) {
+        return status;
+    }
+    
+    uint32_t start = hal_get_tick();
+    while (result == HAL_I2C_BUSY) {
+        if ((hal_get_tick() - start) >= timeout_ms) {
+            break;
+        }
+    }
+    
+    // Give up: detach from the entry so it never writes our stack again
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (result == HAL_I2C_BUSY && entry->result == &result) {
+        i2c_bus_t *bus = bus_for(hi2c, false);
+        entry->result = NULL;
+        if (bus->in_flight && entry == &bus->queue[bus->head]) {
+            // Completes through HAL_I2C_AbortCpltCallback
+            HAL_I2C_Master_Abort_IT(hi2c, xfer->dev_address);
+        } else {
+            entry->cancelled = true;
+        }
+        result = HAL_I2C_TIMEOUT;
+    }
+    __set_PRIMASK(primask);
+    
+    return result;
+}
+
+/**
+ * @brief Transmit data over I2C
+ */
+hal_i2c_status_t hal_i2c_master_transmit(hal_i2c_handle_t handle, uint16_t dev_address,
+                                          uint8_t* data, uint16_t size, uint32_t timeout_ms)
+{
+    hal_i2c_transaction_t xfer = {
+        .type = HAL_I2C_XFER_TRANSMIT, .dev_address = dev_address, .data = data, .size = size
+    };
+    return transfer_blocking(handle, &xfer, timeout_ms);
+}
+
 /**
  * @brief Receive data over I2C
  */
 hal_i2c_status_t hal_i2c_master_receive(hal_i2c_handle_t handle, uint16_t dev_address,
                                          uint8_t* data, uint16_t size, uint32_t timeout_ms)
 {
-    HAL_StatusTypeDef status = HAL_I2C_Master_Receive((I2C_HandleTypeDef*)handle,
-                                                       dev_address, data, size, timeout_ms);
-    
-    switch (status) {
-        case HAL_OK:      return HAL_I2C_OK;
-        case HAL_BUSY:    return HAL_I2C_BUSY;
-        case HAL_TIMEOUT: return HAL_I2C_TIMEOUT;
-        default:          return HAL_I2C_ERROR;
-    }
+    hal_i2c_transaction_t xfer = {
+        .type = HAL_I2C_XFER_RECEIVE, .dev_address = dev_address, .data = data, .size = size
+    };
+    return transfer_blocking(handle, &xfer, timeout_ms);
 }
 
 /**
@@ -44,15 +421,11 @@ hal_i2c_status_t hal_i2c_master_receive(hal_i2c_handle_t handle, uint16_t dev_ad
 hal_i2c_status_t hal_i2c_mem_write(hal_i2c_handle_t handle, uint16_t dev_address,
                                     uint16_t mem_address, uint8_t* data, uint16_t size, uint32_t timeout_ms)
 {
-    HAL_StatusTypeDef status = HAL_I2C_Mem_Write((I2C_HandleTypeDef*)handle, dev_address,
-                                                  mem_address, I2C_MEMADD_SIZE_8BIT, data, size, timeout_ms);
-    
-    switch (status) {
-        case HAL_OK:      return HAL_I2C_OK;
-        case HAL_BUSY:    return HAL_I2C_BUSY;
-        case HAL_TIMEOUT: return HAL_I2C_TIMEOUT;
-        default:          return HAL_I2C_ERROR;
-    }
+    hal_i2c_transaction_t xfer = {
+        .type = HAL_I2C_XFER_MEM_WRITE, .dev_address = dev_address, .mem_address = mem_address,
+        .data = data, .size = size
+    };
+    return transfer_blocking(handle, &xfer, timeout_ms);
 }
 
 /**
@@ -61,13 +434,325 @@ hal_i2c_status_t hal_i2c_mem_write(hal_i2c_handle_t handle, uint16_t dev_address
 hal_i2c_status_t hal_i2c_mem_read(hal_i2c_handle_t handle, uint16_t dev_address,
                                    uint16_t mem_address, uint8_t* data, uint16_t size, uint32_t timeout_ms)
 {
-    HAL_StatusTypeDef status = HAL_I2C_Mem_Read((I2C_HandleTypeDef*)handle, dev_address,
-                                                 mem_address, I2C_MEMADD_SIZE_8BIT, data, size, timeout_ms);
+    hal_i2c_transaction_t xfer = {
+        .type = HAL_I2C_XFER_MEM_READ, .dev_address = dev_address, .mem_address = mem_address,
+        .data = data, .size = size
+    };
+    return transfer_blocking(handle, &xfer, timeout_ms);
+}
+
+/**
+ * @brief Queue a transaction on a bus (non-blocking)
+ */
+hal_i2c_status_t hal_i2c_submit(hal_i2c_handle_t handle, const hal_i2c_transaction_t *xfer)
+{
+    if (xfer == NULL) {
+        return HAL_I2C_ERROR;
+    }
+    return enqueue((I2C_HandleTypeDef*)handle, xfer, NULL, NULL);
+}
+
+/**
+ * @brief Read from I2C device memory/register (interrupt-driven)
+ */
+hal_i2c_status_t hal_i2c_mem_read_async(hal_i2c_handle_t handle, uint16_t dev_address,
+                                         uint16_t mem_address, uint8_t* data, uint16_t size,
+                                         hal_i2c_callback_t callback, void *user_data)
+{
+    hal_i2c_transaction_t xfer = {
+        .type = HAL_I2C_XFER_MEM_READ, .dev_address = dev_address, .mem_address = mem_address,
+        .data = data, .size = size, .callback = callback, .user_data = user_data
+    };
+    return hal_i2c_submit(handle, &xfer);
+}
+
+/**
+ * @brief Number of transactions queued or in flight on a bus
+ */
+uint32_t hal_i2c_pending(hal_i2c_handle_t handle)
+{
+    i2c_bus_t *bus = bus_for((I2C_HandleTypeDef*)handle, false);
+    return (bus != NULL) ? bus->count : 0;
+}
+
+/**
+ * @brief End transfers that overran their deadline (1 ms tick interrupt)
+ */
+void hal_i2c_tick(void)
+{
+    for (int i = 0; i < HAL_I2C_MAX_BUSES; i++) {
+        i2c_bus_t *bus = &buses[i];
+        if (!bus->in_flight) {
+            continue;
+        }
+        
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        if (bus->in_flight && (hal_timer_get_us() - bus->xfer_start_us) > bus->xfer_budget_us) {
+            // Stretched forever, or lost arbitration to a stuck line
+            bus->stats.timeouts++;
+            bus_recover(bus);
+            transfer_complete(bus->hi2c, HAL_I2C_TIMEOUT);
+        }
+        __set_PRIMASK(primask);
+    }
+}
+
+/**
+ * @brief Get the error statistics of a bus
+ */
+void hal_i2c_get_stats(hal_i2c_handle_t handle, hal_i2c_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
     
-    switch (status) {
-        case HAL_OK:      return HAL_I2C_OK;
-        case HAL_BUSY:    return HAL_I2C_BUSY;
-        case HAL_TIMEOUT: return HAL_I2C_TIMEOUT;
-        default:          return HAL_I2C_ERROR;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    i2c_bus_t *bus = bus_for((I2C_HandleTypeDef*)handle, false);
+    if (bus != NULL) {
+        *stats = bus->stats;
+    } else {
+        *stats = (hal_i2c_stats_t){0};
+    }
+    __set_PRIMASK(primask);
+}
+
+// ========== Speed Profiles ==========
+
+static uint32_t div_ceil(uint64_t num, uint64_t den) {
+    return (uint32_t)((num + den - 1) / den);
+}
+
+// SCL period of a TIMINGR value, ns (edges and synchronization not counted)
+static uint32_t timing_bit_ns(uint32_t timing) {
+    // All I2C kernel clocks are PCLK1 on this board (see I2Cx_MspInit)
+    uint32_t clock_hz = HAL_RCC_GetPCLK1Freq();
+    uint32_t presc = (timing >> 28) + 1U;
+    uint32_t clocks = ((timing >> 8) & 0xFFU) + (timing & 0xFFU) + 2U;
+    return (clock_hz != 0) ? (uint32_t)((uint64_t)presc * clocks * 1000000000ULL / clock_hz)
+                           : 10000U;
+}
+
+// TIMINGR for a profile (RM0410 I2C timings), 0 if the clock cannot reach it
+static uint32_t compute_timing(uint32_t clock_hz, const i2c_speed_spec_t *spec) {
+    const uint64_t ps_per_s = 1000000000000ULL;
+    uint32_t clock_ps = (uint32_t)(ps_per_s / clock_hz);
+    uint32_t period_ps = (uint32_t)(ps_per_s / spec->scl_hz);
+    
+    // Per SCL phase the peripheral adds the edge, the analog filter
+    // delay and ~3 kernel clocks of synchronization
+    uint32_t sync_ps = ((uint32_t)spec->rise_ns + spec->fall_ns +
+                        2 * I2C_ANALOG_FILTER_MIN_NS) * 1000 + 6 * clock_ps;
+    if (sync_ps >= period_ps) {
+        return 0;
+    }
+    
+    // Smallest prescaler that fits gives the finest resolution
+    for (uint32_t presc = 0; presc < 16; presc++) {
+        uint32_t tick_ps = (presc + 1) * clock_ps;
+        
+        uint32_t low = div_ceil((uint64_t)spec->low_min_ns * 1000, tick_ps);
+        uint32_t high = div_ceil((uint64_t)spec->high_min_ns * 1000, tick_ps);
+        uint32_t total = div_ceil(period_ps - sync_ps, tick_ps);
+        if (total > low + high) {
+            uint32_t extra = total - low - high;
+            low += (extra + 1) / 2;
+            high += extra / 2;
+        }
+        
+        uint32_t scldel = div_ceil(((uint64_t)spec->rise_ns + spec->su_dat_min_ns) * 1000, tick_ps);
+        int32_t sdadel_ps = (int32_t)spec->fall_ns * 1000 -
+                            I2C_ANALOG_FILTER_MIN_NS * 1000 - 3 * (int32_t)clock_ps;
+        uint32_t sdadel = (sdadel_ps > 0) ? div_ceil((uint64_t)sdadel_ps, tick_ps) : 0;
+        
+        if (low > 256 || high > 256 || scldel > 16 || sdadel > 15) {
+            continue;
+        }
+        if (scldel == 0) {
+            scldel = 1;
+        }
+        
+        return (presc << 28) | ((scldel - 1) << 20) | (sdadel << 16) |
+               ((high - 1) << 8) | (low - 1);
+    }
+    
+    return 0;
+}
+
+static uint32_t fast_mode_plus_flag(I2C_HandleTypeDef *hi2c) {
+    if (hi2c->Instance == I2C1) {
+        return I2C_FASTMODEPLUS_I2C1;
+    }
+    if (hi2c->Instance == I2C2) {
+        return I2C_FASTMODEPLUS_I2C2;
+    }
+    if (hi2c->Instance == I2C3) {
+        return I2C_FASTMODEPLUS_I2C3;
+    }
+    return I2C_FASTMODEPLUS_I2C4;
+}
+
+// Fill the timing cache for the current kernel clock (interrupts disabled)
+static void refresh_timing_cache(i2c_bus_t *bus) {
+    // All I2C kernel clocks are PCLK1 on this board (see I2Cx_MspInit)
+    uint32_t clock_hz = HAL_RCC_GetPCLK1Freq();
+    if (clock_hz == bus->timing_clock_hz) {
+        return;
+    }
+    
+    bus->timing_clock_hz = clock_hz;
+    for (int i = HAL_I2C_SPEED_STANDARD; i < HAL_I2C_SPEED_COUNT; i++) {
+        bus->timing_cache[i] = compute_timing(clock_hz, &speed_specs[i]);
+    }
+    // The board timing only holds at the clock it was generated for
+    bool board_clock = (board_clock_hz == 0 || clock_hz == board_clock_hz);
+    bus->timing_cache[HAL_I2C_SPEED_DEFAULT] =
+        board_clock ? bus->default_timing : bus->timing_cache[HAL_I2C_SPEED_STANDARD];
+}
+
+// Program a timing with the peripheral disabled (interrupts disabled, bus idle)
+static void write_timing(i2c_bus_t *bus, hal_i2c_speed_t speed, uint32_t timing) {
+    I2C_HandleTypeDef *hi2c = bus->hi2c;
+    
+    // TIMINGR can only be written while the peripheral is disabled
+    __HAL_I2C_DISABLE(hi2c);
+    hi2c->Instance->TIMINGR = timing;
+    hi2c->Init.Timing = timing;
+    if (speed == HAL_I2C_SPEED_FAST_PLUS) {
+        HAL_I2CEx_EnableFastModePlus(fast_mode_plus_flag(hi2c));
+    } else {
+        HAL_I2CEx_DisableFastModePlus(fast_mode_plus_flag(hi2c));
     }
+    __HAL_I2C_ENABLE(hi2c);
+    bus->speed = speed;
+    bus->timing_epoch = clock_epoch;
+    bus->bit_ns = timing_bit_ns(timing);
+}
+
+// The bus profile at the current kernel clock (interrupts disabled, bus idle)
+static void retime(i2c_bus_t *bus) {
+    refresh_timing_cache(bus);
+    
+    // A profile the new clock cannot reach falls back to standard mode
+    hal_i2c_speed_t speed = bus->speed;
+    if (bus->timing_cache[speed] == 0) {
+        speed = HAL_I2C_SPEED_STANDARD;
+    }
+    write_timing(bus, speed, bus->timing_cache[speed]);
+}
+
+/**
+ * @brief Switch a bus to a speed profile
+ */
+hal_i2c_status_t hal_i2c_set_speed(hal_i2c_handle_t handle, hal_i2c_speed_t speed)
+{
+    I2C_HandleTypeDef *hi2c = (I2C_HandleTypeDef*)handle;
+    if (speed >= HAL_I2C_SPEED_COUNT) {
+        return HAL_I2C_ERROR;
+    }
+    
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    
+    i2c_bus_t *bus = bus_for(hi2c, true);
+    if (bus == NULL) {
+        __set_PRIMASK(primask);
+        return HAL_I2C_ERROR;
+    }
+    if (bus->count > 0) {
+        __set_PRIMASK(primask);
+        return HAL_I2C_BUSY;
+    }
+    if (bus->speed == speed && bus->timing_epoch == clock_epoch) {
+        __set_PRIMASK(primask);
+        return HAL_I2C_OK;
+    }
+    
+    refresh_timing_cache(bus);
+    uint32_t timing = bus->timing_cache[speed];
+    if (timing == 0) {
+        __set_PRIMASK(primask);
+        return HAL_I2C_ERROR;
+    }
+    write_timing(bus, speed, timing);
+    
+    __set_PRIMASK(primask);
+    return HAL_I2C_OK;
+}
+
+/**
+ * @brief Speed profile a bus currently runs at
+ */
+hal_i2c_speed_t hal_i2c_get_speed(hal_i2c_handle_t handle)
+{
+    i2c_bus_t *bus = bus_for((I2C_HandleTypeDef*)handle, false);
+    return (bus != NULL) ? bus->speed : HAL_I2C_SPEED_DEFAULT;
+}
+
+/**
+ * @brief Check that no bus has a transaction queued or in flight
+ */
+bool hal_i2c_is_idle(void)
+{
+    for (int i = 0; i < HAL_I2C_MAX_BUSES; i++) {
+        if (buses[i].hi2c != NULL && buses[i].count > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Re-derive the bus timings after a kernel clock change
+ */
+void hal_i2c_clock_changed(uint32_t previous_clock_hz)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    
+    if (board_clock_hz == 0) {
+        board_clock_hz = previous_clock_hz;
+    }
+    clock_epoch++;
+    for (int i = 0; i < HAL_I2C_MAX_BUSES; i++) {
+        i2c_bus_t *bus = &buses[i];
+        if (bus->hi2c != NULL && !bus->in_flight) {
+            retime(bus);
+        }
+    }
+    
+    __set_PRIMASK(primask);
+}
+
+// ========== STM32 HAL Callbacks (ISR context) ==========
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    transfer_complete(hi2c, HAL_I2C_OK);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    transfer_complete(hi2c, HAL_I2C_OK);
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    transfer_complete(hi2c, HAL_I2C_OK);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    transfer_complete(hi2c, HAL_I2C_OK);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    transfer_complete(hi2c, HAL_I2C_ERROR);
+}
+
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    transfer_complete(hi2c, HAL_I2C_ERROR);
 }
@@ -6,6 +6,18 @@
  * @brief Platform-independent I2C abstraction layer
  * 
  * This HAL provides a consistent I2C API that can be ported to different platforms.
+ * 
+ * All transfers go through a per-bus transaction queue served from the
+ * I2C interrupts, so drivers sharing a bus never collide. The blocking
+ * functions below queue a transaction and wait for it.
+ *
+ * Every transfer has a deadline of twice its bits at the bus speed plus
+ * 500 us, checked by hal_i2c_tick(). One that overruns it (a slave
+ * stretching SCL forever), a bus error, or a bus a slave holds busy ends
+ * in a recovery: the peripheral is reset and SCL is clocked up to 9 times
+ * until the slave lets go of SDA, then a STOP is sent. The transfer fails
+ * and the queue moves on, so a faulty sensor costs its own transfer and
+ * about 100 us, not the next driver's timeout.
  */
 
 #include <stdint.h>
@@ -22,7 +34,58 @@ typedef enum {
     HAL_I2C_TIMEOUT
 } hal_i2c_status_t;
 
-// I2C Functions
+#define HAL_I2C_MAX_BUSES       2   // Buses with a transaction queue
+#define HAL_I2C_QUEUE_DEPTH     8   // Queued transactions per bus (including the one in flight)
+
+// Per-bus error statistics
+typedef struct {
+    uint32_t transfers;             // Completed
+    uint32_t nacks;                 // Address or data not acknowledged
+    uint32_t bus_errors;            // Misplaced START/STOP, arbitration lost, overrun, failed start
+    uint32_t timeouts;              // Transfers past their deadline
+    uint32_t recoveries;            // Bus clears run
+    uint32_t recovery_failures;     // A line still low after the bus clear
+    uint32_t max_transfer_us;       // Longest completed transfer, start to end
+} hal_i2c_stats_t;
+
+// Bus speed profiles (timing computed for the current I2C kernel clock)
+typedef enum {
+    HAL_I2C_SPEED_DEFAULT = 0,      // Timing the board init configured
+    HAL_I2C_SPEED_STANDARD,         // 100 kHz
+    HAL_I2C_SPEED_FAST,             // 400 kHz
+    HAL_I2C_SPEED_FAST_PLUS,        // 1 MHz (Fm+ drive enabled on the pins)
+    HAL_I2C_SPEED_COUNT
+} hal_i2c_speed_t;
+
+/**
+ * @brief Completion callback for asynchronous transfers (ISR context)
+ * @param handle I2C handle the transfer ran on
+ * @param status HAL_I2C_OK, HAL_I2C_ERROR on NACK/bus error/abort, or
+ *               HAL_I2C_TIMEOUT past the transfer's deadline
+ * @param user_data Context passed when the transfer was submitted
+ */
+typedef void (*hal_i2c_callback_t)(hal_i2c_handle_t handle, hal_i2c_status_t status, void *user_data);
+
+// Transaction types
+typedef enum {
+    HAL_I2C_XFER_TRANSMIT,      // Plain write
+    HAL_I2C_XFER_RECEIVE,       // Plain read
+    HAL_I2C_XFER_MEM_WRITE,     // Register write (8-bit register address)
+    HAL_I2C_XFER_MEM_READ       // Register read (8-bit register address)
+} hal_i2c_xfer_type_t;
+
+// One queued transaction
+typedef struct {
+    hal_i2c_xfer_type_t type;
+    uint16_t dev_address;
+    uint16_t mem_address;           // MEM_* transfers only
+    uint8_t *data;                  // Must stay valid until the callback
+    uint16_t size;
+    hal_i2c_callback_t callback;    // Can be NULL
+    void *user_data;
+} hal_i2c_transaction_t;
+
+// I2C Functions (blocking: queue the transaction and wait for it)
 hal_i2c_status_t hal_i2c_master_transmit(hal_i2c_handle_t handle, uint16_t dev_address, 
                                           uint8_t* data, uint16_t size, uint32_t timeout_ms);
 hal_i2c_status_t hal_i2c_master_receive(hal_i2c_handle_t handle, uint16_t dev_address,
@@ -32,4 +95,76 @@ hal_i2c_status_t hal_i2c_mem_write(hal_i2c_handle_t handle, uint16_t dev_address
 hal_i2c_status_t hal_i2c_mem_read(hal_i2c_handle_t handle, uint16_t dev_address,
                                    uint16_t mem_address, uint8_t* data, uint16_t size, uint32_t timeout_ms);
 
+/**
+ * @brief Queue a transaction on a bus (non-blocking)
+ * 
+ * The transaction is copied; it starts as soon as the transactions ahead
+ * of it on the same bus finish. The callback runs from the I2C interrupt
+ * and may submit the next transaction. Safe from task and ISR context.
+ * 
+ * @note Requires the I2Cx event and error interrupts to be enabled.
+ * @return HAL_I2C_OK if queued, HAL_I2C_BUSY if the queue is full
+ */
+hal_i2c_status_t hal_i2c_submit(hal_i2c_handle_t handle, const hal_i2c_transaction_t *xfer);
+
+/**
+ * @brief Read from I2C device memory/register (interrupt-driven, non-blocking)
+ * 
+ * Shorthand for hal_i2c_submit() with a HAL_I2C_XFER_MEM_READ transaction.
+ * 
+ * @note The data buffer must remain valid until the callback runs.
+ */
+hal_i2c_status_t hal_i2c_mem_read_async(hal_i2c_handle_t handle, uint16_t dev_address,
+                                         uint16_t mem_address, uint8_t* data, uint16_t size,
+                                         hal_i2c_callback_t callback, void *user_data);
+
+/**
+ * @brief Number of transactions queued or in flight on a bus
+ */
+uint32_t hal_i2c_pending(hal_i2c_handle_t handle);
+
+/**
+ * @brief End transfers that overran their deadline (1 ms tick interrupt)
+ */
+void hal_i2c_tick(void);
+
+/**
+ * @brief Get the error statistics of a bus (zeros for a bus not used yet)
+ */
+void hal_i2c_get_stats(hal_i2c_handle_t handle, hal_i2c_stats_t *stats);
+
+/**
+ * @brief Switch a bus to a speed profile
+ * 
+ * The timing register value is computed from the I2C kernel clock on
+ * first use and cached until that clock changes. Only possible while
+ * nothing is queued on the bus.
+ * 
+ * @return HAL_I2C_OK, HAL_I2C_BUSY if transfers are pending, or
+ *         HAL_I2C_ERROR if the clock cannot reach the profile
+ */
+hal_i2c_status_t hal_i2c_set_speed(hal_i2c_handle_t handle, hal_i2c_speed_t speed);
+
+/**
+ * @brief Speed profile a bus currently runs at
+ */
+hal_i2c_speed_t hal_i2c_get_speed(hal_i2c_handle_t handle);
+
+/**
+ * @brief Check that no bus has a transaction queued or in flight
+ */
+bool hal_i2c_is_idle(void);
+
+/**
+ * @brief Re-derive the bus timings after a kernel clock change (hal_clock)
+ *
+ * Each bus keeps its profile; one the new clock cannot reach falls back to
+ * standard mode, and HAL_I2C_SPEED_DEFAULT becomes standard mode away from
+ * the clock the board timings were generated for. Buses not used yet are
+ * retimed before their first transfer.
+ *
+ * @param previous_clock_hz Kernel clock before the change
+ */
+void hal_i2c_clock_changed(uint32_t previous_clock_hz);
+
 #endif // HAL_I2C_H
@@ -0,0 +1,119 @@
+#include "hal_mem.h"
+
+// STM32-specific implementation
+#include "stm32f7xx_hal.h"
+#include <string.h>
+
+// Linker script symbols (STM32F767XX_FLASH.ld)
+extern uint32_t _siitcm, _sitcm, _eitcm;
+extern uint32_t _sidtcm_data, _sdtcm_data, _edtcm_data;
+extern uint32_t _sdtcm_bss, _edtcm_bss;
+
+/**
+ * @brief Load ITCM code and DTCM data sections
+ * @note Call first thing in main(), before any HAL_ITCM_FUNC code runs or
+ *       any HAL_DTCM_* object is used
+ */
+void hal_mem_init_tcm(void)
+{
+    memcpy(&_sitcm, &_siitcm, (size_t)((uint8_t*)&_eitcm - (uint8_t*)&_sitcm));
+    memcpy(&_sdtcm_data, &_sidtcm_data, (size_t)((uint8_t*)&_edtcm_data - (uint8_t*)&_sdtcm_data));
+    memset(&_sdtcm_bss, 0, (size_t)((uint8_t*)&_edtcm_bss - (uint8_t*)&_sdtcm_bss));
+
+    __DSB();
+    __ISB();
+}
+
+/**
+ * @brief Map the .dma_buffer section as non-cacheable, shareable memory
+ * @note Call once after MPU_Config(), before any DMA transfer is started
+ */
+void hal_mem_init_dma_region(void)
+{
+    MPU_Region_InitTypeDef MPU_InitStruct = {0};
+
+    HAL_MPU_Disable();
+
+    // TEX=1, C=0, B=0: normal memory, non-cacheable
+    MPU_InitStruct.Enable = MPU_REGION_ENABLE;
+    MPU_InitStruct.Number = MPU_REGION_NUMBER1;
+    MPU_InitStruct.BaseAddress = HAL_DMA_REGION_BASE;
+    MPU_InitStruct.Size = MPU_REGION_SIZE_16KB;
+    MPU_InitStruct.SubRegionDisable = 0x00;
+    MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL1;
+    MPU_InitStruct.AccessPermission = MPU_REGION_FULL_ACCESS;
+    MPU_InitStruct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+    MPU_InitStruct.IsShareable = MPU_ACCESS_SHAREABLE;
+    MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+    MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+
+    HAL_MPU_ConfigRegion(&MPU_InitStruct);
+
+    HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+}
+
+/**
+ * @brief Enable I-cache and D-cache
+ * @note Call after hal_mem_init_dma_region() so DMA buffers are never cached
+ */
+void hal_mem_enable_caches(void)
+{
+    SCB_EnableICache();
+    SCB_EnableDCache();
+}
+
+/**
+ * @brief Clean and disable both caches (used for benchmarking)
+ */
+void hal_mem_disable_caches(void)
+{
+    SCB_DisableDCache();
+    SCB_DisableICache();
+}
+
+/**
+ * @brief Returns true if the range lies in the non-cacheable DMA region
+ */
+static int in_dma_region(const void* addr, size_t size)
+{
+    uintptr_t start = (uintptr_t)addr;
+    return start >= HAL_DMA_REGION_BASE &&
+           start + size <= HAL_DMA_REGION_BASE + HAL_DMA_REGION_SIZE;
+}
+
+/**
+ * @brief Write back D-cache lines covering a buffer DMA is about to read
+ * @param addr Buffer start
+ * @param size Buffer size in bytes
+ */
+void hal_cache_clean(const void* addr, size_t size)
+{
+    if (addr == NULL || size == 0 || in_dma_region(addr, size) ||
+        (SCB->CCR & SCB_CCR_DC_Msk) == 0) {
+        return;
+    }
+
+    uintptr_t start = (uintptr_t)addr & ~(uintptr_t)(HAL_CACHE_LINE_SIZE - 1);
+    uintptr_t end = (uintptr_t)addr + size;
+    SCB_CleanDCache_by_Addr((uint32_t*)start, (int32_t)(end - start));
+}
+
+/**
+ * @brief Discard D-cache lines covering a buffer DMA has written
+ * @param addr Buffer start (should be HAL_CACHE_LINE_SIZE aligned)
+ * @param size Buffer size in bytes (should be a multiple of HAL_CACHE_LINE_SIZE)
+ *
+ * @note Partial lines at either end are discarded too, so unaligned buffers
+ *       must not share a cache line with data the CPU has modified.
+ */
+void hal_cache_invalidate(void* addr, size_t size)
+{
+    if (addr == NULL || size == 0 || in_dma_region(addr, size) ||
+        (SCB->CCR & SCB_CCR_DC_Msk) == 0) {
+        return;
+    }
+
+    uintptr_t start = (uintptr_t)addr & ~(uintptr_t)(HAL_CACHE_LINE_SIZE - 1);
+    uintptr_t end = (uintptr_t)addr + size;
+    SCB_InvalidateDCache_by_Addr((uint32_t*)start, (int32_t)(end - start));
+}
@@ -0,0 +1,53 @@
+#ifndef HAL_MEM_H
+#define HAL_MEM_H
+
+/**
+ * @file hal_mem.h
+ * @brief Memory placement, caches and DMA buffer maintenance
+ *
+ * Buffers touched by DMA (UART, SPI, I2C) are placed in the .dma_buffer
+ * section (SRAM2, see STM32F767XX_FLASH.ld). hal_mem_init_dma_region()
+ * maps that section as non-cacheable through the MPU, so those buffers
+ * need no cache maintenance once the D-cache is enabled.
+ *
+ * Hot data and ISR code can be pinned into the zero-wait-state tightly
+ * coupled memories with HAL_DTCM_DATA / HAL_DTCM_BSS / HAL_ITCM_FUNC.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Non-cacheable DMA region (must match RAM_DMA in the linker script)
+#define HAL_DMA_REGION_BASE     0x2007C000UL
+#define HAL_DMA_REGION_SIZE     (16U * 1024U)
+
+// Cortex-M7 D-cache line size
+#define HAL_CACHE_LINE_SIZE     32U
+
+// Start a variable or struct member on a D-cache line of its own; in a
+// struct it also rounds the size up to whole lines
+#define HAL_CACHE_ALIGNED       __attribute__((aligned(HAL_CACHE_LINE_SIZE)))
+
+// Place a buffer in the non-cacheable DMA section
+#define HAL_DMA_BUFFER          __attribute__((section(".dma_buffer"), aligned(HAL_CACHE_LINE_SIZE)))
+
+// Place initialized data (e.g. lookup tables) in DTCM
+#define HAL_DTCM_DATA           __attribute__((section(".dtcm_data")))
+
+// Place zero-initialized data (e.g. queues) in DTCM
+#define HAL_DTCM_BSS            __attribute__((section(".dtcm_bss")))
+
+// Run a function from ITCM (ISR handlers, hot loops)
+#define HAL_ITCM_FUNC           __attribute__((section(".itcm_text"), noinline))
+
+// Memory Functions
+void hal_mem_init_tcm(void);
+void hal_mem_init_dma_region(void);
+void hal_mem_enable_caches(void);
+void hal_mem_disable_caches(void);
+
+// Cache maintenance for DMA buffers outside the DMA section
+void hal_cache_clean(const void* addr, size_t size);       // Before DMA reads memory (TX)
+void hal_cache_invalidate(void* addr, size_t size);        // After DMA wrote memory (RX)
+
+#endif // HAL_MEM_H
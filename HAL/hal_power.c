@@ -0,0 +1,184 @@
+#include "hal_power.h"
+#include "hal_rtc.h"
+#include "hal_timer.h"
+#include "hal_clock.h"
+#include "hal_gpio.h"
+
+// STM32-specific implementation
+#include "stm32f7xx_hal.h"
+
+#define HAL_POWER_RTC_IRQ_PRIORITY  15      // Only ends sleeps, nothing to do in the handler
+
+// Host UART RX (USART2_RX on PD6): its start bit ends STOP
+#define HAL_POWER_UART_WAKE_PIN     6U
+#define HAL_POWER_UART_WAKE_PORT    3U      // EXTICR source GPIOD
+#define HAL_POWER_UART_WAKE_IRQ     EXTI9_5_IRQn
+
+static volatile uint32_t stop_locks = 0;
+static volatile bool stop_enabled = false;
+static hal_power_stats_t stats;
+static uint32_t hal_tick_carry_us = 0;     // Sub-millisecond rest of the HAL tick
+
+/**
+ * @brief Route the UART RX pin to its EXTI line, falling edge (start bit)
+ * @return Whether the shared EXTI IRQ was already enabled
+ */
+static bool uart_wake_arm(void)
+{
+    const uint32_t line = 1U << HAL_POWER_UART_WAKE_PIN;
+    const uint32_t shift = (HAL_POWER_UART_WAKE_PIN % 4U) * 4U;
+    bool irq_enabled = NVIC_GetEnableIRQ(HAL_POWER_UART_WAKE_IRQ) != 0U;
+
+    // The EXTI taps the pin input, which stays live in alternate function mode
+    SYSCFG->EXTICR[HAL_POWER_UART_WAKE_PIN / 4U] =
+        (SYSCFG->EXTICR[HAL_POWER_UART_WAKE_PIN / 4U] & ~(0xFU << shift)) |
+        (HAL_POWER_UART_WAKE_PORT << shift);
+    EXTI->FTSR |= line;
+    EXTI->PR = line;
+    EXTI->IMR |= line;
+    NVIC_EnableIRQ(HAL_POWER_UART_WAKE_IRQ);
+
+    return irq_enabled;
+}
+
+static void uart_wake_disarm(bool irq_was_enabled)
+{
+    const uint32_t line = 1U << HAL_POWER_UART_WAKE_PIN;
+
+    EXTI->IMR &= ~line;
+    EXTI->FTSR &= ~line;
+    EXTI->PR = line;
+    if (!irq_was_enabled) {
+        NVIC_DisableIRQ(HAL_POWER_UART_WAKE_IRQ);
+        NVIC_ClearPendingIRQ(HAL_POWER_UART_WAKE_IRQ);
+    }
+}
+
+static uint32_t enter_sleep(void)
+{
+    uint32_t start = hal_timer_get_us();
+
+    // TIM6 (HAL tick) would end the sleep every millisecond
+    HAL_SuspendTick();
+    HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+
+    return hal_timer_get_us() - start;
+}
+
+static uint32_t enter_stop(uint32_t armed_us)
+{
+    hal_rtc_time_t before;
+    hal_rtc_get_time(&before);
+
+    bool irq_was_enabled = uart_wake_arm();
+    HAL_SuspendTick();
+    HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+
+    // Running from HSI now: restart HSE and the PLL at the performance
+    // level that was running. HAL timeouts cannot expire with interrupts
+    // masked, but the ready flags come up within a few milliseconds.
+    hal_clock_restore();
+    uart_wake_disarm(irq_was_enabled);
+
+    uint32_t slept_us = armed_us;
+    if (!hal_rtc_wakeup_fired()) {
+        // Woken early: the calendar gives the time to 1/256 s
+        hal_rtc_time_t after;
+        hal_rtc_wait_sync();
+        hal_rtc_get_time(&after);
+
+        int64_t elapsed_us = ((int64_t)after.seconds - (int64_t)before.seconds) * 1000000 +
+                             ((int32_t)after.milliseconds - (int32_t)before.milliseconds) * 1000;
+        if (elapsed_us < 0) {
+            elapsed_us = 0;
+        }
+        if (elapsed_us < (int64_t)armed_us) {
+            slept_us = (uint32_t)elapsed_us;
+        }
+    }
+
+    // TIM5 stood still: keep the microsecond clock continuous
+    hal_timer_skip_us(slept_us);
+    return slept_us;
+}
+
+bool hal_power_init(void)
+{
+    HAL_NVIC_SetPriority(RTC_WKUP_IRQn, HAL_POWER_RTC_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(RTC_WKUP_IRQn);
+    return true;
+}
+
+void hal_power_set_stop_enabled(bool enable)
+{
+    stop_enabled = enable;
+}
+
+void hal_power_stop_lock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    stop_locks++;
+    __set_PRIMASK(primask);
+}
+
+void hal_power_stop_unlock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (stop_locks > 0) {
+        stop_locks--;
+    }
+    __set_PRIMASK(primask);
+}
+
+uint32_t hal_power_idle(uint32_t max_us)
+{
+    if (max_us > HAL_POWER_MAX_IDLE_US) {
+        max_us = HAL_POWER_MAX_IDLE_US;
+    }
+
+    // EXTI debouncing ends on the HAL tick, which sleep suspends
+    if (hal_gpio_exti_debouncing()) {
+        return 0;
+    }
+
+    uint32_t armed_us = hal_rtc_start_wakeup_us(max_us);
+    if (armed_us == 0) {
+        return 0;
+    }
+
+    bool stop = stop_enabled && stop_locks == 0 && armed_us >= HAL_POWER_STOP_MIN_US;
+    uint32_t slept_us = stop ? enter_stop(armed_us) : enter_sleep();
+
+    hal_rtc_disable_wakeup_timer();
+    hal_rtc_wakeup_fired();     // Drop an expiry that raced another wake-up
+
+    // The HAL tick missed the sleep as well
+    hal_tick_carry_us += slept_us;
+    uwTick += hal_tick_carry_us / 1000U;
+    hal_tick_carry_us %= 1000U;
+    HAL_ResumeTick();
+
+    if (stop) {
+        stats.stop_count++;
+        stats.stop_us += slept_us;
+    } else {
+        stats.sleep_count++;
+        stats.sleep_us += slept_us;
+    }
+    return slept_us;
+}
+
+void hal_power_get_stats(hal_power_stats_t *stats_out)
+{
+    if (stats_out == NULL) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats_out = stats;
+    stats_out->stop_locks = stop_locks;
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,87 @@
+#ifndef HAL_POWER_H
+#define HAL_POWER_H
+
+/**
+ * @file hal_power.h
+ * @brief Low-power idle: SLEEP and STOP entry timed by the RTC wakeup timer
+ *
+ * The tickless idle hook (os_power.c) calls hal_power_idle() with the time
+ * until the next task is due. The core then sleeps in one of two modes:
+ *
+ * - SLEEP: only the CPU clock stops. Peripherals and DMA keep running, so
+ *   any interrupt (UART IDLE/DMA, INA226 ALERT, I2C/SPI completion) wakes
+ *   it within a few cycles. Used for short idle periods and whenever STOP
+ *   is not allowed.
+ * - STOP: all clocks but the LSE stop. The RTC wakeup timer and the EXTI
+ *   lines (INA226 ALERT, host UART RX pin) wake it, after which the PLL is
+ *   restarted. The microsecond timer and the HAL tick are advanced by the
+ *   time slept so both stay continuous.
+ *
+ * STOP is off until hal_power_set_stop_enabled(true): the first bytes the
+ * host sends while the clocks restart are lost, which only suits
+ * deployments where the link is idle most of the time and the host
+ * retries. Drivers hold hal_power_stop_lock() while a transfer is in
+ * flight, so STOP never freezes a DMA or I2C transaction.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Idle periods shorter than this only SLEEP (STOP exit costs the PLL restart)
+#define HAL_POWER_STOP_MIN_US       20000
+
+// Upper bound of one sleep (the RTC wakeup timer counts up to 32 s)
+#define HAL_POWER_MAX_IDLE_US       30000000
+
+typedef enum {
+    HAL_POWER_MODE_SLEEP = 0,
+    HAL_POWER_MODE_STOP
+} hal_power_mode_t;
+
+typedef struct {
+    uint32_t sleep_count;       // SLEEP entries
+    uint32_t stop_count;        // STOP entries
+    uint64_t sleep_us;          // Time spent in SLEEP
+    uint64_t stop_us;           // Time spent in STOP
+    uint32_t stop_locks;        // Currently held stop locks
+} hal_power_stats_t;
+
+/**
+ * @brief Enable the RTC wakeup interrupt used to end a sleep
+ * @return true on success
+ */
+bool hal_power_init(void);
+
+/**
+ * @brief Allow STOP mode for long idle periods (default: SLEEP only)
+ */
+void hal_power_set_stop_enabled(bool enable);
+
+/**
+ * @brief Keep the system out of STOP (nestable, task or ISR context)
+ */
+void hal_power_stop_lock(void);
+
+/**
+ * @brief Release a hal_power_stop_lock()
+ */
+void hal_power_stop_unlock(void);
+
+/**
+ * @brief Sleep until an interrupt or for at most max_us
+ *
+ * Call with interrupts masked (PRIMASK); a pending interrupt still ends
+ * the sleep and runs once the caller unmasks.
+ *
+ * @param max_us Longest sleep in microseconds
+ * @return Microseconds slept; 0 without sleeping while an EXTI line
+ *         debounces (hal_gpio_exti_debouncing())
+ */
+uint32_t hal_power_idle(uint32_t max_us);
+
+/**
+ * @brief Get sleep statistics
+ */
+void hal_power_get_stats(hal_power_stats_t *stats);
+
+#endif // HAL_POWER_H
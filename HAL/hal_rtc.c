@@ -5,6 +5,10 @@
 // External RTC handle (should be defined in main.c after CubeMX generation)
 extern RTC_HandleTypeDef hrtc;
 
+// Tickless wakeup clock (RTCCLK/16)
+#define RTC_WAKEUP_HZ           (LSE_VALUE / 16U)
+#define RTC_WAKEUP_MAX_COUNTS   0x10000U
+
 // Flag to track if RTC is initialized and time is valid
 static bool rtc_time_valid = false;
 
@@ -263,3 +267,38 @@ hal_rtc_status_t hal_rtc_disable_wakeup_timer(void) {
     }
     return HAL_RTC_OK;
 }
+
+uint32_t hal_rtc_start_wakeup_us(uint32_t us) {
+    uint32_t counts = (uint32_t)(((uint64_t)us * RTC_WAKEUP_HZ) / 1000000U);
+    if (counts == 0) {
+        return 0;
+    }
+    if (counts > RTC_WAKEUP_MAX_COUNTS) {
+        counts = RTC_WAKEUP_MAX_COUNTS;
+    }
+
+    // Fires after WUT + 1 cycles; waits up to two RTCCLK cycles for WUTWF
+    if (HAL_RTCEx_SetWakeUpTimer_IT(&hrtc, counts - 1U, RTC_WAKEUPCLOCK_RTCCLK_DIV16) != HAL_OK) {
+        return 0;
+    }
+
+    return (uint32_t)(((uint64_t)counts * 1000000U) / RTC_WAKEUP_HZ);
+}
+
+bool hal_rtc_wakeup_fired(void) {
+    bool fired = __HAL_RTC_WAKEUPTIMER_GET_FLAG(&hrtc, RTC_FLAG_WUTF) != 0U;
+
+    if (fired) {
+        __HAL_RTC_WAKEUPTIMER_CLEAR_FLAG(&hrtc, RTC_FLAG_WUTF);
+    }
+    __HAL_RTC_WAKEUPTIMER_EXTI_CLEAR_FLAG();
+    NVIC_ClearPendingIRQ(RTC_WKUP_IRQn);
+
+    return fired;
+}
+
+void hal_rtc_wait_sync(void) {
+    __HAL_RTC_WRITEPROTECTION_DISABLE(&hrtc);
+    HAL_RTC_WaitForSynchro(&hrtc);
+    __HAL_RTC_WRITEPROTECTION_ENABLE(&hrtc);
+}
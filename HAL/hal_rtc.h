@@ -8,6 +8,11 @@
  * This HAL provides consistent RTC API for timestamp management.
  * Supports Unix timestamp format and millisecond precision.
  * Can be synchronized with external time sources (NTP, GPS, etc.)
+ *
+ * Every read waits for the shadow registers and converts the calendar,
+ * so frequent timestamps (per sample, per session) should come from
+ * hal_timebase_unix_us() instead: it is anchored to the RTC and derives
+ * wall-clock time from the microsecond counter.
  */
 
 #include <stdint.h>
@@ -151,4 +156,30 @@ hal_rtc_status_t hal_rtc_set_wakeup_timer(uint16_t seconds);
  */
 hal_rtc_status_t hal_rtc_disable_wakeup_timer(void);
 
+/**
+ * @brief Arm the wakeup timer for a short interval (tickless idle)
+ * Counts LSE/16 (2048 Hz): 488 us steps, up to 32 s. Shares the timer
+ * with hal_rtc_set_wakeup_timer().
+ *
+ * @param us Interval in microseconds, rounded down to whole steps
+ * @return uint32_t Interval actually armed in microseconds, 0 if shorter
+ *         than one step or on error
+ */
+uint32_t hal_rtc_start_wakeup_us(uint32_t us);
+
+/**
+ * @brief Check and clear the wakeup timer event
+ * Also clears its EXTI line and pending interrupt, so it can be polled
+ * with interrupts masked.
+ *
+ * @return bool True if the timer expired since it was armed
+ */
+bool hal_rtc_wakeup_fired(void);
+
+/**
+ * @brief Wait for the calendar shadow registers after STOP mode
+ * Calendar reads return stale values until the next RTCCLK edge.
+ */
+void hal_rtc_wait_sync(void);
+
 #endif // HAL_RTC_H
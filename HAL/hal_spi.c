@@ -3,6 +3,61 @@
 // STM32-specific implementation
 #include "stm32f7xx_hal.h"
 #include "stm32f7xx_hal_spi.h"
+#include "hal_mem.h"
+#include "hal_power.h"
+#include <stddef.h>
+
+// Per-bus state: DMA completion routing and the device last selected
+typedef struct {
+    SPI_HandleTypeDef *hspi;
+    hal_spi_callback_t callback;
+    void *user_data;
+    bool dma_active;            // Holds a hal_power stop lock
+    hal_spi_device_t *device;   // Last selected on the bus
+} spi_async_slot_t;
+
+static spi_async_slot_t async_slots[HAL_SPI_MAX_ASYNC_BUSES];
+
+// Bus clock generation, bumped by hal_spi_clock_changed(); devices with a
+// max_hz derive their prescaler again when theirs is older
+static volatile uint32_t clock_epoch = 1;
+
+static spi_async_slot_t *find_slot(SPI_HandleTypeDef *hspi, bool create)
+{
+    for (uint32_t i = 0; i < HAL_SPI_MAX_ASYNC_BUSES; i++) {
+        if (async_slots[i].hspi == hspi) {
+            return &async_slots[i];
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < HAL_SPI_MAX_ASYNC_BUSES; i++) {
+        if (async_slots[i].hspi == NULL) {
+            async_slots[i].hspi = hspi;
+            return &async_slots[i];
+        }
+    }
+    return NULL;
+}
+
+static void complete(SPI_HandleTypeDef *hspi, hal_spi_status_t status)
+{
+    spi_async_slot_t *slot = find_slot(hspi, false);
+    if (slot == NULL) {
+        return;
+    }
+    if (slot->dma_active) {
+        slot->dma_active = false;
+        hal_power_stop_unlock();
+    }
+    if (slot->callback == NULL) {
+        return;
+    }
+    hal_spi_callback_t callback = slot->callback;
+    slot->callback = NULL;  // Cleared first so the callback can start the next transfer
+    callback((hal_spi_handle_t)hspi, status, slot->user_data);
+}
 
 /**
  * @brief Transmit data over SPI
@@ -49,3 +104,210 @@ hal_spi_status_t hal_spi_transmit_receive(hal_spi_handle_t handle, uint8_t* tx_d
         default:          return HAL_SPI_ERROR;
     }
 }
+
+/**
+ * @brief Start a DMA transmit
+ */
+hal_spi_status_t hal_spi_transmit_dma(hal_spi_handle_t handle, const uint8_t* data, uint16_t size,
+                                      hal_spi_callback_t callback, void *user_data)
+{
+    SPI_HandleTypeDef *hspi = (SPI_HandleTypeDef*)handle;
+    if (hspi == NULL || hspi->hdmatx == NULL || data == NULL || size == 0) {
+        return HAL_SPI_ERROR;
+    }
+
+    spi_async_slot_t *slot = find_slot(hspi, true);
+    if (slot == NULL) {
+        return HAL_SPI_ERROR;
+    }
+    if (hspi->State != HAL_SPI_STATE_READY) {
+        return HAL_SPI_BUSY;
+    }
+
+    // The DMA reads memory directly: write back what the CPU left in cache
+    hal_cache_clean(data, size);
+
+    slot->callback = callback;
+    slot->user_data = user_data;
+
+    // STOP would freeze the DMA; complete() releases the lock
+    slot->dma_active = true;
+    hal_power_stop_lock();
+
+    HAL_StatusTypeDef status = HAL_SPI_Transmit_DMA(hspi, (uint8_t*)data, size);
+    if (status != HAL_OK) {
+        slot->callback = NULL;
+        slot->dma_active = false;
+        hal_power_stop_unlock();
+        return (status == HAL_BUSY) ? HAL_SPI_BUSY : HAL_SPI_ERROR;
+    }
+    return HAL_SPI_OK;
+}
+
+/**
+ * @brief Check whether a transfer is in flight on the bus
+ */
+bool hal_spi_is_busy(hal_spi_handle_t handle)
+{
+    return ((SPI_HandleTypeDef*)handle)->State != HAL_SPI_STATE_READY;
+}
+
+/**
+ * @brief Kernel clock of the bus: APB2 for SPI1/4/5/6, APB1 for SPI2/3
+ */
+uint32_t hal_spi_get_bus_clock_hz(hal_spi_handle_t handle)
+{
+    SPI_HandleTypeDef *hspi = (SPI_HandleTypeDef*)handle;
+    if (hspi == NULL) {
+        return 0;
+    }
+    if (hspi->Instance == SPI2 || hspi->Instance == SPI3) {
+        return HAL_RCC_GetPCLK1Freq();
+    }
+    return HAL_RCC_GetPCLK2Freq();
+}
+
+/**
+ * @brief Smallest prescaler whose SCK does not exceed max_hz
+ */
+hal_spi_prescaler_t hal_spi_prescaler_for_hz(hal_spi_handle_t handle, uint32_t max_hz)
+{
+    uint32_t clock = hal_spi_get_bus_clock_hz(handle);
+    hal_spi_prescaler_t prescaler = HAL_SPI_PRESCALER_2;
+
+    while (prescaler < HAL_SPI_PRESCALER_256 && (clock >> (prescaler + 1)) > max_hz) {
+        prescaler++;
+    }
+    return prescaler;
+}
+
+/**
+ * @brief SCK a device runs at
+ */
+uint32_t hal_spi_device_clock_hz(const hal_spi_device_t *device)
+{
+    if (device == NULL) {
+        return 0;
+    }
+    return hal_spi_get_bus_clock_hz(device->bus) >> (device->prescaler + 1);
+}
+
+/**
+ * @brief Run a device at the fastest SCK not above max_hz
+ */
+void hal_spi_device_set_max_hz(hal_spi_device_t *device, uint32_t max_hz)
+{
+    if (device == NULL || device->bus == NULL) {
+        return;
+    }
+    device->max_hz = max_hz;
+    device->clock_epoch = clock_epoch;
+    device->prescaler = hal_spi_prescaler_for_hz(device->bus, max_hz);
+}
+
+/**
+ * @brief Write a device's BR, CPOL and CPHA into its bus if they differ
+ * @param force Also while the HAL marks the bus busy (bus known idle)
+ */
+static hal_spi_status_t apply_device(SPI_HandleTypeDef *hspi, const hal_spi_device_t *device,
+                                     bool force)
+{
+    const uint32_t mask = SPI_CR1_BR | SPI_CR1_CPOL | SPI_CR1_CPHA;
+    uint32_t want = ((uint32_t)device->prescaler << SPI_CR1_BR_Pos) |
+                    ((device->mode & 2U) ? SPI_CR1_CPOL : 0U) |
+                    ((device->mode & 1U) ? SPI_CR1_CPHA : 0U);
+
+    if ((hspi->Instance->CR1 & mask) == want) {
+        return HAL_SPI_OK;
+    }
+    if (hspi->State != HAL_SPI_STATE_READY && !force) {
+        return HAL_SPI_BUSY;
+    }
+
+    // BR, CPOL and CPHA only change with the peripheral off; the HAL
+    // enables it again at the start of the next transfer
+    bool enabled = (hspi->Instance->CR1 & SPI_CR1_SPE) != 0U;
+    __HAL_SPI_DISABLE(hspi);
+    hspi->Instance->CR1 = (hspi->Instance->CR1 & ~mask) | want;
+    hspi->Init.BaudRatePrescaler = want & SPI_CR1_BR;
+    hspi->Init.CLKPolarity = want & SPI_CR1_CPOL;
+    hspi->Init.CLKPhase = want & SPI_CR1_CPHA;
+    if (force && enabled) {
+        // A blocking transfer may be half done: let it carry on
+        __HAL_SPI_ENABLE(hspi);
+    }
+    return HAL_SPI_OK;
+}
+
+/**
+ * @brief Apply a device's clock and mode to its bus
+ */
+hal_spi_status_t hal_spi_device_select(hal_spi_device_t *device)
+{
+    if (device == NULL || device->bus == NULL) {
+        return HAL_SPI_ERROR;
+    }
+
+    SPI_HandleTypeDef *hspi = (SPI_HandleTypeDef*)device->bus;
+    if (device->max_hz != 0 && device->clock_epoch != clock_epoch) {
+        device->prescaler = hal_spi_prescaler_for_hz(hspi, device->max_hz);
+        device->clock_epoch = clock_epoch;
+    }
+
+    hal_spi_status_t status = apply_device(hspi, device, false);
+    if (status == HAL_SPI_OK) {
+        spi_async_slot_t *slot = find_slot(hspi, true);
+        if (slot != NULL) {
+            slot->device = device;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Check that no selected bus is transferring
+ */
+bool hal_spi_is_idle(void)
+{
+    for (uint32_t i = 0; i < HAL_SPI_MAX_ASYNC_BUSES; i++) {
+        SPI_HandleTypeDef *hspi = async_slots[i].hspi;
+        if (hspi == NULL) {
+            continue;
+        }
+        // A blocking transfer preempted between frames shows an empty FIFO
+        if (async_slots[i].dma_active ||
+            (hspi->Instance->SR & (SPI_SR_BSY | SPI_SR_FTLVL)) != 0U) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Re-derive the device prescalers after a system clock change
+ */
+void hal_spi_clock_changed(void)
+{
+    clock_epoch++;
+    for (uint32_t i = 0; i < HAL_SPI_MAX_ASYNC_BUSES; i++) {
+        hal_spi_device_t *device = async_slots[i].device;
+        if (device == NULL || device->max_hz == 0) {
+            continue;
+        }
+        device->prescaler = hal_spi_prescaler_for_hz(device->bus, device->max_hz);
+        device->clock_epoch = clock_epoch;
+        (void)apply_device(async_slots[i].hspi, device, true);
+    }
+}
+
+// ========== STM32 HAL Callbacks (ISR context) ==========
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    complete(hspi, HAL_SPI_OK);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    complete(hspi, HAL_SPI_ERROR);
+}
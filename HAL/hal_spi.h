@@ -22,10 +22,118 @@ typedef enum {
     HAL_SPI_TIMEOUT
 } hal_spi_status_t;
 
+/**
+ * @brief Asynchronous transfer completion callback (ISR context)
+ * @param handle Bus the transfer ran on
+ * @param status HAL_SPI_OK or HAL_SPI_ERROR
+ * @param user_data Context passed when the transfer was started
+ */
+typedef void (*hal_spi_callback_t)(hal_spi_handle_t handle, hal_spi_status_t status, void *user_data);
+
+// SCK = bus kernel clock / prescaler (the CR1 BR field, in order)
+typedef enum {
+    HAL_SPI_PRESCALER_2 = 0,
+    HAL_SPI_PRESCALER_4,
+    HAL_SPI_PRESCALER_8,
+    HAL_SPI_PRESCALER_16,
+    HAL_SPI_PRESCALER_32,
+    HAL_SPI_PRESCALER_64,
+    HAL_SPI_PRESCALER_128,
+    HAL_SPI_PRESCALER_256
+} hal_spi_prescaler_t;
+
+/**
+ * @brief Clock and mode of one device on a bus
+ *
+ * hal_spi_device_select() programs them into the bus before a transaction,
+ * so devices sharing a bus each run at their own fastest SCK. Mode is
+ * CPOL << 1 | CPHA, as usual (0 for most parts). With max_hz set (see
+ * hal_spi_device_set_max_hz()) the prescaler follows the bus clock across
+ * system clock changes; with 0 it stays as set.
+ */
+typedef struct {
+    hal_spi_handle_t bus;
+    hal_spi_prescaler_t prescaler;
+    uint8_t mode;
+    uint32_t max_hz;            // Fastest SCK the device takes, 0 for a fixed prescaler
+    uint32_t clock_epoch;       // Bus clock generation the prescaler is for
+} hal_spi_device_t;
+
+// Buses tracked for DMA completion and clock changes (selected or DMA-driven)
+#define HAL_SPI_MAX_ASYNC_BUSES     2
+
 // SPI Functions
 hal_spi_status_t hal_spi_transmit(hal_spi_handle_t handle, uint8_t* data, uint16_t size, uint32_t timeout_ms);
 hal_spi_status_t hal_spi_receive(hal_spi_handle_t handle, uint8_t* data, uint16_t size, uint32_t timeout_ms);
 hal_spi_status_t hal_spi_transmit_receive(hal_spi_handle_t handle, uint8_t* tx_data, uint8_t* rx_data, 
                                            uint16_t size, uint32_t timeout_ms);
 
+/**
+ * @brief Start a DMA transmit (the bus needs a TX DMA stream linked)
+ *
+ * The buffer is cleaned from the D-cache first, so it may live in cacheable
+ * RAM, but it must stay untouched until the callback runs.
+ *
+ * @param handle Bus handle
+ * @param data Data to send
+ * @param size Bytes to send
+ * @param callback Called from the DMA interrupt when done (can be NULL)
+ * @param user_data Passed to the callback
+ * @return HAL_SPI_BUSY if a transfer is in flight on the bus
+ */
+hal_spi_status_t hal_spi_transmit_dma(hal_spi_handle_t handle, const uint8_t* data, uint16_t size,
+                                      hal_spi_callback_t callback, void *user_data);
+
+/**
+ * @brief Check whether a transfer is in flight on the bus
+ */
+bool hal_spi_is_busy(hal_spi_handle_t handle);
+
+/**
+ * @brief Kernel clock the bus divides SCK from (its APB clock)
+ */
+uint32_t hal_spi_get_bus_clock_hz(hal_spi_handle_t handle);
+
+/**
+ * @brief Smallest prescaler whose SCK does not exceed max_hz
+ * @return HAL_SPI_PRESCALER_256 if even that is too fast
+ */
+hal_spi_prescaler_t hal_spi_prescaler_for_hz(hal_spi_handle_t handle, uint32_t max_hz);
+
+/**
+ * @brief SCK a device runs at
+ */
+uint32_t hal_spi_device_clock_hz(const hal_spi_device_t *device);
+
+/**
+ * @brief Run a device at the fastest SCK not above max_hz, now and after
+ *        later bus clock changes
+ */
+void hal_spi_device_set_max_hz(hal_spi_device_t *device, uint32_t max_hz);
+
+/**
+ * @brief Apply a device's clock and mode to its bus
+ *
+ * Call before asserting the device's chip select: a mode change moves the
+ * SCK idle level. Costs one register compare when the bus is already set
+ * up for the device. Task or ISR context.
+ *
+ * @return HAL_SPI_BUSY if a transfer is in flight on the bus
+ */
+hal_spi_status_t hal_spi_device_select(hal_spi_device_t *device);
+
+/**
+ * @brief Check that no selected bus is transferring (DMA or shift register)
+ */
+bool hal_spi_is_idle(void);
+
+/**
+ * @brief Re-derive the device prescalers after a system clock change
+ *
+ * For hal_clock; call with interrupts masked while hal_spi_is_idle(). The
+ * device each bus was last selected for is set up again at once, others
+ * on their next select.
+ */
+void hal_spi_clock_changed(void);
+
 #endif // HAL_SPI_H
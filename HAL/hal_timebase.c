@@ -0,0 +1,254 @@
+#include "hal_timebase.h"
+#include "hal_timer.h"
+#include "hal_rtc.h"
+#include "hal_delay.h"
+
+// STM32-specific implementation
+#include "stm32f7xx_hal.h"
+
+// Conversion segment: unix = seg_unix + elapsed + elapsed * rate / 1e9.
+// Each discipline starts a new segment where the old one ended, so the
+// mapping stays continuous.
+static uint64_t seg_mono_us = 0;
+static uint64_t seg_unix_us = 0;
+static int32_t rate_ppb = 0;
+
+// Frequency reference: source and monotonic time at the last step (or
+// since the source changed)
+static uint64_t ref_mono_us = 0;
+static uint64_t ref_source_us = 0;
+static uint8_t ref_source = HAL_TIMEBASE_SOURCE_RTC;
+
+static bool timebase_initialized = false;
+static uint32_t last_discipline_tick = 0;
+static uint32_t last_reference_tick = 0;
+static uint64_t last_reference_mono_us = 0;
+static hal_timebase_status_t status = {0};
+
+static bool read_rtc_us(uint64_t *rtc_us, uint64_t *mono_us)
+{
+    hal_rtc_time_t time;
+
+    *mono_us = hal_timer_get_us64();
+    if (hal_rtc_get_time(&time) != HAL_RTC_OK) {
+        return false;
+    }
+    *rtc_us = (uint64_t)time.seconds * 1000000U + (uint64_t)time.milliseconds * 1000U;
+    return true;
+}
+
+static uint64_t segment_to_unix(uint64_t mono_us)
+{
+    int64_t elapsed = (int64_t)(mono_us - seg_mono_us);
+    return seg_unix_us + (uint64_t)(elapsed + (elapsed * rate_ppb) / 1000000000LL);
+}
+
+static void step_to(uint64_t source_us, uint64_t mono_us, uint8_t source)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    seg_mono_us = mono_us;
+    seg_unix_us = source_us;
+    ref_mono_us = mono_us;
+    ref_source_us = source_us;
+    ref_source = source;
+    __set_PRIMASK(primask);
+
+    status.synced = (source == HAL_TIMEBASE_SOURCE_REFERENCE) || hal_rtc_is_time_valid();
+    status.source = source;
+    status.last_offset_us = 0;
+    status.steps++;
+}
+
+/**
+ * @brief Adjust towards a source reading taken at mono_us
+ * Estimates the frequency over everything since the last step and sets
+ * the rate that also removes the current offset within slew_ms. The new
+ * segment starts now, so a reading from the past does not make the
+ * mapping jump.
+ */
+static void discipline_to(uint64_t source_us, uint64_t mono_us, uint8_t source, uint32_t slew_ms)
+{
+    uint64_t predicted_us = hal_timebase_to_unix_us(mono_us);
+    int64_t offset_us = (int64_t)(source_us - predicted_us);
+
+    // Source was set or jumped: restart
+    if (offset_us > HAL_TIMEBASE_STEP_THRESHOLD_US || offset_us < -HAL_TIMEBASE_STEP_THRESHOLD_US) {
+        step_to(source_us, mono_us, source);
+        return;
+    }
+
+    int64_t freq_ppb = 0;
+    if (source != ref_source) {
+        // New source: its baseline starts here, the current rate stands in
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        ref_mono_us = mono_us;
+        ref_source_us = source_us;
+        ref_source = source;
+        __set_PRIMASK(primask);
+        freq_ppb = rate_ppb;
+    } else {
+        // Frequency error of the monotonic clock against the source
+        int64_t ref_elapsed = (int64_t)(mono_us - ref_mono_us);
+        if (ref_elapsed > 0) {
+            freq_ppb = (((int64_t)(source_us - ref_source_us) - ref_elapsed) * 1000000000LL) / ref_elapsed;
+        }
+    }
+
+    // Plus the rate that removes the offset within slew_ms
+    int64_t slew_ppb = (offset_us * 1000000LL) / slew_ms;
+    int64_t new_rate = freq_ppb + slew_ppb;
+    if (new_rate > HAL_TIMEBASE_MAX_RATE_PPB) {
+        new_rate = HAL_TIMEBASE_MAX_RATE_PPB;
+    } else if (new_rate < -HAL_TIMEBASE_MAX_RATE_PPB) {
+        new_rate = -HAL_TIMEBASE_MAX_RATE_PPB;
+    }
+
+    // New segment starting where the old one is now
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint64_t now_us = hal_timer_get_us64();
+    seg_unix_us = segment_to_unix(now_us);
+    seg_mono_us = now_us;
+    rate_ppb = (int32_t)new_rate;
+    __set_PRIMASK(primask);
+
+    status.synced = (source == HAL_TIMEBASE_SOURCE_REFERENCE) || hal_rtc_is_time_valid();
+    status.source = source;
+    status.rate_ppb = rate_ppb;
+    status.last_offset_us = (int32_t)offset_us;
+}
+
+/**
+ * @brief Start the monotonic clock and anchor it to the RTC
+ * @return true if the microsecond timer is running
+ */
+bool hal_timebase_init(void)
+{
+    if (!hal_timer_init()) {
+        return false;
+    }
+
+    timebase_initialized = true;
+    hal_timebase_resync();
+    last_discipline_tick = hal_get_tick();
+    return true;
+}
+
+/**
+ * @brief Get monotonic time
+ * @return Microseconds since boot (never jumps)
+ */
+uint64_t hal_timebase_now_us(void)
+{
+    return hal_timer_get_us64();
+}
+
+/**
+ * @brief Convert monotonic time to wall-clock time
+ * @param mono_us Time from hal_timebase_now_us()
+ * @return Microseconds since the Unix epoch (RTC time if never set)
+ */
+uint64_t hal_timebase_to_unix_us(uint64_t mono_us)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint64_t unix_us = segment_to_unix(mono_us);
+    __set_PRIMASK(primask);
+    return unix_us;
+}
+
+/**
+ * @brief Get the current wall-clock time
+ * @return Microseconds since the Unix epoch
+ */
+uint64_t hal_timebase_unix_us(void)
+{
+    return hal_timebase_to_unix_us(hal_timebase_now_us());
+}
+
+/**
+ * @brief Step wall-clock time to the RTC (call after setting the RTC)
+ * Forgets the frequency estimate's baseline but keeps the correction.
+ */
+void hal_timebase_resync(void)
+{
+    uint64_t rtc_us, mono_us;
+
+    if (!timebase_initialized || !read_rtc_us(&rtc_us, &mono_us)) {
+        return;
+    }
+    step_to(rtc_us, mono_us, HAL_TIMEBASE_SOURCE_RTC);
+}
+
+/**
+ * @brief Compare against the RTC and adjust (call periodically)
+ * Returns immediately until HAL_TIMEBASE_DISCIPLINE_INTERVAL_MS has
+ * passed, and while a reference has been seen within
+ * HAL_TIMEBASE_REFERENCE_HOLD_MS. The RTC reads in 1/256 s steps, so the
+ * frequency is estimated over everything since the last step, and the
+ * current offset is slewed out over the next interval.
+ */
+void hal_timebase_discipline(void)
+{
+    uint64_t rtc_us, mono_us;
+
+    if (!timebase_initialized ||
+        (hal_get_tick() - last_discipline_tick) < HAL_TIMEBASE_DISCIPLINE_INTERVAL_MS) {
+        return;
+    }
+    last_discipline_tick = hal_get_tick();
+
+    if (ref_source == HAL_TIMEBASE_SOURCE_REFERENCE &&
+        (hal_get_tick() - last_reference_tick) < HAL_TIMEBASE_REFERENCE_HOLD_MS) {
+        return;
+    }
+
+    if (!read_rtc_us(&rtc_us, &mono_us)) {
+        return;
+    }
+
+    discipline_to(rtc_us, mono_us, HAL_TIMEBASE_SOURCE_RTC, HAL_TIMEBASE_DISCIPLINE_INTERVAL_MS);
+}
+
+/**
+ * @brief Discipline to an external reference sample
+ * The offset is slewed out over the time since the previous sample (at
+ * least HAL_TIMEBASE_SLEW_MIN_MS), expecting the next one as far ahead;
+ * offsets past HAL_TIMEBASE_STEP_THRESHOLD_US are stepped. Call from one
+ * context only.
+ * @param mono_us Monotonic time the sample refers to (may be in the past)
+ * @param unix_us Reference wall-clock time at mono_us
+ */
+void hal_timebase_reference(uint64_t mono_us, uint64_t unix_us)
+{
+    if (!timebase_initialized) {
+        return;
+    }
+
+    uint64_t since_us = mono_us - last_reference_mono_us;
+    uint32_t slew_ms = HAL_TIMEBASE_SLEW_MIN_MS;
+    if (ref_source == HAL_TIMEBASE_SOURCE_REFERENCE && mono_us > last_reference_mono_us &&
+        since_us / 1000U > HAL_TIMEBASE_SLEW_MIN_MS) {
+        slew_ms = (since_us / 1000U < HAL_TIMEBASE_REFERENCE_HOLD_MS)
+                  ? (uint32_t)(since_us / 1000U) : HAL_TIMEBASE_REFERENCE_HOLD_MS;
+    }
+    last_reference_mono_us = mono_us;
+    last_reference_tick = hal_get_tick();
+
+    discipline_to(unix_us, mono_us, HAL_TIMEBASE_SOURCE_REFERENCE, slew_ms);
+    status.references++;
+}
+
+/**
+ * @brief Get discipline state
+ * @param status_out Output
+ */
+void hal_timebase_get_status(hal_timebase_status_t *status_out)
+{
+    if (status_out != NULL) {
+        *status_out = status;
+        status_out->rate_ppb = rate_ppb;
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef HAL_TIMEBASE_H
+#define HAL_TIMEBASE_H
+
+/**
+ * @file hal_timebase.h
+ * @brief 64-bit microsecond monotonic clock disciplined to the RTC
+ *
+ * Monotonic time comes from hal_timer (1 MHz TIM5, overflow-extended) and
+ * never jumps. Wall-clock time is derived from it through an anchor taken
+ * from the RTC: hal_timebase_resync() steps the anchor (after the RTC is
+ * set), and hal_timebase_discipline() periodically compares against the
+ * RTC, estimating the crystal frequency error and slewing out offsets so
+ * wall-clock time also stays monotonic.
+ *
+ * An external reference (a host answering CMD_TIME_SYNC) takes over from
+ * the RTC: hal_timebase_reference() disciplines the same way against its
+ * samples, and the RTC is left alone until they stop for
+ * HAL_TIMEBASE_REFERENCE_HOLD_MS.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Discipline tuning
+#define HAL_TIMEBASE_DISCIPLINE_INTERVAL_MS  10000   // RTC comparison period
+#define HAL_TIMEBASE_STEP_THRESHOLD_US       100000  // Larger offsets are stepped, not slewed
+#define HAL_TIMEBASE_MAX_RATE_PPB            500000  // Frequency correction limit (500 ppm)
+#define HAL_TIMEBASE_REFERENCE_HOLD_MS       60000   // RTC discipline resumes after this without samples
+#define HAL_TIMEBASE_SLEW_MIN_MS             1000    // Shortest time an offset is slewed out over
+
+// What wall-clock time follows
+typedef enum {
+    HAL_TIMEBASE_SOURCE_RTC = 0,
+    HAL_TIMEBASE_SOURCE_REFERENCE,  // hal_timebase_reference() samples
+} hal_timebase_source_t;
+
+// Discipline state
+typedef struct {
+    bool synced;                // Anchored to an RTC that has been set, or to a reference
+    uint8_t source;             // hal_timebase_source_t
+    int32_t rate_ppb;           // Correction applied to the monotonic rate
+    int32_t last_offset_us;     // Source minus timebase at the last discipline
+    uint32_t steps;             // Anchor steps (resyncs and large offsets)
+    uint32_t references;        // Reference samples applied
+} hal_timebase_status_t;
+
+// Timebase Functions
+bool hal_timebase_init(void);
+uint64_t hal_timebase_now_us(void);
+uint64_t hal_timebase_to_unix_us(uint64_t mono_us);
+uint64_t hal_timebase_unix_us(void);
+void hal_timebase_resync(void);
+void hal_timebase_discipline(void);
+void hal_timebase_reference(uint64_t mono_us, uint64_t unix_us);
+void hal_timebase_get_status(hal_timebase_status_t *status);
+
+#endif // HAL_TIMEBASE_H
@@ -0,0 +1,232 @@
+#include "hal_timer.h"
+#include "hal_power.h"
+#include "../Utils/isr_probe.h"
+
+// STM32-specific implementation
+#include "stm32f7xx_hal.h"
+
+#define HAL_TIMER_INSTANCE      TIM5
+#define HAL_TIMER_IRQ           TIM5_IRQn
+#define HAL_TIMER_IRQ_PRIORITY  5       // Same as the I2C interrupts it starts transfers for
+
+static bool timer_initialized = false;
+static volatile uint32_t overflow_count = 0;   // Upper 32 bits of the microsecond count
+
+// Periodic compare event (channel 1)
+static hal_timer_callback_t periodic_callback = NULL;
+static void *periodic_user_data = NULL;
+static uint32_t periodic_period_us = 0;
+static volatile uint64_t periodic_next_us = 0;
+static bool periodic_stop_locked = false;       // The schedule needs the counter running (no STOP)
+
+/**
+ * @brief Kernel clock of the APB1 timers
+ */
+static uint32_t timer_clock_hz(void)
+{
+    // APB1 timers run at twice PCLK1 when the APB1 prescaler is not 1
+    uint32_t timer_clock = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1) {
+        timer_clock *= 2U;
+    }
+    return timer_clock;
+}
+
+/**
+ * @brief Start the free-running microsecond counter (idempotent)
+ * @return true if the timer is running
+ */
+bool hal_timer_init(void)
+{
+    if (timer_initialized) {
+        return true;
+    }
+
+    __HAL_RCC_TIM5_CLK_ENABLE();
+
+    TIM_TypeDef *tim = HAL_TIMER_INSTANCE;
+    tim->CR1 = 0;
+    tim->PSC = (timer_clock_hz() / 1000000U) - 1U;  // 1 MHz count
+    tim->ARR = 0xFFFFFFFFU;
+    tim->CNT = 0;
+    tim->EGR = TIM_EGR_UG;                      // Load the prescaler
+    tim->SR = 0;
+    tim->DIER = TIM_DIER_UIE;                   // Overflow extends the count
+
+    HAL_NVIC_SetPriority(HAL_TIMER_IRQ, HAL_TIMER_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(HAL_TIMER_IRQ);
+
+    tim->CR1 = TIM_CR1_CEN;
+    timer_initialized = true;
+    return true;
+}
+
+/**
+ * @brief Get the 32-bit microsecond counter (wraps every ~71.6 minutes)
+ * @return Microseconds since hal_timer_init()
+ */
+uint32_t hal_timer_get_us(void)
+{
+    return HAL_TIMER_INSTANCE->CNT;
+}
+
+/**
+ * @brief Get the 64-bit microsecond count
+ * Safe from any context, including with interrupts masked across a wrap.
+ * @return Microseconds since hal_timer_init()
+ */
+uint64_t hal_timer_get_us64(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t high = overflow_count;
+    uint32_t low = HAL_TIMER_INSTANCE->CNT;
+
+    // Wrapped but the overflow interrupt has not run yet
+    if ((HAL_TIMER_INSTANCE->SR & TIM_SR_UIF) && low < 0x80000000U) {
+        high++;
+    }
+
+    __set_PRIMASK(primask);
+    return ((uint64_t)high << 32) | low;
+}
+
+/**
+ * @brief Advance the counter by time it did not count (STOP mode)
+ * Keeps the microsecond clock continuous across a stop of the timer's
+ * kernel clock. Call with interrupts disabled.
+ * @param us Microseconds to add
+ */
+void hal_timer_skip_us(uint32_t us)
+{
+    TIM_TypeDef *tim = HAL_TIMER_INSTANCE;
+    uint32_t now = tim->CNT;
+    uint32_t next = now + us;
+
+    if (next < now) {
+        overflow_count++;
+    }
+    tim->CNT = next;
+}
+
+/**
+ * @brief Keep counting microseconds after a system clock change (hal_clock)
+ * The prescaler is derived again and the count carries on where it was.
+ * Call with interrupts disabled.
+ */
+void hal_timer_clock_changed(void)
+{
+    if (!timer_initialized) {
+        return;
+    }
+
+    TIM_TypeDef *tim = HAL_TIMER_INSTANCE;
+    uint32_t prescaler = (timer_clock_hz() / 1000000U) - 1U;
+    if (tim->PSC == prescaler) {
+        return;
+    }
+
+    // The prescaler only loads on an update event, which clears the count;
+    // URS keeps that update from counting as an overflow
+    uint32_t now = tim->CNT;
+    tim->PSC = prescaler;
+    tim->CR1 |= TIM_CR1_URS;
+    tim->EGR = TIM_EGR_UG;
+    tim->CNT = now;
+    tim->CR1 &= ~TIM_CR1_URS;
+}
+
+/**
+ * @brief Call a function every period_us on the counter's grid
+ * The first event is one period from now. Replaces a running schedule.
+ * @param period_us Period in microseconds
+ * @param callback Callback (ISR context)
+ * @param user_data Context passed to the callback
+ * @return false if the timer is not running or the arguments are invalid
+ */
+bool hal_timer_start_periodic(uint32_t period_us, hal_timer_callback_t callback, void *user_data)
+{
+    if (!timer_initialized || period_us == 0 || callback == NULL) {
+        return false;
+    }
+
+    TIM_TypeDef *tim = HAL_TIMER_INSTANCE;
+
+    __disable_irq();
+    tim->DIER &= ~TIM_DIER_CC1IE;
+    periodic_callback = callback;
+    periodic_user_data = user_data;
+    periodic_period_us = period_us;
+    periodic_next_us = hal_timer_get_us64() + period_us;
+    tim->CCR1 = (uint32_t)periodic_next_us;
+    tim->SR = ~(uint32_t)TIM_SR_CC1IF;
+    if (!periodic_stop_locked) {
+        periodic_stop_locked = true;
+        hal_power_stop_lock();
+    }
+    tim->DIER |= TIM_DIER_CC1IE;
+    __enable_irq();
+
+    return true;
+}
+
+/**
+ * @brief Stop the periodic event (the counter keeps running)
+ */
+void hal_timer_stop_periodic(void)
+{
+    __disable_irq();
+    if (periodic_stop_locked) {
+        periodic_stop_locked = false;
+        hal_power_stop_unlock();
+    }
+    HAL_TIMER_INSTANCE->DIER &= ~TIM_DIER_CC1IE;
+    HAL_TIMER_INSTANCE->SR = ~(uint32_t)TIM_SR_CC1IF;
+    periodic_callback = NULL;
+    periodic_user_data = NULL;
+    __enable_irq();
+}
+
+/**
+ * @brief Timer interrupt handler (call from TIM5_IRQHandler)
+ */
+void hal_timer_irq_handler(void)
+{
+    TIM_TypeDef *tim = HAL_TIMER_INSTANCE;
+#if ISR_PROBE_ENABLE
+    uint32_t entry = tim->CNT;
+#endif
+    uint32_t sr = tim->SR & tim->DIER;
+
+    if (sr & TIM_SR_UIF) {
+        tim->SR = ~(uint32_t)TIM_SR_UIF;
+        overflow_count++;
+    }
+
+    if (sr & TIM_SR_CC1IF) {
+        tim->SR = ~(uint32_t)TIM_SR_CC1IF;
+
+        uint64_t scheduled = periodic_next_us;
+#if ISR_PROBE_ENABLE
+        // The compare fired at 'scheduled': how late this handler got to it
+        isr_probe_latency(ISR_PROBE_TIMER_US,
+                          (entry - (uint32_t)scheduled) * (hal_get_cpu_freq_hz() / 1000000U));
+#endif
+
+        // Next grid point; skip ones already past (e.g. after a long
+        // masked section) instead of firing back to back
+        uint64_t now = hal_timer_get_us64();
+        uint64_t next = scheduled + periodic_period_us;
+        if (next <= now) {
+            next += ((now - next) / periodic_period_us + 1) * periodic_period_us;
+        }
+        periodic_next_us = next;
+        tim->CCR1 = (uint32_t)next;
+
+        hal_timer_callback_t callback = periodic_callback;
+        if (callback != NULL) {
+            callback(scheduled, periodic_user_data);
+        }
+    }
+}
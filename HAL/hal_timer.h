@@ -0,0 +1,34 @@
+#ifndef HAL_TIMER_H
+#define HAL_TIMER_H
+
+/**
+ * @file hal_timer.h
+ * @brief Platform-independent hardware timer abstraction layer
+ *
+ * A free-running 32-bit timer counting microseconds (TIM5 on the STM32F7,
+ * extended to 64 bits in software) with one periodic compare event. The
+ * compare fires on a fixed grid of the counter, so its cadence does not
+ * drift with interrupt latency. The callback runs in ISR context.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Periodic timer callback (ISR context)
+ * @param timestamp_us Counter time the event was scheduled for
+ * @param user_data Context from hal_timer_start_periodic()
+ */
+typedef void (*hal_timer_callback_t)(uint64_t timestamp_us, void *user_data);
+
+// Timer Functions
+bool hal_timer_init(void);
+uint32_t hal_timer_get_us(void);
+uint64_t hal_timer_get_us64(void);
+void hal_timer_skip_us(uint32_t us);
+void hal_timer_clock_changed(void);
+bool hal_timer_start_periodic(uint32_t period_us, hal_timer_callback_t callback, void *user_data);
+void hal_timer_stop_periodic(void);
+void hal_timer_irq_handler(void);
+
+#endif // HAL_TIMER_H
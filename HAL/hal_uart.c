@@ -7,61 +7,132 @@
  */
 
 #include "hal_uart.h"
+#include "hal_mem.h"
+#include "hal_power.h"
 #include "stm32f7xx_hal.h"
 #include "../Drivers_BSP/Custom/portable_log.h"
 #include "../OS/os_wrapper.h"
+#include "../OS/os_workqueue.h"
+#include "../Utils/latency_trace.h"
 #include <string.h>
 
 static const char *TAG = "HAL_UART";
 
 #define UART_EVENT_QUEUE_SIZE   20
-#define UART_EVENT_TASK_STACK   2048
-#define UART_RX_DMA_BUFFER_SIZE 256
+#define UART_RX_DMA_BUFFER_SIZE 256      // Default RX DMA ring per port
+#define UART_RX_DMA_BUFFER_MIN  64
+#define UART_RX_DMA_POOL_SIZE   4096     // Non-cacheable RAM shared by all ports' RX rings
+#define UART_TX_QUEUE_SIZE      16
+#define UART_ERROR_LOG_INTERVAL_MS 1000   // Per-site limit for per-packet error logs
+#define UART_BAUD_MAX_ERROR_PERMILLE 20   // Divider rounding error the receiver still tolerates
 
 /**
  * @brief Internal state for each UART port
+ *
+ * Grouped by who writes it, each group starting on its own D-cache line:
+ * the interrupt paths then fill and dirty only the lines they use, and
+ * lines the ISRs keep writing never hold configuration read elsewhere.
+ * The DMA rings themselves are in the non-cacheable section.
  */
 typedef struct {
+    // Set up by init and the configuration calls, read-mostly after that
     bool initialized;
+    bool rx_zero_copy;                // RX served straight from rx_dma_buffer
     UART_HandleTypeDef *huart;
     os_queue_handle_t event_queue;
-    os_task_handle_t event_task;
-    os_semaphore_handle_t rx_data_sem;  // Semaphore for RX data availability (signaled by ISR)
     hal_uart_event_callback_t callback;
     void *user_data;
-    uint8_t *rx_buffer;
-    size_t rx_buffer_size;
-    volatile size_t rx_write_pos;
-    volatile size_t rx_read_pos;
-    uint8_t rx_dma_buffer[UART_RX_DMA_BUFFER_SIZE];
+    os_stream_buffer_handle_t rx_stream;  // Copy-mode RX: service work writes, hal_uart_read() reads
+    uint8_t *rx_dma_buffer;           // Circular DMA target (in the non-cacheable DMA section)
+    size_t rx_dma_size;               // Ring length in use
+    size_t rx_dma_capacity;           // Pool region reserved for the port (kept across deinit)
+
+    // RX: interrupts, the service work and the zero-copy reader
+    os_work_t service_work HAL_CACHE_ALIGNED;  // Bottom half of the port's interrupts
+    volatile bool rx_idle;                // Line went idle, wake the reader below its trigger level
     size_t last_rx_dma_pos;
-    volatile bool tx_in_progress;  // Flag for async TX
+    volatile size_t rx_dma_read_pos;  // Consumer position in rx_dma_buffer (zero-copy mode)
+    volatile hal_uart_isr_counters_t counters;           // ISR and RX overflow diagnostics
+
+    // TX: writers and the TX complete interrupt
+    volatile bool tx_in_progress HAL_CACHE_ALIGNED;  // Flag for async TX
+    volatile size_t tx_head;                             // Next free queue slot
+    volatile size_t tx_tail;                             // Segment currently on DMA
+    bool tx_frame_end[UART_TX_QUEUE_SIZE];               // Segment completes a write (TX_DONE)
+    hal_uart_tx_segment_t tx_queue[UART_TX_QUEUE_SIZE];  // Pending DMA TX segments
 } hal_uart_state_t;
 
 static hal_uart_state_t uart_state[HAL_UART_PORT_MAX] = {0};
 
-// Debug counters for ISR monitoring
-static volatile uint32_t debug_idle_isr_count = 0;
-static volatile uint32_t debug_dma_ht_count = 0;
-static volatile uint32_t debug_dma_tc_count = 0;
+// DMA RX rings live in the non-cacheable section so the CPU never reads stale cache lines
+static uint8_t uart_rx_dma_pool[UART_RX_DMA_POOL_SIZE] HAL_DMA_BUFFER;
+static size_t uart_rx_dma_pool_used;
+
+// Per-port kernel objects in static storage (reused after deinit)
+static uint8_t uart_event_queue_buffer[HAL_UART_PORT_MAX][UART_EVENT_QUEUE_SIZE * sizeof(hal_uart_event_t)]
+    __attribute__((aligned(8)));
+static os_queue_storage_t uart_event_queue_storage[HAL_UART_PORT_MAX];
+
+// Ports are serviced on the shared work queue; the lock keeps deinit out of a service pass
+static os_mutex_storage_t uart_event_lock_storage;
+static os_mutex_handle_t uart_event_lock;
 
-// External UART handles (should be defined in main.c or generated by CubeMX)
-// Only declare the UARTs that are actually configured in CubeMX
-extern UART_HandleTypeDef huart2;  // USART2 is configured
+// UART handles generated by CubeMX. Only USART2 is configured today; the
+// weak references resolve to NULL for USARTs CubeMX does not generate
+extern UART_HandleTypeDef huart1 __attribute__((weak));
+extern UART_HandleTypeDef huart2 __attribute__((weak));
+extern UART_HandleTypeDef huart3 __attribute__((weak));
 
 /**
- * @brief Get STM32 UART handle for a port
+ * @brief Get STM32 UART handle for a port (NULL if not configured)
  */
 static UART_HandleTypeDef* get_uart_handle(hal_uart_port_t port)
 {
     switch (port) {
-        case HAL_UART_PORT_0: return NULL;  // USART1 not configured
-        case HAL_UART_PORT_1: return &huart2;  // USART2 configured
-        case HAL_UART_PORT_2: return NULL;  // USART3 not configured
+        case HAL_UART_PORT_0: return &huart1;  // USART1
+        case HAL_UART_PORT_1: return &huart2;  // USART2
+        case HAL_UART_PORT_2: return &huart3;  // USART3
         default: return NULL;
     }
 }
 
+/**
+ * @brief Find the initialized port a HAL handle belongs to (ISR callbacks)
+ * @return Port, or HAL_UART_PORT_MAX if none
+ */
+static hal_uart_port_t find_port(const UART_HandleTypeDef *huart)
+{
+    for (hal_uart_port_t port = HAL_UART_PORT_0; port < HAL_UART_PORT_MAX; port++) {
+        if (uart_state[port].huart == huart && uart_state[port].initialized) {
+            return port;
+        }
+    }
+    return HAL_UART_PORT_MAX;
+}
+
+/**
+ * @brief Have the work queue service a port (ISR context)
+ *
+ * Interrupts of one burst coalesce into one pending service pass.
+ */
+static void uart_notify_from_isr(hal_uart_port_t port)
+{
+    os_work_submit(&uart_state[port].service_work);
+}
+
+/**
+ * @brief Queue an event for a port's callback and have the port serviced (ISR context)
+ */
+static void uart_post_from_isr(hal_uart_port_t port, const hal_uart_event_t *event)
+{
+    if (uart_state[port].event_queue) {
+        bool higher_priority_task_woken = false;
+        os_queue_send_from_isr(uart_state[port].event_queue, event, &higher_priority_task_woken);
+        os_yield_from_isr(higher_priority_task_woken);
+    }
+    uart_notify_from_isr(port);
+}
+
 /**
  * @brief Convert HAL parity to STM32 parity
  */
@@ -100,90 +171,189 @@ static uint32_t convert_flow_ctrl(hal_uart_flow_ctrl_t flow_ctrl)
 }
 
 /**
- * @brief Convert HAL data bits to STM32 word length
+ * @brief Kernel clock of a USART (CubeMX selects PCLK for all of them)
  */
-static uint32_t convert_data_bits(uint8_t data_bits)
+static uint32_t uart_kernel_clock_hz(const UART_HandleTypeDef *huart)
 {
-    switch (data_bits) {
-        case 7: return UART_WORDLENGTH_7B;
-        case 9: return UART_WORDLENGTH_9B;
-        default: return UART_WORDLENGTH_8B;
+    if (huart->Instance == USART1 || huart->Instance == USART6) {
+        return HAL_RCC_GetPCLK2Freq();
     }
+    return HAL_RCC_GetPCLK1Freq();
 }
 
 /**
- * @brief Calculate buffer available bytes
+ * @brief Pick the oversampling for a baud rate
+ *
+ * Oversampling by 16 while the divider allows it (better noise tolerance),
+ * by 8 above kernel clock / 16, which doubles the top rate.
+ *
+ * @param oversampling Set to UART_OVERSAMPLING_16 or UART_OVERSAMPLING_8
+ * @return false if the clock cannot make the rate within UART_BAUD_MAX_ERROR_PERMILLE
  */
-static size_t buffer_available(hal_uart_state_t *state)
+static bool uart_select_oversampling(const UART_HandleTypeDef *huart, uint32_t baud_rate,
+                                     uint32_t *oversampling)
 {
-    size_t write_pos = state->rx_write_pos;
-    size_t read_pos = state->rx_read_pos;
+    uint32_t clock = uart_kernel_clock_hz(huart);
 
-    if (write_pos >= read_pos) {
-        return write_pos - read_pos;
+    if (baud_rate == 0 || clock / baud_rate < 8) {
+        return false;
+    }
+
+    // USARTDIV = clock / baud (OVER16) or 2 * clock / baud (OVER8), rounded
+    uint32_t samples = (clock / baud_rate >= 16) ? 16 : 8;
+    uint64_t scaled_clock = (uint64_t)clock * (16U / samples);
+    uint32_t divider = (uint32_t)((scaled_clock + baud_rate / 2) / baud_rate);
+    uint32_t actual = (uint32_t)(scaled_clock / divider);
+    uint32_t error = (actual > baud_rate) ? actual - baud_rate : baud_rate - actual;
+
+    if ((uint64_t)error * 1000U > (uint64_t)baud_rate * UART_BAUD_MAX_ERROR_PERMILLE) {
+        return false;
+    }
+
+    *oversampling = (samples == 16) ? UART_OVERSAMPLING_16 : UART_OVERSAMPLING_8;
+    return true;
+}
+
+/**
+ * @brief End bursts on the receiver timeout, or on IDLE if bits is 0
+ * @note Call with interrupts masked: TX completion updates CR1 from its ISR
+ */
+static void uart_apply_rx_timeout(UART_HandleTypeDef *huart, uint32_t bits)
+{
+    if (bits > 0) {
+        MODIFY_REG(huart->Instance->RTOR, USART_RTOR_RTO, bits);
+        SET_BIT(huart->Instance->CR2, USART_CR2_RTOEN);
+        __HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_RTOF);
+        __HAL_UART_DISABLE_IT(huart, UART_IT_IDLE);
+        __HAL_UART_ENABLE_IT(huart, UART_IT_RTO);
     } else {
-        return state->rx_buffer_size - read_pos + write_pos;
+        __HAL_UART_DISABLE_IT(huart, UART_IT_RTO);
+        CLEAR_BIT(huart->Instance->CR2, USART_CR2_RTOEN);
+        __HAL_UART_CLEAR_IDLEFLAG(huart);
+        __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
     }
 }
 
 /**
- * @brief Write data to RX ring buffer
+ * @brief Raise the character match interrupt on match_char (-1 = off)
+ * @note Call with interrupts masked, see uart_apply_rx_timeout()
  */
-static size_t buffer_write(hal_uart_state_t *state, const uint8_t *data, size_t len)
+static void uart_apply_rx_match(UART_HandleTypeDef *huart, int16_t match_char)
 {
-    if (state->rx_buffer == NULL) {
-        return 0;
+    __HAL_UART_DISABLE_IT(huart, UART_IT_CM);
+
+    if (match_char < 0) {
+        return;
     }
 
-    size_t written = 0;
-    size_t write_pos = state->rx_write_pos;
-    size_t read_pos = state->rx_read_pos;
+    // ADD only takes writes with the receiver off; ADDM7 compares all 8 bits
+    CLEAR_BIT(huart->Instance->CR1, USART_CR1_RE);
+    MODIFY_REG(huart->Instance->CR2, USART_CR2_ADD | USART_CR2_ADDM7,
+               ((uint32_t)(uint8_t)match_char << USART_CR2_ADD_Pos) | USART_CR2_ADDM7);
+    SET_BIT(huart->Instance->CR1, USART_CR1_RE);
 
-    for (size_t i = 0; i < len; i++) {
-        size_t next_write_pos = (write_pos + 1) % state->rx_buffer_size;
+    __HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_CMF);
+    __HAL_UART_ENABLE_IT(huart, UART_IT_CM);
+}
 
-        // Check if buffer is full
-        if (next_write_pos == read_pos) {
-            // Buffer overflow - trigger event
-            hal_uart_event_t event = {
-                .type = HAL_UART_EVENT_RX_OVERFLOW,
-                .size = 0
-            };
-            if (state->event_queue) {
-                os_queue_send(state->event_queue, &event, OS_NO_WAIT);
-            }
-            break;
-        }
+/**
+ * @brief RX DMA ring size a configuration asks for
+ */
+static size_t rx_dma_config_size(const hal_uart_config_t *config)
+{
+    if (config->rx_dma_buffer_size > 0) {
+        return config->rx_dma_buffer_size;
+    }
+    if (config->rx_max_latency_ms > 0) {
+        return hal_uart_rx_dma_size_for(config->baud_rate, config->rx_max_latency_ms);
+    }
+    return UART_RX_DMA_BUFFER_SIZE;
+}
+
+/**
+ * @brief Give a port its RX DMA ring from the pool
+ *
+ * A port keeps its region across deinit and reuses it when the new ring
+ * fits; a larger ring takes a fresh region (the old one is not returned).
+ */
+static bool rx_dma_buffer_reserve(hal_uart_port_t port, size_t size)
+{
+    hal_uart_state_t *state = &uart_state[port];
 
-        state->rx_buffer[write_pos] = data[i];
-        write_pos = next_write_pos;
-        written++;
+    if (size > state->rx_dma_capacity) {
+        // Keep regions 32-byte aligned like the rest of the DMA section
+        size_t region = (size + 31U) & ~(size_t)31U;
+        if (region > UART_RX_DMA_POOL_SIZE - uart_rx_dma_pool_used) {
+            return false;
+        }
+        state->rx_dma_buffer = &uart_rx_dma_pool[uart_rx_dma_pool_used];
+        state->rx_dma_capacity = region;
+        uart_rx_dma_pool_used += region;
     }
 
-    state->rx_write_pos = write_pos;
-    return written;
+    state->rx_dma_size = size;
+    return true;
 }
 
 /**
- * @brief Read data from RX ring buffer
+ * @brief Convert HAL data bits to STM32 word length
  */
-static size_t buffer_read(hal_uart_state_t *state, uint8_t *data, size_t len)
+static uint32_t convert_data_bits(uint8_t data_bits)
 {
-    if (state->rx_buffer == NULL) {
-        return 0;
+    switch (data_bits) {
+        case 7: return UART_WORDLENGTH_7B;
+        case 9: return UART_WORDLENGTH_9B;
+        default: return UART_WORDLENGTH_8B;
     }
+}
 
-    size_t read = 0;
-    size_t write_pos = state->rx_write_pos;
-    size_t read_pos = state->rx_read_pos;
+/**
+ * @brief Copy DMA data into the RX stream buffer
+ */
+static void rx_stream_write(hal_uart_state_t *state, const uint8_t *data, size_t len)
+{
+    size_t sent = os_stream_buffer_send(state->rx_stream, data, len, OS_NO_WAIT);
+    size_t buffered = os_stream_buffer_bytes_available(state->rx_stream);
 
-    while (read < len && read_pos != write_pos) {
-        data[read++] = state->rx_buffer[read_pos];
-        read_pos = (read_pos + 1) % state->rx_buffer_size;
+    if (buffered > state->counters.rx_high_water) {
+        state->counters.rx_high_water = buffered;
     }
 
-    state->rx_read_pos = read_pos;
-    return read;
+    if (sent < len) {
+        // Reader fell behind, the rest is lost
+        state->counters.rx_dropped_bytes += len - sent;
+        hal_uart_event_t event = {
+            .type = HAL_UART_EVENT_RX_OVERFLOW,
+            .size = 0
+        };
+        if (state->event_queue) {
+            os_queue_send(state->event_queue, &event, OS_NO_WAIT);
+        }
+    }
+}
+
+/**
+ * @brief Get current DMA write position in rx_dma_buffer
+ */
+static size_t dma_write_pos(hal_uart_state_t *state)
+{
+    size_t pos = state->rx_dma_size - __HAL_DMA_GET_COUNTER(state->huart->hdmarx);
+    return (pos >= state->rx_dma_size) ? 0 : pos;
+}
+
+/**
+ * @brief Bytes pending in rx_dma_buffer (zero-copy mode)
+ */
+static size_t dma_available(hal_uart_state_t *state)
+{
+    size_t write_pos = dma_write_pos(state);
+    size_t read_pos = state->rx_dma_read_pos;
+
+    if (write_pos >= read_pos) {
+        return write_pos - read_pos;
+    } else {
+        return state->rx_dma_size - read_pos + write_pos;
+    }
 }
 
 /**
@@ -198,21 +368,38 @@ static void process_dma_rx(hal_uart_port_t port)
     }
 
     // Get current DMA position
-    size_t current_pos = UART_RX_DMA_BUFFER_SIZE - __HAL_DMA_GET_COUNTER(state->huart->hdmarx);
+    size_t current_pos = dma_write_pos(state);
     size_t last_pos = state->last_rx_dma_pos;
 
     if (current_pos != last_pos) {
         size_t received;
 
-        if (current_pos > last_pos) {
+        if (state->rx_zero_copy) {
+            // Data stays in rx_dma_buffer, only count it for the RX event
+            received = (current_pos > last_pos) ? current_pos - last_pos
+                                                : state->rx_dma_size - last_pos + current_pos;
+
+            // Bytes announced earlier but not consumed yet, plus the new ones
+            size_t read_pos = state->rx_dma_read_pos;
+            size_t unread = ((last_pos >= read_pos) ? last_pos - read_pos
+                                                    : state->rx_dma_size - read_pos + last_pos)
+                            + received;
+            if (unread >= state->rx_dma_size) {
+                state->counters.dma_overruns++;
+                unread = state->rx_dma_size;
+            }
+            if (unread > state->counters.rx_high_water) {
+                state->counters.rx_high_water = unread;
+            }
+        } else if (current_pos > last_pos) {
             // Normal case: DMA hasn't wrapped
             received = current_pos - last_pos;
-            buffer_write(state, &state->rx_dma_buffer[last_pos], received);
+            rx_stream_write(state, &state->rx_dma_buffer[last_pos], received);
         } else {
             // DMA wrapped around
-            size_t to_end = UART_RX_DMA_BUFFER_SIZE - last_pos;
-            buffer_write(state, &state->rx_dma_buffer[last_pos], to_end);
-            buffer_write(state, state->rx_dma_buffer, current_pos);
+            size_t to_end = state->rx_dma_size - last_pos;
+            rx_stream_write(state, &state->rx_dma_buffer[last_pos], to_end);
+            rx_stream_write(state, state->rx_dma_buffer, current_pos);
             received = to_end + current_pos;
         }
 
@@ -232,33 +419,64 @@ static void process_dma_rx(hal_uart_port_t port)
 }
 
 /**
- * @brief UART event processing task
+ * @brief Drain one port: DMA data, end-of-burst wakeup, queued events
+ */
+static void uart_service_port(hal_uart_port_t port)
+{
+    hal_uart_event_t event;
+
+    // Process DMA buffer (new data arrived)
+    process_dma_rx(port);
+
+    // End of a burst: hand a short read to the reader without waiting
+    // for the trigger level
+    if (uart_state[port].rx_idle) {
+        uart_state[port].rx_idle = false;
+        if (!uart_state[port].rx_zero_copy) {
+            os_stream_buffer_wake_reader(uart_state[port].rx_stream);
+        }
+    }
+
+    // Process queued events
+    while (os_queue_receive(uart_state[port].event_queue, &event, OS_NO_WAIT) == OS_SUCCESS) {
+        if (uart_state[port].callback != NULL) {
+            uart_state[port].callback(port, &event, uart_state[port].user_data);
+        }
+    }
+}
+
+/**
+ * @brief Bottom half of a port's interrupts, run on the shared work queue
  *
- * Blocks on rx_data_sem which is signaled by:
- * - UART IDLE interrupt (line idle after receiving data)
+ * Submitted by the port's:
+ * - UART IDLE, receiver timeout or character match interrupt (end of a burst or frame)
  * - DMA Half-Transfer interrupt (buffer half full)
  * - DMA Transfer-Complete interrupt (buffer full, wraparound)
+ * - TX complete and error interrupts (queued events)
  */
-static void uart_event_task(void *arg)
+static void uart_service_work(void *ctx)
 {
-    hal_uart_port_t port = (hal_uart_port_t)(uintptr_t)arg;
-    hal_uart_event_t event;
-
-    while (1) {
-        // Block until RX data available (signaled by ISR) or timeout
-        // Use 100ms timeout as safety fallback
-        os_semaphore_take(uart_state[port].rx_data_sem, 100);
+    hal_uart_port_t port = (hal_uart_port_t)(uintptr_t)ctx;
 
-        // Process DMA buffer (new data arrived)
-        process_dma_rx(port);
+    os_mutex_take(uart_event_lock, OS_WAIT_FOREVER);
+    if (uart_state[port].initialized) {
+        uart_service_port(port);
+    }
+    os_mutex_give(uart_event_lock);
+}
 
-        // Process queued events
-        while (os_queue_receive(uart_state[port].event_queue, &event, OS_NO_WAIT) == OS_SUCCESS) {
-            if (uart_state[port].callback != NULL) {
-                uart_state[port].callback(port, &event, uart_state[port].user_data);
-            }
+/**
+ * @brief Create the service lock and start the work queue with the first port
+ */
+static bool uart_service_start(void)
+{
+    if (uart_event_lock == NULL) {
+        uart_event_lock = os_mutex_create_static(&uart_event_lock_storage);
+        if (uart_event_lock == NULL) {
+            return false;
         }
     }
+    return os_workqueue_start();
 }
 
 bool hal_uart_init(hal_uart_port_t port, const hal_uart_config_t *config)
@@ -273,13 +491,28 @@ bool hal_uart_init(hal_uart_port_t port, const hal_uart_config_t *config)
         return false;
     }
 
+    if (config->rx_timeout_bits > USART_RTOR_RTO || config->rx_match_char > 0xFF) {
+        LOG_E(TAG, "UART%d invalid end-of-frame settings", port);
+        return false;
+    }
+
+    size_t rx_dma_size = rx_dma_config_size(config);
+    if (rx_dma_size < UART_RX_DMA_BUFFER_MIN || rx_dma_size > UINT16_MAX
+        || !rx_dma_buffer_reserve(port, rx_dma_size)) {
+        LOG_E(TAG, "UART%d RX DMA ring of %u bytes unavailable (pool %u, used %u)", port,
+              (unsigned)rx_dma_size, (unsigned)UART_RX_DMA_POOL_SIZE,
+              (unsigned)uart_rx_dma_pool_used);
+        return false;
+    }
+
     UART_HandleTypeDef *huart = get_uart_handle(port);
     if (huart == NULL) {
         LOG_E(TAG, "UART%d handle not available", port);
         return false;
     }
 
-    LOG_I(TAG, "Initializing UART%d (baud=%lu)", port, (unsigned long)config->baud_rate);
+    LOG_I(TAG, "Initializing UART%d (baud=%lu, rx dma=%u)", port, (unsigned long)config->baud_rate,
+          (unsigned)rx_dma_size);
 
     // Configure UART parameters
     huart->Init.BaudRate = config->baud_rate;
@@ -288,67 +521,62 @@ bool hal_uart_init(hal_uart_port_t port, const hal_uart_config_t *config)
     huart->Init.Parity = convert_parity(config->parity);
     huart->Init.Mode = UART_MODE_TX_RX;
     huart->Init.HwFlowCtl = convert_flow_ctrl(config->flow_ctrl);
-    huart->Init.OverSampling = UART_OVERSAMPLING_16;
+    if (!uart_select_oversampling(huart, config->baud_rate, &huart->Init.OverSampling)) {
+        LOG_E(TAG, "UART%d cannot run at %lu baud", port, (unsigned long)config->baud_rate);
+        return false;
+    }
 
     if (HAL_UART_Init(huart) != HAL_OK) {
         LOG_E(TAG, "UART%d initialization failed", port);
         return false;
     }
 
-    // Allocate RX buffer
+    // RX stream buffer; readers wake on every byte until hal_uart_set_rx_trigger()
     size_t rx_buf_size = config->rx_buffer_size > 0 ? config->rx_buffer_size : 1024;
-    uart_state[port].rx_buffer = (uint8_t*)malloc(rx_buf_size);
-    if (uart_state[port].rx_buffer == NULL) {
+    uart_state[port].rx_stream = os_stream_buffer_create(rx_buf_size, 1);
+    if (uart_state[port].rx_stream == NULL) {
         LOG_E(TAG, "UART%d RX buffer allocation failed", port);
         HAL_UART_DeInit(huart);
         return false;
     }
 
-    uart_state[port].rx_buffer_size = rx_buf_size;
-    uart_state[port].rx_write_pos = 0;
-    uart_state[port].rx_read_pos = 0;
+    uart_state[port].rx_idle = false;
     uart_state[port].last_rx_dma_pos = 0;
+    uart_state[port].rx_dma_read_pos = 0;
+    uart_state[port].rx_zero_copy = false;
+    uart_state[port].tx_head = 0;
+    uart_state[port].tx_tail = 0;
+    uart_state[port].tx_in_progress = false;
+    memset((void *)&uart_state[port].counters, 0, sizeof(uart_state[port].counters));
+    uart_state[port].counters.rx_dma_buffer_size = (uint32_t)rx_dma_size;
 
     // Create event queue
-    uart_state[port].event_queue = os_queue_create(UART_EVENT_QUEUE_SIZE, sizeof(hal_uart_event_t));
+    uart_state[port].event_queue = os_queue_create_static(UART_EVENT_QUEUE_SIZE, sizeof(hal_uart_event_t),
+                                                          uart_event_queue_buffer[port],
+                                                          &uart_event_queue_storage[port]);
     if (uart_state[port].event_queue == NULL) {
         LOG_E(TAG, "UART%d event queue creation failed", port);
-        free(uart_state[port].rx_buffer);
-        HAL_UART_DeInit(huart);
-        return false;
-    }
-
-    // Create RX data semaphore (binary, initially empty)
-    uart_state[port].rx_data_sem = os_semaphore_create_binary();
-    if (uart_state[port].rx_data_sem == NULL) {
-        LOG_E(TAG, "UART%d RX semaphore creation failed", port);
-        os_queue_delete(uart_state[port].event_queue);
-        free(uart_state[port].rx_buffer);
+        os_stream_buffer_delete(uart_state[port].rx_stream);
         HAL_UART_DeInit(huart);
         return false;
     }
 
-    // Create event processing task
-    char task_name[16];
-    snprintf(task_name, sizeof(task_name), "uart%d_evt", port);
-
-    os_result_t ret = os_task_create(uart_event_task, task_name,
-                                     UART_EVENT_TASK_STACK, (void *)(uintptr_t)port,
-                                     OS_PRIORITY_HIGH, &uart_state[port].event_task);
-    if (ret != OS_SUCCESS) {
-        LOG_E(TAG, "UART%d event task create failed", port);
-        os_semaphore_delete(uart_state[port].rx_data_sem);
+    // Interrupt bottom half on the shared work queue
+    os_work_init(&uart_state[port].service_work, uart_service_work, (void *)(uintptr_t)port);
+    if (!uart_service_start()) {
+        LOG_E(TAG, "UART%d work queue start failed", port);
         os_queue_delete(uart_state[port].event_queue);
-        free(uart_state[port].rx_buffer);
+        os_stream_buffer_delete(uart_state[port].rx_stream);
         HAL_UART_DeInit(huart);
         return false;
     }
 
     // Start DMA reception in circular mode
-    HAL_UART_Receive_DMA(huart, uart_state[port].rx_dma_buffer, UART_RX_DMA_BUFFER_SIZE);
+    uart_apply_rx_match(huart, config->rx_match_char);
+    HAL_UART_Receive_DMA(huart, uart_state[port].rx_dma_buffer, (uint16_t)uart_state[port].rx_dma_size);
 
-    // Enable UART IDLE interrupt for efficient packet detection
-    __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+    // End-of-burst wakeup: IDLE line, or the receiver timeout if configured
+    uart_apply_rx_timeout(huart, config->rx_timeout_bits);
 
     uart_state[port].initialized = true;
     uart_state[port].huart = huart;
@@ -369,38 +597,32 @@ bool hal_uart_deinit(hal_uart_port_t port)
         return true;
     }
 
-    // Stop DMA and disable IDLE interrupt
+    // Wait out a service pass on the work queue; later passes skip the port
+    os_mutex_take(uart_event_lock, OS_WAIT_FOREVER);
+    uart_state[port].initialized = false;
+    os_mutex_give(uart_event_lock);
+
+    // Stop DMA and disable the end-of-burst interrupts
     if (uart_state[port].huart != NULL) {
         __HAL_UART_DISABLE_IT(uart_state[port].huart, UART_IT_IDLE);
+        __HAL_UART_DISABLE_IT(uart_state[port].huart, UART_IT_RTO);
+        __HAL_UART_DISABLE_IT(uart_state[port].huart, UART_IT_CM);
         HAL_UART_DMAStop(uart_state[port].huart);
         HAL_UART_DeInit(uart_state[port].huart);
     }
 
-    // Delete event task
-    if (uart_state[port].event_task) {
-        os_task_delete(uart_state[port].event_task);
-        uart_state[port].event_task = NULL;
-    }
-
-    // Delete RX data semaphore
-    if (uart_state[port].rx_data_sem) {
-        os_semaphore_delete(uart_state[port].rx_data_sem);
-        uart_state[port].rx_data_sem = NULL;
-    }
-
     // Delete event queue
     if (uart_state[port].event_queue) {
         os_queue_delete(uart_state[port].event_queue);
         uart_state[port].event_queue = NULL;
     }
 
-    // Free RX buffer
-    if (uart_state[port].rx_buffer) {
-        free(uart_state[port].rx_buffer);
-        uart_state[port].rx_buffer = NULL;
+    // Delete RX stream buffer
+    if (uart_state[port].rx_stream) {
+        os_stream_buffer_delete(uart_state[port].rx_stream);
+        uart_state[port].rx_stream = NULL;
     }
 
-    uart_state[port].initialized = false;
     uart_state[port].huart = NULL;
     uart_state[port].callback = NULL;
     uart_state[port].user_data = NULL;
@@ -433,35 +655,108 @@ int hal_uart_write(hal_uart_port_t port, const uint8_t *data, size_t len, int ti
     }
 }
 
+/**
+ * @brief Number of segments waiting in (or on) the TX queue
+ */
+static size_t tx_queue_count(hal_uart_state_t *state)
+{
+    return (state->tx_head + UART_TX_QUEUE_SIZE - state->tx_tail) % UART_TX_QUEUE_SIZE;
+}
+
+/**
+ * @brief Start DMA for the segment at the queue tail
+ * @note Called with interrupts disabled or from the TX complete ISR
+ */
+static bool tx_start_segment(hal_uart_state_t *state)
+{
+    hal_uart_tx_segment_t *segment = &state->tx_queue[state->tx_tail];
+
+    // Caller buffers may sit in cacheable RAM: write them back before DMA reads them
+    hal_cache_clean(segment->data, segment->len);
+
+    if (HAL_UART_Transmit_DMA(state->huart, (uint8_t*)segment->data, segment->len) != HAL_OK) {
+        return false;
+    }
+
+    state->tx_in_progress = true;
+    hal_power_stop_lock();
+    LATENCY_TRACE_MARK(LATENCY_STAGE_TX_DMA_START);
+    return true;
+}
+
 bool hal_uart_write_async(hal_uart_port_t port, const uint8_t *data, size_t len)
+{
+    hal_uart_tx_segment_t segment = { .data = data, .len = len };
+    return hal_uart_write_async_sg(port, &segment, 1);
+}
+
+bool hal_uart_write_async_sg(hal_uart_port_t port, const hal_uart_tx_segment_t *segments,
+                             size_t count)
 {
     if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized) {
         LOG_E(TAG, "UART%d not initialized", port);
         return false;
     }
 
-    if (data == NULL || len == 0) {
+    if (segments == NULL || count == 0) {
         LOG_E(TAG, "UART%d invalid parameters", port);
         return false;
     }
 
-    // Check if transmission is already in progress
-    if (uart_state[port].tx_in_progress) {
-        LOG_W(TAG, "UART%d TX already in progress", port);
+    hal_uart_state_t *state = &uart_state[port];
+    size_t used = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (segments[i].data != NULL && segments[i].len > 0) {
+            used++;
+        }
+    }
+
+    if (used == 0) {
+        LOG_E(TAG, "UART%d invalid parameters", port);
         return false;
     }
 
-    UART_HandleTypeDef *huart = uart_state[port].huart;
+    // The TX complete ISR owns the tail, so queue updates run with IRQs masked
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (tx_queue_count(state) + used > UART_TX_QUEUE_SIZE - 1) {
+        __set_PRIMASK(primask);
+        LOG_W_LIMITED(TAG, UART_ERROR_LOG_INTERVAL_MS, "UART%d TX queue full", port);
+        return false;
+    }
+
+    bool was_idle = (tx_queue_count(state) == 0);
+    size_t head = state->tx_head;
+    size_t last = head;
+
+    for (size_t i = 0; i < count; i++) {
+        if (segments[i].data == NULL || segments[i].len == 0) {
+            continue;
+        }
+        state->tx_queue[head] = segments[i];
+        state->tx_frame_end[head] = false;
+        last = head;
+        head = (head + 1) % UART_TX_QUEUE_SIZE;
+    }
+    state->tx_frame_end[last] = true;
+    state->tx_head = head;
+
+    bool started = true;
+    if (was_idle) {
+        started = tx_start_segment(state);
+        if (!started) {
+            state->tx_head = state->tx_tail;  // Drop what we just queued
+        }
+    }
 
-    // Start DMA transmission
-    HAL_StatusTypeDef status = HAL_UART_Transmit_DMA(huart, (uint8_t*)data, len);
+    __set_PRIMASK(primask);
 
-    if (status != HAL_OK) {
-        LOG_E(TAG, "UART%d DMA TX start failed: %d", port, status);
+    if (!started) {
+        LOG_E(TAG, "UART%d DMA TX start failed", port);
         return false;
     }
 
-    uart_state[port].tx_in_progress = true;
     return true;
 }
 
@@ -473,6 +768,38 @@ bool hal_uart_tx_busy(hal_uart_port_t port)
     return uart_state[port].tx_in_progress;
 }
 
+/**
+ * @brief hal_uart_read() for zero-copy mode (single copy out of rx_dma_buffer)
+ */
+static int rx_read_zero_copy(hal_uart_port_t port, uint8_t *data, size_t len, int timeout_ms)
+{
+    uint32_t start_time = os_get_time_ms();
+    size_t total_read = 0;
+
+    while (total_read < len) {
+        const uint8_t *span;
+        size_t n = hal_uart_rx_peek(port, &span);
+
+        if (n > 0) {
+            if (n > len - total_read) {
+                n = len - total_read;
+            }
+            memcpy(data + total_read, span, n);
+            hal_uart_rx_consume(port, n);
+            total_read += n;
+            continue;
+        }
+
+        if (timeout_ms >= 0 && (os_get_time_ms() - start_time) >= (uint32_t)timeout_ms) {
+            break;
+        }
+
+        os_delay_ms(1);
+    }
+
+    return (int)total_read;
+}
+
 int hal_uart_read(hal_uart_port_t port, uint8_t *data, size_t len, int timeout_ms)
 {
     if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized) {
@@ -484,33 +811,31 @@ int hal_uart_read(hal_uart_port_t port, uint8_t *data, size_t len, int timeout_m
     }
 
     hal_uart_state_t *state = &uart_state[port];
-    uint32_t start_time = os_get_time_ms();
-    uint32_t timeout_time = (timeout_ms < 0) ? 0xFFFFFFFF : start_time + timeout_ms;
 
+    if (state->rx_zero_copy) {
+        return rx_read_zero_copy(port, data, len, timeout_ms);
+    }
+
+    uint32_t start_time = os_get_time_ms();
     size_t total_read = 0;
 
+    // The service work fills the stream; each receive blocks until the
+    // trigger level is buffered, the line goes idle or the time is up
     while (total_read < len) {
-        // Process any new DMA data
-        process_dma_rx(port);
+        uint32_t wait_ms = OS_WAIT_FOREVER;
+
+        if (timeout_ms >= 0) {
+            uint32_t elapsed = os_get_time_ms() - start_time;
+            wait_ms = (elapsed < (uint32_t)timeout_ms) ? (uint32_t)timeout_ms - elapsed : OS_NO_WAIT;
+        }
 
-        // Try to read from buffer
-        size_t read = buffer_read(state, data + total_read, len - total_read);
+        size_t read = os_stream_buffer_receive(state->rx_stream, data + total_read,
+                                               len - total_read, wait_ms);
         total_read += read;
 
-        if (total_read >= len) {
+        if (read == 0 && wait_ms == OS_NO_WAIT) {
             break;
         }
-
-        // Check timeout
-        if (timeout_ms >= 0) {
-            uint32_t current_time = os_get_time_ms();
-            if (current_time >= timeout_time) {
-                break;
-            }
-        }
-
-        // Wait a bit before trying again
-        os_delay_ms(1);
     }
 
     return (int)total_read;
@@ -522,10 +847,96 @@ int hal_uart_available(hal_uart_port_t port)
         return -1;
     }
 
-    // Process any new DMA data first
-    process_dma_rx(port);
+    if (uart_state[port].rx_zero_copy) {
+        return (int)dma_available(&uart_state[port]);
+    }
+
+    return (int)os_stream_buffer_bytes_available(uart_state[port].rx_stream);
+}
+
+bool hal_uart_rx_set_zero_copy(hal_uart_port_t port, bool enable)
+{
+    if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized) {
+        return false;
+    }
+
+    hal_uart_state_t *state = &uart_state[port];
+
+    // Start consuming at the DMA position; anything not yet drained is dropped
+    state->rx_dma_read_pos = dma_write_pos(state);
+    state->last_rx_dma_pos = state->rx_dma_read_pos;
+    os_stream_buffer_reset(state->rx_stream);
+    state->rx_zero_copy = enable;
+    return true;
+}
+
+bool hal_uart_set_rx_trigger(hal_uart_port_t port, size_t bytes)
+{
+    if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized) {
+        return false;
+    }
+
+    return os_stream_buffer_set_trigger_level(uart_state[port].rx_stream, bytes) == OS_SUCCESS;
+}
+
+bool hal_uart_set_rx_timeout(hal_uart_port_t port, uint32_t bits)
+{
+    if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized || bits > USART_RTOR_RTO) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uart_apply_rx_timeout(uart_state[port].huart, bits);
+    __set_PRIMASK(primask);
+    return true;
+}
+
+bool hal_uart_set_rx_match(hal_uart_port_t port, int16_t match_char)
+{
+    if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized || match_char > 0xFF) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uart_apply_rx_match(uart_state[port].huart, match_char);
+    __set_PRIMASK(primask);
+    return true;
+}
+
+size_t hal_uart_rx_peek(hal_uart_port_t port, const uint8_t **data)
+{
+    if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized ||
+        !uart_state[port].rx_zero_copy || data == NULL) {
+        return 0;
+    }
 
-    return (int)buffer_available(&uart_state[port]);
+    hal_uart_state_t *state = &uart_state[port];
+    size_t write_pos = dma_write_pos(state);
+    size_t read_pos = state->rx_dma_read_pos;
+
+    *data = &state->rx_dma_buffer[read_pos];
+
+    // Only hand out the contiguous part; the wrapped tail comes on the next peek
+    return (write_pos >= read_pos) ? write_pos - read_pos : state->rx_dma_size - read_pos;
+}
+
+void hal_uart_rx_consume(hal_uart_port_t port, size_t len)
+{
+    if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized ||
+        !uart_state[port].rx_zero_copy) {
+        return;
+    }
+
+    hal_uart_state_t *state = &uart_state[port];
+    size_t pending = dma_available(state);
+
+    if (len > pending) {
+        len = pending;
+    }
+
+    state->rx_dma_read_pos = (state->rx_dma_read_pos + len) % state->rx_dma_size;
 }
 
 bool hal_uart_flush_tx(hal_uart_port_t port, int timeout_ms)
@@ -546,9 +957,9 @@ bool hal_uart_flush_rx(hal_uart_port_t port)
 
     hal_uart_state_t *state = &uart_state[port];
 
-    // Reset buffer pointers
-    state->rx_write_pos = 0;
-    state->rx_read_pos = 0;
+    // Drop buffered data (fails while a reader is blocked, which has nothing to drop)
+    os_stream_buffer_reset(state->rx_stream);
+    state->rx_dma_read_pos = dma_write_pos(state);
 
     // Reset event queue
     if (state->event_queue) {
@@ -589,12 +1000,19 @@ bool hal_uart_set_baudrate(hal_uart_port_t port, uint32_t baud_rate)
     }
 
     UART_HandleTypeDef *huart = uart_state[port].huart;
+    uint32_t oversampling;
+
+    if (!uart_select_oversampling(huart, baud_rate, &oversampling)) {
+        LOG_E(TAG, "UART%d cannot run at %lu baud", port, (unsigned long)baud_rate);
+        return false;
+    }
 
     // Stop DMA temporarily
     HAL_UART_DMAStop(huart);
 
-    // Update baud rate
+    // Update baud rate (oversampling by 8 above kernel clock / 16)
     huart->Init.BaudRate = baud_rate;
+    huart->Init.OverSampling = oversampling;
 
     if (HAL_UART_Init(huart) != HAL_OK) {
         LOG_E(TAG, "UART%d set baudrate failed", port);
@@ -603,12 +1021,93 @@ bool hal_uart_set_baudrate(hal_uart_port_t port, uint32_t baud_rate)
 
     // Restart DMA reception
     uart_state[port].last_rx_dma_pos = 0;
-    HAL_UART_Receive_DMA(huart, uart_state[port].rx_dma_buffer, UART_RX_DMA_BUFFER_SIZE);
+    uart_state[port].rx_dma_read_pos = 0;
+    HAL_UART_Receive_DMA(huart, uart_state[port].rx_dma_buffer, (uint16_t)uart_state[port].rx_dma_size);
+
+    LOG_I(TAG, "UART%d baudrate set to %lu (oversampling %d)", port, (unsigned long)baud_rate,
+          (oversampling == UART_OVERSAMPLING_8) ? 8 : 16);
+    return true;
+}
+
+/**
+ * @brief BRR for a baud rate at the port's kernel clock, as HAL_UART_Init() derives it
+ */
+static uint32_t uart_brr(const UART_HandleTypeDef *huart, uint32_t baud_rate, uint32_t oversampling)
+{
+    uint32_t clock = uart_kernel_clock_hz(huart);
 
-    LOG_I(TAG, "UART%d baudrate set to %lu", port, (unsigned long)baud_rate);
+    if (oversampling == UART_OVERSAMPLING_8) {
+        // BRR[3] stays clear, the low nibble of USARTDIV shifts down one bit
+        uint32_t divider = (2U * clock + baud_rate / 2U) / baud_rate;
+        return (divider & 0xFFF0U) | ((divider & 0x000FU) >> 1U);
+    }
+    return (clock + baud_rate / 2U) / baud_rate;
+}
+
+bool hal_uart_tx_is_idle(void)
+{
+    for (hal_uart_port_t port = 0; port < HAL_UART_PORT_MAX; port++) {
+        if (!uart_state[port].initialized) {
+            continue;
+        }
+        // TC: the last stop bit left the shift register as well
+        if (uart_state[port].tx_in_progress ||
+            !__HAL_UART_GET_FLAG(uart_state[port].huart, UART_FLAG_TC)) {
+            return false;
+        }
+    }
     return true;
 }
 
+void hal_uart_clock_changed(void)
+{
+    for (hal_uart_port_t port = 0; port < HAL_UART_PORT_MAX; port++) {
+        UART_HandleTypeDef *huart = uart_state[port].huart;
+        uint32_t oversampling;
+
+        if (!uart_state[port].initialized ||
+            !uart_select_oversampling(huart, huart->Init.BaudRate, &oversampling)) {
+            // The old divider stays: off by the clock ratio, but no worse
+            // than leaving the port unconfigured
+            continue;
+        }
+
+        uint32_t brr = uart_brr(huart, huart->Init.BaudRate, oversampling);
+        if (huart->Instance->BRR == brr && huart->Init.OverSampling == oversampling) {
+            continue;
+        }
+
+        // BRR and OVER8 only change with the USART off; the DMA requests
+        // and the receiver timeout stay configured, a byte being received
+        // is dropped
+        CLEAR_BIT(huart->Instance->CR1, USART_CR1_UE);
+        MODIFY_REG(huart->Instance->CR1, USART_CR1_OVER8, oversampling);
+        huart->Instance->BRR = brr;
+        SET_BIT(huart->Instance->CR1, USART_CR1_UE);
+        huart->Init.OverSampling = oversampling;
+    }
+}
+
+bool hal_uart_baudrate_supported(hal_uart_port_t port, uint32_t baud_rate)
+{
+    UART_HandleTypeDef *huart = get_uart_handle(port);
+    uint32_t oversampling;
+
+    return huart != NULL && uart_select_oversampling(huart, baud_rate, &oversampling);
+}
+
+size_t hal_uart_rx_dma_size_for(uint32_t baud_rate, uint32_t latency_ms)
+{
+    // 10 bits per byte at 8N1; twice that so the half-transfer wakeup has headroom
+    uint64_t bytes = ((uint64_t)baud_rate / 10U) * latency_ms * 2U / 1000U;
+    size_t size = UART_RX_DMA_BUFFER_MIN;
+
+    while (size < bytes && size < UART_RX_DMA_POOL_SIZE) {
+        size *= 2;
+    }
+    return size;
+}
+
 hal_uart_config_t hal_uart_get_default_config(void)
 {
     hal_uart_config_t config = {
@@ -623,6 +1122,10 @@ hal_uart_config_t hal_uart_get_default_config(void)
         .cts_pin = -1,
         .rx_buffer_size = 1024,
         .tx_buffer_size = 0,  // Blocking TX by default
+        .rx_dma_buffer_size = 0,
+        .rx_max_latency_ms = 0,  // Default ring (UART_RX_DMA_BUFFER_SIZE)
+        .rx_timeout_bits = 0,
+        .rx_match_char = -1,
     };
     return config;
 }
@@ -633,21 +1136,27 @@ hal_uart_config_t hal_uart_get_default_config(void)
  */
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
-    // Find which port this UART belongs to
-    hal_uart_port_t port;
-    for (port = HAL_UART_PORT_0; port < HAL_UART_PORT_MAX; port++) {
-        if (uart_state[port].huart == huart) {
-            break;
-        }
-    }
-
-    if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized) {
+    hal_uart_port_t port = find_port(huart);
+    if (port >= HAL_UART_PORT_MAX) {
         return;
     }
 
     hal_uart_event_t event = {0};
     uint32_t error = HAL_UART_GetError(huart);
 
+    if (error & HAL_UART_ERROR_ORE) {
+        uart_state[port].counters.hw_overruns++;
+    }
+
+    // The HAL stops DMA reception on any receive error: resume the ring,
+    // bytes not consumed yet are dropped
+    if (huart->RxState == HAL_UART_STATE_READY) {
+        uart_state[port].last_rx_dma_pos = 0;
+        uart_state[port].rx_dma_read_pos = 0;
+        HAL_UART_Receive_DMA(huart, uart_state[port].rx_dma_buffer,
+                             (uint16_t)uart_state[port].rx_dma_size);
+    }
+
     if (error & HAL_UART_ERROR_PE) {
         event.type = HAL_UART_EVENT_PARITY_ERROR;
     } else if (error & HAL_UART_ERROR_FE) {
@@ -658,143 +1167,129 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
         return; // Ignore other errors
     }
 
-    if (uart_state[port].event_queue) {
-        bool higher_priority_task_woken = false;
-        os_queue_send_from_isr(uart_state[port].event_queue, &event, &higher_priority_task_woken);
-        os_yield_from_isr(higher_priority_task_woken);
-    }
+    uart_post_from_isr(port, &event);
 }
 
 /**
  * @brief UART TX complete callback - called from STM32 HAL when DMA TX completes
  * @note This is called from ISR context, must use FromISR variants
  */
-void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+HAL_ITCM_FUNC void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
-    // Find which port this UART belongs to
-    hal_uart_port_t port;
-    for (port = HAL_UART_PORT_0; port < HAL_UART_PORT_MAX; port++) {
-        if (uart_state[port].huart == huart) {
-            break;
-        }
+    hal_uart_port_t port = find_port(huart);
+    if (port >= HAL_UART_PORT_MAX) {
+        return;
     }
 
-    if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized) {
-        return;
+    hal_uart_state_t *state = &uart_state[port];
+    bool frame_done = state->tx_frame_end[state->tx_tail];
+
+    // Retire the finished segment and chain the next one straight from the ISR
+    state->tx_tail = (state->tx_tail + 1) % UART_TX_QUEUE_SIZE;
+    state->tx_in_progress = false;
+    hal_power_stop_unlock();
+    if (frame_done) {
+        LATENCY_TRACE_MARK(LATENCY_STAGE_TX_DONE);
     }
 
-    // Clear TX in progress flag
-    uart_state[port].tx_in_progress = false;
+    while (tx_queue_count(state) > 0 && !tx_start_segment(state)) {
+        state->tx_tail = (state->tx_tail + 1) % UART_TX_QUEUE_SIZE;  // Skip a segment DMA refused
+    }
 
     // Trigger TX done event if callback is registered
-    if (uart_state[port].callback) {
+    if (frame_done && uart_state[port].callback) {
         hal_uart_event_t event = {
             .type = HAL_UART_EVENT_TX_DONE,
             .size = 0
         };
-        if (uart_state[port].event_queue) {
-            bool higher_priority_task_woken = false;
-            os_queue_send_from_isr(uart_state[port].event_queue, &event, &higher_priority_task_woken);
-            os_yield_from_isr(higher_priority_task_woken);
-        }
+        uart_post_from_isr(port, &event);
     }
 }
 
 /**
- * @brief Handle UART IDLE interrupt
- * @note Must be called from USART2_IRQHandler() in stm32f7xx_it.c
- *       when __HAL_UART_GET_FLAG(huart, UART_FLAG_IDLE) is set
+ * @brief Handle the end-of-burst interrupts: IDLE, receiver timeout, character match
+ * @note Must be called from each port's USARTn_IRQHandler() in stm32f7xx_it.c, ahead of
+ *       HAL_UART_IRQHandler(): the HAL aborts DMA RX on a pending RTOF
  */
-void hal_uart_idle_isr(void *huart_ptr)
+HAL_ITCM_FUNC void hal_uart_idle_isr(void *huart_ptr)
 {
     UART_HandleTypeDef *huart = (UART_HandleTypeDef *)huart_ptr;
+    bool idle = __HAL_UART_GET_FLAG(huart, UART_FLAG_IDLE)
+                && __HAL_UART_GET_IT_SOURCE(huart, UART_IT_IDLE);
+    bool rx_timeout = __HAL_UART_GET_FLAG(huart, UART_FLAG_RTOF)
+                      && __HAL_UART_GET_IT_SOURCE(huart, UART_IT_RTO);
+    bool char_match = __HAL_UART_GET_FLAG(huart, UART_FLAG_CMF)
+                      && __HAL_UART_GET_IT_SOURCE(huart, UART_IT_CM);
+
+    if (!idle && !rx_timeout && !char_match) {
+        return;
+    }
 
-    // Clear IDLE flag by reading SR and DR
-    if (__HAL_UART_GET_FLAG(huart, UART_FLAG_IDLE)) {
+    if (idle) {
         __HAL_UART_CLEAR_IDLEFLAG(huart);
+    }
+    if (rx_timeout) {
+        __HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_RTOF);
+    }
+    if (char_match) {
+        // Frame delimiter seen: deliver now, even if the next frame follows without a gap
+        __HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_CMF);
+    }
 
-        debug_idle_isr_count++;  // Debug: count IDLE interrupts
-
-        // Find which port this UART belongs to
-        hal_uart_port_t port;
-        for (port = HAL_UART_PORT_0; port < HAL_UART_PORT_MAX; port++) {
-            if (uart_state[port].huart == huart) {
-                break;
-            }
-        }
+    hal_uart_port_t port = find_port(huart);
+    if (port >= HAL_UART_PORT_MAX) {
+        return;
+    }
 
-        if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized) {
-            return;
-        }
+    uart_state[port].counters.idle += idle;
+    uart_state[port].counters.rx_timeout += rx_timeout;
+    uart_state[port].counters.char_match += char_match;
 
-        // Signal the RX task that data is available
-        bool higher_priority_task_woken = false;
-        os_semaphore_give_from_isr(uart_state[port].rx_data_sem, &higher_priority_task_woken);
-        os_yield_from_isr(higher_priority_task_woken);
-    }
+    // Service the port: data is available and the burst (or frame) has ended
+    uart_state[port].rx_idle = true;
+    uart_notify_from_isr(port);
 }
 
 /**
  * @brief DMA RX Half-Transfer callback
  * @note Called when DMA buffer is half full
  */
-void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
+HAL_ITCM_FUNC void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
 {
-    debug_dma_ht_count++;  // Debug: count DMA HT interrupts
-
-    // Find which port this UART belongs to
-    hal_uart_port_t port;
-    for (port = HAL_UART_PORT_0; port < HAL_UART_PORT_MAX; port++) {
-        if (uart_state[port].huart == huart) {
-            break;
-        }
-    }
-
-    if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized) {
+    hal_uart_port_t port = find_port(huart);
+    if (port >= HAL_UART_PORT_MAX) {
         return;
     }
 
-    // Signal the RX task that data is available
-    bool higher_priority_task_woken = false;
-    os_semaphore_give_from_isr(uart_state[port].rx_data_sem, &higher_priority_task_woken);
-    os_yield_from_isr(higher_priority_task_woken);
+    uart_state[port].counters.dma_half++;
+
+    // Service the port: data is available
+    uart_notify_from_isr(port);
 }
 
 /**
  * @brief DMA RX Transfer-Complete callback
  * @note Called when DMA buffer is full (wraparound in circular mode)
  */
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+HAL_ITCM_FUNC void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 {
-    debug_dma_tc_count++;  // Debug: count DMA TC interrupts
-
-    // Find which port this UART belongs to
-    hal_uart_port_t port;
-    for (port = HAL_UART_PORT_0; port < HAL_UART_PORT_MAX; port++) {
-        if (uart_state[port].huart == huart) {
-            break;
-        }
-    }
-
-    if (port >= HAL_UART_PORT_MAX || !uart_state[port].initialized) {
+    hal_uart_port_t port = find_port(huart);
+    if (port >= HAL_UART_PORT_MAX) {
         return;
     }
 
-    // Signal the RX task that data is available
-    bool higher_priority_task_woken = false;
-    os_semaphore_give_from_isr(uart_state[port].rx_data_sem, &higher_priority_task_woken);
-    os_yield_from_isr(higher_priority_task_woken);
+    uart_state[port].counters.dma_complete++;
+
+    // Service the port: data is available
+    uart_notify_from_isr(port);
 }
 
-/**
- * @brief Get debug ISR counters (for diagnostics)
- * @param idle_count Pointer to store IDLE interrupt count
- * @param dma_ht_count Pointer to store DMA Half-Transfer interrupt count
- * @param dma_tc_count Pointer to store DMA Transfer-Complete interrupt count
- */
-void hal_uart_get_isr_counters(uint32_t *idle_count, uint32_t *dma_ht_count, uint32_t *dma_tc_count)
+bool hal_uart_get_isr_counters(hal_uart_port_t port, hal_uart_isr_counters_t *counters)
 {
-    if (idle_count) *idle_count = debug_idle_isr_count;
-    if (dma_ht_count) *dma_ht_count = debug_dma_ht_count;
-    if (dma_tc_count) *dma_tc_count = debug_dma_tc_count;
+    if (port >= HAL_UART_PORT_MAX || counters == NULL) {
+        return false;
+    }
+
+    *counters = uart_state[port].counters;
+    return true;
 }
@@ -20,11 +20,14 @@ struct __UART_HandleTypeDef;
 
 /**
  * @brief UART port identifier
+ *
+ * A port is usable once CubeMX generates its handle (huartN, with RX/TX
+ * DMA streams) and its USARTn_IRQHandler calls hal_uart_idle_isr().
  */
 typedef enum {
-    HAL_UART_PORT_0 = 0,
-    HAL_UART_PORT_1 = 1,
-    HAL_UART_PORT_2 = 2,
+    HAL_UART_PORT_0 = 0,            /**< USART1 */
+    HAL_UART_PORT_1 = 1,            /**< USART2 (host link) */
+    HAL_UART_PORT_2 = 2,            /**< USART3 */
     HAL_UART_PORT_MAX
 } hal_uart_port_t;
 
@@ -76,6 +79,14 @@ typedef struct {
     size_t size;                    /**< Data size (for RX_DATA event) */
 } hal_uart_event_t;
 
+/**
+ * @brief One contiguous piece of an async scatter/gather transmission
+ */
+typedef struct {
+    const uint8_t *data;            /**< Segment data (must stay valid until TX_DONE) */
+    size_t len;                     /**< Segment length in bytes */
+} hal_uart_tx_segment_t;
+
 /**
  * @brief UART configuration structure
  */
@@ -91,8 +102,28 @@ typedef struct {
     int8_t cts_pin;                 /**< CTS pin number (-1 if not used) */
     size_t rx_buffer_size;          /**< RX ring buffer size */
     size_t tx_buffer_size;          /**< TX ring buffer size (0 for blocking) */
+    size_t rx_dma_buffer_size;      /**< RX DMA ring size (0: from rx_max_latency_ms, else default) */
+    uint32_t rx_max_latency_ms;     /**< Worst-case consumer latency the DMA ring must absorb */
+    uint32_t rx_timeout_bits;       /**< Idle bit times that end a burst (0: IDLE line detection) */
+    int16_t rx_match_char;          /**< Byte that ends a frame, wakes RX at once (-1 if not used) */
 } hal_uart_config_t;
 
+/**
+ * @brief Per-port interrupt and RX buffer counters
+ */
+typedef struct {
+    uint32_t idle;                  /**< IDLE line interrupts */
+    uint32_t rx_timeout;            /**< Receiver timeout interrupts */
+    uint32_t char_match;            /**< Character match interrupts */
+    uint32_t dma_half;              /**< RX DMA half-transfer interrupts */
+    uint32_t dma_complete;          /**< RX DMA transfer-complete interrupts */
+    uint32_t hw_overruns;           /**< USART overrun errors (byte lost before DMA read it) */
+    uint32_t dma_overruns;          /**< Zero-copy: DMA lapped unread data */
+    uint32_t rx_dropped_bytes;      /**< Copy mode: bytes the RX buffer had no room for */
+    uint32_t rx_high_water;         /**< Peak bytes waiting for the consumer */
+    uint32_t rx_dma_buffer_size;    /**< RX DMA ring size in use */
+} hal_uart_isr_counters_t;
+
 /**
  * @brief UART event callback function type
  * @param port UART port that generated the event
@@ -108,6 +139,10 @@ typedef void (*hal_uart_event_callback_t)(hal_uart_port_t port,
  * @param port UART port to initialize
  * @param config UART configuration
  * @return true if successful, false otherwise
+ *
+ * @note DMA RX draining and callbacks run on the shared work queue
+ *       (os_workqueue.h), which the first port started starts if needed.
+ *       Callbacks share its worker with other drivers: keep them short.
  */
 bool hal_uart_init(hal_uart_port_t port, const hal_uart_config_t *config);
 
@@ -115,6 +150,9 @@ bool hal_uart_init(hal_uart_port_t port, const hal_uart_config_t *config);
  * @brief Deinitialize UART HAL for a specific port
  * @param port UART port to deinitialize
  * @return true if successful, false otherwise
+ *
+ * @note Waits for a service pass on the work queue to finish, so it must
+ *       not be called from an event callback or other work item.
  */
 bool hal_uart_deinit(hal_uart_port_t port);
 
@@ -138,14 +176,29 @@ int hal_uart_write(hal_uart_port_t port, const uint8_t *data, size_t len, int ti
  * @param len Number of bytes to send
  * @return true if transmission started successfully, false on error
  *
- * @note NON-BLOCKING: Returns immediately after starting DMA transmission.
+ * @note NON-BLOCKING: Returns immediately after starting or queueing DMA transmission.
  * @warning The data buffer must remain valid until HAL_UART_EVENT_TX_DONE event
  *          is received via the registered callback.
  * @note Requires TX DMA to be configured in CubeMX (Normal mode).
- * @note Only one async transmission can be active at a time per port.
+ * @note If a transmission is in progress the buffer is queued behind it.
  */
 bool hal_uart_write_async(hal_uart_port_t port, const uint8_t *data, size_t len);
 
+/**
+ * @brief Queue a scatter/gather transmission using DMA (non-blocking)
+ * @param port UART port
+ * @param segments Segments to send back-to-back (e.g. header, payload, trailer)
+ * @param count Number of segments
+ * @return true if queued, false if the TX queue is full or on error
+ *
+ * @note The segment array itself is copied; the data each segment points to
+ *       must remain valid until the HAL_UART_EVENT_TX_DONE event for this call.
+ * @note Segments are chained from the TX complete interrupt, so queued writes
+ *       go out at line rate. One TX_DONE event is raised per call.
+ */
+bool hal_uart_write_async_sg(hal_uart_port_t port, const hal_uart_tx_segment_t *segments,
+                             size_t count);
+
 /**
  * @brief Read data from UART
  * @param port UART port
@@ -163,10 +216,79 @@ int hal_uart_read(hal_uart_port_t port, uint8_t *data, size_t len, int timeout_m
  */
 int hal_uart_available(hal_uart_port_t port);
 
+/**
+ * @brief Set how many bytes wake a blocked hal_uart_read()
+ * @param port UART port
+ * @param bytes Trigger level (1 = any data, the default); an idle line or
+ *              the read timeout still return fewer
+ * @return true if successful, false if larger than the RX buffer
+ *
+ * @note At high baud rates a trigger near the expected message size saves a
+ *       context switch per DMA chunk. Not used in zero-copy mode.
+ */
+bool hal_uart_set_rx_trigger(hal_uart_port_t port, size_t bytes);
+
+/**
+ * @brief Set the receiver timeout that ends a burst
+ * @param port UART port
+ * @param bits Idle time in bit times after the last stop bit (0 = use the
+ *             one-character IDLE line detection instead)
+ * @return true if successful, false if out of range (24 bits)
+ *
+ * @note The threshold is in bit times, so it scales with the baud rate. A
+ *       value above one character (10 bits at 8N1) tolerates short gaps
+ *       inside a frame without a wakeup per gap.
+ */
+bool hal_uart_set_rx_timeout(hal_uart_port_t port, uint32_t bits);
+
+/**
+ * @brief Wake RX on a frame delimiter byte (USART character match)
+ * @param port UART port
+ * @param match_char Delimiter (0..255), or -1 to disable
+ * @return true if successful, false otherwise
+ *
+ * @note Bounds delivery latency per frame when frames arrive back-to-back
+ *       with no idle gap. The receiver is briefly disabled to change the
+ *       byte; a byte arriving at that moment is lost.
+ */
+bool hal_uart_set_rx_match(hal_uart_port_t port, int16_t match_char);
+
+/**
+ * @brief Serve RX straight from the DMA circular buffer
+ * @param port UART port
+ * @param enable true to enable zero-copy RX, false to use the RX ring buffer
+ * @return true if successful, false otherwise
+ *
+ * @note Call once after hal_uart_init(), before data is expected. Bytes that
+ *       were not read yet when switching modes are discarded.
+ * @note In zero-copy mode the consumer must keep up with the DMA ring
+ *       (rx_dma_buffer_size); data overwritten by DMA is lost and counted
+ *       in hal_uart_isr_counters_t.dma_overruns.
+ */
+bool hal_uart_rx_set_zero_copy(hal_uart_port_t port, bool enable);
+
+/**
+ * @brief Get the next contiguous span of received bytes (zero-copy mode)
+ * @param port UART port
+ * @param data Output: pointer into the DMA buffer
+ * @return Number of contiguous bytes at *data (0 if none)
+ *
+ * @note The span stays valid until hal_uart_rx_consume(). When the data wraps
+ *       around the end of the DMA buffer, the rest is returned by the next peek.
+ */
+size_t hal_uart_rx_peek(hal_uart_port_t port, const uint8_t **data);
+
+/**
+ * @brief Release bytes returned by hal_uart_rx_peek()
+ * @param port UART port
+ * @param len Number of bytes consumed
+ */
+void hal_uart_rx_consume(hal_uart_port_t port, size_t len);
+
 /**
  * @brief Check if async TX is in progress
  * @param port UART port
- * @return true if TX is in progress, false otherwise
+ * @return true if TX is in progress or queued, false otherwise
  */
 bool hal_uart_tx_busy(hal_uart_port_t port);
 
@@ -205,12 +327,49 @@ bool hal_uart_unregister_callback(hal_uart_port_t port);
 
 /**
  * @brief Set UART baud rate at runtime
+ *
+ * Switches to oversampling by 8 above kernel clock / 16. Bytes in flight
+ * are lost; wait for TX to finish first.
+ *
  * @param port UART port
  * @param baud_rate New baud rate
- * @return true if successful, false otherwise
+ * @return true if successful, false otherwise (also if the rate is unsupported)
  */
 bool hal_uart_set_baudrate(hal_uart_port_t port, uint32_t baud_rate);
 
+/**
+ * @brief Check that a port's clock can make a baud rate (within 2%)
+ * @param port UART port
+ * @param baud_rate Baud rate
+ * @return true if hal_uart_set_baudrate() would accept it
+ */
+bool hal_uart_baudrate_supported(hal_uart_port_t port, uint32_t baud_rate);
+
+/**
+ * @brief Check that no port is transmitting (DMA queue empty, TC set)
+ */
+bool hal_uart_tx_is_idle(void);
+
+/**
+ * @brief Re-derive every port's baud divider after a system clock change
+ *
+ * For hal_clock; call with interrupts masked while hal_uart_tx_is_idle().
+ */
+void hal_uart_clock_changed(void);
+
+/**
+ * @brief RX DMA ring size for a baud rate and consumer latency
+ *
+ * The half-transfer interrupt leaves the consumer half a ring of headroom,
+ * so the ring holds twice what arrives within latency_ms (8N1), rounded
+ * up to a power of two.
+ *
+ * @param baud_rate Highest baud rate the port will run at
+ * @param latency_ms Worst-case delay before the consumer drains the ring
+ * @return Ring size in bytes, clamped to what the DMA pool can give one port
+ */
+size_t hal_uart_rx_dma_size_for(uint32_t baud_rate, uint32_t latency_ms);
+
 /**
  * @brief Get default UART configuration
  * @return Default configuration structure
@@ -218,11 +377,12 @@ bool hal_uart_set_baudrate(hal_uart_port_t port, uint32_t baud_rate);
 hal_uart_config_t hal_uart_get_default_config(void);
 
 /**
- * @brief Handle UART IDLE interrupt (ISR context)
+ * @brief Handle UART IDLE, receiver timeout and character match interrupts (ISR context)
  * @param huart UART handle (void* to avoid circular dependency)
  *
  * @note This function must be called from the USART IRQ handler (e.g., USART2_IRQHandler)
- *       when the IDLE flag is detected. Add this to stm32f7xx_it.c:
+ *       before HAL_UART_IRQHandler(), which would treat a pending receiver
+ *       timeout as an error and abort DMA reception. Add this to stm32f7xx_it.c:
  *
  * @code
  * void USART2_IRQHandler(void)
@@ -235,11 +395,11 @@ hal_uart_config_t hal_uart_get_default_config(void);
 void hal_uart_idle_isr(void *huart);
 
 /**
- * @brief Get debug ISR counters (for diagnostics)
- * @param idle_count Pointer to store IDLE interrupt count (can be NULL)
- * @param dma_ht_count Pointer to store DMA Half-Transfer interrupt count (can be NULL)
- * @param dma_tc_count Pointer to store DMA Transfer-Complete interrupt count (can be NULL)
+ * @brief Get a port's ISR and RX overflow counters (for diagnostics)
+ * @param port UART port
+ * @param counters Filled with the counts since hal_uart_init()
+ * @return true if successful, false for an invalid port
  */
-void hal_uart_get_isr_counters(uint32_t *idle_count, uint32_t *dma_ht_count, uint32_t *dma_tc_count);
+bool hal_uart_get_isr_counters(hal_uart_port_t port, hal_uart_isr_counters_t *counters);
 
 #endif // HAL_UART_H
@@ -0,0 +1,1039 @@
+#include "hal_usb.h"
+#include "hal_power.h"
+
+// STM32-specific implementation
+#include "stm32f7xx_hal.h"
+#include <string.h>
+
+#define USB_IRQ_PRIORITY        6       // Inside the FreeRTOS syscall range: events notify tasks
+#define USB_ENDPOINTS           6       // OTG FS endpoints per direction
+#define USB_SPIN_LIMIT          200000U // Core handshakes take microseconds; also bounded in the ISR
+#define USB_MODE_TIMEOUT_MS     50U
+
+#define OTG                     USB_OTG_FS
+#define OTG_DEV                 ((USB_OTG_DeviceTypeDef *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_DEVICE_BASE))
+#define OTG_IN(ep)              ((USB_OTG_INEndpointTypeDef *)(USB_OTG_FS_PERIPH_BASE + \
+                                  USB_OTG_IN_ENDPOINT_BASE + (ep) * USB_OTG_EP_REG_SIZE))
+#define OTG_OUT(ep)             ((USB_OTG_OUTEndpointTypeDef *)(USB_OTG_FS_PERIPH_BASE + \
+                                  USB_OTG_OUT_ENDPOINT_BASE + (ep) * USB_OTG_EP_REG_SIZE))
+#define OTG_FIFO(ep)            (*(__IO uint32_t *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_FIFO_BASE + \
+                                  (ep) * USB_OTG_FIFO_SIZE))
+#define OTG_PCGCCTL             (*(__IO uint32_t *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_PCGCCTL_BASE))
+
+// Fields without a CMSIS name
+#define EP_SD0PID               (1UL << 28)             // Set DATA0 PID (bulk/interrupt)
+#define EP_TYPE_BULK            (2UL << USB_OTG_DIEPCTL_EPTYP_Pos)
+#define EP_TYPE_INTERRUPT       (3UL << USB_OTG_DIEPCTL_EPTYP_Pos)
+#define DCFG_DSPD_FULL          (3UL << 0)              // Full speed, embedded PHY
+#define GUSBCFG_TRDT_FS         (6UL << USB_OTG_GUSBCFG_TRDT_Pos)  // HCLK of 32 MHz and above
+#define DIEPINT_TXFE            USB_OTG_DIEPINT_TXFE
+#define PKTSTS_OUT_DATA         2U
+#define PKTSTS_SETUP_DATA       6U
+#define TXFNUM_ALL              0x10U
+
+// Endpoints
+#define EP_CONTROL              0
+#define EP_DATA                 1                       // Bulk 0x01 / 0x81
+#define EP_NOTIFY               2                       // Interrupt 0x82 (never sent, ACM needs it)
+#define EP_NOTIFY_SIZE          8U
+
+// FIFO RAM (320 words): RX, then one TX FIFO per IN endpoint
+#define RX_FIFO_WORDS           128U
+#define TX0_FIFO_WORDS          32U
+#define TX1_FIFO_WORDS          128U                    // Eight bulk packets queued ahead
+#define TX2_FIFO_WORDS          16U
+
+// Standard and CDC requests
+#define REQ_TYPE_MASK           0x60U
+#define REQ_TYPE_STANDARD       0x00U
+#define REQ_TYPE_CLASS          0x20U
+#define REQ_RECIPIENT_MASK      0x1FU
+#define REQ_RECIPIENT_DEVICE    0x00U
+#define REQ_RECIPIENT_ENDPOINT  0x02U
+#define REQ_GET_STATUS          0x00U
+#define REQ_CLEAR_FEATURE       0x01U
+#define REQ_SET_FEATURE         0x03U
+#define REQ_SET_ADDRESS         0x05U
+#define REQ_GET_DESCRIPTOR      0x06U
+#define REQ_GET_CONFIGURATION   0x08U
+#define REQ_SET_CONFIGURATION   0x09U
+#define REQ_GET_INTERFACE       0x0AU
+#define REQ_SET_INTERFACE       0x0BU
+#define CDC_SET_LINE_CODING     0x20U
+#define CDC_GET_LINE_CODING     0x21U
+#define CDC_SET_CONTROL_LINE    0x22U
+#define CDC_SEND_BREAK          0x23U
+#define DESC_DEVICE             0x01U
+#define DESC_CONFIGURATION      0x02U
+#define DESC_STRING             0x03U
+#define FEATURE_ENDPOINT_HALT   0x00U
+#define LINE_CODING_SIZE        7U
+
+static const uint8_t device_descriptor[18] = {
+    18, DESC_DEVICE,
+    0x00, 0x02,                                 // USB 2.0
+    0x02, 0x00, 0x00,                           // CDC, class per interface
+    HAL_USB_PACKET_SIZE,                        // EP0 packet
+    HAL_USB_VID & 0xFF, HAL_USB_VID >> 8,
+    HAL_USB_PID & 0xFF, HAL_USB_PID >> 8,
+    0x00, 0x02,                                 // Device release 2.00
+    1, 2, 3,                                    // Manufacturer, product, serial strings
+    1,                                          // Configurations
+};
+
+#define CONFIG_DESCRIPTOR_SIZE  67U
+
+static const uint8_t config_descriptor[CONFIG_DESCRIPTOR_SIZE] = {
+    9, DESC_CONFIGURATION, CONFIG_DESCRIPTOR_SIZE, 0x00,
+    2, 1, 0,                                    // Interfaces, value, no string
+    0xC0, 50,                                   // Self-powered, 100 mA
+
+    // Interface 0: communication class, abstract control model
+    9, 0x04, 0, 0, 1, 0x02, 0x02, 0x01, 0,
+    5, 0x24, 0x00, 0x10, 0x01,                  // Header, CDC 1.10
+    5, 0x24, 0x01, 0x00, 1,                     // Call management: data on interface 1
+    4, 0x24, 0x02, 0x02,                        // ACM: line coding and control line state
+    5, 0x24, 0x06, 0, 1,                        // Union: control 0, data 1
+    7, 0x05, 0x80 | EP_NOTIFY, 0x03, EP_NOTIFY_SIZE, 0x00, 16,
+
+    // Interface 1: data class, one bulk pipe each way
+    9, 0x04, 1, 0, 2, 0x0A, 0x00, 0x00, 0,
+    7, 0x05, EP_DATA, 0x02, HAL_USB_PACKET_SIZE, 0x00, 0,
+    7, 0x05, 0x80 | EP_DATA, 0x02, HAL_USB_PACKET_SIZE, 0x00, 0,
+};
+
+static const char *const strings[] = {
+    [1] = "stm32_development",
+    [2] = "STM32F767 CDC link",
+};
+
+typedef enum {
+    EP0_IDLE = 0,
+    EP0_DATA_IN,
+    EP0_DATA_OUT,
+    EP0_STATUS_IN,
+    EP0_STATUS_OUT
+} ep0_stage_t;
+
+typedef struct {
+    bool running;
+    volatile bool configured;
+    volatile bool suspended;
+    hal_usb_event_callback_t callback;
+    void *user_data;
+
+    // Control endpoint
+    uint8_t setup[8];
+    ep0_stage_t ep0_stage;
+    const uint8_t *ep0_data;
+    uint32_t ep0_remaining;
+    bool ep0_zlp;                   // Data stage shorter than asked, ends on a full packet
+    uint8_t ep0_request;            // Request whose OUT data stage is running
+    uint32_t ep0_out_count;
+    uint8_t ep0_buffer[HAL_USB_PACKET_SIZE];
+    uint8_t line_coding[LINE_CODING_SIZE];
+
+    // Bulk OUT: packet ring, rx_head filled by the core
+    volatile uint32_t rx_head;
+    volatile uint32_t rx_tail;
+    volatile uint32_t rx_count;
+    volatile bool rx_armed;
+
+    // Bulk IN: one transfer in flight
+    const uint8_t *tx_data;
+    uint32_t tx_length;
+    uint32_t tx_pos;
+    volatile bool tx_busy;
+    bool tx_zlp;
+
+    hal_usb_stats_t stats;
+} usb_state_t;
+
+static usb_state_t usb = {0};
+static uint8_t rx_packets[HAL_USB_RX_PACKETS][HAL_USB_PACKET_SIZE];
+static uint16_t rx_lengths[HAL_USB_RX_PACKETS];
+
+_Static_assert(HAL_USB_RX_PACKETS >= 2, "OUT needs a packet to receive into and one to read");
+_Static_assert(RX_FIFO_WORDS + TX0_FIFO_WORDS + TX1_FIFO_WORDS + TX2_FIFO_WORDS <= 320U,
+               "OTG FS has 1.25 KB of FIFO RAM");
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static void emit(hal_usb_event_type_t type, uint32_t value)
+{
+    if (usb.callback != NULL) {
+        hal_usb_event_t event = { .type = type, .value = value };
+        usb.callback(&event, usb.user_data);
+    }
+}
+
+static bool wait_bits(volatile uint32_t *reg, uint32_t bits, bool set)
+{
+    for (uint32_t i = 0; i < USB_SPIN_LIMIT; i++) {
+        if (((*reg & bits) != 0) == set) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool core_reset(void)
+{
+    if (!wait_bits(&OTG->GRSTCTL, USB_OTG_GRSTCTL_AHBIDL, true)) {
+        return false;
+    }
+    OTG->GRSTCTL |= USB_OTG_GRSTCTL_CSRST;
+    return wait_bits(&OTG->GRSTCTL, USB_OTG_GRSTCTL_CSRST, false);
+}
+
+static void flush_tx_fifo(uint32_t number)
+{
+    OTG->GRSTCTL = USB_OTG_GRSTCTL_TXFFLSH | (number << USB_OTG_GRSTCTL_TXFNUM_Pos);
+    (void)wait_bits(&OTG->GRSTCTL, USB_OTG_GRSTCTL_TXFFLSH, false);
+}
+
+static void flush_rx_fifo(void)
+{
+    OTG->GRSTCTL = USB_OTG_GRSTCTL_RXFFLSH;
+    (void)wait_bits(&OTG->GRSTCTL, USB_OTG_GRSTCTL_RXFFLSH, false);
+}
+
+/**
+ * @brief Pop a received packet, keeping at most capacity bytes
+ */
+static void fifo_read(uint8_t *dst, uint32_t count, uint32_t capacity)
+{
+    for (uint32_t pos = 0; pos < count; pos += 4U) {
+        uint32_t word = OTG_FIFO(0);
+        if (pos < capacity) {
+            uint32_t n = capacity - pos;
+            memcpy(&dst[pos], &word, (n < 4U) ? n : 4U);
+        }
+    }
+}
+
+static void fifo_write(uint32_t ep, const uint8_t *src, uint32_t count)
+{
+    for (uint32_t pos = 0; pos < count; pos += 4U) {
+        uint32_t word = 0;
+        uint32_t n = count - pos;
+        memcpy(&word, &src[pos], (n < 4U) ? n : 4U);
+        OTG_FIFO(ep) = word;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Bulk pipes
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Let the host send the next packet if a buffer is free
+ */
+static void rx_arm(void)
+{
+    if (usb.rx_armed || !usb.configured || usb.rx_count >= HAL_USB_RX_PACKETS) {
+        return;
+    }
+    rx_lengths[usb.rx_head] = 0;
+    OTG_OUT(EP_DATA)->DOEPTSIZ = (1UL << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | HAL_USB_PACKET_SIZE;
+    OTG_OUT(EP_DATA)->DOEPCTL |= USB_OTG_DOEPCTL_CNAK | USB_OTG_DOEPCTL_EPENA;
+    usb.rx_armed = true;
+}
+
+static void rx_packet_done(void)
+{
+    usb.rx_armed = false;
+    if (rx_lengths[usb.rx_head] > 0) {
+        usb.rx_head = (usb.rx_head + 1U) % HAL_USB_RX_PACKETS;
+        usb.rx_count++;
+        usb.stats.rx_packets++;
+        emit(HAL_USB_EVENT_RX_DATA, usb.rx_count);
+    }
+
+    rx_arm();
+    if (!usb.rx_armed && usb.configured) {
+        usb.stats.rx_throttled++;   // NAKs until hal_usb_cdc_rx_consume()
+    }
+}
+
+static void tx_start(uint32_t length)
+{
+    uint32_t packets = (length == 0) ? 1U : (length + HAL_USB_PACKET_SIZE - 1U) / HAL_USB_PACKET_SIZE;
+    OTG_IN(EP_DATA)->DIEPTSIZ = (packets << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | length;
+    OTG_IN(EP_DATA)->DIEPCTL |= USB_OTG_DIEPCTL_CNAK | USB_OTG_DIEPCTL_EPENA;
+    if (length > 0) {
+        OTG_DEV->DIEPEMPMSK |= 1UL << EP_DATA;
+    }
+}
+
+/**
+ * @brief Move whole packets into the TX FIFO while it has room
+ */
+static void tx_fill_fifo(void)
+{
+    while (usb.tx_pos < usb.tx_length) {
+        uint32_t chunk = usb.tx_length - usb.tx_pos;
+        if (chunk > HAL_USB_PACKET_SIZE) {
+            chunk = HAL_USB_PACKET_SIZE;
+        }
+        if ((OTG_IN(EP_DATA)->DTXFSTS & USB_OTG_DTXFSTS_INEPTFSAV) < (chunk + 3U) / 4U) {
+            break;
+        }
+        fifo_write(EP_DATA, &usb.tx_data[usb.tx_pos], chunk);
+        usb.tx_pos += chunk;
+    }
+
+    if (usb.tx_pos >= usb.tx_length) {
+        OTG_DEV->DIEPEMPMSK &= ~(1UL << EP_DATA);
+    }
+}
+
+static void tx_done(void)
+{
+    if (usb.tx_zlp) {
+        // A full last packet leaves the host waiting for more; a ZLP ends its read
+        usb.tx_zlp = false;
+        usb.stats.tx_zlps++;
+        tx_start(0);
+        return;
+    }
+
+    usb.tx_busy = false;
+    usb.stats.tx_transfers++;
+    emit(HAL_USB_EVENT_TX_DONE, usb.tx_length);
+}
+
+/**
+ * @brief Stop a transfer on an IN endpoint and empty its FIFO
+ */
+static void in_endpoint_stop(uint32_t ep)
+{
+    if (OTG_IN(ep)->DIEPCTL & USB_OTG_DIEPCTL_EPENA) {
+        OTG_IN(ep)->DIEPCTL |= USB_OTG_DIEPCTL_SNAK | USB_OTG_DIEPCTL_EPDIS;
+        (void)wait_bits(&OTG_IN(ep)->DIEPINT, USB_OTG_DIEPINT_EPDISD, true);
+        OTG_IN(ep)->DIEPINT = USB_OTG_DIEPINT_EPDISD | USB_OTG_DIEPINT_XFRC;
+    }
+    flush_tx_fifo(ep);
+}
+
+static void in_endpoint_disable(uint32_t ep)
+{
+    in_endpoint_stop(ep);
+    OTG_IN(ep)->DIEPCTL &= ~(USB_OTG_DIEPCTL_USBAEP | USB_OTG_DIEPCTL_STALL);
+}
+
+/**
+ * @brief Drop the IN transfer in flight (nobody reads the pipe any more)
+ */
+static void tx_abort(void)
+{
+    if (!usb.tx_busy) {
+        return;
+    }
+    OTG_DEV->DIEPEMPMSK &= ~(1UL << EP_DATA);
+    in_endpoint_stop(EP_DATA);
+    usb.tx_busy = false;
+    usb.tx_zlp = false;
+    emit(HAL_USB_EVENT_TX_DONE, 0);
+}
+
+static void out_endpoint_disable(uint32_t ep)
+{
+    if (OTG_OUT(ep)->DOEPCTL & USB_OTG_DOEPCTL_EPENA) {
+        // An enabled OUT endpoint only disables under the global OUT NAK
+        OTG_DEV->DCTL |= USB_OTG_DCTL_SGONAK;
+        (void)wait_bits(&OTG->GINTSTS, USB_OTG_GINTSTS_BOUTNAKEFF, true);
+        OTG_OUT(ep)->DOEPCTL |= USB_OTG_DOEPCTL_SNAK | USB_OTG_DOEPCTL_EPDIS;
+        (void)wait_bits(&OTG_OUT(ep)->DOEPINT, USB_OTG_DOEPINT_EPDISD, true);
+        OTG_OUT(ep)->DOEPINT = USB_OTG_DOEPINT_EPDISD;
+        OTG_DEV->DCTL |= USB_OTG_DCTL_CGONAK;
+    }
+    OTG_OUT(ep)->DOEPCTL &= ~(USB_OTG_DOEPCTL_USBAEP | USB_OTG_DOEPCTL_STALL);
+}
+
+/**
+ * @brief Close the pipes; a transfer in flight is dropped
+ */
+static void deconfigure(void)
+{
+    bool was_configured = usb.configured;
+
+    usb.configured = false;
+    OTG_DEV->DAINTMSK &= ~((1UL << EP_DATA) | (1UL << (16 + EP_DATA)));
+    OTG_DEV->DIEPEMPMSK &= ~(1UL << EP_DATA);
+    in_endpoint_disable(EP_DATA);
+    in_endpoint_disable(EP_NOTIFY);
+    out_endpoint_disable(EP_DATA);
+
+    usb.tx_busy = false;
+    usb.tx_zlp = false;
+    usb.rx_head = 0;
+    usb.rx_tail = 0;
+    usb.rx_count = 0;
+    usb.rx_armed = false;
+    usb.stats.configured = false;
+
+    if (was_configured) {
+        emit(HAL_USB_EVENT_RESET, 0);
+    }
+}
+
+static void configure(void)
+{
+    deconfigure();
+
+    OTG_IN(EP_DATA)->DIEPCTL = HAL_USB_PACKET_SIZE | EP_TYPE_BULK |
+                               ((uint32_t)EP_DATA << USB_OTG_DIEPCTL_TXFNUM_Pos) |
+                               EP_SD0PID | USB_OTG_DIEPCTL_USBAEP | USB_OTG_DIEPCTL_SNAK;
+    OTG_OUT(EP_DATA)->DOEPCTL = HAL_USB_PACKET_SIZE | EP_TYPE_BULK |
+                                EP_SD0PID | USB_OTG_DOEPCTL_USBAEP | USB_OTG_DOEPCTL_SNAK;
+    OTG_IN(EP_NOTIFY)->DIEPCTL = EP_NOTIFY_SIZE | EP_TYPE_INTERRUPT |
+                                 ((uint32_t)EP_NOTIFY << USB_OTG_DIEPCTL_TXFNUM_Pos) |
+                                 EP_SD0PID | USB_OTG_DIEPCTL_USBAEP | USB_OTG_DIEPCTL_SNAK;
+    OTG_DEV->DAINTMSK |= (1UL << EP_DATA) | (1UL << (16 + EP_DATA));
+
+    usb.configured = true;
+    usb.stats.configured = true;
+    rx_arm();
+    emit(HAL_USB_EVENT_CONFIGURED, 0);
+}
+
+// ---------------------------------------------------------------------------
+// Control endpoint
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Ready EP0 OUT for SETUP packets, and for a data or status packet
+ *        when 'data' is set
+ */
+static void ep0_out_arm(bool data)
+{
+    OTG_OUT(EP_CONTROL)->DOEPTSIZ = (3UL << USB_OTG_DOEPTSIZ_STUPCNT_Pos) |
+                                    (1UL << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | HAL_USB_PACKET_SIZE;
+    if (data) {
+        OTG_OUT(EP_CONTROL)->DOEPCTL |= USB_OTG_DOEPCTL_CNAK | USB_OTG_DOEPCTL_EPENA;
+    }
+}
+
+static void ep0_in_next(void)
+{
+    uint32_t chunk = (usb.ep0_remaining > HAL_USB_PACKET_SIZE) ? HAL_USB_PACKET_SIZE : usb.ep0_remaining;
+
+    OTG_IN(EP_CONTROL)->DIEPTSIZ = (1UL << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | chunk;
+    OTG_IN(EP_CONTROL)->DIEPCTL |= USB_OTG_DIEPCTL_CNAK | USB_OTG_DIEPCTL_EPENA;
+    // The EP0 TX FIFO holds a whole packet
+    fifo_write(EP_CONTROL, usb.ep0_data, chunk);
+    usb.ep0_data += chunk;
+    usb.ep0_remaining -= chunk;
+}
+
+static void ep0_send(const uint8_t *data, uint32_t length)
+{
+    uint16_t requested = (uint16_t)(usb.setup[6] | (usb.setup[7] << 8));
+    if (length > requested) {
+        length = requested;
+    }
+    usb.ep0_data = data;
+    usb.ep0_remaining = length;
+    usb.ep0_zlp = length < requested && length % HAL_USB_PACKET_SIZE == 0 && length > 0;
+    usb.ep0_stage = EP0_DATA_IN;
+    ep0_in_next();
+}
+
+static void ep0_status_in(void)
+{
+    usb.ep0_stage = EP0_STATUS_IN;
+    usb.ep0_remaining = 0;
+    OTG_IN(EP_CONTROL)->DIEPTSIZ = 1UL << USB_OTG_DIEPTSIZ_PKTCNT_Pos;
+    OTG_IN(EP_CONTROL)->DIEPCTL |= USB_OTG_DIEPCTL_CNAK | USB_OTG_DIEPCTL_EPENA;
+}
+
+static void ep0_stall(void)
+{
+    // Cleared by the core at the next SETUP
+    OTG_IN(EP_CONTROL)->DIEPCTL |= USB_OTG_DIEPCTL_STALL;
+    OTG_OUT(EP_CONTROL)->DOEPCTL |= USB_OTG_DOEPCTL_STALL;
+    usb.ep0_stage = EP0_IDLE;
+    usb.stats.stalls++;
+}
+
+static uint32_t string_descriptor(uint8_t index)
+{
+    uint8_t *out = usb.ep0_buffer;
+
+    if (index == 0) {
+        out[0] = 4;
+        out[1] = DESC_STRING;
+        out[2] = 0x09;                          // English (US)
+        out[3] = 0x04;
+        return 4;
+    }
+
+    char serial[25];
+    const char *text;
+    if (index == 3) {
+        // Unique device ID, 96 bits as hex
+        static const char hex[] = "0123456789ABCDEF";
+        const volatile uint32_t *uid = (const volatile uint32_t *)UID_BASE;
+        for (uint32_t i = 0; i < 24; i++) {
+            serial[i] = hex[(uid[i / 8U] >> (28U - 4U * (i % 8U))) & 0xFU];
+        }
+        serial[24] = '\0';
+        text = serial;
+    } else if (index < sizeof(strings) / sizeof(strings[0]) && strings[index] != NULL) {
+        text = strings[index];
+    } else {
+        return 0;
+    }
+
+    uint32_t length = 0;
+    while (text[length] != '\0' && length < (HAL_USB_PACKET_SIZE - 2U) / 2U) {
+        out[2U + 2U * length] = (uint8_t)text[length];
+        out[3U + 2U * length] = 0;
+        length++;
+    }
+    out[0] = (uint8_t)(2U + 2U * length);
+    out[1] = DESC_STRING;
+    return out[0];
+}
+
+static volatile uint32_t *endpoint_ctl(uint8_t address)
+{
+    uint32_t ep = address & 0x0FU;
+    if (ep != EP_DATA && ep != EP_NOTIFY) {
+        return NULL;
+    }
+    if (address & 0x80U) {
+        return &OTG_IN(ep)->DIEPCTL;
+    }
+    return (ep == EP_DATA) ? &OTG_OUT(ep)->DOEPCTL : NULL;
+}
+
+static bool standard_request(void)
+{
+    uint8_t recipient = usb.setup[0] & REQ_RECIPIENT_MASK;
+    uint16_t value = (uint16_t)(usb.setup[2] | (usb.setup[3] << 8));
+    uint8_t index = usb.setup[4];
+    volatile uint32_t *ctl;
+
+    switch (usb.setup[1]) {
+        case REQ_GET_STATUS:
+            usb.ep0_buffer[0] = 0;
+            usb.ep0_buffer[1] = 0;
+            if (recipient == REQ_RECIPIENT_DEVICE) {
+                usb.ep0_buffer[0] = 0x01;       // Self-powered
+            } else if (recipient == REQ_RECIPIENT_ENDPOINT && (index & 0x0FU) != EP_CONTROL) {
+                ctl = endpoint_ctl(index);
+                if (ctl == NULL) {
+                    return false;
+                }
+                usb.ep0_buffer[0] = (*ctl & USB_OTG_DIEPCTL_STALL) ? 0x01 : 0x00;
+            }
+            ep0_send(usb.ep0_buffer, 2);
+            return true;
+
+        case REQ_CLEAR_FEATURE:
+        case REQ_SET_FEATURE:
+            if (recipient == REQ_RECIPIENT_ENDPOINT && value == FEATURE_ENDPOINT_HALT &&
+                (index & 0x0FU) != EP_CONTROL) {
+                ctl = endpoint_ctl(index);
+                if (ctl == NULL) {
+                    return false;
+                }
+                if (usb.setup[1] == REQ_SET_FEATURE) {
+                    *ctl |= USB_OTG_DIEPCTL_STALL;
+                } else {
+                    *ctl = (*ctl & ~USB_OTG_DIEPCTL_STALL) | EP_SD0PID;
+                }
+            }
+            ep0_status_in();
+            return true;
+
+        case REQ_SET_ADDRESS:
+            // Takes effect now; the core answers the status stage at address 0
+            OTG_DEV->DCFG = (OTG_DEV->DCFG & ~USB_OTG_DCFG_DAD) |
+                            (((uint32_t)value & 0x7FU) << USB_OTG_DCFG_DAD_Pos);
+            ep0_status_in();
+            return true;
+
+        case REQ_GET_DESCRIPTOR:
+            switch (value >> 8) {
+                case DESC_DEVICE:
+                    ep0_send(device_descriptor, sizeof(device_descriptor));
+                    return true;
+                case DESC_CONFIGURATION:
+                    ep0_send(config_descriptor, sizeof(config_descriptor));
+                    return true;
+                case DESC_STRING: {
+                    uint32_t length = string_descriptor((uint8_t)value);
+                    if (length == 0) {
+                        return false;
+                    }
+                    ep0_send(usb.ep0_buffer, length);
+                    return true;
+                }
+                default:
+                    return false;               // Device qualifier too: full speed only
+            }
+
+        case REQ_GET_CONFIGURATION:
+            usb.ep0_buffer[0] = usb.configured ? 1 : 0;
+            ep0_send(usb.ep0_buffer, 1);
+            return true;
+
+        case REQ_SET_CONFIGURATION:
+            if (value > 1) {
+                return false;
+            }
+            if (value == 1) {
+                configure();
+            } else {
+                deconfigure();
+            }
+            ep0_status_in();
+            return true;
+
+        case REQ_GET_INTERFACE:
+            usb.ep0_buffer[0] = 0;
+            ep0_send(usb.ep0_buffer, 1);
+            return true;
+
+        case REQ_SET_INTERFACE:
+            if (value != 0) {
+                return false;
+            }
+            ep0_status_in();
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static bool class_request(void)
+{
+    uint16_t value = (uint16_t)(usb.setup[2] | (usb.setup[3] << 8));
+    uint16_t length = (uint16_t)(usb.setup[6] | (usb.setup[7] << 8));
+
+    switch (usb.setup[1]) {
+        case CDC_SET_LINE_CODING:
+            if (length != LINE_CODING_SIZE) {
+                return false;
+            }
+            usb.ep0_stage = EP0_DATA_OUT;
+            usb.ep0_request = CDC_SET_LINE_CODING;
+            usb.ep0_out_count = 0;
+            ep0_out_arm(true);
+            return true;
+
+        case CDC_GET_LINE_CODING:
+            ep0_send(usb.line_coding, LINE_CODING_SIZE);
+            return true;
+
+        case CDC_SET_CONTROL_LINE:
+            usb.stats.line_state = (uint8_t)(value & 0x03U);
+            ep0_status_in();
+            emit(HAL_USB_EVENT_LINE_STATE, usb.stats.line_state);
+            if ((value & 0x01U) == 0) {
+                tx_abort();                     // Port closed: the host stops polling IN
+            }
+            return true;
+
+        case CDC_SEND_BREAK:
+            ep0_status_in();
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static void ep0_setup(void)
+{
+    usb.stats.setups++;
+    usb.ep0_stage = EP0_IDLE;
+    ep0_out_arm(false);
+
+    bool handled = false;
+    uint8_t type = usb.setup[0] & REQ_TYPE_MASK;
+    if (type == REQ_TYPE_STANDARD) {
+        handled = standard_request();
+    } else if (type == REQ_TYPE_CLASS) {
+        handled = class_request();
+    }
+
+    if (!handled) {
+        ep0_stall();
+    }
+}
+
+static void ep0_in_done(void)
+{
+    if (usb.ep0_stage != EP0_DATA_IN) {
+        usb.ep0_stage = EP0_IDLE;               // Status stage sent
+        return;
+    }
+
+    if (usb.ep0_remaining > 0) {
+        ep0_in_next();
+    } else if (usb.ep0_zlp) {
+        usb.ep0_zlp = false;
+        ep0_in_next();                          // Zero-length: data stage ends short
+    } else {
+        usb.ep0_stage = EP0_STATUS_OUT;
+        ep0_out_arm(true);
+    }
+}
+
+static void ep0_out_done(void)
+{
+    if (usb.ep0_stage == EP0_DATA_OUT) {
+        if (usb.ep0_request == CDC_SET_LINE_CODING && usb.ep0_out_count >= LINE_CODING_SIZE) {
+            memcpy(usb.line_coding, usb.ep0_buffer, LINE_CODING_SIZE);
+            memcpy(&usb.stats.line_baud, usb.line_coding, sizeof(usb.stats.line_baud));
+        }
+        ep0_status_in();
+    } else {
+        usb.ep0_stage = EP0_IDLE;               // Status stage received
+    }
+    ep0_out_arm(false);
+}
+
+// ---------------------------------------------------------------------------
+// Interrupt sources
+// ---------------------------------------------------------------------------
+
+static void rx_fifo_pop(void)
+{
+    uint32_t status = OTG->GRXSTSP;
+    uint32_t ep = status & USB_OTG_GRXSTSP_EPNUM;
+    uint32_t count = (status & USB_OTG_GRXSTSP_BCNT) >> USB_OTG_GRXSTSP_BCNT_Pos;
+    uint32_t packet = (status & USB_OTG_GRXSTSP_PKTSTS) >> USB_OTG_GRXSTSP_PKTSTS_Pos;
+
+    if (packet == PKTSTS_SETUP_DATA) {
+        fifo_read(usb.setup, count, sizeof(usb.setup));
+    } else if (packet == PKTSTS_OUT_DATA && count > 0) {
+        if (ep == EP_CONTROL) {
+            uint32_t room = sizeof(usb.ep0_buffer) - usb.ep0_out_count;
+            fifo_read(&usb.ep0_buffer[usb.ep0_out_count], count, room);
+            usb.ep0_out_count += (count < room) ? count : room;
+        } else if (ep == EP_DATA) {
+            fifo_read(rx_packets[usb.rx_head], count, HAL_USB_PACKET_SIZE);
+            rx_lengths[usb.rx_head] = (uint16_t)((count < HAL_USB_PACKET_SIZE) ? count : HAL_USB_PACKET_SIZE);
+        } else {
+            fifo_read(NULL, count, 0);
+        }
+    }
+}
+
+static void out_endpoints(void)
+{
+    uint32_t pending = (OTG_DEV->DAINT & OTG_DEV->DAINTMSK) >> 16;
+
+    for (uint32_t ep = 0; ep < USB_ENDPOINTS && pending != 0; ep++, pending >>= 1) {
+        if ((pending & 1U) == 0) {
+            continue;
+        }
+        uint32_t raw = OTG_OUT(ep)->DOEPINT;
+        uint32_t flags = raw & OTG_DEV->DOEPMSK;
+        OTG_OUT(ep)->DOEPINT = raw;
+
+        if (ep == EP_CONTROL) {
+            if (flags & USB_OTG_DOEPINT_XFRC) {
+                ep0_out_done();
+            }
+            if (flags & USB_OTG_DOEPINT_STUP) {
+                ep0_setup();
+            }
+        } else if (ep == EP_DATA && (flags & USB_OTG_DOEPINT_XFRC)) {
+            rx_packet_done();
+        }
+    }
+}
+
+static void in_endpoints(void)
+{
+    uint32_t pending = OTG_DEV->DAINT & OTG_DEV->DAINTMSK & 0xFFFFU;
+
+    for (uint32_t ep = 0; ep < USB_ENDPOINTS && pending != 0; ep++, pending >>= 1) {
+        if ((pending & 1U) == 0) {
+            continue;
+        }
+        // TXFE is enabled per endpoint through DIEPEMPMSK
+        uint32_t mask = OTG_DEV->DIEPMSK | (((OTG_DEV->DIEPEMPMSK >> ep) & 1U) ? DIEPINT_TXFE : 0U);
+        uint32_t flags = OTG_IN(ep)->DIEPINT & mask;
+
+        if (flags & USB_OTG_DIEPINT_XFRC) {
+            OTG_IN(ep)->DIEPINT = USB_OTG_DIEPINT_XFRC;
+            if (ep == EP_CONTROL) {
+                ep0_in_done();
+            } else if (ep == EP_DATA) {
+                tx_done();
+            }
+        }
+        if ((flags & DIEPINT_TXFE) && ep == EP_DATA) {
+            tx_fill_fifo();
+        }
+    }
+}
+
+static void bus_reset(void)
+{
+    OTG_DEV->DCTL &= ~USB_OTG_DCTL_RWUSIG;
+    deconfigure();
+    flush_tx_fifo(TXFNUM_ALL);
+
+    for (uint32_t ep = 0; ep < USB_ENDPOINTS; ep++) {
+        OTG_IN(ep)->DIEPINT = 0xFB7FU;
+        OTG_OUT(ep)->DOEPINT = 0xFB7FU;
+        OTG_OUT(ep)->DOEPCTL |= USB_OTG_DOEPCTL_SNAK;
+    }
+    OTG_DEV->DAINTMSK = (1UL << EP_CONTROL) | (1UL << (16 + EP_CONTROL));
+    OTG_DEV->DOEPMSK = USB_OTG_DOEPMSK_STUPM | USB_OTG_DOEPMSK_XFRCM;
+    OTG_DEV->DIEPMSK = USB_OTG_DIEPMSK_XFRCM;
+    OTG_DEV->DCFG &= ~USB_OTG_DCFG_DAD;
+
+    usb.ep0_stage = EP0_IDLE;
+    usb.suspended = false;
+    usb.stats.suspended = false;
+    usb.stats.line_state = 0;
+    usb.stats.resets++;
+    ep0_out_arm(false);
+}
+
+static void enumeration_done(void)
+{
+    // Full speed: EP0 at 64 bytes (MPSIZ 0)
+    OTG_IN(EP_CONTROL)->DIEPCTL &= ~USB_OTG_DIEPCTL_MPSIZ;
+    OTG_DEV->DCTL |= USB_OTG_DCTL_CGINAK;
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+bool hal_usb_cdc_init(hal_usb_event_callback_t callback, void *user_data)
+{
+    if (usb.running) {
+        return true;
+    }
+
+    memset(&usb, 0, sizeof(usb));
+    usb.callback = callback;
+    usb.user_data = user_data;
+    static const uint8_t default_line_coding[LINE_CODING_SIZE] = { 0x00, 0xC2, 0x01, 0x00, 0, 0, 8 };
+    memcpy(usb.line_coding, default_line_coding, LINE_CODING_SIZE);   // 115200 8N1
+    usb.stats.line_baud = 115200;
+
+    // 48 MHz: PLLSAI VCO 192 MHz from the shared 1 MHz input, P output / 4
+    RCC_PeriphCLKInitTypeDef clock = {0};
+    clock.PeriphClockSelection = RCC_PERIPHCLK_CLK48;
+    clock.Clk48ClockSelection = RCC_CLK48SOURCE_PLLSAIP;
+    clock.PLLSAI.PLLSAIN = 192;
+    clock.PLLSAI.PLLSAIP = RCC_PLLSAIP_DIV4;
+    clock.PLLSAI.PLLSAIQ = 2;
+    clock.PLLSAI.PLLSAIR = 2;
+    if (HAL_RCCEx_PeriphCLKConfig(&clock) != HAL_OK) {
+        return false;
+    }
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    GPIO_InitTypeDef gpio = {0};
+    gpio.Pin = GPIO_PIN_11 | GPIO_PIN_12;       // DM, DP
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF10_OTG_FS;
+    HAL_GPIO_Init(GPIOA, &gpio);
+
+    __HAL_RCC_USB_OTG_FS_CLK_ENABLE();
+
+    // Core on the embedded full-speed PHY
+    OTG->GAHBCFG &= ~USB_OTG_GAHBCFG_GINT;
+    OTG->GUSBCFG |= USB_OTG_GUSBCFG_PHYSEL;
+    if (!core_reset()) {
+        __HAL_RCC_USB_OTG_FS_CLK_DISABLE();
+        return false;
+    }
+    OTG->GCCFG |= USB_OTG_GCCFG_PWRDWN;
+
+    OTG->GUSBCFG = (OTG->GUSBCFG & ~(USB_OTG_GUSBCFG_FHMOD | USB_OTG_GUSBCFG_FDMOD | USB_OTG_GUSBCFG_TRDT)) |
+                   USB_OTG_GUSBCFG_FDMOD | GUSBCFG_TRDT_FS;
+    uint32_t start = HAL_GetTick();
+    while (OTG->GINTSTS & USB_OTG_GINTSTS_CMOD) {
+        if (HAL_GetTick() - start > USB_MODE_TIMEOUT_MS) {
+            __HAL_RCC_USB_OTG_FS_CLK_DISABLE();
+            return false;
+        }
+    }
+
+    // No VBUS pin: behave as if a session were always valid
+    OTG->GCCFG &= ~USB_OTG_GCCFG_VBDEN;
+    OTG->GOTGCTL |= USB_OTG_GOTGCTL_BVALOEN | USB_OTG_GOTGCTL_BVALOVAL;
+    OTG_PCGCCTL = 0;
+
+    OTG_DEV->DCTL |= USB_OTG_DCTL_SDIS;         // Off the bus until set up
+    OTG_DEV->DCFG |= DCFG_DSPD_FULL;
+
+    OTG->GRXFSIZ = RX_FIFO_WORDS;
+    OTG->DIEPTXF0_HNPTXFSIZ = (TX0_FIFO_WORDS << 16) | RX_FIFO_WORDS;
+    OTG->DIEPTXF[EP_DATA - 1] = (TX1_FIFO_WORDS << 16) | (RX_FIFO_WORDS + TX0_FIFO_WORDS);
+    OTG->DIEPTXF[EP_NOTIFY - 1] = (TX2_FIFO_WORDS << 16) |
+                                  (RX_FIFO_WORDS + TX0_FIFO_WORDS + TX1_FIFO_WORDS);
+    flush_tx_fifo(TXFNUM_ALL);
+    flush_rx_fifo();
+
+    OTG_DEV->DIEPMSK = 0;
+    OTG_DEV->DOEPMSK = 0;
+    OTG_DEV->DAINTMSK = 0;
+    OTG_DEV->DIEPEMPMSK = 0;
+    for (uint32_t ep = 0; ep < USB_ENDPOINTS; ep++) {
+        OTG_IN(ep)->DIEPCTL = 0;
+        OTG_IN(ep)->DIEPTSIZ = 0;
+        OTG_IN(ep)->DIEPINT = 0xFB7FU;
+        OTG_OUT(ep)->DOEPCTL = 0;
+        OTG_OUT(ep)->DOEPTSIZ = 0;
+        OTG_OUT(ep)->DOEPINT = 0xFB7FU;
+    }
+
+    OTG->GINTMSK = 0;
+    OTG->GINTSTS = 0xBFFFFFFFU;
+    OTG->GINTMSK = USB_OTG_GINTMSK_RXFLVLM | USB_OTG_GINTMSK_USBSUSPM | USB_OTG_GINTMSK_USBRST |
+                   USB_OTG_GINTMSK_ENUMDNEM | USB_OTG_GINTMSK_IEPINT | USB_OTG_GINTMSK_OEPINT |
+                   USB_OTG_GINTMSK_WUIM;
+
+    hal_power_stop_lock();                      // PLLSAI stops in STOP
+    usb.running = true;
+
+    HAL_NVIC_SetPriority(OTG_FS_IRQn, USB_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(OTG_FS_IRQn);
+    OTG->GAHBCFG |= USB_OTG_GAHBCFG_GINT;
+    OTG_DEV->DCTL &= ~USB_OTG_DCTL_SDIS;        // Pull-up on: the host sees us
+    return true;
+}
+
+void hal_usb_cdc_deinit(void)
+{
+    if (!usb.running) {
+        return;
+    }
+
+    OTG_DEV->DCTL |= USB_OTG_DCTL_SDIS;
+    HAL_NVIC_DisableIRQ(OTG_FS_IRQn);
+    OTG->GAHBCFG &= ~USB_OTG_GAHBCFG_GINT;
+    usb.callback = NULL;
+    deconfigure();
+    OTG->GCCFG &= ~USB_OTG_GCCFG_PWRDWN;
+
+    __HAL_RCC_USB_OTG_FS_CLK_DISABLE();
+    HAL_GPIO_DeInit(GPIOA, GPIO_PIN_11 | GPIO_PIN_12);
+    __HAL_RCC_PLLSAI_DISABLE();                 // Nothing else on the board uses it
+
+    usb.running = false;
+    hal_power_stop_unlock();
+}
+
+bool hal_usb_cdc_is_configured(void)
+{
+    return usb.configured && !usb.suspended;
+}
+
+bool hal_usb_cdc_transmit(const uint8_t *data, uint32_t length)
+{
+    if (length > HAL_USB_TX_MAX || (data == NULL && length > 0)) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!usb.configured || usb.tx_busy) {
+        __set_PRIMASK(primask);
+        return false;
+    }
+    usb.tx_busy = true;
+    usb.tx_data = data;
+    usb.tx_length = length;
+    usb.tx_pos = 0;
+    usb.tx_zlp = length > 0 && length % HAL_USB_PACKET_SIZE == 0;
+    tx_start(length);
+    __set_PRIMASK(primask);
+    return true;
+}
+
+bool hal_usb_cdc_tx_is_idle(void)
+{
+    return !usb.tx_busy;
+}
+
+uint32_t hal_usb_cdc_rx_peek(const uint8_t **data)
+{
+    if (data == NULL || usb.rx_count == 0) {
+        return 0;
+    }
+    *data = rx_packets[usb.rx_tail];
+    return rx_lengths[usb.rx_tail];
+}
+
+void hal_usb_cdc_rx_consume(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (usb.rx_count > 0) {
+        usb.rx_tail = (usb.rx_tail + 1U) % HAL_USB_RX_PACKETS;
+        usb.rx_count--;
+        rx_arm();
+    }
+    __set_PRIMASK(primask);
+}
+
+void hal_usb_irq_handler(void)
+{
+    if (!usb.running || (OTG->GINTSTS & USB_OTG_GINTSTS_CMOD)) {
+        return;
+    }
+
+    // Received packets first: a SETUP is read out before its STUP interrupt
+    while (OTG->GINTSTS & USB_OTG_GINTSTS_RXFLVL) {
+        rx_fifo_pop();
+    }
+
+    uint32_t status = OTG->GINTSTS & OTG->GINTMSK;
+    if (status & USB_OTG_GINTSTS_OEPINT) {
+        out_endpoints();
+    }
+    if (status & USB_OTG_GINTSTS_IEPINT) {
+        in_endpoints();
+    }
+    if (status & USB_OTG_GINTSTS_USBRST) {
+        OTG->GINTSTS = USB_OTG_GINTSTS_USBRST;
+        bus_reset();
+    }
+    if (status & USB_OTG_GINTSTS_ENUMDNE) {
+        OTG->GINTSTS = USB_OTG_GINTSTS_ENUMDNE;
+        enumeration_done();
+    }
+    if (status & USB_OTG_GINTSTS_USBSUSP) {
+        OTG->GINTSTS = USB_OTG_GINTSTS_USBSUSP;
+        usb.suspended = true;
+        usb.stats.suspended = true;
+    }
+    if (status & USB_OTG_GINTSTS_WKUINT) {
+        OTG->GINTSTS = USB_OTG_GINTSTS_WKUINT;
+        usb.suspended = false;
+        usb.stats.suspended = false;
+    }
+}
+
+void hal_usb_get_stats(hal_usb_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = usb.stats;
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,130 @@
+#ifndef HAL_USB_H
+#define HAL_USB_H
+
+/**
+ * @file hal_usb.h
+ * @brief USB device on OTG FS: one CDC-ACM serial port
+ *
+ * Register-level driver for the full-speed OTG core in device mode (the
+ * tree carries no PCD driver or USB device library). The board shows up
+ * as a virtual COM port with one bulk pipe each way. Line coding set by
+ * the host is stored and reported back but changes nothing: the pipe runs
+ * at USB speed, about 1 MB/s of bulk data when the host polls freely.
+ *
+ * Clocks: the 48 MHz USB clock comes from PLLSAI (1 MHz PLL input x 192 / 4),
+ * so it does not depend on the main PLL or the hal_clock level. PLLSAI
+ * stops in STOP mode, so the driver holds a STOP lock while it runs.
+ * Pins PA11/PA12 (AF10). VBUS sensing is off: the device connects as soon
+ * as it starts.
+ *
+ * Both bulk endpoints are double-buffered in software:
+ * - OUT: HAL_USB_RX_PACKETS packet buffers. The core receives into one
+ *   while the consumer reads the others (hal_usb_cdc_rx_peek/consume).
+ *   With all of them full the endpoint NAKs until one is consumed, so the
+ *   host is throttled instead of data being dropped.
+ * - IN: one transfer of up to HAL_USB_TX_MAX bytes in flight; the caller
+ *   fills its next buffer meanwhile and starts it on TX_DONE. A transfer
+ *   that ends on a full packet is closed with a zero-length packet. When
+ *   the host drops DTR (port closed) the transfer in flight is dropped
+ *   and reported as TX_DONE with 0 bytes.
+ *
+ * Events are delivered from the OTG_FS interrupt.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HAL_USB_PACKET_SIZE     64U         // Full-speed bulk packet
+#define HAL_USB_TX_MAX          (1023U * HAL_USB_PACKET_SIZE)   // DIEPTSIZ packet count limit
+
+#ifndef HAL_USB_RX_PACKETS
+#define HAL_USB_RX_PACKETS      4U
+#endif
+
+// ST's virtual COM port IDs, so stock host drivers bind
+#ifndef HAL_USB_VID
+#define HAL_USB_VID             0x0483U
+#endif
+#ifndef HAL_USB_PID
+#define HAL_USB_PID             0x5740U
+#endif
+
+typedef enum {
+    HAL_USB_EVENT_CONFIGURED,       // Host selected the configuration, pipes open
+    HAL_USB_EVENT_RESET,            // Bus reset or deconfigured: pending TX dropped
+    HAL_USB_EVENT_LINE_STATE,       // value: DTR (bit 0), RTS (bit 1)
+    HAL_USB_EVENT_RX_DATA,          // A packet is ready for hal_usb_cdc_rx_peek()
+    HAL_USB_EVENT_TX_DONE           // value: bytes of the finished transfer (0: dropped)
+} hal_usb_event_type_t;
+
+typedef struct {
+    hal_usb_event_type_t type;
+    uint32_t value;
+} hal_usb_event_t;
+
+typedef void (*hal_usb_event_callback_t)(const hal_usb_event_t *event, void *user_data);
+
+typedef struct {
+    uint32_t resets;            // Bus resets
+    uint32_t setups;            // Control requests
+    uint32_t stalls;            // Control requests refused
+    uint32_t rx_packets;
+    uint32_t rx_throttled;      // Times all OUT buffers were full (endpoint NAKing)
+    uint32_t tx_transfers;
+    uint32_t tx_zlps;           // Zero-length packets ending a transfer
+    bool configured;
+    bool suspended;
+    uint8_t line_state;         // DTR (bit 0), RTS (bit 1)
+    uint32_t line_baud;         // Last SET_LINE_CODING rate (informational)
+} hal_usb_stats_t;
+
+/**
+ * @brief Start the 48 MHz clock and the device core, connect to the bus
+ * @param callback Event callback (ISR context), may be NULL
+ * @return true if the core came up (also when already running)
+ */
+bool hal_usb_cdc_init(hal_usb_event_callback_t callback, void *user_data);
+
+/**
+ * @brief Disconnect, stop the core and the clock
+ */
+void hal_usb_cdc_deinit(void);
+
+/**
+ * @brief Host configured the device and the bus is not suspended
+ */
+bool hal_usb_cdc_is_configured(void);
+
+/**
+ * @brief Start one IN transfer
+ * @param data Bytes to send; must stay valid until TX_DONE
+ * @param length Up to HAL_USB_TX_MAX bytes
+ * @return false if not configured, a transfer is in flight or length is too large
+ */
+bool hal_usb_cdc_transmit(const uint8_t *data, uint32_t length);
+
+/**
+ * @brief No IN transfer in flight
+ */
+bool hal_usb_cdc_tx_is_idle(void);
+
+/**
+ * @brief Oldest received packet
+ * @param data Output: packet bytes, valid until hal_usb_cdc_rx_consume()
+ * @return Packet length, 0 if none is waiting
+ */
+uint32_t hal_usb_cdc_rx_peek(const uint8_t **data);
+
+/**
+ * @brief Free the packet returned by hal_usb_cdc_rx_peek() (re-arms the endpoint)
+ */
+void hal_usb_cdc_rx_consume(void);
+
+/**
+ * @brief OTG_FS interrupt body (stm32f7xx_it.c)
+ */
+void hal_usb_irq_handler(void);
+
+void hal_usb_get_stats(hal_usb_stats_t *stats);
+
+#endif // HAL_USB_H
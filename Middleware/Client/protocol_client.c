@@ -0,0 +1,886 @@
+/**
+ * @file protocol_client.c
+ * @brief Reference host client for bulk downloads from the STM32
+ *
+ * Pipelined reads keep one request outstanding per window slot. The
+ * pending list holds them in send order; since the STM32 answers in that
+ * order, a response to pending[i] means pending[0..i-1] were lost. A lost
+ * request is recovered with CMD_RETRANSMIT first (its response may only
+ * have failed the CRC), a lost retransmit by sending the request again.
+ */
+
+#include "protocol_client.h"
+#include "portable_log.h"
+#include <string.h>
+
+static const char *TAG = "PROTO_CLIENT";
+
+#define CLIENT_BUSY_WAIT_MS     20      // Before asking again for a dump refused as busy
+
+typedef struct {
+    uint8_t sensor_type;
+    uint32_t next;              // Index expected in the next frame
+    uint32_t end;               // First index not asked for, UINT32_MAX = to the end
+    bool truncated;             // Gap table full: the rest is fetched again after the pass
+} bulk_channel_t;
+
+// ============================================================================
+// Packets
+// ============================================================================
+
+static bool send_command(protocol_client_t *client, uint8_t cmd_id, uint8_t seq,
+                         const void *payload, uint16_t payload_len)
+{
+    protocol_packet_t packet;
+    packet.type = PACKET_TYPE_CMD;
+    packet.cmd_id = cmd_id;
+    packet.seq = seq;
+    packet.status = 0;
+    packet.length = payload_len;
+    if (payload_len > 0) {
+        memcpy(packet.payload, payload, payload_len);
+    }
+
+    client->stats.requests++;
+    return client->link->send(client->link->ctx, (const uint8_t *)&packet,
+                              PROTOCOL_HEADER_SIZE + payload_len);
+}
+
+/**
+ * @brief Wait for the next well-formed packet (into client->rx)
+ * @return The packet, NULL on timeout
+ */
+static const protocol_bulk_packet_t *receive_packet(protocol_client_t *client, uint32_t timeout_ms)
+{
+    const protocol_bulk_packet_t *packet = (const protocol_bulk_packet_t *)client->rx;
+
+    for (;;) {
+        size_t length = client->link->receive(client->link->ctx, client->rx, sizeof(client->rx),
+                                              timeout_ms);
+        if (length == 0) {
+            client->stats.timeouts++;
+            return NULL;
+        }
+        if (length < PROTOCOL_HEADER_SIZE || packet->length != length - PROTOCOL_HEADER_SIZE) {
+            client->stats.stray_packets++;
+            continue;
+        }
+
+        client->stats.packets++;
+        client->stats.bytes += (uint32_t)length;
+        if (packet->type & PACKET_TYPE_FLAG_COMPACT) {
+            client->stats.compact_packets++;
+        }
+        return packet;
+    }
+}
+
+/**
+ * @brief Decode a packet's sample array into client->decoded
+ * @return true if exactly count samples were there
+ */
+static bool decode_samples(protocol_client_t *client, const protocol_bulk_packet_t *packet,
+                           size_t header_size, uint8_t sensor_type, uint16_t count)
+{
+    const uint8_t *data = packet->payload + header_size;
+    size_t length = packet->length - header_size;
+
+    if (count > PROTOCOL_CLIENT_DECODE_MAX) {
+        return false;
+    }
+
+    if (packet->type & PACKET_TYPE_FLAG_COMPACT) {
+        uint32_t decoded = 0;
+        return sample_codec_decode(data, length, sensor_type, client->decoded, count, &decoded)
+               && decoded == count;
+    }
+
+    if (length != (size_t)count * sizeof(sensor_sample_t)) {
+        return false;
+    }
+    memcpy(client->decoded, data, length);
+    return true;
+}
+
+static proto_client_status_t response_status(uint8_t status)
+{
+    switch (status) {
+        case RESP_OK:       return PROTO_CLIENT_OK;
+        case RESP_NO_DATA:  return PROTO_CLIENT_ERR_NO_DATA;
+        default:            return PROTO_CLIENT_ERR_REFUSED;
+    }
+}
+
+// ============================================================================
+// Negotiation
+// ============================================================================
+
+static void apply_agreement(protocol_client_t *client, uint8_t version, uint32_t features,
+                            uint16_t max_bulk_payload, uint8_t window)
+{
+    client->version = version;
+    client->features = features;
+    client->max_bulk_payload = max_bulk_payload;
+    client->compact = (features & PROTOCOL_FEATURE_COMPACT) != 0;
+
+    if (!(features & PROTOCOL_FEATURE_WINDOW) || window == 0) {
+        window = 1;
+    }
+    if (window > PROTOCOL_CLIENT_WINDOW_MAX) {
+        window = PROTOCOL_CLIENT_WINDOW_MAX;
+    }
+    if (client->config.window != 0 && window > client->config.window) {
+        window = client->config.window;
+    }
+    client->window = window;
+
+    // The STM32 switched after its response; follow it
+    if (client->link->set_cobs != NULL) {
+        client->link->set_cobs(client->link->ctx, (features & PROTOCOL_FEATURE_COBS) != 0);
+    }
+
+    LOG_I(TAG, "Version %u, features 0x%08lX, window %u", version, (unsigned long)features, window);
+}
+
+/**
+ * @brief CMD_NEGOTIATE_VERSION, for firmware without CMD_HELLO
+ */
+static proto_client_status_t negotiate_version(protocol_client_t *client, uint32_t features)
+{
+    cmd_negotiate_version_t request = { .version = PROTOCOL_VERSION_MAX };
+    if (!(features & PROTOCOL_FEATURE_COBS)) {
+        request.version = PROTOCOL_VERSION_MARKERS;
+    } else if (!(features & PROTOCOL_FEATURE_COMPACT)) {
+        request.version = PROTOCOL_VERSION_COBS;
+    }
+
+    const protocol_bulk_packet_t *response = NULL;
+    proto_client_status_t status = protocol_client_command(
+        client, CMD_NEGOTIATE_VERSION, &request, sizeof(request), &response);
+    if (status != PROTO_CLIENT_OK) {
+        return status;
+    }
+    if (response->length < sizeof(resp_negotiate_version_t)) {
+        return PROTO_CLIENT_ERR_PROTOCOL;
+    }
+
+    uint8_t version = response->payload[0];
+    uint32_t agreed = 0;
+    if (version >= PROTOCOL_VERSION_COBS) {
+        agreed |= PROTOCOL_FEATURE_COBS;
+    }
+    if (version >= PROTOCOL_VERSION_COMPACT) {
+        agreed |= PROTOCOL_FEATURE_COMPACT;
+    }
+    apply_agreement(client, version, agreed, 0, 1);
+    return PROTO_CLIENT_OK;
+}
+
+// ============================================================================
+// Pipelined Reads
+// ============================================================================
+
+static bool request_slot(protocol_client_t *client, uint8_t slot_index)
+{
+    protocol_client_slot_t *slot = &client->slots[slot_index];
+    cmd_get_buffer_data_t request = {
+        .start_index = slot->start + slot->filled,
+        .count = slot->count - slot->filled,
+    };
+    uint8_t seq = client->next_seq++;
+
+    client->pending[client->pending_count++] = (protocol_client_pending_t){
+        .seq = seq, .target = seq, .retransmit = false, .slot = slot_index,
+    };
+    return send_command(client, CMD_GET_BUFFER_DATA, seq, &request, sizeof(request));
+}
+
+static bool request_retransmit(protocol_client_t *client, uint8_t slot_index, uint8_t target)
+{
+    cmd_retransmit_t request = { .seq = target };
+    uint8_t seq = client->next_seq++;
+
+    client->pending[client->pending_count++] = (protocol_client_pending_t){
+        .seq = seq, .target = target, .retransmit = true, .slot = slot_index,
+    };
+    client->stats.retransmits++;
+    return send_command(client, CMD_RETRANSMIT, seq, &request, sizeof(request));
+}
+
+/**
+ * @brief Recover a request whose response never came
+ */
+static proto_client_status_t recover(protocol_client_t *client, const protocol_client_pending_t *lost)
+{
+    protocol_client_slot_t *slot = &client->slots[lost->slot];
+
+    if (++slot->retries > PROTOCOL_MAX_RETRIES) {
+        LOG_W(TAG, "No response for samples %lu+%lu",
+              (unsigned long)(slot->start + slot->filled),
+              (unsigned long)(slot->count - slot->filled));
+        return PROTO_CLIENT_ERR_TIMEOUT;
+    }
+
+    bool sent;
+    if (!lost->retransmit && (client->features & PROTOCOL_FEATURE_WINDOW)) {
+        sent = request_retransmit(client, lost->slot, lost->seq);
+    } else {
+        client->stats.resends++;
+        sent = request_slot(client, lost->slot);
+    }
+    return sent ? PROTO_CLIENT_OK : PROTO_CLIENT_ERR_LINK;
+}
+
+/**
+ * @brief Remove pending[0..count-1] and recover them
+ */
+static proto_client_status_t recover_first(protocol_client_t *client, uint8_t count)
+{
+    protocol_client_pending_t lost[PROTOCOL_CLIENT_WINDOW_MAX];
+
+    memcpy(lost, client->pending, count * sizeof(lost[0]));
+    client->pending_count -= count;
+    memmove(client->pending, client->pending + count,
+            client->pending_count * sizeof(client->pending[0]));
+
+    for (uint8_t i = 0; i < count; i++) {
+        proto_client_status_t status = recover(client, &lost[i]);
+        if (status != PROTO_CLIENT_OK) {
+            return status;
+        }
+    }
+    return PROTO_CLIENT_OK;
+}
+
+/**
+ * @brief Find the pending request a response answers
+ * @return Its position, -1 if none
+ */
+static int match_pending(const protocol_client_t *client, const protocol_bulk_packet_t *packet)
+{
+    if ((packet->type & PACKET_TYPE_MASK) != PACKET_TYPE_RESP) {
+        return -1;
+    }
+
+    for (uint8_t i = 0; i < client->pending_count; i++) {
+        const protocol_client_pending_t *entry = &client->pending[i];
+        // A retransmitted response keeps the cmd_id and seq of the original
+        if (packet->cmd_id == CMD_GET_BUFFER_DATA && packet->seq == entry->target) {
+            return i;
+        }
+        if (entry->retransmit && packet->cmd_id == CMD_RETRANSMIT && packet->seq == entry->seq) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Store a GET_BUFFER_DATA response in its slot
+ * @param end Set when the buffer has no samples past this slot
+ */
+static proto_client_status_t take_response(protocol_client_t *client,
+                                           const protocol_client_pending_t *entry,
+                                           const protocol_bulk_packet_t *packet, bool *end)
+{
+    protocol_client_slot_t *slot = &client->slots[entry->slot];
+
+    if (packet->cmd_id == CMD_RETRANSMIT) {
+        // The response has left the STM32's window: ask again
+        client->stats.resends++;
+        return request_slot(client, entry->slot) ? PROTO_CLIENT_OK : PROTO_CLIENT_ERR_LINK;
+    }
+
+    if (packet->status == RESP_NO_DATA) {
+        slot->done = true;
+        *end = true;
+        return PROTO_CLIENT_OK;
+    }
+
+    if (packet->status != RESP_OK) {
+        if (++slot->retries > PROTOCOL_MAX_RETRIES) {
+            LOG_W(TAG, "GET_BUFFER_DATA refused: status %u", packet->status);
+            return PROTO_CLIENT_ERR_REFUSED;
+        }
+        client->stats.resends++;
+        return request_slot(client, entry->slot) ? PROTO_CLIENT_OK : PROTO_CLIENT_ERR_LINK;
+    }
+
+    if (packet->length < sizeof(resp_buffer_data_header_t)) {
+        return PROTO_CLIENT_ERR_PROTOCOL;
+    }
+    resp_buffer_data_header_t header;
+    memcpy(&header, packet->payload, sizeof(header));
+    if (!decode_samples(client, packet, sizeof(header), header.sensor_type, header.sample_count)) {
+        LOG_W(TAG, "Undecodable GET_BUFFER_DATA response (%u samples)", header.sample_count);
+        return PROTO_CLIENT_ERR_PROTOCOL;
+    }
+
+    uint32_t wanted = slot->count - slot->filled;
+    uint32_t got = (header.sample_count < wanted) ? header.sample_count : wanted;
+    memcpy(&slot->samples[slot->filled], client->decoded, got * sizeof(sensor_sample_t));
+    slot->filled += got;
+    slot->retries = 0;
+
+    bool compact = (packet->type & PACKET_TYPE_FLAG_COMPACT) != 0;
+    if (got == 0 || (got < wanted && !compact)) {
+        // A short plain response is the end of the buffer
+        slot->done = true;
+        *end = true;
+    } else if (got < wanted) {
+        // A compact response holds what fit; ask for the rest
+        client->stats.continuations++;
+        return request_slot(client, entry->slot) ? PROTO_CLIENT_OK : PROTO_CLIENT_ERR_LINK;
+    } else {
+        slot->done = true;
+    }
+    return PROTO_CLIENT_OK;
+}
+
+/**
+ * @brief Hand a completed slot to the callback, samples before min_timestamp left out
+ * @return Samples delivered
+ */
+static uint32_t deliver_slot(protocol_client_t *client, const protocol_client_slot_t *slot,
+                             uint32_t min_timestamp, protocol_client_samples_cb_t callback,
+                             void *user_data)
+{
+    uint32_t skip = 0;
+    while (skip < slot->filled && slot->samples[skip].timestamp < min_timestamp) {
+        skip++;
+    }
+
+    uint32_t count = slot->filled - skip;
+    if (count > 0) {
+        client->stats.samples += count;
+        callback(&slot->samples[skip], count, slot->start + skip, user_data);
+    }
+    return count;
+}
+
+static proto_client_status_t read_window(protocol_client_t *client, uint32_t start_index,
+                                         uint32_t count, uint32_t min_timestamp,
+                                         protocol_client_samples_cb_t callback, void *user_data)
+{
+    uint32_t chunk = client->compact ? PROTOCOL_CLIENT_CHUNK_COMPACT : PROTOCOL_CLIENT_CHUNK_PLAIN;
+    uint32_t next_index = start_index;
+    uint32_t to_request = (count != 0) ? count : UINT32_MAX;
+    uint32_t delivered = 0;
+    uint8_t head = 0;
+    uint8_t used = 0;
+    bool end = false;
+
+    client->pending_count = 0;
+
+    for (;;) {
+        // Hand completed slots over in order
+        while (used > 0 && client->slots[head].done) {
+            delivered += deliver_slot(client, &client->slots[head], min_timestamp,
+                                      callback, user_data);
+            head = (uint8_t)((head + 1U) % PROTOCOL_CLIENT_WINDOW_MAX);
+            used--;
+        }
+        // Keep the window full
+        while (!end && to_request > 0 && used < client->window) {
+            uint8_t slot_index = (uint8_t)((head + used) % PROTOCOL_CLIENT_WINDOW_MAX);
+            protocol_client_slot_t *slot = &client->slots[slot_index];
+            slot->start = next_index;
+            slot->count = (to_request < chunk) ? to_request : chunk;
+            slot->filled = 0;
+            slot->retries = 0;
+            slot->done = false;
+
+            next_index += slot->count;
+            to_request -= slot->count;
+            used++;
+            if (!request_slot(client, slot_index)) {
+                return PROTO_CLIENT_ERR_LINK;
+            }
+        }
+
+        if (used == 0) {
+            break;      // The window only empties at the end
+        }
+
+        proto_client_status_t status;
+        const protocol_bulk_packet_t *packet = receive_packet(client, client->config.timeout_ms);
+        if (packet == NULL) {
+            // The oldest request is the one overdue
+            status = recover_first(client, 1);
+            if (status != PROTO_CLIENT_OK) {
+                return status;
+            }
+            continue;
+        }
+
+        int position = match_pending(client, packet);
+        if (position < 0) {
+            client->stats.stray_packets++;
+            continue;
+        }
+
+        // Everything sent before the answered request is lost
+        protocol_client_pending_t answered = client->pending[position];
+        status = recover_first(client, (uint8_t)position);
+        if (status != PROTO_CLIENT_OK) {
+            return status;
+        }
+        client->pending_count--;
+        memmove(client->pending, client->pending + 1,
+                client->pending_count * sizeof(client->pending[0]));
+
+        status = take_response(client, &answered, packet, &end);
+        if (status != PROTO_CLIENT_OK) {
+            return status;
+        }
+    }
+
+    return (delivered == 0 && end) ? PROTO_CLIENT_ERR_NO_DATA : PROTO_CLIENT_OK;
+}
+
+// ============================================================================
+// Bulk Dumps
+// ============================================================================
+
+static bool grant_credits(protocol_client_t *client, uint16_t credits)
+{
+    // Fire and forget: the response is skipped while the dump runs
+    cmd_grant_credits_t grant = { .credits = credits };
+    client->stats.credits_granted += credits;
+    return send_command(client, CMD_GRANT_CREDITS, client->next_seq++, &grant, sizeof(grant));
+}
+
+/**
+ * @brief Take one NOTIFY_BULK_DATA frame
+ */
+static proto_client_status_t take_bulk_frame(protocol_client_t *client,
+                                             const protocol_bulk_packet_t *packet,
+                                             bulk_channel_t *channels, uint8_t channel_count,
+                                             protocol_client_gap_t *gaps, uint8_t *gap_count,
+                                             protocol_client_samples_cb_t callback, void *user_data,
+                                             uint32_t *received)
+{
+    if (packet->length < sizeof(notify_bulk_data_header_t)) {
+        return PROTO_CLIENT_ERR_PROTOCOL;
+    }
+    notify_bulk_data_header_t header;
+    memcpy(&header, packet->payload, sizeof(header));
+
+    bulk_channel_t *channel = NULL;
+    for (uint8_t c = 0; c < channel_count; c++) {
+        if (channels[c].sensor_type == header.sensor_type) {
+            channel = &channels[c];
+        }
+    }
+    if (channel == NULL ||
+        !decode_samples(client, packet, sizeof(header), header.sensor_type, header.sample_count)) {
+        LOG_W(TAG, "Undecodable bulk frame (sensor %u, %u samples)",
+              header.sensor_type, header.sample_count);
+        return PROTO_CLIENT_ERR_PROTOCOL;
+    }
+    *received += header.sample_count;
+
+    if (channel->truncated) {
+        return PROTO_CLIENT_OK;
+    }
+
+    uint32_t first = header.first_index;
+    uint32_t count = header.sample_count;
+    if (first > channel->next) {
+        // Frames in between were lost; the last table entries stay for the tails
+        if (*gap_count >= PROTOCOL_CLIENT_BULK_GAPS_MAX) {
+            channel->truncated = true;
+            return PROTO_CLIENT_OK;
+        }
+        gaps[(*gap_count)++] = (protocol_client_gap_t){
+            .sensor_type = channel->sensor_type,
+            .start = channel->next,
+            .count = first - channel->next,
+        };
+    }
+
+    uint32_t skip = (first < channel->next) ? channel->next - first : 0;
+    if (skip >= count) {
+        return PROTO_CLIENT_OK;
+    }
+    client->stats.samples += count - skip;
+    callback(&client->decoded[skip], count - skip, first + skip, user_data);
+    channel->next = first + count;
+    return PROTO_CLIENT_OK;
+}
+
+/**
+ * @brief One BULK_DUMP, lost ranges added to gaps[]
+ * @param gaps Table of PROTOCOL_CLIENT_BULK_GAPS_MAX + PROTOCOL_CLIENT_BULK_CHANNELS
+ */
+static proto_client_status_t bulk_pass(protocol_client_t *client, uint8_t sensor_type,
+                                       uint32_t start_index, uint32_t count,
+                                       protocol_client_gap_t *gaps, uint8_t *gap_count,
+                                       protocol_client_samples_cb_t callback, void *user_data)
+{
+    bool credits = (client->features & PROTOCOL_FEATURE_CREDITS) != 0;
+    uint16_t refill = (client->config.bulk_credits > 1U) ? client->config.bulk_credits / 2U : 1U;
+
+    bulk_channel_t channels[PROTOCOL_CLIENT_BULK_CHANNELS];
+    uint8_t channel_count = (sensor_type == SENSOR_TEMP_HUMIDITY) ? 2 : 1;
+    for (uint8_t c = 0; c < channel_count; c++) {
+        channels[c] = (bulk_channel_t){
+            .sensor_type = (sensor_type == SENSOR_TEMP_HUMIDITY)
+                           ? (c == 0 ? SENSOR_TEMPERATURE : SENSOR_HUMIDITY) : sensor_type,
+            .next = start_index,
+            .end = (count != 0) ? start_index + count : UINT32_MAX,
+            .truncated = false,
+        };
+    }
+
+    cmd_bulk_dump_t request = { .sensor_type = sensor_type, .start_index = start_index, .count = count };
+    uint8_t seq = client->next_seq++;
+    if (!send_command(client, CMD_BULK_DUMP, seq, &request, sizeof(request))) {
+        return PROTO_CLIENT_ERR_LINK;
+    }
+
+    bool started = false;
+    bool tails = false;
+    uint8_t attempts = 0;
+    uint8_t silent = 0;
+    uint16_t owed = 0;
+    uint32_t received = 0;
+
+    for (;;) {
+        const protocol_bulk_packet_t *packet = receive_packet(client, client->config.timeout_ms);
+        if (packet == NULL) {
+            if (!started) {
+                // The request or its ack was lost
+                if (++attempts > PROTOCOL_MAX_RETRIES) {
+                    return PROTO_CLIENT_ERR_TIMEOUT;
+                }
+                client->stats.resends++;
+                seq = client->next_seq++;
+                if (!send_command(client, CMD_BULK_DUMP, seq, &request, sizeof(request))) {
+                    return PROTO_CLIENT_ERR_LINK;
+                }
+                continue;
+            }
+            if (++silent > PROTOCOL_MAX_RETRIES) {
+                // NOTIFY_BULK_DONE lost: fetch each channel's rest again
+                tails = true;
+                break;
+            }
+            // A lost frame's credit never comes back; top the balance up
+            if (credits && !grant_credits(client, client->config.bulk_credits)) {
+                return PROTO_CLIENT_ERR_LINK;
+            }
+            continue;
+        }
+        silent = 0;
+
+        uint8_t type = packet->type & PACKET_TYPE_MASK;
+        if (type == PACKET_TYPE_RESP) {
+            if (packet->cmd_id == CMD_BULK_DUMP && packet->seq == seq) {
+                if (packet->status == RESP_OK) {
+                    started = true;
+                } else if (packet->status == RESP_BUSY && ++attempts <= PROTOCOL_MAX_RETRIES) {
+                    // The previous dump is still winding down
+                    (void)receive_packet(client, CLIENT_BUSY_WAIT_MS);
+                    client->stats.resends++;
+                    seq = client->next_seq++;
+                    if (!send_command(client, CMD_BULK_DUMP, seq, &request, sizeof(request))) {
+                        return PROTO_CLIENT_ERR_LINK;
+                    }
+                } else {
+                    LOG_W(TAG, "BULK_DUMP refused: status %u", packet->status);
+                    return PROTO_CLIENT_ERR_REFUSED;
+                }
+            } else if (packet->cmd_id != CMD_GRANT_CREDITS) {
+                client->stats.stray_packets++;
+            }
+            continue;
+        }
+        if (type != PACKET_TYPE_NOTIFY || packet->seq != seq) {
+            client->stats.stray_packets++;
+            continue;
+        }
+        started = true;     // Frames prove the dump runs even if its ack was lost
+
+        if (packet->cmd_id == NOTIFY_BULK_DATA) {
+            proto_client_status_t status = take_bulk_frame(
+                client, packet, channels, channel_count, gaps, gap_count,
+                callback, user_data, &received);
+            if (status != PROTO_CLIENT_OK) {
+                return status;
+            }
+            if (credits && ++owed >= refill) {
+                if (!grant_credits(client, owed)) {
+                    return PROTO_CLIENT_ERR_LINK;
+                }
+                owed = 0;
+            }
+        } else if (packet->cmd_id == NOTIFY_BULK_DONE) {
+            notify_bulk_done_t done;
+            if (packet->length < sizeof(done)) {
+                return PROTO_CLIENT_ERR_PROTOCOL;
+            }
+            memcpy(&done, packet->payload, sizeof(done));
+            if (done.status != RESP_OK && done.status != RESP_NO_DATA && done.status != RESP_TIMEOUT) {
+                LOG_W(TAG, "Bulk dump stopped: status %u", done.status);
+                return PROTO_CLIENT_ERR_REFUSED;
+            }
+            // Frames lost at the end leave no gap; a credit timeout stops early
+            tails = (received < done.sample_count) || (done.status == RESP_TIMEOUT);
+            if (done.status == RESP_NO_DATA && *gap_count == 0 && !tails) {
+                return PROTO_CLIENT_ERR_NO_DATA;
+            }
+            break;
+        } else {
+            client->stats.stray_packets++;
+        }
+    }
+
+    for (uint8_t c = 0; c < channel_count; c++) {
+        bulk_channel_t *channel = &channels[c];
+        if ((tails || channel->truncated) && channel->next < channel->end) {
+            gaps[(*gap_count)++] = (protocol_client_gap_t){
+                .sensor_type = channel->sensor_type,
+                .start = channel->next,
+                .count = (channel->end == UINT32_MAX) ? 0 : channel->end - channel->next,
+            };
+        }
+    }
+    return PROTO_CLIENT_OK;
+}
+
+/**
+ * @brief BULK_DUMP a range, then each range lost on the way, depth rounds deep
+ */
+static proto_client_status_t bulk_fetch(protocol_client_t *client, uint8_t sensor_type,
+                                        uint32_t start_index, uint32_t count, uint8_t depth,
+                                        protocol_client_samples_cb_t callback, void *user_data)
+{
+    protocol_client_gap_t gaps[PROTOCOL_CLIENT_BULK_GAPS_MAX + PROTOCOL_CLIENT_BULK_CHANNELS];
+    uint8_t gap_count = 0;
+
+    proto_client_status_t status = bulk_pass(client, sensor_type, start_index, count,
+                                             gaps, &gap_count, callback, user_data);
+    if (status != PROTO_CLIENT_OK) {
+        return status;
+    }
+    if (gap_count > 0 && depth >= PROTOCOL_MAX_RETRIES) {
+        LOG_W(TAG, "Bulk samples still missing after %d refetches", PROTOCOL_MAX_RETRIES);
+        return PROTO_CLIENT_ERR_TIMEOUT;
+    }
+
+    for (uint8_t i = 0; i < gap_count; i++) {
+        client->stats.bulk_gaps++;
+        status = bulk_fetch(client, gaps[i].sensor_type, gaps[i].start, gaps[i].count,
+                            (uint8_t)(depth + 1U), callback, user_data);
+        // A tail may turn out to be empty
+        if (status != PROTO_CLIENT_OK && status != PROTO_CLIENT_ERR_NO_DATA) {
+            return status;
+        }
+    }
+    return PROTO_CLIENT_OK;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+protocol_client_config_t protocol_client_get_default_config(void)
+{
+    protocol_client_config_t config = {
+        .timeout_ms = PROTOCOL_CLIENT_TIMEOUT_MS,
+        .window = 0,
+        .bulk_credits = PROTOCOL_CLIENT_BULK_CREDITS,
+    };
+    return config;
+}
+
+proto_client_status_t protocol_client_init(protocol_client_t *client,
+                                           const protocol_client_link_t *link,
+                                           const protocol_client_config_t *config)
+{
+    if (client == NULL || link == NULL || link->send == NULL || link->receive == NULL) {
+        return PROTO_CLIENT_ERR_INVALID_PARAM;
+    }
+
+    memset(client, 0, sizeof(*client));
+    client->link = link;
+    client->config = (config != NULL) ? *config : protocol_client_get_default_config();
+    if (client->config.bulk_credits == 0) {
+        client->config.bulk_credits = PROTOCOL_CLIENT_BULK_CREDITS;
+    }
+    client->version = PROTOCOL_VERSION_MARKERS;
+    client->window = 1;
+    return PROTO_CLIENT_OK;
+}
+
+proto_client_status_t protocol_client_hello(protocol_client_t *client, uint32_t features)
+{
+    if (client == NULL || client->link == NULL) {
+        return PROTO_CLIENT_ERR_INVALID_PARAM;
+    }
+    if (client->link->set_cobs == NULL) {
+        features &= ~PROTOCOL_FEATURE_COBS;
+    }
+
+    cmd_hello_t hello = {
+        .version = PROTOCOL_VERSION_MAX,
+        .max_payload = PROTOCOL_BULK_MAX_PAYLOAD_SIZE,
+        .features = features,
+    };
+    const protocol_bulk_packet_t *response = NULL;
+    proto_client_status_t status = protocol_client_command(client, CMD_HELLO, &hello, sizeof(hello),
+                                                           &response);
+    if (status == PROTO_CLIENT_ERR_REFUSED && response->status == RESP_INVALID_CMD) {
+        return negotiate_version(client, features);
+    }
+    if (status != PROTO_CLIENT_OK) {
+        return status;
+    }
+    if (response->length < sizeof(resp_hello_t)) {
+        return PROTO_CLIENT_ERR_PROTOCOL;
+    }
+
+    resp_hello_t agreed;
+    memcpy(&agreed, response->payload, sizeof(agreed));
+    apply_agreement(client, agreed.version, agreed.features, agreed.max_bulk_payload,
+                    agreed.window_size);
+    return PROTO_CLIENT_OK;
+}
+
+uint32_t protocol_client_features(const protocol_client_t *client)
+{
+    return (client != NULL) ? client->features : 0;
+}
+
+proto_client_status_t protocol_client_command(protocol_client_t *client, uint8_t cmd_id,
+                                              const void *payload, uint16_t payload_len,
+                                              const protocol_bulk_packet_t **response)
+{
+    if (client == NULL || client->link == NULL || (payload == NULL && payload_len > 0) ||
+        payload_len > PROTOCOL_MAX_PAYLOAD_SIZE) {
+        return PROTO_CLIENT_ERR_INVALID_PARAM;
+    }
+
+    for (uint8_t attempt = 0; attempt <= PROTOCOL_MAX_RETRIES; attempt++) {
+        if (attempt > 0) {
+            client->stats.resends++;
+        }
+        uint8_t seq = client->next_seq++;
+        if (!send_command(client, cmd_id, seq, payload, payload_len)) {
+            return PROTO_CLIENT_ERR_LINK;
+        }
+
+        const protocol_bulk_packet_t *packet;
+        while ((packet = receive_packet(client, client->config.timeout_ms)) != NULL) {
+            if ((packet->type & PACKET_TYPE_MASK) == PACKET_TYPE_RESP &&
+                packet->cmd_id == cmd_id && packet->seq == seq) {
+                if (response != NULL) {
+                    *response = packet;
+                }
+                return response_status(packet->status);
+            }
+            client->stats.stray_packets++;
+        }
+    }
+
+    LOG_W(TAG, "No response to command 0x%02X", cmd_id);
+    return PROTO_CLIENT_ERR_TIMEOUT;
+}
+
+proto_client_status_t protocol_client_read_buffer(protocol_client_t *client, uint32_t start_index,
+                                                  uint32_t count,
+                                                  protocol_client_samples_cb_t callback,
+                                                  void *user_data)
+{
+    if (client == NULL || client->link == NULL || callback == NULL) {
+        return PROTO_CLIENT_ERR_INVALID_PARAM;
+    }
+
+    return read_window(client, start_index, count, 0, callback, user_data);
+}
+
+proto_client_status_t protocol_client_bulk_dump(protocol_client_t *client, uint8_t sensor_type,
+                                                uint32_t start_index, uint32_t count,
+                                                protocol_client_samples_cb_t callback,
+                                                void *user_data)
+{
+    if (client == NULL || client->link == NULL || callback == NULL) {
+        return PROTO_CLIENT_ERR_INVALID_PARAM;
+    }
+    if (!(client->features & PROTOCOL_FEATURE_BULK)) {
+        return PROTO_CLIENT_ERR_UNSUPPORTED;
+    }
+
+    bool credits = (client->features & PROTOCOL_FEATURE_CREDITS) != 0;
+    proto_client_status_t status;
+    if (credits) {
+        cmd_grant_credits_t grant = { .credits = client->config.bulk_credits };
+        status = protocol_client_command(client, CMD_GRANT_CREDITS, &grant, sizeof(grant), NULL);
+        if (status != PROTO_CLIENT_OK) {
+            return status;
+        }
+        client->stats.credits_granted += grant.credits;
+    }
+
+    status = bulk_fetch(client, sensor_type, start_index, count, 0, callback, user_data);
+
+    if (credits) {
+        cmd_grant_credits_t off = { .credits = PROTOCOL_CREDITS_OFF };
+        proto_client_status_t off_status = protocol_client_command(
+            client, CMD_GRANT_CREDITS, &off, sizeof(off), NULL);
+        if (status == PROTO_CLIENT_OK) {
+            status = off_status;
+        }
+    }
+    return status;
+}
+
+proto_client_status_t protocol_client_resume(protocol_client_t *client, uint32_t from_timestamp,
+                                             protocol_client_samples_cb_t callback,
+                                             void *user_data)
+{
+    if (client == NULL || client->link == NULL || callback == NULL) {
+        return PROTO_CLIENT_ERR_INVALID_PARAM;
+    }
+
+    // One sample is enough to learn where from_timestamp starts
+    cmd_get_buffer_range_t request = {
+        .from_timestamp = from_timestamp,
+        .to_timestamp = 0,
+        .count = 1,
+    };
+    const protocol_bulk_packet_t *response = NULL;
+    proto_client_status_t status = protocol_client_command(
+        client, CMD_GET_BUFFER_RANGE, &request, sizeof(request), &response);
+    if (status != PROTO_CLIENT_OK) {
+        return status;
+    }
+    if (response->length < sizeof(resp_buffer_range_header_t)) {
+        return PROTO_CLIENT_ERR_PROTOCOL;
+    }
+
+    resp_buffer_range_header_t header;
+    memcpy(&header, response->payload, sizeof(header));
+    if (header.sample_count == 0) {
+        return PROTO_CLIENT_ERR_NO_DATA;
+    }
+
+    return read_window(client, header.first_index, 0, from_timestamp, callback, user_data);
+}
+
+void protocol_client_get_stats(const protocol_client_t *client, protocol_client_stats_t *stats)
+{
+    if (client == NULL || stats == NULL) {
+        return;
+    }
+    *stats = client->stats;
+}
+
+void protocol_client_reset_stats(protocol_client_t *client)
+{
+    if (client == NULL) {
+        return;
+    }
+    memset(&client->stats, 0, sizeof(client->stats));
+}
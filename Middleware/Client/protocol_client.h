@@ -0,0 +1,340 @@
+/**
+ * @file protocol_client.h
+ * @brief Reference host client for bulk downloads from the STM32
+ *
+ * The other end of protocol_handler.h, for the ESP32 or a PC: negotiates
+ * framing and features with CMD_HELLO, then downloads buffered samples in
+ * one of three ways:
+ *
+ * - protocol_client_read_buffer(): pipelined GET_BUFFER_DATA. Up to the
+ *   agreed window of requests is outstanding; responses come back in
+ *   request order, so a skipped seq is a lost request or a response that
+ *   failed its CRC. The client asks for it with CMD_RETRANSMIT and sends
+ *   the request again if it has left the STM32's window. A compact
+ *   response that holds fewer samples than asked is continued with a
+ *   request for the rest. Samples reach the callback in index order.
+ * - protocol_client_bulk_dump(): one BULK_DUMP, the NOTIFY_BULK_DATA
+ *   frames reassembled by first_index, under credit flow control when
+ *   agreed. Frames lost on the way are fetched again with a dump of just
+ *   their range once the first pass is done, so those samples arrive
+ *   after later ones (the callback gets the index of each run).
+ * - protocol_client_resume(): everything from a timestamp on, for an
+ *   incremental sync: GET_BUFFER_RANGE finds the first index, pipelined
+ *   reads fetch from there.
+ *
+ * Compact (delta/varint) payloads are decoded with Utils/sample_codec, so
+ * the callback always sees plain sensor_sample_t.
+ *
+ * The client knows nothing of the wire: the link moves whole packets
+ * (header + payload), and framing, CRC checks and the COBS switch are its
+ * business, as for protocol_transport.h on the STM32. A packet that failed
+ * its check is simply never received. Nothing here blocks except the
+ * link's receive(), so the client runs in any task or thread; one client
+ * per link, used from one context. Logs through portable_log.h.
+ *
+ * Usage example:
+ * @code
+ * static protocol_client_t client;
+ * protocol_client_config_t config = protocol_client_get_default_config();
+ * protocol_client_init(&client, &uart_link, &config);
+ * protocol_client_hello(&client, PROTOCOL_CLIENT_FEATURES);
+ * protocol_client_read_buffer(&client, 0, 0, store_samples, NULL);
+ * @endcode
+ */
+
+#ifndef PROTOCOL_CLIENT_H
+#define PROTOCOL_CLIENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "protocol_common.h"
+#include "sample_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/** Features the client implements (HELLO request) */
+#define PROTOCOL_CLIENT_FEATURES \
+    (PROTOCOL_FEATURE_COBS | PROTOCOL_FEATURE_COMPACT | PROTOCOL_FEATURE_WINDOW | \
+     PROTOCOL_FEATURE_CREDITS | PROTOCOL_FEATURE_BULK)
+
+#define PROTOCOL_CLIENT_WINDOW_MAX      PROTOCOL_WINDOW_SIZE
+#define PROTOCOL_CLIENT_TIMEOUT_MS      500     // Default wait for a response
+#define PROTOCOL_CLIENT_BULK_CREDITS    8       // Default bulk frames in flight
+
+/** Samples one GET_BUFFER_DATA request asks for: plain, and compact at best */
+#define PROTOCOL_CLIENT_CHUNK_PLAIN \
+    ((PROTOCOL_MAX_PAYLOAD_SIZE - sizeof(resp_buffer_data_header_t)) / sizeof(sensor_sample_t))
+#define PROTOCOL_CLIENT_CHUNK_COMPACT \
+    (((PROTOCOL_MAX_PAYLOAD_SIZE - sizeof(resp_buffer_data_header_t) - SAMPLE_CODEC_FIRST_MAX) / \
+      SAMPLE_CODEC_DELTA_MIN) + 1)
+
+/** Most samples one received packet can carry (a compact bulk frame) */
+#define PROTOCOL_CLIENT_DECODE_MAX \
+    (((PROTOCOL_BULK_MAX_PAYLOAD_SIZE - sizeof(notify_bulk_data_header_t) - SAMPLE_CODEC_FIRST_MAX) / \
+      SAMPLE_CODEC_DELTA_MIN) + 1)
+
+#define PROTOCOL_CLIENT_BULK_GAPS_MAX   8       // Lost bulk ranges remembered per pass
+#define PROTOCOL_CLIENT_BULK_CHANNELS   2       // SENSOR_TEMP_HUMIDITY: temperature + humidity
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Client status codes
+ */
+typedef enum {
+    PROTO_CLIENT_OK = 0,
+    PROTO_CLIENT_ERR_INVALID_PARAM = -1,
+    PROTO_CLIENT_ERR_LINK = -2,             /**< The link could not send */
+    PROTO_CLIENT_ERR_TIMEOUT = -3,          /**< No answer after PROTOCOL_MAX_RETRIES */
+    PROTO_CLIENT_ERR_REFUSED = -4,          /**< The STM32 answered with an error status */
+    PROTO_CLIENT_ERR_PROTOCOL = -5,         /**< Malformed or undecodable payload */
+    PROTO_CLIENT_ERR_UNSUPPORTED = -6,      /**< Feature not agreed at HELLO */
+    PROTO_CLIENT_ERR_NO_DATA = -7,          /**< Nothing buffered in the range asked for */
+} proto_client_status_t;
+
+/**
+ * @brief Packet link to the STM32
+ */
+typedef struct {
+    /** Frame and send one packet */
+    bool (*send)(void *ctx, const uint8_t *packet, size_t length);
+
+    /** Wait up to timeout_ms for the next valid packet; returns its length, 0 on timeout */
+    size_t (*receive)(void *ctx, uint8_t *packet, size_t size, uint32_t timeout_ms);
+
+    /** Switch both directions to COBS framing or back (NULL: the link cannot) */
+    void (*set_cobs)(void *ctx, bool cobs);
+
+    void *ctx;
+} protocol_client_link_t;
+
+/**
+ * @brief Client configuration
+ */
+typedef struct {
+    uint32_t timeout_ms;        /**< Wait for a response before recovering it */
+    uint8_t window;             /**< Requests in flight, 0 = as agreed (at most PROTOCOL_CLIENT_WINDOW_MAX) */
+    uint8_t bulk_credits;       /**< Credits kept granted during bulk dumps */
+} protocol_client_config_t;
+
+/**
+ * @brief Samples delivered by a download
+ * @param samples Samples, oldest first
+ * @param count Number of samples
+ * @param first_index Buffer index of samples[0]
+ */
+typedef void (*protocol_client_samples_cb_t)(const sensor_sample_t *samples, uint32_t count,
+                                             uint32_t first_index, void *user_data);
+
+/**
+ * @brief Client counters (since init or the last reset)
+ */
+typedef struct {
+    uint32_t requests;          /**< Commands sent, recoveries included */
+    uint32_t continuations;     /**< Requests for the rest of a short compact response */
+    uint32_t retransmits;       /**< CMD_RETRANSMIT sent */
+    uint32_t resends;           /**< Requests sent again (lost, or out of the STM32's window) */
+    uint32_t timeouts;          /**< Receive waits that ran out */
+    uint32_t packets;           /**< Packets received */
+    uint32_t compact_packets;   /**< ... with a compact sample array */
+    uint32_t stray_packets;     /**< ... matching nothing outstanding (late duplicates) */
+    uint32_t bytes;             /**< Packet bytes received, headers included */
+    uint32_t samples;           /**< Samples delivered to callbacks */
+    uint32_t bulk_gaps;         /**< Bulk ranges lost and fetched again */
+    uint32_t credits_granted;   /**< Credits granted for bulk frames */
+} protocol_client_stats_t;
+
+/** One GET_BUFFER_DATA in the window (private) */
+typedef struct {
+    uint32_t start;             /**< Buffer index of samples[0] */
+    uint32_t count;             /**< Samples asked for */
+    uint32_t filled;            /**< Samples received */
+    uint8_t retries;
+    bool done;
+    sensor_sample_t samples[PROTOCOL_CLIENT_CHUNK_COMPACT];
+} protocol_client_slot_t;
+
+/** One request awaiting its response (private) */
+typedef struct {
+    uint8_t seq;                /**< Seq of the request */
+    uint8_t target;             /**< Retransmit: seq of the response asked for again */
+    bool retransmit;
+    uint8_t slot;
+} protocol_client_pending_t;
+
+/** Lost bulk range, fetched again after the pass (private) */
+typedef struct {
+    uint8_t sensor_type;
+    uint32_t start;
+    uint32_t count;             /**< 0 = to the end */
+} protocol_client_gap_t;
+
+/**
+ * @brief Client instance
+ *
+ * Fields are private - use the API functions. Holds the window's sample
+ * slots: about 4.5 KB, allocate it statically.
+ */
+typedef struct {
+    const protocol_client_link_t *link;
+    protocol_client_config_t config;
+    uint8_t next_seq;
+
+    // Agreed at HELLO
+    uint8_t version;
+    uint32_t features;
+    uint16_t max_bulk_payload;
+    uint8_t window;
+    bool compact;
+
+    protocol_client_stats_t stats;
+
+    protocol_client_slot_t slots[PROTOCOL_CLIENT_WINDOW_MAX];
+    protocol_client_pending_t pending[PROTOCOL_CLIENT_WINDOW_MAX];  // One per slot, in send order
+    uint8_t pending_count;
+
+    uint8_t rx[PROTOCOL_HEADER_SIZE + PROTOCOL_BULK_MAX_PAYLOAD_SIZE];
+    sensor_sample_t decoded[PROTOCOL_CLIENT_DECODE_MAX];
+} protocol_client_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Get default configuration
+ */
+protocol_client_config_t protocol_client_get_default_config(void);
+
+/**
+ * @brief Initialize a client on a link
+ *
+ * Until protocol_client_hello() the client speaks version 1: marker
+ * framing, plain samples, one request at a time.
+ *
+ * @param client Client instance
+ * @param link Packet link (outlives the client)
+ * @param config Configuration (NULL for defaults)
+ * @return PROTO_CLIENT_OK, or PROTO_CLIENT_ERR_INVALID_PARAM
+ */
+proto_client_status_t protocol_client_init(protocol_client_t *client,
+                                           const protocol_client_link_t *link,
+                                           const protocol_client_config_t *config);
+
+/**
+ * @brief Agree on version, framing and features
+ *
+ * Sends CMD_HELLO, falling back to CMD_NEGOTIATE_VERSION for a firmware
+ * without it, and switches the link's framing as agreed. Can be called
+ * again to change the features.
+ *
+ * @param client Client instance
+ * @param features PROTOCOL_FEATURE_* to ask for (PROTOCOL_CLIENT_FEATURES
+ *        for all the client implements); links without set_cobs never get COBS
+ * @return PROTO_CLIENT_OK, or why the exchange failed
+ */
+proto_client_status_t protocol_client_hello(protocol_client_t *client, uint32_t features);
+
+/**
+ * @brief Features agreed at the last HELLO (PROTOCOL_FEATURE_*)
+ */
+uint32_t protocol_client_features(const protocol_client_t *client);
+
+/**
+ * @brief Send one command and wait for its response
+ *
+ * Resends on timeout, up to PROTOCOL_MAX_RETRIES times. Notifications
+ * arriving meanwhile are dropped.
+ *
+ * @param client Client instance
+ * @param cmd_id Command
+ * @param payload Request payload (may be NULL if payload_len is 0)
+ * @param payload_len Request payload length
+ * @param response Output (optional): the response, valid until the next call
+ * @return PROTO_CLIENT_OK for RESP_OK, PROTO_CLIENT_ERR_NO_DATA for
+ *         RESP_NO_DATA, PROTO_CLIENT_ERR_REFUSED for other statuses
+ */
+proto_client_status_t protocol_client_command(protocol_client_t *client, uint8_t cmd_id,
+                                              const void *payload, uint16_t payload_len,
+                                              const protocol_bulk_packet_t **response);
+
+/**
+ * @brief Download temperature samples with pipelined GET_BUFFER_DATA
+ *
+ * Indices count from the oldest sample; while the STM32 keeps sampling,
+ * the ring advancing under the download shifts them.
+ *
+ * @param client Client instance
+ * @param start_index First sample (0 = oldest)
+ * @param count Samples wanted, 0 = to the end of the buffer
+ * @param callback Receives the samples in index order
+ * @param user_data Passed to the callback
+ * @return PROTO_CLIENT_OK (also when the buffer ended early), or
+ *         PROTO_CLIENT_ERR_NO_DATA if nothing was at start_index
+ */
+proto_client_status_t protocol_client_read_buffer(protocol_client_t *client, uint32_t start_index,
+                                                  uint32_t count,
+                                                  protocol_client_samples_cb_t callback,
+                                                  void *user_data);
+
+/**
+ * @brief Download a buffer with BULK_DUMP
+ *
+ * Needs PROTOCOL_FEATURE_BULK. With PROTOCOL_FEATURE_CREDITS the client
+ * grants config.bulk_credits up front and one per frame it has taken, and
+ * turns flow control off again when done.
+ *
+ * @param client Client instance
+ * @param sensor_type Buffer (SENSOR_TEMP_HUMIDITY for both climate channels)
+ * @param start_index First sample (0 = oldest)
+ * @param count Samples wanted (per channel), 0 = to the end
+ * @param callback Receives each frame's samples; refetched ranges come last
+ * @param user_data Passed to the callback
+ * @return PROTO_CLIENT_OK, PROTO_CLIENT_ERR_NO_DATA if the buffer was empty
+ */
+proto_client_status_t protocol_client_bulk_dump(protocol_client_t *client, uint8_t sensor_type,
+                                                uint32_t start_index, uint32_t count,
+                                                protocol_client_samples_cb_t callback,
+                                                void *user_data);
+
+/**
+ * @brief Download the temperature samples from a timestamp on
+ *
+ * For an incremental sync pass the timestamp just past the newest sample
+ * already held. Samples older than from_timestamp (the ring moving while
+ * the first index was looked up) are not delivered.
+ *
+ * @param client Client instance
+ * @param from_timestamp First timestamp wanted
+ * @param callback Receives the samples in order
+ * @param user_data Passed to the callback
+ * @return PROTO_CLIENT_OK, PROTO_CLIENT_ERR_NO_DATA if nothing is that new
+ */
+proto_client_status_t protocol_client_resume(protocol_client_t *client, uint32_t from_timestamp,
+                                             protocol_client_samples_cb_t callback,
+                                             void *user_data);
+
+/**
+ * @brief Get the client counters
+ */
+void protocol_client_get_stats(const protocol_client_t *client, protocol_client_stats_t *stats);
+
+/**
+ * @brief Reset the client counters
+ */
+void protocol_client_reset_stats(protocol_client_t *client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROTOCOL_CLIENT_H
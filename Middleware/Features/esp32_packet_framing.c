@@ -13,7 +13,14 @@
 #include "portable_log.h"
 #include "pinout.h"
 #include "hal_uart.h"
+#include "hal_mem.h"
+#include "hal_crc.h"
+#include "crc16.h"
+#include "cobs.h"
+#include "hal_delay.h"
 #include "os_wrapper.h"
+#include "cycle_probe.h"
+#include "sysview_trace.h"
 #include <string.h>
 
 static const char *TAG = "ESP32_UART";
@@ -26,11 +33,18 @@ static const char *TAG = "ESP32_UART";
 #define RX_TASK_PRIORITY        10
 #define RX_POLL_INTERVAL_MS     5
 #define TX_MUTEX_TIMEOUT_MS     1000
+#define TX_FRAME_SLOTS          2       // Async frames in flight (double-buffered)
+#define RX_ERROR_LOG_INTERVAL_MS 1000   // Per-site limit for per-frame error logs
 
 // Packet structure overhead: START(1) + LENGTH(2) + DATA + CRC(2) + END(1)
 #define PACKET_OVERHEAD         6
 #define PACKET_LENGTH_OFFSET    1
 #define PACKET_DATA_OFFSET      3
+#define PACKET_HEADER_SIZE      3       // START + LENGTH
+#define PACKET_TRAILER_SIZE     3       // CRC + END
+#define PACKET_MAX_DATA_SIZE    (STM32_UART_MAX_PACKET_SIZE - PACKET_OVERHEAD)
+#define COBS_CRC_SIZE           2       // CRC16, big-endian so a valid frame has residue 0
+#define COBS_MAX_FRAME_SIZE     COBS_MAX_ENCODED_SIZE(PACKET_MAX_DATA_SIZE + COBS_CRC_SIZE)
 
 // ============================================================================
 // Internal State
@@ -46,87 +60,110 @@ typedef enum {
     RX_STATE_END,               /**< Waiting for end marker */
 } rx_state_t;
 
+typedef struct {
+    union {
+        struct {                    // STM32_UART_WIRE_MARKERS: sent as three segments
+            uint8_t header[PACKET_HEADER_SIZE];
+            uint8_t payload[PACKET_MAX_DATA_SIZE];
+            uint8_t trailer[PACKET_TRAILER_SIZE];
+        };
+        uint8_t cobs[COBS_MAX_FRAME_SIZE];  // STM32_UART_WIRE_COBS: one encoded frame
+    };
+    size_t length;                  // Payload length (for TX_COMPLETE notification)
+    size_t wire_length;             // Framed length (bytes_sent)
+} tx_frame_slot_t;
+
+// A payload built in slot->payload is COBS-encoded where it lies: the encoder
+// writes at most one code byte ahead per 254 data bytes, plus the first, so
+// it stays behind the bytes it still has to read
+_Static_assert(PACKET_HEADER_SIZE >= 1 + (PACKET_MAX_DATA_SIZE - 1) / 254,
+               "COBS in-place encoding would overrun its input");
+
+// Hot/cold groups, each from a fresh D-cache line: the RX task's per-byte
+// state, the TX path (senders and the TX complete callback) and the
+// statistics both update, apart from configuration read-mostly
 typedef struct {
     bool initialized;
     stm32_uart_config_t config;
 
+    // Tasks and synchronization
+    os_task_handle_t rx_task_handle;
+    os_mutex_handle_t tx_mutex;
+    tx_frame_slot_t *tx_slots;                       // Frames queued on the HAL TX queue
+    os_semaphore_handle_t tx_complete_sem;           // Counting: free TX slots
+
+    // Baud switch supervision (see stm32_uart_set_baud_rate())
+    uint32_t baud_fallback;                          // Rate to return to, 0 = none
+    bool baud_confirmed;                             // A valid frame arrived at the new rate
+    uint32_t baud_deadline;                          // Probation end (os_get_time_ms)
+    uint32_t baud_packets_base;                      // packets_received at the switch
+    uint32_t baud_window_start;
+    uint32_t baud_errors_base;                       // RX errors at the window start
+
     // Receive state machine
-    rx_state_t rx_state;
-    uint8_t rx_buffer[STM32_UART_MAX_PACKET_SIZE];
+    rx_state_t rx_state HAL_CACHE_ALIGNED;
+    volatile stm32_uart_wire_mode_t wire_mode;       // Current wire framing
+    uint8_t *rx_buffer;                              // Frame being parsed (one of rx_frames)
     size_t rx_index;
     uint16_t rx_expected_length;
     uint16_t rx_crc;
+    uint16_t rx_crc_running;                         // CRC over payload received so far
+    bool rx_retained;                                // rx_buffer retained in the current callback
     uint32_t rx_last_byte_time;
-
-    // Tasks and synchronization
-    os_task_handle_t rx_task_handle;
-    os_mutex_handle_t tx_mutex;
-    os_semaphore_handle_t rx_data_sem;               // Signaled when RX data available (from HAL callback)
+    size_t rx_cobs_crc_pos;                          // COBS mode: decoded bytes already CRC'd
+    cobs_decoder_t rx_cobs;                          // COBS mode: decodes into rx_buffer
+    volatile uint32_t rx_frames_held;                // Bit per rx_frames entry a consumer retained
 
     // Async TX state
-    uint8_t tx_buffer[STM32_UART_MAX_PACKET_SIZE];  // Static buffer for async TX
-    size_t tx_pending_length;                        // Length of pending TX
-    os_semaphore_handle_t tx_complete_sem;           // Signaled when TX completes
+    size_t tx_fill_slot HAL_CACHE_ALIGNED;           // Next slot to build a frame in
+    size_t tx_done_slot;                             // Oldest frame still on the wire
+    bool tx_reserved;                                // tx_fill_slot handed out by stm32_uart_tx_reserve()
     volatile bool tx_in_progress;                    // TX DMA in progress flag
+    volatile uint32_t tx_in_flight;                  // Frames queued but not yet sent
+    uint32_t tx_busy_start;                          // Cycle count when the wire last became busy
+    uint64_t tx_busy_cycles;                         // Completed busy stretches (stats.tx_busy_us)
 
     // Statistics
-    stm32_uart_stats_t stats;
+    stm32_uart_stats_t stats HAL_CACHE_ALIGNED;
 } stm32_uart_state_t;
 
 static stm32_uart_state_t state = {0};
 
+// Async TX frames are read by DMA, so keep them in the non-cacheable section
+static tx_frame_slot_t tx_frame_slots[TX_FRAME_SLOTS] HAL_DMA_BUFFER;
+
+// Received frames; consumers may hold all but the one being parsed
+static uint8_t rx_frames[STM32_UART_RX_FRAMES][STM32_UART_MAX_PACKET_SIZE];
+
+_Static_assert(STM32_UART_RX_FRAMES >= 2 && STM32_UART_RX_FRAMES < 32,
+               "rx_frames_held needs a parse frame and one bit per frame");
+
+// Kernel objects live in static storage (reused after deinit)
+OS_MUTEX_DEFINE(tx);
+OS_SEMAPHORE_DEFINE(tx_complete);
+OS_TASK_DEFINE(rx, RX_TASK_STACK_SIZE);
+
 // ============================================================================
 // CRC16-CCITT Implementation
 // ============================================================================
 
 /**
- * @brief CRC16-CCITT lookup table
+ * @brief Continue a CRC16-CCITT over more data
  */
-static const uint16_t crc16_table[256] = {
-    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
-    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
-    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
-    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
-    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
-    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
-    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
-    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
-    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
-    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
-    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
-    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
-    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
-    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
-    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
-    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
-    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
-    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
-    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
-    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
-    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
-    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
-    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
-    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
-    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
-    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
-    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
-    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
-    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
-    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
-    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
-    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
-};
+static uint16_t crc16_update(uint16_t crc, const uint8_t *data, size_t length)
+{
+#if STM32_UART_USE_HW_CRC
+    if (hal_crc_is_available()) {
+        return hal_crc_ccitt16(crc, data, length);
+    }
+#endif
+
+    return crc16_ccitt(crc, data, length);
+}
 
 uint16_t stm32_uart_crc16(const uint8_t *data, size_t length)
 {
-    uint16_t crc = 0xFFFF;  // Initial value
-    
-    for (size_t i = 0; i < length; i++) {
-        uint8_t index = (uint8_t)((crc >> 8) ^ data[i]);
-        crc = (crc << 8) ^ crc16_table[index];
-    }
-    
-    return crc;
+    return crc16_update(CRC16_CCITT_INIT, data, length);
 }
 
 // ============================================================================
@@ -134,6 +171,7 @@ uint16_t stm32_uart_crc16(const uint8_t *data, size_t length)
 // ============================================================================
 
 static void notify_event(stm32_uart_event_type_t type, uint8_t *data, size_t length);
+static void tx_busy_leave(void);
 
 // ============================================================================
 // Internal Functions
@@ -149,23 +187,52 @@ static void uart_hal_event_callback(hal_uart_port_t port, hal_uart_event_t *even
     (void)user_data;
 
     if (event->type == HAL_UART_EVENT_RX_DATA) {
-        // RX data available - signal the rx_task
-        // NOTE: This is called from task context, so use normal semaphore give (not _from_isr)
-        if (state.rx_data_sem != NULL) {
-            os_semaphore_give(state.rx_data_sem);
+        // RX data available - wake the rx_task
+        // NOTE: This is called from task context, so use the task-level notify (not _from_isr)
+        if (state.rx_task_handle != NULL) {
+            os_task_notify(state.rx_task_handle);
         }
     }
     else if (event->type == HAL_UART_EVENT_TX_DONE) {
-        // TX DMA completed - signal the semaphore
-        state.tx_in_progress = false;
+        // One frame finished - free its slot
+        size_t length = state.tx_slots[state.tx_done_slot].length;
+        state.stats.bytes_sent += state.tx_slots[state.tx_done_slot].wire_length;
+        state.tx_done_slot = (state.tx_done_slot + 1) % TX_FRAME_SLOTS;
+        tx_busy_leave();
         if (state.tx_complete_sem != NULL) {
             os_semaphore_give(state.tx_complete_sem);
         }
         state.stats.packets_sent++;
-        notify_event(STM32_UART_EVENT_TX_COMPLETE, NULL, state.tx_pending_length);
+        notify_event(STM32_UART_EVENT_TX_COMPLETE, NULL, length);
     }
 }
 
+/**
+ * @brief A frame goes on the wire (TX busy time accounting)
+ */
+static void tx_busy_enter(void)
+{
+    uint32_t mask = os_critical_enter();
+    if (state.tx_in_flight++ == 0) {
+        state.tx_busy_start = hal_get_cycle_count();
+    }
+    state.tx_in_progress = true;
+    os_critical_exit(mask);
+}
+
+/**
+ * @brief A frame left the wire, or was never queued
+ */
+static void tx_busy_leave(void)
+{
+    uint32_t mask = os_critical_enter();
+    if (state.tx_in_flight > 0 && --state.tx_in_flight == 0) {
+        state.tx_busy_cycles += hal_get_cycle_count() - state.tx_busy_start;
+    }
+    state.tx_in_progress = (state.tx_in_flight > 0);
+    os_critical_exit(mask);
+}
+
 /**
  * @brief Reset receive state machine
  */
@@ -175,6 +242,46 @@ static void rx_reset_state(void)
     state.rx_index = 0;
     state.rx_expected_length = 0;
     state.rx_crc = 0;
+    state.rx_crc_running = CRC16_CCITT_INIT;
+    cobs_decoder_reset(&state.rx_cobs);
+    state.rx_cobs_crc_pos = 0;
+}
+
+/**
+ * @brief Move the parser to a free frame if the consumer kept the last one
+ * @note Call right after a PACKET_RECEIVED callback
+ */
+static void rx_frame_delivered(void)
+{
+    if (!state.rx_retained) {
+        return;
+    }
+    state.rx_retained = false;
+
+    uint32_t mask = os_critical_enter();
+    uint32_t held = state.rx_frames_held;
+    os_critical_exit(mask);
+
+    // stm32_uart_rx_retain() made sure one is free; releases only add more
+    for (size_t i = 0; i < STM32_UART_RX_FRAMES; i++) {
+        if ((held & (1UL << i)) == 0) {
+            state.rx_buffer = rx_frames[i];
+            break;
+        }
+    }
+    cobs_decoder_init(&state.rx_cobs, state.rx_buffer, STM32_UART_MAX_PACKET_SIZE);
+}
+
+/**
+ * @brief rx_frames entry holding data, or -1
+ */
+static int rx_frame_index(const uint8_t *data)
+{
+    uintptr_t offset = (uintptr_t)data - (uintptr_t)rx_frames[0];
+    if (data < rx_frames[0] || offset >= sizeof(rx_frames) || offset % STM32_UART_MAX_PACKET_SIZE != 0) {
+        return -1;
+    }
+    return (int)(offset / STM32_UART_MAX_PACKET_SIZE);
 }
 
 /**
@@ -194,28 +301,18 @@ static void notify_event(stm32_uart_event_type_t type, uint8_t *data, size_t len
 
 /**
  * @brief Process a received byte through the state machine
+ * @note Inter-byte timeout is checked by rx_process_bytes(), once per span
  */
-static void rx_process_byte(uint8_t byte)
+static HAL_ITCM_FUNC void rx_process_byte(uint8_t byte)
 {
-    uint32_t now = os_get_time_ms();
-    
-    // Check for timeout (reset state if too long between bytes)
-    if (state.config.rx_timeout_ms > 0 && 
-        state.rx_state != RX_STATE_IDLE &&
-        (now - state.rx_last_byte_time) > state.config.rx_timeout_ms) {
-        LOG_W(TAG, "RX timeout, resetting state machine");
-        state.stats.timeout_errors++;
-        notify_event(STM32_UART_EVENT_TIMEOUT, NULL, 0);
-        rx_reset_state();
-    }
-    
-    state.rx_last_byte_time = now;
-    
+    CYCLE_PROBE_BEGIN(CYCLE_PROBE_UART_RX_BYTE);
+
     switch (state.rx_state) {
         case RX_STATE_IDLE:
             if (byte == STM32_PACKET_START_MARKER) {
                 state.rx_state = RX_STATE_LENGTH_LOW;
                 state.rx_index = 0;
+                state.rx_crc_running = CRC16_CCITT_INIT;
             }
             break;
             
@@ -227,7 +324,7 @@ static void rx_process_byte(uint8_t byte)
         case RX_STATE_LENGTH_HIGH:
             state.rx_expected_length |= (uint16_t)byte << 8;
             if (state.rx_expected_length > STM32_UART_MAX_PACKET_SIZE - PACKET_OVERHEAD) {
-                LOG_W(TAG, "Packet too large: %u bytes", state.rx_expected_length);
+                LOG_W_LIMITED(TAG, RX_ERROR_LOG_INTERVAL_MS, "Packet too large: %u bytes", state.rx_expected_length);
                 state.stats.framing_errors++;
                 rx_reset_state();
             } else if (state.rx_expected_length == 0) {
@@ -240,6 +337,7 @@ static void rx_process_byte(uint8_t byte)
             
         case RX_STATE_DATA:
             state.rx_buffer[state.rx_index++] = byte;
+            state.rx_crc_running = crc16_update(state.rx_crc_running, &byte, 1);
             if (state.rx_index >= state.rx_expected_length) {
                 state.rx_state = RX_STATE_CRC_LOW;
             }
@@ -257,62 +355,284 @@ static void rx_process_byte(uint8_t byte)
             
         case RX_STATE_END:
             if (byte == STM32_PACKET_END_MARKER) {
-                // Validate CRC
-                uint16_t calculated_crc = stm32_uart_crc16(state.rx_buffer, state.rx_index);
+                uint32_t end_marker_cycles = hal_get_cycle_count();
+
+                // Validate CRC (already accumulated while the payload arrived)
+                uint16_t calculated_crc = state.rx_crc_running;
                 if (calculated_crc == state.rx_crc) {
                     // Valid packet received
                     state.stats.packets_received++;
                     LOG_D(TAG, "Packet received: %u bytes", state.rx_index);
+
+                    uint32_t latency = hal_get_cycle_count() - end_marker_cycles;
+                    state.stats.rx_validate_cycles_last = latency;
+                    if (latency > state.stats.rx_validate_cycles_max) {
+                        state.stats.rx_validate_cycles_max = latency;
+                    }
+
+                    SYSVIEW_TRACE_U32(SYSVIEW_EVT_UART_RX_PACKET, state.rx_index);
                     notify_event(STM32_UART_EVENT_PACKET_RECEIVED, 
                                 state.rx_buffer, state.rx_index);
+                    rx_frame_delivered();
                 } else {
                     // CRC mismatch
-                    LOG_W(TAG, "CRC error: expected 0x%04X, got 0x%04X", 
-                            state.rx_crc, calculated_crc);
+                    LOG_W_LIMITED(TAG, RX_ERROR_LOG_INTERVAL_MS, "CRC error: expected 0x%04X, got 0x%04X",
+                                  state.rx_crc, calculated_crc);
                     state.stats.crc_errors++;
                     notify_event(STM32_UART_EVENT_CRC_ERROR, NULL, 0);
                 }
             } else {
                 // Invalid end marker
-                LOG_W(TAG, "Invalid end marker: 0x%02X", byte);
+                LOG_W_LIMITED(TAG, RX_ERROR_LOG_INTERVAL_MS, "Invalid end marker: 0x%02X", byte);
                 state.stats.framing_errors++;
                 notify_event(STM32_UART_EVENT_RX_ERROR, NULL, 0);
             }
             rx_reset_state();
             break;
     }
+
+    CYCLE_PROBE_END(CYCLE_PROBE_UART_RX_BYTE);
+}
+
+/**
+ * @brief Process a span of received bytes in COBS mode
+ *
+ * Every 0x00 ends a frame, so after corruption the parser is back in sync
+ * at the next delimiter. The CRC runs over decoded bytes as they arrive.
+ */
+static HAL_ITCM_FUNC void rx_process_cobs(const uint8_t *data, size_t length)
+{
+    while (length > 0) {
+        size_t consumed;
+        cobs_decode_result_t result = cobs_decoder_feed(&state.rx_cobs, data, length, &consumed);
+
+        size_t decoded = state.rx_cobs.length;
+        if (decoded > state.rx_cobs_crc_pos) {
+            state.rx_crc_running = crc16_update(state.rx_crc_running,
+                                                &state.rx_buffer[state.rx_cobs_crc_pos],
+                                                decoded - state.rx_cobs_crc_pos);
+            state.rx_cobs_crc_pos = decoded;
+        }
+
+        if (result == COBS_DECODE_EMPTY) {
+            // Back-to-back delimiters (idle line fill), not a frame
+        } else if (result == COBS_DECODE_FRAME && decoded >= COBS_CRC_SIZE) {
+            uint32_t end_marker_cycles = hal_get_cycle_count();
+            size_t payload_length = decoded - COBS_CRC_SIZE;
+
+            if (state.rx_crc_running == 0) {
+                state.stats.packets_received++;
+                LOG_D(TAG, "Packet received: %u bytes", payload_length);
+
+                uint32_t latency = hal_get_cycle_count() - end_marker_cycles;
+                state.stats.rx_validate_cycles_last = latency;
+                if (latency > state.stats.rx_validate_cycles_max) {
+                    state.stats.rx_validate_cycles_max = latency;
+                }
+
+                SYSVIEW_TRACE_U32(SYSVIEW_EVT_UART_RX_PACKET, payload_length);
+                notify_event(STM32_UART_EVENT_PACKET_RECEIVED, state.rx_buffer, payload_length);
+                rx_frame_delivered();
+            } else {
+                LOG_W_LIMITED(TAG, RX_ERROR_LOG_INTERVAL_MS, "CRC error on COBS frame (%u bytes)", payload_length);
+                state.stats.crc_errors++;
+                notify_event(STM32_UART_EVENT_CRC_ERROR, NULL, 0);
+            }
+        } else if (result != COBS_DECODE_MORE) {
+            LOG_W_LIMITED(TAG, RX_ERROR_LOG_INTERVAL_MS, "Malformed COBS frame");
+            state.stats.framing_errors++;
+            notify_event(STM32_UART_EVENT_RX_ERROR, NULL, 0);
+        }
+
+        if (result != COBS_DECODE_MORE) {
+            rx_reset_state();
+        }
+
+        data += consumed;
+        length -= consumed;
+    }
+}
+
+/**
+ * @brief Process a span of received bytes
+ *
+ * Header and trailer bytes go through rx_process_byte(); payload bytes are
+ * copied into rx_buffer with one memcpy per span.
+ */
+static HAL_ITCM_FUNC void rx_process_bytes(const uint8_t *data, size_t length)
+{
+    if (length == 0) {
+        return;
+    }
+
+    uint32_t now = os_get_time_ms();
+    state.stats.bytes_received += length;
+
+    // Check for timeout (reset state if too long since the previous span)
+    if (state.config.rx_timeout_ms > 0 &&
+        state.rx_state != RX_STATE_IDLE &&
+        (now - state.rx_last_byte_time) > state.config.rx_timeout_ms) {
+        LOG_W_LIMITED(TAG, RX_ERROR_LOG_INTERVAL_MS, "RX timeout, resetting state machine");
+        state.stats.timeout_errors++;
+        notify_event(STM32_UART_EVENT_TIMEOUT, NULL, 0);
+        rx_reset_state();
+    }
+
+    state.rx_last_byte_time = now;
+
+    if (state.wire_mode == STM32_UART_WIRE_COBS) {
+        rx_process_cobs(data, length);
+        return;
+    }
+
+    size_t i = 0;
+    while (i < length) {
+        if (state.rx_state == RX_STATE_DATA) {
+            // Bulk copy as much of the payload as this span holds
+            size_t chunk = state.rx_expected_length - state.rx_index;
+            if (chunk > length - i) {
+                chunk = length - i;
+            }
+            memcpy(&state.rx_buffer[state.rx_index], &data[i], chunk);
+            state.rx_crc_running = crc16_update(state.rx_crc_running, &data[i], chunk);
+            state.rx_index += chunk;
+            i += chunk;
+            if (state.rx_index >= state.rx_expected_length) {
+                state.rx_state = RX_STATE_CRC_LOW;
+            }
+        } else if (state.rx_state == RX_STATE_IDLE) {
+            // Skip noise up to the next start marker
+            const uint8_t *start = memchr(&data[i], STM32_PACKET_START_MARKER, length - i);
+            if (start == NULL) {
+                break;
+            }
+            i = (size_t)(start - data);
+            rx_process_byte(data[i++]);
+        } else {
+            rx_process_byte(data[i++]);
+        }
+    }
+}
+
+static uint32_t rx_error_count(void)
+{
+    return state.stats.crc_errors + state.stats.framing_errors + state.stats.overflow_errors;
+}
+
+/**
+ * @brief Switch the UART once the frames queued at the old rate are sent
+ */
+static uart_driver_status_t apply_baud_rate(uint32_t baud_rate)
+{
+    if (os_mutex_take(state.tx_mutex, TX_MUTEX_TIMEOUT_MS) != OS_SUCCESS) {
+        return UART_DRV_ERR_TIMEOUT;
+    }
+
+    uart_driver_status_t status = stm32_uart_wait_tx_complete(TX_MUTEX_TIMEOUT_MS);
+    if (status == UART_DRV_OK) {
+        if (hal_uart_set_baudrate((hal_uart_port_t)STM32_UART_PORT, baud_rate)) {
+            state.config.baud_rate = baud_rate;
+            rx_reset_state();
+        } else {
+            status = UART_DRV_ERR_INVALID_PARAM;
+        }
+    }
+
+    os_mutex_give(state.tx_mutex);
+    return status;
+}
+
+/**
+ * @brief Return to the fallback rate if a switched rate is not working out
+ * @note RX task context, after each parse pass
+ */
+static void baud_supervise(void)
+{
+    if (state.baud_fallback == 0) {
+        return;
+    }
+
+    uint32_t now = os_get_time_ms();
+    uint32_t errors = rx_error_count();
+    const char *reason = NULL;
+
+    if (!state.baud_confirmed) {
+        if (state.stats.packets_received != state.baud_packets_base) {
+            state.baud_confirmed = true;
+        } else if ((int32_t)(now - state.baud_deadline) >= 0) {
+            reason = "no valid frame";
+        }
+    }
+
+    if (reason == NULL && errors - state.baud_errors_base > STM32_UART_BAUD_ERROR_LIMIT) {
+        reason = "error spike";
+    }
+
+    if (reason == NULL) {
+        if (now - state.baud_window_start >= STM32_UART_BAUD_ERROR_WINDOW_MS) {
+            state.baud_window_start = now;
+            state.baud_errors_base = errors;
+        }
+        return;
+    }
+
+    uint32_t baud_rate = state.baud_fallback;
+    uint32_t failed_rate = state.config.baud_rate;
+    state.baud_fallback = 0;
+
+    if (apply_baud_rate(baud_rate) != UART_DRV_OK) {
+        LOG_E(TAG, "Baud fallback to %lu failed", (unsigned long)baud_rate);
+        return;
+    }
+    LOG_W(TAG, "Baud %lu abandoned (%s), back to %lu", (unsigned long)failed_rate, reason,
+          (unsigned long)baud_rate);
+    notify_event(STM32_UART_EVENT_BAUD_FALLBACK, NULL, baud_rate);
+}
+
+/**
+ * @brief How long the RX task may sleep without missing a supervision check
+ */
+static uint32_t baud_supervise_wait_ms(void)
+{
+    if (state.baud_fallback == 0) {
+        return OS_WAIT_FOREVER;
+    }
+
+    uint32_t due = state.baud_window_start + STM32_UART_BAUD_ERROR_WINDOW_MS;
+    if (!state.baud_confirmed && (int32_t)(state.baud_deadline - due) < 0) {
+        due = state.baud_deadline;
+    }
+    int32_t left = (int32_t)(due - os_get_time_ms());
+    return (left > 0) ? (uint32_t)left : 1;
 }
 
 /**
  * @brief Receive task - processes incoming bytes from UART buffer
  *
- * Blocks on rx_data_sem which is signaled by HAL callback when RX data arrives.
- * Uses ISR-based triggering for low latency and reduced CPU usage.
+ * Waits for a task notification, sent by the HAL callback when RX data arrives.
+ * Uses ISR-based triggering for low latency and reduced CPU usage. There is
+ * no polling timeout: only a baud rate on probation bounds the wait.
  */
 static void rx_task(void *arg)
 {
     (void)arg;
-    uint8_t rx_buffer[64];
 
-    LOG_I(TAG, "RX task started (ISR-based)");
+    LOG_I(TAG, "RX task started (ISR-based, zero-copy)");
 
     while (1) {
-        // Block until RX data available (signaled by HAL callback) or timeout
-        // Use 50ms timeout as safety fallback
-        os_semaphore_take(state.rx_data_sem, 50);
-
-        // Process all available data
-        int available = hal_uart_available((hal_uart_port_t)STM32_UART_PORT);
+        // Block until RX data available (notified by HAL callback)
+        os_task_notify_wait(baud_supervise_wait_ms());
 
-        if (available > 0) {
-            int to_read = (available > (int)sizeof(rx_buffer)) ? (int)sizeof(rx_buffer) : available;
-            int bytes_read = hal_uart_read((hal_uart_port_t)STM32_UART_PORT,
-                                           rx_buffer, to_read, 0);
+        // Parse all available data in place from the DMA buffer
+        const uint8_t *span;
+        size_t length;
 
-            for (int i = 0; i < bytes_read; i++) {
-                rx_process_byte(rx_buffer[i]);
-            }
+        while ((length = hal_uart_rx_peek((hal_uart_port_t)STM32_UART_PORT, &span)) > 0) {
+            rx_process_bytes(span, length);
+            hal_uart_rx_consume((hal_uart_port_t)STM32_UART_PORT, length);
         }
+
+        baud_supervise();
     }
 }
 
@@ -357,6 +677,12 @@ uart_driver_status_t stm32_uart_init(const stm32_uart_config_t *config)
     uart_config.rx_pin = STM32_UART_RX_PIN;
     uart_config.rx_buffer_size = STM32_UART_RX_BUFFER_SIZE;
     uart_config.tx_buffer_size = STM32_UART_TX_BUFFER_SIZE;
+    // Parsed in place from the DMA ring: size it for the fastest switchable rate
+    uart_config.rx_dma_buffer_size = hal_uart_rx_dma_size_for(STM32_UART_BAUD_MAX,
+                                                              STM32_UART_RX_MAX_LATENCY_MS);
+    // Frame ends wake the parser even without a gap; the timeout covers the rest
+    uart_config.rx_timeout_bits = STM32_UART_RX_TIMEOUT_BITS;
+    uart_config.rx_match_char = STM32_PACKET_END_MARKER;
     
     if (config->use_flow_control) {
         uart_config.flow_ctrl = HAL_UART_FLOW_CTRL_RTS_CTS;
@@ -369,50 +695,60 @@ uart_driver_status_t stm32_uart_init(const stm32_uart_config_t *config)
         return UART_DRV_ERR_TX_FAILED;
     }
     
+    crc16_init();
+
+#if STM32_UART_USE_HW_CRC
+    if (!hal_crc_init()) {
+        LOG_W(TAG, "Hardware CRC unavailable, using table CRC");
+    }
+#endif
+
     // Create TX mutex
-    state.tx_mutex = os_mutex_create();
+    state.tx_mutex = OS_MUTEX_CREATE_STATIC(tx);
     if (state.tx_mutex == NULL) {
         LOG_E(TAG, "Failed to create TX mutex");
         hal_uart_deinit((hal_uart_port_t)STM32_UART_PORT);
         return UART_DRV_ERR_MEMORY;
     }
 
-    // Create RX data semaphore (binary, initially empty)
-    state.rx_data_sem = os_semaphore_create_binary();
-    if (state.rx_data_sem == NULL) {
-        LOG_E(TAG, "Failed to create RX semaphore");
-        os_mutex_delete(state.tx_mutex);
-        hal_uart_deinit((hal_uart_port_t)STM32_UART_PORT);
-        return UART_DRV_ERR_MEMORY;
-    }
-
-    // Create TX complete semaphore (binary, initially available)
-    state.tx_complete_sem = os_semaphore_create_binary();
+    // Create TX slot semaphore (counting, all slots initially free)
+    state.tx_complete_sem = OS_SEMAPHORE_CREATE_COUNTING_STATIC(tx_complete, TX_FRAME_SLOTS, TX_FRAME_SLOTS);
     if (state.tx_complete_sem == NULL) {
         LOG_E(TAG, "Failed to create TX semaphore");
-        os_semaphore_delete(state.rx_data_sem);
         os_mutex_delete(state.tx_mutex);
         hal_uart_deinit((hal_uart_port_t)STM32_UART_PORT);
         return UART_DRV_ERR_MEMORY;
     }
-    // Give semaphore initially so first TX can proceed
-    os_semaphore_give(state.tx_complete_sem);
+    state.tx_slots = tx_frame_slots;
+    state.tx_fill_slot = 0;
+    state.tx_reserved = false;
+    state.tx_done_slot = 0;
+    state.tx_in_flight = 0;
     state.tx_in_progress = false;
+    state.tx_busy_cycles = 0;
+
+    // Parse RX directly from the DMA buffer
+    hal_uart_rx_set_zero_copy((hal_uart_port_t)STM32_UART_PORT, true);
 
     // Register callback for TX_DONE events
     hal_uart_register_callback((hal_uart_port_t)STM32_UART_PORT, uart_hal_event_callback, NULL);
 
-    // Reset state machine
+    // Reset state machine (always start in marker framing until negotiated)
+    state.wire_mode = STM32_UART_WIRE_MARKERS;
+    state.rx_buffer = rx_frames[0];
+    state.rx_frames_held = 0;
+    state.rx_retained = false;
+    cobs_decoder_init(&state.rx_cobs, state.rx_buffer, STM32_UART_MAX_PACKET_SIZE);
     rx_reset_state();
     memset(&state.stats, 0, sizeof(stm32_uart_stats_t));
+    state.baud_fallback = 0;
     
     // Create receive task
-    os_result_t ret = os_task_create_pinned(rx_task, "stm32_rx", RX_TASK_STACK_SIZE,
-                                           NULL, RX_TASK_PRIORITY, &state.rx_task_handle, 1);
+    os_result_t ret = OS_TASK_CREATE_STATIC(rx, rx_task, "stm32_rx", NULL, RX_TASK_PRIORITY,
+                                            &state.rx_task_handle);
     if (ret != OS_SUCCESS) {
         LOG_E(TAG, "Failed to create RX task");
         os_semaphore_delete(state.tx_complete_sem);
-        os_semaphore_delete(state.rx_data_sem);
         os_mutex_delete(state.tx_mutex);
         hal_uart_deinit((hal_uart_port_t)STM32_UART_PORT);
         return UART_DRV_ERR_MEMORY;
@@ -433,8 +769,9 @@ uart_driver_status_t stm32_uart_deinit(void)
     
     // Stop RX task
     if (state.rx_task_handle != NULL) {
-        os_task_delete(state.rx_task_handle);
-        state.rx_task_handle = NULL;
+        os_task_handle_t rx_task_handle = state.rx_task_handle;
+        state.rx_task_handle = NULL;    // Stop RX notifications first
+        os_task_delete(rx_task_handle);
     }
 
     // Delete TX mutex
@@ -443,12 +780,6 @@ uart_driver_status_t stm32_uart_deinit(void)
         state.tx_mutex = NULL;
     }
 
-    // Delete RX data semaphore
-    if (state.rx_data_sem != NULL) {
-        os_semaphore_delete(state.rx_data_sem);
-        state.rx_data_sem = NULL;
-    }
-
     // Delete TX semaphore
     if (state.tx_complete_sem != NULL) {
         os_semaphore_delete(state.tx_complete_sem);
@@ -475,42 +806,25 @@ uart_driver_status_t stm32_uart_send_packet(const uint8_t *data, size_t length,
         return UART_DRV_ERR_PACKET_TOO_LARGE;
     }
     
+    CYCLE_PROBE_BEGIN(CYCLE_PROBE_UART_SEND_PACKET);
+
     // Acquire TX mutex
     if (os_mutex_take(state.tx_mutex, TX_MUTEX_TIMEOUT_MS) != OS_SUCCESS) {
         LOG_E(TAG, "Failed to acquire TX mutex");
         return UART_DRV_ERR_TIMEOUT;
     }
     
-    // Build packet: START + LENGTH(2) + DATA + CRC(2) + END
-    uint8_t tx_buffer[STM32_UART_MAX_PACKET_SIZE];
-    size_t tx_index = 0;
-    
-    // Start marker
-    tx_buffer[tx_index++] = STM32_PACKET_START_MARKER;
-    
-    // Length (little-endian)
-    tx_buffer[tx_index++] = (uint8_t)(length & 0xFF);
-    tx_buffer[tx_index++] = (uint8_t)((length >> 8) & 0xFF);
-    
-    // Data
-    if (data != NULL && length > 0) {
-        memcpy(&tx_buffer[tx_index], data, length);
-        tx_index += length;
-    }
-    
-    // CRC (calculated over data only)
-    uint16_t crc = stm32_uart_crc16(data, length);
-    tx_buffer[tx_index++] = (uint8_t)(crc & 0xFF);
-    tx_buffer[tx_index++] = (uint8_t)((crc >> 8) & 0xFF);
-    
-    // End marker
-    tx_buffer[tx_index++] = STM32_PACKET_END_MARKER;
+    // Build the wire frame for the current mode
+    uint8_t tx_buffer[COBS_MAX_FRAME_SIZE];
+    size_t tx_index = stm32_uart_encode_frame(data, length, tx_buffer, sizeof(tx_buffer));
     
     // Send packet
+    SYSVIEW_TRACE_U32(SYSVIEW_EVT_UART_TX_PACKET, length);
     int sent = hal_uart_write((hal_uart_port_t)STM32_UART_PORT, 
                                tx_buffer, tx_index, timeout_ms);
     
     os_mutex_give(state.tx_mutex);
+    CYCLE_PROBE_END(CYCLE_PROBE_UART_SEND_PACKET);
     
     if (sent != (int)tx_index) {
         LOG_E(TAG, "Failed to send packet: sent %d of %u bytes", sent, tx_index);
@@ -518,6 +832,7 @@ uart_driver_status_t stm32_uart_send_packet(const uint8_t *data, size_t length,
     }
     
     state.stats.packets_sent++;
+    state.stats.bytes_sent += tx_index;
     LOG_D(TAG, "Packet sent: %u bytes (total frame: %u)", length, tx_index);
 
     // Notify TX complete
@@ -526,85 +841,170 @@ uart_driver_status_t stm32_uart_send_packet(const uint8_t *data, size_t length,
     return UART_DRV_OK;
 }
 
-uart_driver_status_t stm32_uart_send_packet_async(const uint8_t *data, size_t length)
+/**
+ * @brief Take the TX lock and the next free frame slot
+ * @note On success the caller holds tx_mutex until tx_slot_send() or tx_slot_release()
+ */
+static uart_driver_status_t tx_slot_acquire(void)
 {
-    if (!state.initialized) {
-        return UART_DRV_ERR_NOT_INITIALIZED;
-    }
+    uint32_t start = hal_get_cycle_count();
 
-    if (length > STM32_UART_MAX_PACKET_SIZE - PACKET_OVERHEAD) {
-        LOG_E(TAG, "Packet too large: %u bytes", length);
-        return UART_DRV_ERR_PACKET_TOO_LARGE;
-    }
-
-    // Acquire TX mutex to protect buffer access
     if (os_mutex_take(state.tx_mutex, TX_MUTEX_TIMEOUT_MS) != OS_SUCCESS) {
         LOG_E(TAG, "Failed to acquire TX mutex");
         return UART_DRV_ERR_TIMEOUT;
     }
 
-    // Wait for previous TX to complete (with timeout)
-    if (state.tx_in_progress) {
-        if (os_semaphore_take(state.tx_complete_sem, TX_MUTEX_TIMEOUT_MS) != OS_SUCCESS) {
-            os_mutex_give(state.tx_mutex);
-            LOG_E(TAG, "Previous TX did not complete in time");
-            return UART_DRV_ERR_TIMEOUT;
-        }
+    // Wait for a free frame slot (only blocks when all slots are on the wire)
+    if (os_semaphore_take(state.tx_complete_sem, TX_MUTEX_TIMEOUT_MS) != OS_SUCCESS) {
+        os_mutex_give(state.tx_mutex);
+        LOG_E(TAG, "Previous TX did not complete in time");
+        return UART_DRV_ERR_TIMEOUT;
     }
 
-    // Also wait for HAL layer TX to complete
-    uint32_t wait_start = os_get_time_ms();
-    while (hal_uart_tx_busy((hal_uart_port_t)STM32_UART_PORT)) {
-        if ((os_get_time_ms() - wait_start) > TX_MUTEX_TIMEOUT_MS) {
-            os_mutex_give(state.tx_mutex);
-            LOG_E(TAG, "HAL TX did not complete in time");
-            return UART_DRV_ERR_TIMEOUT;
-        }
-        os_delay_ms(1);
+    // Under the TX mutex, so the stats need no further locking
+    uint32_t wait_us = (hal_get_cycle_count() - start) / (hal_get_cpu_freq_hz() / 1000000U);
+    uint8_t bucket = 0;
+    while (bucket < STM32_UART_TX_WAIT_BUCKETS - 1 && (wait_us >> bucket) != 0) {
+        bucket++;
     }
+    state.stats.tx_waits++;
+    state.stats.tx_wait_us += wait_us;
+    state.stats.tx_wait_hist[bucket]++;
 
-    // Build packet in the static TX buffer
-    size_t tx_index = 0;
-
-    // Start marker
-    state.tx_buffer[tx_index++] = STM32_PACKET_START_MARKER;
+    return UART_DRV_OK;
+}
 
-    // Length (little-endian)
-    state.tx_buffer[tx_index++] = (uint8_t)(length & 0xFF);
-    state.tx_buffer[tx_index++] = (uint8_t)((length >> 8) & 0xFF);
+/**
+ * @brief Give back an acquired slot unsent
+ */
+static void tx_slot_release(void)
+{
+    os_semaphore_give(state.tx_complete_sem);
+    os_mutex_give(state.tx_mutex);
+}
 
-    // Data
-    if (data != NULL && length > 0) {
-        memcpy(&state.tx_buffer[tx_index], data, length);
-        tx_index += length;
-    }
+/**
+ * @brief Frame the acquired slot and queue it on the HAL, then unlock
+ *
+ * @param data Payload; may be the slot's own payload area, which is
+ *             framed where it lies (COBS encodes it in place)
+ */
+static uart_driver_status_t tx_slot_send(const uint8_t *data, size_t length)
+{
+    tx_frame_slot_t *slot = &state.tx_slots[state.tx_fill_slot];
+    hal_uart_tx_segment_t segments[3];
+    size_t segment_count;
+
+    if (state.wire_mode == STM32_UART_WIRE_COBS) {
+        segments[0].data = slot->cobs;
+        segments[0].len = stm32_uart_encode_frame(data, length, slot->cobs, sizeof(slot->cobs));
+        segment_count = 1;
+    } else {
+        // Start marker + length (little-endian)
+        slot->header[0] = STM32_PACKET_START_MARKER;
+        slot->header[1] = (uint8_t)(length & 0xFF);
+        slot->header[2] = (uint8_t)((length >> 8) & 0xFF);
+
+        // Data
+        if (data != NULL && data != slot->payload && length > 0) {
+            memcpy(slot->payload, data, length);
+        }
 
-    // CRC (calculated over data only)
-    uint16_t crc = stm32_uart_crc16(data, length);
-    state.tx_buffer[tx_index++] = (uint8_t)(crc & 0xFF);
-    state.tx_buffer[tx_index++] = (uint8_t)((crc >> 8) & 0xFF);
+        // CRC (calculated over data only) + end marker
+        uint16_t crc = stm32_uart_crc16(slot->payload, length);
+        slot->trailer[0] = (uint8_t)(crc & 0xFF);
+        slot->trailer[1] = (uint8_t)((crc >> 8) & 0xFF);
+        slot->trailer[2] = STM32_PACKET_END_MARKER;
 
-    // End marker
-    state.tx_buffer[tx_index++] = STM32_PACKET_END_MARKER;
+        segments[0] = (hal_uart_tx_segment_t){ .data = slot->header,  .len = PACKET_HEADER_SIZE };
+        segments[1] = (hal_uart_tx_segment_t){ .data = slot->payload, .len = length };
+        segments[2] = (hal_uart_tx_segment_t){ .data = slot->trailer, .len = PACKET_TRAILER_SIZE };
+        segment_count = 3;
+    }
+    slot->length = length;
+    slot->wire_length = 0;
+    for (size_t i = 0; i < segment_count; i++) {
+        slot->wire_length += segments[i].len;
+    }
 
-    // Store pending length for callback
-    state.tx_pending_length = length;
-    state.tx_in_progress = true;
+    tx_busy_enter();
 
-    // Start async DMA transmission
-    if (!hal_uart_write_async((hal_uart_port_t)STM32_UART_PORT, state.tx_buffer, tx_index)) {
-        state.tx_in_progress = false;
-        os_mutex_give(state.tx_mutex);
+    // Queue the frame segments; the HAL chains them behind any frame in flight
+    SYSVIEW_TRACE_U32(SYSVIEW_EVT_UART_TX_PACKET, length);
+    if (!hal_uart_write_async_sg((hal_uart_port_t)STM32_UART_PORT, segments, segment_count)) {
+        tx_busy_leave();
+        tx_slot_release();
         LOG_E(TAG, "Failed to start async TX");
         return UART_DRV_ERR_TX_FAILED;
     }
 
+    state.tx_fill_slot = (state.tx_fill_slot + 1) % TX_FRAME_SLOTS;
     os_mutex_give(state.tx_mutex);
 
-    LOG_D(TAG, "Async packet TX started: %u bytes (total frame: %u)", length, tx_index);
+    LOG_D(TAG, "Async packet TX queued: %u bytes", length);
     return UART_DRV_OK;
 }
 
+uart_driver_status_t stm32_uart_send_packet_async(const uint8_t *data, size_t length)
+{
+    if (!state.initialized) {
+        return UART_DRV_ERR_NOT_INITIALIZED;
+    }
+
+    if (length > STM32_UART_MAX_PACKET_SIZE - PACKET_OVERHEAD) {
+        LOG_E(TAG, "Packet too large: %u bytes", length);
+        return UART_DRV_ERR_PACKET_TOO_LARGE;
+    }
+
+    uart_driver_status_t status = tx_slot_acquire();
+    if (status != UART_DRV_OK) {
+        return status;
+    }
+
+    return tx_slot_send(data, length);
+}
+
+uint8_t *stm32_uart_tx_reserve(size_t *capacity)
+{
+    if (!state.initialized) {
+        return NULL;
+    }
+
+    if (tx_slot_acquire() != UART_DRV_OK) {
+        return NULL;
+    }
+
+    state.tx_reserved = true;
+    if (capacity != NULL) {
+        *capacity = PACKET_MAX_DATA_SIZE;
+    }
+    return state.tx_slots[state.tx_fill_slot].payload;
+}
+
+uart_driver_status_t stm32_uart_tx_commit(size_t length)
+{
+    if (!state.tx_reserved) {
+        return UART_DRV_ERR_INVALID_PARAM;
+    }
+
+    state.tx_reserved = false;
+    if (length > PACKET_MAX_DATA_SIZE) {
+        tx_slot_release();
+        LOG_E(TAG, "Packet too large: %u bytes", length);
+        return UART_DRV_ERR_PACKET_TOO_LARGE;
+    }
+
+    return tx_slot_send(state.tx_slots[state.tx_fill_slot].payload, length);
+}
+
+void stm32_uart_tx_abort(void)
+{
+    if (state.tx_reserved) {
+        state.tx_reserved = false;
+        tx_slot_release();
+    }
+}
+
 bool stm32_uart_tx_busy(void)
 {
     return state.tx_in_progress;
@@ -620,13 +1020,24 @@ uart_driver_status_t stm32_uart_wait_tx_complete(uint32_t timeout_ms)
         return UART_DRV_OK;
     }
 
-    if (os_semaphore_take(state.tx_complete_sem, timeout_ms) != OS_SUCCESS) {
-        return UART_DRV_ERR_TIMEOUT;
+    // Collect every slot, i.e. wait until all queued frames are sent
+    uint32_t start = os_get_time_ms();
+    uint32_t taken = 0;
+    while (taken < TX_FRAME_SLOTS) {
+        uint32_t elapsed = os_get_time_ms() - start;
+        if (elapsed > timeout_ms ||
+            os_semaphore_take(state.tx_complete_sem, timeout_ms - elapsed) != OS_SUCCESS) {
+            break;
+        }
+        taken++;
     }
 
-    // Give it back since we just wanted to wait, not consume it
-    os_semaphore_give(state.tx_complete_sem);
-    return UART_DRV_OK;
+    // Give them back since we just wanted to wait, not consume them
+    for (uint32_t i = 0; i < taken; i++) {
+        os_semaphore_give(state.tx_complete_sem);
+    }
+
+    return (taken == TX_FRAME_SLOTS) ? UART_DRV_OK : UART_DRV_ERR_TIMEOUT;
 }
 
 int stm32_uart_send_raw(const uint8_t *data, size_t length, uint32_t timeout_ms)
@@ -658,12 +1069,184 @@ uart_driver_status_t stm32_uart_get_stats(stm32_uart_stats_t *stats)
     }
     
     memcpy(stats, &state.stats, sizeof(stm32_uart_stats_t));
+
+    // Busy time includes the stretch still going on
+    uint32_t mask = os_critical_enter();
+    uint64_t busy = state.tx_busy_cycles;
+    if (state.tx_in_flight > 0) {
+        busy += hal_get_cycle_count() - state.tx_busy_start;
+    }
+    os_critical_exit(mask);
+    stats->tx_busy_us = (uint32_t)(busy / (hal_get_cpu_freq_hz() / 1000000U));
     return UART_DRV_OK;
 }
 
 void stm32_uart_reset_stats(void)
 {
     memset(&state.stats, 0, sizeof(stm32_uart_stats_t));
+
+    uint32_t mask = os_critical_enter();
+    state.tx_busy_cycles = 0;
+    if (state.tx_in_flight > 0) {
+        state.tx_busy_start = hal_get_cycle_count();
+    }
+    os_critical_exit(mask);
+}
+
+size_t stm32_uart_encode_frame(const uint8_t *data, size_t length, uint8_t *out, size_t out_size)
+{
+    if (out == NULL || length > PACKET_MAX_DATA_SIZE || (data == NULL && length > 0)) {
+        return 0;
+    }
+
+    uint16_t crc = stm32_uart_crc16(data, length);
+
+    if (state.wire_mode == STM32_UART_WIRE_COBS) {
+        uint8_t crc_bytes[COBS_CRC_SIZE] = { (uint8_t)(crc >> 8), (uint8_t)(crc & 0xFF) };
+        cobs_encoder_t enc;
+        cobs_encoder_init(&enc, out, out_size);
+        cobs_encoder_write(&enc, data, length);
+        cobs_encoder_write(&enc, crc_bytes, sizeof(crc_bytes));
+        return cobs_encoder_finish(&enc);
+    }
+
+    if (out_size < length + PACKET_OVERHEAD) {
+        return 0;
+    }
+
+    // START + LENGTH(2) + DATA + CRC(2) + END
+    size_t index = 0;
+    out[index++] = STM32_PACKET_START_MARKER;
+    out[index++] = (uint8_t)(length & 0xFF);
+    out[index++] = (uint8_t)((length >> 8) & 0xFF);
+    if (length > 0) {
+        memcpy(&out[index], data, length);
+        index += length;
+    }
+    out[index++] = (uint8_t)(crc & 0xFF);
+    out[index++] = (uint8_t)((crc >> 8) & 0xFF);
+    out[index++] = STM32_PACKET_END_MARKER;
+    return index;
+}
+
+uart_driver_status_t stm32_uart_set_wire_mode(stm32_uart_wire_mode_t mode)
+{
+    if (!state.initialized) {
+        return UART_DRV_ERR_NOT_INITIALIZED;
+    }
+
+    if (mode != STM32_UART_WIRE_MARKERS && mode != STM32_UART_WIRE_COBS) {
+        return UART_DRV_ERR_INVALID_PARAM;
+    }
+
+    if (mode != state.wire_mode) {
+        state.wire_mode = mode;
+        rx_reset_state();
+        hal_uart_set_rx_match((hal_uart_port_t)STM32_UART_PORT,
+                              (mode == STM32_UART_WIRE_COBS) ? 0x00 : STM32_PACKET_END_MARKER);
+        LOG_I(TAG, "Wire mode: %s", (mode == STM32_UART_WIRE_COBS) ? "COBS" : "markers");
+    }
+
+    return UART_DRV_OK;
+}
+
+stm32_uart_wire_mode_t stm32_uart_get_wire_mode(void)
+{
+    return state.wire_mode;
+}
+
+uart_driver_status_t stm32_uart_set_baud_rate(uint32_t baud_rate, uint32_t probation_ms)
+{
+    if (!state.initialized) {
+        return UART_DRV_ERR_NOT_INITIALIZED;
+    }
+
+    if (!stm32_uart_baud_rate_supported(baud_rate)) {
+        return UART_DRV_ERR_INVALID_PARAM;
+    }
+
+    // A rate still on probation is not a safe place to return to
+    uint32_t fallback = (state.baud_fallback != 0 && !state.baud_confirmed)
+                        ? state.baud_fallback : state.config.baud_rate;
+
+    state.baud_fallback = 0;  // No supervision while switching
+    uart_driver_status_t status = apply_baud_rate(baud_rate);
+    if (status != UART_DRV_OK) {
+        return status;
+    }
+
+    if (probation_ms > 0 && baud_rate != fallback) {
+        uint32_t now = os_get_time_ms();
+        state.baud_confirmed = false;
+        state.baud_deadline = now + probation_ms;
+        state.baud_packets_base = state.stats.packets_received;
+        state.baud_window_start = now;
+        state.baud_errors_base = rx_error_count();
+        state.baud_fallback = fallback;
+
+        // The RX task may sleep until the next byte: start its checks
+        if (state.rx_task_handle != NULL) {
+            os_task_notify(state.rx_task_handle);
+        }
+    }
+
+    LOG_I(TAG, "Baud rate %lu%s", (unsigned long)baud_rate,
+          (state.baud_fallback != 0) ? " (on probation)" : "");
+    return UART_DRV_OK;
+}
+
+bool stm32_uart_baud_rate_supported(uint32_t baud_rate)
+{
+    return baud_rate > 0 && baud_rate <= STM32_UART_BAUD_MAX
+           && hal_uart_baudrate_supported((hal_uart_port_t)STM32_UART_PORT, baud_rate);
+}
+
+uint32_t stm32_uart_get_baud_rate(void)
+{
+    return state.config.baud_rate;
+}
+
+bool stm32_uart_rx_retain(const uint8_t *data)
+{
+    if (data != state.rx_buffer || state.rx_retained) {
+        return false;
+    }
+
+    uint32_t bit = 1UL << rx_frame_index(data);
+    uint32_t all = (1UL << STM32_UART_RX_FRAMES) - 1;
+
+    uint32_t mask = os_critical_enter();
+    uint32_t held = state.rx_frames_held | bit;
+    if (held == all) {
+        os_critical_exit(mask);
+        return false;  // The parser needs a free frame to continue into
+    }
+    state.rx_frames_held = held;
+    os_critical_exit(mask);
+
+    state.rx_retained = true;
+    return true;
+}
+
+void stm32_uart_rx_release(const uint8_t *data)
+{
+    int index = rx_frame_index(data);
+    if (index < 0) {
+        return;
+    }
+
+    uint32_t mask = os_critical_enter();
+    state.rx_frames_held &= ~(1UL << index);
+    os_critical_exit(mask);
+}
+
+void stm32_uart_inject_rx(const uint8_t *data, size_t length)
+{
+    if (!state.initialized || data == NULL) {
+        return;
+    }
+
+    rx_process_bytes(data, length);
 }
 
 uart_driver_status_t stm32_uart_flush_rx(void)
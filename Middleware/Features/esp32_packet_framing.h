@@ -46,9 +46,23 @@ typedef enum {
 // ============================================================================
 
 #define STM32_UART_BAUD_RATE        921600
+#define STM32_UART_BAUD_MAX         4000000     // Bulk rates need oversampling by 8 (USART2 on PCLK1)
+
+// Baud switch supervision (stm32_uart_set_baud_rate() with probation)
+#define STM32_UART_BAUD_ERROR_WINDOW_MS 1000
+#define STM32_UART_BAUD_ERROR_LIMIT     8       // RX errors per window that end a switched rate
 #define STM32_UART_RX_BUFFER_SIZE   2048
+#define STM32_UART_RX_TIMEOUT_BITS  20          // Line idle (bit times) that ends an RX burst
+#define STM32_UART_RX_MAX_LATENCY_MS 2         // RX task delay the DMA ring absorbs at STM32_UART_BAUD_MAX
 #define STM32_UART_TX_BUFFER_SIZE   1024
 #define STM32_UART_MAX_PACKET_SIZE  512
+#define STM32_UART_RX_FRAMES        6           // RX frame buffers: one being parsed, the rest retainable
+#define STM32_UART_TX_WAIT_BUCKETS  16          // TX wait histogram: bucket n < 2^n us, the last open
+
+// Compute packet CRC on the CRC peripheral (falls back to the table if unavailable)
+#ifndef STM32_UART_USE_HW_CRC
+#define STM32_UART_USE_HW_CRC       1
+#endif
 
 // Packet framing markers
 #define STM32_PACKET_START_MARKER   0xAA
@@ -58,6 +72,17 @@ typedef enum {
 // Data Types
 // ============================================================================
 
+/**
+ * @brief Wire framing
+ *
+ * MARKERS: START(0xAA) + LENGTH(2, LE) + DATA + CRC16(2, LE) + END(0x55)
+ * COBS:    COBS(DATA + CRC16(2, BE)) + 0x00, resyncs at the next 0x00
+ */
+typedef enum {
+    STM32_UART_WIRE_MARKERS = 0,        /**< Start/end markers (default after init) */
+    STM32_UART_WIRE_COBS,               /**< COBS-stuffed, 0x00 delimited */
+} stm32_uart_wire_mode_t;
+
 /**
  * @brief UART driver event types
  */
@@ -67,6 +92,7 @@ typedef enum {
     STM32_UART_EVENT_RX_ERROR,          /**< Reception error (framing, overflow) */
     STM32_UART_EVENT_CRC_ERROR,         /**< CRC validation failed */
     STM32_UART_EVENT_TIMEOUT,           /**< Reception timeout */
+    STM32_UART_EVENT_BAUD_FALLBACK,     /**< Switched rate abandoned (length = baud rate now in use) */
 } stm32_uart_event_type_t;
 
 /**
@@ -74,7 +100,7 @@ typedef enum {
  */
 typedef struct {
     stm32_uart_event_type_t type;       /**< Event type */
-    uint8_t *data;                      /**< Pointer to packet data (for PACKET_RECEIVED) */
+    uint8_t *data;                      /**< Pointer to packet data (for PACKET_RECEIVED, see stm32_uart_rx_retain()) */
     size_t length;                      /**< Data length */
 } stm32_uart_event_t;
 
@@ -109,6 +135,14 @@ typedef struct {
     uint32_t framing_errors;            /**< Framing errors (bad start/end markers) */
     uint32_t overflow_errors;           /**< Buffer overflow errors */
     uint32_t timeout_errors;            /**< Reception timeouts */
+    uint32_t rx_validate_cycles_last;   /**< End marker to PACKET_RECEIVED callback, CPU cycles (last) */
+    uint32_t rx_validate_cycles_max;    /**< End marker to PACKET_RECEIVED callback, CPU cycles (max) */
+    uint32_t bytes_sent;                /**< Wire bytes transmitted (framing included) */
+    uint32_t bytes_received;            /**< Wire bytes received, noise included */
+    uint32_t tx_waits;                  /**< Frames that went through the TX slot wait */
+    uint32_t tx_wait_us;                /**< Sum of those waits in us */
+    uint32_t tx_wait_hist[STM32_UART_TX_WAIT_BUCKETS]; /**< Wait count per power-of-two us bucket */
+    uint32_t tx_busy_us;                /**< Time with a frame on the wire in us */
 } stm32_uart_stats_t;
 
 // ============================================================================
@@ -162,8 +196,9 @@ uart_driver_status_t stm32_uart_send_packet(const uint8_t *data, size_t length,
  * Use stm32_uart_tx_busy() or stm32_uart_wait_tx_complete() to check status.
  * Thread-safe.
  *
- * @note The internal TX buffer is used, so the caller's data buffer can be
- *       released immediately after this call returns.
+ * @note The data is copied into an internal frame slot, so the caller's buffer
+ *       can be released immediately after this call returns. Two frames can be
+ *       in flight; a third call blocks until the oldest one is sent.
  *
  * @param data Pointer to data to send
  * @param length Data length (excluding framing and CRC)
@@ -171,6 +206,36 @@ uart_driver_status_t stm32_uart_send_packet(const uint8_t *data, size_t length,
  */
 uart_driver_status_t stm32_uart_send_packet_async(const uint8_t *data, size_t length);
 
+/**
+ * @brief Reserve the next async TX frame slot to build a packet in place
+ *
+ * Returns the slot's payload area, so the packet is written where it is sent
+ * from instead of being copied in by stm32_uart_send_packet_async(). Finish
+ * with stm32_uart_tx_commit(), or stm32_uart_tx_abort() to send nothing.
+ *
+ * @note The TX lock is held from here to commit/abort: the same task must
+ *       end the reservation, and must not send anything else before it.
+ *       Blocks like stm32_uart_send_packet_async() while all slots are busy.
+ *       The buffer is in the non-cacheable DMA section.
+ *
+ * @param capacity Output: bytes available at the returned pointer (may be NULL)
+ * @return Payload buffer, NULL on timeout or if not initialized
+ */
+uint8_t *stm32_uart_tx_reserve(size_t *capacity);
+
+/**
+ * @brief Frame and queue the reserved slot
+ *
+ * @param length Bytes written at the reserved pointer
+ * @return UART_DRV_OK on success, error code otherwise (the slot is released either way)
+ */
+uart_driver_status_t stm32_uart_tx_commit(size_t length);
+
+/**
+ * @brief Release the reserved slot without sending
+ */
+void stm32_uart_tx_abort(void);
+
 /**
  * @brief Check if async TX is in progress
  * @return true if DMA transmission is ongoing
@@ -180,7 +245,7 @@ bool stm32_uart_tx_busy(void);
 /**
  * @brief Wait for async TX to complete
  *
- * Blocks until the current async transmission completes.
+ * Blocks until all queued async transmissions complete.
  *
  * @param timeout_ms Maximum time to wait in milliseconds
  * @return UART_DRV_OK if complete, UART_DRV_ERR_TIMEOUT if timed out
@@ -226,10 +291,97 @@ void stm32_uart_reset_stats(void);
  */
 uart_driver_status_t stm32_uart_flush_rx(void);
 
+/**
+ * @brief Select the wire framing for both directions
+ *
+ * Takes effect for the next frame; frames already queued for TX keep the
+ * framing they were built with. Reset to STM32_UART_WIRE_MARKERS by
+ * stm32_uart_init().
+ *
+ * @param mode Wire framing
+ * @return UART_DRV_OK on success, error code otherwise
+ */
+uart_driver_status_t stm32_uart_set_wire_mode(stm32_uart_wire_mode_t mode);
+
+/**
+ * @brief Get the current wire framing
+ */
+stm32_uart_wire_mode_t stm32_uart_get_wire_mode(void);
+
+/**
+ * @brief Change the link baud rate
+ *
+ * Waits for queued frames to leave at the old rate, then switches; bytes
+ * arriving during the switch are lost. With probation_ms > 0 the switch is
+ * supervised: the driver returns to the last confirmed rate, and reports
+ * STM32_UART_EVENT_BAUD_FALLBACK, unless a valid frame arrives within
+ * probation_ms, or when RX errors later exceed STM32_UART_BAUD_ERROR_LIMIT
+ * per STM32_UART_BAUD_ERROR_WINDOW_MS. Call from the RX callback or the
+ * task that owns the link. stm32_uart_init() restores the configured rate.
+ *
+ * @param baud_rate New rate (up to STM32_UART_BAUD_MAX, within the USART's divider range)
+ * @param probation_ms 0 = switch for good
+ * @return UART_DRV_OK on success, UART_DRV_ERR_INVALID_PARAM if the rate is unsupported
+ */
+uart_driver_status_t stm32_uart_set_baud_rate(uint32_t baud_rate, uint32_t probation_ms);
+
+/**
+ * @brief Check a rate against STM32_UART_BAUD_MAX and the USART's divider
+ */
+bool stm32_uart_baud_rate_supported(uint32_t baud_rate);
+
+/**
+ * @brief Get the baud rate in use
+ */
+uint32_t stm32_uart_get_baud_rate(void);
+
+/**
+ * @brief Build a complete wire frame for the current wire mode
+ *
+ * @param data Payload
+ * @param length Payload length
+ * @param out Output buffer (STM32_UART_MAX_PACKET_SIZE bytes always suffice)
+ * @param out_size Output buffer size
+ * @return Frame length, or 0 if the payload is too large for out
+ */
+size_t stm32_uart_encode_frame(const uint8_t *data, size_t length, uint8_t *out, size_t out_size);
+
+/**
+ * @brief Keep a received frame after the PACKET_RECEIVED callback returns
+ *
+ * Without this, event->data is only valid during the callback. A retained
+ * frame belongs to the caller, and the parser continues into another RX
+ * frame buffer, until stm32_uart_rx_release().
+ *
+ * @param data event->data, from within the PACKET_RECEIVED callback
+ * @return false if no other frame buffer is free (copy the data instead)
+ */
+bool stm32_uart_rx_retain(const uint8_t *data);
+
+/**
+ * @brief Give a retained frame back to the parser (any task)
+ *
+ * @param data Pointer passed to stm32_uart_rx_retain()
+ */
+void stm32_uart_rx_release(const uint8_t *data);
+
+/**
+ * @brief Feed bytes to the RX parser as if they were received
+ *
+ * Test and benchmark hook (loopback without a second device). Must not be
+ * used while real RX traffic is arriving.
+ *
+ * @param data Wire bytes
+ * @param length Number of bytes
+ */
+void stm32_uart_inject_rx(const uint8_t *data, size_t length);
+
 /**
  * @brief Calculate CRC16-CCITT
  * 
- * Utility function to calculate CRC16 checksum.
+ * Utility function to calculate CRC16 checksum. Uses the hardware CRC
+ * unit once stm32_uart_init() has run (STM32_UART_USE_HW_CRC), the
+ * lookup table otherwise.
  * 
  * @param data Data buffer
  * @param length Data length
@@ -0,0 +1,146 @@
+#include "link_stats.h"
+#include "esp32_packet_framing.h"
+#include "os_wrapper.h"
+#include <string.h>
+
+typedef struct {
+    uint32_t time_ms;
+    stm32_uart_stats_t uart;
+} link_sample_t;
+
+// One more sample than slots: a full window spans LINK_STATS_SLOTS slots
+static link_sample_t samples[LINK_STATS_SLOTS + 1];
+static uint8_t sample_head;         // Next sample to write
+static uint8_t sample_count;
+
+static link_stats_t window;
+static volatile bool window_valid;
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static uint32_t per_second(uint32_t delta, uint32_t window_ms)
+{
+    return (uint32_t)(((uint64_t)delta * 1000U) / window_ms);
+}
+
+static uint32_t rx_errors(const stm32_uart_stats_t *uart)
+{
+    return uart->crc_errors + uart->framing_errors + uart->overflow_errors + uart->timeout_errors;
+}
+
+/**
+ * @brief Rates between the oldest and the newest sample
+ */
+static void compute_window(const link_sample_t *oldest, const link_sample_t *newest,
+                           link_stats_t *out)
+{
+    const stm32_uart_stats_t *a = &oldest->uart;
+    const stm32_uart_stats_t *b = &newest->uart;
+    uint32_t window_ms = newest->time_ms - oldest->time_ms;
+
+    memset(out, 0, sizeof(*out));
+    out->window_ms = window_ms;
+    out->tx_bytes_per_s = per_second(b->bytes_sent - a->bytes_sent, window_ms);
+    out->rx_bytes_per_s = per_second(b->bytes_received - a->bytes_received, window_ms);
+    out->tx_frames_per_s = per_second(b->packets_sent - a->packets_sent, window_ms);
+    out->rx_frames_per_s = per_second(b->packets_received - a->packets_received, window_ms);
+
+    uint32_t errors = rx_errors(b) - rx_errors(a);
+    uint32_t frames = (b->packets_received - a->packets_received) + errors;
+    if (frames > 0) {
+        out->rx_error_ppm = (uint32_t)(((uint64_t)errors * 1000000U) / frames);
+    }
+
+    uint32_t waits = b->tx_waits - a->tx_waits;
+    if (waits > 0) {
+        out->tx_wait_mean_us = (b->tx_wait_us - a->tx_wait_us) / waits;
+
+        // Smallest bucket with 99% of the waits at or below it
+        uint32_t target = waits - waits / 100;
+        uint32_t seen = 0;
+        for (uint8_t bucket = 0; bucket < STM32_UART_TX_WAIT_BUCKETS; bucket++) {
+            seen += b->tx_wait_hist[bucket] - a->tx_wait_hist[bucket];
+            if (seen >= target) {
+                out->tx_wait_p99_us = 1UL << bucket;
+                break;
+            }
+        }
+    }
+
+    uint32_t busy_us = b->tx_busy_us - a->tx_busy_us;
+    uint64_t permille = ((uint64_t)busy_us) / window_ms;    // us per ms = 1/1000
+    out->tx_busy_permille = (uint16_t)((permille > 1000) ? 1000 : permille);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void link_stats_init(void)
+{
+    sample_head = 0;
+    sample_count = 0;
+    window_valid = false;
+}
+
+void link_stats_process(void)
+{
+    uint32_t now = os_get_time_ms();
+    uint8_t newest = (sample_head + LINK_STATS_SLOTS) % (LINK_STATS_SLOTS + 1);
+
+    if (sample_count > 0 && now - samples[newest].time_ms < LINK_STATS_SLOT_MS) {
+        return;
+    }
+
+    link_sample_t *sample = &samples[sample_head];
+    if (stm32_uart_get_stats(&sample->uart) != UART_DRV_OK) {
+        return;
+    }
+    sample->time_ms = now;
+
+    // Counters went back (stm32_uart_reset_stats()): start a new window
+    if (sample_count > 0 && sample->uart.bytes_received < samples[newest].uart.bytes_received) {
+        samples[0] = *sample;
+        sample_head = 1;
+        sample_count = 1;
+        window_valid = false;
+        return;
+    }
+
+    sample_head = (sample_head + 1) % (LINK_STATS_SLOTS + 1);
+    if (sample_count < LINK_STATS_SLOTS + 1) {
+        sample_count++;
+    }
+    if (sample_count < 2) {
+        return;
+    }
+
+    uint8_t oldest = (sample_count <= LINK_STATS_SLOTS) ? 0 : sample_head;
+    link_stats_t result;
+    compute_window(&samples[oldest], sample, &result);
+
+    uint32_t mask = os_critical_enter();
+    window = result;
+    window_valid = true;
+    os_critical_exit(mask);
+}
+
+bool link_stats_get(link_stats_t *stats)
+{
+    if (stats == NULL) {
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    bool valid = window_valid;
+    *stats = window;
+    os_critical_exit(mask);
+    return valid;
+}
+
+bool link_stats_tx_idle(void)
+{
+    return window_valid && window.tx_busy_permille < LINK_STATS_IDLE_PERMILLE;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file link_stats.h
+ * @brief Sliding-window rates of the host link
+ *
+ * Samples the packet framing counters (stm32_uart_stats_t) every
+ * LINK_STATS_SLOT_MS and reports rates over the last LINK_STATS_SLOTS
+ * samples: throughput, frame rates, the RX error rate, TX slot wait
+ * (mean and p99) and how busy the TX DMA was. Call link_stats_process()
+ * periodically (services loop); readers take the latest window from any
+ * task.
+ *
+ * Usage example:
+ * @code
+ * link_stats_t link;
+ * if (link_stats_get(&link) && link.tx_busy_permille > 900) { ... }
+ * @endcode
+ */
+
+#ifndef LINK_STATS_H
+#define LINK_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LINK_STATS_SLOT_MS          100
+#define LINK_STATS_SLOTS            10      // Window: 1 s
+#define LINK_STATS_IDLE_PERMILLE    250     // link_stats_tx_idle() below this TX busy share
+
+typedef struct {
+    uint32_t window_ms;             // Time the rates cover
+    uint32_t tx_bytes_per_s;        // Wire bytes, framing included
+    uint32_t rx_bytes_per_s;
+    uint32_t tx_frames_per_s;
+    uint32_t rx_frames_per_s;       // Valid frames only
+    uint32_t rx_error_ppm;          // Bad frames per million received (valid + bad)
+    uint32_t tx_wait_mean_us;       // Wait for a free TX slot
+    uint32_t tx_wait_p99_us;        // Upper bound of the 99th percentile bucket
+    uint16_t tx_busy_permille;      // Share of the window with a frame on the wire
+} link_stats_t;
+
+/**
+ * @brief Reset the window (call after stm32_uart_init())
+ */
+void link_stats_init(void);
+
+/**
+ * @brief Take a sample if a slot has passed and recompute the window
+ */
+void link_stats_process(void);
+
+/**
+ * @brief Latest window
+ * @return false until two samples exist
+ */
+bool link_stats_get(link_stats_t *stats);
+
+/**
+ * @brief Whether the TX side has plenty of headroom (false without a window)
+ */
+bool link_stats_tx_idle(void);
+
+#endif // LINK_STATS_H
@@ -0,0 +1,343 @@
+#include "metric_pipeline.h"
+#include "os_wrapper.h"
+#include "portable_log.h"
+#include "service_events.h"
+#include "serv_current_monitor.h"
+#include <math.h>
+#include <stddef.h>
+
+static const char *TAG = "METRICS";
+
+// Magnus coefficients over water, -45..60 C
+#define MAGNUS_B                17.62f
+#define MAGNUS_C                243.12f
+#define US_PER_HOUR             3600000000.0f
+
+typedef struct {
+    const metric_node_t *def;
+    volatile uint8_t consumers;     // Non-zero: evaluated
+    volatile bool valid;
+    metric_value_t latest;
+} node_slot_t;
+
+static node_slot_t nodes[METRIC_MAX_NODES];
+static volatile uint8_t node_count = 0;
+
+// ============================================================================
+// Built-in Nodes
+// ============================================================================
+
+static bool dew_point_on_event(void *state, const event_t *event, float *value)
+{
+    (void)state;
+    const temperature_data_t *data = (const temperature_data_t *)event->data;
+    if (data == NULL || event->data_size < sizeof(*data) || !data->sensor_ok
+        || data->humidity <= 0.0f || data->humidity > 100.0f) {
+        return false;
+    }
+
+    float gamma = logf(data->humidity / 100.0f)
+                  + (MAGNUS_B * data->temperature) / (MAGNUS_C + data->temperature);
+    *value = (MAGNUS_C * gamma) / (MAGNUS_B - gamma);
+    return true;
+}
+
+static current_monitor_cursor_t power_cursor;
+static current_sample_t power_batch[METRIC_POLL_BATCH];
+
+static void power_reset(void *state)
+{
+    (void)state;
+    current_monitor_cursor_init(&power_cursor);
+}
+
+static bool power_poll(void *state, float *value)
+{
+    (void)state;
+    float sum = 0.0f;
+    uint32_t total = 0;
+    uint32_t count;
+
+    // Bounded: a 1 kHz measurement adds ~10 samples per services period
+    for (uint8_t step = 0; step < 8; step++) {
+        count = current_monitor_read_new(&power_cursor, power_batch, METRIC_POLL_BATCH);
+        for (uint32_t i = 0; i < count; i++) {
+            sum += power_batch[i].power_mW;
+        }
+        total += count;
+        if (count < METRIC_POLL_BATCH) {
+            break;
+        }
+    }
+
+    if (total == 0) {
+        return false;
+    }
+    *value = sum / (float)total;
+    return true;
+}
+
+typedef struct {
+    float energy_mWh;
+    uint32_t last_timestamp;
+    bool started;
+} energy_state_t;
+
+static energy_state_t energy_state;
+
+static void energy_reset(void *state)
+{
+    energy_state_t *energy = (energy_state_t *)state;
+    energy->energy_mWh = 0.0f;
+    energy->started = false;
+}
+
+static bool energy_on_metric(void *state, const metric_value_t *input, float *value)
+{
+    energy_state_t *energy = (energy_state_t *)state;
+
+    // Each power value is the mean since the previous one, so it covers
+    // exactly the interval ending now; the first one has no start
+    if (energy->started) {
+        uint32_t dt_us = input->timestamp - energy->last_timestamp;
+        energy->energy_mWh += input->value * ((float)dt_us / US_PER_HOUR);
+    }
+    energy->last_timestamp = input->timestamp;
+    energy->started = true;
+
+    *value = energy->energy_mWh;
+    return true;
+}
+
+static const metric_node_t builtin_nodes[METRIC_BUILTIN_COUNT] = {
+    [METRIC_DEW_POINT_C] = {
+        .name = "dew_point_C",
+        .input_event = EVENT_TEMPERATURE_UPDATED,
+        .input_metric = METRIC_NONE,
+        .on_event = dew_point_on_event,
+    },
+    [METRIC_POWER_MW] = {
+        .name = "power_mW",
+        .input_event = EVENT_NONE,
+        .input_metric = METRIC_NONE,
+        .reset = power_reset,
+        .poll = power_poll,
+    },
+    [METRIC_ENERGY_MWH] = {
+        .name = "energy_mWh",
+        .input_event = EVENT_NONE,
+        .input_metric = METRIC_POWER_MW,
+        .reset = energy_reset,
+        .on_metric = energy_on_metric,
+        .state = &energy_state,
+    },
+};
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static bool node_valid(const metric_node_t *node, uint8_t count)
+{
+    if (node == NULL) {
+        return false;
+    }
+
+    uint8_t inputs = (node->input_event != EVENT_NONE ? 1 : 0)
+                     + (node->input_metric != METRIC_NONE ? 1 : 0)
+                     + (node->poll != NULL ? 1 : 0);
+    if (inputs != 1) {
+        return false;
+    }
+
+    if (node->input_event != EVENT_NONE) {
+        return node->on_event != NULL && node->input_event < EVENT_USER_DEFINED_START;
+    }
+    if (node->input_metric != METRIC_NONE) {
+        return node->on_metric != NULL && node->input_metric < count;
+    }
+    return true;
+}
+
+static bool event_wanted(event_type_t type)
+{
+    for (uint8_t i = 0; i < node_count; i++) {
+        if (nodes[i].consumers > 0 && nodes[i].def->input_event == type) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Store a node's new value, publish it and run its downstream nodes
+ */
+static void emit(metric_id_t id, float value, uint32_t timestamp)
+{
+    metric_value_t result = {
+        .id = id,
+        .value = value,
+        .timestamp = timestamp,
+    };
+
+    uint32_t mask = os_critical_enter();
+    nodes[id].latest = result;
+    nodes[id].valid = true;
+    os_critical_exit(mask);
+
+    EVENT_PUBLISH(EVENT_METRIC_UPDATED, &result);
+
+    // Downstream ids are always higher, and chains never loop
+    for (uint8_t i = id + 1; i < node_count; i++) {
+        const metric_node_t *def = nodes[i].def;
+        float derived;
+        if (nodes[i].consumers > 0 && def->input_metric == id
+            && def->on_metric(def->state, &result, &derived)) {
+            emit(i, derived, timestamp);
+        }
+    }
+}
+
+/**
+ * @brief Bus callback of every raw input type an active node uses
+ */
+static void on_input_event(event_t *event)
+{
+    for (uint8_t i = 0; i < node_count; i++) {
+        const metric_node_t *def = nodes[i].def;
+        float value;
+        if (nodes[i].consumers > 0 && def->input_event == event->type
+            && def->on_event(def->state, event, &value)) {
+            emit(i, value, event->timestamp);
+        }
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void metric_pipeline_init(void)
+{
+    if (node_count > 0) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < METRIC_BUILTIN_COUNT; i++) {
+        metric_pipeline_register(&builtin_nodes[i]);
+    }
+}
+
+metric_id_t metric_pipeline_register(const metric_node_t *node)
+{
+    uint32_t mask = os_critical_enter();
+    uint8_t id = node_count;
+    if (id >= METRIC_MAX_NODES || !node_valid(node, id)) {
+        os_critical_exit(mask);
+        return METRIC_NONE;
+    }
+
+    nodes[id].def = node;
+    nodes[id].consumers = 0;
+    nodes[id].valid = false;
+    node_count = id + 1;
+    os_critical_exit(mask);
+    return id;
+}
+
+bool metric_pipeline_acquire(metric_id_t id)
+{
+    if (id >= node_count) {
+        return false;
+    }
+
+    node_slot_t *slot = &nodes[id];
+    if (slot->consumers > 0) {
+        uint32_t mask = os_critical_enter();
+        slot->consumers++;
+        os_critical_exit(mask);
+        return true;
+    }
+
+    const metric_node_t *def = slot->def;
+    if (def->input_metric != METRIC_NONE && !metric_pipeline_acquire(def->input_metric)) {
+        return false;
+    }
+
+    // Reset while inactive, so no input sees half-cleared state
+    slot->valid = false;
+    if (def->reset != NULL) {
+        def->reset(def->state);
+    }
+
+    if (def->input_event != EVENT_NONE && !event_bus_subscribe(def->input_event, on_input_event)) {
+        LOG_W(TAG, "%s: no bus subscription", def->name);
+        if (def->input_metric != METRIC_NONE) {
+            metric_pipeline_release(def->input_metric);
+        }
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    slot->consumers++;
+    os_critical_exit(mask);
+
+    LOG_I(TAG, "%s started", def->name);
+    return true;
+}
+
+void metric_pipeline_release(metric_id_t id)
+{
+    if (id >= node_count || nodes[id].consumers == 0) {
+        return;
+    }
+
+    node_slot_t *slot = &nodes[id];
+    uint32_t mask = os_critical_enter();
+    slot->consumers--;
+    bool stopped = (slot->consumers == 0);
+    os_critical_exit(mask);
+
+    if (!stopped) {
+        return;
+    }
+
+    const metric_node_t *def = slot->def;
+    // The callback is shared: keep it while another node uses the type
+    if (def->input_event != EVENT_NONE && !event_wanted(def->input_event)) {
+        event_bus_unsubscribe(def->input_event, on_input_event);
+    }
+    if (def->input_metric != METRIC_NONE) {
+        metric_pipeline_release(def->input_metric);
+    }
+    LOG_I(TAG, "%s stopped", def->name);
+}
+
+bool metric_pipeline_get(metric_id_t id, metric_value_t *value)
+{
+    if (id >= node_count || value == NULL) {
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    bool valid = nodes[id].valid;
+    *value = nodes[id].latest;
+    os_critical_exit(mask);
+    return valid;
+}
+
+void metric_pipeline_process(void)
+{
+    for (uint8_t i = 0; i < node_count; i++) {
+        const metric_node_t *def = nodes[i].def;
+        float value;
+        if (nodes[i].consumers > 0 && def->poll != NULL && def->poll(def->state, &value)) {
+            emit(i, value, event_bus_get_timestamp_us());
+        }
+    }
+}
+
+const char *metric_pipeline_get_name(metric_id_t id)
+{
+    return (id < node_count) ? nodes[id].def->name : "?";
+}
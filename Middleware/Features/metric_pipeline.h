@@ -0,0 +1,110 @@
+/**
+ * @file metric_pipeline.h
+ * @brief Derived metrics computed incrementally from raw sensor data
+ *
+ * A node turns one input into one metric value. Its input is either:
+ * - a raw event bus type (e.g. EVENT_TEMPERATURE_UPDATED), evaluated in
+ *   the bus dispatch task,
+ * - another node's output, evaluated right after that node, or
+ * - nothing: the node polls a sample ring from metric_pipeline_process().
+ *
+ * Each result is kept as the node's latest value and published as
+ * EVENT_METRIC_UPDATED (metric_value_t). Nodes are lazy: a node does no
+ * work and holds no bus subscription until a consumer (stream, display)
+ * calls metric_pipeline_acquire() for it. Acquiring a node also acquires
+ * its upstream node, and the last metric_pipeline_release() stops both.
+ *
+ * Usage example:
+ * @code
+ * metric_pipeline_acquire(METRIC_DEW_POINT_C);
+ * event_bus_subscribe(EVENT_METRIC_UPDATED, on_metric);   // or poll:
+ *
+ * metric_value_t dew;
+ * if (metric_pipeline_get(METRIC_DEW_POINT_C, &dew)) { ... }
+ * @endcode
+ */
+
+#ifndef METRIC_PIPELINE_H
+#define METRIC_PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "event_bus.h"
+
+#define METRIC_MAX_NODES        8
+#define METRIC_NONE             0xFF
+#define METRIC_POLL_BATCH       32      // Ring samples read per step by polled nodes
+
+// Built-in nodes, registered by metric_pipeline_init() with these ids
+enum {
+    METRIC_DEW_POINT_C = 0,     // Magnus formula over EVENT_TEMPERATURE_UPDATED
+    METRIC_POWER_MW,            // Mean current monitor power since the last poll
+    METRIC_ENERGY_MWH,          // Integral of METRIC_POWER_MW since acquired
+    METRIC_BUILTIN_COUNT
+};
+
+typedef uint8_t metric_id_t;
+
+// EVENT_METRIC_UPDATED payload
+typedef struct {
+    metric_id_t id;
+    float value;
+    uint32_t timestamp;         // Input time in us (event_t timebase)
+} metric_value_t;
+
+/**
+ * @brief One node; keep the definition static (the pipeline keeps the pointer)
+ *
+ * Set exactly one input: input_event, input_metric or poll. The compute
+ * callback matching it returns true with a new value, or false to publish
+ * nothing this time. Callbacks run with the owning context's stack, so
+ * they must stay short and never block.
+ */
+typedef struct {
+    const char *name;
+    event_type_t input_event;       // Raw bus input, else EVENT_NONE
+    metric_id_t input_metric;       // Upstream node, else METRIC_NONE
+    void (*reset)(void *state);     // On acquire, before the first input (optional)
+    bool (*on_event)(void *state, const event_t *event, float *value);
+    bool (*on_metric)(void *state, const metric_value_t *input, float *value);
+    bool (*poll)(void *state, float *value);
+    void *state;
+} metric_node_t;
+
+/**
+ * @brief Register the built-in nodes
+ */
+void metric_pipeline_init(void);
+
+/**
+ * @brief Add a node
+ * @note The upstream node must already be registered, so chains cannot loop
+ * @return The new node's id, or METRIC_NONE if full or invalid
+ */
+metric_id_t metric_pipeline_register(const metric_node_t *node);
+
+/**
+ * @brief Start evaluating a node (and its upstream) for one more consumer
+ * @return false for an unknown id or if the bus has no room to subscribe
+ */
+bool metric_pipeline_acquire(metric_id_t id);
+
+/**
+ * @brief Drop one consumer; the last one stops the node
+ */
+void metric_pipeline_release(metric_id_t id);
+
+/**
+ * @brief Latest value of a node
+ * @return false if it has none since it was acquired
+ */
+bool metric_pipeline_get(metric_id_t id, metric_value_t *value);
+
+/**
+ * @brief Step the polled nodes; call periodically (services loop)
+ */
+void metric_pipeline_process(void);
+
+const char *metric_pipeline_get_name(metric_id_t id);
+
+#endif // METRIC_PIPELINE_H
@@ -1,9 +1,14 @@
+// Generated from protocol_common.idl by tools/protocol_gen.py: edit the IDL, not this file
 /**
  * @file protocol_common.h
  * @brief Shared protocol definitions between ESP32 and STM32
  *
  * This file should be identical on both sides.
  * Copy to both projects: Shared/ or a common include path.
+ *
+ * Generated from protocol_common.idl (tools/protocol_gen.py) together with
+ * protocol_wire.h, the aligned structs and their pack/unpack accessors.
+ * Change the IDL and regenerate; the firmware build checks both are current.
  */
 
 #ifndef PROTOCOL_COMMON_H
@@ -35,6 +40,49 @@ typedef enum {
 #define PROTOCOL_MAX_RETRIES          3
 #define PROTOCOL_RETRY_BACKOFF_MS     100
 
+// Protocol versions (negotiated with CMD_NEGOTIATE_VERSION, default 1)
+#define PROTOCOL_VERSION_MARKERS      1     /**< START/END marker framing */
+#define PROTOCOL_VERSION_COBS         2     /**< COBS framing, 0x00 delimited */
+#define PROTOCOL_VERSION_COMPACT      3     /**< COBS + compact sample arrays */
+#define PROTOCOL_VERSION_MAX          PROTOCOL_VERSION_COMPACT
+
+/**
+ * Sliding window for CMD_GET_BUFFER_DATA
+ *
+ * The host may have up to PROTOCOL_WINDOW_SIZE requests outstanding, each
+ * with its own seq. Responses come back in request order. A gap in the
+ * response seqs means the request was lost (resend it). A response that
+ * failed its CRC on the host can be fetched again with CMD_RETRANSMIT while
+ * it is among the last PROTOCOL_WINDOW_SIZE responses.
+ */
+#define PROTOCOL_WINDOW_SIZE          4
+
+/**
+ * Credit flow control (CMD_GRANT_CREDITS)
+ *
+ * Off until the host's first grant. Then each stream or bulk data frame
+ * (NOTIFY_SENSOR_DATA, NOTIFY_BULK_DATA, NOTIFY_CURRENT_DATA,
+ * NOTIFY_RECORDING_DATA) spends one credit. With none left, streams pause
+ * (batches are held, unbatched samples skipped) and bulk transfers wait,
+ * giving up with RESP_TIMEOUT after PROTOCOL_TIMEOUT_MS. Responses and
+ * NOTIFY_BULK_DONE are never held back. Typically the host grants its
+ * receive queue depth, then one credit per frame it has consumed.
+ */
+#define PROTOCOL_CREDITS_MAX          0x7FFF  /**< Balance saturates here */
+#define PROTOCOL_CREDITS_OFF          0xFFFF  /**< Grant value that turns flow control off */
+
+/**
+ * Bulk dump frames use the full UART frame (512) minus framing overhead (6)
+ * and protocol header (6), instead of PROTOCOL_MAX_PAYLOAD_SIZE
+ */
+#define PROTOCOL_BULK_MAX_PAYLOAD_SIZE  500
+
+/** Largest live stream batch (uncompressed samples that fit one payload) */
+#define PROTOCOL_STREAM_MAX_BATCH     ((PROTOCOL_MAX_PAYLOAD_SIZE - 3) / 9)
+
+/** START_MEASUREMENT batch_size: let the STM32 size batches to the link load */
+#define PROTOCOL_STREAM_BATCH_AUTO    0xFF
+
 // UART framing markers (used by lower layer)
 #define PACKET_START_MARKER           0xAA
 #define PACKET_END_MARKER             0x55
@@ -49,6 +97,15 @@ typedef enum {
     PACKET_TYPE_NOTIFY = 0x03,    /**< Unsolicited notification from STM32 */
 } packet_type_t;
 
+/**
+ * Set on the TYPE byte when the payload's sensor_sample_t array is replaced
+ * by the compact delta/varint encoding (Utils/sample_codec). The payload
+ * header (sensor_type, sample_count, ...) is unchanged. Only sent after
+ * PROTOCOL_VERSION_COMPACT has been negotiated.
+ */
+#define PACKET_TYPE_FLAG_COMPACT      0x80
+#define PACKET_TYPE_MASK              0x7F
+
 // ============================================================================
 // Command IDs
 // ============================================================================
@@ -60,11 +117,43 @@ typedef enum {
     CMD_SET_RTC            = 0x04,   /**< Set STM32 RTC time */
     CMD_GET_STATUS         = 0x05,   /**< Get STM32 status */
     CMD_CLEAR_BUFFER       = 0x06,   /**< Clear data buffer */
-    CMD_GET_CONFIG         = 0x07,   /**< Get configuration */
-    CMD_SET_CONFIG         = 0x08,   /**< Set configuration */
+    CMD_GET_CONFIG         = 0x07,   /**< Read the runtime config store */
+    CMD_SET_CONFIG         = 0x08,   /**< Change (and save) runtime config values */
+    CMD_NEGOTIATE_VERSION  = 0x09,   /**< Agree on protocol version / framing */
+    CMD_RETRANSMIT         = 0x0A,   /**< Resend a windowed response by seq */
+    CMD_BULK_DUMP          = 0x0B,   /**< Stream a buffer range as NOTIFY frames */
+    CMD_GET_CURRENT_CAPTURE = 0x0C,  /**< Offload current-monitor capture records */
+    CMD_GET_BUFFER_RANGE   = 0x0D,   /**< Request buffered data by timestamp range */
+    CMD_GET_HISTORY        = 0x0E,   /**< Request downsampled min/max/mean history */
+    CMD_GET_RECORDING      = 0x0F,   /**< Offload the recorder's stored blocks */
+    CMD_GET_STATS          = 0x10,   /**< Request windowed running statistics */
+    CMD_GET_ANALYSIS       = 0x11,   /**< Analyze the completed current capture */
+    CMD_GET_PERF           = 0x12,   /**< Binary system metrics snapshot */
+    CMD_GET_PROBES         = 0x13,   /**< Cycle-count probe statistics */
+    CMD_ECHO               = 0x14,   /**< Respond with the request payload */
+    CMD_LOOPBACK_TEST      = 0x15,   /**< Link round-trip/throughput test, STM32 driven */
+    CMD_LOOPBACK_RETURN    = 0x16,   /**< Loopback probe sent back by the host (no response) */
+    CMD_SET_BAUD_RATE      = 0x17,   /**< Switch the link rate (supervised) */
+    CMD_GET_COMMAND_STATS  = 0x18,   /**< Per-command counts and handling time */
+    CMD_BULK_EXPORT        = 0x19,   /**< Stream all sensor rings merged by timestamp */
+    CMD_GRANT_CREDITS      = 0x1A,   /**< Allow more stream/bulk NOTIFY frames */
+    CMD_HELLO              = 0x1B,   /**< Exchange version, frame size and features */
+    CMD_SUBSCRIBE_EVENTS   = 0x1C,   /**< Forward event bus types as NOTIFY_EVENTS */
+    CMD_GET_STATUS_IF_CHANGED = 0x1D, /**< GET_STATUS unless unchanged since a version */
+    CMD_GET_LINK_STATS     = 0x1E,   /**< Sliding-window link rates */
+    CMD_GET_DEADLINES      = 0x1F,   /**< Periodic work lateness and misses */
+    CMD_TIME_SYNC          = 0x20,   /**< NTP-style clock exchange, disciplines the STM32 clock */
 
     // Notification IDs (0x80+)
     NOTIFY_SENSOR_DATA     = 0x80,   /**< Live sensor data notification */
+    NOTIFY_BULK_DATA       = 0x81,   /**< Bulk dump chunk */
+    NOTIFY_BULK_DONE       = 0x82,   /**< Bulk dump finished */
+    NOTIFY_CURRENT_DATA    = 0x83,   /**< Current capture records chunk */
+    NOTIFY_RECORDING_DATA  = 0x84,   /**< Recording bytes chunk */
+    NOTIFY_LOOPBACK_PROBE  = 0x85,   /**< Loopback probe, to return as CMD_LOOPBACK_RETURN */
+    NOTIFY_LOOPBACK_DONE   = 0x86,   /**< Loopback test results */
+    NOTIFY_BAUD_FALLBACK   = 0x87,   /**< Link went back to an earlier rate */
+    NOTIFY_EVENTS          = 0x88,   /**< Batch of forwarded event bus events */
 } command_id_t;
 
 // ============================================================================
@@ -79,6 +168,7 @@ typedef enum {
     RESP_BUSY          = 0x04,   /**< Device busy */
     RESP_TIMEOUT       = 0x05,   /**< Operation timeout */
     RESP_NO_DATA       = 0x06,   /**< No data available */
+    RESP_NOT_MODIFIED  = 0x07,   /**< Unchanged since the version asked about (no payload) */
 } response_status_t;
 
 // ============================================================================
@@ -90,16 +180,26 @@ typedef enum {
  * Total header size: 6 bytes
  */
 typedef struct {
-    uint8_t type;                              /**< Packet type (CMD/RESP/NOTIFY) */
-    uint8_t cmd_id;                            /**< Command identifier */
-    uint8_t seq;                               /**< Sequence number */
-    uint8_t status;                            /**< Response status (RESP only) */
-    uint16_t length;                           /**< Payload length */
-    uint8_t payload[PROTOCOL_MAX_PAYLOAD_SIZE]; /**< Payload data */
+    uint8_t  type;            /**< Packet type (CMD/RESP/NOTIFY) */
+    uint8_t  cmd_id;          /**< Command identifier */
+    uint8_t  seq;             /**< Sequence number */
+    uint8_t  status;          /**< Response status (RESP only) */
+    uint16_t length;          /**< Payload length */
+    uint8_t  payload[PROTOCOL_MAX_PAYLOAD_SIZE]; /**< Payload data */
 } __attribute__((packed)) protocol_packet_t;
 
 #define PROTOCOL_HEADER_SIZE  6
 
+/** Same header as protocol_packet_t, with the larger bulk payload */
+typedef struct {
+    uint8_t  type;
+    uint8_t  cmd_id;
+    uint8_t  seq;
+    uint8_t  status;
+    uint16_t length;
+    uint8_t  payload[PROTOCOL_BULK_MAX_PAYLOAD_SIZE];
+} __attribute__((packed)) protocol_bulk_packet_t;
+
 // ============================================================================
 // Common Payload Structures
 // ============================================================================
@@ -120,14 +220,109 @@ typedef struct {
     uint32_t unix_time;
 } __attribute__((packed)) cmd_set_rtc_t;
 
+/**
+ * NEGOTIATE_VERSION request/response payload
+ *
+ * The request carries the highest version the sender supports; the response
+ * carries the version both sides use from the next frame on. The response
+ * itself is still sent in the old framing.
+ */
+typedef struct {
+    uint8_t  version;
+} __attribute__((packed)) cmd_negotiate_version_t;
+
+typedef cmd_negotiate_version_t resp_negotiate_version_t;
+
+/**
+ * Feature bits exchanged by CMD_HELLO
+ *
+ * Each side announces what it implements; the response carries the
+ * intersection, which is what both use from the next frame on. Bits a
+ * side does not know are simply never in the intersection, so either side
+ * can be upgraded first.
+ */
+#define PROTOCOL_FEATURE_COBS         (1UL << 0)  /**< COBS framing */
+#define PROTOCOL_FEATURE_COMPACT      (1UL << 1)  /**< Compact sample arrays (PACKET_TYPE_FLAG_COMPACT) */
+#define PROTOCOL_FEATURE_WINDOW       (1UL << 2)  /**< Windowed GET_BUFFER_DATA + RETRANSMIT */
+#define PROTOCOL_FEATURE_STREAM_BATCH (1UL << 3)  /**< Batched NOTIFY_SENSOR_DATA */
+#define PROTOCOL_FEATURE_BAUD_SWITCH  (1UL << 4)  /**< SET_BAUD_RATE */
+#define PROTOCOL_FEATURE_CREDITS      (1UL << 5)  /**< GRANT_CREDITS flow control */
+#define PROTOCOL_FEATURE_BULK         (1UL << 6)  /**< Bulk frames up to PROTOCOL_BULK_MAX_PAYLOAD_SIZE */
+#define PROTOCOL_FEATURE_BULK_EXPORT  (1UL << 7)  /**< BULK_EXPORT, merged rings */
+#define PROTOCOL_FEATURE_HUMIDITY     (1UL << 8)  /**< SENSOR_HUMIDITY channel */
+#define PROTOCOL_FEATURE_EVENTS       (1UL << 9)  /**< SUBSCRIBE_EVENTS forwarding */
+#define PROTOCOL_FEATURE_STATUS_VERSION (1UL << 10) /**< GET_STATUS_IF_CHANGED */
+#define PROTOCOL_FEATURE_LINK_STATS   (1UL << 11) /**< GET_LINK_STATS */
+#define PROTOCOL_FEATURE_AUTO_BATCH   (1UL << 12) /**< PROTOCOL_STREAM_BATCH_AUTO */
+#define PROTOCOL_FEATURE_DEADLINES    (1UL << 13) /**< GET_DEADLINES */
+#define PROTOCOL_FEATURE_SWINGING_DOOR (1UL << 14) /**< Climate rings hold swinging-door points: interpolate between samples */
+#define PROTOCOL_FEATURE_TIME_SYNC    (1UL << 15) /**< TIME_SYNC */
+#define PROTOCOL_FEATURE_CONFIG       (1UL << 16) /**< GET_CONFIG / SET_CONFIG */
+
+/**
+ * HELLO request payload
+ *
+ * Replaces NEGOTIATE_VERSION for hosts that know it. The response is sent
+ * in the old framing, like NEGOTIATE_VERSION's; framing and compact
+ * samples then follow the agreed features. A host whose max_payload is
+ * below PROTOCOL_BULK_MAX_PAYLOAD_SIZE does not get PROTOCOL_FEATURE_BULK,
+ * and bulk transfers are refused with RESP_INVALID_PARAM.
+ */
+typedef struct {
+    uint8_t  version;         /**< Highest protocol version the host supports */
+    uint16_t max_payload;     /**< Largest payload the host can receive */
+    uint32_t features;        /**< PROTOCOL_FEATURE_* the host implements */
+} __attribute__((packed)) cmd_hello_t;
+
+/** HELLO response payload */
+typedef struct {
+    uint8_t  version;         /**< Version both use */
+    uint16_t max_payload;     /**< Largest payload the STM32 accepts */
+    uint16_t max_bulk_payload; /**< Largest payload the STM32 sends */
+    uint8_t  window_size;     /**< PROTOCOL_WINDOW_SIZE */
+    uint8_t  max_stream_batch; /**< PROTOCOL_STREAM_MAX_BATCH */
+    uint32_t features;        /**< Agreed features (intersection) */
+    uint32_t stm32_features;  /**< Everything the STM32 implements */
+} __attribute__((packed)) resp_hello_t;
+
+/**
+ * RETRANSMIT request payload
+ *
+ * Answered with the original response (its cmd_id and seq), or with
+ * cmd_id CMD_RETRANSMIT and RESP_NO_DATA if it has left the window.
+ */
+typedef struct {
+    uint8_t  seq;             /**< Seq of the response to resend */
+} __attribute__((packed)) cmd_retransmit_t;
+
 /** GET_STATUS response payload */
 typedef struct {
     uint8_t  state;           /**< Current device state */
     uint8_t  error_code;      /**< Last error code */
     uint16_t buffer_count;    /**< Records in buffer */
     uint32_t uptime_sec;      /**< Uptime in seconds */
+    uint16_t stream_missed_deadlines; /**< Stream sample slots skipped (saturating) */
+    uint16_t loop_missed_deadlines; /**< Service loop overruns (saturating) */
 } __attribute__((packed)) resp_get_status_t;
 
+/**
+ * GET_STATUS_IF_CHANGED request payload
+ *
+ * Answered with RESP_NOT_MODIFIED and no payload while the status still
+ * has since_version, else like GET_STATUS with the current version in
+ * front. uptime_sec does not count as a change. Versions start at 1, so
+ * since_version 0 always gets the full status.
+ */
+typedef struct {
+    uint32_t since_version;   /**< Version of the host's last copy */
+} __attribute__((packed)) cmd_get_status_if_changed_t;
+
+/** GET_STATUS_IF_CHANGED response payload (RESP_OK) */
+typedef struct {
+    uint32_t version;         /**< Bumped on each change of the status */
+    resp_get_status_t status;
+} __attribute__((packed)) resp_status_snapshot_t;
+
 // ============================================================================
 // Sensor Types
 // ============================================================================
@@ -135,7 +330,11 @@ typedef struct {
 typedef enum {
     SENSOR_TEMPERATURE = 0x01,
     SENSOR_CURRENT     = 0x02,
+    SENSOR_HUMIDITY    = 0x03,    /**< Relative humidity, centi-percent */
     // Future sensors can be added here
+
+    SENSOR_TEMP_HUMIDITY = 0x80,  /**< BULK_DUMP only: both climate channels, see cmd_bulk_dump_t */
+    SENSOR_MERGED      = 0x81,    /**< BULK_EXPORT frames: mixed types, see cmd_bulk_export_t */
 } sensor_type_t;
 
 // ============================================================================
@@ -149,6 +348,19 @@ typedef struct {
     int32_t  value;           /**< Scaled value (e.g., temp_C * 100, current_mA) */
 } __attribute__((packed)) sensor_sample_t;
 
+/**
+ * One downsampled history record (see sensor_rollup.h)
+ *
+ * Summarizes count raw samples; timestamp is that of the first one.
+ */
+typedef struct {
+    uint32_t timestamp;       /**< Timestamp of the first sample covered */
+    int32_t  min;             /**< Lowest value */
+    int32_t  max;             /**< Highest value */
+    int32_t  mean;            /**< Mean value (rounded) */
+    uint16_t count;           /**< Raw samples covered */
+} __attribute__((packed)) sensor_rollup_record_t;
+
 /** GET_BUFFER_DATA response - array of samples follows header */
 typedef struct {
     uint8_t  sensor_type;     /**< Sensor type requested */
@@ -156,10 +368,682 @@ typedef struct {
     // Followed by: sensor_sample_t samples[sample_count]
 } __attribute__((packed)) resp_buffer_data_header_t;
 
-/** START_MEASUREMENT extended - specify which sensor */
+/**
+ * GET_BUFFER_RANGE request payload
+ *
+ * Samples with from_timestamp <= timestamp < to_timestamp, oldest first, as
+ * many as fit one response. For an incremental sync the host asks from just
+ * past the newest timestamp it has, and repeats while full responses come
+ * back.
+ */
+typedef struct {
+    uint32_t from_timestamp;  /**< First timestamp included */
+    uint32_t to_timestamp;    /**< First timestamp excluded, 0 = no limit */
+    uint16_t count;           /**< Maximum samples wanted */
+} __attribute__((packed)) cmd_get_buffer_range_t;
+
+/** GET_BUFFER_RANGE response - array of samples follows header */
+typedef struct {
+    uint8_t  sensor_type;     /**< Sensor type of the buffer */
+    uint32_t first_index;     /**< Buffer index of the first sample (0 = oldest) */
+    uint16_t sample_count;    /**< Number of samples in payload */
+    // Followed by: sensor_sample_t samples[sample_count] (compact if negotiated)
+} __attribute__((packed)) resp_buffer_range_header_t;
+
+/**
+ * GET_HISTORY request payload
+ *
+ * Records of one history tier with timestamp >= from_timestamp, oldest
+ * first, as many as fit one response.
+ */
+typedef struct {
+    uint8_t  sensor_type;     /**< Sensor whose history to read */
+    uint8_t  tier;            /**< 0 = finest */
+    uint32_t from_timestamp;  /**< First record timestamp included, 0 = oldest */
+    uint16_t count;           /**< Maximum records wanted */
+} __attribute__((packed)) cmd_get_history_t;
+
+/** GET_HISTORY response - array of records follows header */
+typedef struct {
+    uint8_t  sensor_type;     /**< Sensor type */
+    uint8_t  tier;            /**< Tier read */
+    uint32_t first_index;     /**< Tier index of the first record (0 = oldest) */
+    uint16_t record_count;    /**< Number of records in payload */
+    // Followed by: sensor_rollup_record_t records[record_count]
+} __attribute__((packed)) resp_history_header_t;
+
+/**
+ * GET_STATS request payload
+ *
+ * Summary of one running statistics window kept on the device (see
+ * stream_stats.h). Temperature: channel 0, windows last minute / last hour
+ * / since clear. Current: channel 0 = current, 1 = bus voltage, windows
+ * of CURRENT_MONITOR_STATS_SHORT / _LONG samples / whole measurement.
+ */
+typedef struct {
+    uint8_t  sensor_type;     /**< Sensor to summarize */
+    uint8_t  channel;         /**< Stream of that sensor */
+    uint8_t  window;          /**< Window number */
+} __attribute__((packed)) cmd_get_stats_t;
+
+#define STATS_FLAG_COMPLETE   0x01  /**< Window complete (else still filling) */
+
+/** GET_STATS response; value = raw x scale in the sensor's unit (degC, mA, V) */
+typedef struct {
+    uint8_t  sensor_type;
+    uint8_t  channel;
+    uint8_t  window;
+    uint8_t  flags;           /**< STATS_FLAG_* */
+    uint32_t length;          /**< Window length in samples, 0 = since reset */
+    uint32_t count;           /**< Samples covered */
+    uint32_t first_timestamp; /**< Of the first sample covered */
+    uint32_t last_timestamp;  /**< Of the last sample covered */
+    int32_t  min;             /**< Raw units */
+    int32_t  max;
+    float    mean;
+    float    stddev;          /**< Population standard deviation */
+    float    rms;
+    float    scale;           /**< Unit per raw LSB */
+} __attribute__((packed)) resp_stats_t;
+
+/**
+ * GET_ANALYSIS response (no request payload)
+ *
+ * Energy, peak and mean figures of the completed current capture, computed
+ * on the device (see serv_current_analysis.h). RESP_NO_DATA while no
+ * completed measurement holds samples.
+ */
+typedef struct {
+    uint32_t first_index;     /**< First sample analyzed */
+    uint32_t sample_count;
+    uint32_t block_count;     /**< Analysis blocks of 4096 samples */
+    float    duration_s;
+    float    mean_current_mA;
+    float    rms_current_mA;
+    float    peak_current_mA;
+    uint32_t peak_index;
+    float    filtered_peak_mA; /**< Peak of the low-pass filtered current */
+    uint32_t filtered_peak_index;
+    float    mean_power_mW;
+    float    energy_mWh;
+    float    charge_mAh;
+    uint32_t cycles_per_block; /**< Average CPU cycles per full block */
+    uint32_t cycles_max_block;
+} __attribute__((packed)) resp_analysis_t;
+
+/**
+ * GET_PERF response (no request payload)
+ *
+ * perf_snapshot_t of performance_monitor.h, truncated after its
+ * task_count task entries: heap, CPU load (overall and per task), stack
+ * high-water marks, event bus, host link and UART ISR counters. Check
+ * the leading version byte against PERF_SNAPSHOT_VERSION.
+ */
+
+/**
+ * GET_PROBES response (no request payload)
+ *
+ * One entry per probe of cycle_probe.h with measurements; RESP_NO_DATA
+ * when probes are compiled out.
+ */
+typedef struct {
+    uint32_t cpu_freq_hz;     /**< Cycles per second, to convert to time */
+    uint8_t  probe_count;     /**< Entries that follow */
+    // Followed by: resp_probe_entry_t entries[probe_count]
+} __attribute__((packed)) resp_probes_header_t;
+
+typedef struct {
+    uint8_t  probe_id;        /**< cycle_probe_id_t */
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t avg_cycles;
+    uint32_t max_cycles;
+} __attribute__((packed)) resp_probe_entry_t;
+
+/**
+ * BULK_DUMP request payload
+ *
+ * Acknowledged with a plain RESP, then answered by NOTIFY_BULK_DATA frames
+ * back to back and one NOTIFY_BULK_DONE. All of them carry the request seq.
+ *
+ * SENSOR_TEMP_HUMIDITY multiplexes the two climate channels in one dump:
+ * data frames alternate between SENSOR_TEMPERATURE and SENSOR_HUMIDITY
+ * (each header names its channel), start_index and count apply to each
+ * channel, and samples with equal indices share a timestamp.
+ */
+typedef struct {
+    uint8_t  sensor_type;     /**< Buffer to dump (sensor_type_t) */
+    uint32_t start_index;     /**< First sample (0 = oldest) */
+    uint32_t count;           /**< Samples to send, 0 = to the end */
+} __attribute__((packed)) cmd_bulk_dump_t;
+
+/** NOTIFY_BULK_DATA payload - array of samples follows header */
+typedef struct {
+    uint8_t  sensor_type;     /**< Sensor type being dumped */
+    uint32_t first_index;     /**< Buffer index of the first sample */
+    uint16_t sample_count;    /**< Number of samples in payload */
+    // Followed by: sensor_sample_t samples[sample_count]
+} __attribute__((packed)) notify_bulk_data_header_t;
+
+/** GRANT_CREDITS request payload */
+typedef struct {
+    uint16_t credits;         /**< Added to the balance, or PROTOCOL_CREDITS_OFF */
+} __attribute__((packed)) cmd_grant_credits_t;
+
+/** GRANT_CREDITS response payload */
+typedef struct {
+    uint16_t balance;         /**< Credits left after the grant */
+    uint32_t stalls;          /**< Frames held back or skipped for lack of credit */
+} __attribute__((packed)) resp_grant_credits_t;
+
+/**
+ * SUBSCRIBE_EVENTS request payload
+ *
+ * Bit n of event_mask forwards event bus type n (event_type_t, 1..31); the
+ * mask replaces the previous one and 0 ends forwarding. Matching events
+ * are collected on the STM32 and sent as NOTIFY_EVENTS once batch_size are
+ * waiting or the oldest is max_latency_ms old. Events are dropped (and
+ * counted) while the link cannot keep up or credits are out.
+ */
+typedef struct {
+    uint32_t event_mask;      /**< Types to forward */
+    uint8_t  batch_size;      /**< Events per notification, 0/1 = unbatched */
+    uint16_t max_latency_ms;  /**< Flush deadline for a partial batch, 0 = default */
+} __attribute__((packed)) cmd_subscribe_events_t;
+
+/** SUBSCRIBE_EVENTS response payload */
+typedef struct {
+    uint32_t event_mask;      /**< Types now forwarded (others could not be subscribed) */
+} __attribute__((packed)) resp_subscribe_events_t;
+
+#define PROTOCOL_EVENT_MAX_DATA     24      /**< Event payload bytes forwarded, rest cut off */
+
+/** NOTIFY_EVENTS payload - records follow the header */
+typedef struct {
+    uint8_t  event_count;     /**< Records in this notification */
+    uint16_t dropped;         /**< Events lost since the last notification (saturating) */
+    // Followed by event_count x (notify_event_record_t + data[data_size])
+} __attribute__((packed)) notify_events_header_t;
+
+/**
+ * One forwarded event
+ *
+ * data is the payload as published on the STM32 (little-endian structs
+ * from the event's documentation), cut to PROTOCOL_EVENT_MAX_DATA bytes.
+ */
+typedef struct {
+    uint8_t  event_type;      /**< event_type_t */
+    uint32_t timestamp;       /**< Publish time, us (wraps every ~71 min) */
+    uint8_t  data_size;       /**< Payload bytes that follow */
+} __attribute__((packed)) notify_event_record_t;
+
+/**
+ * BULK_EXPORT request payload
+ *
+ * Like BULK_DUMP, but one pass over several rings: NOTIFY_BULK_DATA frames
+ * carry plain sensor_sample_t records of all selected sensors, merged into
+ * timestamp order (ties: temperature, humidity, current). The header's
+ * sensor_type is SENSOR_MERGED and first_index counts records sent before
+ * the frame; each record names its own sensor. Never compact-encoded, as
+ * the codec takes runs of one type. One NOTIFY_BULK_DONE ends the export.
+ *
+ * Current samples are only buffered once a capture is complete. Their
+ * timestamps are Unix seconds, so set the RTC before merging them with
+ * the climate rings.
+ */
+typedef struct {
+    uint8_t  sensors;         /**< Bit (1 << sensor_type) per ring, 0 = all */
+    uint32_t from_timestamp;  /**< First timestamp included, 0 = oldest */
+    uint32_t count;           /**< Records to send, 0 = all */
+} __attribute__((packed)) cmd_bulk_export_t;
+
+/** NOTIFY_BULK_DONE payload */
+typedef struct {
+    uint8_t  sensor_type;     /**< Sensor type dumped */
+    uint8_t  status;          /**< RESP_OK, or why the dump stopped early */
+    uint32_t sample_count;    /**< Total samples sent */
+} __attribute__((packed)) notify_bulk_done_t;
+
+/** GET_CURRENT_CAPTURE flags */
+#define CURRENT_CAPTURE_FLAG_FOLLOW   0x01  /**< Keep sending new records until the measurement stops */
+#define CURRENT_CAPTURE_FLAG_START    0x02  /**< Start a new measurement first (period/duration) */
+
+/**
+ * GET_CURRENT_CAPTURE request payload
+ *
+ * Acknowledged with a plain RESP, then answered on the bulk path: back-to-back
+ * NOTIFY_CURRENT_DATA frames and one NOTIFY_BULK_DONE (sensor_type
+ * SENSOR_CURRENT), all carrying the request seq. Indices count from the
+ * measurement start, so a host offloads a continuous (duration_sec = 0)
+ * capture by asking again from where the previous dump ended, or by
+ * following it.
+ *
+ * With FLAG_START the RESP carries resp_current_capture_plan_t: how the
+ * measurement will be kept. One longer than the RAM buffer runs if a
+ * following dump can stream it or the recorder can stage it in flash; if
+ * neither can, it is refused with RESP_INVALID_PARAM and the plan says why.
+ */
+typedef struct {
+    uint32_t start_index;     /**< First record (from measurement start) */
+    uint32_t count;           /**< Records to send, 0 = all available (or unbounded with FOLLOW) */
+    uint8_t  flags;           /**< CURRENT_CAPTURE_FLAG_* */
+    uint16_t sample_period_ms; /**< With FLAG_START: 1, 10, 100 or 1000 */
+    uint32_t duration_sec;    /**< With FLAG_START: 1-3600, 0 = continuous */
+} __attribute__((packed)) cmd_get_current_capture_t;
+
+/** resp_current_capture_plan_t modes */
+#define CURRENT_CAPTURE_MODE_NONE       0   /**< Nothing sustains it: refused */
+#define CURRENT_CAPTURE_MODE_BUFFER     1   /**< RAM buffer, read out afterwards (continuous: newest only) */
+#define CURRENT_CAPTURE_MODE_STREAM     2   /**< Offloaded by the following dump as it runs */
+#define CURRENT_CAPTURE_MODE_FLASH      3   /**< Staged by the recorder (GET_RECORDING) */
+
+/** resp_current_capture_plan_t formats (index of need[]) */
+#define CURRENT_CAPTURE_FORMAT_RAW        0 /**< current_record_t frames */
+#define CURRENT_CAPTURE_FORMAT_PACKED     1 /**< Raw INA226 registers (buffer, recorder blocks) */
+#define CURRENT_CAPTURE_FORMAT_COMPRESSED 2 /**< Compressed recorder blocks (estimate) */
+#define CURRENT_CAPTURE_FORMAT_COUNT      3
+
+/** What keeping the whole measurement takes in one format (volumes 0 if continuous) */
+typedef struct {
+    uint32_t ram_bytes;       /**< Held on the device until read out */
+    uint32_t flash_bytes;     /**< Staged in recorder blocks */
+    uint32_t link_bytes_per_s; /**< Streamed live, framing included */
+} __attribute__((packed)) current_capture_need_t;
+
+/** GET_CURRENT_CAPTURE response payload with CURRENT_CAPTURE_FLAG_START */
+typedef struct {
+    uint8_t  mode;            /**< CURRENT_CAPTURE_MODE_* */
+    uint8_t  format;          /**< CURRENT_CAPTURE_FORMAT_* the mode keeps samples in */
+    uint32_t samples;         /**< Samples the measurement takes, 0 = continuous */
+    uint32_t ram_bytes;       /**< Available: the sample buffer */
+    uint32_t flash_bytes;     /**< Available: recorder storage, 0 if it is off */
+    uint32_t link_bytes_per_s; /**< Available to a stream (link share it may plan on) */
+    current_capture_need_t need[CURRENT_CAPTURE_FORMAT_COUNT];
+} __attribute__((packed)) resp_current_capture_plan_t;
+
+/** One current-monitor capture record on the wire */
+typedef struct {
+    uint32_t timestamp_sec;   /**< RTC seconds */
+    uint16_t timestamp_ms;    /**< Milliseconds (0-999) */
+    uint8_t  state;           /**< Main state machine state at capture */
+    float    current_mA;
+    float    voltage_V;
+    float    power_mW;
+} __attribute__((packed)) current_record_t;
+
+/** NOTIFY_CURRENT_DATA payload - array of records follows header */
+typedef struct {
+    uint32_t first_index;     /**< Index of the first record */
+    uint16_t record_count;    /**< Number of records in payload */
+    uint32_t dropped;         /**< Records lost because the offload fell behind, so far */
+    // Followed by: current_record_t records[record_count]
+} __attribute__((packed)) notify_current_data_header_t;
+
+/**
+ * GET_RECORDING request payload
+ *
+ * Acknowledged with a plain RESP, then answered on the bulk path: back-to-back
+ * NOTIFY_RECORDING_DATA frames and one NOTIFY_BULK_DONE (sensor_type
+ * SENSOR_CURRENT, sample_count = bytes sent), all carrying the request seq.
+ * The bytes are the recorder's blocks as stored (format in serv_recorder.h).
+ */
+typedef struct {
+    uint32_t offset;          /**< First byte (from the start of the recording) */
+    uint32_t length;          /**< Bytes to send, 0 = to the end */
+} __attribute__((packed)) cmd_get_recording_t;
+
+/** NOTIFY_RECORDING_DATA payload - raw recording bytes follow header */
+typedef struct {
+    uint32_t offset;          /**< Offset of the first byte */
+    uint32_t total_bytes;     /**< Bytes recorded so far */
+    uint16_t byte_count;      /**< Number of bytes in payload */
+    // Followed by: uint8_t data[byte_count]
+} __attribute__((packed)) notify_recording_data_header_t;
+
+/**
+ * LOOPBACK_TEST request payload
+ *
+ * Acknowledged with a plain RESP, then the STM32 sends count
+ * NOTIFY_LOOPBACK_PROBE frames, keeping up to window of them unanswered.
+ * The host sends each probe's payload back unchanged as a
+ * CMD_LOOPBACK_RETURN (no response follows). A probe not back within
+ * timeout_ms is counted lost. One NOTIFY_LOOPBACK_DONE ends the test; all
+ * of the STM32's frames carry the request seq. window = 1 measures latency,
+ * a full window sustained throughput. CMD_ECHO serves host-timed tests.
+ */
+typedef struct {
+    uint32_t count;           /**< Probes to send (1..) */
+    uint16_t payload_size;    /**< Probe payload bytes, header included (LOOPBACK_PROBE_MIN..PROTOCOL_BULK_MAX_PAYLOAD_SIZE) */
+    uint8_t  window;          /**< Probes outstanding at once (1..LOOPBACK_MAX_WINDOW) */
+    uint16_t timeout_ms;      /**< Per probe, 0 = LOOPBACK_DEFAULT_TIMEOUT_MS */
+} __attribute__((packed)) cmd_loopback_test_t;
+
+#define LOOPBACK_MAX_WINDOW         8
+#define LOOPBACK_DEFAULT_TIMEOUT_MS 100
+
+/** NOTIFY_LOOPBACK_PROBE payload - pattern bytes follow up to payload_size */
+typedef struct {
+    uint32_t probe_seq;       /**< 0..count-1 */
+    uint32_t sent_us;         /**< STM32 timebase, low 32 bits */
+    // Followed by: uint8_t pattern[], byte i = (uint8_t)(probe_seq + i)
+} __attribute__((packed)) notify_loopback_probe_t;
+
+#define LOOPBACK_PROBE_MIN          sizeof(notify_loopback_probe_t)
+
+/**
+ * NOTIFY_LOOPBACK_DONE payload
+ *
+ * RTT percentiles are bucket upper bounds (within 1/8 of the value). Rates
+ * run over the test duration and count returned probes; bytes are payload
+ * bytes in one direction. The error counts are stm32_uart_stats_t deltas
+ * over the test.
+ */
+typedef struct {
+    uint8_t  status;          /**< RESP_OK, or why the test stopped early */
+    uint16_t payload_size;
+    uint32_t sent;
+    uint32_t returned;
+    uint32_t lost;            /**< Timed out */
+    uint32_t corrupt;         /**< Returned with a wrong length or pattern */
+    uint32_t duration_us;
+    uint32_t frames_per_s;
+    uint32_t bytes_per_s;
+    uint32_t rtt_min_us;
+    uint32_t rtt_p50_us;
+    uint32_t rtt_p90_us;
+    uint32_t rtt_p99_us;
+    uint32_t rtt_max_us;
+    uint32_t crc_errors;
+    uint32_t framing_errors;
+    uint32_t overflow_errors;
+    uint32_t timeout_errors;
+} __attribute__((packed)) notify_loopback_done_t;
+
+/**
+ * SET_BAUD_RATE request payload
+ *
+ * Answered at the old rate; the STM32 switches once the response is on the
+ * wire, and the host switches when it has the response. The host must then
+ * send a valid frame (e.g. GET_STATUS) within probation_ms, or the STM32
+ * returns to the previous rate. Later error spikes (more than
+ * STM32_UART_BAUD_ERROR_LIMIT RX errors a second) also send it back. Either
+ * way NOTIFY_BAUD_FALLBACK follows at the restored rate; a host that stops
+ * hearing the STM32 after a switch should return to the previous rate too.
+ * RESP_BUSY while a bulk transfer runs, RESP_INVALID_PARAM if the USART
+ * cannot make the rate. Rates above ~1 Mbaud want use_flow_control.
+ */
+typedef struct {
+    uint32_t baud_rate;       /**< Up to STM32_UART_BAUD_MAX */
+    uint16_t probation_ms;    /**< 0 = PROTOCOL_BAUD_PROBATION_MS */
+} __attribute__((packed)) cmd_set_baud_rate_t;
+
+#define PROTOCOL_BAUD_PROBATION_MS  1000
+
+/** SET_BAUD_RATE response payload */
+typedef struct {
+    uint32_t baud_rate;       /**< Rate after the switch */
+    uint32_t previous_baud_rate;
+} __attribute__((packed)) resp_set_baud_rate_t;
+
+/** NOTIFY_BAUD_FALLBACK payload */
+typedef struct {
+    uint32_t baud_rate;       /**< Rate in use again */
+} __attribute__((packed)) notify_baud_fallback_t;
+
+/**
+ * GET_COMMAND_STATS request payload (optional, all zero if omitted)
+ *
+ * One entry per command handled, rejected or busy since the last reset, from
+ * first_cmd_id up. When the entries do not fit one response, next_cmd_id
+ * says where to continue. Handling time is the handler's own, from leaving
+ * the command queue; work it hands to the bulk task is not included.
+ */
+typedef struct {
+    uint8_t  first_cmd_id;    /**< First command to report */
+    uint8_t  reset;           /**< 1 = clear all counters after this response */
+} __attribute__((packed)) cmd_get_command_stats_t;
+
+/** GET_COMMAND_STATS response header */
+typedef struct {
+    uint32_t cpu_freq_hz;     /**< Cycles per second, to convert to time */
+    uint32_t unknown_commands; /**< Commands with no registered handler */
+    uint8_t  entry_count;     /**< Entries that follow */
+    uint8_t  next_cmd_id;     /**< Continue here, 0 = complete */
+    // Followed by: resp_command_stats_entry_t entries[entry_count]
+} __attribute__((packed)) resp_command_stats_header_t;
+
+typedef struct {
+    uint8_t  cmd_id;
+    uint32_t count;           /**< Handled */
+    uint32_t rejected;        /**< Payload shorter than the command takes */
+    uint32_t busy;            /**< Dropped with RESP_BUSY, command queue full */
+    uint32_t avg_cycles;
+    uint32_t max_cycles;
+} __attribute__((packed)) resp_command_stats_entry_t;
+
+/**
+ * START_MEASUREMENT extended - specify which sensor
+ *
+ * batch_size and max_latency_ms are optional; a 5-byte request streams one
+ * sample per notification as before. With batch_size > 1, NOTIFY_SENSOR_DATA
+ * carries resp_buffer_data_header_t + samples (compact if negotiated) and is
+ * sent once batch_size samples are collected or the oldest one is
+ * max_latency_ms old, whichever comes first. With a max_latency_ms set,
+ * partial batches also go out early while the link is mostly idle
+ * (GET_LINK_STATS tx_busy_permille low), so batching only adds latency
+ * when the link needs it.
+ *
+ * batch_size PROTOCOL_STREAM_BATCH_AUTO starts unbatched and lets the
+ * STM32 double the batch while the link nears saturation and halve it
+ * back to single samples as it idles. max_latency_ms still bounds the
+ * delay (0 = a 100 ms default); every batch is at most
+ * PROTOCOL_STREAM_MAX_BATCH samples.
+ */
 typedef struct {
     uint8_t  sensor_type;     /**< Which sensor to stream */
     uint32_t interval_ms;     /**< Sample interval in ms */
+    uint8_t  batch_size;      /**< Samples per notification (1..PROTOCOL_STREAM_MAX_BATCH, or AUTO) */
+    uint16_t max_latency_ms;  /**< Flush deadline for a partial batch, 0 = none */
 } __attribute__((packed)) cmd_start_stream_t;
 
+#define CMD_START_STREAM_MIN_SIZE   5   /**< sensor_type + interval_ms */
+
+/**
+ * STOP_MEASUREMENT payload (optional)
+ *
+ * Sensors stream as independent sessions; this stops one of them. An empty
+ * payload stops all.
+ */
+typedef struct {
+    uint8_t  sensor_type;     /**< Which sensor's stream to stop */
+} __attribute__((packed)) cmd_stop_stream_t;
+
+/**
+ * GET_LINK_STATS response payload
+ *
+ * Rates over the last window (about 1 s) of the STM32's link counters.
+ * Answered RESP_NO_DATA until a first window exists.
+ */
+typedef struct {
+    uint32_t window_ms;       /**< Time the rates cover */
+    uint32_t tx_bytes_per_s;  /**< Wire bytes sent, framing included */
+    uint32_t rx_bytes_per_s;  /**< Wire bytes received, noise included */
+    uint32_t tx_frames_per_s;
+    uint32_t rx_frames_per_s; /**< Valid frames received */
+    uint32_t rx_error_ppm;    /**< Bad frames per million received */
+    uint32_t tx_wait_mean_us; /**< Mean wait for a free TX slot */
+    uint32_t tx_wait_p99_us;  /**< 99th percentile (power-of-two bucket bound) */
+    uint16_t tx_busy_permille; /**< Share of the window the TX DMA was busy */
+} __attribute__((packed)) resp_link_stats_t;
+
+/**
+ * GET_DEADLINES request payload (optional, all zero if omitted)
+ *
+ * One entry per monitored periodic activity (deadline_id_t) that has been
+ * registered, from first_deadline_id up, counted since its registration.
+ * When the entries do not fit one response, next_deadline_id says where to
+ * continue. Percentiles are power-of-two histogram bucket bounds. Answered
+ * RESP_NO_DATA with the monitor compiled out.
+ */
+typedef struct {
+    uint8_t  first_deadline_id; /**< First activity to report */
+} __attribute__((packed)) cmd_get_deadlines_t;
+
+/** GET_DEADLINES response header */
+typedef struct {
+    uint8_t  entry_count;     /**< Entries that follow */
+    uint8_t  next_deadline_id; /**< Continue here, 0 = complete */
+    // Followed by: resp_deadline_entry_t entries[entry_count]
+} __attribute__((packed)) resp_deadlines_header_t;
+
+typedef struct {
+    uint8_t  deadline_id;     /**< deadline_id_t */
+    uint32_t period_us;
+    uint32_t budget_us;
+    uint32_t jobs;            /**< Completed */
+    uint32_t misses;          /**< Ended after the next release, or slot skipped */
+    uint32_t overruns;        /**< Ran longer than the budget */
+    uint32_t lateness_p99_us; /**< Start after release */
+    uint32_t lateness_max_us;
+    uint32_t exec_avg_us;
+    uint32_t exec_p99_us;
+    uint32_t exec_max_us;
+} __attribute__((packed)) resp_deadline_entry_t;
+
+/** Wall-clock time, Unix epoch */
+typedef struct {
+    uint32_t sec;
+    uint32_t usec;            /**< 0..999999 */
+} __attribute__((packed)) time_stamp_t;
+
+/**
+ * TIME_SYNC request payload
+ *
+ * One NTP exchange per request: the host stamps T1 when sending, the STM32
+ * stamps T2 on arrival and T3 when answering, the host T4 when the
+ * response arrives. The next request reports T4 of the previous exchange
+ * (with its T1, so a lost response is recognized), and the STM32 takes
+ * host time (T1 + T4) / 2 at the midpoint of its T2..T3 as a sample of
+ * the host clock: it slews (or, past 100 ms, steps) towards it and
+ * estimates its crystal's frequency error against the samples. Exchanges
+ * with more than twice the recent smallest delay are left out. Once
+ * samples come, the RTC no longer disciplines the clock until they stop
+ * for a minute. prev_t1 / prev_t4 zero: nothing to report (first request).
+ * Run this every few seconds; it is answered in the RX task, ahead of
+ * queued commands.
+ */
+typedef struct {
+    time_stamp_t t1;          /**< Host clock, this request sent */
+    time_stamp_t prev_t1;     /**< T1 of the previous exchange */
+    time_stamp_t prev_t4;     /**< Host clock, previous response received */
+} __attribute__((packed)) cmd_time_sync_t;
+
+#define TIME_SYNC_FLAG_MEASURED    0x01    /**< offset_us / delay_us hold the previous exchange */
+#define TIME_SYNC_FLAG_APPLIED     0x02    /**< ... and it disciplined the clock */
+#define TIME_SYNC_FLAG_STEPPED     0x04    /**< ... by a step */
+#define TIME_SYNC_FLAG_REFERENCE   0x08    /**< The clock follows TIME_SYNC, not the RTC */
+
+/** TIME_SYNC response payload (T2 and T3 on the clock as the previous exchange left it) */
+typedef struct {
+    time_stamp_t t1;          /**< Echoed */
+    time_stamp_t t2;          /**< STM32 clock, request received */
+    time_stamp_t t3;          /**< STM32 clock, response sent */
+    int32_t  offset_us;       /**< Host minus STM32 at the previous exchange */
+    uint32_t delay_us;        /**< Its round trip, STM32 time excluded */
+    int32_t  rate_ppb;        /**< Frequency correction now applied */
+    uint8_t  flags;           /**< TIME_SYNC_FLAG_* */
+} __attribute__((packed)) resp_time_sync_t;
+
+/**
+ * Runtime config keys (GET_CONFIG / SET_CONFIG)
+ *
+ * Each key is one typed value with a range and a default; see
+ * Middleware/Services/serv_config.h for what each one drives. New keys are
+ * only ever appended, so a saved store stays readable.
+ */
+typedef enum {
+    CONFIG_KEY_TEMP_READ_MS = 0,        /**< Temperature read interval (shortest, with adaptive rate) */
+    CONFIG_KEY_DISPLAY_REFRESH_MS,      /**< Display refresh limit */
+    CONFIG_KEY_DISPLAY_CHART_MS,        /**< Capture poll while charting */
+    CONFIG_KEY_LOG_LEVEL,               /**< Default log level (LOG_LVL_*) */
+    CONFIG_KEY_STREAM_BATCH,            /**< Batch size when START_MEASUREMENT gives none */
+    CONFIG_KEY_STREAM_LATENCY_MS,       /**< max_latency_ms when START_MEASUREMENT gives none */
+    CONFIG_KEY_LINK_BAUD,               /**< UART rate from the next boot (supervised) */
+    CONFIG_KEY_COUNT
+} config_key_t;
+
+/** Value types; every value travels as a u32 */
+typedef enum {
+    CONFIG_TYPE_U8 = 0,
+    CONFIG_TYPE_U16,
+    CONFIG_TYPE_U32,
+    CONFIG_TYPE_BOOL,
+} config_type_t;
+
+#define CONFIG_FLAG_BOOT           0x01    /**< Takes effect at the next boot */
+
+/**
+ * GET_CONFIG request payload (optional, all zero if omitted)
+ *
+ * One entry per key from first_key up; when they do not fit one response,
+ * next_key says where to continue.
+ */
+typedef struct {
+    uint8_t  first_key;       /**< config_key_t */
+} __attribute__((packed)) cmd_get_config_t;
+
+#define CONFIG_STATE_UNSAVED       0x01    /**< Values differ from the saved store */
+#define CONFIG_STATE_SAVE_FAILED   0x02    /**< The last save did not reach flash */
+
+/** GET_CONFIG response header */
+typedef struct {
+    uint8_t  entry_count;     /**< Entries that follow */
+    uint8_t  next_key;        /**< Continue here, 0 = complete */
+    uint8_t  state;           /**< CONFIG_STATE_* */
+    uint32_t saves;           /**< Records written since boot */
+    // Followed by: resp_config_entry_t entries[entry_count]
+} __attribute__((packed)) resp_config_header_t;
+
+typedef struct {
+    uint8_t  key;             /**< config_key_t */
+    uint8_t  type;            /**< config_type_t */
+    uint8_t  flags;           /**< CONFIG_FLAG_* */
+    uint32_t value;
+    uint32_t min_value;
+    uint32_t max_value;
+    uint32_t default_value;
+} __attribute__((packed)) resp_config_entry_t;
+
+/** One value of a SET_CONFIG request */
+typedef struct {
+    uint8_t  key;             /**< config_key_t */
+    uint32_t value;
+} __attribute__((packed)) config_value_t;
+
+#define CONFIG_SET_SAVE            0x01    /**< Also save the store to flash */
+#define CONFIG_SET_DEFAULTS        0x02    /**< Start from the defaults (then apply the values) */
+
+/**
+ * SET_CONFIG request header
+ *
+ * Values are checked against their ranges first: one out of range (or an
+ * unknown key) fails the request with RESP_INVALID_PARAM and nothing
+ * changes. Otherwise all are applied at once, live where the key allows,
+ * and with CONFIG_SET_SAVE the store is written to flash by the services
+ * loop shortly after (a full store page first needs a sector erase, which
+ * waits until no current measurement runs).
+ */
+typedef struct {
+    uint8_t  flags;           /**< CONFIG_SET_* */
+    uint8_t  count;           /**< Values that follow */
+    // Followed by: config_value_t values[count]
+} __attribute__((packed)) cmd_set_config_header_t;
+
+/** SET_CONFIG response payload */
+typedef struct {
+    uint8_t  applied;         /**< Values taken */
+    uint8_t  bad_key;         /**< First rejected key, 0xFF = none */
+    uint8_t  flags;           /**< CONFIG_FLAG_BOOT if a changed key waits for a boot */
+} __attribute__((packed)) resp_set_config_t;
+
 #endif // PROTOCOL_COMMON_H
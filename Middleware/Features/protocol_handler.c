@@ -4,14 +4,30 @@
  */
 
 #include "protocol_handler.h"
-#include "esp32_packet_framing.h"
+#include "link_stats.h"
 #include "portable_log.h"
 #include "os_wrapper.h"
 #include "serv_temperature_sensor.h"
 #include "serv_current_monitor.h"
+#include "serv_recorder.h"
+#include "serv_current_analysis.h"
+#include "serv_capture_plan.h"
+#include "serv_config.h"
 #include "event_bus.h"
 #include "service_events.h"
 #include "hal_rtc.h"
+#include "hal_timebase.h"
+#include "services.h"
+#include "sample_codec.h"
+#include "performance_monitor.h"
+#include "cycle_probe.h"
+#include "deadline_monitor.h"
+#include "latency_trace.h"
+#include "hal_timer.h"
+#include "sysview_trace.h"
+#include "hal_delay.h"
+#include "mem_pool.h"
+#include "last_value.h"
 #include <string.h>
 
 static const char *TAG = "PROTO";
@@ -20,65 +36,595 @@ static const char *TAG = "PROTO";
 // Configuration
 // ============================================================================
 
+#define COMMAND_QUEUE_DEPTH     4       // Commands received while one is being handled
+#define COMMAND_TASK_STACK_SIZE 4096
+#define COMMAND_TASK_PRIORITY   8       // Below the framing RX task, which must keep parsing
+#define COMMAND_STOP_TIMEOUT_MS 1000
+#define COMMAND_BUSY_LOG_MS     1000    // "Command queue full" warning interval
 #define STREAM_TASK_STACK_SIZE  4096
 #define STREAM_TASK_PRIORITY    8
+#define STREAM_MAX_SESSIONS     2       // One per sensor type
+#define STREAM_IDLE_WAIT_MS     1000    // Scheduler wait with no deadline pending
+#define STREAM_STOP_TIMEOUT_MS  1000
+#define STREAM_DRAIN_CHUNK      16      // Captured current samples copied per read
+#define STREAM_AUTO_LATENCY_MS  100     // Auto batching deadline if the host sets none
+#define STREAM_AUTO_GROW_PERMILLE   750 // Auto batching: TX busy share that doubles the batch
+#define STREAM_AUTO_SHRINK_PERMILLE 250 // ... and that halves it
+#define BULK_TASK_STACK_SIZE    4096
+#define BULK_TASK_PRIORITY      8
+#define BULK_FOLLOW_POLL_MS     10      // Capture follow: wait for new records
+#define BULK_FOLLOW_MAX_WAIT_MS 100     // Capture follow (drain): longest wait for a full frame
+#define CREDIT_POLL_MS          10      // Bulk wait for credit: stop request check
+#define EVENT_FORWARD_QUEUE_DEPTH 16    // Events waiting for the forwarder task
+#define EVENT_FORWARD_STACK_SIZE  2048
+#define EVENT_FORWARD_PRIORITY    8
+#define EVENT_FORWARD_LATENCY_MS  50    // Default max_latency_ms
+#define EVENT_FORWARD_TYPES       32    // Types an event_mask can select
+#define RECORDING_BUSY_POLLS    100     // Recording dump: give up on storage busy this long
+#define LOOPBACK_POLL_MS        1       // Loopback: timeout check interval while probes are out
+#define LOOPBACK_RTT_SUB_BITS   3       // RTT histogram: 8 buckets per octave (1/8 resolution)
+#define LOOPBACK_RTT_BUCKETS    192     // Up to 2^25 us, beyond any probe timeout
+#define TIME_SYNC_DELAY_SPREAD  2       // Time sync: samples up to this times the smallest delay are used
+#define TIME_SYNC_DELAY_AGING   16      // ... which grows 1/16 per exchange, so a slower path is accepted in time
+#define TX_PACKET_POOL_BLOCKS   6       // Responses/notifications being built at once (RX, command, stream, bulk, events, forwarder)
+
+// Announced in CMD_HELLO
+#define LOCAL_FEATURES \
+    (PROTOCOL_FEATURE_COBS | PROTOCOL_FEATURE_COMPACT | PROTOCOL_FEATURE_WINDOW | \
+     PROTOCOL_FEATURE_STREAM_BATCH | PROTOCOL_FEATURE_BAUD_SWITCH | PROTOCOL_FEATURE_CREDITS | \
+     PROTOCOL_FEATURE_BULK | PROTOCOL_FEATURE_BULK_EXPORT | PROTOCOL_FEATURE_HUMIDITY | \
+     PROTOCOL_FEATURE_EVENTS | PROTOCOL_FEATURE_STATUS_VERSION | PROTOCOL_FEATURE_LINK_STATS | \
+     PROTOCOL_FEATURE_AUTO_BATCH | PROTOCOL_FEATURE_DEADLINES | LOCAL_FEATURE_DOOR | \
+     PROTOCOL_FEATURE_TIME_SYNC | PROTOCOL_FEATURE_CONFIG)
+
+// Only when the climate rings are compressed (serv_temperature_sensor.h)
+#if TEMP_SENSOR_DOOR_ENABLE
+#define LOCAL_FEATURE_DOOR  PROTOCOL_FEATURE_SWINGING_DOOR
+#else
+#define LOCAL_FEATURE_DOOR  0
+#endif
+
+// Largest bulk frames (buffer sizes); the transport's MTU can make them smaller
+#define CAPTURE_RECORDS_PER_FRAME \
+    ((PROTOCOL_BULK_MAX_PAYLOAD_SIZE - sizeof(notify_current_data_header_t)) / sizeof(current_record_t))
+
+#define CAPTURE_FRAME_OVERHEAD      8   // Link framing per packet (markers 6, COBS + CRC about 8)
+
+#define BULK_SAMPLES_PER_FRAME \
+    ((PROTOCOL_BULK_MAX_PAYLOAD_SIZE - sizeof(notify_bulk_data_header_t)) / sizeof(sensor_sample_t))
+#define BULK_MAX_CHANNELS           2   // SENSOR_TEMP_HUMIDITY
+#define EXPORT_MAX_CHANNELS         3   // Temperature, humidity, current
+#define EXPORT_READ_AHEAD           16  // Samples buffered per merged ring
+
+// Most samples a compact payload of 'space' bytes can hold (read-ahead size)
+#define COMPACT_MAX_SAMPLES(space) \
+    ((((space) - SAMPLE_CODEC_FIRST_MAX) / SAMPLE_CODEC_DELTA_MIN) + 1)
+#define RESP_COMPACT_MAX_SAMPLES \
+    COMPACT_MAX_SAMPLES(PROTOCOL_MAX_PAYLOAD_SIZE - sizeof(resp_buffer_data_header_t))
+#define RANGE_COMPACT_MAX_SAMPLES \
+    COMPACT_MAX_SAMPLES(PROTOCOL_MAX_PAYLOAD_SIZE - sizeof(resp_buffer_range_header_t))
+#define BULK_COMPACT_MAX_SAMPLES \
+    COMPACT_MAX_SAMPLES(PROTOCOL_BULK_MAX_PAYLOAD_SIZE - sizeof(notify_bulk_data_header_t))
 
 // ============================================================================
 // Internal State
 // ============================================================================
 
+typedef struct {
+    volatile bool active;
+    volatile bool stop_requested;     // Flush and deactivate on the next pass
+    sensor_type_t sensor;
+    uint32_t interval_ms;
+    uint8_t batch_size;               // Tuned from link_stats if auto_batch
+    uint16_t max_latency_ms;
+    bool auto_batch;
+    uint32_t adapt_tick;              // auto_batch: last batch size decision
+    uint32_t next_sample_tick;
+    uint32_t batch_start_tick;
+    uint32_t batch_count;
+    sensor_sample_t *batch;           // From batch_pool while samples are collected
+    current_monitor_cursor_t cursor;  // SENSOR_CURRENT: position in the capture buffer
+    uint32_t last_emit_tick;          // SENSOR_CURRENT: capture tick of last sample sent
+    bool emitted;
+} stream_session_t;
+
+// One event waiting to be forwarded (copied out of the bus callback)
+typedef struct {
+    uint8_t type;
+    uint8_t data_size;
+    uint32_t timestamp;
+    uint8_t data[PROTOCOL_EVENT_MAX_DATA];
+} forward_event_t;
+
 typedef struct {
     bool initialized;
+    const protocol_transport_t *transport;
+    uint16_t bulk_payload;            // Bulk frame payload the transport's MTU allows
     uint8_t seq_counter;              // For notifications
-
-    // Streaming state
-    bool streaming_active;
-    sensor_type_t stream_sensor;
-    uint32_t stream_interval_ms;
+    bool compact_samples;             // PROTOCOL_VERSION_COMPACT negotiated
+    uint32_t features;                // Agreed in CMD_HELLO (LOCAL_FEATURES until then)
+
+    // Command worker: the RX path validates and queues, the task handles
+    os_queue_handle_t command_queue;
+    os_semaphore_handle_t command_stop;   // Given with command_stop_requested
+    os_queue_set_handle_t command_inputs; // Both of the above
+    os_task_handle_t command_task_handle;
+    volatile bool command_task_running;
+    volatile bool command_stop_requested;
+    volatile uint32_t commands_pending;   // Queued or being handled
+
+    // Streaming state: one scheduler task serves all sessions
+    stream_session_t streams[STREAM_MAX_SESSIONS];
+    os_mutex_handle_t stream_mutex;
+    os_semaphore_handle_t stream_wake;
+    volatile bool streaming_active;   // Scheduler task running
     os_task_handle_t stream_task_handle;
     volatile bool stream_stop_requested;
-
-    // Latest temperature data (updated via event bus)
-    float last_temperature;
-    float last_humidity;
-    bool temp_data_valid;
+    uint32_t stream_missed_deadlines;  // Sample slots skipped by the scheduler
+
+    // Bulk dump state
+    volatile bool bulk_active;
+    volatile bool bulk_stop_requested;
+    os_task_handle_t bulk_task_handle;
+    cmd_bulk_dump_t bulk_request;
+    cmd_bulk_export_t export_request;
+    cmd_get_current_capture_t capture_request;
+    cmd_get_recording_t recording_request;
+    cmd_loopback_test_t loopback_request;
+    volatile bool capture_drain;      // Capture dump holds the current monitor drain
+    uint8_t bulk_seq;
+
+    // Credit flow control (CMD_GRANT_CREDITS), off until the first grant
+    volatile bool credit_mode;
+    volatile uint32_t credits;
+    volatile uint32_t credit_stalls;
+    os_semaphore_handle_t credit_wake;
+
+    // Event forwarding (CMD_SUBSCRIBE_EVENTS)
+    os_queue_handle_t forward_queue;
+    os_semaphore_handle_t forward_stop;   // Given with forward_stop_requested
+    os_queue_set_handle_t forward_inputs; // Both of the above
+    os_task_handle_t forward_task_handle;
+    volatile bool forward_task_running;
+    volatile bool forward_stop_requested;
+    volatile uint32_t forward_mask;   // Types subscribed on the bus
+    volatile uint32_t forward_dropped;
+    uint8_t forward_batch_size;
+    uint16_t forward_latency_ms;
+
+    // Last CMD_TIME_SYNC exchange, waiting for its T4 (RX task only)
+    bool time_sync_pending;
+    uint64_t time_sync_t1_us;         // Host clock
+    uint64_t time_sync_t2_mono_us;
+    uint64_t time_sync_t3_mono_us;
+    uint32_t time_sync_min_delay_us;  // Smallest recent round trip, 0 = none yet
+
+    // Cached GET_STATUS (command task only)
+    resp_get_status_t status_snapshot;
+    uint32_t status_version;          // 0 until the first snapshot
+
+    // Last windowed responses, kept for CMD_RETRANSMIT
+    protocol_packet_t history[PROTOCOL_WINDOW_SIZE];
+    bool history_valid[PROTOCOL_WINDOW_SIZE];
+    uint8_t history_next;
 } protocol_state_t;
 
+// Latest temperature reading: stored by the event handler, read by the stream task
+typedef struct {
+    float temperature;
+    float humidity;
+    bool valid;
+} climate_reading_t;
+
+// Loopback test: the bulk task sends probes, the RX path takes them back
+typedef struct {
+    uint32_t seq;
+    uint32_t sent_us;
+    bool pending;
+} loopback_slot_t;
+
+typedef struct {
+    volatile bool running;            // RX path accepts CMD_LOOPBACK_RETURN
+    uint16_t payload_size;
+    loopback_slot_t slots[LOOPBACK_MAX_WINDOW];  // Indexed by probe_seq % LOOPBACK_MAX_WINDOW
+    uint32_t outstanding;
+    uint32_t returned;
+    uint32_t lost;
+    uint32_t corrupt;
+    uint32_t rtt_min_us;
+    uint32_t rtt_max_us;
+    uint32_t rtt_hist[LOOPBACK_RTT_BUCKETS];
+} loopback_state_t;
+
 static protocol_state_t state = {0};
+static loopback_state_t loopback;
+OS_MUTEX_DEFINE(stream);
+OS_SEMAPHORE_DEFINE(stream_wake);
+OS_SEMAPHORE_DEFINE(credit_wake);
+OS_QUEUE_DEFINE(command, COMMAND_QUEUE_DEPTH, sizeof(const protocol_packet_t *));
+OS_SEMAPHORE_DEFINE(command_stop);
+OS_QUEUE_SET_DEFINE(command_inputs, COMMAND_QUEUE_DEPTH + 1);
+OS_TASK_DEFINE(command, COMMAND_TASK_STACK_SIZE);
+OS_QUEUE_DEFINE(forward, EVENT_FORWARD_QUEUE_DEPTH, sizeof(forward_event_t));
+OS_SEMAPHORE_DEFINE(forward_stop);
+OS_QUEUE_SET_DEFINE(forward_inputs, EVENT_FORWARD_QUEUE_DEPTH + 1);
+OS_TASK_DEFINE(forward, EVENT_FORWARD_STACK_SIZE);
+
+_Static_assert(DEADLINE_STREAM_0 + STREAM_MAX_SESSIONS == DEADLINE_STREAM_1 + 1,
+               "one deadline monitor slot per stream session");
+
+_Static_assert(CAPTURE_PLAN_FLASH == CURRENT_CAPTURE_MODE_FLASH &&
+               CAPTURE_FORMAT_COUNT == CURRENT_CAPTURE_FORMAT_COUNT,
+               "capture plan modes and formats go on the wire as they are");
+
+// Queued commands stay in the transport's RX frames (rx_retain()): the
+// queue, the one being handled and the one being received
+#define COMMAND_RX_FRAMES       (COMMAND_QUEUE_DEPTH + 2)
+
+// Bulk dump frame (too large for the bulk task stack)
+static protocol_bulk_packet_t bulk_frame;
+
+// Response/notification packets are built in pool blocks rather than on the
+// sender's stack; the framing layer copies them into its TX slots
+MEM_POOL_DEFINE(tx_packet, sizeof(protocol_packet_t), TX_PACKET_POOL_BLOCKS);
+
+// Stream batches, held from a batch's first sample until it is flushed
+MEM_POOL_DEFINE(batch, PROTOCOL_STREAM_MAX_BATCH * sizeof(sensor_sample_t), STREAM_MAX_SESSIONS);
+
+LAST_VALUE_DEFINE(climate, climate_reading_t);
+
+// Read-ahead for compact encoding: GET_BUFFER_DATA (command task) and bulk task
+static sensor_sample_t resp_samples[RESP_COMPACT_MAX_SAMPLES];
+static sensor_sample_t bulk_samples[BULK_COMPACT_MAX_SAMPLES];
 
 // ============================================================================
 // Forward Declarations
 // ============================================================================
 
-static void packet_rx_callback(stm32_uart_event_t *event, void *user_data);
+static void packet_rx_callback(const protocol_transport_event_t *event, void *user_data);
+static uint32_t local_features(void);
+static void set_framing(bool cobs);
+static uint32_t bulk_frame_items(size_t header_size, size_t item_size);
 static void handle_command(const protocol_packet_t *packet);
 static void handle_cmd_get_status(const protocol_packet_t *cmd);
+static void handle_cmd_get_status_if_changed(const protocol_packet_t *cmd);
+static void handle_cmd_get_link_stats(const protocol_packet_t *cmd);
 static void handle_cmd_set_rtc(const protocol_packet_t *cmd);
 static void handle_cmd_start_measurement(const protocol_packet_t *cmd);
 static void handle_cmd_stop_measurement(const protocol_packet_t *cmd);
 static void handle_cmd_get_buffer_data(const protocol_packet_t *cmd);
+static void handle_cmd_get_buffer_range(const protocol_packet_t *cmd);
+static void handle_cmd_get_history(const protocol_packet_t *cmd);
+static void handle_cmd_get_stats(const protocol_packet_t *cmd);
+static void handle_cmd_get_analysis(const protocol_packet_t *cmd);
+static void handle_cmd_get_perf(const protocol_packet_t *cmd);
+static void handle_cmd_get_probes(const protocol_packet_t *cmd);
+static void handle_cmd_get_perf(const protocol_packet_t *cmd)
+{
+    perf_snapshot_t snapshot;
+
+    if (perf_get_snapshot(&snapshot) != pdPASS) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_ERROR, NULL, 0);
+        return;
+    }
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &snapshot, PERF_SNAPSHOT_SIZE(snapshot.task_count));
+}
+
+static void handle_cmd_get_probes(const protocol_packet_t *cmd)
+{
+    uint8_t payload[sizeof(resp_probes_header_t) + CYCLE_PROBE_COUNT * sizeof(resp_probe_entry_t)];
+    resp_probes_header_t header = {
+        .cpu_freq_hz = hal_get_cpu_freq_hz(),
+        .probe_count = 0,
+    };
+    size_t len = sizeof(header);
+    cycle_probe_stats_t stats;
+
+    for (uint32_t id = 0; id < CYCLE_PROBE_COUNT; id++) {
+        if (!cycle_probe_get((cycle_probe_id_t)id, &stats)) {
+            protocol_handler_send_response(
+                cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+            return;
+        }
+        if (stats.count == 0) {
+            continue;
+        }
+
+        resp_probe_entry_t entry = {
+            .probe_id = (uint8_t)id,
+            .count = stats.count,
+            .min_cycles = stats.min_cycles,
+            .avg_cycles = (uint32_t)(stats.total_cycles / stats.count),
+            .max_cycles = stats.max_cycles,
+        };
+        memcpy(&payload[len], &entry, sizeof(entry));
+        len += sizeof(entry);
+        header.probe_count++;
+    }
+    memcpy(payload, &header, sizeof(header));
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, payload, len);
+}
+
+static void handle_cmd_get_deadlines(const protocol_packet_t *cmd)
+{
+    uint8_t payload[PROTOCOL_MAX_PAYLOAD_SIZE];
+    cmd_get_deadlines_t req = { .first_deadline_id = 0 };
+    resp_deadlines_header_t header = { .entry_count = 0, .next_deadline_id = 0 };
+    size_t len = sizeof(header);
+    deadline_stats_t stats;
+
+    if (cmd->length >= sizeof(req)) {
+        memcpy(&req, cmd->payload, sizeof(req));
+    }
+
+    for (uint32_t id = req.first_deadline_id; id < DEADLINE_COUNT; id++) {
+        if (!deadline_monitor_get((deadline_id_t)id, &stats)) {
+            protocol_handler_send_response(
+                cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+            return;
+        }
+        if (stats.period_us == 0) {
+            continue;
+        }
+        if (len + sizeof(resp_deadline_entry_t) > sizeof(payload)) {
+            header.next_deadline_id = (uint8_t)id;  // Ask again from here
+            break;
+        }
+
+        resp_deadline_entry_t entry = {
+            .deadline_id = (uint8_t)id,
+            .period_us = stats.period_us,
+            .budget_us = stats.budget_us,
+            .jobs = stats.jobs,
+            .misses = stats.misses,
+            .overruns = stats.overruns,
+            .lateness_p99_us = deadline_monitor_percentile_us(stats.lateness_hist, 990),
+            .lateness_max_us = stats.lateness_max_us,
+            .exec_avg_us = (stats.jobs > 0) ? (uint32_t)(stats.exec_total_us / stats.jobs) : 0U,
+            .exec_p99_us = deadline_monitor_percentile_us(stats.exec_hist, 990),
+            .exec_max_us = stats.exec_max_us,
+        };
+        memcpy(&payload[len], &entry, sizeof(entry));
+        len += sizeof(entry);
+        header.entry_count++;
+    }
+    memcpy(payload, &header, sizeof(header));
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, payload, len);
+}
+
+static void handle_cmd_get_config(const protocol_packet_t *cmd)
+{
+    uint8_t payload[PROTOCOL_MAX_PAYLOAD_SIZE];
+    cmd_get_config_t req = { .first_key = 0 };
+    config_stats_t stats;
+    config_info_t info;
+
+    if (cmd->length >= sizeof(req)) {
+        memcpy(&req, cmd->payload, sizeof(req));
+    }
+
+    config_get_stats(&stats);
+    resp_config_header_t header = {
+        .state = (uint8_t)((stats.unsaved ? CONFIG_STATE_UNSAVED : 0) |
+                           (stats.save_failed ? CONFIG_STATE_SAVE_FAILED : 0)),
+        .saves = stats.saves,
+    };
+    size_t len = sizeof(header);
+
+    for (uint32_t key = req.first_key; key < CONFIG_KEY_COUNT; key++) {
+        if (len + sizeof(resp_config_entry_t) > sizeof(payload)) {
+            header.next_key = (uint8_t)key;  // Ask again from here
+            break;
+        }
+        config_get_info((config_key_t)key, &info);
+
+        resp_config_entry_t entry = {
+            .key = (uint8_t)key,
+            .type = info.type,
+            .flags = info.flags,
+            .value = config_get((config_key_t)key),
+            .min_value = info.min_value,
+            .max_value = info.max_value,
+            .default_value = info.default_value,
+        };
+        memcpy(&payload[len], &entry, sizeof(entry));
+        len += sizeof(entry);
+        header.entry_count++;
+    }
+    memcpy(payload, &header, sizeof(header));
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, payload, len);
+}
+
+static void handle_cmd_set_config(const protocol_packet_t *cmd)
+{
+    cmd_set_config_header_t header;
+    resp_set_config_t resp = { .applied = 0, .bad_key = 0xFF, .flags = 0 };
+    config_info_t info;
+
+    memcpy(&header, cmd->payload, sizeof(header));
+    const config_value_t *values = (const config_value_t *)(cmd->payload + sizeof(header));
+    if (cmd->length < sizeof(header) + (size_t)header.count * sizeof(config_value_t)) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
+        return;
+    }
+
+    // All or nothing: check every value before changing any
+    for (uint32_t i = 0; i < header.count; i++) {
+        if (!config_check((config_key_t)values[i].key, values[i].value)) {
+            resp.bad_key = values[i].key;
+            protocol_handler_send_response(
+                cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, &resp, sizeof(resp));
+            return;
+        }
+    }
+
+    if (header.flags & CONFIG_SET_DEFAULTS) {
+        config_reset_defaults();
+    }
+    for (uint32_t i = 0; i < header.count; i++) {
+        config_key_t key = (config_key_t)values[i].key;
+        if (config_get(key) != values[i].value && config_get_info(key, &info)) {
+            resp.flags |= info.flags & CONFIG_FLAG_BOOT;
+        }
+        config_set(key, values[i].value);
+        resp.applied++;
+    }
+    if (header.flags & CONFIG_SET_SAVE) {
+        config_save();
+    }
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &resp, sizeof(resp));
+}
+
 static void handle_cmd_clear_buffer(const protocol_packet_t *cmd);
+static void handle_cmd_negotiate_version(const protocol_packet_t *cmd);
+static void handle_cmd_retransmit(const protocol_packet_t *cmd);
+static void handle_cmd_bulk_dump(const protocol_packet_t *cmd);
+static void handle_cmd_bulk_export(const protocol_packet_t *cmd);
+static void handle_cmd_grant_credits(const protocol_packet_t *cmd);
+static void handle_cmd_hello(const protocol_packet_t *cmd);
+static void handle_cmd_subscribe_events(const protocol_packet_t *cmd);
+static void handle_cmd_get_current_capture(const protocol_packet_t *cmd);
+static void handle_cmd_get_recording(const protocol_packet_t *cmd);
+static void handle_cmd_echo(const protocol_packet_t *cmd);
+static void handle_cmd_loopback_test(const protocol_packet_t *cmd);
+static void handle_cmd_loopback_return(const protocol_packet_t *cmd);
+static void handle_cmd_set_baud_rate(const protocol_packet_t *cmd);
+static void handle_cmd_get_command_stats(const protocol_packet_t *cmd);
+static void handle_cmd_time_sync(const protocol_packet_t *cmd);
+
+/**
+ * @brief Command table: handler and shortest accepted payload, by cmd_id
+ *
+ * Payloads below min_length are answered with RESP_INVALID_PARAM before the
+ * handler runs, so handlers can cast their request struct directly.
+ *
+ * Handlers run in the command task, one at a time in arrival order. The few
+ * marked rx_context run in the RX task as soon as they are parsed, ahead of
+ * queued commands: loopback returns (the RTT must not include queueing) and
+ * the wire mode and baud changes, which reset the framing RX state.
+ */
+typedef struct {
+    protocol_cmd_handler_t handler;
+    uint16_t min_length;
+    bool rx_context;
+} command_entry_t;
+
+static command_entry_t commands[PROTOCOL_CMD_TABLE_SIZE] = {
+    [CMD_GET_BUFFER_DATA]     = { handle_cmd_get_buffer_data,     sizeof(cmd_get_buffer_data_t) },
+    [CMD_START_MEASUREMENT]   = { handle_cmd_start_measurement,   CMD_START_STREAM_MIN_SIZE },
+    [CMD_STOP_MEASUREMENT]    = { handle_cmd_stop_measurement,    0 },
+    [CMD_SET_RTC]             = { handle_cmd_set_rtc,             sizeof(cmd_set_rtc_t) },
+    [CMD_GET_STATUS]          = { handle_cmd_get_status,          0 },
+    [CMD_CLEAR_BUFFER]        = { handle_cmd_clear_buffer,        0 },
+    [CMD_GET_CONFIG]          = { handle_cmd_get_config,          0 },
+    [CMD_SET_CONFIG]          = { handle_cmd_set_config,          sizeof(cmd_set_config_header_t) },
+    [CMD_NEGOTIATE_VERSION]   = { handle_cmd_negotiate_version,   sizeof(cmd_negotiate_version_t), true },
+    [CMD_RETRANSMIT]          = { handle_cmd_retransmit,          sizeof(cmd_retransmit_t) },
+    [CMD_BULK_DUMP]           = { handle_cmd_bulk_dump,           sizeof(cmd_bulk_dump_t) },
+    [CMD_GET_CURRENT_CAPTURE] = { handle_cmd_get_current_capture, sizeof(cmd_get_current_capture_t) },
+    [CMD_GET_BUFFER_RANGE]    = { handle_cmd_get_buffer_range,    sizeof(cmd_get_buffer_range_t) },
+    [CMD_GET_HISTORY]         = { handle_cmd_get_history,         sizeof(cmd_get_history_t) },
+    [CMD_GET_RECORDING]       = { handle_cmd_get_recording,       sizeof(cmd_get_recording_t) },
+    [CMD_GET_STATS]           = { handle_cmd_get_stats,           sizeof(cmd_get_stats_t) },
+    [CMD_GET_ANALYSIS]        = { handle_cmd_get_analysis,        0 },
+    [CMD_GET_PERF]            = { handle_cmd_get_perf,            0 },
+    [CMD_GET_PROBES]          = { handle_cmd_get_probes,          0 },
+    [CMD_ECHO]                = { handle_cmd_echo,                0 },
+    [CMD_LOOPBACK_TEST]       = { handle_cmd_loopback_test,       sizeof(cmd_loopback_test_t) },
+    [CMD_LOOPBACK_RETURN]     = { handle_cmd_loopback_return,     0, true },   // Never answered
+    [CMD_SET_BAUD_RATE]       = { handle_cmd_set_baud_rate,       sizeof(cmd_set_baud_rate_t), true },
+    [CMD_GET_COMMAND_STATS]   = { handle_cmd_get_command_stats,   0 },
+    [CMD_BULK_EXPORT]         = { handle_cmd_bulk_export,         sizeof(cmd_bulk_export_t) },
+    [CMD_GRANT_CREDITS]       = { handle_cmd_grant_credits,       sizeof(cmd_grant_credits_t), true },
+    [CMD_HELLO]               = { handle_cmd_hello,               sizeof(cmd_hello_t), true },
+    [CMD_SUBSCRIBE_EVENTS]    = { handle_cmd_subscribe_events,    sizeof(cmd_subscribe_events_t) },
+    [CMD_GET_STATUS_IF_CHANGED] = { handle_cmd_get_status_if_changed, sizeof(cmd_get_status_if_changed_t) },
+    [CMD_GET_LINK_STATS]      = { handle_cmd_get_link_stats,      0 },
+    [CMD_GET_DEADLINES]       = { handle_cmd_get_deadlines,       0 },
+    [CMD_TIME_SYNC]           = { handle_cmd_time_sync,           sizeof(cmd_time_sync_t), true },
+};
+
+static protocol_cmd_stats_t command_stats[PROTOCOL_CMD_TABLE_SIZE];
+static uint32_t unknown_commands;
+static bool command_task_start(void);
+static void command_task_stop(void);
+static void command_queue_delete(void);
+static void command_task(void *param);
+static bool bulk_start(os_task_func_t task_func);
+static void bulk_task(void *param);
+static void export_task(void *param);
+static void capture_task(void *param);
+static void recording_task(void *param);
+static void loopback_task(void *param);
+static void bulk_stop(void);
+static void bulk_send_done(uint8_t status, uint32_t sample_count);
+static proto_handler_status_t send_packet(const protocol_packet_t *packet);
+static void history_store(const protocol_packet_t *resp);
+static proto_handler_status_t send_response_flags(
+    uint8_t cmd_id, uint8_t seq, response_status_t status, uint8_t type_flags,
+    const void *payload, uint16_t payload_len);
+static proto_handler_status_t send_notification_flags(
+    uint8_t cmd_id, uint8_t type_flags, const void *payload, uint16_t payload_len);
+static bool stream_flush_batch(stream_session_t *session);
+static void stream_drop_batch(stream_session_t *session);
+static uint32_t stream_service(stream_session_t *session, uint32_t now);
+static deadline_id_t stream_deadline_id(const stream_session_t *session);
 static void stream_task(void *param);
 static void temperature_event_handler(event_t *event);
+static void forward_task_stop(void);
 
 // ============================================================================
 // Public API
 // ============================================================================
 
-proto_handler_status_t protocol_handler_init(void)
+proto_handler_status_t protocol_handler_init(const protocol_transport_t *transport)
 {
     if (state.initialized) {
         return PROTO_HANDLER_ERR_ALREADY_INIT;
     }
 
-    // Initialize packet framing layer
-    stm32_uart_config_t uart_config = stm32_uart_get_default_config();
-    uart_config.callback = packet_rx_callback;
-    uart_config.user_data = NULL;
+    if (transport == NULL || transport->mtu < PROTOCOL_HEADER_SIZE + PROTOCOL_MAX_PAYLOAD_SIZE ||
+        transport->rx_frames < COMMAND_RX_FRAMES) {
+        return PROTO_HANDLER_ERR_INVALID_PARAM;
+    }
+    state.transport = transport;
+    state.bulk_payload = (transport->mtu - PROTOCOL_HEADER_SIZE < PROTOCOL_BULK_MAX_PAYLOAD_SIZE)
+                         ? (uint16_t)(transport->mtu - PROTOCOL_HEADER_SIZE)
+                         : PROTOCOL_BULK_MAX_PAYLOAD_SIZE;
+
+    // The queue has to exist before the first packet can arrive
+    if (!command_task_start()) {
+        return PROTO_HANDLER_ERR_NOT_INIT;
+    }
+
+    protocol_transport_status_t open_status = transport->open(packet_rx_callback, NULL);
+    if (open_status != PROTOCOL_TRANSPORT_OK) {
+        LOG_E(TAG, "Failed to open %s transport: %d", transport->name, open_status);
+        command_task_stop();
+        command_queue_delete();
+        return PROTO_HANDLER_ERR_NOT_INIT;
+    }
 
-    uart_driver_status_t uart_status = stm32_uart_init(&uart_config);
-    if (uart_status != UART_DRV_OK) {
-        LOG_E(TAG, "Failed to init packet framing: %d", uart_status);
+    state.stream_mutex = OS_MUTEX_CREATE_STATIC(stream);
+    state.stream_wake = OS_SEMAPHORE_CREATE_BINARY_STATIC(stream_wake);
+    state.credit_wake = OS_SEMAPHORE_CREATE_BINARY_STATIC(credit_wake);
+    if (state.stream_mutex == NULL || state.stream_wake == NULL || state.credit_wake == NULL) {
+        LOG_E(TAG, "Failed to create stream sync objects");
+        transport->close();
+        command_task_stop();
+        command_queue_delete();
         return PROTO_HANDLER_ERR_NOT_INIT;
     }
 
@@ -86,10 +632,33 @@ proto_handler_status_t protocol_handler_init(void)
     event_bus_subscribe(EVENT_TEMPERATURE_UPDATED, temperature_event_handler);
 
     state.seq_counter = 0;
+    state.compact_samples = false;
+    state.features = local_features();
     state.streaming_active = false;
     state.stream_task_handle = NULL;
     state.stream_stop_requested = false;
-    state.temp_data_valid = false;
+    memset(state.streams, 0, sizeof(state.streams));
+    state.stream_missed_deadlines = 0;
+    state.status_version = 0;
+    state.bulk_active = false;
+    state.bulk_task_handle = NULL;
+    state.capture_drain = false;
+    state.credit_mode = false;
+    state.credits = 0;
+    state.credit_stalls = 0;
+    state.forward_mask = 0;
+    state.forward_dropped = 0;
+    memset(state.history_valid, 0, sizeof(state.history_valid));
+    state.history_next = 0;
+
+    // Configured link rate, supervised: without a valid frame in time the
+    // link returns to the default, so a wrong value cannot lock the host out
+    uint32_t baud_rate = config_get(CONFIG_KEY_LINK_BAUD);
+    if ((transport->caps & PROTOCOL_TRANSPORT_CAP_RATE) != 0 && baud_rate != transport->get_rate() &&
+        transport->rate_supported(baud_rate) &&
+        transport->set_rate(baud_rate, CONFIG_BAUD_BOOT_PROBATION_MS) != PROTOCOL_TRANSPORT_OK) {
+        LOG_W(TAG, "Configured baud rate %lu not applied", (unsigned long)baud_rate);
+    }
 
     state.initialized = true;
     LOG_I(TAG, "Protocol handler initialized");
@@ -103,14 +672,26 @@ proto_handler_status_t protocol_handler_deinit(void)
         return PROTO_HANDLER_ERR_NOT_INIT;
     }
 
-    // Stop streaming if active
+    // Stop the worker first, so that no handler starts a stream or dump
+    // behind the stops below; commands still queued are dropped
+    command_task_stop();
+
+    // Stop streaming, event forwarding and bulk dump if active
     protocol_handler_stop_stream();
+    forward_task_stop();
+    bulk_stop();
 
     // Unsubscribe from events
     event_bus_unsubscribe(EVENT_TEMPERATURE_UPDATED, temperature_event_handler);
 
-    // Deinit packet framing
-    stm32_uart_deinit();
+    os_semaphore_delete(state.stream_wake);
+    os_mutex_delete(state.stream_mutex);
+    state.stream_wake = NULL;
+    state.stream_mutex = NULL;
+
+    // Close the link
+    state.transport->close();
+    command_queue_delete();
 
     state.initialized = false;
     LOG_I(TAG, "Protocol handler deinitialized");
@@ -129,35 +710,108 @@ proto_handler_status_t protocol_handler_send_response(
     response_status_t status,
     const void *payload,
     uint16_t payload_len)
+{
+    return send_response_flags(cmd_id, seq, status, 0, payload, payload_len);
+}
+
+static proto_handler_status_t send_response_flags(
+    uint8_t cmd_id, uint8_t seq, response_status_t status, uint8_t type_flags,
+    const void *payload, uint16_t payload_len)
 {
     if (!state.initialized) {
         return PROTO_HANDLER_ERR_NOT_INIT;
     }
 
-    protocol_packet_t resp = {0};
-    resp.type = PACKET_TYPE_RESP;
-    resp.cmd_id = cmd_id;
-    resp.seq = seq;
-    resp.status = status;
-    resp.length = payload_len;
+    if (payload_len > PROTOCOL_MAX_PAYLOAD_SIZE) {
+        return PROTO_HANDLER_ERR_INVALID_PARAM;
+    }
 
-    if (payload != NULL && payload_len > 0) {
-        if (payload_len > PROTOCOL_MAX_PAYLOAD_SIZE) {
-            return PROTO_HANDLER_ERR_INVALID_PARAM;
-        }
-        memcpy(resp.payload, payload, payload_len);
+    protocol_packet_t *resp = mem_pool_alloc(&tx_packet_pool);
+    if (resp == NULL) {
+        LOG_W(TAG, "No TX packet for response 0x%02X", cmd_id);
+        return PROTO_HANDLER_ERR_TX_FAILED;
     }
 
-    size_t total_len = PROTOCOL_HEADER_SIZE + payload_len;
-    uart_driver_status_t tx_status = stm32_uart_send_packet_async(
-        (const uint8_t *)&resp, total_len);
+    resp->type = PACKET_TYPE_RESP | type_flags;
+    resp->cmd_id = cmd_id;
+    resp->seq = seq;
+    resp->status = status;
+    resp->length = payload_len;
+
+    if (payload != NULL) {
+        memcpy(resp->payload, payload, payload_len);
+    } else {
+        memset(resp->payload, 0, payload_len);
+    }
+
+    history_store(resp);
+
+    proto_handler_status_t ret = send_packet(resp);
+    mem_pool_free(&tx_packet_pool, resp);
+    return ret;
+}
+
+/**
+ * @brief Keep a windowed response so a corrupted one can be resent by seq
+ */
+static void history_store(const protocol_packet_t *resp)
+{
+    if (resp->cmd_id == CMD_GET_BUFFER_DATA) {
+        memcpy(&state.history[state.history_next], resp, PROTOCOL_HEADER_SIZE + resp->length);
+        state.history_valid[state.history_next] = true;
+        state.history_next = (state.history_next + 1) % PROTOCOL_WINDOW_SIZE;
+    }
+}
+
+/**
+ * @brief Start a response directly in the framing TX slot
+ *
+ * The caller fills resp->payload (and status, RESP_OK by default) and sends
+ * with response_commit(). In between it holds the transport's TX slot (see
+ * tx_reserve()): keep it short and send nothing else.
+ *
+ * @return Packet with the header filled in, NULL if no TX slot came free
+ */
+static protocol_packet_t *response_reserve(const protocol_packet_t *cmd, uint8_t type_flags)
+{
+    if (!state.initialized) {
+        return NULL;
+    }
+
+    size_t capacity = 0;
+    protocol_packet_t *resp = (protocol_packet_t *)state.transport->tx_reserve(&capacity);
+    if (resp == NULL) {
+        LOG_W(TAG, "No TX slot for response 0x%02X", cmd->cmd_id);
+        return NULL;
+    }
+    if (capacity < sizeof(protocol_packet_t)) {
+        state.transport->tx_abort();
+        return NULL;
+    }
+
+    resp->type = PACKET_TYPE_RESP | type_flags;
+    resp->cmd_id = cmd->cmd_id;
+    resp->seq = cmd->seq;
+    resp->status = RESP_OK;
+    resp->length = 0;
+    return resp;
+}
+
+static proto_handler_status_t response_commit(protocol_packet_t *resp, uint16_t payload_len)
+{
+    if (payload_len > PROTOCOL_MAX_PAYLOAD_SIZE) {
+        state.transport->tx_abort();
+        return PROTO_HANDLER_ERR_INVALID_PARAM;
+    }
+
+    resp->length = payload_len;
+    history_store(resp);   // Before the commit: COBS framing encodes the slot in place
 
-    if (tx_status != UART_DRV_OK) {
+    protocol_transport_status_t tx_status = state.transport->tx_commit(PROTOCOL_HEADER_SIZE + payload_len);
+    if (tx_status != PROTOCOL_TRANSPORT_OK) {
         LOG_E(TAG, "Failed to send response: %d", tx_status);
         return PROTO_HANDLER_ERR_TX_FAILED;
     }
-
-    LOG_D(TAG, "Response sent: cmd=0x%02X seq=%d status=%d", cmd_id, seq, status);
     return PROTO_HANDLER_OK;
 }
 
@@ -165,30 +819,46 @@ proto_handler_status_t protocol_handler_send_notification(
     uint8_t cmd_id,
     const void *payload,
     uint16_t payload_len)
+{
+    return send_notification_flags(cmd_id, 0, payload, payload_len);
+}
+
+static proto_handler_status_t send_notification_flags(
+    uint8_t cmd_id, uint8_t type_flags, const void *payload, uint16_t payload_len)
 {
     if (!state.initialized) {
         return PROTO_HANDLER_ERR_NOT_INIT;
     }
 
-    protocol_packet_t notify = {0};
-    notify.type = PACKET_TYPE_NOTIFY;
-    notify.cmd_id = cmd_id;
-    notify.seq = state.seq_counter++;
-    notify.status = RESP_OK;
-    notify.length = payload_len;
+    if (payload_len > PROTOCOL_MAX_PAYLOAD_SIZE) {
+        return PROTO_HANDLER_ERR_INVALID_PARAM;
+    }
+
+    protocol_packet_t *notify = mem_pool_alloc(&tx_packet_pool);
+    if (notify == NULL) {
+        LOG_W(TAG, "No TX packet for notification 0x%02X", cmd_id);
+        return PROTO_HANDLER_ERR_TX_FAILED;
+    }
 
-    if (payload != NULL && payload_len > 0) {
-        if (payload_len > PROTOCOL_MAX_PAYLOAD_SIZE) {
-            return PROTO_HANDLER_ERR_INVALID_PARAM;
-        }
-        memcpy(notify.payload, payload, payload_len);
+    notify->type = PACKET_TYPE_NOTIFY | type_flags;
+    notify->cmd_id = cmd_id;
+    notify->seq = state.seq_counter++;
+    notify->status = RESP_OK;
+    notify->length = payload_len;
+
+    if (payload != NULL) {
+        memcpy(notify->payload, payload, payload_len);
+    } else {
+        memset(notify->payload, 0, payload_len);
     }
 
     size_t total_len = PROTOCOL_HEADER_SIZE + payload_len;
-    uart_driver_status_t tx_status = stm32_uart_send_packet_async(
-        (const uint8_t *)&notify, total_len);
+    SYSVIEW_TRACE_U32x2(SYSVIEW_EVT_PROTO_NOTIFY, cmd_id, payload_len);
+    protocol_transport_status_t tx_status = state.transport->send(
+        (const uint8_t *)notify, total_len);
+    mem_pool_free(&tx_packet_pool, notify);
 
-    if (tx_status != UART_DRV_OK) {
+    if (tx_status != PROTOCOL_TRANSPORT_OK) {
         LOG_W(TAG, "Failed to send notification: %d", tx_status);
         return PROTO_HANDLER_ERR_TX_FAILED;
     }
@@ -211,37 +881,131 @@ proto_handler_status_t protocol_handler_send_sensor_sample(
 
 proto_handler_status_t protocol_handler_start_stream(
     sensor_type_t sensor_type,
-    uint32_t interval_ms)
+    uint32_t interval_ms,
+    uint8_t batch_size,
+    uint16_t max_latency_ms)
 {
     if (!state.initialized) {
         return PROTO_HANDLER_ERR_NOT_INIT;
     }
 
-    // Stop existing stream if any
-    if (state.streaming_active) {
-        protocol_handler_stop_stream();
+    if (interval_ms == 0) {
+        return PROTO_HANDLER_ERR_INVALID_PARAM;
     }
 
-    state.stream_sensor = sensor_type;
-    state.stream_interval_ms = interval_ms;
-    state.stream_stop_requested = false;
+    os_mutex_take(state.stream_mutex, OS_WAIT_FOREVER);
 
-    // Create streaming task
-    os_result_t ret = os_task_create(
-        stream_task,
-        "proto_stream",
-        STREAM_TASK_STACK_SIZE,
-        NULL,
-        STREAM_TASK_PRIORITY,
-        &state.stream_task_handle);
+    // Restart the sensor's session if it has one, else take a free slot
+    stream_session_t *session = NULL;
+    for (int i = 0; i < STREAM_MAX_SESSIONS; i++) {
+        if (state.streams[i].active && state.streams[i].sensor == sensor_type) {
+            session = &state.streams[i];
+            break;
+        }
+        if (!state.streams[i].active && session == NULL) {
+            session = &state.streams[i];
+        }
+    }
 
-    if (ret != OS_SUCCESS) {
-        LOG_E(TAG, "Failed to create stream task");
-        return PROTO_HANDLER_ERR_NOT_INIT;
+    if (session == NULL) {
+        os_mutex_give(state.stream_mutex);
+        LOG_W(TAG, "No free stream session for sensor %d", sensor_type);
+        return PROTO_HANDLER_ERR_INVALID_PARAM;
+    }
+
+    // Samples collected under the old settings go out first
+    if (session->active && session->batch_count > 0) {
+        stream_flush_batch(session);
+    }
+    stream_drop_batch(session);  // Left over by a session that was cut off
+
+    session->sensor = sensor_type;
+    session->interval_ms = interval_ms;
+    session->auto_batch = (batch_size == PROTOCOL_STREAM_BATCH_AUTO);
+    if (session->auto_batch) {
+        batch_size = 1;
+        if (max_latency_ms == 0) {
+            max_latency_ms = STREAM_AUTO_LATENCY_MS;
+        }
+    }
+    session->batch_size = (batch_size == 0) ? 1 :
+                          (batch_size > PROTOCOL_STREAM_MAX_BATCH) ? PROTOCOL_STREAM_MAX_BATCH :
+                          batch_size;
+    session->max_latency_ms = max_latency_ms;
+    session->next_sample_tick = os_get_tick_count();
+    session->adapt_tick = session->next_sample_tick;
+    session->batch_count = 0;
+    current_monitor_cursor_init(&session->cursor);
+    session->emitted = false;
+    session->stop_requested = false;
+    session->active = true;
+
+    // One sample slot per interval, due to finish in half of it
+    if (interval_ms <= UINT32_MAX / 1000U) {
+        deadline_monitor_register(stream_deadline_id(session), interval_ms * 1000U,
+                                  interval_ms * (1000U / 2U));
+    }
+
+    os_mutex_give(state.stream_mutex);
+
+    // Scheduler task is shared and started with the first session
+    if (!state.streaming_active) {
+        state.stream_stop_requested = false;
+
+        os_result_t ret = os_task_create(
+            stream_task,
+            "proto_stream",
+            STREAM_TASK_STACK_SIZE,
+            NULL,
+            STREAM_TASK_PRIORITY,
+            &state.stream_task_handle);
+
+        if (ret != OS_SUCCESS) {
+            LOG_E(TAG, "Failed to create stream task");
+            session->active = false;
+            return PROTO_HANDLER_ERR_NOT_INIT;
+        }
+
+        state.streaming_active = true;
+    }
+
+    os_semaphore_give(state.stream_wake);
+
+    LOG_I(TAG, "Started streaming sensor %d @ %lu ms (batch %s%d, latency %d ms)",
+          sensor_type, interval_ms, session->auto_batch ? "auto, now " : "",
+          session->batch_size, max_latency_ms);
+
+    return PROTO_HANDLER_OK;
+}
+
+proto_handler_status_t protocol_handler_stop_sensor_stream(sensor_type_t sensor_type)
+{
+    if (!state.streaming_active) {
+        return PROTO_HANDLER_OK;
+    }
+
+    stream_session_t *session = NULL;
+    for (int i = 0; i < STREAM_MAX_SESSIONS; i++) {
+        if (state.streams[i].active && state.streams[i].sensor == sensor_type) {
+            session = &state.streams[i];
+            break;
+        }
+    }
+
+    if (session == NULL) {
+        return PROTO_HANDLER_OK;
+    }
+
+    // The scheduler flushes the partial batch and deactivates the session
+    session->stop_requested = true;
+    os_semaphore_give(state.stream_wake);
+
+    for (int i = 0; i < STREAM_STOP_TIMEOUT_MS / 10 && session->active; i++) {
+        os_delay_ms(10);
     }
+    session->active = false;
 
-    state.streaming_active = true;
-    LOG_I(TAG, "Started streaming sensor %d @ %lu ms", sensor_type, interval_ms);
+    LOG_I(TAG, "Stopped streaming sensor %d", sensor_type);
 
     return PROTO_HANDLER_OK;
 }
@@ -253,9 +1017,10 @@ proto_handler_status_t protocol_handler_stop_stream(void)
     }
 
     state.stream_stop_requested = true;
+    os_semaphore_give(state.stream_wake);
 
     // Wait for task to finish (with timeout)
-    for (int i = 0; i < 100 && state.streaming_active; i++) {
+    for (int i = 0; i < STREAM_STOP_TIMEOUT_MS / 10 && state.streaming_active; i++) {
         os_delay_ms(10);
     }
 
@@ -266,6 +1031,11 @@ proto_handler_status_t protocol_handler_stop_stream(void)
     state.stream_task_handle = NULL;
     state.streaming_active = false;
 
+    for (int i = 0; i < STREAM_MAX_SESSIONS; i++) {
+        state.streams[i].active = false;
+        stream_drop_batch(&state.streams[i]);
+    }
+
     LOG_I(TAG, "Stopped streaming");
 
     return PROTO_HANDLER_OK;
@@ -273,108 +1043,451 @@ proto_handler_status_t protocol_handler_stop_stream(void)
 
 bool protocol_handler_is_streaming(void)
 {
-    return state.streaming_active;
+    for (int i = 0; i < STREAM_MAX_SESSIONS; i++) {
+        if (state.streams[i].active) {
+            return true;
+        }
+    }
+    return false;
 }
 
-// ============================================================================
-// Internal Functions
-// ============================================================================
-
-static void packet_rx_callback(stm32_uart_event_t *event, void *user_data)
+proto_handler_status_t protocol_handler_register_command(
+    uint8_t cmd_id,
+    protocol_cmd_handler_t handler,
+    uint16_t min_length)
 {
-    (void)user_data;
-
-    if (event->type != STM32_UART_EVENT_PACKET_RECEIVED) {
-        return;
-    }
-
-    if (event->data == NULL || event->length < PROTOCOL_HEADER_SIZE) {
-        LOG_W(TAG, "Invalid packet: len=%u", event->length);
-        return;
+    if (cmd_id >= PROTOCOL_CMD_TABLE_SIZE || min_length > PROTOCOL_MAX_PAYLOAD_SIZE) {
+        return PROTO_HANDLER_ERR_INVALID_PARAM;
     }
 
-    const protocol_packet_t *packet = (const protocol_packet_t *)event->data;
+    // The RX or command task may be dispatching: never let it see a half-written entry
+    uint32_t mask = os_critical_enter();
+    commands[cmd_id].handler = handler;
+    commands[cmd_id].min_length = min_length;
+    commands[cmd_id].rx_context = false;
+    memset(&command_stats[cmd_id], 0, sizeof(command_stats[cmd_id]));
+    os_critical_exit(mask);
 
-    // Verify packet type
-    if (packet->type != PACKET_TYPE_CMD) {
-        LOG_W(TAG, "Unexpected packet type: 0x%02X", packet->type);
-        return;
-    }
+    return PROTO_HANDLER_OK;
+}
 
-    // Verify length
-    if (packet->length > event->length - PROTOCOL_HEADER_SIZE) {
-        LOG_W(TAG, "Payload length mismatch");
-        return;
+bool protocol_handler_get_command_stats(uint8_t cmd_id, protocol_cmd_stats_t *stats)
+{
+    if (cmd_id >= PROTOCOL_CMD_TABLE_SIZE || stats == NULL || commands[cmd_id].handler == NULL) {
+        return false;
     }
 
-    handle_command(packet);
+    uint32_t mask = os_critical_enter();
+    *stats = command_stats[cmd_id];
+    os_critical_exit(mask);
+    return true;
 }
 
-static void handle_command(const protocol_packet_t *packet)
+void protocol_handler_reset_command_stats(void)
 {
-    LOG_D(TAG, "CMD: id=0x%02X seq=%d len=%d", packet->cmd_id, packet->seq, packet->length);
-
-    switch (packet->cmd_id) {
-        case CMD_GET_STATUS:
-            handle_cmd_get_status(packet);
-            break;
+    uint32_t mask = os_critical_enter();
+    memset(command_stats, 0, sizeof(command_stats));
+    unknown_commands = 0;
+    os_critical_exit(mask);
+}
 
-        case CMD_SET_RTC:
-            handle_cmd_set_rtc(packet);
-            break;
+bool protocol_handler_wait_commands(uint32_t timeout_ms)
+{
+    uint32_t start = os_get_tick_count();
 
-        case CMD_START_MEASUREMENT:
-            handle_cmd_start_measurement(packet);
-            break;
+    while (state.commands_pending > 0) {
+        if (os_get_tick_count() - start >= timeout_ms) {
+            return false;
+        }
+        os_delay_ms(1);
+    }
+    return true;
+}
 
-        case CMD_STOP_MEASUREMENT:
-            handle_cmd_stop_measurement(packet);
-            break;
+// ============================================================================
+// Command Worker
+// ============================================================================
 
-        case CMD_GET_BUFFER_DATA:
-            handle_cmd_get_buffer_data(packet);
-            break;
+static bool command_task_start(void)
+{
+    state.command_queue = OS_QUEUE_CREATE_STATIC(command);
+    state.command_stop = OS_SEMAPHORE_CREATE_BINARY_STATIC(command_stop);
+    state.command_inputs = OS_QUEUE_SET_CREATE_STATIC(command_inputs);
+    if (state.command_queue == NULL || state.command_stop == NULL || state.command_inputs == NULL ||
+        os_queue_set_add(state.command_inputs, state.command_queue) != OS_SUCCESS ||
+        os_queue_set_add(state.command_inputs, state.command_stop) != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create command queue");
+        command_queue_delete();
+        return false;
+    }
 
-        case CMD_CLEAR_BUFFER:
-            handle_cmd_clear_buffer(packet);
-            break;
+    state.commands_pending = 0;
+    state.command_stop_requested = false;
+    state.command_task_running = true;
 
-        default:
-            LOG_W(TAG, "Unknown command: 0x%02X", packet->cmd_id);
-            protocol_handler_send_response(
-                packet->cmd_id, packet->seq, RESP_INVALID_CMD, NULL, 0);
-            break;
+    os_result_t ret = OS_TASK_CREATE_STATIC(command, command_task, "proto_cmd", NULL,
+                                            COMMAND_TASK_PRIORITY, &state.command_task_handle);
+    if (ret != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create command task");
+        state.command_task_running = false;
+        command_queue_delete();
+        return false;
     }
+
+    return true;
 }
 
-static void handle_cmd_get_status(const protocol_packet_t *cmd)
+/**
+ * @brief End the command task after the command it is handling
+ *
+ * The queue stays: the RX path may still post to it until framing is down.
+ */
+static void command_task_stop(void)
 {
-    resp_get_status_t status_resp = {0};
-
-    // Get current monitor status
-    measurement_status_t meas_status = current_monitor_get_status();
-    status_resp.state = (uint8_t)meas_status;
-    status_resp.error_code = 0;
+    state.command_stop_requested = true;
+    os_semaphore_give(state.command_stop);
 
-    // Get temperature buffer count
-    status_resp.buffer_count = (uint16_t)temperature_sensor_buffer_get_count();
+    for (int i = 0; i < COMMAND_STOP_TIMEOUT_MS / 10 && state.command_task_running; i++) {
+        os_delay_ms(10);
+    }
 
-    // Uptime
-    status_resp.uptime_sec = os_get_tick_count() / 1000;
+    if (state.command_task_running && state.command_task_handle != NULL) {
+        os_task_delete(state.command_task_handle);
+    }
+    state.command_task_handle = NULL;
+    state.command_task_running = false;
+
+    // Hand frames of commands never handled back to the parser, through
+    // the set so that it keeps one entry per queued command
+    void *member;
+    while ((member = os_queue_set_select(state.command_inputs, OS_NO_WAIT)) != NULL) {
+        const protocol_packet_t *packet;
+        if (member == state.command_stop) {
+            os_semaphore_take(state.command_stop, OS_NO_WAIT);
+        } else if (os_queue_receive(state.command_queue, &packet, OS_NO_WAIT) == OS_SUCCESS) {
+            state.transport->rx_release((const uint8_t *)packet);
+        }
+    }
+}
 
-    protocol_handler_send_response(
-        cmd->cmd_id, cmd->seq, RESP_OK,
-        &status_resp, sizeof(status_resp));
+static void command_queue_delete(void)
+{
+    os_queue_set_delete(state.command_inputs);
+    os_semaphore_delete(state.command_stop);
+    os_queue_delete(state.command_queue);
+    state.command_inputs = NULL;
+    state.command_stop = NULL;
+    state.command_queue = NULL;
 }
 
-static void handle_cmd_set_rtc(const protocol_packet_t *cmd)
+static void command_task(void *param)
 {
-    if (cmd->length < sizeof(cmd_set_rtc_t)) {
-        protocol_handler_send_response(
-            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
-        return;
+    (void)param;
+
+    while (!state.command_stop_requested) {
+        // A command or the stop request, whichever comes first
+        const protocol_packet_t *packet;
+        void *member = os_queue_set_select(state.command_inputs, OS_WAIT_FOREVER);
+        if (member == state.command_stop) {
+            os_semaphore_take(state.command_stop, OS_NO_WAIT);
+            continue;
+        }
+        if (os_queue_receive(state.command_queue, &packet, OS_NO_WAIT) != OS_SUCCESS) {
+            continue;
+        }
+
+        handle_command(packet);
+        state.transport->rx_release((const uint8_t *)packet);
+        state.commands_pending--;
+    }
+
+    state.command_task_running = false;
+    os_task_delete(NULL);  // Delete self
+}
+
+/**
+ * @brief Hand a validated command to the command task (RX context)
+ *
+ * Never blocks: with the queue full the command is answered RESP_BUSY
+ * here, so a burst of commands cannot stall parsing.
+ */
+static void command_enqueue(const protocol_packet_t *packet)
+{
+    uint8_t cmd_id = packet->cmd_id;
+
+    // Handlers read at most a protocol_packet_t
+    if (packet->length > PROTOCOL_MAX_PAYLOAD_SIZE) {
+        LOG_W(TAG, "Payload too long: cmd=0x%02X len=%u", cmd_id, packet->length);
+        protocol_handler_send_response(
+            cmd_id, packet->seq, RESP_INVALID_PARAM, NULL, 0);
+        return;
+    }
+
+    // Queued in place: the parser continues into another RX frame. The
+    // frames outnumber the queue, so this fails only with the queue full
+    bool retained = state.transport->rx_retain((const uint8_t *)packet);
+
+    // Counted first: the worker may finish it before os_queue_send() returns
+    uint32_t mask = os_critical_enter();
+    state.commands_pending++;
+    os_critical_exit(mask);
+
+    if (retained && os_queue_send(state.command_queue, &packet, OS_NO_WAIT) == OS_SUCCESS) {
+        return;
+    }
+
+    if (retained) {
+        state.transport->rx_release((const uint8_t *)packet);
+    }
+
+    mask = os_critical_enter();
+    state.commands_pending--;
+    if (cmd_id < PROTOCOL_CMD_TABLE_SIZE) {
+        command_stats[cmd_id].busy++;
+    }
+    os_critical_exit(mask);
+
+    LOG_W_LIMITED(TAG, COMMAND_BUSY_LOG_MS, "Command queue full: cmd=0x%02X", cmd_id);
+    protocol_handler_send_response(
+        cmd_id, packet->seq, RESP_BUSY, NULL, 0);
+}
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+/**
+ * @brief LOCAL_FEATURES less what the transport cannot do
+ */
+static uint32_t local_features(void)
+{
+    uint32_t features = LOCAL_FEATURES;
+    if ((state.transport->caps & PROTOCOL_TRANSPORT_CAP_COBS) == 0) {
+        features &= ~PROTOCOL_FEATURE_COBS;
+    }
+    if ((state.transport->caps & PROTOCOL_TRANSPORT_CAP_RATE) == 0) {
+        features &= ~PROTOCOL_FEATURE_BAUD_SWITCH;
+    }
+    return features;
+}
+
+static void set_framing(bool cobs)
+{
+    if ((state.transport->caps & PROTOCOL_TRANSPORT_CAP_COBS) != 0) {
+        state.transport->set_framing(cobs ? PROTOCOL_TRANSPORT_FRAMING_COBS
+                                          : PROTOCOL_TRANSPORT_FRAMING_DEFAULT);
+    }
+}
+
+/**
+ * @brief Items of item_size one bulk frame carries after its header on this transport
+ */
+static uint32_t bulk_frame_items(size_t header_size, size_t item_size)
+{
+    return (uint32_t)((state.bulk_payload - header_size) / item_size);
+}
+
+static void packet_rx_callback(const protocol_transport_event_t *event, void *user_data)
+{
+    (void)user_data;
+
+    if (event->type == PROTOCOL_TRANSPORT_EVENT_RATE_FALLBACK) {
+        // Tell the host at the restored rate, in case it switched after all
+        notify_baud_fallback_t notify = { .baud_rate = (uint32_t)event->length };
+        protocol_handler_send_notification(NOTIFY_BAUD_FALLBACK, &notify, sizeof(notify));
+        return;
+    }
+
+    if (event->type != PROTOCOL_TRANSPORT_EVENT_PACKET) {
+        return;
+    }
+
+    if (event->data == NULL || event->length < PROTOCOL_HEADER_SIZE) {
+        LOG_W(TAG, "Invalid packet: len=%u", event->length);
+        return;
+    }
+
+    const protocol_packet_t *packet = (const protocol_packet_t *)event->data;
+
+    // Verify packet type
+    if (packet->type != PACKET_TYPE_CMD) {
+        LOG_W(TAG, "Unexpected packet type: 0x%02X", packet->type);
+        return;
+    }
+
+    // Verify length
+    if (packet->length > event->length - PROTOCOL_HEADER_SIZE) {
+        LOG_W(TAG, "Payload length mismatch");
+        return;
+    }
+
+    if (packet->cmd_id < PROTOCOL_CMD_TABLE_SIZE && commands[packet->cmd_id].rx_context) {
+        handle_command(packet);
+        return;
+    }
+
+    command_enqueue(packet);
+}
+
+/**
+ * @brief Queue a response packet for TX
+ *
+ * Blocks while all framing TX slots are busy, so responses leave in the
+ * order their commands arrived.
+ */
+static proto_handler_status_t send_packet(const protocol_packet_t *packet)
+{
+    size_t total_len = PROTOCOL_HEADER_SIZE + packet->length;
+    protocol_transport_status_t tx_status = state.transport->send(
+        (const uint8_t *)packet, total_len);
+
+    if (tx_status != PROTOCOL_TRANSPORT_OK) {
+        LOG_E(TAG, "Failed to send response: %d", tx_status);
+        return PROTO_HANDLER_ERR_TX_FAILED;
+    }
+
+    LOG_D(TAG, "Response sent: cmd=0x%02X seq=%d status=%d",
+          packet->cmd_id, packet->seq, packet->status);
+    return PROTO_HANDLER_OK;
+}
+
+/**
+ * @brief Dispatch one command through the command table
+ *
+ * Runs in the command task, or in the RX task for rx_context commands.
+ */
+static void handle_command(const protocol_packet_t *packet)
+{
+    uint8_t cmd_id = packet->cmd_id;
+
+    if (cmd_id >= PROTOCOL_CMD_TABLE_SIZE || commands[cmd_id].handler == NULL) {
+        uint32_t mask = os_critical_enter();
+        unknown_commands++;
+        os_critical_exit(mask);
+        LOG_W(TAG, "Unknown command: 0x%02X", cmd_id);
+        protocol_handler_send_response(
+            cmd_id, packet->seq, RESP_INVALID_CMD, NULL, 0);
+        return;
+    }
+
+    const command_entry_t *entry = &commands[cmd_id];
+    protocol_cmd_stats_t *stats = &command_stats[cmd_id];
+
+    if (packet->length < entry->min_length) {
+        uint32_t mask = os_critical_enter();
+        stats->rejected++;
+        os_critical_exit(mask);
+        protocol_handler_send_response(
+            cmd_id, packet->seq, RESP_INVALID_PARAM, NULL, 0);
+        return;
+    }
+
+    uint32_t start = hal_get_cycle_count();
+    entry->handler(packet);
+    uint32_t cycles = hal_get_cycle_count() - start;
+
+    uint32_t mask = os_critical_enter();
+    stats->count++;
+    stats->total_cycles += cycles;
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    os_critical_exit(mask);
+}
+
+/**
+ * @brief Bring the cached status up to date
+ *
+ * Bumps status_version when anything but the uptime differs.
+ */
+static const resp_get_status_t *status_snapshot_refresh(void)
+{
+    resp_get_status_t current = {0};
+
+    // Get current monitor status
+    measurement_status_t meas_status = current_monitor_get_status();
+    current.state = (uint8_t)meas_status;
+    current.error_code = 0;
+
+    // Get temperature buffer count
+    current.buffer_count = (uint16_t)temperature_sensor_buffer_get_count();
+
+    // Real-time health
+    uint32_t stream_missed = state.stream_missed_deadlines;
+    uint32_t loop_missed = services_get_missed_deadlines();
+    current.stream_missed_deadlines = (stream_missed > UINT16_MAX) ? UINT16_MAX : (uint16_t)stream_missed;
+    current.loop_missed_deadlines = (loop_missed > UINT16_MAX) ? UINT16_MAX : (uint16_t)loop_missed;
+
+    // Packed and zero-initialised, so memcmp sees no padding
+    current.uptime_sec = state.status_snapshot.uptime_sec;
+    if (state.status_version == 0
+        || memcmp(&current, &state.status_snapshot, sizeof(current)) != 0) {
+        state.status_snapshot = current;
+        // Skip 0 on wrap: it means "no copy" in GET_STATUS_IF_CHANGED
+        if (++state.status_version == 0) {
+            state.status_version = 1;
+        }
+    }
+
+    // Uptime
+    state.status_snapshot.uptime_sec = os_get_tick_count() / 1000;
+    return &state.status_snapshot;
+}
+
+static void handle_cmd_get_status(const protocol_packet_t *cmd)
+{
+    const resp_get_status_t *status_resp = status_snapshot_refresh();
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK,
+        status_resp, sizeof(*status_resp));
+}
+
+static void handle_cmd_get_status_if_changed(const protocol_packet_t *cmd)
+{
+    const cmd_get_status_if_changed_t *req = (const cmd_get_status_if_changed_t *)cmd->payload;
+    const resp_get_status_t *status = status_snapshot_refresh();
+
+    if (req->since_version == state.status_version) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_NOT_MODIFIED, NULL, 0);
+        return;
+    }
+
+    resp_status_snapshot_t resp = {
+        .version = state.status_version,
+        .status = *status,
+    };
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &resp, sizeof(resp));
+}
+
+static void handle_cmd_get_link_stats(const protocol_packet_t *cmd)
+{
+    link_stats_t link;
+    if (!link_stats_get(&link)) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+        return;
     }
 
+    resp_link_stats_t resp = {
+        .window_ms = link.window_ms,
+        .tx_bytes_per_s = link.tx_bytes_per_s,
+        .rx_bytes_per_s = link.rx_bytes_per_s,
+        .tx_frames_per_s = link.tx_frames_per_s,
+        .rx_frames_per_s = link.rx_frames_per_s,
+        .rx_error_ppm = link.rx_error_ppm,
+        .tx_wait_mean_us = link.tx_wait_mean_us,
+        .tx_wait_p99_us = link.tx_wait_p99_us,
+        .tx_busy_permille = link.tx_busy_permille,
+    };
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &resp, sizeof(resp));
+}
+
+static void handle_cmd_set_rtc(const protocol_packet_t *cmd)
+{
     const cmd_set_rtc_t *rtc_cmd = (const cmd_set_rtc_t *)cmd->payload;
 
     hal_rtc_status_t rtc_status = hal_rtc_set_time(rtc_cmd->unix_time, 0);
@@ -385,25 +1498,115 @@ static void handle_cmd_set_rtc(const protocol_packet_t *cmd)
         return;
     }
 
+    // Step wall-clock time to the new RTC value right away
+    hal_timebase_resync();
+
     LOG_I(TAG, "RTC set to: %lu", rtc_cmd->unix_time);
 
     protocol_handler_send_response(
         cmd->cmd_id, cmd->seq, RESP_OK, NULL, 0);
 }
 
-static void handle_cmd_start_measurement(const protocol_packet_t *cmd)
+static uint64_t time_stamp_us(time_stamp_t stamp)
 {
-    if (cmd->length < sizeof(cmd_start_stream_t)) {
-        protocol_handler_send_response(
-            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
-        return;
+    return (uint64_t)stamp.sec * 1000000U + stamp.usec;
+}
+
+static time_stamp_t time_stamp_of(uint64_t unix_us)
+{
+    time_stamp_t stamp = {
+        .sec = (uint32_t)(unix_us / 1000000U),
+        .usec = (uint32_t)(unix_us % 1000000U),
+    };
+    return stamp;
+}
+
+/**
+ * @brief Discipline the clock to the host's, one NTP exchange per request
+ *
+ * Runs in the RX task, so T2 is taken as the frame is parsed. The previous
+ * exchange is completed with the T4 this request reports: the host clock
+ * at the midpoint of T2..T3 is taken as (T1 + T4) / 2, which assumes equal
+ * delays both ways; delays well over the recent smallest mean queueing on
+ * one side, and those exchanges are only reported.
+ */
+static void handle_cmd_time_sync(const protocol_packet_t *cmd)
+{
+    uint64_t t2_mono_us = hal_timebase_now_us();
+    const cmd_time_sync_t *req = (const cmd_time_sync_t *)cmd->payload;
+    resp_time_sync_t resp = { .t1 = req->t1 };
+
+    uint64_t prev_t1_us = time_stamp_us(req->prev_t1);
+    uint64_t prev_t4_us = time_stamp_us(req->prev_t4);
+    if (state.time_sync_pending && prev_t4_us != 0 && prev_t1_us == state.time_sync_t1_us) {
+        uint64_t held_us = state.time_sync_t3_mono_us - state.time_sync_t2_mono_us;
+        int64_t delay_us = (int64_t)(prev_t4_us - prev_t1_us) - (int64_t)held_us;
+        uint64_t mid_mono_us = state.time_sync_t2_mono_us + held_us / 2U;
+        uint64_t host_us = prev_t1_us + (prev_t4_us - prev_t1_us) / 2U;
+
+        resp.offset_us = (int32_t)((int64_t)(host_us - hal_timebase_to_unix_us(mid_mono_us)));
+        resp.delay_us = (delay_us > 0) ? (uint32_t)delay_us : 0;
+        resp.flags |= TIME_SYNC_FLAG_MEASURED;
+
+        // Popcorn filter against the smallest recent delay
+        uint32_t min_delay_us = state.time_sync_min_delay_us;
+        if (min_delay_us == 0 || resp.delay_us < min_delay_us) {
+            min_delay_us = resp.delay_us;
+        } else {
+            min_delay_us += min_delay_us / TIME_SYNC_DELAY_AGING + 1U;
+        }
+        state.time_sync_min_delay_us = min_delay_us;
+
+        if (delay_us >= 0 && resp.delay_us <= min_delay_us * TIME_SYNC_DELAY_SPREAD) {
+            hal_timebase_status_t before, after;
+            hal_timebase_get_status(&before);
+            hal_timebase_reference(mid_mono_us, host_us);
+            hal_timebase_get_status(&after);
+            resp.flags |= TIME_SYNC_FLAG_APPLIED;
+            if (after.steps != before.steps) {
+                resp.flags |= TIME_SYNC_FLAG_STEPPED;
+            }
+        }
+    }
+
+    hal_timebase_status_t timebase;
+    hal_timebase_get_status(&timebase);
+    resp.rate_ppb = timebase.rate_ppb;
+    if (timebase.source == HAL_TIMEBASE_SOURCE_REFERENCE) {
+        resp.flags |= TIME_SYNC_FLAG_REFERENCE;
     }
 
+    state.time_sync_t1_us = time_stamp_us(req->t1);
+    state.time_sync_t2_mono_us = t2_mono_us;
+    state.time_sync_pending = true;
+    resp.t2 = time_stamp_of(hal_timebase_to_unix_us(t2_mono_us));
+
+    // T3 as late as possible: everything after it is on the host's account
+    uint64_t t3_mono_us = hal_timebase_now_us();
+    state.time_sync_t3_mono_us = t3_mono_us;
+    resp.t3 = time_stamp_of(hal_timebase_to_unix_us(t3_mono_us));
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &resp, sizeof(resp));
+}
+
+static void handle_cmd_start_measurement(const protocol_packet_t *cmd)
+{
     const cmd_start_stream_t *stream_cmd = (const cmd_start_stream_t *)cmd->payload;
 
+    // Batching fields are optional (older hosts send only sensor + interval)
+    uint8_t batch_size = (uint8_t)config_get(CONFIG_KEY_STREAM_BATCH);
+    uint16_t max_latency_ms = (uint16_t)config_get(CONFIG_KEY_STREAM_LATENCY_MS);
+    if (cmd->length >= sizeof(cmd_start_stream_t)) {
+        batch_size = stream_cmd->batch_size;
+        max_latency_ms = stream_cmd->max_latency_ms;
+    }
+
     proto_handler_status_t status = protocol_handler_start_stream(
         (sensor_type_t)stream_cmd->sensor_type,
-        stream_cmd->interval_ms);
+        stream_cmd->interval_ms,
+        batch_size,
+        max_latency_ms);
 
     protocol_handler_send_response(
         cmd->cmd_id, cmd->seq,
@@ -413,20 +1616,59 @@ static void handle_cmd_start_measurement(const protocol_packet_t *cmd)
 
 static void handle_cmd_stop_measurement(const protocol_packet_t *cmd)
 {
-    protocol_handler_stop_stream();
+    // Optional sensor_type stops one session, empty payload stops all
+    if (cmd->length >= sizeof(cmd_stop_stream_t)) {
+        const cmd_stop_stream_t *stop_cmd = (const cmd_stop_stream_t *)cmd->payload;
+        protocol_handler_stop_sensor_stream((sensor_type_t)stop_cmd->sensor_type);
+    } else {
+        protocol_handler_stop_stream();
+    }
 
     protocol_handler_send_response(
         cmd->cmd_id, cmd->seq, RESP_OK, NULL, 0);
 }
 
-static void handle_cmd_get_buffer_data(const protocol_packet_t *cmd)
+/**
+ * @brief GET_BUFFER_DATA response with a compact sample array
+ */
+static void send_buffer_data_compact(const protocol_packet_t *cmd, const cmd_get_buffer_data_t *req)
 {
-    if (cmd->length < sizeof(cmd_get_buffer_data_t)) {
+    uint32_t samples_to_read = req->count;
+    if (samples_to_read > RESP_COMPACT_MAX_SAMPLES) {
+        samples_to_read = RESP_COMPACT_MAX_SAMPLES;
+    }
+
+    uint32_t samples_read = 0;
+    bool success = temperature_sensor_buffer_read(
+        req->start_index, resp_samples, samples_to_read, &samples_read);
+
+    if (!success || samples_read == 0) {
         protocol_handler_send_response(
-            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
+            cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+        return;
+    }
+
+    // Encode straight into the TX slot
+    protocol_packet_t *resp = response_reserve(cmd, PACKET_TYPE_FLAG_COMPACT);
+    if (resp == NULL) {
         return;
     }
 
+    resp_buffer_data_header_t *header = (resp_buffer_data_header_t *)resp->payload;
+    uint32_t encoded = 0;
+    size_t encoded_len = sample_codec_encode(
+        resp_samples, samples_read,
+        resp->payload + sizeof(resp_buffer_data_header_t),
+        PROTOCOL_MAX_PAYLOAD_SIZE - sizeof(resp_buffer_data_header_t), &encoded);
+
+    header->sensor_type = SENSOR_TEMPERATURE;
+    header->sample_count = (uint16_t)encoded;
+
+    response_commit(resp, (uint16_t)(sizeof(resp_buffer_data_header_t) + encoded_len));
+}
+
+static void handle_cmd_get_buffer_data(const protocol_packet_t *cmd)
+{
     const cmd_get_buffer_data_t *req = (const cmd_get_buffer_data_t *)cmd->payload;
 
     // Check if there's data available
@@ -437,6 +1679,11 @@ static void handle_cmd_get_buffer_data(const protocol_packet_t *cmd)
         return;
     }
 
+    if (state.compact_samples) {
+        send_buffer_data_compact(cmd, req);
+        return;
+    }
+
     // Calculate how many samples we can fit in response
     // Response format: resp_buffer_data_header_t + sensor_sample_t[]
     uint32_t max_samples_in_payload =
@@ -447,19 +1694,22 @@ static void handle_cmd_get_buffer_data(const protocol_packet_t *cmd)
         samples_to_read = max_samples_in_payload;
     }
 
-    // Prepare response buffer
-    uint8_t response_buf[PROTOCOL_MAX_PAYLOAD_SIZE];
-    resp_buffer_data_header_t *header = (resp_buffer_data_header_t *)response_buf;
-    sensor_sample_t *samples = (sensor_sample_t *)(response_buf + sizeof(resp_buffer_data_header_t));
+    // Read the samples straight into the TX slot
+    protocol_packet_t *resp = response_reserve(cmd, 0);
+    if (resp == NULL) {
+        return;
+    }
+
+    resp_buffer_data_header_t *header = (resp_buffer_data_header_t *)resp->payload;
+    sensor_sample_t *samples = (sensor_sample_t *)(resp->payload + sizeof(resp_buffer_data_header_t));
 
-    // Read samples from buffer
     uint32_t samples_read = 0;
     bool success = temperature_sensor_buffer_read(
         req->start_index, samples, samples_to_read, &samples_read);
 
     if (!success || samples_read == 0) {
-        protocol_handler_send_response(
-            cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+        resp->status = RESP_NO_DATA;
+        response_commit(resp, 0);
         return;
     }
 
@@ -470,80 +1720,2053 @@ static void handle_cmd_get_buffer_data(const protocol_packet_t *cmd)
     // Calculate total response size
     uint16_t payload_len = sizeof(resp_buffer_data_header_t) + (samples_read * sizeof(sensor_sample_t));
 
-    protocol_handler_send_response(
-        cmd->cmd_id, cmd->seq, RESP_OK, response_buf, payload_len);
-}
-
-static void handle_cmd_clear_buffer(const protocol_packet_t *cmd)
-{
-    current_monitor_clear();
-    temperature_sensor_buffer_clear();
-
-    protocol_handler_send_response(
-        cmd->cmd_id, cmd->seq, RESP_OK, NULL, 0);
+    response_commit(resp, payload_len);
 }
 
-static void stream_task(void *param)
+static void handle_cmd_get_buffer_range(const protocol_packet_t *cmd)
 {
-    (void)param;
+    const cmd_get_buffer_range_t *req = (const cmd_get_buffer_range_t *)cmd->payload;
+    uint32_t to_timestamp = (req->to_timestamp != 0) ? req->to_timestamp : UINT32_MAX;
 
-    LOG_I(TAG, "Stream task started: sensor=%d interval=%lu",
-          state.stream_sensor, state.stream_interval_ms);
+    uint8_t response_buf[PROTOCOL_MAX_PAYLOAD_SIZE];
+    resp_buffer_range_header_t *header = (resp_buffer_range_header_t *)response_buf;
+    uint8_t *payload = response_buf + sizeof(resp_buffer_range_header_t);
+    size_t payload_space = sizeof(response_buf) - sizeof(resp_buffer_range_header_t);
+
+    // Compact responses read ahead into resp_samples and encode what fits;
+    // plain ones read straight into the payload
+    uint32_t max_samples = state.compact_samples
+                           ? RANGE_COMPACT_MAX_SAMPLES
+                           : payload_space / sizeof(sensor_sample_t);
+    if (req->count < max_samples) {
+        max_samples = req->count;
+    }
+    sensor_sample_t *samples = state.compact_samples ? resp_samples : (sensor_sample_t *)payload;
 
-    while (!state.stream_stop_requested) {
-        sensor_sample_t sample = {0};
-        sample.sensor_type = state.stream_sensor;
-        sample.timestamp = os_get_tick_count();
-
-        switch (state.stream_sensor) {
-            case SENSOR_TEMPERATURE:
-                if (state.temp_data_valid) {
-                    // Temperature in centi-degrees (e.g., 2350 = 23.50 C)
-                    sample.value = (int32_t)(state.last_temperature * 100);
-                } else {
-                    sample.value = 0;
-                }
-                break;
+    uint32_t samples_read = 0;
+    uint32_t first_index = 0;
+    bool success = temperature_sensor_buffer_read_range(
+        req->from_timestamp, to_timestamp, samples, max_samples, &samples_read, &first_index);
 
-            case SENSOR_CURRENT: {
-                INA226_Data ina_data;
-                if (current_monitor_get_instant_reading(&ina_data)) {
-                    // Current in microamps
-                    sample.value = (int32_t)(ina_data.current_mA * 1000);
-                } else {
-                    sample.value = 0;
-                }
-                break;
-            }
+    if (!success || samples_read == 0) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+        return;
+    }
 
-            default:
-                sample.value = 0;
-                break;
-        }
+    header->sensor_type = SENSOR_TEMPERATURE;
+    header->first_index = first_index;
 
-        protocol_handler_send_sensor_sample(&sample);
+    if (state.compact_samples) {
+        uint32_t encoded = 0;
+        size_t encoded_len = sample_codec_encode(
+            resp_samples, samples_read, payload, payload_space, &encoded);
+        header->sample_count = (uint16_t)encoded;
 
-        os_delay_ms(state.stream_interval_ms);
+        send_response_flags(
+            cmd->cmd_id, cmd->seq, RESP_OK, PACKET_TYPE_FLAG_COMPACT, response_buf,
+            (uint16_t)(sizeof(resp_buffer_range_header_t) + encoded_len));
+        return;
     }
 
-    LOG_I(TAG, "Stream task exiting");
-    state.streaming_active = false;
-    os_task_delete(NULL);  // Delete self
+    header->sample_count = (uint16_t)samples_read;
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, response_buf,
+        (uint16_t)(sizeof(resp_buffer_range_header_t) + samples_read * sizeof(sensor_sample_t)));
 }
 
-static void temperature_event_handler(event_t *event)
+static void handle_cmd_get_history(const protocol_packet_t *cmd)
 {
-    if (event == NULL || event->data == NULL) {
+    const cmd_get_history_t *req = (const cmd_get_history_t *)cmd->payload;
+    if (req->sensor_type != SENSOR_TEMPERATURE || req->tier >= TEMP_SENSOR_HISTORY_TIERS) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
         return;
     }
 
-    const temperature_data_t *temp_data = (const temperature_data_t *)event->data;
+    uint8_t response_buf[PROTOCOL_MAX_PAYLOAD_SIZE];
+    resp_history_header_t *header = (resp_history_header_t *)response_buf;
+    sensor_rollup_record_t *records = (sensor_rollup_record_t *)(response_buf + sizeof(resp_history_header_t));
+
+    uint32_t max_records = (sizeof(response_buf) - sizeof(resp_history_header_t)) / sizeof(sensor_rollup_record_t);
+    if (req->count < max_records) {
+        max_records = req->count;
+    }
+
+    uint32_t records_read = 0;
+    uint32_t first_index = 0;
+    bool success = temperature_sensor_history_read(
+        req->tier, req->from_timestamp, records, max_records, &records_read, &first_index);
+
+    if (!success || records_read == 0) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+        return;
+    }
+
+    header->sensor_type = SENSOR_TEMPERATURE;
+    header->tier = req->tier;
+    header->first_index = first_index;
+    header->record_count = (uint16_t)records_read;
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, response_buf,
+        (uint16_t)(sizeof(resp_history_header_t) + records_read * sizeof(sensor_rollup_record_t)));
+}
+
+static void handle_cmd_get_stats(const protocol_packet_t *cmd)
+{
+    const cmd_get_stats_t *req = (const cmd_get_stats_t *)cmd->payload;
+    stream_stats_summary_t summary;
+    bool found = false;
+    float scale = 0.0f;
+
+    if (req->sensor_type == SENSOR_TEMPERATURE && req->channel == 0 &&
+        req->window < TEMP_SENSOR_STATS_WINDOWS) {
+        found = temperature_sensor_stats_get(req->window, &summary);
+        scale = 0.01f;  // Centi-degrees
+    } else if (req->sensor_type == SENSOR_CURRENT && req->channel < CURRENT_STATS_CHANNEL_COUNT &&
+               req->window < CURRENT_MONITOR_STATS_WINDOWS) {
+        found = current_monitor_get_stream_stats((current_stats_channel_t)req->channel,
+                                                 req->window, &summary);
+        scale = (req->channel == CURRENT_STATS_CHANNEL_CURRENT) ? current_monitor_get_current_lsb_mA()
+                                                                : INA226_BUS_VOLTAGE_LSB_V;
+    } else {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
+        return;
+    }
+
+    if (!found) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+        return;
+    }
+
+    resp_stats_t resp = {
+        .sensor_type = req->sensor_type,
+        .channel = req->channel,
+        .window = req->window,
+        .flags = summary.complete ? STATS_FLAG_COMPLETE : 0,
+        .length = summary.length,
+        .count = summary.count,
+        .first_timestamp = summary.first_timestamp,
+        .last_timestamp = summary.last_timestamp,
+        .min = summary.min,
+        .max = summary.max,
+        .mean = summary.mean,
+        .stddev = summary.stddev,
+        .rms = summary.rms,
+        .scale = scale,
+    };
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &resp, sizeof(resp));
+}
+
+static void handle_cmd_get_analysis(const protocol_packet_t *cmd)
+{
+    current_analysis_result_t result;
+
+    if (!current_analysis_run(&result)) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+        return;
+    }
+
+    resp_analysis_t resp = {
+        .first_index = result.first_index,
+        .sample_count = result.sample_count,
+        .block_count = result.block_count,
+        .duration_s = result.duration_s,
+        .mean_current_mA = result.mean_current_mA,
+        .rms_current_mA = result.rms_current_mA,
+        .peak_current_mA = result.peak_current_mA,
+        .peak_index = result.peak_index,
+        .filtered_peak_mA = result.filtered_peak_mA,
+        .filtered_peak_index = result.filtered_peak_index,
+        .mean_power_mW = result.mean_power_mW,
+        .energy_mWh = result.energy_mWh,
+        .charge_mAh = result.charge_mAh,
+        .cycles_per_block = result.cycles_per_block,
+        .cycles_max_block = result.cycles_max_block,
+    };
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &resp, sizeof(resp));
+}
+
+static void handle_cmd_clear_buffer(const protocol_packet_t *cmd)
+{
+    current_monitor_clear();
+    temperature_sensor_buffer_clear();
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, NULL, 0);
+}
+
+static void handle_cmd_negotiate_version(const protocol_packet_t *cmd)
+{
+    const cmd_negotiate_version_t *req = (const cmd_negotiate_version_t *)cmd->payload;
+    if (req->version < PROTOCOL_VERSION_MARKERS) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
+        return;
+    }
+
+    resp_negotiate_version_t resp = {
+        .version = (req->version < PROTOCOL_VERSION_MAX) ? req->version : PROTOCOL_VERSION_MAX
+    };
+
+    // Reply in the current framing; the frame is built at queue time, so
+    // switching right after does not affect it
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &resp, sizeof(resp));
+
+    set_framing(resp.version >= PROTOCOL_VERSION_COBS);
+    state.compact_samples = (resp.version >= PROTOCOL_VERSION_COMPACT);
+    LOG_I(TAG, "Protocol version %d", resp.version);
+}
+
+static void handle_cmd_hello(const protocol_packet_t *cmd)
+{
+    const cmd_hello_t *req = (const cmd_hello_t *)cmd->payload;
+    if (req->version < PROTOCOL_VERSION_MARKERS || req->max_payload < PROTOCOL_MAX_PAYLOAD_SIZE) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
+        return;
+    }
+
+    uint32_t features = req->features & local_features();
+    if (req->max_payload < state.bulk_payload) {
+        features &= ~PROTOCOL_FEATURE_BULK;
+    }
+
+    resp_hello_t resp = {
+        .version = (req->version < PROTOCOL_VERSION_MAX) ? req->version : PROTOCOL_VERSION_MAX,
+        .max_payload = PROTOCOL_MAX_PAYLOAD_SIZE,
+        .max_bulk_payload = state.bulk_payload,
+        .window_size = PROTOCOL_WINDOW_SIZE,
+        .max_stream_batch = PROTOCOL_STREAM_MAX_BATCH,
+        .features = features,
+        .stm32_features = local_features(),
+    };
+
+    // Old framing for the reply, as for NEGOTIATE_VERSION
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &resp, sizeof(resp));
+
+    state.features = features;
+    set_framing((features & PROTOCOL_FEATURE_COBS) != 0);
+    state.compact_samples = (features & PROTOCOL_FEATURE_COMPACT) != 0;
+    LOG_I(TAG, "HELLO: version %d, features 0x%08lX", resp.version, (unsigned long)features);
+}
+
+/**
+ * @brief Answer a bulk transfer request that cannot start now
+ * @return true if answered (busy, or the host cannot take bulk frames)
+ */
+static bool bulk_refused(const protocol_packet_t *cmd)
+{
+    if ((state.features & PROTOCOL_FEATURE_BULK) == 0) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
+        return true;
+    }
+
+    if (state.bulk_active) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_BUSY, NULL, 0);
+        return true;
+    }
+    return false;
+}
+
+static void handle_cmd_retransmit(const protocol_packet_t *cmd)
+{
+    const cmd_retransmit_t *req = (const cmd_retransmit_t *)cmd->payload;
+
+    // Search newest first, in case the host has wrapped seq within the window
+    for (uint8_t i = 1; i <= PROTOCOL_WINDOW_SIZE; i++) {
+        uint8_t idx = (state.history_next + PROTOCOL_WINDOW_SIZE - i) % PROTOCOL_WINDOW_SIZE;
+        if (state.history_valid[idx] && state.history[idx].seq == req->seq) {
+            LOG_D(TAG, "Retransmit seq=%d", req->seq);
+            send_packet(&state.history[idx]);
+            return;
+        }
+    }
+
+    LOG_W(TAG, "Retransmit seq=%d not in window", req->seq);
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+}
+
+static void handle_cmd_bulk_dump(const protocol_packet_t *cmd)
+{
+    const cmd_bulk_dump_t *req = (const cmd_bulk_dump_t *)cmd->payload;
+    if (req->sensor_type != SENSOR_TEMPERATURE && req->sensor_type != SENSOR_CURRENT
+        && req->sensor_type != SENSOR_HUMIDITY && req->sensor_type != SENSOR_TEMP_HUMIDITY) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
+        return;
+    }
+
+    if (bulk_refused(cmd)) {
+        return;
+    }
+
+    state.bulk_request = *req;
+    state.bulk_seq = cmd->seq;
+    state.bulk_stop_requested = false;
+
+    // Acknowledge first so the ACK precedes the data frames on the wire
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, NULL, 0);
+
+    bulk_start(bulk_task);
+}
+
+static void handle_cmd_bulk_export(const protocol_packet_t *cmd)
+{
+    if (bulk_refused(cmd)) {
+        return;
+    }
+
+    state.export_request = *(const cmd_bulk_export_t *)cmd->payload;
+    state.bulk_request.sensor_type = SENSOR_MERGED;  // For NOTIFY_BULK_DONE
+    state.bulk_seq = cmd->seq;
+    state.bulk_stop_requested = false;
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, NULL, 0);
+
+    bulk_start(export_task);
+}
+
+/**
+ * @brief Plan a capture measurement against this link and put it in wire form
+ *
+ * @param follow The dump follows the measurement, so it may stream it
+ * @return false if no mode sustains it (resp still filled in)
+ */
+static bool capture_plan_wire(measurement_config_t *config, bool follow, resp_current_capture_plan_t *resp)
+{
+    const protocol_transport_t *transport = state.transport;
+    uint32_t rate = transport->throughput;
+    if (rate == 0 && (transport->caps & PROTOCOL_TRANSPORT_CAP_RATE) != 0) {
+        rate = transport->get_rate() / 10U;   // 8N1: ten bits a byte
+    }
+
+    uint32_t per_frame = bulk_frame_items(sizeof(notify_current_data_header_t), sizeof(current_record_t));
+    capture_plan_link_t link = {
+        .bytes_per_s = follow ? rate : 0,
+        .frame_bytes = (uint32_t)(PROTOCOL_HEADER_SIZE + CAPTURE_FRAME_OVERHEAD +
+                                  sizeof(notify_current_data_header_t) + per_frame * sizeof(current_record_t)),
+        .frame_samples = per_frame,
+    };
+
+    capture_plan_t plan;
+    bool planned = capture_plan_make(config, &link, &plan);
+
+    resp->mode = (uint8_t)plan.mode;
+    resp->format = (uint8_t)plan.format;
+    resp->samples = plan.samples;
+    resp->ram_bytes = plan.ram_bytes;
+    resp->flash_bytes = plan.flash_bytes;
+    resp->link_bytes_per_s = plan.link_bytes_per_s;
+    for (uint32_t i = 0; i < CAPTURE_FORMAT_COUNT; i++) {
+        resp->need[i].ram_bytes = plan.need[i].ram_bytes;
+        resp->need[i].flash_bytes = plan.need[i].flash_bytes;
+        resp->need[i].link_bytes_per_s = plan.need[i].link_bytes_per_s;
+    }
+    return planned;
+}
+
+static void handle_cmd_get_current_capture(const protocol_packet_t *cmd)
+{
+    const cmd_get_current_capture_t *req = (const cmd_get_current_capture_t *)cmd->payload;
+    resp_current_capture_plan_t plan = {0};
+    uint16_t plan_len = 0;
+
+    if (bulk_refused(cmd)) {
+        return;
+    }
+
+    if (req->flags & CURRENT_CAPTURE_FLAG_START) {
+        measurement_config_t config = {
+            .duration_sec = req->duration_sec,
+            .sample_period = (sample_period_ms_t)req->sample_period_ms,
+            .trigger = CURRENT_MONITOR_DEFAULT_TRIGGER,
+        };
+        plan_len = sizeof(plan);
+        bool follow = (req->flags & CURRENT_CAPTURE_FLAG_FOLLOW) != 0;
+        if (!capture_plan_wire(&config, follow, &plan) || !current_monitor_start_measurement(&config)) {
+            protocol_handler_send_response(
+                cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, &plan, plan_len);
+            return;
+        }
+        LOG_I(TAG, "Capture plan: mode %u, %lu samples", plan.mode, plan.samples);
+    }
+
+    state.capture_request = *req;
+    state.bulk_request.sensor_type = SENSOR_CURRENT;  // For NOTIFY_BULK_DONE
+    state.bulk_seq = cmd->seq;
+    state.bulk_stop_requested = false;
+
+    // Acknowledge first so the ACK precedes the data frames on the wire
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, (plan_len != 0) ? &plan : NULL, plan_len);
+
+    bulk_start(capture_task);
+}
+
+static void handle_cmd_get_recording(const protocol_packet_t *cmd)
+{
+    if (bulk_refused(cmd)) {
+        return;
+    }
+
+    recorder_stats_t rec;
+    recorder_get_stats(&rec);
+    if (!rec.available || rec.blocks_recorded == 0) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_NO_DATA, NULL, 0);
+        return;
+    }
+
+    state.recording_request = *(const cmd_get_recording_t *)cmd->payload;
+    state.bulk_request.sensor_type = SENSOR_CURRENT;  // For NOTIFY_BULK_DONE
+    state.bulk_seq = cmd->seq;
+    state.bulk_stop_requested = false;
+
+    // Acknowledge first so the ACK precedes the data frames on the wire
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, NULL, 0);
+
+    bulk_start(recording_task);
+}
+
+static void handle_cmd_set_baud_rate(const protocol_packet_t *cmd)
+{
+    const cmd_set_baud_rate_t *req = (const cmd_set_baud_rate_t *)cmd->payload;
+    if ((state.transport->caps & PROTOCOL_TRANSPORT_CAP_RATE) == 0 ||
+        !state.transport->rate_supported(req->baud_rate)) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
+        return;
+    }
+
+    // Bulk frames queued around the switch would reach the host at the wrong rate
+    if (state.bulk_active) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_BUSY, NULL, 0);
+        return;
+    }
+
+    resp_set_baud_rate_t resp = {
+        .baud_rate = req->baud_rate,
+        .previous_baud_rate = state.transport->get_rate(),
+    };
+    uint32_t probation_ms = (req->probation_ms != 0) ? req->probation_ms : PROTOCOL_BAUD_PROBATION_MS;
+
+    // Reply at the old rate; the switch waits until the reply has left
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &resp, sizeof(resp));
+
+    if (state.transport->set_rate(req->baud_rate, probation_ms) != PROTOCOL_TRANSPORT_OK) {
+        LOG_E(TAG, "Baud switch to %lu failed", (unsigned long)req->baud_rate);
+    }
+}
+
+static void handle_cmd_grant_credits(const protocol_packet_t *cmd)
+{
+    const cmd_grant_credits_t *req = (const cmd_grant_credits_t *)cmd->payload;
+
+    uint32_t mask = os_critical_enter();
+    if (req->credits == PROTOCOL_CREDITS_OFF) {
+        state.credit_mode = false;
+        state.credits = 0;
+    } else {
+        uint32_t balance = state.credits + req->credits;
+        state.credits = (balance > PROTOCOL_CREDITS_MAX) ? PROTOCOL_CREDITS_MAX : balance;
+        state.credit_mode = true;
+    }
+    os_critical_exit(mask);
+
+    // Held transfers and paused streams go on at once
+    os_semaphore_give(state.credit_wake);
+    os_semaphore_give(state.stream_wake);
+
+    resp_grant_credits_t resp = {
+        .balance = (uint16_t)state.credits,
+        .stalls = state.credit_stalls,
+    };
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, (const uint8_t *)&resp, sizeof(resp));
+}
+
+static void handle_cmd_get_command_stats(const protocol_packet_t *cmd)
+{
+    uint8_t payload[PROTOCOL_MAX_PAYLOAD_SIZE];
+    cmd_get_command_stats_t req = { .first_cmd_id = 0, .reset = 0 };
+    resp_command_stats_header_t header = {
+        .cpu_freq_hz = hal_get_cpu_freq_hz(),
+        .unknown_commands = unknown_commands,
+        .entry_count = 0,
+        .next_cmd_id = 0,
+    };
+    size_t len = sizeof(header);
+    protocol_cmd_stats_t stats;
+
+    if (cmd->length >= sizeof(req)) {
+        memcpy(&req, cmd->payload, sizeof(req));
+    }
+
+    for (uint32_t id = req.first_cmd_id; id < PROTOCOL_CMD_TABLE_SIZE; id++) {
+        if (!protocol_handler_get_command_stats((uint8_t)id, &stats)
+            || (stats.count == 0 && stats.rejected == 0 && stats.busy == 0)) {
+            continue;
+        }
+        if (len + sizeof(resp_command_stats_entry_t) > sizeof(payload)) {
+            header.next_cmd_id = (uint8_t)id;   // Ask again from here
+            break;
+        }
+
+        resp_command_stats_entry_t entry = {
+            .cmd_id = (uint8_t)id,
+            .count = stats.count,
+            .rejected = stats.rejected,
+            .busy = stats.busy,
+            .avg_cycles = (stats.count > 0) ? (uint32_t)(stats.total_cycles / stats.count) : 0,
+            .max_cycles = stats.max_cycles,
+        };
+        memcpy(&payload[len], &entry, sizeof(entry));
+        len += sizeof(entry);
+        header.entry_count++;
+    }
+    memcpy(payload, &header, sizeof(header));
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, payload, len);
+
+    if (req.reset) {
+        protocol_handler_reset_command_stats();
+    }
+}
+
+static void handle_cmd_echo(const protocol_packet_t *cmd)
+{
+    if (cmd->length > PROTOCOL_MAX_PAYLOAD_SIZE) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
+        return;
+    }
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, cmd->payload, cmd->length);
+}
+
+static void handle_cmd_loopback_test(const protocol_packet_t *cmd)
+{
+    const cmd_loopback_test_t *req = (const cmd_loopback_test_t *)cmd->payload;
+    if (req->count == 0 || req->window == 0 || req->window > LOOPBACK_MAX_WINDOW
+        || req->payload_size < LOOPBACK_PROBE_MIN
+        || req->payload_size > state.bulk_payload) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_INVALID_PARAM, NULL, 0);
+        return;
+    }
+
+    if (state.bulk_active) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_BUSY, NULL, 0);
+        return;
+    }
+
+    state.loopback_request = *req;
+    state.bulk_seq = cmd->seq;
+    state.bulk_stop_requested = false;
+
+    memset(&loopback, 0, sizeof(loopback));
+    loopback.payload_size = req->payload_size;
+    loopback.rtt_min_us = UINT32_MAX;
+    loopback.running = true;
+
+    // Acknowledge first so the ACK precedes the probes on the wire
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, NULL, 0);
+
+    if (!bulk_start(loopback_task)) {
+        loopback.running = false;
+    }
+}
+
+/**
+ * @brief Pattern byte i of a probe's payload (after the header)
+ */
+static inline uint8_t loopback_pattern(uint32_t probe_seq, uint32_t i)
+{
+    return (uint8_t)(probe_seq + i);
+}
+
+static uint32_t loopback_rtt_bucket(uint32_t rtt_us)
+{
+    const uint32_t sub_count = 1U << LOOPBACK_RTT_SUB_BITS;
+
+    if (rtt_us < sub_count) {
+        return rtt_us;
+    }
+
+    uint32_t octave = 31U - (uint32_t)__builtin_clz(rtt_us);
+    uint32_t sub = (rtt_us >> (octave - LOOPBACK_RTT_SUB_BITS)) & (sub_count - 1U);
+    uint32_t bucket = (octave - LOOPBACK_RTT_SUB_BITS + 1U) * sub_count + sub;
+    return (bucket < LOOPBACK_RTT_BUCKETS) ? bucket : LOOPBACK_RTT_BUCKETS - 1U;
+}
+
+static uint32_t loopback_rtt_bucket_max(uint32_t bucket)
+{
+    const uint32_t sub_count = 1U << LOOPBACK_RTT_SUB_BITS;
+
+    if (bucket < sub_count) {
+        return bucket;
+    }
+
+    uint32_t shift = bucket / sub_count - 1U;
+    uint32_t low = (sub_count + bucket % sub_count) << shift;
+    return low + (1U << shift) - 1U;
+}
+
+/**
+ * @brief RTT below which per_mille of the returned probes fall
+ */
+static uint32_t loopback_rtt_percentile(uint32_t per_mille)
+{
+    if (loopback.returned == 0) {
+        return 0;
+    }
+
+    uint64_t rank = ((uint64_t)loopback.returned * per_mille + 999U) / 1000U;
+    uint64_t seen = 0;
+
+    for (uint32_t bucket = 0; bucket < LOOPBACK_RTT_BUCKETS; bucket++) {
+        seen += loopback.rtt_hist[bucket];
+        if (seen >= rank) {
+            uint32_t bound = loopback_rtt_bucket_max(bucket);
+            return (bound < loopback.rtt_max_us) ? bound : loopback.rtt_max_us;
+        }
+    }
+    return loopback.rtt_max_us;
+}
+
+/**
+ * @brief A probe came back (RX context)
+ */
+static void handle_cmd_loopback_return(const protocol_packet_t *cmd)
+{
+    uint32_t now_us = (uint32_t)hal_timebase_now_us();
+
+    if (!loopback.running || cmd->length < LOOPBACK_PROBE_MIN) {
+        return;
+    }
+
+    const notify_loopback_probe_t *probe = (const notify_loopback_probe_t *)cmd->payload;
+    uint32_t probe_seq = probe->probe_seq;
+    bool intact = (cmd->length == loopback.payload_size);
+    for (uint32_t i = 0; intact && i < (uint32_t)cmd->length - LOOPBACK_PROBE_MIN; i++) {
+        intact = cmd->payload[LOOPBACK_PROBE_MIN + i] == loopback_pattern(probe_seq, i);
+    }
+
+    uint32_t mask = os_critical_enter();
+    loopback_slot_t *slot = &loopback.slots[probe_seq % LOOPBACK_MAX_WINDOW];
+    bool matched = slot->pending && slot->seq == probe_seq;
+    if (matched) {
+        // Late returns of probes already counted lost are ignored
+        slot->pending = false;
+        loopback.outstanding--;
+        if (intact) {
+            uint32_t rtt_us = now_us - slot->sent_us;
+            loopback.returned++;
+            loopback.rtt_hist[loopback_rtt_bucket(rtt_us)]++;
+            if (rtt_us < loopback.rtt_min_us) {
+                loopback.rtt_min_us = rtt_us;
+            }
+            if (rtt_us > loopback.rtt_max_us) {
+                loopback.rtt_max_us = rtt_us;
+            }
+        } else {
+            loopback.corrupt++;
+        }
+    }
+    os_critical_exit(mask);
+
+    if (matched && state.bulk_task_handle != NULL) {
+        os_task_notify(state.bulk_task_handle);
+    }
+}
+
+static bool credit_available(void)
+{
+    return !state.credit_mode || state.credits > 0;
+}
+
+/**
+ * @brief Spend a credit on one data frame (always succeeds with flow control off)
+ */
+static bool credit_try_take(void)
+{
+    if (!state.credit_mode) {
+        return true;
+    }
+
+    uint32_t mask = os_critical_enter();
+    bool taken = (state.credits > 0);
+    if (taken) {
+        state.credits--;
+    }
+    os_critical_exit(mask);
+    return taken;
+}
+
+/**
+ * @brief Bulk paths: wait until the host grants a credit for the next frame
+ * @return RESP_OK, RESP_TIMEOUT after PROTOCOL_TIMEOUT_MS, or RESP_ERROR if stopped
+ */
+static uint8_t credit_wait(void)
+{
+    if (credit_try_take()) {
+        return RESP_OK;
+    }
+
+    state.credit_stalls++;
+    uint32_t start = os_get_tick_count();
+    while (!credit_try_take()) {
+        if (state.bulk_stop_requested) {
+            return RESP_ERROR;
+        }
+        if ((os_get_tick_count() - start) >= PROTOCOL_TIMEOUT_MS) {
+            LOG_W(TAG, "No credit for %d ms, transfer abandoned", PROTOCOL_TIMEOUT_MS);
+            return RESP_TIMEOUT;
+        }
+        os_semaphore_take(state.credit_wake, CREDIT_POLL_MS);
+    }
+    return RESP_OK;
+}
+
+/**
+ * @brief Run a dump in its own task so the command task keeps serving commands
+ */
+static bool bulk_start(os_task_func_t task_func)
+{
+    state.bulk_active = true;
+    os_result_t ret = os_task_create(
+        task_func,
+        "proto_bulk",
+        BULK_TASK_STACK_SIZE,
+        NULL,
+        BULK_TASK_PRIORITY,
+        &state.bulk_task_handle);
+
+    if (ret != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create bulk task");
+        state.bulk_active = false;
+        bulk_send_done(RESP_ERROR, 0);
+        return false;
+    }
+
+    return true;
+}
+
+static void bulk_stop(void)
+{
+    if (!state.bulk_active) {
+        return;
+    }
+
+    state.bulk_stop_requested = true;
+
+    for (int i = 0; i < 100 && state.bulk_active; i++) {
+        os_delay_ms(10);
+    }
+
+    if (state.bulk_active && state.bulk_task_handle != NULL) {
+        os_task_delete(state.bulk_task_handle);
+        loopback.running = false;
+        if (state.capture_drain) {
+            current_monitor_drain_detach();  // The capture dump held it
+            state.capture_drain = false;
+        }
+    }
+    state.bulk_task_handle = NULL;
+    state.bulk_active = false;
+}
+
+/**
+ * @brief Read up to max samples of the requested buffer as sensor_sample_t
+ */
+static uint32_t bulk_read(uint8_t sensor_type, uint32_t index, sensor_sample_t *out, uint32_t max)
+{
+    if (sensor_type == SENSOR_TEMPERATURE) {
+        uint32_t samples_read = 0;
+        if (!temperature_sensor_buffer_read(index, out, max, &samples_read)) {
+            return 0;
+        }
+        return samples_read;
+    }
+
+    if (sensor_type == SENSOR_HUMIDITY) {
+        uint32_t samples_read = 0;
+        if (!temperature_sensor_humidity_read(index, out, max, &samples_read)) {
+            return 0;
+        }
+        return samples_read;
+    }
+
+    // Converted through a bounded stack chunk
+    current_sample_t raw[BULK_SAMPLES_PER_FRAME];
+    uint32_t total = 0;
+
+    while (total < max) {
+        uint32_t chunk = max - total;
+        if (chunk > BULK_SAMPLES_PER_FRAME) {
+            chunk = BULK_SAMPLES_PER_FRAME;
+        }
+
+        uint32_t samples_read = current_monitor_read_range(index + total, raw, chunk);
+        for (uint32_t i = 0; i < samples_read; i++) {
+            out[total + i].sensor_type = SENSOR_CURRENT;
+            out[total + i].timestamp = raw[i].timestamp_sec;
+            out[total + i].value = (int32_t)(raw[i].current_mA * 1000);  // Microamps, as in streaming
+        }
+
+        total += samples_read;
+        if (samples_read < chunk) {
+            break;
+        }
+    }
+    return total;
+}
+
+static void bulk_send_done(uint8_t status, uint32_t sample_count)
+{
+    notify_bulk_done_t *done = (notify_bulk_done_t *)bulk_frame.payload;
+    done->sensor_type = state.bulk_request.sensor_type;
+    done->status = status;
+    done->sample_count = sample_count;
+
+    bulk_frame.type = PACKET_TYPE_NOTIFY;
+    bulk_frame.cmd_id = NOTIFY_BULK_DONE;
+    bulk_frame.seq = state.bulk_seq;
+    bulk_frame.status = RESP_OK;
+    bulk_frame.length = sizeof(notify_bulk_done_t);
+
+    SYSVIEW_TRACE_U32x2(SYSVIEW_EVT_PROTO_NOTIFY, bulk_frame.cmd_id, bulk_frame.length);
+    state.transport->send((const uint8_t *)&bulk_frame,
+                          PROTOCOL_HEADER_SIZE + bulk_frame.length);
+}
+
+/**
+ * @brief Drain watermark: a frame's worth of records is waiting
+ */
+static void capture_drain_watermark(bool above, void *user_data)
+{
+    (void)user_data;
+    os_task_handle_t task = state.bulk_task_handle;
+    if (!above || task == NULL) {
+        return;
+    }
+    if (os_in_isr()) {
+        bool woken = false;
+        os_task_notify_from_isr(task, &woken);
+        os_yield_from_isr(woken);
+    } else {
+        os_task_notify(task);
+    }
+}
+
+/**
+ * @brief Offload current-monitor capture records (optionally following)
+ *
+ * Frames are built in the transport's TX slot itself: the framing layer
+ * keeps two, so the drain's samples are converted into one while the other
+ * is DMA-transmitted, and only the header, CRC and end marker are added
+ * around them (no staging frame, no copy into the slot).
+ */
+static void capture_task(void *param)
+{
+    (void)param;
+
+    const cmd_get_current_capture_t *req = &state.capture_request;
+    bool follow = (req->flags & CURRENT_CAPTURE_FLAG_FOLLOW) != 0;
+    uint32_t remaining = (req->count != 0) ? req->count : UINT32_MAX;
+    uint32_t sent = 0;
+    uint8_t status = RESP_OK;
+    uint32_t per_frame = bulk_frame_items(sizeof(notify_current_data_header_t), sizeof(current_record_t));
+
+    // Prefer the SPSC drain so the producer waits for us instead of
+    // overwriting; fall back to a plain cursor if another drain is attached
+    bool drain = current_monitor_drain_attach(req->start_index);
+    state.capture_drain = drain;
+    if (drain && follow) {
+        // Sleep until a full frame is waiting rather than polling it
+        current_monitor_drain_set_watermarks(per_frame, 0, capture_drain_watermark, NULL);
+    }
+    current_monitor_cursor_t cursor;
+    current_monitor_cursor_init(&cursor);
+    cursor.index = req->start_index;
+
+    LOG_I(TAG, "Capture dump started: start=%lu count=%lu follow=%d",
+          req->start_index, req->count, follow);
+
+    current_sample_t raw[CAPTURE_RECORDS_PER_FRAME];
+
+    while (remaining > 0 && !state.bulk_stop_requested) {
+        uint32_t want = (remaining < per_frame) ? remaining : per_frame;
+        uint32_t first_index;
+        uint32_t got;
+        if (drain) {
+            got = current_monitor_drain_read(raw, want, &first_index);
+        } else {
+            got = current_monitor_read_new(&cursor, raw, want);
+            first_index = cursor.index - got;
+        }
+
+        if (got == 0) {
+            // Caught up: wait for more only while following a running capture
+            if (follow && current_monitor_get_status() == MEASUREMENT_RUNNING) {
+                if (drain) {
+                    // The rest of a frame goes out after the wait times out
+                    os_task_notify_wait(BULK_FOLLOW_MAX_WAIT_MS);
+                } else {
+                    os_delay_ms(BULK_FOLLOW_POLL_MS);
+                }
+                continue;
+            }
+            break;
+        }
+
+        status = credit_wait();
+        if (status != RESP_OK) {
+            break;
+        }
+
+        // Blocks only while both framing TX slots are on the wire
+        uint16_t length = (uint16_t)(sizeof(notify_current_data_header_t) + got * sizeof(current_record_t));
+        size_t capacity = 0;
+        protocol_bulk_packet_t *frame = (protocol_bulk_packet_t *)state.transport->tx_reserve(&capacity);
+        if (frame == NULL) {
+            status = RESP_ERROR;
+            break;
+        }
+        if (capacity < PROTOCOL_HEADER_SIZE + (size_t)length) {
+            state.transport->tx_abort();
+            status = RESP_ERROR;
+            break;
+        }
+
+        notify_current_data_header_t *header = (notify_current_data_header_t *)frame->payload;
+        current_record_t *records = (current_record_t *)(frame->payload + sizeof(notify_current_data_header_t));
+        for (uint32_t i = 0; i < got; i++) {
+            records[i].timestamp_sec = raw[i].timestamp_sec;
+            records[i].timestamp_ms = raw[i].timestamp_ms;
+            records[i].state = raw[i].state_machine_state;
+            records[i].current_mA = raw[i].current_mA;
+            records[i].voltage_V = raw[i].voltage_V;
+            records[i].power_mW = raw[i].power_mW;
+        }
+
+        header->first_index = first_index;
+        header->record_count = (uint16_t)got;
+        header->dropped = drain ? current_monitor_drain_get_overruns() : cursor.dropped;
+
+        frame->type = PACKET_TYPE_NOTIFY;
+        frame->cmd_id = NOTIFY_CURRENT_DATA;
+        frame->seq = state.bulk_seq;
+        frame->status = RESP_OK;
+        frame->length = length;
+
+        SYSVIEW_TRACE_U32x2(SYSVIEW_EVT_PROTO_NOTIFY, frame->cmd_id, frame->length);
+        if (state.transport->tx_commit(PROTOCOL_HEADER_SIZE + length) != PROTOCOL_TRANSPORT_OK) {
+            status = RESP_ERROR;
+            break;
+        }
+
+        remaining -= got;
+        sent += got;
+    }
+
+    if (state.bulk_stop_requested) {
+        status = RESP_ERROR;
+    }
+
+    uint32_t dropped = drain ? current_monitor_drain_get_overruns() : cursor.dropped;
+    if (drain) {
+        current_monitor_drain_detach();
+        state.capture_drain = false;
+    }
+
+    bulk_send_done((sent == 0 && status == RESP_OK) ? RESP_NO_DATA : status, sent);
+
+    LOG_I(TAG, "Capture dump finished: %lu records, %lu dropped", sent, dropped);
+    state.bulk_active = false;
+    os_task_delete(NULL);  // Delete self
+}
+
+/**
+ * @brief Offload stored recorder blocks as raw bytes
+ */
+static void recording_task(void *param)
+{
+    (void)param;
+
+    protocol_bulk_packet_t *frame = &bulk_frame;
+    const cmd_get_recording_t *req = &state.recording_request;
+    uint32_t offset = req->offset;
+    uint32_t remaining = (req->length != 0) ? req->length : UINT32_MAX;
+    uint32_t sent = 0;
+    uint32_t busy_polls = 0;
+    uint8_t status = RESP_OK;
+    uint32_t per_frame = bulk_frame_items(sizeof(notify_recording_data_header_t), 1);
+
+    LOG_I(TAG, "Recording dump started: offset=%lu length=%lu", req->offset, req->length);
+
+    notify_recording_data_header_t *header = (notify_recording_data_header_t *)frame->payload;
+    uint8_t *data = frame->payload + sizeof(notify_recording_data_header_t);
+
+    while (remaining > 0 && !state.bulk_stop_requested) {
+        uint32_t want = (remaining < per_frame) ? remaining : per_frame;
+        uint32_t total = 0;
+        uint32_t got = recorder_read(offset, data, want, &total);
+
+        if (got == 0) {
+            // Storage busy with a block write: wait while there is more to read
+            if (offset < total && busy_polls++ < RECORDING_BUSY_POLLS) {
+                os_delay_ms(BULK_FOLLOW_POLL_MS);
+                continue;
+            }
+            if (offset < total) {
+                status = RESP_TIMEOUT;
+            }
+            break;
+        }
+        busy_polls = 0;
+
+        header->offset = offset;
+        header->total_bytes = total;
+        header->byte_count = (uint16_t)got;
+
+        frame->type = PACKET_TYPE_NOTIFY;
+        frame->cmd_id = NOTIFY_RECORDING_DATA;
+        frame->seq = state.bulk_seq;
+        frame->status = RESP_OK;
+        frame->length = (uint16_t)(sizeof(notify_recording_data_header_t) + got);
+
+        status = credit_wait();
+        if (status != RESP_OK) {
+            break;
+        }
+
+        SYSVIEW_TRACE_U32x2(SYSVIEW_EVT_PROTO_NOTIFY, frame->cmd_id, frame->length);
+        if (state.transport->send((const uint8_t *)frame,
+                                  PROTOCOL_HEADER_SIZE + frame->length) != PROTOCOL_TRANSPORT_OK) {
+            status = RESP_ERROR;
+            break;
+        }
+
+        offset += got;
+        remaining -= got;
+        sent += got;
+    }
+
+    if (state.bulk_stop_requested) {
+        status = RESP_ERROR;
+    }
+
+    bulk_send_done((sent == 0 && status == RESP_OK) ? RESP_NO_DATA : status, sent);
+
+    LOG_I(TAG, "Recording dump finished: %lu bytes", sent);
+    state.bulk_active = false;
+    os_task_delete(NULL);  // Delete self
+}
+
+/**
+ * @brief Count probes out longer than the timeout as lost
+ */
+static void loopback_expire(uint32_t now_us, uint32_t timeout_us)
+{
+    uint32_t mask = os_critical_enter();
+    for (uint32_t i = 0; i < LOOPBACK_MAX_WINDOW; i++) {
+        loopback_slot_t *slot = &loopback.slots[i];
+        if (slot->pending && now_us - slot->sent_us > timeout_us) {
+            slot->pending = false;
+            loopback.outstanding--;
+            loopback.lost++;
+        }
+    }
+    os_critical_exit(mask);
+}
+
+static void loopback_send_done(uint8_t status, uint32_t sent, uint32_t duration_us,
+                               const protocol_transport_stats_t *before)
+{
+    protocol_transport_stats_t after;
+    state.transport->get_stats(&after);
+
+    notify_loopback_done_t *done = (notify_loopback_done_t *)bulk_frame.payload;
+    uint64_t elapsed = (duration_us > 0) ? duration_us : 1U;
+
+    done->status = status;
+    done->payload_size = loopback.payload_size;
+    done->sent = sent;
+    done->returned = loopback.returned;
+    done->lost = loopback.lost;
+    done->corrupt = loopback.corrupt;
+    done->duration_us = duration_us;
+    done->frames_per_s = (uint32_t)((uint64_t)loopback.returned * 1000000U / elapsed);
+    done->bytes_per_s = (uint32_t)((uint64_t)loopback.returned * loopback.payload_size
+                                   * 1000000U / elapsed);
+    done->rtt_min_us = (loopback.returned > 0) ? loopback.rtt_min_us : 0;
+    done->rtt_p50_us = loopback_rtt_percentile(500);
+    done->rtt_p90_us = loopback_rtt_percentile(900);
+    done->rtt_p99_us = loopback_rtt_percentile(990);
+    done->rtt_max_us = loopback.rtt_max_us;
+    done->crc_errors = after.crc_errors - before->crc_errors;
+    done->framing_errors = after.framing_errors - before->framing_errors;
+    done->overflow_errors = after.overflow_errors - before->overflow_errors;
+    done->timeout_errors = after.timeout_errors - before->timeout_errors;
+
+    bulk_frame.type = PACKET_TYPE_NOTIFY;
+    bulk_frame.cmd_id = NOTIFY_LOOPBACK_DONE;
+    bulk_frame.seq = state.bulk_seq;
+    bulk_frame.status = RESP_OK;
+    bulk_frame.length = sizeof(notify_loopback_done_t);
+
+    SYSVIEW_TRACE_U32x2(SYSVIEW_EVT_PROTO_NOTIFY, bulk_frame.cmd_id, bulk_frame.length);
+    state.transport->send((const uint8_t *)&bulk_frame,
+                          PROTOCOL_HEADER_SIZE + bulk_frame.length);
+
+    LOG_I(TAG, "Loopback: %lu/%lu returned, %lu lost, %lu corrupt, %lu frames/s, "
+          "rtt p50=%lu p99=%lu max=%lu us", (unsigned long)done->returned,
+          (unsigned long)sent, (unsigned long)done->lost, (unsigned long)done->corrupt,
+          (unsigned long)done->frames_per_s, (unsigned long)done->rtt_p50_us,
+          (unsigned long)done->rtt_p99_us, (unsigned long)done->rtt_max_us);
+}
+
+/**
+ * @brief Loopback test: keep up to window probes out until count are answered
+ */
+static void loopback_task(void *param)
+{
+    (void)param;
+
+    protocol_bulk_packet_t *frame = &bulk_frame;
+    const cmd_loopback_test_t *req = &state.loopback_request;
+    uint32_t timeout_ms = (req->timeout_ms != 0) ? req->timeout_ms : LOOPBACK_DEFAULT_TIMEOUT_MS;
+    uint32_t timeout_us = timeout_ms * 1000U;
+    uint32_t next = 0;
+    uint8_t status = RESP_OK;
+    protocol_transport_stats_t before;
+
+    LOG_I(TAG, "Loopback started: count=%lu size=%u window=%u",
+          (unsigned long)req->count, req->payload_size, req->window);
+
+    notify_loopback_probe_t *probe = (notify_loopback_probe_t *)frame->payload;
+    uint8_t *pattern = frame->payload + LOOPBACK_PROBE_MIN;
+    uint32_t pattern_len = req->payload_size - LOOPBACK_PROBE_MIN;
+
+    state.transport->get_stats(&before);
+    uint32_t start_us = (uint32_t)hal_timebase_now_us();
+
+    while ((next < req->count || loopback.outstanding > 0) && !state.bulk_stop_requested) {
+        loopback_expire((uint32_t)hal_timebase_now_us(), timeout_us);
+
+        // A slot still pending (slow probe) holds back the probe that reuses it
+        while (next < req->count && loopback.outstanding < req->window
+               && !loopback.slots[next % LOOPBACK_MAX_WINDOW].pending) {
+            for (uint32_t i = 0; i < pattern_len; i++) {
+                pattern[i] = loopback_pattern(next, i);
+            }
+
+            frame->type = PACKET_TYPE_NOTIFY;
+            frame->cmd_id = NOTIFY_LOOPBACK_PROBE;
+            frame->seq = state.bulk_seq;
+            frame->status = RESP_OK;
+            frame->length = req->payload_size;
+
+            // Armed before it is sent: the return can beat the send call's return
+            uint32_t sent_us = (uint32_t)hal_timebase_now_us();
+            probe->probe_seq = next;
+            probe->sent_us = sent_us;
+
+            uint32_t mask = os_critical_enter();
+            loopback_slot_t *slot = &loopback.slots[next % LOOPBACK_MAX_WINDOW];
+            slot->seq = next;
+            slot->sent_us = sent_us;
+            slot->pending = true;
+            loopback.outstanding++;
+            os_critical_exit(mask);
+
+            if (state.transport->send((const uint8_t *)frame,
+                                      PROTOCOL_HEADER_SIZE + frame->length) != PROTOCOL_TRANSPORT_OK) {
+                status = RESP_ERROR;
+                break;
+            }
+            next++;
+        }
+        if (status != RESP_OK) {
+            break;
+        }
+
+        // Woken by each return; the poll bounds how late a timeout is seen
+        os_task_notify_wait(LOOPBACK_POLL_MS);
+    }
+
+    uint32_t duration_us = (uint32_t)hal_timebase_now_us() - start_us;
+    loopback.running = false;
+
+    if (state.bulk_stop_requested) {
+        status = RESP_ERROR;
+    }
+
+    loopback_send_done(status, next, duration_us, &before);
+
+    state.bulk_active = false;
+    os_task_delete(NULL);  // Delete self
+}
+
+/**
+ * @brief Read and send one NOTIFY_BULK_DATA frame of one channel
+ *
+ * @param sent Output: samples sent, 0 at the end of the buffer
+ * @return RESP_OK, or why the frame could not be queued
+ */
+static uint8_t bulk_send_frame(uint8_t sensor_type, uint32_t index, uint32_t want, uint32_t *sent)
+{
+    protocol_bulk_packet_t *frame = &bulk_frame;
+    notify_bulk_data_header_t *header = (notify_bulk_data_header_t *)frame->payload;
+    uint8_t *body = frame->payload + sizeof(notify_bulk_data_header_t);
+    size_t body_size = state.bulk_payload - sizeof(notify_bulk_data_header_t);
+    bool compact = state.compact_samples;
+
+    sensor_sample_t *samples = compact ? bulk_samples : (sensor_sample_t *)body;
+    uint32_t got = bulk_read(sensor_type, index, samples, want);
+    *sent = 0;
+    if (got == 0) {
+        return RESP_OK;  // End of buffer
+    }
+
+    size_t body_len = got * sizeof(sensor_sample_t);
+    if (compact) {
+        // Samples that did not fit are read again for the next frame
+        body_len = sample_codec_encode(samples, got, body, body_size, &got);
+    }
+
+    header->sensor_type = sensor_type;
+    header->first_index = index;
+    header->sample_count = (uint16_t)got;
+
+    frame->type = PACKET_TYPE_NOTIFY | (compact ? PACKET_TYPE_FLAG_COMPACT : 0);
+    frame->cmd_id = NOTIFY_BULK_DATA;
+    frame->seq = state.bulk_seq;
+    frame->status = RESP_OK;
+    frame->length = (uint16_t)(sizeof(notify_bulk_data_header_t) + body_len);
+
+    uint8_t status = credit_wait();
+    if (status != RESP_OK) {
+        return status;
+    }
+
+    SYSVIEW_TRACE_U32x2(SYSVIEW_EVT_PROTO_NOTIFY, frame->cmd_id, frame->length);
+    // Blocks only while both framing TX slots are on the wire
+    if (state.transport->send((const uint8_t *)frame,
+                              PROTOCOL_HEADER_SIZE + frame->length) != PROTOCOL_TRANSPORT_OK) {
+        return RESP_ERROR;
+    }
+
+    *sent = got;
+    return RESP_OK;
+}
+
+static void bulk_task(void *param)
+{
+    (void)param;
+
+    const cmd_bulk_dump_t *req = &state.bulk_request;
+    uint32_t sent = 0;
+    uint8_t status = RESP_OK;
+
+    LOG_I(TAG, "Bulk dump started: sensor=%d start=%lu count=%lu",
+          req->sensor_type, req->start_index, req->count);
+
+    // A multiplexed dump walks both climate channels, one frame each in turn
+    uint8_t channels[BULK_MAX_CHANNELS] = { req->sensor_type };
+    uint8_t channel_count = 1;
+    if (req->sensor_type == SENSOR_TEMP_HUMIDITY) {
+        channels[0] = SENSOR_TEMPERATURE;
+        channels[1] = SENSOR_HUMIDITY;
+        channel_count = 2;
+    }
+
+    uint32_t index[BULK_MAX_CHANNELS];
+    uint32_t remaining[BULK_MAX_CHANNELS];
+    uint8_t open = channel_count;
+    for (uint8_t c = 0; c < channel_count; c++) {
+        index[c] = req->start_index;
+        remaining[c] = (req->count != 0) ? req->count : UINT32_MAX;
+    }
+
+    uint32_t per_frame = state.compact_samples
+                         ? COMPACT_MAX_SAMPLES(state.bulk_payload - sizeof(notify_bulk_data_header_t))
+                         : bulk_frame_items(sizeof(notify_bulk_data_header_t), sizeof(sensor_sample_t));
+    while (open > 0 && status == RESP_OK && !state.bulk_stop_requested) {
+        for (uint8_t c = 0; c < channel_count && !state.bulk_stop_requested; c++) {
+            if (remaining[c] == 0) {
+                continue;
+            }
+
+            uint32_t want = (remaining[c] < per_frame) ? remaining[c] : per_frame;
+            uint32_t got = 0;
+            status = bulk_send_frame(channels[c], index[c], want, &got);
+            if (status != RESP_OK) {
+                break;
+            }
+
+            index[c] += got;
+            remaining[c] = (got == 0) ? 0 : remaining[c] - got;
+            sent += got;
+            if (remaining[c] == 0) {
+                open--;
+            }
+        }
+    }
+
+    if (state.bulk_stop_requested) {
+        status = RESP_ERROR;
+    }
+
+    bulk_send_done((sent == 0 && status == RESP_OK) ? RESP_NO_DATA : status, sent);
+
+    LOG_I(TAG, "Bulk dump finished: %lu samples", sent);
+    state.bulk_active = false;
+    os_task_delete(NULL);  // Delete self
+}
+
+/**
+ * @brief One ring being merged by export_task(), read ahead in small chunks
+ */
+typedef struct {
+    uint8_t sensor_type;
+    uint32_t next_index;            // Ring index of the next chunk
+    uint8_t head;                   // Next unmerged sample in window
+    uint8_t fill;                   // Samples in window
+    sensor_sample_t window[EXPORT_READ_AHEAD];
+} export_channel_t;
+
+static export_channel_t export_channels[EXPORT_MAX_CHANNELS];
 
-    if (temp_data->sensor_ok) {
-        state.last_temperature = temp_data->temperature;
-        state.last_humidity = temp_data->humidity;
-        state.temp_data_valid = true;
+/**
+ * @brief Samples a ring holds now (0 while it has nothing readable)
+ */
+static uint32_t export_ring_count(uint8_t sensor_type)
+{
+    switch (sensor_type) {
+        case SENSOR_TEMPERATURE:
+            return temperature_sensor_buffer_get_count();
+        case SENSOR_HUMIDITY:
+            return temperature_sensor_humidity_get_count();
+        case SENSOR_CURRENT: {
+            uint32_t first = 0;
+            uint32_t count = 0;
+            return current_monitor_get_buffered_range(&first, &count) ? count : 0;
+        }
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Index of the first sample with timestamp >= from (binary search)
+ */
+static uint32_t export_lower_bound(uint8_t sensor_type, uint32_t from_timestamp)
+{
+    uint32_t low = 0;
+    uint32_t high = export_ring_count(sensor_type);
+
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        sensor_sample_t sample;
+        if (bulk_read(sensor_type, mid, &sample, 1) == 0) {
+            high = mid;  // Shrank meanwhile
+        } else if (sample.timestamp < from_timestamp) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Oldest unmerged sample of a ring, refilling the window if needed
+ * @return NULL once the ring is exhausted
+ */
+static const sensor_sample_t *export_peek(export_channel_t *channel)
+{
+    if (channel->head == channel->fill) {
+        channel->fill = (uint8_t)bulk_read(channel->sensor_type, channel->next_index,
+                                           channel->window, EXPORT_READ_AHEAD);
+        channel->next_index += channel->fill;
+        channel->head = 0;
+    }
+    return (channel->head < channel->fill) ? &channel->window[channel->head] : NULL;
+}
+
+static void export_task(void *param)
+{
+    (void)param;
+
+    static const uint8_t ring_order[EXPORT_MAX_CHANNELS] = {
+        SENSOR_TEMPERATURE, SENSOR_HUMIDITY, SENSOR_CURRENT
+    };
+    const cmd_bulk_export_t *req = &state.export_request;
+    uint32_t remaining = (req->count != 0) ? req->count : UINT32_MAX;
+    uint32_t sent = 0;
+    uint8_t status = RESP_OK;
+
+    // Channels follow ring_order, so a timestamp tie keeps that order
+    uint8_t channel_count = 0;
+    for (uint8_t i = 0; i < EXPORT_MAX_CHANNELS; i++) {
+        uint8_t type = ring_order[i];
+        if (req->sensors != 0 && (req->sensors & (1U << type)) == 0) {
+            continue;
+        }
+        export_channel_t *channel = &export_channels[channel_count++];
+        channel->sensor_type = type;
+        channel->next_index = (req->from_timestamp != 0)
+                              ? export_lower_bound(type, req->from_timestamp) : 0;
+        channel->head = 0;
+        channel->fill = 0;
+    }
+
+    LOG_I(TAG, "Bulk export started: sensors=0x%02X from=%lu count=%lu",
+          req->sensors, req->from_timestamp, req->count);
+
+    protocol_bulk_packet_t *frame = &bulk_frame;
+    notify_bulk_data_header_t *header = (notify_bulk_data_header_t *)frame->payload;
+    sensor_sample_t *records = (sensor_sample_t *)(frame->payload + sizeof(notify_bulk_data_header_t));
+    uint32_t per_frame = bulk_frame_items(sizeof(notify_bulk_data_header_t), sizeof(sensor_sample_t));
+
+    while (remaining > 0 && !state.bulk_stop_requested) {
+        uint32_t count = 0;
+
+        // k-way merge; k <= 3, so a linear scan of the heads beats a heap
+        while (count < per_frame && count < remaining) {
+            export_channel_t *oldest = NULL;
+            const sensor_sample_t *oldest_sample = NULL;
+            for (uint8_t c = 0; c < channel_count; c++) {
+                const sensor_sample_t *sample = export_peek(&export_channels[c]);
+                if (sample != NULL
+                    && (oldest_sample == NULL || sample->timestamp < oldest_sample->timestamp)) {
+                    oldest = &export_channels[c];
+                    oldest_sample = sample;
+                }
+            }
+            if (oldest == NULL) {
+                break;  // Every ring exhausted
+            }
+            records[count++] = *oldest_sample;
+            oldest->head++;
+        }
+
+        if (count == 0) {
+            break;
+        }
+
+        header->sensor_type = SENSOR_MERGED;
+        header->first_index = sent;
+        header->sample_count = (uint16_t)count;
+
+        frame->type = PACKET_TYPE_NOTIFY;
+        frame->cmd_id = NOTIFY_BULK_DATA;
+        frame->seq = state.bulk_seq;
+        frame->status = RESP_OK;
+        frame->length = (uint16_t)(sizeof(notify_bulk_data_header_t) + count * sizeof(sensor_sample_t));
+
+        status = credit_wait();
+        if (status != RESP_OK) {
+            break;
+        }
+
+        SYSVIEW_TRACE_U32x2(SYSVIEW_EVT_PROTO_NOTIFY, frame->cmd_id, frame->length);
+        if (state.transport->send((const uint8_t *)frame,
+                                  PROTOCOL_HEADER_SIZE + frame->length) != PROTOCOL_TRANSPORT_OK) {
+            status = RESP_ERROR;
+            break;
+        }
+
+        remaining -= count;
+        sent += count;
+    }
+
+    if (state.bulk_stop_requested) {
+        status = RESP_ERROR;
+    }
+
+    bulk_send_done((sent == 0 && status == RESP_OK) ? RESP_NO_DATA : status, sent);
+
+    LOG_I(TAG, "Bulk export finished: %lu records", sent);
+    state.bulk_active = false;
+    os_task_delete(NULL);  // Delete self
+}
+
+/**
+ * @brief Send a session's collected batch as one NOTIFY_SENSOR_DATA
+ * @return false if held back for lack of credit (the batch is kept)
+ */
+static bool stream_flush_batch(stream_session_t *session)
+{
+    uint8_t payload[PROTOCOL_MAX_PAYLOAD_SIZE];
+    resp_buffer_data_header_t *header = (resp_buffer_data_header_t *)payload;
+    uint8_t *body = payload + sizeof(resp_buffer_data_header_t);
+    uint32_t count = session->batch_count;
+    size_t body_len = count * sizeof(sensor_sample_t);
+    uint8_t type_flags = 0;
+
+    if (session->batch == NULL) {
+        session->batch_count = 0;
+        return true;
+    }
+
+    if (!credit_try_take()) {
+        return false;
+    }
+
+    if (state.compact_samples) {
+        // PROTOCOL_STREAM_MAX_BATCH uncompressed samples always fit, so all are encoded
+        body_len = sample_codec_encode(session->batch, count, body,
+                                       sizeof(payload) - sizeof(resp_buffer_data_header_t), &count);
+        type_flags = PACKET_TYPE_FLAG_COMPACT;
+    } else {
+        memcpy(body, session->batch, body_len);
+    }
+
+    header->sensor_type = session->sensor;
+    header->sample_count = (uint16_t)count;
+    stream_drop_batch(session);
+    if (session->sensor == SENSOR_CURRENT) {
+        LATENCY_TRACE_MARK(LATENCY_STAGE_STREAM_FLUSH);
+    }
+
+    send_notification_flags(NOTIFY_SENSOR_DATA, type_flags, payload,
+                            (uint16_t)(sizeof(resp_buffer_data_header_t) + body_len));
+    return true;
+}
+
+/**
+ * @brief Discard a session's batch and return its buffer to the pool
+ */
+static void stream_drop_batch(stream_session_t *session)
+{
+    if (session->batch != NULL) {
+        mem_pool_free(&batch_pool, session->batch);
+        session->batch = NULL;
+    }
+    session->batch_count = 0;
+}
+
+static void stream_read_sample(sensor_type_t sensor, sensor_sample_t *sample)
+{
+    climate_reading_t climate = {0};
+
+    sample->sensor_type = sensor;
+    sample->timestamp = (uint32_t)(hal_timebase_now_us() / 1000U);  // ms since boot
+
+    switch (sensor) {
+        case SENSOR_TEMPERATURE:
+            if (last_value_load(&climate_value, &climate) && climate.valid) {
+                // Temperature in centi-degrees (e.g., 2350 = 23.50 C)
+                sample->value = (int32_t)(climate.temperature * 100);
+            } else {
+                sample->value = 0;
+            }
+            break;
+
+        case SENSOR_HUMIDITY:
+            // Relative humidity in centi-percent, from the same reading
+            sample->value = (last_value_load(&climate_value, &climate) && climate.valid)
+                                ? (int32_t)(climate.humidity * 100) : 0;
+            break;
+
+        case SENSOR_CURRENT: {
+            INA226_Data ina_data;
+            if (current_monitor_get_instant_reading(&ina_data)) {
+                // Current in microamps
+                sample->value = (int32_t)(ina_data.current_mA * 1000);
+            } else {
+                sample->value = 0;
+            }
+            break;
+        }
+
+        default:
+            sample->value = 0;
+            break;
+    }
+}
+
+/**
+ * @brief Run one session's due work
+ *
+ * @return Ticks until the session next needs service
+ */
+/**
+ * @brief Send one sample unbatched, or skip it without a credit
+ */
+static void stream_send_single(const sensor_sample_t *sample)
+{
+    if (credit_try_take()) {
+        if (sample->sensor_type == SENSOR_CURRENT) {
+            LATENCY_TRACE_MARK(LATENCY_STAGE_STREAM_FLUSH);
+        }
+        protocol_handler_send_sensor_sample(sample);
     } else {
-        state.temp_data_valid = false;
+        state.credit_stalls++;
+    }
+}
+
+static void stream_emit(stream_session_t *session, const sensor_sample_t *sample, uint32_t now)
+{
+    if (session->batch_size <= 1) {
+        stream_send_single(sample);
+        return;
+    }
+
+    // A full batch still held for credit: this sample is skipped
+    if (session->batch_count >= session->batch_size && !stream_flush_batch(session)) {
+        state.credit_stalls++;
+        return;
+    }
+
+    if (session->batch_count == 0) {
+        session->batch = mem_pool_alloc(&batch_pool);
+        if (session->batch == NULL) {
+            // No batch buffer: the sample still goes out, unbatched
+            stream_send_single(sample);
+            return;
+        }
+        session->batch_start_tick = now;
+    }
+    session->batch[session->batch_count++] = *sample;
+    if (session->batch_count >= session->batch_size) {
+        stream_flush_batch(session);
+    }
+}
+
+/**
+ * @brief Send current samples the monitor captured since the last pass
+ *
+ * Decimated to the stream interval by capture time. Samples keep their
+ * capture timestamps and need no I2C transaction of their own.
+ */
+static void stream_drain_current(stream_session_t *session, uint32_t now)
+{
+    current_sample_t raw[STREAM_DRAIN_CHUNK];
+    uint32_t count;
+
+    // Without credit the cursor stays put; the capture buffer holds the samples
+    while (credit_available()
+           && (count = current_monitor_read_new(&session->cursor, raw, STREAM_DRAIN_CHUNK)) > 0) {
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t tick = current_monitor_sample_tick(&raw[i]);
+            if (session->emitted && (tick - session->last_emit_tick) < session->interval_ms) {
+                continue;
+            }
+            session->last_emit_tick = tick;
+            session->emitted = true;
+
+            sensor_sample_t sample = {
+                .sensor_type = SENSOR_CURRENT,
+                .timestamp = tick,
+                .value = (int32_t)(raw[i].current_mA * 1000),  // Microamps
+            };
+            stream_emit(session, &sample, now);
+        }
+    }
+}
+
+/**
+ * @brief Auto batching: size the batch to the link load, once per link window update
+ *
+ * Doubles while the TX side nears saturation, halves while it idles; in
+ * between the size holds, so it does not flap around one threshold.
+ */
+static void stream_adapt(stream_session_t *session, uint32_t now)
+{
+    link_stats_t link;
+    if (!session->auto_batch || now - session->adapt_tick < LINK_STATS_SLOT_MS
+        || !link_stats_get(&link)) {
+        return;
+    }
+    session->adapt_tick = now;
+
+    uint32_t size = session->batch_size;
+    if (link.tx_busy_permille >= STREAM_AUTO_GROW_PERMILLE) {
+        size = (size * 2 > PROTOCOL_STREAM_MAX_BATCH) ? PROTOCOL_STREAM_MAX_BATCH : size * 2;
+    } else if (link.tx_busy_permille < STREAM_AUTO_SHRINK_PERMILLE) {
+        size = (size > 1) ? size / 2 : 1;
+    }
+    if (size == session->batch_size) {
+        return;
+    }
+
+    // Samples already past the new size go out first, in one batch
+    if (session->batch_count >= size && !stream_flush_batch(session)) {
+        return;  // Held for credit: decide again next time
+    }
+    LOG_D(TAG, "Stream %d: batch %d -> %lu (TX busy %u/1000)",
+          session->sensor, session->batch_size, (unsigned long)size, link.tx_busy_permille);
+    session->batch_size = (uint8_t)size;
+}
+
+static deadline_id_t stream_deadline_id(const stream_session_t *session)
+{
+    return (deadline_id_t)(DEADLINE_STREAM_0 + (session - state.streams));
+}
+
+static uint32_t stream_service(stream_session_t *session, uint32_t now)
+{
+    stream_adapt(session, now);
+
+    if ((int32_t)(now - session->next_sample_tick) >= 0) {
+        deadline_id_t deadline = stream_deadline_id(session);
+        deadline_monitor_begin(deadline, DEADLINE_RELEASE_MS_AGO(now - session->next_sample_tick));
+        if (session->sensor == SENSOR_CURRENT &&
+            current_monitor_get_status() == MEASUREMENT_RUNNING) {
+            // The service is already sampling: follow its buffer
+            stream_drain_current(session, now);
+        } else {
+            sensor_sample_t sample;
+            stream_read_sample(session->sensor, &sample);
+            stream_emit(session, &sample, now);
+        }
+
+        // Absolute grid: send time does not shift later samples. Slots that
+        // are already over are skipped (and counted) rather than burst out.
+        session->next_sample_tick += session->interval_ms;
+        if ((int32_t)(now - session->next_sample_tick) >= 0) {
+            state.stream_missed_deadlines += (now - session->next_sample_tick) / session->interval_ms + 1;
+            session->next_sample_tick = now + session->interval_ms;
+        }
+        deadline_monitor_end(deadline);
+    }
+
+    uint32_t wait = session->next_sample_tick - now;
+
+    if (session->batch_count > 0 && session->max_latency_ms != 0) {
+        uint32_t age = now - session->batch_start_tick;
+        // A mostly idle link has room for partial batches: send them early
+        if (age >= session->max_latency_ms || link_stats_tx_idle()) {
+            stream_flush_batch(session);
+        } else if (session->max_latency_ms - age < wait) {
+            wait = session->max_latency_ms - age;
+        }
+    }
+
+    return wait;
+}
+
+/**
+ * @brief Stream scheduler - multiplexes all active sessions
+ */
+static void stream_task(void *param)
+{
+    (void)param;
+
+    LOG_I(TAG, "Stream scheduler started");
+
+    while (!state.stream_stop_requested) {
+        uint32_t now = os_get_tick_count();
+        uint32_t next_deadline = now + STREAM_IDLE_WAIT_MS;
+
+        os_mutex_take(state.stream_mutex, OS_WAIT_FOREVER);
+        for (int i = 0; i < STREAM_MAX_SESSIONS; i++) {
+            stream_session_t *session = &state.streams[i];
+            if (!session->active) {
+                continue;
+            }
+
+            if (session->stop_requested) {
+                if (session->batch_count > 0 && !stream_flush_batch(session)) {
+                    stream_drop_batch(session);
+                }
+                session->active = false;
+                deadline_monitor_unregister(stream_deadline_id(session));
+                continue;
+            }
+
+            uint32_t session_deadline = now + stream_service(session, now);
+            if ((int32_t)(session_deadline - next_deadline) < 0) {
+                next_deadline = session_deadline;
+            }
+        }
+        os_mutex_give(state.stream_mutex);
+
+        // Sleep to the absolute deadline (delay-until semantics: the time spent
+        // sampling and sending above is not added to the period). Woken early
+        // by start/stop requests.
+        uint32_t after = os_get_tick_count();
+        if ((int32_t)(next_deadline - after) > 0) {
+            os_semaphore_take(state.stream_wake, next_deadline - after);
+        }
+    }
+
+    // Do not drop samples collected before the stop request
+    os_mutex_take(state.stream_mutex, OS_WAIT_FOREVER);
+    for (int i = 0; i < STREAM_MAX_SESSIONS; i++) {
+        if (state.streams[i].active && state.streams[i].batch_count > 0
+            && !stream_flush_batch(&state.streams[i])) {
+            stream_drop_batch(&state.streams[i]);
+        }
+        state.streams[i].active = false;
+        deadline_monitor_unregister(stream_deadline_id(&state.streams[i]));
+    }
+    os_mutex_give(state.stream_mutex);
+
+    LOG_I(TAG, "Stream task exiting");
+    state.streaming_active = false;
+    os_task_delete(NULL);  // Delete self
+}
+
+static void forward_count_drop(void)
+{
+    uint32_t mask = os_critical_enter();
+    state.forward_dropped++;
+    os_critical_exit(mask);
+}
+
+/**
+ * @brief Event bus callback of every forwarded type (bus dispatch task)
+ *
+ * Copies the event into the forwarder's queue and never blocks.
+ */
+static void forward_event_callback(event_t *event)
+{
+    if (event->type >= EVENT_FORWARD_TYPES || (state.forward_mask & (1UL << event->type)) == 0) {
+        return;
+    }
+
+    forward_event_t item = {
+        .type = (uint8_t)event->type,
+        .data_size = 0,
+        .timestamp = event->timestamp,
+    };
+    if (event->data != NULL) {
+        item.data_size = (event->data_size < PROTOCOL_EVENT_MAX_DATA)
+                         ? (uint8_t)event->data_size : PROTOCOL_EVENT_MAX_DATA;
+        memcpy(item.data, event->data, item.data_size);
+    }
+
+    if (os_queue_send(state.forward_queue, &item, OS_NO_WAIT) != OS_SUCCESS) {
+        forward_count_drop();
+    }
+}
+
+/**
+ * @brief Subscribe and unsubscribe so exactly the wanted types are forwarded
+ * @return The types now forwarded
+ */
+static uint32_t forward_set_mask(uint32_t wanted)
+{
+    for (uint8_t type = EVENT_NONE + 1; type < EVENT_FORWARD_TYPES; type++) {
+        uint32_t bit = 1UL << type;
+        if ((wanted & bit) && !(state.forward_mask & bit)) {
+            // Set first: the callback checks it
+            state.forward_mask |= bit;
+            if (!event_bus_subscribe((event_type_t)type, forward_event_callback)) {
+                state.forward_mask &= ~bit;
+            }
+        } else if (!(wanted & bit) && (state.forward_mask & bit)) {
+            state.forward_mask &= ~bit;
+            event_bus_unsubscribe((event_type_t)type, forward_event_callback);
+        }
+    }
+    return state.forward_mask;
+}
+
+/**
+ * @brief Send the collected records as one NOTIFY_EVENTS
+ * @return false if held back for lack of credit (the batch is kept)
+ */
+static bool forward_flush(uint8_t *payload, uint16_t *length, uint8_t *count)
+{
+    if (!credit_try_take()) {
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    uint32_t dropped = state.forward_dropped;
+    state.forward_dropped = 0;
+    os_critical_exit(mask);
+
+    notify_events_header_t *header = (notify_events_header_t *)payload;
+    header->event_count = *count;
+    header->dropped = (dropped > UINT16_MAX) ? UINT16_MAX : (uint16_t)dropped;
+    send_notification_flags(NOTIFY_EVENTS, 0, payload, *length);
+
+    *length = sizeof(notify_events_header_t);
+    *count = 0;
+    return true;
+}
+
+/**
+ * @brief Batch queued events into NOTIFY_EVENTS frames
+ */
+static void forward_task(void *param)
+{
+    (void)param;
+
+    uint8_t payload[PROTOCOL_MAX_PAYLOAD_SIZE];
+    uint16_t length = sizeof(notify_events_header_t);
+    uint8_t count = 0;
+    uint32_t batch_start = 0;
+    forward_event_t item;
+
+    while (!state.forward_stop_requested) {
+        uint32_t wait = OS_WAIT_FOREVER;
+        if (count > 0) {
+            uint32_t age = os_get_tick_count() - batch_start;
+            // Past the deadline only while held for credit: poll for it
+            wait = (age < state.forward_latency_ms) ? state.forward_latency_ms - age : CREDIT_POLL_MS;
+        }
+
+        // An event, the stop request or the batch deadline
+        void *member = os_queue_set_select(state.forward_inputs, wait);
+        if (member == state.forward_stop) {
+            os_semaphore_take(state.forward_stop, OS_NO_WAIT);
+        } else if (member != NULL &&
+                   os_queue_receive(state.forward_queue, &item, OS_NO_WAIT) == OS_SUCCESS) {
+            uint16_t record_length = (uint16_t)(sizeof(notify_event_record_t) + item.data_size);
+            if (length + record_length > sizeof(payload) && !forward_flush(payload, &length, &count)) {
+                forward_count_drop();
+                continue;
+            }
+
+            notify_event_record_t *record = (notify_event_record_t *)(payload + length);
+            record->event_type = item.type;
+            record->timestamp = item.timestamp;
+            record->data_size = item.data_size;
+            memcpy(payload + length + sizeof(notify_event_record_t), item.data, item.data_size);
+            length += record_length;
+            if (count++ == 0) {
+                batch_start = os_get_tick_count();
+            }
+        }
+
+        if (count > 0 && (count >= state.forward_batch_size
+                          || (os_get_tick_count() - batch_start) >= state.forward_latency_ms)) {
+            forward_flush(payload, &length, &count);
+        }
+    }
+
+    state.forward_task_running = false;
+    os_task_delete(NULL);  // Delete self
+}
+
+static bool forward_task_start(void)
+{
+    if (state.forward_task_running) {
+        return true;
+    }
+
+    // Kept across subscriptions: events may still be queued
+    if (state.forward_inputs == NULL) {
+        state.forward_queue = OS_QUEUE_CREATE_STATIC(forward);
+        state.forward_stop = OS_SEMAPHORE_CREATE_BINARY_STATIC(forward_stop);
+        state.forward_inputs = OS_QUEUE_SET_CREATE_STATIC(forward_inputs);
+        if (state.forward_queue == NULL || state.forward_stop == NULL || state.forward_inputs == NULL ||
+            os_queue_set_add(state.forward_inputs, state.forward_queue) != OS_SUCCESS ||
+            os_queue_set_add(state.forward_inputs, state.forward_stop) != OS_SUCCESS) {
+            LOG_E(TAG, "Failed to create event forward queue");
+            os_queue_set_delete(state.forward_inputs);
+            os_semaphore_delete(state.forward_stop);
+            os_queue_delete(state.forward_queue);
+            state.forward_inputs = NULL;
+            state.forward_stop = NULL;
+            state.forward_queue = NULL;
+            return false;
+        }
+    }
+
+    state.forward_stop_requested = false;
+    state.forward_task_running = true;
+    os_result_t ret = OS_TASK_CREATE_STATIC(forward, forward_task, "proto_events", NULL,
+                                            EVENT_FORWARD_PRIORITY, &state.forward_task_handle);
+    if (ret != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create event forward task");
+        state.forward_task_running = false;
+        return false;
+    }
+    return true;
+}
+
+static void forward_task_stop(void)
+{
+    forward_set_mask(0);
+    if (!state.forward_task_running) {
+        return;
+    }
+
+    state.forward_stop_requested = true;
+    os_semaphore_give(state.forward_stop);
+    for (int i = 0; i < STREAM_STOP_TIMEOUT_MS / 10 && state.forward_task_running; i++) {
+        os_delay_ms(10);
+    }
+
+    if (state.forward_task_running && state.forward_task_handle != NULL) {
+        os_task_delete(state.forward_task_handle);
+    }
+    state.forward_task_handle = NULL;
+    state.forward_task_running = false;
+}
+
+static void handle_cmd_subscribe_events(const protocol_packet_t *cmd)
+{
+    const cmd_subscribe_events_t *req = (const cmd_subscribe_events_t *)cmd->payload;
+    uint32_t wanted = req->event_mask & ~(1UL << EVENT_NONE);
+
+    if (wanted != 0 && !forward_task_start()) {
+        protocol_handler_send_response(
+            cmd->cmd_id, cmd->seq, RESP_ERROR, NULL, 0);
+        return;
+    }
+
+    state.forward_batch_size = (req->batch_size == 0) ? 1 : req->batch_size;
+    state.forward_latency_ms = (req->max_latency_ms != 0) ? req->max_latency_ms
+                                                          : EVENT_FORWARD_LATENCY_MS;
+
+    resp_subscribe_events_t resp = {
+        .event_mask = forward_set_mask(wanted),
+    };
+    LOG_I(TAG, "Forwarding events 0x%08lX (batch %d, latency %d ms)",
+          (unsigned long)resp.event_mask, state.forward_batch_size, state.forward_latency_ms);
+
+    protocol_handler_send_response(
+        cmd->cmd_id, cmd->seq, RESP_OK, &resp, sizeof(resp));
+}
+
+static void temperature_event_handler(event_t *event)
+{
+    if (event == NULL || event->data == NULL) {
+        return;
     }
+
+    const temperature_data_t *temp_data = (const temperature_data_t *)event->data;
+    climate_reading_t climate = {
+        .temperature = temp_data->temperature,
+        .humidity = temp_data->humidity,
+        .valid = temp_data->sensor_ok,
+    };
+
+    // Event dispatch task only: the cell's one writer
+    last_value_store(&climate_value, &climate);
 }
@@ -2,8 +2,8 @@
  * @file protocol_handler.h
  * @brief Protocol handler for ESP32-STM32 communication
  *
- * Sits on top of esp32_packet_framing layer.
- * Receives commands, dispatches to handlers, sends responses/notifications.
+ * Sits on top of a transport (protocol_transport.h), by default the
+ * esp32_packet_framing layer. Receives commands, dispatches to handlers, sends responses/notifications.
  */
 
 #ifndef PROTOCOL_HANDLER_H
@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "protocol_common.h"
+#include "protocol_transport.h"
 
 // ============================================================================
 // Error Codes
@@ -25,6 +26,32 @@ typedef enum {
     PROTO_HANDLER_ERR_INVALID_PARAM = -4,
 } proto_handler_status_t;
 
+// ============================================================================
+// Command Table
+// ============================================================================
+
+#define PROTOCOL_CMD_TABLE_SIZE     0x40    // Command IDs 0x00..0x3F (NOTIFY IDs start at 0x80)
+
+/**
+ * @brief Command handler, called in the protocol command task
+ *
+ * Must answer (protocol_handler_send_response()) or hand long work to a
+ * task of its own. Parsing goes on meanwhile, but queued commands wait
+ * until it returns; commands arriving with the queue full get RESP_BUSY.
+ */
+typedef void (*protocol_cmd_handler_t)(const protocol_packet_t *cmd);
+
+/**
+ * @brief Per-command dispatch counters
+ */
+typedef struct {
+    uint32_t count;                 /**< Handler calls */
+    uint32_t rejected;              /**< Payload below the registered minimum */
+    uint32_t busy;                  /**< Answered RESP_BUSY, command queue full */
+    uint64_t total_cycles;          /**< Time in the handler, CPU cycles */
+    uint32_t max_cycles;
+} protocol_cmd_stats_t;
+
 // ============================================================================
 // Public API
 // ============================================================================
@@ -32,11 +59,13 @@ typedef enum {
 /**
  * @brief Initialize protocol handler
  *
- * Initializes the packet framing layer and registers for incoming packets.
+ * Opens the transport and registers for incoming packets.
  *
- * @return PROTO_HANDLER_OK on success
+ * @param transport Link to run the protocol over (protocol_transport_uart)
+ * @return PROTO_HANDLER_OK on success, PROTO_HANDLER_ERR_INVALID_PARAM if
+ *         the transport's MTU or RX frames are too small
  */
-proto_handler_status_t protocol_handler_init(void);
+proto_handler_status_t protocol_handler_init(const protocol_transport_t *transport);
 
 /**
  * @brief Deinitialize protocol handler
@@ -98,13 +127,31 @@ proto_handler_status_t protocol_handler_send_sensor_sample(
 /**
  * @brief Start streaming sensor data
  *
+ * Each sensor streams as its own session with its own interval and
+ * batching; starting a sensor that is already streaming updates it.
+ *
  * @param sensor_type Which sensor to stream
  * @param interval_ms Interval between samples in ms
+ * @param batch_size Samples per notification (1 = unbatched,
+ *                   PROTOCOL_STREAM_BATCH_AUTO = follow the link load)
+ * @param max_latency_ms Flush deadline for a partial batch (0 = none)
  * @return PROTO_HANDLER_OK on success
  */
 proto_handler_status_t protocol_handler_start_stream(
     sensor_type_t sensor_type,
-    uint32_t interval_ms);
+    uint32_t interval_ms,
+    uint8_t batch_size,
+    uint16_t max_latency_ms);
+
+/**
+ * @brief Stop one sensor's stream, flushing its partial batch
+ *
+ * Other sessions keep running.
+ *
+ * @param sensor_type Sensor whose session to stop
+ * @return PROTO_HANDLER_OK on success
+ */
+proto_handler_status_t protocol_handler_stop_sensor_stream(sensor_type_t sensor_type);
 
 /**
  * @brief Stop streaming sensor data
@@ -120,4 +167,43 @@ proto_handler_status_t protocol_handler_stop_stream(void);
  */
 bool protocol_handler_is_streaming(void);
 
+/**
+ * @brief Register (or replace) the handler of a command
+ *
+ * Built-in commands are in the table from the start; registering one
+ * replaces it. Counters of the command restart from zero. Registered
+ * handlers run in the command task.
+ *
+ * @param cmd_id Command ID, below PROTOCOL_CMD_TABLE_SIZE
+ * @param handler Handler, NULL to remove the command (then RESP_INVALID_CMD)
+ * @param min_length Shorter payloads get RESP_INVALID_PARAM without calling the handler
+ * @return PROTO_HANDLER_OK, or PROTO_HANDLER_ERR_INVALID_PARAM
+ */
+proto_handler_status_t protocol_handler_register_command(
+    uint8_t cmd_id,
+    protocol_cmd_handler_t handler,
+    uint16_t min_length);
+
+/**
+ * @brief Get the dispatch counters of one command
+ *
+ * @param cmd_id Command ID
+ * @param stats Output
+ * @return false if no handler is registered for cmd_id
+ */
+bool protocol_handler_get_command_stats(uint8_t cmd_id, protocol_cmd_stats_t *stats);
+
+/**
+ * @brief Clear the dispatch counters of all commands
+ */
+void protocol_handler_reset_command_stats(void);
+
+/**
+ * @brief Wait until every queued command has been handled
+ *
+ * @param timeout_ms Longest wait
+ * @return false on timeout
+ */
+bool protocol_handler_wait_commands(uint32_t timeout_ms);
+
 #endif // PROTOCOL_HANDLER_H
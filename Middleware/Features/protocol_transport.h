@@ -0,0 +1,132 @@
+/**
+ * @file protocol_transport.h
+ * @brief Link interface for the protocol handler
+ *
+ * A transport moves whole protocol packets (header + payload) over one
+ * link. Framing, integrity checks and flow control are its business; the
+ * protocol handler only sees packets. Three are in the tree:
+ * protocol_transport_uart (the packet framing layer on USART2, the ESP32
+ * link), protocol_transport_usb (COBS frames over a CDC-ACM port on OTG
+ * FS, for offloading captures to a PC) and protocol_transport_rtt (the
+ * same frames over RTT channel 4, through the debug probe).
+ * PROTOCOL_TRANSPORT_USB / PROTOCOL_TRANSPORT_RTT select the one the
+ * services start; an Ethernet link would plug in the same way.
+ *
+ * Receive: the transport calls the callback given to open() with every
+ * packet that passed its checks. The packet stays valid for the callback
+ * only, unless rx_retain() keeps it; it then stays until rx_release(). The
+ * handler retains one packet per queued command, so a transport needs
+ * rx_frames of at least the command queue depth plus two (the packet being
+ * handled and the one being received).
+ *
+ * Send: send() copies the packet and queues it, blocking only while the
+ * transport's TX slots are all busy. tx_reserve()/tx_commit() build a
+ * packet in the TX slot itself; a transport without in-place TX can hand
+ * out a buffer of its own and send it in tx_commit().
+ *
+ * mtu is the largest packet the link carries. It sizes the bulk frames
+ * (up to PROTOCOL_BULK_MAX_PAYLOAD_SIZE) and must fit a full packet of
+ * PROTOCOL_MAX_PAYLOAD_SIZE.
+ *
+ * Optional operations are NULL when the capability bit is clear.
+ */
+
+#ifndef PROTOCOL_TRANSPORT_H
+#define PROTOCOL_TRANSPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Protocol link the services start: UART (ESP32) unless one of these is 1
+#ifndef PROTOCOL_TRANSPORT_USB
+#define PROTOCOL_TRANSPORT_USB  0
+#endif
+#ifndef PROTOCOL_TRANSPORT_RTT
+#define PROTOCOL_TRANSPORT_RTT  0
+#endif
+
+typedef enum {
+    PROTOCOL_TRANSPORT_OK = 0,
+    PROTOCOL_TRANSPORT_ERR_NOT_OPEN,
+    PROTOCOL_TRANSPORT_ERR_TOO_LARGE,       /**< Packet above the MTU */
+    PROTOCOL_TRANSPORT_ERR_TIMEOUT,         /**< No TX slot came free */
+    PROTOCOL_TRANSPORT_ERR_FAILED,
+} protocol_transport_status_t;
+
+// Capabilities
+#define PROTOCOL_TRANSPORT_CAP_COBS     (1UL << 0)  /**< set_framing(): COBS framing on request */
+#define PROTOCOL_TRANSPORT_CAP_RATE     (1UL << 1)  /**< Link rate switchable at runtime */
+
+typedef enum {
+    PROTOCOL_TRANSPORT_FRAMING_DEFAULT = 0, /**< The link's own framing (after open) */
+    PROTOCOL_TRANSPORT_FRAMING_COBS,
+} protocol_transport_framing_t;
+
+typedef enum {
+    PROTOCOL_TRANSPORT_EVENT_PACKET,        /**< Packet received (data, length) */
+    PROTOCOL_TRANSPORT_EVENT_RATE_FALLBACK, /**< Switched rate abandoned (length = rate in use) */
+} protocol_transport_event_type_t;
+
+typedef struct {
+    protocol_transport_event_type_t type;
+    uint8_t *data;
+    size_t length;
+} protocol_transport_event_t;
+
+typedef void (*protocol_transport_callback_t)(const protocol_transport_event_t *event, void *user_data);
+
+/**
+ * @brief Link counters (free-running, for deltas)
+ */
+typedef struct {
+    uint32_t packets_sent;
+    uint32_t packets_received;
+    uint32_t crc_errors;
+    uint32_t framing_errors;
+    uint32_t overflow_errors;
+    uint32_t timeout_errors;
+} protocol_transport_stats_t;
+
+typedef struct {
+    const char *name;
+    uint16_t mtu;                   /**< Largest packet, header included */
+    uint8_t rx_frames;              /**< Received packets that can be retained at once, plus one */
+    uint32_t caps;                  /**< PROTOCOL_TRANSPORT_CAP_* */
+    uint32_t throughput;            /**< Nominal wire bytes/s; 0 with CAP_RATE: get_rate() / 10 */
+
+    /** Bring up the link; callback runs in the transport's RX context */
+    protocol_transport_status_t (*open)(protocol_transport_callback_t callback, void *user_data);
+
+    void (*close)(void);
+
+    /** Copy and queue one packet */
+    protocol_transport_status_t (*send)(const uint8_t *packet, size_t length);
+
+    /** Next TX slot to build a packet in (NULL if none came free); holds TX until commit/abort */
+    uint8_t *(*tx_reserve)(size_t *capacity);
+    protocol_transport_status_t (*tx_commit)(size_t length);
+    void (*tx_abort)(void);
+
+    /** Keep a received packet past the callback (false if it cannot be kept) */
+    bool (*rx_retain)(const uint8_t *packet);
+    void (*rx_release)(const uint8_t *packet);
+
+    /** Link counters (packets and receive errors) */
+    void (*get_stats)(protocol_transport_stats_t *stats);
+
+    /** PROTOCOL_TRANSPORT_CAP_COBS: framing for both directions, from the next packet */
+    protocol_transport_status_t (*set_framing)(protocol_transport_framing_t framing);
+
+    /** PROTOCOL_TRANSPORT_CAP_RATE: switch once the queued packets left; with probation_ms > 0
+     *  the old rate comes back (RATE_FALLBACK) unless a packet arrives in time */
+    bool (*rate_supported)(uint32_t rate);
+    uint32_t (*get_rate)(void);
+    protocol_transport_status_t (*set_rate)(uint32_t rate, uint32_t probation_ms);
+} protocol_transport_t;
+
+extern const protocol_transport_t protocol_transport_uart;
+extern const protocol_transport_t protocol_transport_usb;
+extern const protocol_transport_t protocol_transport_rtt;
+
+#endif // PROTOCOL_TRANSPORT_H
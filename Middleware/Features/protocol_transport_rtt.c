@@ -0,0 +1,370 @@
+/**
+ * @file protocol_transport_rtt.c
+ * @brief Protocol transport over a SEGGER RTT channel (debug probe)
+ *
+ * Up-channel RTT_CHANNEL carries the packets to the host and down-channel
+ * RTT_CHANNEL the commands back, in the wire format of the USB link: a
+ * packet plus its CRC16-CCITT (big-endian), COBS-encoded and ended by
+ * 0x00. A J-Link reads RTT at MB/s while the core runs, which is enough
+ * for captures the UART cannot carry. tools/rtt_capture.py is the host
+ * side.
+ *
+ * The up buffer is RTT_UP_BUFFER_SIZE bytes (16 KB by default, set
+ * PROTOCOL_TRANSPORT_RTT_BUFFER_SIZE to change it) and runs in
+ * no-block-skip mode: a frame that does not fit is dropped whole and
+ * counted in overflow_errors, so a slow or absent probe never stalls the
+ * sender. The host sees the loss as a gap in the packet seqs (and in the
+ * CRC'd frames there is never half a packet). Streams that must not lose
+ * frames use the credit flow control on top, as on the other links.
+ *
+ * RX: RTT has no interrupt towards the target, so a task polls the down
+ * buffer every RX_POLL_MS and decodes into rx_frames, which consumers may
+ * retain as on the UART link. Framing is fixed: no COBS or rate capability.
+ */
+
+#include "protocol_transport.h"
+#include "protocol_common.h"
+#include "cobs.h"
+#include "crc16.h"
+#include "os_wrapper.h"
+#include "portable_log.h"
+#include "SEGGER_RTT.h"
+#include <string.h>
+
+#define TAG "rtt_link"
+
+#ifndef PROTOCOL_TRANSPORT_RTT_BUFFER_SIZE
+#define PROTOCOL_TRANSPORT_RTT_BUFFER_SIZE  16384
+#endif
+
+#define RTT_CHANNEL             4       // 0 text, 1 SystemView, 2 deferred log, 3 PC samples
+#define RTT_UP_BUFFER_SIZE      PROTOCOL_TRANSPORT_RTT_BUFFER_SIZE
+#define RTT_DOWN_BUFFER_SIZE    1024    // A few commands between two polls
+#define RTT_PACKET_MAX          (PROTOCOL_HEADER_SIZE + PROTOCOL_BULK_MAX_PAYLOAD_SIZE)
+#define RTT_CRC_SIZE            2
+#define RTT_FRAME_MAX           COBS_MAX_ENCODED_SIZE(RTT_PACKET_MAX + RTT_CRC_SIZE)
+#define RTT_TX_TIMEOUT_MS       100
+#define RTT_RX_FRAMES           6       // One being decoded, the rest retainable
+#define RTT_THROUGHPUT          200000  // Probe polling the up-buffer, nominal bytes/s
+#define RTT_RX_CHUNK            64
+#define RX_TASK_STACK_SIZE      2048
+#define RX_TASK_PRIORITY        10      // As the UART RX task
+#define RX_POLL_MS              10
+
+_Static_assert(RTT_UP_BUFFER_SIZE > RTT_FRAME_MAX, "The up buffer holds at least one frame");
+_Static_assert(RTT_CHANNEL < SEGGER_RTT_MAX_NUM_UP_BUFFERS && RTT_CHANNEL < SEGGER_RTT_MAX_NUM_DOWN_BUFFERS,
+               "SEGGER_RTT_Conf.h reserves the channel both ways");
+_Static_assert(RTT_RX_FRAMES >= 2 && RTT_RX_FRAMES < 32,
+               "rx_frames_held needs a decode frame and one bit per frame");
+
+typedef struct {
+    bool open;
+    protocol_transport_callback_t callback;
+    void *user_data;
+
+    // TX: the channel's only writer holds tx_mutex, so writes need no RTT lock
+    os_mutex_handle_t tx_mutex;
+
+    // RX
+    os_task_handle_t rx_task;
+    uint8_t *rx_buffer;                 // Frame being decoded (one of rx_frames)
+    cobs_decoder_t rx_cobs;
+    size_t rx_crc_pos;                  // Decoded bytes already CRC'd
+    uint16_t rx_crc;
+    bool rx_retained;                   // rx_buffer retained in the current callback
+    volatile uint32_t rx_frames_held;
+
+    protocol_transport_stats_t stats;
+} rtt_link_t;
+
+static rtt_link_t link = {0};
+static uint8_t up_buffer[RTT_UP_BUFFER_SIZE];
+static uint8_t down_buffer[RTT_DOWN_BUFFER_SIZE];
+static uint8_t tx_frame[RTT_FRAME_MAX];
+static uint8_t tx_slot[RTT_PACKET_MAX];     // Packet built in place by tx_reserve()
+static uint8_t rx_frames[RTT_RX_FRAMES][RTT_PACKET_MAX + RTT_CRC_SIZE];
+
+OS_MUTEX_DEFINE(rtt_tx);
+OS_TASK_DEFINE(rtt_rx, RX_TASK_STACK_SIZE);
+
+// ============================================================================
+// TX
+// ============================================================================
+
+/**
+ * @brief Frame a packet and write it to the up buffer, or drop it whole
+ * @note Caller holds tx_mutex
+ */
+static protocol_transport_status_t tx_write(const uint8_t *packet, size_t length)
+{
+    if (length > RTT_PACKET_MAX || (packet == NULL && length > 0)) {
+        return PROTOCOL_TRANSPORT_ERR_TOO_LARGE;
+    }
+
+    uint16_t crc = crc16_ccitt(CRC16_CCITT_INIT, packet, length);
+    uint8_t crc_bytes[RTT_CRC_SIZE] = { (uint8_t)(crc >> 8), (uint8_t)(crc & 0xFF) };
+    cobs_encoder_t enc;
+    cobs_encoder_init(&enc, tx_frame, sizeof(tx_frame));
+    cobs_encoder_write(&enc, packet, length);
+    cobs_encoder_write(&enc, crc_bytes, sizeof(crc_bytes));
+    size_t encoded = cobs_encoder_finish(&enc);
+
+    // Skip mode writes all of it or nothing
+    if (SEGGER_RTT_WriteNoLock(RTT_CHANNEL, tx_frame, (unsigned)encoded) != encoded) {
+        link.stats.overflow_errors++;
+        return PROTOCOL_TRANSPORT_OK;
+    }
+    link.stats.packets_sent++;
+    return PROTOCOL_TRANSPORT_OK;
+}
+
+// ============================================================================
+// RX
+// ============================================================================
+
+/**
+ * @brief Move the decoder to a free frame if the consumer kept the last one
+ */
+static void rx_frame_delivered(void)
+{
+    if (!link.rx_retained) {
+        return;
+    }
+    link.rx_retained = false;
+
+    uint32_t mask = os_critical_enter();
+    uint32_t held = link.rx_frames_held;
+    os_critical_exit(mask);
+
+    // rtt_rx_retain() made sure one is free; releases only add more
+    for (size_t i = 0; i < RTT_RX_FRAMES; i++) {
+        if ((held & (1UL << i)) == 0) {
+            link.rx_buffer = rx_frames[i];
+            break;
+        }
+    }
+    cobs_decoder_init(&link.rx_cobs, link.rx_buffer, sizeof(rx_frames[0]));
+}
+
+static int rx_frame_index(const uint8_t *data)
+{
+    uintptr_t offset = (uintptr_t)data - (uintptr_t)rx_frames[0];
+    if (data < rx_frames[0] || offset >= sizeof(rx_frames) || offset % sizeof(rx_frames[0]) != 0) {
+        return -1;
+    }
+    return (int)(offset / sizeof(rx_frames[0]));
+}
+
+static void rx_process(const uint8_t *data, size_t length)
+{
+    while (length > 0) {
+        size_t consumed;
+        cobs_decode_result_t result = cobs_decoder_feed(&link.rx_cobs, data, length, &consumed);
+
+        size_t decoded = link.rx_cobs.length;
+        if (decoded > link.rx_crc_pos) {
+            link.rx_crc = crc16_ccitt(link.rx_crc, &link.rx_buffer[link.rx_crc_pos],
+                                      decoded - link.rx_crc_pos);
+            link.rx_crc_pos = decoded;
+        }
+
+        if (result == COBS_DECODE_EMPTY) {
+            // Back-to-back delimiters, not a frame
+        } else if (result == COBS_DECODE_FRAME && decoded >= RTT_CRC_SIZE) {
+            if (link.rx_crc == 0) {
+                link.stats.packets_received++;
+                if (link.callback != NULL) {
+                    protocol_transport_event_t event = {
+                        .type = PROTOCOL_TRANSPORT_EVENT_PACKET,
+                        .data = link.rx_buffer,
+                        .length = decoded - RTT_CRC_SIZE,
+                    };
+                    link.callback(&event, link.user_data);
+                }
+                rx_frame_delivered();
+            } else {
+                link.stats.crc_errors++;
+            }
+        } else if (result != COBS_DECODE_MORE) {
+            link.stats.framing_errors++;
+        }
+
+        if (result != COBS_DECODE_MORE) {
+            cobs_decoder_reset(&link.rx_cobs);
+            link.rx_crc_pos = 0;
+            link.rx_crc = CRC16_CCITT_INIT;
+        }
+        data += consumed;
+        length -= consumed;
+    }
+}
+
+static void rx_task(void *arg)
+{
+    (void)arg;
+    uint8_t chunk[RTT_RX_CHUNK];
+
+    while (1) {
+        // Only reader of the down buffer
+        unsigned length;
+        while ((length = SEGGER_RTT_ReadNoLock(RTT_CHANNEL, chunk, sizeof(chunk))) > 0) {
+            rx_process(chunk, length);
+        }
+        os_delay_ms(RX_POLL_MS);
+    }
+}
+
+// ============================================================================
+// Transport operations
+// ============================================================================
+
+static protocol_transport_status_t rtt_open(protocol_transport_callback_t callback, void *user_data)
+{
+    if (link.open) {
+        return PROTOCOL_TRANSPORT_OK;
+    }
+
+    crc16_init();
+    link.callback = callback;
+    link.user_data = user_data;
+    memset(&link.stats, 0, sizeof(link.stats));
+
+    link.rx_buffer = rx_frames[0];
+    link.rx_frames_held = 0;
+    link.rx_retained = false;
+    link.rx_crc_pos = 0;
+    link.rx_crc = CRC16_CCITT_INIT;
+    cobs_decoder_init(&link.rx_cobs, link.rx_buffer, sizeof(rx_frames[0]));
+
+    SEGGER_RTT_ConfigUpBuffer(RTT_CHANNEL, "Protocol", up_buffer, sizeof(up_buffer),
+                              SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    SEGGER_RTT_ConfigDownBuffer(RTT_CHANNEL, "Protocol", down_buffer, sizeof(down_buffer),
+                                SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+
+    link.tx_mutex = OS_MUTEX_CREATE_STATIC(rtt_tx);
+    if (link.tx_mutex == NULL) {
+        LOG_E(TAG, "Failed to create TX lock");
+        return PROTOCOL_TRANSPORT_ERR_FAILED;
+    }
+
+    if (OS_TASK_CREATE_STATIC(rtt_rx, rx_task, "rtt_rx", NULL, RX_TASK_PRIORITY,
+                              &link.rx_task) != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create RX task");
+        os_mutex_delete(link.tx_mutex);
+        return PROTOCOL_TRANSPORT_ERR_FAILED;
+    }
+
+    link.open = true;
+    LOG_I(TAG, "RTT link on channel %d (%d byte up buffer)", RTT_CHANNEL, RTT_UP_BUFFER_SIZE);
+    return PROTOCOL_TRANSPORT_OK;
+}
+
+static void rtt_close(void)
+{
+    if (!link.open) {
+        return;
+    }
+
+    // The channel stays configured: the host may still read what is buffered
+    os_task_handle_t rx = link.rx_task;
+    link.rx_task = NULL;
+    os_task_delete(rx);
+    os_mutex_delete(link.tx_mutex);
+    link.callback = NULL;
+    link.open = false;
+}
+
+static protocol_transport_status_t rtt_send(const uint8_t *packet, size_t length)
+{
+    if (!link.open) {
+        return PROTOCOL_TRANSPORT_ERR_NOT_OPEN;
+    }
+    if (os_mutex_take(link.tx_mutex, RTT_TX_TIMEOUT_MS) != OS_SUCCESS) {
+        return PROTOCOL_TRANSPORT_ERR_TIMEOUT;
+    }
+    protocol_transport_status_t status = tx_write(packet, length);
+    os_mutex_give(link.tx_mutex);
+    return status;
+}
+
+// tx_slot is a staging buffer: the frame is encoded from it in tx_commit()
+static uint8_t *rtt_tx_reserve(size_t *capacity)
+{
+    if (!link.open || os_mutex_take(link.tx_mutex, RTT_TX_TIMEOUT_MS) != OS_SUCCESS) {
+        return NULL;
+    }
+    if (capacity != NULL) {
+        *capacity = sizeof(tx_slot);
+    }
+    return tx_slot;
+}
+
+static protocol_transport_status_t rtt_tx_commit(size_t length)
+{
+    protocol_transport_status_t status = tx_write(tx_slot, length);
+    os_mutex_give(link.tx_mutex);
+    return status;
+}
+
+static void rtt_tx_abort(void)
+{
+    os_mutex_give(link.tx_mutex);
+}
+
+static bool rtt_rx_retain(const uint8_t *packet)
+{
+    if (packet != link.rx_buffer || link.rx_retained) {
+        return false;
+    }
+
+    uint32_t bit = 1UL << rx_frame_index(packet);
+    uint32_t all = (1UL << RTT_RX_FRAMES) - 1;
+
+    uint32_t mask = os_critical_enter();
+    uint32_t held = link.rx_frames_held | bit;
+    if (held == all) {
+        os_critical_exit(mask);
+        return false;   // The decoder needs a free frame to continue into
+    }
+    link.rx_frames_held = held;
+    os_critical_exit(mask);
+
+    link.rx_retained = true;
+    return true;
+}
+
+static void rtt_rx_release(const uint8_t *packet)
+{
+    int index = rx_frame_index(packet);
+    if (index < 0) {
+        return;
+    }
+
+    uint32_t mask = os_critical_enter();
+    link.rx_frames_held &= ~(1UL << index);
+    os_critical_exit(mask);
+}
+
+static void rtt_get_stats(protocol_transport_stats_t *stats)
+{
+    uint32_t mask = os_critical_enter();
+    *stats = link.stats;
+    os_critical_exit(mask);
+}
+
+const protocol_transport_t protocol_transport_rtt = {
+    .name = "rtt",
+    .mtu = RTT_PACKET_MAX,
+    .rx_frames = RTT_RX_FRAMES,
+    .caps = 0,                                  // COBS framing always, no rate
+    .throughput = RTT_THROUGHPUT,
+    .open = rtt_open,
+    .close = rtt_close,
+    .send = rtt_send,
+    .tx_reserve = rtt_tx_reserve,
+    .tx_commit = rtt_tx_commit,
+    .tx_abort = rtt_tx_abort,
+    .rx_retain = rtt_rx_retain,
+    .rx_release = rtt_rx_release,
+    .get_stats = rtt_get_stats,
+};
@@ -0,0 +1,118 @@
+/**
+ * @file protocol_transport_uart.c
+ * @brief Protocol transport over the UART packet framing layer
+ */
+
+#include "protocol_transport.h"
+#include "esp32_packet_framing.h"
+
+static protocol_transport_callback_t rx_callback = NULL;
+static void *rx_user_data = NULL;
+
+static protocol_transport_status_t map_status(uart_driver_status_t status)
+{
+    switch (status) {
+        case UART_DRV_OK:
+            return PROTOCOL_TRANSPORT_OK;
+        case UART_DRV_ERR_NOT_INITIALIZED:
+            return PROTOCOL_TRANSPORT_ERR_NOT_OPEN;
+        case UART_DRV_ERR_PACKET_TOO_LARGE:
+            return PROTOCOL_TRANSPORT_ERR_TOO_LARGE;
+        case UART_DRV_ERR_TIMEOUT:
+            return PROTOCOL_TRANSPORT_ERR_TIMEOUT;
+        default:
+            return PROTOCOL_TRANSPORT_ERR_FAILED;
+    }
+}
+
+// Framing RX context: pass packets and rate fallbacks on, drop the rest
+static void uart_event(stm32_uart_event_t *event, void *user_data)
+{
+    (void)user_data;
+
+    protocol_transport_event_t out = { .data = event->data, .length = event->length };
+    if (event->type == STM32_UART_EVENT_PACKET_RECEIVED) {
+        out.type = PROTOCOL_TRANSPORT_EVENT_PACKET;
+    } else if (event->type == STM32_UART_EVENT_BAUD_FALLBACK) {
+        out.type = PROTOCOL_TRANSPORT_EVENT_RATE_FALLBACK;
+    } else {
+        return;
+    }
+
+    if (rx_callback != NULL) {
+        rx_callback(&out, rx_user_data);
+    }
+}
+
+static protocol_transport_status_t uart_open(protocol_transport_callback_t callback, void *user_data)
+{
+    rx_callback = callback;
+    rx_user_data = user_data;
+
+    stm32_uart_config_t config = stm32_uart_get_default_config();
+    config.callback = uart_event;
+    config.user_data = NULL;
+    return map_status(stm32_uart_init(&config));
+}
+
+static void uart_close(void)
+{
+    stm32_uart_deinit();
+    rx_callback = NULL;
+}
+
+static protocol_transport_status_t uart_send(const uint8_t *packet, size_t length)
+{
+    return map_status(stm32_uart_send_packet_async(packet, length));
+}
+
+static protocol_transport_status_t uart_tx_commit(size_t length)
+{
+    return map_status(stm32_uart_tx_commit(length));
+}
+
+static void uart_get_stats(protocol_transport_stats_t *stats)
+{
+    stm32_uart_stats_t uart;
+    if (stm32_uart_get_stats(&uart) != UART_DRV_OK) {
+        *stats = (protocol_transport_stats_t){0};
+        return;
+    }
+    stats->packets_sent = uart.packets_sent;
+    stats->packets_received = uart.packets_received;
+    stats->crc_errors = uart.crc_errors;
+    stats->framing_errors = uart.framing_errors;
+    stats->overflow_errors = uart.overflow_errors;
+    stats->timeout_errors = uart.timeout_errors;
+}
+
+static protocol_transport_status_t uart_set_framing(protocol_transport_framing_t framing)
+{
+    return map_status(stm32_uart_set_wire_mode((framing == PROTOCOL_TRANSPORT_FRAMING_COBS)
+                                               ? STM32_UART_WIRE_COBS : STM32_UART_WIRE_MARKERS));
+}
+
+static protocol_transport_status_t uart_set_rate(uint32_t rate, uint32_t probation_ms)
+{
+    return map_status(stm32_uart_set_baud_rate(rate, probation_ms));
+}
+
+const protocol_transport_t protocol_transport_uart = {
+    .name = "uart",
+    .mtu = STM32_UART_MAX_PACKET_SIZE - 6,      // Less START, LENGTH, CRC and END
+    .rx_frames = STM32_UART_RX_FRAMES,
+    .caps = PROTOCOL_TRANSPORT_CAP_COBS | PROTOCOL_TRANSPORT_CAP_RATE,
+    .open = uart_open,
+    .close = uart_close,
+    .send = uart_send,
+    .tx_reserve = stm32_uart_tx_reserve,
+    .tx_commit = uart_tx_commit,
+    .tx_abort = stm32_uart_tx_abort,
+    .rx_retain = stm32_uart_rx_retain,
+    .rx_release = stm32_uart_rx_release,
+    .get_stats = uart_get_stats,
+    .set_framing = uart_set_framing,
+    .rate_supported = stm32_uart_baud_rate_supported,
+    .get_rate = stm32_uart_get_baud_rate,
+    .set_rate = uart_set_rate,
+};
@@ -0,0 +1,496 @@
+/**
+ * @file protocol_transport_usb.c
+ * @brief Protocol transport over the USB CDC port (OTG FS)
+ *
+ * Same wire format as the UART link in COBS mode: a packet plus its
+ * CRC16-CCITT (big-endian), COBS-encoded and ended by 0x00. The CDC pipe
+ * is a byte stream, so the delimiter finds the packets again and host
+ * tools need only the one decoder for both links. Framing is fixed, so
+ * the transport has no COBS capability to negotiate, and no rate.
+ *
+ * TX is double-buffered: packets are encoded into the filling buffer while
+ * the other one is on the bus, and the TX_DONE interrupt swaps them. A
+ * steady stream leaves in transfers of up to USB_TX_BUFFER_SIZE bytes; a
+ * lone packet goes out at once. With the port closed (no DTR) packets are
+ * dropped with ERR_NOT_OPEN instead of waiting for a reader.
+ *
+ * RX: a task drains the endpoint packets through the COBS decoder into
+ * rx_frames, which consumers may retain as on the UART link.
+ */
+
+#include "protocol_transport.h"
+#include "protocol_common.h"
+#include "hal_usb.h"
+#include "cobs.h"
+#include "crc16.h"
+#include "os_wrapper.h"
+#include "portable_log.h"
+#include <string.h>
+
+#define TAG "usb_link"
+
+#define USB_PACKET_MAX          (PROTOCOL_HEADER_SIZE + PROTOCOL_BULK_MAX_PAYLOAD_SIZE)
+#define USB_CRC_SIZE            2
+#define USB_FRAME_MAX           COBS_MAX_ENCODED_SIZE(USB_PACKET_MAX + USB_CRC_SIZE)
+#define USB_TX_BUFFER_SIZE      4096    // Per buffer: several frames per transfer under load
+#define USB_TX_TIMEOUT_MS       100     // Both buffers full that long: the host stopped reading
+#define USB_RX_FRAMES           6       // One being decoded, the rest retainable
+#define USB_THROUGHPUT          800000  // Full-speed CDC bulk, nominal bytes/s
+#define RX_TASK_STACK_SIZE      2048
+#define RX_TASK_PRIORITY        10      // As the UART RX task
+#define RX_POLL_MS              50
+
+_Static_assert(USB_TX_BUFFER_SIZE >= USB_FRAME_MAX && USB_TX_BUFFER_SIZE <= HAL_USB_TX_MAX,
+               "A TX buffer holds at least one frame and fits one transfer");
+_Static_assert(USB_RX_FRAMES >= 2 && USB_RX_FRAMES < 32,
+               "rx_frames_held needs a decode frame and one bit per frame");
+
+typedef struct {
+    uint8_t data[USB_TX_BUFFER_SIZE];
+    uint32_t length;                // Bytes encoded (published)
+    uint32_t packets;
+} tx_buffer_t;
+
+typedef struct {
+    bool open;
+    protocol_transport_callback_t callback;
+    void *user_data;
+
+    // TX: tx_fill collects frames while the other buffer may be on the bus
+    os_mutex_handle_t tx_mutex;
+    os_semaphore_handle_t tx_space;     // Given on every finished transfer
+    uint32_t tx_fill;
+    bool tx_on_bus;
+    bool tx_writing;                    // A sender is encoding into tx_fill
+    volatile bool host_open;            // DTR: a program has the port open
+
+    // RX
+    os_task_handle_t rx_task;
+    uint8_t *rx_buffer;                 // Frame being decoded (one of rx_frames)
+    cobs_decoder_t rx_cobs;
+    size_t rx_crc_pos;                  // Decoded bytes already CRC'd
+    uint16_t rx_crc;
+    bool rx_retained;                   // rx_buffer retained in the current callback
+    volatile uint32_t rx_frames_held;
+
+    protocol_transport_stats_t stats;
+} usb_link_t;
+
+static usb_link_t link = {0};
+static tx_buffer_t tx_buffers[2];
+static uint8_t tx_slot[USB_PACKET_MAX];     // Packet built in place by tx_reserve()
+static uint8_t rx_frames[USB_RX_FRAMES][USB_PACKET_MAX + USB_CRC_SIZE];
+
+OS_MUTEX_DEFINE(usb_tx);
+OS_SEMAPHORE_DEFINE(usb_tx_space);
+OS_TASK_DEFINE(usb_rx, RX_TASK_STACK_SIZE);
+
+// ============================================================================
+// TX
+// ============================================================================
+
+/**
+ * @brief Put the filled buffer on the bus if the other one came back
+ * @note Interrupts masked (os_critical_enter() or the USB ISR)
+ */
+static void tx_kick(void)
+{
+    tx_buffer_t *fill = &tx_buffers[link.tx_fill];
+    if (link.tx_on_bus || link.tx_writing || fill->length == 0 || !link.host_open) {
+        return;
+    }
+    if (!hal_usb_cdc_transmit(fill->data, fill->length)) {
+        return;
+    }
+    link.tx_on_bus = true;
+    link.tx_fill ^= 1U;
+}
+
+/**
+ * @brief Forget everything queued (bus reset, port closed)
+ * @note Interrupts masked
+ */
+static void tx_drop_queued(void)
+{
+    if (!link.tx_writing) {
+        tx_buffers[link.tx_fill].length = 0;
+        tx_buffers[link.tx_fill].packets = 0;
+    }
+}
+
+/**
+ * @brief USB ISR: the buffer on the bus finished (or was dropped)
+ */
+static void tx_done(uint32_t bytes)
+{
+    tx_buffer_t *sent = &tx_buffers[link.tx_fill ^ 1U];
+    if (bytes > 0) {
+        link.stats.packets_sent += sent->packets;
+    }
+    sent->length = 0;
+    sent->packets = 0;
+    link.tx_on_bus = false;
+    tx_kick();
+}
+
+/**
+ * @brief Frame a packet into the filling buffer and start it if the bus is free
+ * @note Caller holds tx_mutex
+ */
+static protocol_transport_status_t tx_queue(const uint8_t *packet, size_t length)
+{
+    if (length > USB_PACKET_MAX || (packet == NULL && length > 0)) {
+        return PROTOCOL_TRANSPORT_ERR_TOO_LARGE;
+    }
+    size_t needed = COBS_MAX_ENCODED_SIZE(length + USB_CRC_SIZE);
+
+    // Room in the filling buffer, waiting for the bus to hand the other back
+    tx_buffer_t *fill;
+    for (;;) {
+        if (!link.host_open || !hal_usb_cdc_is_configured()) {
+            return PROTOCOL_TRANSPORT_ERR_NOT_OPEN;
+        }
+
+        uint32_t mask = os_critical_enter();
+        fill = &tx_buffers[link.tx_fill];
+        if (fill->length + needed <= USB_TX_BUFFER_SIZE) {
+            link.tx_writing = true;
+            os_critical_exit(mask);
+            break;
+        }
+        tx_kick();
+        bool swapped = tx_buffers[link.tx_fill].length == 0;
+        os_critical_exit(mask);
+
+        if (!swapped && os_semaphore_take(link.tx_space, USB_TX_TIMEOUT_MS) != OS_SUCCESS) {
+            link.stats.timeout_errors++;
+            return PROTOCOL_TRANSPORT_ERR_TIMEOUT;
+        }
+    }
+
+    // Encode outside the critical section; the ISR leaves tx_fill alone meanwhile
+    uint16_t crc = crc16_ccitt(CRC16_CCITT_INIT, packet, length);
+    uint8_t crc_bytes[USB_CRC_SIZE] = { (uint8_t)(crc >> 8), (uint8_t)(crc & 0xFF) };
+    cobs_encoder_t enc;
+    cobs_encoder_init(&enc, &fill->data[fill->length], USB_TX_BUFFER_SIZE - fill->length);
+    cobs_encoder_write(&enc, packet, length);
+    cobs_encoder_write(&enc, crc_bytes, sizeof(crc_bytes));
+    size_t encoded = cobs_encoder_finish(&enc);
+
+    uint32_t mask = os_critical_enter();
+    fill->length += (uint32_t)encoded;
+    fill->packets++;
+    link.tx_writing = false;
+    tx_kick();
+    os_critical_exit(mask);
+    return PROTOCOL_TRANSPORT_OK;
+}
+
+// ============================================================================
+// RX
+// ============================================================================
+
+/**
+ * @brief Move the decoder to a free frame if the consumer kept the last one
+ */
+static void rx_frame_delivered(void)
+{
+    if (!link.rx_retained) {
+        return;
+    }
+    link.rx_retained = false;
+
+    uint32_t mask = os_critical_enter();
+    uint32_t held = link.rx_frames_held;
+    os_critical_exit(mask);
+
+    // usb_rx_retain() made sure one is free; releases only add more
+    for (size_t i = 0; i < USB_RX_FRAMES; i++) {
+        if ((held & (1UL << i)) == 0) {
+            link.rx_buffer = rx_frames[i];
+            break;
+        }
+    }
+    cobs_decoder_init(&link.rx_cobs, link.rx_buffer, sizeof(rx_frames[0]));
+}
+
+static int rx_frame_index(const uint8_t *data)
+{
+    uintptr_t offset = (uintptr_t)data - (uintptr_t)rx_frames[0];
+    if (data < rx_frames[0] || offset >= sizeof(rx_frames) || offset % sizeof(rx_frames[0]) != 0) {
+        return -1;
+    }
+    return (int)(offset / sizeof(rx_frames[0]));
+}
+
+static void rx_process(const uint8_t *data, size_t length)
+{
+    while (length > 0) {
+        size_t consumed;
+        cobs_decode_result_t result = cobs_decoder_feed(&link.rx_cobs, data, length, &consumed);
+
+        size_t decoded = link.rx_cobs.length;
+        if (decoded > link.rx_crc_pos) {
+            link.rx_crc = crc16_ccitt(link.rx_crc, &link.rx_buffer[link.rx_crc_pos],
+                                      decoded - link.rx_crc_pos);
+            link.rx_crc_pos = decoded;
+        }
+
+        if (result == COBS_DECODE_EMPTY) {
+            // Back-to-back delimiters, not a frame
+        } else if (result == COBS_DECODE_FRAME && decoded >= USB_CRC_SIZE) {
+            if (link.rx_crc == 0) {
+                link.stats.packets_received++;
+                if (link.callback != NULL) {
+                    protocol_transport_event_t event = {
+                        .type = PROTOCOL_TRANSPORT_EVENT_PACKET,
+                        .data = link.rx_buffer,
+                        .length = decoded - USB_CRC_SIZE,
+                    };
+                    link.callback(&event, link.user_data);
+                }
+                rx_frame_delivered();
+            } else {
+                link.stats.crc_errors++;
+            }
+        } else if (result != COBS_DECODE_MORE) {
+            link.stats.framing_errors++;
+        }
+
+        if (result != COBS_DECODE_MORE) {
+            cobs_decoder_reset(&link.rx_cobs);
+            link.rx_crc_pos = 0;
+            link.rx_crc = CRC16_CCITT_INIT;
+        }
+        data += consumed;
+        length -= consumed;
+    }
+}
+
+static void rx_task(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        os_task_notify_wait(RX_POLL_MS);
+
+        const uint8_t *packet;
+        uint32_t length;
+        while ((length = hal_usb_cdc_rx_peek(&packet)) > 0) {
+            rx_process(packet, length);
+            hal_usb_cdc_rx_consume();
+        }
+    }
+}
+
+// ============================================================================
+// USB events (OTG_FS interrupt)
+// ============================================================================
+
+static void usb_event(const hal_usb_event_t *event, void *user_data)
+{
+    (void)user_data;
+    bool woken = false;
+
+    switch (event->type) {
+        case HAL_USB_EVENT_RX_DATA:
+            if (link.rx_task != NULL) {
+                os_task_notify_from_isr(link.rx_task, &woken);
+            }
+            break;
+
+        case HAL_USB_EVENT_TX_DONE:
+            tx_done(event->value);
+            os_semaphore_give_from_isr(link.tx_space, &woken);
+            break;
+
+        case HAL_USB_EVENT_LINE_STATE:
+            link.host_open = (event->value & 0x01U) != 0;
+            if (!link.host_open) {
+                tx_drop_queued();
+            }
+            break;
+
+        case HAL_USB_EVENT_RESET:
+            // The HAL dropped the transfer in flight without a TX_DONE
+            link.host_open = false;
+            tx_buffers[link.tx_fill ^ 1U].length = 0;
+            tx_buffers[link.tx_fill ^ 1U].packets = 0;
+            link.tx_on_bus = false;
+            tx_drop_queued();
+            os_semaphore_give_from_isr(link.tx_space, &woken);
+            break;
+
+        default:
+            break;
+    }
+
+    os_yield_from_isr(woken);
+}
+
+// ============================================================================
+// Transport operations
+// ============================================================================
+
+static protocol_transport_status_t usb_open(protocol_transport_callback_t callback, void *user_data)
+{
+    if (link.open) {
+        return PROTOCOL_TRANSPORT_OK;
+    }
+
+    crc16_init();
+    link.callback = callback;
+    link.user_data = user_data;
+    memset(&link.stats, 0, sizeof(link.stats));
+    memset(tx_buffers, 0, sizeof(tx_buffers));
+    link.tx_fill = 0;
+    link.tx_on_bus = false;
+    link.tx_writing = false;
+    link.host_open = false;
+
+    link.rx_buffer = rx_frames[0];
+    link.rx_frames_held = 0;
+    link.rx_retained = false;
+    link.rx_crc_pos = 0;
+    link.rx_crc = CRC16_CCITT_INIT;
+    cobs_decoder_init(&link.rx_cobs, link.rx_buffer, sizeof(rx_frames[0]));
+
+    link.tx_mutex = OS_MUTEX_CREATE_STATIC(usb_tx);
+    link.tx_space = OS_SEMAPHORE_CREATE_BINARY_STATIC(usb_tx_space);
+    if (link.tx_mutex == NULL || link.tx_space == NULL) {
+        LOG_E(TAG, "Failed to create TX lock");
+        return PROTOCOL_TRANSPORT_ERR_FAILED;
+    }
+
+    if (OS_TASK_CREATE_STATIC(usb_rx, rx_task, "usb_rx", NULL, RX_TASK_PRIORITY,
+                              &link.rx_task) != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create RX task");
+        os_semaphore_delete(link.tx_space);
+        os_mutex_delete(link.tx_mutex);
+        return PROTOCOL_TRANSPORT_ERR_FAILED;
+    }
+
+    if (!hal_usb_cdc_init(usb_event, NULL)) {
+        LOG_E(TAG, "USB device did not start");
+        os_task_delete(link.rx_task);
+        link.rx_task = NULL;
+        os_semaphore_delete(link.tx_space);
+        os_mutex_delete(link.tx_mutex);
+        return PROTOCOL_TRANSPORT_ERR_FAILED;
+    }
+
+    link.open = true;
+    LOG_I(TAG, "USB CDC link up, waiting for the host");
+    return PROTOCOL_TRANSPORT_OK;
+}
+
+static void usb_close(void)
+{
+    if (!link.open) {
+        return;
+    }
+
+    hal_usb_cdc_deinit();
+    os_task_handle_t rx = link.rx_task;
+    link.rx_task = NULL;
+    os_task_delete(rx);
+    os_semaphore_delete(link.tx_space);
+    os_mutex_delete(link.tx_mutex);
+    link.callback = NULL;
+    link.open = false;
+}
+
+static protocol_transport_status_t usb_send(const uint8_t *packet, size_t length)
+{
+    if (!link.open) {
+        return PROTOCOL_TRANSPORT_ERR_NOT_OPEN;
+    }
+    if (os_mutex_take(link.tx_mutex, USB_TX_TIMEOUT_MS) != OS_SUCCESS) {
+        return PROTOCOL_TRANSPORT_ERR_TIMEOUT;
+    }
+    protocol_transport_status_t status = tx_queue(packet, length);
+    os_mutex_give(link.tx_mutex);
+    return status;
+}
+
+// tx_slot is a staging buffer: the frame is encoded from it in tx_commit()
+static uint8_t *usb_tx_reserve(size_t *capacity)
+{
+    if (!link.open || os_mutex_take(link.tx_mutex, USB_TX_TIMEOUT_MS) != OS_SUCCESS) {
+        return NULL;
+    }
+    if (capacity != NULL) {
+        *capacity = sizeof(tx_slot);
+    }
+    return tx_slot;
+}
+
+static protocol_transport_status_t usb_tx_commit(size_t length)
+{
+    protocol_transport_status_t status = tx_queue(tx_slot, length);
+    os_mutex_give(link.tx_mutex);
+    return status;
+}
+
+static void usb_tx_abort(void)
+{
+    os_mutex_give(link.tx_mutex);
+}
+
+static bool usb_rx_retain(const uint8_t *packet)
+{
+    if (packet != link.rx_buffer || link.rx_retained) {
+        return false;
+    }
+
+    uint32_t bit = 1UL << rx_frame_index(packet);
+    uint32_t all = (1UL << USB_RX_FRAMES) - 1;
+
+    uint32_t mask = os_critical_enter();
+    uint32_t held = link.rx_frames_held | bit;
+    if (held == all) {
+        os_critical_exit(mask);
+        return false;   // The decoder needs a free frame to continue into
+    }
+    link.rx_frames_held = held;
+    os_critical_exit(mask);
+
+    link.rx_retained = true;
+    return true;
+}
+
+static void usb_rx_release(const uint8_t *packet)
+{
+    int index = rx_frame_index(packet);
+    if (index < 0) {
+        return;
+    }
+
+    uint32_t mask = os_critical_enter();
+    link.rx_frames_held &= ~(1UL << index);
+    os_critical_exit(mask);
+}
+
+static void usb_get_stats(protocol_transport_stats_t *stats)
+{
+    uint32_t mask = os_critical_enter();
+    *stats = link.stats;
+    os_critical_exit(mask);
+}
+
+const protocol_transport_t protocol_transport_usb = {
+    .name = "usb",
+    .mtu = USB_PACKET_MAX,
+    .rx_frames = USB_RX_FRAMES,
+    .caps = 0,                                  // COBS framing always, no rate
+    .throughput = USB_THROUGHPUT,
+    .open = usb_open,
+    .close = usb_close,
+    .send = usb_send,
+    .tx_reserve = usb_tx_reserve,
+    .tx_commit = usb_tx_commit,
+    .tx_abort = usb_tx_abort,
+    .rx_retain = usb_rx_retain,
+    .rx_release = usb_rx_release,
+    .get_stats = usb_get_stats,
+};
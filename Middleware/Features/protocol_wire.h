@@ -0,0 +1,2145 @@
+// Generated from protocol_common.idl by tools/protocol_gen.py: edit the IDL, not this file
+/**
+ * @file protocol_wire.h
+ * @brief Aligned payload structs and their wire conversion
+ *
+ * The packed structs of protocol_common.h match the wire byte for byte,
+ * so a payload is sent as it is built, but members at odd offsets (the
+ * int32 of sensor_sample_t) become byte-wise or unaligned accesses. Code
+ * that works on the fields converts instead: name_unpack() fills the
+ * aligned name_unpacked_t from the payload bytes in one pass and
+ * name_pack() writes it back, little-endian. NAME_WIRE_SIZE is the size
+ * on the wire, checked against the packed struct below.
+ *
+ * Same on both sides, like protocol_common.h.
+ */
+
+#ifndef PROTOCOL_WIRE_H
+#define PROTOCOL_WIRE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "protocol_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#define PROTOCOL_WIRE_ASSERT(cond, msg) static_assert(cond, msg)
+#else
+#define PROTOCOL_WIRE_ASSERT(cond, msg) _Static_assert(cond, msg)
+#endif
+
+// ============================================================================
+// Little-endian field access
+// ============================================================================
+
+static inline void wire_put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void wire_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline void wire_put_f32(uint8_t *p, float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    wire_put_u32(p, bits);
+}
+
+static inline uint16_t wire_get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t wire_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline float wire_get_f32(const uint8_t *p)
+{
+    uint32_t bits = wire_get_u32(p);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+// ============================================================================
+// cmd_get_buffer_data_t
+// ============================================================================
+
+#define CMD_GET_BUFFER_DATA_WIRE_SIZE 8
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_get_buffer_data_t) == CMD_GET_BUFFER_DATA_WIRE_SIZE, "cmd_get_buffer_data_t does not match the IDL");
+
+typedef struct {
+    uint32_t start_index;
+    uint32_t count;
+} cmd_get_buffer_data_unpacked_t;
+
+/** Write v as its 8 wire bytes; returns CMD_GET_BUFFER_DATA_WIRE_SIZE */
+static inline size_t cmd_get_buffer_data_pack(uint8_t *wire, const cmd_get_buffer_data_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->start_index);
+    wire_put_u32(wire + 4, v->count);
+    return CMD_GET_BUFFER_DATA_WIRE_SIZE;
+}
+
+/** Read CMD_GET_BUFFER_DATA_WIRE_SIZE wire bytes into v; returns CMD_GET_BUFFER_DATA_WIRE_SIZE */
+static inline size_t cmd_get_buffer_data_unpack(cmd_get_buffer_data_unpacked_t *v, const uint8_t *wire)
+{
+    v->start_index = wire_get_u32(wire + 0);
+    v->count = wire_get_u32(wire + 4);
+    return CMD_GET_BUFFER_DATA_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_start_measurement_t
+// ============================================================================
+
+#define CMD_START_MEASUREMENT_WIRE_SIZE 4
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_start_measurement_t) == CMD_START_MEASUREMENT_WIRE_SIZE, "cmd_start_measurement_t does not match the IDL");
+
+typedef struct {
+    uint32_t interval_ms;
+} cmd_start_measurement_unpacked_t;
+
+/** Write v as its 4 wire bytes; returns CMD_START_MEASUREMENT_WIRE_SIZE */
+static inline size_t cmd_start_measurement_pack(uint8_t *wire, const cmd_start_measurement_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->interval_ms);
+    return CMD_START_MEASUREMENT_WIRE_SIZE;
+}
+
+/** Read CMD_START_MEASUREMENT_WIRE_SIZE wire bytes into v; returns CMD_START_MEASUREMENT_WIRE_SIZE */
+static inline size_t cmd_start_measurement_unpack(cmd_start_measurement_unpacked_t *v, const uint8_t *wire)
+{
+    v->interval_ms = wire_get_u32(wire + 0);
+    return CMD_START_MEASUREMENT_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_set_rtc_t
+// ============================================================================
+
+#define CMD_SET_RTC_WIRE_SIZE 4
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_set_rtc_t) == CMD_SET_RTC_WIRE_SIZE, "cmd_set_rtc_t does not match the IDL");
+
+typedef struct {
+    uint32_t unix_time;
+} cmd_set_rtc_unpacked_t;
+
+/** Write v as its 4 wire bytes; returns CMD_SET_RTC_WIRE_SIZE */
+static inline size_t cmd_set_rtc_pack(uint8_t *wire, const cmd_set_rtc_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->unix_time);
+    return CMD_SET_RTC_WIRE_SIZE;
+}
+
+/** Read CMD_SET_RTC_WIRE_SIZE wire bytes into v; returns CMD_SET_RTC_WIRE_SIZE */
+static inline size_t cmd_set_rtc_unpack(cmd_set_rtc_unpacked_t *v, const uint8_t *wire)
+{
+    v->unix_time = wire_get_u32(wire + 0);
+    return CMD_SET_RTC_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_negotiate_version_t
+// ============================================================================
+
+#define CMD_NEGOTIATE_VERSION_WIRE_SIZE 1
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_negotiate_version_t) == CMD_NEGOTIATE_VERSION_WIRE_SIZE, "cmd_negotiate_version_t does not match the IDL");
+
+typedef struct {
+    uint8_t version;
+} cmd_negotiate_version_unpacked_t;
+
+/** Write v as its 1 wire bytes; returns CMD_NEGOTIATE_VERSION_WIRE_SIZE */
+static inline size_t cmd_negotiate_version_pack(uint8_t *wire, const cmd_negotiate_version_unpacked_t *v)
+{
+    wire[0] = v->version;
+    return CMD_NEGOTIATE_VERSION_WIRE_SIZE;
+}
+
+/** Read CMD_NEGOTIATE_VERSION_WIRE_SIZE wire bytes into v; returns CMD_NEGOTIATE_VERSION_WIRE_SIZE */
+static inline size_t cmd_negotiate_version_unpack(cmd_negotiate_version_unpacked_t *v, const uint8_t *wire)
+{
+    v->version = wire[0];
+    return CMD_NEGOTIATE_VERSION_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_hello_t
+// ============================================================================
+
+#define CMD_HELLO_WIRE_SIZE 7
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_hello_t) == CMD_HELLO_WIRE_SIZE, "cmd_hello_t does not match the IDL");
+
+typedef struct {
+    uint8_t version;
+    uint16_t max_payload;
+    uint32_t features;
+} cmd_hello_unpacked_t;
+
+/** Write v as its 7 wire bytes; returns CMD_HELLO_WIRE_SIZE */
+static inline size_t cmd_hello_pack(uint8_t *wire, const cmd_hello_unpacked_t *v)
+{
+    wire[0] = v->version;
+    wire_put_u16(wire + 1, v->max_payload);
+    wire_put_u32(wire + 3, v->features);
+    return CMD_HELLO_WIRE_SIZE;
+}
+
+/** Read CMD_HELLO_WIRE_SIZE wire bytes into v; returns CMD_HELLO_WIRE_SIZE */
+static inline size_t cmd_hello_unpack(cmd_hello_unpacked_t *v, const uint8_t *wire)
+{
+    v->version = wire[0];
+    v->max_payload = wire_get_u16(wire + 1);
+    v->features = wire_get_u32(wire + 3);
+    return CMD_HELLO_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_hello_t
+// ============================================================================
+
+#define RESP_HELLO_WIRE_SIZE 15
+PROTOCOL_WIRE_ASSERT(sizeof(resp_hello_t) == RESP_HELLO_WIRE_SIZE, "resp_hello_t does not match the IDL");
+
+typedef struct {
+    uint8_t version;
+    uint16_t max_payload;
+    uint16_t max_bulk_payload;
+    uint8_t window_size;
+    uint8_t max_stream_batch;
+    uint32_t features;
+    uint32_t stm32_features;
+} resp_hello_unpacked_t;
+
+/** Write v as its 15 wire bytes; returns RESP_HELLO_WIRE_SIZE */
+static inline size_t resp_hello_pack(uint8_t *wire, const resp_hello_unpacked_t *v)
+{
+    wire[0] = v->version;
+    wire_put_u16(wire + 1, v->max_payload);
+    wire_put_u16(wire + 3, v->max_bulk_payload);
+    wire[5] = v->window_size;
+    wire[6] = v->max_stream_batch;
+    wire_put_u32(wire + 7, v->features);
+    wire_put_u32(wire + 11, v->stm32_features);
+    return RESP_HELLO_WIRE_SIZE;
+}
+
+/** Read RESP_HELLO_WIRE_SIZE wire bytes into v; returns RESP_HELLO_WIRE_SIZE */
+static inline size_t resp_hello_unpack(resp_hello_unpacked_t *v, const uint8_t *wire)
+{
+    v->version = wire[0];
+    v->max_payload = wire_get_u16(wire + 1);
+    v->max_bulk_payload = wire_get_u16(wire + 3);
+    v->window_size = wire[5];
+    v->max_stream_batch = wire[6];
+    v->features = wire_get_u32(wire + 7);
+    v->stm32_features = wire_get_u32(wire + 11);
+    return RESP_HELLO_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_retransmit_t
+// ============================================================================
+
+#define CMD_RETRANSMIT_WIRE_SIZE 1
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_retransmit_t) == CMD_RETRANSMIT_WIRE_SIZE, "cmd_retransmit_t does not match the IDL");
+
+typedef struct {
+    uint8_t seq;
+} cmd_retransmit_unpacked_t;
+
+/** Write v as its 1 wire bytes; returns CMD_RETRANSMIT_WIRE_SIZE */
+static inline size_t cmd_retransmit_pack(uint8_t *wire, const cmd_retransmit_unpacked_t *v)
+{
+    wire[0] = v->seq;
+    return CMD_RETRANSMIT_WIRE_SIZE;
+}
+
+/** Read CMD_RETRANSMIT_WIRE_SIZE wire bytes into v; returns CMD_RETRANSMIT_WIRE_SIZE */
+static inline size_t cmd_retransmit_unpack(cmd_retransmit_unpacked_t *v, const uint8_t *wire)
+{
+    v->seq = wire[0];
+    return CMD_RETRANSMIT_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_get_status_t
+// ============================================================================
+
+#define RESP_GET_STATUS_WIRE_SIZE 12
+PROTOCOL_WIRE_ASSERT(sizeof(resp_get_status_t) == RESP_GET_STATUS_WIRE_SIZE, "resp_get_status_t does not match the IDL");
+
+typedef struct {
+    uint8_t state;
+    uint8_t error_code;
+    uint16_t buffer_count;
+    uint32_t uptime_sec;
+    uint16_t stream_missed_deadlines;
+    uint16_t loop_missed_deadlines;
+} resp_get_status_unpacked_t;
+
+/** Write v as its 12 wire bytes; returns RESP_GET_STATUS_WIRE_SIZE */
+static inline size_t resp_get_status_pack(uint8_t *wire, const resp_get_status_unpacked_t *v)
+{
+    wire[0] = v->state;
+    wire[1] = v->error_code;
+    wire_put_u16(wire + 2, v->buffer_count);
+    wire_put_u32(wire + 4, v->uptime_sec);
+    wire_put_u16(wire + 8, v->stream_missed_deadlines);
+    wire_put_u16(wire + 10, v->loop_missed_deadlines);
+    return RESP_GET_STATUS_WIRE_SIZE;
+}
+
+/** Read RESP_GET_STATUS_WIRE_SIZE wire bytes into v; returns RESP_GET_STATUS_WIRE_SIZE */
+static inline size_t resp_get_status_unpack(resp_get_status_unpacked_t *v, const uint8_t *wire)
+{
+    v->state = wire[0];
+    v->error_code = wire[1];
+    v->buffer_count = wire_get_u16(wire + 2);
+    v->uptime_sec = wire_get_u32(wire + 4);
+    v->stream_missed_deadlines = wire_get_u16(wire + 8);
+    v->loop_missed_deadlines = wire_get_u16(wire + 10);
+    return RESP_GET_STATUS_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_get_status_if_changed_t
+// ============================================================================
+
+#define CMD_GET_STATUS_IF_CHANGED_WIRE_SIZE 4
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_get_status_if_changed_t) == CMD_GET_STATUS_IF_CHANGED_WIRE_SIZE, "cmd_get_status_if_changed_t does not match the IDL");
+
+typedef struct {
+    uint32_t since_version;
+} cmd_get_status_if_changed_unpacked_t;
+
+/** Write v as its 4 wire bytes; returns CMD_GET_STATUS_IF_CHANGED_WIRE_SIZE */
+static inline size_t cmd_get_status_if_changed_pack(uint8_t *wire, const cmd_get_status_if_changed_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->since_version);
+    return CMD_GET_STATUS_IF_CHANGED_WIRE_SIZE;
+}
+
+/** Read CMD_GET_STATUS_IF_CHANGED_WIRE_SIZE wire bytes into v; returns CMD_GET_STATUS_IF_CHANGED_WIRE_SIZE */
+static inline size_t cmd_get_status_if_changed_unpack(cmd_get_status_if_changed_unpacked_t *v, const uint8_t *wire)
+{
+    v->since_version = wire_get_u32(wire + 0);
+    return CMD_GET_STATUS_IF_CHANGED_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_status_snapshot_t
+// ============================================================================
+
+#define RESP_STATUS_SNAPSHOT_WIRE_SIZE 16
+PROTOCOL_WIRE_ASSERT(sizeof(resp_status_snapshot_t) == RESP_STATUS_SNAPSHOT_WIRE_SIZE, "resp_status_snapshot_t does not match the IDL");
+
+typedef struct {
+    uint32_t version;
+    resp_get_status_unpacked_t status;
+} resp_status_snapshot_unpacked_t;
+
+/** Write v as its 16 wire bytes; returns RESP_STATUS_SNAPSHOT_WIRE_SIZE */
+static inline size_t resp_status_snapshot_pack(uint8_t *wire, const resp_status_snapshot_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->version);
+    resp_get_status_pack(wire + 4, &v->status);
+    return RESP_STATUS_SNAPSHOT_WIRE_SIZE;
+}
+
+/** Read RESP_STATUS_SNAPSHOT_WIRE_SIZE wire bytes into v; returns RESP_STATUS_SNAPSHOT_WIRE_SIZE */
+static inline size_t resp_status_snapshot_unpack(resp_status_snapshot_unpacked_t *v, const uint8_t *wire)
+{
+    v->version = wire_get_u32(wire + 0);
+    resp_get_status_unpack(&v->status, wire + 4);
+    return RESP_STATUS_SNAPSHOT_WIRE_SIZE;
+}
+
+// ============================================================================
+// sensor_sample_t
+// ============================================================================
+
+#define SENSOR_SAMPLE_WIRE_SIZE 9
+PROTOCOL_WIRE_ASSERT(sizeof(sensor_sample_t) == SENSOR_SAMPLE_WIRE_SIZE, "sensor_sample_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint32_t timestamp;
+    int32_t value;
+} sensor_sample_unpacked_t;
+
+/** Write v as its 9 wire bytes; returns SENSOR_SAMPLE_WIRE_SIZE */
+static inline size_t sensor_sample_pack(uint8_t *wire, const sensor_sample_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire_put_u32(wire + 1, v->timestamp);
+    wire_put_u32(wire + 5, (uint32_t)v->value);
+    return SENSOR_SAMPLE_WIRE_SIZE;
+}
+
+/** Read SENSOR_SAMPLE_WIRE_SIZE wire bytes into v; returns SENSOR_SAMPLE_WIRE_SIZE */
+static inline size_t sensor_sample_unpack(sensor_sample_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->timestamp = wire_get_u32(wire + 1);
+    v->value = (int32_t)wire_get_u32(wire + 5);
+    return SENSOR_SAMPLE_WIRE_SIZE;
+}
+
+// ============================================================================
+// sensor_rollup_record_t
+// ============================================================================
+
+#define SENSOR_ROLLUP_RECORD_WIRE_SIZE 18
+PROTOCOL_WIRE_ASSERT(sizeof(sensor_rollup_record_t) == SENSOR_ROLLUP_RECORD_WIRE_SIZE, "sensor_rollup_record_t does not match the IDL");
+
+typedef struct {
+    uint32_t timestamp;
+    int32_t min;
+    int32_t max;
+    int32_t mean;
+    uint16_t count;
+} sensor_rollup_record_unpacked_t;
+
+/** Write v as its 18 wire bytes; returns SENSOR_ROLLUP_RECORD_WIRE_SIZE */
+static inline size_t sensor_rollup_record_pack(uint8_t *wire, const sensor_rollup_record_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->timestamp);
+    wire_put_u32(wire + 4, (uint32_t)v->min);
+    wire_put_u32(wire + 8, (uint32_t)v->max);
+    wire_put_u32(wire + 12, (uint32_t)v->mean);
+    wire_put_u16(wire + 16, v->count);
+    return SENSOR_ROLLUP_RECORD_WIRE_SIZE;
+}
+
+/** Read SENSOR_ROLLUP_RECORD_WIRE_SIZE wire bytes into v; returns SENSOR_ROLLUP_RECORD_WIRE_SIZE */
+static inline size_t sensor_rollup_record_unpack(sensor_rollup_record_unpacked_t *v, const uint8_t *wire)
+{
+    v->timestamp = wire_get_u32(wire + 0);
+    v->min = (int32_t)wire_get_u32(wire + 4);
+    v->max = (int32_t)wire_get_u32(wire + 8);
+    v->mean = (int32_t)wire_get_u32(wire + 12);
+    v->count = wire_get_u16(wire + 16);
+    return SENSOR_ROLLUP_RECORD_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_buffer_data_header_t
+// ============================================================================
+
+#define RESP_BUFFER_DATA_HEADER_WIRE_SIZE 3
+PROTOCOL_WIRE_ASSERT(sizeof(resp_buffer_data_header_t) == RESP_BUFFER_DATA_HEADER_WIRE_SIZE, "resp_buffer_data_header_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint16_t sample_count;
+} resp_buffer_data_header_unpacked_t;
+
+/** Write v as its 3 wire bytes; returns RESP_BUFFER_DATA_HEADER_WIRE_SIZE */
+static inline size_t resp_buffer_data_header_pack(uint8_t *wire, const resp_buffer_data_header_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire_put_u16(wire + 1, v->sample_count);
+    return RESP_BUFFER_DATA_HEADER_WIRE_SIZE;
+}
+
+/** Read RESP_BUFFER_DATA_HEADER_WIRE_SIZE wire bytes into v; returns RESP_BUFFER_DATA_HEADER_WIRE_SIZE */
+static inline size_t resp_buffer_data_header_unpack(resp_buffer_data_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->sample_count = wire_get_u16(wire + 1);
+    return RESP_BUFFER_DATA_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_get_buffer_range_t
+// ============================================================================
+
+#define CMD_GET_BUFFER_RANGE_WIRE_SIZE 10
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_get_buffer_range_t) == CMD_GET_BUFFER_RANGE_WIRE_SIZE, "cmd_get_buffer_range_t does not match the IDL");
+
+typedef struct {
+    uint32_t from_timestamp;
+    uint32_t to_timestamp;
+    uint16_t count;
+} cmd_get_buffer_range_unpacked_t;
+
+/** Write v as its 10 wire bytes; returns CMD_GET_BUFFER_RANGE_WIRE_SIZE */
+static inline size_t cmd_get_buffer_range_pack(uint8_t *wire, const cmd_get_buffer_range_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->from_timestamp);
+    wire_put_u32(wire + 4, v->to_timestamp);
+    wire_put_u16(wire + 8, v->count);
+    return CMD_GET_BUFFER_RANGE_WIRE_SIZE;
+}
+
+/** Read CMD_GET_BUFFER_RANGE_WIRE_SIZE wire bytes into v; returns CMD_GET_BUFFER_RANGE_WIRE_SIZE */
+static inline size_t cmd_get_buffer_range_unpack(cmd_get_buffer_range_unpacked_t *v, const uint8_t *wire)
+{
+    v->from_timestamp = wire_get_u32(wire + 0);
+    v->to_timestamp = wire_get_u32(wire + 4);
+    v->count = wire_get_u16(wire + 8);
+    return CMD_GET_BUFFER_RANGE_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_buffer_range_header_t
+// ============================================================================
+
+#define RESP_BUFFER_RANGE_HEADER_WIRE_SIZE 7
+PROTOCOL_WIRE_ASSERT(sizeof(resp_buffer_range_header_t) == RESP_BUFFER_RANGE_HEADER_WIRE_SIZE, "resp_buffer_range_header_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint32_t first_index;
+    uint16_t sample_count;
+} resp_buffer_range_header_unpacked_t;
+
+/** Write v as its 7 wire bytes; returns RESP_BUFFER_RANGE_HEADER_WIRE_SIZE */
+static inline size_t resp_buffer_range_header_pack(uint8_t *wire, const resp_buffer_range_header_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire_put_u32(wire + 1, v->first_index);
+    wire_put_u16(wire + 5, v->sample_count);
+    return RESP_BUFFER_RANGE_HEADER_WIRE_SIZE;
+}
+
+/** Read RESP_BUFFER_RANGE_HEADER_WIRE_SIZE wire bytes into v; returns RESP_BUFFER_RANGE_HEADER_WIRE_SIZE */
+static inline size_t resp_buffer_range_header_unpack(resp_buffer_range_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->first_index = wire_get_u32(wire + 1);
+    v->sample_count = wire_get_u16(wire + 5);
+    return RESP_BUFFER_RANGE_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_get_history_t
+// ============================================================================
+
+#define CMD_GET_HISTORY_WIRE_SIZE 8
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_get_history_t) == CMD_GET_HISTORY_WIRE_SIZE, "cmd_get_history_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint8_t tier;
+    uint32_t from_timestamp;
+    uint16_t count;
+} cmd_get_history_unpacked_t;
+
+/** Write v as its 8 wire bytes; returns CMD_GET_HISTORY_WIRE_SIZE */
+static inline size_t cmd_get_history_pack(uint8_t *wire, const cmd_get_history_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire[1] = v->tier;
+    wire_put_u32(wire + 2, v->from_timestamp);
+    wire_put_u16(wire + 6, v->count);
+    return CMD_GET_HISTORY_WIRE_SIZE;
+}
+
+/** Read CMD_GET_HISTORY_WIRE_SIZE wire bytes into v; returns CMD_GET_HISTORY_WIRE_SIZE */
+static inline size_t cmd_get_history_unpack(cmd_get_history_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->tier = wire[1];
+    v->from_timestamp = wire_get_u32(wire + 2);
+    v->count = wire_get_u16(wire + 6);
+    return CMD_GET_HISTORY_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_history_header_t
+// ============================================================================
+
+#define RESP_HISTORY_HEADER_WIRE_SIZE 8
+PROTOCOL_WIRE_ASSERT(sizeof(resp_history_header_t) == RESP_HISTORY_HEADER_WIRE_SIZE, "resp_history_header_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint8_t tier;
+    uint32_t first_index;
+    uint16_t record_count;
+} resp_history_header_unpacked_t;
+
+/** Write v as its 8 wire bytes; returns RESP_HISTORY_HEADER_WIRE_SIZE */
+static inline size_t resp_history_header_pack(uint8_t *wire, const resp_history_header_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire[1] = v->tier;
+    wire_put_u32(wire + 2, v->first_index);
+    wire_put_u16(wire + 6, v->record_count);
+    return RESP_HISTORY_HEADER_WIRE_SIZE;
+}
+
+/** Read RESP_HISTORY_HEADER_WIRE_SIZE wire bytes into v; returns RESP_HISTORY_HEADER_WIRE_SIZE */
+static inline size_t resp_history_header_unpack(resp_history_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->tier = wire[1];
+    v->first_index = wire_get_u32(wire + 2);
+    v->record_count = wire_get_u16(wire + 6);
+    return RESP_HISTORY_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_get_stats_t
+// ============================================================================
+
+#define CMD_GET_STATS_WIRE_SIZE 3
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_get_stats_t) == CMD_GET_STATS_WIRE_SIZE, "cmd_get_stats_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint8_t channel;
+    uint8_t window;
+} cmd_get_stats_unpacked_t;
+
+/** Write v as its 3 wire bytes; returns CMD_GET_STATS_WIRE_SIZE */
+static inline size_t cmd_get_stats_pack(uint8_t *wire, const cmd_get_stats_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire[1] = v->channel;
+    wire[2] = v->window;
+    return CMD_GET_STATS_WIRE_SIZE;
+}
+
+/** Read CMD_GET_STATS_WIRE_SIZE wire bytes into v; returns CMD_GET_STATS_WIRE_SIZE */
+static inline size_t cmd_get_stats_unpack(cmd_get_stats_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->channel = wire[1];
+    v->window = wire[2];
+    return CMD_GET_STATS_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_stats_t
+// ============================================================================
+
+#define RESP_STATS_WIRE_SIZE 44
+PROTOCOL_WIRE_ASSERT(sizeof(resp_stats_t) == RESP_STATS_WIRE_SIZE, "resp_stats_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint8_t channel;
+    uint8_t window;
+    uint8_t flags;
+    uint32_t length;
+    uint32_t count;
+    uint32_t first_timestamp;
+    uint32_t last_timestamp;
+    int32_t min;
+    int32_t max;
+    float mean;
+    float stddev;
+    float rms;
+    float scale;
+} resp_stats_unpacked_t;
+
+/** Write v as its 44 wire bytes; returns RESP_STATS_WIRE_SIZE */
+static inline size_t resp_stats_pack(uint8_t *wire, const resp_stats_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire[1] = v->channel;
+    wire[2] = v->window;
+    wire[3] = v->flags;
+    wire_put_u32(wire + 4, v->length);
+    wire_put_u32(wire + 8, v->count);
+    wire_put_u32(wire + 12, v->first_timestamp);
+    wire_put_u32(wire + 16, v->last_timestamp);
+    wire_put_u32(wire + 20, (uint32_t)v->min);
+    wire_put_u32(wire + 24, (uint32_t)v->max);
+    wire_put_f32(wire + 28, v->mean);
+    wire_put_f32(wire + 32, v->stddev);
+    wire_put_f32(wire + 36, v->rms);
+    wire_put_f32(wire + 40, v->scale);
+    return RESP_STATS_WIRE_SIZE;
+}
+
+/** Read RESP_STATS_WIRE_SIZE wire bytes into v; returns RESP_STATS_WIRE_SIZE */
+static inline size_t resp_stats_unpack(resp_stats_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->channel = wire[1];
+    v->window = wire[2];
+    v->flags = wire[3];
+    v->length = wire_get_u32(wire + 4);
+    v->count = wire_get_u32(wire + 8);
+    v->first_timestamp = wire_get_u32(wire + 12);
+    v->last_timestamp = wire_get_u32(wire + 16);
+    v->min = (int32_t)wire_get_u32(wire + 20);
+    v->max = (int32_t)wire_get_u32(wire + 24);
+    v->mean = wire_get_f32(wire + 28);
+    v->stddev = wire_get_f32(wire + 32);
+    v->rms = wire_get_f32(wire + 36);
+    v->scale = wire_get_f32(wire + 40);
+    return RESP_STATS_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_analysis_t
+// ============================================================================
+
+#define RESP_ANALYSIS_WIRE_SIZE 60
+PROTOCOL_WIRE_ASSERT(sizeof(resp_analysis_t) == RESP_ANALYSIS_WIRE_SIZE, "resp_analysis_t does not match the IDL");
+
+typedef struct {
+    uint32_t first_index;
+    uint32_t sample_count;
+    uint32_t block_count;
+    float duration_s;
+    float mean_current_mA;
+    float rms_current_mA;
+    float peak_current_mA;
+    uint32_t peak_index;
+    float filtered_peak_mA;
+    uint32_t filtered_peak_index;
+    float mean_power_mW;
+    float energy_mWh;
+    float charge_mAh;
+    uint32_t cycles_per_block;
+    uint32_t cycles_max_block;
+} resp_analysis_unpacked_t;
+
+/** Write v as its 60 wire bytes; returns RESP_ANALYSIS_WIRE_SIZE */
+static inline size_t resp_analysis_pack(uint8_t *wire, const resp_analysis_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->first_index);
+    wire_put_u32(wire + 4, v->sample_count);
+    wire_put_u32(wire + 8, v->block_count);
+    wire_put_f32(wire + 12, v->duration_s);
+    wire_put_f32(wire + 16, v->mean_current_mA);
+    wire_put_f32(wire + 20, v->rms_current_mA);
+    wire_put_f32(wire + 24, v->peak_current_mA);
+    wire_put_u32(wire + 28, v->peak_index);
+    wire_put_f32(wire + 32, v->filtered_peak_mA);
+    wire_put_u32(wire + 36, v->filtered_peak_index);
+    wire_put_f32(wire + 40, v->mean_power_mW);
+    wire_put_f32(wire + 44, v->energy_mWh);
+    wire_put_f32(wire + 48, v->charge_mAh);
+    wire_put_u32(wire + 52, v->cycles_per_block);
+    wire_put_u32(wire + 56, v->cycles_max_block);
+    return RESP_ANALYSIS_WIRE_SIZE;
+}
+
+/** Read RESP_ANALYSIS_WIRE_SIZE wire bytes into v; returns RESP_ANALYSIS_WIRE_SIZE */
+static inline size_t resp_analysis_unpack(resp_analysis_unpacked_t *v, const uint8_t *wire)
+{
+    v->first_index = wire_get_u32(wire + 0);
+    v->sample_count = wire_get_u32(wire + 4);
+    v->block_count = wire_get_u32(wire + 8);
+    v->duration_s = wire_get_f32(wire + 12);
+    v->mean_current_mA = wire_get_f32(wire + 16);
+    v->rms_current_mA = wire_get_f32(wire + 20);
+    v->peak_current_mA = wire_get_f32(wire + 24);
+    v->peak_index = wire_get_u32(wire + 28);
+    v->filtered_peak_mA = wire_get_f32(wire + 32);
+    v->filtered_peak_index = wire_get_u32(wire + 36);
+    v->mean_power_mW = wire_get_f32(wire + 40);
+    v->energy_mWh = wire_get_f32(wire + 44);
+    v->charge_mAh = wire_get_f32(wire + 48);
+    v->cycles_per_block = wire_get_u32(wire + 52);
+    v->cycles_max_block = wire_get_u32(wire + 56);
+    return RESP_ANALYSIS_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_probes_header_t
+// ============================================================================
+
+#define RESP_PROBES_HEADER_WIRE_SIZE 5
+PROTOCOL_WIRE_ASSERT(sizeof(resp_probes_header_t) == RESP_PROBES_HEADER_WIRE_SIZE, "resp_probes_header_t does not match the IDL");
+
+typedef struct {
+    uint32_t cpu_freq_hz;
+    uint8_t probe_count;
+} resp_probes_header_unpacked_t;
+
+/** Write v as its 5 wire bytes; returns RESP_PROBES_HEADER_WIRE_SIZE */
+static inline size_t resp_probes_header_pack(uint8_t *wire, const resp_probes_header_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->cpu_freq_hz);
+    wire[4] = v->probe_count;
+    return RESP_PROBES_HEADER_WIRE_SIZE;
+}
+
+/** Read RESP_PROBES_HEADER_WIRE_SIZE wire bytes into v; returns RESP_PROBES_HEADER_WIRE_SIZE */
+static inline size_t resp_probes_header_unpack(resp_probes_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->cpu_freq_hz = wire_get_u32(wire + 0);
+    v->probe_count = wire[4];
+    return RESP_PROBES_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_probe_entry_t
+// ============================================================================
+
+#define RESP_PROBE_ENTRY_WIRE_SIZE 17
+PROTOCOL_WIRE_ASSERT(sizeof(resp_probe_entry_t) == RESP_PROBE_ENTRY_WIRE_SIZE, "resp_probe_entry_t does not match the IDL");
+
+typedef struct {
+    uint8_t probe_id;
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t avg_cycles;
+    uint32_t max_cycles;
+} resp_probe_entry_unpacked_t;
+
+/** Write v as its 17 wire bytes; returns RESP_PROBE_ENTRY_WIRE_SIZE */
+static inline size_t resp_probe_entry_pack(uint8_t *wire, const resp_probe_entry_unpacked_t *v)
+{
+    wire[0] = v->probe_id;
+    wire_put_u32(wire + 1, v->count);
+    wire_put_u32(wire + 5, v->min_cycles);
+    wire_put_u32(wire + 9, v->avg_cycles);
+    wire_put_u32(wire + 13, v->max_cycles);
+    return RESP_PROBE_ENTRY_WIRE_SIZE;
+}
+
+/** Read RESP_PROBE_ENTRY_WIRE_SIZE wire bytes into v; returns RESP_PROBE_ENTRY_WIRE_SIZE */
+static inline size_t resp_probe_entry_unpack(resp_probe_entry_unpacked_t *v, const uint8_t *wire)
+{
+    v->probe_id = wire[0];
+    v->count = wire_get_u32(wire + 1);
+    v->min_cycles = wire_get_u32(wire + 5);
+    v->avg_cycles = wire_get_u32(wire + 9);
+    v->max_cycles = wire_get_u32(wire + 13);
+    return RESP_PROBE_ENTRY_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_bulk_dump_t
+// ============================================================================
+
+#define CMD_BULK_DUMP_WIRE_SIZE 9
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_bulk_dump_t) == CMD_BULK_DUMP_WIRE_SIZE, "cmd_bulk_dump_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint32_t start_index;
+    uint32_t count;
+} cmd_bulk_dump_unpacked_t;
+
+/** Write v as its 9 wire bytes; returns CMD_BULK_DUMP_WIRE_SIZE */
+static inline size_t cmd_bulk_dump_pack(uint8_t *wire, const cmd_bulk_dump_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire_put_u32(wire + 1, v->start_index);
+    wire_put_u32(wire + 5, v->count);
+    return CMD_BULK_DUMP_WIRE_SIZE;
+}
+
+/** Read CMD_BULK_DUMP_WIRE_SIZE wire bytes into v; returns CMD_BULK_DUMP_WIRE_SIZE */
+static inline size_t cmd_bulk_dump_unpack(cmd_bulk_dump_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->start_index = wire_get_u32(wire + 1);
+    v->count = wire_get_u32(wire + 5);
+    return CMD_BULK_DUMP_WIRE_SIZE;
+}
+
+// ============================================================================
+// notify_bulk_data_header_t
+// ============================================================================
+
+#define NOTIFY_BULK_DATA_HEADER_WIRE_SIZE 7
+PROTOCOL_WIRE_ASSERT(sizeof(notify_bulk_data_header_t) == NOTIFY_BULK_DATA_HEADER_WIRE_SIZE, "notify_bulk_data_header_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint32_t first_index;
+    uint16_t sample_count;
+} notify_bulk_data_header_unpacked_t;
+
+/** Write v as its 7 wire bytes; returns NOTIFY_BULK_DATA_HEADER_WIRE_SIZE */
+static inline size_t notify_bulk_data_header_pack(uint8_t *wire, const notify_bulk_data_header_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire_put_u32(wire + 1, v->first_index);
+    wire_put_u16(wire + 5, v->sample_count);
+    return NOTIFY_BULK_DATA_HEADER_WIRE_SIZE;
+}
+
+/** Read NOTIFY_BULK_DATA_HEADER_WIRE_SIZE wire bytes into v; returns NOTIFY_BULK_DATA_HEADER_WIRE_SIZE */
+static inline size_t notify_bulk_data_header_unpack(notify_bulk_data_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->first_index = wire_get_u32(wire + 1);
+    v->sample_count = wire_get_u16(wire + 5);
+    return NOTIFY_BULK_DATA_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_grant_credits_t
+// ============================================================================
+
+#define CMD_GRANT_CREDITS_WIRE_SIZE 2
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_grant_credits_t) == CMD_GRANT_CREDITS_WIRE_SIZE, "cmd_grant_credits_t does not match the IDL");
+
+typedef struct {
+    uint16_t credits;
+} cmd_grant_credits_unpacked_t;
+
+/** Write v as its 2 wire bytes; returns CMD_GRANT_CREDITS_WIRE_SIZE */
+static inline size_t cmd_grant_credits_pack(uint8_t *wire, const cmd_grant_credits_unpacked_t *v)
+{
+    wire_put_u16(wire + 0, v->credits);
+    return CMD_GRANT_CREDITS_WIRE_SIZE;
+}
+
+/** Read CMD_GRANT_CREDITS_WIRE_SIZE wire bytes into v; returns CMD_GRANT_CREDITS_WIRE_SIZE */
+static inline size_t cmd_grant_credits_unpack(cmd_grant_credits_unpacked_t *v, const uint8_t *wire)
+{
+    v->credits = wire_get_u16(wire + 0);
+    return CMD_GRANT_CREDITS_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_grant_credits_t
+// ============================================================================
+
+#define RESP_GRANT_CREDITS_WIRE_SIZE 6
+PROTOCOL_WIRE_ASSERT(sizeof(resp_grant_credits_t) == RESP_GRANT_CREDITS_WIRE_SIZE, "resp_grant_credits_t does not match the IDL");
+
+typedef struct {
+    uint16_t balance;
+    uint32_t stalls;
+} resp_grant_credits_unpacked_t;
+
+/** Write v as its 6 wire bytes; returns RESP_GRANT_CREDITS_WIRE_SIZE */
+static inline size_t resp_grant_credits_pack(uint8_t *wire, const resp_grant_credits_unpacked_t *v)
+{
+    wire_put_u16(wire + 0, v->balance);
+    wire_put_u32(wire + 2, v->stalls);
+    return RESP_GRANT_CREDITS_WIRE_SIZE;
+}
+
+/** Read RESP_GRANT_CREDITS_WIRE_SIZE wire bytes into v; returns RESP_GRANT_CREDITS_WIRE_SIZE */
+static inline size_t resp_grant_credits_unpack(resp_grant_credits_unpacked_t *v, const uint8_t *wire)
+{
+    v->balance = wire_get_u16(wire + 0);
+    v->stalls = wire_get_u32(wire + 2);
+    return RESP_GRANT_CREDITS_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_subscribe_events_t
+// ============================================================================
+
+#define CMD_SUBSCRIBE_EVENTS_WIRE_SIZE 7
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_subscribe_events_t) == CMD_SUBSCRIBE_EVENTS_WIRE_SIZE, "cmd_subscribe_events_t does not match the IDL");
+
+typedef struct {
+    uint32_t event_mask;
+    uint8_t batch_size;
+    uint16_t max_latency_ms;
+} cmd_subscribe_events_unpacked_t;
+
+/** Write v as its 7 wire bytes; returns CMD_SUBSCRIBE_EVENTS_WIRE_SIZE */
+static inline size_t cmd_subscribe_events_pack(uint8_t *wire, const cmd_subscribe_events_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->event_mask);
+    wire[4] = v->batch_size;
+    wire_put_u16(wire + 5, v->max_latency_ms);
+    return CMD_SUBSCRIBE_EVENTS_WIRE_SIZE;
+}
+
+/** Read CMD_SUBSCRIBE_EVENTS_WIRE_SIZE wire bytes into v; returns CMD_SUBSCRIBE_EVENTS_WIRE_SIZE */
+static inline size_t cmd_subscribe_events_unpack(cmd_subscribe_events_unpacked_t *v, const uint8_t *wire)
+{
+    v->event_mask = wire_get_u32(wire + 0);
+    v->batch_size = wire[4];
+    v->max_latency_ms = wire_get_u16(wire + 5);
+    return CMD_SUBSCRIBE_EVENTS_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_subscribe_events_t
+// ============================================================================
+
+#define RESP_SUBSCRIBE_EVENTS_WIRE_SIZE 4
+PROTOCOL_WIRE_ASSERT(sizeof(resp_subscribe_events_t) == RESP_SUBSCRIBE_EVENTS_WIRE_SIZE, "resp_subscribe_events_t does not match the IDL");
+
+typedef struct {
+    uint32_t event_mask;
+} resp_subscribe_events_unpacked_t;
+
+/** Write v as its 4 wire bytes; returns RESP_SUBSCRIBE_EVENTS_WIRE_SIZE */
+static inline size_t resp_subscribe_events_pack(uint8_t *wire, const resp_subscribe_events_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->event_mask);
+    return RESP_SUBSCRIBE_EVENTS_WIRE_SIZE;
+}
+
+/** Read RESP_SUBSCRIBE_EVENTS_WIRE_SIZE wire bytes into v; returns RESP_SUBSCRIBE_EVENTS_WIRE_SIZE */
+static inline size_t resp_subscribe_events_unpack(resp_subscribe_events_unpacked_t *v, const uint8_t *wire)
+{
+    v->event_mask = wire_get_u32(wire + 0);
+    return RESP_SUBSCRIBE_EVENTS_WIRE_SIZE;
+}
+
+// ============================================================================
+// notify_events_header_t
+// ============================================================================
+
+#define NOTIFY_EVENTS_HEADER_WIRE_SIZE 3
+PROTOCOL_WIRE_ASSERT(sizeof(notify_events_header_t) == NOTIFY_EVENTS_HEADER_WIRE_SIZE, "notify_events_header_t does not match the IDL");
+
+typedef struct {
+    uint8_t event_count;
+    uint16_t dropped;
+} notify_events_header_unpacked_t;
+
+/** Write v as its 3 wire bytes; returns NOTIFY_EVENTS_HEADER_WIRE_SIZE */
+static inline size_t notify_events_header_pack(uint8_t *wire, const notify_events_header_unpacked_t *v)
+{
+    wire[0] = v->event_count;
+    wire_put_u16(wire + 1, v->dropped);
+    return NOTIFY_EVENTS_HEADER_WIRE_SIZE;
+}
+
+/** Read NOTIFY_EVENTS_HEADER_WIRE_SIZE wire bytes into v; returns NOTIFY_EVENTS_HEADER_WIRE_SIZE */
+static inline size_t notify_events_header_unpack(notify_events_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->event_count = wire[0];
+    v->dropped = wire_get_u16(wire + 1);
+    return NOTIFY_EVENTS_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// notify_event_record_t
+// ============================================================================
+
+#define NOTIFY_EVENT_RECORD_WIRE_SIZE 6
+PROTOCOL_WIRE_ASSERT(sizeof(notify_event_record_t) == NOTIFY_EVENT_RECORD_WIRE_SIZE, "notify_event_record_t does not match the IDL");
+
+typedef struct {
+    uint8_t event_type;
+    uint32_t timestamp;
+    uint8_t data_size;
+} notify_event_record_unpacked_t;
+
+/** Write v as its 6 wire bytes; returns NOTIFY_EVENT_RECORD_WIRE_SIZE */
+static inline size_t notify_event_record_pack(uint8_t *wire, const notify_event_record_unpacked_t *v)
+{
+    wire[0] = v->event_type;
+    wire_put_u32(wire + 1, v->timestamp);
+    wire[5] = v->data_size;
+    return NOTIFY_EVENT_RECORD_WIRE_SIZE;
+}
+
+/** Read NOTIFY_EVENT_RECORD_WIRE_SIZE wire bytes into v; returns NOTIFY_EVENT_RECORD_WIRE_SIZE */
+static inline size_t notify_event_record_unpack(notify_event_record_unpacked_t *v, const uint8_t *wire)
+{
+    v->event_type = wire[0];
+    v->timestamp = wire_get_u32(wire + 1);
+    v->data_size = wire[5];
+    return NOTIFY_EVENT_RECORD_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_bulk_export_t
+// ============================================================================
+
+#define CMD_BULK_EXPORT_WIRE_SIZE 9
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_bulk_export_t) == CMD_BULK_EXPORT_WIRE_SIZE, "cmd_bulk_export_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensors;
+    uint32_t from_timestamp;
+    uint32_t count;
+} cmd_bulk_export_unpacked_t;
+
+/** Write v as its 9 wire bytes; returns CMD_BULK_EXPORT_WIRE_SIZE */
+static inline size_t cmd_bulk_export_pack(uint8_t *wire, const cmd_bulk_export_unpacked_t *v)
+{
+    wire[0] = v->sensors;
+    wire_put_u32(wire + 1, v->from_timestamp);
+    wire_put_u32(wire + 5, v->count);
+    return CMD_BULK_EXPORT_WIRE_SIZE;
+}
+
+/** Read CMD_BULK_EXPORT_WIRE_SIZE wire bytes into v; returns CMD_BULK_EXPORT_WIRE_SIZE */
+static inline size_t cmd_bulk_export_unpack(cmd_bulk_export_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensors = wire[0];
+    v->from_timestamp = wire_get_u32(wire + 1);
+    v->count = wire_get_u32(wire + 5);
+    return CMD_BULK_EXPORT_WIRE_SIZE;
+}
+
+// ============================================================================
+// notify_bulk_done_t
+// ============================================================================
+
+#define NOTIFY_BULK_DONE_WIRE_SIZE 6
+PROTOCOL_WIRE_ASSERT(sizeof(notify_bulk_done_t) == NOTIFY_BULK_DONE_WIRE_SIZE, "notify_bulk_done_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint8_t status;
+    uint32_t sample_count;
+} notify_bulk_done_unpacked_t;
+
+/** Write v as its 6 wire bytes; returns NOTIFY_BULK_DONE_WIRE_SIZE */
+static inline size_t notify_bulk_done_pack(uint8_t *wire, const notify_bulk_done_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire[1] = v->status;
+    wire_put_u32(wire + 2, v->sample_count);
+    return NOTIFY_BULK_DONE_WIRE_SIZE;
+}
+
+/** Read NOTIFY_BULK_DONE_WIRE_SIZE wire bytes into v; returns NOTIFY_BULK_DONE_WIRE_SIZE */
+static inline size_t notify_bulk_done_unpack(notify_bulk_done_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->status = wire[1];
+    v->sample_count = wire_get_u32(wire + 2);
+    return NOTIFY_BULK_DONE_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_get_current_capture_t
+// ============================================================================
+
+#define CMD_GET_CURRENT_CAPTURE_WIRE_SIZE 15
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_get_current_capture_t) == CMD_GET_CURRENT_CAPTURE_WIRE_SIZE, "cmd_get_current_capture_t does not match the IDL");
+
+typedef struct {
+    uint32_t start_index;
+    uint32_t count;
+    uint8_t flags;
+    uint16_t sample_period_ms;
+    uint32_t duration_sec;
+} cmd_get_current_capture_unpacked_t;
+
+/** Write v as its 15 wire bytes; returns CMD_GET_CURRENT_CAPTURE_WIRE_SIZE */
+static inline size_t cmd_get_current_capture_pack(uint8_t *wire, const cmd_get_current_capture_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->start_index);
+    wire_put_u32(wire + 4, v->count);
+    wire[8] = v->flags;
+    wire_put_u16(wire + 9, v->sample_period_ms);
+    wire_put_u32(wire + 11, v->duration_sec);
+    return CMD_GET_CURRENT_CAPTURE_WIRE_SIZE;
+}
+
+/** Read CMD_GET_CURRENT_CAPTURE_WIRE_SIZE wire bytes into v; returns CMD_GET_CURRENT_CAPTURE_WIRE_SIZE */
+static inline size_t cmd_get_current_capture_unpack(cmd_get_current_capture_unpacked_t *v, const uint8_t *wire)
+{
+    v->start_index = wire_get_u32(wire + 0);
+    v->count = wire_get_u32(wire + 4);
+    v->flags = wire[8];
+    v->sample_period_ms = wire_get_u16(wire + 9);
+    v->duration_sec = wire_get_u32(wire + 11);
+    return CMD_GET_CURRENT_CAPTURE_WIRE_SIZE;
+}
+
+// ============================================================================
+// current_capture_need_t
+// ============================================================================
+
+#define CURRENT_CAPTURE_NEED_WIRE_SIZE 12
+PROTOCOL_WIRE_ASSERT(sizeof(current_capture_need_t) == CURRENT_CAPTURE_NEED_WIRE_SIZE, "current_capture_need_t does not match the IDL");
+
+typedef struct {
+    uint32_t ram_bytes;
+    uint32_t flash_bytes;
+    uint32_t link_bytes_per_s;
+} current_capture_need_unpacked_t;
+
+/** Write v as its 12 wire bytes; returns CURRENT_CAPTURE_NEED_WIRE_SIZE */
+static inline size_t current_capture_need_pack(uint8_t *wire, const current_capture_need_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->ram_bytes);
+    wire_put_u32(wire + 4, v->flash_bytes);
+    wire_put_u32(wire + 8, v->link_bytes_per_s);
+    return CURRENT_CAPTURE_NEED_WIRE_SIZE;
+}
+
+/** Read CURRENT_CAPTURE_NEED_WIRE_SIZE wire bytes into v; returns CURRENT_CAPTURE_NEED_WIRE_SIZE */
+static inline size_t current_capture_need_unpack(current_capture_need_unpacked_t *v, const uint8_t *wire)
+{
+    v->ram_bytes = wire_get_u32(wire + 0);
+    v->flash_bytes = wire_get_u32(wire + 4);
+    v->link_bytes_per_s = wire_get_u32(wire + 8);
+    return CURRENT_CAPTURE_NEED_WIRE_SIZE;
+}
+
+// ============================================================================
+// current_record_t
+// ============================================================================
+
+#define CURRENT_RECORD_WIRE_SIZE 19
+PROTOCOL_WIRE_ASSERT(sizeof(current_record_t) == CURRENT_RECORD_WIRE_SIZE, "current_record_t does not match the IDL");
+
+typedef struct {
+    uint32_t timestamp_sec;
+    uint16_t timestamp_ms;
+    uint8_t state;
+    float current_mA;
+    float voltage_V;
+    float power_mW;
+} current_record_unpacked_t;
+
+/** Write v as its 19 wire bytes; returns CURRENT_RECORD_WIRE_SIZE */
+static inline size_t current_record_pack(uint8_t *wire, const current_record_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->timestamp_sec);
+    wire_put_u16(wire + 4, v->timestamp_ms);
+    wire[6] = v->state;
+    wire_put_f32(wire + 7, v->current_mA);
+    wire_put_f32(wire + 11, v->voltage_V);
+    wire_put_f32(wire + 15, v->power_mW);
+    return CURRENT_RECORD_WIRE_SIZE;
+}
+
+/** Read CURRENT_RECORD_WIRE_SIZE wire bytes into v; returns CURRENT_RECORD_WIRE_SIZE */
+static inline size_t current_record_unpack(current_record_unpacked_t *v, const uint8_t *wire)
+{
+    v->timestamp_sec = wire_get_u32(wire + 0);
+    v->timestamp_ms = wire_get_u16(wire + 4);
+    v->state = wire[6];
+    v->current_mA = wire_get_f32(wire + 7);
+    v->voltage_V = wire_get_f32(wire + 11);
+    v->power_mW = wire_get_f32(wire + 15);
+    return CURRENT_RECORD_WIRE_SIZE;
+}
+
+// ============================================================================
+// notify_current_data_header_t
+// ============================================================================
+
+#define NOTIFY_CURRENT_DATA_HEADER_WIRE_SIZE 10
+PROTOCOL_WIRE_ASSERT(sizeof(notify_current_data_header_t) == NOTIFY_CURRENT_DATA_HEADER_WIRE_SIZE, "notify_current_data_header_t does not match the IDL");
+
+typedef struct {
+    uint32_t first_index;
+    uint16_t record_count;
+    uint32_t dropped;
+} notify_current_data_header_unpacked_t;
+
+/** Write v as its 10 wire bytes; returns NOTIFY_CURRENT_DATA_HEADER_WIRE_SIZE */
+static inline size_t notify_current_data_header_pack(uint8_t *wire, const notify_current_data_header_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->first_index);
+    wire_put_u16(wire + 4, v->record_count);
+    wire_put_u32(wire + 6, v->dropped);
+    return NOTIFY_CURRENT_DATA_HEADER_WIRE_SIZE;
+}
+
+/** Read NOTIFY_CURRENT_DATA_HEADER_WIRE_SIZE wire bytes into v; returns NOTIFY_CURRENT_DATA_HEADER_WIRE_SIZE */
+static inline size_t notify_current_data_header_unpack(notify_current_data_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->first_index = wire_get_u32(wire + 0);
+    v->record_count = wire_get_u16(wire + 4);
+    v->dropped = wire_get_u32(wire + 6);
+    return NOTIFY_CURRENT_DATA_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_get_recording_t
+// ============================================================================
+
+#define CMD_GET_RECORDING_WIRE_SIZE 8
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_get_recording_t) == CMD_GET_RECORDING_WIRE_SIZE, "cmd_get_recording_t does not match the IDL");
+
+typedef struct {
+    uint32_t offset;
+    uint32_t length;
+} cmd_get_recording_unpacked_t;
+
+/** Write v as its 8 wire bytes; returns CMD_GET_RECORDING_WIRE_SIZE */
+static inline size_t cmd_get_recording_pack(uint8_t *wire, const cmd_get_recording_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->offset);
+    wire_put_u32(wire + 4, v->length);
+    return CMD_GET_RECORDING_WIRE_SIZE;
+}
+
+/** Read CMD_GET_RECORDING_WIRE_SIZE wire bytes into v; returns CMD_GET_RECORDING_WIRE_SIZE */
+static inline size_t cmd_get_recording_unpack(cmd_get_recording_unpacked_t *v, const uint8_t *wire)
+{
+    v->offset = wire_get_u32(wire + 0);
+    v->length = wire_get_u32(wire + 4);
+    return CMD_GET_RECORDING_WIRE_SIZE;
+}
+
+// ============================================================================
+// notify_recording_data_header_t
+// ============================================================================
+
+#define NOTIFY_RECORDING_DATA_HEADER_WIRE_SIZE 10
+PROTOCOL_WIRE_ASSERT(sizeof(notify_recording_data_header_t) == NOTIFY_RECORDING_DATA_HEADER_WIRE_SIZE, "notify_recording_data_header_t does not match the IDL");
+
+typedef struct {
+    uint32_t offset;
+    uint32_t total_bytes;
+    uint16_t byte_count;
+} notify_recording_data_header_unpacked_t;
+
+/** Write v as its 10 wire bytes; returns NOTIFY_RECORDING_DATA_HEADER_WIRE_SIZE */
+static inline size_t notify_recording_data_header_pack(uint8_t *wire, const notify_recording_data_header_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->offset);
+    wire_put_u32(wire + 4, v->total_bytes);
+    wire_put_u16(wire + 8, v->byte_count);
+    return NOTIFY_RECORDING_DATA_HEADER_WIRE_SIZE;
+}
+
+/** Read NOTIFY_RECORDING_DATA_HEADER_WIRE_SIZE wire bytes into v; returns NOTIFY_RECORDING_DATA_HEADER_WIRE_SIZE */
+static inline size_t notify_recording_data_header_unpack(notify_recording_data_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->offset = wire_get_u32(wire + 0);
+    v->total_bytes = wire_get_u32(wire + 4);
+    v->byte_count = wire_get_u16(wire + 8);
+    return NOTIFY_RECORDING_DATA_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_loopback_test_t
+// ============================================================================
+
+#define CMD_LOOPBACK_TEST_WIRE_SIZE 9
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_loopback_test_t) == CMD_LOOPBACK_TEST_WIRE_SIZE, "cmd_loopback_test_t does not match the IDL");
+
+typedef struct {
+    uint32_t count;
+    uint16_t payload_size;
+    uint8_t window;
+    uint16_t timeout_ms;
+} cmd_loopback_test_unpacked_t;
+
+/** Write v as its 9 wire bytes; returns CMD_LOOPBACK_TEST_WIRE_SIZE */
+static inline size_t cmd_loopback_test_pack(uint8_t *wire, const cmd_loopback_test_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->count);
+    wire_put_u16(wire + 4, v->payload_size);
+    wire[6] = v->window;
+    wire_put_u16(wire + 7, v->timeout_ms);
+    return CMD_LOOPBACK_TEST_WIRE_SIZE;
+}
+
+/** Read CMD_LOOPBACK_TEST_WIRE_SIZE wire bytes into v; returns CMD_LOOPBACK_TEST_WIRE_SIZE */
+static inline size_t cmd_loopback_test_unpack(cmd_loopback_test_unpacked_t *v, const uint8_t *wire)
+{
+    v->count = wire_get_u32(wire + 0);
+    v->payload_size = wire_get_u16(wire + 4);
+    v->window = wire[6];
+    v->timeout_ms = wire_get_u16(wire + 7);
+    return CMD_LOOPBACK_TEST_WIRE_SIZE;
+}
+
+// ============================================================================
+// notify_loopback_probe_t
+// ============================================================================
+
+#define NOTIFY_LOOPBACK_PROBE_WIRE_SIZE 8
+PROTOCOL_WIRE_ASSERT(sizeof(notify_loopback_probe_t) == NOTIFY_LOOPBACK_PROBE_WIRE_SIZE, "notify_loopback_probe_t does not match the IDL");
+
+typedef struct {
+    uint32_t probe_seq;
+    uint32_t sent_us;
+} notify_loopback_probe_unpacked_t;
+
+/** Write v as its 8 wire bytes; returns NOTIFY_LOOPBACK_PROBE_WIRE_SIZE */
+static inline size_t notify_loopback_probe_pack(uint8_t *wire, const notify_loopback_probe_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->probe_seq);
+    wire_put_u32(wire + 4, v->sent_us);
+    return NOTIFY_LOOPBACK_PROBE_WIRE_SIZE;
+}
+
+/** Read NOTIFY_LOOPBACK_PROBE_WIRE_SIZE wire bytes into v; returns NOTIFY_LOOPBACK_PROBE_WIRE_SIZE */
+static inline size_t notify_loopback_probe_unpack(notify_loopback_probe_unpacked_t *v, const uint8_t *wire)
+{
+    v->probe_seq = wire_get_u32(wire + 0);
+    v->sent_us = wire_get_u32(wire + 4);
+    return NOTIFY_LOOPBACK_PROBE_WIRE_SIZE;
+}
+
+// ============================================================================
+// notify_loopback_done_t
+// ============================================================================
+
+#define NOTIFY_LOOPBACK_DONE_WIRE_SIZE 67
+PROTOCOL_WIRE_ASSERT(sizeof(notify_loopback_done_t) == NOTIFY_LOOPBACK_DONE_WIRE_SIZE, "notify_loopback_done_t does not match the IDL");
+
+typedef struct {
+    uint8_t status;
+    uint16_t payload_size;
+    uint32_t sent;
+    uint32_t returned;
+    uint32_t lost;
+    uint32_t corrupt;
+    uint32_t duration_us;
+    uint32_t frames_per_s;
+    uint32_t bytes_per_s;
+    uint32_t rtt_min_us;
+    uint32_t rtt_p50_us;
+    uint32_t rtt_p90_us;
+    uint32_t rtt_p99_us;
+    uint32_t rtt_max_us;
+    uint32_t crc_errors;
+    uint32_t framing_errors;
+    uint32_t overflow_errors;
+    uint32_t timeout_errors;
+} notify_loopback_done_unpacked_t;
+
+/** Write v as its 67 wire bytes; returns NOTIFY_LOOPBACK_DONE_WIRE_SIZE */
+static inline size_t notify_loopback_done_pack(uint8_t *wire, const notify_loopback_done_unpacked_t *v)
+{
+    wire[0] = v->status;
+    wire_put_u16(wire + 1, v->payload_size);
+    wire_put_u32(wire + 3, v->sent);
+    wire_put_u32(wire + 7, v->returned);
+    wire_put_u32(wire + 11, v->lost);
+    wire_put_u32(wire + 15, v->corrupt);
+    wire_put_u32(wire + 19, v->duration_us);
+    wire_put_u32(wire + 23, v->frames_per_s);
+    wire_put_u32(wire + 27, v->bytes_per_s);
+    wire_put_u32(wire + 31, v->rtt_min_us);
+    wire_put_u32(wire + 35, v->rtt_p50_us);
+    wire_put_u32(wire + 39, v->rtt_p90_us);
+    wire_put_u32(wire + 43, v->rtt_p99_us);
+    wire_put_u32(wire + 47, v->rtt_max_us);
+    wire_put_u32(wire + 51, v->crc_errors);
+    wire_put_u32(wire + 55, v->framing_errors);
+    wire_put_u32(wire + 59, v->overflow_errors);
+    wire_put_u32(wire + 63, v->timeout_errors);
+    return NOTIFY_LOOPBACK_DONE_WIRE_SIZE;
+}
+
+/** Read NOTIFY_LOOPBACK_DONE_WIRE_SIZE wire bytes into v; returns NOTIFY_LOOPBACK_DONE_WIRE_SIZE */
+static inline size_t notify_loopback_done_unpack(notify_loopback_done_unpacked_t *v, const uint8_t *wire)
+{
+    v->status = wire[0];
+    v->payload_size = wire_get_u16(wire + 1);
+    v->sent = wire_get_u32(wire + 3);
+    v->returned = wire_get_u32(wire + 7);
+    v->lost = wire_get_u32(wire + 11);
+    v->corrupt = wire_get_u32(wire + 15);
+    v->duration_us = wire_get_u32(wire + 19);
+    v->frames_per_s = wire_get_u32(wire + 23);
+    v->bytes_per_s = wire_get_u32(wire + 27);
+    v->rtt_min_us = wire_get_u32(wire + 31);
+    v->rtt_p50_us = wire_get_u32(wire + 35);
+    v->rtt_p90_us = wire_get_u32(wire + 39);
+    v->rtt_p99_us = wire_get_u32(wire + 43);
+    v->rtt_max_us = wire_get_u32(wire + 47);
+    v->crc_errors = wire_get_u32(wire + 51);
+    v->framing_errors = wire_get_u32(wire + 55);
+    v->overflow_errors = wire_get_u32(wire + 59);
+    v->timeout_errors = wire_get_u32(wire + 63);
+    return NOTIFY_LOOPBACK_DONE_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_set_baud_rate_t
+// ============================================================================
+
+#define CMD_SET_BAUD_RATE_WIRE_SIZE 6
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_set_baud_rate_t) == CMD_SET_BAUD_RATE_WIRE_SIZE, "cmd_set_baud_rate_t does not match the IDL");
+
+typedef struct {
+    uint32_t baud_rate;
+    uint16_t probation_ms;
+} cmd_set_baud_rate_unpacked_t;
+
+/** Write v as its 6 wire bytes; returns CMD_SET_BAUD_RATE_WIRE_SIZE */
+static inline size_t cmd_set_baud_rate_pack(uint8_t *wire, const cmd_set_baud_rate_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->baud_rate);
+    wire_put_u16(wire + 4, v->probation_ms);
+    return CMD_SET_BAUD_RATE_WIRE_SIZE;
+}
+
+/** Read CMD_SET_BAUD_RATE_WIRE_SIZE wire bytes into v; returns CMD_SET_BAUD_RATE_WIRE_SIZE */
+static inline size_t cmd_set_baud_rate_unpack(cmd_set_baud_rate_unpacked_t *v, const uint8_t *wire)
+{
+    v->baud_rate = wire_get_u32(wire + 0);
+    v->probation_ms = wire_get_u16(wire + 4);
+    return CMD_SET_BAUD_RATE_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_set_baud_rate_t
+// ============================================================================
+
+#define RESP_SET_BAUD_RATE_WIRE_SIZE 8
+PROTOCOL_WIRE_ASSERT(sizeof(resp_set_baud_rate_t) == RESP_SET_BAUD_RATE_WIRE_SIZE, "resp_set_baud_rate_t does not match the IDL");
+
+typedef struct {
+    uint32_t baud_rate;
+    uint32_t previous_baud_rate;
+} resp_set_baud_rate_unpacked_t;
+
+/** Write v as its 8 wire bytes; returns RESP_SET_BAUD_RATE_WIRE_SIZE */
+static inline size_t resp_set_baud_rate_pack(uint8_t *wire, const resp_set_baud_rate_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->baud_rate);
+    wire_put_u32(wire + 4, v->previous_baud_rate);
+    return RESP_SET_BAUD_RATE_WIRE_SIZE;
+}
+
+/** Read RESP_SET_BAUD_RATE_WIRE_SIZE wire bytes into v; returns RESP_SET_BAUD_RATE_WIRE_SIZE */
+static inline size_t resp_set_baud_rate_unpack(resp_set_baud_rate_unpacked_t *v, const uint8_t *wire)
+{
+    v->baud_rate = wire_get_u32(wire + 0);
+    v->previous_baud_rate = wire_get_u32(wire + 4);
+    return RESP_SET_BAUD_RATE_WIRE_SIZE;
+}
+
+// ============================================================================
+// notify_baud_fallback_t
+// ============================================================================
+
+#define NOTIFY_BAUD_FALLBACK_WIRE_SIZE 4
+PROTOCOL_WIRE_ASSERT(sizeof(notify_baud_fallback_t) == NOTIFY_BAUD_FALLBACK_WIRE_SIZE, "notify_baud_fallback_t does not match the IDL");
+
+typedef struct {
+    uint32_t baud_rate;
+} notify_baud_fallback_unpacked_t;
+
+/** Write v as its 4 wire bytes; returns NOTIFY_BAUD_FALLBACK_WIRE_SIZE */
+static inline size_t notify_baud_fallback_pack(uint8_t *wire, const notify_baud_fallback_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->baud_rate);
+    return NOTIFY_BAUD_FALLBACK_WIRE_SIZE;
+}
+
+/** Read NOTIFY_BAUD_FALLBACK_WIRE_SIZE wire bytes into v; returns NOTIFY_BAUD_FALLBACK_WIRE_SIZE */
+static inline size_t notify_baud_fallback_unpack(notify_baud_fallback_unpacked_t *v, const uint8_t *wire)
+{
+    v->baud_rate = wire_get_u32(wire + 0);
+    return NOTIFY_BAUD_FALLBACK_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_get_command_stats_t
+// ============================================================================
+
+#define CMD_GET_COMMAND_STATS_WIRE_SIZE 2
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_get_command_stats_t) == CMD_GET_COMMAND_STATS_WIRE_SIZE, "cmd_get_command_stats_t does not match the IDL");
+
+typedef struct {
+    uint8_t first_cmd_id;
+    uint8_t reset;
+} cmd_get_command_stats_unpacked_t;
+
+/** Write v as its 2 wire bytes; returns CMD_GET_COMMAND_STATS_WIRE_SIZE */
+static inline size_t cmd_get_command_stats_pack(uint8_t *wire, const cmd_get_command_stats_unpacked_t *v)
+{
+    wire[0] = v->first_cmd_id;
+    wire[1] = v->reset;
+    return CMD_GET_COMMAND_STATS_WIRE_SIZE;
+}
+
+/** Read CMD_GET_COMMAND_STATS_WIRE_SIZE wire bytes into v; returns CMD_GET_COMMAND_STATS_WIRE_SIZE */
+static inline size_t cmd_get_command_stats_unpack(cmd_get_command_stats_unpacked_t *v, const uint8_t *wire)
+{
+    v->first_cmd_id = wire[0];
+    v->reset = wire[1];
+    return CMD_GET_COMMAND_STATS_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_command_stats_header_t
+// ============================================================================
+
+#define RESP_COMMAND_STATS_HEADER_WIRE_SIZE 10
+PROTOCOL_WIRE_ASSERT(sizeof(resp_command_stats_header_t) == RESP_COMMAND_STATS_HEADER_WIRE_SIZE, "resp_command_stats_header_t does not match the IDL");
+
+typedef struct {
+    uint32_t cpu_freq_hz;
+    uint32_t unknown_commands;
+    uint8_t entry_count;
+    uint8_t next_cmd_id;
+} resp_command_stats_header_unpacked_t;
+
+/** Write v as its 10 wire bytes; returns RESP_COMMAND_STATS_HEADER_WIRE_SIZE */
+static inline size_t resp_command_stats_header_pack(uint8_t *wire, const resp_command_stats_header_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->cpu_freq_hz);
+    wire_put_u32(wire + 4, v->unknown_commands);
+    wire[8] = v->entry_count;
+    wire[9] = v->next_cmd_id;
+    return RESP_COMMAND_STATS_HEADER_WIRE_SIZE;
+}
+
+/** Read RESP_COMMAND_STATS_HEADER_WIRE_SIZE wire bytes into v; returns RESP_COMMAND_STATS_HEADER_WIRE_SIZE */
+static inline size_t resp_command_stats_header_unpack(resp_command_stats_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->cpu_freq_hz = wire_get_u32(wire + 0);
+    v->unknown_commands = wire_get_u32(wire + 4);
+    v->entry_count = wire[8];
+    v->next_cmd_id = wire[9];
+    return RESP_COMMAND_STATS_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_command_stats_entry_t
+// ============================================================================
+
+#define RESP_COMMAND_STATS_ENTRY_WIRE_SIZE 21
+PROTOCOL_WIRE_ASSERT(sizeof(resp_command_stats_entry_t) == RESP_COMMAND_STATS_ENTRY_WIRE_SIZE, "resp_command_stats_entry_t does not match the IDL");
+
+typedef struct {
+    uint8_t cmd_id;
+    uint32_t count;
+    uint32_t rejected;
+    uint32_t busy;
+    uint32_t avg_cycles;
+    uint32_t max_cycles;
+} resp_command_stats_entry_unpacked_t;
+
+/** Write v as its 21 wire bytes; returns RESP_COMMAND_STATS_ENTRY_WIRE_SIZE */
+static inline size_t resp_command_stats_entry_pack(uint8_t *wire, const resp_command_stats_entry_unpacked_t *v)
+{
+    wire[0] = v->cmd_id;
+    wire_put_u32(wire + 1, v->count);
+    wire_put_u32(wire + 5, v->rejected);
+    wire_put_u32(wire + 9, v->busy);
+    wire_put_u32(wire + 13, v->avg_cycles);
+    wire_put_u32(wire + 17, v->max_cycles);
+    return RESP_COMMAND_STATS_ENTRY_WIRE_SIZE;
+}
+
+/** Read RESP_COMMAND_STATS_ENTRY_WIRE_SIZE wire bytes into v; returns RESP_COMMAND_STATS_ENTRY_WIRE_SIZE */
+static inline size_t resp_command_stats_entry_unpack(resp_command_stats_entry_unpacked_t *v, const uint8_t *wire)
+{
+    v->cmd_id = wire[0];
+    v->count = wire_get_u32(wire + 1);
+    v->rejected = wire_get_u32(wire + 5);
+    v->busy = wire_get_u32(wire + 9);
+    v->avg_cycles = wire_get_u32(wire + 13);
+    v->max_cycles = wire_get_u32(wire + 17);
+    return RESP_COMMAND_STATS_ENTRY_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_start_stream_t
+// ============================================================================
+
+#define CMD_START_STREAM_WIRE_SIZE 8
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_start_stream_t) == CMD_START_STREAM_WIRE_SIZE, "cmd_start_stream_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+    uint32_t interval_ms;
+    uint8_t batch_size;
+    uint16_t max_latency_ms;
+} cmd_start_stream_unpacked_t;
+
+/** Write v as its 8 wire bytes; returns CMD_START_STREAM_WIRE_SIZE */
+static inline size_t cmd_start_stream_pack(uint8_t *wire, const cmd_start_stream_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    wire_put_u32(wire + 1, v->interval_ms);
+    wire[5] = v->batch_size;
+    wire_put_u16(wire + 6, v->max_latency_ms);
+    return CMD_START_STREAM_WIRE_SIZE;
+}
+
+/** Read CMD_START_STREAM_WIRE_SIZE wire bytes into v; returns CMD_START_STREAM_WIRE_SIZE */
+static inline size_t cmd_start_stream_unpack(cmd_start_stream_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    v->interval_ms = wire_get_u32(wire + 1);
+    v->batch_size = wire[5];
+    v->max_latency_ms = wire_get_u16(wire + 6);
+    return CMD_START_STREAM_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_stop_stream_t
+// ============================================================================
+
+#define CMD_STOP_STREAM_WIRE_SIZE 1
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_stop_stream_t) == CMD_STOP_STREAM_WIRE_SIZE, "cmd_stop_stream_t does not match the IDL");
+
+typedef struct {
+    uint8_t sensor_type;
+} cmd_stop_stream_unpacked_t;
+
+/** Write v as its 1 wire bytes; returns CMD_STOP_STREAM_WIRE_SIZE */
+static inline size_t cmd_stop_stream_pack(uint8_t *wire, const cmd_stop_stream_unpacked_t *v)
+{
+    wire[0] = v->sensor_type;
+    return CMD_STOP_STREAM_WIRE_SIZE;
+}
+
+/** Read CMD_STOP_STREAM_WIRE_SIZE wire bytes into v; returns CMD_STOP_STREAM_WIRE_SIZE */
+static inline size_t cmd_stop_stream_unpack(cmd_stop_stream_unpacked_t *v, const uint8_t *wire)
+{
+    v->sensor_type = wire[0];
+    return CMD_STOP_STREAM_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_link_stats_t
+// ============================================================================
+
+#define RESP_LINK_STATS_WIRE_SIZE 34
+PROTOCOL_WIRE_ASSERT(sizeof(resp_link_stats_t) == RESP_LINK_STATS_WIRE_SIZE, "resp_link_stats_t does not match the IDL");
+
+typedef struct {
+    uint32_t window_ms;
+    uint32_t tx_bytes_per_s;
+    uint32_t rx_bytes_per_s;
+    uint32_t tx_frames_per_s;
+    uint32_t rx_frames_per_s;
+    uint32_t rx_error_ppm;
+    uint32_t tx_wait_mean_us;
+    uint32_t tx_wait_p99_us;
+    uint16_t tx_busy_permille;
+} resp_link_stats_unpacked_t;
+
+/** Write v as its 34 wire bytes; returns RESP_LINK_STATS_WIRE_SIZE */
+static inline size_t resp_link_stats_pack(uint8_t *wire, const resp_link_stats_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->window_ms);
+    wire_put_u32(wire + 4, v->tx_bytes_per_s);
+    wire_put_u32(wire + 8, v->rx_bytes_per_s);
+    wire_put_u32(wire + 12, v->tx_frames_per_s);
+    wire_put_u32(wire + 16, v->rx_frames_per_s);
+    wire_put_u32(wire + 20, v->rx_error_ppm);
+    wire_put_u32(wire + 24, v->tx_wait_mean_us);
+    wire_put_u32(wire + 28, v->tx_wait_p99_us);
+    wire_put_u16(wire + 32, v->tx_busy_permille);
+    return RESP_LINK_STATS_WIRE_SIZE;
+}
+
+/** Read RESP_LINK_STATS_WIRE_SIZE wire bytes into v; returns RESP_LINK_STATS_WIRE_SIZE */
+static inline size_t resp_link_stats_unpack(resp_link_stats_unpacked_t *v, const uint8_t *wire)
+{
+    v->window_ms = wire_get_u32(wire + 0);
+    v->tx_bytes_per_s = wire_get_u32(wire + 4);
+    v->rx_bytes_per_s = wire_get_u32(wire + 8);
+    v->tx_frames_per_s = wire_get_u32(wire + 12);
+    v->rx_frames_per_s = wire_get_u32(wire + 16);
+    v->rx_error_ppm = wire_get_u32(wire + 20);
+    v->tx_wait_mean_us = wire_get_u32(wire + 24);
+    v->tx_wait_p99_us = wire_get_u32(wire + 28);
+    v->tx_busy_permille = wire_get_u16(wire + 32);
+    return RESP_LINK_STATS_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_get_deadlines_t
+// ============================================================================
+
+#define CMD_GET_DEADLINES_WIRE_SIZE 1
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_get_deadlines_t) == CMD_GET_DEADLINES_WIRE_SIZE, "cmd_get_deadlines_t does not match the IDL");
+
+typedef struct {
+    uint8_t first_deadline_id;
+} cmd_get_deadlines_unpacked_t;
+
+/** Write v as its 1 wire bytes; returns CMD_GET_DEADLINES_WIRE_SIZE */
+static inline size_t cmd_get_deadlines_pack(uint8_t *wire, const cmd_get_deadlines_unpacked_t *v)
+{
+    wire[0] = v->first_deadline_id;
+    return CMD_GET_DEADLINES_WIRE_SIZE;
+}
+
+/** Read CMD_GET_DEADLINES_WIRE_SIZE wire bytes into v; returns CMD_GET_DEADLINES_WIRE_SIZE */
+static inline size_t cmd_get_deadlines_unpack(cmd_get_deadlines_unpacked_t *v, const uint8_t *wire)
+{
+    v->first_deadline_id = wire[0];
+    return CMD_GET_DEADLINES_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_deadlines_header_t
+// ============================================================================
+
+#define RESP_DEADLINES_HEADER_WIRE_SIZE 2
+PROTOCOL_WIRE_ASSERT(sizeof(resp_deadlines_header_t) == RESP_DEADLINES_HEADER_WIRE_SIZE, "resp_deadlines_header_t does not match the IDL");
+
+typedef struct {
+    uint8_t entry_count;
+    uint8_t next_deadline_id;
+} resp_deadlines_header_unpacked_t;
+
+/** Write v as its 2 wire bytes; returns RESP_DEADLINES_HEADER_WIRE_SIZE */
+static inline size_t resp_deadlines_header_pack(uint8_t *wire, const resp_deadlines_header_unpacked_t *v)
+{
+    wire[0] = v->entry_count;
+    wire[1] = v->next_deadline_id;
+    return RESP_DEADLINES_HEADER_WIRE_SIZE;
+}
+
+/** Read RESP_DEADLINES_HEADER_WIRE_SIZE wire bytes into v; returns RESP_DEADLINES_HEADER_WIRE_SIZE */
+static inline size_t resp_deadlines_header_unpack(resp_deadlines_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->entry_count = wire[0];
+    v->next_deadline_id = wire[1];
+    return RESP_DEADLINES_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_deadline_entry_t
+// ============================================================================
+
+#define RESP_DEADLINE_ENTRY_WIRE_SIZE 41
+PROTOCOL_WIRE_ASSERT(sizeof(resp_deadline_entry_t) == RESP_DEADLINE_ENTRY_WIRE_SIZE, "resp_deadline_entry_t does not match the IDL");
+
+typedef struct {
+    uint8_t deadline_id;
+    uint32_t period_us;
+    uint32_t budget_us;
+    uint32_t jobs;
+    uint32_t misses;
+    uint32_t overruns;
+    uint32_t lateness_p99_us;
+    uint32_t lateness_max_us;
+    uint32_t exec_avg_us;
+    uint32_t exec_p99_us;
+    uint32_t exec_max_us;
+} resp_deadline_entry_unpacked_t;
+
+/** Write v as its 41 wire bytes; returns RESP_DEADLINE_ENTRY_WIRE_SIZE */
+static inline size_t resp_deadline_entry_pack(uint8_t *wire, const resp_deadline_entry_unpacked_t *v)
+{
+    wire[0] = v->deadline_id;
+    wire_put_u32(wire + 1, v->period_us);
+    wire_put_u32(wire + 5, v->budget_us);
+    wire_put_u32(wire + 9, v->jobs);
+    wire_put_u32(wire + 13, v->misses);
+    wire_put_u32(wire + 17, v->overruns);
+    wire_put_u32(wire + 21, v->lateness_p99_us);
+    wire_put_u32(wire + 25, v->lateness_max_us);
+    wire_put_u32(wire + 29, v->exec_avg_us);
+    wire_put_u32(wire + 33, v->exec_p99_us);
+    wire_put_u32(wire + 37, v->exec_max_us);
+    return RESP_DEADLINE_ENTRY_WIRE_SIZE;
+}
+
+/** Read RESP_DEADLINE_ENTRY_WIRE_SIZE wire bytes into v; returns RESP_DEADLINE_ENTRY_WIRE_SIZE */
+static inline size_t resp_deadline_entry_unpack(resp_deadline_entry_unpacked_t *v, const uint8_t *wire)
+{
+    v->deadline_id = wire[0];
+    v->period_us = wire_get_u32(wire + 1);
+    v->budget_us = wire_get_u32(wire + 5);
+    v->jobs = wire_get_u32(wire + 9);
+    v->misses = wire_get_u32(wire + 13);
+    v->overruns = wire_get_u32(wire + 17);
+    v->lateness_p99_us = wire_get_u32(wire + 21);
+    v->lateness_max_us = wire_get_u32(wire + 25);
+    v->exec_avg_us = wire_get_u32(wire + 29);
+    v->exec_p99_us = wire_get_u32(wire + 33);
+    v->exec_max_us = wire_get_u32(wire + 37);
+    return RESP_DEADLINE_ENTRY_WIRE_SIZE;
+}
+
+// ============================================================================
+// time_stamp_t
+// ============================================================================
+
+#define TIME_STAMP_WIRE_SIZE 8
+PROTOCOL_WIRE_ASSERT(sizeof(time_stamp_t) == TIME_STAMP_WIRE_SIZE, "time_stamp_t does not match the IDL");
+
+typedef struct {
+    uint32_t sec;
+    uint32_t usec;
+} time_stamp_unpacked_t;
+
+/** Write v as its 8 wire bytes; returns TIME_STAMP_WIRE_SIZE */
+static inline size_t time_stamp_pack(uint8_t *wire, const time_stamp_unpacked_t *v)
+{
+    wire_put_u32(wire + 0, v->sec);
+    wire_put_u32(wire + 4, v->usec);
+    return TIME_STAMP_WIRE_SIZE;
+}
+
+/** Read TIME_STAMP_WIRE_SIZE wire bytes into v; returns TIME_STAMP_WIRE_SIZE */
+static inline size_t time_stamp_unpack(time_stamp_unpacked_t *v, const uint8_t *wire)
+{
+    v->sec = wire_get_u32(wire + 0);
+    v->usec = wire_get_u32(wire + 4);
+    return TIME_STAMP_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_time_sync_t
+// ============================================================================
+
+#define CMD_TIME_SYNC_WIRE_SIZE 24
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_time_sync_t) == CMD_TIME_SYNC_WIRE_SIZE, "cmd_time_sync_t does not match the IDL");
+
+typedef struct {
+    time_stamp_unpacked_t t1;
+    time_stamp_unpacked_t prev_t1;
+    time_stamp_unpacked_t prev_t4;
+} cmd_time_sync_unpacked_t;
+
+/** Write v as its 24 wire bytes; returns CMD_TIME_SYNC_WIRE_SIZE */
+static inline size_t cmd_time_sync_pack(uint8_t *wire, const cmd_time_sync_unpacked_t *v)
+{
+    time_stamp_pack(wire + 0, &v->t1);
+    time_stamp_pack(wire + 8, &v->prev_t1);
+    time_stamp_pack(wire + 16, &v->prev_t4);
+    return CMD_TIME_SYNC_WIRE_SIZE;
+}
+
+/** Read CMD_TIME_SYNC_WIRE_SIZE wire bytes into v; returns CMD_TIME_SYNC_WIRE_SIZE */
+static inline size_t cmd_time_sync_unpack(cmd_time_sync_unpacked_t *v, const uint8_t *wire)
+{
+    time_stamp_unpack(&v->t1, wire + 0);
+    time_stamp_unpack(&v->prev_t1, wire + 8);
+    time_stamp_unpack(&v->prev_t4, wire + 16);
+    return CMD_TIME_SYNC_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_time_sync_t
+// ============================================================================
+
+#define RESP_TIME_SYNC_WIRE_SIZE 37
+PROTOCOL_WIRE_ASSERT(sizeof(resp_time_sync_t) == RESP_TIME_SYNC_WIRE_SIZE, "resp_time_sync_t does not match the IDL");
+
+typedef struct {
+    time_stamp_unpacked_t t1;
+    time_stamp_unpacked_t t2;
+    time_stamp_unpacked_t t3;
+    int32_t offset_us;
+    uint32_t delay_us;
+    int32_t rate_ppb;
+    uint8_t flags;
+} resp_time_sync_unpacked_t;
+
+/** Write v as its 37 wire bytes; returns RESP_TIME_SYNC_WIRE_SIZE */
+static inline size_t resp_time_sync_pack(uint8_t *wire, const resp_time_sync_unpacked_t *v)
+{
+    time_stamp_pack(wire + 0, &v->t1);
+    time_stamp_pack(wire + 8, &v->t2);
+    time_stamp_pack(wire + 16, &v->t3);
+    wire_put_u32(wire + 24, (uint32_t)v->offset_us);
+    wire_put_u32(wire + 28, v->delay_us);
+    wire_put_u32(wire + 32, (uint32_t)v->rate_ppb);
+    wire[36] = v->flags;
+    return RESP_TIME_SYNC_WIRE_SIZE;
+}
+
+/** Read RESP_TIME_SYNC_WIRE_SIZE wire bytes into v; returns RESP_TIME_SYNC_WIRE_SIZE */
+static inline size_t resp_time_sync_unpack(resp_time_sync_unpacked_t *v, const uint8_t *wire)
+{
+    time_stamp_unpack(&v->t1, wire + 0);
+    time_stamp_unpack(&v->t2, wire + 8);
+    time_stamp_unpack(&v->t3, wire + 16);
+    v->offset_us = (int32_t)wire_get_u32(wire + 24);
+    v->delay_us = wire_get_u32(wire + 28);
+    v->rate_ppb = (int32_t)wire_get_u32(wire + 32);
+    v->flags = wire[36];
+    return RESP_TIME_SYNC_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_get_config_t
+// ============================================================================
+
+#define CMD_GET_CONFIG_WIRE_SIZE 1
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_get_config_t) == CMD_GET_CONFIG_WIRE_SIZE, "cmd_get_config_t does not match the IDL");
+
+typedef struct {
+    uint8_t first_key;
+} cmd_get_config_unpacked_t;
+
+/** Write v as its 1 wire bytes; returns CMD_GET_CONFIG_WIRE_SIZE */
+static inline size_t cmd_get_config_pack(uint8_t *wire, const cmd_get_config_unpacked_t *v)
+{
+    wire[0] = v->first_key;
+    return CMD_GET_CONFIG_WIRE_SIZE;
+}
+
+/** Read CMD_GET_CONFIG_WIRE_SIZE wire bytes into v; returns CMD_GET_CONFIG_WIRE_SIZE */
+static inline size_t cmd_get_config_unpack(cmd_get_config_unpacked_t *v, const uint8_t *wire)
+{
+    v->first_key = wire[0];
+    return CMD_GET_CONFIG_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_config_header_t
+// ============================================================================
+
+#define RESP_CONFIG_HEADER_WIRE_SIZE 7
+PROTOCOL_WIRE_ASSERT(sizeof(resp_config_header_t) == RESP_CONFIG_HEADER_WIRE_SIZE, "resp_config_header_t does not match the IDL");
+
+typedef struct {
+    uint8_t entry_count;
+    uint8_t next_key;
+    uint8_t state;
+    uint32_t saves;
+} resp_config_header_unpacked_t;
+
+/** Write v as its 7 wire bytes; returns RESP_CONFIG_HEADER_WIRE_SIZE */
+static inline size_t resp_config_header_pack(uint8_t *wire, const resp_config_header_unpacked_t *v)
+{
+    wire[0] = v->entry_count;
+    wire[1] = v->next_key;
+    wire[2] = v->state;
+    wire_put_u32(wire + 3, v->saves);
+    return RESP_CONFIG_HEADER_WIRE_SIZE;
+}
+
+/** Read RESP_CONFIG_HEADER_WIRE_SIZE wire bytes into v; returns RESP_CONFIG_HEADER_WIRE_SIZE */
+static inline size_t resp_config_header_unpack(resp_config_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->entry_count = wire[0];
+    v->next_key = wire[1];
+    v->state = wire[2];
+    v->saves = wire_get_u32(wire + 3);
+    return RESP_CONFIG_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_config_entry_t
+// ============================================================================
+
+#define RESP_CONFIG_ENTRY_WIRE_SIZE 19
+PROTOCOL_WIRE_ASSERT(sizeof(resp_config_entry_t) == RESP_CONFIG_ENTRY_WIRE_SIZE, "resp_config_entry_t does not match the IDL");
+
+typedef struct {
+    uint8_t key;
+    uint8_t type;
+    uint8_t flags;
+    uint32_t value;
+    uint32_t min_value;
+    uint32_t max_value;
+    uint32_t default_value;
+} resp_config_entry_unpacked_t;
+
+/** Write v as its 19 wire bytes; returns RESP_CONFIG_ENTRY_WIRE_SIZE */
+static inline size_t resp_config_entry_pack(uint8_t *wire, const resp_config_entry_unpacked_t *v)
+{
+    wire[0] = v->key;
+    wire[1] = v->type;
+    wire[2] = v->flags;
+    wire_put_u32(wire + 3, v->value);
+    wire_put_u32(wire + 7, v->min_value);
+    wire_put_u32(wire + 11, v->max_value);
+    wire_put_u32(wire + 15, v->default_value);
+    return RESP_CONFIG_ENTRY_WIRE_SIZE;
+}
+
+/** Read RESP_CONFIG_ENTRY_WIRE_SIZE wire bytes into v; returns RESP_CONFIG_ENTRY_WIRE_SIZE */
+static inline size_t resp_config_entry_unpack(resp_config_entry_unpacked_t *v, const uint8_t *wire)
+{
+    v->key = wire[0];
+    v->type = wire[1];
+    v->flags = wire[2];
+    v->value = wire_get_u32(wire + 3);
+    v->min_value = wire_get_u32(wire + 7);
+    v->max_value = wire_get_u32(wire + 11);
+    v->default_value = wire_get_u32(wire + 15);
+    return RESP_CONFIG_ENTRY_WIRE_SIZE;
+}
+
+// ============================================================================
+// config_value_t
+// ============================================================================
+
+#define CONFIG_VALUE_WIRE_SIZE 5
+PROTOCOL_WIRE_ASSERT(sizeof(config_value_t) == CONFIG_VALUE_WIRE_SIZE, "config_value_t does not match the IDL");
+
+typedef struct {
+    uint8_t key;
+    uint32_t value;
+} config_value_unpacked_t;
+
+/** Write v as its 5 wire bytes; returns CONFIG_VALUE_WIRE_SIZE */
+static inline size_t config_value_pack(uint8_t *wire, const config_value_unpacked_t *v)
+{
+    wire[0] = v->key;
+    wire_put_u32(wire + 1, v->value);
+    return CONFIG_VALUE_WIRE_SIZE;
+}
+
+/** Read CONFIG_VALUE_WIRE_SIZE wire bytes into v; returns CONFIG_VALUE_WIRE_SIZE */
+static inline size_t config_value_unpack(config_value_unpacked_t *v, const uint8_t *wire)
+{
+    v->key = wire[0];
+    v->value = wire_get_u32(wire + 1);
+    return CONFIG_VALUE_WIRE_SIZE;
+}
+
+// ============================================================================
+// cmd_set_config_header_t
+// ============================================================================
+
+#define CMD_SET_CONFIG_HEADER_WIRE_SIZE 2
+PROTOCOL_WIRE_ASSERT(sizeof(cmd_set_config_header_t) == CMD_SET_CONFIG_HEADER_WIRE_SIZE, "cmd_set_config_header_t does not match the IDL");
+
+typedef struct {
+    uint8_t flags;
+    uint8_t count;
+} cmd_set_config_header_unpacked_t;
+
+/** Write v as its 2 wire bytes; returns CMD_SET_CONFIG_HEADER_WIRE_SIZE */
+static inline size_t cmd_set_config_header_pack(uint8_t *wire, const cmd_set_config_header_unpacked_t *v)
+{
+    wire[0] = v->flags;
+    wire[1] = v->count;
+    return CMD_SET_CONFIG_HEADER_WIRE_SIZE;
+}
+
+/** Read CMD_SET_CONFIG_HEADER_WIRE_SIZE wire bytes into v; returns CMD_SET_CONFIG_HEADER_WIRE_SIZE */
+static inline size_t cmd_set_config_header_unpack(cmd_set_config_header_unpacked_t *v, const uint8_t *wire)
+{
+    v->flags = wire[0];
+    v->count = wire[1];
+    return CMD_SET_CONFIG_HEADER_WIRE_SIZE;
+}
+
+// ============================================================================
+// resp_set_config_t
+// ============================================================================
+
+#define RESP_SET_CONFIG_WIRE_SIZE 3
+PROTOCOL_WIRE_ASSERT(sizeof(resp_set_config_t) == RESP_SET_CONFIG_WIRE_SIZE, "resp_set_config_t does not match the IDL");
+
+typedef struct {
+    uint8_t applied;
+    uint8_t bad_key;
+    uint8_t flags;
+} resp_set_config_unpacked_t;
+
+/** Write v as its 3 wire bytes; returns RESP_SET_CONFIG_WIRE_SIZE */
+static inline size_t resp_set_config_pack(uint8_t *wire, const resp_set_config_unpacked_t *v)
+{
+    wire[0] = v->applied;
+    wire[1] = v->bad_key;
+    wire[2] = v->flags;
+    return RESP_SET_CONFIG_WIRE_SIZE;
+}
+
+/** Read RESP_SET_CONFIG_WIRE_SIZE wire bytes into v; returns RESP_SET_CONFIG_WIRE_SIZE */
+static inline size_t resp_set_config_unpack(resp_set_config_unpacked_t *v, const uint8_t *wire)
+{
+    v->applied = wire[0];
+    v->bad_key = wire[1];
+    v->flags = wire[2];
+    return RESP_SET_CONFIG_WIRE_SIZE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROTOCOL_WIRE_H
@@ -78,17 +78,22 @@ Revision: $Rev: 24316 $
 // Most common case:
 // Up-channel 0: RTT
 // Up-channel 1: SystemView
+// Up-channel 2: deferred binary log (log_deferred.h)
+// Up-channel 3: PC samples (pc_sampler.h)
+// Up-channel 4: protocol packets (protocol_transport_rtt.c)
+// Up-channel 5: event bus trace (event_trace.h)
 //
 #ifndef   SEGGER_RTT_MAX_NUM_UP_BUFFERS
-  #define SEGGER_RTT_MAX_NUM_UP_BUFFERS             (3)     // Max. number of up-buffers (T->H) available on this target    (Default: 3)
+  #define SEGGER_RTT_MAX_NUM_UP_BUFFERS             (6)     // Max. number of up-buffers (T->H) available on this target    (Default: 3)
 #endif
 //
 // Most common case:
 // Down-channel 0: RTT
 // Down-channel 1: SystemView
+// Down-channel 4: protocol commands (protocol_transport_rtt.c)
 //
 #ifndef   SEGGER_RTT_MAX_NUM_DOWN_BUFFERS
-  #define SEGGER_RTT_MAX_NUM_DOWN_BUFFERS           (3)     // Max. number of down-buffers (H->T) available on this target  (Default: 3)
+  #define SEGGER_RTT_MAX_NUM_DOWN_BUFFERS           (5)     // Max. number of down-buffers (H->T) available on this target  (Default: 3)
 #endif
 
 #ifndef   BUFFER_SIZE_UP
@@ -0,0 +1,50 @@
+/**
+ * @file recorder_backend.h
+ * @brief Block storage interface for the streaming recorder
+ *
+ * A backend stores fixed-size blocks at block numbers 0..block_count-1.
+ * Writes are asynchronous: write_block() starts one, poll() advances it
+ * from the service loop and reports when it is done. Only one write is in
+ * flight at a time; the recorder double-buffers on its side so the next
+ * block fills while the previous one is written.
+ *
+ * All calls come from one context at a time (the recorder serializes
+ * them), so backends need no locking of their own.
+ */
+
+#ifndef RECORDER_BACKEND_H
+#define RECORDER_BACKEND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    RECORDER_BACKEND_OK = 0,
+    RECORDER_BACKEND_BUSY,          /**< Write in progress (poll again) */
+    RECORDER_BACKEND_ERROR
+} recorder_backend_status_t;
+
+typedef struct {
+    const char *name;
+    uint32_t block_size;            /**< Bytes per block */
+
+    /** Bring up the storage; false if it is absent */
+    bool (*open)(void);
+
+    /** Blocks available (valid after open) */
+    uint32_t (*get_block_count)(void);
+
+    /** Start writing one block; data stays valid until poll() finishes it */
+    recorder_backend_status_t (*write_block)(uint32_t block, const uint8_t *data);
+
+    /** Advance the write: BUSY while running, then OK or ERROR once */
+    recorder_backend_status_t (*poll)(void);
+
+    /** Read bytes at a byte offset (BUSY while a write is in progress) */
+    recorder_backend_status_t (*read)(uint32_t offset, uint8_t *data, uint32_t len);
+} recorder_backend_t;
+
+/** External SPI NOR flash on the storage bus (BSP_Storage_SPI_Init()) */
+extern const recorder_backend_t recorder_backend_spi_nor;
+
+#endif // RECORDER_BACKEND_H
@@ -0,0 +1,61 @@
+/**
+ * @file recorder_backend_spi_nor.c
+ * @brief Recorder storage on an external SPI NOR flash
+ *
+ * One recorder block per 4 KB erase sector; a write erases the sector and
+ * programs it page by page over DMA (spi_nor.h).
+ */
+
+#include "recorder_backend.h"
+#include "spi_nor.h"
+#include "bsp.h"
+
+static spi_nor_t nor_flash;
+
+static bool nor_open(void)
+{
+    hal_spi_handle_t hspi = BSP_Storage_SPI_Init();
+    if (hspi == NULL) {
+        return false;
+    }
+    return spi_nor_open(&nor_flash, hspi, (hal_gpio_port_t)STORAGE_CS_PORT, STORAGE_CS_PIN) == HAL_SPI_OK;
+}
+
+static uint32_t nor_get_block_count(void)
+{
+    return nor_flash.initialized ? nor_flash.size_bytes / SPI_NOR_SECTOR_SIZE : 0;
+}
+
+static recorder_backend_status_t map_status(hal_spi_status_t status)
+{
+    switch (status) {
+        case HAL_SPI_OK:    return RECORDER_BACKEND_OK;
+        case HAL_SPI_BUSY:  return RECORDER_BACKEND_BUSY;
+        default:            return RECORDER_BACKEND_ERROR;
+    }
+}
+
+static recorder_backend_status_t nor_write_block(uint32_t block, const uint8_t *data)
+{
+    return map_status(spi_nor_write_sector_async(&nor_flash, block * SPI_NOR_SECTOR_SIZE, data));
+}
+
+static recorder_backend_status_t nor_poll(void)
+{
+    return map_status(spi_nor_poll(&nor_flash));
+}
+
+static recorder_backend_status_t nor_read(uint32_t offset, uint8_t *data, uint32_t len)
+{
+    return map_status(spi_nor_read(&nor_flash, offset, data, len));
+}
+
+const recorder_backend_t recorder_backend_spi_nor = {
+    .name = "spi_nor",
+    .block_size = SPI_NOR_SECTOR_SIZE,
+    .open = nor_open,
+    .get_block_count = nor_get_block_count,
+    .write_block = nor_write_block,
+    .poll = nor_poll,
+    .read = nor_read,
+};
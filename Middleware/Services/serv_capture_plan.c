@@ -0,0 +1,118 @@
+/**
+ * @file serv_capture_plan.c
+ * @brief Memory, storage and link budget of a current measurement
+ */
+
+#include "serv_capture_plan.h"
+#include "serv_recorder.h"
+#include <string.h>
+
+#define BLOCK_PAYLOAD       (RECORDER_BLOCK_SIZE - sizeof(recorder_block_header_t))
+#define COMPRESSED_RECORDS  (BLOCK_PAYLOAD * 8U / CAPTURE_PLAN_COMPRESSED_BITS)
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static uint32_t clamp_u32(uint64_t value)
+{
+    return (value > UINT32_MAX) ? UINT32_MAX : (uint32_t)value;
+}
+
+// Whole recorder blocks for samples at per_block records each
+static uint32_t flash_bytes(uint32_t samples, uint32_t per_block)
+{
+    uint64_t blocks = ((uint64_t)samples + per_block - 1U) / per_block;
+    return clamp_u32(blocks * RECORDER_BLOCK_SIZE);
+}
+
+// Blocks go out whole, so a block's share of bytes per sample
+static uint32_t block_rate(uint32_t rate_hz, uint32_t per_block)
+{
+    return clamp_u32(((uint64_t)rate_hz * RECORDER_BLOCK_SIZE + per_block - 1U) / per_block);
+}
+
+static void plan_needs(capture_plan_t *plan, const capture_plan_link_t *link)
+{
+    uint32_t samples = plan->samples;
+    uint32_t rate = plan->sample_rate_hz;
+
+    if (link != NULL && link->frame_samples != 0 && link->frame_bytes != 0) {
+        capture_plan_need_t *raw = &plan->need[CAPTURE_FORMAT_RAW];
+        uint32_t per_block = (uint32_t)(BLOCK_PAYLOAD * link->frame_samples / link->frame_bytes);
+        raw->ram_bytes = clamp_u32((uint64_t)samples * link->frame_bytes / link->frame_samples);
+        raw->flash_bytes = (per_block != 0) ? flash_bytes(samples, per_block) : UINT32_MAX;
+        raw->link_bytes_per_s = clamp_u32(((uint64_t)rate * link->frame_bytes + link->frame_samples - 1U) /
+                                          link->frame_samples);
+    }
+
+    capture_plan_need_t *packed = &plan->need[CAPTURE_FORMAT_PACKED];
+    uint64_t blocks = ((uint64_t)samples + CURRENT_MONITOR_BLOCK_SIZE - 1U) / CURRENT_MONITOR_BLOCK_SIZE;
+    packed->ram_bytes = clamp_u32((uint64_t)samples * CURRENT_MONITOR_SAMPLE_BYTES +
+                                  blocks * CURRENT_MONITOR_BLOCK_BYTES);
+    packed->flash_bytes = flash_bytes(samples, RECORDER_RECORDS_PER_BLOCK);
+    packed->link_bytes_per_s = block_rate(rate, RECORDER_RECORDS_PER_BLOCK);
+
+    capture_plan_need_t *compressed = &plan->need[CAPTURE_FORMAT_COMPRESSED];
+    compressed->ram_bytes = clamp_u32(((uint64_t)samples * CAPTURE_PLAN_COMPRESSED_BITS + 7U) / 8U);
+    compressed->flash_bytes = flash_bytes(samples, COMPRESSED_RECORDS);
+    compressed->link_bytes_per_s = block_rate(rate, COMPRESSED_RECORDS);
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+bool capture_plan_make(measurement_config_t *config, const capture_plan_link_t *link, capture_plan_t *plan)
+{
+    if (config == NULL || plan == NULL) {
+        return false;
+    }
+    memset(plan, 0, sizeof(*plan));
+
+    // Period and duration limits; the buffer size is what is planned here
+    config->offload = true;
+    bool valid = current_monitor_validate_config(config);
+    config->offload = false;
+    if (!valid) {
+        return false;
+    }
+
+    plan->samples = (config->duration_sec * 1000U) / config->sample_period;
+    plan->sample_rate_hz = 1000U / config->sample_period;
+    plan_needs(plan, link);
+
+    recorder_stats_t recorder;
+    recorder_get_stats(&recorder);
+    plan->ram_bytes = CURRENT_MONITOR_BUFFER_SIZE * CURRENT_MONITOR_SAMPLE_BYTES +
+                      (CURRENT_MONITOR_BUFFER_SIZE / CURRENT_MONITOR_BLOCK_SIZE) * CURRENT_MONITOR_BLOCK_BYTES;
+    plan->flash_bytes = (recorder.available && recorder.enabled)
+                      ? clamp_u32((uint64_t)recorder.block_count * RECORDER_BLOCK_SIZE) : 0;
+    plan->link_bytes_per_s = (link != NULL)
+                           ? (uint32_t)((uint64_t)link->bytes_per_s * CAPTURE_PLAN_LINK_HEADROOM_PCT / 100U) : 0;
+
+    capture_format_t flash_format = RECORDER_COMPRESS ? CAPTURE_FORMAT_COMPRESSED : CAPTURE_FORMAT_PACKED;
+    bool finite = (plan->samples != 0);
+
+    if (finite && plan->samples <= CURRENT_MONITOR_BUFFER_SIZE) {
+        plan->mode = CAPTURE_PLAN_BUFFER;
+        plan->format = CAPTURE_FORMAT_PACKED;
+    } else if (plan->link_bytes_per_s != 0 && plan->need[CAPTURE_FORMAT_RAW].link_bytes_per_s != 0 &&
+               plan->need[CAPTURE_FORMAT_RAW].link_bytes_per_s <= plan->link_bytes_per_s) {
+        plan->mode = CAPTURE_PLAN_STREAM;
+        plan->format = CAPTURE_FORMAT_RAW;
+    } else if (finite && plan->need[flash_format].flash_bytes <= plan->flash_bytes) {
+        plan->mode = CAPTURE_PLAN_FLASH;
+        plan->format = flash_format;
+    } else if (!finite) {
+        // Nothing keeps all of it: the buffer keeps the newest samples
+        plan->mode = CAPTURE_PLAN_BUFFER;
+        plan->format = CAPTURE_FORMAT_PACKED;
+    } else {
+        plan->mode = CAPTURE_PLAN_NONE;
+        return false;
+    }
+
+    config->offload = (plan->mode == CAPTURE_PLAN_STREAM || plan->mode == CAPTURE_PLAN_FLASH);
+    return true;
+}
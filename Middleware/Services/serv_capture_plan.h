@@ -0,0 +1,119 @@
+/**
+ * @file serv_capture_plan.h
+ * @brief Memory, storage and link budget of a current measurement
+ *
+ * current_monitor_validate_config() only knows the RAM buffer: a 1 ms x
+ * 3600 s measurement (3.6 M samples) does not fit its 8192 samples and is
+ * refused. capture_plan_make() works out what such a measurement needs in
+ * each format the firmware keeps samples in and picks the first of these
+ * that the device and link can sustain:
+ *
+ *   CAPTURE_PLAN_BUFFER    the whole measurement fits the RAM buffer, read it
+ *                          out afterwards (continuous: the newest samples)
+ *   CAPTURE_PLAN_STREAM    a following capture dump offloads it as it runs,
+ *                          in NOTIFY_CURRENT_DATA records
+ *   CAPTURE_PLAN_FLASH     the recorder stages it in block storage, packed
+ *                          or (RECORDER_COMPRESS) compressed
+ *
+ * Formats and what they cost per sample:
+ *
+ *   CAPTURE_FORMAT_RAW         decoded records as streamed (the link's record
+ *                              and framing share, capture_plan_link_t)
+ *   CAPTURE_FORMAT_PACKED      raw INA226 registers: CURRENT_MONITOR_SAMPLE_BYTES
+ *                              in RAM, recorder_record_t in flash
+ *   CAPTURE_FORMAT_COMPRESSED  series_codec blocks, CAPTURE_PLAN_COMPRESSED_BITS
+ *                              estimated (a noisy signal packs worse)
+ *
+ * A plan other than BUFFER sets config->offload, so the monitor wraps its
+ * buffer behind the consumer instead of refusing the duration.
+ *
+ * Usage example:
+ * @code
+ * capture_plan_t plan;
+ * if (capture_plan_make(&config, &link, &plan) && current_monitor_start_measurement(&config)) {
+ *     report(plan.mode, plan.need[plan.format].link_bytes_per_s);
+ * }
+ * @endcode
+ */
+
+#ifndef SERV_CAPTURE_PLAN_H
+#define SERV_CAPTURE_PLAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "serv_current_monitor.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+// Share of the link a stream may plan on (credits, responses and other streams share it)
+#define CAPTURE_PLAN_LINK_HEADROOM_PCT  80
+// Compressed size estimate per sample, in bits (steady signals pack below 16)
+#define CAPTURE_PLAN_COMPRESSED_BITS    16
+
+// ============================================================================
+// Types
+// ============================================================================
+
+typedef enum {
+    CAPTURE_PLAN_NONE = 0,          /**< Nothing sustains it: refused */
+    CAPTURE_PLAN_BUFFER,
+    CAPTURE_PLAN_STREAM,
+    CAPTURE_PLAN_FLASH,
+} capture_plan_mode_t;
+
+typedef enum {
+    CAPTURE_FORMAT_RAW = 0,
+    CAPTURE_FORMAT_PACKED,
+    CAPTURE_FORMAT_COMPRESSED,
+    CAPTURE_FORMAT_COUNT
+} capture_format_t;
+
+/**
+ * @brief The link a capture dump would stream over
+ */
+typedef struct {
+    uint32_t bytes_per_s;           /**< Wire throughput, 0: not streaming (no follow) */
+    uint32_t frame_bytes;           /**< Wire bytes of one full capture frame, framing included */
+    uint32_t frame_samples;         /**< Records it carries */
+} capture_plan_link_t;
+
+/**
+ * @brief What keeping a whole measurement takes in one format
+ *
+ * Volumes are 0 for a continuous measurement, which has no end.
+ */
+typedef struct {
+    uint32_t ram_bytes;             /**< Held in RAM until read out */
+    uint32_t flash_bytes;           /**< Staged in recorder blocks */
+    uint32_t link_bytes_per_s;      /**< Streamed live */
+} capture_plan_need_t;
+
+typedef struct {
+    uint32_t samples;               /**< The measurement takes, 0: continuous */
+    uint32_t sample_rate_hz;
+    capture_plan_need_t need[CAPTURE_FORMAT_COUNT];
+    uint32_t ram_bytes;             /**< Available: the sample buffer */
+    uint32_t flash_bytes;           /**< Available: recorder storage, 0 if it is off */
+    uint32_t link_bytes_per_s;      /**< Available to a stream, after the headroom */
+    capture_plan_mode_t mode;
+    capture_format_t format;        /**< Format the chosen mode keeps samples in */
+} capture_plan_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Work out the budget of a measurement and pick a mode
+ *
+ * @param config Measurement to plan; offload is set for STREAM and FLASH
+ * @param link Streaming link, NULL if the measurement is not followed
+ * @param plan Output: needs per format, what is available, the chosen mode
+ * @return false for an invalid period or duration, or when no mode fits
+ *         (plan->mode CAPTURE_PLAN_NONE, the rest still filled in)
+ */
+bool capture_plan_make(measurement_config_t *config, const capture_plan_link_t *link, capture_plan_t *plan);
+
+#endif // SERV_CAPTURE_PLAN_H
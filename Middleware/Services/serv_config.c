@@ -0,0 +1,335 @@
+/**
+ * @file serv_config.c
+ * @brief Runtime config store, saved in internal flash
+ */
+
+#include "serv_config.h"
+#include "serv_current_monitor.h"
+#include "serv_display.h"
+#include "serv_load_shed.h"
+#include "serv_temperature_sensor.h"
+#include "esp32_packet_framing.h"
+#include "hal_flash.h"
+#include "crc16.h"
+#include "os_wrapper.h"
+#include "os_sched.h"
+#include "services.h"
+#include "portable_log.h"
+#include <stddef.h>
+#include <string.h>
+
+static const char *TAG = "CONFIG";
+
+#define CONFIG_MAGIC                0x47464352UL    // "RCFG"
+#define CONFIG_SLOTS                (HAL_FLASH_DATA_SECTOR_SIZE / CONFIG_RECORD_SIZE)
+#define CONFIG_SECTORS              HAL_FLASH_CONFIG_SECTOR_COUNT
+#define CONFIG_STORE_BASE           (HAL_FLASH_DATA_BASE + HAL_FLASH_CONFIG_SECTOR * HAL_FLASH_DATA_SECTOR_SIZE)
+#define CONFIG_BAUD_MIN             9600
+
+// ============================================================================
+// Flash Layout
+// ============================================================================
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;          // Increases with every save, never 0
+    uint32_t values[CONFIG_RECORD_VALUES];
+    uint16_t count;             // Values stored; keys past it take their defaults
+    uint16_t crc;               // CRC16 over everything before it
+} config_record_t;
+
+_Static_assert(sizeof(config_record_t) == CONFIG_RECORD_SIZE, "config record does not fill its slot");
+_Static_assert(CONFIG_KEY_COUNT <= CONFIG_RECORD_VALUES, "config keys do not fit a record");
+_Static_assert(CONFIG_SECTORS >= 2, "the config store needs a sector to move to before an erase");
+
+// ============================================================================
+// Key Table
+// ============================================================================
+
+typedef struct {
+    config_info_t info;
+    void (*apply)(uint32_t value);  // Live keys; NULL = read where it is used
+} config_param_t;
+
+// Display, temperature and log values are the load shedder's normal level
+static void apply_load_shed(uint32_t value)
+{
+    (void)value;
+    load_shed_refresh();
+}
+
+static const config_param_t params[CONFIG_KEY_COUNT] = {
+    [CONFIG_KEY_TEMP_READ_MS]       = { { CONFIG_TYPE_U32, 0, TEMP_SENSOR_READ_INTERVAL_MS, 60000,
+                                          TEMP_SENSOR_READ_INTERVAL_MS }, apply_load_shed },
+    [CONFIG_KEY_DISPLAY_REFRESH_MS] = { { CONFIG_TYPE_U32, 0, 50, 10000, DISPLAY_MIN_REFRESH_MS }, apply_load_shed },
+    [CONFIG_KEY_DISPLAY_CHART_MS]   = { { CONFIG_TYPE_U32, 0, 5, 1000, DISPLAY_CHART_PERIOD_MS }, apply_load_shed },
+    [CONFIG_KEY_LOG_LEVEL]          = { { CONFIG_TYPE_U8, 0, LOG_LVL_NONE, LOG_LVL_VERBOSE,
+                                          LOG_DEFAULT_LEVEL }, apply_load_shed },
+    [CONFIG_KEY_STREAM_BATCH]       = { { CONFIG_TYPE_U8, 0, 1, PROTOCOL_STREAM_BATCH_AUTO, 1 }, NULL },
+    [CONFIG_KEY_STREAM_LATENCY_MS]  = { { CONFIG_TYPE_U16, 0, 0, 60000, 0 }, NULL },
+    [CONFIG_KEY_LINK_BAUD]          = { { CONFIG_TYPE_U32, CONFIG_FLAG_BOOT, CONFIG_BAUD_MIN,
+                                          STM32_UART_BAUD_MAX, STM32_UART_BAUD_RATE }, NULL },
+};
+
+// ============================================================================
+// Private Data
+// ============================================================================
+
+static volatile uint32_t values[CONFIG_KEY_COUNT];
+static uint32_t saved[CONFIG_KEY_COUNT];        // As in the last valid record (defaults if none)
+static uint32_t sequence = 0;                   // Of the last valid record
+static uint32_t active_sector = 0;              // Config sector taking records
+static uint32_t next_slot = CONFIG_SLOTS;       // First erased slot in it; CONFIG_SLOTS = move on
+static volatile bool save_requested = false;
+static bool store_ready = false;
+
+static config_stats_t stats = {0};
+
+// ============================================================================
+// Private Functions
+// ============================================================================
+
+static inline uint32_t slot_address(uint32_t sector, uint32_t slot)
+{
+    return CONFIG_STORE_BASE + sector * HAL_FLASH_DATA_SECTOR_SIZE + slot * CONFIG_RECORD_SIZE;
+}
+
+static inline const config_record_t *slot_record(uint32_t sector, uint32_t slot)
+{
+    return (const config_record_t *)slot_address(sector, slot);
+}
+
+static uint16_t record_crc(const config_record_t *record)
+{
+    return crc16_ccitt_bytewise(CRC16_CCITT_INIT, (const uint8_t *)record,
+                                offsetof(config_record_t, crc));
+}
+
+static bool record_valid(const config_record_t *record)
+{
+    return record->magic == CONFIG_MAGIC && record->sequence != 0 &&
+           record->count <= CONFIG_RECORD_VALUES && record->crc == record_crc(record);
+}
+
+static bool values_unsaved(void)
+{
+    for (uint32_t k = 0; k < CONFIG_KEY_COUNT; k++) {
+        if (values[k] != saved[k]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void apply_all(void)
+{
+    for (uint32_t k = 0; k < CONFIG_KEY_COUNT; k++) {
+        if (params[k].apply != NULL) {
+            params[k].apply(values[k]);
+        }
+    }
+}
+
+// Scan both sectors: the last valid record, and where the next one goes
+static void recover(void)
+{
+    const config_record_t *latest = NULL;
+    uint32_t free_slot[CONFIG_SECTORS];
+
+    active_sector = 0;
+    for (uint32_t sector = 0; sector < CONFIG_SECTORS; sector++) {
+        free_slot[sector] = CONFIG_SLOTS;
+        for (uint32_t slot = 0; slot < CONFIG_SLOTS; slot++) {
+            const config_record_t *record = slot_record(sector, slot);
+            if (record->magic == HAL_FLASH_ERASED_WORD) {
+                // Records are appended, so the rest is erased too
+                free_slot[sector] = slot;
+                break;
+            }
+            // Torn or foreign slots are skipped
+            if (record_valid(record) && (latest == NULL || record->sequence > latest->sequence)) {
+                latest = record;
+                active_sector = sector;
+            }
+        }
+    }
+
+    // Without a record, only a blank sector is trusted to be erased past
+    // its first blank word (it may hold sample log pages from before)
+    next_slot = free_slot[active_sector];
+    if (latest == NULL) {
+        if (next_slot != 0) {
+            next_slot = CONFIG_SLOTS;
+        }
+        return;
+    }
+
+    sequence = latest->sequence;
+    for (uint32_t k = 0; k < CONFIG_KEY_COUNT && k < latest->count; k++) {
+        // A value the current range no longer allows keeps the default
+        if (config_check((config_key_t)k, latest->values[k])) {
+            values[k] = latest->values[k];
+        }
+    }
+}
+
+static bool write_record(void)
+{
+    config_record_t record;
+
+    memset(&record, 0xFF, sizeof(record));
+    record.magic = CONFIG_MAGIC;
+    record.sequence = sequence + 1U;
+    record.count = CONFIG_KEY_COUNT;
+    uint32_t mask = os_critical_enter();
+    for (uint32_t k = 0; k < CONFIG_KEY_COUNT; k++) {
+        record.values[k] = values[k];
+    }
+    os_critical_exit(mask);
+    record.crc = record_crc(&record);
+
+    uint32_t address = slot_address(active_sector, next_slot);
+    next_slot++;    // A failed slot is not retried
+    if (!hal_flash_program(address, &record, sizeof(record)) ||
+        memcmp((const void *)address, &record, sizeof(record)) != 0) {
+        return false;
+    }
+
+    sequence = record.sequence;
+    for (uint32_t k = 0; k < CONFIG_KEY_COUNT; k++) {
+        saved[k] = record.values[k];
+    }
+    return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool config_init(void)
+{
+    for (uint32_t k = 0; k < CONFIG_KEY_COUNT; k++) {
+        values[k] = params[k].info.default_value;
+    }
+    recover();
+    for (uint32_t k = 0; k < CONFIG_KEY_COUNT; k++) {
+        saved[k] = values[k];
+    }
+    store_ready = true;
+
+    if (sequence == 0) {
+        LOG_I(TAG, "No saved config, using defaults");
+        return false;
+    }
+    LOG_I(TAG, "Config record %lu loaded, %lu slots free",
+          (unsigned long)sequence, (unsigned long)(CONFIG_SLOTS - next_slot));
+    return true;
+}
+
+uint32_t config_get(config_key_t key)
+{
+    return ((uint32_t)key < CONFIG_KEY_COUNT) ? values[key] : 0;
+}
+
+bool config_get_info(config_key_t key, config_info_t *info)
+{
+    if ((uint32_t)key >= CONFIG_KEY_COUNT || info == NULL) {
+        return false;
+    }
+    *info = params[key].info;
+    return true;
+}
+
+bool config_check(config_key_t key, uint32_t value)
+{
+    if ((uint32_t)key >= CONFIG_KEY_COUNT) {
+        return false;
+    }
+    const config_info_t *info = &params[key].info;
+    if (info->type == CONFIG_TYPE_BOOL) {
+        return value <= 1U;
+    }
+    return value >= info->min_value && value <= info->max_value;
+}
+
+bool config_set(config_key_t key, uint32_t value)
+{
+    if (!config_check(key, value)) {
+        return false;
+    }
+    if (values[key] == value) {
+        return true;
+    }
+
+    values[key] = value;
+    if (params[key].apply != NULL) {
+        params[key].apply(value);
+    }
+    LOG_I(TAG, "Key %u = %lu", (unsigned)key, (unsigned long)value);
+    return true;
+}
+
+void config_reset_defaults(void)
+{
+    for (uint32_t k = 0; k < CONFIG_KEY_COUNT; k++) {
+        values[k] = params[k].info.default_value;
+    }
+    apply_all();
+}
+
+void config_save(void)
+{
+    save_requested = true;
+    os_sched_post(SERVICES_JOB_CONFIG);
+}
+
+void config_process(void)
+{
+    if (!save_requested || !store_ready) {
+        return;
+    }
+
+    if (!values_unsaved()) {
+        save_requested = false;
+        return;
+    }
+
+    if (next_slot >= CONFIG_SLOTS) {
+        // Move on to the other sector. The last record stays in this one,
+        // so a reset during the erase (a 1-2 s flash stall) loses nothing
+        if (current_monitor_get_status() == MEASUREMENT_RUNNING) {
+            stats.deferred_saves++;
+            return;
+        }
+        uint32_t spare = (active_sector + 1U) % CONFIG_SECTORS;
+        stats.erases++;
+        if (!hal_flash_erase_data_sector(HAL_FLASH_CONFIG_SECTOR + spare)) {
+            LOG_E(TAG, "Config sector erase failed");
+            stats.save_errors++;
+            stats.save_failed = true;
+            save_requested = false;
+            return;
+        }
+        active_sector = spare;
+        next_slot = 0;
+    }
+
+    save_requested = false;
+    if (!write_record()) {
+        LOG_E(TAG, "Config save failed");
+        stats.save_errors++;
+        stats.save_failed = true;
+        return;
+    }
+    stats.saves++;
+    stats.save_failed = false;
+}
+
+void config_get_stats(config_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+    out->unsaved = values_unsaved();
+}
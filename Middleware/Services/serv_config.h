@@ -0,0 +1,140 @@
+/**
+ * @file serv_config.h
+ * @brief Runtime config store, saved in internal flash
+ *
+ * A fixed table of typed tunables (config_key_t, protocol_common.h), each
+ * with a range and a compile-time default, that CMD_GET_CONFIG and
+ * CMD_SET_CONFIG read and change in the field:
+ *
+ *   TEMP_READ_MS        temperature read interval     live
+ *   DISPLAY_REFRESH_MS  display refresh limit         live
+ *   DISPLAY_CHART_MS    capture poll while charting   live
+ *   LOG_LEVEL           default log level             live
+ *   STREAM_BATCH        default stream batch size     next START_MEASUREMENT
+ *   STREAM_LATENCY_MS   default stream flush deadline next START_MEASUREMENT
+ *   LINK_BAUD           UART rate                     next boot, supervised
+ *
+ * The live display, temperature and log values are the load shedder's
+ * normal level (serv_load_shed.h): its levels scale them, and a change
+ * takes over within one services period. Ring and buffer sizes are static
+ * storage and stay compile-time.
+ *
+ * The store lives in the two config sectors of the reserved flash area
+ * (HAL_FLASH_CONFIG_SECTOR on): every save appends one CRC-checked record
+ * of all values, and at boot the newest valid record in either sector wins
+ * over the defaults. When the active sector is full the other one is
+ * erased and the next record goes there, so the last record stays in flash
+ * through the erase and a reset during it loses nothing. The erase (like
+ * the sample log's) waits until no current measurement runs. Saves happen
+ * in config_process() only, so flash is touched from the services loop.
+ *
+ * Usage example:
+ * @code
+ * config_init();                                   // Before the services it drives
+ * uint32_t batch = config_get(CONFIG_KEY_STREAM_BATCH);
+ *
+ * if (config_set(CONFIG_KEY_DISPLAY_REFRESH_MS, 500)) {
+ *     config_save();                               // Written by config_process()
+ * }
+ * @endcode
+ */
+
+#ifndef SERV_CONFIG_H
+#define SERV_CONFIG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "protocol_common.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define CONFIG_RECORD_SIZE          64      // Flash slot per saved record
+#define CONFIG_RECORD_VALUES        13      // Keys a record can hold (CONFIG_KEY_COUNT and growth)
+#define CONFIG_BAUD_BOOT_PROBATION_MS 5000  // LINK_BAUD at boot falls back without a valid frame by then
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief What a key accepts
+ */
+typedef struct {
+    uint8_t type;                   /**< config_type_t */
+    uint8_t flags;                  /**< CONFIG_FLAG_* */
+    uint32_t min_value;
+    uint32_t max_value;
+    uint32_t default_value;
+} config_info_t;
+
+/**
+ * @brief Store statistics
+ */
+typedef struct {
+    uint32_t saves;                 /**< Records written since boot */
+    uint32_t save_errors;           /**< Programs that failed or did not read back */
+    uint32_t erases;
+    uint32_t deferred_saves;        /**< process() calls that postponed an erase */
+    bool unsaved;                   /**< Values differ from the saved record */
+    bool save_failed;               /**< The last save attempt failed */
+} config_stats_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Load the defaults, then the last saved record
+ * @return true if a saved record was found
+ */
+bool config_init(void);
+
+/**
+ * @brief Current value of a key (0 for an unknown key)
+ */
+uint32_t config_get(config_key_t key);
+
+/**
+ * @brief Range, type and default of a key
+ * @return false for an unknown key
+ */
+bool config_get_info(config_key_t key, config_info_t *info);
+
+/**
+ * @brief Whether a value is in a key's range
+ */
+bool config_check(config_key_t key, uint32_t value);
+
+/**
+ * @brief Change a value and apply it (live keys)
+ *
+ * Not saved until config_save(). Call from one task at a time (the
+ * protocol's command task).
+ *
+ * @return false (nothing changed) for an unknown key or a value out of range
+ */
+bool config_set(config_key_t key, uint32_t value);
+
+/**
+ * @brief Set every key back to its default and apply it
+ */
+void config_reset_defaults(void);
+
+/**
+ * @brief Have config_process() save the current values
+ */
+void config_save(void);
+
+/**
+ * @brief Write a requested save (call from the service loop)
+ */
+void config_process(void);
+
+/**
+ * @brief Get store statistics
+ */
+void config_get_stats(config_stats_t *stats);
+
+#endif // SERV_CONFIG_H
@@ -0,0 +1,225 @@
+/**
+ * @file serv_current_analysis.c
+ * @brief On-device analysis of a completed current capture
+ */
+
+#include "serv_current_analysis.h"
+#include "serv_current_monitor.h"
+#include "dsp_kernels.h"
+#include "hal_delay.h"
+#include "os_wrapper.h"
+#include "portable_log.h"
+#include <string.h>
+#include <math.h>
+
+static const char *TAG = "ANALYSIS";
+
+#define ANALYSIS_PI     3.14159265f
+
+// Kernel buffers (48 KB): currents, a work block that holds the voltages,
+// then the power, then the filtered currents, and the FIR history
+static float current_block[CURRENT_ANALYSIS_BLOCK_SIZE];
+static float work_block[CURRENT_ANALYSIS_BLOCK_SIZE];
+static float fir_state[CURRENT_ANALYSIS_FIR_TAPS + CURRENT_ANALYSIS_BLOCK_SIZE - 1];
+static float fir_coeffs[CURRENT_ANALYSIS_FIR_TAPS];
+static dsp_fir_f32_t fir;
+
+// Serializes users of the buffers above
+static os_mutex_handle_t analysis_mutex = NULL;
+OS_MUTEX_DEFINE(analysis);
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static void design_low_pass(void)
+{
+    float sum = 0.0f;
+
+    for (int32_t k = 0; k < CURRENT_ANALYSIS_FIR_TAPS; k++) {
+        int32_t n = k - CURRENT_ANALYSIS_FIR_DELAY;
+        float h = (n == 0) ? 2.0f * CURRENT_ANALYSIS_FIR_CUTOFF
+                           : sinf(2.0f * ANALYSIS_PI * CURRENT_ANALYSIS_FIR_CUTOFF * (float)n) /
+                             (ANALYSIS_PI * (float)n);
+        h *= 0.54f - 0.46f * cosf(2.0f * ANALYSIS_PI * (float)k / (float)(CURRENT_ANALYSIS_FIR_TAPS - 1));
+        fir_coeffs[k] = h;
+        sum += h;
+    }
+
+    // Unity DC gain. Symmetric, so already in the time reversed order
+    // the FIR kernel expects.
+    for (uint32_t k = 0; k < CURRENT_ANALYSIS_FIR_TAPS; k++) {
+        fir_coeffs[k] /= sum;
+    }
+}
+
+/**
+ * @brief Reset the filter and load the input history before start_index
+ *
+ * History older than the capture repeats its first sample, so the trace
+ * starts settled instead of ramping up from zero.
+ */
+static void fir_prime(uint32_t first_index, uint32_t start_index)
+{
+    uint32_t history = start_index - first_index;
+    if (history > CURRENT_ANALYSIS_FIR_TAPS - 1) {
+        history = CURRENT_ANALYSIS_FIR_TAPS - 1;
+    }
+
+    dsp_fir_init_f32(&fir, CURRENT_ANALYSIS_FIR_TAPS, fir_coeffs, fir_state, CURRENT_ANALYSIS_BLOCK_SIZE);
+
+    // One sample more than the history, for the padding value
+    if (current_monitor_read_scaled(start_index - history, current_block, work_block, history + 1) == 0) {
+        return;
+    }
+
+    uint32_t pad = (CURRENT_ANALYSIS_FIR_TAPS - 1) - history;
+    for (uint32_t i = 0; i < pad; i++) {
+        fir_state[i] = current_block[0];
+    }
+    memcpy(&fir_state[pad], current_block, history * sizeof(float));
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+void current_analysis_init(void)
+{
+    design_low_pass();
+
+    if (analysis_mutex == NULL) {
+        analysis_mutex = OS_MUTEX_CREATE_STATIC(analysis);
+    }
+    if (analysis_mutex == NULL) {
+        LOG_E(TAG, "Failed to create mutex");
+    }
+}
+
+bool current_analysis_run(current_analysis_result_t *result)
+{
+    uint32_t first_index, count;
+
+    if (result == NULL || analysis_mutex == NULL ||
+        !current_monitor_get_buffered_range(&first_index, &count)) {
+        return false;
+    }
+
+    measurement_config_t config;
+    current_monitor_get_config(&config);
+
+    os_mutex_take(analysis_mutex, OS_WAIT_FOREVER);
+
+    memset(result, 0, sizeof(*result));
+    result->first_index = first_index;
+    fir_prime(first_index, first_index);
+
+    double current_sum = 0.0, square_sum = 0.0, power_sum = 0.0;
+    uint64_t full_block_cycles = 0;
+    uint32_t full_blocks = 0;
+    uint32_t index = first_index;
+
+    while (result->sample_count < count) {
+        uint32_t n = current_monitor_read_scaled(index, current_block, work_block, CURRENT_ANALYSIS_BLOCK_SIZE);
+        if (n == 0) {
+            break;  // A new measurement started meanwhile
+        }
+
+        float mean, rms, peak, power_mean, filtered_peak;
+        uint32_t peak_at, filtered_peak_at;
+        uint32_t start = hal_get_cycle_count();
+
+        dsp_mean_f32(current_block, n, &mean);
+        dsp_rms_f32(current_block, n, &rms);
+        dsp_max_f32(current_block, n, &peak, &peak_at);
+        for (uint32_t i = 0; i < n; i++) {
+            work_block[i] = fabsf(current_block[i]) * work_block[i];
+        }
+        dsp_mean_f32(work_block, n, &power_mean);
+        dsp_fir_f32(&fir, current_block, work_block, n);
+        dsp_max_f32(work_block, n, &filtered_peak, &filtered_peak_at);
+
+        uint32_t cycles = hal_get_cycle_count() - start;
+
+        if (n == CURRENT_ANALYSIS_BLOCK_SIZE) {
+            full_block_cycles += cycles;
+            full_blocks++;
+            if (cycles > result->cycles_max_block) {
+                result->cycles_max_block = cycles;
+            }
+        }
+
+        current_sum += (double)mean * n;
+        square_sum += (double)rms * rms * n;
+        power_sum += (double)power_mean * n;
+
+        if (result->block_count == 0 || peak > result->peak_current_mA) {
+            result->peak_current_mA = peak;
+            result->peak_index = index + peak_at;
+        }
+        if (result->block_count == 0 || filtered_peak > result->filtered_peak_mA) {
+            uint32_t at = index + filtered_peak_at;
+            result->filtered_peak_mA = filtered_peak;
+            result->filtered_peak_index = (at - first_index >= CURRENT_ANALYSIS_FIR_DELAY)
+                                              ? at - CURRENT_ANALYSIS_FIR_DELAY : first_index;
+        }
+
+        result->block_count++;
+        result->sample_count += n;
+        index += n;
+    }
+
+    os_mutex_give(analysis_mutex);
+
+    if (result->sample_count == 0) {
+        return false;
+    }
+
+    float samples = (float)result->sample_count;
+    result->duration_s = samples * (float)config.sample_period / 1000.0f;
+    result->mean_current_mA = (float)(current_sum / samples);
+    result->rms_current_mA = sqrtf((float)(square_sum / samples));
+    result->mean_power_mW = (float)(power_sum / samples);
+    result->energy_mWh = result->mean_power_mW * result->duration_s / 3600.0f;
+    result->charge_mAh = result->mean_current_mA * result->duration_s / 3600.0f;
+    result->cycles_per_block = (full_blocks > 0) ? (uint32_t)(full_block_cycles / full_blocks) : 0;
+
+    LOG_D(TAG, "%lu samples in %lu blocks, %lu cycles/block",
+          (unsigned long)result->sample_count, (unsigned long)result->block_count,
+          (unsigned long)result->cycles_per_block);
+
+    return true;
+}
+
+uint32_t current_analysis_filtered_trace(uint32_t start_index, float *trace_mA, uint32_t max_samples)
+{
+    uint32_t first_index, count;
+
+    if (trace_mA == NULL || max_samples == 0 || analysis_mutex == NULL ||
+        !current_monitor_get_buffered_range(&first_index, &count) ||
+        start_index < first_index || start_index - first_index >= count) {
+        return 0;
+    }
+
+    os_mutex_take(analysis_mutex, OS_WAIT_FOREVER);
+
+    fir_prime(first_index, start_index);
+
+    uint32_t done = 0;
+    while (done < max_samples) {
+        uint32_t chunk = max_samples - done;
+        if (chunk > CURRENT_ANALYSIS_BLOCK_SIZE) {
+            chunk = CURRENT_ANALYSIS_BLOCK_SIZE;
+        }
+        uint32_t n = current_monitor_read_scaled(start_index + done, current_block, work_block, chunk);
+        if (n == 0) {
+            break;
+        }
+        dsp_fir_f32(&fir, current_block, &trace_mA[done], n);
+        done += n;
+    }
+
+    os_mutex_give(analysis_mutex);
+
+    return done;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file serv_current_analysis.h
+ * @brief On-device analysis of a completed current capture
+ *
+ * Walks the buffered samples of a finished current_monitor measurement in
+ * blocks of CURRENT_ANALYSIS_BLOCK_SIZE, using the CMSIS-DSP style kernels
+ * of dsp_kernels.h: mean and RMS current, peak current (raw and low-pass
+ * filtered), average power and the energy and charge drawn. Each full
+ * block is timed with the DWT cycle counter, so the cost per block is
+ * reported with the result.
+ *
+ * The low-pass is a linear-phase FIR of CURRENT_ANALYSIS_FIR_TAPS taps
+ * (Hamming-windowed sinc, unity DC gain); filtered traces lag the input by
+ * CURRENT_ANALYSIS_FIR_DELAY samples, which the reported filtered peak
+ * index already compensates.
+ *
+ * Work buffers are static and shared, so calls are serialized internally
+ * and run on the caller's task (roughly a millisecond per block).
+ *
+ * Usage example:
+ * @code
+ * current_analysis_result_t result;
+ * if (current_analysis_run(&result)) {
+ *     report(result.energy_mWh, result.peak_current_mA, result.cycles_per_block);
+ * }
+ * @endcode
+ */
+
+#ifndef SERV_CURRENT_ANALYSIS_H
+#define SERV_CURRENT_ANALYSIS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define CURRENT_ANALYSIS_BLOCK_SIZE     4096    // Samples per kernel call
+#define CURRENT_ANALYSIS_FIR_TAPS       15      // Odd: integer group delay
+#define CURRENT_ANALYSIS_FIR_CUTOFF     0.05f   // Low-pass corner, fraction of the sample rate
+#define CURRENT_ANALYSIS_FIR_DELAY      ((CURRENT_ANALYSIS_FIR_TAPS - 1) / 2)
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Analysis of one capture
+ */
+typedef struct {
+    uint32_t first_index;           /**< First sample analyzed (counts from measurement start) */
+    uint32_t sample_count;          /**< Samples analyzed */
+    uint32_t block_count;           /**< Kernel blocks, the last one may be partial */
+    float duration_s;               /**< sample_count x nominal sample period */
+    float mean_current_mA;
+    float rms_current_mA;
+    float peak_current_mA;          /**< Largest single sample */
+    uint32_t peak_index;
+    float filtered_peak_mA;         /**< Largest low-pass filtered value */
+    uint32_t filtered_peak_index;   /**< Delay compensated */
+    float mean_power_mW;            /**< Mean of |I| x V */
+    float energy_mWh;
+    float charge_mAh;               /**< Net, from the signed mean current */
+    uint32_t cycles_per_block;      /**< Average DWT cycles per full block, all kernels */
+    uint32_t cycles_max_block;      /**< Slowest full block */
+} current_analysis_result_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Initialize the analysis service (designs the low-pass filter)
+ */
+void current_analysis_init(void);
+
+/**
+ * @brief Analyze the completed measurement
+ *
+ * @param result Output
+ * @return false if no completed measurement holds samples
+ */
+bool current_analysis_run(current_analysis_result_t *result);
+
+/**
+ * @brief Low-pass filtered current of a completed measurement
+ *
+ * The filter is primed with the samples just before start_index, so
+ * consecutive calls produce one seamless trace.
+ *
+ * @param start_index First sample (counts from measurement start)
+ * @param trace_mA Output, one filtered value per input sample
+ * @param max_samples Maximum number of values
+ * @return Number of values written
+ */
+uint32_t current_analysis_filtered_trace(uint32_t start_index, float *trace_mA, uint32_t max_samples);
+
+#endif // SERV_CURRENT_ANALYSIS_H
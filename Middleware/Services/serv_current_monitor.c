@@ -1,16 +1,66 @@
 #include "serv_current_monitor.h"
 #include "ina226.h"
-#include "hal_rtc.h"
 #include "hal_delay.h"
+#include "hal_timer.h"
+#include "hal_timebase.h"
+#include "hal_clock.h"
 #include "bsp.h"
+#include "event_bus.h"
+#include "service_events.h"
+#include "os_wrapper.h"
+#include "os_workqueue.h"
+#include "deadline_monitor.h"
+#include "latency_trace.h"
+#include "last_value.h"
 #include <string.h>
+#include <math.h>
 
-// Ring buffer for samples
-static current_sample_t sample_buffer[CURRENT_MONITOR_BUFFER_SIZE];
-static volatile uint32_t sample_count = 0;
+#define CURRENT_MONITOR_BLOCK_COUNT (CURRENT_MONITOR_BUFFER_SIZE / CURRENT_MONITOR_BLOCK_SIZE)
+
+// Ring buffer for samples, stored as one array per field (raw registers,
+// converted lazily into current_sample_t) so window kernels stream
+// contiguous int16 data. Cache-line aligned, which also satisfies CMSIS-DSP.
+// Each block of CURRENT_MONITOR_BLOCK_SIZE slots shares a base tick,
+// written with the block's first sample; overwriting it invalidates the
+// whole old block, so readers keep a block of margin.
+static int16_t current_raw_buffer[CURRENT_MONITOR_BUFFER_SIZE] __ALIGNED(32);     // INA226 current register
+static uint16_t bus_voltage_raw_buffer[CURRENT_MONITOR_BUFFER_SIZE] __ALIGNED(32); // INA226 bus voltage register
+static uint16_t tick_delta_buffer[CURRENT_MONITOR_BUFFER_SIZE] __ALIGNED(32);     // Time since the block's base tick
+static uint8_t state_buffer[CURRENT_MONITOR_BUFFER_SIZE] __ALIGNED(32);           // Main state machine state
+#if CURRENT_MONITOR_TASK_TAGS
+static uint8_t task_buffer[CURRENT_MONITOR_BUFFER_SIZE] __ALIGNED(32);            // Running task's number
+#endif
+static uint32_t block_base_tick[CURRENT_MONITOR_BLOCK_COUNT];
+static uint64_t block_base_us[CURRENT_MONITOR_BLOCK_COUNT];   // Base tick as us since session start
+static float session_current_lsb_mA = 0.0f;    // mA per current register LSB
+static volatile uint32_t sample_count = 0;     // Captured this measurement; stored at % BUFFER_SIZE
+static bool continuous_mode = false;           // duration_sec == 0: runs until stopped
+static bool wrap_buffer = false;               // Continuous, or offloaded past the buffer size
+
+// Single-consumer drain (lock-free SPSC: producer owns sample_count,
+// consumer owns drain_tail; each only reads the other's index)
+static volatile bool drain_attached = false;
+static volatile uint32_t drain_tail = 0;       // Next index the consumer reads
+static uint32_t drain_session = 0;
+static volatile uint32_t drain_overruns = 0;   // Samples dropped since attach
+static uint32_t drain_high = 0;                // Watermarks, 0: none
+static uint32_t drain_low = 0;
+static current_monitor_drain_cb_t drain_cb = NULL;
+static void *drain_cb_arg = NULL;
+static volatile bool drain_above = false;       // High reported, low not yet
+
+// Latest conversion, stored by the data-ready callback (its one writer)
+// whether or not a measurement runs, so readers need no I2C round trip
+typedef struct {
+    INA226_Data data;
+    uint32_t tick;                             // hal_get_tick() at arrival
+} instant_reading_t;
+LAST_VALUE_DEFINE(instant, instant_reading_t);
 
 // Statistics
 static current_monitor_stats_t stats = {0};
+// Fed from the I2C completion interrupt; readers copy with IRQs off
+static stream_stats_t stream_stats[CURRENT_STATS_CHANNEL_COUNT];
 
 // Sensor reference
 static ina226_sensor_t* current_sensor = &default_ina226_sensor;
@@ -28,20 +78,94 @@ static volatile uint8_t current_state = 0;
 static uint32_t session_start_sec = 0;
 static uint16_t session_start_ms = 0;
 static uint32_t session_start_tick = 0;
+static volatile uint32_t session_id = 0;    // Bumped per measurement, for cursors
+static uint64_t session_start_us = 0;       // hal_timer time at session start (timer trigger)
+static uint32_t session_delta_unit_us = 1000; // tick_delta_buffer unit
 
-// Sample rate throttling
-static uint32_t last_sample_tick = 0;
+// Timer-triggered sampling
+static current_trigger_mode_t trigger_mode = CURRENT_TRIGGER_ALERT;
+static volatile uint64_t trigger_time_us = 0;  // Timer event of the read in flight
+
+// Sample rate throttling: the first conversion at or after each period
+// boundary is kept, so a conversion cycle just under the period still
+// yields the requested rate
+static uint32_t next_sample_tick = 0;
 static uint32_t sample_period_ms = 0;
+static uint32_t first_sample_tick = 0;
+static uint32_t last_sample_tick = 0;       // Rate and last read time are derived on readout
+
+// Triggered capture, armed on a continuous measurement. The sample callback
+// owns the trigger decision; set_state()/trigger_capture() only request it
+static current_capture_config_t capture_config = {0};
+static int16_t capture_threshold_raw = 0;
+static volatile bool capture_used = false;      // Armed at least once this measurement
+static volatile bool capture_armed = false;
+static volatile bool capture_pending = false;   // Next sample is the trigger sample
+static volatile bool capture_triggered = false;
+static volatile bool capture_done = false;      // Post-trigger samples complete
+static uint32_t capture_trigger_index = 0;
+
+// Performance level held for the running measurement
+static hal_clock_level_t clock_request = HAL_CLOCK_LEVEL_COUNT;    // None
+
+// Hardware limit watch (exclusive with measurements: one sensor, one ALERT)
+static current_limit_config_t limit_config = {0};
+static volatile bool limit_watch_active = false;
+static bool limit_above = false;
+static uint32_t limit_crossings = 0;
+static void limit_watch_work(void *ctx);
+static os_work_t limit_work = OS_WORK_INIT(limit_watch_work, NULL);
 
 // Forward declarations
 static void current_data_ready_callback(ina226_sensor_t* sensor, INA226_Data* data);
+static void sample_timer_callback(uint64_t timestamp_us, void *user_data);
 static void get_ina226_config_for_period(sample_period_ms_t period, ina226_config_t *config);
+static void tune_ina226_config(uint32_t period_us, ina226_config_t *config);
 static void check_measurement_completion(void);
+static void publish_stopped(measurement_status_t status);
+static uint32_t oldest_valid_index(uint32_t count);
+static void tick_to_timestamp(uint32_t tick, uint32_t *timestamp_sec, uint16_t *timestamp_ms);
+static void decode_samples(uint32_t index, current_sample_t *samples, uint32_t count);
+static void span_stats_q15(const int16_t *data, uint32_t count, int16_t *min, int16_t *max, int64_t *sum);
+static uint64_t sample_elapsed_us(uint32_t index);
+
+/**
+ * @brief Hold a performance level for the measurement (HAL_CLOCK_LEVEL_COUNT: none)
+ */
+static void set_clock_request(hal_clock_level_t level) {
+    if (level == clock_request) {
+        return;
+    }
+    if (level != HAL_CLOCK_LEVEL_COUNT) {
+        hal_clock_request(level);
+    }
+    if (clock_request != HAL_CLOCK_LEVEL_COUNT) {
+        hal_clock_release(clock_request);
+    }
+    clock_request = level;
+}
+
+static hal_clock_level_t clock_level_for_period(sample_period_ms_t period) {
+    if (period <= CURRENT_MONITOR_FULL_CLOCK_PERIOD_MS) {
+        return HAL_CLOCK_FULL;
+    }
+    if (period >= CURRENT_MONITOR_IDLE_CLOCK_PERIOD_MS) {
+        return HAL_CLOCK_LEVEL_COUNT;
+    }
+    return HAL_CLOCK_NORMAL;
+}
 
 void current_monitor_init(void) {
     // Initialize INA226 driver
     ina226_init();
     
+    const uint32_t windows[CURRENT_MONITOR_STATS_WINDOWS] = {
+        CURRENT_MONITOR_STATS_SHORT, CURRENT_MONITOR_STATS_LONG, 0
+    };
+    for (uint32_t ch = 0; ch < CURRENT_STATS_CHANNEL_COUNT; ch++) {
+        stream_stats_init(&stream_stats[ch], windows, CURRENT_MONITOR_STATS_WINDOWS);
+    }
+    
     // Clear buffer and statistics
     current_monitor_clear();
 }
@@ -51,8 +175,8 @@ bool current_monitor_validate_config(const measurement_config_t *config) {
         return false;
     }
     
-    // Validate duration (1 second to 1 hour)
-    if (config->duration_sec < 1 || config->duration_sec > 3600) {
+    // Validate duration (1 second to 1 hour, or 0 = continuous)
+    if (config->duration_sec > 3600) {
         return false;
     }
     
@@ -67,8 +191,9 @@ bool current_monitor_validate_config(const measurement_config_t *config) {
     // Calculate expected sample count
     uint32_t expected_samples = (config->duration_sec * 1000) / config->sample_period;
     
-    // Check if buffer can hold all samples
-    if (expected_samples > CURRENT_MONITOR_BUFFER_SIZE) {
+    // Check if buffer can hold all samples (continuous and offloaded
+    // measurements wrap instead)
+    if (config->duration_sec != 0 && !config->offload && expected_samples > CURRENT_MONITOR_BUFFER_SIZE) {
         return false;  // Too many samples for buffer
     }
     
@@ -81,8 +206,8 @@ bool current_monitor_start_measurement(const measurement_config_t *config) {
         return false;
     }
     
-    // Don't start if already running
-    if (measurement_status == MEASUREMENT_RUNNING) {
+    // Don't start if already running (or the sensor is watching limits)
+    if (measurement_status == MEASUREMENT_RUNNING || limit_watch_active) {
         return false;
     }
     
@@ -92,11 +217,22 @@ bool current_monitor_start_measurement(const measurement_config_t *config) {
     // Store configuration
     memcpy(&active_config, config, sizeof(measurement_config_t));
     active_config.max_samples = (config->duration_sec * 1000) / config->sample_period;
+    continuous_mode = (config->duration_sec == 0);
+    wrap_buffer = continuous_mode || active_config.max_samples > CURRENT_MONITOR_BUFFER_SIZE;
     
     // Get INA226 configuration for requested sample period
     ina226_config_t ina_config;
     get_ina226_config_for_period(config->sample_period, &ina_config);
     
+    // 1 ms sampling runs at full speed, 1 s logging at the idle level;
+    // before the bus speed, so the I2C timing is derived for that clock
+    set_clock_request(clock_level_for_period(config->sample_period));
+    
+    // 1 ms sampling needs the fastest bus; other rates keep the board default
+    hal_i2c_set_speed(BSP_Get_CurrentSensor_I2C(),
+                      (config->sample_period == SAMPLE_PERIOD_1MS) ? CURRENT_MONITOR_FAST_I2C_SPEED
+                                                                   : HAL_I2C_SPEED_DEFAULT);
+    
     // Open sensor
     hal_i2c_status_t status = ina226_open(
         current_sensor,
@@ -107,21 +243,38 @@ bool current_monitor_start_measurement(const measurement_config_t *config) {
     );
     
     if (status != HAL_I2C_OK) {
+        set_clock_request(HAL_CLOCK_LEVEL_COUNT);
         measurement_status = MEASUREMENT_ERROR;
         return false;
     }
     
-    // Capture session start timestamp
-    hal_rtc_time_t start_time;
-    if (hal_rtc_get_time(&start_time) == HAL_RTC_OK) {
-        session_start_sec = start_time.seconds;
-        session_start_ms = start_time.milliseconds;
+    // ALERT-driven reads from here on; if that cannot be enabled the
+    // service loop keeps polling via ina226_process_alert(). The timer
+    // trigger reads on its own schedule instead.
+    trigger_mode = config->trigger;
+    if (trigger_mode == CURRENT_TRIGGER_TIMER && !hal_timer_init()) {
+        trigger_mode = CURRENT_TRIGGER_ALERT;
+    }
+    if (trigger_mode == CURRENT_TRIGGER_ALERT) {
+        ina226_start_async(current_sensor);
     }
+    
+    // Capture session start timestamp (wall clock from the disciplined
+    // timebase, no RTC register read)
     session_start_tick = hal_get_tick();
+    session_start_us = hal_timebase_now_us();
+    uint64_t start_unix_us = hal_timebase_to_unix_us(session_start_us);
+    session_start_sec = (uint32_t)(start_unix_us / 1000000U);
+    session_start_ms = (uint16_t)((start_unix_us / 1000U) % 1000U);
+    // Timer-triggered deltas use period x 1 us units: us resolution at
+    // 1 ms while a block still spans 65535 units
+    session_delta_unit_us = (trigger_mode == CURRENT_TRIGGER_TIMER) ? config->sample_period : 1000;
+    session_current_lsb_mA = current_sensor->current_lsb * 1000.0f;
+    session_id++;
     
     // Initialize sample rate throttling
     sample_period_ms = config->sample_period;
-    last_sample_tick = hal_get_tick();
+    next_sample_tick = hal_get_tick();
     
     // Start measurement timing
     measurement_start_tick = hal_get_tick();
@@ -132,16 +285,33 @@ bool current_monitor_start_measurement(const measurement_config_t *config) {
     stats.status = MEASUREMENT_RUNNING;
     stats.sample_period = config->sample_period;
     stats.actual_sample_rate_hz = 1000.0f / config->sample_period;
+    stats.conversion_cycle_us = ina226_conversion_cycle_us(&ina_config);
+    stats.averaging_count = ina226_averaging_count(ina_config.averaging);
+    stats.noise_bandwidth_hz = 1e6f / (2.0f * (float)stats.averaging_count *
+                                       (float)ina226_conversion_time_us(ina_config.shunt_conv_time, true));
     stats.measurement_progress_percent = 0;
     
+    if (trigger_mode == CURRENT_TRIGGER_TIMER) {
+        // Each read is due to complete in half a period
+        uint32_t period_us = (uint32_t)config->sample_period * 1000U;
+        deadline_monitor_register(DEADLINE_CURRENT_SAMPLE, period_us, period_us / 2U);
+        hal_timer_start_periodic(period_us, sample_timer_callback, NULL);
+    }
+    
+    EVENT_SIGNAL(EVENT_MEASUREMENT_STARTED);
     return true;
 }
 
 void current_monitor_stop_measurement(void) {
     if (measurement_status == MEASUREMENT_RUNNING) {
+        hal_timer_stop_periodic();
+        deadline_monitor_unregister(DEADLINE_CURRENT_SAMPLE);
         ina226_close(current_sensor);
+        hal_i2c_set_speed(BSP_Get_CurrentSensor_I2C(), HAL_I2C_SPEED_DEFAULT);
+        set_clock_request(HAL_CLOCK_LEVEL_COUNT);
         measurement_status = MEASUREMENT_IDLE;
         stats.status = MEASUREMENT_IDLE;
+        publish_stopped(MEASUREMENT_IDLE);
     }
 }
 
@@ -158,11 +328,185 @@ bool current_monitor_is_complete(void) {
 }
 
 void current_monitor_set_state(uint8_t state) {
+    if (capture_armed && capture_config.source == CURRENT_CAPTURE_STATE_CHANGE && state != current_state) {
+        capture_pending = true;
+    }
     current_state = state;
 }
 
+bool current_monitor_arm_capture(const current_capture_config_t *config) {
+    if (config == NULL || config->source == CURRENT_CAPTURE_NONE ||
+        config->source > CURRENT_CAPTURE_EXTERNAL ||
+        config->pre_samples >= CURRENT_MONITOR_CAPTURE_MAX ||
+        config->post_samples >= CURRENT_MONITOR_CAPTURE_MAX - config->pre_samples) {
+        return false;
+    }
+    
+    if (measurement_status != MEASUREMENT_RUNNING || !continuous_mode) {
+        return false;
+    }
+    
+    // Compared against the raw current register in the sample callback
+    float raw = (session_current_lsb_mA > 0.0f) ? config->threshold_mA / session_current_lsb_mA : 0.0f;
+    int16_t threshold_raw = (raw >= (float)INT16_MAX) ? INT16_MAX
+                          : (raw <= (float)INT16_MIN) ? INT16_MIN
+                          : (int16_t)raw;
+    
+    __disable_irq();
+    capture_config = *config;
+    capture_threshold_raw = threshold_raw;
+    capture_pending = false;
+    capture_triggered = false;
+    capture_done = false;
+    capture_used = true;
+    capture_armed = true;
+    __enable_irq();
+    
+    return true;
+}
+
+void current_monitor_disarm_capture(void) {
+    __disable_irq();
+    capture_armed = false;
+    capture_pending = false;
+    __enable_irq();
+}
+
+void current_monitor_trigger_capture(void) {
+    if (capture_armed) {
+        capture_pending = true;
+    }
+}
+
+bool current_monitor_get_capture(current_capture_status_t *status_out) {
+    if (status_out == NULL || !capture_used) {
+        return false;
+    }
+    
+    __disable_irq();
+    bool armed = capture_armed;
+    bool triggered = capture_triggered;
+    uint32_t trigger_index = capture_trigger_index;
+    uint32_t count = sample_count;
+    __enable_irq();
+    
+    status_out->armed = armed;
+    status_out->triggered = triggered;
+    status_out->trigger_index = trigger_index;
+    status_out->first_index = 0;
+    status_out->count = 0;
+    
+    if (triggered) {
+        uint32_t first = (trigger_index > capture_config.pre_samples)
+                       ? trigger_index - capture_config.pre_samples : 0;
+        uint32_t oldest = oldest_valid_index(count);
+        if (first < oldest) {
+            first = oldest;
+        }
+        status_out->first_index = first;
+        status_out->count = count - first;
+    }
+    return true;
+}
+
+static hal_i2c_status_t arm_limit(bool above) {
+    // Above: wait for the way back down, otherwise for the way up
+    return above ? ina226_start_limit_alert(current_sensor, INA226_MASK_SUL,
+                                            ina226_shunt_limit_from_mA(current_sensor, limit_config.low_mA))
+                 : ina226_start_limit_alert(current_sensor, INA226_MASK_SOL,
+                                            ina226_shunt_limit_from_mA(current_sensor, limit_config.high_mA));
+}
+
+bool current_monitor_start_limit_watch(const current_limit_config_t *config) {
+    if (config == NULL || config->low_mA > config->high_mA ||
+        measurement_status == MEASUREMENT_RUNNING || limit_watch_active) {
+        return false;
+    }
+    
+    // Shunt only, 64 x 1.1 ms: ~70 ms per compared conversion, well filtered
+    ina226_config_t ina_config = {
+        .averaging = INA226_CONFIG_AVG_64,
+        .bus_conv_time = INA226_CONFIG_VBUSCT_1100US,
+        .shunt_conv_time = INA226_CONFIG_VSHCT_1100US,
+        .mode = INA226_CONFIG_MODE_SHUNT_CONT,
+        .read_fields = INA226_READ_CURRENT,
+    };
+    hal_i2c_set_speed(BSP_Get_CurrentSensor_I2C(), HAL_I2C_SPEED_DEFAULT);
+    if (ina226_open(current_sensor, BSP_Get_CurrentSensor_I2C(), 0.1f, NULL, &ina_config) != HAL_I2C_OK) {
+        return false;
+    }
+    
+    // Start on the side the current is on now; no event for it
+    INA226_Data data;
+    limit_config = *config;
+    limit_crossings = 0;
+    limit_above = (ina226_read(current_sensor, &data) == HAL_I2C_OK) && data.current_mA >= config->high_mA;
+    if (arm_limit(limit_above) != HAL_I2C_OK) {
+        ina226_close(current_sensor);
+        return false;
+    }
+    
+    // Crossings run on the work queue from here on; the first pass
+    // catches an ALERT latched while arming
+    limit_watch_active = true;
+    ina226_set_alert_work(current_sensor, &limit_work);
+    os_work_submit(&limit_work);
+    return true;
+}
+
+void current_monitor_stop_limit_watch(void) {
+    if (!limit_watch_active) {
+        return;
+    }
+    
+    limit_watch_active = false;
+    ina226_set_alert_work(current_sensor, NULL);
+    ina226_close(current_sensor);
+}
+
+bool current_monitor_limit_watch_above(void) {
+    return limit_watch_active && limit_above;
+}
+
+static void process_limit_watch(void) {
+    bool tripped = false;
+    if (ina226_check_limit_alert(current_sensor, &tripped) != HAL_I2C_OK || !tripped) {
+        return;
+    }
+    
+    limit_above = !limit_above;
+    limit_crossings++;
+    arm_limit(limit_above);
+    
+    // The current reading is an extra I2C transfer: only for a listener
+    if (!event_bus_has_subscribers(EVENT_CURRENT_LIMIT)) {
+        return;
+    }
+    
+    INA226_Data data;
+    current_limit_event_t event = {
+        .above = limit_above,
+        .current_mA = (ina226_read(current_sensor, &data) == HAL_I2C_OK) ? data.current_mA : 0.0f,
+        .crossings = limit_crossings,
+    };
+    EVENT_PUBLISH(EVENT_CURRENT_LIMIT, &event);
+}
+
+static void limit_watch_work(void *ctx) {
+    (void)ctx;
+    if (limit_watch_active) {
+        process_limit_watch();
+    }
+}
+
 void current_monitor_process(void) {
-    // Trigger INA226 to process any pending alerts
+    // The limit watch runs on ALERT work items, not here
+    if (limit_watch_active) {
+        return;
+    }
+    
+    // Trigger INA226 to process any pending alerts (non-blocking when
+    // acquisition is interrupt-driven)
     ina226_process_alert(current_sensor);
     
     // Check measurement completion
@@ -181,31 +525,429 @@ uint32_t current_monitor_read_measurement(current_sample_t *samples, uint32_t ma
         return 0;
     }
     
-    // Read all available samples (up to max_samples)
-    uint32_t to_read = (sample_count < max_samples) ? sample_count : max_samples;
+    // Read all available samples (up to max_samples); a wrapped buffer
+    // starts at its oldest readable one
+    uint32_t first = oldest_valid_index(sample_count);
+    uint32_t to_read = sample_count - first;
+    if (to_read > max_samples) {
+        to_read = max_samples;
+    }
     
     if (to_read > 0) {
-        memcpy(samples, sample_buffer, to_read * sizeof(current_sample_t));
+        decode_samples(first, samples, to_read);
     }
     
     return to_read;
 }
 
+uint32_t current_monitor_read_range(uint32_t start_index, current_sample_t *samples, uint32_t max_samples) {
+    if (samples == NULL || max_samples == 0) {
+        return 0;
+    }
+    
+    // Only allow reading when measurement is complete (buffer no longer written)
+    if (measurement_status != MEASUREMENT_COMPLETE || start_index >= sample_count ||
+        start_index < oldest_valid_index(sample_count)) {
+        return 0;
+    }
+    
+    uint32_t to_read = sample_count - start_index;
+    if (to_read > max_samples) {
+        to_read = max_samples;
+    }
+    
+    decode_samples(start_index, samples, to_read);
+    
+    return to_read;
+}
+
+bool current_monitor_get_buffered_range(uint32_t *first_index, uint32_t *count) {
+    if (first_index == NULL || count == NULL || measurement_status != MEASUREMENT_COMPLETE) {
+        return false;
+    }
+    
+    *first_index = oldest_valid_index(sample_count);
+    *count = sample_count - *first_index;
+    return (*count > 0);
+}
+
+uint32_t current_monitor_read_scaled(uint32_t start_index, float *current_mA, float *voltage_V,
+                                     uint32_t max_samples) {
+    if (current_mA == NULL || voltage_V == NULL || max_samples == 0) {
+        return 0;
+    }
+    
+    if (measurement_status != MEASUREMENT_COMPLETE || start_index >= sample_count ||
+        start_index < oldest_valid_index(sample_count)) {
+        return 0;
+    }
+    
+    uint32_t to_read = sample_count - start_index;
+    if (to_read > max_samples) {
+        to_read = max_samples;
+    }
+    
+    // Only the register arrays are touched, no timestamp decoding
+    for (uint32_t i = 0; i < to_read; i++) {
+        uint32_t slot = (start_index + i) % CURRENT_MONITOR_BUFFER_SIZE;
+        current_mA[i] = (float)current_raw_buffer[slot] * session_current_lsb_mA;
+        voltage_V[i] = (float)bus_voltage_raw_buffer[slot] * INA226_BUS_VOLTAGE_LSB_V;
+    }
+    
+    return to_read;
+}
+
+void current_monitor_cursor_init(current_monitor_cursor_t *cursor) {
+    if (cursor == NULL) {
+        return;
+    }
+    
+    __disable_irq();
+    cursor->session = session_id;
+    cursor->index = sample_count;
+    cursor->dropped = 0;
+    __enable_irq();
+}
+
+uint32_t current_monitor_read_new(current_monitor_cursor_t *cursor, current_sample_t *samples, uint32_t max_samples) {
+    if (cursor == NULL || samples == NULL || max_samples == 0) {
+        return 0;
+    }
+    
+    // A new measurement restarts the buffer at index 0
+    if (cursor->session != session_id) {
+        cursor->session = session_id;
+        cursor->index = 0;
+    }
+    
+    uint32_t available = sample_count;
+    __DMB();
+    
+    // Skip samples a continuous measurement has already overwritten
+    uint32_t oldest = oldest_valid_index(available);
+    if (cursor->index < oldest) {
+        cursor->dropped += oldest - cursor->index;
+        cursor->index = oldest;
+    }
+    
+    if (cursor->index >= available) {
+        return 0;
+    }
+    
+    uint32_t to_read = available - cursor->index;
+    if (to_read > max_samples) {
+        to_read = max_samples;
+    }
+    
+    decode_samples(cursor->index, samples, to_read);
+    
+    // The writer may have lapped the decoded range meanwhile (the block
+    // margin also covers a slot or base tick being written right now).
+    // Discard those from the front.
+    __DMB();
+    uint32_t valid_from = oldest_valid_index(sample_count);
+    if (valid_from > cursor->index) {
+        uint32_t torn = valid_from - cursor->index;
+        if (torn > to_read) {
+            torn = to_read;
+        }
+        memmove(samples, &samples[torn], (to_read - torn) * sizeof(current_sample_t));
+        to_read -= torn;
+        cursor->dropped += torn;
+        cursor->index += torn;
+    }
+    
+    cursor->index += to_read;
+    
+    return to_read;
+}
+
+bool current_monitor_drain_attach(uint32_t start_index) {
+    if (drain_attached) {
+        return false;
+    }
+    
+    __disable_irq();
+    uint32_t count = sample_count;
+    uint32_t oldest = oldest_valid_index(count);
+    drain_tail = (start_index < oldest) ? oldest : (start_index > count) ? count : start_index;
+    drain_session = session_id;
+    drain_overruns = 0;
+    drain_attached = true;
+    __enable_irq();
+    
+    return true;
+}
+
+void current_monitor_drain_detach(void) {
+    __disable_irq();
+    drain_attached = false;
+    drain_high = 0;
+    drain_cb = NULL;
+    drain_above = false;
+    __enable_irq();
+}
+
+bool current_monitor_drain_set_watermarks(uint32_t high, uint32_t low,
+                                          current_monitor_drain_cb_t callback, void *user_data) {
+    if (!drain_attached ||
+        (high != 0 && (callback == NULL || low >= high ||
+                       high > CURRENT_MONITOR_BUFFER_SIZE - CURRENT_MONITOR_BLOCK_SIZE))) {
+        return false;
+    }
+    
+    __disable_irq();
+    drain_high = high;
+    drain_low = low;
+    drain_cb = (high != 0) ? callback : NULL;
+    drain_cb_arg = user_data;
+    drain_above = false;
+    __enable_irq();
+    
+    return true;
+}
+
+uint32_t current_monitor_drain_read(current_sample_t *samples, uint32_t max_samples, uint32_t *first_index) {
+    if (!drain_attached || samples == NULL || max_samples == 0) {
+        return 0;
+    }
+    
+    // A new measurement restarted the buffer (clear() reset the tail)
+    if (drain_session != session_id) {
+        drain_session = session_id;
+        drain_tail = 0;
+    }
+    
+    uint32_t tail = drain_tail;
+    uint32_t available = sample_count;
+    __DMB();    // Samples up to 'available' are fully written
+    
+    if (tail >= available) {
+        return 0;
+    }
+    
+    uint32_t to_read = available - tail;
+    if (to_read > max_samples) {
+        to_read = max_samples;
+    }
+    
+    decode_samples(tail, samples, to_read);
+    
+    __DMB();    // Finish decoding before the producer may reuse the slots
+    drain_tail = tail + to_read;
+    
+    if (drain_high != 0 && available - drain_tail <= drain_low) {
+        __disable_irq();
+        bool was_above = drain_above;
+        drain_above = false;
+        current_monitor_drain_cb_t callback = drain_cb;
+        void *arg = drain_cb_arg;
+        __enable_irq();
+        if (was_above && callback != NULL) {
+            callback(false, arg);
+        }
+    }
+    
+    if (first_index != NULL) {
+        *first_index = tail;
+    }
+    return to_read;
+}
+
+uint32_t current_monitor_drain_get_overruns(void) {
+    return drain_overruns;
+}
+
+bool current_monitor_window_stats(uint32_t start_index, uint32_t count, current_window_stats_t *stats_out) {
+    if (stats_out == NULL || count == 0) {
+        return false;
+    }
+    
+    uint32_t available = sample_count;
+    __DMB();
+    
+    if (start_index < oldest_valid_index(available) || start_index + count > available) {
+        return false;
+    }
+    
+    int16_t current_min = INT16_MAX, current_max = INT16_MIN;
+    int16_t voltage_min = INT16_MAX, voltage_max = INT16_MIN;
+    int64_t current_sum = 0, voltage_sum = 0;
+    
+    // Walk the window in contiguous spans, splitting where the ring wraps.
+    // Bit 15 of the bus voltage register is always 0, so it is valid q15.
+    uint32_t index = start_index;
+    uint32_t remaining = count;
+    while (remaining > 0) {
+        uint32_t slot = index % CURRENT_MONITOR_BUFFER_SIZE;
+        uint32_t span = CURRENT_MONITOR_BUFFER_SIZE - slot;
+        if (span > remaining) {
+            span = remaining;
+        }
+        span_stats_q15(&current_raw_buffer[slot], span, &current_min, &current_max, &current_sum);
+        span_stats_q15((const int16_t *)&bus_voltage_raw_buffer[slot], span, &voltage_min, &voltage_max, &voltage_sum);
+        index += span;
+        remaining -= span;
+    }
+    
+    // A continuous measurement may have lapped the window meanwhile
+    __DMB();
+    if (start_index < oldest_valid_index(sample_count)) {
+        return false;
+    }
+    
+    stats_out->count = count;
+    stats_out->current_min_mA = (float)current_min * session_current_lsb_mA;
+    stats_out->current_max_mA = (float)current_max * session_current_lsb_mA;
+    stats_out->current_mean_mA = ((float)current_sum / (float)count) * session_current_lsb_mA;
+    stats_out->voltage_min_V = (float)voltage_min * INA226_BUS_VOLTAGE_LSB_V;
+    stats_out->voltage_max_V = (float)voltage_max * INA226_BUS_VOLTAGE_LSB_V;
+    stats_out->voltage_mean_V = ((float)voltage_sum / (float)count) * INA226_BUS_VOLTAGE_LSB_V;
+    
+    return true;
+}
+
+uint32_t current_monitor_energy_by(current_energy_key_t by, uint32_t start_index, uint32_t count,
+                                   current_energy_bin_t *bins, uint32_t max_bins) {
+    if (bins == NULL || max_bins == 0 || count == 0) {
+        return 0;
+    }
+#if !CURRENT_MONITOR_TASK_TAGS
+    if (by == CURRENT_ENERGY_BY_TASK) {
+        return 0;
+    }
+#endif
+    
+    uint32_t available = sample_count;
+    __DMB();
+    
+    if (start_index < oldest_valid_index(available) || start_index + count > available) {
+        return 0;
+    }
+    
+    // Interval of the last sample when there is no next one to measure to
+    uint32_t period_us = (uint32_t)active_config.sample_period * 1000U;
+    uint32_t used = 0;
+    uint64_t at_us = sample_elapsed_us(start_index);
+    
+    for (uint32_t i = 0, index = start_index; i < count; i++, index++) {
+        uint32_t slot = index % CURRENT_MONITOR_BUFFER_SIZE;
+        uint64_t next_us = (index + 1 < available) ? sample_elapsed_us(index + 1) : at_us + period_us;
+        uint32_t interval_us = (uint32_t)(next_us - at_us);
+        at_us = next_us;
+        
+#if CURRENT_MONITOR_TASK_TAGS
+        uint8_t key = (by == CURRENT_ENERGY_BY_TASK) ? task_buffer[slot] : state_buffer[slot];
+#else
+        uint8_t key = state_buffer[slot];
+#endif
+        uint32_t bin = 0;
+        while (bin < used && bins[bin].key != key) {
+            bin++;
+        }
+        if (bin == used) {
+            if (used < max_bins) {
+                memset(&bins[used], 0, sizeof(bins[used]));
+                bins[used].key = key;
+                used++;
+            } else {
+                bin = max_bins - 1;     // Overflow: lumped into the last bin
+            }
+        }
+        
+        float current_mA = fabsf((float)current_raw_buffer[slot] * session_current_lsb_mA);
+        float voltage_V = (float)bus_voltage_raw_buffer[slot] * INA226_BUS_VOLTAGE_LSB_V;
+        float seconds = (float)interval_us * 1e-6f;
+        bins[bin].samples++;
+        bins[bin].duration_us += interval_us;
+        bins[bin].energy_mJ += current_mA * voltage_V * seconds;
+        bins[bin].charge_mC += current_mA * seconds;
+    }
+    
+    // A continuous measurement may have lapped the window meanwhile
+    __DMB();
+    if (start_index < oldest_valid_index(sample_count)) {
+        return 0;
+    }
+    
+    // Few bins: insertion sort, most energy first
+    for (uint32_t i = 1; i < used; i++) {
+        current_energy_bin_t moving = bins[i];
+        uint32_t j = i;
+        while (j > 0 && bins[j - 1].energy_mJ < moving.energy_mJ) {
+            bins[j] = bins[j - 1];
+            j--;
+        }
+        bins[j] = moving;
+    }
+    return used;
+}
+
+uint32_t current_monitor_sample_tick(const current_sample_t *sample) {
+    // Timestamps are derived from the session start tick, so this is exact
+    int32_t elapsed_ms = (int32_t)(sample->timestamp_sec - session_start_sec) * 1000 +
+                         ((int32_t)sample->timestamp_ms - (int32_t)session_start_ms);
+    return session_start_tick + (uint32_t)elapsed_ms;
+}
+
+void current_monitor_get_config(measurement_config_t *config) {
+    if (config != NULL) {
+        memcpy(config, &active_config, sizeof(measurement_config_t));
+    }
+}
+
+float current_monitor_get_current_lsb_mA(void) {
+    return session_current_lsb_mA;
+}
+
+bool current_monitor_get_stream_stats(current_stats_channel_t channel, uint32_t window,
+                                      stream_stats_summary_t *summary) {
+    if (channel >= CURRENT_STATS_CHANNEL_COUNT || summary == NULL) {
+        return false;
+    }
+    
+    __disable_irq();
+    stream_stats_status_t status = stream_stats_get_summary(&stream_stats[channel], window, summary);
+    __enable_irq();
+    
+    return (status == STREAM_STATS_OK);
+}
+
 void current_monitor_get_stats(current_monitor_stats_t *stats_out) {
     if (stats_out != NULL) {
         __disable_irq();
         memcpy(stats_out, &stats, sizeof(current_monitor_stats_t));
+        uint32_t count = sample_count;
+        uint32_t first = first_sample_tick;
+        uint32_t last = last_sample_tick;
         __enable_irq();
+        
+        // Kept out of the sample callback: only the ticks are recorded there
+        if (count > 0) {
+            tick_to_timestamp(last, &stats_out->last_read_time_sec, &stats_out->last_read_time_ms);
+        }
+        if (count > 1 && last != first) {
+            stats_out->actual_sample_rate_hz = (float)(count - 1) * 1000.0f / (float)(last - first);
+        }
     }
 }
 
 void current_monitor_clear(void) {
     __disable_irq();
     sample_count = 0;
+    drain_tail = 0;
     memset(&stats, 0, sizeof(current_monitor_stats_t));
+    for (uint32_t ch = 0; ch < CURRENT_STATS_CHANNEL_COUNT; ch++) {
+        stream_stats_reset(&stream_stats[ch]);
+    }
     stats.buffer_full = false;
     stats.status = MEASUREMENT_IDLE;
     measurement_status = MEASUREMENT_IDLE;
+    capture_used = false;
+    capture_armed = false;
+    capture_pending = false;
+    capture_triggered = false;
+    capture_done = false;
     __enable_irq();
 }
 
@@ -213,7 +955,14 @@ bool current_monitor_get_instant_reading(INA226_Data *data) {
     if (data == NULL) {
         return false;
     }
-    
+
+    instant_reading_t latest;
+    if (last_value_load(&instant_value, &latest) &&
+        (hal_get_tick() - latest.tick) <= CURRENT_MONITOR_INSTANT_MAX_AGE_MS) {
+        *data = latest.data;
+        return true;
+    }
+
     hal_i2c_status_t status = ina226_read(current_sensor, data);
     return (status == HAL_I2C_OK);
 }
@@ -221,60 +970,152 @@ bool current_monitor_get_instant_reading(INA226_Data *data) {
 // ========== Internal Callback ==========
 
 static void current_data_ready_callback(ina226_sensor_t* sensor, INA226_Data* data) {
-    // This callback is called from ina226_process_alert() when new data is available
+    // This callback is called from the I2C completion interrupt when new data
+    // is available (or from ina226_process_alert() when polling)
     // Keep this fast - just buffer the data with timestamp and state
     
-    // Don't buffer if not running or buffer full
-    if (measurement_status != MEASUREMENT_RUNNING) {
+    if (trigger_mode == CURRENT_TRIGGER_TIMER) {
+        deadline_monitor_end(DEADLINE_CURRENT_SAMPLE);
+    }
+
+    instant_reading_t latest = { .data = *data, .tick = hal_get_tick() };
+    last_value_store(&instant_value, &latest);
+    
+    // Don't buffer if not running, or once a triggered capture is complete
+    if (measurement_status != MEASUREMENT_RUNNING || capture_done) {
         return;
     }
     
-    // Throttle to desired sample rate
-    uint32_t now = hal_get_tick();
-    if ((now - last_sample_tick) < sample_period_ms) {
-        return;  // Too soon, skip this sample
+    uint64_t elapsed_us;
+    if (trigger_mode == CURRENT_TRIGGER_TIMER) {
+        // Timed by the timer event that started this read
+        elapsed_us = trigger_time_us - session_start_us;
+    } else {
+        // Throttle to desired sample rate
+        uint32_t now_tick = hal_get_tick();
+        int32_t late = (int32_t)(now_tick - next_sample_tick);
+        if (late < 0) {
+            return;  // Too soon, skip this sample
+        }
+        // Stay on the period grid; resync if a whole period was missed
+        next_sample_tick = ((uint32_t)late >= sample_period_ms) ? now_tick + sample_period_ms
+                                                                 : next_sample_tick + sample_period_ms;
+        elapsed_us = (uint64_t)(now_tick - session_start_tick) * 1000U;
     }
-    last_sample_tick = now;
     
-    if (sample_count >= CURRENT_MONITOR_BUFFER_SIZE || sample_count >= active_config.max_samples) {
+    if (!continuous_mode &&
+        ((!wrap_buffer && sample_count >= CURRENT_MONITOR_BUFFER_SIZE) ||
+         sample_count >= active_config.max_samples)) {
         stats.buffer_full = true;
         stats.buffer_overruns++;
         return;  // Buffer full, drop sample
     }
     
-    // Calculate timestamp based on session start + elapsed ticks
-    uint32_t elapsed_ms = hal_get_tick() - session_start_tick;
-    uint32_t timestamp_sec = session_start_sec + (elapsed_ms / 1000);
-    uint16_t timestamp_ms = session_start_ms + (elapsed_ms % 1000);
+    // With a drain attached, never overwrite what it has not read yet
+    // (including the base tick of its oldest block): an overrun means the
+    // consumer really fell a whole buffer behind
+    if (drain_attached &&
+        (sample_count - drain_tail) > (CURRENT_MONITOR_BUFFER_SIZE - CURRENT_MONITOR_BLOCK_SIZE)) {
+        stats.buffer_overruns++;
+        drain_overruns++;
+        return;
+    }
     
-    // Handle millisecond overflow
-    if (timestamp_ms >= 1000) {
-        timestamp_sec += 1;
-        timestamp_ms -= 1000;
+    // The first sample of a block sets its base tick; the rest store a
+    // delta (a block spans at most 32 s at the slowest sample period).
+    // Only the base needs the 64-bit divide, the rest derive from it
+    uint32_t block = (sample_count / CURRENT_MONITOR_BLOCK_SIZE) % CURRENT_MONITOR_BLOCK_COUNT;
+    if ((sample_count % CURRENT_MONITOR_BLOCK_SIZE) == 0) {
+        uint32_t base_ms = (uint32_t)(elapsed_us / 1000U);
+        block_base_tick[block] = session_start_tick + base_ms;
+        block_base_us[block] = (uint64_t)base_ms * 1000U;
     }
+    uint32_t delta_us = (uint32_t)(elapsed_us - block_base_us[block]);
+    uint32_t delta = delta_us / session_delta_unit_us;
+    uint32_t now = block_base_tick[block] + delta_us / 1000U;
     
-    // Store sample in buffer (sequential, not ring buffer since we read all at end)
-    current_sample_t* sample = &sample_buffer[sample_count];
-    sample->timestamp_sec = timestamp_sec;
-    sample->timestamp_ms = timestamp_ms;
-    sample->state_machine_state = current_state;
-    sample->current_mA = data->current_mA;
-    sample->voltage_V = data->voltage_V;
-    sample->power_mW = data->power_mW;
+    // Store sample in buffer (sequential; wraps only in continuous mode)
+    uint32_t slot = sample_count % CURRENT_MONITOR_BUFFER_SIZE;
+    tick_delta_buffer[slot] = (delta > UINT16_MAX) ? UINT16_MAX : (uint16_t)delta;
+    current_raw_buffer[slot] = data->current_raw;
+    bus_voltage_raw_buffer[slot] = data->bus_voltage_raw;
+    state_buffer[slot] = current_state;
+#if CURRENT_MONITOR_TASK_TAGS
+    // ISR context: the task this read interrupted
+    task_buffer[slot] = (uint8_t)os_task_get_number(NULL);
+#endif
     
+    // Publish the sample only after it is fully written (cursor readers)
+    __DMB();
     sample_count++;
+    LATENCY_TRACE_MARK(LATENCY_STAGE_CAPTURE_PUSH);
+    
+    // The drain's consumer sleeps until its batch is worth reading
+    if (drain_attached && drain_high != 0 && !drain_above &&
+        sample_count - drain_tail >= drain_high) {
+        drain_above = true;
+        if (drain_cb != NULL) {
+            drain_cb(true, drain_cb_arg);
+        }
+    }
+    
+    if (capture_armed) {
+        bool fire = capture_pending;
+        if (capture_config.source == CURRENT_CAPTURE_CURRENT_ABOVE) {
+            fire |= (data->current_raw >= capture_threshold_raw);
+        } else if (capture_config.source == CURRENT_CAPTURE_CURRENT_BELOW) {
+            fire |= (data->current_raw <= capture_threshold_raw);
+        }
+        if (fire) {
+            capture_trigger_index = sample_count - 1;
+            capture_pending = false;
+            capture_armed = false;
+            capture_triggered = true;
+        }
+    }
+    if (capture_triggered && !capture_done &&
+        sample_count - capture_trigger_index > capture_config.post_samples) {
+        capture_done = true;    // Frozen: completed from the service task
+    }
     
     // Update statistics
     stats.samples_captured++;
-    stats.last_read_time_sec = timestamp_sec;
-    stats.last_read_time_ms = timestamp_ms;
+    stream_stats_add(&stream_stats[CURRENT_STATS_CHANNEL_CURRENT], data->current_raw, now);
+    stream_stats_add(&stream_stats[CURRENT_STATS_CHANNEL_VOLTAGE], data->bus_voltage_raw, now);
+    if (sample_count == 1) {
+        first_sample_tick = now;
+    }
+    last_sample_tick = now;
     
     // Update progress
-    if (active_config.max_samples > 0) {
+    if (continuous_mode) {
+        stats.buffer_full = (sample_count >= CURRENT_MONITOR_BUFFER_SIZE);
+    } else if (active_config.max_samples > 0) {
         stats.measurement_progress_percent = (sample_count * 100) / active_config.max_samples;
     }
 }
 
+static void sample_timer_callback(uint64_t timestamp_us, void *user_data) {
+    // Timer ISR: start the next read; it completes in the I2C interrupt
+    // (same priority, so it cannot overtake this)
+    (void)user_data;
+    if (measurement_status != MEASUREMENT_RUNNING) {
+        return;
+    }
+    
+    // Keep the timestamp of a read still in flight
+    if (ina226_read_pending(current_sensor)) {
+        stats.missed_triggers++;
+        return;
+    }
+    trigger_time_us = timestamp_us;
+    deadline_monitor_begin(DEADLINE_CURRENT_SAMPLE, (uint32_t)timestamp_us);
+    LATENCY_TRACE_MARK(LATENCY_STAGE_TRIGGER);
+    if (ina226_read_async(current_sensor) != HAL_I2C_OK) {
+        stats.missed_triggers++;
+    }
+}
+
 static void check_measurement_completion(void) {
     if (measurement_status != MEASUREMENT_RUNNING) {
         return;
@@ -282,68 +1123,158 @@ static void check_measurement_completion(void) {
     
     uint32_t elapsed_ms = hal_get_tick() - measurement_start_tick;
     
-    // Check if measurement duration reached OR buffer full
-    if (elapsed_ms >= measurement_duration_ms || sample_count >= active_config.max_samples) {
+    // Continuous measurements run until stopped or a triggered capture is
+    // complete; others until the duration is reached OR the buffer is full
+    bool done = continuous_mode ? capture_done
+                                : (elapsed_ms >= measurement_duration_ms ||
+                                   sample_count >= active_config.max_samples);
+    if (done) {
         // Stop sensor
+        hal_timer_stop_periodic();
+        deadline_monitor_unregister(DEADLINE_CURRENT_SAMPLE);
         ina226_close(current_sensor);
+        hal_i2c_set_speed(BSP_Get_CurrentSensor_I2C(), HAL_I2C_SPEED_DEFAULT);
+        set_clock_request(HAL_CLOCK_LEVEL_COUNT);
         
         // Mark as complete
         measurement_status = MEASUREMENT_COMPLETE;
         stats.status = MEASUREMENT_COMPLETE;
         stats.measurement_progress_percent = 100;
+        publish_stopped(MEASUREMENT_COMPLETE);
+    }
+}
+
+static void publish_stopped(measurement_status_t status) {
+    measurement_status_t payload = status;
+    EVENT_PUBLISH(EVENT_MEASUREMENT_STOPPED, &payload);
+}
+
+// ========== Packed Sample Decoding ==========
+
+static uint32_t oldest_valid_index(uint32_t count) {
+    // Writing anywhere in a block may already have replaced the base tick
+    // of the block it laps, so one block less than the buffer is readable
+    uint32_t readable = CURRENT_MONITOR_BUFFER_SIZE - CURRENT_MONITOR_BLOCK_SIZE;
+    return (count > readable) ? count - readable : 0;
+}
+
+static void tick_to_timestamp(uint32_t tick, uint32_t *timestamp_sec, uint16_t *timestamp_ms) {
+    // Timestamp based on session start + elapsed ticks
+    uint32_t elapsed_ms = tick - session_start_tick;
+    uint32_t sec = session_start_sec + (elapsed_ms / 1000);
+    uint16_t ms = session_start_ms + (elapsed_ms % 1000);
+    
+    // Handle millisecond overflow
+    if (ms >= 1000) {
+        sec += 1;
+        ms -= 1000;
     }
+    
+    *timestamp_sec = sec;
+    *timestamp_ms = ms;
+}
+
+// Capture time of a buffered sample since the session start
+static uint64_t sample_elapsed_us(uint32_t index) {
+    uint32_t slot = index % CURRENT_MONITOR_BUFFER_SIZE;
+    uint32_t block = (index / CURRENT_MONITOR_BLOCK_SIZE) % CURRENT_MONITOR_BLOCK_COUNT;
+    return block_base_us[block] + (uint64_t)tick_delta_buffer[slot] * session_delta_unit_us;
+}
+
+static void decode_samples(uint32_t index, current_sample_t *samples, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++, index++) {
+        uint32_t slot = index % CURRENT_MONITOR_BUFFER_SIZE;
+        uint32_t block = (index / CURRENT_MONITOR_BLOCK_SIZE) % CURRENT_MONITOR_BLOCK_COUNT;
+        current_sample_t *sample = &samples[i];
+        uint32_t offset_us = (uint32_t)tick_delta_buffer[slot] * session_delta_unit_us;
+        
+        tick_to_timestamp(block_base_tick[block] + offset_us / 1000U,
+                          &sample->timestamp_sec, &sample->timestamp_ms);
+        sample->timestamp_us = (uint16_t)(offset_us % 1000U);
+        sample->state_machine_state = state_buffer[slot];
+#if CURRENT_MONITOR_TASK_TAGS
+        sample->task_number = task_buffer[slot];
+#else
+        sample->task_number = 0;
+#endif
+        sample->current_mA = (float)current_raw_buffer[slot] * session_current_lsb_mA;
+        sample->voltage_V = (float)bus_voltage_raw_buffer[slot] * INA226_BUS_VOLTAGE_LSB_V;
+        sample->power_mW = fabsf(sample->current_mA) * sample->voltage_V;
+    }
+}
+
+static void span_stats_q15(const int16_t *data, uint32_t count, int16_t *min, int16_t *max, int64_t *sum) {
+    // Same contract as arm_min_q15/arm_max_q15 plus a wide sum, so this
+    // can be swapped for CMSIS-DSP once it is linked
+    int16_t lo = *min;
+    int16_t hi = *max;
+    int64_t total = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        int16_t v = data[i];
+        if (v < lo) {
+            lo = v;
+        }
+        if (v > hi) {
+            hi = v;
+        }
+        total += v;
+    }
+    *min = lo;
+    *max = hi;
+    *sum += total;
 }
 
 // ========== INA226 Configuration Helper ==========
 
 static void get_ina226_config_for_period(sample_period_ms_t period, ina226_config_t *config) {
-    switch (period) {
-        case SAMPLE_PERIOD_1MS:
-            // 1ms period → 1000 Hz target
-            // Conversion time: (332µs + 332µs) * 1 = 664µs → ~1506 Hz
-            // Runs at ~1.5x target rate, throttle to 1000 Hz in software
-            config->averaging = INA226_CONFIG_AVG_1;
-            config->bus_conv_time = INA226_CONFIG_VBUSCT_332US;
-            config->shunt_conv_time = INA226_CONFIG_VSHCT_332US;
-            config->mode = INA226_CONFIG_MODE_SHUNT_BUS_CONT;
-            break;
-            
-        case SAMPLE_PERIOD_10MS:
-            // 10ms period → 100 Hz target
-            // Conversion time: (588µs + 588µs) * 4 = 4.7ms → ~212 Hz
-            // Runs at ~2.1x target rate with 4x averaging, throttle to 100 Hz
-            config->averaging = INA226_CONFIG_AVG_4;
-            config->bus_conv_time = INA226_CONFIG_VBUSCT_588US;
-            config->shunt_conv_time = INA226_CONFIG_VSHCT_588US;
-            config->mode = INA226_CONFIG_MODE_SHUNT_BUS_CONT;
-            break;
-            
-        case SAMPLE_PERIOD_100MS:
-            // 100ms period → 10 Hz target
-            // Conversion time: (1100µs + 1100µs) * 16 = 35.2ms → ~28 Hz
-            // Runs at ~2.8x target rate with 16x averaging, throttle to 10 Hz
-            config->averaging = INA226_CONFIG_AVG_16;
-            config->bus_conv_time = INA226_CONFIG_VBUSCT_1100US;
-            config->shunt_conv_time = INA226_CONFIG_VSHCT_1100US;
-            config->mode = INA226_CONFIG_MODE_SHUNT_BUS_CONT;
-            break;
-            
-        case SAMPLE_PERIOD_1000MS:
-            // 1000ms period → 1 Hz target
-            // Conversion time: (4156µs + 4156µs) * 64 = 532ms → ~1.88 Hz
-            // Runs at ~1.9x target rate with 64x averaging, throttle to 1 Hz
-            config->averaging = INA226_CONFIG_AVG_64;
-            config->bus_conv_time = INA226_CONFIG_VBUSCT_4156US;
-            config->shunt_conv_time = INA226_CONFIG_VSHCT_4156US;
-            config->mode = INA226_CONFIG_MODE_SHUNT_BUS_CONT;
-            break;
-            
-        default:
-            // Default to 100ms settings
-            config->averaging = INA226_CONFIG_AVG_16;
-            config->bus_conv_time = INA226_CONFIG_VBUSCT_1100US;
-            config->shunt_conv_time = INA226_CONFIG_VSHCT_1100US;
-            config->mode = INA226_CONFIG_MODE_SHUNT_BUS_CONT;
-            break;
+    // Continuous shunt and bus conversions; power is not stored (decoded
+    // as |I| x V), so never fetch it
+    config->mode = INA226_CONFIG_MODE_SHUNT_BUS_CONT;
+    config->read_fields = INA226_READ_BUS | INA226_READ_CURRENT;
+    
+    // Leave headroom for the device timebase so a conversion is always
+    // ready by the next period boundary
+    uint32_t period_us = (uint32_t)period * 1000;
+    tune_ina226_config(period_us - (period_us * CURRENT_MONITOR_CONVERSION_MARGIN_PCT) / 100, config);
+}
+
+static void tune_ina226_config(uint32_t period_us, ina226_config_t *config) {
+    // Pick the setting with the longest shunt averaging window (lowest
+    // current noise bandwidth) whose cycle fits the period; ties go to the
+    // longer bus window. Bus + shunt conversion times per period: 1 ms
+    // 1 x (204 + 588 us), 10 ms 1 x (588 + 8244 us), 100 ms 64 x (204 +
+    // 1100 us), 1 s 1024 x (204 + 588 us).
+    uint32_t best_shunt_window = 0;
+    uint32_t best_bus_window = 0;
+    
+    // Fallback: fastest setting
+    config->averaging = INA226_CONFIG_AVG_1;
+    config->bus_conv_time = INA226_CONFIG_VBUSCT_140US;
+    config->shunt_conv_time = INA226_CONFIG_VSHCT_140US;
+    
+    for (uint16_t avg = 0; avg < 8; avg++) {
+        for (uint16_t vbus = 0; vbus < 8; vbus++) {
+            for (uint16_t vsh = 0; vsh < 8; vsh++) {
+                ina226_config_t candidate = *config;
+                candidate.averaging = (uint16_t)(avg << 9);
+                candidate.bus_conv_time = (uint16_t)(vbus << 6);
+                candidate.shunt_conv_time = (uint16_t)(vsh << 3);
+                
+                if (ina226_conversion_cycle_us(&candidate) > period_us) {
+                    continue;
+                }
+                
+                uint32_t count = ina226_averaging_count(candidate.averaging);
+                uint32_t shunt_window = count * ina226_conversion_time_us(candidate.shunt_conv_time, true);
+                uint32_t bus_window = count * ina226_conversion_time_us(candidate.bus_conv_time, false);
+                
+                if (shunt_window > best_shunt_window ||
+                    (shunt_window == best_shunt_window && bus_window > best_bus_window)) {
+                    best_shunt_window = shunt_window;
+                    best_bus_window = bus_window;
+                    *config = candidate;
+                }
+            }
+        }
     }
 }
@@ -4,16 +4,59 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "ina226.h"
+#include "stream_stats.h"
 
 // Configuration
-#define CURRENT_MONITOR_BUFFER_SIZE     4096    // Ring buffer size for samples
+#define CURRENT_MONITOR_BUFFER_SIZE     8192    // Ring buffer size for samples (power of two)
+#define CURRENT_MONITOR_BLOCK_SIZE      32      // Samples sharing one 32-bit base tick
+// I2C profile for 1 ms sampling. 1 MHz is beyond the INA226's 400 kHz
+// fast mode (its high-speed mode needs a master code the STM32 I2C cannot
+// send); boards with marginal pull-ups can use HAL_I2C_SPEED_FAST.
+#ifndef CURRENT_MONITOR_FAST_I2C_SPEED
+#define CURRENT_MONITOR_FAST_I2C_SPEED  HAL_I2C_SPEED_FAST_PLUS
+#endif
+// Performance level while measuring (hal_clock.h): full speed at this
+// period and below, the idle level from the second one on (low-rate
+// logging), normal in between
+#define CURRENT_MONITOR_FULL_CLOCK_PERIOD_MS    1
+#define CURRENT_MONITOR_IDLE_CLOCK_PERIOD_MS    1000
+// Headroom for the INA226's internal timebase when fitting the averaging
+// window into the sample period (conversion times are typical values)
+#define CURRENT_MONITOR_CONVERSION_MARGIN_PCT  10
+// Running statistics windows in samples (see stream_stats.h); the last
+// covers the whole measurement
+#define CURRENT_MONITOR_STATS_WINDOWS   3
+#ifndef CURRENT_MONITOR_STATS_SHORT
+#define CURRENT_MONITOR_STATS_SHORT     1000
+#endif
+#ifndef CURRENT_MONITOR_STATS_LONG
+#define CURRENT_MONITOR_STATS_LONG      60000
+#endif
+// Tag each sample with the running task's number (FreeRTOS uxTaskNumber,
+// as performance_monitor reports it), for current_monitor_energy_by();
+// one byte per buffered sample
+#ifndef CURRENT_MONITOR_TASK_TAGS
+#define CURRENT_MONITOR_TASK_TAGS       1
+#endif
+// Buffer RAM per sample (raw fields, task tag) and per block (base tick, base us)
+#define CURRENT_MONITOR_SAMPLE_BYTES    (7 + CURRENT_MONITOR_TASK_TAGS)
+#define CURRENT_MONITOR_BLOCK_BYTES     12
+// current_monitor_get_instant_reading() returns the latest conversion
+// while it is at most this old, and reads the sensor otherwise
+#ifndef CURRENT_MONITOR_INSTANT_MAX_AGE_MS
+#define CURRENT_MONITOR_INSTANT_MAX_AGE_MS  100
+#endif
+// Sample cadence source used by the protocol handler
+#ifndef CURRENT_MONITOR_DEFAULT_TRIGGER
+#define CURRENT_MONITOR_DEFAULT_TRIGGER  CURRENT_TRIGGER_ALERT
+#endif
 
 // Sample period options (in milliseconds)
 typedef enum {
-    SAMPLE_PERIOD_1MS = 1,       // 1ms = 1000 Hz (ultra precise, max ~3 seconds in buffer)
-    SAMPLE_PERIOD_10MS = 10,     // 10ms = 100 Hz (precise, max ~40 seconds in buffer)
-    SAMPLE_PERIOD_100MS = 100,   // 100ms = 10 Hz (normal, max ~6.8 minutes in buffer)
-    SAMPLE_PERIOD_1000MS = 1000  // 1000ms = 1 Hz (low power, max ~68 minutes in buffer)
+    SAMPLE_PERIOD_1MS = 1,       // 1ms = 1000 Hz (ultra precise, max ~8 seconds in buffer)
+    SAMPLE_PERIOD_10MS = 10,     // 10ms = 100 Hz (precise, max ~80 seconds in buffer)
+    SAMPLE_PERIOD_100MS = 100,   // 100ms = 10 Hz (normal, max ~13.6 minutes in buffer)
+    SAMPLE_PERIOD_1000MS = 1000  // 1000ms = 1 Hz (low power, max 60 minutes per measurement)
 } sample_period_ms_t;
 
 // Measurement status
@@ -24,23 +67,120 @@ typedef enum {
     MEASUREMENT_ERROR            // Error occurred during measurement
 } measurement_status_t;
 
+// What sets the sample cadence
+typedef enum {
+    CURRENT_TRIGGER_ALERT = 0,   // INA226 conversion-ready ALERT, throttled on the ms tick
+    CURRENT_TRIGGER_TIMER        // Hardware timer starts each read (us timestamps, us-level jitter)
+} current_trigger_mode_t;
+
 // Measurement configuration
 typedef struct {
-    uint32_t duration_sec;       // Total measurement duration in seconds (1-3600)
+    uint32_t duration_sec;       // Total measurement duration in seconds (1-3600, 0 = continuous)
     sample_period_ms_t sample_period; // Sample period (1ms, 10ms, 100ms, 1000ms)
-    uint32_t max_samples;        // Calculated: duration_sec * 1000 / sample_period
+    uint32_t max_samples;        // Calculated: duration_sec * 1000 / sample_period (0 if continuous)
+    current_trigger_mode_t trigger; // Sample cadence source
+    bool offload;                // Drained while it runs (capture follow, recorder): a duration
+                                 // longer than the buffer wraps it instead of being refused
 } measurement_config_t;
 
+// Event that freezes a triggered capture
+typedef enum {
+    CURRENT_CAPTURE_NONE = 0,        // Not armed
+    CURRENT_CAPTURE_CURRENT_ABOVE,   // A sample at or above threshold_mA
+    CURRENT_CAPTURE_CURRENT_BELOW,   // A sample at or below threshold_mA
+    CURRENT_CAPTURE_STATE_CHANGE,    // current_monitor_set_state() with a new state
+    CURRENT_CAPTURE_EXTERNAL         // current_monitor_trigger_capture() only
+} current_capture_source_t;
+
+// Oscilloscope-style capture around a trigger
+typedef struct {
+    current_capture_source_t source;
+    float threshold_mA;          // Threshold sources only
+    uint32_t pre_samples;        // Kept from before the trigger sample
+    uint32_t post_samples;       // Captured after it, then the measurement completes
+} current_capture_config_t;
+
+typedef struct {
+    bool armed;                  // Waiting for the trigger
+    bool triggered;
+    uint32_t trigger_index;      // Index of the trigger sample (counts from measurement start)
+    uint32_t first_index;        // Oldest sample of the capture
+    uint32_t count;              // Samples in the capture so far
+} current_capture_status_t;
+
+// Samples a capture can hold: pre + trigger + post (one block of margin)
+#define CURRENT_MONITOR_CAPTURE_MAX  (CURRENT_MONITOR_BUFFER_SIZE - CURRENT_MONITOR_BLOCK_SIZE)
+
+// Hardware limit watch: the INA226 compares every conversion against a
+// limit and raises ALERT on a crossing; nothing is read in between
+typedef struct {
+    float high_mA;               // Crossing upwards: at or above this
+    float low_mA;                // Back down: at or below this (hysteresis, <= high_mA)
+} current_limit_config_t;
+
+// EVENT_CURRENT_LIMIT payload
+typedef struct {
+    bool above;                  // Now above high_mA (false: back at or below low_mA)
+    float current_mA;            // Current register read after the crossing
+    uint32_t crossings;          // Crossings since the watch started
+} current_limit_event_t;
+
+// A continuous measurement (duration_sec = 0) runs until stopped. The buffer
+// then wraps, keeping the newest CURRENT_MONITOR_BUFFER_SIZE samples, and
+// sample indices keep counting up so a cursor can follow it indefinitely.
+
+// Samples are stored as raw fields in separate arrays (7 bytes: time delta
+// from a per-block base tick, raw INA226 current and bus voltage registers,
+// state; 8 with the task tag) and decoded into this view on read. Power is recomputed as |I| x V.
+// With CURRENT_TRIGGER_TIMER the delta counts sample_period x 1 us units,
+// so samples carry sub-millisecond timestamps; each one is the INA226's
+// latest conversion at the timer event.
+
 // Buffered sample with timestamp and state
 typedef struct {
     uint32_t timestamp_sec;      // Unix timestamp (seconds)
     uint16_t timestamp_ms;       // Milliseconds (0-999)
+    uint16_t timestamp_us;       // Microseconds within timestamp_ms (0-999; 0 unless timer-triggered)
     uint8_t state_machine_state; // Main state machine state at time of sample
+    uint8_t task_number;         // Task running at the sample (0: none or CURRENT_MONITOR_TASK_TAGS off)
     float current_mA;
     float voltage_V;
     float power_mW;
 } current_sample_t;
 
+// What current_monitor_energy_by() groups samples by
+typedef enum {
+    CURRENT_ENERGY_BY_TASK = 0,  // current_sample_t.task_number
+    CURRENT_ENERGY_BY_STATE      // current_sample_t.state_machine_state
+} current_energy_key_t;
+
+// Energy of the samples sharing one task or state
+typedef struct {
+    uint8_t key;                 // Task number or state
+    uint32_t samples;
+    uint32_t duration_us;        // Time the samples cover
+    float energy_mJ;             // Sum of |I| x V x interval
+    float charge_mC;             // Sum of |I| x interval
+} current_energy_bin_t;
+
+// Read position for following a measurement while it is captured
+typedef struct {
+    uint32_t session;            // Measurement the index refers to
+    uint32_t index;              // Next sample to read (counts from measurement start)
+    uint32_t dropped;            // Samples overwritten before they were read
+} current_monitor_cursor_t;
+
+// Aggregate over a window of buffered samples
+typedef struct {
+    uint32_t count;
+    float current_min_mA;
+    float current_max_mA;
+    float current_mean_mA;
+    float voltage_min_V;
+    float voltage_max_V;
+    float voltage_mean_V;
+} current_window_stats_t;
+
 // Service statistics
 typedef struct {
     uint32_t samples_captured;
@@ -50,6 +190,10 @@ typedef struct {
     bool buffer_full;
     sample_period_ms_t sample_period;
     float actual_sample_rate_hz;    // Actual achieved sample rate
+    uint32_t conversion_cycle_us;   // INA226 time per averaged conversion
+    uint16_t averaging_count;       // INA226 samples averaged per conversion
+    float noise_bandwidth_hz;       // Current channel noise bandwidth, 1 / (2 x averaging window)
+    uint32_t missed_triggers;       // Timer events skipped because a read was still in flight
     measurement_status_t status;
     uint32_t measurement_progress_percent; // 0-100%
 } current_monitor_stats_t;
@@ -93,12 +237,70 @@ bool current_monitor_is_complete(void);
 /**
  * @brief Set current state machine state
  * Should be called whenever state machine changes state
- * This state will be attached to all subsequent samples
+ * This state will be attached to all subsequent samples; a change
+ * triggers a capture armed with CURRENT_CAPTURE_STATE_CHANGE
  * 
  * @param state Current state machine state (0-255)
  */
 void current_monitor_set_state(uint8_t state);
 
+/**
+ * @brief Arm a triggered capture on the running continuous measurement
+ *
+ * The buffer keeps wrapping until the trigger. Its sample is kept with up
+ * to pre_samples before it (fewer if the measurement had not captured that
+ * many yet) and post_samples after, then the measurement completes and
+ * the capture reads like any completed measurement (see
+ * current_monitor_get_capture()). Arming again re-arms.
+ *
+ * @param config Trigger and window; pre + post + 1 <= CURRENT_MONITOR_CAPTURE_MAX
+ * @return false unless a continuous (duration_sec = 0) measurement runs,
+ *         or if the window does not fit
+ */
+bool current_monitor_arm_capture(const current_capture_config_t *config);
+
+/**
+ * @brief Drop an armed capture that has not triggered (capture continues)
+ */
+void current_monitor_disarm_capture(void);
+
+/**
+ * @brief Trigger an armed capture now (any source; task or ISR context)
+ * The next captured sample becomes the trigger sample.
+ */
+void current_monitor_trigger_capture(void);
+
+/**
+ * @brief Get the state of the armed or last capture
+ * @return false if no capture was armed this measurement
+ */
+bool current_monitor_get_capture(current_capture_status_t *status);
+
+/**
+ * @brief Watch the current against hardware limits instead of sampling
+ *
+ * Opens the INA226 with long averaging and arms its shunt over-limit
+ * ALERT at high_mA. On a crossing the ALERT interrupt's work item (on
+ * the shared work queue) publishes EVENT_CURRENT_LIMIT and re-arms the
+ * opposite direction (under-limit at low_mA, and so on), so the bus is
+ * only touched on crossings and nothing polls in between.
+ *
+ * @param config Limits
+ * @return false while a measurement or a watch runs, or on I2C errors
+ */
+bool current_monitor_start_limit_watch(const current_limit_config_t *config);
+
+/**
+ * @brief Stop the limit watch and power the sensor down
+ */
+void current_monitor_stop_limit_watch(void);
+
+/**
+ * @brief Check whether the watched current is above the high limit
+ * @return false if below, or if no watch runs
+ */
+bool current_monitor_limit_watch_above(void);
+
 /**
  * @brief Process pending samples (should be called from main loop)
  * Triggers INA226 to check for new data and checks measurement completion
@@ -108,7 +310,8 @@ void current_monitor_process(void);
 
 /**
  * @brief Read all captured samples from completed measurement
- * Only works when measurement status is COMPLETE
+ * Only works when measurement status is COMPLETE; a wrapped buffer is read
+ * from its oldest readable sample
  * 
  * @param samples Pointer to array to store samples
  * @param max_samples Maximum number of samples to read
@@ -116,6 +319,186 @@ void current_monitor_process(void);
  */
 uint32_t current_monitor_read_measurement(current_sample_t *samples, uint32_t max_samples);
 
+/**
+ * @brief Read a range of captured samples from completed measurement
+ * Only works when measurement status is COMPLETE
+ *
+ * @param start_index Index of first sample (0 = first of the measurement)
+ * @param samples Pointer to array to store samples
+ * @param max_samples Maximum number of samples to read
+ * @return Number of samples actually read (0 past the end, or from a
+ *         start a wrapped buffer has overwritten)
+ */
+uint32_t current_monitor_read_range(uint32_t start_index, current_sample_t *samples, uint32_t max_samples);
+
+/**
+ * @brief Position a cursor at the newest captured sample
+ * Samples captured from now on are returned by current_monitor_read_new()
+ * 
+ * @param cursor Cursor to initialize
+ */
+void current_monitor_cursor_init(current_monitor_cursor_t *cursor);
+
+/**
+ * @brief Read samples captured since the cursor and advance it
+ * Works while the measurement runs (no extra I2C traffic). When a new
+ * measurement starts, the cursor restarts at its first sample. If a
+ * continuous measurement has overwritten samples the cursor had not read,
+ * it skips ahead and adds them to cursor->dropped.
+ * 
+ * @param cursor Cursor from current_monitor_cursor_init()
+ * @param samples Pointer to array to store samples
+ * @param max_samples Maximum number of samples to read
+ * @return Number of samples actually read
+ */
+uint32_t current_monitor_read_new(current_monitor_cursor_t *cursor, current_sample_t *samples, uint32_t max_samples);
+
+/**
+ * @brief Attach the single drain consumer
+ * The capture buffer then acts as a lock-free SPSC ring: the producer never
+ * overwrites samples the drain has not read, and counts an overrun (dropping
+ * the new sample) only when the drain is a whole buffer behind. Other
+ * cursors keep working but are not protected from overwrite.
+ * 
+ * @param start_index First sample to drain (clamped to what is buffered)
+ * @return false if a drain is already attached
+ */
+bool current_monitor_drain_attach(uint32_t start_index);
+
+/**
+ * @brief Detach the drain consumer (the buffer overwrites oldest again)
+ */
+void current_monitor_drain_detach(void);
+
+/**
+ * @brief Read and release the next samples for the drain consumer
+ * 
+ * @param samples Pointer to array to store samples
+ * @param max_samples Maximum number of samples to read
+ * @param first_index Output: index of samples[0] (can be NULL)
+ * @return Number of samples actually read
+ */
+uint32_t current_monitor_drain_read(current_sample_t *samples, uint32_t max_samples, uint32_t *first_index);
+
+/**
+ * @brief Drain watermark callback
+ * @param above true when the unread samples reached the high mark (from the
+ *        sampling context, possibly the I2C interrupt), false when a
+ *        current_monitor_drain_read() took them down to the low mark
+ */
+typedef void (*current_monitor_drain_cb_t)(bool above, void *user_data);
+
+/**
+ * @brief Wake the drain consumer on its backlog instead of polling
+ * Each crossing is reported once; a read that leaves more than the low mark
+ * keeps the high one reported. Cleared by detach.
+ *
+ * @param high Unread samples that report above (0 clears the watermarks)
+ * @param low Unread samples that report below, less than high
+ * @return false without a drain attached or with invalid marks
+ */
+bool current_monitor_drain_set_watermarks(uint32_t high, uint32_t low,
+                                          current_monitor_drain_cb_t callback, void *user_data);
+
+/**
+ * @brief Samples dropped because the drain fell behind, since it attached
+ */
+uint32_t current_monitor_drain_get_overruns(void);
+
+/**
+ * @brief Samples of a completed measurement that are still buffered
+ * 
+ * @param first_index Output: oldest readable sample (counts from measurement start)
+ * @param count Output: readable samples from first_index on
+ * @return false unless a measurement is complete and holds samples
+ */
+bool current_monitor_get_buffered_range(uint32_t *first_index, uint32_t *count);
+
+/**
+ * @brief Read current and voltage of a completed measurement as arrays
+ * For bulk analysis: separate float arrays, without timestamps.
+ * 
+ * @param start_index First sample to read (counts from measurement start)
+ * @param current_mA Output currents
+ * @param voltage_V Output bus voltages
+ * @param max_samples Maximum number of samples to read
+ * @return Number of samples read (0 unless complete and still buffered)
+ */
+uint32_t current_monitor_read_scaled(uint32_t start_index, float *current_mA, float *voltage_V,
+                                     uint32_t max_samples);
+
+/**
+ * @brief Min/max/mean of current and voltage over buffered samples
+ * Runs on the raw register arrays without decoding samples, and works
+ * while the measurement runs.
+ * 
+ * @param start_index First sample of the window (counts from measurement start)
+ * @param count Number of samples in the window
+ * @param stats_out Output aggregate
+ * @return false if the window is empty, not yet captured or overwritten
+ */
+bool current_monitor_window_stats(uint32_t start_index, uint32_t count, current_window_stats_t *stats_out);
+
+/**
+ * @brief Integrate energy per task or per app state over buffered samples
+ *
+ * Each sample stands for the time until the next one (the last for its
+ * measurement's period), so gaps count against the sample before them.
+ * Tasks are attributed statistically: a sample is tagged with the task the
+ * read interrupted, so shares converge over many samples. Works while the
+ * measurement runs.
+ *
+ * @param by Group by task (needs CURRENT_MONITOR_TASK_TAGS) or by state
+ * @param start_index First sample of the window (counts from measurement start)
+ * @param count Number of samples in the window
+ * @param bins Output, most energy first
+ * @param max_bins Capacity of bins; further keys are added to the last bin
+ * @return Bins filled, 0 if the window is empty, not yet captured or overwritten
+ */
+uint32_t current_monitor_energy_by(current_energy_key_t by, uint32_t start_index, uint32_t count,
+                                   current_energy_bin_t *bins, uint32_t max_bins);
+
+/**
+ * @brief Capture time of a buffered sample in system ticks (ms since boot)
+ * 
+ * @param sample Sample from the current measurement
+ * @return Tick at which the sample was captured
+ */
+uint32_t current_monitor_sample_tick(const current_sample_t *sample);
+
+/**
+ * @brief Get the configuration of the current (or last) measurement
+ * 
+ * @param config Pointer to configuration structure to fill
+ */
+void current_monitor_get_config(measurement_config_t *config);
+
+/**
+ * @brief mA per current register LSB of the current (or last) measurement
+ * Lets consumers re-encode decoded samples into raw register values.
+ */
+float current_monitor_get_current_lsb_mA(void);
+
+// Streams with running statistics
+typedef enum {
+    CURRENT_STATS_CHANNEL_CURRENT = 0,  // Current register (current LSB units)
+    CURRENT_STATS_CHANNEL_VOLTAGE,      // Bus voltage register (1.25 mV units)
+    CURRENT_STATS_CHANNEL_COUNT
+} current_stats_channel_t;
+
+/**
+ * @brief Get running statistics of the captured samples
+ * Updated with every sample, reset when a measurement starts. Values are
+ * raw register units; timestamps are capture ticks (ms since boot).
+ * 
+ * @param channel Stream to summarize
+ * @param window Statistics window (see CURRENT_MONITOR_STATS_WINDOWS)
+ * @param summary Output
+ * @return false for an unknown channel or window, or before the first sample
+ */
+bool current_monitor_get_stream_stats(current_stats_channel_t channel, uint32_t window,
+                                      stream_stats_summary_t *summary);
+
 /**
  * @brief Get service statistics
  * 
@@ -130,7 +513,11 @@ void current_monitor_clear(void);
 
 /**
  * @brief Get current instantaneous reading (bypasses buffer)
- * 
+ *
+ * Returns the latest conversion the sensor delivered, without waiting, if
+ * it is at most CURRENT_MONITOR_INSTANT_MAX_AGE_MS old; otherwise reads the
+ * sensor (blocking I2C). Safe from any task.
+ *
  * @param data Pointer to INA226 data structure to fill
  * @return true if read successfully
  */
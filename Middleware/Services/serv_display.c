@@ -2,42 +2,312 @@
 #include "event_bus.h"
 #include "service_events.h"
 #include "ips_display.h"
+#if DISPLAY_CURRENT_CHART
+#include "display_chart.h"
+#include "serv_current_monitor.h"
+#endif
+#include "os_wrapper.h"
+#include "portable_log.h"
+#include "sysview_trace.h"
+#include "deadline_monitor.h"
 #include <stddef.h>
+#include <stdbool.h>
+#include <math.h>
+
+static const char *TAG = "DISPLAY";
+
+#define DISPLAY_TASK_STACK_SIZE     2048    // Integer formatting, no float printf
+#define DISPLAY_TASK_PRIORITY       OS_PRIORITY_LOW
+#define DISPLAY_READY_POLL_MS       10
+#define DISPLAY_CHART_BATCH         16      // Samples read from the capture at a time
+
+// Values to show next
+typedef struct {
+    float temperature;
+    float humidity;
+} display_values_t;
+
+// Last-value mailbox: event handlers overwrite it, the render task takes
+// the latest. The semaphore only wakes the task, so posts collapse.
+static display_values_t mailbox;
+static os_mutex_handle_t mailbox_mutex = NULL;
+static os_semaphore_handle_t mailbox_wake = NULL;
+static os_task_handle_t render_task_handle = NULL;
+OS_MUTEX_DEFINE(mailbox);
+OS_SEMAPHORE_DEFINE(mailbox_wake);
+OS_TASK_DEFINE(render, DISPLAY_TASK_STACK_SIZE);
+
+// Render task state
+static volatile bool panel_ready = false;  // Open sequence done, UI drawn
+static bool drawn_once = false;
+static int32_t drawn_temperature = 0;      // Last drawn, in 1 / DISPLAY_VALUE_SCALE
+static int32_t drawn_humidity = 0;
+static uint32_t last_draw_ms = 0;
+static volatile uint32_t min_refresh_ms = DISPLAY_MIN_REFRESH_MS;
+static volatile uint32_t chart_period_ms = DISPLAY_CHART_PERIOD_MS;
+
+// Dispatch task state: what was last posted, at display resolution
+static bool posted_once = false;
+static int32_t posted_temperature = 0;
+static int32_t posted_humidity = 0;
+
+static int32_t quantize(float value)
+{
+    return (int32_t)lroundf(value * DISPLAY_VALUE_SCALE);
+}
 
 /**
- * @brief Event handler for temperature updates
+ * @brief Hand values to the render task (never blocks on drawing)
+ */
+static void post_values(float temperature, float humidity)
+{
+    if (mailbox_mutex == NULL) {
+        return;
+    }
+
+    os_mutex_take(mailbox_mutex, OS_WAIT_FOREVER);
+    mailbox.temperature = temperature;
+    mailbox.humidity = humidity;
+    os_mutex_give(mailbox_mutex);
+
+    posted_once = true;
+    posted_temperature = quantize(temperature);
+    posted_humidity = quantize(humidity);
+
+    os_semaphore_give(mailbox_wake);
+}
+
+/**
+ * @brief Draw values, if they differ at display resolution
+ */
+static void render(const display_values_t *values)
+{
+    int32_t temperature = quantize(values->temperature);
+    int32_t humidity = quantize(values->humidity);
+
+    if (drawn_once && temperature == drawn_temperature && humidity == drawn_humidity) {
+        return;
+    }
+
+    SYSVIEW_MARK_START(SYSVIEW_MARKER_DISPLAY_REDRAW);
+    if (ips_display_write_temp_data(temperature, humidity) == IPS_DISPLAY_OK) {
+        drawn_once = true;
+        drawn_temperature = temperature;
+        drawn_humidity = humidity;
+        last_draw_ms = os_get_time_ms();
+    }
+    SYSVIEW_MARK_STOP(SYSVIEW_MARKER_DISPLAY_REDRAW);
+}
+
+/**
+ * @brief Run the panel's open sequence, sleeping through its power-up delays
+ */
+static void open_panel(void)
+{
+    uint32_t wait_ms = 0;
+    ips_display_status_t status = ips_display_open_begin();
+
+    while (status == IPS_DISPLAY_OK &&
+           (status = ips_display_open_poll(&wait_ms)) == IPS_DISPLAY_BUSY) {
+        os_delay_ms(wait_ms);
+    }
+
+    if (status != IPS_DISPLAY_OK) {
+        LOG_E(TAG, "Display open failed");
+        return;
+    }
+    panel_ready = true;
+    EVENT_SIGNAL(EVENT_DISPLAY_READY);
+}
+
+#if DISPLAY_CURRENT_CHART
+enum {
+    CHART_SERIES_CURRENT = 0,
+    CHART_SERIES_TEMPERATURE
+};
+
+/**
+ * @brief Chart loop of the render task: a column per captured sample
+ * @return only if the chart could not be opened
+ */
+static void run_chart(void)
+{
+    display_chart_config_t config = {
+        0, ST7735_WIDTH, ST7735_BLACK, DISPLAY_CHART_GRID_COLOR, ST7735_HEIGHT / 4
+    };
+    if (!display_chart_open(&config)) {
+        LOG_E(TAG, "Chart open failed");
+        return;
+    }
+    display_chart_set_series(CHART_SERIES_CURRENT, ST7735_YELLOW, 0.0f, DISPLAY_CHART_CURRENT_MAX_MA);
+    display_chart_set_series(CHART_SERIES_TEMPERATURE, ST7735_CYAN,
+                             DISPLAY_CHART_TEMP_MIN_C, DISPLAY_CHART_TEMP_MAX_C);
+
+    current_monitor_cursor_t cursor;
+    current_sample_t samples[DISPLAY_CHART_BATCH];
+    float temperature = NAN;                // Until the first reading
+    uint32_t last_push_ms = os_get_time_ms();
+    current_monitor_cursor_init(&cursor);
+    uint32_t period_ms = 0;
+
+    for (;;) {
+        if (period_ms != chart_period_ms) {
+            period_ms = chart_period_ms;
+            deadline_monitor_register(DEADLINE_DISPLAY_CHART, period_ms * 1000U, period_ms * 1000U / 2U);
+        }
+
+        // Temperature posts wake the task early; the poll drives the rest
+        uint32_t release_us = hal_timer_get_us() + period_ms * 1000U;
+        if (os_semaphore_take(mailbox_wake, period_ms) == OS_SUCCESS) {
+            os_mutex_take(mailbox_mutex, OS_WAIT_FOREVER);
+            temperature = mailbox.temperature;
+            os_mutex_give(mailbox_mutex);
+        }
+        deadline_monitor_begin(DEADLINE_DISPLAY_CHART, release_us);
+
+        float values[DISPLAY_CHART_MAX_SERIES] = { NAN, temperature };
+        uint32_t count;
+        bool pushed = false;
+        while ((count = current_monitor_read_new(&cursor, samples, DISPLAY_CHART_BATCH)) > 0) {
+            for (uint32_t i = 0; i < count; i++) {
+                values[CHART_SERIES_CURRENT] = samples[i].current_mA;
+                display_chart_push(values);
+            }
+            pushed = true;
+        }
+
+        uint32_t now = os_get_time_ms();
+        if (!pushed && now - last_push_ms >= DISPLAY_CHART_IDLE_MS) {
+            display_chart_push(values);
+            pushed = true;
+        }
+        if (pushed) {
+            last_push_ms = now;
+        }
+        deadline_monitor_end(DEADLINE_DISPLAY_CHART);
+    }
+}
+#endif
+
+/**
+ * @brief Render task: opens the panel, then waits for values and draws at
+ *        most once per refresh interval
  */
-static void on_temperature_updated(event_t* event)
+static void render_task(void *param)
 {
-    if (event->data != NULL) {
-        temperature_data_t* temp_data = (temperature_data_t*)event->data;
-        
-        // Update display with new temperature data
-        ips_display_write_temp_data(temp_data->temperature, temp_data->humidity);
+    (void)param;
+
+    // Values posted meanwhile wait in the mailbox
+    open_panel();
+
+#if DISPLAY_CURRENT_CHART
+    run_chart();
+#endif
+
+    for (;;) {
+        os_semaphore_take(mailbox_wake, OS_WAIT_FOREVER);
+
+        // Hold off until the interval ends; posts meanwhile replace the values
+        uint32_t refresh_ms = min_refresh_ms;
+        uint32_t elapsed = os_get_time_ms() - last_draw_ms;
+        if (drawn_once && elapsed < refresh_ms) {
+            os_delay_ms(refresh_ms - elapsed);
+        }
+
+        display_values_t values;
+        os_mutex_take(mailbox_mutex, OS_WAIT_FOREVER);
+        values = mailbox;
+        os_mutex_give(mailbox_mutex);
+
+        render(&values);
     }
 }
 
+/**
+ * @brief Subscription filter: only readings that change what is shown
+ *
+ * Most readings repeat the last one at display resolution; skipping them
+ * at dispatch saves the mailbox post and the render task wake-up.
+ */
+static bool temperature_changed(const event_t* event, void* ctx)
+{
+    (void)ctx;
+    if (event->data == NULL || event->data_size < sizeof(temperature_data_t)) {
+        return true;
+    }
+
+    const temperature_data_t* temp_data = (const temperature_data_t*)event->data;
+    return !posted_once || quantize(temp_data->temperature) != posted_temperature ||
+           quantize(temp_data->humidity) != posted_humidity;
+}
+
+static const event_filter_t temperature_filter = EVENT_FILTER_PREDICATE_FN(temperature_changed, NULL);
+
+/**
+ * @brief Event handler for temperature updates
+ */
+EVENT_HANDLER(EVENT_TEMPERATURE_UPDATED, on_temperature_updated)
+{
+    (void)event;
+    post_values(payload->temperature, payload->humidity);
+}
+
 /**
  * @brief Event handler for sensor errors
  */
 static void on_sensor_error(event_t* event)
 {
     // Handle sensor error - display zeros or error indication
-    ips_display_write_temp_data(0.0f, 0.0f);
+    post_values(0.0f, 0.0f);
 }
 
 void display_init(void)
 {
-    // Initialize display hardware
+    // The init sequence's ~800 ms of delays run in the render task
     ips_display_init();
+
+    mailbox_mutex = OS_MUTEX_CREATE_STATIC(mailbox);
+    mailbox_wake = OS_SEMAPHORE_CREATE_BINARY_STATIC(mailbox_wake);
+    if (mailbox_mutex == NULL || mailbox_wake == NULL ||
+        OS_TASK_CREATE_STATIC(render, render_task, "display", NULL,
+                              DISPLAY_TASK_PRIORITY, &render_task_handle) != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create render task");
+        return;
+    }
     
-    // Subscribe to relevant events
-    event_bus_subscribe(EVENT_TEMPERATURE_UPDATED, on_temperature_updated);
+    // Subscribe to relevant events. Handlers only post to the mailbox, so
+    // they stay on the default shard; drawing happens in the render task.
+    event_bus_subscribe_filtered(EVENT_HANDLER_TYPE(on_temperature_updated),
+                                 EVENT_HANDLER_CALLBACK(on_temperature_updated),
+                                 EVENT_SHARD_DEFAULT, &temperature_filter);
     event_bus_subscribe(EVENT_SENSOR_ERROR, on_sensor_error);
 }
 
+bool display_is_ready(void)
+{
+    return panel_ready;
+}
+
+bool display_wait_ready(uint32_t timeout_ms)
+{
+    uint32_t start = os_get_time_ms();
+    while (!panel_ready) {
+        if (render_task_handle == NULL || os_get_time_ms() - start >= timeout_ms) {
+            return false;
+        }
+        os_delay_ms(DISPLAY_READY_POLL_MS);
+    }
+    return true;
+}
+
+void display_set_refresh(uint32_t refresh_ms, uint32_t period_ms)
+{
+    min_refresh_ms = (refresh_ms != 0) ? refresh_ms : DISPLAY_MIN_REFRESH_MS;
+    chart_period_ms = (period_ms != 0) ? period_ms : DISPLAY_CHART_PERIOD_MS;
+}
+
 void display_run(void)
 {
     // Display service is event-driven, no polling needed
-    // All updates happen via event callbacks
+    // All rendering happens in the display task
 }
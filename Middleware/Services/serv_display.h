@@ -7,9 +7,56 @@
  * 
  * This service subscribes to relevant events and updates the display accordingly.
  * It decouples display logic from other services.
+ *
+ * Event handlers only post the values to a last-value mailbox; a
+ * low-priority render task does the SPI drawing at its own pace, so a
+ * redraw never holds up event delivery. It draws at most once per
+ * DISPLAY_MIN_REFRESH_MS, taking the latest values when the interval
+ * ends. Values are compared at display resolution first, so an update
+ * that would show the same digits causes no SPI traffic.
+ *
+ * display_init() returns at once: the render task runs the panel's open
+ * sequence, sleeping through its power-up delays, then publishes
+ * EVENT_DISPLAY_READY (no payload) and starts drawing.
  */
 
+#include <stdint.h>
+#include <stdbool.h>
+
+// Shortest time between two redraws
+#ifndef DISPLAY_MIN_REFRESH_MS
+#define DISPLAY_MIN_REFRESH_MS      250
+#endif
+
+// Replace the value screen by a scrolling chart (display_chart.h): current
+// from the current monitor's capture, one column per sample, and the
+// latest temperature. Without a measurement running, a column is added
+// every DISPLAY_CHART_IDLE_MS so the temperature trace keeps moving.
+#ifndef DISPLAY_CURRENT_CHART
+#define DISPLAY_CURRENT_CHART       0
+#endif
+#define DISPLAY_CHART_PERIOD_MS     20      // Capture poll while charting
+#define DISPLAY_CHART_IDLE_MS       1000
+#define DISPLAY_CHART_CURRENT_MAX_MA    500.0f  // Top row; bottom is 0 mA
+#define DISPLAY_CHART_TEMP_MIN_C        0.0f
+#define DISPLAY_CHART_TEMP_MAX_C        50.0f
+
+// Display resolution of the values; ips_display_write_temp_data() takes
+// hundredths, so keep this at 100
+#define DISPLAY_VALUE_SCALE         100
+
 void display_init(void);
 void display_run(void);
 
+// Whether the panel is open and the UI drawn
+bool display_is_ready(void);
+
+// Block until display_is_ready(); false on timeout or without a render task
+bool display_wait_ready(uint32_t timeout_ms);
+
+// Slow down or restore drawing (load shedding): time between redraws and,
+// with DISPLAY_CURRENT_CHART, between capture polls; 0 for the default.
+// Applies from the next redraw / poll.
+void display_set_refresh(uint32_t min_refresh_ms, uint32_t chart_period_ms);
+
 #endif // SERV_DISPLAY_H
@@ -0,0 +1,247 @@
+#include "serv_load_shed.h"
+#include "serv_config.h"
+#include "serv_display.h"
+#include "serv_temperature_sensor.h"
+#include "link_stats.h"
+#include "deadline_monitor.h"
+#include "performance_monitor.h"
+#include "event_bus.h"
+#include "service_events.h"
+#include "os_wrapper.h"
+#include "portable_log.h"
+#include <string.h>
+
+static const char *TAG = "LOAD_SHED";
+
+// What each level runs at, against the configured values (serv_config.h);
+// row LOAD_SHED_NONE is the configuration as it is
+typedef struct {
+    uint8_t display_refresh_factor;
+    uint8_t chart_period_factor;
+    uint8_t temperature_read_factor;
+    uint8_t log_level_cap;          // Default level at most this; tags set on their own keep theirs
+} load_shed_policy_t;
+
+static const load_shed_policy_t policies[LOAD_SHED_LEVEL_COUNT] = {
+    [LOAD_SHED_NONE]  = { 1, 1, 1, LOG_LVL_VERBOSE },
+    [LOAD_SHED_LIGHT] = { 4, 2, 1, LOG_LVL_WARN },
+    [LOAD_SHED_HEAVY] = { 8, 5, 5, LOG_LVL_ERROR },
+};
+
+static const char *const level_names[LOAD_SHED_LEVEL_COUNT] = {
+    [LOAD_SHED_NONE]  = "none",
+    [LOAD_SHED_LIGHT] = "light",
+    [LOAD_SHED_HEAVY] = "heavy",
+};
+
+// Deadlines load shedding is there to protect
+static const deadline_id_t protected_deadlines[] = {
+    DEADLINE_CURRENT_SAMPLE,
+    DEADLINE_CURRENT_TASK,
+    DEADLINE_STREAM_0,
+    DEADLINE_STREAM_1,
+};
+#define PROTECTED_COUNT (sizeof(protected_deadlines) / sizeof(protected_deadlines[0]))
+
+static load_shed_status_t status;
+static uint32_t last_eval_ms = 0;
+static uint32_t calm_evals = 0;
+static uint32_t last_misses[PROTECTED_COUNT];
+static volatile bool refresh_requested = false;
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static uint32_t new_protected_misses(void)
+{
+    uint32_t total = 0;
+    deadline_stats_t stats;
+
+    for (uint32_t i = 0; i < PROTECTED_COUNT; i++) {
+        if (!deadline_monitor_get(protected_deadlines[i], &stats)) {
+            continue;
+        }
+        // Re-registering clears the count: take it as the new base
+        if (stats.misses >= last_misses[i]) {
+            total += stats.misses - last_misses[i];
+        }
+        last_misses[i] = stats.misses;
+    }
+    return total;
+}
+
+/**
+ * @brief Level the signals call for, entering thresholds only
+ */
+static load_shed_level_t demanded_level(uint8_t cpu, uint16_t link, uint32_t misses)
+{
+    if (misses > 0 || cpu >= LOAD_SHED_HEAVY_CPU_PERCENT || link >= LOAD_SHED_HEAVY_LINK_PERMILLE) {
+        return LOAD_SHED_HEAVY;
+    }
+    if (cpu >= LOAD_SHED_LIGHT_CPU_PERCENT || link >= LOAD_SHED_LIGHT_LINK_PERMILLE) {
+        return LOAD_SHED_LIGHT;
+    }
+    return LOAD_SHED_NONE;
+}
+
+/**
+ * @brief Whether the signals are clear of the current level's exit threshold
+ */
+static bool below_exit(load_shed_level_t level, uint8_t cpu, uint16_t link)
+{
+    uint32_t cpu_threshold = (level == LOAD_SHED_HEAVY) ? LOAD_SHED_HEAVY_CPU_PERCENT
+                                                        : LOAD_SHED_LIGHT_CPU_PERCENT;
+    uint32_t link_threshold = (level == LOAD_SHED_HEAVY) ? LOAD_SHED_HEAVY_LINK_PERMILLE
+                                                         : LOAD_SHED_LIGHT_LINK_PERMILLE;
+    return cpu + LOAD_SHED_EXIT_CPU_PERCENT < cpu_threshold &&
+           link + LOAD_SHED_EXIT_LINK_PERMILLE < link_threshold;
+}
+
+static void apply(load_shed_level_t level)
+{
+    const load_shed_policy_t *policy = &policies[level];
+    uint32_t log_level = config_get(CONFIG_KEY_LOG_LEVEL);
+
+    display_set_refresh(config_get(CONFIG_KEY_DISPLAY_REFRESH_MS) * policy->display_refresh_factor,
+                        config_get(CONFIG_KEY_DISPLAY_CHART_MS) * policy->chart_period_factor);
+    temperature_sensor_set_read_interval(config_get(CONFIG_KEY_TEMP_READ_MS) *
+                                         policy->temperature_read_factor);
+    log_set_level(NULL, (uint8_t)((log_level < policy->log_level_cap) ? log_level
+                                                                       : policy->log_level_cap));
+}
+
+static void change_level(load_shed_level_t level, uint32_t misses)
+{
+    load_shed_event_t event = {
+        .level = (uint8_t)level,
+        .previous = (uint8_t)status.level,
+        .cpu_percent = status.cpu_percent,
+        .link_permille = status.link_permille,
+        .deadline_misses = misses,
+    };
+
+    // Logged at warning level, so the heavy level's error-only setting
+    // applies from the next message on
+    LOG_W(TAG, "Level %s -> %s (cpu %u%%, link %u/1000, %lu misses)",
+          level_names[status.level], level_names[level], status.cpu_percent,
+          status.link_permille, (unsigned long)misses);
+    apply(level);
+
+    uint32_t mask = os_critical_enter();
+    status.level = level;
+    status.changes++;
+    os_critical_exit(mask);
+
+    calm_evals = 0;
+    EVENT_PUBLISH(EVENT_LOAD_SHED_CHANGED, &event);
+}
+
+static void evaluate(uint32_t elapsed_ms)
+{
+    link_stats_t link;
+    uint8_t cpu = perf_get_cpu_load_percent();
+    uint16_t link_busy = link_stats_get(&link) ? link.tx_busy_permille : 0;
+    uint32_t misses = new_protected_misses();
+
+    uint32_t mask = os_critical_enter();
+    status.cpu_percent = cpu;
+    status.link_permille = link_busy;
+    status.evaluations++;
+    status.time_in_level_ms[status.level] += elapsed_ms;
+    load_shed_level_t forced = status.forced;
+    os_critical_exit(mask);
+
+    if (forced != LOAD_SHED_LEVEL_COUNT) {
+        if (forced != status.level) {
+            change_level(forced, misses);
+        }
+        return;
+    }
+
+    load_shed_level_t demanded = demanded_level(cpu, link_busy, misses);
+    if (demanded > status.level) {
+        change_level(demanded, misses);
+        return;
+    }
+
+    // Step down one level at a time, after a calm spell
+    if (status.level == LOAD_SHED_NONE || !below_exit(status.level, cpu, link_busy)) {
+        calm_evals = 0;
+        return;
+    }
+    if (++calm_evals >= LOAD_SHED_HOLD_EVALS) {
+        change_level((load_shed_level_t)(status.level - 1), misses);
+    }
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+void load_shed_init(void)
+{
+    uint32_t mask = os_critical_enter();
+    memset(&status, 0, sizeof(status));
+    status.level = LOAD_SHED_NONE;
+    status.forced = LOAD_SHED_LEVEL_COUNT;
+    os_critical_exit(mask);
+
+    calm_evals = 0;
+    last_eval_ms = os_get_time_ms();
+    (void)new_protected_misses();
+    refresh_requested = false;
+    apply(LOAD_SHED_NONE);
+}
+
+void load_shed_refresh(void)
+{
+    refresh_requested = true;
+}
+
+void load_shed_process(void)
+{
+    uint32_t now = os_get_time_ms();
+    uint32_t elapsed = now - last_eval_ms;
+
+    if (refresh_requested) {
+        refresh_requested = false;
+        apply(status.level);
+    }
+
+    if (elapsed < LOAD_SHED_EVAL_MS) {
+        return;
+    }
+    last_eval_ms = now;
+    evaluate(elapsed);
+}
+
+void load_shed_force(load_shed_level_t level)
+{
+    if (level > LOAD_SHED_LEVEL_COUNT) {
+        return;
+    }
+    uint32_t mask = os_critical_enter();
+    status.forced = level;
+    os_critical_exit(mask);
+}
+
+load_shed_level_t load_shed_get_level(void)
+{
+    return status.level;
+}
+
+void load_shed_get_status(load_shed_status_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+    uint32_t mask = os_critical_enter();
+    *out = status;
+    os_critical_exit(mask);
+}
+
+const char *load_shed_level_name(load_shed_level_t level)
+{
+    return (level < LOAD_SHED_LEVEL_COUNT) ? level_names[level] : "?";
+}
@@ -0,0 +1,104 @@
+/**
+ * @file serv_load_shed.h
+ * @brief Load shedding: slow down low-priority work under overload
+ *
+ * Every LOAD_SHED_EVAL_MS the service looks at three signals:
+ *   - CPU load of the last interval (perf_get_cpu_load_percent())
+ *   - TX busy share of the host link (link_stats_t.tx_busy_permille)
+ *   - new misses of the protected deadlines: current sampling, the
+ *     current task and the stream slots (deadline_monitor.h)
+ *
+ * and picks a level. Each level is a row of the policy table: display
+ * refresh and chart poll and temperature read interval as multiples of
+ * their configured values (serv_config.h), and a cap on the configured
+ * default log level; LOAD_SHED_NONE runs the configuration as it is.
+ * Current capture and the protocol are never throttled; shedding only buys
+ * them CPU and link time by slowing the rest.
+ *
+ * A level is entered on the first evaluation above its threshold (a
+ * protected deadline miss goes straight to LOAD_SHED_HEAVY) and left one
+ * step at a time after LOAD_SHED_HOLD_EVALS evaluations below its exit
+ * threshold, so a load hovering near a threshold does not flap. A change
+ * publishes EVENT_LOAD_SHED_CHANGED (load_shed_event_t).
+ *
+ * Call load_shed_process() periodically (services loop).
+ */
+
+#ifndef SERV_LOAD_SHED_H
+#define SERV_LOAD_SHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LOAD_SHED_EVAL_MS               1000    // As PERF_SAMPLE_PERIOD_MS
+#define LOAD_SHED_HOLD_EVALS            3       // Calm evaluations before stepping down
+
+#define LOAD_SHED_LIGHT_CPU_PERCENT     70
+#define LOAD_SHED_HEAVY_CPU_PERCENT     85
+#define LOAD_SHED_LIGHT_LINK_PERMILLE   800
+#define LOAD_SHED_HEAVY_LINK_PERMILLE   950
+#define LOAD_SHED_EXIT_CPU_PERCENT      10      // Exit this far below the entry threshold
+#define LOAD_SHED_EXIT_LINK_PERMILLE    100
+
+typedef enum {
+    LOAD_SHED_NONE = 0,             // Everything at full rate
+    LOAD_SHED_LIGHT,                // Slower display, warnings only
+    LOAD_SHED_HEAVY,                // Display and temperature at a crawl, errors only
+    LOAD_SHED_LEVEL_COUNT
+} load_shed_level_t;
+
+/**
+ * @brief EVENT_LOAD_SHED_CHANGED payload
+ */
+typedef struct {
+    uint8_t  level;                 // load_shed_level_t, new
+    uint8_t  previous;
+    uint8_t  cpu_percent;           // Signals of the deciding evaluation
+    uint16_t link_permille;
+    uint32_t deadline_misses;       // Protected misses since the last evaluation
+} load_shed_event_t;
+
+typedef struct {
+    load_shed_level_t level;
+    load_shed_level_t forced;       // LOAD_SHED_LEVEL_COUNT when automatic
+    uint8_t  cpu_percent;           // Last evaluation
+    uint16_t link_permille;
+    uint32_t evaluations;
+    uint32_t changes;
+    uint32_t time_in_level_ms[LOAD_SHED_LEVEL_COUNT];
+} load_shed_status_t;
+
+/**
+ * @brief Start at LOAD_SHED_NONE, applying the configured values (after
+ *        the config store, display, temperature and link stats are
+ *        initialized)
+ */
+void load_shed_init(void);
+
+/**
+ * @brief Apply the current level again, e.g. after the configured values
+ *        changed (any task; takes effect in the next load_shed_process())
+ */
+void load_shed_refresh(void);
+
+/**
+ * @brief Evaluate if LOAD_SHED_EVAL_MS have passed and apply a new level
+ */
+void load_shed_process(void);
+
+/**
+ * @brief Pin a level (tests, host command); LOAD_SHED_LEVEL_COUNT returns
+ *        to automatic
+ */
+void load_shed_force(load_shed_level_t level);
+
+load_shed_level_t load_shed_get_level(void);
+
+/**
+ * @brief Copy the status (from any task)
+ */
+void load_shed_get_status(load_shed_status_t *status);
+
+const char *load_shed_level_name(load_shed_level_t level);
+
+#endif // SERV_LOAD_SHED_H
@@ -0,0 +1,530 @@
+/**
+ * @file serv_recorder.c
+ * @brief Streaming recorder: current measurements drained into block storage
+ */
+
+#include "serv_recorder.h"
+#include "serv_current_monitor.h"
+#include "services.h"
+#include "ina226.h"
+#include "crc16.h"
+#include "series_codec.h"
+#include "hal_mem.h"
+#include "os_wrapper.h"
+#include "os_sched.h"
+#include "portable_log.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+static const char *TAG = "RECORDER";
+
+#define RECORDER_RAM_BLOCKS         2
+#define RECORDER_WRITE_RETRIES      2
+#define NO_BLOCK                    (-1)
+
+_Static_assert(RECORDER_RECORDS_PER_BLOCK <= UINT16_MAX, "record_count is 16 bits");
+_Static_assert(RECORDER_PACKED_RECORDS_MAX <= UINT16_MAX, "record_count is 16 bits");
+
+#if RECORDER_COMPRESS
+#define BLOCK_MAGIC                 RECORDER_BLOCK_MAGIC_PACKED
+#else
+#define BLOCK_MAGIC                 RECORDER_BLOCK_MAGIC
+#endif
+
+#define BLOCK_DATA_SIZE             (RECORDER_BLOCK_SIZE - sizeof(recorder_block_header_t))
+
+// Fields of a packed block, in recorder_record_t order (see serv_recorder.h)
+static const series_codec_field_t packed_fields[] = {
+    { SERIES_CODEC_DELTA_OF_DELTA, 16 },    // dt
+    { SERIES_CODEC_DELTA, 16 },             // current_raw
+    { SERIES_CODEC_DELTA, 16 },             // bus_voltage_raw
+    { SERIES_CODEC_REPEAT, 8 },             // state
+};
+
+// ============================================================================
+// Private Types and Data
+// ============================================================================
+
+typedef enum {
+    BLOCK_FREE = 0,
+    BLOCK_FILLING,
+    BLOCK_FULL,                     // Sealed, waiting for the backend
+    BLOCK_WRITING
+} block_state_t;
+
+typedef struct {
+    block_state_t state;
+    uint32_t sequence;              // Block number in the recording (set when sealed)
+    uint32_t count;
+    uint32_t first_index;
+    uint64_t last_us;               // Time of the last record as the host will rebuild it
+    uint8_t retries;
+#if RECORDER_COMPRESS
+    series_codec_encoder_t encoder; // Packs the records behind the header
+#endif
+} block_meta_t;
+
+static uint8_t block_data[RECORDER_RAM_BLOCKS][RECORDER_BLOCK_SIZE] __attribute__((aligned(HAL_CACHE_LINE_SIZE)));
+static block_meta_t blocks[RECORDER_RAM_BLOCKS];
+static int fill_block = NO_BLOCK;
+static int write_block = NO_BLOCK;
+
+static const recorder_backend_t *backend = NULL;
+static os_mutex_handle_t recorder_mutex = NULL;    // process() vs. readers
+OS_MUTEX_DEFINE(recorder);
+static bool enabled = false;
+static bool recording = false;
+static uint32_t next_sequence = 0;
+
+// Current recording's encoding
+static uint16_t time_unit_us = 1000;
+static float current_lsb_mA = 0.0f;
+
+// Drained samples not yet packed (kept across passes when both blocks are busy)
+static current_sample_t batch[RECORDER_DRAIN_BATCH];
+static uint32_t batch_len = 0;
+static uint32_t batch_pos = 0;
+static uint32_t batch_first = 0;
+static volatile bool drain_due = false;            // Backlog reached the watermark
+
+static recorder_stats_t stats = {0};
+
+// ============================================================================
+// Private Functions
+// ============================================================================
+
+static inline recorder_block_header_t *block_header(int b)
+{
+    return (recorder_block_header_t *)block_data[b];
+}
+
+static inline uint8_t *block_body(int b)
+{
+    return block_data[b] + sizeof(recorder_block_header_t);
+}
+
+// Bytes of the block body the records use
+static inline uint32_t block_body_used(int b)
+{
+#if RECORDER_COMPRESS
+    return (uint32_t)series_codec_encoded_bytes(&blocks[b].encoder);
+#else
+    return blocks[b].count * sizeof(recorder_record_t);
+#endif
+}
+
+static inline uint64_t sample_time_us(const current_sample_t *sample)
+{
+    return (uint64_t)sample->timestamp_sec * 1000000ULL +
+           (uint64_t)sample->timestamp_ms * 1000ULL + sample->timestamp_us;
+}
+
+static bool header_valid(const recorder_block_header_t *header, uint32_t recording_id, uint32_t sequence)
+{
+    if (header->recording_id != recording_id || header->sequence != sequence) {
+        return false;
+    }
+    // Either format: a recording made before a change of RECORDER_COMPRESS stays readable
+    if (header->magic == RECORDER_BLOCK_MAGIC_PACKED) {
+        return header->record_count <= RECORDER_PACKED_RECORDS_MAX;
+    }
+    return header->magic == RECORDER_BLOCK_MAGIC &&
+           header->record_count <= RECORDER_RECORDS_PER_BLOCK;
+}
+
+static bool read_header(uint32_t block, recorder_block_header_t *header)
+{
+    return backend->read(block * RECORDER_BLOCK_SIZE, (uint8_t *)header, sizeof(*header)) == RECORDER_BACKEND_OK;
+}
+
+// Find the last recording: block 0 names it, its blocks follow contiguously
+static void recover_last_recording(void)
+{
+    recorder_block_header_t header;
+
+    if (!read_header(0, &header) || !header_valid(&header, header.recording_id, 0)) {
+        stats.recording_id = 0;
+        stats.blocks_recorded = 0;
+        return;
+    }
+    uint32_t id = header.recording_id;
+
+    // Invariant: block lo belongs to the recording, block hi does not
+    uint32_t lo = 0;
+    uint32_t hi = stats.block_count;
+    while (hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (read_header(mid, &header) && header_valid(&header, id, mid)) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    stats.recording_id = id;
+    stats.blocks_recorded = lo + 1;
+}
+
+static int take_free_block(void)
+{
+    for (int b = 0; b < RECORDER_RAM_BLOCKS; b++) {
+        if (blocks[b].state == BLOCK_FREE) {
+            memset(block_data[b], 0xFF, RECORDER_BLOCK_SIZE);  // Filler reads as erased
+            blocks[b].state = BLOCK_FILLING;
+            blocks[b].count = 0;
+            blocks[b].retries = 0;
+#if RECORDER_COMPRESS
+            series_codec_encoder_init(&blocks[b].encoder, packed_fields, 4, block_body(b), BLOCK_DATA_SIZE);
+#endif
+            fill_block = b;
+            return b;
+        }
+    }
+    return NO_BLOCK;
+}
+
+static bool append_record(int b, const current_sample_t *sample, uint32_t index)
+{
+    block_meta_t *meta = &blocks[b];
+    recorder_block_header_t *header = block_header(b);
+    uint64_t t_us = sample_time_us(sample);
+    uint32_t dt = 0;
+
+    if (meta->count == 0) {
+        meta->first_index = index;
+        meta->last_us = t_us;
+        header->first_index = index;
+        header->start_sec = sample->timestamp_sec;
+        header->start_ms = sample->timestamp_ms;
+        header->start_us = sample->timestamp_us;
+    } else {
+        // A gap in the indices or a time step dt cannot hold starts a new block
+        if (index != meta->first_index + meta->count || t_us < meta->last_us) {
+            return false;
+        }
+        uint64_t units = (t_us - meta->last_us) / time_unit_us;
+        if (units > UINT16_MAX) {
+            return false;
+        }
+        dt = (uint32_t)units;
+    }
+
+    recorder_record_t record = {
+        .dt = (uint16_t)dt,
+        .current_raw = (current_lsb_mA > 0.0f) ?
+                       (int16_t)lroundf(sample->current_mA / current_lsb_mA) : 0,
+        .bus_voltage_raw = (uint16_t)lroundf(sample->voltage_V / INA226_BUS_VOLTAGE_LSB_V),
+        .state = sample->state_machine_state,
+    };
+
+#if RECORDER_COMPRESS
+    const int32_t values[4] = { record.dt, record.current_raw, record.bus_voltage_raw, record.state };
+    if (!series_codec_encode(&meta->encoder, values)) {
+        return false;       // Block full
+    }
+#else
+    memcpy(block_body(b) + meta->count * sizeof(recorder_record_t), &record, sizeof(record));
+#endif
+
+    meta->last_us += (uint64_t)dt * time_unit_us;
+    meta->count++;
+    return true;
+}
+
+static void seal_block(int b)
+{
+    block_meta_t *meta = &blocks[b];
+    fill_block = NO_BLOCK;
+
+    if (meta->count == 0) {
+        meta->state = BLOCK_FREE;
+        return;
+    }
+
+    recorder_block_header_t *header = block_header(b);
+    header->magic = BLOCK_MAGIC;
+    header->recording_id = stats.recording_id;
+    header->sequence = next_sequence;
+    header->record_count = (uint16_t)meta->count;
+    header->time_unit_us = time_unit_us;
+    header->current_lsb_mA = current_lsb_mA;
+
+    uint16_t crc = crc16_ccitt(CRC16_CCITT_INIT, block_data[b], offsetof(recorder_block_header_t, crc));
+    header->crc = crc16_ccitt(crc, block_body(b), block_body_used(b));
+
+    meta->sequence = next_sequence++;
+    meta->state = BLOCK_FULL;
+}
+
+static void drop_pending_blocks(void)
+{
+    for (int b = 0; b < RECORDER_RAM_BLOCKS; b++) {
+        if (blocks[b].state == BLOCK_FULL || blocks[b].state == BLOCK_FILLING) {
+            blocks[b].state = BLOCK_FREE;
+        }
+    }
+    fill_block = NO_BLOCK;
+}
+
+// Drain watermark: run the recorder job now, not at the next period
+static void drain_watermark(bool above, void *user_data)
+{
+    (void)user_data;
+    drain_due = above;
+    if (!above) {
+        return;
+    }
+    if (os_in_isr()) {
+        bool woken = false;
+        os_sched_post_from_isr(SERVICES_JOB_RECORDER, &woken);
+        os_yield_from_isr(woken);
+    } else {
+        os_sched_post(SERVICES_JOB_RECORDER);
+    }
+}
+
+static void stop_recording(void)
+{
+    current_monitor_drain_detach();
+    recording = false;
+    batch_len = 0;
+    batch_pos = 0;
+    LOG_I(TAG, "Recording %lu finished: %lu blocks", stats.recording_id, stats.blocks_recorded);
+}
+
+// Finish the write in flight, then start the oldest sealed block
+static void service_writes(void)
+{
+    if (write_block != NO_BLOCK) {
+        block_meta_t *meta = &blocks[write_block];
+        recorder_backend_status_t status = backend->poll();
+        if (status == RECORDER_BACKEND_BUSY) {
+            return;
+        }
+        if (status == RECORDER_BACKEND_OK) {
+            stats.blocks_recorded = meta->sequence + 1;
+            stats.records_written += meta->count;
+            meta->state = BLOCK_FREE;
+        } else if (meta->retries++ < RECORDER_WRITE_RETRIES) {
+            meta->state = BLOCK_FULL;   // Try the same block again
+        } else {
+            // Later blocks would be unreachable behind the hole
+            LOG_E(TAG, "Block %lu write failed", meta->sequence);
+            stats.write_errors++;
+            meta->state = BLOCK_FREE;
+            drop_pending_blocks();
+            if (recording) {
+                stop_recording();
+            }
+        }
+        write_block = NO_BLOCK;
+    }
+
+    int next = NO_BLOCK;
+    for (int b = 0; b < RECORDER_RAM_BLOCKS; b++) {
+        if (blocks[b].state == BLOCK_FULL &&
+            (next == NO_BLOCK || blocks[b].sequence < blocks[next].sequence)) {
+            next = b;
+        }
+    }
+    if (next == NO_BLOCK) {
+        return;
+    }
+
+    if (blocks[next].sequence >= stats.block_count) {
+        LOG_W(TAG, "Storage full, recording %lu cut short", stats.recording_id);
+        stats.storage_full++;
+        drop_pending_blocks();
+        if (recording) {
+            stop_recording();
+        }
+        return;
+    }
+
+    if (backend->write_block(blocks[next].sequence, block_data[next]) == RECORDER_BACKEND_OK) {
+        blocks[next].state = BLOCK_WRITING;
+        write_block = next;
+    } else if (blocks[next].retries++ >= RECORDER_WRITE_RETRIES) {
+        stats.write_errors++;
+        drop_pending_blocks();
+        if (recording) {
+            stop_recording();
+        }
+    }
+}
+
+static void start_recording(void)
+{
+    if (!current_monitor_drain_attach(0)) {
+        return;     // A capture dump holds the drain; retried next pass
+    }
+
+    measurement_config_t config;
+    current_monitor_get_config(&config);
+    time_unit_us = (uint16_t)config.sample_period;   // 1 unit = 1 us per ms of period
+    current_lsb_mA = current_monitor_get_current_lsb_mA();
+
+    stats.recording_id++;
+    stats.blocks_recorded = 0;
+    next_sequence = 0;
+    batch_len = 0;
+    batch_pos = 0;
+    recording = true;
+
+    // Drained in batches of the watermark while the measurement runs
+    drain_due = false;
+    current_monitor_drain_set_watermarks(RECORDER_DRAIN_WATERMARK, 0, drain_watermark, NULL);
+
+    LOG_I(TAG, "Recording %lu started (%s)", stats.recording_id, backend->name);
+}
+
+// Pack drained samples until the drain is empty or no RAM block is free
+static bool drain_samples(void)
+{
+    while (true) {
+        if (batch_pos == batch_len) {
+            batch_len = current_monitor_drain_read(batch, RECORDER_DRAIN_BATCH, &batch_first);
+            batch_pos = 0;
+            if (batch_len == 0) {
+                return true;    // Caught up
+            }
+        }
+
+        int b = (fill_block != NO_BLOCK) ? fill_block : take_free_block();
+        if (b == NO_BLOCK) {
+            return false;       // Storage behind; the drain holds the producer back
+        }
+
+        if (append_record(b, &batch[batch_pos], batch_first + batch_pos)) {
+            batch_pos++;
+            if (!RECORDER_COMPRESS && blocks[b].count == RECORDER_RECORDS_PER_BLOCK) {
+                seal_block(b);
+            }
+        } else {
+            seal_block(b);      // Sample goes first into the next block
+        }
+    }
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+bool recorder_init(const recorder_backend_t *backend_in)
+{
+    if (backend_in == NULL || backend_in->block_size != RECORDER_BLOCK_SIZE) {
+        return false;
+    }
+
+    if (recorder_mutex == NULL) {
+        recorder_mutex = OS_MUTEX_CREATE_STATIC(recorder);
+        if (recorder_mutex == NULL) {
+            return false;
+        }
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    memset(blocks, 0, sizeof(blocks));
+    fill_block = NO_BLOCK;
+    write_block = NO_BLOCK;
+    recording = false;
+    backend = backend_in;
+
+    if (!backend->open()) {
+        LOG_W(TAG, "No %s storage", backend->name);
+        return false;
+    }
+
+    stats.block_count = backend->get_block_count();
+    recover_last_recording();
+
+    stats.available = true;
+    enabled = true;
+    LOG_I(TAG, "%s: %lu blocks, recording %lu holds %lu",
+          backend->name, stats.block_count, stats.recording_id, stats.blocks_recorded);
+    return true;
+}
+
+void recorder_set_enabled(bool enable)
+{
+    enabled = enable;
+}
+
+void recorder_process(void)
+{
+    if (!stats.available) {
+        return;
+    }
+
+    os_mutex_take(recorder_mutex, OS_WAIT_FOREVER);
+
+    service_writes();
+
+    if (!recording && enabled && current_monitor_get_status() == MEASUREMENT_RUNNING) {
+        start_recording();
+    }
+
+    if (recording) {
+        bool measuring = enabled && current_monitor_get_status() == MEASUREMENT_RUNNING;
+        // Below the watermark the samples wait in the capture buffer
+        bool caught_up = (drain_due || !measuring) ? drain_samples() : true;
+
+        if (caught_up && !measuring) {
+            if (fill_block != NO_BLOCK) {
+                seal_block(fill_block);
+            }
+        }
+        service_writes();
+
+        // Done once the last partial block is in storage
+        if (recording && caught_up && !measuring &&
+            write_block == NO_BLOCK && fill_block == NO_BLOCK) {
+            bool pending = false;
+            for (int b = 0; b < RECORDER_RAM_BLOCKS; b++) {
+                pending |= (blocks[b].state != BLOCK_FREE);
+            }
+            if (!pending) {
+                stop_recording();
+            }
+        }
+    }
+
+    os_mutex_give(recorder_mutex);
+}
+
+uint32_t recorder_read(uint32_t offset, uint8_t *data, uint32_t len, uint32_t *total_bytes)
+{
+    if (!stats.available || data == NULL) {
+        return 0;
+    }
+
+    os_mutex_take(recorder_mutex, OS_WAIT_FOREVER);
+
+    uint32_t total = stats.blocks_recorded * RECORDER_BLOCK_SIZE;
+    if (total_bytes != NULL) {
+        *total_bytes = total;
+    }
+
+    uint32_t n = 0;
+    if (offset < total) {
+        n = (len < total - offset) ? len : total - offset;
+        if (backend->read(offset, data, n) != RECORDER_BACKEND_OK) {
+            n = 0;
+        }
+    }
+
+    os_mutex_give(recorder_mutex);
+    return n;
+}
+
+void recorder_get_stats(recorder_stats_t *stats_out)
+{
+    if (stats_out == NULL) {
+        return;
+    }
+    *stats_out = stats;
+    stats_out->enabled = enabled;
+    stats_out->recording = recording;
+    stats_out->drain_overruns = recording ? current_monitor_drain_get_overruns() : 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file serv_recorder.h
+ * @brief Streaming recorder: current measurements drained into block storage
+ *
+ * While enabled, every current measurement is recorded from its first
+ * sample: the recorder attaches as the current monitor's drain consumer,
+ * packs samples into compact blocks and hands full blocks to a storage
+ * backend (recorder_backend.h). Two RAM blocks are used in turn, so one
+ * fills while the other is written; if storage falls behind, the drain
+ * holds the producer back and the monitor counts the overruns.
+ *
+ * A recording always starts at block 0 and is written sequentially, so
+ * after a reboot its length is found by binary searching the blocks for
+ * the last one of the same recording. Read it out as a byte stream with
+ * recorder_read() (CMD_GET_RECORDING).
+ *
+ * Block format (little endian): recorder_block_header_t, then
+ * record_count recorder_record_t, then erased filler. Records carry raw
+ * INA226 registers: current_mA = current_raw * current_lsb_mA and
+ * voltage_V = bus_voltage_raw * 1.25 mV. Each record's time is the
+ * previous one's plus dt * time_unit_us (the block start for the first).
+ * At 1 kHz this is 7 bytes per sample, about 25 MB per hour.
+ *
+ * With RECORDER_COMPRESS the blocks carry RECORDER_BLOCK_MAGIC_PACKED and
+ * the same records as one series_codec run (Utils/series_codec.h) of four
+ * fields: dt (delta of delta, 16 bits), current_raw (delta, 16),
+ * bus_voltage_raw (delta, 16) and state (repeat, 8). The CRC covers the
+ * encoded bytes. A steady measurement packs to under 2 bytes per sample;
+ * every block decodes on its own, so the recording stays seekable by
+ * block. tools/recording_decode.py reads both formats.
+ *
+ * While the recorder holds the drain, CMD_GET_CURRENT_CAPTURE falls back
+ * to a plain cursor.
+ */
+
+#ifndef SERV_RECORDER_H
+#define SERV_RECORDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "recorder_backend.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define RECORDER_BLOCK_SIZE         4096    // Must match the backend's block size
+
+// Packed blocks (RECORDER_BLOCK_MAGIC_PACKED) instead of recorder_record_t arrays
+#ifndef RECORDER_COMPRESS
+#define RECORDER_COMPRESS           0
+#endif
+#define RECORDER_DRAIN_BATCH        32      // Samples drained per step
+#define RECORDER_DRAIN_WATERMARK    256     // Backlog that wakes the drain while measuring
+
+// ============================================================================
+// Block Format
+// ============================================================================
+
+#define RECORDER_BLOCK_MAGIC        0x43455252UL    // "RREC"
+#define RECORDER_BLOCK_MAGIC_PACKED 0x5A455252UL    // "RREZ"
+
+typedef struct {
+    uint32_t magic;                 /**< RECORDER_BLOCK_MAGIC */
+    uint32_t recording_id;          /**< Increases with every recording */
+    uint32_t sequence;              /**< Block number within the recording */
+    uint32_t first_index;           /**< Measurement sample index of the first record */
+    uint32_t start_sec;             /**< Unix time of the first record */
+    uint16_t start_ms;
+    uint16_t start_us;
+    uint16_t record_count;
+    uint16_t time_unit_us;          /**< Unit of recorder_record_t.dt */
+    float current_lsb_mA;           /**< mA per current_raw LSB */
+    uint16_t crc;                   /**< CRC16-CCITT over the header up to here and the records */
+} __attribute__((packed)) recorder_block_header_t;
+
+typedef struct {
+    uint16_t dt;                    /**< Time since the previous record, time_unit_us units */
+    int16_t current_raw;            /**< INA226 current register */
+    uint16_t bus_voltage_raw;       /**< INA226 bus voltage register */
+    uint8_t state;                  /**< Main state machine state */
+} __attribute__((packed)) recorder_record_t;
+
+#define RECORDER_RECORDS_PER_BLOCK \
+    ((RECORDER_BLOCK_SIZE - sizeof(recorder_block_header_t)) / sizeof(recorder_record_t))
+
+// Packed: at least 4 bits per record (all four fields unchanged)
+#define RECORDER_PACKED_RECORDS_MAX \
+    ((RECORDER_BLOCK_SIZE - sizeof(recorder_block_header_t)) * 8 / 4)
+
+// ============================================================================
+// Types
+// ============================================================================
+
+typedef struct {
+    bool available;                 /**< Backend opened */
+    bool enabled;
+    bool recording;                 /**< Draining a measurement now */
+    uint32_t recording_id;          /**< Current or last recording */
+    uint32_t blocks_recorded;       /**< Blocks of it in storage */
+    uint32_t block_count;           /**< Storage capacity in blocks */
+    uint32_t records_written;       /**< Since boot */
+    uint32_t write_errors;          /**< Blocks lost to storage errors */
+    uint32_t storage_full;          /**< Recordings cut short by a full storage */
+    uint32_t drain_overruns;        /**< Samples the monitor dropped in the current recording */
+} recorder_stats_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Open the backend and recover the last recording
+ *
+ * @param backend Storage backend
+ * @return false if the storage is absent (the recorder stays idle)
+ */
+bool recorder_init(const recorder_backend_t *backend);
+
+/**
+ * @brief Record upcoming measurements (on by default once initialized)
+ *
+ * Disabling finishes a recording in progress with what is drained so far.
+ */
+void recorder_set_enabled(bool enabled);
+
+/**
+ * @brief Drain samples and advance storage writes (call from the service loop)
+ */
+void recorder_process(void);
+
+/**
+ * @brief Read the current or last recording as a byte stream
+ *
+ * @param offset Byte offset from the start of block 0
+ * @param data Output buffer
+ * @param len Bytes wanted
+ * @param total_bytes Output: recorded bytes available (can be NULL)
+ * @return Bytes read; 0 past the end or while storage is busy writing
+ */
+uint32_t recorder_read(uint32_t offset, uint8_t *data, uint32_t len, uint32_t *total_bytes);
+
+/**
+ * @brief Get recorder statistics
+ */
+void recorder_get_stats(recorder_stats_t *stats);
+
+#endif // SERV_RECORDER_H
@@ -0,0 +1,437 @@
+/**
+ * @file serv_sample_log.c
+ * @brief Persistent, append-only sample log in internal flash
+ */
+
+#include "serv_sample_log.h"
+#include "serv_current_monitor.h"
+#include "hal_flash.h"
+#include "crc16.h"
+#include "os_wrapper.h"
+#include "os_sched.h"
+#include "services.h"
+#include "portable_log.h"
+#include <stddef.h>
+#include <string.h>
+
+static const char *TAG = "SAMPLE_LOG";
+
+#define SAMPLE_LOG_MAGIC            0x474F4C53UL    // "SLOG"
+#define PAGES_PER_SECTOR            (HAL_FLASH_DATA_SECTOR_SIZE / SAMPLE_LOG_PAGE_SIZE)
+#define FIRST_DATA_PAGE             1               // Page 0 is the sector header
+#define LOG_SECTOR_COUNT            HAL_FLASH_CONFIG_SECTOR     // The data area less the config sectors
+
+// ============================================================================
+// Flash Layout
+// ============================================================================
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;          // Increases with every sector taken into use, never 0
+} log_sector_header_t;
+
+typedef struct {
+    uint16_t sample_count;
+    uint16_t crc;               // CRC16 over the samples
+    sensor_sample_t samples[SAMPLE_LOG_SAMPLES_PER_PAGE];
+} __attribute__((packed)) log_page_t;
+
+// Programmed in whole words
+#define LOG_PAGE_PROGRAM_SIZE   ((sizeof(log_page_t) + 3U) & ~3U)
+
+_Static_assert(LOG_PAGE_PROGRAM_SIZE <= SAMPLE_LOG_PAGE_SIZE, "log page does not fit its slot");
+
+// ============================================================================
+// Private Data
+// ============================================================================
+
+typedef struct {
+    uint32_t sequence;          // 0 = not part of the log
+    uint32_t first_timestamp;   // Of the first data page (if any)
+} sector_index_t;
+
+static sector_index_t sectors[LOG_SECTOR_COUNT];
+static uint32_t active_sector = 0;
+static uint32_t next_page = FIRST_DATA_PAGE;    // In the active sector
+static bool log_ready = false;
+static os_mutex_handle_t log_mutex = NULL;      // Flash changes vs. readers
+OS_MUTEX_DEFINE(log);
+
+// RAM page queue: filled by append(), drained by process()
+static log_page_t page_queue[SAMPLE_LOG_PAGE_BUFFERS];
+static uint32_t queue_head = 0;                 // Page being filled
+static uint32_t queue_tail = 0;                 // Oldest full page
+static volatile uint32_t queue_full_pages = 0;  // Appender and writer run in different tasks
+
+static sample_log_stats_t stats = {0};
+
+// ============================================================================
+// Private Functions
+// ============================================================================
+
+static inline uint32_t sector_address(uint32_t sector)
+{
+    return HAL_FLASH_DATA_BASE + sector * HAL_FLASH_DATA_SECTOR_SIZE;
+}
+
+static inline const log_page_t *flash_page(uint32_t sector, uint32_t page)
+{
+    return (const log_page_t *)(sector_address(sector) + page * SAMPLE_LOG_PAGE_SIZE);
+}
+
+static inline bool page_blank(uint32_t sector, uint32_t page)
+{
+    return *(const volatile uint32_t *)flash_page(sector, page) == HAL_FLASH_ERASED_WORD;
+}
+
+static bool page_valid(const log_page_t *page)
+{
+    if (page->sample_count == 0 || page->sample_count > SAMPLE_LOG_SAMPLES_PER_PAGE) {
+        return false;
+    }
+    uint16_t crc = crc16_ccitt_bytewise(CRC16_CCITT_INIT, (const uint8_t *)page->samples,
+                                        page->sample_count * sizeof(sensor_sample_t));
+    return crc == page->crc;
+}
+
+// Pages in use in a sector: pages are written in order, so they end at the
+// first blank one (a page torn by a reset is not blank)
+static uint32_t scan_pages_used(uint32_t sector)
+{
+    uint32_t lo = FIRST_DATA_PAGE;
+    uint32_t hi = PAGES_PER_SECTOR;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (page_blank(sector, mid)) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+static uint32_t sector_pages_used(uint32_t sector)
+{
+    return (log_ready && sector == active_sector) ? next_page : scan_pages_used(sector);
+}
+
+static void index_sector(uint32_t sector)
+{
+    const log_sector_header_t *header = (const log_sector_header_t *)sector_address(sector);
+    sectors[sector].sequence = (header->magic == SAMPLE_LOG_MAGIC) ? header->sequence : 0;
+    sectors[sector].first_timestamp = 0;
+
+    uint32_t used = sector_pages_used(sector);
+    for (uint32_t page = FIRST_DATA_PAGE; page < used; page++) {
+        const log_page_t *p = flash_page(sector, page);
+        if (page_valid(p)) {
+            sectors[sector].first_timestamp = p->samples[0].timestamp;
+            break;
+        }
+    }
+}
+
+// Sector holding the oldest data, 0xFF if the log is empty
+static uint32_t oldest_sector(void)
+{
+    uint32_t oldest = 0xFF;
+    for (uint32_t i = 0; i < LOG_SECTOR_COUNT; i++) {
+        if (sectors[i].sequence != 0 &&
+            (oldest == 0xFF || sectors[i].sequence < sectors[oldest].sequence)) {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+static int32_t sector_by_sequence(uint32_t sequence)
+{
+    for (uint32_t i = 0; i < LOG_SECTOR_COUNT; i++) {
+        if (sequence != 0 && sectors[i].sequence == sequence) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+// Erase a sector and make it the active one
+static bool start_sector(uint32_t sector, uint32_t sequence)
+{
+    log_sector_header_t header = {
+        .magic = SAMPLE_LOG_MAGIC,
+        .sequence = sequence,
+    };
+
+    sectors[sector].sequence = 0;
+    stats.sector_erases++;
+
+    if (!hal_flash_erase_data_sector(sector) ||
+        !hal_flash_program(sector_address(sector), &header, sizeof(header))) {
+        LOG_E(TAG, "Sector %lu erase failed", (unsigned long)sector);
+        return false;
+    }
+
+    sectors[sector].sequence = sequence;
+    sectors[sector].first_timestamp = 0;
+    active_sector = sector;
+    next_page = FIRST_DATA_PAGE;
+    return true;
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+bool sample_log_init(void)
+{
+    if (log_mutex == NULL) {
+        log_mutex = OS_MUTEX_CREATE_STATIC(log);
+        if (log_mutex == NULL) {
+            return false;
+        }
+    }
+
+    log_ready = false;
+    for (uint32_t i = 0; i < LOG_SECTOR_COUNT; i++) {
+        index_sector(i);
+    }
+
+    uint32_t newest = 0xFF;
+    for (uint32_t i = 0; i < LOG_SECTOR_COUNT; i++) {
+        if (sectors[i].sequence != 0 &&
+            (newest == 0xFF || sectors[i].sequence > sectors[newest].sequence)) {
+            newest = i;
+        }
+    }
+
+    if (newest == 0xFF) {
+        // First use: nothing to recover
+        LOG_I(TAG, "Formatting log area");
+        log_ready = start_sector(0, 1);
+        return log_ready;
+    }
+
+    active_sector = newest;
+    next_page = scan_pages_used(newest);
+
+    log_ready = true;
+    LOG_I(TAG, "Recovered: sector %lu seq %lu page %lu",
+          (unsigned long)active_sector, (unsigned long)sectors[active_sector].sequence,
+          (unsigned long)next_page);
+    return true;
+}
+
+bool sample_log_append(const sensor_sample_t *sample)
+{
+    if (!log_ready || sample == NULL) {
+        return false;
+    }
+
+    if (queue_full_pages >= SAMPLE_LOG_PAGE_BUFFERS) {
+        stats.samples_dropped++;
+        return false;
+    }
+
+    log_page_t *page = &page_queue[queue_head];
+    page->samples[page->sample_count++] = *sample;
+
+    if (page->sample_count == SAMPLE_LOG_SAMPLES_PER_PAGE) {
+        sample_log_flush();
+    }
+    return true;
+}
+
+void sample_log_flush(void)
+{
+    if (queue_full_pages >= SAMPLE_LOG_PAGE_BUFFERS || page_queue[queue_head].sample_count == 0) {
+        return;
+    }
+
+    queue_head = (queue_head + 1) % SAMPLE_LOG_PAGE_BUFFERS;
+    uint32_t mask = os_critical_enter();
+    queue_full_pages++;
+    os_critical_exit(mask);
+
+    // Write it from the housekeeping loop now rather than at the next period
+    os_sched_post(SERVICES_JOB_SAMPLE_LOG);
+}
+
+void sample_log_process(void)
+{
+    if (!log_ready || queue_full_pages == 0) {
+        return;
+    }
+
+    if (next_page >= PAGES_PER_SECTOR) {
+        // Rotate onto the oldest sector; the erase stalls flash reads for
+        // seconds, so not while a current measurement is sampling
+        if (current_monitor_get_status() == MEASUREMENT_RUNNING) {
+            stats.deferred_erases++;
+            return;
+        }
+
+        uint32_t next = (active_sector + 1) % LOG_SECTOR_COUNT;
+        uint32_t sequence = sectors[active_sector].sequence + 1;
+
+        os_mutex_take(log_mutex, OS_WAIT_FOREVER);
+        bool ok = start_sector(next, sequence);
+        os_mutex_give(log_mutex);
+
+        if (!ok) {
+            return;
+        }
+    }
+
+    log_page_t *page = &page_queue[queue_tail];
+    page->crc = crc16_ccitt_bytewise(CRC16_CCITT_INIT, (const uint8_t *)page->samples,
+                                     page->sample_count * sizeof(sensor_sample_t));
+
+    uint32_t address = (uint32_t)(uintptr_t)flash_page(active_sector, next_page);
+
+    os_mutex_take(log_mutex, OS_WAIT_FOREVER);
+    bool ok = hal_flash_program(address, page, LOG_PAGE_PROGRAM_SIZE);
+    if (next_page == FIRST_DATA_PAGE) {
+        sectors[active_sector].first_timestamp = page->samples[0].timestamp;
+    }
+    next_page++;    // A failed page is skipped; its CRC will not match
+    os_mutex_give(log_mutex);
+
+    if (ok) {
+        stats.pages_written++;
+        stats.samples_written += page->sample_count;
+    } else {
+        stats.page_errors++;
+    }
+
+    page->sample_count = 0;
+    queue_tail = (queue_tail + 1) % SAMPLE_LOG_PAGE_BUFFERS;
+    uint32_t mask = os_critical_enter();
+    queue_full_pages--;
+    os_critical_exit(mask);
+}
+
+void sample_log_seek(uint32_t from_timestamp, sample_log_cursor_t *cursor)
+{
+    if (cursor == NULL) {
+        return;
+    }
+
+    cursor->sequence = 0;
+    cursor->page = FIRST_DATA_PAGE;
+    cursor->sample = 0;
+    cursor->min_timestamp = from_timestamp;
+
+    if (!log_ready) {
+        return;
+    }
+
+    os_mutex_take(log_mutex, OS_WAIT_FOREVER);
+
+    // Newest sector that starts at or before the timestamp
+    uint32_t first = oldest_sector();
+    uint32_t sector = first;
+    for (uint32_t k = 1; first != 0xFF && k < LOG_SECTOR_COUNT; k++) {
+        uint32_t candidate = (first + k) % LOG_SECTOR_COUNT;
+        if (sectors[candidate].sequence == 0 || sector_pages_used(candidate) <= FIRST_DATA_PAGE ||
+            sectors[candidate].first_timestamp > from_timestamp) {
+            break;
+        }
+        sector = candidate;
+    }
+
+    if (sector != 0xFF) {
+        // Last page in the sector starting at or before the timestamp
+        uint32_t lo = FIRST_DATA_PAGE;
+        uint32_t hi = sector_pages_used(sector);
+        while (hi - lo > 1) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (flash_page(sector, mid)->samples[0].timestamp <= from_timestamp) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        cursor->sequence = sectors[sector].sequence;
+        cursor->page = (uint16_t)lo;
+    }
+
+    os_mutex_give(log_mutex);
+}
+
+uint32_t sample_log_read(sample_log_cursor_t *cursor, sensor_sample_t *samples, uint32_t max_samples)
+{
+    if (!log_ready || cursor == NULL || samples == NULL) {
+        return 0;
+    }
+
+    uint32_t n = 0;
+
+    os_mutex_take(log_mutex, OS_WAIT_FOREVER);
+
+    int32_t sector = sector_by_sequence(cursor->sequence);
+    if (sector < 0) {
+        // Not started, or erased under the cursor: restart at the oldest
+        uint32_t oldest = oldest_sector();
+        if (oldest == 0xFF) {
+            os_mutex_give(log_mutex);
+            return 0;
+        }
+        sector = (int32_t)oldest;
+        cursor->sequence = sectors[oldest].sequence;
+        cursor->page = FIRST_DATA_PAGE;
+        cursor->sample = 0;
+    }
+
+    while (n < max_samples) {
+        uint32_t used = sector_pages_used((uint32_t)sector);
+
+        if (cursor->page >= used) {
+            // End of this sector: on to the next one in the log, if any
+            int32_t next = sector_by_sequence(cursor->sequence + 1);
+            if (next < 0 || (uint32_t)sector == active_sector) {
+                break;
+            }
+            sector = next;
+            cursor->sequence++;
+            cursor->page = FIRST_DATA_PAGE;
+            cursor->sample = 0;
+            continue;
+        }
+
+        const log_page_t *page = flash_page((uint32_t)sector, cursor->page);
+        if (!page_valid(page)) {
+            cursor->page++;
+            cursor->sample = 0;
+            continue;
+        }
+
+        while (cursor->sample < page->sample_count && n < max_samples) {
+            const sensor_sample_t *sample = &page->samples[cursor->sample++];
+            if (sample->timestamp >= cursor->min_timestamp) {
+                samples[n++] = *sample;
+            }
+        }
+
+        if (cursor->sample >= page->sample_count) {
+            cursor->page++;
+            cursor->sample = 0;
+        }
+    }
+
+    os_mutex_give(log_mutex);
+
+    // Everything from here on is newer
+    if (n > 0) {
+        cursor->min_timestamp = 0;
+    }
+
+    return n;
+}
+
+void sample_log_get_stats(sample_log_stats_t *stats_out)
+{
+    if (stats_out != NULL) {
+        *stats_out = stats;
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file serv_sample_log.h
+ * @brief Persistent, append-only sample log in internal flash
+ *
+ * Samples are collected in RAM pages and written a whole page at a time
+ * into the reserved flash area (hal_flash.h), filling one sector after the
+ * other. The log gets the sectors the config store does not use: sectors
+ * 8-9, 512 KB. When the last free page is used the oldest sector is erased
+ * and becomes the new head, so wear is spread evenly over both sectors and
+ * the log always holds the most recent one to two sectors of data.
+ *
+ * Sector layout: a header page (magic + sequence number, written after the
+ * erase) followed by data pages of SAMPLE_LOG_SAMPLES_PER_PAGE samples, each
+ * with its own CRC so a page torn by a reset is skipped. At boot the log
+ * is recovered by reading the sector headers and binary searching the
+ * active sector for its first blank page; a RAM index of each sector's
+ * first timestamp makes seeks a binary search as well.
+ *
+ * Flash work happens only in sample_log_process(): at most one page program
+ * (~1.3 ms of short stalls) per call, and sector erases (~1-2 s stall) are
+ * deferred while a current measurement is running, with up to
+ * SAMPLE_LOG_PAGE_BUFFERS pages queued in RAM meanwhile.
+ *
+ * Seeking assumes timestamps do not decrease along the log, i.e. RTC
+ * (Unix) timestamps; samples logged before the RTC was set carry
+ * ms-since-boot and are only reachable by reading from the oldest.
+ *
+ * Usage example:
+ * @code
+ * sample_log_cursor_t cursor;
+ * sample_log_seek(since, &cursor);
+ * uint32_t n;
+ * while ((n = sample_log_read(&cursor, samples, 16)) > 0) {
+ *     // ...
+ * }
+ * @endcode
+ */
+
+#ifndef SERV_SAMPLE_LOG_H
+#define SERV_SAMPLE_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "protocol_common.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define SAMPLE_LOG_PAGE_SIZE            256     // Bytes per flash page slot
+#define SAMPLE_LOG_SAMPLES_PER_PAGE     27      // Fits with the page header
+#define SAMPLE_LOG_PAGE_BUFFERS         4       // RAM pages queued for programming
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Read position in the log
+ */
+typedef struct {
+    uint32_t sequence;          /**< Sequence of the sector being read (0 = start at oldest) */
+    uint16_t page;              /**< Page within the sector */
+    uint16_t sample;            /**< Sample within the page */
+    uint32_t min_timestamp;     /**< Samples older than this are skipped */
+} sample_log_cursor_t;
+
+/**
+ * @brief Log statistics
+ */
+typedef struct {
+    uint32_t pages_written;
+    uint32_t page_errors;       /**< Page programs that failed */
+    uint32_t sector_erases;
+    uint32_t samples_dropped;   /**< Lost because the RAM queue was full */
+    uint32_t samples_written;   /**< Samples programmed since boot */
+    uint32_t deferred_erases;   /**< process() calls that postponed an erase */
+} sample_log_stats_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Recover the log from flash (erases the area on first use)
+ * @return true if the log is usable
+ */
+bool sample_log_init(void);
+
+/**
+ * @brief Queue a sample for the log (RAM only, never touches flash)
+ *
+ * @param sample Sample to log
+ * @return false if the log is not usable or the queue is full (sample dropped)
+ */
+bool sample_log_append(const sensor_sample_t *sample);
+
+/**
+ * @brief Write queued pages and rotate sectors (call from the service loop)
+ */
+void sample_log_process(void);
+
+/**
+ * @brief Queue the partially filled page for writing
+ *
+ * Use before a planned reset; every flush costs a page.
+ */
+void sample_log_flush(void);
+
+/**
+ * @brief Position a cursor at the first logged sample at or after a timestamp
+ *
+ * @param from_timestamp Timestamp to seek to (0 = oldest sample)
+ * @param cursor Output cursor
+ */
+void sample_log_seek(uint32_t from_timestamp, sample_log_cursor_t *cursor);
+
+/**
+ * @brief Read samples from flash and advance the cursor
+ *
+ * If the sector the cursor is in has been erased meanwhile, reading
+ * continues from the oldest sample still logged.
+ *
+ * @param cursor Cursor from sample_log_seek()
+ * @param samples Output buffer
+ * @param max_samples Maximum samples to read
+ * @return Number of samples read (0 = end of log)
+ */
+uint32_t sample_log_read(sample_log_cursor_t *cursor, sensor_sample_t *samples, uint32_t max_samples);
+
+/**
+ * @brief Get log statistics
+ */
+void sample_log_get_stats(sample_log_stats_t *stats);
+
+#endif // SERV_SAMPLE_LOG_H
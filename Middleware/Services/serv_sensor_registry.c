@@ -0,0 +1,313 @@
+/**
+ * @file serv_sensor_registry.c
+ * @brief Registry of additional INA226 rail monitors
+ */
+
+#include "serv_sensor_registry.h"
+#include "hal_delay.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#define SENSOR_REGISTRY_RING_MASK   (SENSOR_REGISTRY_RING_SIZE - 1)
+#define SENSOR_REGISTRY_MAX_BUSES   2
+#define SENSOR_REGISTRY_NO_CHANNEL  0xFF
+
+// ============================================================================
+// Private Types and Data
+// ============================================================================
+
+typedef struct {
+    const char *name;
+    uint8_t bus;                                // Index into bus_handles
+    uint16_t period_ms;
+    uint32_t next_due_tick;
+    // Capture ring (lock-free SPSC: the I2C completion interrupt owns head,
+    // sensor_registry_read() owns tail; full drops the new sample)
+    sensor_registry_sample_t ring[SENSOR_REGISTRY_RING_SIZE];
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    sensor_registry_sample_t latest;
+    volatile bool has_latest;
+    sensor_registry_channel_stats_t stats;
+} registry_channel_t;
+
+// Kept apart from the channels so the data callback maps a sensor back to
+// its channel by index
+static ina226_sensor_t channel_sensors[SENSOR_REGISTRY_MAX_CHANNELS];
+static registry_channel_t channels[SENSOR_REGISTRY_MAX_CHANNELS];
+static volatile uint32_t channel_count = 0;
+
+// Scheduler state per bus: one read in flight, round-robin over its channels
+static hal_i2c_handle_t bus_handles[SENSOR_REGISTRY_MAX_BUSES];
+static uint32_t bus_count = 0;
+static volatile uint8_t bus_in_flight[SENSOR_REGISTRY_MAX_BUSES];
+static uint8_t bus_next[SENSOR_REGISTRY_MAX_BUSES];
+
+// ============================================================================
+// Private Functions
+// ============================================================================
+
+static bool channel_valid(int channel)
+{
+    return channel >= 0 && (uint32_t)channel < channel_count;
+}
+
+static int find_or_add_bus(hal_i2c_handle_t hi2c)
+{
+    for (uint32_t i = 0; i < bus_count; i++) {
+        if (bus_handles[i] == hi2c) {
+            return (int)i;
+        }
+    }
+    if (bus_count >= SENSOR_REGISTRY_MAX_BUSES) {
+        return -1;
+    }
+    bus_handles[bus_count] = hi2c;
+    bus_in_flight[bus_count] = SENSOR_REGISTRY_NO_CHANNEL;
+    bus_next[bus_count] = 0;
+    return (int)bus_count++;
+}
+
+// Spread the first due ticks of a bus's channels over their period
+static void stagger_bus(uint8_t bus)
+{
+    uint32_t now = hal_get_tick();
+    uint32_t on_bus = 0;
+
+    for (uint32_t i = 0; i < channel_count; i++) {
+        if (channels[i].bus == bus) {
+            on_bus++;
+        }
+    }
+
+    uint32_t slot = 0;
+    for (uint32_t i = 0; i < channel_count; i++) {
+        if (channels[i].bus == bus) {
+            channels[i].next_due_tick = now + (channels[i].period_ms * slot) / on_bus;
+            slot++;
+        }
+    }
+}
+
+// Start the next due channel on a bus if nothing is in flight there.
+// Runs from the service loop and from the I2C completion interrupt.
+static void schedule_bus(uint8_t bus)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint8_t current = bus_in_flight[bus];
+    if (current != SENSOR_REGISTRY_NO_CHANNEL && ina226_read_pending(&channel_sensors[current])) {
+        __set_PRIMASK(primask);
+        return;
+    }
+    bus_in_flight[bus] = SENSOR_REGISTRY_NO_CHANNEL;
+
+    uint32_t count = channel_count;
+    uint32_t now = hal_get_tick();
+
+    for (uint32_t k = 0; k < count; k++) {
+        uint32_t i = (bus_next[bus] + k) % count;
+        registry_channel_t *ch = &channels[i];
+
+        if (ch->bus != bus) {
+            continue;
+        }
+        int32_t late = (int32_t)(now - ch->next_due_tick);
+        if (late < 0) {
+            continue;
+        }
+
+        // Keep the period grid; periods the bus was too busy for are skipped
+        uint32_t skipped = (uint32_t)late / ch->period_ms;
+        ch->stats.missed_periods += skipped;
+        ch->next_due_tick += (skipped + 1) * ch->period_ms;
+
+        if (ina226_read_async(&channel_sensors[i]) == HAL_I2C_OK) {
+            bus_in_flight[bus] = (uint8_t)i;
+            bus_next[bus] = (uint8_t)((i + 1) % count);
+            break;
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+// ISR context (I2C completion)
+static void registry_data_callback(ina226_sensor_t *sensor, INA226_Data *data)
+{
+    uint32_t index = (uint32_t)(sensor - channel_sensors);
+    if (index >= SENSOR_REGISTRY_MAX_CHANNELS) {
+        return;
+    }
+    registry_channel_t *ch = &channels[index];
+
+    sensor_registry_sample_t sample = {
+        .tick = hal_get_tick(),
+        .current_raw = data->current_raw,
+        .bus_voltage_raw = data->bus_voltage_raw,
+    };
+    ch->latest = sample;
+    ch->has_latest = true;
+    ch->stats.samples_captured++;
+
+    uint32_t head = ch->head;
+    if (head - ch->tail >= SENSOR_REGISTRY_RING_SIZE) {
+        ch->stats.ring_overruns++;
+    } else {
+        ch->ring[head & SENSOR_REGISTRY_RING_MASK] = sample;
+        __DMB();  // Sample visible before the index that publishes it
+        ch->head = head + 1;
+    }
+
+    // Keep the bus busy with the next due channel
+    schedule_bus(ch->bus);
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+void sensor_registry_init(void)
+{
+    sensor_registry_clear();
+}
+
+int sensor_registry_add_ina226(const sensor_registry_channel_config_t *config)
+{
+    if (config == NULL || config->hi2c == NULL || config->period_ms == 0) {
+        return -1;
+    }
+    if (channel_count >= SENSOR_REGISTRY_MAX_CHANNELS) {
+        return -1;
+    }
+
+    int bus = find_or_add_bus(config->hi2c);
+    if (bus < 0) {
+        return -1;
+    }
+
+    uint32_t index = channel_count;
+    ina226_sensor_t *sensor = &channel_sensors[index];
+    registry_channel_t *ch = &channels[index];
+
+    ina226_sensor_init(sensor, config->i2c_address, NULL, 0);
+
+    ina226_config_t ina_config = {
+        .averaging = INA226_CONFIG_AVG_16,
+        .bus_conv_time = INA226_CONFIG_VBUSCT_1100US,
+        .shunt_conv_time = INA226_CONFIG_VSHCT_1100US,
+        .mode = INA226_CONFIG_MODE_SHUNT_BUS_CONT,
+        .read_fields = INA226_READ_BUS | INA226_READ_CURRENT,
+    };
+    if (ina226_open(sensor, config->hi2c, config->shunt_resistor_ohms,
+                    registry_data_callback, &ina_config) != HAL_I2C_OK) {
+        return -1;
+    }
+
+    memset(ch, 0, sizeof(*ch));
+    ch->name = config->name;
+    ch->bus = (uint8_t)bus;
+    ch->period_ms = config->period_ms;
+
+    channel_count = index + 1;
+    stagger_bus((uint8_t)bus);
+
+    return (int)index;
+}
+
+void sensor_registry_clear(void)
+{
+    uint32_t count = channel_count;
+
+    // Stop scheduling first so completions do not start new reads
+    channel_count = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t start = hal_get_tick();
+        while (ina226_read_pending(&channel_sensors[i]) &&
+               (hal_get_tick() - start) < INA226_I2C_TIMEOUT_MS) {
+        }
+        ina226_close(&channel_sensors[i]);
+    }
+
+    bus_count = 0;
+}
+
+uint32_t sensor_registry_get_channel_count(void)
+{
+    return channel_count;
+}
+
+const char *sensor_registry_get_name(int channel)
+{
+    return channel_valid(channel) ? channels[channel].name : NULL;
+}
+
+void sensor_registry_process(void)
+{
+    for (uint32_t bus = 0; bus < bus_count; bus++) {
+        schedule_bus((uint8_t)bus);
+    }
+}
+
+uint32_t sensor_registry_read(int channel, sensor_registry_sample_t *samples, uint32_t max_samples)
+{
+    if (!channel_valid(channel) || samples == NULL) {
+        return 0;
+    }
+    registry_channel_t *ch = &channels[channel];
+
+    uint32_t tail = ch->tail;
+    uint32_t available = ch->head - tail;
+    __DMB();  // Index read before the samples it covers
+    uint32_t n = (available < max_samples) ? available : max_samples;
+
+    for (uint32_t i = 0; i < n; i++) {
+        samples[i] = ch->ring[(tail + i) & SENSOR_REGISTRY_RING_MASK];
+    }
+    __DMB();  // Samples copied before the slots are released
+    ch->tail = tail + n;
+
+    return n;
+}
+
+bool sensor_registry_get_latest(int channel, INA226_Data *data)
+{
+    if (!channel_valid(channel) || data == NULL || !channels[channel].has_latest) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    sensor_registry_sample_t sample = channels[channel].latest;
+    __set_PRIMASK(primask);
+
+    sensor_registry_decode(channel, &sample, data);
+    return true;
+}
+
+void sensor_registry_decode(int channel, const sensor_registry_sample_t *sample, INA226_Data *data)
+{
+    if (!channel_valid(channel) || sample == NULL || data == NULL) {
+        return;
+    }
+    float current_lsb_mA = channel_sensors[channel].current_lsb * 1000.0f;
+
+    data->current_raw = sample->current_raw;
+    data->bus_voltage_raw = sample->bus_voltage_raw;
+    data->current_mA = (float)sample->current_raw * current_lsb_mA;
+    data->voltage_V = (float)sample->bus_voltage_raw * INA226_BUS_VOLTAGE_LSB_V;
+    data->power_mW = fabsf(data->current_mA) * data->voltage_V;
+}
+
+bool sensor_registry_get_stats(int channel, sensor_registry_channel_stats_t *stats)
+{
+    if (!channel_valid(channel) || stats == NULL) {
+        return false;
+    }
+    *stats = channels[channel].stats;
+    stats->read_errors = channel_sensors[channel].async_errors;
+    return true;
+}
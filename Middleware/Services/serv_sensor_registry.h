@@ -0,0 +1,157 @@
+/**
+ * @file serv_sensor_registry.h
+ * @brief Registry of additional INA226 rail monitors
+ *
+ * Holds up to SENSOR_REGISTRY_MAX_CHANNELS INA226 instances (e.g. one per
+ * supply rail), each with its own capture ring. A scheduler run from the
+ * service loop starts non-blocking reads on due channels, round-robin per
+ * I2C bus and one read in flight per bus, so transfers on the two buses
+ * overlap instead of serializing. Channels are staggered within their
+ * period so channels on the same bus do not all fall due in the same pass.
+ *
+ * These channels are separate from the current monitor's high-rate sensor
+ * (default_ina226_sensor); register devices at other addresses.
+ *
+ * Usage example:
+ * @code
+ * sensor_registry_channel_config_t rail = {
+ *     .name = "3V3",
+ *     .hi2c = BSP_Get_CurrentSensor_I2C(),
+ *     .i2c_address = (0x41 << 1),
+ *     .shunt_resistor_ohms = 0.01f,
+ *     .period_ms = 100,
+ * };
+ * int channel = sensor_registry_add_ina226(&rail);
+ *
+ * // Later, from the service loop
+ * sensor_registry_sample_t samples[16];
+ * uint32_t n = sensor_registry_read(channel, samples, 16);
+ * @endcode
+ */
+
+#ifndef SERV_SENSOR_REGISTRY_H
+#define SERV_SENSOR_REGISTRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ina226.h"
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define SENSOR_REGISTRY_MAX_CHANNELS    4
+#define SENSOR_REGISTRY_RING_SIZE       128     // Samples per channel (power of two)
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Channel configuration
+ */
+typedef struct {
+    const char *name;               /**< Rail name (not copied) */
+    hal_i2c_handle_t hi2c;          /**< Bus the device is on */
+    uint16_t i2c_address;           /**< 8-bit I2C address */
+    float shunt_resistor_ohms;      /**< Shunt value in ohms */
+    uint16_t period_ms;             /**< Sample period (rounded up to the service loop period) */
+} sensor_registry_channel_config_t;
+
+/**
+ * @brief Captured sample (raw registers, see sensor_registry_decode())
+ */
+typedef struct {
+    uint32_t tick;                  /**< Capture tick (ms since boot) */
+    int16_t current_raw;            /**< Current register */
+    uint16_t bus_voltage_raw;       /**< Bus voltage register */
+} sensor_registry_sample_t;
+
+/**
+ * @brief Per-channel statistics
+ */
+typedef struct {
+    uint32_t samples_captured;
+    uint32_t ring_overruns;         /**< Samples dropped because the ring was full */
+    uint32_t read_errors;           /**< Reads that failed to start or complete */
+    uint32_t missed_periods;        /**< Periods skipped because the bus was busy */
+} sensor_registry_channel_stats_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Initialize the registry (no channels)
+ */
+void sensor_registry_init(void);
+
+/**
+ * @brief Register and open an INA226 channel
+ *
+ * @param config Channel configuration
+ * @return Channel number, or -1 if the registry is full or the device does not respond
+ */
+int sensor_registry_add_ina226(const sensor_registry_channel_config_t *config);
+
+/**
+ * @brief Close all channels and empty the registry
+ */
+void sensor_registry_clear(void);
+
+/**
+ * @brief Number of registered channels
+ */
+uint32_t sensor_registry_get_channel_count(void);
+
+/**
+ * @brief Get a channel's name
+ *
+ * @param channel Channel number
+ * @return Name, or NULL for an unknown channel
+ */
+const char *sensor_registry_get_name(int channel);
+
+/**
+ * @brief Start reads on due channels (call from the service loop)
+ */
+void sensor_registry_process(void);
+
+/**
+ * @brief Read and remove the oldest captured samples of a channel
+ *
+ * @param channel Channel number
+ * @param samples Output buffer
+ * @param max_samples Maximum samples to read
+ * @return Number of samples read
+ */
+uint32_t sensor_registry_read(int channel, sensor_registry_sample_t *samples, uint32_t max_samples);
+
+/**
+ * @brief Get the most recent reading of a channel
+ *
+ * @param channel Channel number
+ * @param data Output, converted to engineering units
+ * @return false if the channel has no sample yet
+ */
+bool sensor_registry_get_latest(int channel, INA226_Data *data);
+
+/**
+ * @brief Convert a captured sample of a channel to engineering units
+ *
+ * @param channel Channel number
+ * @param sample Sample from sensor_registry_read()
+ * @param data Output
+ */
+void sensor_registry_decode(int channel, const sensor_registry_sample_t *sample, INA226_Data *data);
+
+/**
+ * @brief Get a channel's statistics
+ *
+ * @param channel Channel number
+ * @param stats Output
+ * @return false for an unknown channel
+ */
+bool sensor_registry_get_stats(int channel, sensor_registry_channel_stats_t *stats);
+
+#endif // SERV_SENSOR_REGISTRY_H
@@ -4,8 +4,14 @@
 #include "ath25.h"
 #include "bsp.h"
 #include "sensor_ring_buffer.h"
+#include "sensor_rollup.h"
+#include "swinging_door.h"
+#include "adaptive_rate.h"
+#include "serv_sample_log.h"
 #include "os_wrapper.h"
+#include "sysview_trace.h"
 #include "hal_rtc.h"
+#include "hal_timebase.h"
 
 // ============================================================================
 // Private Data
@@ -14,13 +20,58 @@
 static ath25_sensor_t* temp_sensor = &default_ath25_sensor;
 
 static uint32_t last_read_time = 0;
-static const uint32_t read_interval_ms = 1000; // read every second
+static volatile uint32_t read_interval_ms = TEMP_SENSOR_READ_INTERVAL_MS;
+
+#if TEMP_SENSOR_ADAPTIVE_RATE
+// One per channel, read together: the busier one sets the pace
+static const adaptive_rate_config_t temp_rate_config = {
+    .min_interval_ms = TEMP_SENSOR_ADAPTIVE_MIN_MS,
+    .max_interval_ms = TEMP_SENSOR_ADAPTIVE_MAX_MS,
+    .rate_threshold = 5,            // 0.05 C/s
+    .deviation_threshold = 20,      // 0.2 C
+    .quiet_steps = 5,
+};
+static const adaptive_rate_config_t humidity_rate_config = {
+    .min_interval_ms = TEMP_SENSOR_ADAPTIVE_MIN_MS,
+    .max_interval_ms = TEMP_SENSOR_ADAPTIVE_MAX_MS,
+    .rate_threshold = 50,           // 0.5 %RH/s
+    .deviation_threshold = 100,     // 1 %RH
+    .quiet_steps = 5,
+};
+static adaptive_rate_t temp_rate;
+static adaptive_rate_t humidity_rate;
+#endif
 
 // Buffer state
 static sensor_ring_buffer_t temp_buffer;
+static sensor_ring_buffer_record_t temp_storage[SENSOR_RING_BUFFER_DEFAULT_CAPACITY];
 static bool buffer_initialized = false;
+
+// Humidity channel, pushed with each temperature sample (same timestamps)
+static sensor_ring_buffer_t humidity_buffer;
+static sensor_ring_buffer_record_t humidity_storage[TEMP_SENSOR_HUMIDITY_CAPACITY];
+static bool humidity_initialized = false;
+
+#if TEMP_SENSOR_DOOR_ENABLE
+// Decides which samples the climate rings keep; reset on the next sample
+// after a clear (set from the protocol task)
+static swinging_door_t climate_door;
+static volatile bool climate_door_restart = false;
+#endif
+
+// Downsampled history fed from the same samples
+static sensor_rollup_t temp_history;
+static sensor_rollup_record_t history_minutes[TEMP_SENSOR_HISTORY_MINUTES];
+static sensor_rollup_record_t history_hours[TEMP_SENSOR_HISTORY_HOURS];
+static bool history_initialized = false;
+
+// Running statistics of the same samples, read from the protocol task
+static stream_stats_t temp_stats;
+static os_mutex_handle_t stats_mutex = NULL;
+OS_MUTEX_DEFINE(stats);
 static uint32_t last_buffer_store_time = 0;
 static float last_valid_temperature = 0.0f;
+static float last_valid_humidity = 0.0f;
 static bool has_valid_reading = false;
 static temp_sensor_timestamp_fn timestamp_fn = NULL;
 
@@ -33,14 +84,54 @@ static uint32_t get_timestamp(void)
     if (timestamp_fn != NULL) {
         return timestamp_fn();
     }
-    // Use RTC timestamp if valid, otherwise fall back to OS time
+    // Wall-clock time if the RTC was set, otherwise fall back to OS time.
+    // From the timebase anchor: reading the RTC itself takes a shadow
+    // register sync and a calendar conversion per sample
     if (hal_rtc_is_time_valid()) {
-        return hal_rtc_get_timestamp();
+        return (uint32_t)(hal_timebase_unix_us() / 1000000U);
     }
     return os_get_time_ms();
 }
 
-static void store_sample_to_buffer(float temperature)
+static uint32_t current_read_interval(void)
+{
+#if TEMP_SENSOR_ADAPTIVE_RATE
+    uint32_t interval = adaptive_rate_get_interval(&temp_rate);
+    uint32_t humidity_interval = adaptive_rate_get_interval(&humidity_rate);
+    if (humidity_interval < interval) {
+        interval = humidity_interval;
+    }
+    // Load shedding only ever slows the sensor down
+    uint32_t floor = read_interval_ms;
+    if (floor > TEMP_SENSOR_READ_INTERVAL_MS && floor > interval) {
+        interval = floor;
+    }
+    return interval;
+#else
+    return read_interval_ms;
+#endif
+}
+
+static void push_climate(uint32_t timestamp, int32_t temperature, int32_t humidity)
+{
+    sensor_sample_t sample = {
+        .sensor_type = SENSOR_TEMPERATURE,
+        .timestamp = timestamp,
+        .value = temperature
+    };
+    sensor_ring_buffer_push(&temp_buffer, &sample);
+
+    if (humidity_initialized) {
+        sensor_sample_t humidity_sample = {
+            .sensor_type = SENSOR_HUMIDITY,
+            .timestamp = timestamp,
+            .value = humidity
+        };
+        sensor_ring_buffer_push(&humidity_buffer, &humidity_sample);
+    }
+}
+
+static void store_sample_to_buffer(float temperature, float humidity)
 {
     if (!buffer_initialized) {
         return;
@@ -51,8 +142,35 @@ static void store_sample_to_buffer(float temperature)
         .timestamp = get_timestamp(),
         .value = (int32_t)(temperature * 100)  // Store as centi-degrees
     };
+    int32_t humidity_value = (int32_t)(humidity * 100);  // Centi-percent RH
 
-    sensor_ring_buffer_push(&temp_buffer, &sample);
+#if TEMP_SENSOR_DOOR_ENABLE
+    if (climate_door_restart) {
+        climate_door_restart = false;
+        swinging_door_reset(&climate_door);
+    }
+    const int32_t values[2] = { sample.value, humidity_value };
+    swinging_door_point_t kept[SWINGING_DOOR_MAX_OUT];
+    uint32_t kept_count = swinging_door_add(&climate_door, sample.timestamp, values, kept);
+    for (uint32_t i = 0; i < kept_count; i++) {
+        push_climate(kept[i].timestamp, kept[i].values[0], kept[i].values[1]);
+    }
+#else
+    push_climate(sample.timestamp, sample.value, humidity_value);
+#endif
+
+    if (history_initialized) {
+        sensor_rollup_add(&temp_history, &sample);
+    }
+
+    if (stats_mutex != NULL) {
+        os_mutex_take(stats_mutex, OS_WAIT_FOREVER);
+        stream_stats_add(&temp_stats, sample.value, sample.timestamp);
+        os_mutex_give(stats_mutex);
+    }
+
+    // Persisted in batches by sample_log_process()
+    sample_log_append(&sample);
 }
 
 // ============================================================================
@@ -70,49 +188,107 @@ void temperature_sensor_init(void)
     // Initialize buffer
     sensor_ring_buffer_config_t buf_config = sensor_ring_buffer_get_default_config();
     buf_config.sensor_type = SENSOR_TEMPERATURE;
+    // This service is the only producer and the protocol handler the only
+    // consumer, so pushes need no mutex
+    buf_config.mode = SENSOR_RING_BUFFER_MODE_SPSC;
 
-    if (sensor_ring_buffer_init(&temp_buffer, &buf_config) == SENSOR_RING_BUFFER_OK) {
+    if (sensor_ring_buffer_init_static(&temp_buffer, &buf_config, temp_storage,
+                                       SENSOR_RING_BUFFER_DEFAULT_CAPACITY) == SENSOR_RING_BUFFER_OK) {
         buffer_initialized = true;
     }
+
+    buf_config.sensor_type = SENSOR_HUMIDITY;
+    if (sensor_ring_buffer_init_static(&humidity_buffer, &buf_config, humidity_storage,
+                                       TEMP_SENSOR_HUMIDITY_CAPACITY) == SENSOR_RING_BUFFER_OK) {
+        humidity_initialized = true;
+    }
+
+    const uint32_t samples_per_minute = 60000 / TEMP_SENSOR_BUFFER_INTERVAL_MS;
+    const sensor_rollup_tier_config_t tiers[TEMP_SENSOR_HISTORY_TIERS] = {
+        { .records = history_minutes, .capacity = TEMP_SENSOR_HISTORY_MINUTES, .fan_in = samples_per_minute },
+        { .records = history_hours,   .capacity = TEMP_SENSOR_HISTORY_HOURS,   .fan_in = 60 },
+    };
+    if (sensor_rollup_init(&temp_history, tiers, TEMP_SENSOR_HISTORY_TIERS) == SENSOR_ROLLUP_OK) {
+        history_initialized = true;
+    }
+
+    const uint32_t stats_windows[TEMP_SENSOR_STATS_WINDOWS] = {
+        samples_per_minute, samples_per_minute * 60, 0
+    };
+    if (stats_mutex == NULL) {
+        stats_mutex = OS_MUTEX_CREATE_STATIC(stats);
+    }
+    stream_stats_init(&temp_stats, stats_windows, TEMP_SENSOR_STATS_WINDOWS);
+
+#if TEMP_SENSOR_ADAPTIVE_RATE
+    adaptive_rate_init(&temp_rate, &temp_rate_config);
+    adaptive_rate_init(&humidity_rate, &humidity_rate_config);
+#endif
+
+#if TEMP_SENSOR_DOOR_ENABLE
+    const int32_t deviations[2] = { TEMP_SENSOR_DOOR_TEMPERATURE, TEMP_SENSOR_DOOR_HUMIDITY };
+    swinging_door_init(&climate_door, deviations, 2, TEMP_SENSOR_DOOR_MAX_SKIP);
+#endif
 }
 
 void temperature_sensor_run(void)
 {
     uint32_t now = hal_get_tick();
 
-    // Read temperature sensor every second
-    if ((now - last_read_time) >= read_interval_ms)
+    // Read temperature sensor every read interval: trigger, then poll each pass
+    // until the conversion has been fetched (never waits in here)
+    if (!ath25_measurement_pending(temp_sensor) && (now - last_read_time) >= current_read_interval())
+    {
+        last_read_time = now;
+        if (ath25_start_measurement(temp_sensor) != HAL_I2C_OK) {
+            temperature_data_t temp_event_data = {0};
+            EVENT_PUBLISH(EVENT_SENSOR_ERROR, &temp_event_data);
+        }
+    }
+
+    if (ath25_measurement_pending(temp_sensor))
     {
         ath_data_t data;
         temperature_data_t temp_event_data;
+        SYSVIEW_MARK_START(SYSVIEW_MARKER_SENSOR_READ);
+        hal_i2c_status_t status = ath25_poll_measurement(temp_sensor, &data);
+        SYSVIEW_MARK_STOP(SYSVIEW_MARKER_SENSOR_READ);
 
-        if(ath25_read(temp_sensor, &data) == HAL_I2C_OK) {
+        if (status == HAL_I2C_BUSY) {
+            // Still converting
+        } else if (status == HAL_I2C_OK) {
             // Successfully read data, publish event
+            SYSVIEW_TRACE_U32(SYSVIEW_EVT_SENSOR_SAMPLE, SYSVIEW_SENSOR_AHT25);
             temp_event_data.temperature = data.temperature;
             temp_event_data.humidity = data.humidity;
             temp_event_data.sensor_ok = 1;
 
+#if TEMP_SENSOR_ADAPTIVE_RATE
+            adaptive_rate_update(&temp_rate, now, (int32_t)(data.temperature * 100));
+            adaptive_rate_update(&humidity_rate, now, (int32_t)(data.humidity * 100));
+#endif
+
             // Store for buffering
             last_valid_temperature = data.temperature;
+            last_valid_humidity = data.humidity;
             has_valid_reading = true;
 
             // Publish event to notify subscribers
-            event_bus_publish(EVENT_TEMPERATURE_UPDATED, &temp_event_data, sizeof(temperature_data_t));
+            EVENT_PUBLISH(EVENT_TEMPERATURE_UPDATED, &temp_event_data);
         } else {
             // Handle read error - publish error event
             temp_event_data.temperature = 0.0f;
             temp_event_data.humidity = 0.0f;
             temp_event_data.sensor_ok = 0;
 
-            event_bus_publish(EVENT_SENSOR_ERROR, &temp_event_data, sizeof(temperature_data_t));
+            EVENT_PUBLISH(EVENT_SENSOR_ERROR, &temp_event_data);
         }
-        last_read_time = now;
     }
 
     // Store to buffer every TEMP_SENSOR_BUFFER_INTERVAL_MS
     if (has_valid_reading && (now - last_buffer_store_time) >= TEMP_SENSOR_BUFFER_INTERVAL_MS)
     {
-        store_sample_to_buffer(last_valid_temperature);
+        store_sample_to_buffer(last_valid_temperature, last_valid_humidity);
         last_buffer_store_time = now;
     }
 }
@@ -145,8 +321,136 @@ bool temperature_sensor_buffer_read(
     return (status == SENSOR_RING_BUFFER_OK);
 }
 
+bool temperature_sensor_buffer_read_range(
+    uint32_t from_timestamp,
+    uint32_t to_timestamp,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read,
+    uint32_t *first_index)
+{
+    if (!buffer_initialized || samples == NULL || samples_read == NULL) {
+        return false;
+    }
+
+    sensor_ring_buffer_status_t status = sensor_ring_buffer_read_time_range(
+        &temp_buffer, from_timestamp, to_timestamp, samples, max_samples,
+        samples_read, first_index);
+
+    return (status == SENSOR_RING_BUFFER_OK);
+}
+
+uint32_t temperature_sensor_humidity_get_count(void)
+{
+    if (!humidity_initialized) {
+        return 0;
+    }
+    return sensor_ring_buffer_get_count(&humidity_buffer);
+}
+
+bool temperature_sensor_humidity_read(
+    uint32_t start_index,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read)
+{
+    if (!humidity_initialized || samples == NULL || samples_read == NULL) {
+        return false;
+    }
+
+    sensor_ring_buffer_status_t status = sensor_ring_buffer_read(
+        &humidity_buffer, start_index, samples, max_samples, samples_read);
+
+    return (status == SENSOR_RING_BUFFER_OK);
+}
+
+bool temperature_sensor_humidity_read_range(
+    uint32_t from_timestamp,
+    uint32_t to_timestamp,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read,
+    uint32_t *first_index)
+{
+    if (!humidity_initialized || samples == NULL || samples_read == NULL) {
+        return false;
+    }
+
+    sensor_ring_buffer_status_t status = sensor_ring_buffer_read_time_range(
+        &humidity_buffer, from_timestamp, to_timestamp, samples, max_samples,
+        samples_read, first_index);
+
+    return (status == SENSOR_RING_BUFFER_OK);
+}
+
+bool temperature_sensor_attach_cursor(
+    sensor_type_t channel,
+    sensor_ring_buffer_cursor_t *cursor,
+    const char *name,
+    bool from_oldest)
+{
+    sensor_ring_buffer_t *rb = NULL;
+
+    if (channel == SENSOR_TEMPERATURE && buffer_initialized) {
+        rb = &temp_buffer;
+    } else if (channel == SENSOR_HUMIDITY && humidity_initialized) {
+        rb = &humidity_buffer;
+    }
+    if (rb == NULL) {
+        return false;
+    }
+
+    return sensor_ring_buffer_cursor_attach(rb, cursor, name, from_oldest) == SENSOR_RING_BUFFER_OK;
+}
+
+bool temperature_sensor_history_read(
+    uint32_t tier,
+    uint32_t from_timestamp,
+    sensor_rollup_record_t *records,
+    uint32_t max_records,
+    uint32_t *records_read,
+    uint32_t *first_index)
+{
+    if (!history_initialized || records == NULL || records_read == NULL) {
+        return false;
+    }
+
+    sensor_rollup_status_t status = sensor_rollup_read(
+        &temp_history, tier, from_timestamp, records, max_records, records_read, first_index);
+
+    return (status == SENSOR_ROLLUP_OK);
+}
+
+bool temperature_sensor_stats_get(uint32_t window, stream_stats_summary_t *summary)
+{
+    if (stats_mutex == NULL || summary == NULL) {
+        return false;
+    }
+
+    os_mutex_take(stats_mutex, OS_WAIT_FOREVER);
+    stream_stats_status_t status = stream_stats_get_summary(&temp_stats, window, summary);
+    os_mutex_give(stats_mutex);
+
+    return (status == STREAM_STATS_OK);
+}
+
 void temperature_sensor_buffer_clear(void)
 {
+#if TEMP_SENSOR_DOOR_ENABLE
+    // The first sample after the clear has to be kept as the new pivot
+    climate_door_restart = true;
+#endif
+    if (history_initialized) {
+        sensor_rollup_clear(&temp_history);
+    }
+    if (stats_mutex != NULL) {
+        os_mutex_take(stats_mutex, OS_WAIT_FOREVER);
+        stream_stats_reset(&temp_stats);
+        os_mutex_give(stats_mutex);
+    }
+    if (humidity_initialized) {
+        sensor_ring_buffer_clear(&humidity_buffer);
+    }
     if (!buffer_initialized) {
         return;
     }
@@ -157,3 +461,13 @@ void temperature_sensor_set_timestamp_fn(temp_sensor_timestamp_fn get_timestamp)
 {
     timestamp_fn = get_timestamp;
 }
+
+void temperature_sensor_set_read_interval(uint32_t interval_ms)
+{
+    read_interval_ms = (interval_ms != 0) ? interval_ms : TEMP_SENSOR_READ_INTERVAL_MS;
+}
+
+uint32_t temperature_sensor_get_read_interval(void)
+{
+    return current_read_interval();
+}
@@ -4,16 +4,83 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "protocol_common.h"
+#include "stream_stats.h"
+#include "sensor_ring_buffer.h"
 
 // ============================================================================
 // Configuration
 // ============================================================================
 
+/**
+ * @brief Default interval between sensor reads (load shedding stretches it)
+ */
+#define TEMP_SENSOR_READ_INTERVAL_MS      1000
+
 /**
  * @brief Default interval for storing samples to buffer (10 seconds)
  */
 #define TEMP_SENSOR_BUFFER_INTERVAL_MS    10000
 
+/**
+ * @brief Humidity channel capacity (samples)
+ *
+ * Pushed alongside each buffered temperature sample with the same
+ * timestamp. The temperature ring's capacity
+ * (SENSOR_RING_BUFFER_DEFAULT_CAPACITY) keeps the two index-aligned.
+ */
+#define TEMP_SENSOR_HUMIDITY_CAPACITY     512
+
+/**
+ * @brief Downsampled history tiers (see sensor_rollup.h)
+ *
+ * Tier 0: 1 min min/max/mean (6 buffered samples), ~4 hours
+ * Tier 1: 1 hour min/max/mean (60 tier-0 records), 7 days
+ */
+#define TEMP_SENSOR_HISTORY_TIERS         2
+#define TEMP_SENSOR_HISTORY_MINUTES       256
+#define TEMP_SENSOR_HISTORY_HOURS         168
+
+/**
+ * @brief Running statistics windows over the buffered samples (see stream_stats.h)
+ *
+ * Window 0: last complete minute, 1: last complete hour, 2: since boot or clear
+ */
+#define TEMP_SENSOR_STATS_WINDOWS         3
+
+/**
+ * @brief Swinging-door compression of the climate rings (see swinging_door.h)
+ *
+ * With TEMP_SENSOR_DOOR_ENABLE the temperature and humidity rings keep only
+ * the points that linear interpolation needs to reproduce every buffered
+ * sample within these deviations; both rings keep the same points, so
+ * they stay index-aligned. The history, statistics and sample log still
+ * get every sample. HELLO announces it as PROTOCOL_FEATURE_SWINGING_DOOR.
+ * The newest ring sample can trail the sensor by up to MAX_SKIP buffered
+ * samples (10 minutes).
+ */
+#ifndef TEMP_SENSOR_DOOR_ENABLE
+#define TEMP_SENSOR_DOOR_ENABLE           0
+#endif
+#define TEMP_SENSOR_DOOR_TEMPERATURE      10    // Centi-degrees
+#define TEMP_SENSOR_DOOR_HUMIDITY         50    // Centi-percent RH
+#define TEMP_SENSOR_DOOR_MAX_SKIP         59
+
+/**
+ * @brief Adaptive read interval (see adaptive_rate.h)
+ *
+ * With TEMP_SENSOR_ADAPTIVE_RATE the sensor is read every
+ * TEMP_SENSOR_ADAPTIVE_MIN_MS while temperature or humidity moves, and the
+ * interval doubles towards TEMP_SENSOR_ADAPTIVE_MAX_MS (the buffer interval,
+ * so buffered samples stay fresh) while both are steady. Without it reads
+ * come every TEMP_SENSOR_READ_INTERVAL_MS. A longer interval set by
+ * temperature_sensor_set_read_interval() (load shedding) is the floor.
+ */
+#ifndef TEMP_SENSOR_ADAPTIVE_RATE
+#define TEMP_SENSOR_ADAPTIVE_RATE         0
+#endif
+#define TEMP_SENSOR_ADAPTIVE_MIN_MS       TEMP_SENSOR_READ_INTERVAL_MS  // Faster heats the AHT25 itself
+#define TEMP_SENSOR_ADAPTIVE_MAX_MS       TEMP_SENSOR_BUFFER_INTERVAL_MS
+
 // ============================================================================
 // Types
 // ============================================================================
@@ -73,7 +140,106 @@ bool temperature_sensor_buffer_read(
     uint32_t *samples_read);
 
 /**
- * @brief Clear all buffered temperature samples
+ * @brief Read buffered temperature samples by time
+ *
+ * Reads samples with from_timestamp <= timestamp < to_timestamp, oldest
+ * first. Does not remove samples.
+ *
+ * @param from_timestamp First timestamp included
+ * @param to_timestamp First timestamp excluded (UINT32_MAX for no limit)
+ * @param samples Output buffer for samples
+ * @param max_samples Maximum samples to read
+ * @param samples_read Output: actual number read
+ * @param first_index Output: buffer index of samples[0] (0 = oldest)
+ * @return true on success, false on error or no matching sample
+ */
+bool temperature_sensor_buffer_read_range(
+    uint32_t from_timestamp,
+    uint32_t to_timestamp,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read,
+    uint32_t *first_index);
+
+/**
+ * @brief Get number of buffered humidity samples
+ */
+uint32_t temperature_sensor_humidity_get_count(void);
+
+/**
+ * @brief Read humidity samples (centi-percent RH) from buffer
+ *
+ * Same as temperature_sensor_buffer_read() for the humidity channel.
+ */
+bool temperature_sensor_humidity_read(
+    uint32_t start_index,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read);
+
+/**
+ * @brief Read buffered humidity samples by time
+ *
+ * Same as temperature_sensor_buffer_read_range() for the humidity channel.
+ */
+bool temperature_sensor_humidity_read_range(
+    uint32_t from_timestamp,
+    uint32_t to_timestamp,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read,
+    uint32_t *first_index);
+
+/**
+ * @brief Attach a consumer cursor to the temperature or humidity buffer
+ *
+ * The consumer then drains new samples with sensor_ring_buffer_cursor_read(),
+ * at its own pace and with its own overrun count.
+ *
+ * @param channel SENSOR_TEMPERATURE or SENSOR_HUMIDITY
+ * @param cursor Caller-provided cursor
+ * @param name Consumer name, for diagnostics
+ * @param from_oldest true to start at the oldest buffered sample
+ * @return false if the channel is not buffered or the cursor is attached
+ */
+bool temperature_sensor_attach_cursor(
+    sensor_type_t channel,
+    sensor_ring_buffer_cursor_t *cursor,
+    const char *name,
+    bool from_oldest);
+
+/**
+ * @brief Read downsampled temperature history
+ *
+ * @param tier History tier (0 = 1 min, 1 = 1 hour)
+ * @param from_timestamp First record timestamp included (0 = from the oldest)
+ * @param records Output buffer for records
+ * @param max_records Maximum records to read
+ * @param records_read Output: actual number read
+ * @param first_index Output: tier index of records[0] (0 = oldest)
+ * @return true on success, false on error or no matching record
+ */
+bool temperature_sensor_history_read(
+    uint32_t tier,
+    uint32_t from_timestamp,
+    sensor_rollup_record_t *records,
+    uint32_t max_records,
+    uint32_t *records_read,
+    uint32_t *first_index);
+
+/**
+ * @brief Get running statistics of the buffered temperature samples
+ *
+ * Values are in centi-degrees like the buffered samples.
+ *
+ * @param window Statistics window (see TEMP_SENSOR_STATS_WINDOWS)
+ * @param summary Output
+ * @return false for an unknown window or before the first sample
+ */
+bool temperature_sensor_stats_get(uint32_t window, stream_stats_summary_t *summary);
+
+/**
+ * @brief Clear all buffered temperature and humidity samples, history and statistics
  */
 void temperature_sensor_buffer_clear(void);
 
@@ -86,4 +252,20 @@ void temperature_sensor_buffer_clear(void);
  */
 void temperature_sensor_set_timestamp_fn(temp_sensor_timestamp_fn get_timestamp);
 
+/**
+ * @brief Change the time between sensor reads
+ *
+ * Buffered samples keep TEMP_SENSOR_BUFFER_INTERVAL_MS as long as reads
+ * come at least that often. With TEMP_SENSOR_ADAPTIVE_RATE an interval
+ * above TEMP_SENSOR_READ_INTERVAL_MS holds the adaptive one back.
+ *
+ * @param interval_ms Read interval, 0 for TEMP_SENSOR_READ_INTERVAL_MS
+ */
+void temperature_sensor_set_read_interval(uint32_t interval_ms);
+
+/**
+ * @brief Interval the sensor is read at now, ms
+ */
+uint32_t temperature_sensor_get_read_interval(void);
+
 #endif // SERV_TEMPERATURE_SENSOR_H
@@ -3,10 +3,37 @@
 
 /**
  * @file service_events.h
- * @brief Event data structures for services
+ * @brief Event data structures for services, and typed access to the catalog
+ *
+ * For every EVENT row of event_catalog.h this header checks at compile
+ * time that the payload fits MAX_EVENT_DATA_SIZE and generates typed
+ * wrappers, so a publisher cannot pass the wrong struct or size and a
+ * handler gets its payload without casting:
+ *
+ * @code
+ * EVENT_PUBLISH(EVENT_CURRENT_LIMIT, &event);           // const current_limit_event_t*
+ * EVENT_SIGNAL(EVENT_DISPLAY_READY);                     // SIGNAL rows: no payload
+ *
+ * EVENT_HANDLER(EVENT_TEMPERATURE_UPDATED, on_reading)
+ * {
+ *     post(payload->temperature);                        // const temperature_data_t*
+ * }
+ * EVENT_SUBSCRIBE(on_reading);                           // in the init function
+ * @endcode
+ *
+ * The handler's generated event_callback_t drops an event whose payload
+ * is shorter than the type (only an untyped publish can send one), so
+ * handlers do not check sizes themselves. EVENT_STATIC_HANDLER also
+ * registers it in the flash table (EVENT_BUS_USE_STATIC_SUBSCRIPTIONS).
  */
 
 #include <stdint.h>
+#include "event_bus.h"
+#include "hal_gpio.h"
+#include "serv_current_monitor.h"
+#include "serv_load_shed.h"
+#include "metric_pipeline.h"
+#include "deadline_monitor.h"
 
 /**
  * @brief Temperature sensor data event payload
@@ -17,4 +44,75 @@ typedef struct {
     uint8_t sensor_ok;
 } temperature_data_t;
 
+// ============================================================================
+// Typed Catalog Access
+// ============================================================================
+
+// Payload type of a catalog event, e.g. EVENT_PAYLOAD(EVENT_CURRENT_LIMIT)
+#define EVENT_PAYLOAD(id)               id##_payload_t
+
+#define SERVICE_EVENT_TYPED(id, payload_type, priority, coalesce)                     \
+    typedef payload_type id##_payload_t;                                              \
+    _Static_assert(sizeof(payload_type) <= MAX_EVENT_DATA_SIZE,                       \
+                   #id " payload exceeds MAX_EVENT_DATA_SIZE");                       \
+    static inline bool event_publish_##id(const payload_type* payload)                \
+    {                                                                                 \
+        return event_bus_publish(id, (void*)payload, sizeof(payload_type));           \
+    }                                                                                 \
+    static inline bool event_publish_from_isr_##id(const payload_type* payload)       \
+    {                                                                                 \
+        return event_bus_publish_from_isr(id, payload, sizeof(payload_type));         \
+    }
+
+#define SERVICE_EVENT_SIGNAL(id, priority, coalesce)                                  \
+    static inline bool event_signal_##id(void)                                        \
+    {                                                                                 \
+        return event_bus_publish(id, NULL, 0);                                        \
+    }
+
+EVENT_CATALOG(SERVICE_EVENT_TYPED, SERVICE_EVENT_SIGNAL)
+
+// Publish a catalog event; payload must point at its EVENT_PAYLOAD type
+#define EVENT_PUBLISH(id, payload)              event_publish_##id(payload)
+#define EVENT_PUBLISH_FROM_ISR(id, payload)     event_publish_from_isr_##id(payload)
+#define EVENT_SIGNAL(id)                        event_signal_##id()
+
+// Handler prototype plus the event_callback_t that unpacks its payload
+#define SERVICE_EVENT_HANDLER_(id, name)                                              \
+    enum { name##_event_type = id };                                                  \
+    static void name(const EVENT_PAYLOAD(id)* payload, const event_t* event);         \
+    static void name##_callback(event_t* event)                                       \
+    {                                                                                 \
+        if (event->data != NULL && event->data_size >= sizeof(EVENT_PAYLOAD(id))) {   \
+            name((const EVENT_PAYLOAD(id)*)event->data, event);                       \
+        }                                                                             \
+    }
+
+/**
+ * @brief Define a handler that receives the typed payload of one event type
+ *
+ * Place at file scope, followed by the body; inside it 'payload' is the
+ * const EVENT_PAYLOAD(id)* and 'event' the bus event.
+ */
+#define EVENT_HANDLER(id, name)                                                       \
+    SERVICE_EVENT_HANDLER_(id, name)                                                  \
+    static void name(const EVENT_PAYLOAD(id)* payload, const event_t* event)
+
+// Event type and event_callback_t of an EVENT_HANDLER, for the other subscribe calls
+#define EVENT_HANDLER_TYPE(name)        ((event_type_t)name##_event_type)
+#define EVENT_HANDLER_CALLBACK(name)    name##_callback
+
+#define EVENT_SUBSCRIBE(name)           event_bus_subscribe(EVENT_HANDLER_TYPE(name), name##_callback)
+#define EVENT_UNSUBSCRIBE(name)         event_bus_unsubscribe(EVENT_HANDLER_TYPE(name), name##_callback)
+
+#if EVENT_BUS_USE_STATIC_SUBSCRIPTIONS
+/**
+ * @brief EVENT_HANDLER, subscribed from the flash table (no EVENT_SUBSCRIBE)
+ */
+#define EVENT_STATIC_HANDLER(id, name)                                                \
+    SERVICE_EVENT_HANDLER_(id, name)                                                  \
+    EVENT_BUS_STATIC_SUBSCRIBE(id, name##_callback);                                  \
+    static void name(const EVENT_PAYLOAD(id)* payload, const event_t* event)
+#endif
+
 #endif // SERVICE_EVENTS_H
@@ -3,64 +3,445 @@
 #include "serv_temperature_sensor.h"
 #include "serv_display.h"
 #include "serv_current_monitor.h"
+#include "serv_sensor_registry.h"
+#include "serv_sample_log.h"
+#include "serv_recorder.h"
+#include "serv_current_analysis.h"
+#include "serv_load_shed.h"
+#include "serv_config.h"
 #include "protocol_handler.h"
+#include "metric_pipeline.h"
+#include "link_stats.h"
 #include "portable_log.h"
 // /#include "hal_uart.h"
 #include "os_wrapper.h"
+#include "os_tasks.h"
+#include "os_sched.h"
+#include "os_boot.h"
+#include "deadline_monitor.h"
+#include "hal_timebase.h"
+#include "hal_clock.h"
 
 #ifdef ENABLE_UART_TEST
 #include "../../Tests/uart_test/serv_uart_test.h"
 #endif
 
+#ifdef ENABLE_MEM_BENCHMARK
+#include "../../Tests/mem_benchmark/mem_benchmark.h"
+#endif
+
+#ifdef ENABLE_CRC_BENCHMARK
+#include "../../Tests/crc_benchmark/crc_benchmark.h"
+#endif
+
+#ifdef ENABLE_FRAMING_BENCHMARK
+#include "../../Tests/framing_benchmark/framing_benchmark.h"
+#endif
+
+#ifdef ENABLE_RING_BUFFER_BENCHMARK
+#include "../../Tests/ring_buffer_benchmark/ring_buffer_benchmark.h"
+#endif
+
+#ifdef ENABLE_RING_BUFFER_STRESS
+#include "../../Tests/ring_buffer_stress/ring_buffer_stress.h"
+#endif
+
+#ifdef ENABLE_DSP_BENCHMARK
+#include "../../Tests/dsp_benchmark/dsp_benchmark.h"
+#endif
+
+#ifdef ENABLE_DISPLAY_BENCHMARK
+#include "../../Tests/display_benchmark/display_benchmark.h"
+#endif
+
+#ifdef ENABLE_EVENT_BUS_SOAK
+#include "../../Tests/event_bus_soak/event_bus_soak.h"
+#endif
+
+#ifdef ENABLE_PERF_SUITE
+#include "../../Tests/perf_suite/perf_suite.h"
+#endif
+
+// Rate-monotonic priorities, highest first:
+//   current monitor   2 ms   CURRENT_TASK_PRIORITY
+//   protocol RX       event  OS_PRIORITY_HIGH (esp32_packet_framing)
+//   temperature      10 ms   TEMPERATURE_TASK_PRIORITY
+//   housekeeping     10 ms   SERVICES_LOOP_PRIORITY (this loop, best effort)
+//   display          event  OS_PRIORITY_LOW (serv_display render task)
+// The event bus dispatch task and the work queue worker stay above all of them.
+#define CURRENT_TASK_PERIOD_MS      2
+#define CURRENT_TASK_PRIORITY       (OS_PRIORITY_HIGH + 2)
+#define CURRENT_TASK_STACK          1024
+#define TEMPERATURE_TASK_PERIOD_MS  10
+#define TEMPERATURE_TASK_PRIORITY   (OS_PRIORITY_NORMAL + 2)
+#define TEMPERATURE_TASK_STACK      1536
+#define SERVICES_LOOP_PRIORITY      (OS_PRIORITY_LOW + 1)
+
+// Deadline monitor budgets: a pass should leave half its period free
+#define CURRENT_TASK_BUDGET_MS      (CURRENT_TASK_PERIOD_MS / 2)
+#define TEMPERATURE_TASK_BUDGET_MS  (TEMPERATURE_TASK_PERIOD_MS / 2)
+#define SERVICES_LOOP_BUDGET_MS     (SERVICES_RUN_PERIOD_MS / 2)
+
+#define ISR_LOG_INTERVAL_MS         5000
+#define STACK_LOG_INTERVAL_MS       60000
+
 static const char *TAG = "SERVICES";
-static uint32_t last_isr_log_time = 0;
+static volatile bool isr_log_due = false;
+static volatile bool stack_log_due = false;
+static uint32_t loop_last_wake = 0;
+static uint32_t loop_missed_deadlines = 0;
 
-void services_init(void)
+static void housekeeping_job(void);
+static void diag_log_job(void);
+
+OS_TIMER_DEFINE(isr_log);
+OS_TIMER_DEFINE(stack_log);
+
+OS_PERIODIC_TASK_DEFINE(current, "current", CURRENT_TASK_STACK, current_monitor_process,
+                        CURRENT_TASK_PERIOD_MS, CURRENT_TASK_PRIORITY);
+OS_PERIODIC_TASK_DEFINE(temperature, "temperature", TEMPERATURE_TASK_STACK, temperature_sensor_run,
+                        TEMPERATURE_TASK_PERIOD_MS, TEMPERATURE_TASK_PRIORITY);
+
+// ============================================================================
+// Init Graph
+// ============================================================================
+
+// Steps of services_init(), in table order. The sensor power-up is async,
+// so the protocol and the current monitor are up within milliseconds
+// instead of waiting behind it; the display step only starts its render
+// task, which sleeps through the panel's reset sequence on its own.
+enum {
+    INIT_CONFIG,
+    INIT_BLINKY,
+    INIT_SAMPLE_LOG,
+    INIT_TEMPERATURE,
+    INIT_DISPLAY,
+    INIT_CURRENT_MONITOR,
+    INIT_CURRENT_ANALYSIS,
+    INIT_RECORDER,
+    INIT_SENSOR_REGISTRY,
+    INIT_PROTOCOL,
+    INIT_LOAD_SHED,
+    INIT_SCHEDULER,
+    INIT_STEP_COUNT
+};
+
+#if defined(ENABLE_FRAMING_BENCHMARK) || defined(ENABLE_PERF_SUITE)
+// The boot benchmarks run in the protocol step and time the sensors and the
+// display: everything must be up, and idle, by then
+#define INIT_PROTOCOL_BENCH_DEPS    (OS_BOOT_DEP(INIT_TEMPERATURE) | OS_BOOT_DEP(INIT_DISPLAY))
+#define INIT_BENCH_DISPLAY_TIMEOUT_MS   2000
+#else
+#define INIT_PROTOCOL_BENCH_DEPS    0
+#endif
+
+#if defined(ENABLE_MEM_BENCHMARK) || defined(ENABLE_CRC_BENCHMARK) || \
+    defined(ENABLE_RING_BUFFER_BENCHMARK) || defined(ENABLE_DSP_BENCHMARK) || \
+    defined(ENABLE_DISPLAY_BENCHMARK) || defined(ENABLE_EVENT_BUS_SOAK) || \
+    defined(ENABLE_RING_BUFFER_STRESS)
+// Benchmarks run after the graph and want the CPU to themselves: the
+// service tasks start after them
+#define SERVICES_BOOT_BENCHMARKS
+#endif
+
+static void start_service_task(os_periodic_task_t *task)
 {
+#ifndef SERVICES_BOOT_BENCHMARKS
+    os_periodic_task_start(task);
+#else
+    (void)task;
+#endif
+}
+
+static void init_config(void)
+{
+    // Values only: the load shed step applies them once their services are up
+    config_init();
+}
 
+static void init_blinky(void)
+{
     blinky_init();
-    LOG_I(TAG, "Blinky initialized\n");
+}
 
+static void init_sample_log(void)
+{
+    // Before the temperature service starts logging into it
+    if (!sample_log_init()) {
+        LOG_E(TAG, "Sample log unavailable\n");
+    }
+}
+
+static void init_temperature(void)
+{
+    // Sensor power-up delay; the task starts once the sensor is open
     temperature_sensor_init();
-    LOG_I(TAG, "Temperature sensor initialized\n");
-    
+    os_periodic_task_monitor(&temperature_periodic_task, DEADLINE_TEMPERATURE_TASK,
+                             TEMPERATURE_TASK_BUDGET_MS);
+    start_service_task(&temperature_periodic_task);
+}
+
+static void init_display(void)
+{
     display_init();
-    LOG_I(TAG, "Display initialized\n");
+}
 
+static void init_current_monitor(void)
+{
     current_monitor_init();
-    LOG_I(TAG, "Current monitor initialized\n");
+    os_periodic_task_monitor(&current_periodic_task, DEADLINE_CURRENT_TASK, CURRENT_TASK_BUDGET_MS);
+    start_service_task(&current_periodic_task);
+}
 
-    protocol_handler_init();
-    LOG_I(TAG, "Protocol handler initialized\n");
+static void init_current_analysis(void)
+{
+    current_analysis_init();
+}
+
+static void init_recorder(void)
+{
+    if (!recorder_init(&recorder_backend_spi_nor)) {
+        LOG_W(TAG, "Recorder storage unavailable\n");
+    }
+}
+
+static void init_sensor_registry(void)
+{
+    sensor_registry_init();
+}
+
+static void init_protocol(void)
+{
+#if defined(ENABLE_FRAMING_BENCHMARK) || defined(ENABLE_PERF_SUITE)
+    // The display step only started the panel's open sequence
+    if (!display_wait_ready(INIT_BENCH_DISPLAY_TIMEOUT_MS)) {
+        LOG_W(TAG, "Display not ready, benchmarks go ahead");
+    }
+#endif
+
+#ifdef ENABLE_FRAMING_BENCHMARK
+    // Borrows the packet framing layer, so it must run before the protocol handler
+    framing_benchmark_run();
+#endif
+
+#ifdef ENABLE_PERF_SUITE
+    // Same: borrows the packet framing layer
+    perf_suite_run();
+#endif
+
+#if PROTOCOL_TRANSPORT_USB
+    protocol_handler_init(&protocol_transport_usb);
+#elif PROTOCOL_TRANSPORT_RTT
+    protocol_handler_init(&protocol_transport_rtt);
+#else
+    protocol_handler_init(&protocol_transport_uart);
+#endif
+    link_stats_init();
+
+    // Nodes stay idle until a consumer acquires them
+    metric_pipeline_init();
+}
+
+static void init_load_shed(void)
+{
+    // Reads the link window the protocol step set up, and applies the
+    // configured display, temperature and log values
+    load_shed_init();
+}
+
+// Timer service task, or the tick interrupt without configUSE_TIMERS
+static void diag_log_timer(void *arg)
+{
+    *(volatile bool *)arg = true;
+    if (os_in_isr()) {
+        bool higher_priority_task_woken = false;
+        os_sched_post_from_isr(SERVICES_JOB_DIAG_LOG, &higher_priority_task_woken);
+        os_yield_from_isr(higher_priority_task_woken);
+    } else {
+        os_sched_post(SERVICES_JOB_DIAG_LOG);
+    }
+}
+
+static void init_scheduler(void)
+{
+    // Before anything posts to them
+    os_sched_init();
+    os_sched_add(SERVICES_JOB_HOUSEKEEPING, housekeeping_job);
+    os_sched_add(SERVICES_JOB_SAMPLE_LOG, sample_log_process);
+    os_sched_add(SERVICES_JOB_RECORDER, recorder_process);
+    os_sched_add(SERVICES_JOB_SENSOR_REGISTRY, sensor_registry_process);
+    os_sched_add(SERVICES_JOB_METRICS, metric_pipeline_process);
+    os_sched_add(SERVICES_JOB_LINK_STATS, link_stats_process);
+    os_sched_add(SERVICES_JOB_LOAD_SHED, load_shed_process);
+    os_sched_add(SERVICES_JOB_CLOCK, hal_clock_process);
+    os_sched_add(SERVICES_JOB_CONFIG, config_process);
+    os_sched_add(SERVICES_JOB_DIAG_LOG, diag_log_job);
+
+    // The debug logs wake the loop when due instead of being checked every period
+    os_timer_start(OS_TIMER_CREATE_STATIC(isr_log, ISR_LOG_INTERVAL_MS, true,
+                                          diag_log_timer, (void *)&isr_log_due));
+    os_timer_start(OS_TIMER_CREATE_STATIC(stack_log, STACK_LOG_INTERVAL_MS, true,
+                                          diag_log_timer, (void *)&stack_log_due));
+}
+
+static const os_boot_step_t init_steps[INIT_STEP_COUNT] = {
+    [INIT_CONFIG]           = { "config",           init_config,           0, false },
+    [INIT_BLINKY]           = { "blinky",           init_blinky,           0, false },
+    [INIT_SAMPLE_LOG]       = { "sample_log",       init_sample_log,       0, false },
+    [INIT_TEMPERATURE]      = { "temperature",      init_temperature,
+                                OS_BOOT_DEP(INIT_SAMPLE_LOG), true },
+    [INIT_DISPLAY]          = { "display",          init_display,          0, false },
+    [INIT_CURRENT_MONITOR]  = { "current_monitor",  init_current_monitor,  0, false },
+    [INIT_CURRENT_ANALYSIS] = { "current_analysis", init_current_analysis,
+                                OS_BOOT_DEP(INIT_CURRENT_MONITOR), false },
+    [INIT_RECORDER]         = { "recorder",         init_recorder,         0, false },
+    [INIT_SENSOR_REGISTRY]  = { "sensor_registry",  init_sensor_registry,  0, false },
+    [INIT_PROTOCOL]         = { "protocol",         init_protocol,
+                                OS_BOOT_DEP(INIT_CONFIG) | OS_BOOT_DEP(INIT_CURRENT_MONITOR) |
+                                OS_BOOT_DEP(INIT_SENSOR_REGISTRY) | INIT_PROTOCOL_BENCH_DEPS, false },
+    [INIT_LOAD_SHED]        = { "load_shed",        init_load_shed,
+                                OS_BOOT_DEP(INIT_PROTOCOL) | OS_BOOT_DEP(INIT_TEMPERATURE) |
+                                OS_BOOT_DEP(INIT_DISPLAY), false },
+    [INIT_SCHEDULER]        = { "scheduler",        init_scheduler,        0, false },
+};
+
+void services_init(void)
+{
+    os_boot_mark("services");
+    os_boot_run(init_steps, INIT_STEP_COUNT);
+    LOG_I(TAG, "Services up (temperature and display finishing in the background)\n");
 
 #ifdef ENABLE_UART_TEST
     SEGGER_RTT_printf(0, "Services: Initializing UART test...\n");
     serv_uart_test_init();
     LOG_I(TAG, "UART test service initialized\n");
 #endif
+
+#ifdef SERVICES_BOOT_BENCHMARKS
+    // No init may still be running either
+    os_boot_wait_all(OS_WAIT_FOREVER);
+#endif
+
+#ifdef ENABLE_MEM_BENCHMARK
+    mem_benchmark_run();
+#endif
+
+#ifdef ENABLE_CRC_BENCHMARK
+    crc_benchmark_run();
+#endif
+
+#ifdef ENABLE_RING_BUFFER_BENCHMARK
+    ring_buffer_benchmark_run();
+#endif
+
+#ifdef ENABLE_RING_BUFFER_STRESS
+    ring_buffer_stress_run();
+#endif
+
+#ifdef ENABLE_DSP_BENCHMARK
+    dsp_benchmark_run();
+#endif
+
+#ifdef ENABLE_DISPLAY_BENCHMARK
+    // No sensor task runs yet, so the display service has nothing to draw
+    display_benchmark_run();
+#endif
+
+#ifdef ENABLE_EVENT_BUS_SOAK
+    // Before the current task can claim the hal_timer compare
+    event_bus_soak_run();
+#endif
+
+#ifdef SERVICES_BOOT_BENCHMARKS
+    os_periodic_task_start(&current_periodic_task);
+    os_periodic_task_start(&temperature_periodic_task);
+#endif
+
+    // The calling (default) task keeps the housekeeping loop, below the sensors
+    os_task_set_priority(NULL, SERVICES_LOOP_PRIORITY);
+    deadline_monitor_register(DEADLINE_SERVICES_LOOP, SERVICES_RUN_PERIOD_MS * 1000U,
+                              SERVICES_LOOP_BUDGET_MS * 1000U);
+    loop_last_wake = os_get_tick_count();
 }
 
-void services_run(void)
+static void housekeeping_job(void)
 {
     blinky_run();
-    temperature_sensor_run();
-    display_run();
-    current_monitor_process();
+    hal_timebase_discipline();
 
 #ifdef ENABLE_UART_TEST
     serv_uart_test_loop();
 #endif
+}
 
-    // Debug: Log ISR counters every 5 seconds
-    // TEMPORARILY DISABLED - testing for boot loop
+static void diag_log_job(void)
+{
+    if (isr_log_due) {
+        isr_log_due = false;
+        hal_uart_isr_counters_t isr;
+        if (hal_uart_get_isr_counters((hal_uart_port_t)STM32_UART_PORT, &isr)) {
+            LOG_I(TAG, "UART ISR counters: IDLE=%lu, RTO=%lu, CM=%lu, DMA_HT=%lu, DMA_TC=%lu",
+                  isr.idle, isr.rx_timeout, isr.char_match, isr.dma_half, isr.dma_complete);
+            LOG_I(TAG, "UART RX: high water=%lu/%lu, ORE=%lu, DMA overruns=%lu, dropped=%lu",
+                  isr.rx_high_water, isr.rx_dma_buffer_size, isr.hw_overruns,
+                  isr.dma_overruns, isr.rx_dropped_bytes);
+        }
+    }
 
-    uint32_t current_time = os_get_tick_count();
-    if (os_ticks_to_ms(current_time - last_isr_log_time) >= 5000) {
-        uint32_t idle_count, dma_ht_count, dma_tc_count;
-        hal_uart_get_isr_counters(&idle_count, &dma_ht_count, &dma_tc_count);
-        LOG_I(TAG, "UART ISR counters: IDLE=%lu, DMA_HT=%lu, DMA_TC=%lu",
-              idle_count, dma_ht_count, dma_tc_count);
-        last_isr_log_time = current_time;
+    if (stack_log_due) {
+        stack_log_due = false;
+        LOG_I(TAG, "Stack left (bytes): current=%lu, temperature=%lu, services=%lu",
+              (unsigned long)os_periodic_task_stack_high_water(&current_periodic_task),
+              (unsigned long)os_periodic_task_stack_high_water(&temperature_periodic_task),
+              (unsigned long)os_task_get_stack_high_water(NULL));
     }
+}
+
+void services_run(void)
+{
+    // Current monitor and temperature sensor run in their own tasks, the
+    // display in its render task; the rest are housekeeping jobs
+    deadline_monitor_begin(DEADLINE_SERVICES_LOOP,
+                           DEADLINE_RELEASE_MS_AGO(os_get_tick_count() - loop_last_wake));
+    os_sched_post(SERVICES_JOB_CONFIG);
+    os_sched_post(SERVICES_JOB_CLOCK);
+    os_sched_post(SERVICES_JOB_LOAD_SHED);
+    os_sched_post(SERVICES_JOB_LINK_STATS);
+    os_sched_post(SERVICES_JOB_METRICS);
+    os_sched_post(SERVICES_JOB_SENSOR_REGISTRY);
+    os_sched_post(SERVICES_JOB_RECORDER);
+    os_sched_post(SERVICES_JOB_SAMPLE_LOG);
+    os_sched_post(SERVICES_JOB_HOUSEKEEPING);
+    os_sched_dispatch();
+    deadline_monitor_end(DEADLINE_SERVICES_LOOP);
+}
 
+void services_wait_period(void)
+{
+    uint32_t period = os_ms_to_ticks(SERVICES_RUN_PERIOD_MS);
+
+    if (os_get_tick_count() - loop_last_wake >= period) {
+        // Overran: count it and restart the grid instead of running back to back
+        loop_missed_deadlines++;
+        loop_last_wake = os_get_tick_count();
+        return;
+    }
+
+    // Run jobs as they are posted until the next period is due
+    while (1) {
+        os_sched_dispatch();
+        uint32_t elapsed = os_get_tick_count() - loop_last_wake;
+        if (elapsed >= period) {
+            break;
+        }
+        os_sched_idle(os_ticks_to_ms(period - elapsed));
+    }
+    loop_last_wake += period;
+}
+
+uint32_t services_get_missed_deadlines(void)
+{
+    return loop_missed_deadlines +
+           os_periodic_task_missed_deadlines(&current_periodic_task) +
+           os_periodic_task_missed_deadlines(&temperature_periodic_task);
 }
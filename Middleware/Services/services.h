@@ -1,7 +1,38 @@
 #ifndef SERVICES_H
 #define SERVICES_H
 
+#include <stdint.h>
+
+#define SERVICES_RUN_PERIOD_MS  10
+
+// Housekeeping jobs (os_sched.h priorities, highest runs first). Each runs
+// every period unless noted; os_sched_post() one to run it before the next
+// period.
+#define SERVICES_JOB_HOUSEKEEPING       0   // Blinky, timebase
+#define SERVICES_JOB_SAMPLE_LOG         1
+#define SERVICES_JOB_RECORDER           2
+#define SERVICES_JOB_SENSOR_REGISTRY    3
+#define SERVICES_JOB_METRICS            4   // Polled derived metrics
+#define SERVICES_JOB_LINK_STATS         5   // Host link rate window
+#define SERVICES_JOB_LOAD_SHED          6   // Overload policy, after the link window
+#define SERVICES_JOB_CLOCK              7   // Pending performance level changes
+#define SERVICES_JOB_CONFIG             8   // Requested config saves (returns at once otherwise)
+#define SERVICES_JOB_DIAG_LOG           9   // Debug logs, posted by their timers only
+
 void services_init(void);
 void services_run(void);
 
+/**
+ * @brief Wait for the next services_run() period (absolute deadline, no drift)
+ *
+ * Jobs posted meanwhile run as they arrive instead of at the next period.
+ */
+void services_wait_period(void);
+
+/**
+ * @brief Number of service periods that overran their deadline (the loop
+ *        and the per-service tasks together)
+ */
+uint32_t services_get_missed_deadlines(void);
+
 #endif  
@@ -0,0 +1,257 @@
+#include "active_object.h"
+#include "event_pool.h"
+#include "hal_delay.h"
+#include "portable_log.h"
+#include <string.h>
+
+static const char *TAG = "AO";
+
+// Started objects; the bus callback fans events out to their queues
+static active_object_t *objects[AO_MAX_OBJECTS];
+static volatile uint8_t object_count = 0;
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static bool is_subscribed(const active_object_t *ao, event_type_t event_type)
+{
+    for (uint8_t i = 0; i < ao->subscription_count; i++) {
+        if (ao->subscriptions[i] == event_type) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool any_subscribed(event_type_t event_type)
+{
+    for (uint8_t i = 0; i < object_count; i++) {
+        if (is_subscribed(objects[i], event_type)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Copy an event into the object's queue (never blocks)
+ */
+static bool post_event(active_object_t *ao, const event_t *event)
+{
+    ao_event_t item = {
+        .type = event->type,
+        .timestamp = event->timestamp,
+        .data_size = event->data_size,
+        .record_size = event->record_size,
+        .record_count = event->record_count,
+        .pooled = NULL,
+    };
+
+    if (event->data != NULL && event->data_size > 0) {
+        if (event_pool_owns(event->data)) {
+            event_pool_retain(event->data);
+            item.pooled = event->data;
+        } else if (event->data_size <= AO_EVENT_DATA_SIZE) {
+            memcpy(item.data, event->data, event->data_size);
+        } else {
+            ao->stats.oversize++;
+            return false;
+        }
+    }
+
+    if (os_queue_send(ao->queue, &item, OS_NO_WAIT) != OS_SUCCESS) {
+        if (item.pooled != NULL) {
+            event_pool_release(item.pooled);
+        }
+        ao->stats.dropped++;
+        return false;
+    }
+
+    ao->stats.posted++;
+    uint32_t waiting = os_queue_get_count(ao->queue);
+    if (waiting > ao->stats.queue_high_water) {
+        ao->stats.queue_high_water = waiting;
+    }
+    return true;
+}
+
+/**
+ * @brief Event bus callback of every type an object subscribed to
+ */
+static void bus_callback(event_t *event)
+{
+    for (uint8_t i = 0; i < object_count; i++) {
+        if (is_subscribed(objects[i], event->type)) {
+            post_event(objects[i], event);
+        }
+    }
+}
+
+static void ao_task(void *arg)
+{
+    active_object_t *ao = (active_object_t *)arg;
+    ao_event_t item;
+
+    while (1) {
+        if (os_queue_receive(ao->queue, &item, OS_WAIT_FOREVER) != OS_SUCCESS) {
+            continue;
+        }
+
+        event_t event = {
+            .type = item.type,
+            .data = (item.pooled != NULL) ? item.pooled
+                    : (item.data_size > 0) ? item.data : NULL,
+            .data_size = item.data_size,
+            .timestamp = item.timestamp,
+            .record_size = item.record_size,
+            .record_count = item.record_count,
+        };
+
+        uint32_t start = hal_get_cycle_count();
+        ao->handler(ao, &event);
+        uint32_t cycles = hal_get_cycle_count() - start;
+
+        if (item.pooled != NULL) {
+            event_pool_release(item.pooled);
+        }
+        ao->stats.handled++;
+        if (cycles > ao->stats.max_handler_cycles) {
+            ao->stats.max_handler_cycles = cycles;
+        }
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool ao_start(active_object_t *ao)
+{
+    if (ao == NULL || ao->handler == NULL || ao->queue_depth == 0) {
+        return false;
+    }
+
+    if (ao->task != NULL) {
+        return true;
+    }
+
+    if (object_count >= AO_MAX_OBJECTS) {
+        LOG_E(TAG, "No room for %s", ao->name);
+        return false;
+    }
+
+    ao->queue = os_queue_create_static(ao->queue_depth, sizeof(ao_event_t),
+                                       ao->queue_buffer, ao->queue_storage);
+    if (ao->queue == NULL) {
+        LOG_E(TAG, "Failed to create %s queue", ao->name);
+        return false;
+    }
+
+    memset((void *)&ao->stats, 0, sizeof(ao->stats));
+    ao->subscription_count = 0;
+
+    if (os_task_create_static(ao_task, ao->name, ao->stack_size, ao, ao->priority,
+                              ao->stack, ao->task_storage, &ao->task) != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create %s task", ao->name);
+        os_queue_delete(ao->queue);
+        ao->queue = NULL;
+        ao->task = NULL;
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    objects[object_count] = ao;
+    object_count++;
+    os_critical_exit(mask);
+
+    LOG_I(TAG, "%s: queue %lu, priority %d", ao->name,
+          (unsigned long)ao->queue_depth, ao->priority);
+    return true;
+}
+
+bool ao_subscribe(active_object_t *ao, event_type_t event_type)
+{
+    if (ao == NULL || ao->queue == NULL) {
+        return false;
+    }
+
+    if (is_subscribed(ao, event_type)) {
+        return true;
+    }
+
+    if (ao->subscription_count >= AO_MAX_SUBSCRIPTIONS
+        || !event_bus_subscribe(event_type, bus_callback)) {
+        return false;
+    }
+
+    // Fully written before the bus callback can see it
+    ao->subscriptions[ao->subscription_count] = event_type;
+    uint32_t mask = os_critical_enter();
+    ao->subscription_count++;
+    os_critical_exit(mask);
+    return true;
+}
+
+bool ao_unsubscribe(active_object_t *ao, event_type_t event_type)
+{
+    if (ao == NULL) {
+        return false;
+    }
+
+    bool found = false;
+    uint32_t mask = os_critical_enter();
+    for (uint8_t i = 0; i < ao->subscription_count; i++) {
+        if (ao->subscriptions[i] == event_type) {
+            ao->subscriptions[i] = ao->subscriptions[ao->subscription_count - 1];
+            ao->subscription_count--;
+            found = true;
+            break;
+        }
+    }
+    os_critical_exit(mask);
+
+    // The bus callback is shared: keep it while another object wants the type
+    if (found && !any_subscribed(event_type)) {
+        event_bus_unsubscribe(event_type, bus_callback);
+    }
+    return found;
+}
+
+bool ao_post(active_object_t *ao, event_type_t event_type, const void *data, uint32_t data_size)
+{
+    if (ao == NULL || ao->queue == NULL || (data == NULL && data_size > 0)) {
+        return false;
+    }
+
+    event_t event = {
+        .type = event_type,
+        .data = (void *)data,
+        .data_size = data_size,
+        .timestamp = event_bus_get_timestamp_us(),
+    };
+    return post_event(ao, &event);
+}
+
+void ao_get_stats(const active_object_t *ao, ao_stats_t *stats)
+{
+    if (ao == NULL || stats == NULL) {
+        return;
+    }
+
+    memcpy(stats, (const void *)&ao->stats, sizeof(*stats));
+}
+
+uint32_t ao_get_queue_count(const active_object_t *ao)
+{
+    return (ao != NULL && ao->queue != NULL) ? os_queue_get_count(ao->queue) : 0;
+}
+
+uint32_t ao_stack_high_water(const active_object_t *ao)
+{
+    if (ao == NULL || ao->task == NULL) {
+        return 0;
+    }
+
+    return os_task_get_stack_high_water(ao->task);
+}
@@ -0,0 +1,144 @@
+#ifndef ACTIVE_OBJECT_H
+#define ACTIVE_OBJECT_H
+
+/**
+ * @file active_object.h
+ * @brief Active objects: a private event queue and task per service
+ *
+ * An active object subscribes to event bus types; the bus dispatch task
+ * only copies each event into the object's queue (never blocking), and the
+ * object's own task runs the handler, one event at a time. A slow handler
+ * delays only its own object. A full queue drops the event and counts it,
+ * so queue high water and drops show which object falls behind.
+ *
+ * Payloads up to AO_EVENT_DATA_SIZE are copied into the queue item; pooled
+ * payloads (event_bus_publish_pooled()) are kept by reference until the
+ * handler returns.
+ *
+ * Stacks and queues are static. Start with an estimate and trim the stack
+ * with ao_stack_high_water() after a soak run.
+ *
+ * Usage example:
+ * @code
+ * static void logger_handle(active_object_t *ao, const event_t *event);
+ * AO_DEFINE(logger, "logger", 1024, 8, logger_handle, OS_PRIORITY_LOW);
+ *
+ * ao_start(&logger_ao);
+ * ao_subscribe(&logger_ao, EVENT_SENSOR_ERROR);
+ * @endcode
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "os_wrapper.h"
+#include "event_bus.h"
+
+#define AO_MAX_OBJECTS          8
+#define AO_MAX_SUBSCRIPTIONS    8       // Event types per object
+#define AO_EVENT_DATA_SIZE      64      // Inline payload copy, as the bus itself
+
+typedef struct active_object active_object_t;
+
+/**
+ * @brief Event handler, run in the object's task
+ * @param event Valid only during the call (like an event bus callback)
+ */
+typedef void (*ao_handler_t)(active_object_t *ao, const event_t *event);
+
+/**
+ * @brief One queued event
+ */
+typedef struct {
+    event_type_t type;
+    uint32_t timestamp;
+    uint32_t data_size;
+    uint16_t record_size;
+    uint16_t record_count;
+    void *pooled;                   // Retained event_pool block, else NULL (data is inline)
+    uint8_t data[AO_EVENT_DATA_SIZE];
+} ao_event_t;
+
+typedef struct {
+    uint32_t posted;                // Queued
+    uint32_t dropped;               // Queue full
+    uint32_t oversize;              // Payload too large to copy, not pooled
+    uint32_t handled;
+    uint32_t queue_high_water;      // Most events waiting at once
+    uint32_t max_handler_cycles;
+} ao_stats_t;
+
+/**
+ * @brief One active object; define with AO_DEFINE()
+ */
+struct active_object {
+    const char *name;
+    ao_handler_t handler;
+    void *context;                  // Caller data for the handler
+    uint8_t priority;               // OS_PRIORITY_*
+    uint32_t *stack;
+    uint32_t stack_size;            // Bytes
+    os_task_storage_t *task_storage;
+    uint8_t *queue_buffer;
+    os_queue_storage_t *queue_storage;
+    uint32_t queue_depth;
+    os_task_handle_t task;          // NULL until started
+    os_queue_handle_t queue;
+    event_type_t subscriptions[AO_MAX_SUBSCRIPTIONS];
+    volatile uint8_t subscription_count;
+    volatile ao_stats_t stats;
+};
+
+#define AO_DEFINE(var, ao_name, stack_bytes, depth, handler_func, prio) \
+    OS_TASK_DEFINE(var, stack_bytes); \
+    OS_QUEUE_DEFINE(var, depth, sizeof(ao_event_t)); \
+    static active_object_t var##_ao = { \
+        .name = (ao_name), \
+        .handler = (handler_func), \
+        .priority = (prio), \
+        .stack = var##_task_stack, \
+        .stack_size = sizeof(var##_task_stack), \
+        .task_storage = &var##_task_storage, \
+        .queue_buffer = var##_queue_buffer, \
+        .queue_storage = &var##_queue_storage, \
+        .queue_depth = (depth), \
+    }
+
+/**
+ * @brief Create the queue and the task
+ * @return true if running (or already running)
+ */
+bool ao_start(active_object_t *ao);
+
+/**
+ * @brief Deliver an event bus type to the object
+ * @note Call after ao_start()
+ * @return false if the object or the bus has no room for another subscription
+ */
+bool ao_subscribe(active_object_t *ao, event_type_t event_type);
+
+bool ao_unsubscribe(active_object_t *ao, event_type_t event_type);
+
+/**
+ * @brief Queue an event for the object directly, bypassing the bus
+ *
+ * Any type value works, including private ones >= EVENT_USER_DEFINED_START.
+ *
+ * @note NON-BLOCKING: a full queue drops the event (counted)
+ * @return true if queued
+ */
+bool ao_post(active_object_t *ao, event_type_t event_type, const void *data, uint32_t data_size);
+
+void ao_get_stats(const active_object_t *ao, ao_stats_t *stats);
+
+/**
+ * @brief Events waiting in the object's queue now
+ */
+uint32_t ao_get_queue_count(const active_object_t *ao);
+
+/**
+ * @brief Smallest amount of stack the task has had left so far, in bytes
+ * @return 0 if the object was not started
+ */
+uint32_t ao_stack_high_water(const active_object_t *ao);
+
+#endif // ACTIVE_OBJECT_H
@@ -1,60 +1,432 @@
 #include "event_bus.h"
+#include "event_pool.h"
 #include "hal_delay.h"
+#include "hal_timebase.h"
+#include "hal_mem.h"
+#include "cycle_probe.h"
+#include "sysview_trace.h"
+#include "event_trace.h"
+#if EVENT_BUS_USE_DISPATCH_TASK
+#include "os_wrapper.h"
+#endif
+#include "portable_log.h"
 #include <string.h>
 
+#if EVENT_BUS_USE_STATIC_SUBSCRIPTIONS
+static const char *TAG = "EVENT_BUS";
+#endif
+
 // Event Queue
-#define EVENT_QUEUE_SIZE 16
-#define MAX_EVENT_DATA_SIZE 64  // Maximum size for event data
+#define EVENT_QUEUE_SIZE 32     // Depth of the normal priority lane
+
+// Priority lanes
+#define EVENT_LANE_CRITICAL_SIZE    8
+#define EVENT_LANE_BULK_SIZE        16
+
+// Payload arena per lane: copied payloads take their size rounded up to
+// EVENT_ARENA_ALIGN, so small events no longer cost a 64-byte slot
+#define EVENT_LANE_CRITICAL_ARENA   256
+#define EVENT_LANE_NORMAL_ARENA     1024
+#define EVENT_LANE_BULK_ARENA       512
+#define EVENT_ARENA_ALIGN           8
+#define EVENT_ARENA_ROUND(size)     (((size) + EVENT_ARENA_ALIGN - 1U) & ~(uint32_t)(EVENT_ARENA_ALIGN - 1U))
+
+#if EVENT_LANE_CRITICAL_ARENA < MAX_EVENT_DATA_SIZE || EVENT_LANE_NORMAL_ARENA < MAX_EVENT_DATA_SIZE \
+    || EVENT_LANE_BULK_ARENA < MAX_EVENT_DATA_SIZE
+#error "Every lane arena must hold one MAX_EVENT_DATA_SIZE payload"
+#endif
+
+#if (EVENT_LANE_CRITICAL_ARENA | EVENT_LANE_NORMAL_ARENA | EVENT_LANE_BULK_ARENA) % EVENT_ARENA_ALIGN != 0 \
+    || EVENT_LANE_NORMAL_ARENA > UINT16_MAX
+#error "Lane arenas must be multiples of EVENT_ARENA_ALIGN and fit 16 bits"
+#endif
+
+// Events dispatched per lane per round (0 = drain lane completely).
+// A critical event waits at most NORMAL + BULK budget dispatches.
+#define EVENT_LANE_CRITICAL_BUDGET  0
+#define EVENT_LANE_NORMAL_BUDGET    4
+#define EVENT_LANE_BULK_BUDGET      2
+
+// ISR Event Ring (lock-free, multi-producer / single-consumer)
+#define EVENT_ISR_QUEUE_SIZE 8  // Must be a power of two
+#define EVENT_ISR_QUEUE_MASK (EVENT_ISR_QUEUE_SIZE - 1)
+
+#if (EVENT_ISR_QUEUE_SIZE & EVENT_ISR_QUEUE_MASK) != 0
+#error "EVENT_ISR_QUEUE_SIZE must be a power of two"
+#endif
 
+// Timer Wheel (delayed / periodic publishing), 1 slot per HAL tick (1 ms)
+#define EVENT_TIMER_WHEEL_SLOTS 32  // Must be a power of two
+#define EVENT_TIMER_WHEEL_MASK  (EVENT_TIMER_WHEEL_SLOTS - 1)
+#define EVENT_TIMER_NONE        0xFF
+
+#if (EVENT_TIMER_WHEEL_SLOTS & EVENT_TIMER_WHEEL_MASK) != 0
+#error "EVENT_TIMER_WHEEL_SLOTS must be a power of two"
+#endif
+
+#define EVENT_SLOT_NONE 0xFF
+
+#if EVENT_BUS_SHARD_COUNT > 8
+#error "EVENT_BUS_SHARD_COUNT must be <= 8 (shard bitmask is 8 bits)"
+#endif
+
+// Rows start on a D-cache line, ordered by use: a publish reads only the
+// first fields (one line), dispatch the callbacks after them, and the
+// filter state comes last
 typedef struct {
-    event_callback_t callbacks[MAX_SUBSCRIBERS_PER_EVENT];
     uint8_t subscriber_count;
-} event_subscriber_list_t;
+    uint8_t shard_mask;                           // Shards with at least one subscriber
+    bool coalesce;                                // Last-value-wins for this type
+    uint8_t pending_mask;                         // Shards holding a coalescable event
+    uint8_t pending_lane[EVENT_BUS_SHARD_COUNT];  // Lane of the queued event per shard
+    uint8_t pending_pos[EVENT_BUS_SHARD_COUNT];   // Ring position of the queued event
+    uint8_t callback_shard[MAX_SUBSCRIBERS_PER_EVENT];  // Shard each callback runs on
+    bool callback_is_batch[MAX_SUBSCRIBERS_PER_EVENT];  // Stored as event_batch_callback_t
+    event_callback_t callbacks[MAX_SUBSCRIBERS_PER_EVENT];
+#if EVENT_BUS_USE_STATIC_SUBSCRIPTIONS
+    uint8_t static_count;                         // Compile-time subscribers
+    event_callback_t* static_first;               // Their run in static_callbacks[]
+#endif
+    const event_filter_t* callback_filter[MAX_SUBSCRIBERS_PER_EVENT];  // NULL = every event
+    float callback_last[MAX_SUBSCRIBERS_PER_EVENT];     // EVENT_FILTER_CHANGED: last delivered
+    bool callback_seen[MAX_SUBSCRIBERS_PER_EVENT];      // callback_last holds a value
+} HAL_CACHE_ALIGNED event_subscriber_list_t;
+
+// Built-in types (event_catalog.h), indexed by id - 1
+typedef struct {
+    uint8_t priority;
+    bool coalesce;
+} event_catalog_entry_t;
+
+#define CATALOG_EVENT_ROW(id, payload_type, priority, coalesce)  { (priority), (coalesce) },
+#define CATALOG_SIGNAL_ROW(id, priority, coalesce)               { (priority), (coalesce) },
+
+static const event_catalog_entry_t event_catalog[] = {
+    EVENT_CATALOG(CATALOG_EVENT_ROW, CATALOG_SIGNAL_ROW)
+};
+
+#define EVENT_CATALOG_COUNT (sizeof(event_catalog) / sizeof(event_catalog[0]))
+
+_Static_assert(EVENT_CATALOG_COUNT < EVENT_USER_DEFINED_START,
+               "event_catalog.h runs into EVENT_USER_DEFINED_START");
+
+// Dense subscription table: event_slot[] maps an event id to a row in
+// subscriber_table[], so only event types that are actually used cost RAM.
+static uint8_t event_slot[EVENT_USER_DEFINED_START];
+static event_subscriber_list_t subscriber_table[EVENT_BUS_MAX_EVENT_TYPES];
+static uint8_t slot_count = 0;
+
+#if EVENT_BUS_USE_STATIC_SUBSCRIPTIONS
+// Flash table built by EVENT_BUS_STATIC_SUBSCRIBE(), sorted by section name
+// in the linker script; event_bus_init() groups its callbacks by type here
+extern const event_static_subscription_t __event_subs_start[];
+extern const event_static_subscription_t __event_subs_end[];
+static event_callback_t static_callbacks[EVENT_BUS_MAX_STATIC_SUBSCRIPTIONS];
+#endif
+
+// Arena bytes held by one queued event
+typedef struct {
+    uint16_t offset;                       // Start of the payload copy
+    uint16_t span;                         // Released at dispatch, wrap skip included
+    uint16_t room;                         // Usable from offset (coalescing reuses it)
+} event_lane_bytes_t;
+
+// Priority lane ring (one per event_priority_t). Copied payloads are laid
+// out in a byte ring in queue order, so they are freed in the same order:
+// a payload that does not fit before the end of the arena skips the tail
+// and starts at offset 0, keeping every payload contiguous.
+typedef struct {
+    event_t* events;
+    event_lane_bytes_t* bytes;             // Arena use per queued event
+    uint8_t* arena;                        // Payload copies
+    uint16_t arena_size;
+    uint16_t arena_head;                   // Oldest byte in use
+    uint16_t arena_tail;                   // Next free byte
+    uint16_t arena_used;                   // Bytes held, wrap skips included
+    uint8_t size;
+    uint8_t head;
+    uint8_t tail;
+    uint8_t count;
+    uint8_t budget;                        // Max events per round, 0 = unlimited
+} event_lane_t;
+
+// Event queues for asynchronous processing, one set of lanes per shard
+static event_t lane_critical_events[EVENT_BUS_SHARD_COUNT][EVENT_LANE_CRITICAL_SIZE] HAL_DTCM_BSS;
+static event_lane_bytes_t lane_critical_bytes[EVENT_BUS_SHARD_COUNT][EVENT_LANE_CRITICAL_SIZE] HAL_DTCM_BSS;
+static uint8_t lane_critical_arena[EVENT_BUS_SHARD_COUNT][EVENT_LANE_CRITICAL_ARENA] HAL_DTCM_BSS
+    __attribute__((aligned(EVENT_ARENA_ALIGN)));
+static event_t lane_normal_events[EVENT_BUS_SHARD_COUNT][EVENT_QUEUE_SIZE] HAL_DTCM_BSS;
+static event_lane_bytes_t lane_normal_bytes[EVENT_BUS_SHARD_COUNT][EVENT_QUEUE_SIZE] HAL_DTCM_BSS;
+static uint8_t lane_normal_arena[EVENT_BUS_SHARD_COUNT][EVENT_LANE_NORMAL_ARENA] HAL_DTCM_BSS
+    __attribute__((aligned(EVENT_ARENA_ALIGN)));
+static event_t lane_bulk_events[EVENT_BUS_SHARD_COUNT][EVENT_LANE_BULK_SIZE] HAL_DTCM_BSS;
+static event_lane_bytes_t lane_bulk_bytes[EVENT_BUS_SHARD_COUNT][EVENT_LANE_BULK_SIZE] HAL_DTCM_BSS;
+static uint8_t lane_bulk_arena[EVENT_BUS_SHARD_COUNT][EVENT_LANE_BULK_ARENA] HAL_DTCM_BSS
+    __attribute__((aligned(EVENT_ARENA_ALIGN)));
+
+static event_lane_t lanes[EVENT_BUS_SHARD_COUNT][EVENT_PRIORITY_COUNT] HAL_DTCM_BSS;
+
+static const uint8_t default_lane_budget[EVENT_PRIORITY_COUNT] = {
+    [EVENT_PRIORITY_CRITICAL] = EVENT_LANE_CRITICAL_BUDGET,
+    [EVENT_PRIORITY_NORMAL]   = EVENT_LANE_NORMAL_BUDGET,
+    [EVENT_PRIORITY_BULK]     = EVENT_LANE_BULK_BUDGET,
+};
+
+// ISR ring slot. 'sequence' tells producers and the consumer who owns the
+// slot: == position means free for the producer claiming that position,
+// == position + 1 means filled and ready for the consumer.
+typedef struct {
+    volatile uint32_t sequence;
+    event_type_t type;
+    uint32_t data_size;
+    uint32_t timestamp;
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+    uint32_t publish_cycles;
+#endif
+    uint8_t data[MAX_EVENT_DATA_SIZE];
+} event_isr_slot_t;
+
+static event_isr_slot_t isr_queue[EVENT_ISR_QUEUE_SIZE] HAL_DTCM_BSS;
+static volatile uint32_t isr_queue_tail HAL_DTCM_BSS;   // Claimed by producers (CAS)
+static uint32_t isr_queue_head HAL_DTCM_BSS;            // Owned by event_bus_process()
 
-// Global event subscription table
-static event_subscriber_list_t subscriber_table[EVENT_USER_DEFINED_START];
+// Statistics tracking. Every publish and dispatch writes it, so it sits in
+// DTCM with the lanes and never costs a D-cache line fill or eviction
+static event_bus_stats_t stats HAL_DTCM_BSS;
+
+// Timer entry: linked into the wheel slot its expiry hashes to
+typedef struct {
+    event_type_t type;
+    uint32_t period_ticks;       // 0 = one-shot
+    uint32_t expiry_tick;        // Absolute tick the timer fires at
+    uint16_t rounds;             // Full wheel turns left before it fires
+    uint8_t next;                // Next timer in the same wheel slot
+    uint8_t generation;          // Invalidates stale handles
+    bool active;
+    uint32_t data_size;
+    uint8_t data[MAX_EVENT_DATA_SIZE];
+} event_timer_t;
+
+static event_timer_t timers[EVENT_BUS_MAX_TIMERS];
+static uint8_t timer_wheel[EVENT_TIMER_WHEEL_SLOTS];   // Head index per slot
+static uint32_t timer_last_tick = 0;                   // Last tick already processed
+static uint8_t timer_active_count = 0;
+
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+// Latency histograms, one per subscriber_table row. Shards update them
+// without locking, so counts are approximate when shards run concurrently.
+static event_bus_latency_t latency_table[EVENT_BUS_MAX_EVENT_TYPES];
+
+/**
+ * @brief Map a cycle count to its log2 histogram bucket
+ */
+static inline uint8_t latency_bucket(uint32_t cycles)
+{
+    uint32_t scaled = cycles >> EVENT_LATENCY_BUCKET_BASE_SHIFT;
+    uint8_t bucket = (scaled == 0) ? 0 : (uint8_t)(31 - __builtin_clz(scaled));
+    return (bucket < EVENT_LATENCY_BUCKET_COUNT) ? bucket : (EVENT_LATENCY_BUCKET_COUNT - 1);
+}
+#endif
+
+#if EVENT_BUS_USE_DISPATCH_TASK
+// Dispatch tasks: one per shard, each blocking on its own semaphore.
+// bus_mutex guards lane bookkeeping once a second task touches the bus.
+#define EVENT_DISPATCH_TASK_STACK_SIZE  4096
+
+static const uint8_t shard_task_priority[EVENT_BUS_SHARD_COUNT] = {
+    [EVENT_SHARD_DEFAULT]    = OS_PRIORITY_ISR_DEFERRED,
+    [EVENT_SHARD_BACKGROUND] = OS_PRIORITY_NORMAL,
+};
+
+static const char* const shard_task_name[EVENT_BUS_SHARD_COUNT] = {
+    [EVENT_SHARD_DEFAULT]    = "event_bus",
+    [EVENT_SHARD_BACKGROUND] = "event_bus_bg",
+};
+
+static os_semaphore_handle_t dispatch_sem[EVENT_BUS_SHARD_COUNT] = {0};
+static os_task_handle_t dispatch_task_handle[EVENT_BUS_SHARD_COUNT] = {0};
+static os_mutex_handle_t bus_mutex = NULL;
+static bool dispatch_tasks_running = false;
+
+// Kernel objects live in static storage
+OS_MUTEX_DEFINE(bus);
+static os_semaphore_storage_t dispatch_sem_storage[EVENT_BUS_SHARD_COUNT];
+static uint32_t dispatch_task_stack[EVENT_BUS_SHARD_COUNT][EVENT_DISPATCH_TASK_STACK_SIZE / 4]
+    __attribute__((aligned(8)));
+static os_task_storage_t dispatch_task_storage[EVENT_BUS_SHARD_COUNT];
+
+#define BUS_LOCK()      do { if (bus_mutex != NULL) { os_mutex_take(bus_mutex, OS_WAIT_FOREVER); } } while (0)
+#define BUS_UNLOCK()    do { if (bus_mutex != NULL) { os_mutex_give(bus_mutex); } } while (0)
+#define BUS_SIGNAL(shard) \
+    do { if (dispatch_sem[(shard)] != NULL) { os_semaphore_give(dispatch_sem[(shard)]); } } while (0)
+#else
+#define BUS_LOCK()      do {} while (0)
+#define BUS_UNLOCK()    do {} while (0)
+#define BUS_SIGNAL(shard) do { (void)(shard); } while (0)
+#endif
+
+/**
+ * @brief Find the subscription row of an event type
+ * @param event_type Type of event
+ * @param create Allocate a row if the type has none yet
+ * @return Subscriber list, or NULL if none (or table full)
+ */
+static event_subscriber_list_t* get_subscriber_list(event_type_t event_type, bool create)
+{
+    uint8_t slot = event_slot[event_type];
+
+    if (slot != EVENT_SLOT_NONE) {
+        return &subscriber_table[slot];
+    }
+
+    if (!create || slot_count >= EVENT_BUS_MAX_EVENT_TYPES) {
+        return NULL;
+    }
+
+    slot = slot_count++;
+    event_slot[event_type] = slot;
+    memset(&subscriber_table[slot], 0, sizeof(subscriber_table[slot]));
+    return &subscriber_table[slot];
+}
+
+#if EVENT_BUS_USE_STATIC_SUBSCRIPTIONS
+/**
+ * @brief Index the compile-time subscriptions from flash
+ *
+ * The section name is the type as spelled at the EVENT_BUS_STATIC_SUBSCRIBE()
+ * site, so one type written as an alias, a number or a cast gets a run of
+ * its own in the sorted table. The first pass counts each type's entries,
+ * the second copies the callbacks into one run per type in
+ * static_callbacks[] (table order kept), so dispatch needs no search.
+ * Entries that cannot be indexed are logged and dropped.
+ */
+static void index_static_subscriptions(void)
+{
+    const event_static_subscription_t* entry;
+    uint32_t total = 0;
+
+    for (entry = __event_subs_start; entry < __event_subs_end; entry++) {
+        if (entry->type >= EVENT_USER_DEFINED_START) {
+            LOG_E(TAG, "Static subscription to user type %u dropped", (unsigned)entry->type);
+            continue;
+        }
+        if (total >= EVENT_BUS_MAX_STATIC_SUBSCRIPTIONS) {
+            LOG_E(TAG, "Static subscription to type %u dropped, raise EVENT_BUS_MAX_STATIC_SUBSCRIPTIONS",
+                  (unsigned)entry->type);
+            continue;
+        }
+        event_subscriber_list_t* list = get_subscriber_list(entry->type, true);
+        if (list == NULL) {
+            LOG_E(TAG, "Static subscription to type %u dropped, raise EVENT_BUS_MAX_EVENT_TYPES",
+                  (unsigned)entry->type);
+            continue;
+        }
+        list->static_count++;
+        total++;
+    }
 
-// Event queue for asynchronous processing
-static event_t event_queue[EVENT_QUEUE_SIZE];
-static uint8_t event_data_buffer[EVENT_QUEUE_SIZE][MAX_EVENT_DATA_SIZE];  // Buffer to store event data copies
-static uint8_t queue_head = 0;
-static uint8_t queue_tail = 0;
-static uint8_t queue_count = 0;
+    // One run per type, then fill them in the same order the first pass counted
+    uint32_t offset = 0;
+    for (uint8_t slot = 0; slot < slot_count; slot++) {
+        event_subscriber_list_t* list = &subscriber_table[slot];
+        list->static_first = &static_callbacks[offset];
+        offset += list->static_count;
+        list->static_count = 0;
+    }
 
-// Statistics tracking
-static event_bus_stats_t stats = {0};
+    uint32_t placed = 0;
+    for (entry = __event_subs_start; entry < __event_subs_end && placed < total; entry++) {
+        event_subscriber_list_t* list = (entry->type < EVENT_USER_DEFINED_START)
+                                            ? get_subscriber_list(entry->type, false) : NULL;
+        if (list != NULL) {
+            list->static_first[list->static_count++] = entry->callback;
+            placed++;
+        }
+    }
+}
+#endif
 
 /**
  * @brief Initialize the event bus
  */
 void event_bus_init(void)
 {
+    // Reset payload pool
+    event_pool_init();
+
     // Clear subscriber table
+    memset(event_slot, EVENT_SLOT_NONE, sizeof(event_slot));
     memset(subscriber_table, 0, sizeof(subscriber_table));
+    slot_count = 0;
+#if EVENT_BUS_USE_STATIC_SUBSCRIPTIONS
+    index_static_subscriptions();
+#endif
+
+    // Coalescing types from the catalog
+    for (uint32_t i = 0; i < EVENT_CATALOG_COUNT; i++) {
+        if (event_catalog[i].coalesce) {
+            event_subscriber_list_t* list = get_subscriber_list((event_type_t)(i + 1U), true);
+            if (list != NULL) {
+                list->coalesce = true;
+            }
+        }
+    }
+
+    // Clear event queues
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        lanes[shard][EVENT_PRIORITY_CRITICAL] = (event_lane_t){
+            .events = lane_critical_events[shard], .bytes = lane_critical_bytes[shard],
+            .arena = lane_critical_arena[shard], .arena_size = EVENT_LANE_CRITICAL_ARENA,
+            .size = EVENT_LANE_CRITICAL_SIZE };
+        lanes[shard][EVENT_PRIORITY_NORMAL] = (event_lane_t){
+            .events = lane_normal_events[shard], .bytes = lane_normal_bytes[shard],
+            .arena = lane_normal_arena[shard], .arena_size = EVENT_LANE_NORMAL_ARENA,
+            .size = EVENT_QUEUE_SIZE };
+        lanes[shard][EVENT_PRIORITY_BULK] = (event_lane_t){
+            .events = lane_bulk_events[shard], .bytes = lane_bulk_bytes[shard],
+            .arena = lane_bulk_arena[shard], .arena_size = EVENT_LANE_BULK_ARENA,
+            .size = EVENT_LANE_BULK_SIZE };
+
+        for (uint8_t p = 0; p < EVENT_PRIORITY_COUNT; p++) {
+            lanes[shard][p].budget = default_lane_budget[p];
+        }
+    }
+
+    // Clear timer wheel
+    memset(timers, 0, sizeof(timers));
+    memset(timer_wheel, EVENT_TIMER_NONE, sizeof(timer_wheel));
+    timer_last_tick = event_bus_get_tick();
+    timer_active_count = 0;
 
-    // Clear event queue
-    queue_head = 0;
-    queue_tail = 0;
-    queue_count = 0;
+    // Clear ISR ring and hand every slot back to producers
+    for (uint32_t i = 0; i < EVENT_ISR_QUEUE_SIZE; i++) {
+        isr_queue[i].sequence = i;
+    }
+    isr_queue_head = 0;
+    __atomic_store_n(&isr_queue_tail, 0, __ATOMIC_RELEASE);
 
     // Reset statistics
     memset(&stats, 0, sizeof(stats));
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+    memset(latency_table, 0, sizeof(latency_table));
+#endif
+
+#if EVENT_TRACE_ENABLE && EVENT_TRACE_AUTOSTART
+    event_trace_start();
+#endif
 }
 
 /**
- * @brief Subscribe to an event type
- * @param event_type Type of event to subscribe to
- * @param callback Callback function to call when event occurs
- * @return true if subscription successful, false otherwise
+ * @brief Add a subscriber (caller holds the bus lock)
  */
-bool event_bus_subscribe(event_type_t event_type, event_callback_t callback)
+static bool subscribe_locked(event_type_t event_type, event_callback_t callback, uint8_t shard,
+                             bool is_batch, const event_filter_t* filter)
 {
-    if (event_type >= EVENT_USER_DEFINED_START || callback == NULL) {
-        return false;
+    event_subscriber_list_t* list = get_subscriber_list(event_type, true);
+    if (list == NULL) {
+        return false; // No free event type slot
     }
     
-    event_subscriber_list_t* list = &subscriber_table[event_type];
-    
     // Check if already subscribed
     for (uint8_t i = 0; i < list->subscriber_count; i++) {
         if (list->callbacks[i] == callback) {
@@ -65,7 +437,12 @@ bool event_bus_subscribe(event_type_t event_type, event_callback_t callback)
     // Add new subscriber
     if (list->subscriber_count < MAX_SUBSCRIBERS_PER_EVENT) {
         list->callbacks[list->subscriber_count] = callback;
+        list->callback_shard[list->subscriber_count] = shard;
+        list->callback_is_batch[list->subscriber_count] = is_batch;
+        list->callback_filter[list->subscriber_count] = filter;
+        list->callback_seen[list->subscriber_count] = false;
         list->subscriber_count++;
+        list->shard_mask |= (uint8_t)(1u << shard);
         return true;
     }
     
@@ -73,18 +450,138 @@ bool event_bus_subscribe(event_type_t event_type, event_callback_t callback)
 }
 
 /**
- * @brief Unsubscribe from an event type
- * @param event_type Type of event to unsubscribe from
- * @param callback Callback function to remove
- * @return true if unsubscription successful, false otherwise
+ * @brief Subscribe to an event type
+ * @param event_type Type of event to subscribe to
+ * @param callback Callback function to call when event occurs
+ * @return true if subscription successful, false otherwise
  */
-bool event_bus_unsubscribe(event_type_t event_type, event_callback_t callback)
+bool event_bus_subscribe(event_type_t event_type, event_callback_t callback)
+{
+    return event_bus_subscribe_on_shard(event_type, callback, EVENT_SHARD_DEFAULT);
+}
+
+/**
+ * @brief Subscribe to an event type on a specific dispatch shard
+ *
+ * Each shard has its own lanes and (with the dispatch task) its own task,
+ * so a slow subscriber on one shard cannot delay subscribers on another.
+ * An event is queued once on every shard that has a subscriber for it.
+ *
+ * @param event_type Type of event to subscribe to
+ * @param callback Callback function to call when event occurs
+ * @param shard Shard whose task runs the callback
+ * @return true if subscription successful, false otherwise
+ */
+bool event_bus_subscribe_on_shard(event_type_t event_type, event_callback_t callback, uint8_t shard)
+{
+    if (event_type >= EVENT_USER_DEFINED_START || callback == NULL
+        || shard >= EVENT_BUS_SHARD_COUNT) {
+        return false;
+    }
+
+    BUS_LOCK();
+    bool result = subscribe_locked(event_type, callback, shard, false, NULL);
+    BUS_UNLOCK();
+
+    return result;
+}
+
+/**
+ * @brief Subscribe to an event type with a batched callback
+ *
+ * The callback receives the record span directly. Events that were not
+ * published with event_bus_publish_batch() are passed as one record of
+ * event->data_size bytes. Runs on the default shard.
+ *
+ * @param event_type Type of event to subscribe to
+ * @param callback Batched callback
+ * @return true if subscription successful, false otherwise
+ */
+bool event_bus_subscribe_batch(event_type_t event_type, event_batch_callback_t callback)
 {
     if (event_type >= EVENT_USER_DEFINED_START || callback == NULL) {
         return false;
     }
-    
-    event_subscriber_list_t* list = &subscriber_table[event_type];
+
+    BUS_LOCK();
+    bool result = subscribe_locked(event_type, (event_callback_t)callback, EVENT_SHARD_DEFAULT, true, NULL);
+    BUS_UNLOCK();
+
+    return result;
+}
+
+/**
+ * @brief Subscribe with a filter checked before each delivery
+ *
+ * The filter runs on the shard's dispatch task just before the callback
+ * would, so an event the subscriber does not want costs the check only.
+ * The bus keeps the pointer: the filter must outlive the subscription
+ * (a static const is the usual case). A callback that is already
+ * subscribed keeps its filter; change it with event_bus_set_filter().
+ *
+ * @param event_type Type of event to subscribe to
+ * @param callback Callback function to call when event occurs
+ * @param shard Shard whose task runs the callback
+ * @param filter Filter, or NULL for every event
+ * @return true if subscription successful, false otherwise
+ */
+bool event_bus_subscribe_filtered(event_type_t event_type, event_callback_t callback, uint8_t shard,
+                                  const event_filter_t* filter)
+{
+    if (event_type >= EVENT_USER_DEFINED_START || callback == NULL
+        || shard >= EVENT_BUS_SHARD_COUNT) {
+        return false;
+    }
+
+    BUS_LOCK();
+    bool result = subscribe_locked(event_type, callback, shard, false, filter);
+    BUS_UNLOCK();
+
+    return result;
+}
+
+/**
+ * @brief Replace the filter of a subscription
+ *
+ * An EVENT_FILTER_CHANGED filter starts over: the next event passes.
+ *
+ * @param event_type Type the callback is subscribed to
+ * @param callback Subscribed callback (plain or batched)
+ * @param filter New filter, or NULL for every event
+ * @return false if the callback is not subscribed to the type
+ */
+bool event_bus_set_filter(event_type_t event_type, event_callback_t callback,
+                          const event_filter_t* filter)
+{
+    if (event_type >= EVENT_USER_DEFINED_START || callback == NULL) {
+        return false;
+    }
+
+    bool result = false;
+    BUS_LOCK();
+    event_subscriber_list_t* list = get_subscriber_list(event_type, false);
+    for (uint8_t i = 0; list != NULL && i < list->subscriber_count; i++) {
+        if (list->callbacks[i] == callback) {
+            list->callback_filter[i] = filter;
+            list->callback_seen[i] = false;
+            result = true;
+            break;
+        }
+    }
+    BUS_UNLOCK();
+
+    return result;
+}
+
+/**
+ * @brief Remove a subscriber (caller holds the bus lock)
+ */
+static bool unsubscribe_locked(event_type_t event_type, event_callback_t callback)
+{
+    event_subscriber_list_t* list = get_subscriber_list(event_type, false);
+    if (list == NULL) {
+        return false; // Nothing subscribed to this type
+    }
     
     // Find and remove callback
     for (uint8_t i = 0; i < list->subscriber_count; i++) {
@@ -92,8 +589,19 @@ bool event_bus_unsubscribe(event_type_t event_type, event_callback_t callback)
             // Shift remaining callbacks down
             for (uint8_t j = i; j < list->subscriber_count - 1; j++) {
                 list->callbacks[j] = list->callbacks[j + 1];
+                list->callback_shard[j] = list->callback_shard[j + 1];
+                list->callback_is_batch[j] = list->callback_is_batch[j + 1];
+                list->callback_filter[j] = list->callback_filter[j + 1];
+                list->callback_last[j] = list->callback_last[j + 1];
+                list->callback_seen[j] = list->callback_seen[j + 1];
             }
             list->subscriber_count--;
+
+            // Rebuild shard mask from the remaining subscribers
+            list->shard_mask = 0;
+            for (uint8_t j = 0; j < list->subscriber_count; j++) {
+                list->shard_mask |= (uint8_t)(1u << list->callback_shard[j]);
+            }
             return true;
         }
     }
@@ -101,6 +609,50 @@ bool event_bus_unsubscribe(event_type_t event_type, event_callback_t callback)
     return false; // Callback not found
 }
 
+/**
+ * @brief Unsubscribe from an event type
+ * @param event_type Type of event to unsubscribe from
+ * @param callback Callback function to remove
+ * @return true if unsubscription successful, false otherwise
+ */
+bool event_bus_unsubscribe(event_type_t event_type, event_callback_t callback)
+{
+    if (event_type >= EVENT_USER_DEFINED_START || callback == NULL) {
+        return false;
+    }
+
+    BUS_LOCK();
+    bool result = unsubscribe_locked(event_type, callback);
+    BUS_UNLOCK();
+
+    return result;
+}
+
+/**
+ * @brief Remove a batched subscriber
+ * @param event_type Type of event to unsubscribe from
+ * @param callback Batched callback to remove
+ * @return true if unsubscription successful, false otherwise
+ */
+bool event_bus_unsubscribe_batch(event_type_t event_type, event_batch_callback_t callback)
+{
+    return event_bus_unsubscribe(event_type, (event_callback_t)callback);
+}
+
+/**
+ * @brief Get the default priority lane for an event type
+ * @param event_type Type of event
+ * @return Lane used by event_bus_publish() for this type (event_catalog.h row,
+ *         normal for user-defined types)
+ */
+event_priority_t event_bus_get_default_priority(event_type_t event_type)
+{
+    if (event_type > EVENT_NONE && (uint32_t)event_type <= EVENT_CATALOG_COUNT) {
+        return (event_priority_t)event_catalog[event_type - 1].priority;
+    }
+    return EVENT_PRIORITY_NORMAL;
+}
+
 /**
  * @brief Publish an event to the event bus
  * @param event_type Type of event to publish
@@ -110,106 +662,1458 @@ bool event_bus_unsubscribe(event_type_t event_type, event_callback_t callback)
  */
 bool event_bus_publish(event_type_t event_type, void* data, uint32_t data_size)
 {
-    if (queue_count >= EVENT_QUEUE_SIZE) {
-        stats.queue_overflow_count++;
-        stats.publish_fail_count++;
-        return false; // Queue full
-    }
+    return event_bus_publish_prio(event_type, event_bus_get_default_priority(event_type),
+                                  data, data_size);
+}
 
-    if (data_size > MAX_EVENT_DATA_SIZE) {
-        stats.data_too_large_count++;
-        stats.publish_fail_count++;
-        return false; // Data too large
+/**
+ * @brief Get the shards an event type is delivered to
+ * @param list Subscriber list of the type (may be NULL)
+ * @return Shard bitmask, the default shard if nobody subscribed
+ */
+static uint8_t target_shards(const event_subscriber_list_t* list)
+{
+    if (list == NULL || list->shard_mask == 0) {
+        return (uint8_t)(1u << EVENT_SHARD_DEFAULT);
     }
+    return list->shard_mask;
+}
 
-    // Add event to queue
-    event_t* event = &event_queue[queue_tail];
-    event->type = event_type;
-    event->data_size = data_size;
-    event->timestamp = event_bus_get_tick();
-
-    // Copy event data into buffer to prevent stack corruption
-    if (data != NULL && data_size > 0) {
-        memcpy(event_data_buffer[queue_tail], data, data_size);
-        event->data = event_data_buffer[queue_tail];
-    } else {
-        event->data = NULL;
+/**
+ * @brief Whether anyone would receive an event of a subscriber list
+ */
+static inline bool list_has_subscribers(const event_subscriber_list_t* list)
+{
+    if (list == NULL) {
+        return false;
     }
+#if EVENT_BUS_USE_STATIC_SUBSCRIPTIONS
+    return list->subscriber_count > 0 || list->static_count > 0;
+#else
+    return list->subscriber_count > 0;
+#endif
+}
 
-    queue_tail = (queue_tail + 1) % EVENT_QUEUE_SIZE;
-    queue_count++;
-
-    // Update statistics
-    stats.publish_success_count++;
-    if (queue_count > stats.max_queue_depth) {
-        stats.max_queue_depth = queue_count;
+/**
+ * @brief Check whether an event type has any subscriber
+ *
+ * Lock-free and safe from ISRs. Lets a publisher skip building a payload
+ * nobody consumes; a subscriber added right after the check misses that
+ * one event, as it would have if it had subscribed a moment later.
+ *
+ * @param event_type Type of event
+ * @return true if at least one runtime or static subscriber exists
+ */
+bool event_bus_has_subscribers(event_type_t event_type)
+{
+    if (event_type >= EVENT_USER_DEFINED_START) {
+        return false;
     }
 
-    return true;
+    uint8_t slot = __atomic_load_n(&event_slot[event_type], __ATOMIC_RELAXED);
+    return slot != EVENT_SLOT_NONE && list_has_subscribers(&subscriber_table[slot]);
 }
 
 /**
- * @brief Process pending events in the queue
- * 
- * This should be called periodically from the main loop or RTOS task
+ * @brief Find room for a payload copy in a lane's arena
+ * @param lane Lane to queue on
+ * @param data_size Payload size in bytes (> 0)
+ * @param offset Output: start of the copy
+ * @param span Output: arena bytes it would hold, wrap skip included
+ * @return true if the payload fits
  */
-void event_bus_process(void)
+static bool arena_place(const event_lane_t* lane, uint32_t data_size, uint16_t* offset, uint16_t* span)
 {
-    while (queue_count > 0) {
-        // Get next event from queue
-        event_t* event = &event_queue[queue_head];
+    uint32_t need = EVENT_ARENA_ROUND(data_size);
+    uint32_t head = lane->arena_head;
+    uint32_t tail = lane->arena_tail;
 
-        // Notify all subscribers
-        if (event->type < EVENT_USER_DEFINED_START) {
-            event_subscriber_list_t* list = &subscriber_table[event->type];
+    if (lane->arena_used == 0) {
+        // Empty: start over at the front for the longest contiguous run
+        *offset = 0;
+        *span = (uint16_t)need;
+        return need <= lane->arena_size;
+    }
 
-            for (uint8_t i = 0; i < list->subscriber_count; i++) {
-                if (list->callbacks[i] != NULL) {
-                    list->callbacks[i](event);
-                }
-            }
+    if (tail > head) {
+        // In use: [head, tail). Free: [tail, end) then [0, head)
+        if (need <= lane->arena_size - tail) {
+            *offset = (uint16_t)tail;
+            *span = (uint16_t)need;
+            return true;
         }
-
-        // Move to next event
-        queue_head = (queue_head + 1) % EVENT_QUEUE_SIZE;
-        queue_count--;
-
-        // Update process count
-        stats.process_count++;
+        if (need <= head) {
+            *offset = 0;
+            *span = (uint16_t)(lane->arena_size - tail + need);
+            return true;
+        }
+        return false;
     }
+
+    // Wrapped: free is [tail, head)
+    *offset = (uint16_t)tail;
+    *span = (uint16_t)need;
+    return need <= head - tail;
 }
 
 /**
- * @brief Get current system tick for timestamp
- * @return Current tick count
+ * @brief Claim arena bytes for a payload copy
+ * @param bytes Output: what the queued event holds
+ * @return Start of the copy, NULL if it does not fit
  */
-uint32_t event_bus_get_tick(void)
+static uint8_t* arena_take(event_lane_t* lane, uint32_t data_size, event_lane_bytes_t* bytes)
 {
-    return hal_get_tick();
+    uint16_t offset;
+    uint16_t span;
+
+    if (!arena_place(lane, data_size, &offset, &span)) {
+        return NULL;
+    }
+
+    uint16_t room = (uint16_t)EVENT_ARENA_ROUND(data_size);
+    if (lane->arena_used == 0) {
+        lane->arena_head = 0;
+    }
+    lane->arena_tail = (uint16_t)((offset + room) % lane->arena_size);
+    lane->arena_used = (uint16_t)(lane->arena_used + span);
+
+    *bytes = (event_lane_bytes_t){ offset, span, room };
+    return &lane->arena[offset];
 }
 
 /**
- * @brief Get event bus statistics
- * @return Copy of current statistics
+ * @brief Check whether a publish merges into the pending event of its type
+ *
+ * A copied payload must fit the arena bytes of the pending one; if it
+ * does not, it is queued as a new event instead.
  */
-event_bus_stats_t event_bus_get_stats(void)
+static bool merges_pending(const event_subscriber_list_t* list, uint8_t shard,
+                           const void* data, uint32_t data_size, bool copy)
 {
-    return stats;
+    if (!list->coalesce || !(list->pending_mask & (1u << shard))) {
+        return false;
+    }
+    if (!copy || data == NULL || data_size == 0) {
+        return true;
+    }
+
+    const event_lane_t* lane = &lanes[shard][list->pending_lane[shard]];
+    return data_size <= lane->bytes[list->pending_pos[shard]].room;
 }
 
 /**
- * @brief Reset event bus statistics
+ * @brief Fill an event slot with a new payload
  */
-void event_bus_reset_stats(void)
+static void fill_event(event_t* event, uint8_t* buffer, void* data, uint32_t data_size, bool copy,
+                       uint16_t record_size, uint16_t record_count)
 {
-    memset(&stats, 0, sizeof(stats));
+    event->data_size = data_size;
+    event->record_size = record_size;
+    event->record_count = record_count;
+    event->timestamp = event_bus_get_timestamp_us();
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+    event->publish_cycles = hal_get_cycle_count();
+#endif
+
+    if (!copy) {
+        event->data = data;
+    } else if (data != NULL && data_size > 0) {
+        // Copy event data into buffer to prevent stack corruption
+        memcpy(buffer, data, data_size);
+        event->data = buffer;
+    } else {
+        event->data = NULL;
+    }
 }
 
 /**
- * @brief Get current queue depth
- * @return Number of events currently in queue
- */
+ * @brief Queue an event on the lanes of a set of shards
+ *
+ * All-or-nothing: if any target lane is full (no free entry, or no
+ * contiguous arena room for a copied payload) the event is queued
+ * nowhere. Pooled payloads get one reference per target shard. An event type
+ * without subscribers is dropped here and counts as published: nothing
+ * is stamped, copied or queued, and no reference is taken. The reference
+ * the publisher handed over is then dropped by lane_enqueue(), not by the
+ * publisher.
+ *
+ * @param event_type Type of event to publish
+ * @param priority Lane to queue the event on
+ * @param data Pointer to event data
+ * @param data_size Size of event data in bytes
+ * @param copy true to copy data into the lane buffer, false to reference it
+ * @param record_size Record size for batch events (0 = not a batch)
+ * @param record_count Number of records for batch events
+ * @param shards Bitmask of target shards
+ * @param woken Output: bitmask of shards that got a new queue entry
+ * @return true if event queued (or merged), false otherwise
+ */
+static bool enqueue_locked(event_type_t event_type, event_priority_t priority,
+                           void* data, uint32_t data_size, bool copy,
+                           uint16_t record_size, uint16_t record_count,
+                           uint8_t shards, uint8_t* woken)
+{
+    *woken = 0;
+
+    if (priority >= EVENT_PRIORITY_COUNT) {
+        stats.publish_fail_count++;
+        return false;
+    }
+
+    if (copy && data_size > MAX_EVENT_DATA_SIZE) {
+        stats.data_too_large_count++;
+        stats.publish_fail_count++;
+        return false; // Data too large
+    }
+
+    event_subscriber_list_t* list = NULL;
+    if (event_type < EVENT_USER_DEFINED_START) {
+        list = get_subscriber_list(event_type, false);
+    }
+
+    // Nobody to dispatch to: skip the copy and the lane slot
+    if (!list_has_subscribers(list)) {
+        // Atomic: the ISR path counts it too, without the lock
+        __atomic_fetch_add(&stats.elided_count, 1, __ATOMIC_RELAXED);
+        stats.publish_success_count++;
+        return true;
+    }
+
+    bool coalesce = list->coalesce;
+    bool arena = copy && data != NULL && data_size > 0;
+
+    // Check room on every target shard first
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        if (!(shards & (1u << shard))) {
+            continue;
+        }
+        if (merges_pending(list, shard, data, data_size, copy)) {
+            continue; // Will be merged in place
+        }
+
+        event_lane_t* lane = &lanes[shard][priority];
+        uint16_t offset;
+        uint16_t span;
+        if (lane->count >= lane->size || (arena && !arena_place(lane, data_size, &offset, &span))) {
+            stats.queue_overflow_count++;
+            stats.publish_fail_count++;
+            stats.lanes[priority].overflow_count++;
+            return false; // Queue full
+        }
+    }
+
+    bool first = true;
+
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        if (!(shards & (1u << shard))) {
+            continue;
+        }
+
+        // Caller's pooled reference covers the first shard, retain for the rest
+        if (!copy && !first) {
+            event_pool_retain(data);
+        }
+        first = false;
+
+        // Last-value-wins: overwrite the queued event of this type in place
+        if (merges_pending(list, shard, data, data_size, copy)) {
+            event_lane_t* pending_lane = &lanes[shard][list->pending_lane[shard]];
+            uint8_t pos = list->pending_pos[shard];
+            event_t* event = &pending_lane->events[pos];
+
+            if (event->data != NULL && event_pool_owns(event->data)) {
+                event_pool_release(event->data);
+            }
+
+            fill_event(event, &pending_lane->arena[pending_lane->bytes[pos].offset], data, data_size,
+                       copy, record_size, record_count);
+            stats.coalesced_count++;
+            continue;
+        }
+
+        // Add event to queue
+        event_lane_t* lane = &lanes[shard][priority];
+        event_bus_lane_stats_t* lane_stats = &stats.lanes[priority];
+        event_t* event = &lane->events[lane->tail];
+        event_lane_bytes_t* bytes = &lane->bytes[lane->tail];
+        uint8_t* buffer = NULL;
+
+        *bytes = (event_lane_bytes_t){ 0, 0, 0 };
+        if (arena) {
+            buffer = arena_take(lane, data_size, bytes);   // Checked above
+            if (lane->arena_used > lane_stats->max_arena_bytes) {
+                lane_stats->max_arena_bytes = lane->arena_used;
+            }
+        }
+
+        event->type = event_type;
+        fill_event(event, buffer, data, data_size, copy, record_size, record_count);
+
+        if (coalesce) {
+            list->pending_mask |= (uint8_t)(1u << shard);
+            list->pending_lane[shard] = (uint8_t)priority;
+            list->pending_pos[shard] = lane->tail;
+        }
+
+        lane->tail = (lane->tail + 1) % lane->size;
+        lane->count++;
+        *woken |= (uint8_t)(1u << shard);
+
+        lane_stats->publish_count++;
+        if (lane->count > lane_stats->max_depth) {
+            lane_stats->max_depth = lane->count;
+        }
+    }
+
+    // Update statistics
+    stats.publish_success_count++;
+
+    uint32_t depth = event_bus_get_queue_depth();
+    if (depth > stats.max_queue_depth) {
+        stats.max_queue_depth = depth;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Queue an event on its target shards and wake their dispatchers
+ */
+static bool lane_enqueue(event_type_t event_type, event_priority_t priority,
+                         void* data, uint32_t data_size, bool copy,
+                         uint16_t record_size, uint16_t record_count)
+{
+    SYSVIEW_TRACE_U32(SYSVIEW_EVT_BUS_PUBLISH, event_type);
+
+    BUS_LOCK();
+    event_subscriber_list_t* list = (event_type < EVENT_USER_DEFINED_START)
+                                        ? get_subscriber_list(event_type, false) : NULL;
+    bool elided = !list_has_subscribers(list);
+    uint8_t woken;
+    bool result = enqueue_locked(event_type, priority, data, data_size, copy,
+                                 record_size, record_count, target_shards(list), &woken);
+    // Under the lock, so task publishes are recorded in queue order
+    EVENT_TRACE_RECORD(event_type,
+                       (record_size != 0) ? EVENT_TRACE_SRC_BATCH
+                                          : (copy ? EVENT_TRACE_SRC_TASK : EVENT_TRACE_SRC_POOLED),
+                       priority, data, data_size, record_size,
+                       !result ? EVENT_TRACE_REJECTED
+                               : (elided ? EVENT_TRACE_ELIDED : EVENT_TRACE_QUEUED));
+    BUS_UNLOCK();
+
+    // Elided: the bus took ownership of a pooled payload and has no use for it
+    if (result && elided && !copy && data != NULL) {
+        event_pool_release(data);
+    }
+
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        if (woken & (1u << shard)) {
+            BUS_SIGNAL(shard);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Count a publish rejected before it reached the lanes
+ *
+ * enqueue_locked() bumps the same counters with BUS_LOCK held, so the
+ * early checks take the lock too rather than racing it.
+ *
+ * @param too_large true if the payload did not fit, as well as failing
+ */
+static void count_rejected(bool too_large)
+{
+    BUS_LOCK();
+    if (too_large) {
+        stats.data_too_large_count++;
+    }
+    stats.publish_fail_count++;
+    BUS_UNLOCK();
+}
+
+/**
+ * @brief Publish an event on an explicit priority lane
+ * @param event_type Type of event to publish
+ * @param priority Lane to queue the event on
+ * @param data Pointer to event data (will be copied)
+ * @param data_size Size of event data in bytes
+ * @return true if event published successfully, false otherwise
+ */
+bool event_bus_publish_prio(event_type_t event_type, event_priority_t priority,
+                            void* data, uint32_t data_size)
+{
+    return lane_enqueue(event_type, priority, data, data_size, true, 0, 0);
+}
+
+/**
+ * @brief Publish a pooled payload without copying it
+ *
+ * On success the bus takes over the caller's reference and releases it
+ * after the last subscriber returns. On failure the caller still owns the
+ * reference and must call event_pool_release().
+ *
+ * @param event_type Type of event to publish
+ * @param payload Pointer returned by event_pool_alloc()
+ * @param data_size Number of valid payload bytes
+ * @return true if event published successfully, false otherwise
+ */
+bool event_bus_publish_pooled(event_type_t event_type, void* payload, uint32_t data_size)
+{
+    if (!event_pool_owns(payload) || data_size > EVENT_POOL_BLOCK_SIZE) {
+        count_rejected(false);
+        return false;
+    }
+
+    return lane_enqueue(event_type, event_bus_get_default_priority(event_type),
+                        payload, data_size, false, 0, 0);
+}
+
+/**
+ * @brief Publish N homogeneous records as one event
+ *
+ * Subscribers see a single event whose data points at 'count' contiguous
+ * records of 'record_size' bytes (event->record_size / record_count).
+ * Spans up to MAX_EVENT_DATA_SIZE are copied into the lane buffer, larger
+ * spans go into one payload pool block with a single copy. If 'records' is
+ * itself a pool block it is referenced without copying and ownership moves
+ * to the bus on success, as with event_bus_publish_pooled().
+ *
+ * @param event_type Type of event to publish
+ * @param records Pointer to the first record
+ * @param record_size Size of one record in bytes
+ * @param count Number of records
+ * @return true if event published successfully, false otherwise
+ */
+bool event_bus_publish_batch(event_type_t event_type, const void* records,
+                             uint16_t record_size, uint16_t count)
+{
+    uint32_t span = (uint32_t)record_size * count;
+
+    if (records == NULL || record_size == 0 || count == 0) {
+        count_rejected(false);
+        return false;
+    }
+
+    event_priority_t priority = event_bus_get_default_priority(event_type);
+
+    if (event_pool_owns(records)) {
+        if (span > EVENT_POOL_BLOCK_SIZE) {
+            count_rejected(true);
+            return false;
+        }
+        return lane_enqueue(event_type, priority, (void*)records, span, false, record_size, count);
+    }
+
+    if (span <= MAX_EVENT_DATA_SIZE) {
+        return lane_enqueue(event_type, priority, (void*)records, span, true, record_size, count);
+    }
+
+    void* block = event_pool_alloc(span);
+    if (block == NULL) {
+        count_rejected(true);
+        return false; // Too large for a pool block, or pool empty
+    }
+
+    memcpy(block, records, span);
+    if (!lane_enqueue(event_type, priority, block, span, false, record_size, count)) {
+        event_pool_release(block);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Publish an event from interrupt context
+ *
+ * Uses a separate lock-free ring so it never races with event_bus_publish()
+ * and never masks interrupts. Producers claim a slot by CAS on the tail
+ * index, so nested ISRs of different priorities may publish concurrently.
+ *
+ * @param event_type Type of event to publish
+ * @param data Pointer to event data (will be copied)
+ * @param data_size Size of event data in bytes
+ * @return true if event published successfully, false if ring full or data too large
+ */
+HAL_ITCM_FUNC bool event_bus_publish_from_isr(event_type_t event_type, const void* data, uint32_t data_size)
+{
+    SYSVIEW_TRACE_U32(SYSVIEW_EVT_BUS_PUBLISH, event_type);
+
+    if (data_size > MAX_EVENT_DATA_SIZE) {
+        __atomic_fetch_add(&stats.isr_publish_fail_count, 1, __ATOMIC_RELAXED);
+        EVENT_TRACE_RECORD(event_type, EVENT_TRACE_SRC_ISR, event_bus_get_default_priority(event_type),
+                           data, data_size, 0, EVENT_TRACE_REJECTED);
+        return false; // Data too large
+    }
+
+    // No subscriber: keep the ring slot for events someone wants
+    if (!event_bus_has_subscribers(event_type)) {
+        __atomic_fetch_add(&stats.elided_count, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&stats.isr_publish_success_count, 1, __ATOMIC_RELAXED);
+        EVENT_TRACE_RECORD(event_type, EVENT_TRACE_SRC_ISR, event_bus_get_default_priority(event_type),
+                           data, data_size, 0, EVENT_TRACE_ELIDED);
+        return true;
+    }
+
+    uint32_t pos = __atomic_load_n(&isr_queue_tail, __ATOMIC_RELAXED);
+    event_isr_slot_t* slot;
+
+    for (;;) {
+        slot = &isr_queue[pos & EVENT_ISR_QUEUE_MASK];
+        uint32_t seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(seq - pos);
+
+        if (diff == 0) {
+            // Slot is free for this position, try to claim it
+            if (__atomic_compare_exchange_n(&isr_queue_tail, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+            // CAS failed: pos now holds the current tail, retry
+        } else if (diff < 0) {
+            // Consumer has not released this slot yet: ring full
+            __atomic_fetch_add(&stats.isr_publish_fail_count, 1, __ATOMIC_RELAXED);
+            EVENT_TRACE_RECORD(event_type, EVENT_TRACE_SRC_ISR,
+                               event_bus_get_default_priority(event_type), data, data_size, 0,
+                               EVENT_TRACE_REJECTED);
+            return false;
+        } else {
+            // Another producer claimed it first
+            pos = __atomic_load_n(&isr_queue_tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->type = event_type;
+    slot->data_size = (data != NULL) ? data_size : 0;
+    slot->timestamp = event_bus_get_timestamp_us();
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+    slot->publish_cycles = hal_get_cycle_count();
+#endif
+    if (data != NULL && data_size > 0) {
+        memcpy(slot->data, data, data_size);
+    }
+
+    // Publish the slot to the consumer
+    __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&stats.isr_publish_success_count, 1, __ATOMIC_RELAXED);
+    EVENT_TRACE_RECORD(event_type, EVENT_TRACE_SRC_ISR, event_bus_get_default_priority(event_type),
+                       data, data_size, 0, EVENT_TRACE_QUEUED);
+
+#if EVENT_BUS_USE_DISPATCH_TASK
+    // The default shard drains the ISR ring
+    if (dispatch_sem[EVENT_SHARD_DEFAULT] != NULL) {
+        bool woken = false;
+        os_semaphore_give_from_isr(dispatch_sem[EVENT_SHARD_DEFAULT], &woken);
+        os_yield_from_isr(woken);
+    }
+#endif
+
+    return true;
+}
+
+/**
+ * @brief Call a subscriber with the signature it registered
+ */
+static inline void call_subscriber(event_callback_t callback, bool is_batch, event_t* event)
+{
+    if (!is_batch) {
+        callback(event);
+    } else if (event->record_count > 0) {
+        ((event_batch_callback_t)callback)(event, event->data, event->record_size, event->record_count);
+    } else {
+        ((event_batch_callback_t)callback)(event, event->data, (uint16_t)event->data_size,
+                                           (event->data != NULL) ? 1 : 0);
+    }
+}
+
+/**
+ * @brief Run one subscriber callback, timing it when histograms are enabled
+ */
+static inline void invoke_callback(event_callback_t callback, bool is_batch, event_t* event,
+                                   event_subscriber_list_t* list)
+{
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+    event_bus_latency_t* latency = &latency_table[list - subscriber_table];
+    uint32_t start = hal_get_cycle_count();
+
+    call_subscriber(callback, is_batch, event);
+
+    uint32_t cycles = hal_get_cycle_count() - start;
+    latency->callback_hist[latency_bucket(cycles)]++;
+    if (cycles > latency->callback_max_cycles) {
+        latency->callback_max_cycles = cycles;
+        latency->slowest_callback = callback;
+    }
+#else
+    (void)list;
+    call_subscriber(callback, is_batch, event);
+#endif
+}
+
+/**
+ * @brief Read the float value of a filter's payload field
+ * @return false if the payload is too short for the field
+ */
+static bool filter_field(const event_filter_t* filter, const event_t* event, float* value)
+{
+    static const uint8_t field_size[] = {
+        [EVENT_FIELD_U8] = 1, [EVENT_FIELD_I8] = 1, [EVENT_FIELD_U16] = 2, [EVENT_FIELD_I16] = 2,
+        [EVENT_FIELD_U32] = 4, [EVENT_FIELD_I32] = 4, [EVENT_FIELD_FLOAT] = 4,
+    };
+
+    if (filter->field_type > EVENT_FIELD_FLOAT || event->data == NULL ||
+        (uint32_t)filter->offset + field_size[filter->field_type] > event->data_size) {
+        return false;
+    }
+
+    // Payloads are copied into lane buffers, so fields need not be aligned
+    const uint8_t* field = (const uint8_t*)event->data + filter->offset;
+    union { uint8_t u8; int8_t i8; uint16_t u16; int16_t i16; uint32_t u32; int32_t i32; float f; } raw;
+    memcpy(&raw, field, field_size[filter->field_type]);
+
+    switch (filter->field_type) {
+        case EVENT_FIELD_U8:  *value = (float)raw.u8;  break;
+        case EVENT_FIELD_I8:  *value = (float)raw.i8;  break;
+        case EVENT_FIELD_U16: *value = (float)raw.u16; break;
+        case EVENT_FIELD_I16: *value = (float)raw.i16; break;
+        case EVENT_FIELD_U32: *value = (float)raw.u32; break;
+        case EVENT_FIELD_I32: *value = (float)raw.i32; break;
+        default:              *value = raw.f;          break;
+    }
+    return true;
+}
+
+/**
+ * @brief Check a subscriber's declarative filter (with BUS_LOCK held)
+ *
+ * EVENT_FILTER_CHANGED keeps state per subscriber entry, which only stays
+ * that entry's while unsubscribes are locked out.
+ *
+ * @return true to deliver the event
+ */
+static bool filter_pass(event_subscriber_list_t* list, uint8_t index, const event_t* event)
+{
+    const event_filter_t* filter = list->callback_filter[index];
+    float value;
+
+    if (!filter_field(filter, event, &value)) {
+        return true;
+    }
+
+    switch (filter->kind) {
+        case EVENT_FILTER_INSIDE:
+            return value >= filter->u.range.min && value <= filter->u.range.max;
+        case EVENT_FILTER_OUTSIDE:
+            return value < filter->u.range.min || value > filter->u.range.max;
+        case EVENT_FILTER_CHANGED: {
+            float delta = value - list->callback_last[index];
+            if (list->callback_seen[index] && delta <= filter->u.deadband && -delta <= filter->u.deadband) {
+                return false;
+            }
+            list->callback_last[index] = value;
+            list->callback_seen[index] = true;
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
+// A subscriber of the event being dispatched, copied under BUS_LOCK
+typedef struct {
+    event_callback_t callback;
+    const event_filter_t* predicate;    // Checked unlocked; NULL = deliver
+    bool is_batch;
+} dispatch_target_t;
+
+/**
+ * @brief Deliver an event to the subscribers of its type on one shard
+ *
+ * Called without BUS_LOCK. Unsubscribing from another task shifts the
+ * subscriber arrays down, so this shard's entries are copied under the
+ * lock first, with the declarative filters applied there too; callbacks
+ * and predicates then run on the copy, unlocked. A callback removed in
+ * the meantime still sees this one event.
+ *
+ * @param event Event to dispatch
+ * @param shard Shard being serviced
+ */
+static HAL_ITCM_FUNC void dispatch_event(event_t* event, uint8_t shard)
+{
+    event_subscriber_list_t* list = NULL;
+    dispatch_target_t targets[MAX_SUBSCRIBERS_PER_EVENT];
+    uint8_t target_count = 0;
+    uint8_t subscriber_count = 0;
+
+    if (event->type < EVENT_USER_DEFINED_START) {
+        list = get_subscriber_list(event->type, false);
+    }
+
+    if (list != NULL) {
+        BUS_LOCK();
+        subscriber_count = list->subscriber_count;
+        for (uint8_t i = 0; i < list->subscriber_count; i++) {
+            if (list->callbacks[i] == NULL || list->callback_shard[i] != shard) {
+                continue;
+            }
+            const event_filter_t* filter = list->callback_filter[i];
+            bool is_predicate = (filter != NULL && filter->kind == EVENT_FILTER_PREDICATE);
+            if (filter != NULL && !is_predicate && !filter_pass(list, i, event)) {
+                __atomic_fetch_add(&stats.filtered_count, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+            targets[target_count].callback = list->callbacks[i];
+            targets[target_count].predicate = is_predicate ? filter : NULL;
+            targets[target_count].is_batch = list->callback_is_batch[i];
+            target_count++;
+        }
+        BUS_UNLOCK();
+    }
+
+    (void)subscriber_count;     // Only traced
+    SYSVIEW_TRACE_U32x2(SYSVIEW_EVT_BUS_DISPATCH, event->type, subscriber_count);
+    SYSVIEW_MARK_START(SYSVIEW_MARKER_BUS_DISPATCH);
+
+    if (list != NULL) {
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+        event_bus_latency_t* latency = &latency_table[list - subscriber_table];
+        uint32_t queue_cycles = hal_get_cycle_count() - event->publish_cycles;
+
+        latency->queue_hist[latency_bucket(queue_cycles)]++;
+        if (queue_cycles > latency->queue_max_cycles) {
+            latency->queue_max_cycles = queue_cycles;
+        }
+        latency->sample_count++;
+#endif
+#if EVENT_BUS_USE_STATIC_SUBSCRIPTIONS
+        // Compile-time subscribers first (always on the default shard)
+        if (shard == EVENT_SHARD_DEFAULT) {
+            for (uint8_t i = 0; i < list->static_count; i++) {
+                invoke_callback(list->static_first[i], false, event, list);
+            }
+        }
+#endif
+        for (uint8_t i = 0; i < target_count; i++) {
+            const event_filter_t* predicate = targets[i].predicate;
+            if (predicate != NULL && predicate->u.predicate.fn != NULL &&
+                !predicate->u.predicate.fn(event, predicate->u.predicate.ctx)) {
+                __atomic_fetch_add(&stats.filtered_count, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+            invoke_callback(targets[i].callback, targets[i].is_batch, event, list);
+        }
+    }
+
+    SYSVIEW_MARK_STOP(SYSVIEW_MARKER_BUS_DISPATCH);
+
+    // Drop the bus reference on pooled payloads
+    if (event->data != NULL && event_pool_owns(event->data)) {
+        event_pool_release(event->data);
+    }
+}
+
+/**
+ * @brief Drain events published from interrupt context
+ *
+ * Runs on the default shard. Its subscribers read the payload straight from
+ * the ring slot; other shards with subscribers get a queued copy. The slot
+ * is handed back to producers only after the last callback returns.
+ *
+ * @return Number of events drained
+ */
+static HAL_ITCM_FUNC uint8_t process_isr_queue(void)
+{
+    uint8_t drained = 0;
+
+    for (;;) {
+        event_isr_slot_t* slot = &isr_queue[isr_queue_head & EVENT_ISR_QUEUE_MASK];
+        uint32_t seq = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+
+        if (seq != isr_queue_head + 1) {
+            break; // Empty (or producer still filling this slot)
+        }
+
+        event_t event = {
+            .type = slot->type,
+            .data = (slot->data_size > 0) ? slot->data : NULL,
+            .data_size = slot->data_size,
+            .timestamp = slot->timestamp,
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+            .publish_cycles = slot->publish_cycles,
+#endif
+        };
+
+        // Forward a copy to the other shards that subscribe to this type
+        BUS_LOCK();
+        event_subscriber_list_t* list = (event.type < EVENT_USER_DEFINED_START)
+                                            ? get_subscriber_list(event.type, false) : NULL;
+        uint8_t others = target_shards(list) & (uint8_t)~(1u << EVENT_SHARD_DEFAULT);
+        uint8_t woken = 0;
+        if (others != 0) {
+            enqueue_locked(event.type, event_bus_get_default_priority(event.type),
+                           event.data, event.data_size, true, 0, 0, others, &woken);
+        }
+        stats.process_count++;      // Shared with process_lane() on other shards
+        BUS_UNLOCK();
+
+        for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+            if (woken & (1u << shard)) {
+                BUS_SIGNAL(shard);
+            }
+        }
+
+        dispatch_event(&event, EVENT_SHARD_DEFAULT);
+
+        // Release slot for the producer that wraps around to it
+        __atomic_store_n(&slot->sequence, isr_queue_head + EVENT_ISR_QUEUE_SIZE, __ATOMIC_RELEASE);
+        isr_queue_head++;
+        drained++;
+    }
+
+    return drained;
+}
+
+/**
+ * @brief Dispatch up to 'budget' events from one lane
+ * @param shard Shard to service
+ * @param priority Lane to service
+ * @return Number of events dispatched
+ */
+static HAL_ITCM_FUNC uint8_t process_lane(uint8_t shard, event_priority_t priority)
+{
+    event_lane_t* lane = &lanes[shard][priority];
+    uint8_t dispatched = 0;
+
+    BUS_LOCK();
+
+    while (lane->count > 0 && (lane->budget == 0 || dispatched < lane->budget)) {
+        event_t* event = &lane->events[lane->head];
+
+        // Publishes from here on (also from inside callbacks) queue a new event
+        if (event->type < EVENT_USER_DEFINED_START) {
+            event_subscriber_list_t* list = get_subscriber_list(event->type, false);
+            if (list != NULL && (list->pending_mask & (1u << shard))
+                && list->pending_lane[shard] == (uint8_t)priority
+                && list->pending_pos[shard] == lane->head) {
+                list->pending_mask &= (uint8_t)~(1u << shard);
+            }
+        }
+
+        // Get next event from queue and notify all subscribers. The slot
+        // stays counted, so publishers cannot reuse it while callbacks run.
+        BUS_UNLOCK();
+        dispatch_event(event, shard);
+        BUS_LOCK();
+
+        // Move to next event, freeing its payload copy
+        uint16_t span = lane->bytes[lane->head].span;
+        lane->arena_head = (uint16_t)((lane->arena_head + span) % lane->arena_size);
+        lane->arena_used = (uint16_t)(lane->arena_used - span);
+        lane->head = (lane->head + 1) % lane->size;
+        lane->count--;
+        dispatched++;
+
+        stats.lanes[priority].process_count++;
+        stats.process_count++;
+    }
+
+    BUS_UNLOCK();
+
+    return dispatched;
+}
+
+/**
+ * @brief Link a timer into the wheel slot of its expiry tick
+ *
+ * Caller holds the bus lock and has set timer->expiry_tick.
+ */
+static void timer_insert_locked(uint8_t index)
+{
+    event_timer_t* timer = &timers[index];
+    uint32_t delta = timer->expiry_tick - timer_last_tick;    // >= 1
+    uint8_t slot = (uint8_t)(timer->expiry_tick & EVENT_TIMER_WHEEL_MASK);
+
+    timer->rounds = (uint16_t)((delta - 1) / EVENT_TIMER_WHEEL_SLOTS);
+    timer->next = timer_wheel[slot];
+    timer_wheel[slot] = index;
+}
+
+/**
+ * @brief Unlink a timer from its wheel slot (caller holds the bus lock)
+ */
+static void timer_remove_locked(uint8_t index)
+{
+    uint8_t slot = (uint8_t)(timers[index].expiry_tick & EVENT_TIMER_WHEEL_MASK);
+    uint8_t* link = &timer_wheel[slot];
+
+    while (*link != EVENT_TIMER_NONE) {
+        if (*link == index) {
+            *link = timers[index].next;
+            return;
+        }
+        link = &timers[*link].next;
+    }
+}
+
+/**
+ * @brief Advance the timer wheel up to the current tick
+ *
+ * Visits one wheel slot per elapsed tick. Timers whose round count has run
+ * out are published; periodic ones are re-armed relative to their previous
+ * expiry, so they do not drift with dispatch latency. Re-arming waits until
+ * the slot walk is done: a period that is a multiple of the wheel size
+ * lands in the slot being walked, which must not count it down again.
+ *
+ * @return Number of timed events published
+ */
+static uint32_t process_timers(void)
+{
+    uint32_t fired = 0;
+    uint8_t woken_all = 0;
+
+    BUS_LOCK();
+
+    uint32_t now = event_bus_get_tick();
+
+    while (timer_active_count > 0 && timer_last_tick != now) {
+        timer_last_tick++;
+        uint8_t slot = (uint8_t)(timer_last_tick & EVENT_TIMER_WHEEL_MASK);
+        uint8_t* link = &timer_wheel[slot];
+        uint8_t rearm = EVENT_TIMER_NONE;       // Expired periodic timers, via next
+
+        while (*link != EVENT_TIMER_NONE) {
+            uint8_t index = *link;
+            event_timer_t* timer = &timers[index];
+
+            if (timer->rounds > 0) {
+                timer->rounds--;
+                link = &timer->next;
+                continue;
+            }
+
+            // Expired: unlink, publish, and re-arm or free
+            *link = timer->next;
+
+            uint8_t woken;
+            event_subscriber_list_t* list = (timer->type < EVENT_USER_DEFINED_START)
+                                                ? get_subscriber_list(timer->type, false) : NULL;
+            event_priority_t priority = event_bus_get_default_priority(timer->type);
+            void* data = (timer->data_size > 0) ? timer->data : NULL;
+            bool queued = enqueue_locked(timer->type, priority, data, timer->data_size,
+                                         true, 0, 0, target_shards(list), &woken);
+            EVENT_TRACE_RECORD(timer->type, EVENT_TRACE_SRC_TIMER, priority, data,
+                               timer->data_size, 0,
+                               !queued ? EVENT_TRACE_REJECTED
+                                       : (list_has_subscribers(list) ? EVENT_TRACE_QUEUED
+                                                                     : EVENT_TRACE_ELIDED));
+            (void)queued;
+            woken_all |= woken;
+            fired++;
+
+            if (timer->period_ticks > 0) {
+                timer->expiry_tick += timer->period_ticks;
+                if ((int32_t)(timer->expiry_tick - timer_last_tick) <= 0) {
+                    // Fell behind by more than a period: skip missed expiries
+                    timer->expiry_tick = timer_last_tick + timer->period_ticks;
+                }
+                timer->next = rearm;
+                rearm = index;
+            } else {
+                timer->active = false;
+                timer_active_count--;
+            }
+        }
+
+        while (rearm != EVENT_TIMER_NONE) {
+            uint8_t index = rearm;
+            rearm = timers[index].next;
+            timer_insert_locked(index);
+        }
+    }
+
+    if (timer_active_count == 0) {
+        timer_last_tick = now;
+    }
+
+    BUS_UNLOCK();
+
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        if (woken_all & (1u << shard)) {
+            BUS_SIGNAL(shard);
+        }
+    }
+
+    return fired;
+}
+
+/**
+ * @brief Arm a delayed or periodic publish
+ * @return Timer handle, or EVENT_TIMER_INVALID
+ */
+static event_timer_handle_t timer_start(event_type_t event_type, const void* data, uint32_t data_size,
+                                        uint32_t delay_ms, uint32_t period_ms)
+{
+    if (data_size > MAX_EVENT_DATA_SIZE) {
+        BUS_LOCK();
+        stats.data_too_large_count++;
+        BUS_UNLOCK();
+        return EVENT_TIMER_INVALID;
+    }
+
+    event_timer_handle_t handle = EVENT_TIMER_INVALID;
+
+    BUS_LOCK();
+
+    for (uint8_t i = 0; i < EVENT_BUS_MAX_TIMERS; i++) {
+        event_timer_t* timer = &timers[i];
+        if (timer->active) {
+            continue;
+        }
+
+        // Catch up so the wheel position matches the current tick
+        if (timer_active_count == 0) {
+            timer_last_tick = event_bus_get_tick();
+        }
+
+        timer->type = event_type;
+        timer->data_size = (data != NULL) ? data_size : 0;
+        if (timer->data_size > 0) {
+            memcpy(timer->data, data, data_size);
+        }
+        timer->period_ticks = (period_ms > 0) ? period_ms : 0;
+        timer->expiry_tick = event_bus_get_tick() + ((delay_ms > 0) ? delay_ms : 1);
+        if ((int32_t)(timer->expiry_tick - timer_last_tick) <= 0) {
+            timer->expiry_tick = timer_last_tick + 1;
+        }
+        timer->active = true;
+        timer->generation++;
+        timer_active_count++;
+        timer_insert_locked(i);
+
+        handle = (event_timer_handle_t)(((uint16_t)timer->generation << 8) | (i + 1));
+        break;
+    }
+
+    if (handle == EVENT_TIMER_INVALID) {
+        stats.timer_fail_count++;
+    }
+
+    BUS_UNLOCK();
+
+    // Let the default shard recompute its wake-up time
+    if (handle != EVENT_TIMER_INVALID) {
+        BUS_SIGNAL(EVENT_SHARD_DEFAULT);
+    }
+
+    return handle;
+}
+
+/**
+ * @brief Publish an event after a delay
+ *
+ * The payload is copied now and published from the timer wheel once the
+ * delay has elapsed (resolution: one HAL tick, 1 ms).
+ *
+ * @param event_type Type of event to publish
+ * @param data Pointer to event data (will be copied)
+ * @param data_size Size of event data in bytes
+ * @param delay_ms Delay before the event is published
+ * @return Timer handle, or EVENT_TIMER_INVALID if no timer is free
+ */
+event_timer_handle_t event_bus_publish_delayed(event_type_t event_type, const void* data,
+                                               uint32_t data_size, uint32_t delay_ms)
+{
+    return timer_start(event_type, data, data_size, delay_ms, 0);
+}
+
+/**
+ * @brief Publish an event periodically
+ *
+ * First publish happens one period from now. Use event_bus_cancel_timer()
+ * to stop it.
+ *
+ * @param event_type Type of event to publish
+ * @param data Pointer to event data (will be copied)
+ * @param data_size Size of event data in bytes
+ * @param period_ms Publish interval (must be > 0)
+ * @return Timer handle, or EVENT_TIMER_INVALID if no timer is free
+ */
+event_timer_handle_t event_bus_publish_periodic(event_type_t event_type, const void* data,
+                                                uint32_t data_size, uint32_t period_ms)
+{
+    if (period_ms == 0) {
+        return EVENT_TIMER_INVALID;
+    }
+
+    return timer_start(event_type, data, data_size, period_ms, period_ms);
+}
+
+/**
+ * @brief Cancel a delayed or periodic publish
+ * @param handle Handle returned by event_bus_publish_delayed/periodic()
+ * @return true if the timer was active and is now cancelled
+ */
+bool event_bus_cancel_timer(event_timer_handle_t handle)
+{
+    uint8_t index = (uint8_t)((handle & 0xFF) - 1);
+    uint8_t generation = (uint8_t)(handle >> 8);
+
+    if (handle == EVENT_TIMER_INVALID || index >= EVENT_BUS_MAX_TIMERS) {
+        return false;
+    }
+
+    bool cancelled = false;
+
+    BUS_LOCK();
+    event_timer_t* timer = &timers[index];
+    if (timer->active && timer->generation == generation) {
+        timer_remove_locked(index);
+        timer->active = false;
+        timer_active_count--;
+        cancelled = true;
+    }
+    BUS_UNLOCK();
+
+    return cancelled;
+}
+
+/**
+ * @brief Get time until the next timer may fire
+ * @return Milliseconds until the earliest armed timer expires,
+ *         or 0xFFFFFFFF if no timer is armed
+ */
+uint32_t event_bus_get_next_timer_ms(void)
+{
+    uint32_t next = 0xFFFFFFFF;
+
+    BUS_LOCK();
+    uint32_t now = event_bus_get_tick();
+    for (uint8_t i = 0; i < EVENT_BUS_MAX_TIMERS; i++) {
+        if (!timers[i].active) {
+            continue;
+        }
+        int32_t remaining = (int32_t)(timers[i].expiry_tick - now);
+        uint32_t ticks = (remaining > 0) ? (uint32_t)remaining : 0;
+        if (ticks < next) {
+            next = ticks;
+        }
+    }
+    BUS_UNLOCK();
+
+    return next;
+}
+
+/**
+ * @brief Run one budgeted round over the lanes of a shard
+ * @param shard Shard to service
+ * @return Number of events dispatched
+ */
+static uint32_t process_shard_round(uint8_t shard)
+{
+    uint32_t dispatched = 0;
+
+    if (shard == EVENT_SHARD_DEFAULT) {
+        dispatched += process_timers();
+        dispatched += process_isr_queue();
+    }
+
+    for (uint8_t p = 0; p < EVENT_PRIORITY_COUNT; p++) {
+        dispatched += process_lane(shard, (event_priority_t)p);
+    }
+
+    return dispatched;
+}
+
+/**
+ * @brief Process pending events in the queue
+ * 
+ * This should be called periodically from the main loop or RTOS task.
+ * Events published from ISRs are delivered first, then the priority lanes
+ * of every shard are serviced highest-first in rounds, each lane limited
+ * to its budget, until all lanes are empty.
+ */
+void event_bus_process(void)
+{
+    uint32_t dispatched;
+
+    CYCLE_PROBE_BEGIN(CYCLE_PROBE_EVENT_BUS_PROCESS);
+    do {
+        dispatched = 0;
+        for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+            dispatched += process_shard_round(shard);
+        }
+    } while (dispatched > 0);
+    CYCLE_PROBE_END(CYCLE_PROBE_EVENT_BUS_PROCESS);
+}
+
+/**
+ * @brief Enable or disable last-value-wins coalescing for an event type
+ *
+ * While an event of a coalescing type is queued, further publishes of that
+ * type overwrite its payload and timestamp instead of taking another queue
+ * slot. Events published from ISRs are never coalesced.
+ *
+ * @param event_type Type of event
+ * @param enable true to coalesce, false for normal FIFO behaviour
+ * @return true if successful, false if type invalid or table full
+ */
+bool event_bus_set_coalesce(event_type_t event_type, bool enable)
+{
+    if (event_type >= EVENT_USER_DEFINED_START) {
+        return false;
+    }
+
+    BUS_LOCK();
+    event_subscriber_list_t* list = get_subscriber_list(event_type, true);
+    if (list != NULL) {
+        list->coalesce = enable;
+        if (!enable) {
+            list->pending_mask = 0;
+        }
+    }
+    BUS_UNLOCK();
+
+    return list != NULL;
+}
+
+/**
+ * @brief Set the per-round dispatch budget of a lane
+ * @param priority Lane to configure
+ * @param budget Max events dispatched per round (0 = unlimited)
+ * @return true if lane is valid
+ */
+bool event_bus_set_lane_budget(event_priority_t priority, uint8_t budget)
+{
+    if (priority >= EVENT_PRIORITY_COUNT) {
+        return false;
+    }
+
+    BUS_LOCK();
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        lanes[shard][priority].budget = budget;
+    }
+    BUS_UNLOCK();
+
+    return true;
+}
+
+#if EVENT_BUS_USE_DISPATCH_TASK
+/**
+ * @brief Dispatch task: sleeps until something is published to its shard
+ * @param args Shard index
+ */
+static void event_dispatch_task(void* args)
+{
+    uint8_t shard = (uint8_t)(uintptr_t)args;
+
+    while (1) {
+        // The default shard also wakes up when the next timer is due
+        uint32_t timeout = OS_WAIT_FOREVER;
+        if (shard == EVENT_SHARD_DEFAULT) {
+            uint32_t next_ms = event_bus_get_next_timer_ms();
+            if (next_ms != 0xFFFFFFFF) {
+                timeout = (next_ms > 0) ? next_ms : 1;
+            }
+        }
+
+        os_semaphore_take(dispatch_sem[shard], timeout);
+
+        // Timed like event_bus_process(), which this replaces in task mode
+        CYCLE_PROBE_BEGIN(CYCLE_PROBE_EVENT_BUS_PROCESS);
+        while (process_shard_round(shard) > 0) {
+        }
+        CYCLE_PROBE_END(CYCLE_PROBE_EVENT_BUS_PROCESS);
+    }
+}
+
+/**
+ * @brief Start the event dispatch tasks (one per shard)
+ *
+ * After this call events are delivered from the dispatch tasks as soon as
+ * they are published; do not call event_bus_process() from other tasks.
+ *
+ * @return true if all tasks are running
+ */
+bool event_bus_start_dispatch_task(void)
+{
+    if (dispatch_tasks_running) {
+        return true;
+    }
+
+    bus_mutex = OS_MUTEX_CREATE_STATIC(bus);
+    if (bus_mutex == NULL) {
+        return false;
+    }
+
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        dispatch_sem[shard] = os_semaphore_create_binary_static(&dispatch_sem_storage[shard]);
+        if (dispatch_sem[shard] == NULL) {
+            goto fail;
+        }
+    }
+
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        if (os_task_create_static(event_dispatch_task, shard_task_name[shard],
+                                  sizeof(dispatch_task_stack[shard]), (void*)(uintptr_t)shard,
+                                  shard_task_priority[shard], dispatch_task_stack[shard],
+                                  &dispatch_task_storage[shard],
+                                  &dispatch_task_handle[shard]) != OS_SUCCESS) {
+            goto fail;
+        }
+    }
+
+    // Deliver anything published before the tasks existed
+    dispatch_tasks_running = true;
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        os_semaphore_give(dispatch_sem[shard]);
+    }
+    return true;
+
+fail:
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        if (dispatch_task_handle[shard] != NULL) {
+            os_task_delete(dispatch_task_handle[shard]);
+            dispatch_task_handle[shard] = NULL;
+        }
+        if (dispatch_sem[shard] != NULL) {
+            os_semaphore_delete(dispatch_sem[shard]);
+            dispatch_sem[shard] = NULL;
+        }
+    }
+    os_mutex_delete(bus_mutex);
+    bus_mutex = NULL;
+    return false;
+}
+
+/**
+ * @brief Check whether the dispatch tasks deliver events
+ * @return true if event_bus_start_dispatch_task() succeeded
+ */
+bool event_bus_is_dispatch_task_running(void)
+{
+    return dispatch_tasks_running;
+}
+#endif
+
+/**
+ * @brief Get current system tick for timestamp
+ * @return Current tick count
+ */
+uint32_t event_bus_get_tick(void)
+{
+    return hal_get_tick();
+}
+
+/**
+ * @brief Get current time for event timestamps
+ * @return Microseconds from the monotonic timebase (low 32 bits)
+ */
+uint32_t event_bus_get_timestamp_us(void)
+{
+    return (uint32_t)hal_timebase_now_us();
+}
+
+/**
+ * @brief Get event bus statistics
+ * @return Copy of current statistics
+ */
+event_bus_stats_t event_bus_get_stats(void)
+{
+    return stats;
+}
+
+/**
+ * @brief Reset event bus statistics
+ */
+void event_bus_reset_stats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * @brief Get current queue depth
+ * @return Number of events currently in queue
+ */
 uint8_t event_bus_get_queue_depth(void)
 {
-    return queue_count;
+    uint8_t depth = 0;
+
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        for (uint8_t p = 0; p < EVENT_PRIORITY_COUNT; p++) {
+            depth += lanes[shard][p].count;
+        }
+    }
+
+    return depth;
+}
+
+/**
+ * @brief Get current depth of a single priority lane
+ * @param priority Lane to query
+ * @return Number of events currently in the lane (0 if invalid)
+ */
+uint8_t event_bus_get_lane_depth(event_priority_t priority)
+{
+    if (priority >= EVENT_PRIORITY_COUNT) {
+        return 0;
+    }
+
+    uint8_t depth = 0;
+    for (uint8_t shard = 0; shard < EVENT_BUS_SHARD_COUNT; shard++) {
+        depth += lanes[shard][priority].count;
+    }
+
+    return depth;
+}
+
+/**
+ * @brief Get current depth of all lanes of one shard
+ * @param shard Shard to query
+ * @return Number of events currently queued on the shard (0 if invalid)
+ */
+uint8_t event_bus_get_shard_depth(uint8_t shard)
+{
+    if (shard >= EVENT_BUS_SHARD_COUNT) {
+        return 0;
+    }
+
+    uint8_t depth = 0;
+    for (uint8_t p = 0; p < EVENT_PRIORITY_COUNT; p++) {
+        depth += lanes[shard][p].count;
+    }
+
+    return depth;
+}
+
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+/**
+ * @brief Get latency histograms for an event type
+ * @param event_type Type of event
+ * @param latency Output: copy of the histograms
+ * @return true if the type has a subscription row, false otherwise
+ */
+bool event_bus_get_latency(event_type_t event_type, event_bus_latency_t* latency)
+{
+    if (event_type >= EVENT_USER_DEFINED_START || latency == NULL) {
+        return false;
+    }
+
+    uint8_t slot = event_slot[event_type];
+    if (slot == EVENT_SLOT_NONE) {
+        return false;
+    }
+
+    *latency = latency_table[slot];
+    return true;
+}
+
+/**
+ * @brief Clear all latency histograms
+ */
+void event_bus_reset_latency(void)
+{
+    memset(latency_table, 0, sizeof(latency_table));
 }
+#endif
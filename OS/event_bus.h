@@ -15,14 +15,21 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include "event_catalog.h"
+
+// Per-event-type latency histograms using the DWT cycle counter
+#ifndef EVENT_BUS_LATENCY_HISTOGRAMS
+#define EVENT_BUS_LATENCY_HISTOGRAMS    1
+#endif
+
+// Event Types: the rows of event_catalog.h (payload type, lane, coalescing)
+#define EVENT_CATALOG_ID(id, payload_type, priority, coalesce)  id,
+#define EVENT_CATALOG_SIGNAL_ID(id, priority, coalesce)         id,
 
-// Event Types
 typedef enum {
     EVENT_NONE = 0,
-    EVENT_BUTTON_PRESSED,
-    EVENT_TEMPERATURE_UPDATED,
-    EVENT_SENSOR_ERROR,
-    EVENT_DISPLAY_READY,
+    EVENT_CATALOG(EVENT_CATALOG_ID, EVENT_CATALOG_SIGNAL_ID)
     EVENT_USER_DEFINED_START = 100  // User can define events starting from 100
 } event_type_t;
 
@@ -31,15 +38,165 @@ typedef struct {
     event_type_t type;
     void* data;         // Pointer to event-specific data
     uint32_t data_size; // Size of data in bytes
-    uint32_t timestamp; // Timestamp when event was created
+    uint32_t timestamp; // Creation time in us (hal_timebase, wraps every ~71 min)
+    uint16_t record_size;   // Batch events: size of one record (0 otherwise)
+    uint16_t record_count;  // Batch events: number of records in data
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+    uint32_t publish_cycles; // Cycle counter at publish (latency measurement)
+#endif
 } event_t;
 
+// Event Priority Lanes (lower value = serviced first)
+typedef enum {
+    EVENT_PRIORITY_CRITICAL = 0,    // Faults and errors
+    EVENT_PRIORITY_NORMAL,          // Regular sensor updates
+    EVENT_PRIORITY_BULK,            // Bulk / best-effort traffic
+    EVENT_PRIORITY_COUNT
+} event_priority_t;
+
 // Event Callback Function Type
 typedef void (*event_callback_t)(event_t* event);
 
+// Batched Callback: receives a span of 'count' records of 'record_size' bytes
+typedef void (*event_batch_callback_t)(const event_t* event, const void* records,
+                                       uint16_t record_size, uint16_t count);
+
 // Maximum number of subscribers per event type
 #define MAX_SUBSCRIBERS_PER_EVENT   5
 
+// Largest payload copied into a lane, ISR slot or timer
+#define MAX_EVENT_DATA_SIZE         64
+
+// Subscription Filters: checked on the dispatch task before the callback;
+// a subscriber whose filter says no costs the check and nothing else.
+// Declarative filters run with the bus lock held, predicates without it
+typedef enum {
+    EVENT_FILTER_PREDICATE = 0,     // predicate(event, ctx) decides
+    EVENT_FILTER_INSIDE,            // Field within [min, max]
+    EVENT_FILTER_OUTSIDE,           // Field below min or above max
+    EVENT_FILTER_CHANGED            // Field moved more than deadband since the last delivery
+} event_filter_kind_t;
+
+// Payload field a declarative filter reads, compared as float (exact for
+// integers up to 2^24)
+typedef enum {
+    EVENT_FIELD_U8 = 0,
+    EVENT_FIELD_I8,
+    EVENT_FIELD_U16,
+    EVENT_FIELD_I16,
+    EVENT_FIELD_U32,
+    EVENT_FIELD_I32,
+    EVENT_FIELD_FLOAT
+} event_field_type_t;
+
+typedef bool (*event_predicate_t)(const event_t* event, void* ctx);
+
+typedef struct {
+    uint8_t kind;                   // event_filter_kind_t
+    uint8_t field_type;             // event_field_type_t
+    uint16_t offset;                // Field offset in event->data
+    union {
+        struct {
+            event_predicate_t fn;
+            void* ctx;
+        } predicate;
+        struct {
+            float min;
+            float max;
+        } range;
+        float deadband;             // EVENT_FILTER_CHANGED, 0 = any change
+    } u;
+} event_filter_t;
+
+// Filter initialisers, for a static const filter (the bus keeps the pointer):
+//   static const event_filter_t f = EVENT_FILTER_CHANGED_FIELD(temperature_data_t, temperature,
+//                                                              EVENT_FIELD_FLOAT, 0.1f);
+// An event too short for the field always passes, its callback validates it.
+#define EVENT_FILTER_PREDICATE_FN(fn_, ctx_) \
+    { .kind = EVENT_FILTER_PREDICATE, .u.predicate = { (fn_), (ctx_) } }
+#define EVENT_FILTER_INSIDE_FIELD(type_, member_, field_, min_, max_) \
+    { .kind = EVENT_FILTER_INSIDE, .field_type = (field_), .offset = offsetof(type_, member_), \
+      .u.range = { (min_), (max_) } }
+#define EVENT_FILTER_OUTSIDE_FIELD(type_, member_, field_, min_, max_) \
+    { .kind = EVENT_FILTER_OUTSIDE, .field_type = (field_), .offset = offsetof(type_, member_), \
+      .u.range = { (min_), (max_) } }
+#define EVENT_FILTER_CHANGED_FIELD(type_, member_, field_, deadband_) \
+    { .kind = EVENT_FILTER_CHANGED, .field_type = (field_), .offset = offsetof(type_, member_), \
+      .u.deadband = (deadband_) }
+
+// Optional dispatch task that blocks on an os_wrapper semaphore. Set to 0
+// for bare-metal builds; the application then polls event_bus_process().
+#ifndef EVENT_BUS_USE_DISPATCH_TASK
+#define EVENT_BUS_USE_DISPATCH_TASK     1
+#endif
+
+// Dispatch shards: each has its own lanes and (with the dispatch task) its
+// own task, so slow subscribers can be isolated from latency-critical ones
+#ifndef EVENT_BUS_SHARD_COUNT
+#define EVENT_BUS_SHARD_COUNT       2
+#endif
+#define EVENT_SHARD_DEFAULT         0   // High-priority task, drains ISR events
+#define EVENT_SHARD_BACKGROUND      1   // Low-priority task for slow subscribers (display)
+
+// Concurrent delayed / periodic publishes (timer wheel entries)
+#ifndef EVENT_BUS_MAX_TIMERS
+#define EVENT_BUS_MAX_TIMERS        8
+#endif
+
+// Maximum number of distinct event types with subscribers (dense table rows)
+#ifndef EVENT_BUS_MAX_EVENT_TYPES
+#define EVENT_BUS_MAX_EVENT_TYPES   16
+#endif
+
+// Compile-time subscriptions placed in flash (needs .event_subs in linker script)
+#ifndef EVENT_BUS_USE_STATIC_SUBSCRIPTIONS
+#define EVENT_BUS_USE_STATIC_SUBSCRIPTIONS  1
+#endif
+
+// Compile-time subscriptions the bus indexes, all types together
+#ifndef EVENT_BUS_MAX_STATIC_SUBSCRIPTIONS
+#define EVENT_BUS_MAX_STATIC_SUBSCRIPTIONS  16
+#endif
+
+#if EVENT_BUS_USE_STATIC_SUBSCRIPTIONS
+// Static Subscription Entry (lives in flash)
+typedef struct {
+    event_type_t type;
+    event_callback_t callback;
+} event_static_subscription_t;
+
+#define EVENT_BUS_CONCAT_(a, b)     a##b
+#define EVENT_BUS_CONCAT(a, b)      EVENT_BUS_CONCAT_(a, b)
+
+/**
+ * @brief Declare a subscription at compile time
+ *
+ * Place at file scope. The entry is stored in flash and is active from
+ * event_bus_init() on; it cannot be unsubscribed. Static subscribers are
+ * called before runtime subscribers of the same event type. The type may
+ * be spelled any way (name, alias, value); user-defined types are not
+ * supported and are logged and dropped at init.
+ *
+ * @code
+ * static void on_error(event_t* event);
+ * EVENT_BUS_STATIC_SUBSCRIBE(EVENT_SENSOR_ERROR, on_error);
+ * @endcode
+ */
+#define EVENT_BUS_STATIC_SUBSCRIBE(event_type, callback)                           \
+    __attribute__((used, section(".event_subs." #event_type)))                     \
+    static const event_static_subscription_t                                       \
+        EVENT_BUS_CONCAT(event_sub_, __LINE__) = { (event_type), (callback) }
+#endif
+
+// Per-Lane Statistics
+typedef struct {
+    uint32_t publish_count;            // Successful publishes on this lane
+    uint32_t overflow_count;           // Publishes dropped because lane was full
+    uint32_t process_count;            // Events dispatched from this lane
+    uint32_t max_depth;                // Maximum lane depth reached
+    uint32_t max_arena_bytes;          // Most payload arena bytes held at once
+} event_bus_lane_stats_t;
+
 // Event Bus Statistics
 typedef struct {
     uint32_t publish_success_count;    // Total successful publishes
@@ -48,21 +205,100 @@ typedef struct {
     uint32_t data_too_large_count;     // Data size exceeded
     uint32_t process_count;            // Total events processed
     uint32_t max_queue_depth;          // Maximum queue depth reached
+    uint32_t isr_publish_success_count; // Successful publishes from ISR
+    uint32_t isr_publish_fail_count;   // ISR publishes dropped (ring full / too large)
+    uint32_t coalesced_count;          // Publishes merged into a pending event
+    uint32_t timer_fail_count;         // Delayed publishes rejected (no free timer)
+    uint32_t filtered_count;           // Deliveries a subscription filter skipped
+    uint32_t elided_count;             // Publishes dropped for lack of subscribers (not queued)
+    event_bus_lane_stats_t lanes[EVENT_PRIORITY_COUNT];
 } event_bus_stats_t;
 
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+// Latency Histogram: bucket 0 counts < 2*EVENT_LATENCY_BUCKET_BASE cycles,
+// bucket n counts [BASE << n, BASE << (n+1)), the last bucket everything above
+#define EVENT_LATENCY_BUCKET_COUNT      20
+#define EVENT_LATENCY_BUCKET_BASE_SHIFT 6       // 64 cycles (~0.3 us @ 216 MHz)
+
+typedef struct {
+    uint32_t queue_hist[EVENT_LATENCY_BUCKET_COUNT];     // Publish -> dispatch
+    uint32_t callback_hist[EVENT_LATENCY_BUCKET_COUNT];  // Per-callback run time
+    uint32_t queue_max_cycles;         // Worst publish -> dispatch
+    uint32_t callback_max_cycles;      // Worst single callback
+    event_callback_t slowest_callback; // Callback that set callback_max_cycles
+    uint32_t sample_count;             // Events dispatched
+} event_bus_latency_t;
+#endif
+
+// Timer Handle (delayed / periodic publish)
+typedef uint16_t event_timer_handle_t;
+#define EVENT_TIMER_INVALID         0
+
 // Event Bus Functions
 void event_bus_init(void);
 bool event_bus_subscribe(event_type_t event_type, event_callback_t callback);
+bool event_bus_subscribe_on_shard(event_type_t event_type, event_callback_t callback, uint8_t shard);
 bool event_bus_unsubscribe(event_type_t event_type, event_callback_t callback);
+bool event_bus_subscribe_batch(event_type_t event_type, event_batch_callback_t callback);
+bool event_bus_subscribe_filtered(event_type_t event_type, event_callback_t callback, uint8_t shard,
+                                  const event_filter_t* filter);
+bool event_bus_set_filter(event_type_t event_type, event_callback_t callback,
+                          const event_filter_t* filter);
+bool event_bus_unsubscribe_batch(event_type_t event_type, event_batch_callback_t callback);
 bool event_bus_publish(event_type_t event_type, void* data, uint32_t data_size);
+bool event_bus_publish_prio(event_type_t event_type, event_priority_t priority,
+                            void* data, uint32_t data_size);
+bool event_bus_publish_pooled(event_type_t event_type, void* payload, uint32_t data_size);
+bool event_bus_publish_batch(event_type_t event_type, const void* records,
+                             uint16_t record_size, uint16_t count);
+event_priority_t event_bus_get_default_priority(event_type_t event_type);
+bool event_bus_has_subscribers(event_type_t event_type);
+bool event_bus_set_lane_budget(event_priority_t priority, uint8_t budget);
+bool event_bus_set_coalesce(event_type_t event_type, bool enable);
 void event_bus_process(void);
 
+/**
+ * @brief Publish an event from interrupt context
+ *
+ * Lock-free and safe against concurrent ISRs and event_bus_publish().
+ * The payload is copied into a dedicated ISR ring and delivered by the
+ * next event_bus_process() call.
+ *
+ * @note NON-BLOCKING: Never disables interrupts
+ */
+bool event_bus_publish_from_isr(event_type_t event_type, const void* data, uint32_t data_size);
+
+// Timed Publishing (hashed timer wheel, advanced by event_bus_process())
+event_timer_handle_t event_bus_publish_delayed(event_type_t event_type, const void* data,
+                                               uint32_t data_size, uint32_t delay_ms);
+event_timer_handle_t event_bus_publish_periodic(event_type_t event_type, const void* data,
+                                                uint32_t data_size, uint32_t period_ms);
+bool event_bus_cancel_timer(event_timer_handle_t handle);
+uint32_t event_bus_get_next_timer_ms(void);
+
+#if EVENT_BUS_USE_DISPATCH_TASK
+bool event_bus_start_dispatch_task(void);
+bool event_bus_is_dispatch_task_running(void);
+#else
+#define event_bus_start_dispatch_task()         (false)
+#define event_bus_is_dispatch_task_running()    (false)
+#endif
+
 // Diagnostics Functions
 event_bus_stats_t event_bus_get_stats(void);
 void event_bus_reset_stats(void);
 uint8_t event_bus_get_queue_depth(void);
+uint8_t event_bus_get_lane_depth(event_priority_t priority);
+uint8_t event_bus_get_shard_depth(uint8_t shard);
+#if EVENT_BUS_LATENCY_HISTOGRAMS
+bool event_bus_get_latency(event_type_t event_type, event_bus_latency_t* latency);
+void event_bus_reset_latency(void);
+#endif
 
-// Helper function to get current tick (for timestamp)
+// Helper function to get current tick
 uint32_t event_bus_get_tick(void);
 
+// Helper function to get current time for event timestamps (us)
+uint32_t event_bus_get_timestamp_us(void);
+
 #endif // EVENT_BUS_H
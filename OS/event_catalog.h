@@ -0,0 +1,36 @@
+#ifndef EVENT_CATALOG_H
+#define EVENT_CATALOG_H
+
+/**
+ * @file event_catalog.h
+ * @brief The built-in event types, one X-macro row each
+ *
+ * EVENT_CATALOG(EVENT, SIGNAL) lists them in id order, from 1 up. The ids
+ * go over the wire (protocol event forwarding, event traces), so rows are
+ * only ever appended.
+ *
+ *   EVENT(id, payload_type, priority, coalesce)    with a payload
+ *   SIGNAL(id, priority, coalesce)                 without one
+ *
+ * Expanded into:
+ * - event_type_t (event_bus.h)
+ * - the const default-priority and coalesce tables (event_bus.c)
+ * - typed publish wrappers and handlers, with compile-time payload size
+ *   checks (service_events.h, which includes the payload headers)
+ *
+ * Payload types are only named here, so this header needs none of them.
+ */
+
+#define EVENT_CATALOG(EVENT, SIGNAL)                                                             \
+    EVENT(EVENT_BUTTON_PRESSED,      hal_gpio_exti_event_t, EVENT_PRIORITY_NORMAL,   false)     \
+    EVENT(EVENT_TEMPERATURE_UPDATED, temperature_data_t,    EVENT_PRIORITY_NORMAL,   true)      \
+    EVENT(EVENT_SENSOR_ERROR,        temperature_data_t,    EVENT_PRIORITY_CRITICAL, false)     \
+    SIGNAL(EVENT_DISPLAY_READY,                             EVENT_PRIORITY_NORMAL,   false)     \
+    SIGNAL(EVENT_MEASUREMENT_STARTED,                       EVENT_PRIORITY_NORMAL,   false)     \
+    EVENT(EVENT_MEASUREMENT_STOPPED, measurement_status_t,  EVENT_PRIORITY_NORMAL,   false)     \
+    EVENT(EVENT_CURRENT_LIMIT,       current_limit_event_t, EVENT_PRIORITY_NORMAL,   false)     \
+    EVENT(EVENT_METRIC_UPDATED,      metric_value_t,        EVENT_PRIORITY_NORMAL,   false)     \
+    EVENT(EVENT_DEADLINE_MISSED,     deadline_miss_event_t, EVENT_PRIORITY_NORMAL,   false)     \
+    EVENT(EVENT_LOAD_SHED_CHANGED,   load_shed_event_t,     EVENT_PRIORITY_NORMAL,   false)
+
+#endif // EVENT_CATALOG_H
@@ -0,0 +1,290 @@
+#include "event_hsm.h"
+#include <stddef.h>
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static inline const hsm_state_t *state_of(const hsm_t *hsm, uint8_t id)
+{
+    return &hsm->def->states[id];
+}
+
+static bool is_valid_ref(const hsm_def_t *def, uint8_t id)
+{
+    return id == HSM_STATE_NONE || id < def->state_count;
+}
+
+/**
+ * @brief Check that every reference is in range and no chain is too deep
+ */
+static bool definition_valid(const hsm_def_t *def)
+{
+    if (def == NULL || def->states == NULL || def->state_count == 0
+        || def->state_count >= HSM_STATE_NONE || def->initial >= def->state_count) {
+        return false;
+    }
+
+    for (uint8_t id = 0; id < def->state_count; id++) {
+        const hsm_state_t *state = &def->states[id];
+        if (!is_valid_ref(def, state->parent) || !is_valid_ref(def, state->initial)) {
+            return false;
+        }
+        for (uint8_t i = 0; i < state->transition_count; i++) {
+            if (!is_valid_ref(def, state->transitions[i].target)) {
+                return false;
+            }
+        }
+
+        // Also catches parent cycles
+        uint8_t depth = 0;
+        for (uint8_t s = id; s != HSM_STATE_NONE; s = def->states[s].parent) {
+            if (++depth > HSM_MAX_DEPTH) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool is_ancestor_or_self(const hsm_t *hsm, uint8_t ancestor, uint8_t state)
+{
+    for (uint8_t s = state; s != HSM_STATE_NONE; s = state_of(hsm, s)->parent) {
+        if (s == ancestor) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Run exit actions from the current state up to (excluding) ancestor
+ */
+static void exit_to(hsm_t *hsm, uint8_t ancestor, const event_t *event)
+{
+    while (hsm->state != ancestor && hsm->state != HSM_STATE_NONE) {
+        const hsm_state_t *state = state_of(hsm, hsm->state);
+        if (state->exit != NULL) {
+            state->exit(hsm, event);
+        }
+        hsm->state = state->parent;
+    }
+}
+
+/**
+ * @brief Run entry actions from below ancestor down to target, then on
+ *        through the initial substates
+ */
+static void enter_from(hsm_t *hsm, uint8_t ancestor, uint8_t target, const event_t *event)
+{
+    uint8_t path[HSM_MAX_DEPTH];
+    uint8_t length = 0;
+
+    for (uint8_t s = target; s != ancestor && s != HSM_STATE_NONE && length < HSM_MAX_DEPTH;
+         s = state_of(hsm, s)->parent) {
+        path[length++] = s;
+    }
+
+    while (length > 0) {
+        hsm->state = path[--length];
+        const hsm_state_t *state = state_of(hsm, hsm->state);
+        if (state->entry != NULL) {
+            state->entry(hsm, event);
+        }
+    }
+
+    for (uint8_t depth = 0; depth < HSM_MAX_DEPTH; depth++) {
+        uint8_t initial = state_of(hsm, hsm->state)->initial;
+        if (initial == HSM_STATE_NONE) {
+            break;
+        }
+        hsm->state = initial;
+        const hsm_state_t *state = state_of(hsm, initial);
+        if (state->entry != NULL) {
+            state->entry(hsm, event);
+        }
+    }
+}
+
+static void run_transition(hsm_t *hsm, uint8_t source, uint8_t target,
+                           hsm_action_t action, const event_t *event)
+{
+    // Innermost state containing both; a target that is the source or one
+    // of its ancestors is left and re-entered
+    uint8_t common = source;
+    while (common != HSM_STATE_NONE && !is_ancestor_or_self(hsm, common, target)) {
+        common = state_of(hsm, common)->parent;
+    }
+    if (common == target) {
+        common = state_of(hsm, target)->parent;
+    }
+
+    exit_to(hsm, common, event);
+    if (action != NULL) {
+        action(hsm, event);
+    }
+    enter_from(hsm, common, target, event);
+    hsm->transitions++;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool hsm_init(hsm_t *hsm, const hsm_def_t *def, void *context)
+{
+    if (hsm == NULL || !definition_valid(def)) {
+        return false;
+    }
+
+    hsm->def = def;
+    hsm->context = context;
+    hsm->dispatched = 0;
+    hsm->unhandled = 0;
+    hsm->transitions = 0;
+    hsm->state = HSM_STATE_NONE;
+    enter_from(hsm, HSM_STATE_NONE, def->initial, NULL);
+    return true;
+}
+
+/**
+ * @brief Check whether an event type appears in a table before (id, index)
+ */
+static bool event_listed_before(const hsm_def_t *def, event_type_t type, uint8_t id, uint8_t index)
+{
+    for (uint8_t s = 0; s <= id; s++) {
+        const hsm_state_t *state = &def->states[s];
+        uint8_t count = (s == id) ? index : state->transition_count;
+        for (uint8_t i = 0; i < count; i++) {
+            if (state->transitions[i].event == type) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint8_t hsm_get_events(const hsm_t *hsm, event_type_t *types, uint8_t max_types)
+{
+    if (hsm == NULL || hsm->def == NULL || (types == NULL && max_types > 0)) {
+        return 0;
+    }
+
+    const hsm_def_t *def = hsm->def;
+    uint8_t count = 0;
+    for (uint8_t id = 0; id < def->state_count; id++) {
+        const hsm_state_t *state = &def->states[id];
+        for (uint8_t i = 0; i < state->transition_count; i++) {
+            event_type_t type = state->transitions[i].event;
+            if (event_listed_before(def, type, id, i)) {
+                continue;
+            }
+            if (count < max_types) {
+                types[count] = type;
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+bool hsm_subscribe(const hsm_t *hsm, event_callback_t callback)
+{
+    if (hsm == NULL || hsm->def == NULL || callback == NULL) {
+        return false;
+    }
+
+    const hsm_def_t *def = hsm->def;
+    bool ok = true;
+    for (uint8_t id = 0; id < def->state_count; id++) {
+        const hsm_state_t *state = &def->states[id];
+        for (uint8_t i = 0; i < state->transition_count; i++) {
+            event_type_t type = state->transitions[i].event;
+            if (!event_listed_before(def, type, id, i) && !event_bus_subscribe(type, callback)) {
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+void hsm_unsubscribe(const hsm_t *hsm, event_callback_t callback)
+{
+    if (hsm == NULL || hsm->def == NULL || callback == NULL) {
+        return;
+    }
+
+    const hsm_def_t *def = hsm->def;
+    for (uint8_t id = 0; id < def->state_count; id++) {
+        const hsm_state_t *state = &def->states[id];
+        for (uint8_t i = 0; i < state->transition_count; i++) {
+            event_type_t type = state->transitions[i].event;
+            if (!event_listed_before(def, type, id, i)) {
+                event_bus_unsubscribe(type, callback);
+            }
+        }
+    }
+}
+
+bool hsm_dispatch(hsm_t *hsm, const event_t *event)
+{
+    if (hsm == NULL || hsm->def == NULL || event == NULL) {
+        return false;
+    }
+
+    hsm->dispatched++;
+
+    // Innermost state first, then outwards
+    for (uint8_t s = hsm->state; s != HSM_STATE_NONE; s = state_of(hsm, s)->parent) {
+        const hsm_state_t *state = state_of(hsm, s);
+        for (uint8_t i = 0; i < state->transition_count; i++) {
+            const hsm_transition_t *t = &state->transitions[i];
+            if (t->event != event->type) {
+                continue;
+            }
+
+            if (t->target == HSM_STATE_NONE) {
+                if (t->action != NULL) {
+                    t->action(hsm, event);
+                }
+            } else {
+                run_transition(hsm, s, t->target, t->action, event);
+            }
+            return true;
+        }
+    }
+
+    hsm->unhandled++;
+    return false;
+}
+
+bool hsm_transition(hsm_t *hsm, uint8_t target)
+{
+    if (hsm == NULL || hsm->def == NULL || target >= hsm->def->state_count) {
+        return false;
+    }
+
+    run_transition(hsm, hsm->state, target, NULL, NULL);
+    return true;
+}
+
+uint8_t hsm_get_state(const hsm_t *hsm)
+{
+    return (hsm != NULL) ? hsm->state : HSM_STATE_NONE;
+}
+
+bool hsm_is_in(const hsm_t *hsm, uint8_t state)
+{
+    if (hsm == NULL || hsm->def == NULL || state >= hsm->def->state_count) {
+        return false;
+    }
+    return is_ancestor_or_self(hsm, state, hsm->state);
+}
+
+const char *hsm_get_state_name(const hsm_t *hsm, uint8_t state)
+{
+    if (hsm == NULL || hsm->def == NULL || state >= hsm->def->state_count) {
+        return "?";
+    }
+    return state_of(hsm, state)->name;
+}
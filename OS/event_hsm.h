@@ -0,0 +1,135 @@
+#ifndef EVENT_HSM_H
+#define EVENT_HSM_H
+
+/**
+ * @file event_hsm.h
+ * @brief Table-driven hierarchical state machine fed by the event bus
+ *
+ * A machine is a const table of states (kept in flash). Each state names
+ * its parent, optional entry/exit actions and a table of transitions:
+ * event type -> target state, with an optional action. An event the
+ * current state does not handle is offered to its parent, and so on up.
+ *
+ * A transition exits from the current state up to the common ancestor of
+ * source and target, runs its action, then enters down to the target and
+ * on through the initial substates of a composite target. A transition to
+ * the source state itself, or to one of its ancestors, exits and re-enters
+ * it. HSM_STATE_NONE as target is an internal transition: action only.
+ *
+ * Example usage:
+ * - static const hsm_state_t states[] = { [S_IDLE] = { "IDLE", ... }, ... };
+ * - static const hsm_def_t def = { states, S_COUNT, S_IDLE };
+ * - hsm_init(&machine, &def, NULL); hsm_subscribe(&machine, bus_callback);
+ * - bus_callback(event): hsm_dispatch(&machine, event)
+ * - Or from an active object (OS/active_object.h): ao_subscribe() each type
+ *   of hsm_get_events(), then hsm_dispatch() in the handler
+ *
+ * @note Not reentrant: dispatch from one task (one event bus shard or one
+ *       active object). Actions must not call hsm_dispatch()/hsm_transition()
+ *       on their own machine; they may publish events, which arrive after
+ *       the transition.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "event_bus.h"
+
+#define HSM_STATE_NONE          0xFF    // No parent / no target / no initial substate
+#define HSM_MAX_DEPTH           8       // Nesting levels (entry path length)
+
+typedef struct hsm hsm_t;
+
+/**
+ * @brief Transition or entry/exit action
+ * @param event Triggering event, NULL for hsm_init()/hsm_transition()
+ */
+typedef void (*hsm_action_t)(hsm_t *hsm, const event_t *event);
+
+typedef struct {
+    event_type_t event;
+    uint8_t target;                 // HSM_STATE_NONE: internal, action only
+    hsm_action_t action;            // Runs between exit and entry (may be NULL)
+} hsm_transition_t;
+
+typedef struct {
+    const char *name;
+    uint8_t parent;                 // HSM_STATE_NONE for top-level states
+    uint8_t initial;                // Composite: substate entered next, else HSM_STATE_NONE
+    hsm_action_t entry;             // May be NULL
+    hsm_action_t exit;              // May be NULL
+    const hsm_transition_t *transitions;
+    uint8_t transition_count;
+} hsm_state_t;
+
+typedef struct {
+    const hsm_state_t *states;      // Indexed by state ID
+    uint8_t state_count;
+    uint8_t initial;
+} hsm_def_t;
+
+struct hsm {
+    const hsm_def_t *def;
+    volatile uint8_t state;         // Current state; during entry, the state being entered
+    void *context;                  // Caller data for the actions
+    uint32_t dispatched;            // Events offered to the machine
+    uint32_t unhandled;             // ... that no state along the path took
+    uint32_t transitions;           // State changes (internal transitions excluded)
+};
+
+/**
+ * @brief Enter the initial state (entry actions from the top down)
+ * @return false if the definition is invalid (IDs out of range, too deep)
+ */
+bool hsm_init(hsm_t *hsm, const hsm_def_t *def, void *context);
+
+/**
+ * @brief List the distinct event types the tables handle
+ *
+ * For subscribing some other way than hsm_subscribe(), e.g. an active
+ * object's ao_subscribe().
+ *
+ * @param types Filled with up to max_types types
+ * @return Number of distinct types (may exceed max_types)
+ */
+uint8_t hsm_get_events(const hsm_t *hsm, event_type_t *types, uint8_t max_types);
+
+/**
+ * @brief Subscribe callback to every event type the tables handle
+ *
+ * The callback is the caller's event bus handler, which passes the event
+ * on with hsm_dispatch(). Types already subscribed are not duplicated.
+ *
+ * @return false if a subscription failed
+ */
+bool hsm_subscribe(const hsm_t *hsm, event_callback_t callback);
+
+/**
+ * @brief Unsubscribe callback from the event types of hsm_subscribe()
+ */
+void hsm_unsubscribe(const hsm_t *hsm, event_callback_t callback);
+
+/**
+ * @brief Offer one event to the machine
+ * @return true if a state took it
+ */
+bool hsm_dispatch(hsm_t *hsm, const event_t *event);
+
+/**
+ * @brief Transition to target without an event (e.g. on a direct request)
+ *
+ * Exit and entry run as for an event-driven transition from the current state.
+ *
+ * @return false if target is out of range
+ */
+bool hsm_transition(hsm_t *hsm, uint8_t target);
+
+uint8_t hsm_get_state(const hsm_t *hsm);
+
+/**
+ * @brief Check whether state is the current state or one of its ancestors
+ */
+bool hsm_is_in(const hsm_t *hsm, uint8_t state);
+
+const char *hsm_get_state_name(const hsm_t *hsm, uint8_t state);
+
+#endif // EVENT_HSM_H
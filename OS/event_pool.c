@@ -0,0 +1,117 @@
+#include "event_pool.h"
+#include "mem_pool.h"
+#include <string.h>
+
+// Block storage and per-block reference counts
+MEM_POOL_DEFINE(event_payload, EVENT_POOL_BLOCK_SIZE, EVENT_POOL_BLOCK_COUNT);
+static volatile uint8_t pool_refcount[EVENT_POOL_BLOCK_COUNT];
+
+// Requests larger than a block (the pool counts only empty-pool failures)
+static volatile uint32_t size_fail_count = 0;
+
+/**
+ * @brief Initialize the payload pool
+ *
+ * Must be called before any block is in use (done by event_bus_init()).
+ */
+void event_pool_init(void)
+{
+    memset((void*)pool_refcount, 0, sizeof(pool_refcount));
+    mem_pool_reset(&event_payload_pool);
+    size_fail_count = 0;
+}
+
+/**
+ * @brief Allocate a payload block
+ * @param size Number of payload bytes required
+ * @return Pointer to payload memory, or NULL on failure
+ */
+void* event_pool_alloc(uint32_t size)
+{
+    if (size == 0 || size > EVENT_POOL_BLOCK_SIZE) {
+        __atomic_fetch_add(&size_fail_count, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    void* payload = mem_pool_alloc(&event_payload_pool);
+    if (payload == NULL) {
+        return NULL; // Pool empty
+    }
+
+    __atomic_store_n(&pool_refcount[mem_pool_block_index(&event_payload_pool, payload)], 1,
+                     __ATOMIC_RELAXED);
+    return payload;
+}
+
+/**
+ * @brief Add a reference to a pooled payload
+ * @param payload Pointer returned by event_pool_alloc()
+ * @return true if payload belongs to the pool
+ */
+bool event_pool_retain(void* payload)
+{
+    int32_t index = mem_pool_block_index(&event_payload_pool, payload);
+    if (index < 0) {
+        return false;
+    }
+
+    __atomic_fetch_add(&pool_refcount[index], 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+/**
+ * @brief Drop a reference to a pooled payload
+ * @param payload Pointer returned by event_pool_alloc()
+ * @return true if payload belongs to the pool
+ */
+bool event_pool_release(void* payload)
+{
+    int32_t index = mem_pool_block_index(&event_payload_pool, payload);
+    if (index < 0) {
+        return false;
+    }
+
+    if (__atomic_sub_fetch(&pool_refcount[index], 1, __ATOMIC_ACQ_REL) == 0) {
+        // Last reference gone, return block to the pool
+        mem_pool_free(&event_payload_pool, payload);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check whether a pointer is a pooled payload
+ * @param payload Pointer to test
+ * @return true if payload is the start of a pool block
+ */
+bool event_pool_owns(const void* payload)
+{
+    return mem_pool_owns(&event_payload_pool, payload);
+}
+
+/**
+ * @brief Get payload pool statistics
+ * @return Copy of current statistics
+ */
+event_pool_stats_t event_pool_get_stats(void)
+{
+    mem_pool_stats_t pool_stats;
+    mem_pool_get_stats(&event_payload_pool, &pool_stats);
+
+    event_pool_stats_t stats = {
+        .alloc_count = pool_stats.alloc_count,
+        .alloc_fail_count = pool_stats.fail_count + size_fail_count,
+        .free_count = pool_stats.free_count,
+        .max_blocks_in_use = pool_stats.high_water,
+    };
+    return stats;
+}
+
+/**
+ * @brief Get number of free blocks
+ * @return Blocks currently available for allocation
+ */
+uint8_t event_pool_get_free_count(void)
+{
+    return (uint8_t)mem_pool_free_blocks(&event_payload_pool);
+}
@@ -0,0 +1,62 @@
+#ifndef EVENT_POOL_H
+#define EVENT_POOL_H
+
+/**
+ * @file event_pool.h
+ * @brief Fixed-block, reference-counted payload pool for the event bus
+ *
+ * Lets publishers hand large payloads to subscribers without a copy and
+ * without the 64-byte event_bus_publish() limit. The blocks come from a
+ * mem_pool (Utils/mem_pool.h); this module adds the reference counts.
+ *
+ * Example usage:
+ * - Publisher: p = event_pool_alloc(n); fill p; event_bus_publish_pooled(type, p, n)
+ * - Event bus releases the block after the last subscriber returns
+ * - Subscriber that needs the data later: event_pool_retain(event->data),
+ *   then event_pool_release() when done
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Pool Configuration
+#define EVENT_POOL_BLOCK_COUNT      8       // Max 255 (free count is reported as uint8_t)
+#define EVENT_POOL_BLOCK_SIZE       512     // Payload bytes per block
+
+// Pool Statistics
+typedef struct {
+    uint32_t alloc_count;              // Successful allocations
+    uint32_t alloc_fail_count;         // Allocations failed (pool empty / too large)
+    uint32_t free_count;               // Blocks returned to pool
+    uint32_t max_blocks_in_use;        // Peak number of blocks in use
+} event_pool_stats_t;
+
+// Payload Pool Functions
+void event_pool_init(void);
+
+/**
+ * @brief Allocate a payload block with a reference count of 1
+ * @note NON-BLOCKING: O(1), safe from tasks and ISRs
+ * @return Pointer to payload memory, or NULL if pool empty or size too large
+ */
+void* event_pool_alloc(uint32_t size);
+
+/**
+ * @brief Add a reference to a pooled payload
+ * @return true if payload belongs to the pool
+ */
+bool event_pool_retain(void* payload);
+
+/**
+ * @brief Drop a reference; the block is freed when the count reaches zero
+ * @return true if payload belongs to the pool
+ */
+bool event_pool_release(void* payload);
+
+bool event_pool_owns(const void* payload);
+
+// Diagnostics Functions
+event_pool_stats_t event_pool_get_stats(void);
+uint8_t event_pool_get_free_count(void);
+
+#endif // EVENT_POOL_H
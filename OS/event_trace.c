@@ -0,0 +1,330 @@
+/**
+ * @file event_trace.c
+ * @brief Event bus publish recorder, for replaying field timing on the host
+ */
+
+#include "event_trace.h"
+#include "portable_log.h"
+#include <string.h>
+
+#if EVENT_TRACE_ENABLE
+#include "os_wrapper.h"
+#include "SEGGER_RTT.h"
+#endif
+
+static const char *TAG = "EVTRACE";
+
+#define FNV_OFFSET_BASIS        2166136261u
+#define FNV_PRIME               16777619u
+
+#if EVENT_TRACE_ENABLE
+
+#define TRACE_MASK              (EVENT_TRACE_DEPTH - 1U)
+#define NO_STOP                 UINT32_MAX
+#define RTT_STALL_MS            1000U   // Give up on a probe that stopped reading
+#define WRITER_WAIT_MS          10U     // For a preempted writer to finish its slot
+
+#if (EVENT_TRACE_DEPTH & TRACE_MASK) != 0
+#error "EVENT_TRACE_DEPTH must be a power of two"
+#endif
+
+#if defined(SEGGER_RTT_MAX_NUM_UP_BUFFERS) && (EVENT_TRACE_RTT_CHANNEL >= SEGGER_RTT_MAX_NUM_UP_BUFFERS)
+#error "EVENT_TRACE_RTT_CHANNEL needs another RTT up-buffer (SEGGER_RTT_Conf.h)"
+#endif
+
+typedef struct {
+    uint32_t sequence;              // Write index + 1 once complete, 0 while written
+    event_trace_record_t record;
+} trace_slot_t;
+
+static trace_slot_t ring[EVENT_TRACE_DEPTH];
+static uint32_t write_index = 0;    // Claimed by writers (atomic add)
+static uint32_t stop_index = NO_STOP;   // Writes from here on are discarded
+static bool running = false;
+static bool frozen = false;
+
+static uint8_t rtt_buffer[EVENT_TRACE_RTT_BUFFER_SIZE];
+static bool rtt_configured = false;
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+// Records written since the start, not counting discarded ones
+static uint32_t written(void)
+{
+    uint32_t claimed = __atomic_load_n(&write_index, __ATOMIC_ACQUIRE);
+    uint32_t stop = __atomic_load_n(&stop_index, __ATOMIC_RELAXED);
+    return (claimed < stop) ? claimed : stop;
+}
+
+static bool rtt_write(const void *data, uint32_t size, void *ctx)
+{
+    (void)ctx;
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t idle_ms = 0;
+
+    while (size > 0) {
+        unsigned sent = SEGGER_RTT_Write(EVENT_TRACE_RTT_CHANNEL, bytes, size);
+        if (sent > 0) {
+            bytes += sent;
+            size -= sent;
+            idle_ms = 0;
+            continue;
+        }
+        if (++idle_ms > RTT_STALL_MS) {
+            return false;
+        }
+        os_delay_ms(1);
+    }
+    return true;
+}
+#endif
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+uint32_t event_trace_hash(const void *data, uint32_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t hash = FNV_OFFSET_BASIS;
+
+    for (uint32_t i = 0; i < size && bytes != NULL; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+void event_trace_record(event_type_t type, event_trace_source_t source, event_priority_t priority,
+                        const void *data, uint32_t data_size, uint16_t record_size,
+                        event_trace_outcome_t outcome)
+{
+#if EVENT_TRACE_ENABLE
+    if (!__atomic_load_n(&running, __ATOMIC_RELAXED)) {
+        return;
+    }
+
+    uint32_t index = __atomic_fetch_add(&write_index, 1, __ATOMIC_RELAXED);
+    if (index >= __atomic_load_n(&stop_index, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&running, false, __ATOMIC_RELAXED);
+        __atomic_store_n(&frozen, true, __ATOMIC_RELAXED);
+        return;
+    }
+
+    trace_slot_t *slot = &ring[index & TRACE_MASK];
+    __atomic_store_n(&slot->sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    event_trace_record_t *record = &slot->record;
+    uint32_t kept = (data == NULL) ? 0 : data_size;
+    if (kept > EVENT_TRACE_PAYLOAD_MAX) {
+        kept = EVENT_TRACE_PAYLOAD_MAX;
+    }
+
+    record->timestamp_us = event_bus_get_timestamp_us();
+    record->payload_hash = event_trace_hash(data, data_size);
+    record->type = (uint16_t)type;
+    record->data_size = (uint16_t)data_size;
+    record->record_size = record_size;
+    record->source = (uint8_t)source;
+    record->flags = (uint8_t)((uint32_t)priority & EVENT_TRACE_FLAG_PRIO_MASK);
+    if (outcome == EVENT_TRACE_REJECTED) {
+        record->flags |= EVENT_TRACE_FLAG_REJECTED;
+    } else if (outcome == EVENT_TRACE_ELIDED) {
+        record->flags |= EVENT_TRACE_FLAG_ELIDED;
+    }
+    if (kept < data_size) {
+        record->flags |= EVENT_TRACE_FLAG_TRUNCATED;
+    }
+    memset(record->payload, 0, sizeof(record->payload));
+    if (kept > 0) {
+        memcpy(record->payload, data, kept);
+    }
+
+    __atomic_store_n(&slot->sequence, index + 1U, __ATOMIC_RELEASE);
+
+#if EVENT_TRACE_FREEZE_ON_DROP
+    if (outcome == EVENT_TRACE_REJECTED) {
+        // First drop only: keep its lead-up, then a quarter ring after it
+        uint32_t expected = NO_STOP;
+        __atomic_compare_exchange_n(&stop_index, &expected, index + 1U + EVENT_TRACE_POST_DROP,
+                                    false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+    }
+#endif
+#else
+    (void)type;
+    (void)source;
+    (void)priority;
+    (void)data;
+    (void)data_size;
+    (void)record_size;
+    (void)outcome;
+#endif
+}
+
+void event_trace_start(void)
+{
+#if EVENT_TRACE_ENABLE
+    uint32_t mask = os_critical_enter();
+    running = false;
+    memset(ring, 0, sizeof(ring));
+    write_index = 0;
+    stop_index = NO_STOP;
+    frozen = false;
+    running = true;
+    os_critical_exit(mask);
+#endif
+}
+
+void event_trace_stop(void)
+{
+#if EVENT_TRACE_ENABLE
+    __atomic_store_n(&running, false, __ATOMIC_RELAXED);
+#endif
+}
+
+bool event_trace_is_running(void)
+{
+#if EVENT_TRACE_ENABLE
+    return __atomic_load_n(&running, __ATOMIC_RELAXED);
+#else
+    return false;
+#endif
+}
+
+bool event_trace_is_frozen(void)
+{
+#if EVENT_TRACE_ENABLE
+    return __atomic_load_n(&frozen, __ATOMIC_RELAXED);
+#else
+    return false;
+#endif
+}
+
+uint32_t event_trace_count(void)
+{
+#if EVENT_TRACE_ENABLE
+    uint32_t total = written();
+    return (total < EVENT_TRACE_DEPTH) ? total : EVENT_TRACE_DEPTH;
+#else
+    return 0;
+#endif
+}
+
+uint32_t event_trace_lost(void)
+{
+#if EVENT_TRACE_ENABLE
+    return written() - event_trace_count();
+#else
+    return 0;
+#endif
+}
+
+bool event_trace_get(uint32_t index, event_trace_record_t *record)
+{
+#if EVENT_TRACE_ENABLE
+    if (record == NULL || index >= event_trace_count()) {
+        return false;
+    }
+
+    uint32_t position = event_trace_lost() + index;
+    const trace_slot_t *slot = &ring[position & TRACE_MASK];
+
+    // Seqlock read: a writer that lapped the reader changes the sequence
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != position + 1U) {
+        return false;
+    }
+    *record = slot->record;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) == position + 1U;
+#else
+    (void)index;
+    (void)record;
+    return false;
+#endif
+}
+
+bool event_trace_export(event_trace_write_t write, void *ctx)
+{
+#if EVENT_TRACE_ENABLE
+    if (write == NULL) {
+        return false;
+    }
+
+    event_trace_stop();
+
+    // A writer may have claimed a slot before the stop and been preempted:
+    // give it time, and end the trace before its slot if it does not finish
+    uint32_t total = written();
+    uint32_t first = event_trace_lost();
+    for (uint32_t position = first; position < total; position++) {
+        uint32_t waited_ms = 0;
+        while (__atomic_load_n(&ring[position & TRACE_MASK].sequence, __ATOMIC_ACQUIRE) != position + 1U) {
+            if (++waited_ms > WRITER_WAIT_MS) {
+                break;
+            }
+            os_delay_ms(1);
+        }
+        if (waited_ms > WRITER_WAIT_MS) {
+            total = position;
+            break;
+        }
+    }
+
+    event_trace_header_t header = {
+        .magic = EVENT_TRACE_MAGIC,
+        .version = EVENT_TRACE_VERSION,
+        .record_bytes = (uint16_t)sizeof(event_trace_record_t),
+        .count = total - first,
+        .lost = first,
+    };
+    if (!write(&header, sizeof(header), ctx)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.count; i++) {
+        event_trace_record_t record;
+        if (!event_trace_get(i, &record) || !write(&record, sizeof(record), ctx)) {
+            return false;
+        }
+    }
+    return true;
+#else
+    (void)write;
+    (void)ctx;
+    return false;
+#endif
+}
+
+void event_trace_dump(bool force)
+{
+#if EVENT_TRACE_ENABLE
+    uint32_t count = event_trace_count();
+    uint32_t lost = event_trace_lost();
+    bool was_frozen = event_trace_is_frozen();
+
+    LOG_I(TAG, "Event trace: %lu records (%lu overwritten), %s", (unsigned long)count,
+          (unsigned long)lost, was_frozen ? "frozen on a drop" : (event_trace_is_running() ? "recording" : "stopped"));
+
+    if (!force && !was_frozen) {
+        return;
+    }
+
+    if (!rtt_configured) {
+        SEGGER_RTT_ConfigUpBuffer(EVENT_TRACE_RTT_CHANNEL, "EventTrace", rtt_buffer, sizeof(rtt_buffer),
+                                  SEGGER_RTT_MODE_NO_BLOCK_TRIM);
+        rtt_configured = true;
+    }
+
+    if (event_trace_export(rtt_write, NULL)) {
+        LOG_I(TAG, "Streamed %lu records to RTT channel %d", (unsigned long)count, EVENT_TRACE_RTT_CHANNEL);
+    } else {
+        LOG_W(TAG, "RTT channel %d not drained, trace discarded", EVENT_TRACE_RTT_CHANNEL);
+    }
+    event_trace_start();
+#else
+    (void)force;
+    LOG_W(TAG, "Event trace unavailable. Set EVENT_TRACE_ENABLE=1");
+#endif
+}
@@ -0,0 +1,232 @@
+/**
+ * @file event_trace.h
+ * @brief Event bus publish recorder, for replaying field timing on the host
+ *
+ * Records every publish the bus sees (task, pooled, batch, ISR and timer)
+ * into a RAM ring: time, type, lane, payload size, whether the bus took
+ * it, an FNV-1a hash of the whole payload and its first
+ * EVENT_TRACE_PAYLOAD_MAX bytes. The ring overwrites its oldest records,
+ * so it always holds the lead-up to now. With EVENT_TRACE_FREEZE_ON_DROP
+ * the first rejected publish (lane or ISR ring full) arms a stop
+ * EVENT_TRACE_POST_DROP records later, keeping the overflow with what led
+ * to it and what followed.
+ *
+ * Recording is lock-free and safe from tasks and ISRs: a writer claims
+ * a slot with one atomic add and stamps it with its sequence number when
+ * complete, so a reader skips a slot that is being rewritten. A record
+ * costs the hash and a copy of up to EVENT_TRACE_PAYLOAD_MAX bytes.
+ *
+ * event_trace_export() stops the recorder and writes the trace as one
+ * little-endian stream:
+ *
+ *   header   magic "EVTR" (u32), version (u16), bytes per record (u16),
+ *            records (u32), records lost to overwriting before them (u32)
+ *   records  event_trace_record_t, oldest first
+ *
+ * On target event_trace_dump() streams it to RTT up-channel
+ * EVENT_TRACE_RTT_CHANNEL, once the recorder froze on a drop (or always,
+ * with force), and arms it again; the periodic performance report calls
+ * it. The host build replays a capture through event_bus_process() and
+ * the subscribers linked there (Tests/host/event_replay.h).
+ *
+ * Off by default: with EVENT_TRACE_ENABLE 0 the record hook expands to
+ * nothing and the functions do nothing.
+ *
+ * Usage example:
+ * @code
+ * event_trace_dump(false);    // Ships the trace if a drop froze it
+ * // JLinkRTTLogger -Device STM32F767ZI -If SWD -Speed 4000 -RTTChannel 5 trace.bin
+ * // build/host/stm32_host trace trace.bin
+ * @endcode
+ */
+
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include "event_bus.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#ifndef EVENT_TRACE_ENABLE
+#define EVENT_TRACE_ENABLE          0
+#endif
+
+// Start recording from event_bus_init() (the host starts it per replay)
+#ifndef EVENT_TRACE_AUTOSTART
+#define EVENT_TRACE_AUTOSTART       1
+#endif
+
+#ifndef EVENT_TRACE_DEPTH
+#define EVENT_TRACE_DEPTH           128     // Records, power of two (40 B each)
+#endif
+
+#ifndef EVENT_TRACE_PAYLOAD_MAX
+#define EVENT_TRACE_PAYLOAD_MAX     24      // Payload bytes kept per record
+#endif
+
+#ifndef EVENT_TRACE_FREEZE_ON_DROP
+#define EVENT_TRACE_FREEZE_ON_DROP  1
+#endif
+
+#define EVENT_TRACE_POST_DROP       (EVENT_TRACE_DEPTH / 4)
+#define EVENT_TRACE_RTT_CHANNEL     5       // 0 text, 1 SystemView, 2 deferred log, 3 PC samples, 4 protocol
+#define EVENT_TRACE_RTT_BUFFER_SIZE 1024
+
+#define EVENT_TRACE_MAGIC           0x52545645u     // "EVTR"
+#define EVENT_TRACE_VERSION         1
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Publish path of a record (the replay takes the same one)
+ */
+typedef enum {
+    EVENT_TRACE_SRC_TASK = 0,       /**< event_bus_publish()/_prio(), payload copied */
+    EVENT_TRACE_SRC_POOLED,         /**< event_bus_publish_pooled() */
+    EVENT_TRACE_SRC_BATCH,          /**< event_bus_publish_batch() */
+    EVENT_TRACE_SRC_ISR,            /**< event_bus_publish_from_isr() */
+    EVENT_TRACE_SRC_TIMER,          /**< A delayed or periodic publish firing */
+    EVENT_TRACE_SRC_COUNT
+} event_trace_source_t;
+
+/**
+ * @brief What the bus did with a publish
+ */
+typedef enum {
+    EVENT_TRACE_QUEUED = 0,
+    EVENT_TRACE_REJECTED,           /**< Lane or ISR ring full, payload too large */
+    EVENT_TRACE_ELIDED              /**< No subscriber: dropped without queueing */
+} event_trace_outcome_t;
+
+#define EVENT_TRACE_FLAG_PRIO_MASK  0x03u   // Lane the publish asked for
+#define EVENT_TRACE_FLAG_REJECTED   0x04u   // The bus refused it (full, too large)
+#define EVENT_TRACE_FLAG_TRUNCATED  0x08u   // Payload longer than EVENT_TRACE_PAYLOAD_MAX
+#define EVENT_TRACE_FLAG_ELIDED     0x10u   // Nobody subscribed, so nothing was queued
+
+/**
+ * @brief One publish; also the wire layout of the exported records
+ */
+typedef struct {
+    uint32_t timestamp_us;          /**< event_bus_get_timestamp_us() at publish */
+    uint32_t payload_hash;          /**< FNV-1a over all data_size bytes */
+    uint16_t type;                  /**< event_type_t */
+    uint16_t data_size;
+    uint16_t record_size;           /**< Batch publishes: size of one record, else 0 */
+    uint8_t source;                 /**< event_trace_source_t */
+    uint8_t flags;                  /**< Priority and EVENT_TRACE_FLAG_* */
+    uint8_t payload[EVENT_TRACE_PAYLOAD_MAX];
+} event_trace_record_t;
+
+/**
+ * @brief Header of an exported trace
+ */
+typedef struct {
+    uint32_t magic;                 /**< EVENT_TRACE_MAGIC */
+    uint16_t version;               /**< EVENT_TRACE_VERSION */
+    uint16_t record_bytes;          /**< sizeof(event_trace_record_t) of the writer */
+    uint32_t count;                 /**< Records that follow */
+    uint32_t lost;                  /**< Overwritten before the first of them */
+} event_trace_header_t;
+
+/**
+ * @brief Byte sink for event_trace_export()
+ * @return false to abort the export
+ */
+typedef bool (*event_trace_write_t)(const void *data, uint32_t size, void *ctx);
+
+// ============================================================================
+// Record Hook
+// ============================================================================
+
+#if EVENT_TRACE_ENABLE
+#define EVENT_TRACE_RECORD(type, source, priority, data, size, record_size, outcome) \
+    event_trace_record((type), (source), (priority), (data), (size), (record_size), (outcome))
+#else
+#define EVENT_TRACE_RECORD(type, source, priority, data, size, record_size, outcome) \
+    do {} while (0)
+#endif
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Record one publish (task or ISR context)
+ *
+ * Called by the event bus; does nothing while the recorder is stopped.
+ */
+void event_trace_record(event_type_t type, event_trace_source_t source, event_priority_t priority,
+                        const void *data, uint32_t data_size, uint16_t record_size,
+                        event_trace_outcome_t outcome);
+
+/**
+ * @brief Clear the ring and start recording
+ */
+void event_trace_start(void);
+
+/**
+ * @brief Stop recording; the ring keeps what it holds
+ */
+void event_trace_stop(void);
+
+/**
+ * @brief true while publishes are recorded
+ */
+bool event_trace_is_running(void);
+
+/**
+ * @brief true once a rejected publish stopped the recorder
+ */
+bool event_trace_is_frozen(void);
+
+/**
+ * @brief Records held, oldest first from index 0
+ */
+uint32_t event_trace_count(void);
+
+/**
+ * @brief Records overwritten since the last start
+ */
+uint32_t event_trace_lost(void);
+
+/**
+ * @brief Read one held record
+ * @return false out of range, for a slot being rewritten, or compiled out
+ */
+bool event_trace_get(uint32_t index, event_trace_record_t *record);
+
+/**
+ * @brief Stop the recorder and write header and records to a sink
+ * @return false if the sink aborted or the recorder is compiled out
+ */
+bool event_trace_export(event_trace_write_t write, void *ctx);
+
+/**
+ * @brief FNV-1a hash, as stored in payload_hash
+ */
+uint32_t event_trace_hash(const void *data, uint32_t size);
+
+/**
+ * @brief Log the recorder state and stream the trace to RTT
+ *
+ * Streams when the recorder froze on a drop, or always with force, then
+ * starts it again. Blocks the caller while the probe drains the channel
+ * and gives up after a second without progress.
+ */
+void event_trace_dump(bool force);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EVENT_TRACE_H
@@ -0,0 +1,236 @@
+#include "os_boot.h"
+#include "os_wrapper.h"
+#include "hal_delay.h"
+#include "portable_log.h"
+#include <stddef.h>
+
+static const char *TAG = "BOOT";
+
+#define BOOT_WORKER_PRIORITY    OS_PRIORITY_LOW
+#define BOOT_RUNNER_CALLER      0       // Runner 1..OS_BOOT_WORKERS is a worker
+
+typedef struct {
+    const char *phase;
+    uint32_t time_us;
+} boot_mark_t;
+
+typedef struct {
+    uint32_t start_us;
+    uint32_t end_us;
+    uint8_t runner;
+} boot_timing_t;
+
+static boot_mark_t marks[OS_BOOT_MAX_MARKS];
+static uint8_t mark_count;
+
+static const os_boot_step_t *table;
+static uint8_t table_count;
+static uint32_t all_mask;
+static uint32_t async_mask;
+static volatile uint32_t claimed_mask;
+static volatile uint32_t done_mask;
+static bool reported;
+static boot_timing_t timings[OS_BOOT_MAX_STEPS];
+
+static uint32_t worker_stacks[OS_BOOT_WORKERS][(OS_BOOT_WORKER_STACK + 3) / 4] __attribute__((aligned(8)));
+static os_task_storage_t worker_storage[OS_BOOT_WORKERS];
+static os_task_handle_t worker_handles[OS_BOOT_WORKERS];
+static uint8_t worker_count;
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+// DWT counts from the clock setup in main(); boot ends well before it wraps
+static uint32_t boot_time_us(void)
+{
+    uint32_t cycles_per_us = hal_get_cpu_freq_hz() / 1000000U;
+    return hal_get_cycle_count() / ((cycles_per_us > 0) ? cycles_per_us : 1U);
+}
+
+static bool step_ready(uint8_t step)
+{
+    return (table[step].deps & ~done_mask) == 0;
+}
+
+static bool step_claim(uint8_t step)
+{
+    uint32_t bit = OS_BOOT_DEP(step);
+    uint32_t mask = os_critical_enter();
+    bool claimed = (claimed_mask & bit) == 0;
+    claimed_mask |= bit;
+    os_critical_exit(mask);
+    return claimed;
+}
+
+static void step_run(uint8_t step, uint8_t runner)
+{
+    timings[step].runner = runner;
+    timings[step].start_us = boot_time_us();
+    table[step].init();
+    timings[step].end_us = boot_time_us();
+
+    uint32_t mask = os_critical_enter();
+    done_mask |= OS_BOOT_DEP(step);
+    bool report = (done_mask == all_mask) && !reported;
+    reported |= report;
+    os_critical_exit(mask);
+
+    if (report) {
+        os_boot_mark("init done");
+        os_boot_report();
+    }
+}
+
+/**
+ * @brief Claim and run one async step whose dependencies are done
+ * @return false if none was ready
+ */
+static bool run_ready_async(uint8_t runner)
+{
+    for (uint8_t step = 0; step < table_count; step++) {
+        if ((async_mask & OS_BOOT_DEP(step)) && !(claimed_mask & OS_BOOT_DEP(step)) &&
+            step_ready(step) && step_claim(step)) {
+            step_run(step, runner);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void worker_task(void *param)
+{
+    uint8_t runner = (uint8_t)(uintptr_t)param;
+
+    while ((claimed_mask & async_mask) != async_mask) {
+        if (!run_ready_async(runner)) {
+            os_delay_ms(OS_BOOT_POLL_MS);
+        }
+    }
+
+    worker_handles[runner - 1] = NULL;
+    os_task_delete(NULL);  // Delete self
+}
+
+static void start_workers(void)
+{
+    worker_count = 0;
+    for (uint8_t i = 0; i < OS_BOOT_WORKERS; i++) {
+        if (worker_handles[i] != NULL) {
+            continue;   // Still finishing a previous table
+        }
+        if (os_task_create_static(worker_task, "boot", sizeof(worker_stacks[i]),
+                                  (void *)(uintptr_t)(i + 1), BOOT_WORKER_PRIORITY,
+                                  worker_stacks[i], &worker_storage[i],
+                                  &worker_handles[i]) != OS_SUCCESS) {
+            LOG_W(TAG, "Boot worker %u not started", (unsigned)(i + 1));
+            worker_handles[i] = NULL;
+            continue;
+        }
+        worker_count++;
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void os_boot_mark(const char *phase)
+{
+    uint32_t now = boot_time_us();
+    uint32_t mask = os_critical_enter();
+    if (mark_count < OS_BOOT_MAX_MARKS) {
+        marks[mark_count].phase = phase;
+        marks[mark_count].time_us = now;
+        mark_count++;
+    }
+    os_critical_exit(mask);
+}
+
+bool os_boot_run(const os_boot_step_t *steps, uint8_t count)
+{
+    if (steps == NULL || count == 0 || count > OS_BOOT_MAX_STEPS) {
+        return false;
+    }
+    for (uint8_t step = 0; step < count; step++) {
+        // Earlier steps only: rules out cycles
+        if (steps[step].init == NULL || (steps[step].deps & ~(OS_BOOT_DEP(step) - 1U)) != 0) {
+            LOG_E(TAG, "Step %u (%s) invalid", (unsigned)step,
+                  (steps[step].name != NULL) ? steps[step].name : "?");
+            return false;
+        }
+    }
+
+    table = steps;
+    table_count = count;
+    all_mask = OS_BOOT_DEP(count) - 1U;
+    async_mask = 0;
+    for (uint8_t step = 0; step < count; step++) {
+        if (steps[step].async) {
+            async_mask |= OS_BOOT_DEP(step);
+        }
+    }
+    claimed_mask = 0;
+    done_mask = 0;
+    reported = false;
+
+    if (async_mask != 0) {
+        start_workers();
+    }
+
+    for (uint8_t step = 0; step < count; step++) {
+        if (steps[step].async) {
+            continue;
+        }
+        while (!step_ready(step)) {
+            // Without workers the caller runs the async steps it waits for
+            if (worker_count > 0 || !run_ready_async(BOOT_RUNNER_CALLER)) {
+                os_delay_ms(OS_BOOT_POLL_MS);
+            }
+        }
+        step_claim(step);
+        step_run(step, BOOT_RUNNER_CALLER);
+    }
+
+    if (worker_count == 0) {
+        while (run_ready_async(BOOT_RUNNER_CALLER)) {
+        }
+    }
+    return worker_count > 0 || async_mask == 0;
+}
+
+bool os_boot_wait_all(uint32_t timeout_ms)
+{
+    uint32_t start = os_get_time_ms();
+    while (done_mask != all_mask) {
+        if (os_get_time_ms() - start >= timeout_ms) {
+            return false;
+        }
+        os_delay_ms(OS_BOOT_POLL_MS);
+    }
+    return true;
+}
+
+bool os_boot_step_done(uint8_t step)
+{
+    return step < table_count && (done_mask & OS_BOOT_DEP(step)) != 0;
+}
+
+void os_boot_report(void)
+{
+    for (uint8_t i = 0; i < mark_count; i++) {
+        LOG_I(TAG, "%8lu us  %s", (unsigned long)marks[i].time_us, marks[i].phase);
+    }
+
+    for (uint8_t step = 0; step < table_count; step++) {
+        if (!(done_mask & OS_BOOT_DEP(step))) {
+            LOG_I(TAG, "  %-16s pending", table[step].name);
+            continue;
+        }
+        const boot_timing_t *timing = &timings[step];
+        LOG_I(TAG, "  %-16s at %8lu us, %7lu us on runner %u (0 = caller)", table[step].name,
+              (unsigned long)timing->start_us,
+              (unsigned long)(timing->end_us - timing->start_us),
+              (unsigned)timing->runner);
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef OS_BOOT_H
+#define OS_BOOT_H
+
+/**
+ * @file os_boot.h
+ * @brief Boot-phase timestamps and a dependency graph of init steps
+ *
+ * os_boot_mark() stamps a phase (clock up, peripherals, scheduler ...) in
+ * microseconds since the DWT cycle counter was started in main().
+ *
+ * os_boot_run() executes a table of init steps. A step runs once every
+ * step in its deps mask has finished. Synchronous steps run on the calling
+ * task in table order; async steps run on OS_BOOT_WORKERS worker tasks as
+ * soon as they are ready, so slow ones (display power-up, sensor warm-up)
+ * no longer hold back the ones behind them. os_boot_run() returns when the
+ * synchronous steps are done; async steps may still be running, and the
+ * last one to finish logs the boot report.
+ *
+ * Usage example:
+ * @code
+ * enum { STEP_LOG, STEP_DISPLAY, STEP_PROTOCOL };
+ * static const os_boot_step_t steps[] = {
+ *     [STEP_LOG]      = { "log",      log_init,      0,                   false },
+ *     [STEP_DISPLAY]  = { "display",  display_init,  0,                   true  },
+ *     [STEP_PROTOCOL] = { "protocol", protocol_init, OS_BOOT_DEP(STEP_LOG), false },
+ * };
+ * os_boot_run(steps, 3);
+ * @endcode
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define OS_BOOT_MAX_STEPS       24
+#define OS_BOOT_MAX_MARKS       8
+#define OS_BOOT_WORKERS         2
+#define OS_BOOT_WORKER_STACK    2048
+#define OS_BOOT_POLL_MS         1       // Wait for a dependency in this step
+
+#define OS_BOOT_DEP(step)       (1UL << (step))
+
+typedef struct {
+    const char *name;
+    void (*init)(void);
+    uint32_t deps;              // OS_BOOT_DEP() of the steps that must finish first
+    bool async;                 // Run on a boot worker rather than the caller
+} os_boot_step_t;
+
+/**
+ * @brief Record a boot phase (any context; later marks past OS_BOOT_MAX_MARKS are dropped)
+ */
+void os_boot_mark(const char *phase);
+
+/**
+ * @brief Run the init graph
+ *
+ * Steps must only depend on earlier steps of the table. The table must
+ * stay valid until every async step has finished.
+ *
+ * @return false if the table is invalid or a worker could not start (the
+ *         async steps then ran on the caller)
+ */
+bool os_boot_run(const os_boot_step_t *steps, uint8_t count);
+
+/**
+ * @brief Wait until every step, async ones included, has finished
+ * @return false on timeout
+ */
+bool os_boot_wait_all(uint32_t timeout_ms);
+
+/**
+ * @brief Whether a step of the running table has finished
+ */
+bool os_boot_step_done(uint8_t step);
+
+/**
+ * @brief Log the marks and each step's start, duration and task
+ */
+void os_boot_report(void);
+
+#endif // OS_BOOT_H
@@ -31,7 +31,8 @@
 // Bare-Metal Configuration
 #if !USE_FREERTOS
 
-// Main loop timing
+// Main loop timing: polled jobs run every period; jobs posted through
+// os_sched.h run as soon as the current one returns
 #define MAIN_LOOP_PERIOD_MS     10  // Main loop runs every 10ms
 
 #endif
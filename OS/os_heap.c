@@ -0,0 +1,327 @@
+#include "os_heap.h"
+#include <string.h>
+
+#if defined(ESP_PLATFORM) || defined(IDF_VER)
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+#else
+    #include "FreeRTOS.h"
+    #include "task.h"
+#endif
+
+// Free blocks are linked through their header; an allocated block keeps
+// its size with HEAP_USED_BIT set and next = NULL
+typedef struct heap_block {
+    struct heap_block *next;
+    size_t size;                // Header included
+} heap_block_t;
+
+#define HEAP_HEADER_SIZE    ((sizeof(heap_block_t) + OS_HEAP_ALIGN - 1) & ~(size_t)(OS_HEAP_ALIGN - 1))
+#define HEAP_MIN_BLOCK      (HEAP_HEADER_SIZE * 2)     // Smaller remainders are not split off
+#define HEAP_USED_BIT       ((size_t)1 << (sizeof(size_t) * 8 - 1))
+
+typedef struct {
+    uint8_t *start;
+    uint8_t *end;
+    heap_block_t *free_list;    // Address order
+    os_heap_class_t heap_class;
+} heap_region_t;
+
+typedef struct {
+    uint32_t total_bytes;
+    uint32_t free_bytes;
+    uint32_t min_free_bytes;
+    uint32_t alloc_count;
+    uint32_t free_count;
+    uint32_t fallback_count;
+    uint32_t fail_count;
+} heap_class_state_t;
+
+static heap_region_t regions[OS_HEAP_MAX_REGIONS];
+static uint8_t region_count;
+static heap_class_state_t classes[OS_HEAP_CLASS_COUNT];
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+// Scheduler lock, as heap_4: the idle task frees deleted tasks through
+// vPortFree(), so a mutex (which the idle task must not block on) won't do
+static void heap_lock(void)
+{
+    vTaskSuspendAll();
+}
+
+static void heap_unlock(void)
+{
+    (void)xTaskResumeAll();
+}
+
+static heap_region_t *region_of(const void *ptr)
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+    for (uint8_t i = 0; i < region_count; i++) {
+        if (p >= regions[i].start && p < regions[i].end) {
+            return &regions[i];
+        }
+    }
+    return NULL;
+}
+
+static void class_account(os_heap_class_t heap_class, int32_t delta)
+{
+    heap_class_state_t *state = &classes[heap_class];
+    state->free_bytes = (uint32_t)((int32_t)state->free_bytes + delta);
+    if (state->free_bytes < state->min_free_bytes) {
+        state->min_free_bytes = state->free_bytes;
+    }
+}
+
+/**
+ * @brief First fit in one region; splits off the tail when it is big enough
+ */
+static void *region_alloc(heap_region_t *region, size_t block_size)
+{
+    heap_block_t **link = &region->free_list;
+    while (*link != NULL && (*link)->size < block_size) {
+        link = &(*link)->next;
+    }
+
+    heap_block_t *block = *link;
+    if (block == NULL) {
+        return NULL;
+    }
+
+    if (block->size - block_size >= HEAP_MIN_BLOCK) {
+        heap_block_t *rest = (heap_block_t *)((uint8_t *)block + block_size);
+        rest->size = block->size - block_size;
+        rest->next = block->next;
+        block->size = block_size;
+        *link = rest;
+    } else {
+        *link = block->next;
+    }
+
+    class_account(region->heap_class, -(int32_t)block->size);
+    block->size |= HEAP_USED_BIT;
+    block->next = NULL;
+    return (uint8_t *)block + HEAP_HEADER_SIZE;
+}
+
+/**
+ * @brief Put a block back in address order, merged with free neighbours
+ */
+static void region_insert(heap_region_t *region, heap_block_t *block)
+{
+    heap_block_t *prev = NULL;
+    heap_block_t *next = region->free_list;
+    while (next != NULL && next < block) {
+        prev = next;
+        next = next->next;
+    }
+
+    if (next != NULL && (uint8_t *)block + block->size == (uint8_t *)next) {
+        block->size += next->size;
+        block->next = next->next;
+    } else {
+        block->next = next;
+    }
+
+    if (prev != NULL && (uint8_t *)prev + prev->size == (uint8_t *)block) {
+        prev->size += block->size;
+        prev->next = block->next;
+    } else if (prev != NULL) {
+        prev->next = block;
+    } else {
+        region->free_list = block;
+    }
+}
+
+static void *class_alloc(os_heap_class_t heap_class, size_t block_size)
+{
+    for (uint8_t i = 0; i < region_count; i++) {
+        if (regions[i].heap_class == heap_class) {
+            void *ptr = region_alloc(&regions[i], block_size);
+            if (ptr != NULL) {
+                classes[heap_class].alloc_count++;
+                return ptr;
+            }
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool os_heap_add_region(os_heap_class_t heap_class, void *base, size_t size)
+{
+    if (heap_class >= OS_HEAP_CLASS_COUNT || base == NULL || region_count >= OS_HEAP_MAX_REGIONS) {
+        return false;
+    }
+
+    uintptr_t start = ((uintptr_t)base + OS_HEAP_ALIGN - 1) & ~(uintptr_t)(OS_HEAP_ALIGN - 1);
+    uintptr_t end = ((uintptr_t)base + size) & ~(uintptr_t)(OS_HEAP_ALIGN - 1);
+    if (end <= start || end - start < HEAP_MIN_BLOCK) {
+        return false;
+    }
+
+    heap_lock();
+    heap_region_t *region = &regions[region_count];
+    region->start = (uint8_t *)start;
+    region->end = (uint8_t *)end;
+    region->heap_class = heap_class;
+    region->free_list = (heap_block_t *)start;
+    region->free_list->size = end - start;
+    region->free_list->next = NULL;
+    region_count++;
+
+    heap_class_state_t *state = &classes[heap_class];
+    state->total_bytes += (uint32_t)(end - start);
+    state->free_bytes += (uint32_t)(end - start);
+    state->min_free_bytes = state->free_bytes;
+    heap_unlock();
+    return true;
+}
+
+void *os_heap_alloc(size_t size, os_heap_class_t hint)
+{
+    if (size == 0 || hint >= OS_HEAP_CLASS_COUNT || size > HEAP_USED_BIT - HEAP_HEADER_SIZE - OS_HEAP_ALIGN) {
+        return NULL;
+    }
+    size_t block_size = (size + HEAP_HEADER_SIZE + OS_HEAP_ALIGN - 1) & ~(size_t)(OS_HEAP_ALIGN - 1);
+
+    heap_lock();
+    void *ptr = class_alloc(hint, block_size);
+    if (ptr == NULL) {
+        for (uint8_t other = 0; other < OS_HEAP_CLASS_COUNT && ptr == NULL; other++) {
+            if (other != hint) {
+                ptr = class_alloc((os_heap_class_t)other, block_size);
+            }
+        }
+        if (ptr != NULL) {
+            classes[hint].fallback_count++;
+        } else {
+            classes[hint].fail_count++;
+        }
+    }
+    heap_unlock();
+    return ptr;
+}
+
+void os_heap_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    heap_lock();
+    heap_region_t *region = region_of(ptr);
+    heap_block_t *block = (heap_block_t *)((uint8_t *)ptr - HEAP_HEADER_SIZE);
+    // Not ours, or freed twice: leave the lists alone
+    if (region != NULL && (uint8_t *)block >= region->start &&
+        (block->size & HEAP_USED_BIT) && block->next == NULL) {
+        block->size &= ~HEAP_USED_BIT;
+        class_account(region->heap_class, (int32_t)block->size);
+        classes[region->heap_class].free_count++;
+        region_insert(region, block);
+    }
+    heap_unlock();
+}
+
+os_heap_class_t os_heap_class_of(const void *ptr)
+{
+    const heap_region_t *region = region_of(ptr);
+    return (region != NULL) ? region->heap_class : OS_HEAP_CLASS_COUNT;
+}
+
+bool os_heap_get_stats(os_heap_class_t heap_class, os_heap_stats_t *stats)
+{
+    if (heap_class >= OS_HEAP_CLASS_COUNT || stats == NULL) {
+        return false;
+    }
+
+    heap_lock();
+    const heap_class_state_t *state = &classes[heap_class];
+    memset(stats, 0, sizeof(*stats));
+    stats->total_bytes = state->total_bytes;
+    stats->free_bytes = state->free_bytes;
+    stats->min_free_bytes = state->min_free_bytes;
+    stats->alloc_count = state->alloc_count;
+    stats->free_count = state->free_count;
+    stats->fallback_count = state->fallback_count;
+    stats->fail_count = state->fail_count;
+
+    for (uint8_t i = 0; i < region_count; i++) {
+        if (regions[i].heap_class != heap_class) {
+            continue;
+        }
+        for (const heap_block_t *block = regions[i].free_list; block != NULL; block = block->next) {
+            uint32_t usable = (uint32_t)(block->size - HEAP_HEADER_SIZE);
+            if (usable > stats->largest_free) {
+                stats->largest_free = usable;
+            }
+        }
+    }
+    heap_unlock();
+    return true;
+}
+
+// ============================================================================
+// FreeRTOS Port Allocator (replaces heap_4.c)
+// ============================================================================
+
+#if !defined(ESP_PLATFORM) && !defined(IDF_VER)
+// ESP-IDF brings its own heap_caps allocator
+
+void *pvPortMalloc(size_t xWantedSize)
+{
+    void *ptr = os_heap_alloc(xWantedSize, OS_HEAP_FAST);
+    traceMALLOC(ptr, xWantedSize);
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+    if (ptr == NULL) {
+        extern void vApplicationMallocFailedHook(void);
+        vApplicationMallocFailedHook();
+    }
+#endif
+    return ptr;
+}
+
+void vPortFree(void *pv)
+{
+    if (pv != NULL) {
+        traceFREE(pv, 0);
+        os_heap_free(pv);
+    }
+}
+
+void vPortInitialiseBlocks(void)
+{
+    // Regions are set up by os_heap_add_region()
+}
+
+size_t xPortGetFreeHeapSize(void)
+{
+    size_t free_bytes = 0;
+    heap_lock();
+    for (uint8_t i = 0; i < OS_HEAP_CLASS_COUNT; i++) {
+        free_bytes += classes[i].free_bytes;
+    }
+    heap_unlock();
+    return free_bytes;
+}
+
+// Sum of the per-class low-water marks: never above the true minimum
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+    size_t min_free = 0;
+    heap_lock();
+    for (uint8_t i = 0; i < OS_HEAP_CLASS_COUNT; i++) {
+        min_free += classes[i].min_free_bytes;
+    }
+    heap_unlock();
+    return min_free;
+}
+
+#endif // !ESP_PLATFORM
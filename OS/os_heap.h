@@ -0,0 +1,88 @@
+#ifndef OS_HEAP_H
+#define OS_HEAP_H
+
+/**
+ * @file os_heap.h
+ * @brief Multi-region heap with placement hints (DTCM / SRAM1 / SRAM2)
+ *
+ * Regions are registered once at boot (main.c), each under a class:
+ *   OS_HEAP_FAST   zero-wait-state DTCM: queues, pools and other objects
+ *                  touched on hot paths
+ *   OS_HEAP_BULK   SRAM1 and the free tail of SRAM2: capture buffers and
+ *                  other large, rarely touched blocks
+ *
+ * An allocation tries its hinted class first and falls back to the other
+ * one when that is full (counted in fallback_count), so a hint never makes
+ * an allocation fail that would otherwise fit. Each region is a first-fit,
+ * address-ordered free list that coalesces on free, as FreeRTOS heap_4/5.
+ *
+ * This is also the FreeRTOS heap: os_heap.c provides pvPortMalloc() and
+ * vPortFree() in place of heap_4.c, hinted OS_HEAP_FAST, so tasks, queues
+ * and event pools created with os_*_create() land in DTCM while it lasts.
+ * The C library's malloc() is hinted OS_HEAP_BULK (sysmem.c), which is
+ * where capture buffers such as sensor_ring_buffer_init() storage go.
+ * configTOTAL_HEAP_SIZE is not used; the regions in main.c are the heap.
+ * Locked by suspending the scheduler, as heap_4. Not callable from ISRs.
+ *
+ * Usage example:
+ * @code
+ * sensor_sample_t *capture = os_heap_alloc(count * sizeof(*capture), OS_HEAP_BULK);
+ * if (capture != NULL) {
+ *     ...
+ *     os_heap_free(capture);
+ * }
+ * @endcode
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define OS_HEAP_MAX_REGIONS     4
+#define OS_HEAP_ALIGN           8
+
+typedef enum {
+    OS_HEAP_FAST = 0,
+    OS_HEAP_BULK,
+    OS_HEAP_CLASS_COUNT
+} os_heap_class_t;
+
+typedef struct {
+    uint32_t total_bytes;       // All regions of the class, headers included
+    uint32_t free_bytes;
+    uint32_t min_free_bytes;    // Low-water mark of free_bytes
+    uint32_t largest_free;      // Biggest single allocation that fits now
+    uint32_t alloc_count;       // Blocks handed out from this class
+    uint32_t free_count;
+    uint32_t fallback_count;    // Allocations hinted here, served by the other class
+    uint32_t fail_count;        // Allocations hinted here that fit nowhere
+} os_heap_stats_t;
+
+/**
+ * @brief Give a memory range to the heap (boot, before any allocation)
+ *
+ * The range is trimmed to OS_HEAP_ALIGN. Must not overlap another region.
+ *
+ * @return false if the region table is full or the range is too small
+ */
+bool os_heap_add_region(os_heap_class_t heap_class, void *base, size_t size);
+
+/**
+ * @brief Allocate from the hinted class, or from the other one if it is full
+ * @return OS_HEAP_ALIGN-aligned block, or NULL
+ */
+void *os_heap_alloc(size_t size, os_heap_class_t hint);
+
+/**
+ * @brief Return a block from os_heap_alloc() (NULL is ignored)
+ */
+void os_heap_free(void *ptr);
+
+/**
+ * @brief Class the block was served from (OS_HEAP_CLASS_COUNT if not a heap block)
+ */
+os_heap_class_t os_heap_class_of(const void *ptr);
+
+bool os_heap_get_stats(os_heap_class_t heap_class, os_heap_stats_t *stats);
+
+#endif // OS_HEAP_H
@@ -0,0 +1,71 @@
+#include "os_power.h"
+
+#if !defined(ESP_PLATFORM) && !defined(IDF_VER)
+// ESP-IDF brings its own tickless idle (CONFIG_FREERTOS_USE_TICKLESS_IDLE)
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32f7xx_hal.h"
+#include "hal_power.h"
+
+#if configUSE_TICKLESS_IDLE == 2
+
+#define TICK_US     (1000000UL / configTICK_RATE_HZ)
+
+void os_power_suppress_ticks_and_sleep(uint32_t expected_idle_ticks)
+{
+    uint32_t cycles_per_tick = SysTick->LOAD + 1U;
+    uint32_t max_ticks = HAL_POWER_MAX_IDLE_US / TICK_US;
+
+    if (expected_idle_ticks > max_ticks) {
+        expected_idle_ticks = max_ticks;
+    }
+
+    // Stop the tick and note how far into the current period it was
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        // A task became ready meanwhile: resume the period where it stopped
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        __enable_irq();
+        return;
+    }
+
+    uint32_t cycles_into_tick = cycles_per_tick - SysTick->VAL;
+    uint32_t into_tick_us = (uint32_t)(((uint64_t)cycles_into_tick * TICK_US) / cycles_per_tick);
+    uint32_t sleep_us = expected_idle_ticks * TICK_US - into_tick_us;
+
+    uint32_t since_tick_us = into_tick_us + hal_power_idle(sleep_us);
+    uint32_t ticks = since_tick_us / TICK_US;
+    uint32_t rest_us = since_tick_us % TICK_US;
+
+    uint32_t first_period = cycles_per_tick;
+    if (ticks >= expected_idle_ticks) {
+        // The wake-up tick is due now; the SysTick handler unblocks the task
+        ticks = expected_idle_ticks - 1U;
+        SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+    } else {
+        // Finish the period the sleep ended in
+        first_period -= (uint32_t)(((uint64_t)rest_us * cycles_per_tick) / TICK_US);
+        if (first_period < 2U) {
+            first_period = 2U;
+        }
+    }
+    if (ticks > 0) {
+        vTaskStepTick(ticks);
+    }
+
+    // Full periods again from the next underflow on
+    SysTick->LOAD = first_period - 1U;
+    SysTick->VAL = 0;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = cycles_per_tick - 1U;
+    __enable_irq();
+}
+
+#endif // configUSE_TICKLESS_IDLE == 2
+
+#endif // !ESP_PLATFORM
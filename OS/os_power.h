@@ -0,0 +1,24 @@
+#ifndef OS_POWER_H
+#define OS_POWER_H
+
+/**
+ * @file os_power.h
+ * @brief FreeRTOS tickless idle on top of hal_power
+ *
+ * With configUSE_TICKLESS_IDLE 2 the kernel calls
+ * os_power_suppress_ticks_and_sleep() from the idle task whenever no task
+ * is due for at least configEXPECTED_IDLE_TIME_BEFORE_SLEEP ticks. The
+ * SysTick is stopped, hal_power_idle() sleeps until the next task is due
+ * (or an interrupt arrives), and the tick count is stepped by the time
+ * slept, carrying the sub-tick rest to the next sleep.
+ */
+
+#include <stdint.h>
+
+/**
+ * @brief portSUPPRESS_TICKS_AND_SLEEP() implementation (idle task only)
+ * @param expected_idle_ticks Ticks until the next task unblocks
+ */
+void os_power_suppress_ticks_and_sleep(uint32_t expected_idle_ticks);
+
+#endif // OS_POWER_H
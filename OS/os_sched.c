@@ -0,0 +1,147 @@
+#include "os_sched.h"
+#include "os_wrapper.h"
+#include "hal_delay.h"
+#include "hal_power.h"
+#include "stm32f7xx_hal.h"
+#include <stddef.h>
+
+static os_sched_job_t jobs[OS_SCHED_MAX_JOBS];
+static volatile uint32_t ready_mask = 0;
+static volatile os_sched_stats_t stats;
+static os_semaphore_handle_t wake_semaphore = NULL;
+
+OS_SEMAPHORE_DEFINE(sched_wake);
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static bool mark_ready(uint8_t priority)
+{
+    if (priority >= OS_SCHED_MAX_JOBS || jobs[priority] == NULL) {
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    ready_mask |= (1UL << priority);
+    stats.posts++;
+    os_critical_exit(mask);
+    return true;
+}
+
+/**
+ * @brief Take the highest ready job off the mask
+ * @return Its priority, or OS_SCHED_MAX_JOBS if none is ready
+ */
+static uint8_t take_highest(void)
+{
+    uint32_t mask = os_critical_enter();
+    uint32_t ready = ready_mask;
+    uint8_t priority = OS_SCHED_MAX_JOBS;
+    if (ready != 0) {
+        priority = (uint8_t)(31U - (uint32_t)__builtin_clz(ready));
+        ready_mask = ready & ~(1UL << priority);
+    }
+    os_critical_exit(mask);
+    return priority;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool os_sched_init(void)
+{
+    if (wake_semaphore != NULL) {
+        return true;
+    }
+
+    wake_semaphore = OS_SEMAPHORE_CREATE_BINARY_STATIC(sched_wake);
+    return wake_semaphore != NULL;
+}
+
+bool os_sched_add(uint8_t priority, os_sched_job_t job)
+{
+    if (priority >= OS_SCHED_MAX_JOBS || job == NULL || jobs[priority] != NULL) {
+        return false;
+    }
+
+    jobs[priority] = job;
+    return true;
+}
+
+void os_sched_post(uint8_t priority)
+{
+    if (mark_ready(priority) && wake_semaphore != NULL) {
+        os_semaphore_give(wake_semaphore);
+    }
+}
+
+void os_sched_post_from_isr(uint8_t priority, bool *higher_priority_task_woken)
+{
+    if (mark_ready(priority) && wake_semaphore != NULL) {
+        os_semaphore_give_from_isr(wake_semaphore, higher_priority_task_woken);
+    }
+}
+
+uint32_t os_sched_dispatch(void)
+{
+    uint32_t count = 0;
+
+    // Re-read after every job: a higher priority post goes next
+    for (uint8_t priority = take_highest(); priority < OS_SCHED_MAX_JOBS;
+         priority = take_highest()) {
+        uint32_t start = hal_get_cycle_count();
+        jobs[priority]();
+        uint32_t cycles = hal_get_cycle_count() - start;
+
+        if (cycles > stats.max_job_cycles) {
+            stats.max_job_cycles = cycles;
+        }
+        count++;
+    }
+
+    stats.runs += count;
+    return count;
+}
+
+void os_sched_idle(uint32_t timeout_ms)
+{
+    if (timeout_ms == 0 || ready_mask != 0) {
+        return;
+    }
+
+    if (os_kernel_is_running()) {
+        // A give left over from a job that already ran only ends this wait early
+        if (wake_semaphore != NULL) {
+            os_semaphore_take(wake_semaphore, timeout_ms);
+        } else {
+            os_delay_ms(timeout_ms);
+        }
+        stats.idles++;
+        return;
+    }
+
+    // No kernel: sleep with interrupts masked; a pending one still wakes the core
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (ready_mask == 0) {
+        hal_power_idle(timeout_ms * 1000U);
+        stats.idles++;
+    }
+    __set_PRIMASK(primask);
+}
+
+void os_sched_get_stats(os_sched_stats_t *stats_out)
+{
+    if (stats_out == NULL) {
+        return;
+    }
+
+    uint32_t mask = os_critical_enter();
+    stats_out->posts = stats.posts;
+    stats_out->runs = stats.runs;
+    stats_out->idles = stats.idles;
+    stats_out->max_job_cycles = stats.max_job_cycles;
+    os_critical_exit(mask);
+}
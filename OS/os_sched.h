@@ -0,0 +1,88 @@
+#ifndef OS_SCHED_H
+#define OS_SCHED_H
+
+/**
+ * @file os_sched.h
+ * @brief Cooperative run-to-completion job scheduler
+ *
+ * Up to OS_SCHED_MAX_JOBS jobs share one thread of execution (the bare-
+ * metal main loop, or one task). Each job has a fixed priority, which is
+ * also its bit in a ready mask. os_sched_post() sets the bit from task or
+ * ISR context; os_sched_dispatch() runs the highest ready job to
+ * completion, re-reads the mask and repeats until nothing is ready. A job
+ * posted while another runs waits for it to return, never longer.
+ *
+ * os_sched_idle() sleeps until the next post or the timeout:
+ * - Before the RTOS kernel runs (bare metal): SLEEP via hal_power_idle()
+ *   with interrupts masked, so a post from an ISR cannot slip in between
+ *   the check and the WFI.
+ * - In a task: blocks on a binary semaphore the posts give.
+ *
+ * Usage example:
+ * @code
+ * os_sched_init();
+ * os_sched_add(JOB_UART, uart_job);        // Posted by the UART ISR
+ * os_sched_add(JOB_HOUSEKEEPING, poll);    // Posted every period
+ *
+ * while (1) {
+ *     os_sched_dispatch();
+ *     os_sched_idle(time_to_next_period_ms);
+ * }
+ * @endcode
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define OS_SCHED_MAX_JOBS       32      // Priorities 0 (lowest) to 31
+
+typedef void (*os_sched_job_t)(void);
+
+typedef struct {
+    uint32_t posts;                 // os_sched_post*() calls, repeats included
+    uint32_t runs;                  // Jobs run
+    uint32_t idles;                 // os_sched_idle() calls that slept
+    uint32_t max_job_cycles;        // Longest job; bounds the latency a post sees
+} os_sched_stats_t;
+
+/**
+ * @brief Create the wake-up semaphore
+ * @return true on success (or if already initialized)
+ */
+bool os_sched_init(void);
+
+/**
+ * @brief Register a job at a priority (one job per priority)
+ * @return false if the priority is out of range or taken
+ */
+bool os_sched_add(uint8_t priority, os_sched_job_t job);
+
+/**
+ * @brief Mark a job ready (task context)
+ * @note NON-BLOCKING. Posts before the job runs collapse into one run.
+ */
+void os_sched_post(uint8_t priority);
+
+/**
+ * @brief Mark a job ready (ISR context)
+ * @param higher_priority_task_woken Set to true if the scheduling task was woken
+ */
+void os_sched_post_from_isr(uint8_t priority, bool *higher_priority_task_woken);
+
+/**
+ * @brief Run ready jobs, highest priority first, until none is ready
+ * @note Call from the scheduler's one thread only
+ * @return Number of jobs run
+ */
+uint32_t os_sched_dispatch(void);
+
+/**
+ * @brief Sleep until a job is posted or timeout_ms passed
+ *
+ * Returns at once if a job is already ready.
+ */
+void os_sched_idle(uint32_t timeout_ms);
+
+void os_sched_get_stats(os_sched_stats_t *stats);
+
+#endif // OS_SCHED_H
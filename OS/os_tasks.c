@@ -1,82 +1,79 @@
 #include "os_tasks.h"
-#include "os_config.h"
+#include "portable_log.h"
 
-// Uncomment when using FreeRTOS
-// #include "FreeRTOS.h"
-// #include "task.h"
+static const char *TAG = "OS_TASKS";
 
-/**
- * @brief Initialize all RTOS tasks
- * 
- * This function creates and starts all application tasks.
- * Currently set up for bare-metal operation.
- */
-void os_tasks_init(void)
+static void periodic_task(void *arg)
 {
-    // Bare-metal mode - no tasks to create
-    // Tasks are called sequentially from main loop
-    
-    // When using FreeRTOS, uncomment below:
-    /*
-    xTaskCreate(task_sensor_read,
-                "SensorTask",
-                TASK_STACK_SIZE_MEDIUM,
-                NULL,
-                TASK_PRIORITY_NORMAL,
-                NULL);
-    
-    xTaskCreate(task_display_update,
-                "DisplayTask",
-                TASK_STACK_SIZE_MEDIUM,
-                NULL,
-                TASK_PRIORITY_NORMAL,
-                NULL);
-    
-    xTaskCreate(task_communication,
-                "CommTask",
-                TASK_STACK_SIZE_MEDIUM,
-                NULL,
-                TASK_PRIORITY_LOW,
-                NULL);
-    */
+    os_periodic_task_t *task = (os_periodic_task_t *)arg;
+    uint32_t last_wake = os_get_tick_count();
+
+    if (task->monitored) {
+        deadline_monitor_register(task->deadline, task->period_ms * 1000U, task->budget_ms * 1000U);
+    }
+
+    while (1) {
+        if (task->monitored) {
+            // Released at last_wake, on the tick grid
+            deadline_monitor_begin(task->deadline, DEADLINE_RELEASE_MS_AGO(os_get_tick_count() - last_wake));
+            task->run();
+            deadline_monitor_end(task->deadline);
+        } else {
+            task->run();
+        }
+
+        if (!os_delay_until(&last_wake, task->period_ms)) {
+            // Overran: count it and restart the grid instead of running back to back
+            task->missed_deadlines++;
+            last_wake = os_get_tick_count();
+        }
+    }
 }
 
-// Example FreeRTOS task implementations (uncomment when using FreeRTOS)
-/*
-void task_sensor_read(void* pvParameters)
+void os_periodic_task_monitor(os_periodic_task_t *task, deadline_id_t deadline, uint32_t budget_ms)
 {
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    const TickType_t xFrequency = pdMS_TO_TICKS(1000); // 1 second
-    
-    for (;;)
-    {
-        // Read sensors
-        // Publish events via event bus
-        
-        vTaskDelayUntil(&xLastWakeTime, xFrequency);
+    if (task == NULL || task->handle != NULL) {
+        return;
     }
+
+    task->deadline = deadline;
+    task->budget_ms = budget_ms;
+    task->monitored = true;
 }
 
-void task_display_update(void* pvParameters)
+bool os_periodic_task_start(os_periodic_task_t *task)
 {
-    TickType_t xLastWakeTime = xTaskGetTickCount();
-    const TickType_t xFrequency = pdMS_TO_TICKS(100); // 100 ms
-    
-    for (;;)
-    {
-        // Update display
-        
-        vTaskDelayUntil(&xLastWakeTime, xFrequency);
+    if (task == NULL || task->run == NULL || task->period_ms == 0) {
+        return false;
+    }
+
+    if (task->handle != NULL) {
+        return true;
     }
+
+    if (os_task_create_static(periodic_task, task->name, task->stack_size, task,
+                              task->priority, task->stack, task->storage,
+                              &task->handle) != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create %s task", task->name);
+        task->handle = NULL;
+        return false;
+    }
+
+    LOG_I(TAG, "%s task: every %lu ms, priority %d", task->name,
+          (unsigned long)task->period_ms, task->priority);
+    return true;
 }
 
-void task_communication(void* pvParameters)
+uint32_t os_periodic_task_stack_high_water(const os_periodic_task_t *task)
 {
-    for (;;)
-    {
-        // Handle communication
-        
-        vTaskDelay(pdMS_TO_TICKS(10));
+    if (task == NULL || task->handle == NULL) {
+        return 0;
     }
+
+    return os_task_get_stack_high_water(task->handle);
+}
+
+uint32_t os_periodic_task_missed_deadlines(const os_periodic_task_t *task)
+{
+    return (task != NULL) ? task->missed_deadlines : 0;
 }
-*/
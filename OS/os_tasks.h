@@ -3,31 +3,83 @@
 
 /**
  * @file os_tasks.h
- * @brief RTOS Task Definitions (FreeRTOS)
- * 
- * This module defines all RTOS tasks for the application.
- * Currently set up for bare-metal (no RTOS), but can be extended
- * to use FreeRTOS or other RTOS.
+ * @brief Periodic service tasks
+ *
+ * Runs a service's poll function in its own task on a fixed period, so a
+ * slow service (a blocking sensor read, a display redraw) only delays
+ * itself and the tasks below it. Priorities are meant to be rate-monotonic:
+ * the shorter the period, the higher the priority.
+ *
+ * Stacks are static. Start with an estimate and trim it with
+ * os_periodic_task_stack_high_water() after a soak run.
+ *
+ * os_periodic_task_monitor() hands a task's passes to the deadline monitor
+ * (lateness after each release, run time against a budget, miss events).
+ *
+ * Usage example:
+ * @code
+ * OS_PERIODIC_TASK_DEFINE(sensor, "sensor", 1024, sensor_poll, 10, OS_PRIORITY_NORMAL);
+ *
+ * os_periodic_task_start(&sensor_periodic_task);
+ * @endcode
  */
 
+#include <stdbool.h>
 #include <stdint.h>
+#include "os_wrapper.h"
+#include "deadline_monitor.h"
 
-// Task Priorities (if using FreeRTOS)
-#define TASK_PRIORITY_HIGH      3
-#define TASK_PRIORITY_NORMAL    2
-#define TASK_PRIORITY_LOW       1
+/**
+ * @brief One periodic task; define with OS_PERIODIC_TASK_DEFINE()
+ */
+typedef struct {
+    const char *name;
+    void (*run)(void);              /**< One pass of the service */
+    uint32_t period_ms;
+    uint8_t priority;               /**< OS_PRIORITY_* */
+    uint32_t *stack;
+    uint32_t stack_size;            /**< Bytes */
+    os_task_storage_t *storage;
+    os_task_handle_t handle;        /**< NULL until started */
+    volatile uint32_t missed_deadlines;
+    bool monitored;                 /**< Set by os_periodic_task_monitor() */
+    deadline_id_t deadline;
+    uint32_t budget_ms;
+} os_periodic_task_t;
+
+#define OS_PERIODIC_TASK_DEFINE(var, task_name, stack_bytes, run_func, period, prio) \
+    OS_TASK_DEFINE(var, stack_bytes); \
+    static os_periodic_task_t var##_periodic_task = { \
+        .name = (task_name), \
+        .run = (run_func), \
+        .period_ms = (period), \
+        .priority = (prio), \
+        .stack = var##_task_stack, \
+        .stack_size = sizeof(var##_task_stack), \
+        .storage = &var##_task_storage, \
+    }
+
+/**
+ * @brief Report the task's passes to the deadline monitor; call before starting it
+ * @param budget_ms Run time of one pass above which it counts as overrun
+ */
+void os_periodic_task_monitor(os_periodic_task_t *task, deadline_id_t deadline, uint32_t budget_ms);
 
-// Task Stack Sizes (in words, for FreeRTOS)
-#define TASK_STACK_SIZE_SMALL   128
-#define TASK_STACK_SIZE_MEDIUM  256
-#define TASK_STACK_SIZE_LARGE   512
+/**
+ * @brief Create the task; the first pass runs right away
+ * @return true if the task was created (or already runs)
+ */
+bool os_periodic_task_start(os_periodic_task_t *task);
 
-// Task Functions (implement these in os_tasks.c)
-void os_tasks_init(void);
+/**
+ * @brief Smallest amount of stack the task has had left so far, in bytes
+ * @return 0 if the task was not started
+ */
+uint32_t os_periodic_task_stack_high_water(const os_periodic_task_t *task);
 
-// Example task functions (uncomment when using FreeRTOS)
-// void task_sensor_read(void* pvParameters);
-// void task_display_update(void* pvParameters);
-// void task_communication(void* pvParameters);
+/**
+ * @brief Passes that overran the period
+ */
+uint32_t os_periodic_task_missed_deadlines(const os_periodic_task_t *task);
 
 #endif // OS_TASKS_H
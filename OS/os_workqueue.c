@@ -0,0 +1,209 @@
+#include "os_workqueue.h"
+#include "os_wrapper.h"
+#include "hal_delay.h"
+#include "hal_mem.h"
+#include "portable_log.h"
+#include <stddef.h>
+
+static const char *TAG = "WORKQ";
+
+#define WORKQUEUE_MASK          (OS_WORKQUEUE_SIZE - 1U)
+#define WORKQUEUE_STACK         2048
+#define WORKQUEUE_PRIORITY      OS_PRIORITY_ISR_DEFERRED
+
+_Static_assert((OS_WORKQUEUE_SIZE & WORKQUEUE_MASK) == 0, "OS_WORKQUEUE_SIZE must be a power of 2");
+
+typedef struct {
+    volatile uint32_t sequence;     // Lap of the position it is free for, + 1 once filled
+    os_work_fn_t fn;
+    void *ctx;
+} work_slot_t;
+
+static work_slot_t ring[OS_WORKQUEUE_SIZE];
+static uint32_t ring_tail = 0;          // Next position to claim (producers, CAS)
+static uint32_t ring_head = 0;          // Next position to run (worker only)
+static os_workqueue_stats_t stats;
+static os_task_handle_t worker_handle = NULL;
+
+OS_TASK_DEFINE(worker, WORKQUEUE_STACK);
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+// Sequences count in laps (position & ~mask), so the zeroed ring is ready
+// without an init call and ISRs may submit before the worker starts
+static inline uint32_t lap(uint32_t pos)
+{
+    return pos & ~WORKQUEUE_MASK;
+}
+
+static void wake_worker(void)
+{
+    if (worker_handle == NULL) {
+        return;     // Runs once the worker starts
+    }
+    if (os_in_isr()) {
+        bool higher_priority_task_woken = false;
+        os_task_notify_from_isr(worker_handle, &higher_priority_task_woken);
+        os_yield_from_isr(higher_priority_task_woken);
+    } else {
+        os_task_notify(worker_handle);
+    }
+}
+
+/**
+ * @brief Run queued items until the ring is empty
+ *
+ * A slot whose producer is still filling it ends the pass; its producer
+ * notifies the worker once the slot is filled.
+ */
+static void drain(void)
+{
+    for (;;) {
+        work_slot_t *slot = &ring[ring_head & WORKQUEUE_MASK];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != lap(ring_head) + 1U) {
+            break;
+        }
+
+        os_work_fn_t fn = slot->fn;
+        void *ctx = slot->ctx;
+
+        // Hand the slot back before running, so the item may resubmit itself
+        __atomic_store_n(&slot->sequence, lap(ring_head) + OS_WORKQUEUE_SIZE, __ATOMIC_RELEASE);
+        ring_head++;
+
+        uint32_t start = hal_get_cycle_count();
+        fn(ctx);
+        uint32_t cycles = hal_get_cycle_count() - start;
+
+        stats.runs++;
+        if (cycles > stats.max_run_cycles) {
+            stats.max_run_cycles = cycles;
+        }
+    }
+}
+
+static void worker_task(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        drain();
+        os_task_notify_wait(OS_WAIT_FOREVER);
+    }
+}
+
+static void run_work(void *ctx)
+{
+    os_work_t *work = (os_work_t *)ctx;
+
+    __atomic_store_n(&work->pending, 0, __ATOMIC_RELEASE);
+    work->fn(work->ctx);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool os_workqueue_start(void)
+{
+    if (worker_handle != NULL) {
+        return true;
+    }
+
+    if (OS_TASK_CREATE_STATIC(worker, worker_task, "workq", NULL, WORKQUEUE_PRIORITY,
+                              &worker_handle) != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create worker task");
+        worker_handle = NULL;
+        return false;
+    }
+    return true;
+}
+
+HAL_ITCM_FUNC bool os_workqueue_submit(os_work_fn_t fn, void *ctx)
+{
+    if (fn == NULL) {
+        return false;
+    }
+
+    uint32_t pos = __atomic_load_n(&ring_tail, __ATOMIC_RELAXED);
+    work_slot_t *slot;
+
+    for (;;) {
+        slot = &ring[pos & WORKQUEUE_MASK];
+        int32_t diff = (int32_t)(__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - lap(pos));
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&ring_tail, &pos, pos + 1U, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+            // CAS failed: pos now holds the current tail, retry
+        } else if (diff < 0) {
+            // The worker has not run this slot yet: ring full
+            __atomic_fetch_add(&stats.dropped, 1, __ATOMIC_RELAXED);
+            return false;
+        } else {
+            // Another producer claimed it first
+            pos = __atomic_load_n(&ring_tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->fn = fn;
+    slot->ctx = ctx;
+    __atomic_store_n(&slot->sequence, lap(pos) + 1U, __ATOMIC_RELEASE);
+
+    __atomic_fetch_add(&stats.submitted, 1, __ATOMIC_RELAXED);
+    uint32_t depth = pos + 1U - __atomic_load_n(&ring_head, __ATOMIC_RELAXED);
+    uint32_t max_depth = __atomic_load_n(&stats.max_depth, __ATOMIC_RELAXED);
+    while (depth > max_depth &&
+           !__atomic_compare_exchange_n(&stats.max_depth, &max_depth, depth, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+
+    wake_worker();
+    return true;
+}
+
+void os_work_init(os_work_t *work, os_work_fn_t fn, void *ctx)
+{
+    if (work == NULL) {
+        return;
+    }
+    work->fn = fn;
+    work->ctx = ctx;
+    work->pending = 0;
+}
+
+HAL_ITCM_FUNC bool os_work_submit(os_work_t *work)
+{
+    if (work == NULL || work->fn == NULL) {
+        return false;
+    }
+
+    if (__atomic_exchange_n(&work->pending, 1, __ATOMIC_ACQ_REL) != 0) {
+        __atomic_fetch_add(&stats.coalesced, 1, __ATOMIC_RELAXED);
+        return true;
+    }
+
+    if (!os_workqueue_submit(run_work, work)) {
+        // Not queued: the next submit tries again
+        __atomic_store_n(&work->pending, 0, __ATOMIC_RELEASE);
+        return false;
+    }
+    return true;
+}
+
+bool os_work_is_pending(const os_work_t *work)
+{
+    return work != NULL && __atomic_load_n(&work->pending, __ATOMIC_ACQUIRE) != 0;
+}
+
+void os_workqueue_get_stats(os_workqueue_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+}
@@ -0,0 +1,109 @@
+#ifndef OS_WORKQUEUE_H
+#define OS_WORKQUEUE_H
+
+/**
+ * @file os_workqueue.h
+ * @brief Shared deferred-work queue for ISR bottom halves
+ *
+ * Interrupt handlers hand the part of their work that needs a task
+ * (blocking bus transfers, callbacks, queue drains) to one worker task,
+ * at the event bus dispatch priority, instead of setting a flag that a
+ * service loop polls or waking a task of their own. A work item is a function and its context;
+ * items run one at a time, in submission order, to completion.
+ *
+ * Submitting never blocks and never masks interrupts: producers claim a
+ * slot of a fixed ring by CAS (as event_bus_publish_from_isr() does), so
+ * tasks and nested ISRs of any priority may submit concurrently. A full
+ * ring drops the item and counts it.
+ *
+ * An os_work_t wraps an item that is queued at most once: submitting it
+ * again before it starts is a no-op, so an interrupt that fires in bursts
+ * costs one run per burst, not one slot per interrupt. The function runs
+ * after the pending mark is cleared, so a submit during the run queues
+ * another.
+ *
+ * Work items share the worker's stack and delay each other: keep them
+ * short, and never wait in one for another work item.
+ *
+ * Usage example:
+ * @code
+ * static void alert_work(void *ctx)       // Task context
+ * {
+ *     sensor_read_and_clear(ctx);
+ * }
+ * static os_work_t alert = OS_WORK_INIT(alert_work, &sensor);
+ *
+ * void alert_isr(void)
+ * {
+ *     os_work_submit(&alert);
+ * }
+ * @endcode
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define OS_WORKQUEUE_SIZE       32      // Ring slots, power of 2
+
+typedef void (*os_work_fn_t)(void *ctx);
+
+/**
+ * @brief A work item that is queued at most once
+ *
+ * All fields are private - define with OS_WORK_INIT() or os_work_init().
+ */
+typedef struct {
+    os_work_fn_t fn;
+    void *ctx;
+    volatile uint8_t pending;       // Queued and not started yet
+} os_work_t;
+
+#define OS_WORK_INIT(fn, ctx)   { (fn), (ctx), 0 }
+
+typedef struct {
+    uint32_t submitted;             // Items queued
+    uint32_t coalesced;             // os_work_submit() calls on a pending item
+    uint32_t dropped;               // Items lost to a full ring
+    uint32_t runs;                  // Items run
+    uint32_t max_depth;             // Most items queued at once
+    uint32_t max_run_cycles;        // Longest item; bounds the latency the others see
+} os_workqueue_stats_t;
+
+/**
+ * @brief Start the worker task
+ * @return true on success (or if already started)
+ */
+bool os_workqueue_start(void);
+
+/**
+ * @brief Queue fn(ctx) for the worker (task or ISR context)
+ * @note NON-BLOCKING
+ * @return false if the ring is full
+ *
+ * Items submitted before os_workqueue_start() run once the worker is up.
+ */
+bool os_workqueue_submit(os_work_fn_t fn, void *ctx);
+
+/**
+ * @brief Set up a work item at run time
+ */
+void os_work_init(os_work_t *work, os_work_fn_t fn, void *ctx);
+
+/**
+ * @brief Queue a work item unless it is already pending (task or ISR context)
+ * @note NON-BLOCKING
+ * @return true if the item is pending now, false if it could not be queued
+ */
+bool os_work_submit(os_work_t *work);
+
+/**
+ * @brief Whether a work item is queued and has not started
+ */
+bool os_work_is_pending(const os_work_t *work);
+
+/**
+ * @brief Get queue statistics
+ */
+void os_workqueue_get_stats(os_workqueue_stats_t *stats);
+
+#endif // OS_WORKQUEUE_H
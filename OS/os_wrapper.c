@@ -8,16 +8,57 @@
     #include <freertos/task.h>
     #include <freertos/queue.h>
     #include <freertos/semphr.h>
+    #include <freertos/stream_buffer.h>
+    #include <freertos/message_buffer.h>
+    #include <freertos/timers.h>
 #else
     // STM32 or other platforms
     #include "FreeRTOS.h"
     #include "task.h"
     #include "queue.h"
     #include "semphr.h"
+    #include "stream_buffer.h"
+    #include "message_buffer.h"
+    #include "timers.h"
 #endif
 
 static const char *TAG = "OS_WRAPPER";
 
+#if !configSUPPORT_STATIC_ALLOCATION
+    #error "os_wrapper static creators need configSUPPORT_STATIC_ALLOCATION 1"
+#endif
+
+_Static_assert(sizeof(os_task_storage_t) >= sizeof(StaticTask_t),
+               "os_task_storage_t too small, raise OS_TASK_STORAGE_WORDS");
+_Static_assert(sizeof(os_queue_storage_t) >= sizeof(StaticQueue_t),
+               "os_queue_storage_t too small, raise OS_QUEUE_STORAGE_WORDS");
+_Static_assert(sizeof(os_queue_storage_t) >= sizeof(StaticSemaphore_t),
+               "os_queue_storage_t too small, raise OS_QUEUE_STORAGE_WORDS");
+_Static_assert(sizeof(os_stream_buffer_storage_t) >= sizeof(StaticStreamBuffer_t),
+               "os_stream_buffer_storage_t too small, raise OS_STREAM_STORAGE_WORDS");
+
+// Entry and stack size of the tasks created here, for stack reports; the
+// kernel keeps neither
+#define TASK_INFO_SLOTS 24
+
+typedef struct {
+    TaskHandle_t handle;
+    os_task_info_t info;
+} task_info_slot_t;
+
+static task_info_slot_t task_info[TASK_INFO_SLOTS];
+
+static TickType_t timeout_to_ticks(uint32_t timeout_ms)
+{
+    if (timeout_ms == OS_WAIT_FOREVER) {
+        return portMAX_DELAY;
+    }
+    if (timeout_ms == OS_NO_WAIT) {
+        return 0;
+    }
+    return pdMS_TO_TICKS(timeout_ms);
+}
+
 // Platform detection for core affinity
 #if defined(ESP_PLATFORM)
     // ESP32 platform detection
@@ -54,6 +95,11 @@ os_result_t os_init(void)
     return OS_SUCCESS;
 }
 
+bool os_kernel_is_running(void)
+{
+    return xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED;
+}
+
 // =============================================================================
 // QUEUE OPERATIONS
 // =============================================================================
@@ -75,6 +121,25 @@ os_queue_handle_t os_queue_create(uint32_t queue_length, uint32_t item_size)
     return (os_queue_handle_t)queue;
 }
 
+os_queue_handle_t os_queue_create_static(uint32_t queue_length, uint32_t item_size,
+                                         uint8_t* buffer, os_queue_storage_t* storage)
+{
+    if (queue_length == 0 || item_size == 0 || buffer == NULL || storage == NULL) {
+        LOG_E(TAG, "Invalid queue parameters");
+        return NULL;
+    }
+
+    QueueHandle_t queue = xQueueCreateStatic(queue_length, item_size, buffer,
+                                             (StaticQueue_t*)storage);
+    if (queue == NULL) {
+        LOG_E(TAG, "Failed to create static queue");
+        return NULL;
+    }
+
+    LOG_D(TAG, "Created static queue: length=%lu, item_size=%lu", queue_length, item_size);
+    return (os_queue_handle_t)queue;
+}
+
 void os_queue_delete(os_queue_handle_t queue)
 {
     if (queue == NULL) {
@@ -191,10 +256,113 @@ os_result_t os_queue_reset(os_queue_handle_t queue)
     return OS_SUCCESS;
 }
 
+// =============================================================================
+// QUEUE SETS
+// =============================================================================
+
+os_queue_set_handle_t os_queue_set_create_static(uint32_t length, uint8_t* buffer,
+                                                 os_queue_storage_t* storage)
+{
+    if (length == 0 || buffer == NULL || storage == NULL) {
+        LOG_E(TAG, "Invalid queue set parameters");
+        return NULL;
+    }
+
+    // What xQueueCreateSet() does, on static storage
+    QueueHandle_t set = xQueueGenericCreateStatic(length, sizeof(QueueSetMemberHandle_t), buffer,
+                                                  (StaticQueue_t*)storage, queueQUEUE_TYPE_SET);
+    if (set == NULL) {
+        LOG_E(TAG, "Failed to create static queue set");
+        return NULL;
+    }
+
+    LOG_D(TAG, "Created static queue set: length=%lu", length);
+    return (os_queue_set_handle_t)set;
+}
+
+void os_queue_set_delete(os_queue_set_handle_t set)
+{
+    if (set != NULL) {
+        vQueueDelete((QueueHandle_t)set);
+    }
+}
+
+os_result_t os_queue_set_add(os_queue_set_handle_t set, void* member)
+{
+    if (set == NULL || member == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    return (xQueueAddToSet((QueueSetMemberHandle_t)member, (QueueSetHandle_t)set) == pdPASS)
+           ? OS_SUCCESS : OS_ERROR;
+}
+
+os_result_t os_queue_set_remove(os_queue_set_handle_t set, void* member)
+{
+    if (set == NULL || member == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    return (xQueueRemoveFromSet((QueueSetMemberHandle_t)member, (QueueSetHandle_t)set) == pdPASS)
+           ? OS_SUCCESS : OS_ERROR;
+}
+
+void* os_queue_set_select(os_queue_set_handle_t set, uint32_t timeout_ms)
+{
+    if (set == NULL) {
+        return NULL;
+    }
+
+    TickType_t timeout_ticks;
+    if (timeout_ms == OS_WAIT_FOREVER) {
+        timeout_ticks = portMAX_DELAY;
+    } else if (timeout_ms == OS_NO_WAIT) {
+        timeout_ticks = 0;
+    } else {
+        timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+    }
+
+    return (void*)xQueueSelectFromSet((QueueSetHandle_t)set, timeout_ticks);
+}
+
 // =============================================================================
 // TASK OPERATIONS
 // =============================================================================
 
+static void task_info_set(TaskHandle_t handle, os_task_func_t entry, uint32_t stack_size)
+{
+    task_info_slot_t *free_slot = NULL;
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < TASK_INFO_SLOTS; i++) {
+        if (task_info[i].handle == handle) {
+            free_slot = &task_info[i];
+            break;
+        }
+        if (task_info[i].handle == NULL && free_slot == NULL) {
+            free_slot = &task_info[i];
+        }
+    }
+    if (free_slot != NULL) {
+        free_slot->handle = handle;
+        free_slot->info.entry = entry;
+        free_slot->info.stack_size = stack_size;
+    }
+    taskEXIT_CRITICAL();
+}
+
+static void task_info_clear(TaskHandle_t handle)
+{
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < TASK_INFO_SLOTS; i++) {
+        if (task_info[i].handle == handle) {
+            task_info[i].handle = NULL;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
 os_result_t os_task_create(os_task_func_t task_func, const char* name, 
                           uint32_t stack_size, void* params, 
                           uint8_t priority, os_task_handle_t* handle)
@@ -218,6 +386,7 @@ os_result_t os_task_create(os_task_func_t task_func, const char* name,
         return (result == errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY) ? OS_NO_MEMORY : OS_ERROR;
     }
 
+    task_info_set(task_handle, task_func, stack_size);
     if (handle != NULL) {
         *handle = (os_task_handle_t)task_handle;
     }
@@ -267,6 +436,7 @@ os_result_t os_task_create_pinned(os_task_func_t task_func, const char* name,
         return (result == errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY) ? OS_NO_MEMORY : OS_ERROR;
     }
 
+    task_info_set(task_handle, task_func, stack_size);
     if (handle != NULL) {
         *handle = (os_task_handle_t)task_handle;
     }
@@ -281,8 +451,44 @@ os_result_t os_task_create_pinned(os_task_func_t task_func, const char* name,
     return OS_SUCCESS;
 }
 
+os_result_t os_task_create_static(os_task_func_t task_func, const char* name,
+                                  uint32_t stack_size, void* params,
+                                  uint8_t priority, uint32_t* stack,
+                                  os_task_storage_t* storage, os_task_handle_t* handle)
+{
+    if (task_func == NULL || stack == NULL || storage == NULL ||
+        stack_size < configMINIMAL_STACK_SIZE * sizeof(StackType_t)) {
+        return OS_INVALID_PARAM;
+    }
+
+    TaskHandle_t task_handle = xTaskCreateStatic(
+        (TaskFunction_t)task_func,
+        name ? name : "unnamed_task",
+        stack_size / sizeof(StackType_t),  // FreeRTOS expects stack size in words
+        params,
+        priority,
+        (StackType_t*)stack,
+        (StaticTask_t*)storage
+    );
+
+    if (task_handle == NULL) {
+        LOG_E(TAG, "Failed to create static task: %s", name ? name : "unnamed");
+        return OS_ERROR;
+    }
+
+    task_info_set(task_handle, task_func, stack_size);
+    if (handle != NULL) {
+        *handle = (os_task_handle_t)task_handle;
+    }
+
+    LOG_D(TAG, "Created static task: %s, priority=%d, stack=%lu",
+          name ? name : "unnamed", priority, stack_size);
+    return OS_SUCCESS;
+}
+
 void os_task_delete(os_task_handle_t handle)
 {
+    task_info_clear((handle != NULL) ? (TaskHandle_t)handle : xTaskGetCurrentTaskHandle());
     vTaskDelete((TaskHandle_t)handle);
     LOG_D(TAG, "Task deleted");
 }
@@ -292,6 +498,103 @@ os_task_handle_t os_task_get_current(void)
     return (os_task_handle_t)xTaskGetCurrentTaskHandle();
 }
 
+void os_task_set_priority(os_task_handle_t handle, uint8_t priority)
+{
+    vTaskPrioritySet((TaskHandle_t)handle, priority);
+}
+
+uint32_t os_task_get_stack_high_water(os_task_handle_t handle)
+{
+    return (uint32_t)uxTaskGetStackHighWaterMark((TaskHandle_t)handle) * sizeof(StackType_t);
+}
+
+uint32_t os_task_get_number(os_task_handle_t handle)
+{
+    TaskHandle_t task = (handle != NULL) ? (TaskHandle_t)handle : xTaskGetCurrentTaskHandle();
+    if (task == NULL) {
+        return 0U;
+    }
+    // uxTaskGetTaskNumber() is the trace number, 0 unless set; the TCB number
+    // comes with vTaskGetInfo(), which only reads when given a state and no
+    // stack check
+    TaskStatus_t status;
+    vTaskGetInfo(task, &status, pdFALSE, eRunning);
+    return (uint32_t)status.xTaskNumber;
+}
+
+void os_task_note_info(os_task_handle_t handle, os_task_func_t entry, uint32_t stack_size)
+{
+    TaskHandle_t task = (handle != NULL) ? (TaskHandle_t)handle : xTaskGetCurrentTaskHandle();
+    if (task != NULL) {
+        task_info_set(task, entry, stack_size);
+    }
+}
+
+bool os_task_get_info(os_task_handle_t handle, os_task_info_t *info)
+{
+    TaskHandle_t task = (handle != NULL) ? (TaskHandle_t)handle : xTaskGetCurrentTaskHandle();
+    bool found = false;
+
+    if (task == NULL || info == NULL) {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < TASK_INFO_SLOTS; i++) {
+        if (task_info[i].handle == task) {
+            *info = task_info[i].info;
+            found = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+    return found;
+}
+
+// =============================================================================
+// TASK NOTIFICATIONS
+// =============================================================================
+
+os_result_t os_task_notify(os_task_handle_t task)
+{
+    if (task == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    xTaskNotifyGive((TaskHandle_t)task);
+    return OS_SUCCESS;
+}
+
+os_result_t os_task_notify_from_isr(os_task_handle_t task, bool* higher_priority_task_woken)
+{
+    if (task == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR((TaskHandle_t)task, &xHigherPriorityTaskWoken);
+
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+    }
+
+    return OS_SUCCESS;
+}
+
+uint32_t os_task_notify_wait(uint32_t timeout_ms)
+{
+    TickType_t timeout_ticks;
+    if (timeout_ms == OS_WAIT_FOREVER) {
+        timeout_ticks = portMAX_DELAY;
+    } else if (timeout_ms == OS_NO_WAIT) {
+        timeout_ticks = 0;
+    } else {
+        timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+    }
+
+    return (uint32_t)ulTaskNotifyTake(pdTRUE, timeout_ticks);
+}
+
 // =============================================================================
 // SYNCHRONIZATION - MUTEX
 // =============================================================================
@@ -308,6 +611,21 @@ os_mutex_handle_t os_mutex_create(void)
     return (os_mutex_handle_t)mutex;
 }
 
+os_mutex_handle_t os_mutex_create_static(os_mutex_storage_t* storage)
+{
+    if (storage == NULL) {
+        return NULL;
+    }
+
+    SemaphoreHandle_t mutex = xSemaphoreCreateMutexStatic((StaticSemaphore_t*)storage);
+    if (mutex == NULL) {
+        LOG_E(TAG, "Failed to create static mutex");
+        return NULL;
+    }
+
+    return (os_mutex_handle_t)mutex;
+}
+
 void os_mutex_delete(os_mutex_handle_t mutex)
 {
     if (mutex == NULL) {
@@ -381,6 +699,39 @@ os_semaphore_handle_t os_semaphore_create_counting(uint32_t max_count, uint32_t
     return (os_semaphore_handle_t)sem;
 }
 
+os_semaphore_handle_t os_semaphore_create_binary_static(os_semaphore_storage_t* storage)
+{
+    if (storage == NULL) {
+        return NULL;
+    }
+
+    SemaphoreHandle_t sem = xSemaphoreCreateBinaryStatic((StaticSemaphore_t*)storage);
+    if (sem == NULL) {
+        LOG_E(TAG, "Failed to create static binary semaphore");
+        return NULL;
+    }
+
+    return (os_semaphore_handle_t)sem;
+}
+
+os_semaphore_handle_t os_semaphore_create_counting_static(uint32_t max_count, uint32_t initial_count,
+                                                          os_semaphore_storage_t* storage)
+{
+    if (max_count == 0 || initial_count > max_count || storage == NULL) {
+        LOG_E(TAG, "Invalid semaphore parameters");
+        return NULL;
+    }
+
+    SemaphoreHandle_t sem = xSemaphoreCreateCountingStatic(max_count, initial_count,
+                                                           (StaticSemaphore_t*)storage);
+    if (sem == NULL) {
+        LOG_E(TAG, "Failed to create static counting semaphore");
+        return NULL;
+    }
+
+    return (os_semaphore_handle_t)sem;
+}
+
 void os_semaphore_delete(os_semaphore_handle_t semaphore)
 {
     if (semaphore == NULL) {
@@ -452,6 +803,537 @@ os_result_t os_semaphore_take_from_isr(os_semaphore_handle_t semaphore, bool* hi
     return (result == pdPASS) ? OS_SUCCESS : OS_TIMEOUT;
 }
 
+// =============================================================================
+// STREAM AND MESSAGE BUFFERS
+// =============================================================================
+
+os_stream_buffer_handle_t os_stream_buffer_create(size_t size_bytes, size_t trigger_level)
+{
+    if (size_bytes == 0 || trigger_level > size_bytes) {
+        LOG_E(TAG, "Invalid stream buffer parameters");
+        return NULL;
+    }
+
+    StreamBufferHandle_t stream = xStreamBufferCreate(size_bytes, trigger_level);
+    if (stream == NULL) {
+        LOG_E(TAG, "Failed to create stream buffer");
+        return NULL;
+    }
+
+    return (os_stream_buffer_handle_t)stream;
+}
+
+os_stream_buffer_handle_t os_stream_buffer_create_static(size_t size_bytes, size_t trigger_level,
+                                                         uint8_t* buffer,
+                                                         os_stream_buffer_storage_t* storage)
+{
+    if (size_bytes < 2 || trigger_level >= size_bytes || buffer == NULL || storage == NULL) {
+        LOG_E(TAG, "Invalid stream buffer parameters");
+        return NULL;
+    }
+
+    StreamBufferHandle_t stream = xStreamBufferCreateStatic(size_bytes, trigger_level, buffer,
+                                                            (StaticStreamBuffer_t*)storage);
+    if (stream == NULL) {
+        LOG_E(TAG, "Failed to create static stream buffer");
+        return NULL;
+    }
+
+    return (os_stream_buffer_handle_t)stream;
+}
+
+void os_stream_buffer_delete(os_stream_buffer_handle_t stream)
+{
+    if (stream != NULL) {
+        vStreamBufferDelete((StreamBufferHandle_t)stream);
+    }
+}
+
+size_t os_stream_buffer_send(os_stream_buffer_handle_t stream, const void* data, size_t length,
+                             uint32_t timeout_ms)
+{
+    if (stream == NULL || data == NULL || length == 0) {
+        return 0;
+    }
+
+    return xStreamBufferSend((StreamBufferHandle_t)stream, data, length, timeout_to_ticks(timeout_ms));
+}
+
+size_t os_stream_buffer_send_from_isr(os_stream_buffer_handle_t stream, const void* data, size_t length,
+                                      bool* higher_priority_task_woken)
+{
+    if (stream == NULL || data == NULL || length == 0) {
+        return 0;
+    }
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    size_t sent = xStreamBufferSendFromISR((StreamBufferHandle_t)stream, data, length,
+                                           &xHigherPriorityTaskWoken);
+
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+    }
+
+    return sent;
+}
+
+size_t os_stream_buffer_receive(os_stream_buffer_handle_t stream, void* data, size_t length,
+                                uint32_t timeout_ms)
+{
+    if (stream == NULL || data == NULL || length == 0) {
+        return 0;
+    }
+
+    return xStreamBufferReceive((StreamBufferHandle_t)stream, data, length, timeout_to_ticks(timeout_ms));
+}
+
+size_t os_stream_buffer_receive_from_isr(os_stream_buffer_handle_t stream, void* data, size_t length,
+                                         bool* higher_priority_task_woken)
+{
+    if (stream == NULL || data == NULL || length == 0) {
+        return 0;
+    }
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    size_t received = xStreamBufferReceiveFromISR((StreamBufferHandle_t)stream, data, length,
+                                                  &xHigherPriorityTaskWoken);
+
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+    }
+
+    return received;
+}
+
+size_t os_stream_buffer_bytes_available(os_stream_buffer_handle_t stream)
+{
+    if (stream == NULL) {
+        return 0;
+    }
+
+    return xStreamBufferBytesAvailable((StreamBufferHandle_t)stream);
+}
+
+os_result_t os_stream_buffer_set_trigger_level(os_stream_buffer_handle_t stream, size_t trigger_level)
+{
+    if (stream == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    // FreeRTOS treats 0 as 1
+    return (xStreamBufferSetTriggerLevel((StreamBufferHandle_t)stream, trigger_level) == pdTRUE)
+               ? OS_SUCCESS : OS_INVALID_PARAM;
+}
+
+bool os_stream_buffer_wake_reader(os_stream_buffer_handle_t stream)
+{
+    if (stream == NULL) {
+        return false;
+    }
+
+    // Completes the reader's receive regardless of the trigger level. The
+    // FromISR variant only masks interrupts, so it is fine from a task.
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    BaseType_t woken = xStreamBufferSendCompletedFromISR((StreamBufferHandle_t)stream,
+                                                         &xHigherPriorityTaskWoken);
+    if (xHigherPriorityTaskWoken == pdTRUE) {
+        taskYIELD();
+    }
+
+    return (woken == pdTRUE);
+}
+
+bool os_stream_buffer_wake_reader_from_isr(os_stream_buffer_handle_t stream,
+                                           bool* higher_priority_task_woken)
+{
+    if (stream == NULL) {
+        return false;
+    }
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    BaseType_t woken = xStreamBufferSendCompletedFromISR((StreamBufferHandle_t)stream,
+                                                         &xHigherPriorityTaskWoken);
+
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+    }
+
+    return (woken == pdTRUE);
+}
+
+os_result_t os_stream_buffer_reset(os_stream_buffer_handle_t stream)
+{
+    if (stream == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    return (xStreamBufferReset((StreamBufferHandle_t)stream) == pdPASS) ? OS_SUCCESS : OS_ERROR;
+}
+
+os_message_buffer_handle_t os_message_buffer_create(size_t size_bytes)
+{
+    if (size_bytes <= sizeof(size_t)) {
+        LOG_E(TAG, "Invalid message buffer size");
+        return NULL;
+    }
+
+    MessageBufferHandle_t buffer = xMessageBufferCreate(size_bytes);
+    if (buffer == NULL) {
+        LOG_E(TAG, "Failed to create message buffer");
+        return NULL;
+    }
+
+    return (os_message_buffer_handle_t)buffer;
+}
+
+os_message_buffer_handle_t os_message_buffer_create_static(size_t size_bytes, uint8_t* buffer,
+                                                           os_stream_buffer_storage_t* storage)
+{
+    if (size_bytes <= sizeof(size_t) + 1 || buffer == NULL || storage == NULL) {
+        LOG_E(TAG, "Invalid message buffer parameters");
+        return NULL;
+    }
+
+    MessageBufferHandle_t handle = xMessageBufferCreateStatic(size_bytes, buffer,
+                                                              (StaticMessageBuffer_t*)storage);
+    if (handle == NULL) {
+        LOG_E(TAG, "Failed to create static message buffer");
+        return NULL;
+    }
+
+    return (os_message_buffer_handle_t)handle;
+}
+
+void os_message_buffer_delete(os_message_buffer_handle_t buffer)
+{
+    if (buffer != NULL) {
+        vMessageBufferDelete((MessageBufferHandle_t)buffer);
+    }
+}
+
+os_result_t os_message_buffer_send(os_message_buffer_handle_t buffer, const void* message, size_t length,
+                                   uint32_t timeout_ms)
+{
+    if (buffer == NULL || message == NULL || length == 0) {
+        return OS_INVALID_PARAM;
+    }
+
+    // A message is written whole or not at all
+    size_t sent = xMessageBufferSend((MessageBufferHandle_t)buffer, message, length,
+                                     timeout_to_ticks(timeout_ms));
+    return (sent == length) ? OS_SUCCESS : OS_FULL;
+}
+
+os_result_t os_message_buffer_send_from_isr(os_message_buffer_handle_t buffer, const void* message,
+                                            size_t length, bool* higher_priority_task_woken)
+{
+    if (buffer == NULL || message == NULL || length == 0) {
+        return OS_INVALID_PARAM;
+    }
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    size_t sent = xMessageBufferSendFromISR((MessageBufferHandle_t)buffer, message, length,
+                                            &xHigherPriorityTaskWoken);
+
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+    }
+
+    return (sent == length) ? OS_SUCCESS : OS_FULL;
+}
+
+size_t os_message_buffer_receive(os_message_buffer_handle_t buffer, void* message, size_t max_length,
+                                 uint32_t timeout_ms)
+{
+    if (buffer == NULL || message == NULL || max_length == 0) {
+        return 0;
+    }
+
+    return xMessageBufferReceive((MessageBufferHandle_t)buffer, message, max_length,
+                                 timeout_to_ticks(timeout_ms));
+}
+
+size_t os_message_buffer_receive_from_isr(os_message_buffer_handle_t buffer, void* message,
+                                          size_t max_length, bool* higher_priority_task_woken)
+{
+    if (buffer == NULL || message == NULL || max_length == 0) {
+        return 0;
+    }
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    size_t received = xMessageBufferReceiveFromISR((MessageBufferHandle_t)buffer, message, max_length,
+                                                   &xHigherPriorityTaskWoken);
+
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+    }
+
+    return received;
+}
+
+// =============================================================================
+// SOFTWARE TIMERS
+// =============================================================================
+
+// The callback and its argument ride along in the caller's storage
+typedef struct timer_block {
+#if configUSE_TIMERS
+    StaticTimer_t timer;            // First: its address is the handle
+#else
+    struct timer_block* next;       // Active list
+    struct timer_block* next_due;   // Expired in the current tick
+    uint32_t period_ticks;
+    uint32_t remaining_ticks;
+    bool periodic;
+    bool active;
+#endif
+    os_timer_callback_t callback;
+    void* arg;
+} timer_block_t;
+
+_Static_assert(sizeof(os_timer_storage_t) >= sizeof(timer_block_t),
+               "os_timer_storage_t too small, raise OS_TIMER_STORAGE_WORDS");
+
+#if configUSE_TIMERS
+
+static TickType_t period_to_ticks(uint32_t period_ms)
+{
+    TickType_t ticks = pdMS_TO_TICKS(period_ms);
+    return (ticks > 0) ? ticks : 1;
+}
+
+static void timer_trampoline(TimerHandle_t handle)
+{
+    timer_block_t* block = (timer_block_t*)pvTimerGetTimerID(handle);
+    block->callback(block->arg);
+}
+
+static os_result_t timer_result(BaseType_t result)
+{
+    return (result == pdPASS) ? OS_SUCCESS : OS_FULL;
+}
+
+os_timer_handle_t os_timer_create_static(const char* name, uint32_t period_ms, bool periodic,
+                                         os_timer_callback_t callback, void* arg,
+                                         os_timer_storage_t* storage)
+{
+    if (storage == NULL || callback == NULL || period_ms == 0) {
+        return NULL;
+    }
+
+    timer_block_t* block = (timer_block_t*)storage;
+    block->callback = callback;
+    block->arg = arg;
+    return (os_timer_handle_t)xTimerCreateStatic(name, period_to_ticks(period_ms),
+                                                 periodic ? pdTRUE : pdFALSE, block,
+                                                 timer_trampoline, &block->timer);
+}
+
+void os_timer_delete(os_timer_handle_t timer)
+{
+    if (timer != NULL) {
+        xTimerDelete((TimerHandle_t)timer, 0);
+    }
+}
+
+os_result_t os_timer_start(os_timer_handle_t timer)
+{
+    if (timer == NULL) {
+        return OS_INVALID_PARAM;
+    }
+    // Reset starts a dormant timer and restarts a running one
+    return timer_result(xTimerReset((TimerHandle_t)timer, 0));
+}
+
+os_result_t os_timer_start_from_isr(os_timer_handle_t timer, bool* higher_priority_task_woken)
+{
+    if (timer == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    os_result_t result = timer_result(xTimerResetFromISR((TimerHandle_t)timer, &xHigherPriorityTaskWoken));
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+    }
+    return result;
+}
+
+os_result_t os_timer_stop(os_timer_handle_t timer)
+{
+    if (timer == NULL) {
+        return OS_INVALID_PARAM;
+    }
+    return timer_result(xTimerStop((TimerHandle_t)timer, 0));
+}
+
+os_result_t os_timer_stop_from_isr(os_timer_handle_t timer, bool* higher_priority_task_woken)
+{
+    if (timer == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    os_result_t result = timer_result(xTimerStopFromISR((TimerHandle_t)timer, &xHigherPriorityTaskWoken));
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+    }
+    return result;
+}
+
+os_result_t os_timer_set_period(os_timer_handle_t timer, uint32_t period_ms)
+{
+    if (timer == NULL || period_ms == 0) {
+        return OS_INVALID_PARAM;
+    }
+    return timer_result(xTimerChangePeriod((TimerHandle_t)timer, period_to_ticks(period_ms), 0));
+}
+
+bool os_timer_is_active(os_timer_handle_t timer)
+{
+    return timer != NULL && xTimerIsTimerActive((TimerHandle_t)timer) != pdFALSE;
+}
+
+void os_timer_tick(void)
+{
+    // The timer service task drives the timers
+}
+
+#else // !configUSE_TIMERS
+
+// os_timer_tick() runs once per millisecond, so periods stay in ms
+static timer_block_t* active_timers = NULL;
+
+static void timer_unlink(timer_block_t* block)
+{
+    for (timer_block_t** link = &active_timers; *link != NULL; link = &(*link)->next) {
+        if (*link == block) {
+            *link = block->next;
+            break;
+        }
+    }
+    block->active = false;
+}
+
+static void timer_arm(timer_block_t* block, uint32_t period_ticks)
+{
+    uint32_t mask = os_critical_enter();
+    if (!block->active) {
+        block->next = active_timers;
+        active_timers = block;
+        block->active = true;
+    }
+    block->period_ticks = period_ticks;
+    block->remaining_ticks = period_ticks;
+    os_critical_exit(mask);
+}
+
+os_timer_handle_t os_timer_create_static(const char* name, uint32_t period_ms, bool periodic,
+                                         os_timer_callback_t callback, void* arg,
+                                         os_timer_storage_t* storage)
+{
+    (void)name;
+    if (storage == NULL || callback == NULL || period_ms == 0) {
+        return NULL;
+    }
+
+    timer_block_t* block = (timer_block_t*)storage;
+    *block = (timer_block_t){
+        .period_ticks = period_ms,
+        .periodic = periodic,
+        .callback = callback,
+        .arg = arg,
+    };
+    return (os_timer_handle_t)block;
+}
+
+void os_timer_delete(os_timer_handle_t timer)
+{
+    os_timer_stop(timer);
+}
+
+os_result_t os_timer_start(os_timer_handle_t timer)
+{
+    if (timer == NULL) {
+        return OS_INVALID_PARAM;
+    }
+    timer_block_t* block = (timer_block_t*)timer;
+    timer_arm(block, block->period_ticks);
+    return OS_SUCCESS;
+}
+
+os_result_t os_timer_start_from_isr(os_timer_handle_t timer, bool* higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = false;
+    }
+    return os_timer_start(timer);
+}
+
+os_result_t os_timer_stop(os_timer_handle_t timer)
+{
+    if (timer == NULL) {
+        return OS_INVALID_PARAM;
+    }
+    uint32_t mask = os_critical_enter();
+    timer_unlink((timer_block_t*)timer);
+    os_critical_exit(mask);
+    return OS_SUCCESS;
+}
+
+os_result_t os_timer_stop_from_isr(os_timer_handle_t timer, bool* higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = false;
+    }
+    return os_timer_stop(timer);
+}
+
+os_result_t os_timer_set_period(os_timer_handle_t timer, uint32_t period_ms)
+{
+    if (timer == NULL || period_ms == 0) {
+        return OS_INVALID_PARAM;
+    }
+    timer_arm((timer_block_t*)timer, period_ms);
+    return OS_SUCCESS;
+}
+
+bool os_timer_is_active(os_timer_handle_t timer)
+{
+    return timer != NULL && ((timer_block_t*)timer)->active;
+}
+
+void os_timer_tick(void)
+{
+    timer_block_t* due = NULL;
+
+    // Count down under the mask, call back outside it: a callback may
+    // start or stop timers
+    uint32_t mask = os_critical_enter();
+    for (timer_block_t** link = &active_timers; *link != NULL;) {
+        timer_block_t* block = *link;
+        if (--block->remaining_ticks == 0) {
+            block->next_due = due;
+            due = block;
+            if (block->periodic) {
+                block->remaining_ticks = block->period_ticks;
+            } else {
+                *link = block->next;
+                block->active = false;
+                continue;
+            }
+        }
+        link = &block->next;
+    }
+    os_critical_exit(mask);
+
+    for (; due != NULL; due = due->next_due) {
+        due->callback(due->arg);
+    }
+}
+
+#endif // configUSE_TIMERS
+
 // =============================================================================
 // ISR UTILITIES
 // =============================================================================
@@ -461,6 +1343,21 @@ void os_yield_from_isr(bool higher_priority_task_woken)
     portYIELD_FROM_ISR(higher_priority_task_woken ? pdTRUE : pdFALSE);
 }
 
+bool os_in_isr(void)
+{
+    return xPortIsInsideInterrupt() == pdTRUE;
+}
+
+uint32_t os_critical_enter(void)
+{
+    return (uint32_t)portSET_INTERRUPT_MASK_FROM_ISR();
+}
+
+void os_critical_exit(uint32_t saved_mask)
+{
+    portCLEAR_INTERRUPT_MASK_FROM_ISR((UBaseType_t)saved_mask);
+}
+
 // =============================================================================
 // TIME OPERATIONS
 // =============================================================================
@@ -475,6 +1372,16 @@ uint32_t os_get_time_ms(void)
     return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
 }
 
+uint32_t os_get_idle_time_us(void)
+{
+#if (configGENERATE_RUN_TIME_STATS == 1) && (INCLUDE_xTaskGetIdleTaskHandle == 1)
+    // The counter runs on portGET_RUN_TIME_COUNTER_VALUE(), hal_timer_get_us()
+    return (uint32_t)xTaskGetIdleRunTimeCounter();
+#else
+    return 0;
+#endif
+}
+
 void os_delay_ms(uint32_t delay_ms)
 {
     if (delay_ms > 0) {
@@ -482,6 +1389,24 @@ void os_delay_ms(uint32_t delay_ms)
     }
 }
 
+bool os_delay_until(uint32_t *last_wake_tick, uint32_t period_ms)
+{
+    if (last_wake_tick == NULL) {
+        return false;
+    }
+
+    TickType_t last_wake = (TickType_t)*last_wake_tick;
+    TickType_t period = pdMS_TO_TICKS(period_ms);
+
+    // vTaskDelayUntil (V10.2) does not report a missed deadline, so check first
+    bool on_time = (TickType_t)(xTaskGetTickCount() - last_wake) < period;
+
+    vTaskDelayUntil(&last_wake, period);
+    *last_wake_tick = (uint32_t)last_wake;
+
+    return on_time;
+}
+
 uint32_t os_ms_to_ticks(uint32_t ms)
 {
     return (uint32_t)pdMS_TO_TICKS(ms);
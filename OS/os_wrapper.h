@@ -14,10 +14,52 @@ typedef void* os_queue_handle_t;
 typedef void* os_task_handle_t;
 typedef void* os_mutex_handle_t;
 typedef void* os_semaphore_handle_t;
+typedef void* os_stream_buffer_handle_t;
+typedef void* os_message_buffer_handle_t;
+typedef void* os_timer_handle_t;
+typedef void* os_queue_set_handle_t;
 
 // Task function prototype
 typedef void (*os_task_func_t)(void* args);
 
+// Storage for statically allocated kernel objects (sized for the FreeRTOS
+// Static*_t types, checked in os_wrapper.c), in pointer-sized words
+#if defined(ESP_PLATFORM) || defined(IDF_VER)
+    #define OS_TASK_STORAGE_WORDS       100
+    #define OS_QUEUE_STORAGE_WORDS      28
+    #define OS_STREAM_STORAGE_WORDS     12
+    #define OS_TIMER_STORAGE_WORDS      20
+#else
+    #define OS_TASK_STORAGE_WORDS       24  // StaticTask_t, 96 bytes on Cortex-M7
+    #define OS_QUEUE_STORAGE_WORDS      21  // StaticQueue_t / StaticSemaphore_t, 84 bytes with queue sets
+    #define OS_STREAM_STORAGE_WORDS     9   // StaticStreamBuffer_t, 36 bytes
+    #define OS_TIMER_STORAGE_WORDS      14  // StaticTimer_t (44 bytes) + callback and argument
+#endif
+
+typedef struct {
+    uintptr_t words[OS_TASK_STORAGE_WORDS];
+} __attribute__((aligned(8))) os_task_storage_t;
+
+// Queues, mutexes and semaphores share one control block type
+typedef struct {
+    uintptr_t words[OS_QUEUE_STORAGE_WORDS];
+} __attribute__((aligned(8))) os_queue_storage_t;
+
+typedef os_queue_storage_t os_mutex_storage_t;
+typedef os_queue_storage_t os_semaphore_storage_t;
+
+// Stream and message buffers share one control block type
+typedef struct {
+    uintptr_t words[OS_STREAM_STORAGE_WORDS];
+} __attribute__((aligned(8))) os_stream_buffer_storage_t;
+
+typedef struct {
+    uintptr_t words[OS_TIMER_STORAGE_WORDS];
+} __attribute__((aligned(8))) os_timer_storage_t;
+
+// Timer expiry callback, see SOFTWARE TIMERS for its context
+typedef void (*os_timer_callback_t)(void* arg);
+
 // Return codes
 typedef enum {
     OS_SUCCESS = 0,
@@ -48,6 +90,65 @@ typedef enum {
 #define OS_PRIORITY_CRITICAL        15  // Critical real-time tasks
 #define OS_PRIORITY_ISR_DEFERRED    20  // Deferred ISR processing
 
+// Static allocation: define the storage at file scope, then create the
+// object on it at init. Nothing comes from the heap, so kernel RAM is fixed
+// at link time. Deleting a static object leaves its storage reusable.
+//
+//   OS_QUEUE_DEFINE(events, 16, sizeof(event_t));
+//   OS_TASK_DEFINE(worker, 2048);
+//   queue = OS_QUEUE_CREATE_STATIC(events);
+//   OS_TASK_CREATE_STATIC(worker, worker_task, "worker", NULL, OS_PRIORITY_NORMAL, &handle);
+#define OS_QUEUE_DEFINE(name, length, item_size) \
+    static uint8_t name##_queue_buffer[(length) * (item_size)] __attribute__((aligned(8))); \
+    static os_queue_storage_t name##_queue_storage; \
+    enum { name##_queue_length = (length), name##_queue_item_size = (item_size) }
+#define OS_QUEUE_CREATE_STATIC(name) \
+    os_queue_create_static(name##_queue_length, name##_queue_item_size, \
+                           name##_queue_buffer, &name##_queue_storage)
+
+// Stack size in bytes, as for os_task_create()
+#define OS_TASK_DEFINE(name, stack_size) \
+    static uint32_t name##_task_stack[((stack_size) + 3) / 4] __attribute__((aligned(8))); \
+    static os_task_storage_t name##_task_storage
+#define OS_TASK_CREATE_STATIC(name, task_func, task_name, params, priority, handle) \
+    os_task_create_static((task_func), (task_name), sizeof(name##_task_stack), (params), \
+                          (priority), name##_task_stack, &name##_task_storage, (handle))
+
+#define OS_MUTEX_DEFINE(name) \
+    static os_mutex_storage_t name##_mutex_storage
+#define OS_MUTEX_CREATE_STATIC(name) \
+    os_mutex_create_static(&name##_mutex_storage)
+
+#define OS_SEMAPHORE_DEFINE(name) \
+    static os_semaphore_storage_t name##_semaphore_storage
+#define OS_SEMAPHORE_CREATE_BINARY_STATIC(name) \
+    os_semaphore_create_binary_static(&name##_semaphore_storage)
+#define OS_SEMAPHORE_CREATE_COUNTING_STATIC(name, max_count, initial_count) \
+    os_semaphore_create_counting_static((max_count), (initial_count), &name##_semaphore_storage)
+
+// One byte of a stream buffer's storage is never used, so add it here
+#define OS_STREAM_BUFFER_DEFINE(name, size_bytes, trigger_level) \
+    static uint8_t name##_stream_buffer[(size_bytes) + 1]; \
+    static os_stream_buffer_storage_t name##_stream_storage; \
+    enum { name##_stream_size = (size_bytes) + 1, name##_stream_trigger = (trigger_level) }
+#define OS_STREAM_BUFFER_CREATE_STATIC(name) \
+    os_stream_buffer_create_static(name##_stream_size, name##_stream_trigger, \
+                                   name##_stream_buffer, &name##_stream_storage)
+
+// A set holds one entry per item its members hold, so size it for all of them
+#define OS_QUEUE_SET_DEFINE(name, length) \
+    static void* name##_queue_set_buffer[(length)]; \
+    static os_queue_storage_t name##_queue_set_storage; \
+    enum { name##_queue_set_length = (length) }
+#define OS_QUEUE_SET_CREATE_STATIC(name) \
+    os_queue_set_create_static(name##_queue_set_length, (uint8_t*)name##_queue_set_buffer, \
+                               &name##_queue_set_storage)
+
+#define OS_TIMER_DEFINE(name) \
+    static os_timer_storage_t name##_timer_storage
+#define OS_TIMER_CREATE_STATIC(name, period_ms, periodic, callback, arg) \
+    os_timer_create_static(#name, (period_ms), (periodic), (callback), (arg), &name##_timer_storage)
+
 // =============================================================================
 // INITIALIZATION
 // =============================================================================
@@ -58,6 +159,12 @@ typedef enum {
  */
 os_result_t os_init(void);
 
+/**
+ * @brief Check whether the scheduler has been started
+ * @return false before the kernel starts (tasks may already exist)
+ */
+bool os_kernel_is_running(void);
+
 // =============================================================================
 // QUEUE OPERATIONS
 // =============================================================================
@@ -70,6 +177,19 @@ os_result_t os_init(void);
  */
 os_queue_handle_t os_queue_create(uint32_t queue_length, uint32_t item_size);
 
+/**
+ * @brief Create a message queue on caller-provided storage
+ * @param queue_length Maximum number of items the queue can hold
+ * @param item_size Size of each item in bytes
+ * @param buffer Item storage, queue_length * item_size bytes
+ * @param storage Control block storage
+ * @return Queue handle on success, NULL on failure
+ *
+ * @note Buffers must outlive the queue; usually via OS_QUEUE_DEFINE()
+ */
+os_queue_handle_t os_queue_create_static(uint32_t queue_length, uint32_t item_size,
+                                         uint8_t* buffer, os_queue_storage_t* storage);
+
 /**
  * @brief Delete a queue
  * @param queue Queue handle to delete
@@ -140,6 +260,63 @@ uint32_t os_queue_get_count(os_queue_handle_t queue);
  */
 os_result_t os_queue_reset(os_queue_handle_t queue);
 
+// =============================================================================
+// QUEUE SETS
+// =============================================================================
+
+// One blocking wait on several queues and semaphores (not mutexes), for a
+// task with more than one input, instead of polling each with a timeout.
+// Sending to a member, from a task or an ISR, also posts the member to its
+// set; os_queue_set_select() returns the next member posted, which then
+// has an item to take with OS_NO_WAIT. Take a member's items only after
+// selecting it; an item taken otherwise leaves its entry in the set.
+//
+//   OS_QUEUE_SET_DEFINE(inputs, RX_DEPTH + 1);
+//   set = OS_QUEUE_SET_CREATE_STATIC(inputs);
+//   os_queue_set_add(set, rx_queue);
+//   os_queue_set_add(set, stop_semaphore);
+//   while ((member = os_queue_set_select(set, OS_WAIT_FOREVER)) != stop_semaphore) {
+//       os_queue_receive(rx_queue, &item, OS_NO_WAIT);
+//   }
+
+/**
+ * @brief Create a queue set on caller-provided storage
+ * @param length Entries: at least the summed lengths of the members (1 per semaphore count)
+ * @param buffer Entry storage, length pointers
+ * @param storage Control block storage
+ * @return Set handle on success, NULL on failure
+ *
+ * @note Buffers must outlive the set; usually via OS_QUEUE_SET_DEFINE()
+ */
+os_queue_set_handle_t os_queue_set_create_static(uint32_t length, uint8_t* buffer,
+                                                 os_queue_storage_t* storage);
+
+/**
+ * @brief Delete a set (does not delete its members)
+ */
+void os_queue_set_delete(os_queue_set_handle_t set);
+
+/**
+ * @brief Add an empty queue or semaphore to a set
+ * @return OS_SUCCESS, OS_ERROR if the member holds items or is in a set, or OS_INVALID_PARAM
+ */
+os_result_t os_queue_set_add(os_queue_set_handle_t set, void* member);
+
+/**
+ * @brief Remove an empty queue or semaphore from its set
+ * @return OS_SUCCESS, OS_ERROR if the member holds items or is not in the set, or OS_INVALID_PARAM
+ */
+os_result_t os_queue_set_remove(os_queue_set_handle_t set, void* member);
+
+/**
+ * @brief Wait until a member of the set has an item
+ * @param timeout_ms Timeout in milliseconds (OS_NO_WAIT, OS_WAIT_FOREVER, or specific time)
+ * @return The member (a queue or semaphore handle), or NULL on timeout
+ *
+ * @note BLOCKING. Must NOT be called from ISR context.
+ */
+void* os_queue_set_select(os_queue_set_handle_t set, uint32_t timeout_ms);
+
 // =============================================================================
 // TASK OPERATIONS
 // =============================================================================
@@ -183,6 +360,26 @@ os_result_t os_task_create_pinned(os_task_func_t task_func, const char* name,
                                  uint8_t priority, os_task_handle_t* handle,
                                  uint8_t core_id);
 
+/**
+ * @brief Create a task on caller-provided stack and control block
+ * @param task_func Task function to execute
+ * @param name Task name (for debugging)
+ * @param stack_size Stack size in bytes (size of the stack array)
+ * @param params Parameters to pass to task function
+ * @param priority Task priority (0=lowest, higher number = higher priority)
+ * @param stack Stack storage, 8-byte aligned
+ * @param storage Control block storage
+ * @param handle Pointer to store task handle (can be NULL)
+ * @return OS_SUCCESS on success, OS_INVALID_PARAM on bad arguments
+ *
+ * @note Storage must outlive the task; usually via OS_TASK_DEFINE(). A task
+ *       that deleted itself frees its storage only after the idle task ran.
+ */
+os_result_t os_task_create_static(os_task_func_t task_func, const char* name,
+                                  uint32_t stack_size, void* params,
+                                  uint8_t priority, uint32_t* stack,
+                                  os_task_storage_t* storage, os_task_handle_t* handle);
+
 /**
  * @brief Delete a task
  * @param handle Task handle to delete (NULL deletes current task)
@@ -195,6 +392,92 @@ void os_task_delete(os_task_handle_t handle);
  */
 os_task_handle_t os_task_get_current(void);
 
+/**
+ * @brief Change a task's priority
+ * @param handle Task handle (NULL for the current task)
+ * @param priority New priority, OS_PRIORITY_* constants
+ */
+void os_task_set_priority(os_task_handle_t handle, uint8_t priority);
+
+/**
+ * @brief Smallest amount of stack a task has had left so far
+ * @param handle Task handle (NULL for the current task)
+ * @return Unused stack in bytes (0 means it has overflowed or is about to)
+ */
+uint32_t os_task_get_stack_high_water(os_task_handle_t handle);
+
+/**
+ * @brief Kernel-assigned task number (the one runtime stats report)
+ * Only reads the task, so safe from ISRs of any priority.
+ * @param handle Task handle (NULL for the current task)
+ * @return Task number, 0 before the scheduler runs
+ */
+uint32_t os_task_get_number(os_task_handle_t handle);
+
+/**
+ * @brief Entry function and stack size of a task, for stack reports
+ */
+typedef struct {
+    os_task_func_t entry;
+    uint32_t stack_size;            /**< Bytes */
+} os_task_info_t;
+
+/**
+ * @brief Record a task created without os_task_create*() (CMSIS, raw FreeRTOS)
+ * @param handle Task handle (NULL for the current task)
+ * @param entry Task function
+ * @param stack_size Stack size in bytes
+ */
+void os_task_note_info(os_task_handle_t handle, os_task_func_t entry, uint32_t stack_size);
+
+/**
+ * @brief Entry function and stack size given when the task was created
+ * @param handle Task handle (NULL for the current task)
+ * @param info Output
+ * @return false for tasks not created (or noted) through the wrapper, or when
+ *         the table was full at creation
+ */
+bool os_task_get_info(os_task_handle_t handle, os_task_info_t *info);
+
+// =============================================================================
+// TASK NOTIFICATIONS
+// =============================================================================
+
+// Direct-to-task wakeups: no kernel object, faster than a semaphore. Each
+// task has one notification, used with counting semantics below; it may
+// only have a single waiter (the task itself).
+
+/**
+ * @brief Wake a task waiting in os_task_notify_wait()
+ * @param task Task to notify
+ * @return OS_SUCCESS or OS_INVALID_PARAM
+ *
+ * @note NON-BLOCKING. Must NOT be called from ISR context - use
+ *       os_task_notify_from_isr() instead.
+ */
+os_result_t os_task_notify(os_task_handle_t task);
+
+/**
+ * @brief Wake a task waiting in os_task_notify_wait(), from ISR context
+ * @param task Task to notify
+ * @param higher_priority_task_woken Set to true if a higher priority task was woken
+ * @return OS_SUCCESS or OS_INVALID_PARAM
+ *
+ * @note NON-BLOCKING: This function never blocks and should only be called from ISR context.
+ */
+os_result_t os_task_notify_from_isr(os_task_handle_t task, bool* higher_priority_task_woken);
+
+/**
+ * @brief Wait for notifications to the calling task
+ * @param timeout_ms Timeout in milliseconds (OS_NO_WAIT, OS_WAIT_FOREVER, or specific time)
+ * @return Number of notifications received (all are consumed), 0 on timeout
+ *
+ * @note BLOCKING: Like taking a binary semaphore; notifications sent while
+ *       the task was busy collapse into one wakeup.
+ *       Must NOT be called from ISR context.
+ */
+uint32_t os_task_notify_wait(uint32_t timeout_ms);
+
 // =============================================================================
 // SYNCHRONIZATION - MUTEX
 // =============================================================================
@@ -205,6 +488,13 @@ os_task_handle_t os_task_get_current(void);
  */
 os_mutex_handle_t os_mutex_create(void);
 
+/**
+ * @brief Create a mutex on caller-provided storage
+ * @param storage Control block storage (usually via OS_MUTEX_DEFINE())
+ * @return Mutex handle on success, NULL on failure
+ */
+os_mutex_handle_t os_mutex_create_static(os_mutex_storage_t* storage);
+
 /**
  * @brief Delete a mutex
  * @param mutex Mutex handle to delete
@@ -251,6 +541,23 @@ os_semaphore_handle_t os_semaphore_create_binary(void);
  */
 os_semaphore_handle_t os_semaphore_create_counting(uint32_t max_count, uint32_t initial_count);
 
+/**
+ * @brief Create a binary semaphore on caller-provided storage
+ * @param storage Control block storage (usually via OS_SEMAPHORE_DEFINE())
+ * @return Semaphore handle on success, NULL on failure
+ */
+os_semaphore_handle_t os_semaphore_create_binary_static(os_semaphore_storage_t* storage);
+
+/**
+ * @brief Create a counting semaphore on caller-provided storage
+ * @param max_count Maximum count value
+ * @param initial_count Initial count value
+ * @param storage Control block storage (usually via OS_SEMAPHORE_DEFINE())
+ * @return Semaphore handle on success, NULL on failure
+ */
+os_semaphore_handle_t os_semaphore_create_counting_static(uint32_t max_count, uint32_t initial_count,
+                                                          os_semaphore_storage_t* storage);
+
 /**
  * @brief Delete a semaphore
  * @param semaphore Semaphore handle to delete
@@ -300,6 +607,257 @@ os_result_t os_semaphore_give_from_isr(os_semaphore_handle_t semaphore, bool* hi
  */
 os_result_t os_semaphore_take_from_isr(os_semaphore_handle_t semaphore, bool* higher_priority_task_woken);
 
+// =============================================================================
+// STREAM AND MESSAGE BUFFERS
+// =============================================================================
+
+// Byte streams (stream buffer) and length-delimited messages (message
+// buffer) from exactly one writer to exactly one reader, either side may be
+// an ISR. Several writers or readers need their own serialization.
+
+/**
+ * @brief Create a stream buffer
+ * @param size_bytes Capacity in bytes
+ * @param trigger_level Bytes that must be buffered before a blocked reader
+ *                      wakes (1 = any data); a timeout or
+ *                      os_stream_buffer_wake_reader() returns fewer
+ * @return Stream buffer handle on success, NULL on failure
+ */
+os_stream_buffer_handle_t os_stream_buffer_create(size_t size_bytes, size_t trigger_level);
+
+/**
+ * @brief Create a stream buffer on caller-provided storage
+ * @param size_bytes Size of buffer; the capacity is one byte less
+ * @param trigger_level See os_stream_buffer_create()
+ * @param buffer Data storage
+ * @param storage Control block storage (usually via OS_STREAM_BUFFER_DEFINE())
+ * @return Stream buffer handle on success, NULL on failure
+ */
+os_stream_buffer_handle_t os_stream_buffer_create_static(size_t size_bytes, size_t trigger_level,
+                                                         uint8_t* buffer,
+                                                         os_stream_buffer_storage_t* storage);
+
+/**
+ * @brief Delete a stream buffer
+ * @param stream Stream buffer handle to delete
+ */
+void os_stream_buffer_delete(os_stream_buffer_handle_t stream);
+
+/**
+ * @brief Write bytes to a stream buffer
+ * @param stream Stream buffer handle
+ * @param data Bytes to write
+ * @param length Number of bytes
+ * @param timeout_ms Time to wait for space (OS_NO_WAIT, OS_WAIT_FOREVER, or specific time)
+ * @return Number of bytes written, less than length if the buffer filled up
+ *
+ * @note Must NOT be called from ISR context - use os_stream_buffer_send_from_isr() instead.
+ */
+size_t os_stream_buffer_send(os_stream_buffer_handle_t stream, const void* data, size_t length,
+                             uint32_t timeout_ms);
+
+/**
+ * @brief Write bytes to a stream buffer from ISR context
+ * @param higher_priority_task_woken Set to true if a higher priority task was woken
+ * @return Number of bytes written
+ */
+size_t os_stream_buffer_send_from_isr(os_stream_buffer_handle_t stream, const void* data, size_t length,
+                                      bool* higher_priority_task_woken);
+
+/**
+ * @brief Read bytes from a stream buffer
+ * @param stream Stream buffer handle
+ * @param data Destination
+ * @param length Maximum number of bytes
+ * @param timeout_ms Time to wait for the trigger level (OS_NO_WAIT, OS_WAIT_FOREVER, or specific time)
+ * @return Number of bytes read, 0 on timeout
+ *
+ * @note BLOCKING while fewer than the trigger level bytes are buffered.
+ *       Must NOT be called from ISR context - use os_stream_buffer_receive_from_isr() instead.
+ */
+size_t os_stream_buffer_receive(os_stream_buffer_handle_t stream, void* data, size_t length,
+                                uint32_t timeout_ms);
+
+/**
+ * @brief Read bytes from a stream buffer from ISR context
+ * @param higher_priority_task_woken Set to true if a higher priority task was woken
+ * @return Number of bytes read
+ */
+size_t os_stream_buffer_receive_from_isr(os_stream_buffer_handle_t stream, void* data, size_t length,
+                                         bool* higher_priority_task_woken);
+
+/**
+ * @brief Number of bytes buffered
+ */
+size_t os_stream_buffer_bytes_available(os_stream_buffer_handle_t stream);
+
+/**
+ * @brief Change the trigger level
+ * @return OS_SUCCESS, or OS_INVALID_PARAM if larger than the buffer
+ */
+os_result_t os_stream_buffer_set_trigger_level(os_stream_buffer_handle_t stream, size_t trigger_level);
+
+/**
+ * @brief Wake a blocked reader below the trigger level (e.g. on line idle)
+ * @return true if a reader was waiting
+ *
+ * @note The writer side calls it. Must NOT be called from ISR context - use
+ *       os_stream_buffer_wake_reader_from_isr() instead.
+ */
+bool os_stream_buffer_wake_reader(os_stream_buffer_handle_t stream);
+
+/**
+ * @brief Wake a blocked reader from ISR context
+ * @param higher_priority_task_woken Set to true if a higher priority task was woken
+ * @return true if a reader was waiting
+ */
+bool os_stream_buffer_wake_reader_from_isr(os_stream_buffer_handle_t stream,
+                                           bool* higher_priority_task_woken);
+
+/**
+ * @brief Discard buffered data
+ * @return OS_SUCCESS, or OS_ERROR while a task is blocked on the buffer
+ */
+os_result_t os_stream_buffer_reset(os_stream_buffer_handle_t stream);
+
+/**
+ * @brief Create a message buffer
+ * @param size_bytes Capacity in bytes; every message also takes a
+ *                   sizeof(size_t) length header
+ * @return Message buffer handle on success, NULL on failure
+ */
+os_message_buffer_handle_t os_message_buffer_create(size_t size_bytes);
+
+/**
+ * @brief Create a message buffer on caller-provided storage
+ * @param size_bytes Size of buffer; the capacity is one byte less
+ * @param buffer Data storage
+ * @param storage Control block storage
+ * @return Message buffer handle on success, NULL on failure
+ */
+os_message_buffer_handle_t os_message_buffer_create_static(size_t size_bytes, uint8_t* buffer,
+                                                           os_stream_buffer_storage_t* storage);
+
+/**
+ * @brief Delete a message buffer
+ */
+void os_message_buffer_delete(os_message_buffer_handle_t buffer);
+
+/**
+ * @brief Write one message
+ * @param timeout_ms Time to wait for space (OS_NO_WAIT, OS_WAIT_FOREVER, or specific time)
+ * @return OS_SUCCESS, OS_FULL (no room in time) or OS_INVALID_PARAM
+ */
+os_result_t os_message_buffer_send(os_message_buffer_handle_t buffer, const void* message, size_t length,
+                                   uint32_t timeout_ms);
+
+/**
+ * @brief Write one message from ISR context
+ * @return OS_SUCCESS, OS_FULL or OS_INVALID_PARAM
+ */
+os_result_t os_message_buffer_send_from_isr(os_message_buffer_handle_t buffer, const void* message,
+                                            size_t length, bool* higher_priority_task_woken);
+
+/**
+ * @brief Read one message
+ * @param message Destination
+ * @param max_length Size of destination; a longer message stays queued
+ * @param timeout_ms Time to wait for a message (OS_NO_WAIT, OS_WAIT_FOREVER, or specific time)
+ * @return Message length, 0 on timeout or if it does not fit
+ */
+size_t os_message_buffer_receive(os_message_buffer_handle_t buffer, void* message, size_t max_length,
+                                 uint32_t timeout_ms);
+
+/**
+ * @brief Read one message from ISR context
+ * @return Message length, 0 if none (or it does not fit)
+ */
+size_t os_message_buffer_receive_from_isr(os_message_buffer_handle_t buffer, void* message,
+                                          size_t max_length, bool* higher_priority_task_woken);
+
+// =============================================================================
+// SOFTWARE TIMERS
+// =============================================================================
+
+// One-shot and periodic callbacks at a time, instead of comparing ticks in
+// every pass of a loop. With configUSE_TIMERS these are FreeRTOS timers:
+// callbacks run in the timer service task, one after another, and must
+// not block. Without it (bare metal) a list driven by os_timer_tick() from
+// the tick interrupt runs them in that interrupt. Either way a callback
+// should only hand work on - a task notification or an os_sched post, the
+// _from_isr variant when os_in_isr() - so it works in both contexts.
+//
+//   OS_TIMER_DEFINE(flush);
+//   os_timer_handle_t t = OS_TIMER_CREATE_STATIC(flush, 500, false, flush_due, NULL);
+//   os_timer_start(t);                       // flush_due(NULL) in 500 ms
+
+/**
+ * @brief Create a timer on caller-provided storage (not started)
+ * @param name Name for debugging
+ * @param period_ms Time from start to expiry, and between periodic expiries (> 0)
+ * @param periodic Restart after every expiry
+ * @param callback Called on expiry
+ * @param arg Passed to the callback
+ * @param storage Control block storage
+ * @return Timer handle on success, NULL on failure
+ */
+os_timer_handle_t os_timer_create_static(const char* name, uint32_t period_ms, bool periodic,
+                                         os_timer_callback_t callback, void* arg,
+                                         os_timer_storage_t* storage);
+
+/**
+ * @brief Delete a stopped or running timer
+ *
+ * The storage is reusable once the timer task has taken the command.
+ */
+void os_timer_delete(os_timer_handle_t timer);
+
+/**
+ * @brief Start a timer, or restart a running one, from now
+ * @return OS_SUCCESS, OS_FULL (timer command queue full) or OS_INVALID_PARAM
+ *
+ * @note NON-BLOCKING. Before the kernel starts the command waits in the
+ *       queue and the period runs from the timer task's first pass.
+ */
+os_result_t os_timer_start(os_timer_handle_t timer);
+
+/**
+ * @brief Start or restart a timer from ISR context
+ * @return OS_SUCCESS, OS_FULL or OS_INVALID_PARAM
+ */
+os_result_t os_timer_start_from_isr(os_timer_handle_t timer, bool* higher_priority_task_woken);
+
+/**
+ * @brief Stop a timer; a stopped timer stays stopped
+ * @return OS_SUCCESS, OS_FULL or OS_INVALID_PARAM
+ */
+os_result_t os_timer_stop(os_timer_handle_t timer);
+
+/**
+ * @brief Stop a timer from ISR context
+ * @return OS_SUCCESS, OS_FULL or OS_INVALID_PARAM
+ */
+os_result_t os_timer_stop_from_isr(os_timer_handle_t timer, bool* higher_priority_task_woken);
+
+/**
+ * @brief Change the period and (re)start the timer from now
+ * @return OS_SUCCESS, OS_FULL or OS_INVALID_PARAM (also for 0 ms)
+ */
+os_result_t os_timer_set_period(os_timer_handle_t timer, uint32_t period_ms);
+
+/**
+ * @brief Check whether a timer is running (started and not expired, or periodic)
+ */
+bool os_timer_is_active(os_timer_handle_t timer);
+
+/**
+ * @brief Advance bare-metal timers by one millisecond (1 ms tick interrupt)
+ *
+ * Only does something without configUSE_TIMERS; the kernel drives its
+ * own timers otherwise.
+ */
+void os_timer_tick(void);
+
 // =============================================================================
 // ISR UTILITIES
 // =============================================================================
@@ -314,6 +872,29 @@ os_result_t os_semaphore_take_from_isr(os_semaphore_handle_t semaphore, bool* hi
  */
 void os_yield_from_isr(bool higher_priority_task_woken);
 
+/**
+ * @brief Whether the caller runs in an interrupt handler
+ *
+ * For code shared by tasks and ISRs that has to pick between an OS call
+ * and its _from_isr variant.
+ */
+bool os_in_isr(void);
+
+/**
+ * @brief Mask the interrupts that may use the OS, from task or ISR context
+ * @return Previous mask, to hand to os_critical_exit()
+ *
+ * @note For a few instructions only, e.g. updating shared counters. Nests;
+ *       must not block or call other OS functions inside.
+ */
+uint32_t os_critical_enter(void);
+
+/**
+ * @brief Restore the interrupt mask saved by os_critical_enter()
+ * @param saved_mask Value returned by the matching os_critical_enter()
+ */
+void os_critical_exit(uint32_t saved_mask);
+
 // =============================================================================
 // TIME OPERATIONS
 // =============================================================================
@@ -330,6 +911,16 @@ uint32_t os_get_tick_count(void);
  */
 uint32_t os_get_time_ms(void);
 
+/**
+ * @brief Time the idle task has run since boot
+ * @return Microseconds (the run-time stats clock, wraps), 0 without
+ *         configGENERATE_RUN_TIME_STATS
+ *
+ * The difference over an interval, taken from a task, is the time no
+ * task wanted the CPU.
+ */
+uint32_t os_get_idle_time_us(void);
+
 /**
  * @brief Delay current task for specified milliseconds
  * @param delay_ms Delay in milliseconds
@@ -339,6 +930,20 @@ uint32_t os_get_time_ms(void);
  */
 void os_delay_ms(uint32_t delay_ms);
 
+/**
+ * @brief Delay current task until an absolute, periodic deadline
+ * @param last_wake_tick In: tick of the previous deadline (initialize with
+ *                       os_get_tick_count()). Out: the deadline just reached.
+ * @param period_ms Period in milliseconds
+ * @return true if the deadline was met, false if it had already passed
+ *         (the call then returns without blocking)
+ *
+ * @note Unlike os_delay_ms(), the time spent between calls does not add to
+ *       the period, so a periodic loop does not drift.
+ *       Must NOT be called from ISR context.
+ */
+bool os_delay_until(uint32_t *last_wake_tick, uint32_t period_ms);
+
 /**
  * @brief Convert milliseconds to OS ticks
  * @param ms Milliseconds to convert
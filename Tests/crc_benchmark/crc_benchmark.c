@@ -0,0 +1,72 @@
+/**
+ * @file crc_benchmark.c
+ * @brief CRC16 implementation micro-benchmark
+ *
+ * Output (RTT), cycles per call:
+ *   CRC_BENCH: 256B: bytewise=<n> slice8=<n> hw=<n>
+ *   CRC_BENCH: 512B: bytewise=<n> slice8=<n> hw=<n>
+ */
+
+#include "crc_benchmark.h"
+#include "../../Utils/crc16.h"
+#include "../../HAL/hal_crc.h"
+#include "../../HAL/hal_delay.h"
+#include "../../Drivers_BSP/Custom/portable_log.h"
+
+static const char *TAG = "CRC_BENCH";
+
+#define BENCH_ROUNDS        100
+#define BENCH_MAX_LENGTH    512
+
+typedef uint16_t (*crc_func_t)(uint16_t crc, const uint8_t *data, size_t length);
+
+static uint8_t bench_data[BENCH_MAX_LENGTH];
+
+/**
+ * @brief Average cycles per call of one CRC implementation
+ */
+static uint32_t bench_cycles(crc_func_t func, size_t length, uint16_t *result)
+{
+    uint32_t start = hal_get_cycle_count();
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        *result = func(CRC16_CCITT_INIT, bench_data, length);
+    }
+
+    return (hal_get_cycle_count() - start) / BENCH_ROUNDS;
+}
+
+void crc_benchmark_run(void)
+{
+    static const size_t lengths[] = { 256, 512 };
+
+    for (uint32_t i = 0; i < sizeof(bench_data); i++) {
+        bench_data[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    crc16_init();
+
+    for (uint32_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        uint16_t crc_byte, crc_slice, crc_hw = 0;
+        uint32_t hw_cycles = 0;
+
+        uint32_t byte_cycles = bench_cycles(crc16_ccitt_bytewise, lengths[i], &crc_byte);
+        uint32_t slice_cycles = bench_cycles(crc16_ccitt_sliced, lengths[i], &crc_slice);
+
+        if (hal_crc_is_available()) {
+            hw_cycles = bench_cycles(hal_crc_ccitt16, lengths[i], &crc_hw);
+        } else {
+            crc_hw = crc_byte;
+        }
+
+        if (crc_slice != crc_byte || crc_hw != crc_byte) {
+            LOG_E(TAG, "%uB: result mismatch byte=0x%04X slice=0x%04X hw=0x%04X",
+                  (unsigned)lengths[i], crc_byte, crc_slice, crc_hw);
+            continue;
+        }
+
+        LOG_I(TAG, "%uB: bytewise=%lu slice%d=%lu hw=%lu", (unsigned)lengths[i],
+              (unsigned long)byte_cycles, CRC16_SLICES, (unsigned long)slice_cycles,
+              (unsigned long)hw_cycles);
+    }
+}
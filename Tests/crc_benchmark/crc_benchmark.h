@@ -0,0 +1,17 @@
+/**
+ * @file crc_benchmark.h
+ * @brief CRC16 implementation micro-benchmark
+ */
+
+#ifndef CRC_BENCHMARK_H
+#define CRC_BENCHMARK_H
+
+/**
+ * @brief Compare bytewise, slice-by-N and hardware CRC16
+ *
+ * Runs each implementation on 256- and 512-byte payloads, checks that all
+ * results match, and logs the average DWT cycles per call.
+ */
+void crc_benchmark_run(void);
+
+#endif // CRC_BENCHMARK_H
@@ -0,0 +1,268 @@
+/**
+ * @file display_benchmark.c
+ * @brief ST7735 display pipeline benchmark
+ *
+ * Output (RTT), one line per case and path, averaged over the case's frames:
+ *   DISP_BENCH: <case>/<path>: fps=<n.n> spi=<n>% cycles/frame=<n> busy/frame=<n>
+ *   DISP_BENCH: <case>/<path>: n/a          (path unavailable)
+ *
+ * <path> is "poll" or "dma"; spi is the wire time of the bytes sent (at
+ * the panel's SCK) over the run time, busy the cycles no idle task ran.
+ *
+ * Cases and what one frame is:
+ *   fill        one full-screen ST7735_FillScreenFast()
+ *   glyphs      BENCH_GLYPH_ROWS rows of BENCH_GLYPH_COLS Font_11x18 digits
+ *               through ST7735_WriteString() (also cycles/glyph)
+ *   image       one 128x128 ST7735_DrawImage() of a gradient in RAM
+ *   fb_text     one changed value string in the framebuffer, then a flush
+ *   fb_image    the image or a clear of its area in the framebuffer, then a flush
+ *   widgets     three numbers, a bar and a sparkline updated, one display_ui_render()
+ */
+
+#include "display_benchmark.h"
+#include "../../Drivers_BSP/Custom/ips_display.h"
+#include "../../Drivers_BSP/Custom/display_fb.h"
+#include "../../Drivers_BSP/Custom/display_ui.h"
+#include "../../Drivers_BSP/External/ST7735/st7735.h"
+#include "../../Middleware/Services/serv_display.h"
+#include "../../HAL/hal_delay.h"
+#include "../../HAL/hal_mem.h"
+#include "../../HAL/hal_timer.h"
+#include "../../OS/os_wrapper.h"
+#include "../../Drivers_BSP/Custom/portable_log.h"
+#include <stdio.h>
+
+static const char *TAG = "DISP_BENCH";
+
+#define BENCH_READY_TIMEOUT_MS  2000
+#define BENCH_FILL_FRAMES       10
+#define BENCH_GLYPH_FRAMES      10
+#define BENCH_GLYPH_COLS        10
+#define BENCH_GLYPH_ROWS        8
+#define BENCH_IMAGE_FRAMES      10
+#define BENCH_IMAGE_SIZE        128
+#define BENCH_FB_FRAMES         50
+#define BENCH_WIDGET_FRAMES     50
+
+typedef struct {
+    uint32_t cycles;
+    uint32_t us;
+    uint32_t idle_us;
+    uint32_t bytes;
+} bench_mark_t;
+
+static const char *const path_names[] = { "poll", "dma" };
+
+// Panel byte order, as ST7735_DrawImage() takes it; DMA reads it
+static uint16_t image_pixels[BENCH_IMAGE_SIZE * BENCH_IMAGE_SIZE]
+    __attribute__((aligned(HAL_CACHE_LINE_SIZE)));
+
+static void make_image(void)
+{
+    for (uint32_t y = 0; y < BENCH_IMAGE_SIZE; y++) {
+        for (uint32_t x = 0; x < BENCH_IMAGE_SIZE; x++) {
+            // RGB565: red across, green down, blue on the diagonal
+            uint16_t color = (uint16_t)(((x >> 2) << 11) | ((y >> 1) << 5) | (((x + y) >> 3) & 0x1F));
+            image_pixels[y * BENCH_IMAGE_SIZE + x] = (uint16_t)((color >> 8) | (color << 8));
+        }
+    }
+    hal_cache_clean(image_pixels, sizeof(image_pixels));
+}
+
+static void bench_begin(bench_mark_t *mark)
+{
+    mark->bytes = ST7735_GetBytesSent();
+    mark->idle_us = os_get_idle_time_us();
+    mark->us = hal_timer_get_us();
+    mark->cycles = hal_get_cycle_count();
+}
+
+static void report(const char *name, uint32_t path, const bench_mark_t *mark, uint32_t frames,
+                   uint32_t glyphs)
+{
+    if (frames == 0) {
+        LOG_W(TAG, "%s/%s: n/a", name, path_names[path]);
+        return;
+    }
+
+    uint32_t cycles = hal_get_cycle_count() - mark->cycles;
+    uint32_t us = hal_timer_get_us() - mark->us;
+    uint32_t idle_us = os_get_idle_time_us() - mark->idle_us;
+    uint32_t bytes = ST7735_GetBytesSent() - mark->bytes;
+
+    if (us == 0) {
+        us = 1;     // Frames below the timer's resolution
+    }
+
+    uint32_t sck_hz = ST7735_GetSpiClockHz();
+    uint64_t wire_us = (sck_hz > 0) ? (uint64_t)bytes * 8U * 1000000U / sck_hz : 0;
+    uint32_t busy_us = (idle_us < us) ? us - idle_us : 0;
+    uint64_t cycles_per_us = hal_get_cpu_freq_hz() / 1000000U;
+    uint32_t fps_x10 = (uint32_t)((uint64_t)frames * 10000000U / us);
+
+    LOG_I(TAG, "%s/%s: fps=%lu.%lu spi=%lu%% cycles/frame=%lu busy/frame=%lu", name,
+          path_names[path], (unsigned long)(fps_x10 / 10U), (unsigned long)(fps_x10 % 10U),
+          (unsigned long)(wire_us * 100U / us), (unsigned long)(cycles / frames),
+          (unsigned long)(busy_us * cycles_per_us / frames));
+    if (glyphs > 0) {
+        LOG_I(TAG, "%s/%s: cycles/glyph=%lu", name, path_names[path],
+              (unsigned long)(cycles / glyphs));
+    }
+}
+
+// ============================================================================
+// Direct Drawing
+// ============================================================================
+
+static void bench_fill(uint32_t path)
+{
+    bench_mark_t mark;
+
+    bench_begin(&mark);
+    for (uint32_t i = 0; i < BENCH_FILL_FRAMES; i++) {
+        ST7735_FillScreenFast((i & 1) ? ST7735_BLACK : ST7735_WHITE);
+    }
+    report("fill", path, &mark, BENCH_FILL_FRAMES, 0);
+}
+
+static void bench_glyphs(uint32_t path)
+{
+    static const char digits[BENCH_GLYPH_COLS + 1] = "0123456789";
+    bench_mark_t mark;
+
+    // Same font and colors throughout: the glyph cache is warm, as for value updates
+    bench_begin(&mark);
+    for (uint32_t i = 0; i < BENCH_GLYPH_FRAMES; i++) {
+        for (uint32_t row = 0; row < BENCH_GLYPH_ROWS; row++) {
+            ST7735_WriteString(0, (uint16_t)(row * Font_11x18.height), digits, Font_11x18,
+                               ST7735_WHITE, ST7735_BLACK);
+        }
+    }
+    report("glyphs", path, &mark, BENCH_GLYPH_FRAMES,
+           BENCH_GLYPH_FRAMES * BENCH_GLYPH_ROWS * BENCH_GLYPH_COLS);
+}
+
+static void bench_image(uint32_t path)
+{
+    bench_mark_t mark;
+
+    if (ST7735_WIDTH < BENCH_IMAGE_SIZE || ST7735_HEIGHT < BENCH_IMAGE_SIZE) {
+        report("image", path, NULL, 0, 0);
+        return;
+    }
+
+    bench_begin(&mark);
+    for (uint32_t i = 0; i < BENCH_IMAGE_FRAMES; i++) {
+        ST7735_DrawImage(0, 0, BENCH_IMAGE_SIZE, BENCH_IMAGE_SIZE, image_pixels);
+    }
+    report("image", path, &mark, BENCH_IMAGE_FRAMES, 0);
+}
+
+// ============================================================================
+// Framebuffer and Widgets
+// ============================================================================
+
+static void bench_fb_text(uint32_t path)
+{
+    char text[12];
+    bench_mark_t mark;
+
+    display_fb_init(ST7735_BLACK);
+    display_fb_flush();
+
+    // A counting value: the last digit or two change per frame
+    bench_begin(&mark);
+    for (uint32_t i = 0; i < BENCH_FB_FRAMES; i++) {
+        snprintf(text, sizeof(text), "%lu.%02lu C", (unsigned long)(20U + i / 100U),
+                 (unsigned long)(i % 100U));
+        display_fb_write_string(10, 40, text, Font_11x18, ST7735_WHITE, ST7735_BLACK);
+        display_fb_flush();
+    }
+    report("fb_text", path, &mark, BENCH_FB_FRAMES, 0);
+}
+
+static void bench_fb_image(uint32_t path)
+{
+    bench_mark_t mark;
+
+    if (ST7735_WIDTH < BENCH_IMAGE_SIZE || ST7735_HEIGHT < BENCH_IMAGE_SIZE) {
+        report("fb_image", path, NULL, 0, 0);
+        return;
+    }
+
+    display_fb_init(ST7735_BLACK);
+    display_fb_flush();
+
+    bench_begin(&mark);
+    for (uint32_t i = 0; i < BENCH_FB_FRAMES; i++) {
+        if (i & 1) {
+            display_fb_fill_rect(0, 0, BENCH_IMAGE_SIZE, BENCH_IMAGE_SIZE, ST7735_BLACK);
+        } else {
+            display_fb_draw_image(0, 0, BENCH_IMAGE_SIZE, BENCH_IMAGE_SIZE,
+                                  image_pixels);
+        }
+        display_fb_flush();
+    }
+    report("fb_image", path, &mark, BENCH_FB_FRAMES, 0);
+}
+
+static void bench_widgets(uint32_t path)
+{
+    bench_mark_t mark;
+
+    // About what a status screen shows: three readings, a load bar, a trend
+    display_ui_init(ST7735_BLACK);
+    display_ui_id_t temp = display_ui_add_text(10, 10, "", Font_11x18, ST7735_WHITE, ST7735_BLACK);
+    display_ui_id_t humidity = display_ui_add_text(10, 34, "", Font_11x18, ST7735_CYAN, ST7735_BLACK);
+    display_ui_id_t current = display_ui_add_text(10, 58, "", Font_7x10, ST7735_YELLOW, ST7735_BLACK);
+    display_ui_id_t load = display_ui_add_bar(10, 76, 100, 6, 0, 100, ST7735_GREEN, ST7735_BLACK);
+    display_ui_id_t trend = display_ui_add_spark(10, 90, DISPLAY_UI_SPARK_POINTS, 30, 0, 100,
+                                                 ST7735_MAGENTA, ST7735_BLACK);
+    display_ui_render();
+
+    bench_begin(&mark);
+    for (uint32_t i = 0; i < BENCH_WIDGET_FRAMES; i++) {
+        int32_t wave = (int32_t)((i * 7U) % 100U);
+        display_ui_set_fixed(temp, 2000 + (int32_t)i, 2, " C");
+        display_ui_set_fixed(humidity, 4500 + (int32_t)(i / 4U), 2, " %");
+        display_ui_set_fixed(current, 125000 + (int32_t)(i * 37U), 3, " mA");
+        display_ui_set_bar(load, wave);
+        display_ui_push_spark(trend, wave);
+        display_ui_render();
+    }
+    report("widgets", path, &mark, BENCH_WIDGET_FRAMES, 0);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void display_benchmark_run(void)
+{
+    if (!display_wait_ready(BENCH_READY_TIMEOUT_MS)) {
+        LOG_W(TAG, "Display not ready, skipped");
+        return;
+    }
+
+    make_image();
+    LOG_I(TAG, "SCK %lu Hz, CPU %lu Hz", (unsigned long)ST7735_GetSpiClockHz(),
+          (unsigned long)hal_get_cpu_freq_hz());
+
+    for (uint32_t path = 0; path < 2; path++) {
+        if (!ST7735_SetDmaEnabled(path == 1)) {
+            LOG_W(TAG, "%s: n/a", path_names[path]);
+            continue;
+        }
+        bench_fill(path);
+        bench_glyphs(path);
+        bench_image(path);
+        bench_fb_text(path);
+        bench_fb_image(path);
+        bench_widgets(path);
+    }
+    ST7735_SetDmaEnabled(true);
+
+    // Reopen to rebuild the service's screen the cases drew over
+    ips_display_close();
+    ips_display_open();
+}
@@ -0,0 +1,26 @@
+/**
+ * @file display_benchmark.h
+ * @brief ST7735 display pipeline benchmark
+ */
+
+#ifndef DISPLAY_BENCHMARK_H
+#define DISPLAY_BENCHMARK_H
+
+/**
+ * @brief Time the display paths, polled SPI against DMA
+ *
+ * Runs full-screen fills, strings (per glyph), a 128x128 image blit, the
+ * framebuffer's text and image updates and a mixed widget screen
+ * (display_ui), each once with polled transfers and once with DMA, and
+ * logs frames/s, the SPI wire time as a share of the run, and wall and
+ * busy (non-idle) CPU cycles per frame. The busy numbers need
+ * configGENERATE_RUN_TIME_STATS; build once with ST7735_USE_DMA2D=0 or
+ * DISPLAY_UI_USE_FRAMEBUFFER=0 to compare those paths.
+ *
+ * @note Takes over the panel and redraws the service's screen when done;
+ *       call once from services_init() while the service tasks are held
+ *       back (a boot benchmark).
+ */
+void display_benchmark_run(void);
+
+#endif // DISPLAY_BENCHMARK_H
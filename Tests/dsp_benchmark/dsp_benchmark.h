@@ -0,0 +1,21 @@
+/**
+ * @file dsp_benchmark.h
+ * @brief dsp_kernels micro-benchmark
+ */
+
+#ifndef DSP_BENCHMARK_H
+#define DSP_BENCHMARK_H
+
+/**
+ * @brief Time the analysis kernels on one 4096-sample block
+ *
+ * Runs mean, RMS, max and the current analysis FIR over a synthetic
+ * current trace, checks the results against plain reference loops, and
+ * logs the DWT cycles per block of each kernel. Build once with
+ * DSP_KERNELS_USE_CMSIS_DSP=1 to compare against the library.
+ *
+ * @note Uses ~48KB of static buffers; call once from services_init().
+ */
+void dsp_benchmark_run(void);
+
+#endif // DSP_BENCHMARK_H
@@ -0,0 +1,291 @@
+/**
+ * @file event_bus_soak.c
+ * @brief Event bus soak test: sustained rate before overflow, per bus configuration
+ *
+ * Output (RTT):
+ *   EVBUS_SOAK: <config> @<rate>/s: pub=<n>/s delivered=<n> drop=<n> lat p50<<n> p99<<n> max=<n> us cpu=<n>%
+ *   EVBUS_SOAK: <config>: sustained <n> ev/s                 (highest step without a drop)
+ *
+ * A quarter of each step's rate comes from the ISR, the rest from the two
+ * publisher tasks in 1 ms bursts. Drops are queue_overflow_count plus
+ * isr_publish_fail_count over the step. Latency is the event's publish
+ * timestamp to the fast subscriber's callback; with coalescing it is that
+ * of the last merged publish.
+ */
+
+#include "event_bus_soak.h"
+#include "../../OS/event_bus.h"
+#include "../../OS/os_wrapper.h"
+#include "../../HAL/hal_delay.h"
+#include "../../HAL/hal_timer.h"
+#include "../../Drivers_BSP/Custom/portable_log.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+static const char *TAG = "EVBUS_SOAK";
+
+#define EVENT_SOAK_EVENT        EVENT_DISPLAY_READY     // Nothing else subscribes
+#define EVENT_SOAK_STEP_MS      1000
+#define EVENT_SOAK_DRAIN_MS     500
+
+// Subscriber cost per event, in CPU cycles
+#ifndef EVENT_SOAK_FAST_CYCLES
+#define EVENT_SOAK_FAST_CYCLES  500
+#endif
+#ifndef EVENT_SOAK_SLOW_CYCLES
+#define EVENT_SOAK_SLOW_CYCLES  5000
+#endif
+
+#define SOAK_PUBLISHERS         2
+#define SOAK_PUBLISHER_STACK    1024
+#define SOAK_PUBLISHER_PRIORITY OS_PRIORITY_HIGH    // Above the background shard
+#define SOAK_ISR_DIVISOR        4                   // ISR share of a step's rate: 1/4
+#define SOAK_ISR_MIN_PERIOD_US  10
+#define SOAK_HIST_BUCKETS       18                  // Last bucket: 131 ms and more
+
+typedef struct {
+    const char *name;
+    bool spread_lanes;          // Publishes cycle over the priority lanes
+    bool coalesce;
+    bool sharded;               // Slow subscriber on the background shard
+} soak_config_t;
+
+static const soak_config_t configs[] = {
+    { "fifo",     false, false, false },
+    { "lanes",    true,  false, false },
+    { "coalesce", false, true,  false },
+    { "sharded",  false, false, true  },
+};
+
+static const uint32_t rates[] = { 1000, 2000, 5000, 10000, 20000, 50000, 100000 };
+
+static volatile uint32_t task_rate = 0;     // Events/s per publisher task, 0 = paused
+static volatile bool spread_lanes = false;
+static volatile bool publishers_stop = false;
+static volatile uint32_t publishers_running = 0;
+
+static volatile uint32_t published = 0;     // Successful task and ISR publishes
+static volatile uint32_t fast_delivered = 0;
+static volatile uint32_t slow_delivered = 0;
+
+// Written by the fast subscriber only (one dispatch task)
+static uint32_t latency_hist[SOAK_HIST_BUCKETS];
+static uint32_t latency_max_us = 0;
+
+OS_TASK_DEFINE(soak_pub_0, SOAK_PUBLISHER_STACK);
+OS_TASK_DEFINE(soak_pub_1, SOAK_PUBLISHER_STACK);
+
+// ============================================================================
+// Subscribers and Publishers
+// ============================================================================
+
+static void spin(uint32_t cycles)
+{
+    uint32_t start = hal_get_cycle_count();
+    while (hal_get_cycle_count() - start < cycles) {
+    }
+}
+
+static uint32_t hist_bucket(uint32_t us)
+{
+    if (us < 2U) {
+        return 0;
+    }
+    uint32_t bucket = 31U - (uint32_t)__builtin_clz(us);
+    return (bucket < SOAK_HIST_BUCKETS) ? bucket : SOAK_HIST_BUCKETS - 1U;
+}
+
+static void fast_subscriber(event_t *event)
+{
+    uint32_t latency = event_bus_get_timestamp_us() - event->timestamp;
+    latency_hist[hist_bucket(latency)]++;
+    if (latency > latency_max_us) {
+        latency_max_us = latency;
+    }
+    spin(EVENT_SOAK_FAST_CYCLES);
+    fast_delivered++;
+}
+
+static void slow_subscriber(event_t *event)
+{
+    (void)event;
+    spin(EVENT_SOAK_SLOW_CYCLES);
+    slow_delivered++;
+}
+
+static void publisher_task(void *arg)
+{
+    uint32_t sequence = (uint32_t)(uintptr_t)arg << 24;
+    uint32_t credit = 0;        // Thousandths of an event
+    uint32_t last_wake = os_get_tick_count();
+
+    while (!publishers_stop) {
+        os_delay_until(&last_wake, 1);
+
+        uint32_t rate = task_rate;
+        if (rate == 0) {
+            credit = 0;
+            continue;
+        }
+        for (credit += rate; credit >= 1000U; credit -= 1000U) {
+            sequence++;
+            bool ok = spread_lanes
+                ? event_bus_publish_prio(EVENT_SOAK_EVENT,
+                                         (event_priority_t)(sequence % EVENT_PRIORITY_COUNT),
+                                         &sequence, sizeof(sequence))
+                : event_bus_publish(EVENT_SOAK_EVENT, &sequence, sizeof(sequence));
+            if (ok) {
+                __atomic_fetch_add(&published, 1, __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+    __atomic_fetch_sub(&publishers_running, 1, __ATOMIC_RELEASE);
+    os_task_delete(NULL);
+}
+
+static void isr_publisher(uint64_t timestamp_us, void *user_data)
+{
+    (void)user_data;
+    uint32_t value = (uint32_t)timestamp_us;
+    if (event_bus_publish_from_isr(EVENT_SOAK_EVENT, &value, sizeof(value))) {
+        __atomic_fetch_add(&published, 1, __ATOMIC_RELAXED);
+    }
+}
+
+// ============================================================================
+// Steps
+// ============================================================================
+
+// Upper bound of the bucket holding the given share; the last one is open
+static uint32_t percentile_us(uint32_t total, uint32_t permille)
+{
+    uint32_t target = (uint32_t)(((uint64_t)total * permille + 999U) / 1000U);
+    uint32_t seen = 0;
+    for (uint32_t i = 0; i < SOAK_HIST_BUCKETS - 1U; i++) {
+        seen += latency_hist[i];
+        if (seen >= target) {
+            return 1UL << (i + 1U);
+        }
+    }
+    return 1UL << (SOAK_HIST_BUCKETS - 1U);
+}
+
+/**
+ * @brief Publish at one rate for a step, then let the bus drain
+ * @return Events/s published if nothing was dropped, 0 otherwise
+ */
+static uint32_t run_step(const soak_config_t *config, uint32_t rate)
+{
+    published = 0;
+    fast_delivered = 0;
+    slow_delivered = 0;
+    latency_max_us = 0;
+    for (uint32_t i = 0; i < SOAK_HIST_BUCKETS; i++) {
+        latency_hist[i] = 0;
+    }
+
+    event_bus_stats_t before = event_bus_get_stats();
+    uint32_t isr_period_us = (uint32_t)((uint64_t)SOAK_ISR_DIVISOR * 1000000U / rate);
+    if (isr_period_us < SOAK_ISR_MIN_PERIOD_US) {
+        isr_period_us = SOAK_ISR_MIN_PERIOD_US;
+    }
+
+    uint32_t start_idle_us = os_get_idle_time_us();
+    uint32_t start_us = hal_timer_get_us();
+    task_rate = rate * (SOAK_ISR_DIVISOR - 1U) / (SOAK_ISR_DIVISOR * SOAK_PUBLISHERS);
+    bool isr_running = hal_timer_start_periodic(isr_period_us, isr_publisher, NULL);
+    os_delay_ms(EVENT_SOAK_STEP_MS);
+    task_rate = 0;
+    if (isr_running) {
+        hal_timer_stop_periodic();
+    }
+    uint32_t elapsed_us = hal_timer_get_us() - start_us;
+    uint32_t idle_us = os_get_idle_time_us() - start_idle_us;
+    uint32_t sent = published;
+
+    for (uint32_t waited = 0; waited < EVENT_SOAK_DRAIN_MS && event_bus_get_queue_depth() > 0;
+         waited++) {
+        os_delay_ms(1);
+    }
+    os_delay_ms(1);     // Last dispatch pass, ISR ring included
+
+    event_bus_stats_t after = event_bus_get_stats();
+    uint32_t drops = (after.queue_overflow_count - before.queue_overflow_count) +
+                     (after.isr_publish_fail_count - before.isr_publish_fail_count);
+    uint32_t sent_per_s = (uint32_t)((uint64_t)sent * 1000000U / elapsed_us);
+    uint32_t busy_us = (idle_us < elapsed_us) ? elapsed_us - idle_us : 0;
+    uint32_t delivered = fast_delivered;
+
+    LOG_I(TAG, "%s @%lu/s: pub=%lu/s delivered=%lu drop=%lu lat p50<%lu p99<%lu max=%lu us cpu=%lu%%%s",
+          config->name, (unsigned long)rate, (unsigned long)sent_per_s, (unsigned long)delivered,
+          (unsigned long)drops,
+          (unsigned long)(delivered > 0 ? percentile_us(delivered, 500) : 0),
+          (unsigned long)(delivered > 0 ? percentile_us(delivered, 990) : 0),
+          (unsigned long)latency_max_us, (unsigned long)((uint64_t)busy_us * 100U / elapsed_us),
+          isr_running ? "" : " (no ISR publisher)");
+
+    return (drops == 0) ? sent_per_s : 0;
+}
+
+static void run_config(const soak_config_t *config)
+{
+    uint32_t sustained = 0;
+
+    event_bus_subscribe(EVENT_SOAK_EVENT, fast_subscriber);
+    event_bus_subscribe_on_shard(EVENT_SOAK_EVENT, slow_subscriber,
+                                 config->sharded ? EVENT_SHARD_BACKGROUND : EVENT_SHARD_DEFAULT);
+    event_bus_set_coalesce(EVENT_SOAK_EVENT, config->coalesce);
+    spread_lanes = config->spread_lanes;
+
+    for (uint32_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        uint32_t sent_per_s = run_step(config, rates[i]);
+        if (sent_per_s == 0) {
+            break;
+        }
+        sustained = sent_per_s;
+    }
+
+    event_bus_set_coalesce(EVENT_SOAK_EVENT, false);
+    event_bus_unsubscribe(EVENT_SOAK_EVENT, slow_subscriber);
+    event_bus_unsubscribe(EVENT_SOAK_EVENT, fast_subscriber);
+
+    LOG_I(TAG, "%s: sustained %lu ev/s", config->name, (unsigned long)sustained);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void event_bus_soak_run(void)
+{
+    if (!event_bus_is_dispatch_task_running()) {
+        LOG_W(TAG, "Needs the dispatch tasks, skipped");
+        return;
+    }
+
+    LOG_I(TAG, "fast subscriber %lu cycles, slow %lu cycles, %lu ms steps",
+          (unsigned long)EVENT_SOAK_FAST_CYCLES, (unsigned long)EVENT_SOAK_SLOW_CYCLES,
+          (unsigned long)EVENT_SOAK_STEP_MS);
+
+    publishers_stop = false;
+    publishers_running = SOAK_PUBLISHERS;
+    if (OS_TASK_CREATE_STATIC(soak_pub_0, publisher_task, "soak_pub0", (void *)0,
+                              SOAK_PUBLISHER_PRIORITY, NULL) != OS_SUCCESS ||
+        OS_TASK_CREATE_STATIC(soak_pub_1, publisher_task, "soak_pub1", (void *)1,
+                              SOAK_PUBLISHER_PRIORITY, NULL) != OS_SUCCESS) {
+        LOG_E(TAG, "Failed to create publisher tasks");
+        // A task that did start stops at once and deletes itself
+        publishers_stop = true;
+        return;
+    }
+
+    for (uint32_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        run_config(&configs[c]);
+    }
+
+    publishers_stop = true;
+    while (__atomic_load_n(&publishers_running, __ATOMIC_ACQUIRE) > 0) {
+        os_delay_ms(1);
+    }
+}
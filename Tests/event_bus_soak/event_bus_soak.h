@@ -0,0 +1,31 @@
+/**
+ * @file event_bus_soak.h
+ * @brief Event bus soak test: sustained rate before overflow, per bus configuration
+ */
+
+#ifndef EVENT_BUS_SOAK_H
+#define EVENT_BUS_SOAK_H
+
+/**
+ * @brief Drive the event bus at escalating rates until it drops events
+ *
+ * Two publisher tasks and the hal_timer compare interrupt publish one
+ * event type while a fast subscriber (EVENT_SOAK_FAST_CYCLES per event)
+ * and a slow one (EVENT_SOAK_SLOW_CYCLES) run. Each rate step lasts
+ * EVENT_SOAK_STEP_MS; the first step that overflows a lane or the ISR
+ * ring ends the configuration. Configurations: plain FIFO, publishes
+ * spread over the priority lanes, coalescing, and the slow subscriber on
+ * the background shard.
+ *
+ * Logs per step the publish rate, drops, the fast subscriber's publish ->
+ * callback latency (p50/p99 bounds and max) and the CPU share, then the
+ * highest rate each configuration sustained.
+ *
+ * @note Borrows the hal_timer compare (no current measurement may run)
+ *       and takes ~EVENT_SOAK_STEP_MS x 7 per configuration; call once
+ *       from services_init() while the service tasks are held back (a
+ *       boot benchmark).
+ */
+void event_bus_soak_run(void);
+
+#endif // EVENT_BUS_SOAK_H
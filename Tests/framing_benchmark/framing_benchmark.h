@@ -0,0 +1,18 @@
+/**
+ * @file framing_benchmark.h
+ * @brief Marker vs COBS framing goodput under bit errors
+ */
+
+#ifndef FRAMING_BENCHMARK_H
+#define FRAMING_BENCHMARK_H
+
+/**
+ * @brief Compare goodput of both wire modes at several bit error rates
+ *
+ * Initializes the packet framing layer with its own callback, feeds encoded
+ * frames with injected bit flips through the RX parser, and deinitializes it
+ * again. Must run before protocol_handler_init().
+ */
+void framing_benchmark_run(void);
+
+#endif // FRAMING_BENCHMARK_H
@@ -0,0 +1,410 @@
+/**
+ * @file download_bench.c
+ * @brief End-to-end download benchmark: protocol_client against the protocol handler
+ *
+ * The STM32 side's UART writes are deframed in the writing task (markers
+ * or COBS, as the client last agreed) and queued; the client's receive()
+ * takes them off the queue. A full queue holds the writer back, as a busy
+ * wire would. Lossy cases drop every DOWNLOAD_DROP_EVERY-th STM32 packet
+ * after the HELLO, like a frame failing its CRC.
+ */
+
+#include "download_bench.h"
+#include "host_port.h"
+#include "protocol_client.h"
+#include "protocol_handler.h"
+#include "esp32_packet_framing.h"
+#include "event_bus.h"
+#include "os_wrapper.h"
+#include "hal_timebase.h"
+#include "cobs.h"
+#include "portable_log.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "DOWNLOAD";
+
+#define DOWNLOAD_SAMPLES        HOST_TEMP_BUFFER_SIZE
+#define DOWNLOAD_TIMEOUT_MS     50      // Client wait before recovering (the host wire is instant)
+#define DOWNLOAD_DROP_EVERY     16
+#define DOWNLOAD_RESUME_AT      (DOWNLOAD_SAMPLES * 3U / 4U)    // Resume case: index of from_timestamp
+#define LINK_QUEUE_DEPTH        32      // STM32 packets buffered for the client
+#define LINK_QUEUE_WAIT_MS      1000    // Writer held back by a full queue, at most
+#define WIRE_BAUD               921600U
+#define WIRE_BITS_PER_BYTE      10U
+
+typedef enum {
+    METHOD_READ,
+    METHOD_BULK,
+    METHOD_RESUME,
+} download_method_t;
+
+typedef struct {
+    const char *name;
+    uint32_t features;          // Asked for at HELLO
+    uint8_t window;             // 0 = as agreed
+    download_method_t method;
+    bool lossy;
+} download_case_t;
+
+static const download_case_t cases[] = {
+    { "read/markers/w1", 0,                                               1, METHOD_READ,   false },
+    { "read/plain/w4",   PROTOCOL_FEATURE_COBS | PROTOCOL_FEATURE_WINDOW, 0, METHOD_READ,   false },
+    { "read/compact/w4", PROTOCOL_CLIENT_FEATURES,                        0, METHOD_READ,   false },
+    { "bulk/plain",      PROTOCOL_FEATURE_COBS | PROTOCOL_FEATURE_CREDITS | PROTOCOL_FEATURE_BULK,
+                                                                          0, METHOD_BULK,   false },
+    { "bulk/compact",    PROTOCOL_CLIENT_FEATURES,                        0, METHOD_BULK,   false },
+    { "resume/compact",  PROTOCOL_CLIENT_FEATURES,                        0, METHOD_RESUME, false },
+    { "read/lossy",      PROTOCOL_CLIENT_FEATURES,                        0, METHOD_READ,   true  },
+    { "bulk/lossy",      PROTOCOL_CLIENT_FEATURES,                        0, METHOD_BULK,   true  },
+};
+
+typedef struct {
+    uint16_t length;
+    uint8_t data[PROTOCOL_HEADER_SIZE + PROTOCOL_BULK_MAX_PAYLOAD_SIZE];
+} link_packet_t;
+
+// STM32 -> client: deframing state, touched by the writing task only
+static struct {
+    volatile bool cobs;
+    cobs_decoder_t cobs_decoder;
+    uint8_t frame[STM32_UART_MAX_PACKET_SIZE];
+    size_t have;                // Marker framing: bytes of the current frame
+    size_t need;                // ... its full size, 0 = length not read yet
+    link_packet_t item;
+    volatile uint32_t drop_every;
+    uint32_t counter;
+    volatile uint32_t wire_bytes;
+    volatile uint32_t dropped;
+    volatile uint32_t bad_frames;
+    volatile uint32_t overflows;
+} sink;
+
+// Client -> STM32
+static os_queue_handle_t rx_queue = NULL;
+static uint8_t tx_wire[COBS_MAX_ENCODED_SIZE(STM32_UART_MAX_PACKET_SIZE)];
+static link_packet_t rx_item;
+static uint32_t tx_wire_bytes = 0;
+
+static protocol_client_t client;
+
+static sensor_sample_t expected[DOWNLOAD_SAMPLES];
+static sensor_sample_t received[DOWNLOAD_SAMPLES];
+static bool seen[DOWNLOAD_SAMPLES];
+static uint32_t duplicates = 0;
+static uint32_t out_of_range = 0;
+
+// ============================================================================
+// Loopback Link
+// ============================================================================
+
+static void sink_packet(const uint8_t *data, size_t length, uint16_t crc)
+{
+    if (stm32_uart_crc16(data, length) != crc ||
+        length > sizeof(sink.item.data) || length < PROTOCOL_HEADER_SIZE) {
+        sink.bad_frames++;
+        return;
+    }
+    if (sink.drop_every != 0 && ++sink.counter % sink.drop_every == 0) {
+        sink.dropped++;
+        return;
+    }
+
+    sink.item.length = (uint16_t)length;
+    memcpy(sink.item.data, data, length);
+    if (os_queue_send(rx_queue, &sink.item, LINK_QUEUE_WAIT_MS) != OS_SUCCESS) {
+        sink.overflows++;
+    }
+}
+
+static void sink_cobs(const uint8_t *data, size_t length)
+{
+    while (length > 0) {
+        size_t consumed = 0;
+        cobs_decode_result_t result = cobs_decoder_feed(&sink.cobs_decoder, data, length, &consumed);
+        data += consumed;
+        length -= consumed;
+
+        if (result == COBS_DECODE_FRAME) {
+            size_t frame_len = sink.cobs_decoder.length;
+            if (frame_len > 2) {
+                sink_packet(sink.frame, frame_len - 2,
+                            (uint16_t)((sink.frame[frame_len - 2] << 8) | sink.frame[frame_len - 1]));
+            } else {
+                sink.bad_frames++;
+            }
+            cobs_decoder_reset(&sink.cobs_decoder);
+        } else if (result == COBS_DECODE_ERROR) {
+            sink.bad_frames++;
+            cobs_decoder_reset(&sink.cobs_decoder);
+        } else if (result == COBS_DECODE_EMPTY) {
+            cobs_decoder_reset(&sink.cobs_decoder);
+        }
+    }
+}
+
+static void sink_markers(const uint8_t *data, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        uint8_t byte = data[i];
+        if (sink.have == 0 && byte != STM32_PACKET_START_MARKER) {
+            continue;
+        }
+        sink.frame[sink.have++] = byte;
+
+        // START + LENGTH(2) + DATA + CRC(2) + END
+        if (sink.have == 3) {
+            size_t data_len = (size_t)sink.frame[1] | ((size_t)sink.frame[2] << 8);
+            sink.need = data_len + 6;
+            if (sink.need > sizeof(sink.frame)) {
+                sink.bad_frames++;
+                sink.have = 0;
+            }
+            continue;
+        }
+        if (sink.have < 3 || sink.have < sink.need) {
+            continue;
+        }
+
+        size_t data_len = sink.need - 6;
+        if (sink.frame[sink.need - 1] == STM32_PACKET_END_MARKER) {
+            sink_packet(&sink.frame[3], data_len,
+                        (uint16_t)(sink.frame[3 + data_len] | (sink.frame[4 + data_len] << 8)));
+        } else {
+            sink.bad_frames++;
+        }
+        sink.have = 0;
+    }
+}
+
+static void sink_write(const uint8_t *data, size_t length, void *user_data)
+{
+    (void)user_data;
+    sink.wire_bytes += (uint32_t)length;
+
+    if (sink.cobs) {
+        sink_cobs(data, length);
+    } else {
+        sink_markers(data, length);
+    }
+}
+
+static bool link_send(void *ctx, const uint8_t *packet, size_t length)
+{
+    (void)ctx;
+
+    // Framed as the STM32 expects it now
+    size_t wire_len = stm32_uart_encode_frame(packet, length, tx_wire, sizeof(tx_wire));
+    if (wire_len == 0) {
+        return false;
+    }
+    tx_wire_bytes += (uint32_t)wire_len;
+    stm32_uart_inject_rx(tx_wire, wire_len);
+    return true;
+}
+
+static size_t link_receive(void *ctx, uint8_t *packet, size_t size, uint32_t timeout_ms)
+{
+    (void)ctx;
+
+    if (os_queue_receive(rx_queue, &rx_item, timeout_ms) != OS_SUCCESS || rx_item.length > size) {
+        return 0;
+    }
+    memcpy(packet, rx_item.data, rx_item.length);
+    return rx_item.length;
+}
+
+static void link_set_cobs(void *ctx, bool cobs)
+{
+    (void)ctx;
+    sink.cobs = cobs;
+    sink.have = 0;
+    cobs_decoder_reset(&sink.cobs_decoder);
+}
+
+static const protocol_client_link_t loopback = {
+    .send = link_send,
+    .receive = link_receive,
+    .set_cobs = link_set_cobs,
+    .ctx = NULL,
+};
+
+// ============================================================================
+// Cases
+// ============================================================================
+
+static void collect_samples(const sensor_sample_t *samples, uint32_t count, uint32_t first_index,
+                            void *user_data)
+{
+    (void)user_data;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t index = first_index + i;
+        if (index >= DOWNLOAD_SAMPLES) {
+            out_of_range++;
+            continue;
+        }
+        if (seen[index]) {
+            duplicates++;
+        }
+        seen[index] = true;
+        received[index] = samples[i];
+    }
+}
+
+/**
+ * @brief Check the samples from first_index on against the ring's content
+ */
+static bool verify(uint32_t first_index, uint32_t *missing, uint32_t *wrong)
+{
+    *missing = 0;
+    *wrong = 0;
+    for (uint32_t i = 0; i < DOWNLOAD_SAMPLES; i++) {
+        if (i < first_index) {
+            *wrong += seen[i] ? 1U : 0U;
+        } else if (!seen[i]) {
+            (*missing)++;
+        } else if (memcmp(&received[i], &expected[i], sizeof(sensor_sample_t)) != 0) {
+            (*wrong)++;
+        }
+    }
+    return *missing == 0 && *wrong == 0 && duplicates == 0 && out_of_range == 0;
+}
+
+static bool run_case(const download_case_t *test)
+{
+    memset(seen, 0, sizeof(seen));
+    duplicates = 0;
+    out_of_range = 0;
+
+    protocol_client_config_t config = protocol_client_get_default_config();
+    config.timeout_ms = DOWNLOAD_TIMEOUT_MS;
+    config.window = test->window;
+    protocol_client_init(&client, &loopback, &config);
+
+    // Drowns the handler's per-dump lines; failures still show
+    log_set_level(NULL, LOG_LVL_WARN);
+    proto_client_status_t status = protocol_client_hello(&client, test->features);
+    if (status != PROTO_CLIENT_OK) {
+        log_set_level(NULL, LOG_LVL_INFO);
+        LOG_E(TAG, "%s: HELLO failed (%d)", test->name, status);
+        return false;
+    }
+
+    protocol_client_reset_stats(&client);
+    sink.wire_bytes = 0;
+    sink.dropped = 0;
+    sink.counter = 0;
+    tx_wire_bytes = 0;
+    sink.drop_every = test->lossy ? DOWNLOAD_DROP_EVERY : 0;
+
+    uint32_t first_index = 0;
+    uint64_t start_us = hal_timebase_now_us();
+    switch (test->method) {
+        case METHOD_READ:
+            status = protocol_client_read_buffer(&client, 0, 0, collect_samples, NULL);
+            break;
+        case METHOD_BULK:
+            status = protocol_client_bulk_dump(&client, SENSOR_TEMPERATURE, 0, 0,
+                                               collect_samples, NULL);
+            break;
+        case METHOD_RESUME:
+            first_index = DOWNLOAD_RESUME_AT;
+            status = protocol_client_resume(&client, expected[first_index].timestamp,
+                                            collect_samples, NULL);
+            break;
+    }
+    uint64_t elapsed_us = hal_timebase_now_us() - start_us;
+    sink.drop_every = 0;
+    log_set_level(NULL, LOG_LVL_INFO);
+
+    // Late duplicates must not reach the next case
+    while (os_queue_receive(rx_queue, &rx_item, 0) == OS_SUCCESS) {
+    }
+    event_bus_process();
+
+    protocol_client_stats_t stats;
+    protocol_client_get_stats(&client, &stats);
+    uint32_t missing = 0;
+    uint32_t wrong = 0;
+    bool ok = (status == PROTO_CLIENT_OK) && verify(first_index, &missing, &wrong);
+    uint32_t down = sink.wire_bytes;
+    uint32_t wire_ms = (uint32_t)((uint64_t)((down > tx_wire_bytes) ? down : tx_wire_bytes) *
+                                  WIRE_BITS_PER_BYTE * 1000U / WIRE_BAUD);
+    if (elapsed_us == 0) {
+        elapsed_us = 1;
+    }
+
+    char result[96];
+    if (ok) {
+        snprintf(result, sizeof(result), "ok");
+    } else {
+        snprintf(result, sizeof(result), "FAILED status=%d missing=%lu wrong=%lu dup=%lu",
+                 status, (unsigned long)missing, (unsigned long)wrong, (unsigned long)duplicates);
+    }
+
+    LOG_I(TAG, "%s: %lu samples in %lu ms, %lu samples/s, %lu req, %lu retx, %lu resend, "
+          "%lu packets (%lu dropped), wire %lu B down %lu B up (%lu ms at %lu), %s",
+          test->name, (unsigned long)stats.samples, (unsigned long)(elapsed_us / 1000U),
+          (unsigned long)((uint64_t)stats.samples * 1000000U / elapsed_us),
+          (unsigned long)stats.requests, (unsigned long)stats.retransmits,
+          (unsigned long)stats.resends, (unsigned long)stats.packets,
+          (unsigned long)sink.dropped, (unsigned long)down, (unsigned long)tx_wire_bytes,
+          (unsigned long)wire_ms, (unsigned long)WIRE_BAUD, result);
+    return ok;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+int download_bench_run(void)
+{
+    rx_queue = os_queue_create(LINK_QUEUE_DEPTH, sizeof(link_packet_t));
+    if (rx_queue == NULL) {
+        LOG_E(TAG, "Failed to create the link queue");
+        return 1;
+    }
+    cobs_decoder_init(&sink.cobs_decoder, sink.frame, sizeof(sink.frame));
+    sink.cobs = false;
+    sink.have = 0;
+
+    event_bus_init();
+    if (protocol_handler_init(&protocol_transport_uart) != PROTO_HANDLER_OK) {
+        LOG_E(TAG, "protocol_handler_init failed");
+        os_queue_delete(rx_queue);
+        return 1;
+    }
+    host_uart_set_tx_sink(sink_write, NULL);
+
+    // A slow random walk, as room temperature is; the ring ends up holding only these
+    int32_t value = 2150;
+    uint32_t lcg = 1;
+    for (uint32_t i = 0; i < DOWNLOAD_SAMPLES; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        value += (int32_t)((lcg >> 24) % 7U) - 3;
+        expected[i] = (sensor_sample_t){
+            .sensor_type = SENSOR_TEMPERATURE,
+            .timestamp = 1000U + i * 10U,
+            .value = value,
+        };
+        host_temperature_push(expected[i].timestamp, value);
+    }
+
+    uint32_t failed = 0;
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        if (!run_case(&cases[i])) {
+            failed++;
+        }
+    }
+
+    host_uart_set_tx_sink(NULL, NULL);
+    protocol_handler_deinit();
+    os_queue_delete(rx_queue);
+    rx_queue = NULL;
+
+    if (sink.bad_frames > 0 || sink.overflows > 0) {
+        LOG_W(TAG, "link: %lu bad frames, %lu queue overflows",
+              (unsigned long)sink.bad_frames, (unsigned long)sink.overflows);
+    }
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file download_bench.h
+ * @brief End-to-end download benchmark: protocol_client against the protocol handler
+ *
+ * The reference client (Middleware/Client) plays the ESP32 on a loopback
+ * link: its packets are framed and injected with stm32_uart_inject_rx(),
+ * and the STM32's UART writes are deframed and CRC-checked from the
+ * host_uart_set_tx_sink() hook. Each case downloads the whole temperature
+ * ring and checks every sample against what was pushed.
+ *
+ * Output:
+ *   DOWNLOAD: <case>: <n> samples in <n> ms, <n> samples/s, <n> req, <n> retx, <n> resend,
+ *             <n> packets (<n> dropped), wire <n> B down <n> B up (<n> ms at 921600), ok | FAILED ...
+ *
+ * The host wire is infinitely fast, so samples/s is the CPU cost of both
+ * ends; the wire figure is what bounds a real link, before the round trip
+ * per request that stop-and-wait adds and a window hides.
+ */
+
+#ifndef DOWNLOAD_BENCH_H
+#define DOWNLOAD_BENCH_H
+
+/**
+ * @brief Run every download case
+ * @return Process exit code: 0, or 1 if a case failed
+ */
+int download_bench_run(void);
+
+#endif // DOWNLOAD_BENCH_H
@@ -0,0 +1,451 @@
+/**
+ * @file event_replay.c
+ * @brief Replay of recorded event bus publishes (OS/event_trace.h), host build
+ */
+
+#include "event_replay.h"
+#include "framing_replay.h"
+#include "event_trace.h"
+#include "event_bus.h"
+#include "event_pool.h"
+#include "service_events.h"
+#include "portable_log.h"
+#include "hal_delay.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+static const char *TAG = "TRACE";
+
+#define REPLAY_MAX_RECORDS          EVENT_TRACE_DEPTH
+#define REPLAY_MIN_RECORD_BYTES     offsetof(event_trace_record_t, payload)
+
+// Synthetic session
+#define SESSION_ROUNDS              40
+#define SESSION_BURST_EVERY         4       // Rounds between lane-overflowing bursts
+#define SESSION_BURST               40      // Normal lane holds 32
+#define SESSION_SIDE_EVERY          5       // Rounds between pooled/batch publishes
+#define SESSION_TIMER_MS            7
+#define SESSION_POOLED_SIZE         40      // Longer than the kept payload
+#define SESSION_BATCH_RECORDS       4
+
+typedef struct {
+    uint32_t published;
+    uint32_t delivered;
+    uint32_t rejected_recorded;
+    uint32_t rejected_replayed;
+} type_stats_t;
+
+typedef struct {
+    uint32_t rounds;
+    uint64_t dispatch_cycles;
+    uint32_t rejected_recorded;
+    uint32_t rejected_replayed;
+    uint32_t mismatches;           // Type, path, size or payload hash differs
+    uint32_t truncated;
+    uint32_t elided;               // Recorded without subscribers, not published
+} replay_result_t;
+
+typedef struct {
+    const uint8_t *cursor;
+    const uint8_t *end;
+} capture_t;
+
+typedef struct {
+    uint8_t *buffer;
+    uint32_t size;
+    uint32_t capacity;
+} export_sink_t;
+
+static uint8_t input_buffer[EVENT_REPLAY_MAX_INPUT];
+static event_trace_record_t records[REPLAY_MAX_RECORDS];
+static uint8_t outcome[2][REPLAY_MAX_RECORDS];      // Replayed flags, per replay
+static type_stats_t type_stats[EVENT_USER_DEFINED_START];
+static uint8_t payload[EVENT_POOL_BLOCK_SIZE];
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+static void tap(event_t *event)
+{
+    if ((uint32_t)event->type < EVENT_USER_DEFINED_START) {
+        type_stats[event->type].delivered++;
+    }
+}
+
+// Refused before reaching the bus: recorded here, so the replay's trace stays aligned
+static bool refuse(const event_trace_record_t *record, event_priority_t priority)
+{
+    uint8_t source = (record->source == EVENT_TRACE_SRC_TIMER) ? EVENT_TRACE_SRC_TASK : record->source;
+    event_trace_record((event_type_t)record->type, (event_trace_source_t)source, priority,
+                       NULL, record->data_size, record->record_size, EVENT_TRACE_REJECTED);
+    return false;
+}
+
+// Nobody subscribed on the target: publishing here would queue what it dropped
+static bool elide(const event_trace_record_t *record, event_priority_t priority, const void *data)
+{
+    uint8_t source = (record->source == EVENT_TRACE_SRC_TIMER) ? EVENT_TRACE_SRC_TASK : record->source;
+    event_trace_record((event_type_t)record->type, (event_trace_source_t)source, priority,
+                       data, record->data_size, record->record_size, EVENT_TRACE_ELIDED);
+    return true;
+}
+
+static bool publish(const event_trace_record_t *record)
+{
+    event_type_t type = (event_type_t)record->type;
+    event_priority_t priority = (event_priority_t)(record->flags & EVENT_TRACE_FLAG_PRIO_MASK);
+    uint32_t size = record->data_size;
+
+    if (size > sizeof(payload)) {
+        return refuse(record, priority);
+    }
+    memset(payload, 0, size);
+    memcpy(payload, record->payload, (size < EVENT_TRACE_PAYLOAD_MAX) ? size : EVENT_TRACE_PAYLOAD_MAX);
+    void *data = (size > 0) ? payload : NULL;
+
+    if (record->flags & EVENT_TRACE_FLAG_ELIDED) {
+        return elide(record, priority, data);
+    }
+
+    switch (record->source) {
+        case EVENT_TRACE_SRC_POOLED: {
+            void *block = event_pool_alloc(size);
+            if (block == NULL) {
+                return refuse(record, priority);
+            }
+            memcpy(block, payload, size);
+            if (!event_bus_publish_pooled(type, block, size)) {
+                event_pool_release(block);
+                return false;
+            }
+            return true;
+        }
+        case EVENT_TRACE_SRC_BATCH:
+            if (record->record_size == 0) {
+                return refuse(record, priority);
+            }
+            return event_bus_publish_batch(type, payload, record->record_size,
+                                           (uint16_t)(size / record->record_size));
+        case EVENT_TRACE_SRC_ISR:
+            return event_bus_publish_from_isr(type, data, size);
+        default:
+            // Timer fires are replayed as the publishes they turned into
+            return event_bus_publish_prio(type, priority, data, size);
+    }
+}
+
+static void dispatch(replay_result_t *result)
+{
+    uint32_t start = hal_get_cycle_count();
+    event_bus_process();
+    result->dispatch_cycles += hal_get_cycle_count() - start;
+    result->rounds++;
+}
+
+// The replay's own record of a publish against the captured one
+static bool same_publish(const event_trace_record_t *captured, const event_trace_record_t *replayed)
+{
+    uint8_t source = (captured->source == EVENT_TRACE_SRC_TIMER) ? EVENT_TRACE_SRC_TASK : captured->source;
+    if (replayed->type != captured->type || replayed->source != source ||
+        replayed->data_size != captured->data_size || replayed->record_size != captured->record_size) {
+        return false;
+    }
+    return (captured->flags & EVENT_TRACE_FLAG_TRUNCATED) ||
+           replayed->payload_hash == captured->payload_hash;
+}
+
+/**
+ * @brief Replay one trace from a fresh bus and protocol handler
+ * @param flags Output: replayed record flags, for comparing replays
+ */
+static bool replay_once(uint32_t count, uint32_t gap_us, replay_result_t *result, uint8_t *flags)
+{
+    memset(result, 0, sizeof(*result));
+    memset(type_stats, 0, sizeof(type_stats));
+
+    // The handler's per-command lines would drown the report
+    log_set_level(NULL, LOG_LVL_WARN);
+    if (!framing_replay_setup()) {
+        log_set_level(NULL, LOG_LVL_INFO);
+        LOG_E(TAG, "bus/protocol handler setup failed");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t type = records[i].type;
+        if (type < EVENT_USER_DEFINED_START && type_stats[type].published++ == 0) {
+            event_bus_subscribe((event_type_t)type, tap);
+        }
+    }
+    memset(type_stats, 0, sizeof(type_stats));
+
+    event_trace_start();
+    for (uint32_t i = 0; i < count; i++) {
+        const event_trace_record_t *record = &records[i];
+        if (i > 0 && record->timestamp_us - records[i - 1U].timestamp_us >= gap_us) {
+            dispatch(result);
+        }
+
+        bool accepted = publish(record);
+        bool was_rejected = (record->flags & EVENT_TRACE_FLAG_REJECTED) != 0;
+        result->rejected_recorded += was_rejected ? 1U : 0U;
+        result->rejected_replayed += accepted ? 0U : 1U;
+        result->truncated += (record->flags & EVENT_TRACE_FLAG_TRUNCATED) ? 1U : 0U;
+        result->elided += (record->flags & EVENT_TRACE_FLAG_ELIDED) ? 1U : 0U;
+
+        if (record->type < EVENT_USER_DEFINED_START) {
+            type_stats_t *stats = &type_stats[record->type];
+            stats->published++;
+            stats->rejected_recorded += was_rejected ? 1U : 0U;
+            stats->rejected_replayed += accepted ? 0U : 1U;
+        }
+    }
+    dispatch(result);
+    event_trace_stop();
+
+    event_trace_record_t replayed;
+    uint32_t recorded = event_trace_count();
+    for (uint32_t i = 0; i < count; i++) {
+        if (i >= recorded || !event_trace_get(i, &replayed) || !same_publish(&records[i], &replayed)) {
+            result->mismatches++;
+            flags[i] = 0xFF;
+            continue;
+        }
+        flags[i] = replayed.flags;
+    }
+
+    framing_replay_teardown();
+    log_set_level(NULL, LOG_LVL_INFO);
+    return true;
+}
+
+static void report(const char *name, const event_trace_header_t *header, const replay_result_t *result)
+{
+    uint32_t count = header->count;
+    uint32_t span_us = (count > 0) ? records[count - 1U].timestamp_us - records[0].timestamp_us : 0;
+
+    LOG_I(TAG, "%s: %lu records over %lu ms (%lu lost before), %lu rounds, dispatch %llu ns "
+          "(%llu ns/event), rejected %lu recorded / %lu replayed, %lu mismatches, %lu truncated, %lu elided",
+          name, (unsigned long)count, (unsigned long)(span_us / 1000U), (unsigned long)header->lost,
+          (unsigned long)result->rounds, (unsigned long long)result->dispatch_cycles,
+          (unsigned long long)((count > 0) ? result->dispatch_cycles / count : 0),
+          (unsigned long)result->rejected_recorded, (unsigned long)result->rejected_replayed,
+          (unsigned long)result->mismatches, (unsigned long)result->truncated,
+          (unsigned long)result->elided);
+
+    for (uint32_t type = 0; type < EVENT_USER_DEFINED_START; type++) {
+        const type_stats_t *stats = &type_stats[type];
+        if (stats->published == 0) {
+            continue;
+        }
+
+        event_bus_latency_t latency;
+        uint32_t slowest = event_bus_get_latency((event_type_t)type, &latency)
+                               ? latency.callback_max_cycles : 0;
+        LOG_I(TAG, "  type %lu: %lu published, %lu delivered, rejected %lu/%lu, slowest callback %lu ns",
+              (unsigned long)type, (unsigned long)stats->published, (unsigned long)stats->delivered,
+              (unsigned long)stats->rejected_recorded, (unsigned long)stats->rejected_replayed,
+              (unsigned long)slowest);
+    }
+}
+
+// ============================================================================
+// Capture Parsing
+// ============================================================================
+
+/**
+ * @brief Next trace of a capture into records[]
+ *
+ * Skips bytes up to the next header, so a capture that starts mid-trace
+ * or holds several traces back to back still parses.
+ */
+static bool next_trace(capture_t *capture, event_trace_header_t *header)
+{
+    while ((size_t)(capture->end - capture->cursor) >= sizeof(*header)) {
+        memcpy(header, capture->cursor, sizeof(*header));
+        if (header->magic != EVENT_TRACE_MAGIC || header->version != EVENT_TRACE_VERSION ||
+            header->record_bytes < REPLAY_MIN_RECORD_BYTES) {
+            capture->cursor++;
+            continue;
+        }
+
+        capture->cursor += sizeof(*header);
+        size_t available = (size_t)(capture->end - capture->cursor) / header->record_bytes;
+        if (header->count > available) {
+            LOG_W(TAG, "trace cut short: %lu of %lu records", (unsigned long)available,
+                  (unsigned long)header->count);
+            header->count = (uint32_t)available;
+        }
+        if (header->count > REPLAY_MAX_RECORDS) {
+            LOG_W(TAG, "replaying the first %d of %lu records", REPLAY_MAX_RECORDS,
+                  (unsigned long)header->count);
+        }
+
+        // A writer with a different EVENT_TRACE_PAYLOAD_MAX: copy what both have
+        size_t copy = (header->record_bytes < sizeof(event_trace_record_t))
+                          ? header->record_bytes : sizeof(event_trace_record_t);
+        uint32_t kept = (header->count < REPLAY_MAX_RECORDS) ? header->count : REPLAY_MAX_RECORDS;
+        for (uint32_t i = 0; i < kept; i++) {
+            memset(&records[i], 0, sizeof(records[i]));
+            memcpy(&records[i], capture->cursor + (size_t)i * header->record_bytes, copy);
+        }
+        capture->cursor += (size_t)header->count * header->record_bytes;
+        header->count = kept;
+        return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// Synthetic Session
+// ============================================================================
+
+static bool export_append(const void *data, uint32_t size, void *ctx)
+{
+    export_sink_t *sink = (export_sink_t *)ctx;
+    if (size > sink->capacity - sink->size) {
+        return false;
+    }
+    memcpy(sink->buffer + sink->size, data, size);
+    sink->size += size;
+    return true;
+}
+
+/**
+ * @brief Record a session on the host bus, exported into input_buffer
+ * @return Capture size in bytes, 0 on failure
+ */
+static uint32_t record_session(void)
+{
+    log_set_level(NULL, LOG_LVL_WARN);
+    if (!framing_replay_setup()) {
+        log_set_level(NULL, LOG_LVL_INFO);
+        return 0;
+    }
+
+    // Consumers for the session, so it queues and overflows; the ISR
+    // deadline reports keep none and are elided
+    static const event_type_t consumed[] = {
+        EVENT_TEMPERATURE_UPDATED, EVENT_METRIC_UPDATED, EVENT_CURRENT_LIMIT,
+        EVENT_DISPLAY_READY, EVENT_SENSOR_ERROR,
+    };
+    for (uint32_t i = 0; i < sizeof(consumed) / sizeof(consumed[0]); i++) {
+        event_bus_subscribe(consumed[i], tap);
+    }
+
+    uint32_t tick = 0;
+    event_bus_publish_periodic(EVENT_SENSOR_ERROR, &tick, sizeof(tick), SESSION_TIMER_MS);
+    event_trace_start();
+
+    for (uint32_t round = 0; round < SESSION_ROUNDS; round++) {
+        temperature_data_t reading = {0};
+        reading.temperature = 20.0f + (float)round * 0.1f;
+        reading.humidity = 45.0f;
+        reading.sensor_ok = 1;
+        event_bus_publish(EVENT_TEMPERATURE_UPDATED, &reading, sizeof(reading));
+
+        uint32_t now_us = event_bus_get_timestamp_us();
+        event_bus_publish_from_isr(EVENT_DEADLINE_MISSED, &now_us, sizeof(now_us));
+
+        if (round % SESSION_BURST_EVERY == 0) {
+            for (uint32_t i = 0; i < SESSION_BURST; i++) {
+                uint32_t value[2] = { round, i };
+                event_bus_publish(EVENT_METRIC_UPDATED, value, sizeof(value));
+            }
+        }
+
+        if (round % SESSION_SIDE_EVERY == 0) {
+            uint8_t *block = event_pool_alloc(SESSION_POOLED_SIZE);
+            if (block != NULL) {
+                memset(block, (int)round, SESSION_POOLED_SIZE);
+                if (!event_bus_publish_pooled(EVENT_CURRENT_LIMIT, block, SESSION_POOLED_SIZE)) {
+                    event_pool_release(block);
+                }
+            }
+
+            uint16_t batch[SESSION_BATCH_RECORDS][2];
+            for (uint16_t i = 0; i < SESSION_BATCH_RECORDS; i++) {
+                batch[i][0] = (uint16_t)round;
+                batch[i][1] = i;
+            }
+            event_bus_publish_batch(EVENT_DISPLAY_READY, batch, sizeof(batch[0]), SESSION_BATCH_RECORDS);
+        }
+
+        hal_delay_ms(1);
+        event_bus_process();
+    }
+
+    export_sink_t sink = { input_buffer, 0, sizeof(input_buffer) };
+    bool exported = event_trace_export(export_append, &sink);
+    framing_replay_teardown();
+    log_set_level(NULL, LOG_LVL_INFO);
+    return exported ? sink.size : 0;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+int event_replay_run(const char *path, uint32_t gap_us)
+{
+    uint32_t size;
+
+    if (path != NULL) {
+        FILE *file = fopen(path, "rb");
+        if (file == NULL) {
+            LOG_E(TAG, "%s: cannot open", path);
+            return 1;
+        }
+        size = (uint32_t)fread(input_buffer, 1, sizeof(input_buffer), file);
+        fclose(file);
+    } else {
+        size = record_session();
+        if (size == 0) {
+            LOG_E(TAG, "synthetic session: recording failed");
+            return 1;
+        }
+    }
+
+    capture_t capture = { input_buffer, input_buffer + size };
+    event_trace_header_t header;
+    replay_result_t result;
+    uint32_t traces = 0;
+    int exit_code = 0;
+    char name[96];
+
+    while (next_trace(&capture, &header)) {
+        snprintf(name, sizeof(name), "%s#%lu", (path != NULL) ? path : "synthetic",
+                 (unsigned long)traces);
+        traces++;
+
+        if (!replay_once(header.count, gap_us, &result, outcome[0])) {
+            return 1;
+        }
+        report(name, &header, &result);
+        if (result.mismatches > 0) {
+            exit_code = 1;
+        }
+
+        if (path == NULL) {
+            // Same trace, same gap: the second replay must not differ at all
+            replay_result_t again;
+            if (!replay_once(header.count, gap_us, &again, outcome[1])) {
+                return 1;
+            }
+            bool same = memcmp(outcome[0], outcome[1], header.count) == 0 &&
+                        again.rounds == result.rounds;
+            LOG_I(TAG, "%s: second replay %s", name, same ? "identical" : "DIFFERS");
+            if (!same || result.rejected_replayed != result.rejected_recorded) {
+                exit_code = 1;
+            }
+        }
+    }
+
+    if (traces == 0) {
+        LOG_E(TAG, "%s: no trace header", (path != NULL) ? path : "synthetic");
+        return 1;
+    }
+    return exit_code;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file event_replay.h
+ * @brief Replay of recorded event bus publishes (OS/event_trace.h), host build
+ *
+ * Feeds each trace of a capture back through the publish path it was
+ * recorded on, then event_bus_process(), with the protocol handler's
+ * subscribers and a counting tap on every traced type. The target's
+ * dispatch tasks are not modelled: a gap of at least gap_us between two
+ * records stands for the dispatcher running, so the replay calls
+ * event_bus_process() there and publishes records closer together back
+ * to back. Lowering gap_us lets the bus keep up better, raising it
+ * makes bursts pile up; the report compares the replay's rejected
+ * publishes with the recorded ones, which is how to tell the model
+ * reproduces the overflow. Payloads longer than EVENT_TRACE_PAYLOAD_MAX
+ * are padded with zeros. Publishes the target elided for want of a
+ * subscriber are not published again, only recorded.
+ *
+ * The replay records itself and checks every publish against the
+ * capture (type, path, size, payload hash). Without a capture, a
+ * synthetic session (task, ISR, pooled, batch and timer publishes, with
+ * bursts that overflow a lane) is recorded on the host bus, exported and
+ * replayed twice; the two replays must agree publish for publish.
+ *
+ * Output:
+ *   TRACE: <name>: <n> records over <n> ms (<n> lost before), <n> rounds, dispatch <n> ns
+ *          (<n> ns/event), rejected <n> recorded / <n> replayed, <n> mismatches, <n> truncated,
+ *          <n> elided
+ *   TRACE:   type <n>: <n> published, <n> delivered, rejected <n>/<n>, slowest callback <n> ns
+ */
+
+#ifndef EVENT_REPLAY_H
+#define EVENT_REPLAY_H
+
+#include <stdint.h>
+
+#define EVENT_REPLAY_GAP_US         200     // Default dispatcher gap
+#define EVENT_REPLAY_MAX_INPUT      (256 * 1024)
+
+/**
+ * @brief Replay every trace in a capture file, or the synthetic session
+ *
+ * @param path Capture (event_trace_export() stream, e.g. RTT channel 5), or NULL
+ * @param gap_us Record spacing treated as a dispatcher run
+ * @return Process exit code: 0, or 1 on a bad capture or a mismatch
+ */
+int event_replay_run(const char *path, uint32_t gap_us);
+
+#endif // EVENT_REPLAY_H
@@ -0,0 +1,314 @@
+/**
+ * @file framing_replay.c
+ * @brief Wire traffic replay through framing + protocol (host build)
+ */
+
+#include "framing_replay.h"
+#include "host_port.h"
+#include "event_bus.h"
+#include "esp32_packet_framing.h"
+#include "protocol_handler.h"
+#include "protocol_common.h"
+#include "portable_log.h"
+#include "hal_delay.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static const char *TAG = "REPLAY";
+
+#define REPLAY_TEMP_SAMPLES         300
+#define REPLAY_COMMAND_WAIT_MS      1000    // Command task catches up before the next input
+#define REPLAY_SEED_PAYLOAD         16      // Zero payload of single-command seeds (>= any min_length)
+#define REPLAY_PATH_MAX             512
+
+static uint8_t input_buffer[FRAMING_REPLAY_MAX_INPUT];
+
+// Replay totals
+static uint64_t total_bytes;
+static uint64_t total_ns;
+static uint32_t total_inputs;
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+bool framing_replay_setup(void)
+{
+    if (!host_services_init()) {
+        return false;
+    }
+
+    event_bus_init();
+    if (protocol_handler_init(&protocol_transport_uart) != PROTO_HANDLER_OK) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < REPLAY_TEMP_SAMPLES; i++) {
+        host_temperature_push(1000U + i * 10U, 2000 + (int32_t)(i % 100));
+    }
+    return true;
+}
+
+void framing_replay_teardown(void)
+{
+    protocol_handler_deinit();
+}
+
+uint64_t framing_replay_input(const uint8_t *data, size_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+
+    // A frame left half-parsed by the previous input must not swallow this one
+    stm32_uart_set_wire_mode((data[0] & 0x01) ? STM32_UART_WIRE_COBS : STM32_UART_WIRE_MARKERS);
+    stm32_uart_flush_rx();
+
+    uint64_t ns = 0;
+    for (size_t offset = 1; offset < size; offset += FRAMING_REPLAY_SPAN) {
+        size_t span = size - offset;
+        if (span > FRAMING_REPLAY_SPAN) {
+            span = FRAMING_REPLAY_SPAN;
+        }
+
+        uint32_t start = hal_get_cycle_count();
+        stm32_uart_inject_rx(&data[offset], span);
+        ns += hal_get_cycle_count() - start;
+    }
+
+    protocol_handler_wait_commands(REPLAY_COMMAND_WAIT_MS);
+    event_bus_process();
+    return ns;
+}
+
+static bool replay_file(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        LOG_E(TAG, "%s: cannot open", path);
+        return false;
+    }
+
+    size_t size = fread(input_buffer, 1, sizeof(input_buffer), file);
+    bool truncated = !feof(file);
+    fclose(file);
+    if (truncated) {
+        LOG_W(TAG, "%s: replaying the first %u bytes only", path, (unsigned)size);
+    }
+
+    total_ns += framing_replay_input(input_buffer, size);
+    total_bytes += (size > 0) ? size - 1 : 0;
+    total_inputs++;
+    return true;
+}
+
+static bool replay_path(const char *path)
+{
+    struct stat info;
+    if (stat(path, &info) != 0) {
+        LOG_E(TAG, "%s: not found", path);
+        return false;
+    }
+    if (!S_ISDIR(info.st_mode)) {
+        return replay_file(path);
+    }
+
+    DIR *dir = opendir(path);
+    if (dir == NULL) {
+        LOG_E(TAG, "%s: cannot open", path);
+        return false;
+    }
+
+    bool ok = true;
+    struct dirent *entry;
+    char file_path[REPLAY_PATH_MAX];
+    while ((entry = readdir(dir)) != NULL) {
+        snprintf(file_path, sizeof(file_path), "%s/%s", path, entry->d_name);
+        if (stat(file_path, &info) == 0 && S_ISREG(info.st_mode)) {
+            ok &= replay_file(file_path);
+        }
+    }
+    closedir(dir);
+    return ok;
+}
+
+int framing_replay_run(char **paths, int path_count, uint32_t repeat)
+{
+    if (!framing_replay_setup()) {
+        LOG_E(TAG, "Setup failed");
+        return 1;
+    }
+
+    // Rejected frames log a warning each; only the summary matters here
+    log_set_level(NULL, LOG_LVL_ERROR);
+    stm32_uart_reset_stats();
+    host_uart_tx_clear();
+    total_bytes = 0;
+    total_ns = 0;
+    total_inputs = 0;
+
+    bool ok = true;
+    for (uint32_t pass = 0; pass < repeat && ok; pass++) {
+        for (int i = 0; i < path_count; i++) {
+            ok &= replay_path(paths[i]);
+        }
+    }
+
+    stm32_uart_stats_t stats;
+    stm32_uart_get_stats(&stats);
+    framing_replay_teardown();
+    log_set_level(NULL, LOG_LVL_INFO);
+
+    // Bytes per ns * 1000 = MB/s
+    uint64_t kb_per_s = (total_ns > 0) ? (total_bytes * 1000000ULL) / total_ns : 0;
+    LOG_I(TAG, "replay: %lu inputs, %llu bytes, %lu packets in, %lu frames out, "
+          "%lu crc / %lu framing errors",
+          (unsigned long)total_inputs, (unsigned long long)total_bytes,
+          (unsigned long)stats.packets_received, (unsigned long)host_uart_tx_frames(),
+          (unsigned long)stats.crc_errors, (unsigned long)stats.framing_errors);
+    LOG_I(TAG, "replay: parse %llu.%03llu MB/s (%llu ns)",
+          (unsigned long long)(kb_per_s / 1000), (unsigned long long)(kb_per_s % 1000),
+          (unsigned long long)total_ns);
+    return ok ? 0 : 1;
+}
+
+// ============================================================================
+// Seed Corpus
+// ============================================================================
+
+typedef struct {
+    uint8_t data[FRAMING_REPLAY_MAX_INPUT];
+    size_t length;
+    uint8_t seq;
+} corpus_input_t;
+
+static corpus_input_t corpus;
+
+static void corpus_begin(stm32_uart_wire_mode_t mode)
+{
+    // Frames below are encoded in the current mode
+    stm32_uart_set_wire_mode(mode);
+    corpus.data[0] = (mode == STM32_UART_WIRE_COBS) ? 0x01 : 0x00;
+    corpus.length = 1;
+    corpus.seq = 0;
+}
+
+static void corpus_command(uint8_t cmd_id, const void *payload, uint16_t length)
+{
+    protocol_packet_t cmd = {
+        .type = PACKET_TYPE_CMD,
+        .cmd_id = cmd_id,
+        .seq = corpus.seq++,
+        .status = 0,
+        .length = length,
+    };
+    if (length > 0) {
+        memcpy(cmd.payload, payload, length);
+    }
+
+    corpus.length += stm32_uart_encode_frame((const uint8_t *)&cmd, PROTOCOL_HEADER_SIZE + length,
+                                             &corpus.data[corpus.length],
+                                             sizeof(corpus.data) - corpus.length);
+}
+
+static bool corpus_write(const char *dir, const char *name)
+{
+    char path[REPLAY_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        LOG_E(TAG, "%s: cannot create", path);
+        return false;
+    }
+    bool ok = fwrite(corpus.data, 1, corpus.length, file) == corpus.length;
+    fclose(file);
+    return ok;
+}
+
+/**
+ * @brief A host tool's session: handshake, queries, a stream and a dump
+ */
+static void corpus_session(stm32_uart_wire_mode_t mode)
+{
+    uint32_t wire = (mode == STM32_UART_WIRE_COBS) ? PROTOCOL_FEATURE_COBS : 0;
+    cmd_hello_t hello = {
+        .version = PROTOCOL_VERSION_MAX,
+        .max_payload = PROTOCOL_BULK_MAX_PAYLOAD_SIZE,
+        .features = wire | PROTOCOL_FEATURE_COMPACT | PROTOCOL_FEATURE_CREDITS |
+                    PROTOCOL_FEATURE_BULK | PROTOCOL_FEATURE_STREAM_BATCH,
+    };
+    cmd_grant_credits_t credits = { .credits = 64 };
+    cmd_get_status_if_changed_t if_changed = { .since_version = 1 };
+    cmd_get_buffer_data_t buffer = { .start_index = 0, .count = 16 };
+    cmd_start_stream_t stream = {
+        .sensor_type = SENSOR_TEMPERATURE,
+        .interval_ms = 100,
+        .batch_size = 4,
+        .max_latency_ms = 500,
+    };
+    cmd_subscribe_events_t events = {
+        .event_mask = 1UL << EVENT_TEMPERATURE_UPDATED,
+        .batch_size = 4,
+        .max_latency_ms = 100,
+    };
+    cmd_bulk_dump_t dump = { .sensor_type = SENSOR_TEMPERATURE, .start_index = 0, .count = 64 };
+    cmd_stop_stream_t stop = { .sensor_type = SENSOR_TEMPERATURE };
+    cmd_subscribe_events_t unsubscribe = { .event_mask = 0 };
+    uint8_t echo[32];
+    for (size_t i = 0; i < sizeof(echo); i++) {
+        echo[i] = (uint8_t)i;
+    }
+
+    corpus_begin(mode);
+    corpus_command(CMD_HELLO, &hello, sizeof(hello));
+    corpus_command(CMD_GRANT_CREDITS, &credits, sizeof(credits));
+    corpus_command(CMD_GET_STATUS, NULL, 0);
+    corpus_command(CMD_GET_STATUS_IF_CHANGED, &if_changed, sizeof(if_changed));
+    corpus_command(CMD_GET_BUFFER_DATA, &buffer, sizeof(buffer));
+    corpus_command(CMD_START_MEASUREMENT, &stream, sizeof(stream));
+    corpus_command(CMD_SUBSCRIBE_EVENTS, &events, sizeof(events));
+    corpus_command(CMD_ECHO, echo, sizeof(echo));
+    corpus_command(CMD_BULK_DUMP, &dump, sizeof(dump));
+    corpus_command(CMD_GET_PERF, NULL, 0);
+    corpus_command(CMD_STOP_MEASUREMENT, &stop, sizeof(stop));
+    corpus_command(CMD_SUBSCRIBE_EVENTS, &unsubscribe, sizeof(unsubscribe));
+    corpus_command(CMD_GET_STATUS, NULL, 0);
+}
+
+int framing_replay_write_corpus(const char *dir)
+{
+    if (!framing_replay_setup()) {
+        LOG_E(TAG, "Setup failed");
+        return 1;
+    }
+
+    static const uint8_t zeros[REPLAY_SEED_PAYLOAD] = {0};
+    static const stm32_uart_wire_mode_t modes[] = { STM32_UART_WIRE_MARKERS, STM32_UART_WIRE_COBS };
+    static const char *const mode_names[] = { "markers", "cobs" };
+    char name[64];
+    bool ok = true;
+    uint32_t written = 0;
+
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        for (uint8_t cmd_id = CMD_GET_BUFFER_DATA; cmd_id <= CMD_GET_STATUS_IF_CHANGED; cmd_id++) {
+            corpus_begin(modes[m]);
+            corpus_command(cmd_id, zeros, sizeof(zeros));
+            snprintf(name, sizeof(name), "%s_cmd_%02x.bin", mode_names[m], cmd_id);
+            ok &= corpus_write(dir, name);
+            written++;
+        }
+
+        corpus_session(modes[m]);
+        snprintf(name, sizeof(name), "%s_session.bin", mode_names[m]);
+        ok &= corpus_write(dir, name);
+        written++;
+    }
+
+    framing_replay_teardown();
+    LOG_I(TAG, "corpus: %lu inputs written to %s", (unsigned long)written, dir);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file framing_replay.h
+ * @brief Wire traffic replay through framing + protocol (host build)
+ *
+ * One input is one file of the corpus (Tests/host/corpus) or one libFuzzer
+ * input (fuzz_framing.c), in the same format:
+ *
+ *   byte 0     wire mode: bit 0 set = COBS, clear = start/end markers
+ *   byte 1..   bytes as received on the UART
+ *
+ * The bytes reach the parser in FRAMING_REPLAY_SPAN chunks, like DMA idle
+ * line bursts, and parse time is measured around them only: it covers the
+ * framing state machine, CRC and the protocol handler's RX-side decode,
+ * not the command task's handling.
+ */
+
+#ifndef FRAMING_REPLAY_H
+#define FRAMING_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define FRAMING_REPLAY_SPAN         64      // Bytes per parser call
+#define FRAMING_REPLAY_MAX_INPUT    (64 * 1024)
+
+/**
+ * @brief Bring up event bus, protocol handler and some buffered samples
+ * @return false if the protocol handler failed to start
+ */
+bool framing_replay_setup(void);
+
+void framing_replay_teardown(void);
+
+/**
+ * @brief Feed one input and let the command task catch up
+ * @return Nanoseconds spent parsing
+ */
+uint64_t framing_replay_input(const uint8_t *data, size_t size);
+
+/**
+ * @brief Replay corpus files and directories, and report parse throughput
+ *
+ * @param paths Files, or directories whose regular files are all replayed
+ * @param repeat Passes over the inputs (for a steadier throughput figure)
+ * @return Process exit code: 0, or 1 if an input could not be read
+ */
+int framing_replay_run(char **paths, int path_count, uint32_t repeat);
+
+/**
+ * @brief Write the seed corpus: each command alone, plus host sessions
+ *
+ * @param dir Existing output directory
+ * @return Process exit code
+ */
+int framing_replay_write_corpus(const char *dir);
+
+#endif // FRAMING_REPLAY_H
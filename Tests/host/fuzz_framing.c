@@ -0,0 +1,33 @@
+/**
+ * @file fuzz_framing.c
+ * @brief libFuzzer entry point: framing parser + protocol decode
+ *
+ * Inputs use the corpus format of framing_replay.h, so the seed corpus and
+ * any finding replay with "stm32_host replay <file>":
+ *
+ *   cmake -S Tests/host -B build/fuzz -DCMAKE_C_COMPILER=clang -DHOST_LIBFUZZER=ON
+ *   cmake --build build/fuzz
+ *   build/fuzz/stm32_host_fuzz -max_len=4096 build/fuzz/corpus Tests/host/corpus
+ */
+
+#include "framing_replay.h"
+#include "portable_log.h"
+#include <stdlib.h>
+
+int LLVMFuzzerInitialize(int *argc, char ***argv)
+{
+    (void)argc;
+    (void)argv;
+
+    if (!framing_replay_setup()) {
+        abort();
+    }
+    log_set_level(NULL, LOG_LVL_ERROR);
+    return 0;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    framing_replay_input(data, size);
+    return 0;
+}
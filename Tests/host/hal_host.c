@@ -0,0 +1,351 @@
+/**
+ * @file hal_host.c
+ * @brief HAL functions for the host build
+ *
+ * Time comes from CLOCK_MONOTONIC; the "cycle counter" counts nanoseconds
+ * at a nominal 1 GHz, so cycle-based benchmark output reads as ns. A check
+ * can hold the millisecond tick and step it by hand (host_tick_hold()).
+ *
+ * The UART is a sink: everything written is appended to a capture buffer
+ * (host_uart_tx_*() in host_port.h), and handed to the test's sink if one
+ * is set, and async transfers complete at once.
+ * Nothing arrives on RX; tests feed the framing parser through
+ * stm32_uart_inject_rx() instead.
+ */
+
+#include "host_port.h"
+#include "hal_delay.h"
+#include "hal_timebase.h"
+#include "hal_timer.h"
+#include "hal_crc.h"
+#include "hal_rtc.h"
+#include "hal_uart.h"
+#include <string.h>
+#include <time.h>
+
+#define HOST_CPU_FREQ_HZ        1000000000U
+
+static hal_uart_event_callback_t uart_callback[HAL_UART_PORT_MAX];
+static void *uart_user_data[HAL_UART_PORT_MAX];
+
+static uint8_t tx_capture[HOST_UART_TX_CAPTURE_SIZE];
+static size_t tx_capture_len = 0;
+static uint32_t tx_frames = 0;
+static host_uart_tx_sink_t tx_sink = NULL;
+static void *tx_sink_user_data = NULL;
+
+static uint32_t rtc_seconds = 0;
+
+// Held tick (host_tick_hold()); read from any task
+static bool tick_held = false;
+static uint32_t tick_held_ms = 0;
+
+static uint64_t monotonic_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static void tx_capture_append(const uint8_t *data, size_t len)
+{
+    // Keeps the start of the stream once full; the byte count goes on
+    size_t room = sizeof(tx_capture) - tx_capture_len;
+    size_t copy = (len < room) ? len : room;
+    memcpy(&tx_capture[tx_capture_len], data, copy);
+    tx_capture_len += copy;
+
+    if (tx_sink != NULL) {
+        tx_sink(data, len, tx_sink_user_data);
+    }
+}
+
+// ============================================================================
+// Delay and Timebase
+// ============================================================================
+
+void hal_delay_ms(uint32_t milliseconds)
+{
+    struct timespec ts = {
+        .tv_sec = milliseconds / 1000U,
+        .tv_nsec = (long)(milliseconds % 1000U) * 1000000L,
+    };
+    nanosleep(&ts, NULL);
+}
+
+uint32_t hal_get_tick(void)
+{
+    if (__atomic_load_n(&tick_held, __ATOMIC_ACQUIRE)) {
+        return __atomic_load_n(&tick_held_ms, __ATOMIC_RELAXED);
+    }
+    return (uint32_t)(monotonic_ns() / 1000000U);
+}
+
+void host_tick_hold(void)
+{
+    __atomic_store_n(&tick_held_ms, (uint32_t)(monotonic_ns() / 1000000U), __ATOMIC_RELAXED);
+    __atomic_store_n(&tick_held, true, __ATOMIC_RELEASE);
+}
+
+void host_tick_advance(uint32_t milliseconds)
+{
+    __atomic_fetch_add(&tick_held_ms, milliseconds, __ATOMIC_RELAXED);
+}
+
+void host_tick_release(void)
+{
+    __atomic_store_n(&tick_held, false, __ATOMIC_RELEASE);
+}
+
+uint32_t hal_timer_get_us(void)
+{
+    return (uint32_t)(monotonic_ns() / 1000U);
+}
+
+uint32_t hal_get_cycle_count(void)
+{
+    return (uint32_t)monotonic_ns();
+}
+
+uint32_t hal_get_cpu_freq_hz(void)
+{
+    return HOST_CPU_FREQ_HZ;
+}
+
+bool hal_timebase_init(void)
+{
+    return true;
+}
+
+uint64_t hal_timebase_now_us(void)
+{
+    return monotonic_ns() / 1000U;
+}
+
+uint64_t hal_timebase_to_unix_us(uint64_t mono_us)
+{
+    return (uint64_t)rtc_seconds * 1000000U + mono_us;
+}
+
+void hal_timebase_resync(void)
+{
+}
+
+void hal_timebase_reference(uint64_t mono_us, uint64_t unix_us)
+{
+    (void)mono_us;
+    (void)unix_us;
+}
+
+void hal_timebase_get_status(hal_timebase_status_t *status)
+{
+    if (status != NULL) {
+        memset(status, 0, sizeof(*status));
+    }
+}
+
+// ============================================================================
+// CRC (no peripheral: callers fall back to the table CRC)
+// ============================================================================
+
+bool hal_crc_init(void)
+{
+    return false;
+}
+
+bool hal_crc_is_available(void)
+{
+    return false;
+}
+
+uint16_t hal_crc_ccitt16(uint16_t init, const uint8_t *data, size_t length)
+{
+    (void)data;
+    (void)length;
+    return init;
+}
+
+// ============================================================================
+// RTC
+// ============================================================================
+
+hal_rtc_status_t hal_rtc_set_time(uint32_t seconds, uint16_t milliseconds)
+{
+    (void)milliseconds;
+    rtc_seconds = seconds;
+    return HAL_RTC_OK;
+}
+
+// ============================================================================
+// UART
+// ============================================================================
+
+hal_uart_config_t hal_uart_get_default_config(void)
+{
+    hal_uart_config_t config = {
+        .baud_rate = 115200,
+        .data_bits = 8,
+        .parity = HAL_UART_PARITY_NONE,
+        .stop_bits = HAL_UART_STOP_BITS_1,
+        .flow_ctrl = HAL_UART_FLOW_CTRL_NONE,
+        .tx_pin = -1,
+        .rx_pin = -1,
+        .rts_pin = -1,
+        .cts_pin = -1,
+        .rx_buffer_size = 1024,
+        .tx_buffer_size = 0,
+        .rx_dma_buffer_size = 0,
+        .rx_max_latency_ms = 0,
+        .rx_timeout_bits = 0,
+        .rx_match_char = -1,
+    };
+    return config;
+}
+
+bool hal_uart_init(hal_uart_port_t port, const hal_uart_config_t *config)
+{
+    return port < HAL_UART_PORT_MAX && config != NULL;
+}
+
+bool hal_uart_deinit(hal_uart_port_t port)
+{
+    if (port >= HAL_UART_PORT_MAX) {
+        return false;
+    }
+
+    uart_callback[port] = NULL;
+    return true;
+}
+
+int hal_uart_write(hal_uart_port_t port, const uint8_t *data, size_t len, int timeout_ms)
+{
+    (void)timeout_ms;
+
+    if (port >= HAL_UART_PORT_MAX || data == NULL) {
+        return -1;
+    }
+
+    tx_capture_append(data, len);
+    tx_frames++;
+    return (int)len;
+}
+
+bool hal_uart_write_async_sg(hal_uart_port_t port, const hal_uart_tx_segment_t *segments,
+                             size_t count)
+{
+    if (port >= HAL_UART_PORT_MAX || segments == NULL || count == 0) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        tx_capture_append(segments[i].data, segments[i].len);
+    }
+    tx_frames++;
+
+    // The wire is infinitely fast: the transfer is done before this returns
+    if (uart_callback[port] != NULL) {
+        hal_uart_event_t event = { .type = HAL_UART_EVENT_TX_DONE, .size = 0 };
+        uart_callback[port](port, &event, uart_user_data[port]);
+    }
+    return true;
+}
+
+bool hal_uart_set_baudrate(hal_uart_port_t port, uint32_t baud_rate)
+{
+    return hal_uart_baudrate_supported(port, baud_rate);
+}
+
+bool hal_uart_baudrate_supported(hal_uart_port_t port, uint32_t baud_rate)
+{
+    return port < HAL_UART_PORT_MAX && baud_rate > 0;
+}
+
+size_t hal_uart_rx_dma_size_for(uint32_t baud_rate, uint32_t latency_ms)
+{
+    return (size_t)(((uint64_t)baud_rate / 10U) * latency_ms * 2U / 1000U);
+}
+
+bool hal_uart_rx_set_zero_copy(hal_uart_port_t port, bool enable)
+{
+    (void)enable;
+    return port < HAL_UART_PORT_MAX;
+}
+
+bool hal_uart_set_rx_timeout(hal_uart_port_t port, uint32_t bits)
+{
+    (void)bits;
+    return port < HAL_UART_PORT_MAX;
+}
+
+bool hal_uart_set_rx_match(hal_uart_port_t port, int16_t match_char)
+{
+    (void)match_char;
+    return port < HAL_UART_PORT_MAX;
+}
+
+size_t hal_uart_rx_peek(hal_uart_port_t port, const uint8_t **data)
+{
+    (void)port;
+    if (data != NULL) {
+        *data = NULL;
+    }
+    return 0;
+}
+
+void hal_uart_rx_consume(hal_uart_port_t port, size_t len)
+{
+    (void)port;
+    (void)len;
+}
+
+bool hal_uart_flush_rx(hal_uart_port_t port)
+{
+    return port < HAL_UART_PORT_MAX;
+}
+
+bool hal_uart_register_callback(hal_uart_port_t port,
+                                hal_uart_event_callback_t callback,
+                                void *user_data)
+{
+    if (port >= HAL_UART_PORT_MAX) {
+        return false;
+    }
+
+    uart_callback[port] = callback;
+    uart_user_data[port] = user_data;
+    return true;
+}
+
+bool hal_uart_unregister_callback(hal_uart_port_t port)
+{
+    return hal_uart_register_callback(port, NULL, NULL);
+}
+
+// ============================================================================
+// Host Test Hooks
+// ============================================================================
+
+const uint8_t *host_uart_tx_data(size_t *length)
+{
+    if (length != NULL) {
+        *length = tx_capture_len;
+    }
+    return tx_capture;
+}
+
+uint32_t host_uart_tx_frames(void)
+{
+    return tx_frames;
+}
+
+void host_uart_tx_clear(void)
+{
+    tx_capture_len = 0;
+    tx_frames = 0;
+}
+
+void host_uart_set_tx_sink(host_uart_tx_sink_t sink, void *user_data)
+{
+    tx_sink_user_data = user_data;
+    tx_sink = sink;
+}
@@ -0,0 +1,397 @@
+/**
+ * @file host_checks.c
+ * @brief Pass/fail regression checks of the portable layers, host build
+ */
+
+#include "host_checks.h"
+#include "event_bus.h"
+#include "cobs.h"
+#include "esp32_packet_framing.h"
+#include "sensor_ring_buffer.h"
+#include "portable_log.h"
+#include "host_port.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+static const char *TAG = "CHECK";
+
+#define CHECK_TIMER_EVENT       EVENT_DISPLAY_READY     // No subscriber in the host build
+#define CHECK_TIMER_WHEEL       32                      // EVENT_TIMER_WHEEL_SLOTS
+#define CHECK_TIMER_PERIODS     5
+#define CHECK_COBS_PAYLOAD      16
+#define CHECK_RB_CAPACITY       8
+#define CHECK_RB_WRAP_START     0xFFFFFFFCUL            // Four pushes before head wraps
+
+static bool check_failed(const char *name, const char *why)
+{
+    LOG_E(TAG, "%s: FAILED (%s)", name, why);
+    return false;
+}
+
+static bool check_passed(const char *name)
+{
+    LOG_I(TAG, "%s: ok", name);
+    return true;
+}
+
+// ============================================================================
+// Timer Wheel
+// ============================================================================
+
+static uint32_t timer_fires;
+static uint32_t timer_fire_ms[CHECK_TIMER_PERIODS + 2];
+
+static void timer_handler(event_t *event)
+{
+    (void)event;
+    if (timer_fires < sizeof(timer_fire_ms) / sizeof(timer_fire_ms[0])) {
+        timer_fire_ms[timer_fires] = event_bus_get_tick();
+    }
+    timer_fires++;
+}
+
+/**
+ * @brief A periodic publish fires once per period, on its grid
+ *
+ * A period that is a multiple of the wheel size re-arms into the slot
+ * being walked; it must not be visited again in the same walk. The tick is
+ * held and stepped 1 ms per process call, so every fire must land exactly
+ * on its due tick.
+ */
+static bool check_timer_period(uint32_t period_ms)
+{
+    const char *name = (period_ms == CHECK_TIMER_WHEEL) ? "timer period 1x wheel" : "timer period 2x wheel";
+
+    event_bus_init();
+    event_bus_subscribe(CHECK_TIMER_EVENT, timer_handler);
+    timer_fires = 0;
+
+    host_tick_hold();
+    uint32_t start = event_bus_get_tick();
+    event_timer_handle_t handle = event_bus_publish_periodic(CHECK_TIMER_EVENT, NULL, 0, period_ms);
+    if (handle == EVENT_TIMER_INVALID) {
+        host_tick_release();
+        event_bus_unsubscribe(CHECK_TIMER_EVENT, timer_handler);
+        return check_failed(name, "no timer");
+    }
+
+    bool next_ok = true;
+    uint32_t steps = period_ms * CHECK_TIMER_PERIODS + period_ms / 2;
+    for (uint32_t step = 0; step < steps; step++) {
+        uint32_t fires = timer_fires;
+        host_tick_advance(1);
+        event_bus_process();
+        if (timer_fires != fires && event_bus_get_next_timer_ms() != period_ms) {
+            next_ok = false;
+        }
+    }
+
+    event_bus_cancel_timer(handle);
+    host_tick_release();
+    event_bus_unsubscribe(CHECK_TIMER_EVENT, timer_handler);
+
+    if (timer_fires != CHECK_TIMER_PERIODS) {
+        LOG_E(TAG, "%s: %lu fires in %lu periods", name,
+              (unsigned long)timer_fires, (unsigned long)CHECK_TIMER_PERIODS);
+        return check_failed(name, "fire count");
+    }
+    for (uint32_t i = 0; i < CHECK_TIMER_PERIODS; i++) {
+        uint32_t due = start + period_ms * (i + 1);
+        if (timer_fire_ms[i] != due) {
+            LOG_E(TAG, "%s: fire %lu at %ld ms, due at %lu ms", name, (unsigned long)i,
+                  (long)(timer_fire_ms[i] - start), (unsigned long)(due - start));
+            return check_failed(name, "off the period grid");
+        }
+    }
+    if (!next_ok) {
+        return check_failed(name, "next timer not one period after a fire");
+    }
+    return check_passed(name);
+}
+
+// ============================================================================
+// Dispatch Snapshot
+// ============================================================================
+
+static uint32_t snapshot_calls[3];
+
+static void snapshot_first(event_t *event)
+{
+    (void)event;
+    snapshot_calls[0]++;
+    // Shifts the later subscribers down while this dispatch walks them
+    event_bus_unsubscribe(CHECK_TIMER_EVENT, snapshot_first);
+}
+
+static void snapshot_second(event_t *event)
+{
+    (void)event;
+    snapshot_calls[1]++;
+}
+
+static void snapshot_third(event_t *event)
+{
+    (void)event;
+    snapshot_calls[2]++;
+}
+
+/**
+ * @brief Unsubscribing during a dispatch skips or repeats no other subscriber
+ */
+static bool check_dispatch_unsubscribe(void)
+{
+    static const char *name = "unsubscribe during dispatch";
+
+    event_bus_init();
+    event_bus_subscribe(CHECK_TIMER_EVENT, snapshot_first);
+    event_bus_subscribe(CHECK_TIMER_EVENT, snapshot_second);
+    event_bus_subscribe(CHECK_TIMER_EVENT, snapshot_third);
+    snapshot_calls[0] = snapshot_calls[1] = snapshot_calls[2] = 0;
+
+    for (uint32_t i = 0; i < 2; i++) {
+        event_bus_publish(CHECK_TIMER_EVENT, NULL, 0);
+        event_bus_process();
+    }
+
+    event_bus_unsubscribe(CHECK_TIMER_EVENT, snapshot_second);
+    event_bus_unsubscribe(CHECK_TIMER_EVENT, snapshot_third);
+
+    if (snapshot_calls[0] != 1 || snapshot_calls[1] != 2 || snapshot_calls[2] != 2) {
+        LOG_E(TAG, "%s: calls %lu/%lu/%lu, expected 1/2/2", name, (unsigned long)snapshot_calls[0],
+              (unsigned long)snapshot_calls[1], (unsigned long)snapshot_calls[2]);
+        return check_failed(name, "subscriber skipped or repeated");
+    }
+    return check_passed(name);
+}
+
+// ============================================================================
+// Static Subscriptions
+// ============================================================================
+
+// One type under two spellings, with another type's run sorted between them
+#define CHECK_STATIC_EVENT_A    EVENT_MEASUREMENT_STARTED  // No publisher in the host build
+#define CHECK_STATIC_EVENT_B    EVENT_BUTTON_PRESSED
+#define CHECK_STATIC_EVENT_C    EVENT_MEASUREMENT_STARTED
+
+static uint32_t static_calls[3];
+
+static void static_first_run(event_t *event)
+{
+    (void)event;
+    static_calls[0]++;
+}
+
+static void static_other_type(event_t *event)
+{
+    (void)event;
+    static_calls[1]++;
+}
+
+static void static_second_run(event_t *event)
+{
+    (void)event;
+    static_calls[2]++;
+}
+
+EVENT_BUS_STATIC_SUBSCRIBE(CHECK_STATIC_EVENT_A, static_first_run);
+EVENT_BUS_STATIC_SUBSCRIBE(CHECK_STATIC_EVENT_B, static_other_type);
+EVENT_BUS_STATIC_SUBSCRIBE(CHECK_STATIC_EVENT_C, static_second_run);
+
+/**
+ * @brief A type spelled two ways keeps both of its static subscribers
+ */
+static bool check_static_spellings(void)
+{
+    static const char *name = "static subscriptions of one type, two spellings";
+
+    event_bus_init();
+    static_calls[0] = static_calls[1] = static_calls[2] = 0;
+
+    event_bus_publish(EVENT_MEASUREMENT_STARTED, NULL, 0);
+    event_bus_process();
+
+    if (static_calls[0] != 1 || static_calls[1] != 0 || static_calls[2] != 1) {
+        LOG_E(TAG, "%s: calls %lu/%lu/%lu, expected 1/0/1", name, (unsigned long)static_calls[0],
+              (unsigned long)static_calls[1], (unsigned long)static_calls[2]);
+        return check_failed(name, "second run dropped");
+    }
+    return check_passed(name);
+}
+
+// ============================================================================
+// COBS Delimiters
+// ============================================================================
+
+/**
+ * @brief Decoder: delimiters without a frame before them are EMPTY
+ */
+static bool check_cobs_decoder(void)
+{
+    static const char *name = "cobs back-to-back delimiters";
+    // Leading, repeated and trailing delimiters around two frames ("AB", "C")
+    static const uint8_t wire[] = { 0x00, 0x00, 0x03, 'A', 'B', 0x00, 0x00, 0x00,
+                                    0x02, 'C', 0x00, 0x00 };
+    static const cobs_decode_result_t expected[] = {
+        COBS_DECODE_EMPTY, COBS_DECODE_EMPTY, COBS_DECODE_FRAME, COBS_DECODE_EMPTY,
+        COBS_DECODE_EMPTY, COBS_DECODE_FRAME, COBS_DECODE_EMPTY,
+    };
+    static const size_t expected_length[] = { 0, 0, 2, 0, 0, 1, 0 };
+    uint8_t out[8];
+    cobs_decoder_t dec;
+    size_t offset = 0;
+    size_t results = 0;
+
+    cobs_decoder_init(&dec, out, sizeof(out));
+    while (offset < sizeof(wire)) {
+        size_t consumed;
+        cobs_decode_result_t result = cobs_decoder_feed(&dec, &wire[offset], sizeof(wire) - offset, &consumed);
+        offset += consumed;
+        if (result == COBS_DECODE_MORE) {
+            continue;
+        }
+        if (results >= sizeof(expected) / sizeof(expected[0]) || result != expected[results] ||
+            (result == COBS_DECODE_FRAME && dec.length != expected_length[results])) {
+            LOG_E(TAG, "%s: result %lu is %d (length %lu)", name, (unsigned long)results,
+                  (int)result, (unsigned long)dec.length);
+            return check_failed(name, "unexpected result");
+        }
+        results++;
+        cobs_decoder_reset(&dec);
+    }
+    if (results != sizeof(expected) / sizeof(expected[0])) {
+        return check_failed(name, "missing results");
+    }
+    return check_passed(name);
+}
+
+static uint32_t framing_packets;
+static uint32_t framing_rx_errors;
+
+static void framing_callback(stm32_uart_event_t *event, void *user_data)
+{
+    (void)user_data;
+    if (event->type == STM32_UART_EVENT_PACKET_RECEIVED && event->length == CHECK_COBS_PAYLOAD) {
+        framing_packets++;
+    } else if (event->type == STM32_UART_EVENT_RX_ERROR) {
+        framing_rx_errors++;
+    }
+}
+
+/**
+ * @brief Framing layer: idle and keep-alive delimiters are not framing errors
+ */
+static bool check_cobs_framing_idle(void)
+{
+    static const char *name = "cobs idle delimiters in framing";
+    static const uint8_t idle[] = { 0x00, 0x00, 0x00 };
+    uint8_t payload[CHECK_COBS_PAYLOAD];
+    uint8_t wire[64];
+
+    stm32_uart_config_t config = stm32_uart_get_default_config();
+    config.callback = framing_callback;
+    config.user_data = NULL;
+    if (stm32_uart_init(&config) != UART_DRV_OK) {
+        return check_failed(name, "framing init");
+    }
+    stm32_uart_set_wire_mode(STM32_UART_WIRE_COBS);
+    stm32_uart_flush_rx();
+
+    stm32_uart_stats_t before;
+    stm32_uart_get_stats(&before);
+    framing_packets = 0;
+    framing_rx_errors = 0;
+
+    for (uint32_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i * 29 + 3);
+    }
+    size_t length = stm32_uart_encode_frame(payload, sizeof(payload), wire, sizeof(wire));
+
+    stm32_uart_inject_rx(idle, 1);                  // Lone delimiter
+    stm32_uart_inject_rx(idle, sizeof(idle));       // Keep-alive run
+    stm32_uart_inject_rx(wire, length);
+    stm32_uart_inject_rx(idle, sizeof(idle));
+    stm32_uart_inject_rx(wire, length);
+
+    stm32_uart_stats_t after;
+    stm32_uart_get_stats(&after);
+    stm32_uart_set_wire_mode(STM32_UART_WIRE_MARKERS);
+    stm32_uart_deinit();
+
+    if (framing_packets != 2) {
+        return check_failed(name, "frames around the idle fill lost");
+    }
+    if (after.framing_errors != before.framing_errors || framing_rx_errors != 0) {
+        return check_failed(name, "idle fill counted as a framing error");
+    }
+    return check_passed(name);
+}
+
+// ============================================================================
+// SPSC Ring Buffer
+// ============================================================================
+
+/**
+ * @brief SPSC buffers take only power-of-two capacities and read across the index wrap
+ */
+static bool check_spsc_wrap(void)
+{
+    static const char *name = "spsc ring buffer index wrap";
+    static sensor_ring_buffer_record_t storage[455];
+    sensor_ring_buffer_config_t config = sensor_ring_buffer_get_default_config();
+    sensor_ring_buffer_t rb = { 0 };
+
+    config.mode = SENSOR_RING_BUFFER_MODE_SPSC;
+    if (sensor_ring_buffer_init_static(&rb, &config, storage, 455) != SENSOR_RING_BUFFER_ERR_INVALID_ARG) {
+        return check_failed(name, "non-power-of-two capacity accepted");
+    }
+    if (sensor_ring_buffer_init_static(&rb, &config, storage, CHECK_RB_CAPACITY) != SENSOR_RING_BUFFER_OK) {
+        return check_failed(name, "init");
+    }
+
+    // An empty buffer whose free-running indices are about to wrap
+    rb.head = CHECK_RB_WRAP_START;
+    rb.tail = CHECK_RB_WRAP_START;
+
+    const uint32_t pushes = CHECK_RB_CAPACITY - 2;
+    for (uint32_t i = 0; i < pushes; i++) {
+        sensor_sample_t sample = { .sensor_type = SENSOR_TEMPERATURE, .timestamp = i, .value = (int32_t)i };
+        sensor_ring_buffer_push(&rb, &sample);
+    }
+
+    sensor_sample_t samples[CHECK_RB_CAPACITY];
+    uint32_t read = 0;
+    uint32_t count = sensor_ring_buffer_get_count(&rb);
+    sensor_ring_buffer_read(&rb, 0, samples, CHECK_RB_CAPACITY, &read);
+    sensor_ring_buffer_deinit(&rb);
+
+    if (count != pushes || read != pushes) {
+        LOG_E(TAG, "%s: %lu counted, %lu read of %lu", name,
+              (unsigned long)count, (unsigned long)read, (unsigned long)pushes);
+        return check_failed(name, "samples lost at the wrap");
+    }
+    for (uint32_t i = 0; i < pushes; i++) {
+        if (samples[i].value != (int32_t)i) {
+            return check_failed(name, "samples out of order at the wrap");
+        }
+    }
+    return check_passed(name);
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+int host_checks_run(void)
+{
+    bool ok = true;
+
+    ok &= check_timer_period(CHECK_TIMER_WHEEL);
+    ok &= check_timer_period(CHECK_TIMER_WHEEL * 2);
+    ok &= check_dispatch_unsubscribe();
+    ok &= check_static_spellings();
+    ok &= check_cobs_decoder();
+    ok &= check_cobs_framing_idle();
+    ok &= check_spsc_wrap();
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file host_checks.h
+ * @brief Pass/fail regression checks of the portable layers, host build
+ *
+ * Unlike the benchmarks these assert on behaviour, and the run exits
+ * non-zero if any of them fails, so ctest can run them:
+ *
+ *   timer wheel    periodic publishes at 1x and 2x the wheel size fire
+ *                  exactly once per period on a held, hand-stepped tick,
+ *                  and the next-timer estimate follows
+ *   dispatch       a subscriber unsubscribing itself mid-dispatch makes
+ *                  the bus skip or repeat none of the others
+ *   static subs    one event type spelled two ways in EVENT_BUS_STATIC_SUBSCRIBE
+ *                  keeps the subscribers of both section runs
+ *   cobs           back-to-back, leading and lone delimiters are idle fill:
+ *                  EMPTY from the decoder, no framing error in the framing
+ *                  layer, and the frames around them still arrive
+ *   spsc ring      SPSC mode rejects a non-power-of-two capacity and reads
+ *                  every sample across the 32-bit index wrap
+ *
+ * Output:
+ *   CHECK: <name>: ok
+ *   CHECK: <name>: FAILED (<why>)
+ */
+
+#ifndef HOST_CHECKS_H
+#define HOST_CHECKS_H
+
+/**
+ * @brief Run every check
+ * @return Process exit code: 0, or 1 if any check failed
+ */
+int host_checks_run(void);
+
+#endif // HOST_CHECKS_H
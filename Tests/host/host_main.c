@@ -0,0 +1,356 @@
+/**
+ * @file host_main.c
+ * @brief Host benchmark and fuzz runner
+ *
+ * Usage:
+ *   stm32_host bench                 Framing, CRC, ring buffer and event bus benchmarks
+ *   stm32_host fuzz [iters] [seed]   Random and mutated frames through framing + protocol
+ *   stm32_host replay <path>...      Corpus files/directories (framing_replay.h), parse MB/s
+ *   stm32_host corpus <dir>          Write the seed corpus (Tests/host/corpus)
+ *   stm32_host download              protocol_client downloads end to end (download_bench.h)
+ *   stm32_host trace [file] [gap]    Replay recorded event bus publishes (event_replay.h)
+ *   stm32_host check                 Pass/fail regression checks (host_checks.h)
+ *   stm32_host                       Bench and fuzz, with the default fuzz run
+ *
+ * Benchmarks report "cycles" of the host's nominal 1 GHz counter, i.e.
+ * nanoseconds. Build with -DHOST_SANITIZE=ON to let the fuzz run catch
+ * out-of-bounds accesses and undefined behaviour. Inputs come from a
+ * seeded generator, so a finding replays with the same seed.
+ */
+
+#include "host_port.h"
+#include "event_bus.h"
+#include "event_pool.h"
+#include "esp32_packet_framing.h"
+#include "protocol_handler.h"
+#include "protocol_common.h"
+#include "portable_log.h"
+#include "hal_delay.h"
+#include "os_wrapper.h"
+#include "crc_benchmark/crc_benchmark.h"
+#include "framing_benchmark/framing_benchmark.h"
+#include "ring_buffer_benchmark/ring_buffer_benchmark.h"
+#include "framing_replay.h"
+#include "download_bench.h"
+#include "event_replay.h"
+#include "host_checks.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "HOST";
+
+#define FUZZ_DEFAULT_ITERATIONS     20000
+#define FUZZ_DEFAULT_SEED           1
+#define FUZZ_CMD_ID_MAX             0x20    // A few past the last command
+#define FUZZ_TEMP_SAMPLES           300
+#define FUZZ_COMMAND_WAIT_MS        1000    // Command task catches up before the next input
+#define REPLAY_DEFAULT_REPEAT       20      // Corpus passes per replay (steadier MB/s)
+
+#define BUS_BENCH_EVENTS            100000
+#define BUS_BENCH_BATCH             8       // Publishes per process call (lane depth limit)
+#define BUS_BENCH_EVENT             EVENT_DISPLAY_READY     // No subscriber in the host build
+#define BUS_BENCH_UNINTERESTED      4       // Subscribers that want none of the events
+
+typedef struct {
+    uint32_t payload[4];
+} bus_bench_event_t;
+
+static uint32_t lcg_state;
+static volatile uint32_t bus_received;
+static uint8_t fuzz_wire[STM32_UART_MAX_PACKET_SIZE];
+
+static uint32_t lcg_next(void)
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 8;
+}
+
+// ============================================================================
+// Event Bus Benchmark
+// ============================================================================
+
+static void bus_bench_handler(event_t *event)
+{
+    (void)event;
+    bus_received++;
+}
+
+// Subscribers that look at the payload and ignore the event
+static volatile uint32_t bus_ignored;
+
+static void bus_bench_ignore(event_t *event)
+{
+    if (((const bus_bench_event_t *)event->data)->payload[1] != 0) {
+        bus_received++;
+    } else {
+        bus_ignored++;
+    }
+}
+
+static void bus_bench_ignore_1(event_t *event) { bus_bench_ignore(event); }
+static void bus_bench_ignore_2(event_t *event) { bus_bench_ignore(event); }
+static void bus_bench_ignore_3(event_t *event) { bus_bench_ignore(event); }
+static void bus_bench_ignore_4(event_t *event) { bus_bench_ignore(event); }
+
+static const event_callback_t bus_bench_uninterested[BUS_BENCH_UNINTERESTED] = {
+    bus_bench_ignore_1, bus_bench_ignore_2, bus_bench_ignore_3, bus_bench_ignore_4,
+};
+
+// The same test as a filter: payload[1] is always 0
+static const event_filter_t bus_bench_filter =
+    EVENT_FILTER_OUTSIDE_FIELD(bus_bench_event_t, payload[1], EVENT_FIELD_U32, 0.0f, 0.0f);
+
+/**
+ * @brief Publish/dispatch throughput with one subscriber
+ */
+static void bench_event_bus(void)
+{
+    bus_bench_event_t payload = {{0}};
+    uint32_t published = 0;
+
+    event_bus_init();
+    event_bus_subscribe(BUS_BENCH_EVENT, bus_bench_handler);
+    bus_received = 0;
+
+    uint32_t start = hal_get_cycle_count();
+    while (published < BUS_BENCH_EVENTS) {
+        for (uint32_t i = 0; i < BUS_BENCH_BATCH; i++) {
+            payload.payload[0] = published;
+            if (event_bus_publish(BUS_BENCH_EVENT, &payload, sizeof(payload))) {
+                published++;
+            }
+        }
+        event_bus_process();
+    }
+    event_bus_process();
+    uint32_t cycles = hal_get_cycle_count() - start;
+
+    event_bus_unsubscribe(BUS_BENCH_EVENT, bus_bench_handler);
+    LOG_I(TAG, "event bus: %lu events, %lu delivered, %lu ns/event",
+          (unsigned long)published, (unsigned long)bus_received,
+          (unsigned long)(cycles / published));
+}
+
+/**
+ * @brief Uninterested subscribers: callbacks that return early against filters
+ */
+static void bench_event_bus_filtered(bool filtered)
+{
+    bus_bench_event_t payload = {{0}};
+    uint32_t published = 0;
+
+    event_bus_init();
+    event_bus_subscribe(BUS_BENCH_EVENT, bus_bench_handler);
+    for (uint32_t i = 0; i < BUS_BENCH_UNINTERESTED; i++) {
+        event_bus_subscribe_filtered(BUS_BENCH_EVENT, bus_bench_uninterested[i], EVENT_SHARD_DEFAULT,
+                                     filtered ? &bus_bench_filter : NULL);
+    }
+    bus_received = 0;
+    bus_ignored = 0;
+
+    uint32_t start = hal_get_cycle_count();
+    while (published < BUS_BENCH_EVENTS) {
+        for (uint32_t i = 0; i < BUS_BENCH_BATCH; i++) {
+            payload.payload[0] = published;
+            if (event_bus_publish(BUS_BENCH_EVENT, &payload, sizeof(payload))) {
+                published++;
+            }
+        }
+        event_bus_process();
+    }
+    event_bus_process();
+    uint32_t cycles = hal_get_cycle_count() - start;
+
+    event_bus_stats_t stats = event_bus_get_stats();
+    event_bus_unsubscribe(BUS_BENCH_EVENT, bus_bench_handler);
+    for (uint32_t i = 0; i < BUS_BENCH_UNINTERESTED; i++) {
+        event_bus_unsubscribe(BUS_BENCH_EVENT, bus_bench_uninterested[i]);
+    }
+    LOG_I(TAG, "event bus +%d uninterested (%s): %lu events, %lu delivered, %lu ignored, "
+          "%lu filtered, %lu ns/event", BUS_BENCH_UNINTERESTED, filtered ? "filter" : "callback",
+          (unsigned long)published, (unsigned long)bus_received, (unsigned long)bus_ignored,
+          (unsigned long)stats.filtered_count, (unsigned long)(cycles / published));
+}
+
+/**
+ * @brief Publish cost of a type nobody subscribes to (elided at the bus)
+ */
+static void bench_event_bus_elided(void)
+{
+    bus_bench_event_t payload = {{0}};
+    uint32_t published = 0;
+
+    event_bus_init();
+
+    uint32_t start = hal_get_cycle_count();
+    while (published < BUS_BENCH_EVENTS) {
+        for (uint32_t i = 0; i < BUS_BENCH_BATCH; i++) {
+            payload.payload[0] = published;
+            if (event_bus_publish(BUS_BENCH_EVENT, &payload, sizeof(payload))) {
+                published++;
+            }
+        }
+        event_bus_process();
+    }
+    uint32_t cycles = hal_get_cycle_count() - start;
+
+    event_bus_stats_t stats = event_bus_get_stats();
+    LOG_I(TAG, "event bus, no subscriber: %lu events, %lu elided, %lu ns/event",
+          (unsigned long)published, (unsigned long)stats.elided_count,
+          (unsigned long)(cycles / published));
+}
+
+static void run_benchmarks(void)
+{
+    crc_benchmark_run();
+    framing_benchmark_run();
+    ring_buffer_benchmark_run();
+    bench_event_bus();
+    bench_event_bus_filtered(false);
+    bench_event_bus_filtered(true);
+    bench_event_bus_elided();
+}
+
+// ============================================================================
+// Protocol Fuzzing
+// ============================================================================
+
+/**
+ * @brief One input: a valid command, a mutated one, or line noise
+ * @return Wire bytes in fuzz_wire
+ */
+static size_t fuzz_input(void)
+{
+    uint32_t kind = lcg_next() % 4;
+
+    if (kind == 0) {
+        // Line noise; start markers turn up by chance
+        size_t length = lcg_next() % sizeof(fuzz_wire);
+        for (size_t i = 0; i < length; i++) {
+            fuzz_wire[i] = (uint8_t)lcg_next();
+        }
+        return length;
+    }
+
+    protocol_packet_t cmd;
+    uint16_t payload_len = (uint16_t)(lcg_next() % 48);
+    cmd.type = (lcg_next() % 8 == 0) ? (uint8_t)lcg_next() : PACKET_TYPE_CMD;
+    cmd.cmd_id = (uint8_t)(lcg_next() % FUZZ_CMD_ID_MAX);
+    cmd.seq = (uint8_t)lcg_next();
+    cmd.status = 0;
+    cmd.length = payload_len;
+    for (uint16_t i = 0; i < payload_len; i++) {
+        cmd.payload[i] = (uint8_t)lcg_next();
+    }
+
+    // Header length field sometimes disagrees with the frame
+    size_t frame_len = PROTOCOL_HEADER_SIZE + payload_len;
+    if (lcg_next() % 8 == 0) {
+        cmd.length = (uint16_t)lcg_next();
+    }
+
+    size_t length = stm32_uart_encode_frame((const uint8_t *)&cmd, frame_len,
+                                            fuzz_wire, sizeof(fuzz_wire));
+    if (kind == 1 && length > 0) {
+        // Flip, drop or truncate
+        uint32_t flips = 1 + lcg_next() % 4;
+        for (uint32_t i = 0; i < flips; i++) {
+            fuzz_wire[lcg_next() % length] ^= (uint8_t)(1u << (lcg_next() % 8));
+        }
+        if (lcg_next() % 4 == 0) {
+            length = lcg_next() % length;
+        }
+    }
+    return length;
+}
+
+static int run_fuzz(uint32_t iterations, uint32_t seed)
+{
+    lcg_state = seed;
+
+    event_bus_init();
+    if (protocol_handler_init(&protocol_transport_uart) != PROTO_HANDLER_OK) {
+        LOG_E(TAG, "protocol_handler_init failed");
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < FUZZ_TEMP_SAMPLES; i++) {
+        host_temperature_push(1000U + i * 10U, 2000 + (int32_t)(lcg_next() % 1000));
+    }
+
+    // Rejected frames log a warning each; only the summary matters here
+    log_set_level(NULL, LOG_LVL_ERROR);
+    host_uart_tx_clear();
+    for (uint32_t i = 0; i < iterations; i++) {
+        size_t length = fuzz_input();
+        stm32_uart_inject_rx(fuzz_wire, length);
+        protocol_handler_wait_commands(FUZZ_COMMAND_WAIT_MS);
+        event_bus_process();
+    }
+
+    stm32_uart_stats_t stats;
+    stm32_uart_get_stats(&stats);
+    event_pool_stats_t pool = event_pool_get_stats();
+
+    protocol_handler_deinit();
+    log_set_level(NULL, LOG_LVL_INFO);
+
+    LOG_I(TAG, "fuzz: %lu inputs (seed %lu), %lu packets in, %lu frames out, "
+          "%lu crc errors, pool peak %lu",
+          (unsigned long)iterations, (unsigned long)seed,
+          (unsigned long)stats.packets_received, (unsigned long)host_uart_tx_frames(),
+          (unsigned long)stats.crc_errors, (unsigned long)pool.max_blocks_in_use);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *mode = (argc > 1) ? argv[1] : "all";
+
+    // Output survives a sanitizer abort
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    if (strcmp(mode, "replay") == 0 && argc > 2) {
+        const char *repeat = getenv("REPLAY_REPEAT");
+        return framing_replay_run(&argv[2], argc - 2,
+                                  (repeat != NULL) ? (uint32_t)strtoul(repeat, NULL, 0) : REPLAY_DEFAULT_REPEAT);
+    }
+    if (strcmp(mode, "corpus") == 0 && argc == 3) {
+        return framing_replay_write_corpus(argv[2]);
+    }
+    if (strcmp(mode, "trace") == 0) {
+        return event_replay_run((argc > 2) ? argv[2] : NULL,
+                                (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : EVENT_REPLAY_GAP_US);
+    }
+    if (strcmp(mode, "check") == 0) {
+        return host_checks_run();
+    }
+
+    uint32_t iterations = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : FUZZ_DEFAULT_ITERATIONS;
+    uint32_t seed = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : FUZZ_DEFAULT_SEED;
+
+    if (!host_services_init()) {
+        LOG_E(TAG, "host_services_init failed");
+        return 1;
+    }
+
+    if (strcmp(mode, "bench") == 0) {
+        run_benchmarks();
+        return 0;
+    }
+    if (strcmp(mode, "fuzz") == 0) {
+        return run_fuzz(iterations, seed);
+    }
+    if (strcmp(mode, "download") == 0) {
+        return download_bench_run();
+    }
+    if (strcmp(mode, "all") == 0) {
+        run_benchmarks();
+        return run_fuzz(iterations, seed);
+    }
+
+    fprintf(stderr, "usage: %s [bench | fuzz [iterations] [seed] | replay <path>... | corpus <dir> | download | trace [file] [gap_us] | check]\n",
+            argv[0]);
+    return 2;
+}
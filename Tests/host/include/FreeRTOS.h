@@ -0,0 +1,25 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host build stand-in for the kernel's base types
+ *
+ * Middleware goes through os_wrapper.h; this only covers headers that
+ * name kernel types in prototypes (performance_monitor.h).
+ */
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define configMAX_TASK_NAME_LEN     16
+
+#define pdFALSE         ((BaseType_t)0)
+#define pdTRUE          ((BaseType_t)1)
+#define pdPASS          (pdTRUE)
+#define pdFAIL          (pdFALSE)
+
+#endif // HOST_FREERTOS_H
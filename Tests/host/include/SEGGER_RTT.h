@@ -0,0 +1,30 @@
+/**
+ * @file SEGGER_RTT.h
+ * @brief Host build stand-in for the RTT up-channels: no probe, output discarded
+ */
+
+#ifndef HOST_SEGGER_RTT_H
+#define HOST_SEGGER_RTT_H
+
+#define SEGGER_RTT_MODE_NO_BLOCK_SKIP   (0)
+#define SEGGER_RTT_MODE_NO_BLOCK_TRIM   (1)
+
+static inline int SEGGER_RTT_ConfigUpBuffer(unsigned index, const char *name, void *buffer,
+                                            unsigned size, unsigned flags)
+{
+    (void)index;
+    (void)name;
+    (void)buffer;
+    (void)size;
+    (void)flags;
+    return 0;
+}
+
+static inline unsigned SEGGER_RTT_Write(unsigned index, const void *data, unsigned size)
+{
+    (void)index;
+    (void)data;
+    return size;
+}
+
+#endif // HOST_SEGGER_RTT_H
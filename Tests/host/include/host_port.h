@@ -0,0 +1,70 @@
+/**
+ * @file host_port.h
+ * @brief Test hooks of the host build (hal_host.c, service_stubs.c)
+ */
+
+#ifndef HOST_PORT_H
+#define HOST_PORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define HOST_UART_TX_CAPTURE_SIZE   (64 * 1024)
+#define HOST_TEMP_BUFFER_SIZE       4096    // Temperature samples the stub ring keeps
+
+/**
+ * @brief Receives each UART write as it is made (see host_uart_set_tx_sink())
+ */
+typedef void (*host_uart_tx_sink_t)(const uint8_t *data, size_t length, void *user_data);
+
+/**
+ * @brief Bytes written to any UART since the last clear
+ * @param length Set to the captured byte count (capped at the capture size)
+ */
+const uint8_t *host_uart_tx_data(size_t *length);
+
+/**
+ * @brief Writes (sync or async) since the last clear
+ */
+uint32_t host_uart_tx_frames(void);
+
+void host_uart_tx_clear(void);
+
+/**
+ * @brief Hand every UART write to a sink too, in order (NULL to remove)
+ *
+ * Called on the writing task, once per write or scatter-gather segment;
+ * lets a test play the ESP32 end of the link.
+ */
+void host_uart_set_tx_sink(host_uart_tx_sink_t sink, void *user_data);
+
+/**
+ * @brief Stop hal_get_tick() at its current value; it then moves only by host_tick_advance()
+ *
+ * For checks that assert on exact tick values, which the real clock
+ * cannot give under load. The other timebase calls keep running.
+ */
+void host_tick_hold(void);
+
+/**
+ * @brief Move the held tick forward
+ */
+void host_tick_advance(uint32_t milliseconds);
+
+/**
+ * @brief Return hal_get_tick() to the monotonic clock
+ */
+void host_tick_release(void);
+
+/**
+ * @brief Create the stubbed services' state (temperature sample buffer), or empty it again
+ */
+bool host_services_init(void);
+
+/**
+ * @brief Append one temperature sample, as the temperature service does
+ */
+void host_temperature_push(uint32_t timestamp, int32_t value);
+
+#endif // HOST_PORT_H
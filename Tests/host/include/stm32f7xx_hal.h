@@ -0,0 +1,43 @@
+/**
+ * @file stm32f7xx_hal.h
+ * @brief Host build stand-in for the vendor HAL header
+ *
+ * Only what board headers (pinout.h) name at file scope: pin masks and
+ * port handles. Host code never touches the peripherals behind them.
+ */
+
+#ifndef HOST_STM32F7XX_HAL_H
+#define HOST_STM32F7XX_HAL_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t unused;
+} GPIO_TypeDef;
+
+#define GPIO_PIN_0      ((uint16_t)0x0001)
+#define GPIO_PIN_1      ((uint16_t)0x0002)
+#define GPIO_PIN_2      ((uint16_t)0x0004)
+#define GPIO_PIN_3      ((uint16_t)0x0008)
+#define GPIO_PIN_4      ((uint16_t)0x0010)
+#define GPIO_PIN_5      ((uint16_t)0x0020)
+#define GPIO_PIN_6      ((uint16_t)0x0040)
+#define GPIO_PIN_7      ((uint16_t)0x0080)
+#define GPIO_PIN_8      ((uint16_t)0x0100)
+#define GPIO_PIN_9      ((uint16_t)0x0200)
+#define GPIO_PIN_10     ((uint16_t)0x0400)
+#define GPIO_PIN_11     ((uint16_t)0x0800)
+#define GPIO_PIN_12     ((uint16_t)0x1000)
+#define GPIO_PIN_13     ((uint16_t)0x2000)
+#define GPIO_PIN_14     ((uint16_t)0x4000)
+#define GPIO_PIN_15     ((uint16_t)0x8000)
+
+#define GPIOA           ((GPIO_TypeDef *)0)
+#define GPIOB           ((GPIO_TypeDef *)0)
+#define GPIOC           ((GPIO_TypeDef *)0)
+#define GPIOD           ((GPIO_TypeDef *)0)
+#define GPIOE           ((GPIO_TypeDef *)0)
+#define GPIOF           ((GPIO_TypeDef *)0)
+#define GPIOG           ((GPIO_TypeDef *)0)
+
+#endif // HOST_STM32F7XX_HAL_H
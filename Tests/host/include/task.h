@@ -0,0 +1,22 @@
+/**
+ * @file task.h
+ * @brief Host build stand-in for the kernel task types
+ */
+
+#ifndef HOST_TASK_H
+#define HOST_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+typedef enum {
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+#endif // HOST_TASK_H
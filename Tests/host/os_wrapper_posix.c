@@ -0,0 +1,877 @@
+/**
+ * @file os_wrapper_posix.c
+ * @brief os_wrapper.h on POSIX threads, for the host build
+ *
+ * Covers the calls the host-built modules make (tasks, notifications,
+ * queues, queue sets, mutexes, semaphores, critical sections, time). Kernel objects are
+ * constructed in the caller's static storage exactly as on target, so the
+ * *_DEFINE / *_CREATE_STATIC macros work unchanged.
+ *
+ * There are no interrupts on the host: the _from_isr variants are the task
+ * variants, and a critical section is one process-wide recursive mutex.
+ * Priorities are accepted and ignored; threads are scheduled by the host.
+ *
+ * Deleting another task is cooperative: the task is woken and ends itself
+ * at its next os_task_notify_wait() or os_delay_ms(), which is where the
+ * tasks of the host-built modules block. pthread_cancel() is only the
+ * fallback for a task that does not get there in time (it upsets
+ * AddressSanitizer, which cannot see the unwound frames).
+ */
+
+#define _GNU_SOURCE     // PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP
+
+#include "os_wrapper.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HOST_TASK_DELETE_WAIT_MS    1000    // Before falling back to pthread_cancel()
+
+typedef struct {
+    pthread_t thread;
+    os_task_func_t func;
+    void *args;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify_count;
+    uint32_t exited;                // Set by the task as it ends (a count for wait_for_count)
+    bool delete_requested;
+    bool allocated;                 // From os_task_create(), freed on exit
+} host_task_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+} host_mutex_t;
+
+// Entries name the member that got an item, one per item, in send order
+typedef struct host_queue_set {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    void **entries;
+    uint32_t length;
+    uint32_t head;
+    uint32_t count;
+} host_queue_set_t;
+
+// First in every object a set can hold
+typedef struct {
+    host_queue_set_t *set;
+    pthread_mutex_t *lock;          // The object's own
+    uint32_t *count;                // Items it holds
+} host_set_member_t;
+
+typedef struct {
+    host_set_member_t member;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t count;
+    uint32_t max_count;
+    bool allocated;
+} host_semaphore_t;
+
+// One condition for both directions (storage is too small for two); waiters
+// recheck, so a broadcast wakes senders and receivers alike
+typedef struct {
+    host_set_member_t member;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint8_t *buffer;
+    uint32_t item_size;
+    uint32_t length;
+    uint32_t head;                  // Next item to receive
+    uint32_t count;
+    bool allocated;                 // From os_queue_create(), freed on delete
+} host_queue_t;
+
+_Static_assert(sizeof(host_task_t) <= sizeof(os_task_storage_t), "os_task_storage_t too small");
+_Static_assert(sizeof(host_queue_t) <= sizeof(os_queue_storage_t), "os_queue_storage_t too small");
+_Static_assert(sizeof(host_mutex_t) <= sizeof(os_mutex_storage_t), "os_mutex_storage_t too small");
+_Static_assert(sizeof(host_queue_set_t) <= sizeof(os_queue_storage_t), "os_queue_storage_t too small");
+_Static_assert(sizeof(host_semaphore_t) <= sizeof(os_semaphore_storage_t),
+               "os_semaphore_storage_t too small");
+
+static pthread_mutex_t critical_lock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static __thread host_task_t *current_task = NULL;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+static uint64_t monotonic_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+/**
+ * @brief Absolute CLOCK_MONOTONIC deadline timeout_ms from now
+ */
+static struct timespec deadline_after(uint32_t timeout_ms)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += timeout_ms / 1000U;
+    ts.tv_nsec += (long)(timeout_ms % 1000U) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+static void cond_init_monotonic(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/**
+ * @brief Wait on cond until *count is non-zero or the timeout expires
+ * @note Called with lock held
+ */
+static bool wait_for_count(pthread_mutex_t *lock, pthread_cond_t *cond,
+                           volatile uint32_t *count, uint32_t timeout_ms)
+{
+    if (timeout_ms == OS_WAIT_FOREVER) {
+        while (*count == 0) {
+            pthread_cond_wait(cond, lock);
+        }
+        return true;
+    }
+
+    struct timespec deadline = deadline_after(timeout_ms);
+    while (*count == 0) {
+        if (pthread_cond_timedwait(cond, lock, &deadline) == ETIMEDOUT) {
+            return *count != 0;
+        }
+    }
+    return true;
+}
+
+static void set_member_init(host_set_member_t *member, pthread_mutex_t *lock, uint32_t *count)
+{
+    member->set = NULL;
+    member->lock = lock;
+    member->count = count;
+}
+
+/**
+ * @brief Post a member that just got an item to its set, if any
+ * @note Called with the member's lock held, so entries keep send order
+ */
+static void set_member_posted(host_set_member_t *member)
+{
+    host_queue_set_t *set = member->set;
+    if (set == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&set->lock);
+    if (set->count < set->length) {
+        set->entries[(set->head + set->count) % set->length] = member;
+        set->count++;
+        pthread_cond_broadcast(&set->cond);
+    }
+    pthread_mutex_unlock(&set->lock);
+}
+
+static void task_object_init(host_task_t *task, os_task_func_t func, void *args)
+{
+    memset(task, 0, sizeof(*task));
+    task->func = func;
+    task->args = args;
+    pthread_mutex_init(&task->lock, NULL);
+    cond_init_monotonic(&task->cond);
+}
+
+/**
+ * @brief Task object of the calling thread (threads the host started get one lazily)
+ */
+static host_task_t *self(void)
+{
+    if (current_task == NULL) {
+        host_task_t *task = calloc(1, sizeof(host_task_t));
+        if (task != NULL) {
+            task_object_init(task, NULL, NULL);
+            task->thread = pthread_self();
+            task->allocated = true;
+        }
+        current_task = task;
+    }
+    return current_task;
+}
+
+/**
+ * @brief End the calling task
+ *
+ * A task deleted by another hands its object back to the deleter, which
+ * frees it; a task that ends itself frees its own.
+ */
+static void task_exit(host_task_t *task)
+{
+    if (task != NULL) {
+        pthread_mutex_lock(&task->lock);
+        bool requested = task->delete_requested;
+        task->exited = 1;
+        pthread_cond_broadcast(&task->cond);
+        pthread_mutex_unlock(&task->lock);
+
+        current_task = NULL;
+        if (!requested && task->allocated) {
+            free(task);
+        }
+    }
+    pthread_exit(NULL);
+}
+
+static void exit_if_deleted(host_task_t *task)
+{
+    pthread_mutex_lock(&task->lock);
+    bool requested = task->delete_requested;
+    pthread_mutex_unlock(&task->lock);
+
+    if (requested) {
+        task_exit(task);
+    }
+}
+
+static void *task_entry(void *arg)
+{
+    host_task_t *task = (host_task_t *)arg;
+    current_task = task;
+    task->func(task->args);
+
+    // Returning from a task function is an error on target; end the thread
+    os_task_delete(NULL);
+    return NULL;
+}
+
+static os_result_t task_start(host_task_t *task, os_task_handle_t *handle)
+{
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+    // Publish the handle before the task runs, as xTaskCreate does
+    if (handle != NULL) {
+        *handle = task;
+    }
+    int ret = pthread_create(&task->thread, &attr, task_entry, task);
+    pthread_attr_destroy(&attr);
+
+    if (ret != 0) {
+        if (handle != NULL) {
+            *handle = NULL;
+        }
+        return OS_NO_MEMORY;
+    }
+    return OS_SUCCESS;
+}
+
+// =============================================================================
+// TASK OPERATIONS
+// =============================================================================
+
+os_result_t os_task_create(os_task_func_t task_func, const char* name,
+                          uint32_t stack_size, void* params,
+                          uint8_t priority, os_task_handle_t* handle)
+{
+    (void)name;
+    (void)stack_size;
+    (void)priority;
+
+    if (task_func == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    host_task_t *task = malloc(sizeof(host_task_t));
+    if (task == NULL) {
+        return OS_NO_MEMORY;
+    }
+    task_object_init(task, task_func, params);
+    task->allocated = true;
+
+    os_result_t ret = task_start(task, handle);
+    if (ret != OS_SUCCESS) {
+        free(task);
+    }
+    return ret;
+}
+
+os_result_t os_task_create_static(os_task_func_t task_func, const char* name,
+                                  uint32_t stack_size, void* params, uint8_t priority,
+                                  uint32_t* stack, os_task_storage_t* storage,
+                                  os_task_handle_t* handle)
+{
+    (void)name;
+    (void)stack_size;
+    (void)priority;
+    (void)stack;
+
+    if (task_func == NULL || storage == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    host_task_t *task = (host_task_t *)storage;
+    task_object_init(task, task_func, params);
+    return task_start(task, handle);
+}
+
+void os_task_delete(os_task_handle_t handle)
+{
+    host_task_t *task = (handle != NULL) ? (host_task_t *)handle : current_task;
+
+    if (task == NULL || task == current_task) {
+        // Static task objects stay in their storage for the next create
+        task_exit(task);
+    }
+
+    // Another task: wake it and wait for it to end itself, so that it is
+    // gone when this returns, as on target
+    pthread_mutex_lock(&task->lock);
+    task->delete_requested = true;
+    task->notify_count++;           // Ends a notification wait at once
+    pthread_cond_broadcast(&task->cond);
+    bool exited = wait_for_count(&task->lock, &task->cond, &task->exited,
+                                 HOST_TASK_DELETE_WAIT_MS);
+    pthread_mutex_unlock(&task->lock);
+
+    if (!exited) {
+        pthread_cancel(task->thread);
+        return;
+    }
+    if (task->allocated) {
+        free(task);
+    }
+}
+
+os_result_t os_task_notify(os_task_handle_t task)
+{
+    host_task_t *t = (host_task_t *)task;
+    if (t == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&t->lock);
+    t->notify_count++;
+    pthread_cond_signal(&t->cond);
+    pthread_mutex_unlock(&t->lock);
+    return OS_SUCCESS;
+}
+
+os_result_t os_task_notify_from_isr(os_task_handle_t task, bool* higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = false;
+    }
+    return os_task_notify(task);
+}
+
+uint32_t os_task_notify_wait(uint32_t timeout_ms)
+{
+    host_task_t *t = self();
+    if (t == NULL) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&t->lock);
+    wait_for_count(&t->lock, &t->cond, &t->notify_count, timeout_ms);
+    uint32_t count = t->notify_count;
+    t->notify_count = 0;
+    pthread_mutex_unlock(&t->lock);
+
+    exit_if_deleted(t);
+    return count;
+}
+
+// =============================================================================
+// MUTEX OPERATIONS
+// =============================================================================
+
+os_mutex_handle_t os_mutex_create_static(os_mutex_storage_t* storage)
+{
+    if (storage == NULL) {
+        return NULL;
+    }
+
+    host_mutex_t *mutex = (host_mutex_t *)storage;
+    pthread_mutex_init(&mutex->lock, NULL);
+    return mutex;
+}
+
+os_mutex_handle_t os_mutex_create(void)
+{
+    os_mutex_storage_t *storage = malloc(sizeof(os_mutex_storage_t));
+    return (storage != NULL) ? os_mutex_create_static(storage) : NULL;
+}
+
+void os_mutex_delete(os_mutex_handle_t mutex)
+{
+    if (mutex != NULL) {
+        pthread_mutex_destroy(&((host_mutex_t *)mutex)->lock);
+    }
+}
+
+os_result_t os_mutex_take(os_mutex_handle_t mutex, uint32_t timeout_ms)
+{
+    host_mutex_t *m = (host_mutex_t *)mutex;
+    if (m == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    if (timeout_ms == OS_WAIT_FOREVER) {
+        return (pthread_mutex_lock(&m->lock) == 0) ? OS_SUCCESS : OS_ERROR;
+    }
+
+    // pthread_mutex_timedlock() takes a CLOCK_REALTIME deadline
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000U;
+    deadline.tv_nsec += (long)(timeout_ms % 1000U) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return (pthread_mutex_timedlock(&m->lock, &deadline) == 0) ? OS_SUCCESS : OS_TIMEOUT;
+}
+
+os_result_t os_mutex_give(os_mutex_handle_t mutex)
+{
+    host_mutex_t *m = (host_mutex_t *)mutex;
+    if (m == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    return (pthread_mutex_unlock(&m->lock) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+// =============================================================================
+// SEMAPHORE OPERATIONS
+// =============================================================================
+
+os_semaphore_handle_t os_semaphore_create_counting_static(uint32_t max_count, uint32_t initial_count,
+                                                          os_semaphore_storage_t* storage)
+{
+    if (storage == NULL || max_count == 0 || initial_count > max_count) {
+        return NULL;
+    }
+
+    host_semaphore_t *sem = (host_semaphore_t *)storage;
+    memset(sem, 0, sizeof(*sem));
+    pthread_mutex_init(&sem->lock, NULL);
+    cond_init_monotonic(&sem->cond);
+    set_member_init(&sem->member, &sem->lock, &sem->count);
+    sem->count = initial_count;
+    sem->max_count = max_count;
+    return sem;
+}
+
+os_semaphore_handle_t os_semaphore_create_binary_static(os_semaphore_storage_t* storage)
+{
+    return os_semaphore_create_counting_static(1, 0, storage);
+}
+
+os_semaphore_handle_t os_semaphore_create_counting(uint32_t max_count, uint32_t initial_count)
+{
+    os_semaphore_storage_t *storage = malloc(sizeof(os_semaphore_storage_t));
+    if (storage == NULL) {
+        return NULL;
+    }
+
+    host_semaphore_t *sem = os_semaphore_create_counting_static(max_count, initial_count, storage);
+    if (sem == NULL) {
+        free(storage);
+        return NULL;
+    }
+    sem->allocated = true;
+    return sem;
+}
+
+os_semaphore_handle_t os_semaphore_create_binary(void)
+{
+    return os_semaphore_create_counting(1, 0);
+}
+
+void os_semaphore_delete(os_semaphore_handle_t semaphore)
+{
+    host_semaphore_t *sem = (host_semaphore_t *)semaphore;
+    if (sem == NULL) {
+        return;
+    }
+
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->lock);
+    if (sem->allocated) {
+        free(sem);
+    }
+}
+
+os_result_t os_semaphore_take(os_semaphore_handle_t semaphore, uint32_t timeout_ms)
+{
+    host_semaphore_t *sem = (host_semaphore_t *)semaphore;
+    if (sem == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&sem->lock);
+    bool taken = wait_for_count(&sem->lock, &sem->cond, &sem->count, timeout_ms);
+    if (taken) {
+        sem->count--;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return taken ? OS_SUCCESS : OS_TIMEOUT;
+}
+
+os_result_t os_semaphore_give(os_semaphore_handle_t semaphore)
+{
+    host_semaphore_t *sem = (host_semaphore_t *)semaphore;
+    if (sem == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    os_result_t ret = OS_FULL;
+    pthread_mutex_lock(&sem->lock);
+    if (sem->count < sem->max_count) {
+        sem->count++;
+        pthread_cond_signal(&sem->cond);
+        set_member_posted(&sem->member);
+        ret = OS_SUCCESS;
+    }
+    pthread_mutex_unlock(&sem->lock);
+    return ret;
+}
+
+os_result_t os_semaphore_give_from_isr(os_semaphore_handle_t semaphore, bool* higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = false;
+    }
+    return os_semaphore_give(semaphore);
+}
+
+os_result_t os_semaphore_take_from_isr(os_semaphore_handle_t semaphore, bool* higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = false;
+    }
+    return os_semaphore_take(semaphore, OS_NO_WAIT);
+}
+
+// =============================================================================
+// QUEUES
+// =============================================================================
+
+os_queue_handle_t os_queue_create_static(uint32_t queue_length, uint32_t item_size,
+                                         uint8_t* buffer, os_queue_storage_t* storage)
+{
+    if (storage == NULL || buffer == NULL || queue_length == 0 || item_size == 0) {
+        return NULL;
+    }
+
+    host_queue_t *queue = (host_queue_t *)storage;
+    memset(queue, 0, sizeof(*queue));
+    pthread_mutex_init(&queue->lock, NULL);
+    cond_init_monotonic(&queue->cond);
+    set_member_init(&queue->member, &queue->lock, &queue->count);
+    queue->buffer = buffer;
+    queue->item_size = item_size;
+    queue->length = queue_length;
+    return queue;
+}
+
+os_queue_handle_t os_queue_create(uint32_t queue_length, uint32_t item_size)
+{
+    os_queue_storage_t *storage = malloc(sizeof(os_queue_storage_t));
+    uint8_t *buffer = malloc((size_t)queue_length * item_size);
+    if (storage == NULL || buffer == NULL) {
+        free(storage);
+        free(buffer);
+        return NULL;
+    }
+
+    host_queue_t *queue = os_queue_create_static(queue_length, item_size, buffer, storage);
+    if (queue == NULL) {
+        free(storage);
+        free(buffer);
+        return NULL;
+    }
+    queue->allocated = true;
+    return queue;
+}
+
+void os_queue_delete(os_queue_handle_t queue)
+{
+    host_queue_t *q = (host_queue_t *)queue;
+    if (q == NULL) {
+        return;
+    }
+
+    pthread_cond_destroy(&q->cond);
+    pthread_mutex_destroy(&q->lock);
+    if (q->allocated) {
+        free(q->buffer);
+        free(q);
+    }
+}
+
+/**
+ * @brief Wait on the queue's condition until ready() or the timeout expires
+ * @note Called with q->lock held
+ */
+static bool queue_wait(host_queue_t *q, bool (*ready)(const host_queue_t *), uint32_t timeout_ms,
+                       const struct timespec *deadline)
+{
+    while (!ready(q)) {
+        if (timeout_ms == OS_NO_WAIT) {
+            return false;
+        }
+        if (timeout_ms == OS_WAIT_FOREVER) {
+            pthread_cond_wait(&q->cond, &q->lock);
+        } else if (pthread_cond_timedwait(&q->cond, &q->lock, deadline) == ETIMEDOUT) {
+            return ready(q);
+        }
+    }
+    return true;
+}
+
+static bool queue_has_space(const host_queue_t *q)
+{
+    return q->count < q->length;
+}
+
+static bool queue_has_item(const host_queue_t *q)
+{
+    return q->count > 0;
+}
+
+os_result_t os_queue_send(os_queue_handle_t queue, const void* item, uint32_t timeout_ms)
+{
+    host_queue_t *q = (host_queue_t *)queue;
+    if (q == NULL || item == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    struct timespec deadline = deadline_after(timeout_ms);
+    pthread_mutex_lock(&q->lock);
+    if (!queue_wait(q, queue_has_space, timeout_ms, &deadline)) {
+        pthread_mutex_unlock(&q->lock);
+        return (timeout_ms == OS_NO_WAIT) ? OS_FULL : OS_TIMEOUT;
+    }
+
+    uint32_t tail = (q->head + q->count) % q->length;
+    memcpy(&q->buffer[(size_t)tail * q->item_size], item, q->item_size);
+    q->count++;
+    pthread_cond_broadcast(&q->cond);
+    set_member_posted(&q->member);
+    pthread_mutex_unlock(&q->lock);
+    return OS_SUCCESS;
+}
+
+os_result_t os_queue_send_from_isr(os_queue_handle_t queue, const void* item, bool* higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = false;
+    }
+    return os_queue_send(queue, item, OS_NO_WAIT);
+}
+
+os_result_t os_queue_receive(os_queue_handle_t queue, void* item, uint32_t timeout_ms)
+{
+    host_queue_t *q = (host_queue_t *)queue;
+    if (q == NULL || item == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    struct timespec deadline = deadline_after(timeout_ms);
+    pthread_mutex_lock(&q->lock);
+    if (!queue_wait(q, queue_has_item, timeout_ms, &deadline)) {
+        pthread_mutex_unlock(&q->lock);
+        return (timeout_ms == OS_NO_WAIT) ? OS_EMPTY : OS_TIMEOUT;
+    }
+
+    memcpy(item, &q->buffer[(size_t)q->head * q->item_size], q->item_size);
+    q->head = (q->head + 1) % q->length;
+    q->count--;
+    pthread_cond_broadcast(&q->cond);
+    pthread_mutex_unlock(&q->lock);
+    return OS_SUCCESS;
+}
+
+os_result_t os_queue_receive_from_isr(os_queue_handle_t queue, void* item, bool* higher_priority_task_woken)
+{
+    if (higher_priority_task_woken != NULL) {
+        *higher_priority_task_woken = false;
+    }
+    return os_queue_receive(queue, item, OS_NO_WAIT);
+}
+
+uint32_t os_queue_get_count(os_queue_handle_t queue)
+{
+    host_queue_t *q = (host_queue_t *)queue;
+    if (q == NULL) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&q->lock);
+    uint32_t count = q->count;
+    pthread_mutex_unlock(&q->lock);
+    return count;
+}
+
+os_result_t os_queue_reset(os_queue_handle_t queue)
+{
+    host_queue_t *q = (host_queue_t *)queue;
+    if (q == NULL) {
+        return OS_INVALID_PARAM;
+    }
+
+    pthread_mutex_lock(&q->lock);
+    q->head = 0;
+    q->count = 0;
+    pthread_cond_broadcast(&q->cond);
+    pthread_mutex_unlock(&q->lock);
+    return OS_SUCCESS;
+}
+
+// =============================================================================
+// QUEUE SETS
+// =============================================================================
+
+os_queue_set_handle_t os_queue_set_create_static(uint32_t length, uint8_t* buffer,
+                                                 os_queue_storage_t* storage)
+{
+    if (length == 0 || buffer == NULL || storage == NULL) {
+        return NULL;
+    }
+
+    host_queue_set_t *set = (host_queue_set_t *)storage;
+    memset(set, 0, sizeof(*set));
+    pthread_mutex_init(&set->lock, NULL);
+    cond_init_monotonic(&set->cond);
+    set->entries = (void **)buffer;
+    set->length = length;
+    return set;
+}
+
+void os_queue_set_delete(os_queue_set_handle_t set)
+{
+    host_queue_set_t *qs = (host_queue_set_t *)set;
+    if (qs == NULL) {
+        return;
+    }
+
+    pthread_cond_destroy(&qs->cond);
+    pthread_mutex_destroy(&qs->lock);
+}
+
+/**
+ * @brief Move an empty member into (to != NULL) or out of (from != NULL) a set
+ */
+static os_result_t set_member_move(host_set_member_t *member, host_queue_set_t *from,
+                                   host_queue_set_t *to)
+{
+    os_result_t ret = OS_ERROR;
+    pthread_mutex_lock(member->lock);
+    if (member->set == from && *member->count == 0) {
+        member->set = to;
+        ret = OS_SUCCESS;
+    }
+    pthread_mutex_unlock(member->lock);
+    return ret;
+}
+
+os_result_t os_queue_set_add(os_queue_set_handle_t set, void* member)
+{
+    if (set == NULL || member == NULL) {
+        return OS_INVALID_PARAM;
+    }
+    return set_member_move((host_set_member_t *)member, NULL, (host_queue_set_t *)set);
+}
+
+os_result_t os_queue_set_remove(os_queue_set_handle_t set, void* member)
+{
+    if (set == NULL || member == NULL) {
+        return OS_INVALID_PARAM;
+    }
+    return set_member_move((host_set_member_t *)member, (host_queue_set_t *)set, NULL);
+}
+
+void* os_queue_set_select(os_queue_set_handle_t set, uint32_t timeout_ms)
+{
+    host_queue_set_t *qs = (host_queue_set_t *)set;
+    if (qs == NULL) {
+        return NULL;
+    }
+
+    void *member = NULL;
+    pthread_mutex_lock(&qs->lock);
+    if (timeout_ms == OS_NO_WAIT ? qs->count != 0
+                                 : wait_for_count(&qs->lock, &qs->cond, &qs->count, timeout_ms)) {
+        member = qs->entries[qs->head];
+        qs->head = (qs->head + 1) % qs->length;
+        qs->count--;
+    }
+    pthread_mutex_unlock(&qs->lock);
+    return member;
+}
+
+// =============================================================================
+// CRITICAL SECTIONS AND SCHEDULING
+// =============================================================================
+
+void os_yield_from_isr(bool higher_priority_task_woken)
+{
+    (void)higher_priority_task_woken;
+}
+
+bool os_in_isr(void)
+{
+    return false;
+}
+
+uint32_t os_critical_enter(void)
+{
+    pthread_mutex_lock(&critical_lock);
+    return 0;
+}
+
+void os_critical_exit(uint32_t saved_mask)
+{
+    (void)saved_mask;
+    pthread_mutex_unlock(&critical_lock);
+}
+
+// =============================================================================
+// TIME OPERATIONS
+// =============================================================================
+
+uint32_t os_get_tick_count(void)
+{
+    // 1 kHz, like configTICK_RATE_HZ on target
+    return (uint32_t)(monotonic_us() / 1000U);
+}
+
+uint32_t os_get_time_ms(void)
+{
+    return (uint32_t)(monotonic_us() / 1000U);
+}
+
+void os_delay_ms(uint32_t delay_ms)
+{
+    struct timespec ts = {
+        .tv_sec = delay_ms / 1000U,
+        .tv_nsec = (long)(delay_ms % 1000U) * 1000000L,
+    };
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+
+    if (current_task != NULL) {
+        exit_if_deleted(current_task);
+    }
+}
@@ -0,0 +1,366 @@
+/**
+ * @file service_stubs.c
+ * @brief Services the protocol handler calls, reduced for the host build
+ *
+ * The temperature sample buffer is a real sensor_ring_buffer, filled with
+ * host_temperature_push(), so buffer read commands walk real data. The
+ * current monitor, recorder and analysis have no sensor behind them: they
+ * report idle and empty. The config store keeps its values in RAM only.
+ */
+
+#include "host_port.h"
+#include "serv_temperature_sensor.h"
+#include "serv_current_monitor.h"
+#include "serv_current_analysis.h"
+#include "serv_recorder.h"
+#include "serv_config.h"
+#include "services.h"
+#include "sensor_ring_buffer.h"
+#include "performance_monitor.h"
+#include <string.h>
+
+static sensor_ring_buffer_t temp_buffer;
+static sensor_ring_buffer_record_t temp_storage[HOST_TEMP_BUFFER_SIZE];
+static bool buffer_initialized = false;
+
+bool host_services_init(void)
+{
+    // Again for each setup of a run: starts over with an empty buffer
+    if (buffer_initialized) {
+        return sensor_ring_buffer_clear(&temp_buffer) == SENSOR_RING_BUFFER_OK;
+    }
+
+    sensor_ring_buffer_config_t config = sensor_ring_buffer_get_default_config();
+    config.sensor_type = SENSOR_TEMPERATURE;
+
+    buffer_initialized = sensor_ring_buffer_init_static(&temp_buffer, &config, temp_storage,
+                                                        HOST_TEMP_BUFFER_SIZE) == SENSOR_RING_BUFFER_OK;
+    return buffer_initialized;
+}
+
+void host_temperature_push(uint32_t timestamp, int32_t value)
+{
+    if (!buffer_initialized) {
+        return;
+    }
+
+    sensor_sample_t sample = {
+        .sensor_type = SENSOR_TEMPERATURE,
+        .timestamp = timestamp,
+        .value = value,
+    };
+    sensor_ring_buffer_push(&temp_buffer, &sample);
+}
+
+// ============================================================================
+// Temperature Service
+// ============================================================================
+
+uint32_t temperature_sensor_buffer_get_count(void)
+{
+    return buffer_initialized ? sensor_ring_buffer_get_count(&temp_buffer) : 0;
+}
+
+bool temperature_sensor_buffer_read(
+    uint32_t start_index,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read)
+{
+    if (!buffer_initialized || samples == NULL || samples_read == NULL) {
+        return false;
+    }
+
+    return sensor_ring_buffer_read(&temp_buffer, start_index, samples, max_samples,
+                                   samples_read) == SENSOR_RING_BUFFER_OK;
+}
+
+bool temperature_sensor_buffer_read_range(
+    uint32_t from_timestamp,
+    uint32_t to_timestamp,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read,
+    uint32_t *first_index)
+{
+    if (!buffer_initialized || samples == NULL || samples_read == NULL) {
+        return false;
+    }
+
+    return sensor_ring_buffer_read_time_range(&temp_buffer, from_timestamp, to_timestamp,
+                                              samples, max_samples, samples_read,
+                                              first_index) == SENSOR_RING_BUFFER_OK;
+}
+
+uint32_t temperature_sensor_humidity_get_count(void)
+{
+    return 0;
+}
+
+bool temperature_sensor_humidity_read(
+    uint32_t start_index,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read)
+{
+    (void)start_index;
+    (void)samples;
+    (void)max_samples;
+
+    if (samples_read != NULL) {
+        *samples_read = 0;
+    }
+    return false;
+}
+
+bool temperature_sensor_history_read(
+    uint32_t tier,
+    uint32_t from_timestamp,
+    sensor_rollup_record_t *records,
+    uint32_t max_records,
+    uint32_t *records_read,
+    uint32_t *first_index)
+{
+    (void)tier;
+    (void)from_timestamp;
+    (void)records;
+    (void)max_records;
+
+    if (records_read != NULL) {
+        *records_read = 0;
+    }
+    if (first_index != NULL) {
+        *first_index = 0;
+    }
+    return false;
+}
+
+bool temperature_sensor_stats_get(uint32_t window, stream_stats_summary_t *summary)
+{
+    (void)window;
+    (void)summary;
+    return false;
+}
+
+void temperature_sensor_buffer_clear(void)
+{
+    if (buffer_initialized) {
+        sensor_ring_buffer_clear(&temp_buffer);
+    }
+}
+
+// ============================================================================
+// Current Monitor (no INA226: always idle, nothing captured)
+// ============================================================================
+
+measurement_status_t current_monitor_get_status(void)
+{
+    return MEASUREMENT_IDLE;
+}
+
+bool current_monitor_start_measurement(const measurement_config_t *config)
+{
+    (void)config;
+    return false;
+}
+
+bool current_monitor_validate_config(const measurement_config_t *config)
+{
+    // Limits only, so GET_CURRENT_CAPTURE plans before its start fails
+    return config != NULL && config->duration_sec <= 3600 &&
+           (config->sample_period == SAMPLE_PERIOD_1MS || config->sample_period == SAMPLE_PERIOD_10MS ||
+            config->sample_period == SAMPLE_PERIOD_100MS || config->sample_period == SAMPLE_PERIOD_1000MS);
+}
+
+void current_monitor_clear(void)
+{
+}
+
+bool current_monitor_get_instant_reading(INA226_Data *data)
+{
+    (void)data;
+    return false;
+}
+
+float current_monitor_get_current_lsb_mA(void)
+{
+    return 0.0f;
+}
+
+bool current_monitor_get_stream_stats(current_stats_channel_t channel, uint32_t window,
+                                      stream_stats_summary_t *summary)
+{
+    (void)channel;
+    (void)window;
+    (void)summary;
+    return false;
+}
+
+void current_monitor_cursor_init(current_monitor_cursor_t *cursor)
+{
+    if (cursor != NULL) {
+        memset(cursor, 0, sizeof(*cursor));
+    }
+}
+
+uint32_t current_monitor_read_new(current_monitor_cursor_t *cursor, current_sample_t *samples,
+                                  uint32_t max_samples)
+{
+    (void)cursor;
+    (void)samples;
+    (void)max_samples;
+    return 0;
+}
+
+uint32_t current_monitor_read_range(uint32_t start_index, current_sample_t *samples,
+                                    uint32_t max_samples)
+{
+    (void)start_index;
+    (void)samples;
+    (void)max_samples;
+    return 0;
+}
+
+bool current_monitor_get_buffered_range(uint32_t *first_index, uint32_t *count)
+{
+    (void)first_index;
+    (void)count;
+    return false;
+}
+
+uint32_t current_monitor_sample_tick(const current_sample_t *sample)
+{
+    (void)sample;
+    return 0;
+}
+
+bool current_monitor_drain_attach(uint32_t start_index)
+{
+    (void)start_index;
+    return false;
+}
+
+void current_monitor_drain_detach(void)
+{
+}
+
+uint32_t current_monitor_drain_read(current_sample_t *samples, uint32_t max_samples,
+                                    uint32_t *first_index)
+{
+    (void)samples;
+    (void)max_samples;
+    if (first_index != NULL) {
+        *first_index = 0;
+    }
+    return 0;
+}
+
+bool current_monitor_drain_set_watermarks(uint32_t high, uint32_t low,
+                                          current_monitor_drain_cb_t callback, void *user_data)
+{
+    (void)high;
+    (void)low;
+    (void)callback;
+    (void)user_data;
+    return false;
+}
+
+uint32_t current_monitor_drain_get_overruns(void)
+{
+    return 0;
+}
+
+// ============================================================================
+// Analysis, Recorder, Services, Performance Monitor
+// ============================================================================
+
+bool current_analysis_run(current_analysis_result_t *result)
+{
+    (void)result;
+    return false;
+}
+
+void recorder_get_stats(recorder_stats_t *stats)
+{
+    if (stats != NULL) {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
+uint32_t recorder_read(uint32_t offset, uint8_t *data, uint32_t len, uint32_t *total_bytes)
+{
+    (void)offset;
+    (void)data;
+    (void)len;
+    if (total_bytes != NULL) {
+        *total_bytes = 0;
+    }
+    return 0;
+}
+
+uint32_t services_get_missed_deadlines(void)
+{
+    return 0;
+}
+
+BaseType_t perf_get_snapshot(perf_snapshot_t *snapshot)
+{
+    (void)snapshot;
+    return pdFAIL;
+}
+
+// ============================================================================
+// Config Store (RAM only, every key a plain u32 up to UINT32_MAX)
+// ============================================================================
+
+static uint32_t config_values[CONFIG_KEY_COUNT] = {
+    [CONFIG_KEY_STREAM_BATCH] = 1,
+};
+
+uint32_t config_get(config_key_t key)
+{
+    return ((uint32_t)key < CONFIG_KEY_COUNT) ? config_values[key] : 0;
+}
+
+bool config_get_info(config_key_t key, config_info_t *info)
+{
+    if ((uint32_t)key >= CONFIG_KEY_COUNT || info == NULL) {
+        return false;
+    }
+    memset(info, 0, sizeof(*info));
+    info->type = CONFIG_TYPE_U32;
+    info->max_value = UINT32_MAX;
+    return true;
+}
+
+bool config_check(config_key_t key, uint32_t value)
+{
+    (void)value;
+    return (uint32_t)key < CONFIG_KEY_COUNT;
+}
+
+bool config_set(config_key_t key, uint32_t value)
+{
+    if (!config_check(key, value)) {
+        return false;
+    }
+    config_values[key] = value;
+    return true;
+}
+
+void config_reset_defaults(void)
+{
+    memset(config_values, 0, sizeof(config_values));
+    config_values[CONFIG_KEY_STREAM_BATCH] = 1;
+}
+
+void config_save(void)
+{
+}
+
+void config_get_stats(config_stats_t *stats)
+{
+    if (stats != NULL) {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
@@ -0,0 +1,147 @@
+/**
+ * @file mem_benchmark.c
+ * @brief Cache and TCM placement benchmark
+ *
+ * Output (RTT):
+ *   MEM_BENCH: caches off: bus=<cycles/event> crc=<cycles/256B> flash=<cycles> itcm=<cycles>
+ *   MEM_BENCH: caches on:  bus=<cycles/event> crc=<cycles/256B> flash=<cycles> itcm=<cycles>
+ *
+ * flash / itcm run the same loop over 256 bytes from flash (AXIM, wait
+ * states behind the I-cache) and from ITCM RAM.
+ */
+
+#include "mem_benchmark.h"
+#include "../../HAL/hal_mem.h"
+#include "../../HAL/hal_delay.h"
+#include "../../OS/event_bus.h"
+#include "../../Middleware/Features/esp32_packet_framing.h"
+#include "../../Drivers_BSP/Custom/portable_log.h"
+#include <string.h>
+
+static const char *TAG = "MEM_BENCH";
+
+#define BENCH_ROUNDS        50
+#define BENCH_BATCH         8      // Events per round (fits the normal lane)
+#define BENCH_CRC_LENGTH    256
+
+static volatile uint32_t bench_sink = 0;
+static uint8_t crc_buffer[BENCH_CRC_LENGTH];
+
+/**
+ * @brief Benchmark subscriber - touches the payload like a real consumer
+ */
+static void bench_callback(event_t* event)
+{
+    bench_sink += ((const uint8_t*)event->data)[0];
+}
+
+/**
+ * @brief Average cycles per event for publish + event_bus_process()
+ */
+static uint32_t bench_event_bus(void)
+{
+    uint8_t payload[16] = {1};
+    uint32_t total = 0;
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        for (uint32_t i = 0; i < BENCH_BATCH; i++) {
+            event_bus_publish(EVENT_DISPLAY_READY, payload, sizeof(payload));
+        }
+
+        uint32_t start = hal_get_cycle_count();
+        event_bus_process();
+        total += hal_get_cycle_count() - start;
+    }
+
+    return total / (BENCH_ROUNDS * BENCH_BATCH);
+}
+
+/**
+ * @brief Average cycles per stm32_uart_crc16() over BENCH_CRC_LENGTH bytes
+ */
+static uint32_t bench_crc16(void)
+{
+    uint32_t start = hal_get_cycle_count();
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        bench_sink += stm32_uart_crc16(crc_buffer, sizeof(crc_buffer));
+    }
+
+    return (hal_get_cycle_count() - start) / BENCH_ROUNDS;
+}
+
+/**
+ * @brief Loop body shared by the flash and ITCM copies (branches on the data)
+ */
+static inline __attribute__((always_inline)) uint32_t checksum_body(const uint8_t *data, size_t length)
+{
+    uint32_t a = 1;
+    uint32_t b = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        a += data[i];
+        if (a >= 65521U) {
+            a -= 65521U;
+        }
+        b += a;
+        if (b >= 65521U) {
+            b -= 65521U;
+        }
+    }
+    return (b << 16) | a;
+}
+
+static __attribute__((noinline)) uint32_t checksum_flash(const uint8_t *data, size_t length)
+{
+    return checksum_body(data, length);
+}
+
+static HAL_ITCM_FUNC uint32_t checksum_itcm(const uint8_t *data, size_t length)
+{
+    return checksum_body(data, length);
+}
+
+/**
+ * @brief Average cycles of one checksum copy over BENCH_CRC_LENGTH bytes
+ */
+static uint32_t bench_fetch(uint32_t (*checksum)(const uint8_t *, size_t))
+{
+    uint32_t start = hal_get_cycle_count();
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        bench_sink += checksum(crc_buffer, sizeof(crc_buffer));
+    }
+
+    return (hal_get_cycle_count() - start) / BENCH_ROUNDS;
+}
+
+void mem_benchmark_run(void)
+{
+    for (uint32_t i = 0; i < sizeof(crc_buffer); i++) {
+        crc_buffer[i] = (uint8_t)i;
+    }
+
+    if (!event_bus_subscribe(EVENT_DISPLAY_READY, bench_callback)) {
+        LOG_E(TAG, "Subscribe failed");
+        return;
+    }
+
+    hal_mem_disable_caches();
+    uint32_t bus_off = bench_event_bus();
+    uint32_t crc_off = bench_crc16();
+    uint32_t flash_off = bench_fetch(checksum_flash);
+    uint32_t itcm_off = bench_fetch(checksum_itcm);
+
+    hal_mem_enable_caches();
+    uint32_t bus_on = bench_event_bus();
+    uint32_t crc_on = bench_crc16();
+    uint32_t flash_on = bench_fetch(checksum_flash);
+    uint32_t itcm_on = bench_fetch(checksum_itcm);
+
+    event_bus_unsubscribe(EVENT_DISPLAY_READY, bench_callback);
+
+    LOG_I(TAG, "caches off: bus=%lu crc=%lu flash=%lu itcm=%lu", (unsigned long)bus_off,
+          (unsigned long)crc_off, (unsigned long)flash_off, (unsigned long)itcm_off);
+    LOG_I(TAG, "caches on:  bus=%lu crc=%lu flash=%lu itcm=%lu", (unsigned long)bus_on,
+          (unsigned long)crc_on, (unsigned long)flash_on, (unsigned long)itcm_on);
+}
@@ -0,0 +1,23 @@
+/**
+ * @file mem_benchmark.h
+ * @brief Cache and TCM placement benchmark
+ */
+
+#ifndef MEM_BENCHMARK_H
+#define MEM_BENCHMARK_H
+
+/**
+ * @brief Run the memory placement benchmark
+ *
+ * Measures event_bus_process() and stm32_uart_crc16() in DWT cycles,
+ * first with I/D cache disabled, then enabled, and logs both results.
+ * The event bus queues and CRC16 table are in DTCM in both runs, so the
+ * "cache off" numbers show what TCM placement alone gives. The same loop
+ * run from flash and from ITCM shows the cost of the flash wait states.
+ *
+ * @note Call once from services_init(), from the highest-priority task,
+ *       so the dispatch tasks do not drain the benchmark events.
+ */
+void mem_benchmark_run(void);
+
+#endif // MEM_BENCHMARK_H
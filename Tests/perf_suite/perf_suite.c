@@ -0,0 +1,333 @@
+/**
+ * @file perf_suite.c
+ * @brief On-target performance regression suite
+ *
+ * Output (RTT), one line per case, averaged over the case's rounds:
+ *   PERF: <case>: cycles/op=<n> ops/s=<n>
+ *   PERF: <case>: n/a                      (peripheral missing or init failed)
+ *
+ * Cases and what one op is:
+ *   bus_1sub, bus_5sub    one publish until all subscribers ran
+ *   rb_push, rb_read      one sample (read in chunks of PERF_RB_READ_CHUNK)
+ *   crc_64/256/512        one CRC16 over the payload (crc16_ccitt())
+ *   crc_hw_512            same on the CRC peripheral, if available
+ *   frame_parse           one 128-byte frame through the RX parser
+ *   lcd_fill              one ST7735 full-screen fill (at ST7735_SPI_MAX_HZ)
+ *   lcd_fill_div2..16     same with SCK = PCLK / 2..16; a case that tears
+ *                         or hangs marks a clock the panel cannot take
+ *   ina226_read           one blocking read of all INA226 registers
+ *
+ * Diff the log between firmware versions to catch regressions; the
+ * numbers only compare on the same clock and cache configuration.
+ */
+
+#include "perf_suite.h"
+#include "../../OS/event_bus.h"
+#include "../../Utils/sensor_ring_buffer.h"
+#include "../../Utils/crc16.h"
+#include "../../HAL/hal_crc.h"
+#include "../../HAL/hal_delay.h"
+#include "../../Middleware/Features/esp32_packet_framing.h"
+#include "../../Middleware/Services/serv_current_monitor.h"
+#include "../../Drivers_BSP/Custom/ips_display.h"
+#include "../../Drivers_BSP/External/ST7735/st7735.h"
+#include "../../Drivers_BSP/Custom/portable_log.h"
+
+static const char *TAG = "PERF";
+
+#define PERF_BUS_EVENTS         1000
+#define PERF_BUS_EVENT          EVENT_DISPLAY_READY     // Nothing else subscribes
+#define PERF_BUS_MAX_SUBS       5
+#define PERF_BUS_WAIT_CYCLES    (hal_get_cpu_freq_hz() / 100)   // 10 ms per event
+
+#define PERF_RB_CAPACITY        512
+#define PERF_RB_SAMPLES         2048
+#define PERF_RB_READ_CHUNK      64
+
+#define PERF_CRC_ROUNDS         100
+#define PERF_CRC_MAX_LENGTH     512
+
+#define PERF_FRAME_PAYLOAD      128
+#define PERF_FRAME_COUNT        500
+
+#define PERF_LCD_FILLS          10
+#define PERF_INA226_READS       100
+
+static volatile uint32_t bus_delivered;
+static volatile uint32_t frames_delivered;
+static volatile int32_t bench_sink;
+
+static uint8_t bench_data[PERF_CRC_MAX_LENGTH];
+static uint8_t bench_wire[STM32_UART_MAX_PACKET_SIZE];
+static sensor_sample_t read_chunk[PERF_RB_READ_CHUNK];
+
+static void report(const char *name, uint32_t cycles, uint32_t ops)
+{
+    if (ops == 0) {
+        LOG_W(TAG, "%s: n/a", name);
+        return;
+    }
+
+    uint32_t per_op = cycles / ops;
+    uint32_t ops_per_s = (per_op > 0) ? hal_get_cpu_freq_hz() / per_op : 0;
+    LOG_I(TAG, "%s: cycles/op=%lu ops/s=%lu", name, (unsigned long)per_op,
+          (unsigned long)ops_per_s);
+}
+
+// ============================================================================
+// Event Bus
+// ============================================================================
+
+static void bus_handler(event_t *event)
+{
+    (void)event;
+    bus_delivered++;
+}
+
+// Distinct functions: the bus ignores a second subscription of the same callback
+static void bus_handler_1(event_t *event) { bus_handler(event); }
+static void bus_handler_2(event_t *event) { bus_handler(event); }
+static void bus_handler_3(event_t *event) { bus_handler(event); }
+static void bus_handler_4(event_t *event) { bus_handler(event); }
+
+static const event_callback_t bus_handlers[PERF_BUS_MAX_SUBS] = {
+    bus_handler, bus_handler_1, bus_handler_2, bus_handler_3, bus_handler_4,
+};
+
+/**
+ * @brief Publish one event at a time and wait until every subscriber ran
+ *
+ * With the dispatch tasks running the callbacks run there; otherwise this
+ * task dispatches with event_bus_process().
+ */
+static void bench_bus(const char *name, uint32_t subscribers)
+{
+    uint32_t payload = 0;
+    uint32_t delivered_events = 0;
+    bool dispatch_task = event_bus_is_dispatch_task_running();
+
+    for (uint32_t i = 0; i < subscribers; i++) {
+        event_bus_subscribe(PERF_BUS_EVENT, bus_handlers[i]);
+    }
+    bus_delivered = 0;
+
+    uint32_t start = hal_get_cycle_count();
+    for (uint32_t i = 0; i < PERF_BUS_EVENTS; i++) {
+        payload = i;
+        if (!event_bus_publish(PERF_BUS_EVENT, &payload, sizeof(payload))) {
+            break;
+        }
+
+        uint32_t expected = (i + 1) * subscribers;
+        if (!dispatch_task) {
+            event_bus_process();
+        }
+        uint32_t wait_start = hal_get_cycle_count();
+        while (bus_delivered < expected
+               && hal_get_cycle_count() - wait_start < PERF_BUS_WAIT_CYCLES) {
+        }
+        if (bus_delivered < expected) {
+            LOG_E(TAG, "%s: event %lu not delivered", name, (unsigned long)i);
+            break;
+        }
+        delivered_events++;
+    }
+    uint32_t cycles = hal_get_cycle_count() - start;
+
+    for (uint32_t i = 0; i < subscribers; i++) {
+        event_bus_unsubscribe(PERF_BUS_EVENT, bus_handlers[i]);
+    }
+    report(name, cycles, delivered_events);
+}
+
+// ============================================================================
+// Ring Buffer
+// ============================================================================
+
+static void bench_ring_buffer(void)
+{
+    sensor_ring_buffer_t rb = {0};
+    sensor_ring_buffer_config_t config = sensor_ring_buffer_get_default_config();
+    config.capacity = PERF_RB_CAPACITY;
+
+    if (sensor_ring_buffer_init(&rb, &config) != SENSOR_RING_BUFFER_OK) {
+        report("rb_push", 0, 0);
+        report("rb_read", 0, 0);
+        return;
+    }
+
+    sensor_sample_t sample = { .sensor_type = SENSOR_TEMPERATURE, .timestamp = 0, .value = 0 };
+
+    uint32_t start = hal_get_cycle_count();
+    for (uint32_t i = 0; i < PERF_RB_SAMPLES; i++) {
+        sample.value = (int32_t)i;
+        sensor_ring_buffer_push(&rb, &sample);
+    }
+    report("rb_push", hal_get_cycle_count() - start, PERF_RB_SAMPLES);
+
+    uint32_t count = sensor_ring_buffer_get_count(&rb);
+    start = hal_get_cycle_count();
+    for (uint32_t i = 0; i < count; i += PERF_RB_READ_CHUNK) {
+        uint32_t read = 0;
+        sensor_ring_buffer_read(&rb, i, read_chunk, PERF_RB_READ_CHUNK, &read);
+        bench_sink += read_chunk[0].value;
+    }
+    report("rb_read", hal_get_cycle_count() - start, count);
+
+    sensor_ring_buffer_deinit(&rb);
+}
+
+// ============================================================================
+// CRC16
+// ============================================================================
+
+static void bench_crc(void)
+{
+    static const size_t lengths[] = { 64, 256, 512 };
+    static const char *const names[] = { "crc_64", "crc_256", "crc_512" };
+    uint16_t crc = 0;
+
+    crc16_init();
+
+    for (uint32_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        uint32_t start = hal_get_cycle_count();
+        for (uint32_t round = 0; round < PERF_CRC_ROUNDS; round++) {
+            crc = crc16_ccitt(CRC16_CCITT_INIT, bench_data, lengths[i]);
+        }
+        report(names[i], hal_get_cycle_count() - start, PERF_CRC_ROUNDS);
+    }
+
+    if (!hal_crc_is_available()) {
+        report("crc_hw_512", 0, 0);
+        return;
+    }
+
+    uint32_t start = hal_get_cycle_count();
+    for (uint32_t round = 0; round < PERF_CRC_ROUNDS; round++) {
+        crc = hal_crc_ccitt16(CRC16_CCITT_INIT, bench_data, PERF_CRC_MAX_LENGTH);
+    }
+    report("crc_hw_512", hal_get_cycle_count() - start, PERF_CRC_ROUNDS);
+    bench_sink += crc;
+}
+
+// ============================================================================
+// Framing
+// ============================================================================
+
+static void frame_callback(stm32_uart_event_t *event, void *user_data)
+{
+    (void)user_data;
+
+    if (event->type == STM32_UART_EVENT_PACKET_RECEIVED) {
+        frames_delivered++;
+    }
+}
+
+/**
+ * @brief Parse frames back to back, as fast as the parser takes them
+ */
+static void bench_framing(void)
+{
+    stm32_uart_config_t config = stm32_uart_get_default_config();
+    config.callback = frame_callback;
+    config.user_data = NULL;
+
+    if (stm32_uart_init(&config) != UART_DRV_OK) {
+        report("frame_parse", 0, 0);
+        return;
+    }
+
+    size_t length = stm32_uart_encode_frame(bench_data, PERF_FRAME_PAYLOAD,
+                                            bench_wire, sizeof(bench_wire));
+    frames_delivered = 0;
+
+    uint32_t start = hal_get_cycle_count();
+    for (uint32_t i = 0; i < PERF_FRAME_COUNT; i++) {
+        stm32_uart_inject_rx(bench_wire, length);
+    }
+    uint32_t cycles = hal_get_cycle_count() - start;
+
+    if (frames_delivered != PERF_FRAME_COUNT) {
+        LOG_E(TAG, "frame_parse: %lu/%d frames delivered",
+              (unsigned long)frames_delivered, PERF_FRAME_COUNT);
+    }
+    report("frame_parse", cycles, frames_delivered);
+
+    stm32_uart_deinit();
+}
+
+// ============================================================================
+// Peripherals
+// ============================================================================
+
+static void bench_lcd_fill(void)
+{
+    // Opens the panel if the display service has not yet; an open panel is kept
+    ips_display_open();
+
+    uint32_t start = hal_get_cycle_count();
+    for (uint32_t i = 0; i < PERF_LCD_FILLS; i++) {
+        ST7735_FillScreenFast((i & 1) ? ST7735_BLACK : ST7735_WHITE);
+    }
+    report("lcd_fill", hal_get_cycle_count() - start, PERF_LCD_FILLS);
+
+    // Same fills per prescaler, to find the fastest SCK this panel takes
+    static const struct {
+        const char *name;
+        hal_spi_prescaler_t prescaler;
+    } clocks[] = {
+        { "lcd_fill_div2", HAL_SPI_PRESCALER_2 },
+        { "lcd_fill_div4", HAL_SPI_PRESCALER_4 },
+        { "lcd_fill_div8", HAL_SPI_PRESCALER_8 },
+        { "lcd_fill_div16", HAL_SPI_PRESCALER_16 },
+    };
+    hal_spi_prescaler_t profile = ST7735_GetSpiPrescaler();
+    for (uint32_t c = 0; c < sizeof(clocks) / sizeof(clocks[0]); c++) {
+        ST7735_SetSpiPrescaler(clocks[c].prescaler);
+        LOG_I(TAG, "%s: SCK %lu Hz", clocks[c].name, (unsigned long)ST7735_GetSpiClockHz());
+        start = hal_get_cycle_count();
+        for (uint32_t i = 0; i < PERF_LCD_FILLS; i++) {
+            ST7735_FillScreenFast((i & 1) ? ST7735_BLACK : ST7735_WHITE);
+        }
+        report(clocks[c].name, hal_get_cycle_count() - start, PERF_LCD_FILLS);
+    }
+    ST7735_SetSpiPrescaler(profile);
+
+    // Reopen to redraw the background and labels the fills covered
+    ips_display_close();
+    ips_display_open();
+}
+
+static void bench_ina226_read(void)
+{
+    INA226_Data data;
+    uint32_t reads = 0;
+
+    uint32_t start = hal_get_cycle_count();
+    for (uint32_t i = 0; i < PERF_INA226_READS; i++) {
+        if (!current_monitor_get_instant_reading(&data)) {
+            break;
+        }
+        reads++;
+    }
+    report("ina226_read", hal_get_cycle_count() - start, reads);
+}
+
+void perf_suite_run(void)
+{
+    for (uint32_t i = 0; i < sizeof(bench_data); i++) {
+        bench_data[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    LOG_I(TAG, "Suite start (%lu Hz)", (unsigned long)hal_get_cpu_freq_hz());
+
+    bench_bus("bus_1sub", 1);
+    bench_bus("bus_5sub", PERF_BUS_MAX_SUBS);
+    bench_ring_buffer();
+    bench_crc();
+    bench_framing();
+    bench_lcd_fill();
+    bench_ina226_read();
+
+    LOG_I(TAG, "Suite done");
+}
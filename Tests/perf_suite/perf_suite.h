@@ -0,0 +1,20 @@
+/**
+ * @file perf_suite.h
+ * @brief On-target performance regression suite
+ */
+
+#ifndef PERF_SUITE_H
+#define PERF_SUITE_H
+
+/**
+ * @brief Time the hot paths and log cycles/op and ops/s for each
+ *
+ * Covers event bus publish-to-callback with 1 and 5 subscribers, ring
+ * buffer push/read, CRC16 over 64/256/512 B, framing parse of back-to-back
+ * frames, an ST7735 full-screen fill and an INA226 read. Initializes the
+ * packet framing layer with its own callback, so it must run before
+ * protocol_handler_init(), and before the sensor tasks start.
+ */
+void perf_suite_run(void);
+
+#endif // PERF_SUITE_H
@@ -0,0 +1,78 @@
+/**
+ * @file ring_buffer_benchmark.c
+ * @brief sensor_ring_buffer indexing micro-benchmark
+ *
+ * Output (RTT), cycles per sample:
+ *   RB_BENCH: mutex cap=455: push=<n> peek=<n> read=<n>
+ *   RB_BENCH: mutex cap=512: push=<n> peek=<n> read=<n>
+ *   RB_BENCH: spsc  cap=512: push=<n> peek=<n> read=<n>
+ */
+
+#include "ring_buffer_benchmark.h"
+#include "../../Utils/sensor_ring_buffer.h"
+#include "../../HAL/hal_delay.h"
+#include "../../Drivers_BSP/Custom/portable_log.h"
+
+static const char *TAG = "RB_BENCH";
+
+#define BENCH_SAMPLES       2048    // Pushes per run, wraps both buffers several times
+#define BENCH_READ_CHUNK    64
+
+static volatile int32_t bench_sink = 0;
+static sensor_sample_t read_chunk[BENCH_READ_CHUNK];
+
+/**
+ * @brief Benchmark one capacity/mode combination and log the result
+ */
+static void bench_buffer(uint32_t capacity, sensor_ring_buffer_mode_t mode)
+{
+    sensor_ring_buffer_t rb = {0};
+    sensor_ring_buffer_config_t config = sensor_ring_buffer_get_default_config();
+    config.capacity = capacity;
+    config.mode = mode;
+
+    if (sensor_ring_buffer_init(&rb, &config) != SENSOR_RING_BUFFER_OK) {
+        LOG_E(TAG, "Init failed (cap=%lu)", (unsigned long)capacity);
+        return;
+    }
+
+    sensor_sample_t sample = { .sensor_type = SENSOR_TEMPERATURE, .timestamp = 0, .value = 0 };
+
+    uint32_t start = hal_get_cycle_count();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        sample.value = (int32_t)i;
+        sensor_ring_buffer_push(&rb, &sample);
+    }
+    uint32_t push_cycles = (hal_get_cycle_count() - start) / BENCH_SAMPLES;
+
+    uint32_t count = sensor_ring_buffer_get_count(&rb);
+
+    start = hal_get_cycle_count();
+    for (uint32_t i = 0; i < count; i++) {
+        sensor_ring_buffer_peek(&rb, i, &sample);
+        bench_sink += sample.value;
+    }
+    uint32_t peek_cycles = (hal_get_cycle_count() - start) / count;
+
+    start = hal_get_cycle_count();
+    for (uint32_t i = 0; i < count; i += BENCH_READ_CHUNK) {
+        uint32_t read = 0;
+        sensor_ring_buffer_read(&rb, i, read_chunk, BENCH_READ_CHUNK, &read);
+        bench_sink += read_chunk[0].value;
+    }
+    uint32_t read_cycles = (hal_get_cycle_count() - start) / count;
+
+    sensor_ring_buffer_deinit(&rb);
+
+    LOG_I(TAG, "%s cap=%lu: push=%lu peek=%lu read=%lu",
+          (mode == SENSOR_RING_BUFFER_MODE_SPSC) ? "spsc " : "mutex",
+          (unsigned long)capacity, (unsigned long)push_cycles,
+          (unsigned long)peek_cycles, (unsigned long)read_cycles);
+}
+
+void ring_buffer_benchmark_run(void)
+{
+    bench_buffer(455, SENSOR_RING_BUFFER_MODE_MUTEX);
+    bench_buffer(512, SENSOR_RING_BUFFER_MODE_MUTEX);
+    bench_buffer(512, SENSOR_RING_BUFFER_MODE_SPSC);
+}
@@ -0,0 +1,24 @@
+/**
+ * @file ring_buffer_benchmark.h
+ * @brief sensor_ring_buffer indexing micro-benchmark
+ */
+
+#ifndef RING_BUFFER_BENCHMARK_H
+#define RING_BUFFER_BENCHMARK_H
+
+/**
+ * @brief Compare modulo and mask indexing in sensor_ring_buffer
+ *
+ * Pushes and peeks through a 455-sample buffer (the old default, indexed
+ * by division) and a 512-sample buffer (masked) in mutex mode, and through
+ * the 512-sample buffer in SPSC mode, which takes only powers of two. Logs
+ * the average DWT cycles per sample. Peek is used for the
+ * read side as it indexes one sample per call like the protocol's paged
+ * reads do.
+ *
+ * @note Allocates one buffer at a time (~4KB heap); call once from
+ *       services_init().
+ */
+void ring_buffer_benchmark_run(void);
+
+#endif // RING_BUFFER_BENCHMARK_H
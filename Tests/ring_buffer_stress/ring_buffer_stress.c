@@ -0,0 +1,338 @@
+/**
+ * @file ring_buffer_stress.c
+ * @brief sensor_ring_buffer concurrency stress and throughput benchmark
+ *
+ * Output (RTT), one line per case:
+ *   RB_STRESS: <case>: push=<n>/s read=<n>/s avg push=<n> read=<n> cyc worst push=<n> read=<n> us full=<n> ok
+ *   RB_STRESS: <case>: ... FAILED lost=<n> order=<n> missing=<n>
+ *
+ * Cases (consumer task at OS_PRIORITY_NORMAL):
+ *   mutex/hi     one producer task above the consumer
+ *   mutex/lo     one producer task below the consumer
+ *   mutex/2task  one producer above and one below
+ *   spsc/hi      as mutex/hi, lock-free
+ *   spsc/lo      as mutex/lo, lock-free
+ *   spsc/isr     the hal_timer compare interrupt as the producer
+ *
+ * Samples carry (producer << 24) | sequence. lost is the cursor's overrun
+ * count, order the samples out of sequence, missing pushed minus read.
+ */
+
+#include "ring_buffer_stress.h"
+#include "../../Utils/sensor_ring_buffer.h"
+#include "../../OS/os_wrapper.h"
+#include "../../HAL/hal_delay.h"
+#include "../../HAL/hal_timer.h"
+#include "../../Drivers_BSP/Custom/portable_log.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "RB_STRESS";
+
+#define RB_STRESS_CASE_MS           500
+#define RB_STRESS_CAPACITY          512
+#define RB_STRESS_READ_CHUNK        32
+#define RB_STRESS_ISR_PERIOD_US     10
+#define RB_STRESS_TASK_STACK        1024
+#define RB_STRESS_EXIT_TIMEOUT_MS   1000
+#define RB_STRESS_PRODUCERS         3       // Two tasks and the ISR
+#define RB_STRESS_ISR_PRODUCER      2
+// Producers wait below this lag, so even all of them at once cannot
+// overwrite (SPSC holds capacity - 1)
+#define RB_STRESS_LAG_LIMIT         (RB_STRESS_CAPACITY - 1U - RB_STRESS_PRODUCERS)
+
+typedef struct {
+    const char *name;
+    sensor_ring_buffer_mode_t mode;
+    uint8_t producer_priority[2];   // Task producers, 0 = not used
+    bool isr_producer;
+} stress_case_t;
+
+static const stress_case_t cases[] = {
+    { "mutex/hi",    SENSOR_RING_BUFFER_MODE_MUTEX, { OS_PRIORITY_HIGH, 0 },             false },
+    { "mutex/lo",    SENSOR_RING_BUFFER_MODE_MUTEX, { OS_PRIORITY_LOW, 0 },              false },
+    { "mutex/2task", SENSOR_RING_BUFFER_MODE_MUTEX, { OS_PRIORITY_HIGH, OS_PRIORITY_LOW }, false },
+    { "spsc/hi",     SENSOR_RING_BUFFER_MODE_SPSC,  { OS_PRIORITY_HIGH, 0 },             false },
+    { "spsc/lo",     SENSOR_RING_BUFFER_MODE_SPSC,  { OS_PRIORITY_LOW, 0 },              false },
+    { "spsc/isr",    SENSOR_RING_BUFFER_MODE_SPSC,  { 0, 0 },                            true  },
+};
+
+// Each written by its own producer only
+typedef struct {
+    uint32_t pushed;
+    uint64_t push_cycles;
+    uint32_t worst_cycles;
+    uint32_t full_waits;
+} producer_stats_t;
+
+typedef struct {
+    uint32_t received;
+    uint64_t read_cycles;
+    uint32_t worst_cycles;
+    uint32_t order_errors;
+    uint32_t expected[RB_STRESS_PRODUCERS];
+} consumer_stats_t;
+
+static sensor_ring_buffer_record_t storage[RB_STRESS_CAPACITY];
+static sensor_ring_buffer_t rb;
+static sensor_ring_buffer_cursor_t cursor;
+static sensor_sample_t read_chunk[RB_STRESS_READ_CHUNK];
+
+static producer_stats_t producers[RB_STRESS_PRODUCERS];
+static consumer_stats_t consumer;
+
+static volatile bool producers_stop = false;
+static volatile bool consumer_drain = false;    // Producers are gone: read to empty, then exit
+static volatile uint32_t producers_running = 0;
+static volatile uint32_t consumer_running = 0;
+
+// ============================================================================
+// Producers and Consumer
+// ============================================================================
+
+static void push_one(uint32_t id, sensor_ring_buffer_status_t (*push)(sensor_ring_buffer_t *,
+                                                                      const sensor_sample_t *))
+{
+    producer_stats_t *stats = &producers[id];
+    sensor_sample_t sample = {
+        .sensor_type = SENSOR_CURRENT,
+        .timestamp = stats->pushed,
+        .value = (int32_t)((id << 24) | (stats->pushed & 0xFFFFFFU)),
+    };
+
+    uint32_t start = hal_get_cycle_count();
+    sensor_ring_buffer_status_t status = push(&rb, &sample);
+    uint32_t cycles = hal_get_cycle_count() - start;
+
+    if (status != SENSOR_RING_BUFFER_OK) {
+        return;
+    }
+    stats->pushed++;
+    stats->push_cycles += cycles;
+    if (cycles > stats->worst_cycles) {
+        stats->worst_cycles = cycles;
+    }
+}
+
+static void producer_task(void *arg)
+{
+    uint32_t id = (uint32_t)(uintptr_t)arg;
+
+    while (!producers_stop) {
+        if (sensor_ring_buffer_cursor_lag(&cursor) >= RB_STRESS_LAG_LIMIT) {
+            producers[id].full_waits++;
+            os_delay_ms(1);
+            continue;
+        }
+        push_one(id, sensor_ring_buffer_push);
+    }
+
+    __atomic_fetch_sub(&producers_running, 1, __ATOMIC_RELEASE);
+    os_task_delete(NULL);
+}
+
+static void isr_producer(uint64_t timestamp_us, void *user_data)
+{
+    (void)timestamp_us;
+    (void)user_data;
+
+    // An ISR cannot wait: a full buffer skips this tick
+    if (sensor_ring_buffer_cursor_lag(&cursor) >= RB_STRESS_LAG_LIMIT) {
+        producers[RB_STRESS_ISR_PRODUCER].full_waits++;
+        return;
+    }
+    push_one(RB_STRESS_ISR_PRODUCER, sensor_ring_buffer_push_isr);
+}
+
+static void check_order(const sensor_sample_t *samples, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t value = (uint32_t)samples[i].value;
+        uint32_t id = value >> 24;
+        uint32_t sequence = value & 0xFFFFFFU;
+
+        if (id >= RB_STRESS_PRODUCERS) {
+            consumer.order_errors++;
+            continue;
+        }
+        if (sequence != (consumer.expected[id] & 0xFFFFFFU)) {
+            consumer.order_errors++;
+            consumer.expected[id] = sequence;   // Resynchronize, count each break once
+        }
+        consumer.expected[id]++;
+    }
+}
+
+static void consumer_task(void *arg)
+{
+    (void)arg;
+
+    for (;;) {
+        uint32_t count = 0;
+        uint32_t start = hal_get_cycle_count();
+        sensor_ring_buffer_cursor_read(&cursor, read_chunk, RB_STRESS_READ_CHUNK, &count);
+        uint32_t cycles = hal_get_cycle_count() - start;
+
+        if (count == 0) {
+            if (consumer_drain) {
+                break;
+            }
+            os_delay_ms(1);
+            continue;
+        }
+
+        consumer.received += count;
+        consumer.read_cycles += cycles;
+        if (cycles > consumer.worst_cycles) {
+            consumer.worst_cycles = cycles;
+        }
+        check_order(read_chunk, count);
+    }
+
+    __atomic_fetch_sub(&consumer_running, 1, __ATOMIC_RELEASE);
+    os_task_delete(NULL);
+}
+
+// ============================================================================
+// Cases
+// ============================================================================
+
+static bool wait_zero(volatile uint32_t *running)
+{
+    for (uint32_t waited = 0; waited < RB_STRESS_EXIT_TIMEOUT_MS; waited++) {
+        if (__atomic_load_n(running, __ATOMIC_ACQUIRE) == 0) {
+            return true;
+        }
+        os_delay_ms(1);
+    }
+    return false;
+}
+
+static uint32_t cycles_to_us(uint32_t cycles)
+{
+    return (uint32_t)((uint64_t)cycles * 1000000U / hal_get_cpu_freq_hz());
+}
+
+/**
+ * @brief Run one case and log it
+ * @return false if its tasks did not exit (the buffer is still in use)
+ */
+static bool run_case(const stress_case_t *c)
+{
+    sensor_ring_buffer_config_t config = sensor_ring_buffer_get_default_config();
+    config.sensor_type = SENSOR_CURRENT;
+    config.mode = c->mode;
+
+    memset(&rb, 0, sizeof(rb));
+    memset(&cursor, 0, sizeof(cursor));
+    memset(producers, 0, sizeof(producers));
+    memset(&consumer, 0, sizeof(consumer));
+    producers_stop = false;
+    consumer_drain = false;
+
+    if (sensor_ring_buffer_init_static(&rb, &config, storage, RB_STRESS_CAPACITY) !=
+            SENSOR_RING_BUFFER_OK ||
+        sensor_ring_buffer_cursor_attach(&rb, &cursor, "stress", false) != SENSOR_RING_BUFFER_OK) {
+        LOG_E(TAG, "%s: init failed", c->name);
+        return true;
+    }
+
+    consumer_running = 1;
+    if (os_task_create(consumer_task, "rb_cons", RB_STRESS_TASK_STACK, NULL, OS_PRIORITY_NORMAL,
+                       NULL) != OS_SUCCESS) {
+        LOG_E(TAG, "%s: consumer task failed", c->name);
+        sensor_ring_buffer_deinit(&rb);
+        return true;
+    }
+
+    uint32_t start_us = hal_timer_get_us();
+    uint32_t task_producers = 0;
+    for (uint32_t i = 0; i < 2; i++) {
+        if (c->producer_priority[i] == 0) {
+            continue;
+        }
+        __atomic_fetch_add(&producers_running, 1, __ATOMIC_RELAXED);
+        if (os_task_create(producer_task, "rb_prod", RB_STRESS_TASK_STACK, (void *)(uintptr_t)i,
+                           c->producer_priority[i], NULL) != OS_SUCCESS) {
+            __atomic_fetch_sub(&producers_running, 1, __ATOMIC_RELAXED);
+            LOG_E(TAG, "%s: producer task failed", c->name);
+            continue;
+        }
+        task_producers++;
+    }
+    bool isr_running = c->isr_producer &&
+                       hal_timer_start_periodic(RB_STRESS_ISR_PERIOD_US, isr_producer, NULL);
+
+    os_delay_ms(RB_STRESS_CASE_MS);
+    producers_stop = true;
+    if (isr_running) {
+        hal_timer_stop_periodic();
+    }
+    uint32_t elapsed_us = hal_timer_get_us() - start_us;
+
+    bool exited = wait_zero(&producers_running);
+    consumer_drain = true;
+    exited = wait_zero(&consumer_running) && exited;
+    if (!exited) {
+        LOG_E(TAG, "%s: tasks did not exit", c->name);
+        return false;
+    }
+
+    sensor_ring_buffer_cursor_stats_t cursor_stats;
+    sensor_ring_buffer_cursor_get_stats(&cursor, &cursor_stats);
+    sensor_ring_buffer_deinit(&rb);
+
+    if (task_producers == 0 && !isr_running) {
+        LOG_W(TAG, "%s: n/a", c->name);
+        return true;
+    }
+
+    uint32_t pushed = 0;
+    uint64_t push_cycles = 0;
+    uint32_t worst_push = 0;
+    uint32_t full_waits = 0;
+    for (uint32_t i = 0; i < RB_STRESS_PRODUCERS; i++) {
+        pushed += producers[i].pushed;
+        push_cycles += producers[i].push_cycles;
+        full_waits += producers[i].full_waits;
+        if (producers[i].worst_cycles > worst_push) {
+            worst_push = producers[i].worst_cycles;
+        }
+    }
+
+    uint32_t missing = pushed - consumer.received;
+    char verdict[48];
+    if (cursor_stats.overruns == 0 && consumer.order_errors == 0 && missing == 0) {
+        snprintf(verdict, sizeof(verdict), "ok");
+    } else {
+        snprintf(verdict, sizeof(verdict), "FAILED lost=%lu order=%lu missing=%lu",
+                 (unsigned long)cursor_stats.overruns, (unsigned long)consumer.order_errors,
+                 (unsigned long)missing);
+    }
+
+    LOG_I(TAG, "%s: push=%lu/s read=%lu/s avg push=%lu read=%lu cyc worst push=%lu read=%lu us full=%lu %s",
+          c->name, (unsigned long)((uint64_t)pushed * 1000000U / elapsed_us),
+          (unsigned long)((uint64_t)consumer.received * 1000000U / elapsed_us),
+          (unsigned long)(pushed > 0 ? push_cycles / pushed : 0),
+          (unsigned long)(consumer.received > 0 ? consumer.read_cycles / consumer.received : 0),
+          (unsigned long)cycles_to_us(worst_push), (unsigned long)cycles_to_us(consumer.worst_cycles),
+          (unsigned long)full_waits, verdict);
+    return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void ring_buffer_stress_run(void)
+{
+    LOG_I(TAG, "cap=%lu, %lu ms per case, lag limit %lu", (unsigned long)RB_STRESS_CAPACITY,
+          (unsigned long)RB_STRESS_CASE_MS, (unsigned long)RB_STRESS_LAG_LIMIT);
+
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        if (!run_case(&cases[i])) {
+            // Its tasks still use the buffer: no later case may reinit it
+            break;
+        }
+    }
+}
@@ -0,0 +1,29 @@
+/**
+ * @file ring_buffer_stress.h
+ * @brief sensor_ring_buffer concurrency stress and throughput benchmark
+ */
+
+#ifndef RING_BUFFER_STRESS_H
+#define RING_BUFFER_STRESS_H
+
+/**
+ * @brief Run producers and a consumer against both ring buffer modes
+ *
+ * Producer tasks above and below the consumer's priority (and for SPSC
+ * the hal_timer compare interrupt) push numbered samples while a consumer
+ * task drains them through a cursor. Producers hold back while the
+ * cursor's lag is near the capacity, so nothing may be overwritten: the
+ * consumer checks every producer's sequence for gaps and reordering, and
+ * the cursor's overrun count must stay at 0.
+ *
+ * Logs per case push and read samples/s, average cycles per push and per
+ * read sample, the longest single push and read call (mutex waits
+ * included), the producers' full waits, and ok or the errors found.
+ *
+ * @note Borrows the hal_timer compare and takes ~RB_STRESS_CASE_MS per
+ *       case; call once from services_init() while the service tasks are
+ *       held back (a boot benchmark).
+ */
+void ring_buffer_stress_run(void);
+
+#endif // RING_BUFFER_STRESS_H
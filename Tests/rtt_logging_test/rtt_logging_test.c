@@ -8,6 +8,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "stm32f7xx_hal.h"
+#include "fixed_format.h"
 #include <stdio.h>
 
 static const char *TAG = "RTT_TEST";
@@ -65,9 +66,13 @@ void rtt_test_performance(void)
     uint32_t end_time = HAL_GetTick();
     uint32_t duration = end_time - start_time;
     
-    SEGGER_RTT_printf(0, "RTT Performance: %lu messages in %lu ms (%.2f msg/sec)\n", 
-                      iterations, duration, 
-                      duration > 0 ? (float)iterations * 1000.0f / duration : 0.0f);
+    // SEGGER_RTT_printf has no %f: rate in hundredths, formatted as integers
+    char rate[16];
+    uint32_t rate_centi = duration > 0 ? (uint32_t)((uint64_t)iterations * 100000u / duration) : 0;
+    fixed_format_centi(rate, sizeof(rate), (int32_t)rate_centi, NULL);
+
+    SEGGER_RTT_printf(0, "RTT Performance: %lu messages in %lu ms (%s msg/sec)\n", 
+                      iterations, duration, rate);
 }
 
 /**
@@ -21,6 +21,7 @@
 
 #include "serv_uart_test.h"
 #include "../../HAL/hal_uart.h"
+#include "../../HAL/hal_mem.h"
 #include "../../OS/os_wrapper.h"
 #include "../../Drivers_BSP/Custom/portable_log.h"
 #include <string.h>
@@ -28,7 +29,7 @@
 static const char *TAG = "UART_TEST";
 
 // Static buffer for async transmission (must persist until TX_DONE)
-static uint8_t async_tx_buffer[512];
+static uint8_t async_tx_buffer[512] HAL_DMA_BUFFER;
 static volatile bool async_tx_ready = true;
 
 /**
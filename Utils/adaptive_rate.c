@@ -0,0 +1,119 @@
+/**
+ * @file adaptive_rate.c
+ * @brief Sampling interval that follows a signal's activity
+ */
+
+#include "adaptive_rate.h"
+#include <stddef.h>
+#include <string.h>
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static bool is_active(const adaptive_rate_t *rate, uint32_t now_ms, int32_t value)
+{
+    const adaptive_rate_config_t *config = &rate->config;
+
+    if (config->rate_threshold != 0) {
+        uint32_t dt_ms = now_ms - rate->last_ms;
+        int64_t dv = (int64_t)value - rate->last_value;
+        uint64_t change = (uint64_t)((dv < 0) ? -dv : dv);
+        // |dv| / dt > threshold per second, without the division
+        if (change * 1000U > (uint64_t)config->rate_threshold * (dt_ms != 0 ? dt_ms : 1)) {
+            return true;
+        }
+    }
+
+    if (config->deviation_threshold != 0) {
+        float deviation = (float)value - rate->mean;
+        if (deviation < 0.0f) {
+            deviation = -deviation;
+        }
+        if (deviation > (float)config->deviation_threshold) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+void adaptive_rate_init(adaptive_rate_t *rate, const adaptive_rate_config_t *config)
+{
+    if (rate == NULL || config == NULL) {
+        return;
+    }
+
+    memset(rate, 0, sizeof(*rate));
+    rate->config = *config;
+    if (rate->config.max_interval_ms < rate->config.min_interval_ms) {
+        rate->config.max_interval_ms = rate->config.min_interval_ms;
+    }
+    if (rate->config.quiet_steps == 0) {
+        rate->config.quiet_steps = 1;
+    }
+    rate->interval_ms = rate->config.min_interval_ms;
+}
+
+uint32_t adaptive_rate_update(adaptive_rate_t *rate, uint32_t now_ms, int32_t value)
+{
+    if (rate == NULL) {
+        return 0;
+    }
+
+    rate->stats.readings++;
+
+    if (!rate->primed) {
+        rate->primed = true;
+        rate->mean = (float)value;
+    } else if (is_active(rate, now_ms, value)) {
+        rate->stats.active++;
+        rate->interval_ms = rate->config.min_interval_ms;
+        rate->quiet = 0;
+    } else if (++rate->quiet >= rate->config.quiet_steps) {
+        rate->quiet = 0;
+        if (rate->interval_ms < rate->config.max_interval_ms) {
+            uint32_t doubled = rate->interval_ms * 2U;
+            rate->interval_ms = (doubled < rate->config.max_interval_ms && doubled > rate->interval_ms)
+                                ? doubled : rate->config.max_interval_ms;
+            rate->stats.backoffs++;
+        }
+    }
+
+    rate->mean += ((float)value - rate->mean) / (float)ADAPTIVE_RATE_MEAN_WEIGHT;
+    rate->last_value = value;
+    rate->last_ms = now_ms;
+
+    return rate->interval_ms;
+}
+
+uint32_t adaptive_rate_get_interval(const adaptive_rate_t *rate)
+{
+    return (rate != NULL) ? rate->interval_ms : 0;
+}
+
+void adaptive_rate_reset(adaptive_rate_t *rate)
+{
+    if (rate == NULL) {
+        return;
+    }
+    rate->primed = false;
+    rate->quiet = 0;
+    rate->interval_ms = rate->config.min_interval_ms;
+}
+
+void adaptive_rate_get_stats(const adaptive_rate_t *rate, adaptive_rate_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    if (rate == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = rate->stats;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file adaptive_rate.h
+ * @brief Sampling interval that follows a signal's activity
+ *
+ * Fed with every reading, it picks the interval until the next one: the
+ * shortest as soon as the signal moves, doubling towards the longest while
+ * it stays quiet. A reading counts as activity when the rate of change
+ * since the previous reading, or its distance from a running mean
+ * (exponential, 1/ADAPTIVE_RATE_MEAN_WEIGHT per reading), exceeds the
+ * thresholds. Speeding up is immediate, backing off takes quiet_steps
+ * quiet readings per doubling, so a transient is caught at its start and
+ * a settled signal costs a reading every max_interval.
+ *
+ * There is no locking inside; the owner serializes every call.
+ *
+ * Usage example:
+ * @code
+ * // 0.25-10 s; busy above 0.05 C/s or 0.2 C off the mean (centi-degrees)
+ * static const adaptive_rate_config_t config = {
+ *     .min_interval_ms = 250, .max_interval_ms = 10000,
+ *     .rate_threshold = 5, .deviation_threshold = 20, .quiet_steps = 5,
+ * };
+ * adaptive_rate_t rate;
+ * adaptive_rate_init(&rate, &config);
+ *
+ * // With every reading
+ * uint32_t next_ms = adaptive_rate_update(&rate, now_ms, value);
+ * @endcode
+ */
+
+#ifndef ADAPTIVE_RATE_H
+#define ADAPTIVE_RATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define ADAPTIVE_RATE_MEAN_WEIGHT   8       // Readings the running mean spans
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Bounds and thresholds, in the signal's own units
+ */
+typedef struct {
+    uint32_t min_interval_ms;       /**< Interval while active */
+    uint32_t max_interval_ms;       /**< Interval when settled */
+    uint32_t rate_threshold;        /**< |change| per second that counts as activity, 0 = not used */
+    uint32_t deviation_threshold;   /**< |value - mean| that counts as activity, 0 = not used */
+    uint8_t quiet_steps;            /**< Quiet readings per doubling of the interval (0 = 1) */
+} adaptive_rate_config_t;
+
+/**
+ * @brief Counters (free-running)
+ */
+typedef struct {
+    uint32_t readings;
+    uint32_t active;                /**< Readings that counted as activity */
+    uint32_t backoffs;              /**< Interval doublings */
+} adaptive_rate_stats_t;
+
+/**
+ * @brief Sampler state
+ *
+ * All fields are private - use API functions to access.
+ */
+typedef struct {
+    adaptive_rate_config_t config;
+    uint32_t interval_ms;
+    bool primed;                    /**< A previous reading is known */
+    int32_t last_value;
+    uint32_t last_ms;
+    float mean;
+    uint8_t quiet;                  /**< Quiet readings since the last change of interval */
+    adaptive_rate_stats_t stats;
+} adaptive_rate_t;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * @brief Initialize, starting at the shortest interval
+ *
+ * @param rate Sampler
+ * @param config Bounds and thresholds (copied); max below min is raised to min
+ */
+void adaptive_rate_init(adaptive_rate_t *rate, const adaptive_rate_config_t *config);
+
+/**
+ * @brief Take a reading into account
+ *
+ * @param rate Sampler
+ * @param now_ms Time of the reading
+ * @param value The reading
+ * @return Interval until the next reading, ms
+ */
+uint32_t adaptive_rate_update(adaptive_rate_t *rate, uint32_t now_ms, int32_t value);
+
+/**
+ * @brief Interval until the next reading, ms
+ */
+uint32_t adaptive_rate_get_interval(const adaptive_rate_t *rate);
+
+/**
+ * @brief Back to the shortest interval, forgetting the history
+ */
+void adaptive_rate_reset(adaptive_rate_t *rate);
+
+/**
+ * @brief Get the counters
+ */
+void adaptive_rate_get_stats(const adaptive_rate_t *rate, adaptive_rate_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ADAPTIVE_RATE_H
@@ -0,0 +1,150 @@
+/**
+ * @file cobs.c
+ * @brief COBS encoder/decoder implementation
+ */
+
+#include "cobs.h"
+#include "hal_mem.h"
+#include <string.h>
+
+// ============================================================================
+// Encoder
+// ============================================================================
+
+void cobs_encoder_init(cobs_encoder_t *enc, uint8_t *dst, size_t capacity)
+{
+    enc->dst = dst;
+    enc->capacity = capacity;
+    enc->code_pos = 0;
+    enc->pos = 1;           // Slot 0 is reserved for the first code byte
+    enc->code = 1;
+    enc->overflow = (capacity < 2);
+}
+
+/**
+ * @brief Write the pending code byte and open a new block
+ */
+static void encoder_close_block(cobs_encoder_t *enc)
+{
+    enc->dst[enc->code_pos] = enc->code;
+    enc->code_pos = enc->pos++;
+    enc->code = 1;
+}
+
+void cobs_encoder_write(cobs_encoder_t *enc, const uint8_t *data, size_t length)
+{
+    for (size_t i = 0; i < length && !enc->overflow; i++) {
+        if (enc->pos >= enc->capacity) {
+            enc->overflow = true;
+            break;
+        }
+
+        if (data[i] == COBS_DELIMITER) {
+            encoder_close_block(enc);
+        } else {
+            enc->dst[enc->pos++] = data[i];
+            if (++enc->code == 0xFF) {
+                if (enc->pos >= enc->capacity) {
+                    enc->overflow = true;
+                    break;
+                }
+                encoder_close_block(enc);
+            }
+        }
+    }
+}
+
+size_t cobs_encoder_finish(cobs_encoder_t *enc)
+{
+    if (enc->overflow || enc->pos >= enc->capacity) {
+        return 0;
+    }
+
+    enc->dst[enc->code_pos] = enc->code;
+    enc->dst[enc->pos++] = COBS_DELIMITER;
+    return enc->pos;
+}
+
+// ============================================================================
+// Decoder
+// ============================================================================
+
+void cobs_decoder_init(cobs_decoder_t *dec, uint8_t *dst, size_t capacity)
+{
+    dec->dst = dst;
+    dec->capacity = capacity;
+    cobs_decoder_reset(dec);
+}
+
+void cobs_decoder_reset(cobs_decoder_t *dec)
+{
+    dec->length = 0;
+    dec->remaining = 0;
+    dec->code = 0;
+    dec->error = false;
+}
+
+HAL_ITCM_FUNC cobs_decode_result_t cobs_decoder_feed(cobs_decoder_t *dec, const uint8_t *data,
+                                                     size_t length, size_t *consumed)
+{
+    size_t i = 0;
+
+    while (i < length) {
+        uint8_t byte = data[i];
+
+        if (byte == COBS_DELIMITER) {
+            *consumed = i + 1;
+            if (!dec->error && dec->code == 0) {
+                return COBS_DECODE_EMPTY;
+            }
+            // A frame must end exactly at a block boundary
+            if (dec->error || dec->remaining != 0) {
+                return COBS_DECODE_ERROR;
+            }
+            return COBS_DECODE_FRAME;
+        }
+
+        if (dec->error) {
+            // Skip to the delimiter in one step
+            const uint8_t *end = memchr(&data[i], COBS_DELIMITER, length - i);
+            i = (end != NULL) ? (size_t)(end - data) : length;
+            continue;
+        }
+
+        if (dec->remaining == 0) {
+            // Code byte: emit the zero implied by the previous block
+            if (dec->code != 0 && dec->code != 0xFF) {
+                if (dec->length >= dec->capacity) {
+                    dec->error = true;
+                    continue;
+                }
+                dec->dst[dec->length++] = 0x00;
+            }
+            dec->code = byte;
+            dec->remaining = (uint8_t)(byte - 1);
+            i++;
+            continue;
+        }
+
+        // Block data: copy up to the end of the block or the next delimiter
+        size_t chunk = dec->remaining;
+        if (chunk > length - i) {
+            chunk = length - i;
+        }
+        const uint8_t *end = memchr(&data[i], COBS_DELIMITER, chunk);
+        if (end != NULL) {
+            chunk = (size_t)(end - &data[i]);
+        }
+        if (dec->length + chunk > dec->capacity) {
+            dec->error = true;
+            continue;
+        }
+        memcpy(&dec->dst[dec->length], &data[i], chunk);
+        dec->length += chunk;
+        dec->remaining = (uint8_t)(dec->remaining - chunk);
+        i += chunk;
+    }
+
+    *consumed = length;
+    return COBS_DECODE_MORE;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file cobs.h
+ * @brief Consistent Overhead Byte Stuffing (COBS) encoder/decoder
+ *
+ * COBS removes every 0x00 from a frame so 0x00 can delimit frames on the
+ * wire. A receiver resynchronizes at the next 0x00, whatever was corrupted.
+ * Overhead is at most 1 byte per 254 bytes of data (COBS_MAX_ENCODED_SIZE).
+ *
+ * Both sides are incremental so frames can be built from several pieces
+ * and decoded straight from DMA spans.
+ *
+ * Usage example:
+ * @code
+ * cobs_encoder_t enc;
+ * cobs_encoder_init(&enc, wire, sizeof(wire));
+ * cobs_encoder_write(&enc, payload, payload_len);
+ * cobs_encoder_write(&enc, crc_bytes, 2);
+ * size_t wire_len = cobs_encoder_finish(&enc);   // Includes the 0x00 delimiter
+ * @endcode
+ */
+
+#ifndef COBS_H
+#define COBS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define COBS_DELIMITER              0x00
+
+/**
+ * @brief Worst-case wire size for 'n' data bytes, including the delimiter
+ */
+#define COBS_MAX_ENCODED_SIZE(n)    ((n) + ((n) / 254) + 2)
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Incremental encoder state
+ */
+typedef struct {
+    uint8_t *dst;           /**< Output buffer */
+    size_t capacity;        /**< Output buffer size */
+    size_t code_pos;        /**< Position of the pending code byte */
+    size_t pos;             /**< Next write position */
+    uint8_t code;           /**< Current block length + 1 */
+    bool overflow;          /**< Output buffer too small */
+} cobs_encoder_t;
+
+/**
+ * @brief Decoder result for one input span
+ */
+typedef enum {
+    COBS_DECODE_MORE = 0,   /**< Span consumed, frame not complete yet */
+    COBS_DECODE_FRAME,      /**< Delimiter reached, frame complete */
+    COBS_DECODE_ERROR,      /**< Delimiter reached, frame malformed or too large */
+    COBS_DECODE_EMPTY,      /**< Delimiter with no frame before it (idle or keep-alive fill) */
+} cobs_decode_result_t;
+
+/**
+ * @brief Incremental decoder state
+ */
+typedef struct {
+    uint8_t *dst;           /**< Output buffer */
+    size_t capacity;        /**< Output buffer size */
+    size_t length;          /**< Decoded bytes so far */
+    uint8_t remaining;      /**< Data bytes left in the current block */
+    uint8_t code;           /**< Code byte of the current block (0 = none yet) */
+    bool error;             /**< Discarding until the next delimiter */
+} cobs_decoder_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void cobs_encoder_init(cobs_encoder_t *enc, uint8_t *dst, size_t capacity);
+void cobs_encoder_write(cobs_encoder_t *enc, const uint8_t *data, size_t length);
+
+/**
+ * @brief Close the frame and append the delimiter
+ * @return Encoded length including the delimiter, 0 if the buffer overflowed
+ */
+size_t cobs_encoder_finish(cobs_encoder_t *enc);
+
+void cobs_decoder_init(cobs_decoder_t *dec, uint8_t *dst, size_t capacity);
+
+/**
+ * @brief Restart the decoder for the next frame (keeps the output buffer)
+ */
+void cobs_decoder_reset(cobs_decoder_t *dec);
+
+/**
+ * @brief Decode bytes from the wire
+ *
+ * Consumes input up to and including the first delimiter. On FRAME the
+ * decoded frame is dec->dst[0..dec->length); call cobs_decoder_reset()
+ * before feeding the rest of the span. A delimiter right after the
+ * previous one (or at the start) is EMPTY, which callers skip.
+ *
+ * @param dec Decoder
+ * @param data Wire bytes
+ * @param length Number of wire bytes
+ * @param consumed Output: number of input bytes consumed
+ * @return Decode result
+ */
+cobs_decode_result_t cobs_decoder_feed(cobs_decoder_t *dec, const uint8_t *data,
+                                       size_t length, size_t *consumed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COBS_H
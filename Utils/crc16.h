@@ -0,0 +1,85 @@
+/**
+ * @file crc16.h
+ * @brief Software CRC16-CCITT (poly 0x1021, init 0xFFFF, no reflection)
+ *
+ * Three implementations share one result:
+ * - crc16_ccitt_bytewise(): classic 256-entry table, one byte per step
+ * - crc16_ccitt_sliced():   slice-by-4/8, consumes 32-bit words per step
+ * - crc16_ccitt():          the one selected by CRC16_SLICES
+ *
+ * Usage example:
+ * @code
+ * crc16_init();                                  // Build slice tables once
+ * uint16_t crc = crc16_ccitt(CRC16_CCITT_INIT, data, length);
+ * @endcode
+ */
+
+#ifndef CRC16_H
+#define CRC16_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/**
+ * @brief Bytes consumed per step by crc16_ccitt(): 1 (table), 4 or 8
+ *
+ * Slicing needs CRC16_SLICES extra 512-byte tables, built by crc16_init().
+ */
+#ifndef CRC16_SLICES
+#define CRC16_SLICES        8
+#endif
+
+#define CRC16_CCITT_INIT    0xFFFF
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Build the slice-by-N tables (no-op when CRC16_SLICES is 1)
+ */
+void crc16_init(void);
+
+/**
+ * @brief CRC16-CCITT, one table lookup per byte
+ * @param crc Initial value (CRC16_CCITT_INIT, or a previous result to continue)
+ * @param data Data buffer
+ * @param length Data length
+ * @return Updated CRC
+ */
+uint16_t crc16_ccitt_bytewise(uint16_t crc, const uint8_t *data, size_t length);
+
+/**
+ * @brief CRC16-CCITT, CRC16_SLICES bytes per step (bytewise when CRC16_SLICES is 1)
+ * @param crc Initial value (CRC16_CCITT_INIT, or a previous result to continue)
+ * @param data Data buffer
+ * @param length Data length
+ * @return Updated CRC
+ */
+uint16_t crc16_ccitt_sliced(uint16_t crc, const uint8_t *data, size_t length);
+
+/**
+ * @brief CRC16-CCITT using the implementation selected by CRC16_SLICES
+ */
+static inline uint16_t crc16_ccitt(uint16_t crc, const uint8_t *data, size_t length)
+{
+#if CRC16_SLICES > 1
+    return crc16_ccitt_sliced(crc, data, length);
+#else
+    return crc16_ccitt_bytewise(crc, data, length);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CRC16_H
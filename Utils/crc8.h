@@ -0,0 +1,40 @@
+/**
+ * @file crc8.h
+ * @brief Software CRC8 (poly 0x31, init 0xFF, no reflection)
+ *
+ * The checksum used by the ATH25/AHT2x humidity sensors (also known as
+ * CRC-8/NRSC-5). Table driven: one lookup per byte, table in flash.
+ *
+ * Usage example:
+ * @code
+ * uint8_t crc = crc8_poly31(CRC8_POLY31_INIT, data, length);
+ * @endcode
+ */
+
+#ifndef CRC8_H
+#define CRC8_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRC8_POLY31         0x31
+#define CRC8_POLY31_INIT    0xFF
+
+/**
+ * @brief CRC8 poly 0x31, one table lookup per byte
+ * @param crc Initial value (CRC8_POLY31_INIT, or a previous result to continue)
+ * @param data Data buffer
+ * @param length Data length
+ * @return Updated CRC
+ */
+uint8_t crc8_poly31(uint8_t crc, const uint8_t *data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CRC8_H
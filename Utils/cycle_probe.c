@@ -0,0 +1,106 @@
+/**
+ * @file cycle_probe.c
+ * @brief Cycle-count probes for timing hot code regions
+ */
+
+#include "cycle_probe.h"
+#include "os_wrapper.h"
+#include "portable_log.h"
+#include <string.h>
+
+static const char *TAG = "PROBE";
+
+static const char *const probe_names[CYCLE_PROBE_COUNT] = {
+    [CYCLE_PROBE_EVENT_BUS_PROCESS]   = "event_bus_process",
+    [CYCLE_PROBE_UART_RX_BYTE]        = "rx_process_byte",
+    [CYCLE_PROBE_UART_SEND_PACKET]    = "stm32_uart_send_packet",
+    [CYCLE_PROBE_INA226_READ]         = "ina226_read",
+    [CYCLE_PROBE_ST7735_WRITE_STRING] = "ST7735_WriteString",
+};
+
+#if CYCLE_PROBE_ENABLE
+static cycle_probe_stats_t probes[CYCLE_PROBE_COUNT];
+#endif
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+void cycle_probe_record(cycle_probe_id_t id, uint32_t cycles)
+{
+#if CYCLE_PROBE_ENABLE
+    if (id >= CYCLE_PROBE_COUNT) {
+        return;
+    }
+
+    cycle_probe_stats_t *probe = &probes[id];
+    uint32_t mask = os_critical_enter();
+    if (probe->count == 0 || cycles < probe->min_cycles) {
+        probe->min_cycles = cycles;
+    }
+    if (cycles > probe->max_cycles) {
+        probe->max_cycles = cycles;
+    }
+    probe->count++;
+    probe->total_cycles += cycles;
+    os_critical_exit(mask);
+#else
+    (void)id;
+    (void)cycles;
+#endif
+}
+
+bool cycle_probe_get(cycle_probe_id_t id, cycle_probe_stats_t *stats)
+{
+#if CYCLE_PROBE_ENABLE
+    if (id >= CYCLE_PROBE_COUNT || stats == NULL) {
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    *stats = probes[id];
+    os_critical_exit(mask);
+    return true;
+#else
+    (void)id;
+    (void)stats;
+    return false;
+#endif
+}
+
+const char *cycle_probe_name(cycle_probe_id_t id)
+{
+    return (id < CYCLE_PROBE_COUNT) ? probe_names[id] : "?";
+}
+
+void cycle_probe_reset(void)
+{
+#if CYCLE_PROBE_ENABLE
+    uint32_t mask = os_critical_enter();
+    memset(probes, 0, sizeof(probes));
+    os_critical_exit(mask);
+#endif
+}
+
+void cycle_probe_dump(void)
+{
+#if CYCLE_PROBE_ENABLE
+    uint32_t cycles_per_us = hal_get_cpu_freq_hz() / 1000000U;
+    cycle_probe_stats_t stats;
+
+    LOG_I(TAG, "=== Cycle Probes (%lu cycles/us) ===", (unsigned long)cycles_per_us);
+
+    for (uint32_t id = 0; id < CYCLE_PROBE_COUNT; id++) {
+        if (!cycle_probe_get((cycle_probe_id_t)id, &stats) || stats.count == 0) {
+            continue;
+        }
+
+        LOG_I(TAG, "%s: n=%lu min=%lu avg=%lu max=%lu cycles", probe_names[id],
+              (unsigned long)stats.count, (unsigned long)stats.min_cycles,
+              (unsigned long)(stats.total_cycles / stats.count),
+              (unsigned long)stats.max_cycles);
+    }
+#else
+    LOG_W(TAG, "Cycle probes unavailable. Set CYCLE_PROBE_ENABLE=1");
+#endif
+}
@@ -0,0 +1,116 @@
+/**
+ * @file cycle_probe.h
+ * @brief Cycle-count probes for timing hot code regions
+ *
+ * A probe brackets a region with CYCLE_PROBE_BEGIN / CYCLE_PROBE_END and
+ * accumulates count, min, max and total DWT cycles in a static table, one
+ * entry per cycle_probe_id_t. Recording costs two counter reads and a few
+ * instructions with interrupts masked, so probes can sit in ISR paths.
+ * With CYCLE_PROBE_ENABLE 0 the macros expand to nothing.
+ *
+ * Results are printed with cycle_probe_dump() (part of the performance
+ * report) and returned to the host by CMD_GET_PROBES.
+ *
+ * Usage example:
+ * @code
+ * CYCLE_PROBE_BEGIN(CYCLE_PROBE_INA226_READ);
+ * status = read_registers(sensor, data);
+ * CYCLE_PROBE_END(CYCLE_PROBE_INA226_READ);
+ * @endcode
+ */
+
+#ifndef CYCLE_PROBE_H
+#define CYCLE_PROBE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_delay.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#ifndef CYCLE_PROBE_ENABLE
+#define CYCLE_PROBE_ENABLE      1
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Probe points; the values are part of the CMD_GET_PROBES format
+ */
+typedef enum {
+    CYCLE_PROBE_EVENT_BUS_PROCESS = 0,  /**< One dispatch pass over the queued events */
+    CYCLE_PROBE_UART_RX_BYTE,           /**< Host link receive state machine, per byte */
+    CYCLE_PROBE_UART_SEND_PACKET,       /**< stm32_uart_send_packet(), including the wait */
+    CYCLE_PROBE_INA226_READ,            /**< ina226_read() */
+    CYCLE_PROBE_ST7735_WRITE_STRING,    /**< ST7735_WriteString() */
+    CYCLE_PROBE_COUNT
+} cycle_probe_id_t;
+
+/**
+ * @brief Accumulated timing of one probe
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min_cycles;            /**< 0 while count is 0 */
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+} cycle_probe_stats_t;
+
+// ============================================================================
+// Probe Macros
+// ============================================================================
+
+#if CYCLE_PROBE_ENABLE
+// Begin and end must be in the same scope
+#define CYCLE_PROBE_BEGIN(id) \
+    const uint32_t cycle_probe_start_##id = hal_get_cycle_count()
+#define CYCLE_PROBE_END(id) \
+    cycle_probe_record((id), hal_get_cycle_count() - cycle_probe_start_##id)
+#else
+#define CYCLE_PROBE_BEGIN(id)   do {} while (0)
+#define CYCLE_PROBE_END(id)     do {} while (0)
+#endif
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Add one measurement (task or ISR context)
+ */
+void cycle_probe_record(cycle_probe_id_t id, uint32_t cycles);
+
+/**
+ * @brief Read a probe's statistics
+ * @return false for an invalid id or with probes compiled out
+ */
+bool cycle_probe_get(cycle_probe_id_t id, cycle_probe_stats_t *stats);
+
+/**
+ * @brief Probe name for reports
+ */
+const char *cycle_probe_name(cycle_probe_id_t id);
+
+/**
+ * @brief Clear all probes
+ */
+void cycle_probe_reset(void);
+
+/**
+ * @brief Log every probe that has measurements
+ */
+void cycle_probe_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CYCLE_PROBE_H
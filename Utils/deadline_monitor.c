@@ -0,0 +1,300 @@
+/**
+ * @file deadline_monitor.c
+ * @brief Lateness and execution time of periodic work, with miss events
+ */
+
+#include "deadline_monitor.h"
+#include "os_wrapper.h"
+#include "event_bus.h"
+#include "hal_timer.h"
+#include "portable_log.h"
+#include <string.h>
+
+static const char *TAG = "DEADLINE";
+
+static const char *const deadline_names[DEADLINE_COUNT] = {
+    [DEADLINE_CURRENT_SAMPLE] = "current_sample",
+    [DEADLINE_STREAM_0]       = "stream_0",
+    [DEADLINE_STREAM_1]       = "stream_1",
+    [DEADLINE_DISPLAY_CHART]  = "display_chart",
+    [DEADLINE_CURRENT_TASK]   = "current_task",
+    [DEADLINE_TEMPERATURE_TASK] = "temperature_task",
+    [DEADLINE_SERVICES_LOOP]  = "services_loop",
+};
+
+#if DEADLINE_MONITOR_ENABLE
+typedef struct {
+    deadline_stats_t stats;
+    bool registered;
+    bool running;               // Begun, not ended yet
+    bool event_sent;            // last_event_us is valid
+    uint32_t release_us;
+    uint32_t begin_us;
+    uint32_t lateness_us;       // Of the running job
+    uint32_t unreported;        // Misses since the last event
+    uint32_t last_event_us;
+} deadline_entry_t;
+
+static deadline_entry_t entries[DEADLINE_COUNT];
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static uint32_t hist_bucket(uint32_t us)
+{
+    if (us < 2U) {
+        return 0;
+    }
+    uint32_t bucket = 31U - (uint32_t)__builtin_clz(us);
+    return (bucket < DEADLINE_HIST_BUCKETS) ? bucket : DEADLINE_HIST_BUCKETS - 1U;
+}
+
+/**
+ * @brief Count a miss (interrupts masked); true if an event is due
+ */
+static bool count_miss(deadline_entry_t *entry, uint32_t misses, uint32_t now)
+{
+    entry->stats.misses += misses;
+    entry->unreported += misses;
+    if (entry->event_sent && now - entry->last_event_us < DEADLINE_EVENT_MIN_INTERVAL_US) {
+        return false;
+    }
+    entry->event_sent = true;
+    entry->last_event_us = now;
+    return true;
+}
+
+static void publish_miss(deadline_id_t id, uint32_t misses, uint32_t lateness_us, uint32_t exec_us)
+{
+    deadline_miss_event_t event = {
+        .id = (uint8_t)id,
+        .misses = misses,
+        .lateness_us = lateness_us,
+        .exec_us = exec_us,
+    };
+    if (os_in_isr()) {
+        event_bus_publish_from_isr(EVENT_DEADLINE_MISSED, &event, sizeof(event));
+    } else {
+        event_bus_publish(EVENT_DEADLINE_MISSED, &event, sizeof(event));
+    }
+}
+#endif
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+bool deadline_monitor_register(deadline_id_t id, uint32_t period_us, uint32_t budget_us)
+{
+#if DEADLINE_MONITOR_ENABLE
+    if (id >= DEADLINE_COUNT || period_us == 0) {
+        return false;
+    }
+
+    deadline_entry_t *entry = &entries[id];
+    uint32_t mask = os_critical_enter();
+    memset(entry, 0, sizeof(*entry));
+    entry->stats.period_us = period_us;
+    entry->stats.budget_us = budget_us;
+    entry->registered = true;
+    os_critical_exit(mask);
+    return true;
+#else
+    (void)id;
+    (void)period_us;
+    (void)budget_us;
+    return false;
+#endif
+}
+
+void deadline_monitor_unregister(deadline_id_t id)
+{
+#if DEADLINE_MONITOR_ENABLE
+    if (id >= DEADLINE_COUNT) {
+        return;
+    }
+
+    uint32_t mask = os_critical_enter();
+    entries[id].registered = false;
+    entries[id].running = false;
+    os_critical_exit(mask);
+#else
+    (void)id;
+#endif
+}
+
+void deadline_monitor_begin(deadline_id_t id, uint32_t release_us)
+{
+#if DEADLINE_MONITOR_ENABLE
+    if (id >= DEADLINE_COUNT || !entries[id].registered) {
+        return;
+    }
+
+    deadline_entry_t *entry = &entries[id];
+    uint32_t now = hal_timer_get_us();
+    uint32_t misses = 0;
+    uint32_t missed_lateness = 0;
+
+    uint32_t mask = os_critical_enter();
+    if (entry->running) {
+        // Released again before the last job ended
+        misses++;
+        missed_lateness = entry->lateness_us;
+    }
+
+    if ((int32_t)(now - release_us) < 0) {
+        release_us = now;       // Woken early: the deadline counts from now
+    }
+    uint32_t lateness = now - release_us;
+
+    deadline_stats_t *stats = &entry->stats;
+    stats->lateness_hist[hist_bucket(lateness)]++;
+    if (lateness > stats->lateness_max_us) {
+        stats->lateness_max_us = lateness;
+    }
+    entry->release_us = release_us;
+    entry->begin_us = now;
+    entry->lateness_us = lateness;
+    entry->running = true;
+
+    bool publish = false;
+    uint32_t unreported = 0;
+    if (misses > 0) {
+        publish = count_miss(entry, misses, now);
+        unreported = entry->unreported;
+        if (publish) {
+            entry->unreported = 0;
+        }
+    }
+    os_critical_exit(mask);
+
+    if (publish) {
+        publish_miss(id, unreported, missed_lateness, 0);
+    }
+#else
+    (void)id;
+    (void)release_us;
+#endif
+}
+
+void deadline_monitor_end(deadline_id_t id)
+{
+#if DEADLINE_MONITOR_ENABLE
+    if (id >= DEADLINE_COUNT || !entries[id].running) {
+        return;
+    }
+
+    deadline_entry_t *entry = &entries[id];
+    uint32_t now = hal_timer_get_us();
+    deadline_stats_t *stats = &entry->stats;
+
+    uint32_t mask = os_critical_enter();
+    uint32_t exec = now - entry->begin_us;
+    stats->jobs++;
+    stats->exec_total_us += exec;
+    stats->exec_hist[hist_bucket(exec)]++;
+    if (exec > stats->exec_max_us) {
+        stats->exec_max_us = exec;
+    }
+    if (exec > stats->budget_us) {
+        stats->overruns++;
+    }
+    entry->running = false;
+
+    bool publish = false;
+    uint32_t unreported = 0;
+    if (now - entry->release_us > stats->period_us) {
+        publish = count_miss(entry, 1, now);
+        unreported = entry->unreported;
+        if (publish) {
+            entry->unreported = 0;
+        }
+    }
+    uint32_t lateness = entry->lateness_us;
+    os_critical_exit(mask);
+
+    if (publish) {
+        publish_miss(id, unreported, lateness, exec);
+    }
+#else
+    (void)id;
+#endif
+}
+
+bool deadline_monitor_get(deadline_id_t id, deadline_stats_t *stats)
+{
+#if DEADLINE_MONITOR_ENABLE
+    if (id >= DEADLINE_COUNT || stats == NULL) {
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    *stats = entries[id].stats;
+    os_critical_exit(mask);
+    return true;
+#else
+    (void)id;
+    (void)stats;
+    return false;
+#endif
+}
+
+uint32_t deadline_monitor_percentile_us(const uint32_t *hist, uint32_t permille)
+{
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < DEADLINE_HIST_BUCKETS; i++) {
+        total += hist[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Smallest bucket with the share at or below it; the last one is open
+    uint32_t target = (uint32_t)(((uint64_t)total * permille + 999U) / 1000U);
+    uint32_t seen = 0;
+    for (uint32_t i = 0; i < DEADLINE_HIST_BUCKETS - 1U; i++) {
+        seen += hist[i];
+        if (seen >= target) {
+            return 1UL << (i + 1U);
+        }
+    }
+    return 1UL << (DEADLINE_HIST_BUCKETS - 1U);
+}
+
+const char *deadline_monitor_name(deadline_id_t id)
+{
+    return (id < DEADLINE_COUNT) ? deadline_names[id] : "?";
+}
+
+void deadline_monitor_dump(void)
+{
+#if DEADLINE_MONITOR_ENABLE
+    deadline_stats_t stats;
+
+    LOG_I(TAG, "=== Deadlines ===");
+
+    for (uint32_t id = 0; id < DEADLINE_COUNT; id++) {
+        if (!deadline_monitor_get((deadline_id_t)id, &stats) || stats.period_us == 0) {
+            continue;
+        }
+
+        LOG_I(TAG, "%s: period %lu us, budget %lu us, %lu jobs, %lu missed, %lu overrun",
+              deadline_names[id], (unsigned long)stats.period_us, (unsigned long)stats.budget_us,
+              (unsigned long)stats.jobs, (unsigned long)stats.misses, (unsigned long)stats.overruns);
+        if (stats.jobs == 0) {
+            continue;
+        }
+        LOG_I(TAG, "  late: p50<%lu p99<%lu max=%lu us  exec: p50<%lu p99<%lu avg=%lu max=%lu us",
+              (unsigned long)deadline_monitor_percentile_us(stats.lateness_hist, 500),
+              (unsigned long)deadline_monitor_percentile_us(stats.lateness_hist, 990),
+              (unsigned long)stats.lateness_max_us,
+              (unsigned long)deadline_monitor_percentile_us(stats.exec_hist, 500),
+              (unsigned long)deadline_monitor_percentile_us(stats.exec_hist, 990),
+              (unsigned long)(stats.exec_total_us / stats.jobs),
+              (unsigned long)stats.exec_max_us);
+    }
+#else
+    LOG_W(TAG, "Deadline monitor unavailable. Set DEADLINE_MONITOR_ENABLE=1");
+#endif
+}
@@ -0,0 +1,165 @@
+/**
+ * @file deadline_monitor.h
+ * @brief Lateness and execution time of periodic work, with miss events
+ *
+ * Each periodic activity has a fixed deadline_id_t. It registers its period
+ * and execution budget, then brackets every job with deadline_monitor_begin()
+ * and deadline_monitor_end():
+ *
+ *   lateness   begin - release (when the job was due to start)
+ *   execution  end - begin
+ *   miss       the job ends after release + period, or the next release
+ *              comes while it is still running (a skipped slot)
+ *   overrun    execution above the budget
+ *
+ * Lateness and execution time go into log2 histograms (bucket i counts
+ * values below 2^(i+1) us), so percentiles are bucket bounds. A miss
+ * publishes EVENT_DEADLINE_MISSED (deadline_miss_event_t), at most once
+ * per DEADLINE_EVENT_MIN_INTERVAL_US per activity; the event counts the
+ * misses since the last one.
+ *
+ * begin/end of one activity must not preempt each other: one task, or
+ * ISRs of one priority. Timestamps are hal_timer_get_us().
+ *
+ * Results are printed with deadline_monitor_dump() (part of the performance
+ * report) and returned to the host by CMD_GET_DEADLINES.
+ *
+ * Usage example:
+ * @code
+ * deadline_monitor_register(DEADLINE_DISPLAY_CHART, 20000, 10000);
+ * for (;;) {
+ *     uint32_t release_us = hal_timer_get_us() + 20000;
+ *     wait_up_to_ms(20);
+ *     deadline_monitor_begin(DEADLINE_DISPLAY_CHART, release_us);
+ *     do_work();
+ *     deadline_monitor_end(DEADLINE_DISPLAY_CHART);
+ * }
+ * @endcode
+ */
+
+#ifndef DEADLINE_MONITOR_H
+#define DEADLINE_MONITOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#ifndef DEADLINE_MONITOR_ENABLE
+#define DEADLINE_MONITOR_ENABLE         1
+#endif
+
+#define DEADLINE_HIST_BUCKETS           16      // Last bucket: 32.8 ms and more
+#define DEADLINE_EVENT_MIN_INTERVAL_US  100000U
+
+// deadline_monitor_begin() release for work scheduled on the ms tick
+#define DEADLINE_RELEASE_MS_AGO(ms)     (hal_timer_get_us() - (uint32_t)(ms) * 1000U)
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Monitored activities; the values are part of the CMD_GET_DEADLINES format
+ */
+typedef enum {
+    DEADLINE_CURRENT_SAMPLE = 0,    /**< Sample timer event -> INA226 read complete */
+    DEADLINE_STREAM_0,              /**< Stream session slot 0, one sample slot */
+    DEADLINE_STREAM_1,              /**< Stream session slot 1 */
+    DEADLINE_DISPLAY_CHART,         /**< Chart poll of the display render task */
+    DEADLINE_CURRENT_TASK,          /**< os_periodic_task "current" pass */
+    DEADLINE_TEMPERATURE_TASK,      /**< os_periodic_task "temperature" pass */
+    DEADLINE_SERVICES_LOOP,         /**< services_run() on the main loop period */
+    DEADLINE_COUNT
+} deadline_id_t;
+
+/**
+ * @brief Statistics of one activity since it was registered
+ */
+typedef struct {
+    uint32_t period_us;             /**< 0 if never registered */
+    uint32_t budget_us;
+    uint32_t jobs;                  /**< Completed begin/end pairs */
+    uint32_t misses;
+    uint32_t overruns;
+    uint32_t lateness_max_us;
+    uint32_t exec_max_us;
+    uint64_t exec_total_us;
+    uint32_t lateness_hist[DEADLINE_HIST_BUCKETS];
+    uint32_t exec_hist[DEADLINE_HIST_BUCKETS];
+} deadline_stats_t;
+
+/**
+ * @brief EVENT_DEADLINE_MISSED payload
+ */
+typedef struct {
+    uint8_t  id;                    /**< deadline_id_t */
+    uint32_t misses;                /**< Since the previous event of this activity */
+    uint32_t lateness_us;           /**< Of the job that missed */
+    uint32_t exec_us;               /**< 0 if it was still running at the next release */
+} deadline_miss_event_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Start monitoring an activity (again), clearing its statistics
+ * @param period_us Release interval; the deadline is the next release
+ * @param budget_us Execution time above which a job counts as overrun
+ * @return false for an invalid id, a zero period or with the monitor compiled out
+ */
+bool deadline_monitor_register(deadline_id_t id, uint32_t period_us, uint32_t budget_us);
+
+/**
+ * @brief Stop monitoring an activity; its statistics stay readable
+ */
+void deadline_monitor_unregister(deadline_id_t id);
+
+/**
+ * @brief A job starts
+ * @param release_us When it was due, hal_timer_get_us() time (a release in
+ *        the future, e.g. after an early wake-up, counts as on time)
+ */
+void deadline_monitor_begin(deadline_id_t id, uint32_t release_us);
+
+/**
+ * @brief The job started by the last deadline_monitor_begin() is done
+ */
+void deadline_monitor_end(deadline_id_t id);
+
+/**
+ * @brief Read an activity's statistics
+ * @return false for an invalid id or with the monitor compiled out
+ */
+bool deadline_monitor_get(deadline_id_t id, deadline_stats_t *stats);
+
+/**
+ * @brief Upper bound of the bucket holding the given share of a histogram
+ * @param permille 500 for the median, 990 for the 99th percentile
+ * @return Bound in us, 0 for an empty histogram
+ */
+uint32_t deadline_monitor_percentile_us(const uint32_t *hist, uint32_t permille);
+
+/**
+ * @brief Activity name for reports
+ */
+const char *deadline_monitor_name(deadline_id_t id);
+
+/**
+ * @brief Log every registered activity
+ */
+void deadline_monitor_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEADLINE_MONITOR_H
@@ -0,0 +1,150 @@
+/**
+ * @file dsp_kernels.c
+ * @brief Float signal kernels with the CMSIS-DSP contracts
+ */
+
+#include "dsp_kernels.h"
+#include <string.h>
+#include <math.h>
+
+#if DSP_KERNELS_USE_CMSIS_DSP
+
+#include "arm_math.h"
+
+void dsp_mean_f32(const float *src, uint32_t count, float *result)
+{
+    arm_mean_f32(src, count, result);
+}
+
+void dsp_rms_f32(const float *src, uint32_t count, float *result)
+{
+    arm_rms_f32(src, count, result);
+}
+
+void dsp_max_f32(const float *src, uint32_t count, float *result, uint32_t *index)
+{
+    arm_max_f32(src, count, result, index);
+}
+
+void dsp_fir_init_f32(dsp_fir_f32_t *fir, uint16_t num_taps, const float *coeffs,
+                      float *state, uint32_t block_size)
+{
+    _Static_assert(sizeof(dsp_fir_f32_t) == sizeof(arm_fir_instance_f32), "instance layout");
+    arm_fir_init_f32((arm_fir_instance_f32 *)fir, num_taps, coeffs, state, block_size);
+}
+
+void dsp_fir_f32(dsp_fir_f32_t *fir, const float *src, float *dst, uint32_t block_size)
+{
+    arm_fir_f32((const arm_fir_instance_f32 *)fir, src, dst, block_size);
+}
+
+#else
+
+// Four independent accumulators: each FPU add waits on its own chain only
+
+static float sum_f32(const float *src, uint32_t count)
+{
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    uint32_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        s0 += src[i];
+        s1 += src[i + 1];
+        s2 += src[i + 2];
+        s3 += src[i + 3];
+    }
+    for (; i < count; i++) {
+        s0 += src[i];
+    }
+    return (s0 + s1) + (s2 + s3);
+}
+
+void dsp_mean_f32(const float *src, uint32_t count, float *result)
+{
+    *result = (count > 0) ? sum_f32(src, count) / (float)count : 0.0f;
+}
+
+void dsp_rms_f32(const float *src, uint32_t count, float *result)
+{
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+    uint32_t i = 0;
+
+    if (count == 0) {
+        *result = 0.0f;
+        return;
+    }
+    for (; i + 4 <= count; i += 4) {
+        s0 += src[i] * src[i];
+        s1 += src[i + 1] * src[i + 1];
+        s2 += src[i + 2] * src[i + 2];
+        s3 += src[i + 3] * src[i + 3];
+    }
+    for (; i < count; i++) {
+        s0 += src[i] * src[i];
+    }
+    *result = sqrtf(((s0 + s1) + (s2 + s3)) / (float)count);
+}
+
+void dsp_max_f32(const float *src, uint32_t count, float *result, uint32_t *index)
+{
+    float best = (count > 0) ? src[0] : 0.0f;
+    uint32_t best_index = 0;
+
+    for (uint32_t i = 1; i < count; i++) {
+        if (src[i] > best) {
+            best = src[i];
+            best_index = i;
+        }
+    }
+    *result = best;
+    *index = best_index;
+}
+
+void dsp_fir_init_f32(dsp_fir_f32_t *fir, uint16_t num_taps, const float *coeffs,
+                      float *state, uint32_t block_size)
+{
+    fir->num_taps = num_taps;
+    fir->coeffs = coeffs;
+    fir->state = state;
+    memset(state, 0, (num_taps + block_size - 1) * sizeof(float));
+}
+
+void dsp_fir_f32(dsp_fir_f32_t *fir, const float *src, float *dst, uint32_t block_size)
+{
+    const uint32_t taps = fir->num_taps;
+    const float *coeffs = fir->coeffs;
+    float *state = fir->state;
+
+    // History (taps - 1 samples) is followed by the new block
+    memcpy(&state[taps - 1], src, block_size * sizeof(float));
+
+    uint32_t n = 0;
+    for (; n + 4 <= block_size; n += 4) {
+        // Four outputs share each coefficient load
+        float a0 = 0.0f, a1 = 0.0f, a2 = 0.0f, a3 = 0.0f;
+        const float *x = &state[n];
+        for (uint32_t k = 0; k < taps; k++) {
+            float c = coeffs[k];
+            a0 += c * x[k];
+            a1 += c * x[k + 1];
+            a2 += c * x[k + 2];
+            a3 += c * x[k + 3];
+        }
+        dst[n] = a0;
+        dst[n + 1] = a1;
+        dst[n + 2] = a2;
+        dst[n + 3] = a3;
+    }
+    for (; n < block_size; n++) {
+        float acc = 0.0f;
+        for (uint32_t k = 0; k < taps; k++) {
+            acc += coeffs[k] * state[n + k];
+        }
+        dst[n] = acc;
+    }
+
+    // Keep the last taps - 1 inputs for the next block
+    memmove(state, &state[block_size], (taps - 1) * sizeof(float));
+}
+
+#endif // DSP_KERNELS_USE_CMSIS_DSP
@@ -0,0 +1,79 @@
+/**
+ * @file dsp_kernels.h
+ * @brief Float signal kernels with the CMSIS-DSP contracts
+ *
+ * dsp_mean_f32(), dsp_rms_f32(), dsp_max_f32() and dsp_fir_f32() take the
+ * same arguments and produce the same results as arm_mean_f32(),
+ * arm_rms_f32(), arm_max_f32() and arm_fir_f32(). The built-in versions
+ * are unrolled by four with independent accumulators, which keeps the
+ * M7's FPU pipeline full; with DSP_KERNELS_USE_CMSIS_DSP set (and the
+ * CMSIS-DSP library linked) they forward to the library instead.
+ *
+ * Usage example:
+ * @code
+ * static float state[FIR_TAPS + BLOCK - 1];
+ * dsp_fir_f32_t fir;
+ * dsp_fir_init_f32(&fir, FIR_TAPS, coeffs, state, BLOCK);
+ * dsp_fir_f32(&fir, in, out, BLOCK);   // Call per block; history carries over
+ * @endcode
+ */
+
+#ifndef DSP_KERNELS_H
+#define DSP_KERNELS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef DSP_KERNELS_USE_CMSIS_DSP
+#define DSP_KERNELS_USE_CMSIS_DSP   0
+#endif
+
+/**
+ * @brief FIR filter instance (same layout as arm_fir_instance_f32)
+ */
+typedef struct {
+    uint16_t num_taps;
+    float *state;               /**< num_taps + block_size - 1 floats */
+    const float *coeffs;        /**< Time reversed: b[num_taps-1] .. b[0] */
+} dsp_fir_f32_t;
+
+/**
+ * @brief Arithmetic mean of a block
+ */
+void dsp_mean_f32(const float *src, uint32_t count, float *result);
+
+/**
+ * @brief Root mean square of a block
+ */
+void dsp_rms_f32(const float *src, uint32_t count, float *result);
+
+/**
+ * @brief Largest value of a block and its (first) index
+ */
+void dsp_max_f32(const float *src, uint32_t count, float *result, uint32_t *index);
+
+/**
+ * @brief Initialize a FIR filter (clears the history)
+ *
+ * @param fir Instance
+ * @param num_taps Number of coefficients
+ * @param coeffs Coefficients, time reversed
+ * @param state Work buffer of num_taps + block_size - 1 floats
+ * @param block_size Largest block passed to dsp_fir_f32()
+ */
+void dsp_fir_init_f32(dsp_fir_f32_t *fir, uint16_t num_taps, const float *coeffs,
+                      float *state, uint32_t block_size);
+
+/**
+ * @brief Filter a block (src and dst may not overlap)
+ */
+void dsp_fir_f32(dsp_fir_f32_t *fir, const float *src, float *dst, uint32_t block_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DSP_KERNELS_H
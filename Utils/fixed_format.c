@@ -0,0 +1,54 @@
+/**
+ * @file fixed_format.c
+ * @brief Integer formatting of fixed-point values
+ */
+
+#include "fixed_format.h"
+
+size_t fixed_format(char *buf, size_t size, int32_t value, uint8_t decimals, const char *suffix)
+{
+    // Sign, 10 digits, point, leading zeros of a value below one
+    char digits[FIXED_FORMAT_MAX_DECIMALS + 12];
+    size_t n = 0;
+
+    if (buf == NULL || size == 0) {
+        return 0;
+    }
+    buf[0] = '\0';
+    if (decimals > FIXED_FORMAT_MAX_DECIMALS) {
+        return 0;
+    }
+
+    // Magnitude as unsigned so INT32_MIN works
+    uint32_t magnitude = (value < 0) ? (0u - (uint32_t)value) : (uint32_t)value;
+
+    // Digits in reverse, at least one before the point
+    do {
+        if (n == decimals && decimals > 0) {
+            digits[n++] = '.';
+        }
+        digits[n++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0 || n <= decimals);
+    if (value < 0) {
+        digits[n++] = '-';
+    }
+
+    size_t len = 0;
+    while (n > 0) {
+        if (len + 1 >= size) {
+            buf[0] = '\0';
+            return 0;
+        }
+        buf[len++] = digits[--n];
+    }
+    while (suffix != NULL && *suffix) {
+        if (len + 1 >= size) {
+            buf[0] = '\0';
+            return 0;
+        }
+        buf[len++] = *suffix++;
+    }
+    buf[len] = '\0';
+    return len;
+}
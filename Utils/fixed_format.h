@@ -0,0 +1,52 @@
+/**
+ * @file fixed_format.h
+ * @brief Integer formatting of fixed-point values
+ *
+ * Formats a scaled integer (e.g. 2345 centi-degrees) as "23.45" plus an
+ * optional suffix without going through float printf: one division per
+ * digit, no locale, a few bytes of stack. Meant for the display and log
+ * paths, which already carry values as the protocol's scaled int32_t.
+ *
+ * Usage example:
+ * @code
+ * char text[16];
+ * fixed_format_centi(text, sizeof(text), -5, " C");     // "-0.05 C"
+ * @endcode
+ */
+
+#ifndef FIXED_FORMAT_H
+#define FIXED_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FIXED_FORMAT_MAX_DECIMALS   9
+
+/**
+ * @brief Format value / 10^decimals with exactly that many decimals
+ * @param buf Output, always terminated when size > 0
+ * @param size Output size including the terminator
+ * @param value Scaled value
+ * @param decimals Digits after the point, 0..FIXED_FORMAT_MAX_DECIMALS
+ * @param suffix Appended as is, may be NULL
+ * @return Length written, or 0 if it did not fit (buf is then empty)
+ */
+size_t fixed_format(char *buf, size_t size, int32_t value, uint8_t decimals, const char *suffix);
+
+/**
+ * @brief Format a centi-unit value ("23.45")
+ */
+static inline size_t fixed_format_centi(char *buf, size_t size, int32_t centi, const char *suffix)
+{
+    return fixed_format(buf, size, centi, 2, suffix);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIXED_FORMAT_H
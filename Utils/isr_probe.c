@@ -0,0 +1,131 @@
+/**
+ * @file isr_probe.c
+ * @brief Duration and latency of interrupt handlers
+ */
+
+#include "isr_probe.h"
+#include "os_wrapper.h"
+#include "portable_log.h"
+#include <string.h>
+
+static const char *TAG = "ISR";
+
+static const char *const probe_names[ISR_PROBE_COUNT] = {
+    [ISR_PROBE_UART_RX_DMA] = "DMA1_Stream5 (uart rx)",
+    [ISR_PROBE_UART_TX_DMA] = "DMA1_Stream6 (uart tx)",
+    [ISR_PROBE_USART2]      = "USART2",
+    [ISR_PROBE_UART_IDLE]   = "hal_uart_idle_isr",
+    [ISR_PROBE_TIMER_US]    = "TIM5 (us timer)",
+    [ISR_PROBE_EXTI]        = "EXTI15_10 (ina226 alert)",
+    [ISR_PROBE_I2C2_EV]     = "I2C2_EV",
+    [ISR_PROBE_I2C4_EV]     = "I2C4_EV",
+    [ISR_PROBE_STORAGE_DMA] = "DMA2_Stream1 (storage)",
+    [ISR_PROBE_DISPLAY_DMA] = "DMA2_Stream3 (display)",
+    [ISR_PROBE_USB]         = "OTG_FS",
+};
+
+#if ISR_PROBE_ENABLE
+static isr_probe_stats_t probes[ISR_PROBE_COUNT];
+#endif
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+void isr_probe_record(isr_probe_id_t id, uint32_t cycles)
+{
+#if ISR_PROBE_ENABLE
+    if (id >= ISR_PROBE_COUNT) {
+        return;
+    }
+
+    // Only this entry's vector writes it, and it cannot preempt itself
+    isr_probe_stats_t *probe = &probes[id];
+    if (cycles > probe->max_cycles) {
+        probe->max_cycles = cycles;
+    }
+    probe->count++;
+    probe->total_cycles += cycles;
+#else
+    (void)id;
+    (void)cycles;
+#endif
+}
+
+void isr_probe_latency(isr_probe_id_t id, uint32_t cycles)
+{
+#if ISR_PROBE_ENABLE
+    if (id >= ISR_PROBE_COUNT) {
+        return;
+    }
+
+    isr_probe_stats_t *probe = &probes[id];
+    if (cycles > probe->latency_max_cycles) {
+        probe->latency_max_cycles = cycles;
+    }
+    probe->latency_count++;
+    probe->latency_total_cycles += cycles;
+#else
+    (void)id;
+    (void)cycles;
+#endif
+}
+
+bool isr_probe_get(isr_probe_id_t id, isr_probe_stats_t *stats)
+{
+#if ISR_PROBE_ENABLE
+    if (id >= ISR_PROBE_COUNT || stats == NULL) {
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    *stats = probes[id];
+    os_critical_exit(mask);
+    return true;
+#else
+    (void)id;
+    (void)stats;
+    return false;
+#endif
+}
+
+const char *isr_probe_name(isr_probe_id_t id)
+{
+    return (id < ISR_PROBE_COUNT) ? probe_names[id] : "?";
+}
+
+void isr_probe_reset(void)
+{
+#if ISR_PROBE_ENABLE
+    uint32_t mask = os_critical_enter();
+    memset(probes, 0, sizeof(probes));
+    os_critical_exit(mask);
+#endif
+}
+
+void isr_probe_dump(void)
+{
+#if ISR_PROBE_ENABLE
+    uint32_t cycles_per_us = hal_get_cpu_freq_hz() / 1000000U;
+    isr_probe_stats_t stats;
+
+    LOG_I(TAG, "=== ISR Probes (%lu cycles/us) ===", (unsigned long)cycles_per_us);
+
+    for (uint32_t id = 0; id < ISR_PROBE_COUNT; id++) {
+        if (!isr_probe_get((isr_probe_id_t)id, &stats) || stats.count == 0) {
+            continue;
+        }
+
+        LOG_I(TAG, "%s: n=%lu avg=%lu max=%lu cycles", probe_names[id],
+              (unsigned long)stats.count, (unsigned long)(stats.total_cycles / stats.count),
+              (unsigned long)stats.max_cycles);
+        if (stats.latency_count != 0) {
+            LOG_I(TAG, "  latency: avg=%lu max=%lu cycles",
+                  (unsigned long)(stats.latency_total_cycles / stats.latency_count),
+                  (unsigned long)stats.latency_max_cycles);
+        }
+    }
+#else
+    LOG_W(TAG, "ISR probes unavailable. Set ISR_PROBE_ENABLE=1");
+#endif
+}
@@ -0,0 +1,139 @@
+/**
+ * @file isr_probe.h
+ * @brief Duration and latency of interrupt handlers
+ *
+ * hal_uart_get_isr_counters() says how often the UART interrupts fire, not
+ * how long they run. An ISR probe brackets a vector (or a part of one) with
+ * ISR_PROBE_ENTER / ISR_PROBE_EXIT and accumulates count, total and max DWT
+ * cycles per isr_probe_id_t, so growth of work such as hal_uart_idle_isr()
+ * shows up as a number in the performance report.
+ *
+ * Where the trigger carries a timestamp, the handler also reports how late
+ * it ran with isr_probe_latency(): the microsecond timer compares its TIM5
+ * counter against the compare value that fired it (1 us resolution).
+ *
+ * Durations are inclusive: a handler preempted by a higher-priority one
+ * counts that one's time too. Each entry is written only from its own
+ * vector, which cannot preempt itself, so recording takes no lock; reads
+ * and resets are masked. With ISR_PROBE_ENABLE 0 the macros expand to
+ * nothing.
+ *
+ * Usage example:
+ * @code
+ * void DMA1_Stream5_IRQHandler(void)
+ * {
+ *     ISR_PROBE_ENTER(ISR_PROBE_UART_RX_DMA);
+ *     HAL_DMA_IRQHandler(&hdma_usart2_rx);
+ *     ISR_PROBE_EXIT(ISR_PROBE_UART_RX_DMA);
+ * }
+ * @endcode
+ */
+
+#ifndef ISR_PROBE_H
+#define ISR_PROBE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_delay.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#ifndef ISR_PROBE_ENABLE
+#define ISR_PROBE_ENABLE        1
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Instrumented interrupt handlers; one vector writes each entry
+ */
+typedef enum {
+    ISR_PROBE_UART_RX_DMA = 0,      /**< DMA1_Stream5: host link RX ring half/complete */
+    ISR_PROBE_UART_TX_DMA,          /**< DMA1_Stream6: host link TX complete */
+    ISR_PROBE_USART2,               /**< USART2, HAL handler included */
+    ISR_PROBE_UART_IDLE,            /**< hal_uart_idle_isr(), the part of USART2 run first */
+    ISR_PROBE_TIMER_US,             /**< TIM5 microsecond timer; latency: compare to entry */
+    ISR_PROBE_EXTI,                 /**< EXTI15_10: INA226 ALERT */
+    ISR_PROBE_I2C2_EV,              /**< I2C2 event */
+    ISR_PROBE_I2C4_EV,              /**< I2C4 event */
+    ISR_PROBE_STORAGE_DMA,          /**< DMA2_Stream1: SPI4 TX */
+    ISR_PROBE_DISPLAY_DMA,          /**< DMA2_Stream3: SPI1 TX */
+    ISR_PROBE_USB,                  /**< OTG_FS */
+    ISR_PROBE_COUNT
+} isr_probe_id_t;
+
+/**
+ * @brief Accumulated timing of one handler
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    uint32_t latency_count;         /**< Entries with a latency, 0 without a timestamped trigger */
+    uint32_t latency_max_cycles;
+    uint64_t latency_total_cycles;
+} isr_probe_stats_t;
+
+// ============================================================================
+// Probe Macros
+// ============================================================================
+
+#if ISR_PROBE_ENABLE
+// Enter and exit must be in the same scope
+#define ISR_PROBE_ENTER(id) \
+    const uint32_t isr_probe_start_##id = hal_get_cycle_count()
+#define ISR_PROBE_EXIT(id) \
+    isr_probe_record((id), hal_get_cycle_count() - isr_probe_start_##id)
+#else
+#define ISR_PROBE_ENTER(id)     do {} while (0)
+#define ISR_PROBE_EXIT(id)      do {} while (0)
+#endif
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Add one handler run (from that handler)
+ */
+void isr_probe_record(isr_probe_id_t id, uint32_t cycles);
+
+/**
+ * @brief Add how late a handler started after its trigger (from that handler)
+ */
+void isr_probe_latency(isr_probe_id_t id, uint32_t cycles);
+
+/**
+ * @brief Read a handler's statistics
+ * @return false for an invalid id or with probes compiled out
+ */
+bool isr_probe_get(isr_probe_id_t id, isr_probe_stats_t *stats);
+
+/**
+ * @brief Handler name for reports
+ */
+const char *isr_probe_name(isr_probe_id_t id);
+
+/**
+ * @brief Clear all handlers
+ */
+void isr_probe_reset(void);
+
+/**
+ * @brief Log every handler that has run
+ */
+void isr_probe_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ISR_PROBE_H
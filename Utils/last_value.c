@@ -0,0 +1,70 @@
+/**
+ * @file last_value.c
+ * @brief Lock-free last-value cells (seqlock with two slots)
+ */
+
+#include "last_value.h"
+#include <string.h>
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+bool last_value_init(last_value_t *cell, void *slots, uint32_t size)
+{
+    if (cell == NULL || slots == NULL || size == 0) {
+        return false;
+    }
+
+    cell->sequence = 0;
+    cell->size = size;
+    cell->slots = (uint8_t *)slots;
+    return true;
+}
+
+void last_value_store(last_value_t *cell, const void *value)
+{
+    if (cell == NULL || value == NULL) {
+        return;
+    }
+
+    // Only the writer changes the sequence: a plain read is current
+    uint32_t next = cell->sequence + 1U;
+
+    memcpy(&cell->slots[(next & 1U) * cell->size], value, cell->size);
+
+    // The slot is complete before the new sequence publishes it
+    __atomic_store_n(&cell->sequence, next, __ATOMIC_RELEASE);
+}
+
+bool last_value_load(const last_value_t *cell, void *value)
+{
+    if (cell == NULL || value == NULL) {
+        return false;
+    }
+
+    uint32_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+
+    for (;;) {
+        if (sequence == 0) {
+            return false;
+        }
+
+        memcpy(value, &cell->slots[(sequence & 1U) * cell->size], cell->size);
+
+        // The copy is done before the sequence is read again
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        uint32_t again = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        if (again == sequence) {
+            return true;
+        }
+
+        // A store completed during the copy; the next may have reused our slot
+        sequence = again;
+    }
+}
+
+uint32_t last_value_sequence(const last_value_t *cell)
+{
+    return (cell != NULL) ? __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE) : 0;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file last_value.h
+ * @brief Lock-free last-value cells (seqlock with two slots)
+ *
+ * A cell holds the latest copy of a small value: one writer stores, any
+ * number of readers take consistent snapshots, and neither side locks or
+ * masks interrupts. Meant for state one context produces and others only
+ * look at (latest sensor reading, last measurement), where a mutex would
+ * cost more than the copy.
+ *
+ * The cell keeps two slots and a sequence count. A store fills the slot
+ * not published, then bumps the sequence, which publishes it; a load
+ * copies the published slot and retries if a store completed meanwhile.
+ * A reader that preempts the writer mid-store reads the previous value
+ * instead of waiting, so a high-priority reader never spins on a
+ * low-priority writer. Loads retry only when the writer (an ISR, or a
+ * task preempting the reader) finishes a store during the copy.
+ *
+ * Single writer: two contexts storing into one cell must serialize
+ * themselves. Values are copied bytewise; keep them to a few dozen bytes.
+ *
+ * Usage example:
+ * @code
+ * LAST_VALUE_DEFINE(reading, reading_t);
+ *
+ * // Writer (one task or ISR)
+ * last_value_store(&reading_value, &fresh);
+ *
+ * // Readers (anywhere)
+ * reading_t snapshot;
+ * if (last_value_load(&reading_value, &snapshot)) {
+ *     use(&snapshot);
+ * }
+ * @endcode
+ */
+
+#ifndef LAST_VALUE_H
+#define LAST_VALUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief One cell; define with LAST_VALUE_DEFINE() or set up with last_value_init()
+ */
+typedef struct {
+    volatile uint32_t sequence;     /**< Stores so far; slot (sequence & 1) is published */
+    uint32_t size;                  /**< Bytes per value */
+    uint8_t *slots;                 /**< Two values back to back */
+} last_value_t;
+
+/**
+ * @brief Define a static cell for values of 'type', named var##_value
+ */
+#define LAST_VALUE_DEFINE(var, type) \
+    static type var##_value_slots[2]; \
+    static last_value_t var##_value = { \
+        .size = sizeof(type), \
+        .slots = (uint8_t *)var##_value_slots, \
+    }
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Set up a cell over caller-provided storage of 2 * size bytes
+ * @return true on success
+ */
+bool last_value_init(last_value_t *cell, void *slots, uint32_t size);
+
+/**
+ * @brief Publish a new value
+ * @note NON-BLOCKING: from the cell's one writer (task or ISR)
+ */
+void last_value_store(last_value_t *cell, const void *value);
+
+/**
+ * @brief Copy the latest value
+ * @note NON-BLOCKING: from any task or ISR
+ * @return false if nothing was stored yet (value untouched)
+ */
+bool last_value_load(const last_value_t *cell, void *value);
+
+/**
+ * @brief Stores so far; a reader compares it to see whether the value changed
+ */
+uint32_t last_value_sequence(const last_value_t *cell);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LAST_VALUE_H
@@ -0,0 +1,196 @@
+/**
+ * @file latency_trace.c
+ * @brief Stage-by-stage latency of one current sample, INA226 to host link
+ */
+
+#include "latency_trace.h"
+#include "os_wrapper.h"
+#include "hal_timer.h"
+#include "portable_log.h"
+#include <string.h>
+
+#if defined(LATENCY_TRACE_GPIO_PORT) && defined(LATENCY_TRACE_GPIO_PIN)
+#include "hal_gpio.h"
+#include "pinout.h"
+#define TRACE_PIN_TOGGLE()  hal_gpio_toggle_pin(LATENCY_TRACE_GPIO_PORT, LATENCY_TRACE_GPIO_PIN)
+#else
+#define TRACE_PIN_TOGGLE()  do {} while (0)
+#endif
+
+static const char *TAG = "LATENCY";
+
+static const char *const stage_names[LATENCY_STAGE_COUNT] = {
+    [LATENCY_STAGE_TRIGGER]      = "end_to_end",
+    [LATENCY_STAGE_I2C_DONE]     = "i2c_done",
+    [LATENCY_STAGE_CAPTURE_PUSH] = "capture_push",
+    [LATENCY_STAGE_STREAM_FLUSH] = "stream_flush",
+    [LATENCY_STAGE_TX_DMA_START] = "tx_dma_start",
+    [LATENCY_STAGE_TX_DONE]      = "tx_done",
+};
+
+#if LATENCY_TRACE_ENABLE
+static latency_stage_stats_t stages[LATENCY_STAGE_COUNT];
+static uint32_t stamp_us[LATENCY_STAGE_COUNT];     // Of the running trace
+static uint32_t next_stage = LATENCY_STAGE_TRIGGER; // TRIGGER: no trace runs
+static uint32_t abandoned = 0;
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static uint32_t hist_bucket(uint32_t us)
+{
+    if (us < 2U) {
+        return 0;
+    }
+    uint32_t bucket = 31U - (uint32_t)__builtin_clz(us);
+    return (bucket < LATENCY_TRACE_HIST_BUCKETS) ? bucket : LATENCY_TRACE_HIST_BUCKETS - 1U;
+}
+
+static void record(latency_stage_stats_t *stats, uint32_t us)
+{
+    if (stats->count == 0 || us < stats->min_us) {
+        stats->min_us = us;
+    }
+    if (us > stats->max_us) {
+        stats->max_us = us;
+    }
+    stats->count++;
+    stats->total_us += us;
+    stats->hist[hist_bucket(us)]++;
+}
+
+// Interrupts masked: the trace is complete in stamp_us[]
+static void close_trace(void)
+{
+    for (uint32_t s = LATENCY_STAGE_I2C_DONE; s < LATENCY_STAGE_COUNT; s++) {
+        record(&stages[s], stamp_us[s] - stamp_us[s - 1U]);
+    }
+    record(&stages[LATENCY_STAGE_TRIGGER],
+           stamp_us[LATENCY_STAGE_TX_DONE] - stamp_us[LATENCY_STAGE_TRIGGER]);
+    next_stage = LATENCY_STAGE_TRIGGER;
+}
+#endif
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+void latency_trace_mark(latency_stage_t stage)
+{
+#if LATENCY_TRACE_ENABLE
+    if ((uint32_t)stage >= LATENCY_STAGE_COUNT) {
+        return;
+    }
+
+    uint32_t now = hal_timer_get_us();
+    uint32_t mask = os_critical_enter();
+
+    if (next_stage != LATENCY_STAGE_TRIGGER &&
+        now - stamp_us[LATENCY_STAGE_TRIGGER] > LATENCY_TRACE_TIMEOUT_US) {
+        abandoned++;
+        next_stage = LATENCY_STAGE_TRIGGER;
+    }
+
+    if ((uint32_t)stage != next_stage) {
+        os_critical_exit(mask);
+        return;
+    }
+
+    stamp_us[stage] = now;
+    if (stage == LATENCY_STAGE_TX_DONE) {
+        close_trace();
+    } else {
+        next_stage = (uint32_t)stage + 1U;
+    }
+    os_critical_exit(mask);
+
+    TRACE_PIN_TOGGLE();
+#else
+    (void)stage;
+#endif
+}
+
+bool latency_trace_get(latency_stage_t stage, latency_stage_stats_t *stats)
+{
+#if LATENCY_TRACE_ENABLE
+    if ((uint32_t)stage >= LATENCY_STAGE_COUNT || stats == NULL) {
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    *stats = stages[stage];
+    os_critical_exit(mask);
+    return true;
+#else
+    (void)stage;
+    (void)stats;
+    return false;
+#endif
+}
+
+uint32_t latency_trace_abandoned(void)
+{
+#if LATENCY_TRACE_ENABLE
+    return abandoned;
+#else
+    return 0;
+#endif
+}
+
+void latency_trace_reset(void)
+{
+#if LATENCY_TRACE_ENABLE
+    uint32_t mask = os_critical_enter();
+    memset(stages, 0, sizeof(stages));
+    next_stage = LATENCY_STAGE_TRIGGER;
+    abandoned = 0;
+    os_critical_exit(mask);
+#endif
+}
+
+const char *latency_trace_name(latency_stage_t stage)
+{
+    return ((uint32_t)stage < LATENCY_STAGE_COUNT) ? stage_names[stage] : "?";
+}
+
+#if LATENCY_TRACE_ENABLE
+// Upper bound of the bucket holding the given share; the last one is open
+static uint32_t percentile_us(const uint32_t *hist, uint32_t total, uint32_t permille)
+{
+    uint32_t target = (uint32_t)(((uint64_t)total * permille + 999U) / 1000U);
+    uint32_t seen = 0;
+    for (uint32_t i = 0; i < LATENCY_TRACE_HIST_BUCKETS - 1U; i++) {
+        seen += hist[i];
+        if (seen >= target) {
+            return 1UL << (i + 1U);
+        }
+    }
+    return 1UL << (LATENCY_TRACE_HIST_BUCKETS - 1U);
+}
+#endif
+
+void latency_trace_dump(void)
+{
+#if LATENCY_TRACE_ENABLE
+    latency_stage_stats_t stats;
+
+    LOG_I(TAG, "=== Sample Latency (%lu traces abandoned) ===", (unsigned long)abandoned);
+
+    // The stages in path order, then the total
+    for (uint32_t n = 1; n <= LATENCY_STAGE_COUNT; n++) {
+        latency_stage_t stage = (latency_stage_t)(n % LATENCY_STAGE_COUNT);
+        if (!latency_trace_get(stage, &stats) || stats.count == 0) {
+            continue;
+        }
+
+        LOG_I(TAG, "%s: n=%lu min=%lu avg=%lu max=%lu p50<%lu p99<%lu us", stage_names[stage],
+              (unsigned long)stats.count, (unsigned long)stats.min_us,
+              (unsigned long)(stats.total_us / stats.count), (unsigned long)stats.max_us,
+              (unsigned long)percentile_us(stats.hist, stats.count, 500),
+              (unsigned long)percentile_us(stats.hist, stats.count, 990));
+    }
+#else
+    LOG_W(TAG, "Latency trace unavailable. Set LATENCY_TRACE_ENABLE=1");
+#endif
+}
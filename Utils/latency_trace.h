@@ -0,0 +1,138 @@
+/**
+ * @file latency_trace.h
+ * @brief Stage-by-stage latency of one current sample, INA226 to host link
+ *
+ * Follows one sample at a time through the path from the conversion
+ * trigger to the end of the UART frame that carries it:
+ *
+ *   TRIGGER        INA226 ALERT edge, or the sample timer starting a read
+ *   I2C_DONE       the async register chain delivered the reading
+ *   CAPTURE_PUSH   the current monitor stored it in its capture buffer
+ *   STREAM_FLUSH   a current stream sent its batch (or single sample)
+ *   TX_DMA_START   the UART started DMA for the next segment
+ *   TX_DONE        the UART finished a frame
+ *
+ * A trigger while no trace runs starts one; every other stage counts only
+ * as the first mark after the stage before it, and TX_DONE closes the
+ * trace. Triggers during a trace are ignored, so under load one sample in
+ * many is followed. The marks are not tagged with the sample: with a
+ * backlog queued, STREAM_FLUSH and the TX stages are the next flush and
+ * frame after the sample got there, which may carry older samples. A
+ * trace that does not close within LATENCY_TRACE_TIMEOUT_US (no stream
+ * running, a transport other than the UART) is abandoned and counted.
+ *
+ * Each stage's time since the previous stage goes into min/avg/max and a
+ * log2 histogram (bucket i counts values below 2^(i+1) us); the TRIGGER
+ * entry holds the end-to-end time. Timestamps are hal_timer_get_us().
+ * With LATENCY_TRACE_GPIO_PORT/PIN defined, every counted mark also
+ * toggles that pin, so a logic analyser shows the same stages.
+ *
+ * Off by default: with LATENCY_TRACE_ENABLE 0 the marks expand to nothing.
+ * Results are printed with latency_trace_dump() (part of the performance
+ * report).
+ *
+ * Usage example:
+ * @code
+ * LATENCY_TRACE_MARK(LATENCY_STAGE_I2C_DONE);     // Task or ISR context
+ * @endcode
+ */
+
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#ifndef LATENCY_TRACE_ENABLE
+#define LATENCY_TRACE_ENABLE        0
+#endif
+
+#ifndef LATENCY_TRACE_TIMEOUT_US
+#define LATENCY_TRACE_TIMEOUT_US    2000000U    // Above the default stream flush deadline
+#endif
+
+#define LATENCY_TRACE_HIST_BUCKETS  18          // Last bucket: 131 ms and more
+
+// ============================================================================
+// Types
+// ============================================================================
+
+typedef enum {
+    LATENCY_STAGE_TRIGGER = 0,      /**< Starts a trace; its stats are end to end */
+    LATENCY_STAGE_I2C_DONE,
+    LATENCY_STAGE_CAPTURE_PUSH,
+    LATENCY_STAGE_STREAM_FLUSH,
+    LATENCY_STAGE_TX_DMA_START,
+    LATENCY_STAGE_TX_DONE,          /**< Closes the trace */
+    LATENCY_STAGE_COUNT
+} latency_stage_t;
+
+/**
+ * @brief Time from the previous stage, over all closed traces
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;                /**< 0 while count is 0 */
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t hist[LATENCY_TRACE_HIST_BUCKETS];
+} latency_stage_stats_t;
+
+// ============================================================================
+// Mark Macro
+// ============================================================================
+
+#if LATENCY_TRACE_ENABLE
+#define LATENCY_TRACE_MARK(stage)   latency_trace_mark(stage)
+#else
+#define LATENCY_TRACE_MARK(stage)   do {} while (0)
+#endif
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief A sample reached a stage (task or ISR context)
+ */
+void latency_trace_mark(latency_stage_t stage);
+
+/**
+ * @brief Read one stage's statistics
+ * @return false for an invalid stage or with the trace compiled out
+ */
+bool latency_trace_get(latency_stage_t stage, latency_stage_stats_t *stats);
+
+/**
+ * @brief Traces abandoned after LATENCY_TRACE_TIMEOUT_US
+ */
+uint32_t latency_trace_abandoned(void);
+
+/**
+ * @brief Clear all statistics and drop a running trace
+ */
+void latency_trace_reset(void);
+
+/**
+ * @brief Stage name for reports
+ */
+const char *latency_trace_name(latency_stage_t stage);
+
+/**
+ * @brief Log the per-stage distributions
+ */
+void latency_trace_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LATENCY_TRACE_H
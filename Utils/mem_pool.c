@@ -0,0 +1,162 @@
+/**
+ * @file mem_pool.c
+ * @brief Fixed-size block pools with O(1) alloc/free
+ */
+
+#include "mem_pool.h"
+#include "os_wrapper.h"
+#include "portable_log.h"
+#include <string.h>
+
+static const char *TAG = "MEM_POOL";
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+bool mem_pool_init(mem_pool_t *pool, const char *name, void *storage,
+                   uint32_t block_size, uint32_t block_count)
+{
+    if (pool == NULL || storage == NULL || block_count == 0 ||
+        ((uintptr_t)storage % MEM_POOL_ALIGN) != 0) {
+        return false;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    pool->name = name;
+    pool->storage = (uint8_t *)storage;
+    pool->block_size = (uint32_t)MEM_POOL_BLOCK_BYTES(block_size);
+    pool->block_count = block_count;
+    return true;
+}
+
+void mem_pool_reset(mem_pool_t *pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+
+    uint32_t mask = os_critical_enter();
+    pool->free_list = NULL;
+    pool->next_unused = 0;
+    pool->in_use = 0;
+    pool->high_water = 0;
+    pool->alloc_count = 0;
+    pool->free_count = 0;
+    pool->fail_count = 0;
+    os_critical_exit(mask);
+}
+
+void *mem_pool_alloc(mem_pool_t *pool)
+{
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    void *block = NULL;
+    uint32_t mask = os_critical_enter();
+
+    if (pool->free_list != NULL) {
+        block = pool->free_list;
+        pool->free_list = *(void **)block;
+    } else if (pool->next_unused < pool->block_count) {
+        block = pool->storage + pool->next_unused * pool->block_size;
+        pool->next_unused++;
+    }
+
+    if (block != NULL) {
+        pool->alloc_count++;
+        pool->in_use++;
+        if (pool->in_use > pool->high_water) {
+            pool->high_water = pool->in_use;
+        }
+    } else {
+        pool->fail_count++;
+    }
+
+    os_critical_exit(mask);
+    return block;
+}
+
+bool mem_pool_free(mem_pool_t *pool, void *block)
+{
+    if (mem_pool_block_index(pool, block) < 0) {
+        return false;
+    }
+
+    uint32_t mask = os_critical_enter();
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+    pool->free_count++;
+    if (pool->in_use > 0) {
+        pool->in_use--;
+    }
+    os_critical_exit(mask);
+    return true;
+}
+
+int32_t mem_pool_block_index(const mem_pool_t *pool, const void *block)
+{
+    if (pool == NULL || block == NULL) {
+        return -1;
+    }
+
+    const uint8_t *p = (const uint8_t *)block;
+    if (p < pool->storage || p >= pool->storage + pool->block_count * pool->block_size) {
+        return -1;
+    }
+
+    uint32_t offset = (uint32_t)(p - pool->storage);
+    if ((offset % pool->block_size) != 0) {
+        return -1;
+    }
+
+    return (int32_t)(offset / pool->block_size);
+}
+
+bool mem_pool_owns(const mem_pool_t *pool, const void *block)
+{
+    return mem_pool_block_index(pool, block) >= 0;
+}
+
+uint32_t mem_pool_free_blocks(const mem_pool_t *pool)
+{
+    if (pool == NULL) {
+        return 0;
+    }
+
+    return pool->block_count - pool->in_use;
+}
+
+void mem_pool_get_stats(const mem_pool_t *pool, mem_pool_stats_t *stats)
+{
+    if (pool == NULL || stats == NULL) {
+        return;
+    }
+
+    uint32_t mask = os_critical_enter();
+    stats->block_size = pool->block_size;
+    stats->block_count = pool->block_count;
+    stats->in_use = pool->in_use;
+    stats->high_water = pool->high_water;
+    stats->alloc_count = pool->alloc_count;
+    stats->free_count = pool->free_count;
+    stats->fail_count = pool->fail_count;
+    os_critical_exit(mask);
+}
+
+void mem_pool_dump(const mem_pool_t *pool)
+{
+    mem_pool_stats_t stats;
+
+    if (pool == NULL) {
+        return;
+    }
+
+    mem_pool_get_stats(pool, &stats);
+    LOG_I(TAG, "%s: %lu x %lu B, in use %lu, peak %lu, failed %lu",
+          (pool->name != NULL) ? pool->name : "?",
+          (unsigned long)stats.block_count, (unsigned long)stats.block_size,
+          (unsigned long)stats.in_use, (unsigned long)stats.high_water,
+          (unsigned long)stats.fail_count);
+}
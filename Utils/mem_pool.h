@@ -0,0 +1,166 @@
+/**
+ * @file mem_pool.h
+ * @brief Fixed-size block pools with O(1) alloc/free
+ *
+ * A pool hands out blocks of one size from a static array. Free blocks
+ * form a singly linked list threaded through the blocks themselves;
+ * blocks that were never used are taken from the end of the array, so a
+ * pool defined with MEM_POOL_DEFINE() needs no init call and costs nothing
+ * at boot. Alloc and free are a few instructions with interrupts masked,
+ * so both run in constant time and are safe from tasks and ISRs - unlike
+ * the heap, whose time depends on fragmentation.
+ *
+ * Each pool tracks blocks in use, its high-water mark and failed
+ * allocations; size a pool from the high-water mark after a soak run.
+ *
+ * Usage example:
+ * @code
+ * // 4 frames, placed in the non-cacheable DMA section
+ * MEM_POOL_DEFINE(frame, sizeof(frame_t), 4, HAL_DMA_BUFFER);
+ *
+ * frame_t *f = mem_pool_alloc(&frame_pool);
+ * if (f != NULL) {
+ *     fill(f);
+ *     send(f);
+ *     mem_pool_free(&frame_pool, f);
+ * }
+ * @endcode
+ */
+
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define MEM_POOL_ALIGN          8       // Block alignment (and size granularity)
+
+// Bytes one block of 'size' occupies (room for the free-list link included)
+#define MEM_POOL_BLOCK_BYTES(size) \
+    ((((size) < sizeof(void *) ? sizeof(void *) : (size)) + MEM_POOL_ALIGN - 1) & \
+     ~(size_t)(MEM_POOL_ALIGN - 1))
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Pool counters (snapshot)
+ */
+typedef struct {
+    uint32_t block_size;        /**< Bytes per block, rounded to MEM_POOL_ALIGN */
+    uint32_t block_count;
+    uint32_t in_use;            /**< Blocks allocated right now */
+    uint32_t high_water;        /**< Most blocks ever in use at once */
+    uint32_t alloc_count;       /**< Successful allocations */
+    uint32_t free_count;        /**< Blocks returned */
+    uint32_t fail_count;        /**< Allocations refused, pool empty */
+} mem_pool_stats_t;
+
+/**
+ * @brief One pool; define with MEM_POOL_DEFINE() or set up with mem_pool_init()
+ */
+typedef struct {
+    const char *name;
+    uint8_t *storage;
+    uint32_t block_size;
+    uint32_t block_count;
+    void *free_list;            /**< Returned blocks, linked through their first word */
+    uint32_t next_unused;       /**< Blocks from here on were never handed out */
+    uint32_t in_use;
+    uint32_t high_water;
+    uint32_t alloc_count;
+    uint32_t free_count;
+    uint32_t fail_count;
+} mem_pool_t;
+
+/**
+ * @brief Define a static pool named var##_pool
+ *
+ * Optional trailing arguments are attributes of the block storage (e.g.
+ * HAL_DMA_BUFFER for blocks a DMA reads).
+ */
+#define MEM_POOL_DEFINE(var, size, count, ...) \
+    static uint8_t var##_pool_storage[(count) * MEM_POOL_BLOCK_BYTES(size)] \
+        __attribute__((aligned(MEM_POOL_ALIGN))) __VA_ARGS__; \
+    static mem_pool_t var##_pool = { \
+        .name = #var, \
+        .storage = var##_pool_storage, \
+        .block_size = MEM_POOL_BLOCK_BYTES(size), \
+        .block_count = (count), \
+    }
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Set up a pool over caller-provided storage
+ *
+ * @param storage      block_count * MEM_POOL_BLOCK_BYTES(block_size) bytes,
+ *                     aligned to MEM_POOL_ALIGN
+ * @return true on success
+ */
+bool mem_pool_init(mem_pool_t *pool, const char *name, void *storage,
+                   uint32_t block_size, uint32_t block_count);
+
+/**
+ * @brief Return every block to the pool and clear the counters
+ * @note Only while no block is in use
+ */
+void mem_pool_reset(mem_pool_t *pool);
+
+/**
+ * @brief Take one block
+ * @note NON-BLOCKING: O(1), safe from tasks and ISRs
+ * @return Block (MEM_POOL_ALIGN aligned, contents undefined), or NULL if empty
+ */
+void *mem_pool_alloc(mem_pool_t *pool);
+
+/**
+ * @brief Give a block back
+ * @note NON-BLOCKING: O(1), safe from tasks and ISRs
+ * @return false if block is not the start of one of the pool's blocks
+ */
+bool mem_pool_free(mem_pool_t *pool, void *block);
+
+/**
+ * @brief Index of a block within its pool
+ * @return 0..block_count-1, or -1 if block is not from this pool
+ */
+int32_t mem_pool_block_index(const mem_pool_t *pool, const void *block);
+
+/**
+ * @brief Check whether a pointer is the start of one of the pool's blocks
+ */
+bool mem_pool_owns(const mem_pool_t *pool, const void *block);
+
+/**
+ * @brief Blocks available for allocation
+ */
+uint32_t mem_pool_free_blocks(const mem_pool_t *pool);
+
+/**
+ * @brief Get a consistent snapshot of the pool counters
+ */
+void mem_pool_get_stats(const mem_pool_t *pool, mem_pool_stats_t *stats);
+
+/**
+ * @brief Log the counters of a pool
+ */
+void mem_pool_dump(const mem_pool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEM_POOL_H
@@ -0,0 +1,193 @@
+/**
+ * @file pc_sampler.c
+ * @brief Statistical PC-sampling profiler streamed over RTT
+ */
+
+#include "pc_sampler.h"
+#include <stddef.h>
+
+#if PC_SAMPLER_ENABLE
+
+#include "os_wrapper.h"
+#include "hal_power.h"
+#include "SEGGER_RTT.h"
+#include "stm32f7xx_hal.h"
+
+#define SAMPLER_TIMER           TIM7
+#define SAMPLER_IRQ             TIM7_IRQn
+#define SAMPLER_DITHER_US       8U      // Period varies over +-4 us
+#define SAMPLER_MIN_HZ          100U
+#define SAMPLER_MAX_HZ          50000U
+
+#define RECORD_WORDS            4
+#define FRAME_LR                5       // Word offsets in the exception frame
+#define FRAME_PC                6
+#define FRAME_XPSR              7
+
+static uint8_t rtt_buffer[PC_SAMPLER_BUFFER_SIZE];
+static bool configured = false;
+static bool running = false;
+static uint32_t base_reload = 0;
+static uint32_t dither = 1;             // LFSR state, never 0
+static uint16_t sequence = 0;
+static volatile uint32_t taken = 0;
+static volatile uint32_t dropped = 0;
+
+void pc_sampler_isr(const uint32_t *frame, uint32_t exc_return);
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static void configure(void)
+{
+    SEGGER_RTT_ConfigUpBuffer(PC_SAMPLER_RTT_CHANNEL, "PcSamples", rtt_buffer, sizeof(rtt_buffer),
+                              SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+
+    __HAL_RCC_TIM7_CLK_ENABLE();
+
+    // APB1 timers run at twice PCLK1 when the APB1 prescaler is not 1
+    uint32_t timer_clock = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1) {
+        timer_clock *= 2U;
+    }
+
+    TIM_TypeDef *tim = SAMPLER_TIMER;
+    tim->CR1 = 0;                               // ARPE off: a new ARR applies this period
+    tim->PSC = (timer_clock / 1000000U) - 1U;   // 1 MHz count
+    tim->EGR = TIM_EGR_UG;
+    tim->SR = 0;
+    tim->DIER = TIM_DIER_UIE;
+
+    HAL_NVIC_SetPriority(SAMPLER_IRQ, PC_SAMPLER_IRQ_PRIORITY, 0);
+    configured = true;
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+bool pc_sampler_start(uint32_t rate_hz)
+{
+    if (rate_hz < SAMPLER_MIN_HZ || rate_hz > SAMPLER_MAX_HZ) {
+        return false;
+    }
+    if (!configured) {
+        configure();
+    }
+
+    uint32_t mask = os_critical_enter();
+    base_reload = 1000000U / rate_hz - 1U - SAMPLER_DITHER_US / 2U;
+    SAMPLER_TIMER->ARR = base_reload;
+    SAMPLER_TIMER->CNT = 0;
+    if (!running) {
+        running = true;
+        hal_power_stop_lock();      // TIM7 stops in STOP mode
+    }
+    os_critical_exit(mask);
+
+    HAL_NVIC_EnableIRQ(SAMPLER_IRQ);
+    SAMPLER_TIMER->CR1 = TIM_CR1_CEN;
+    return true;
+}
+
+void pc_sampler_stop(void)
+{
+    SAMPLER_TIMER->CR1 = 0;
+    HAL_NVIC_DisableIRQ(SAMPLER_IRQ);
+
+    uint32_t mask = os_critical_enter();
+    if (running) {
+        running = false;
+        hal_power_stop_unlock();
+    }
+    os_critical_exit(mask);
+}
+
+void pc_sampler_get_stats(uint32_t *taken_out, uint32_t *dropped_out)
+{
+    if (taken_out != NULL) {
+        *taken_out = taken;
+    }
+    if (dropped_out != NULL) {
+        *dropped_out = dropped;
+    }
+}
+
+/**
+ * @brief One sample (TIM7 interrupt, above configMAX_SYSCALL: no RTOS calls
+ *        other than reading the current task)
+ * @param frame Exception frame of the interrupted context
+ * @param exc_return EXC_RETURN of this interrupt
+ */
+void pc_sampler_isr(const uint32_t *frame, uint32_t exc_return)
+{
+    SAMPLER_TIMER->SR = ~(uint32_t)TIM_SR_UIF;
+
+    // Galois LFSR; the next period is base + 0..SAMPLER_DITHER_US - 1
+    dither = (dither >> 1) ^ (-(dither & 1U) & 0xB400U);
+    SAMPLER_TIMER->ARR = base_reload + (dither & (SAMPLER_DITHER_US - 1U));
+
+    // Thread mode on the process stack is a task; the main stack holds the
+    // frame of an interrupted ISR (IPSR in the stacked xPSR) or of main()
+    uint32_t exception = (exc_return & 0x4U) ? 0U : (frame[FRAME_XPSR] & 0x1FFU);
+    uint32_t record[RECORD_WORDS];
+    record[0] = PC_SAMPLER_MAGIC | ((exception & 0xFFU) << 8) | ((uint32_t)sequence << 16);
+    record[1] = frame[FRAME_PC];
+    record[2] = frame[FRAME_LR];
+    record[3] = (uint32_t)(uintptr_t)os_task_get_current();
+    sequence++;
+    taken++;
+
+    // Only writer of the channel: no RTT lock, which would not mask this
+    // priority anyway
+    if (SEGGER_RTT_WriteNoLock(PC_SAMPLER_RTT_CHANNEL, record, sizeof(record)) != sizeof(record)) {
+        dropped++;
+    }
+
+    // The flag clear must land before the exception returns, or it tail-chains
+    __DSB();
+}
+
+/**
+ * @brief TIM7 vector: passes the interrupted context's frame to pc_sampler_isr()
+ *
+ * Defined here rather than in stm32f7xx_it.c because it must see the stack
+ * untouched: bit 2 of EXC_RETURN tells whether the frame is on the process
+ * (task) or main stack. Not reported to SystemView, which would be flooded.
+ */
+__attribute__((naked)) void TIM7_IRQHandler(void)
+{
+    __asm volatile(
+        "tst   lr, #4          \n"
+        "ite   eq              \n"
+        "mrseq r0, msp         \n"
+        "mrsne r0, psp         \n"
+        "mov   r1, lr          \n"
+        "b     pc_sampler_isr  \n"
+    );
+}
+
+#else
+
+bool pc_sampler_start(uint32_t rate_hz)
+{
+    (void)rate_hz;
+    return false;
+}
+
+void pc_sampler_stop(void)
+{
+}
+
+void pc_sampler_get_stats(uint32_t *taken_out, uint32_t *dropped_out)
+{
+    if (taken_out != NULL) {
+        *taken_out = 0;
+    }
+    if (dropped_out != NULL) {
+        *dropped_out = 0;
+    }
+}
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file pc_sampler.h
+ * @brief Statistical PC-sampling profiler streamed over RTT
+ *
+ * TIM7 interrupts PC_SAMPLER_RATE_HZ times a second, above every other
+ * interrupt, and records where the CPU was: the stacked PC and LR of the
+ * interrupted context, the running task and, if an ISR was interrupted,
+ * its exception number. SystemView shows which task runs; the samples
+ * show where inside it the cycles go. tools/pc_profile.py symbolizes them
+ * against the ELF into a per-function profile or folded stacks for a
+ * flame graph (task;caller;function).
+ *
+ * Each sample is written straight into RTT up-channel PC_SAMPLER_RTT_CHANNEL,
+ * whose buffer is the sample ring; the sampler is its only writer, so it
+ * needs no lock. The channel runs in no-block-skip mode: a sample that
+ * does not fit is dropped whole and shows as a gap in the sequence.
+ *
+ * Record, little-endian 32-bit words:
+ *   [0] magic (8) | exception number (8, 0 = thread) | sequence (16)
+ *   [1] PC
+ *   [2] LR (the caller, for leaf functions)
+ *   [3] current task handle (TCB address)
+ *
+ * The period is dithered by a few microseconds so sampling does not lock
+ * onto periodic work. A sample costs on the order of 100 cycles with the
+ * interrupt entry, about 1% of the CPU at 10 kHz (SYSCLK 120 MHz); the RTT
+ * traffic is 160 KB/s. Lower the rate if the probe cannot keep up.
+ *
+ * Built with PC_SAMPLER_ENABLE=1; otherwise the functions do nothing.
+ *
+ * Usage example:
+ * @code
+ * pc_sampler_start(PC_SAMPLER_RATE_HZ);
+ * // JLinkRTTLogger -Device STM32F767ZI -If SWD -Speed 4000 -RTTChannel 3 pc.bin
+ * // tools/pc_profile.py build/Debug/stm32_blinking_led.elf pc.bin
+ * @endcode
+ */
+
+#ifndef PC_SAMPLER_H
+#define PC_SAMPLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#ifndef PC_SAMPLER_ENABLE
+#define PC_SAMPLER_ENABLE           0
+#endif
+
+#define PC_SAMPLER_RATE_HZ          10000
+#define PC_SAMPLER_RTT_CHANNEL      3       // 0 text, 1 SystemView, 2 deferred log
+#define PC_SAMPLER_BUFFER_SIZE      4096    // 25 ms of samples at 10 kHz
+#define PC_SAMPLER_IRQ_PRIORITY     1       // Above configMAX_SYSCALL: samples critical sections too
+#define PC_SAMPLER_MAGIC            0xA5
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Start sampling (sets up the RTT channel and TIM7 on first use)
+ * @param rate_hz Samples per second, 100..50000
+ * @return false if disabled at build time or the rate is out of range
+ */
+bool pc_sampler_start(uint32_t rate_hz);
+
+/**
+ * @brief Stop sampling; the channel keeps what the host has not read
+ */
+void pc_sampler_stop(void);
+
+/**
+ * @brief Samples taken and samples dropped because the channel was full
+ */
+void pc_sampler_get_stats(uint32_t *taken, uint32_t *dropped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PC_SAMPLER_H
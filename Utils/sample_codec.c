@@ -0,0 +1,163 @@
+/**
+ * @file sample_codec.c
+ * @brief Compact delta + zigzag-varint encoding of sensor_sample_t runs
+ */
+
+#include "sample_codec.h"
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static inline uint32_t zigzag_encode(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static inline int32_t zigzag_decode(uint32_t value)
+{
+    return (int32_t)((value >> 1) ^ (0u - (value & 1u)));
+}
+
+static size_t varint_write(uint8_t *out, uint32_t value)
+{
+    size_t i = 0;
+
+    while (value >= 0x80) {
+        out[i++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[i++] = (uint8_t)value;
+
+    return i;
+}
+
+static bool varint_read(const uint8_t *data, size_t length, size_t *pos, uint32_t *value)
+{
+    uint32_t result = 0;
+
+    for (uint32_t shift = 0; shift < 35 && *pos < length; shift += 7) {
+        uint8_t byte = data[(*pos)++];
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+size_t sample_codec_encode(const sensor_sample_t *samples, uint32_t count,
+                           uint8_t *out, size_t out_size, uint32_t *encoded)
+{
+    if (encoded != NULL) {
+        *encoded = 0;
+    }
+
+    if (samples == NULL || out == NULL || encoded == NULL || count == 0 ||
+        out_size < SAMPLE_CODEC_FIRST_MAX) {
+        return 0;
+    }
+
+    uint32_t ts = samples[0].timestamp;
+    int32_t value = samples[0].value;
+    size_t pos = 0;
+
+    out[pos++] = (uint8_t)(ts & 0xFF);
+    out[pos++] = (uint8_t)((ts >> 8) & 0xFF);
+    out[pos++] = (uint8_t)((ts >> 16) & 0xFF);
+    out[pos++] = (uint8_t)((ts >> 24) & 0xFF);
+    pos += varint_write(&out[pos], zigzag_encode(value));
+
+    uint32_t i = 1;
+    for (; i < count; i++) {
+        uint32_t d_ts = zigzag_encode((int32_t)(samples[i].timestamp - ts));
+        uint32_t d_value = zigzag_encode((int32_t)((uint32_t)samples[i].value - (uint32_t)value));
+
+        // Worst case check first keeps the fast path free of per-byte bounds tests
+        if (out_size - pos < SAMPLE_CODEC_DELTA_MAX) {
+            uint8_t tmp[SAMPLE_CODEC_DELTA_MAX];
+            size_t n = varint_write(tmp, d_ts);
+            n += varint_write(&tmp[n], d_value);
+            if (n > out_size - pos) {
+                break;
+            }
+            for (size_t k = 0; k < n; k++) {
+                out[pos++] = tmp[k];
+            }
+        } else {
+            pos += varint_write(&out[pos], d_ts);
+            pos += varint_write(&out[pos], d_value);
+        }
+
+        ts = samples[i].timestamp;
+        value = samples[i].value;
+    }
+
+    *encoded = i;
+    return pos;
+}
+
+bool sample_codec_decode(const uint8_t *data, size_t length, uint8_t sensor_type,
+                         sensor_sample_t *samples, uint32_t max_samples, uint32_t *decoded)
+{
+    if (decoded != NULL) {
+        *decoded = 0;
+    }
+
+    if (data == NULL || samples == NULL || decoded == NULL) {
+        return false;
+    }
+
+    if (length == 0) {
+        return true;
+    }
+
+    if (length < 4 || max_samples == 0) {
+        return false;
+    }
+
+    size_t pos = 4;
+    uint32_t raw;
+    uint32_t ts = (uint32_t)data[0] | ((uint32_t)data[1] << 8) |
+                  ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+
+    if (!varint_read(data, length, &pos, &raw)) {
+        return false;
+    }
+    int32_t value = zigzag_decode(raw);
+
+    uint32_t n = 0;
+    for (;;) {
+        samples[n].sensor_type = sensor_type;
+        samples[n].timestamp = ts;
+        samples[n].value = value;
+        n++;
+
+        if (pos == length) {
+            break;
+        }
+        if (n == max_samples) {
+            *decoded = n;
+            return false;
+        }
+
+        uint32_t d_ts, d_value;
+        if (!varint_read(data, length, &pos, &d_ts) ||
+            !varint_read(data, length, &pos, &d_value)) {
+            *decoded = n;
+            return false;
+        }
+
+        ts += (uint32_t)zigzag_decode(d_ts);
+        value = (int32_t)((uint32_t)value + (uint32_t)zigzag_decode(d_value));
+    }
+
+    *decoded = n;
+    return true;
+}
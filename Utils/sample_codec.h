@@ -0,0 +1,78 @@
+/**
+ * @file sample_codec.h
+ * @brief Compact delta + zigzag-varint encoding of sensor_sample_t runs
+ *
+ * A run of samples of one sensor type is encoded as:
+ *   TIMESTAMP0(4, LE) + VARINT(zz(VALUE0)) + { VARINT(zz(dTS)) + VARINT(zz(dVALUE)) }...
+ *
+ * The sensor type is not repeated; it travels once in the enclosing payload
+ * header. Deltas are taken modulo 2^32, so wrap-around and non-monotonic
+ * timestamps still round-trip. Slowly varying sensors need ~2-3 bytes per
+ * sample instead of sizeof(sensor_sample_t) (9).
+ *
+ * Usage example:
+ * @code
+ * uint32_t encoded;
+ * size_t len = sample_codec_encode(samples, count, payload, sizeof(payload), &encoded);
+ * // receiver:
+ * sample_codec_decode(payload, len, SENSOR_TEMPERATURE, out, max, &decoded);
+ * @endcode
+ */
+
+#ifndef SAMPLE_CODEC_H
+#define SAMPLE_CODEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "protocol_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define SAMPLE_CODEC_VARINT_MAX     5       // Bytes for a 32-bit varint
+#define SAMPLE_CODEC_FIRST_MAX      (4 + SAMPLE_CODEC_VARINT_MAX)
+#define SAMPLE_CODEC_DELTA_MAX      (2 * SAMPLE_CODEC_VARINT_MAX)
+#define SAMPLE_CODEC_DELTA_MIN      2       // Smallest encoded sample after the first
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Encode as many samples as fit in the output buffer
+ *
+ * @param samples Samples (all of one sensor type)
+ * @param count Number of samples
+ * @param out Output buffer
+ * @param out_size Output buffer size
+ * @param encoded Output: number of samples encoded
+ * @return Encoded length in bytes (0 if nothing fit)
+ */
+size_t sample_codec_encode(const sensor_sample_t *samples, uint32_t count,
+                           uint8_t *out, size_t out_size, uint32_t *encoded);
+
+/**
+ * @brief Decode a compact sample run
+ *
+ * @param data Encoded bytes
+ * @param length Encoded length
+ * @param sensor_type Sensor type to fill in (from the payload header)
+ * @param samples Output samples
+ * @param max_samples Output capacity
+ * @param decoded Output: number of samples decoded
+ * @return true if the whole input decoded cleanly
+ */
+bool sample_codec_decode(const uint8_t *data, size_t length, uint8_t sensor_type,
+                         sensor_sample_t *samples, uint32_t max_samples, uint32_t *decoded);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLE_CODEC_H
@@ -7,6 +7,317 @@
 #include <stdlib.h>
 #include <string.h>
 
+// ============================================================================
+// Index Helpers
+// ============================================================================
+
+// Power-of-two buffers (mask != 0) run head and tail freely over 32 bits
+// and mask them; others keep them wrapped to the capacity and map offsets
+// from them with a division. Only mutex mode allows the latter: SPSC
+// indices always run free, and 2^32 is not a multiple of other capacities,
+// so the slots would jump at the wrap.
+
+// Storage slot of a buffer index
+static inline uint32_t rb_slot(const sensor_ring_buffer_t *rb, uint32_t index)
+{
+    if (rb->mask != 0) {
+        return index & rb->mask;
+    }
+    return (index < rb->capacity) ? index : index % rb->capacity;
+}
+
+// Mutex mode: index n positions after index
+static inline uint32_t rb_advance(const sensor_ring_buffer_t *rb, uint32_t index, uint32_t n)
+{
+    if (rb->mask != 0) {
+        return index + n;
+    }
+    return (index + n) % rb->capacity;
+}
+
+// ============================================================================
+// Span Helpers
+// ============================================================================
+
+// Split count samples starting at storage slot first into at most two
+// contiguous runs (the second starts at slot 0 after the wrap)
+static uint32_t make_spans(const sensor_ring_buffer_t *rb, uint32_t first, uint32_t count,
+                           sensor_ring_buffer_span_t spans[2])
+{
+    uint32_t run = rb->capacity - first;
+    if (run > count) {
+        run = count;
+    }
+    spans[0].data = &rb->buffer[first];
+    spans[0].count = run;
+    spans[1].data = rb->buffer;
+    spans[1].count = count - run;
+    return count;
+}
+
+// ============================================================================
+// Record Helpers
+// ============================================================================
+
+// Samples are stored as aligned records and packed into sensor_sample_t
+// (the wire format) only on the way out; the type is the ring's.
+
+static inline sensor_ring_buffer_record_t record_of(const sensor_sample_t *sample)
+{
+    sensor_ring_buffer_record_t record = {
+        .timestamp = sample->timestamp,
+        .value = sample->value,
+    };
+    return record;
+}
+
+static inline void record_pack(sensor_sample_t *dest, const sensor_ring_buffer_record_t *record,
+                               sensor_type_t sensor_type)
+{
+    dest->sensor_type = sensor_type;
+    dest->timestamp = record->timestamp;
+    dest->value = record->value;
+}
+
+static void copy_spans(const sensor_ring_buffer_t *rb, sensor_sample_t *dest,
+                       const sensor_ring_buffer_span_t spans[2])
+{
+    for (uint32_t s = 0; s < 2; s++) {
+        const sensor_ring_buffer_record_t *src = spans[s].data;
+        for (uint32_t i = 0; i < spans[s].count; i++) {
+            record_pack(dest++, &src[i], rb->sensor_type);
+        }
+    }
+}
+
+static void fill_spans(const sensor_ring_buffer_span_t spans[2], const sensor_sample_t *samples)
+{
+    for (uint32_t s = 0; s < 2; s++) {
+        sensor_ring_buffer_record_t *dest = (sensor_ring_buffer_record_t *)spans[s].data;
+        for (uint32_t i = 0; i < spans[s].count; i++) {
+            dest[i] = record_of(samples++);
+        }
+    }
+}
+
+// Position (0..count) of the first of count samples from index base whose
+// timestamp is >= timestamp; timestamps are non-decreasing along the ring
+static uint32_t lower_bound_time(const sensor_ring_buffer_t *rb, uint32_t base, uint32_t count,
+                                 uint32_t timestamp)
+{
+    uint32_t lo = 0;
+    uint32_t hi = count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (rb->buffer[rb_slot(rb, base + mid)].timestamp < timestamp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// ============================================================================
+// SPSC Helpers
+// ============================================================================
+
+// SPSC buffers never lock: head counts every push and is written only by
+// the producer (release, after the sample), tail is the consumer's clear
+// point. Readers copy, then re-check head and drop whatever the producer
+// may have overwritten in the meantime.
+
+// Oldest readable index for a head value: one slot is left for the write
+// in progress, and nothing before the clear point. Compared as a signed
+// distance, so it holds across the 32-bit wrap; before the first lap the
+// clear point (0 at init) is the floor.
+static uint32_t spsc_oldest(const sensor_ring_buffer_t *rb, uint32_t head)
+{
+    uint32_t oldest = head - (rb->capacity - 1);
+    uint32_t floor = rb->tail;
+    return ((int32_t)(floor - oldest) > 0) ? floor : oldest;
+}
+
+static void spsc_push(sensor_ring_buffer_t *rb, const sensor_sample_t *sample)
+{
+    uint32_t head = rb->head;
+    rb->buffer[rb_slot(rb, head)] = record_of(sample);
+    __atomic_store_n(&rb->head, head + 1, __ATOMIC_RELEASE);
+}
+
+// Copy n samples from index *first, then drop the ones overwritten during
+// the copy. Returns the number kept; *first becomes the index of the first
+// kept sample and *oldest the oldest index still valid.
+static uint32_t spsc_copy(
+    sensor_ring_buffer_t *rb,
+    uint32_t *first,
+    uint32_t n,
+    sensor_sample_t *samples,
+    uint32_t *oldest)
+{
+    sensor_ring_buffer_span_t spans[2];
+    make_spans(rb, rb_slot(rb, *first), n, spans);
+    copy_spans(rb, samples, spans);
+
+    // Copies complete before head is checked again
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint32_t valid_from = spsc_oldest(rb, __atomic_load_n(&rb->head, __ATOMIC_RELAXED));
+    *oldest = valid_from;
+
+    if ((int32_t)(valid_from - *first) > 0) {
+        uint32_t lost = valid_from - *first;
+        if (lost >= n) {
+            return 0;
+        }
+        memmove(samples, samples + lost, (n - lost) * sizeof(sensor_sample_t));
+        n -= lost;
+        *first = valid_from;
+    }
+    return n;
+}
+
+static sensor_ring_buffer_status_t spsc_read(
+    sensor_ring_buffer_t *rb,
+    uint32_t start_index,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read)
+{
+    uint32_t head = __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE);
+    uint32_t oldest = spsc_oldest(rb, head);
+    uint32_t count = head - oldest;
+
+    *samples_read = 0;
+
+    if (count == 0) {
+        return SENSOR_RING_BUFFER_ERR_EMPTY;
+    }
+
+    if (start_index >= count) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    uint32_t first = oldest + start_index;
+    uint32_t available = count - start_index;
+    uint32_t to_read = (max_samples < available) ? max_samples : available;
+
+    to_read = spsc_copy(rb, &first, to_read, samples, &oldest);
+    if (to_read == 0) {
+        return SENSOR_RING_BUFFER_ERR_EMPTY;
+    }
+
+    *samples_read = to_read;
+    return SENSOR_RING_BUFFER_OK;
+}
+
+// ============================================================================
+// Cursor Helpers
+// ============================================================================
+
+// Cursors count in pushed samples: SPSC head, or the mutex mode's pushed
+// counter. The window is what a cursor can still read: from oldest to
+// newest, with floor the clear point (or last commit) at or below oldest.
+typedef struct {
+    uint32_t oldest;
+    uint32_t newest;
+    uint32_t floor;
+} cursor_window_t;
+
+// Mutex mode: call with the mutex held
+static cursor_window_t cursor_window(const sensor_ring_buffer_t *rb)
+{
+    cursor_window_t window;
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        window.newest = __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE);
+        window.oldest = spsc_oldest(rb, window.newest);
+        window.floor = rb->tail;
+    } else {
+        window.newest = rb->pushed;
+        window.oldest = rb->pushed - rb->count;
+        window.floor = rb->floor;
+    }
+    return window;
+}
+
+// Move a cursor that fell out of the window to its oldest sample. Returns
+// the samples it lost to the producer; those removed on purpose (clear,
+// commit) do not count.
+static uint32_t cursor_catch_up(sensor_ring_buffer_cursor_t *cursor, const cursor_window_t *window)
+{
+    if ((int32_t)(window->oldest - cursor->position) <= 0) {
+        return 0;
+    }
+
+    uint32_t from = ((int32_t)(window->floor - cursor->position) > 0) ? window->floor
+                                                                    : cursor->position;
+    cursor->position = window->oldest;
+    return window->oldest - from;
+}
+
+static uint32_t cursor_lag(const sensor_ring_buffer_cursor_t *cursor, const cursor_window_t *window)
+{
+    uint32_t from = ((int32_t)(window->oldest - cursor->position) > 0) ? window->oldest
+                                                                     : cursor->position;
+    return window->newest - from;
+}
+
+// Producer side, after a push (mutex mode: with the mutex held). Callbacks
+// run outside the critical section, so one crossing is taken per pass;
+// a cursor marked above is skipped by the next pass.
+static void watermark_check_high(sensor_ring_buffer_t *rb)
+{
+    if (rb->watermarks == 0) {
+        return;
+    }
+
+    cursor_window_t window = cursor_window(rb);
+
+    for (;;) {
+        sensor_ring_buffer_cursor_t *fired = NULL;
+        sensor_ring_buffer_watermark_cb_t callback = NULL;
+        void *arg = NULL;
+
+        uint32_t mask = os_critical_enter();
+        for (sensor_ring_buffer_cursor_t *cursor = rb->cursors; cursor != NULL; cursor = cursor->next) {
+            if (cursor->high_watermark != 0 && !cursor->above &&
+                cursor_lag(cursor, &window) >= cursor->high_watermark) {
+                cursor->above = true;
+                fired = cursor;
+                callback = cursor->watermark_cb;
+                arg = cursor->watermark_arg;
+                break;
+            }
+        }
+        os_critical_exit(mask);
+
+        if (fired == NULL) {
+            return;
+        }
+        callback(fired, SENSOR_RING_BUFFER_WATERMARK_HIGH, arg);
+    }
+}
+
+// Consumer side, after a read left 'lag' samples unread
+static void watermark_check_low(sensor_ring_buffer_cursor_t *cursor, uint32_t lag)
+{
+    if (cursor->high_watermark == 0 || lag > cursor->low_watermark) {
+        return;
+    }
+
+    uint32_t mask = os_critical_enter();
+    bool was_above = cursor->above;
+    cursor->above = false;
+    sensor_ring_buffer_watermark_cb_t callback = cursor->watermark_cb;
+    void *arg = cursor->watermark_arg;
+    os_critical_exit(mask);
+
+    if (was_above && callback != NULL) {
+        callback(cursor, SENSOR_RING_BUFFER_WATERMARK_LOW, arg);
+    }
+}
+
 // ============================================================================
 // Public API Implementation
 // ============================================================================
@@ -16,13 +327,16 @@ sensor_ring_buffer_config_t sensor_ring_buffer_get_default_config(void)
     sensor_ring_buffer_config_t config = {
         .capacity = SENSOR_RING_BUFFER_DEFAULT_CAPACITY,
         .sensor_type = SENSOR_TEMPERATURE,
+        .mode = SENSOR_RING_BUFFER_MODE_MUTEX,
     };
     return config;
 }
 
-sensor_ring_buffer_status_t sensor_ring_buffer_init(
+// Shared by both init variants: storage NULL allocates it
+static sensor_ring_buffer_status_t init_buffer(
     sensor_ring_buffer_t *rb,
-    const sensor_ring_buffer_config_t *config)
+    const sensor_ring_buffer_config_t *config,
+    sensor_ring_buffer_record_t *storage)
 {
     if (rb == NULL) {
         return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
@@ -45,30 +359,81 @@ sensor_ring_buffer_status_t sensor_ring_buffer_init(
         cfg.capacity = SENSOR_RING_BUFFER_DEFAULT_CAPACITY;
     }
 
-    // Allocate sample buffer
-    rb->buffer = (sensor_sample_t *)malloc(cfg.capacity * sizeof(sensor_sample_t));
-    if (rb->buffer == NULL) {
-        return SENSOR_RING_BUFFER_ERR_NO_MEM;
+    // SPSC needs a free slot besides the samples it holds, and masked
+    // indices (see rb_slot())
+    if (cfg.mode == SENSOR_RING_BUFFER_MODE_SPSC &&
+        (cfg.capacity < 2 || (cfg.capacity & (cfg.capacity - 1)) != 0)) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
     }
 
-    // Create mutex for thread safety
-    rb->mutex = os_mutex_create();
-    if (rb->mutex == NULL) {
-        free(rb->buffer);
-        rb->buffer = NULL;
-        return SENSOR_RING_BUFFER_ERR_NO_MEM;
+    // Allocate sample buffer unless the caller provided one
+    rb->owns_buffer = (storage == NULL);
+    if (storage == NULL) {
+        storage = (sensor_ring_buffer_record_t *)malloc(cfg.capacity * sizeof(sensor_ring_buffer_record_t));
+        if (storage == NULL) {
+            return SENSOR_RING_BUFFER_ERR_NO_MEM;
+        }
+    }
+    rb->buffer = storage;
+
+    // Create mutex for thread safety (SPSC buffers do without)
+    rb->mutex = NULL;
+    if (cfg.mode == SENSOR_RING_BUFFER_MODE_MUTEX) {
+        rb->mutex = os_mutex_create_static(&rb->mutex_storage);
+        if (rb->mutex == NULL) {
+            if (rb->owns_buffer) {
+                free(rb->buffer);
+            }
+            rb->buffer = NULL;
+            return SENSOR_RING_BUFFER_ERR_NO_MEM;
+        }
     }
 
     rb->capacity = cfg.capacity;
+    rb->mask = ((cfg.capacity & (cfg.capacity - 1)) == 0) ? cfg.capacity - 1 : 0;
     rb->sensor_type = cfg.sensor_type;
+    rb->mode = cfg.mode;
     rb->head = 0;
     rb->tail = 0;
+    rb->span_first = 0;
     rb->count = 0;
+    rb->pushed = 0;
+    rb->floor = 0;
+    rb->cursors = NULL;
+    rb->watermarks = 0;
     rb->initialized = true;
 
     return SENSOR_RING_BUFFER_OK;
 }
 
+sensor_ring_buffer_status_t sensor_ring_buffer_init(
+    sensor_ring_buffer_t *rb,
+    const sensor_ring_buffer_config_t *config)
+{
+    return init_buffer(rb, config, NULL);
+}
+
+sensor_ring_buffer_status_t sensor_ring_buffer_init_static(
+    sensor_ring_buffer_t *rb,
+    const sensor_ring_buffer_config_t *config,
+    sensor_ring_buffer_record_t *storage,
+    uint32_t capacity)
+{
+    if (storage == NULL || capacity == 0) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    sensor_ring_buffer_config_t cfg;
+    if (config != NULL) {
+        cfg = *config;
+    } else {
+        cfg = sensor_ring_buffer_get_default_config();
+    }
+    cfg.capacity = capacity;
+
+    return init_buffer(rb, &cfg, storage);
+}
+
 sensor_ring_buffer_status_t sensor_ring_buffer_deinit(sensor_ring_buffer_t *rb)
 {
     if (rb == NULL) {
@@ -79,6 +444,15 @@ sensor_ring_buffer_status_t sensor_ring_buffer_deinit(sensor_ring_buffer_t *rb)
         return SENSOR_RING_BUFFER_ERR_NOT_INIT;
     }
 
+    // Cursors left attached read nothing from here on
+    uint32_t mask = os_critical_enter();
+    for (sensor_ring_buffer_cursor_t *cursor = rb->cursors; cursor != NULL; cursor = cursor->next) {
+        cursor->rb = NULL;
+    }
+    rb->cursors = NULL;
+    rb->watermarks = 0;
+    os_critical_exit(mask);
+
     // Free resources
     if (rb->mutex != NULL) {
         os_mutex_delete(rb->mutex);
@@ -86,7 +460,9 @@ sensor_ring_buffer_status_t sensor_ring_buffer_deinit(sensor_ring_buffer_t *rb)
     }
 
     if (rb->buffer != NULL) {
-        free(rb->buffer);
+        if (rb->owns_buffer) {
+            free(rb->buffer);
+        }
         rb->buffer = NULL;
     }
 
@@ -118,21 +494,177 @@ sensor_ring_buffer_status_t sensor_ring_buffer_push(
         return SENSOR_RING_BUFFER_ERR_NOT_INIT;
     }
 
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        spsc_push(rb, sample);
+        watermark_check_high(rb);
+        return SENSOR_RING_BUFFER_OK;
+    }
+
     os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
 
     // Write sample at head position
-    rb->buffer[rb->head] = *sample;
+    rb->buffer[rb_slot(rb, rb->head)] = record_of(sample);
 
     // Advance head
-    rb->head = (rb->head + 1) % rb->capacity;
+    rb->head = rb_advance(rb, rb->head, 1);
+    rb->pushed++;
 
     if (rb->count < rb->capacity) {
         // Buffer not yet full
         rb->count++;
     } else {
         // Buffer full - tail advances (oldest sample overwritten)
-        rb->tail = (rb->tail + 1) % rb->capacity;
+        rb->tail = rb_advance(rb, rb->tail, 1);
+    }
+
+    watermark_check_high(rb);
+    os_mutex_give(rb->mutex);
+
+    return SENSOR_RING_BUFFER_OK;
+}
+
+sensor_ring_buffer_status_t sensor_ring_buffer_push_isr(
+    sensor_ring_buffer_t *rb,
+    const sensor_sample_t *sample)
+{
+    if (rb == NULL || sample == NULL) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    if (!rb->initialized) {
+        return SENSOR_RING_BUFFER_ERR_NOT_INIT;
+    }
+
+    // A mutex cannot be taken from an ISR
+    if (rb->mode != SENSOR_RING_BUFFER_MODE_SPSC) {
+        return SENSOR_RING_BUFFER_ERR_UNSUPPORTED;
+    }
+
+    spsc_push(rb, sample);
+    watermark_check_high(rb);
+    return SENSOR_RING_BUFFER_OK;
+}
+
+sensor_ring_buffer_status_t sensor_ring_buffer_push_n(
+    sensor_ring_buffer_t *rb,
+    const sensor_sample_t *samples,
+    uint32_t count)
+{
+    if (rb == NULL || (samples == NULL && count > 0)) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    if (!rb->initialized) {
+        return SENSOR_RING_BUFFER_ERR_NOT_INIT;
+    }
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        // Published one at a time: readers only allow for a single slot
+        // being written past head
+        for (uint32_t i = 0; i < count; i++) {
+            spsc_push(rb, &samples[i]);
+        }
+        watermark_check_high(rb);
+        return SENSOR_RING_BUFFER_OK;
+    }
+
+    // Only the newest capacity samples survive (cursors see the rest as overwritten)
+    uint32_t pushed = count;
+    if (count > rb->capacity) {
+        samples += count - rb->capacity;
+        count = rb->capacity;
+    }
+
+    os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
+    rb->pushed += pushed;
+
+    sensor_ring_buffer_span_t spans[2];
+    make_spans(rb, rb_slot(rb, rb->head), count, spans);
+    fill_spans(spans, samples);
+
+    rb->head = rb_advance(rb, rb->head, count);
+    if (rb->count + count >= rb->capacity) {
+        // Full: oldest samples overwritten, tail follows head
+        rb->count = rb->capacity;
+        rb->tail = rb->head;
+    } else {
+        rb->count += count;
+    }
+
+    watermark_check_high(rb);
+    os_mutex_give(rb->mutex);
+
+    return SENSOR_RING_BUFFER_OK;
+}
+
+uint32_t sensor_ring_buffer_get_read_spans(
+    sensor_ring_buffer_t *rb,
+    uint32_t max_samples,
+    sensor_ring_buffer_span_t spans[2])
+{
+    if (spans == NULL) {
+        return 0;
+    }
+    spans[0].count = 0;
+    spans[1].count = 0;
+
+    if (rb == NULL || !rb->initialized) {
+        return 0;
+    }
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        uint32_t head = __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE);
+        uint32_t oldest = spsc_oldest(rb, head);
+        uint32_t count = head - oldest;
+        if (count > max_samples) {
+            count = max_samples;
+        }
+        rb->span_first = oldest;
+        return make_spans(rb, rb_slot(rb, oldest), count, spans);
+    }
+
+    // Held until sensor_ring_buffer_commit_read()
+    os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
+
+    uint32_t count = (rb->count < max_samples) ? rb->count : max_samples;
+    return make_spans(rb, rb_slot(rb, rb->tail), count, spans);
+}
+
+sensor_ring_buffer_status_t sensor_ring_buffer_commit_read(
+    sensor_ring_buffer_t *rb,
+    uint32_t consumed)
+{
+    if (rb == NULL) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    if (!rb->initialized) {
+        return SENSOR_RING_BUFFER_ERR_NOT_INIT;
+    }
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        uint32_t first = rb->span_first;
+
+        // Did the producer lap the spans while they were in use?
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        uint32_t valid_from = spsc_oldest(rb, __atomic_load_n(&rb->head, __ATOMIC_RELAXED));
+        bool overwritten = (int32_t)(valid_from - first) > 0;
+
+        uint32_t new_tail = first + consumed;
+        if ((int32_t)(valid_from - new_tail) > 0) {
+            new_tail = valid_from;
+        }
+        __atomic_store_n(&rb->tail, new_tail, __ATOMIC_RELEASE);
+
+        return overwritten ? SENSOR_RING_BUFFER_ERR_OVERWRITTEN : SENSOR_RING_BUFFER_OK;
+    }
+
+    if (consumed > rb->count) {
+        consumed = rb->count;
     }
+    rb->tail = rb_advance(rb, rb->tail, consumed);
+    rb->count -= consumed;
+    rb->floor = rb->pushed - rb->count;
 
     os_mutex_give(rb->mutex);
 
@@ -144,6 +676,10 @@ uint32_t sensor_ring_buffer_get_count(const sensor_ring_buffer_t *rb)
     if (rb == NULL || !rb->initialized) {
         return 0;
     }
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        uint32_t head = __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE);
+        return head - spsc_oldest(rb, head);
+    }
     return rb->count;
 }
 
@@ -170,6 +706,10 @@ sensor_ring_buffer_status_t sensor_ring_buffer_read(
         return SENSOR_RING_BUFFER_ERR_NOT_INIT;
     }
 
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        return spsc_read(rb, start_index, samples, max_samples, samples_read);
+    }
+
     os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
 
     *samples_read = 0;
@@ -191,12 +731,12 @@ sensor_ring_buffer_status_t sensor_ring_buffer_read(
 
     // Calculate actual buffer index for start_index
     // start_index 0 = oldest = tail
-    uint32_t buf_index = (rb->tail + start_index) % rb->capacity;
+    uint32_t buf_index = rb_slot(rb, rb->tail + start_index);
 
-    for (uint32_t i = 0; i < to_read; i++) {
-        samples[i] = rb->buffer[buf_index];
-        buf_index = (buf_index + 1) % rb->capacity;
-    }
+    // At most two runs, copied whole
+    sensor_ring_buffer_span_t spans[2];
+    make_spans(rb, buf_index, to_read, spans);
+    copy_spans(rb, samples, spans);
 
     *samples_read = to_read;
 
@@ -205,6 +745,115 @@ sensor_ring_buffer_status_t sensor_ring_buffer_read(
     return SENSOR_RING_BUFFER_OK;
 }
 
+sensor_ring_buffer_status_t sensor_ring_buffer_find_time(
+    sensor_ring_buffer_t *rb,
+    uint32_t timestamp,
+    uint32_t *index)
+{
+    if (rb == NULL || index == NULL) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    if (!rb->initialized) {
+        return SENSOR_RING_BUFFER_ERR_NOT_INIT;
+    }
+
+    uint32_t count;
+    uint32_t position;
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        uint32_t head = __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE);
+        uint32_t oldest = spsc_oldest(rb, head);
+        count = head - oldest;
+        position = lower_bound_time(rb, oldest, count, timestamp);
+
+        // Samples the producer overwrote meanwhile were older; rebase on
+        // what is still valid
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        uint32_t valid_from = spsc_oldest(rb, __atomic_load_n(&rb->head, __ATOMIC_RELAXED));
+        uint32_t shift = valid_from - oldest;
+        position = (position > shift) ? position - shift : 0;
+        count = (count > shift) ? count - shift : 0;
+    } else {
+        os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
+        count = rb->count;
+        position = lower_bound_time(rb, rb->tail, count, timestamp);
+        os_mutex_give(rb->mutex);
+    }
+
+    *index = position;
+    return (position < count) ? SENSOR_RING_BUFFER_OK : SENSOR_RING_BUFFER_ERR_EMPTY;
+}
+
+sensor_ring_buffer_status_t sensor_ring_buffer_read_time_range(
+    sensor_ring_buffer_t *rb,
+    uint32_t from_timestamp,
+    uint32_t to_timestamp,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read,
+    uint32_t *first_index)
+{
+    if (rb == NULL || samples == NULL || samples_read == NULL) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    if (!rb->initialized) {
+        return SENSOR_RING_BUFFER_ERR_NOT_INIT;
+    }
+
+    *samples_read = 0;
+
+    uint32_t base;
+    uint32_t count;
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        uint32_t head = __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE);
+        base = spsc_oldest(rb, head);
+        count = head - base;
+    } else {
+        os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
+        base = rb->tail;
+        count = rb->count;
+    }
+
+    uint32_t lo = lower_bound_time(rb, base, count, from_timestamp);
+    uint32_t hi = (to_timestamp > from_timestamp)
+                  ? lo + lower_bound_time(rb, base + lo, count - lo, to_timestamp)
+                  : lo;
+    uint32_t n = hi - lo;
+    if (n > max_samples) {
+        n = max_samples;
+    }
+
+    uint32_t position = lo;
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        if (n > 0) {
+            uint32_t first = base + lo;
+            uint32_t oldest;
+            n = spsc_copy(rb, &first, n, samples, &oldest);
+            position = first - oldest;
+        }
+    } else {
+        sensor_ring_buffer_span_t spans[2];
+        make_spans(rb, rb_slot(rb, base + lo), n, spans);
+        copy_spans(rb, samples, spans);
+        os_mutex_give(rb->mutex);
+    }
+
+    if (first_index != NULL) {
+        *first_index = position;
+    }
+
+    if (n == 0) {
+        return SENSOR_RING_BUFFER_ERR_EMPTY;
+    }
+
+    *samples_read = n;
+    return SENSOR_RING_BUFFER_OK;
+}
+
 sensor_ring_buffer_status_t sensor_ring_buffer_peek(
     sensor_ring_buffer_t *rb,
     uint32_t index,
@@ -218,6 +867,11 @@ sensor_ring_buffer_status_t sensor_ring_buffer_peek(
         return SENSOR_RING_BUFFER_ERR_NOT_INIT;
     }
 
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        uint32_t read;
+        return spsc_read(rb, index, sample, 1, &read);
+    }
+
     os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
 
     if (rb->count == 0) {
@@ -231,8 +885,8 @@ sensor_ring_buffer_status_t sensor_ring_buffer_peek(
     }
 
     // Calculate actual buffer index (index 0 = oldest = tail)
-    uint32_t buf_index = (rb->tail + index) % rb->capacity;
-    *sample = rb->buffer[buf_index];
+    uint32_t buf_index = rb_slot(rb, rb->tail + index);
+    record_pack(sample, &rb->buffer[buf_index], rb->sensor_type);
 
     os_mutex_give(rb->mutex);
 
@@ -249,17 +903,252 @@ sensor_ring_buffer_status_t sensor_ring_buffer_clear(sensor_ring_buffer_t *rb)
         return SENSOR_RING_BUFFER_ERR_NOT_INIT;
     }
 
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        // Everything pushed so far is behind the clear point
+        __atomic_store_n(&rb->tail, __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+        return SENSOR_RING_BUFFER_OK;
+    }
+
     os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
 
     rb->head = 0;
     rb->tail = 0;
     rb->count = 0;
+    rb->floor = rb->pushed;
 
     os_mutex_give(rb->mutex);
 
     return SENSOR_RING_BUFFER_OK;
 }
 
+sensor_ring_buffer_status_t sensor_ring_buffer_cursor_attach(
+    sensor_ring_buffer_t *rb,
+    sensor_ring_buffer_cursor_t *cursor,
+    const char *name,
+    bool from_oldest)
+{
+    if (rb == NULL || cursor == NULL) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    if (!rb->initialized) {
+        return SENSOR_RING_BUFFER_ERR_NOT_INIT;
+    }
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_MUTEX) {
+        os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
+    }
+    cursor_window_t window = cursor_window(rb);
+
+    sensor_ring_buffer_status_t status = SENSOR_RING_BUFFER_OK;
+    uint32_t mask = os_critical_enter();
+    for (sensor_ring_buffer_cursor_t *it = rb->cursors; it != NULL; it = it->next) {
+        if (it == cursor) {
+            status = SENSOR_RING_BUFFER_ERR_ALREADY_INIT;
+            break;
+        }
+    }
+    if (status == SENSOR_RING_BUFFER_OK) {
+        cursor->rb = rb;
+        cursor->name = name;
+        cursor->position = from_oldest ? window.oldest : window.newest;
+        cursor->max_lag = 0;
+        cursor->overruns = 0;
+        cursor->read_count = 0;
+        cursor->high_watermark = 0;
+        cursor->low_watermark = 0;
+        cursor->watermark_cb = NULL;
+        cursor->watermark_arg = NULL;
+        cursor->above = false;
+        cursor->next = rb->cursors;
+        rb->cursors = cursor;
+    }
+    os_critical_exit(mask);
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_MUTEX) {
+        os_mutex_give(rb->mutex);
+    }
+    return status;
+}
+
+void sensor_ring_buffer_cursor_detach(sensor_ring_buffer_cursor_t *cursor)
+{
+    if (cursor == NULL) {
+        return;
+    }
+
+    uint32_t mask = os_critical_enter();
+    sensor_ring_buffer_t *rb = cursor->rb;
+    if (rb != NULL) {
+        for (sensor_ring_buffer_cursor_t **link = &rb->cursors; *link != NULL; link = &(*link)->next) {
+            if (*link == cursor) {
+                *link = cursor->next;
+                if (cursor->high_watermark != 0) {
+                    rb->watermarks--;
+                }
+                break;
+            }
+        }
+    }
+    cursor->rb = NULL;
+    cursor->next = NULL;
+    os_critical_exit(mask);
+}
+
+sensor_ring_buffer_status_t sensor_ring_buffer_cursor_read(
+    sensor_ring_buffer_cursor_t *cursor,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read)
+{
+    if (cursor == NULL || samples == NULL || samples_read == NULL) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    *samples_read = 0;
+
+    sensor_ring_buffer_t *rb = cursor->rb;
+    if (rb == NULL || !rb->initialized) {
+        return SENSOR_RING_BUFFER_ERR_NOT_INIT;
+    }
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_MUTEX) {
+        os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
+    }
+
+    cursor_window_t window = cursor_window(rb);
+    uint32_t lost = cursor_catch_up(cursor, &window);
+    uint32_t lag = window.newest - cursor->position;
+    uint32_t n = (lag < max_samples) ? lag : max_samples;
+
+    if (lag > cursor->max_lag) {
+        cursor->max_lag = lag;
+    }
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) {
+        if (n > 0) {
+            // Samples overwritten during the copy are dropped and counted too
+            uint32_t first = cursor->position;
+            uint32_t oldest;
+            n = spsc_copy(rb, &first, n, samples, &oldest);
+            lost += first - cursor->position;
+            cursor->position = first;
+        }
+    } else {
+        sensor_ring_buffer_span_t spans[2];
+        make_spans(rb, rb_slot(rb, rb->tail + (cursor->position - window.oldest)), n, spans);
+        copy_spans(rb, samples, spans);
+        os_mutex_give(rb->mutex);
+    }
+
+    cursor->position += n;
+    cursor->overruns += lost;
+    cursor->read_count += n;
+    *samples_read = n;
+
+    watermark_check_low(cursor, window.newest - cursor->position);
+
+    if (lost > 0) {
+        return SENSOR_RING_BUFFER_ERR_OVERWRITTEN;
+    }
+    return (n > 0) ? SENSOR_RING_BUFFER_OK : SENSOR_RING_BUFFER_ERR_EMPTY;
+}
+
+sensor_ring_buffer_status_t sensor_ring_buffer_cursor_set_watermarks(
+    sensor_ring_buffer_cursor_t *cursor,
+    uint32_t high_watermark,
+    uint32_t low_watermark,
+    sensor_ring_buffer_watermark_cb_t callback,
+    void *user_data)
+{
+    if (cursor == NULL) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    sensor_ring_buffer_t *rb = cursor->rb;
+    if (rb == NULL || !rb->initialized) {
+        return SENSOR_RING_BUFFER_ERR_NOT_INIT;
+    }
+
+    // SPSC mode holds one sample less than its capacity
+    uint32_t most = (rb->mode == SENSOR_RING_BUFFER_MODE_SPSC) ? rb->capacity - 1 : rb->capacity;
+    if (high_watermark != 0 &&
+        (callback == NULL || low_watermark >= high_watermark || high_watermark > most)) {
+        return SENSOR_RING_BUFFER_ERR_INVALID_ARG;
+    }
+
+    uint32_t mask = os_critical_enter();
+    if (cursor->high_watermark == 0 && high_watermark != 0) {
+        rb->watermarks++;
+    } else if (cursor->high_watermark != 0 && high_watermark == 0) {
+        rb->watermarks--;
+    }
+    cursor->high_watermark = high_watermark;
+    cursor->low_watermark = (high_watermark != 0) ? low_watermark : 0;
+    cursor->watermark_cb = (high_watermark != 0) ? callback : NULL;
+    cursor->watermark_arg = user_data;
+    cursor->above = false;
+    os_critical_exit(mask);
+
+    return SENSOR_RING_BUFFER_OK;
+}
+
+uint32_t sensor_ring_buffer_cursor_lag(const sensor_ring_buffer_cursor_t *cursor)
+{
+    if (cursor == NULL || cursor->rb == NULL || !cursor->rb->initialized) {
+        return 0;
+    }
+
+    // Mutex mode: a snapshot of two counters, good enough for a gauge
+    cursor_window_t window = cursor_window(cursor->rb);
+    return cursor_lag(cursor, &window);
+}
+
+void sensor_ring_buffer_cursor_get_stats(
+    const sensor_ring_buffer_cursor_t *cursor,
+    sensor_ring_buffer_cursor_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    if (cursor == NULL) {
+        return;
+    }
+    stats->lag = sensor_ring_buffer_cursor_lag(cursor);
+    stats->max_lag = cursor->max_lag;
+    stats->overruns = cursor->overruns;
+    stats->read_count = cursor->read_count;
+}
+
+uint32_t sensor_ring_buffer_get_max_lag(sensor_ring_buffer_t *rb)
+{
+    if (rb == NULL || !rb->initialized) {
+        return 0;
+    }
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_MUTEX) {
+        os_mutex_take(rb->mutex, OS_WAIT_FOREVER);
+    }
+    cursor_window_t window = cursor_window(rb);
+
+    uint32_t max_lag = 0;
+    uint32_t mask = os_critical_enter();
+    for (const sensor_ring_buffer_cursor_t *cursor = rb->cursors; cursor != NULL; cursor = cursor->next) {
+        uint32_t lag = cursor_lag(cursor, &window);
+        if (lag > max_lag) {
+            max_lag = lag;
+        }
+    }
+    os_critical_exit(mask);
+
+    if (rb->mode == SENSOR_RING_BUFFER_MODE_MUTEX) {
+        os_mutex_give(rb->mutex);
+    }
+    return max_lag;
+}
+
 sensor_type_t sensor_ring_buffer_get_sensor_type(const sensor_ring_buffer_t *rb)
 {
     if (rb == NULL) {
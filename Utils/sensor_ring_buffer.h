@@ -5,6 +5,28 @@
  * This module provides a reusable, thread-safe ring buffer for storing sensor
  * samples. Multiple instances can be created for different sensor types.
  *
+ * Two synchronization modes:
+ * - SENSOR_RING_BUFFER_MODE_MUTEX: every call takes an os mutex; any number
+ *   of producers and consumers (not from ISRs).
+ * - SENSOR_RING_BUFFER_MODE_SPSC: lock-free for one producer (task or ISR,
+ *   see sensor_ring_buffer_push_isr()) and one consumer context. The
+ *   producer still overwrites the oldest sample; readers validate what they
+ *   copied against the head index and drop samples overwritten meanwhile.
+ *   One slot is kept free for the write in progress, so it holds
+ *   capacity - 1 samples. The capacity must be a power of two.
+ *
+ * Consumers that each need their own read position (display, streaming,
+ * logging, statistics) attach a cursor. A cursor reads only what was pushed
+ * since its last read, and counts samples the producer overwrote before it
+ * got to them. Cursors do not hold samples back: a slow consumer loses
+ * samples, it never blocks the producer or the other consumers. In SPSC
+ * mode any number of cursors read lock-free, one context per cursor.
+ *
+ * A cursor can also carry watermarks, so its consumer sleeps instead of
+ * polling the count: the callback reports HIGH from the producer once the
+ * cursor's lag reaches the high mark, and LOW from the consumer's read that
+ * brings it down to the low mark. Each is reported once per crossing.
+ *
  * Usage example:
  * @code
  * // Create a buffer for temperature samples
@@ -21,6 +43,11 @@
  * sensor_sample_t samples[10];
  * uint32_t count;
  * sensor_ring_buffer_read(&temp_buffer, 0, samples, 10, &count);
+ *
+ * // Or drain what is new, from a consumer of its own
+ * static sensor_ring_buffer_cursor_t log_cursor;
+ * sensor_ring_buffer_cursor_attach(&temp_buffer, &log_cursor, "log", false);
+ * sensor_ring_buffer_cursor_read(&log_cursor, samples, 10, &count);
  * @endcode
  */
 
@@ -43,9 +70,11 @@ extern "C" {
 /**
  * @brief Default buffer capacity (number of samples)
  *
- * With sensor_sample_t being 9 bytes, 455 samples use ~4KB
+ * Stored as 8-byte records, 512 samples use 4KB. Power-of-two
+ * capacities index by masking instead of dividing; mutex mode also takes
+ * any other capacity, SPSC mode only powers of two.
  */
-#define SENSOR_RING_BUFFER_DEFAULT_CAPACITY    455
+#define SENSOR_RING_BUFFER_DEFAULT_CAPACITY    512
 
 // ============================================================================
 // Types
@@ -61,16 +90,47 @@ typedef enum {
     SENSOR_RING_BUFFER_ERR_ALREADY_INIT,
     SENSOR_RING_BUFFER_ERR_EMPTY,
     SENSOR_RING_BUFFER_ERR_NO_MEM,
+    SENSOR_RING_BUFFER_ERR_UNSUPPORTED,     /**< Not available in this buffer's mode */
+    SENSOR_RING_BUFFER_ERR_OVERWRITTEN,     /**< Producer overwrote samples before they were read */
 } sensor_ring_buffer_status_t;
 
+/**
+ * @brief Synchronization mode
+ */
+typedef enum {
+    SENSOR_RING_BUFFER_MODE_MUTEX = 0,      /**< Mutex-guarded, multiple producers/consumers */
+    SENSOR_RING_BUFFER_MODE_SPSC,           /**< Lock-free, single producer and consumer */
+} sensor_ring_buffer_mode_t;
+
 /**
  * @brief Ring buffer configuration
  */
 typedef struct {
     uint32_t capacity;          /**< Maximum number of samples (0 = default) */
     sensor_type_t sensor_type;  /**< Sensor type for samples in this buffer */
+    sensor_ring_buffer_mode_t mode; /**< Synchronization mode */
 } sensor_ring_buffer_config_t;
 
+/**
+ * @brief Sample as the buffer stores it
+ *
+ * Aligned, and without the sensor type (one per buffer): 8 bytes against
+ * the 9 of a packed sensor_sample_t. Reads pack records back into
+ * sensor_sample_t, the wire format.
+ */
+typedef struct {
+    uint32_t timestamp;         /**< As sensor_sample_t.timestamp */
+    int32_t value;              /**< As sensor_sample_t.value */
+} sensor_ring_buffer_record_t;
+
+/**
+ * @brief Contiguous run of samples inside the buffer storage
+ */
+typedef struct {
+    const sensor_ring_buffer_record_t *data; /**< First record of the run */
+    uint32_t count;                 /**< Samples in the run (may be 0) */
+} sensor_ring_buffer_span_t;
+
 /**
  * @brief Ring buffer instance
  *
@@ -78,16 +138,77 @@ typedef struct {
  * All fields are private - use API functions to access.
  */
 typedef struct {
-    sensor_sample_t *buffer;    /**< Sample storage (dynamically allocated) */
+    sensor_ring_buffer_record_t *buffer; /**< Sample storage */
+    bool owns_buffer;           /**< Storage was allocated by init (freed by deinit) */
     uint32_t capacity;          /**< Maximum samples */
-    uint32_t head;              /**< Write index */
-    uint32_t tail;              /**< Read index (oldest sample) */
-    uint32_t count;             /**< Current sample count */
+    uint32_t mask;              /**< capacity - 1 for power-of-two capacities, else 0 */
+    volatile uint32_t head;     /**< Write index, free-running if mask != 0 (SPSC: samples ever pushed, producer-owned) */
+    volatile uint32_t tail;     /**< Read index, oldest sample (SPSC: clear point, consumer-owned) */
+    uint32_t span_first;        /**< SPSC: first index handed out by get_read_spans() */
+    uint32_t count;             /**< Current sample count (mutex mode) */
+    uint32_t pushed;            /**< Mutex mode: samples ever pushed, free-running (cursor positions) */
+    uint32_t floor;             /**< Mutex mode: pushed count at the last clear or commit */
+    struct sensor_ring_buffer_cursor *cursors; /**< Attached cursors */
+    volatile uint32_t watermarks; /**< Attached cursors with watermarks (push skips the check at 0) */
     sensor_type_t sensor_type;  /**< Sensor type for this buffer */
-    os_mutex_handle_t mutex;    /**< Thread safety mutex */
+    sensor_ring_buffer_mode_t mode; /**< Synchronization mode */
+    os_mutex_handle_t mutex;    /**< Thread safety mutex (mutex mode) */
+    os_mutex_storage_t mutex_storage; /**< Its control block, inside the instance */
     bool initialized;           /**< Initialization flag */
 } sensor_ring_buffer_t;
 
+struct sensor_ring_buffer_cursor;
+
+/**
+ * @brief Watermark crossings reported to a cursor's callback
+ */
+typedef enum {
+    SENSOR_RING_BUFFER_WATERMARK_HIGH = 0,  /**< Lag reached the high mark (producer context) */
+    SENSOR_RING_BUFFER_WATERMARK_LOW,       /**< A read took the lag down to the low mark */
+} sensor_ring_buffer_watermark_t;
+
+/**
+ * @brief Watermark callback
+ *
+ * HIGH runs in the context of the push (possibly an ISR; in mutex mode
+ * with the buffer's mutex held), LOW in that of the read: post a job or
+ * notify a task, never touch the buffer.
+ */
+typedef void (*sensor_ring_buffer_watermark_cb_t)(
+    struct sensor_ring_buffer_cursor *cursor,
+    sensor_ring_buffer_watermark_t level,
+    void *user_data);
+
+/**
+ * @brief Read position of one consumer; attach with sensor_ring_buffer_cursor_attach()
+ *
+ * Fields are private; the caller provides the storage.
+ */
+typedef struct sensor_ring_buffer_cursor {
+    sensor_ring_buffer_t *rb;   /**< Buffer attached to, NULL when detached */
+    const char *name;
+    uint32_t position;          /**< Samples pushed before the next one to read */
+    uint32_t max_lag;           /**< Most unread samples found at a read */
+    uint32_t overruns;          /**< Samples overwritten before this cursor read them */
+    uint32_t read_count;        /**< Samples delivered */
+    uint32_t high_watermark;    /**< Lag that reports HIGH (0: no watermarks) */
+    uint32_t low_watermark;     /**< Lag that reports LOW after a HIGH */
+    sensor_ring_buffer_watermark_cb_t watermark_cb;
+    void *watermark_arg;
+    volatile bool above;        /**< HIGH reported, LOW not yet */
+    struct sensor_ring_buffer_cursor *next;
+} sensor_ring_buffer_cursor_t;
+
+/**
+ * @brief Cursor counters (snapshot)
+ */
+typedef struct {
+    uint32_t lag;               /**< Unread samples now */
+    uint32_t max_lag;           /**< Most unread samples found at a read */
+    uint32_t overruns;          /**< Samples overwritten before they were read */
+    uint32_t read_count;        /**< Samples delivered */
+} sensor_ring_buffer_cursor_stats_t;
+
 // ============================================================================
 // Public API
 // ============================================================================
@@ -111,6 +232,30 @@ sensor_ring_buffer_status_t sensor_ring_buffer_init(
     sensor_ring_buffer_t *rb,
     const sensor_ring_buffer_config_t *config);
 
+/**
+ * @brief Initialize a ring buffer instance on caller-provided storage
+ *
+ * Same as sensor_ring_buffer_init() but the heap is not touched for the
+ * samples, so the storage can be a static array in any RAM region:
+ * @code
+ * static sensor_ring_buffer_record_t temp_storage[512] HAL_DTCM_BSS;
+ * sensor_ring_buffer_init_static(&temp_buffer, &config, temp_storage, 512);
+ * @endcode
+ * The mutex (mutex mode) lives inside the instance. The storage must
+ * outlive the buffer; deinit does not free it.
+ *
+ * @param rb Pointer to ring buffer instance
+ * @param config Configuration (NULL for defaults); its capacity is ignored
+ * @param storage Sample storage
+ * @param capacity Number of samples in storage
+ * @return SENSOR_RING_BUFFER_OK on success
+ */
+sensor_ring_buffer_status_t sensor_ring_buffer_init_static(
+    sensor_ring_buffer_t *rb,
+    const sensor_ring_buffer_config_t *config,
+    sensor_ring_buffer_record_t *storage,
+    uint32_t capacity);
+
 /**
  * @brief Deinitialize a ring buffer instance
  *
@@ -143,6 +288,70 @@ sensor_ring_buffer_status_t sensor_ring_buffer_push(
     sensor_ring_buffer_t *rb,
     const sensor_sample_t *sample);
 
+/**
+ * @brief Push a sample from interrupt context
+ *
+ * Same as sensor_ring_buffer_push() for SPSC buffers, which never block.
+ *
+ * @param rb Pointer to ring buffer instance
+ * @param sample Sample to add
+ * @return SENSOR_RING_BUFFER_OK on success, SENSOR_RING_BUFFER_ERR_UNSUPPORTED
+ *         for a mutex-mode buffer
+ */
+sensor_ring_buffer_status_t sensor_ring_buffer_push_isr(
+    sensor_ring_buffer_t *rb,
+    const sensor_sample_t *sample);
+
+/**
+ * @brief Push several samples at once
+ *
+ * Mutex mode copies them in at most two runs under one lock; SPSC mode
+ * publishes them one by one. If count exceeds the capacity only the
+ * newest samples are kept.
+ *
+ * @param rb Pointer to ring buffer instance
+ * @param samples Samples to add (oldest first)
+ * @param count Number of samples
+ * @return SENSOR_RING_BUFFER_OK on success
+ */
+sensor_ring_buffer_status_t sensor_ring_buffer_push_n(
+    sensor_ring_buffer_t *rb,
+    const sensor_sample_t *samples,
+    uint32_t count);
+
+/**
+ * @brief Get the oldest samples in place, as up to two contiguous runs
+ *
+ * Zero-copy read: the runs point into the buffer storage, as records
+ * (the buffer's sensor type completes them to sensor_sample_t). Every call must be followed by
+ * sensor_ring_buffer_commit_read(); in mutex mode the mutex is held until
+ * then. In SPSC mode nothing is locked, and the producer overwriting the
+ * runs is reported by the commit.
+ *
+ * @param rb Pointer to ring buffer instance
+ * @param max_samples Maximum samples to return
+ * @param spans Output: spans[0] from the oldest sample, spans[1] after the wrap
+ * @return Total samples in both spans
+ */
+uint32_t sensor_ring_buffer_get_read_spans(
+    sensor_ring_buffer_t *rb,
+    uint32_t max_samples,
+    sensor_ring_buffer_span_t spans[2]);
+
+/**
+ * @brief Finish a sensor_ring_buffer_get_read_spans() access
+ *
+ * Removes the first consumed samples (0 leaves the buffer unchanged).
+ *
+ * @param rb Pointer to ring buffer instance
+ * @param consumed Number of samples to remove from the oldest end
+ * @return SENSOR_RING_BUFFER_OK, or SENSOR_RING_BUFFER_ERR_OVERWRITTEN if
+ *         (SPSC) the producer lapped the spans while they were in use
+ */
+sensor_ring_buffer_status_t sensor_ring_buffer_commit_read(
+    sensor_ring_buffer_t *rb,
+    uint32_t consumed);
+
 /**
  * @brief Get the number of samples in the buffer
  *
@@ -193,16 +402,149 @@ sensor_ring_buffer_status_t sensor_ring_buffer_peek(
     uint32_t index,
     sensor_sample_t *sample);
 
+/**
+ * @brief Find the first sample at or after a timestamp
+ *
+ * Binary search over the buffered samples; relies on timestamps being
+ * non-decreasing from oldest to newest, as they are when pushed in capture
+ * order from one clock. In SPSC mode the index can be stale by the time it
+ * is used if the producer overwrites samples meanwhile; use
+ * sensor_ring_buffer_read_time_range() to search and copy in one go.
+ *
+ * @param rb Pointer to ring buffer instance
+ * @param timestamp Timestamp to search for
+ * @param index Output: logical index (0 = oldest); the sample count if
+ *        every sample is older
+ * @return SENSOR_RING_BUFFER_OK, or SENSOR_RING_BUFFER_ERR_EMPTY if no
+ *         sample is at or after timestamp
+ */
+sensor_ring_buffer_status_t sensor_ring_buffer_find_time(
+    sensor_ring_buffer_t *rb,
+    uint32_t timestamp,
+    uint32_t *index);
+
+/**
+ * @brief Read samples with from_timestamp <= timestamp < to_timestamp
+ *
+ * Does not remove samples. Reads from the oldest match, so a range with
+ * more than max_samples matches is continued by calling again with
+ * from_timestamp just past the last sample read, or by index from
+ * first_index + samples_read.
+ *
+ * @param rb Pointer to ring buffer instance
+ * @param from_timestamp First timestamp included
+ * @param to_timestamp First timestamp excluded (UINT32_MAX for no limit)
+ * @param samples Output array
+ * @param max_samples Maximum samples to read
+ * @param samples_read Output: actual number read
+ * @param first_index Output (optional): logical index of samples[0]
+ * @return SENSOR_RING_BUFFER_OK, or SENSOR_RING_BUFFER_ERR_EMPTY if nothing matched
+ */
+sensor_ring_buffer_status_t sensor_ring_buffer_read_time_range(
+    sensor_ring_buffer_t *rb,
+    uint32_t from_timestamp,
+    uint32_t to_timestamp,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read,
+    uint32_t *first_index);
+
 /**
  * @brief Clear all samples from the buffer
  *
- * Thread-safe.
+ * Thread-safe. In SPSC mode this belongs to the consumer side (the
+ * producer keeps pushing after the clear point).
  *
  * @param rb Pointer to ring buffer instance
  * @return SENSOR_RING_BUFFER_OK on success
  */
 sensor_ring_buffer_status_t sensor_ring_buffer_clear(sensor_ring_buffer_t *rb);
 
+/**
+ * @brief Attach a consumer cursor
+ *
+ * @param rb Pointer to ring buffer instance
+ * @param cursor Caller-provided cursor (outlives the attachment)
+ * @param name Consumer name, for diagnostics
+ * @param from_oldest true to start at the oldest buffered sample, false to
+ *        read only samples pushed from now on
+ * @return SENSOR_RING_BUFFER_OK, or SENSOR_RING_BUFFER_ERR_ALREADY_INIT if
+ *         the cursor is attached already
+ */
+sensor_ring_buffer_status_t sensor_ring_buffer_cursor_attach(
+    sensor_ring_buffer_t *rb,
+    sensor_ring_buffer_cursor_t *cursor,
+    const char *name,
+    bool from_oldest);
+
+/**
+ * @brief Detach a cursor (deinit detaches all of them)
+ */
+void sensor_ring_buffer_cursor_detach(sensor_ring_buffer_cursor_t *cursor);
+
+/**
+ * @brief Read the samples pushed since the cursor's last read
+ *
+ * Copies up to max_samples, oldest first, and moves the cursor past them.
+ * Samples the producer overwrote before the cursor reached them are
+ * skipped and counted; samples removed by sensor_ring_buffer_clear() or a
+ * commit are skipped without counting. One context per cursor.
+ *
+ * @param cursor Attached cursor
+ * @param samples Output array
+ * @param max_samples Maximum samples to read
+ * @param samples_read Output: actual number read
+ * @return SENSOR_RING_BUFFER_OK, SENSOR_RING_BUFFER_ERR_EMPTY if nothing is
+ *         new, or SENSOR_RING_BUFFER_ERR_OVERWRITTEN if samples were lost
+ *         before the ones read (samples_read is still valid)
+ */
+sensor_ring_buffer_status_t sensor_ring_buffer_cursor_read(
+    sensor_ring_buffer_cursor_t *cursor,
+    sensor_sample_t *samples,
+    uint32_t max_samples,
+    uint32_t *samples_read);
+
+/**
+ * @brief Set or clear a cursor's watermarks
+ *
+ * HIGH is reported when a push brings the cursor's lag to high_watermark
+ * or more, LOW when a read brings it down to low_watermark or less; then
+ * HIGH is armed again. A read that leaves the lag above low_watermark
+ * keeps HIGH reported, so a consumer woken by HIGH reads until LOW. If the
+ * lag is at the high mark already, the next push reports it.
+ *
+ * @param cursor Attached cursor
+ * @param high_watermark Lag that reports HIGH, 0 to clear the watermarks
+ * @param low_watermark Lag that reports LOW, below high_watermark
+ * @param callback Called at each crossing (NULL only when clearing)
+ * @param user_data Passed to the callback
+ * @return SENSOR_RING_BUFFER_OK, SENSOR_RING_BUFFER_ERR_NOT_INIT if the
+ *         cursor is not attached, or SENSOR_RING_BUFFER_ERR_INVALID_ARG
+ */
+sensor_ring_buffer_status_t sensor_ring_buffer_cursor_set_watermarks(
+    sensor_ring_buffer_cursor_t *cursor,
+    uint32_t high_watermark,
+    uint32_t low_watermark,
+    sensor_ring_buffer_watermark_cb_t callback,
+    void *user_data);
+
+/**
+ * @brief Unread samples still in the buffer for a cursor
+ */
+uint32_t sensor_ring_buffer_cursor_lag(const sensor_ring_buffer_cursor_t *cursor);
+
+/**
+ * @brief Get the counters of a cursor
+ */
+void sensor_ring_buffer_cursor_get_stats(
+    const sensor_ring_buffer_cursor_t *cursor,
+    sensor_ring_buffer_cursor_stats_t *stats);
+
+/**
+ * @brief Lag of the slowest attached cursor (0 without cursors)
+ */
+uint32_t sensor_ring_buffer_get_max_lag(sensor_ring_buffer_t *rb);
+
 /**
  * @brief Get the sensor type for this buffer
  *
@@ -0,0 +1,232 @@
+/**
+ * @file sensor_rollup.c
+ * @brief Multi-resolution min/max/mean history kept alongside a sample ring
+ */
+
+#include "sensor_rollup.h"
+#include <string.h>
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static inline sensor_rollup_record_t *tier_record(const sensor_rollup_tier_t *tier, uint32_t index)
+{
+    return &tier->records[index % tier->capacity];
+}
+
+static inline uint32_t tier_count(const sensor_rollup_tier_t *tier)
+{
+    return (tier->written < tier->capacity) ? tier->written : tier->capacity;
+}
+
+// Fold a bucket (one sample or one finished lower-tier bucket) into a tier;
+// cascades upwards when the tier's bucket completes
+static void tier_add(sensor_rollup_t *rollup, uint32_t level, const sensor_rollup_bucket_t *in)
+{
+    sensor_rollup_tier_t *tier = &rollup->tiers[level];
+    sensor_rollup_bucket_t *bucket = &tier->bucket;
+
+    if (bucket->inputs == 0) {
+        *bucket = *in;
+        bucket->inputs = 0;
+    } else {
+        if (in->min < bucket->min) {
+            bucket->min = in->min;
+        }
+        if (in->max > bucket->max) {
+            bucket->max = in->max;
+        }
+        bucket->sum += in->sum;
+        bucket->count += in->count;
+    }
+
+    if (++bucket->inputs < tier->fan_in) {
+        return;
+    }
+
+    // Round half away from zero
+    int64_t half = (int64_t)(bucket->count / 2);
+    int64_t mean = (bucket->sum >= 0)
+                   ? (bucket->sum + half) / bucket->count
+                   : (bucket->sum - half) / bucket->count;
+
+    sensor_rollup_record_t *record = tier_record(tier, tier->written);
+    record->timestamp = bucket->timestamp;
+    record->min = bucket->min;
+    record->max = bucket->max;
+    record->mean = (int32_t)mean;
+    record->count = (bucket->count > UINT16_MAX) ? UINT16_MAX : (uint16_t)bucket->count;
+    tier->written++;
+
+    sensor_rollup_bucket_t done = *bucket;
+    bucket->inputs = 0;
+
+    if (level + 1 < rollup->tier_count) {
+        tier_add(rollup, level + 1, &done);
+    }
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+sensor_rollup_status_t sensor_rollup_init(
+    sensor_rollup_t *rollup,
+    const sensor_rollup_tier_config_t *tiers,
+    uint32_t tier_count)
+{
+    if (rollup == NULL || tiers == NULL || tier_count == 0 || tier_count > SENSOR_ROLLUP_MAX_TIERS) {
+        return SENSOR_ROLLUP_ERR_INVALID_ARG;
+    }
+
+    for (uint32_t i = 0; i < tier_count; i++) {
+        if (tiers[i].records == NULL || tiers[i].capacity == 0 || tiers[i].fan_in == 0) {
+            return SENSOR_ROLLUP_ERR_INVALID_ARG;
+        }
+    }
+
+    memset(rollup, 0, sizeof(*rollup));
+
+    rollup->mutex = os_mutex_create_static(&rollup->mutex_storage);
+    if (rollup->mutex == NULL) {
+        return SENSOR_ROLLUP_ERR_NO_MEM;
+    }
+
+    for (uint32_t i = 0; i < tier_count; i++) {
+        rollup->tiers[i].records = tiers[i].records;
+        rollup->tiers[i].capacity = tiers[i].capacity;
+        rollup->tiers[i].fan_in = tiers[i].fan_in;
+    }
+    rollup->tier_count = tier_count;
+    rollup->initialized = true;
+
+    return SENSOR_ROLLUP_OK;
+}
+
+sensor_rollup_status_t sensor_rollup_add(sensor_rollup_t *rollup, const sensor_sample_t *sample)
+{
+    if (rollup == NULL || sample == NULL) {
+        return SENSOR_ROLLUP_ERR_INVALID_ARG;
+    }
+
+    if (!rollup->initialized) {
+        return SENSOR_ROLLUP_ERR_NOT_INIT;
+    }
+
+    sensor_rollup_bucket_t in = {
+        .timestamp = sample->timestamp,
+        .min = sample->value,
+        .max = sample->value,
+        .sum = sample->value,
+        .count = 1,
+        .inputs = 0,
+    };
+
+    os_mutex_take(rollup->mutex, OS_WAIT_FOREVER);
+    tier_add(rollup, 0, &in);
+    os_mutex_give(rollup->mutex);
+
+    return SENSOR_ROLLUP_OK;
+}
+
+uint32_t sensor_rollup_get_tier_count(const sensor_rollup_t *rollup)
+{
+    if (rollup == NULL || !rollup->initialized) {
+        return 0;
+    }
+    return rollup->tier_count;
+}
+
+uint32_t sensor_rollup_get_count(sensor_rollup_t *rollup, uint32_t tier)
+{
+    if (rollup == NULL || !rollup->initialized || tier >= rollup->tier_count) {
+        return 0;
+    }
+    return tier_count(&rollup->tiers[tier]);
+}
+
+sensor_rollup_status_t sensor_rollup_read(
+    sensor_rollup_t *rollup,
+    uint32_t tier,
+    uint32_t from_timestamp,
+    sensor_rollup_record_t *records,
+    uint32_t max_records,
+    uint32_t *records_read,
+    uint32_t *first_index)
+{
+    if (rollup == NULL || records == NULL || records_read == NULL) {
+        return SENSOR_ROLLUP_ERR_INVALID_ARG;
+    }
+
+    if (!rollup->initialized) {
+        return SENSOR_ROLLUP_ERR_NOT_INIT;
+    }
+
+    if (tier >= rollup->tier_count) {
+        return SENSOR_ROLLUP_ERR_INVALID_ARG;
+    }
+
+    *records_read = 0;
+
+    os_mutex_take(rollup->mutex, OS_WAIT_FOREVER);
+
+    const sensor_rollup_tier_t *t = &rollup->tiers[tier];
+    uint32_t count = tier_count(t);
+    uint32_t oldest = t->written - count;
+
+    // Binary search: record timestamps are non-decreasing
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (tier_record(t, oldest + mid)->timestamp < from_timestamp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    uint32_t n = count - lo;
+    if (n > max_records) {
+        n = max_records;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        records[i] = *tier_record(t, oldest + lo + i);
+    }
+
+    os_mutex_give(rollup->mutex);
+
+    if (first_index != NULL) {
+        *first_index = lo;
+    }
+
+    if (n == 0) {
+        return SENSOR_ROLLUP_ERR_EMPTY;
+    }
+
+    *records_read = n;
+    return SENSOR_ROLLUP_OK;
+}
+
+sensor_rollup_status_t sensor_rollup_clear(sensor_rollup_t *rollup)
+{
+    if (rollup == NULL) {
+        return SENSOR_ROLLUP_ERR_INVALID_ARG;
+    }
+
+    if (!rollup->initialized) {
+        return SENSOR_ROLLUP_ERR_NOT_INIT;
+    }
+
+    os_mutex_take(rollup->mutex, OS_WAIT_FOREVER);
+
+    for (uint32_t i = 0; i < rollup->tier_count; i++) {
+        rollup->tiers[i].written = 0;
+        memset(&rollup->tiers[i].bucket, 0, sizeof(rollup->tiers[i].bucket));
+    }
+
+    os_mutex_give(rollup->mutex);
+
+    return SENSOR_ROLLUP_OK;
+}
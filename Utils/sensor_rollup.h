@@ -0,0 +1,190 @@
+/**
+ * @file sensor_rollup.h
+ * @brief Multi-resolution min/max/mean history kept alongside a sample ring
+ *
+ * A rollup holds up to SENSOR_ROLLUP_MAX_TIERS rings of
+ * sensor_rollup_record_t. Tier 0 summarizes every fan_in raw samples, each
+ * higher tier every fan_in records of the tier below, so the history is
+ * kept incrementally: adding a sample costs a few compares per tier and
+ * nothing is ever recomputed from raw data. Tiers count inputs rather than
+ * time, which keeps them aligned across a switch from boot-relative to RTC
+ * timestamps; with a fixed sampling interval that is the same thing.
+ *
+ * Records only appear once complete; the bucket being filled is not
+ * readable. Storage is provided by the caller for every tier.
+ *
+ * Usage example:
+ * @code
+ * // 10 s samples: 1 min and 1 h tiers
+ * static sensor_rollup_record_t minutes[256];
+ * static sensor_rollup_record_t hours[168];
+ * const sensor_rollup_tier_config_t tiers[] = {
+ *     { .records = minutes, .capacity = 256, .fan_in = 6 },
+ *     { .records = hours,   .capacity = 168, .fan_in = 60 },
+ * };
+ * sensor_rollup_t history;
+ * sensor_rollup_init(&history, tiers, 2);
+ *
+ * // With every raw sample
+ * sensor_rollup_add(&history, &sample);
+ *
+ * // Hourly records since a timestamp
+ * sensor_rollup_record_t out[8];
+ * uint32_t count, first;
+ * sensor_rollup_read(&history, 1, since, out, 8, &count, &first);
+ * @endcode
+ */
+
+#ifndef SENSOR_ROLLUP_H
+#define SENSOR_ROLLUP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "os_wrapper.h"
+#include "protocol_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define SENSOR_ROLLUP_MAX_TIERS     4
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Rollup status codes
+ */
+typedef enum {
+    SENSOR_ROLLUP_OK = 0,
+    SENSOR_ROLLUP_ERR_INVALID_ARG,
+    SENSOR_ROLLUP_ERR_NOT_INIT,
+    SENSOR_ROLLUP_ERR_EMPTY,
+    SENSOR_ROLLUP_ERR_NO_MEM,
+} sensor_rollup_status_t;
+
+/**
+ * @brief Tier configuration
+ */
+typedef struct {
+    sensor_rollup_record_t *records;    /**< Record storage */
+    uint32_t capacity;                  /**< Records in storage */
+    uint32_t fan_in;                    /**< Inputs per record: raw samples (tier 0) or records of the tier below */
+} sensor_rollup_tier_config_t;
+
+/**
+ * @brief Bucket being filled (private)
+ */
+typedef struct {
+    uint32_t timestamp;
+    int32_t min;
+    int32_t max;
+    int64_t sum;                /**< Sum of all raw values covered */
+    uint32_t count;             /**< Raw samples covered */
+    uint32_t inputs;            /**< Inputs so far, up to fan_in */
+} sensor_rollup_bucket_t;
+
+/**
+ * @brief One tier (private)
+ */
+typedef struct {
+    sensor_rollup_record_t *records;
+    uint32_t capacity;
+    uint32_t fan_in;
+    uint32_t written;           /**< Records ever written (free-running) */
+    sensor_rollup_bucket_t bucket;
+} sensor_rollup_tier_t;
+
+/**
+ * @brief Rollup instance
+ *
+ * All fields are private - use API functions to access.
+ */
+typedef struct {
+    sensor_rollup_tier_t tiers[SENSOR_ROLLUP_MAX_TIERS];
+    uint32_t tier_count;
+    os_mutex_handle_t mutex;    /**< Guards adds against reads */
+    os_mutex_storage_t mutex_storage;
+    bool initialized;
+} sensor_rollup_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Initialize a rollup
+ *
+ * @param rollup Pointer to rollup instance (caller allocates the struct)
+ * @param tiers Tier configurations, finest first
+ * @param tier_count Number of tiers (1..SENSOR_ROLLUP_MAX_TIERS)
+ * @return SENSOR_ROLLUP_OK on success
+ */
+sensor_rollup_status_t sensor_rollup_init(
+    sensor_rollup_t *rollup,
+    const sensor_rollup_tier_config_t *tiers,
+    uint32_t tier_count);
+
+/**
+ * @brief Feed one raw sample
+ *
+ * Completes a record in every tier whose bucket fills up.
+ *
+ * @param rollup Pointer to rollup instance
+ * @param sample Raw sample
+ * @return SENSOR_ROLLUP_OK on success
+ */
+sensor_rollup_status_t sensor_rollup_add(sensor_rollup_t *rollup, const sensor_sample_t *sample);
+
+/**
+ * @brief Number of tiers
+ */
+uint32_t sensor_rollup_get_tier_count(const sensor_rollup_t *rollup);
+
+/**
+ * @brief Number of complete records held in a tier
+ */
+uint32_t sensor_rollup_get_count(sensor_rollup_t *rollup, uint32_t tier);
+
+/**
+ * @brief Read records of a tier starting at a timestamp
+ *
+ * Reads, oldest first, the records whose timestamp is >= from_timestamp
+ * (0 = from the oldest). Does not remove records.
+ *
+ * @param rollup Pointer to rollup instance
+ * @param tier Tier (0 = finest)
+ * @param from_timestamp First record timestamp included
+ * @param records Output array
+ * @param max_records Maximum records to read
+ * @param records_read Output: actual number read
+ * @param first_index Output (optional): index of records[0] in the tier (0 = oldest)
+ * @return SENSOR_ROLLUP_OK, or SENSOR_ROLLUP_ERR_EMPTY if no record matched
+ */
+sensor_rollup_status_t sensor_rollup_read(
+    sensor_rollup_t *rollup,
+    uint32_t tier,
+    uint32_t from_timestamp,
+    sensor_rollup_record_t *records,
+    uint32_t max_records,
+    uint32_t *records_read,
+    uint32_t *first_index);
+
+/**
+ * @brief Drop all records and partial buckets
+ *
+ * @param rollup Pointer to rollup instance
+ * @return SENSOR_ROLLUP_OK on success
+ */
+sensor_rollup_status_t sensor_rollup_clear(sensor_rollup_t *rollup);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_ROLLUP_H
@@ -0,0 +1,273 @@
+/**
+ * @file series_codec.c
+ * @brief Bit-packed delta / delta-of-delta encoding of fixed-width records
+ */
+
+#include "series_codec.h"
+#include <string.h>
+
+// Delta buckets after the '0' for zero: prefix '10', '110', '1110'
+#define BUCKETS         3
+#define ESCAPE_PREFIX   0xF     // '1111'
+#define ESCAPE_EXTRA    2       // Delta-of-delta of a field needs bits + 2
+
+static const uint8_t bucket_bits[BUCKETS] = { 4, 8, 12 };
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static bool state_init(series_codec_state_t *state, const series_codec_field_t *fields, uint8_t field_count)
+{
+    if (fields == NULL || field_count == 0 || field_count > SERIES_CODEC_MAX_FIELDS) {
+        return false;
+    }
+
+    memset(state, 0, sizeof(*state));
+    for (uint8_t f = 0; f < field_count; f++) {
+        if (fields[f].bits == 0 || fields[f].bits > SERIES_CODEC_MAX_BITS ||
+            fields[f].kind > SERIES_CODEC_REPEAT) {
+            return false;
+        }
+        state->record_bits_max += (fields[f].kind == SERIES_CODEC_REPEAT)
+                                  ? 1u + fields[f].bits
+                                  : 4u + fields[f].bits + ESCAPE_EXTRA;
+    }
+    state->fields = fields;
+    state->field_count = field_count;
+    return true;
+}
+
+static inline bool fits_signed(int32_t value, uint8_t bits)
+{
+    int32_t half = 1 << (bits - 1);
+    return value >= -half && value < half;
+}
+
+static inline int32_t sign_extend(uint32_t value, uint8_t bits)
+{
+    uint32_t sign = 1u << (bits - 1);
+    return (int32_t)((value ^ sign) - sign);
+}
+
+// MSB first; bits <= 24
+static void put_bits(series_codec_encoder_t *enc, uint32_t value, uint8_t bits)
+{
+    while (bits > 0) {
+        size_t byte = enc->bit_pos >> 3;
+        uint8_t used = (uint8_t)(enc->bit_pos & 7);
+        uint8_t take = (uint8_t)(8 - used);
+        if (take > bits) {
+            take = bits;
+        }
+        if (used == 0) {
+            enc->data[byte] = 0;
+        }
+        uint8_t chunk = (uint8_t)((value >> (bits - take)) & ((1u << take) - 1));
+        enc->data[byte] |= (uint8_t)(chunk << (8 - used - take));
+        enc->bit_pos += take;
+        bits -= take;
+    }
+}
+
+static bool get_bits(series_codec_decoder_t *dec, uint8_t bits, uint32_t *value)
+{
+    if (dec->bit_pos + bits > dec->length * 8) {
+        return false;
+    }
+
+    uint32_t result = 0;
+    while (bits > 0) {
+        size_t byte = dec->bit_pos >> 3;
+        uint8_t used = (uint8_t)(dec->bit_pos & 7);
+        uint8_t take = (uint8_t)(8 - used);
+        if (take > bits) {
+            take = bits;
+        }
+        uint8_t chunk = (uint8_t)((dec->data[byte] >> (8 - used - take)) & ((1u << take) - 1));
+        result = (result << take) | chunk;
+        dec->bit_pos += take;
+        bits -= take;
+    }
+    *value = result;
+    return true;
+}
+
+static void put_delta(series_codec_encoder_t *enc, int32_t delta, uint8_t field_bits)
+{
+    if (delta == 0) {
+        put_bits(enc, 0, 1);
+        return;
+    }
+    for (uint8_t b = 0; b < BUCKETS; b++) {
+        if (fits_signed(delta, bucket_bits[b])) {
+            // b + 1 ones, then a zero
+            put_bits(enc, ((1u << (b + 1)) - 1) << 1, (uint8_t)(b + 2));
+            put_bits(enc, (uint32_t)delta & ((1u << bucket_bits[b]) - 1), bucket_bits[b]);
+            return;
+        }
+    }
+    uint8_t bits = (uint8_t)(field_bits + ESCAPE_EXTRA);
+    put_bits(enc, ESCAPE_PREFIX, 4);
+    put_bits(enc, (uint32_t)delta & ((1u << bits) - 1), bits);
+}
+
+static bool get_delta(series_codec_decoder_t *dec, uint8_t field_bits, int32_t *delta)
+{
+    uint32_t bit;
+    uint8_t ones = 0;
+
+    // Up to four ones; a zero ends the prefix early
+    while (ones < 4) {
+        if (!get_bits(dec, 1, &bit)) {
+            return false;
+        }
+        if (bit == 0) {
+            break;
+        }
+        ones++;
+    }
+
+    if (ones == 0) {
+        *delta = 0;
+        return true;
+    }
+
+    uint8_t bits = (ones <= BUCKETS) ? bucket_bits[ones - 1] : (uint8_t)(field_bits + ESCAPE_EXTRA);
+    uint32_t raw;
+    if (!get_bits(dec, bits, &raw)) {
+        return false;
+    }
+    *delta = sign_extend(raw, bits);
+    return true;
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+bool series_codec_encoder_init(series_codec_encoder_t *enc, const series_codec_field_t *fields,
+                               uint8_t field_count, uint8_t *data, size_t capacity)
+{
+    if (enc == NULL || data == NULL || !state_init(&enc->state, fields, field_count)) {
+        return false;
+    }
+    enc->data = data;
+    enc->capacity = capacity;
+    enc->bit_pos = 0;
+    return true;
+}
+
+bool series_codec_encode(series_codec_encoder_t *enc, const int32_t *values)
+{
+    if (enc == NULL || values == NULL) {
+        return false;
+    }
+
+    series_codec_state_t *state = &enc->state;
+    if (enc->bit_pos + state->record_bits_max > enc->capacity * 8) {
+        return false;
+    }
+
+    for (uint8_t f = 0; f < state->field_count; f++) {
+        const series_codec_field_t *field = &state->fields[f];
+        int32_t value = values[f];
+
+        switch (field->kind) {
+        case SERIES_CODEC_DELTA_OF_DELTA: {
+            int32_t delta = value - state->prev[f];
+            put_delta(enc, delta - state->prev_delta[f], field->bits);
+            state->prev_delta[f] = delta;
+            break;
+        }
+        case SERIES_CODEC_DELTA:
+            put_delta(enc, value - state->prev[f], field->bits);
+            break;
+        default:
+            if (value == state->prev[f]) {
+                put_bits(enc, 0, 1);
+            } else {
+                put_bits(enc, 1, 1);
+                put_bits(enc, (uint32_t)value & ((1u << field->bits) - 1), field->bits);
+            }
+            break;
+        }
+        state->prev[f] = value;
+    }
+
+    state->records++;
+    return true;
+}
+
+size_t series_codec_encoded_bytes(const series_codec_encoder_t *enc)
+{
+    return (enc != NULL) ? (enc->bit_pos + 7) / 8 : 0;
+}
+
+uint32_t series_codec_encoded_records(const series_codec_encoder_t *enc)
+{
+    return (enc != NULL) ? enc->state.records : 0;
+}
+
+bool series_codec_decoder_init(series_codec_decoder_t *dec, const series_codec_field_t *fields,
+                               uint8_t field_count, const uint8_t *data, size_t length)
+{
+    if (dec == NULL || (data == NULL && length > 0) || !state_init(&dec->state, fields, field_count)) {
+        return false;
+    }
+    dec->data = data;
+    dec->length = length;
+    dec->bit_pos = 0;
+    return true;
+}
+
+bool series_codec_decode(series_codec_decoder_t *dec, int32_t *values)
+{
+    if (dec == NULL || values == NULL) {
+        return false;
+    }
+
+    series_codec_state_t *state = &dec->state;
+
+    for (uint8_t f = 0; f < state->field_count; f++) {
+        const series_codec_field_t *field = &state->fields[f];
+        int32_t delta;
+        uint32_t raw;
+
+        switch (field->kind) {
+        case SERIES_CODEC_DELTA_OF_DELTA:
+            if (!get_delta(dec, field->bits, &delta)) {
+                return false;
+            }
+            state->prev_delta[f] += delta;
+            state->prev[f] += state->prev_delta[f];
+            break;
+        case SERIES_CODEC_DELTA:
+            if (!get_delta(dec, field->bits, &delta)) {
+                return false;
+            }
+            state->prev[f] += delta;
+            break;
+        default:
+            if (!get_bits(dec, 1, &raw)) {
+                return false;
+            }
+            if (raw != 0) {
+                if (!get_bits(dec, field->bits, &raw)) {
+                    return false;
+                }
+                state->prev[f] = (int32_t)raw;
+            }
+            break;
+        }
+        values[f] = state->prev[f];
+    }
+
+    state->records++;
+    return true;
+}
+
+size_t series_codec_decoded_bytes(const series_codec_decoder_t *dec)
+{
+    return (dec != NULL) ? (dec->bit_pos + 7) / 8 : 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file series_codec.h
+ * @brief Bit-packed delta / delta-of-delta encoding of fixed-width records
+ *
+ * Gorilla-style compression for long runs of small integer records (raw
+ * sensor registers, time steps). Each record is a fixed list of fields,
+ * each up to SERIES_CODEC_MAX_BITS wide, and every field is coded against
+ * the same field of the previous record by its kind:
+ *
+ *   DELTA_OF_DELTA  the change of the delta: '0' for a steady step
+ *   DELTA           the delta
+ *     '0'                 0
+ *     '10'   + 4 bits     -8..7
+ *     '110'  + 8 bits     -128..127
+ *     '1110' + 12 bits    -2048..2047
+ *     '1111' + bits + 2   anything else (two's complement)
+ *   REPEAT          '0' unchanged, '1' + bits the new value (unsigned)
+ *
+ * Bits are written MSB first. The first record is coded against all-zero
+ * fields (and a zero delta), so every encoded run is self-contained: a
+ * storage or transfer unit that starts its own run can be decoded on its
+ * own. Encoding streams record by record and stops cleanly when the worst
+ * case of one more record no longer fits.
+ *
+ * Usage example:
+ * @code
+ * static const series_codec_field_t fields[] = {
+ *     { SERIES_CODEC_DELTA_OF_DELTA, 16 },    // time step
+ *     { SERIES_CODEC_DELTA, 16 },             // register
+ *     { SERIES_CODEC_REPEAT, 8 },             // state
+ * };
+ * series_codec_encoder_t enc;
+ * series_codec_encoder_init(&enc, fields, 3, block, sizeof(block));
+ * while (series_codec_encode(&enc, values)) { ... next values ... }
+ * size_t used = series_codec_encoded_bytes(&enc);
+ * @endcode
+ */
+
+#ifndef SERIES_CODEC_H
+#define SERIES_CODEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define SERIES_CODEC_MAX_FIELDS     4
+#define SERIES_CODEC_MAX_BITS       16      // Widest field
+
+// ============================================================================
+// Types
+// ============================================================================
+
+typedef enum {
+    SERIES_CODEC_DELTA_OF_DELTA = 0,
+    SERIES_CODEC_DELTA,
+    SERIES_CODEC_REPEAT,
+} series_codec_kind_t;
+
+/**
+ * @brief One field of a record
+ *
+ * Values must fit bits: 0..2^bits-1, or the signed range of that width.
+ */
+typedef struct {
+    uint8_t kind;                   /**< series_codec_kind_t */
+    uint8_t bits;                   /**< 1..SERIES_CODEC_MAX_BITS */
+} series_codec_field_t;
+
+/**
+ * @brief Coding state shared by encoder and decoder (private)
+ */
+typedef struct {
+    const series_codec_field_t *fields;
+    uint8_t field_count;
+    uint32_t record_bits_max;       /**< Worst case of one record */
+    int32_t prev[SERIES_CODEC_MAX_FIELDS];
+    int32_t prev_delta[SERIES_CODEC_MAX_FIELDS];
+    uint32_t records;
+} series_codec_state_t;
+
+/**
+ * @brief Encoder (all fields private)
+ */
+typedef struct {
+    series_codec_state_t state;
+    uint8_t *data;
+    size_t capacity;                /**< Bytes */
+    size_t bit_pos;
+} series_codec_encoder_t;
+
+/**
+ * @brief Decoder (all fields private)
+ */
+typedef struct {
+    series_codec_state_t state;
+    const uint8_t *data;
+    size_t length;                  /**< Bytes */
+    size_t bit_pos;
+} series_codec_decoder_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Start an encoded run in data
+ *
+ * The fields array is referenced, not copied. data is written as bits come;
+ * bytes past the last whole one are cleared as they are started, others
+ * are left as they were.
+ *
+ * @return false if the field list is invalid
+ */
+bool series_codec_encoder_init(series_codec_encoder_t *enc, const series_codec_field_t *fields,
+                               uint8_t field_count, uint8_t *data, size_t capacity);
+
+/**
+ * @brief Append one record
+ *
+ * @param values One value per field
+ * @return false (nothing written) if the worst case of a record does not fit
+ */
+bool series_codec_encode(series_codec_encoder_t *enc, const int32_t *values);
+
+/**
+ * @brief Bytes used so far (the last one may be partly filled)
+ */
+size_t series_codec_encoded_bytes(const series_codec_encoder_t *enc);
+
+/**
+ * @brief Records appended so far
+ */
+uint32_t series_codec_encoded_records(const series_codec_encoder_t *enc);
+
+/**
+ * @brief Start decoding a run encoded with the same fields
+ *
+ * @return false if the field list is invalid
+ */
+bool series_codec_decoder_init(series_codec_decoder_t *dec, const series_codec_field_t *fields,
+                               uint8_t field_count, const uint8_t *data, size_t length);
+
+/**
+ * @brief Decode the next record
+ *
+ * The caller knows how many records the run holds (trailing bits of the
+ * last byte would otherwise decode as records).
+ *
+ * @param values Output: one value per field
+ * @return false if the data ran out
+ */
+bool series_codec_decode(series_codec_decoder_t *dec, int32_t *values);
+
+/**
+ * @brief Bytes consumed so far (the last one may be partly used)
+ */
+size_t series_codec_decoded_bytes(const series_codec_decoder_t *dec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SERIES_CODEC_H
@@ -0,0 +1,132 @@
+/**
+ * @file stream_stats.c
+ * @brief Incremental windowed statistics (min/max/mean/stddev/RMS)
+ */
+
+#include "stream_stats.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+static inline void acc_add(stream_stats_acc_t *acc, int32_t value, uint32_t timestamp)
+{
+    if (acc->count == 0) {
+        acc->min = value;
+        acc->max = value;
+        acc->first_timestamp = timestamp;
+    } else {
+        if (value < acc->min) {
+            acc->min = value;
+        }
+        if (value > acc->max) {
+            acc->max = value;
+        }
+    }
+    acc->last_timestamp = timestamp;
+    acc->count++;
+
+    // Welford: the mean moves by delta / n, m2 by delta x (new deviation)
+    double x = (double)value;
+    double delta = x - acc->mean;
+    acc->mean += delta / (double)acc->count;
+    acc->m2 += delta * (x - acc->mean);
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+stream_stats_status_t stream_stats_init(stream_stats_t *stats, const uint32_t *lengths, uint32_t window_count)
+{
+    if (stats == NULL || lengths == NULL || window_count == 0 || window_count > STREAM_STATS_MAX_WINDOWS) {
+        return STREAM_STATS_ERR_INVALID_ARG;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    for (uint32_t i = 0; i < window_count; i++) {
+        stats->windows[i].length = lengths[i];
+    }
+    stats->window_count = window_count;
+    stats->initialized = true;
+
+    return STREAM_STATS_OK;
+}
+
+void stream_stats_add(stream_stats_t *stats, int32_t value, uint32_t timestamp)
+{
+    if (stats == NULL || !stats->initialized) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < stats->window_count; i++) {
+        stream_stats_window_t *window = &stats->windows[i];
+
+        acc_add(&window->current, value, timestamp);
+
+        if (window->length != 0 && window->current.count >= window->length) {
+            window->last = window->current;
+            memset(&window->current, 0, sizeof(window->current));
+            window->completed++;
+        }
+    }
+}
+
+uint32_t stream_stats_get_window_count(const stream_stats_t *stats)
+{
+    return (stats != NULL && stats->initialized) ? stats->window_count : 0;
+}
+
+stream_stats_status_t stream_stats_get_summary(const stream_stats_t *stats, uint32_t window,
+                                               stream_stats_summary_t *summary)
+{
+    if (stats == NULL || summary == NULL) {
+        return STREAM_STATS_ERR_INVALID_ARG;
+    }
+    if (!stats->initialized) {
+        return STREAM_STATS_ERR_NOT_INIT;
+    }
+    if (window >= stats->window_count) {
+        return STREAM_STATS_ERR_INVALID_ARG;
+    }
+
+    const stream_stats_window_t *w = &stats->windows[window];
+    bool complete = (w->length != 0 && w->completed > 0);
+    const stream_stats_acc_t *acc = complete ? &w->last : &w->current;
+
+    if (acc->count == 0) {
+        return STREAM_STATS_ERR_EMPTY;
+    }
+
+    double variance = acc->m2 / (double)acc->count;
+
+    summary->length = w->length;
+    summary->count = acc->count;
+    summary->complete = complete;
+    summary->first_timestamp = acc->first_timestamp;
+    summary->last_timestamp = acc->last_timestamp;
+    summary->min = acc->min;
+    summary->max = acc->max;
+    summary->mean = (float)acc->mean;
+    summary->stddev = (float)sqrt(variance);
+    summary->rms = (float)sqrt(variance + acc->mean * acc->mean);
+
+    return STREAM_STATS_OK;
+}
+
+void stream_stats_reset(stream_stats_t *stats)
+{
+    if (stats == NULL || !stats->initialized) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < stats->window_count; i++) {
+        stream_stats_window_t *window = &stats->windows[i];
+        memset(&window->current, 0, sizeof(window->current));
+        memset(&window->last, 0, sizeof(window->last));
+        window->completed = 0;
+    }
+}
@@ -0,0 +1,163 @@
+/**
+ * @file stream_stats.h
+ * @brief Incremental windowed statistics (min/max/mean/stddev/RMS)
+ *
+ * Keeps running aggregates of a sample stream over up to
+ * STREAM_STATS_MAX_WINDOWS windows at once. Each window either tumbles
+ * every `length` samples, publishing the finished window as its summary,
+ * or (length 0) accumulates everything since the last reset. Mean and
+ * variance use Welford's update, so they stay accurate over long windows
+ * and no samples are kept: adding one costs a few floating point
+ * operations per window.
+ *
+ * There is no locking inside, so it can be fed from an interrupt; the
+ * owner serializes stream_stats_add() against the readers.
+ *
+ * Usage example:
+ * @code
+ * // One-minute and one-hour windows of 10 s samples, plus since boot
+ * static const uint32_t lengths[] = { 6, 360, 0 };
+ * stream_stats_t stats;
+ * stream_stats_init(&stats, lengths, 3);
+ *
+ * // With every sample
+ * stream_stats_add(&stats, sample.value, sample.timestamp);
+ *
+ * // Last complete hour
+ * stream_stats_summary_t hour;
+ * stream_stats_get_summary(&stats, 1, &hour);
+ * @endcode
+ */
+
+#ifndef STREAM_STATS_H
+#define STREAM_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define STREAM_STATS_MAX_WINDOWS    4
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Status codes
+ */
+typedef enum {
+    STREAM_STATS_OK = 0,
+    STREAM_STATS_ERR_INVALID_ARG,
+    STREAM_STATS_ERR_NOT_INIT,
+    STREAM_STATS_ERR_EMPTY,
+} stream_stats_status_t;
+
+/**
+ * @brief Running aggregate (private)
+ */
+typedef struct {
+    uint32_t count;
+    int32_t min;
+    int32_t max;
+    double mean;
+    double m2;                      /**< Sum of squared deviations from the mean */
+    uint32_t first_timestamp;
+    uint32_t last_timestamp;
+} stream_stats_acc_t;
+
+/**
+ * @brief One window (private)
+ */
+typedef struct {
+    uint32_t length;                /**< Samples per window, 0 = since reset */
+    stream_stats_acc_t current;     /**< Window being filled */
+    stream_stats_acc_t last;        /**< Last complete window */
+    uint32_t completed;             /**< Windows completed since reset */
+} stream_stats_window_t;
+
+/**
+ * @brief Statistics engine instance
+ *
+ * All fields are private - use API functions to access.
+ */
+typedef struct {
+    stream_stats_window_t windows[STREAM_STATS_MAX_WINDOWS];
+    uint32_t window_count;
+    bool initialized;
+} stream_stats_t;
+
+/**
+ * @brief Summary of one window
+ */
+typedef struct {
+    uint32_t length;                /**< Window length in samples, 0 = since reset */
+    uint32_t count;                 /**< Samples covered */
+    bool complete;                  /**< false: window still filling (no complete one yet) */
+    uint32_t first_timestamp;       /**< Timestamp of the first sample covered */
+    uint32_t last_timestamp;        /**< Timestamp of the last sample covered */
+    int32_t min;
+    int32_t max;
+    float mean;
+    float stddev;                   /**< Population standard deviation */
+    float rms;                      /**< Root mean square */
+} stream_stats_summary_t;
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Initialize an engine
+ *
+ * @param stats Pointer to engine instance (caller allocates the struct)
+ * @param lengths Window lengths in samples (0 = since reset)
+ * @param window_count Number of windows (1..STREAM_STATS_MAX_WINDOWS)
+ * @return STREAM_STATS_OK on success
+ */
+stream_stats_status_t stream_stats_init(stream_stats_t *stats, const uint32_t *lengths, uint32_t window_count);
+
+/**
+ * @brief Feed one sample to every window
+ *
+ * @param stats Pointer to engine instance
+ * @param value Sample value (in the stream's own scaled units)
+ * @param timestamp Sample timestamp
+ */
+void stream_stats_add(stream_stats_t *stats, int32_t value, uint32_t timestamp);
+
+/**
+ * @brief Number of windows
+ */
+uint32_t stream_stats_get_window_count(const stream_stats_t *stats);
+
+/**
+ * @brief Summarize a window
+ *
+ * Tumbling windows report their last complete window, or the one being
+ * filled until the first completes.
+ *
+ * @param stats Pointer to engine instance
+ * @param window Window number (order of init)
+ * @param summary Output
+ * @return STREAM_STATS_OK, or STREAM_STATS_ERR_EMPTY if no sample was added
+ */
+stream_stats_status_t stream_stats_get_summary(const stream_stats_t *stats, uint32_t window,
+                                               stream_stats_summary_t *summary);
+
+/**
+ * @brief Drop all aggregates (window lengths are kept)
+ */
+void stream_stats_reset(stream_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STREAM_STATS_H
@@ -0,0 +1,154 @@
+/**
+ * @file swinging_door.c
+ * @brief Swinging-door compression of slow sample streams
+ */
+
+#include "swinging_door.h"
+#include <stddef.h>
+#include <string.h>
+
+// ============================================================================
+// Internal Functions
+// ============================================================================
+
+// Slopes from the pivot to point, less and plus the deviation
+static inline void door_slopes(const swinging_door_t *door, uint8_t ch,
+                               const swinging_door_point_t *point, float *low, float *high)
+{
+    float dt = (float)(point->timestamp - door->pivot.timestamp);
+    float dv = (float)point->values[ch] - (float)door->pivot.values[ch];
+    float deviation = (float)door->channel[ch].deviation;
+
+    *low = (dv - deviation) / dt;
+    *high = (dv + deviation) / dt;
+}
+
+// First input after the pivot: the door is what it allows
+static void door_open(swinging_door_t *door, const swinging_door_point_t *point)
+{
+    for (uint8_t ch = 0; ch < door->channels; ch++) {
+        door_slopes(door, ch, point, &door->channel[ch].slope_low, &door->channel[ch].slope_high);
+    }
+    door->pending = *point;
+    door->has_pending = true;
+    door->skipped = 0;
+}
+
+// Narrow every door to point; false (nothing changed) if one would close
+static bool door_narrow(swinging_door_t *door, const swinging_door_point_t *point)
+{
+    float low[SWINGING_DOOR_MAX_CHANNELS];
+    float high[SWINGING_DOOR_MAX_CHANNELS];
+
+    for (uint8_t ch = 0; ch < door->channels; ch++) {
+        door_slopes(door, ch, point, &low[ch], &high[ch]);
+        if (low[ch] < door->channel[ch].slope_low) {
+            low[ch] = door->channel[ch].slope_low;
+        }
+        if (high[ch] > door->channel[ch].slope_high) {
+            high[ch] = door->channel[ch].slope_high;
+        }
+        if (low[ch] > high[ch]) {
+            return false;
+        }
+    }
+
+    for (uint8_t ch = 0; ch < door->channels; ch++) {
+        door->channel[ch].slope_low = low[ch];
+        door->channel[ch].slope_high = high[ch];
+    }
+    return true;
+}
+
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+swinging_door_status_t swinging_door_init(swinging_door_t *door, const int32_t *deviations,
+                                          uint8_t channels, uint32_t max_skip)
+{
+    if (door == NULL || deviations == NULL || channels == 0 || channels > SWINGING_DOOR_MAX_CHANNELS) {
+        return SWINGING_DOOR_ERR_INVALID_ARG;
+    }
+
+    memset(door, 0, sizeof(*door));
+    for (uint8_t ch = 0; ch < channels; ch++) {
+        if (deviations[ch] < 0) {
+            return SWINGING_DOOR_ERR_INVALID_ARG;
+        }
+        door->channel[ch].deviation = deviations[ch];
+    }
+    door->channels = channels;
+    door->max_skip = max_skip;
+
+    return SWINGING_DOOR_OK;
+}
+
+uint32_t swinging_door_add(swinging_door_t *door, uint32_t timestamp, const int32_t *values,
+                           swinging_door_point_t out[SWINGING_DOOR_MAX_OUT])
+{
+    if (door == NULL || values == NULL || out == NULL || door->channels == 0) {
+        return 0;
+    }
+
+    swinging_door_point_t point = { .timestamp = timestamp };
+    memcpy(point.values, values, door->channels * sizeof(int32_t));
+
+    uint32_t n = 0;
+    uint32_t newest = door->has_pending ? door->pending.timestamp : door->pivot.timestamp;
+
+    if (!door->has_pivot || (int32_t)(timestamp - newest) <= 0) {
+        // Nothing to interpolate from: keep what is pending, and this as the pivot
+        if (door->has_pending) {
+            out[n++] = door->pending;
+        }
+        out[n++] = point;
+        door->pivot = point;
+        door->has_pivot = true;
+        door->has_pending = false;
+        door->skipped = 0;
+        return n;
+    }
+
+    if (!door->has_pending) {
+        door_open(door, &point);
+        return 0;
+    }
+
+    bool may_skip = (door->max_skip == 0 || door->skipped < door->max_skip);
+    if (may_skip && door_narrow(door, &point)) {
+        // The pending input is on the line from the pivot to this one
+        door->pending = point;
+        door->skipped++;
+        return 0;
+    }
+
+    // Door closed: the pending input is kept and pivots the next one
+    out[n++] = door->pending;
+    door->pivot = door->pending;
+    door_open(door, &point);
+    return n;
+}
+
+bool swinging_door_flush(swinging_door_t *door, swinging_door_point_t *out)
+{
+    if (door == NULL || out == NULL || !door->has_pending) {
+        return false;
+    }
+
+    *out = door->pending;
+    door->pivot = door->pending;
+    door->has_pending = false;
+    door->skipped = 0;
+    return true;
+}
+
+void swinging_door_reset(swinging_door_t *door)
+{
+    if (door == NULL) {
+        return;
+    }
+    door->has_pivot = false;
+    door->has_pending = false;
+    door->skipped = 0;
+}
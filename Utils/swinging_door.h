@@ -0,0 +1,155 @@
+/**
+ * @file swinging_door.h
+ * @brief Swinging-door compression of slow sample streams
+ *
+ * Keeps a point only where the signal leaves a straight line: from the last
+ * kept point (the pivot) every input narrows a "door" of slopes that pass
+ * within the channel's deviation of all inputs since. When an input falls
+ * outside it the previous input is kept and becomes the next pivot.
+ * Linear interpolation between consecutive kept points then reproduces
+ * every dropped input to within the deviation.
+ *
+ * Up to SWINGING_DOOR_MAX_CHANNELS channels sharing timestamps are
+ * compressed together: a point is kept for all of them when any one door
+ * closes, so rings fed from the kept points stay index-aligned.
+ *
+ * A kept point is only known one input later, so the newest input is held
+ * back (pending) until the next one decides; swinging_door_flush() keeps
+ * it. max_skip bounds the inputs dropped in a row, and with it how stale
+ * the newest kept point can be. Timestamps going backwards (a clock
+ * switch) start a new pivot.
+ *
+ * There is no locking inside; the owner serializes every call.
+ *
+ * Usage example:
+ * @code
+ * // Temperature within 0.1 C, humidity within 0.5 %RH, every 60th at least
+ * static const int32_t deviations[] = { 10, 50 };
+ * swinging_door_t door;
+ * swinging_door_init(&door, deviations, 2, 60);
+ *
+ * // With every input: store what comes out
+ * swinging_door_point_t kept[SWINGING_DOOR_MAX_OUT];
+ * int32_t values[2] = { temp, humidity };
+ * uint32_t n = swinging_door_add(&door, timestamp, values, kept);
+ * for (uint32_t i = 0; i < n; i++) {
+ *     store(kept[i].timestamp, kept[i].values[0], kept[i].values[1]);
+ * }
+ * @endcode
+ */
+
+#ifndef SWINGING_DOOR_H
+#define SWINGING_DOOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#define SWINGING_DOOR_MAX_CHANNELS  2
+
+/** Points one swinging_door_add() can keep (pending input plus a new pivot) */
+#define SWINGING_DOOR_MAX_OUT       2
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Status codes
+ */
+typedef enum {
+    SWINGING_DOOR_OK = 0,
+    SWINGING_DOOR_ERR_INVALID_ARG,
+} swinging_door_status_t;
+
+/**
+ * @brief One point, all channels
+ */
+typedef struct {
+    uint32_t timestamp;
+    int32_t values[SWINGING_DOOR_MAX_CHANNELS];
+} swinging_door_point_t;
+
+/**
+ * @brief Per-channel door (private)
+ */
+typedef struct {
+    int32_t deviation;              /**< Error bound, in sample units */
+    float slope_low;                /**< Door, in value per timestamp unit */
+    float slope_high;
+} swinging_door_channel_t;
+
+/**
+ * @brief Compressor state
+ *
+ * All fields are private - use API functions to access.
+ */
+typedef struct {
+    swinging_door_channel_t channel[SWINGING_DOOR_MAX_CHANNELS];
+    uint8_t channels;
+    bool has_pivot;                 /**< pivot is set (something was kept) */
+    bool has_pending;               /**< pending holds an input not yet decided */
+    uint32_t max_skip;              /**< Inputs dropped in a row before one is kept anyway, 0 = no limit */
+    uint32_t skipped;               /**< Inputs dropped since the pivot */
+    swinging_door_point_t pivot;    /**< Last point kept */
+    swinging_door_point_t pending;  /**< Newest input */
+} swinging_door_t;
+
+// ============================================================================
+// API
+// ============================================================================
+
+/**
+ * @brief Initialize a compressor
+ *
+ * @param door Compressor
+ * @param deviations Error bound per channel, in sample units (0 keeps every input unless exactly on the line)
+ * @param channels Number of channels (1..SWINGING_DOOR_MAX_CHANNELS)
+ * @param max_skip Most inputs dropped in a row, 0 = no limit
+ * @return SWINGING_DOOR_OK on success
+ */
+swinging_door_status_t swinging_door_init(swinging_door_t *door, const int32_t *deviations,
+                                          uint8_t channels, uint32_t max_skip);
+
+/**
+ * @brief Feed one input
+ *
+ * @param door Compressor
+ * @param timestamp Input timestamp (non-decreasing, any unit)
+ * @param values One value per channel
+ * @param out Output: points to keep, oldest first
+ * @return Number of points in out (0..SWINGING_DOOR_MAX_OUT)
+ */
+uint32_t swinging_door_add(swinging_door_t *door, uint32_t timestamp, const int32_t *values,
+                           swinging_door_point_t out[SWINGING_DOOR_MAX_OUT]);
+
+/**
+ * @brief Keep the pending input now
+ *
+ * It becomes the pivot, as if the door had closed on it.
+ *
+ * @param door Compressor
+ * @param out Output: the pending input
+ * @return true if there was one
+ */
+bool swinging_door_flush(swinging_door_t *door, swinging_door_point_t *out);
+
+/**
+ * @brief Forget pivot and pending input; the next input is kept
+ *
+ * @param door Compressor
+ */
+void swinging_door_reset(swinging_door_t *door);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SWINGING_DOOR_H
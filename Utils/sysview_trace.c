@@ -0,0 +1,45 @@
+/**
+ * @file sysview_trace.c
+ * @brief SystemView user events and markers for project subsystems
+ */
+
+#include "sysview_trace.h"
+
+#if SYSVIEW_TRACE_ACTIVE
+
+static void send_module_description(void);
+
+// Event names and parameters as SystemView displays them, in enum order
+SEGGER_SYSVIEW_MODULE sysview_trace_module = {
+    .sModule = "M=App, "
+               "0 BusPublish type=%u, "
+               "1 BusDispatch type=%u subscribers=%u, "
+               "2 UartRx len=%u, "
+               "3 UartTx len=%u, "
+               "4 SensorAlert, "
+               "5 SensorSample sensor=%u, "
+               "6 Notify id=%u len=%u",
+    .NumEvents = SYSVIEW_EVT_COUNT,
+    .pfSendModuleDesc = send_module_description,
+};
+
+static void send_module_description(void)
+{
+    // Called at every recording start, so the names reach each session
+    SEGGER_SYSVIEW_NameMarker(SYSVIEW_MARKER_BUS_DISPATCH, "Dispatch");
+    SEGGER_SYSVIEW_NameMarker(SYSVIEW_MARKER_SENSOR_READ, "SensorRead");
+    SEGGER_SYSVIEW_NameMarker(SYSVIEW_MARKER_DISPLAY_REDRAW, "Redraw");
+}
+
+void sysview_trace_init(void)
+{
+    SEGGER_SYSVIEW_RegisterModule(&sysview_trace_module);
+}
+
+#else
+
+void sysview_trace_init(void)
+{
+}
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * @file sysview_trace.h
+ * @brief SystemView user events and markers for project subsystems
+ *
+ * Registers one SystemView module ("App") whose events show up next to the
+ * kernel events: event bus publish/dispatch, framed UART packets, INA226
+ * alerts and samples, NOTIFY frames to the host. Longer activities (event
+ * dispatch, sensor reads, display redraws) are SystemView markers, drawn
+ * as spans. Together they put e.g. INA226 ALERT -> sample -> NOTIFY TX on
+ * one timeline.
+ *
+ * Built with SYSVIEW_TRACE_ENABLE=1 (and USE_SEGGER_SYSTEMVIEW); otherwise
+ * every macro expands to nothing and its arguments are not evaluated.
+ *
+ * Usage example:
+ * @code
+ * SYSVIEW_TRACE_U32(SYSVIEW_EVT_UART_RX_PACKET, length);
+ *
+ * SYSVIEW_MARK_START(SYSVIEW_MARKER_DISPLAY_REDRAW);
+ * redraw();
+ * SYSVIEW_MARK_STOP(SYSVIEW_MARKER_DISPLAY_REDRAW);
+ * @endcode
+ */
+
+#ifndef SYSVIEW_TRACE_H
+#define SYSVIEW_TRACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+#ifndef SYSVIEW_TRACE_ENABLE
+#define SYSVIEW_TRACE_ENABLE    0
+#endif
+
+#if SYSVIEW_TRACE_ENABLE && defined(USE_SEGGER_SYSTEMVIEW) && USE_SEGGER_SYSTEMVIEW
+#define SYSVIEW_TRACE_ACTIVE    1
+#else
+#define SYSVIEW_TRACE_ACTIVE    0
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * @brief Module events; the order matches the module description
+ */
+typedef enum {
+    SYSVIEW_EVT_BUS_PUBLISH = 0,        /**< event type */
+    SYSVIEW_EVT_BUS_DISPATCH,           /**< event type, subscriber count */
+    SYSVIEW_EVT_UART_RX_PACKET,         /**< payload length */
+    SYSVIEW_EVT_UART_TX_PACKET,         /**< payload length */
+    SYSVIEW_EVT_SENSOR_ALERT,           /**< INA226 ALERT edge */
+    SYSVIEW_EVT_SENSOR_SAMPLE,          /**< sysview_trace_sensor_t */
+    SYSVIEW_EVT_PROTO_NOTIFY,           /**< notification id, payload length */
+    SYSVIEW_EVT_COUNT
+} sysview_trace_event_t;
+
+/**
+ * @brief Sensor parameter of SYSVIEW_EVT_SENSOR_SAMPLE
+ */
+typedef enum {
+    SYSVIEW_SENSOR_INA226 = 0,
+    SYSVIEW_SENSOR_AHT25,
+} sysview_trace_sensor_t;
+
+/**
+ * @brief Marker ids (spans)
+ */
+typedef enum {
+    SYSVIEW_MARKER_BUS_DISPATCH = 0,    /**< One event through its subscribers */
+    SYSVIEW_MARKER_SENSOR_READ,         /**< Synchronous sensor register read */
+    SYSVIEW_MARKER_DISPLAY_REDRAW,      /**< Display update */
+    SYSVIEW_MARKER_COUNT
+} sysview_trace_marker_t;
+
+// ============================================================================
+// Trace Macros
+// ============================================================================
+
+#if SYSVIEW_TRACE_ACTIVE
+#include "SEGGER_SYSVIEW.h"
+
+extern SEGGER_SYSVIEW_MODULE sysview_trace_module;
+
+#define SYSVIEW_TRACE(evt) \
+    SEGGER_SYSVIEW_RecordVoid(sysview_trace_module.EventOffset + (evt))
+#define SYSVIEW_TRACE_U32(evt, a) \
+    SEGGER_SYSVIEW_RecordU32(sysview_trace_module.EventOffset + (evt), (U32)(a))
+#define SYSVIEW_TRACE_U32x2(evt, a, b) \
+    SEGGER_SYSVIEW_RecordU32x2(sysview_trace_module.EventOffset + (evt), (U32)(a), (U32)(b))
+#define SYSVIEW_MARK_START(marker)  SEGGER_SYSVIEW_MarkStart(marker)
+#define SYSVIEW_MARK_STOP(marker)   SEGGER_SYSVIEW_MarkStop(marker)
+#else
+#define SYSVIEW_TRACE(evt)              do {} while (0)
+#define SYSVIEW_TRACE_U32(evt, a)       do {} while (0)
+#define SYSVIEW_TRACE_U32x2(evt, a, b)  do {} while (0)
+#define SYSVIEW_MARK_START(marker)      do {} while (0)
+#define SYSVIEW_MARK_STOP(marker)       do {} while (0)
+#endif
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+/**
+ * @brief Register the module with SystemView
+ *
+ * Call after SEGGER_SYSVIEW_Conf() and before recording starts. No-op when
+ * tracing is compiled out.
+ */
+void sysview_trace_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYSVIEW_TRACE_H
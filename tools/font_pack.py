@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Pack the ST7735 fonts of fonts.c into 1bpp or RLE glyph tables.
+
+fonts.c keeps each glyph as one uint16_t per row, MSB = left column, which
+wastes 16 - width bits per row and stores blank rows in full. This script
+rewrites every font in both compressed formats of fonts.h and keeps the
+smaller one:
+
+    FONT_FORMAT_PACKED1  width * height bits per glyph, row-major, MSB first
+    FONT_FORMAT_RLE      runs of (value << 7 | length) bytes over the same
+                         bit stream, one offset per glyph
+
+plus digit-only atlases (FontDef.chars) of the larger fonts for screens that
+only show readings. Regenerate after editing fonts.c:
+
+    tools/font_pack.py Drivers_BSP/External/ST7735/fonts.c \\
+        > Drivers_BSP/External/ST7735/fonts_packed.c
+
+Standard library only.
+"""
+
+import argparse
+import re
+import sys
+
+FIRST_CHAR = 32
+LAST_CHAR = 126
+
+# Array name in fonts.c -> public FontDef name, width, height
+FONTS = [
+    ("Font7x10", "Font_7x10", 7, 10),
+    ("Font11x18", "Font_11x18", 11, 18),
+    ("Font16x26", "Font_16x26", 16, 26),
+]
+
+# Characters of the reading atlases (values, signs, units)
+DIGITS = " +-.0123456789:%ACVWm"
+ATLASES = [
+    ("Font11x18", "Font_11x18_Digits"),
+    ("Font16x26", "Font_16x26_Digits"),
+]
+
+ARRAY = re.compile(r"static const uint16_t (\w+)\s*\[\]\s*=\s*\{(.*?)\};", re.S)
+WORD = re.compile(r"0x[0-9a-fA-F]{4}")
+LINE_COMMENT = re.compile(r"//[^\n]*")
+
+# Decoders read up to two bytes past a glyph's last bit
+PACKED1_PAD = 2
+RLE_MAX_RUN = 127
+
+
+def parse_fonts(path):
+    """Array name -> list of glyphs, each a list of row words."""
+    with open(path, encoding="utf-8") as f:
+        source = f.read()
+    arrays = {}
+    for name, body in ARRAY.findall(source):
+        arrays[name] = [int(w, 16) for w in WORD.findall(LINE_COMMENT.sub("", body))]
+
+    fonts = {}
+    for array, _, width, height in FONTS:
+        words = arrays.get(array)
+        count = LAST_CHAR - FIRST_CHAR + 1
+        if words is None or len(words) != count * height:
+            sys.exit("font_pack: %s missing or not %d glyphs of %d rows" % (array, count, height))
+        mask = (0xFFFF << (16 - width)) & 0xFFFF
+        fonts[array] = [[w & mask for w in words[g * height:(g + 1) * height]] for g in range(count)]
+    return fonts
+
+
+def glyph_bits(rows, width):
+    bits = []
+    for row in rows:
+        for col in range(width):
+            bits.append((row >> (15 - col)) & 1)
+    return bits
+
+
+def pack1(bits):
+    out = bytearray((len(bits) + 7) // 8)
+    for i, bit in enumerate(bits):
+        if bit:
+            out[i // 8] |= 0x80 >> (i % 8)
+    return bytes(out)
+
+
+def rle(bits):
+    out = bytearray()
+    i = 0
+    while i < len(bits):
+        value = bits[i]
+        run = 1
+        while i + run < len(bits) and bits[i + run] == value and run < RLE_MAX_RUN:
+            run += 1
+        out.append(value << 7 | run)
+        i += run
+    return bytes(out)
+
+
+def encode(glyphs, width):
+    """(format, data bytes, offsets or None) of the smaller encoding."""
+    # One bit stream: glyphs are not byte aligned
+    stream = [bit for g in glyphs for bit in glyph_bits(g, width)]
+    packed = pack1(stream) + bytes(PACKED1_PAD)
+
+    offsets = []
+    runs = bytearray()
+    for g in glyphs:
+        offsets.append(len(runs))
+        runs += rle(glyph_bits(g, width))
+    if len(offsets) * 2 + len(runs) < len(packed):
+        return "FONT_FORMAT_RLE", bytes(runs), offsets
+    return "FONT_FORMAT_PACKED1", packed, None
+
+
+def c_bytes(data, per_line=16):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(", ".join("0x%02X" % b for b in data[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def c_words(data, per_line=12):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(", ".join("%d" % w for w in data[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def emit_font(out, symbol, public, width, height, glyphs, chars, raw_bytes):
+    fmt, data, offsets = encode(glyphs, width)
+    tag = "RLE" if offsets is not None else "1bpp"
+    size = len(data) + (2 * len(offsets) if offsets is not None else 0)
+    out.append("// %s: %d glyphs, %s, %d bytes (%d as uint16_t rows)"
+               % (public, len(glyphs), tag, size, raw_bytes))
+    out.append("static const uint8_t %s_bits[] = {" % symbol)
+    out.append(c_bytes(data))
+    out.append("};")
+    if offsets is not None:
+        out.append("static const uint16_t %s_offsets[] = {" % symbol)
+        out.append(c_words(offsets))
+        out.append("};")
+    out.append("")
+    chars_c = "NULL" if chars is None else '"%s"' % chars.replace("\\", "\\\\").replace('"', '\\"')
+    offsets_c = "%s_offsets" % symbol if offsets is not None else "NULL"
+    return "const FontDef %s = {%d,%d,NULL,%s,%s,%s_bits,%s};" % (
+        public, width, height, fmt, chars_c, symbol, offsets_c)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n", 1)[0])
+    parser.add_argument("fonts_c", help="fonts.c with the uint16_t row tables")
+    args = parser.parse_args()
+
+    fonts = parse_fonts(args.fonts_c)
+    dims = {array: (public, width, height) for array, public, width, height in FONTS}
+
+    out = [
+        "/* vim: set ai et ts=4 sw=4: */",
+        "// Generated by tools/font_pack.py from fonts.c; do not edit.",
+        '#include "fonts.h"',
+        "#include <stddef.h>",
+        "",
+    ]
+    defs = []
+
+    out.append("#if FONTS_PACKED")
+    out.append("")
+    for array, public, width, height in FONTS:
+        glyphs = fonts[array]
+        defs_line = emit_font(out, "packed_" + array, public, width, height, glyphs, None,
+                              2 * height * len(glyphs))
+        defs.append(defs_line)
+    out.extend(defs)
+    out.append("")
+    out.append("#endif // FONTS_PACKED")
+    out.append("")
+
+    for array, public in ATLASES:
+        _, width, height = dims[array]
+        glyphs = [fonts[array][ord(c) - FIRST_CHAR] for c in DIGITS]
+        out.append(emit_font(out, "digits_" + array, public, width, height, glyphs, DIGITS,
+                             2 * height * len(glyphs)))
+        out.append("")
+
+    sys.stdout.write("\n".join(out).rstrip("\n") + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Decode deferred binary log records (Drivers_BSP/Custom/log_deferred.h).
+
+Capture RTT channel 2 to a file, e.g.
+
+    JLinkRTTLogger -Device STM32F767ZI -If SWD -Speed 4000 -RTTChannel 2 log.bin
+
+then decode it against the ELF of the same build:
+
+    tools/log_decode.py build/Debug/stm32_blinking_led.elf log.bin
+
+Format strings come from the non-loaded .log_fmt section; tags and %s
+arguments are read from the ELF's loaded sections (flash). Standard
+library only.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+MAGIC = 0xD1
+HEADER_WORDS = 4
+LEVELS = {1: "E", 2: "W", 3: "I", 4: "D", 5: "V"}
+
+# printf conversion: flags, width, precision, length, conversion
+SPEC = re.compile(r"%([-+ #0]*)(\d*|\*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diuxXcspo%])")
+
+
+class Elf:
+    """Section contents of an ELF file, addressable by address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF":
+            raise ValueError(f"{path}: not an ELF file")
+        is64 = data[4] == 2
+        endian = "<" if data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x3A)
+            entry = endian + "IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from(endian + "I", data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", data, 0x2E)
+            entry = endian + "IIIIIIIIII"
+
+        headers = [struct.unpack_from(entry, data, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx]
+        self.sections = {}
+        self.loaded = []
+        for name_off, sh_type, flags, addr, offset, size, *_ in headers:
+            end = data.index(b"\0", names[4] + name_off)
+            name = data[names[4] + name_off:end].decode()
+            content = data[offset:offset + size] if sh_type != 8 else b""  # 8 = NOBITS
+            self.sections[name] = (addr, content)
+            if flags & 0x2 and content:  # SHF_ALLOC
+                self.loaded.append((addr, content))
+
+    def string_at(self, addr, section=None):
+        """NUL-terminated string at an address, or None."""
+        regions = [self.sections[section]] if section else self.loaded
+        for base, content in regions:
+            if base <= addr < base + len(content):
+                start = addr - base
+                end = content.find(b"\0", start)
+                return content[start:end if end >= 0 else None].decode(errors="replace")
+        return None
+
+
+def format_message(elf, fmt, args):
+    """Apply a printf format to 32-bit raw arguments."""
+    args = list(args)
+
+    def convert(match):
+        flags, width, precision, _length, conv = match.groups()
+        if conv == "%":
+            return "%"
+        if width == "*":
+            width = str(args.pop(0) if args else 0)
+        if not args:
+            return "<missing>"
+        value = args.pop(0)
+        spec = "%" + flags + width + ("." + precision if precision else "")
+        if conv in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            return (spec + "d") % value
+        if conv in "uxXo":
+            return (spec + conv) % value
+        if conv == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if conv == "p":
+            return "0x%08x" % value
+        text = elf.string_at(value)
+        return (spec + "s") % (text if text is not None else "<str@0x%08x>" % value)
+
+    return SPEC.sub(convert, fmt)
+
+
+def decode(elf, stream, out):
+    expected = None
+    pos = 0
+    while pos + HEADER_WORDS * 4 <= len(stream):
+        word0, tick, fmt_id, tag_addr = struct.unpack_from("<IIII", stream, pos)
+        if word0 & 0xFF != MAGIC:
+            pos += 1  # Resynchronize on a corrupt capture
+            continue
+        level = (word0 >> 8) & 0x0F
+        count = (word0 >> 12) & 0x0F
+        seq = word0 >> 16
+        end = pos + (HEADER_WORDS + count) * 4
+        if end > len(stream):
+            break
+        args = struct.unpack_from("<%dI" % count, stream, pos + HEADER_WORDS * 4)
+        pos = end
+
+        if expected is not None and seq != expected:
+            out.write("--- %d record(s) dropped ---\n" % ((seq - expected) & 0xFFFF))
+        expected = (seq + 1) & 0xFFFF
+
+        fmt = elf.string_at(fmt_id, ".log_fmt")
+        tag = elf.string_at(tag_addr) or "?"
+        message = format_message(elf, fmt, args) if fmt is not None else \
+            "<unknown format 0x%08x> %s" % (fmt_id, " ".join("0x%08x" % a for a in args))
+        out.write("%s (%d) %s: %s\n" % (LEVELS.get(level, "?"), tick, tag, message.rstrip("\n")))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="firmware ELF of the build that produced the log")
+    parser.add_argument("log", help="binary capture of the RTT channel ('-' for stdin)")
+    options = parser.parse_args()
+
+    elf = Elf(options.elf)
+    if ".log_fmt" not in elf.sections:
+        sys.exit("%s has no .log_fmt section (built without LOG_DEFERRED?)" % options.elf)
+    if options.log == "-":
+        stream = sys.stdin.buffer.read()
+    else:
+        with open(options.log, "rb") as f:
+            stream = f.read()
+    decode(elf, stream, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
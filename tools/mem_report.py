@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+"""Report RAM/flash use per memory region, section and module from a GNU ld map.
+
+The firmware link writes stm32_development.map next to the ELF; the
+mem_report target runs this on it:
+
+    cmake --build build/Debug --target mem_report
+
+or by hand:
+
+    tools/mem_report.py build/Debug/stm32_development.map --by file --top 30
+
+Every input section is charged to the region holding its address, and
+initialized sections (.data, .itcm_text, .dtcm_data) are charged to FLASH a
+second time for their load copy. Modules are source files, grouped by their
+top-level directory (Application, Middleware, HAL, ...) or their library.
+
+With --budget the script exits 1 if a region or module group is past its
+budget; the build runs it that way when tools/mem_budget.json exists.
+--write-budget records the current use, plus --slack percent, as a new
+budget. Standard library only.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+HEX = r"0x[0-9a-fA-F]+"
+
+# Region line of the "Memory Configuration" table
+REGION = re.compile(r"^(\S+)\s+(" + HEX + r")\s+(" + HEX + r")(?:\s+\S+)?\s*$")
+# Output section: name, then address and size on the same or the next line
+OUTPUT = re.compile(r"^(\.\S+|COMMON)(?:\s+(" + HEX + r")\s+(" + HEX + r")(?:\s+load address\s+(" + HEX + r"))?)?\s*$")
+# Input section: one leading space, name, then address, size and object
+INPUT = re.compile(r"^ (\.\S+|COMMON|\*fill\*)(?:\s+(" + HEX + r")\s+(" + HEX + r")(?:\s+(.+))?)?\s*$")
+# Continuation of a long output or input section name
+CONTINUATION = re.compile(r"^\s+(" + HEX + r")\s+(" + HEX + r")(?:\s+(.+?))?\s*$")
+LOAD_ADDRESS = re.compile(r"load address\s+(" + HEX + r")")
+
+# Output sections that take no target memory
+NOT_LOADED = re.compile(r"^\.(debug|comment|ARM\.attributes|stab|gnu\.attributes|log_fmt|note)")
+
+FLASH = "FLASH"
+FILL = "(fill)"
+
+
+class Region:
+    def __init__(self, name, origin, length):
+        self.name = name
+        self.origin = origin
+        self.length = length
+        self.used = 0
+
+    def holds(self, address):
+        return self.origin <= address < self.origin + self.length
+
+
+class Section:
+    def __init__(self, name, address, size, load):
+        self.name = name
+        self.address = address
+        self.size = size
+        self.load = load        # Load address when it differs from the address
+        self.region = None
+        self.load_region = None
+
+
+class MapFile:
+    """Memory regions, output sections and per-object use of one link."""
+
+    def __init__(self, path):
+        self.regions = []
+        self.sections = []
+        # module -> region -> bytes
+        self.modules = {}
+        with open(path, "r", errors="replace") as f:
+            self._parse(f.read().splitlines())
+
+    def region_of(self, address):
+        for region in self.regions:
+            if region.holds(address):
+                return region
+        return None
+
+    def _charge(self, module, region, size):
+        if region is None or size == 0:
+            return
+        usage = self.modules.setdefault(module, {})
+        usage[region.name] = usage.get(region.name, 0) + size
+
+    def _parse(self, lines):
+        index = 0
+        while index < len(lines) and not lines[index].startswith("Memory Configuration"):
+            index += 1
+        index += 1
+        while index < len(lines) and not lines[index].startswith("Linker script and memory map"):
+            match = REGION.match(lines[index])
+            if match and match.group(1) not in ("Name", "*default*"):
+                self.regions.append(Region(match.group(1), int(match.group(2), 16), int(match.group(3), 16)))
+            index += 1
+        if not self.regions:
+            raise ValueError("no Memory Configuration table (not a GNU ld map?)")
+
+        section = None
+        pending = None          # Input section name waiting for its address line
+        while index < len(lines):
+            line = lines[index]
+            index += 1
+
+            match = OUTPUT.match(line)
+            if match:
+                name, address, size, load = match.groups()
+                if address is None and index < len(lines):
+                    follow = CONTINUATION.match(lines[index])
+                    if follow:
+                        address, size = follow.group(1), follow.group(2)
+                        load_match = LOAD_ADDRESS.search(lines[index])
+                        load = load_match.group(1) if load_match else None
+                        index += 1
+                section = None
+                pending = None
+                if address is not None and not NOT_LOADED.match(name):
+                    section = self._add_section(name, int(address, 16), int(size, 16),
+                                                int(load, 16) if load else None)
+                continue
+
+            if section is None:
+                continue
+
+            match = INPUT.match(line)
+            if match:
+                name, address, size, obj = match.groups()
+                if address is None:
+                    pending = name
+                    continue
+                pending = None
+                self._add_input(section, name, int(address, 16), int(size, 16), obj)
+                continue
+
+            match = CONTINUATION.match(line)
+            if pending is not None and match:
+                address, size, obj = match.groups()
+                self._add_input(section, pending, int(address, 16), int(size, 16), obj)
+            pending = None
+
+    def _add_section(self, name, address, size, load):
+        section = Section(name, address, size, load)
+        section.region = self.region_of(address)
+        if load is not None and load != address:
+            section.load_region = self.region_of(load)
+        if size > 0:
+            self.sections.append(section)
+            if section.region is not None:
+                section.region.used += size
+            if section.load_region is not None:
+                section.load_region.used += size
+        return section
+
+    def _add_input(self, section, name, address, size, obj):
+        if size == 0:
+            return
+        module = FILL if name == "*fill*" or not obj else module_name(obj)
+        self._charge(module, self.region_of(address), size)
+        if section.load_region is not None:
+            self._charge(module, section.load_region, size)
+
+
+def module_name(obj):
+    """Source path of a CMake object, or library(member) of an archive member."""
+    obj = obj.strip()
+    archive = re.match(r"^(.*?)([^/\\]+\.a)\((.+)\)$", obj)
+    if archive:
+        return "%s(%s)" % (archive.group(2), archive.group(3))
+    match = re.search(r"CMakeFiles[/\\][^/\\]+\.dir[/\\](.+?)\.obj$", obj)
+    if match:
+        return match.group(1).replace("\\", "/")
+    return os.path.basename(obj)
+
+
+def group_name(module):
+    """Top-level directory of a source path, or the library of an archive member."""
+    if module == FILL:
+        return module
+    if "(" in module:
+        return module.split("(", 1)[0]
+    return module.split("/", 1)[0] if "/" in module else module
+
+
+def grouped(modules, by):
+    if by == "file":
+        return modules
+    groups = {}
+    for module, usage in modules.items():
+        total = groups.setdefault(group_name(module), {})
+        for region, size in usage.items():
+            total[region] = total.get(region, 0) + size
+    return groups
+
+
+def ram_of(usage):
+    return sum(size for region, size in usage.items() if region != FLASH)
+
+
+def print_report(link, by, top, out):
+    used = [region for region in link.regions if region.used > 0]
+
+    out.write("Memory regions\n")
+    out.write("  %-12s %10s %10s %7s\n" % ("Region", "Used", "Size", "Use"))
+    for region in link.regions:
+        percent = 100.0 * region.used / region.length if region.length else 0.0
+        out.write("  %-12s %10d %10d %6.1f%%\n" % (region.name, region.used, region.length, percent))
+
+    out.write("\nSections\n")
+    out.write("  %-20s %-10s %-10s %10s %10s\n" % ("Section", "Region", "Load", "Address", "Size"))
+    for section in link.sections:
+        out.write("  %-20s %-10s %-10s 0x%08x %10d\n" % (
+            section.name,
+            section.region.name if section.region else "-",
+            section.load_region.name if section.load_region else "",
+            section.address, section.size))
+
+    groups = grouped(link.modules, by)
+    names = sorted(groups, key=lambda name: (ram_of(groups[name]), groups[name].get(FLASH, 0)), reverse=True)
+    if top > 0:
+        names = names[:top]
+
+    out.write("\n%s, by RAM\n" % ("Files" if by == "file" else "Modules"))
+    out.write("  %-48s" % "Module" + "".join(" %10s" % region.name for region in used) + "\n")
+    for name in names:
+        usage = groups[name]
+        out.write("  %-48s" % name + "".join(" %10d" % usage.get(region.name, 0) for region in used) + "\n")
+
+
+def usage_by(link, by):
+    groups = grouped(link.modules, by)
+    return {
+        "regions": {region.name: region.used for region in link.regions if region.used > 0},
+        "modules": {name: dict(usage) for name, usage in groups.items() if name != FILL},
+    }
+
+
+def check_budget(link, budget, out):
+    """Print every use past its budget; return the number of them."""
+    by = budget.get("by", "module")
+    current = usage_by(link, by)
+    over = 0
+
+    for region, limit in budget.get("regions", {}).items():
+        size = current["regions"].get(region, 0)
+        if size > limit:
+            out.write("over budget: %s %d > %d (+%d)\n" % (region, size, limit, size - limit))
+            over += 1
+
+    for module, limits in budget.get("modules", {}).items():
+        usage = current["modules"].get(module, {})
+        for region, limit in limits.items():
+            size = usage.get(region, 0)
+            if size > limit:
+                out.write("over budget: %s %s %d > %d (+%d)\n" % (module, region, size, limit, size - limit))
+                over += 1
+
+    # A module without a budget is new: it has to be budgeted explicitly
+    for module in sorted(set(current["modules"]) - set(budget.get("modules", {}))):
+        if ram_of(current["modules"][module]) > budget.get("unbudgeted_ram", 0):
+            out.write("over budget: %s has no budget (%d bytes RAM)\n" % (module, ram_of(current["modules"][module])))
+            over += 1
+    return over
+
+
+def write_budget(link, by, slack, path):
+    current = usage_by(link, by)
+
+    def allow(size):
+        return size + size * slack // 100
+
+    budget = {
+        "by": by,
+        "slack_percent": slack,
+        "unbudgeted_ram": 0,
+        "regions": {region: allow(size) for region, size in sorted(current["regions"].items())},
+        "modules": {
+            module: {region: allow(size) for region, size in sorted(usage.items())}
+            for module, usage in sorted(current["modules"].items())
+        },
+    }
+    with open(path, "w") as f:
+        json.dump(budget, f, indent=2)
+        f.write("\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("map", help="linker map of the firmware (-Wl,-Map)")
+    parser.add_argument("--by", choices=("module", "file"), default="module",
+                        help="group per top-level directory / library, or list files")
+    parser.add_argument("--top", type=int, default=20, help="rows of the module table (0 = all)")
+    parser.add_argument("--budget", help="budget JSON to check against; exit 1 if past it")
+    parser.add_argument("--write-budget", metavar="FILE", help="record the current use as a budget")
+    parser.add_argument("--slack", type=int, default=2, help="headroom of --write-budget, percent")
+    parser.add_argument("--quiet", action="store_true", help="print budget overruns only")
+    options = parser.parse_args()
+
+    try:
+        link = MapFile(options.map)
+    except (OSError, ValueError) as error:
+        sys.exit("%s: %s" % (options.map, error))
+
+    if not options.quiet:
+        print_report(link, options.by, options.top, sys.stdout)
+
+    if options.write_budget:
+        write_budget(link, options.by, options.slack, options.write_budget)
+        print("budget written to %s" % options.write_budget)
+
+    if options.budget:
+        with open(options.budget) as f:
+            budget = json.load(f)
+        over = check_budget(link, budget, sys.stderr)
+        if over:
+            sys.exit("%s: %d item(s) over budget (%s)" % (options.map, over, options.budget))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""Symbolize PC samples (Utils/pc_sampler.h) into a CPU profile.
+
+Build with PC_SAMPLER_ENABLE=1, capture RTT channel 3 to a file, e.g.
+
+    JLinkRTTLogger -Device STM32F767ZI -If SWD -Speed 4000 -RTTChannel 3 pc.bin
+
+then symbolize it against the ELF of the same build:
+
+    tools/pc_profile.py build/Debug/stm32_blinking_led.elf pc.bin
+    tools/pc_profile.py build/Debug/stm32_blinking_led.elf pc.bin --by task
+    tools/pc_profile.py build/Debug/stm32_blinking_led.elf pc.bin --folded | flamegraph.pl > cpu.svg
+
+The default report lists functions by share of samples; --by task groups
+them per task (tasks made with OS_TASK_DEFINE are named after their
+storage symbol, others show their TCB address) and interrupts (exception
+number). --folded prints "context;caller;function count" lines for
+flame graph tools; the caller comes from the stacked LR, so it is exact
+for leaf functions and a hint otherwise. Standard library only.
+"""
+
+import argparse
+import bisect
+import collections
+import struct
+import sys
+
+MAGIC = 0xA5
+RECORD = struct.Struct("<IIII")
+
+STT_OBJECT = 1
+STT_FUNC = 2
+SHT_SYMTAB = 2
+
+FIRST_IRQ = 16      # Exception numbers below are system exceptions
+SYSTEM_EXCEPTIONS = {2: "NMI", 3: "HardFault", 4: "MemManage", 5: "BusFault",
+                     6: "UsageFault", 11: "SVCall", 12: "DebugMon", 14: "PendSV",
+                     15: "SysTick"}
+
+
+class Symbols:
+    """Function and object symbols of an ELF, looked up by address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1:
+            raise ValueError(f"{path}: not a 32-bit ELF file")
+        endian = "<" if data[5] == 1 else ">"
+        shoff, = struct.unpack_from(endian + "I", data, 0x20)
+        shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x2E)
+        headers = [struct.unpack_from(endian + "IIIIIIIIII", data, shoff + i * shentsize)
+                   for i in range(shnum)]
+
+        functions, objects = [], []
+        for _, sh_type, _, _, offset, size, link, _, _, entsize in headers:
+            if sh_type != SHT_SYMTAB:
+                continue
+            strtab = headers[link][4]
+            for pos in range(offset, offset + size, entsize):
+                name_off, value, sym_size, info, _, _ = struct.unpack_from(endian + "IIIBBH", data, pos)
+                kind = info & 0xF
+                if kind not in (STT_FUNC, STT_OBJECT) or value == 0:
+                    continue
+                end = data.index(b"\0", strtab + name_off)
+                name = data[strtab + name_off:end].decode(errors="replace")
+                if kind == STT_FUNC:
+                    functions.append((value & ~1, max(sym_size, 2), name))   # Thumb bit
+                else:
+                    objects.append((value, max(sym_size, 1), name))
+        self.functions = self._index(functions)
+        self.objects = self._index(objects)
+
+    @staticmethod
+    def _index(symbols):
+        symbols.sort()
+        return [s[0] for s in symbols], symbols
+
+    @staticmethod
+    def _find(table, addr):
+        starts, symbols = table
+        i = bisect.bisect_right(starts, addr) - 1
+        if i >= 0:
+            start, size, name = symbols[i]
+            if addr < start + size:
+                return name
+        return None
+
+    def function(self, addr):
+        return self._find(self.functions, addr & ~1) or "0x%08x" % addr
+
+    def task(self, tcb):
+        if tcb == 0:
+            return "(no task)"
+        name = self._find(self.objects, tcb)
+        if name is not None and name.endswith("_task_storage"):
+            return name[:-len("_task_storage")]
+        return name or "task@0x%08x" % tcb
+
+
+def parse(stream):
+    """Samples as (exception, pc, lr, tcb), plus samples lost to gaps."""
+    samples = []
+    lost = 0
+    expected = None
+    pos = 0
+    while pos + RECORD.size <= len(stream):
+        word0, pc, lr, tcb = RECORD.unpack_from(stream, pos)
+        if word0 & 0xFF != MAGIC:
+            pos += 1  # Resynchronize on a corrupt capture
+            continue
+        pos += RECORD.size
+        seq = word0 >> 16
+        if expected is not None and seq != expected:
+            lost += (seq - expected) & 0xFFFF
+        expected = (seq + 1) & 0xFFFF
+        samples.append(((word0 >> 8) & 0xFF, pc, lr, tcb))
+    return samples, lost
+
+
+def context_name(symbols, exception, tcb):
+    if exception == 0:
+        return symbols.task(tcb)
+    if exception < FIRST_IRQ:
+        return "[%s]" % SYSTEM_EXCEPTIONS.get(exception, "exception %d" % exception)
+    return "[IRQ %d]" % (exception - FIRST_IRQ)
+
+
+def caller_name(symbols, pc_name, lr):
+    if lr >= 0xFFFFFF00:
+        return None     # EXC_RETURN: interrupted before the first call
+    name = symbols.function(lr)
+    return None if name == pc_name else name
+
+
+def report_flat(rows, total, top, out):
+    out.write("%8s %6s  %s\n" % ("samples", "%", "function"))
+    for name, count in rows.most_common(top):
+        out.write("%8d %5.1f%%  %s\n" % (count, 100.0 * count / total, name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="firmware ELF of the build that produced the samples")
+    parser.add_argument("samples", help="binary capture of the RTT channel ('-' for stdin)")
+    parser.add_argument("--by", choices=["function", "task"], default="function",
+                        help="group the report by function (default) or by task first")
+    parser.add_argument("--folded", action="store_true",
+                        help="print folded stacks for flame graph tools instead")
+    parser.add_argument("--top", type=int, default=30, help="functions to list (default 30)")
+    options = parser.parse_args()
+
+    symbols = Symbols(options.elf)
+    if options.samples == "-":
+        stream = sys.stdin.buffer.read()
+    else:
+        with open(options.samples, "rb") as f:
+            stream = f.read()
+    samples, lost = parse(stream)
+    if not samples:
+        sys.exit("no samples in %s (built without PC_SAMPLER_ENABLE?)" % options.samples)
+
+    out = sys.stdout
+    if options.folded:
+        stacks = collections.Counter()
+        for exception, pc, lr, tcb in samples:
+            function = symbols.function(pc)
+            frames = [context_name(symbols, exception, tcb)]
+            caller = caller_name(symbols, function, lr)
+            if caller is not None:
+                frames.append(caller)
+            frames.append(function)
+            stacks[";".join(frames)] += 1
+        for stack, count in sorted(stacks.items()):
+            out.write("%s %d\n" % (stack, count))
+        return
+
+    total = len(samples)
+    out.write("%d samples, %d lost to a full channel\n\n" % (total, lost))
+    if options.by == "function":
+        report_flat(collections.Counter(symbols.function(pc) for _, pc, _, _ in samples),
+                    total, options.top, out)
+        return
+
+    contexts = collections.defaultdict(collections.Counter)
+    for exception, pc, _, tcb in samples:
+        contexts[context_name(symbols, exception, tcb)][symbols.function(pc)] += 1
+    for context, rows in sorted(contexts.items(), key=lambda item: -sum(item[1].values())):
+        count = sum(rows.values())
+        out.write("%s: %d samples, %.1f%%\n" % (context, count, 100.0 * count / total))
+        report_flat(rows, total, options.top, out)
+        out.write("\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Compare Tests/perf_suite cycle counts between firmware builds.
+
+Build each preset with the suite and capture its RTT log, e.g.
+
+    cmake --preset Debug -DFIRMWARE_PERF_SUITE=ON && cmake --build --preset Debug
+    cmake --preset SizeHot -DFIRMWARE_PERF_SUITE=ON && cmake --build --preset SizeHot
+    (flash each, save the RTT terminal output to debug.log / sizehot.log)
+
+then
+
+    tools/perf_compare.py Debug=debug.log SizeHot=sizehot.log
+
+prints cycles/op per case and build, as a Markdown table, with each build's
+speedup over the first one. A map per build (--map SizeHot=build/SizeHot/
+stm32_development.map) adds its flash and RAM use (tools/mem_report.py).
+Standard library only.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Log line of perf_suite.c report(), behind whatever prefix the log layer adds
+CASE = re.compile(r"PERF: (\w+): (?:cycles/op=(\d+) ops/s=\d+|n/a)")
+
+
+def parse_log(path):
+    """Case name -> cycles/op (None for n/a), in suite order."""
+    cases = {}
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            match = CASE.search(line)
+            if match:
+                cases[match.group(1)] = int(match.group(2)) if match.group(2) else None
+    return cases
+
+
+def labeled(argument):
+    label, sep, path = argument.partition("=")
+    if not sep:
+        label, path = os.path.splitext(os.path.basename(argument))[0], argument
+    return label, path
+
+
+def map_usage(path):
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    import mem_report
+    link = mem_report.MapFile(path)
+    flash = sum(r.used for r in link.regions if r.name == mem_report.FLASH)
+    ram = sum(r.used for r in link.regions if r.name != mem_report.FLASH)
+    return flash, ram
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("logs", nargs="+", metavar="LABEL=LOG",
+                        help="RTT log per build; the first is the baseline")
+    parser.add_argument("--map", action="append", default=[], metavar="LABEL=MAP",
+                        help="linker map of a build, for its memory use")
+    options = parser.parse_args()
+
+    builds = [labeled(argument) for argument in options.logs]
+    results = [(label, parse_log(path)) for label, path in builds]
+    for label, cases in results:
+        if not cases:
+            sys.exit("%s: no perf_suite output (built with FIRMWARE_PERF_SUITE?)" % label)
+
+    names = []
+    for _, cases in results:
+        names.extend(name for name in cases if name not in names)
+
+    baseline = results[0][1]
+    header = ["case"] + [label for label, _ in results]
+    header += ["%s speedup" % label for label, _ in results[1:]]
+    print("| " + " | ".join(header) + " |")
+    print("|" + "---|" * len(header))
+    for name in names:
+        row = [name]
+        for _, cases in results:
+            value = cases.get(name)
+            row.append("n/a" if value is None else str(value))
+        for _, cases in results[1:]:
+            base, value = baseline.get(name), cases.get(name)
+            row.append("%.2fx" % (base / value) if base and value else "-")
+        print("| " + " | ".join(row) + " |")
+
+    if options.map:
+        print()
+        print("| build | flash | RAM |")
+        print("|---|---|---|")
+        for argument in options.map:
+            label, path = labeled(argument)
+            try:
+                flash, ram = map_usage(path)
+            except (OSError, ValueError) as error:
+                sys.exit("%s: %s" % (path, error))
+            print("| %s | %d | %d |" % (label, flash, ram))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,373 @@
+#!/usr/bin/env python3
+"""Generate the protocol headers from Middleware/Features/protocol_common.idl.
+
+The IDL is protocol_common.h with every payload struct written as a
+block of typed fields; everything outside the blocks (constants, enums,
+prose) is copied through unchanged:
+
+    /** Single sensor sample (used for buffered data and streaming) */
+    struct sensor_sample {
+        u8  sensor_type           /**< Sensor type (sensor_type_t) */
+        u32 timestamp             /**< Unix timestamp or ms since boot */
+        i32 value
+        // Comment lines are copied into the struct
+    }
+
+Field types are u8, u16, u32, i8, i16, i32, f32 (little-endian IEEE 754
+on the wire), a struct declared earlier, or an array of one of those
+(u8 payload[PROTOCOL_MAX_PAYLOAD_SIZE], sizes from a number or a #define
+in the IDL). Two headers come out, next to the IDL:
+
+- protocol_common.h: the packed wire structs as before (name_t), the
+  file to copy to the ESP32 side;
+- protocol_wire.h: per struct an aligned copy (name_unpacked_t),
+  NAME_WIRE_SIZE, and static inline name_pack()/name_unpack() that
+  convert in one pass with shifts a compiler merges into word accesses.
+  Structs with array fields (the packets themselves) get none: their
+  payload is used in place.
+
+    tools/protocol_gen.py Middleware/Features/protocol_common.idl
+    tools/protocol_gen.py Middleware/Features/protocol_common.idl --check
+
+--check writes nothing and fails if either header differs from what the
+IDL gives (the firmware build runs it). Standard library only.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SCALARS = {
+    # IDL type: (C type, bytes)
+    "u8": ("uint8_t", 1),
+    "u16": ("uint16_t", 2),
+    "u32": ("uint32_t", 4),
+    "i8": ("int8_t", 1),
+    "i16": ("int16_t", 2),
+    "i32": ("int32_t", 4),
+    "f32": ("float", 4),
+}
+
+STRUCT_START = re.compile(r"^struct (\w+) \{$")
+FIELD = re.compile(r"^\s+(\w+)\s+(\w+)(?:\[(\w+)\])?\s*(/\*\*<.*\*/)?\s*$")
+COMMENT = re.compile(r"^\s+(//.*)$")
+DEFINE = re.compile(r"^#define\s+(\w+)\s+(\d+)\b")
+
+GENERATED = "// Generated from {idl} by tools/protocol_gen.py: edit the IDL, not this file\n"
+
+
+class Field:
+    def __init__(self, kind, name, count, doc):
+        self.kind = kind
+        self.name = name
+        self.count = count
+        self.doc = doc
+
+
+class Struct:
+    def __init__(self, name, line):
+        self.name = name
+        self.line = line
+        self.items = []             # Field or comment text, in order
+        self.size = 0
+
+    @property
+    def fields(self):
+        return [item for item in self.items if isinstance(item, Field)]
+
+    @property
+    def has_array(self):
+        return any(field.count is not None for field in self.fields)
+
+
+def parse(path):
+    """Verbatim text pieces and Struct objects, in file order."""
+    pieces, structs, defines = [], {}, {}
+    current = None
+    with open(path, "r") as f:
+        for number, line in enumerate(f, 1):
+            where = f"{path}:{number}"
+            if current is None:
+                match = STRUCT_START.match(line.rstrip("\n"))
+                if match is None:
+                    define = DEFINE.match(line)
+                    if define:
+                        defines[define.group(1)] = int(define.group(2))
+                    pieces.append(line)
+                    continue
+                if match.group(1) in structs:
+                    raise SyntaxError(f"{where}: struct {match.group(1)} declared twice")
+                current = Struct(match.group(1), where)
+                continue
+
+            text = line.rstrip("\n")
+            if text == "}":
+                if not current.fields:
+                    raise SyntaxError(f"{current.line}: struct {current.name} has no fields")
+                structs[current.name] = current
+                pieces.append(current)
+                current = None
+                continue
+            comment = COMMENT.match(text)
+            if comment:
+                current.items.append(comment.group(1))
+                continue
+            field = FIELD.match(text)
+            if field is None:
+                raise SyntaxError(f"{where}: not a field: {text.strip()}")
+            kind, name, count, doc = field.groups()
+            if kind not in SCALARS and kind not in structs:
+                raise SyntaxError(f"{where}: unknown type {kind}")
+            if count is not None:
+                if count.isdigit():
+                    count = int(count)
+                elif count in defines:
+                    count = (count, defines[count])
+                else:
+                    raise SyntaxError(f"{where}: array size {count} is not a number or #define")
+            current.items.append(Field(kind, name, count, doc))
+
+    if current is not None:
+        raise SyntaxError(f"{current.line}: struct {current.name} not closed")
+
+    for struct in structs.values():
+        for field in struct.fields:
+            size = SCALARS[field.kind][1] if field.kind in SCALARS else structs[field.kind].size
+            struct.size += size * length(field.count)
+    return pieces, structs
+
+
+def length(count):
+    if count is None:
+        return 1
+    return count[1] if isinstance(count, tuple) else count
+
+
+def ctype(kind):
+    return SCALARS[kind][0] if kind in SCALARS else f"{kind}_t"
+
+
+def declaration(field):
+    count = "" if field.count is None else f"[{field.count[0] if isinstance(field.count, tuple) else field.count}]"
+    return f"{field.name}{count};"
+
+
+def emit_struct(struct):
+    lines = ["typedef struct {\n"]
+    for item in struct.items:
+        if isinstance(item, str):
+            lines.append(f"    {item}\n")
+            continue
+        decl = f"    {ctype(item.kind):<8} {declaration(item)}"
+        if item.doc:
+            decl = f"{decl:<29}"
+            decl = f"{decl} {item.doc}"
+        lines.append(decl.rstrip() + "\n")
+    lines.append(f"}} __attribute__((packed)) {struct.name}_t;\n")
+    return "".join(lines)
+
+
+def common_header(idl, pieces):
+    out = [GENERATED.format(idl=os.path.basename(idl))]
+    for piece in pieces:
+        out.append(emit_struct(piece) if isinstance(piece, Struct) else piece)
+    return "".join(out)
+
+
+WIRE_PROLOGUE = """\
+/**
+ * @file protocol_wire.h
+ * @brief Aligned payload structs and their wire conversion
+ *
+ * The packed structs of protocol_common.h match the wire byte for byte,
+ * so a payload is sent as it is built, but members at odd offsets (the
+ * int32 of sensor_sample_t) become byte-wise or unaligned accesses. Code
+ * that works on the fields converts instead: name_unpack() fills the
+ * aligned name_unpacked_t from the payload bytes in one pass and
+ * name_pack() writes it back, little-endian. NAME_WIRE_SIZE is the size
+ * on the wire, checked against the packed struct below.
+ *
+ * Same on both sides, like protocol_common.h.
+ */
+
+#ifndef PROTOCOL_WIRE_H
+#define PROTOCOL_WIRE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "protocol_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#define PROTOCOL_WIRE_ASSERT(cond, msg) static_assert(cond, msg)
+#else
+#define PROTOCOL_WIRE_ASSERT(cond, msg) _Static_assert(cond, msg)
+#endif
+
+// ============================================================================
+// Little-endian field access
+// ============================================================================
+
+static inline void wire_put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void wire_put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline void wire_put_f32(uint8_t *p, float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    wire_put_u32(p, bits);
+}
+
+static inline uint16_t wire_get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t wire_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline float wire_get_f32(const uint8_t *p)
+{
+    uint32_t bits = wire_get_u32(p);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+"""
+
+WIRE_EPILOGUE = """
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROTOCOL_WIRE_H
+"""
+
+PUT = {
+    "u8": "wire[{o}] = v->{n};",
+    "i8": "wire[{o}] = (uint8_t)v->{n};",
+    "u16": "wire_put_u16(wire + {o}, v->{n});",
+    "i16": "wire_put_u16(wire + {o}, (uint16_t)v->{n});",
+    "u32": "wire_put_u32(wire + {o}, v->{n});",
+    "i32": "wire_put_u32(wire + {o}, (uint32_t)v->{n});",
+    "f32": "wire_put_f32(wire + {o}, v->{n});",
+}
+
+GET = {
+    "u8": "v->{n} = wire[{o}];",
+    "i8": "v->{n} = (int8_t)wire[{o}];",
+    "u16": "v->{n} = wire_get_u16(wire + {o});",
+    "i16": "v->{n} = (int16_t)wire_get_u16(wire + {o});",
+    "u32": "v->{n} = wire_get_u32(wire + {o});",
+    "i32": "v->{n} = (int32_t)wire_get_u32(wire + {o});",
+    "f32": "v->{n} = wire_get_f32(wire + {o});",
+}
+
+
+def emit_wire(struct, structs):
+    name = struct.name
+    size_macro = f"{name.upper()}_WIRE_SIZE"
+    lines = [
+        "\n// ============================================================================\n",
+        f"// {name}_t\n",
+        "// ============================================================================\n\n",
+        f"#define {size_macro} {struct.size}\n",
+        f"PROTOCOL_WIRE_ASSERT(sizeof({name}_t) == {size_macro}, \"{name}_t does not match the IDL\");\n\n",
+        "typedef struct {\n",
+    ]
+    for field in struct.fields:
+        kind = ctype(field.kind) if field.kind in SCALARS else f"{field.kind}_unpacked_t"
+        lines.append(f"    {kind} {field.name};\n")
+    lines.append(f"}} {name}_unpacked_t;\n\n")
+
+    puts, gets, offset = [], [], 0
+    for field in struct.fields:
+        if field.kind in SCALARS:
+            puts.append(PUT[field.kind].format(o=offset, n=field.name))
+            gets.append(GET[field.kind].format(o=offset, n=field.name))
+            offset += SCALARS[field.kind][1]
+        else:
+            puts.append(f"{field.kind}_pack(wire + {offset}, &v->{field.name});")
+            gets.append(f"{field.kind}_unpack(&v->{field.name}, wire + {offset});")
+            offset += structs[field.kind].size
+
+    lines.append(f"/** Write v as its {struct.size} wire bytes; returns {size_macro} */\n")
+    lines.append(f"static inline size_t {name}_pack(uint8_t *wire, const {name}_unpacked_t *v)\n{{\n")
+    lines += [f"    {line}\n" for line in puts]
+    lines.append(f"    return {size_macro};\n}}\n\n")
+
+    lines.append(f"/** Read {size_macro} wire bytes into v; returns {size_macro} */\n")
+    lines.append(f"static inline size_t {name}_unpack({name}_unpacked_t *v, const uint8_t *wire)\n{{\n")
+    lines += [f"    {line}\n" for line in gets]
+    lines.append(f"    return {size_macro};\n}}\n")
+    return "".join(lines)
+
+
+def wire_header(idl, structs):
+    out = [GENERATED.format(idl=os.path.basename(idl)), WIRE_PROLOGUE]
+    for struct in structs.values():
+        if not struct.has_array:
+            out.append(emit_wire(struct, structs))
+    out.append(WIRE_EPILOGUE)
+    return "".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("idl", help="protocol_common.idl")
+    parser.add_argument("--check", action="store_true", help="fail if the headers are out of date")
+    args = parser.parse_args()
+
+    try:
+        pieces, structs = parse(args.idl)
+    except SyntaxError as e:
+        print(f"protocol_gen: {e}", file=sys.stderr)
+        return 1
+
+    directory = os.path.dirname(args.idl)
+    outputs = {
+        os.path.join(directory, "protocol_common.h"): common_header(args.idl, pieces),
+        os.path.join(directory, "protocol_wire.h"): wire_header(args.idl, structs),
+    }
+
+    stale = []
+    for path, text in outputs.items():
+        try:
+            with open(path, "r") as f:
+                current = f.read()
+        except FileNotFoundError:
+            current = None
+        if current == text:
+            continue
+        if args.check:
+            stale.append(path)
+        else:
+            with open(path, "w") as f:
+                f.write(text)
+            print(f"wrote {path}")
+
+    if stale:
+        for path in stale:
+            print(f"protocol_gen: {path} is out of date, run tools/protocol_gen.py {args.idl}",
+                  file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""Decode a current recording (Middleware/Services/serv_recorder.h) to CSV.
+
+The input is the recording as CMD_GET_RECORDING sends it: the recorder's
+4 KB blocks back to back, plain (RREC, recorder_record_t arrays) or packed
+(RREZ, series_codec runs, see Utils/series_codec.h). Either the raw bytes
+
+    tools/recording_decode.py recording.bin -o recording.csv
+
+or an rtt_capture.py packet file holding the NOTIFY_RECORDING_DATA frames
+
+    tools/recording_decode.py --packets capture.bin -o recording.csv
+
+Every block is CRC-checked and decoded on its own; bad blocks are counted
+and skipped. The CSV has time_us (Unix time), current_mA, voltage_V and
+state per sample; the summary goes to stderr. Standard library only.
+"""
+
+import argparse
+import struct
+import sys
+
+BLOCK_SIZE = 4096
+MAGIC_PLAIN = 0x43455252      # "RREC"
+MAGIC_PACKED = 0x5A455252     # "RREZ"
+
+HEADER = struct.Struct("<IIIIIHHHHfH")
+HEADER_CRC_OFFSET = HEADER.size - 2
+RECORD = struct.Struct("<HhHB")
+BUS_VOLTAGE_LSB_V = 0.00125
+
+NOTIFY_RECORDING_DATA = 0x84
+PACKET_HEADER = struct.Struct("<BBBBH")
+RECORDING_DATA_HEADER = struct.Struct("<IIH")
+
+# Packed block fields: (kind, bits), kind 0 delta of delta, 1 delta, 2 repeat
+PACKED_FIELDS = ((0, 16), (1, 16), (1, 16), (2, 8))
+BUCKET_BITS = (4, 8, 12)
+ESCAPE_EXTRA = 2
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class BitReader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def bits(self, n):
+        if self.pos + n > len(self.data) * 8:
+            raise ValueError("packed block ends early")
+        value = 0
+        for _ in range(n):
+            byte = self.data[self.pos >> 3]
+            value = (value << 1) | ((byte >> (7 - (self.pos & 7))) & 1)
+            self.pos += 1
+        return value
+
+    def delta(self, field_bits):
+        ones = 0
+        while ones < 4 and self.bits(1):
+            ones += 1
+        if ones == 0:
+            return 0
+        n = BUCKET_BITS[ones - 1] if ones <= len(BUCKET_BITS) else field_bits + ESCAPE_EXTRA
+        raw = self.bits(n)
+        return raw - (1 << n) if raw & (1 << (n - 1)) else raw
+
+    def used(self):
+        return (self.pos + 7) // 8
+
+
+def unpack_packed(body, count):
+    """Records of a packed block, and the body bytes they take."""
+    reader = BitReader(body)
+    prev = [0] * len(PACKED_FIELDS)
+    prev_delta = [0] * len(PACKED_FIELDS)
+    records = []
+    for _ in range(count):
+        for f, (kind, bits) in enumerate(PACKED_FIELDS):
+            if kind == 0:
+                prev_delta[f] += reader.delta(bits)
+                prev[f] += prev_delta[f]
+            elif kind == 1:
+                prev[f] += reader.delta(bits)
+            elif reader.bits(1):
+                prev[f] = reader.bits(bits)
+        records.append(tuple(prev))
+    return records, reader.used()
+
+
+def unpack_plain(body, count):
+    used = count * RECORD.size
+    if used > len(body):
+        raise ValueError("record count past the block")
+    return [RECORD.unpack_from(body, i * RECORD.size) for i in range(count)], used
+
+
+def decode_block(block):
+    """(header fields, records) of a valid block, or None."""
+    if len(block) < HEADER.size:
+        return None
+    (magic, recording_id, sequence, first_index, start_sec, start_ms, start_us,
+     count, time_unit_us, current_lsb_mA, crc) = HEADER.unpack_from(block)
+    body = block[HEADER.size:]
+    try:
+        if magic == MAGIC_PACKED:
+            records, used = unpack_packed(body, count)
+        elif magic == MAGIC_PLAIN:
+            records, used = unpack_plain(body, count)
+        else:
+            return None
+    except ValueError:
+        return None
+    if crc16_ccitt(body[:used], crc16_ccitt(block[:HEADER_CRC_OFFSET])) != crc:
+        return None
+    start_us_total = start_sec * 1000000 + start_ms * 1000 + start_us
+    return (recording_id, sequence, first_index, start_us_total, time_unit_us,
+            current_lsb_mA, magic == MAGIC_PACKED), records
+
+
+def reassemble(path):
+    """Recording bytes from NOTIFY_RECORDING_DATA packets (u16 length + packet)."""
+    data = bytearray()
+    with open(path, "rb") as f:
+        raw = f.read()
+    pos = 0
+    while pos + 2 <= len(raw):
+        (length,) = struct.unpack_from("<H", raw, pos)
+        packet = raw[pos + 2:pos + 2 + length]
+        pos += 2 + length
+        if len(packet) < PACKET_HEADER.size + RECORDING_DATA_HEADER.size:
+            continue
+        _, cmd_id, _, _, _ = PACKET_HEADER.unpack_from(packet)
+        if cmd_id != NOTIFY_RECORDING_DATA:
+            continue
+        offset, _, count = RECORDING_DATA_HEADER.unpack_from(packet, PACKET_HEADER.size)
+        chunk = packet[PACKET_HEADER.size + RECORDING_DATA_HEADER.size:][:count]
+        if len(data) < offset + len(chunk):
+            data.extend(b"\xff" * (offset + len(chunk) - len(data)))
+        data[offset:offset + len(chunk)] = chunk
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="recording bytes, or an rtt_capture.py file with --packets")
+    parser.add_argument("--packets", action="store_true", help="input holds NOTIFY_RECORDING_DATA packets")
+    parser.add_argument("-o", "--output", help="CSV file (default stdout)")
+    args = parser.parse_args()
+
+    if args.packets:
+        data = reassemble(args.input)
+    else:
+        with open(args.input, "rb") as f:
+            data = f.read()
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    out.write("time_us,current_mA,voltage_V,state\n")
+
+    samples = 0
+    packed = 0
+    bad = 0
+    blocks = (len(data) + BLOCK_SIZE - 1) // BLOCK_SIZE
+    for b in range(blocks):
+        decoded = decode_block(data[b * BLOCK_SIZE:(b + 1) * BLOCK_SIZE])
+        if decoded is None:
+            bad += 1
+            continue
+        (_, _, _, t_us, unit_us, lsb_mA, is_packed), records = decoded
+        packed += is_packed
+        for i, (dt, current_raw, bus_raw, state) in enumerate(records):
+            if i > 0:
+                t_us += dt * unit_us
+            out.write(f"{t_us},{current_raw * lsb_mA:.4f},{bus_raw * BUS_VOLTAGE_LSB_V:.5f},{state}\n")
+        samples += len(records)
+
+    if out is not sys.stdout:
+        out.close()
+    per_sample = f", {len(data) / samples:.2f} bytes per sample" if samples else ""
+    print(f"{blocks} blocks ({packed} packed, {bad} bad), {samples} samples{per_sample}",
+          file=sys.stderr)
+    return 0 if bad == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
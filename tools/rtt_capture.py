@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+"""Capture protocol packets from the RTT transport (protocol_transport_rtt.c).
+
+Build with PROTOCOL_TRANSPORT_RTT=1. The packets come on RTT up-channel 4
+as COBS frames (packet + CRC16-CCITT, big-endian, 0x00 delimited), the
+same frames the USB link carries. Two ways to get at them:
+
+- live, both directions, through an RTT TCP server, e.g. OpenOCD's
+
+      openocd -f interface/stlink.cfg -f target/stm32f7x.cfg \\
+          -c init -c "rtt setup 0x20000000 0x80000 \\"SEGGER RTT\\"" \\
+          -c "rtt start" -c "rtt server start 19024 4"
+      tools/rtt_capture.py --tcp localhost:19024 --hello --start 10 -o capture.bin
+
+- recorded with the J-Link logger (up-channel only), decoded afterwards:
+
+      JLinkRTTLogger -Device STM32F767ZI -If SWD -Speed 4000 -RTTChannel 4 rtt.bin
+      tools/rtt_capture.py rtt.bin -o capture.bin
+
+--hello and --start send CMD_HELLO and CMD_START_MEASUREMENT(interval_ms)
+down-channel 4 first; --stop sends CMD_STOP_MEASUREMENT when the capture
+ends (Ctrl-C or --seconds). -o writes every good packet as a little-endian
+u16 length followed by the packet (header + payload). The summary counts
+packets per command, CRC and framing errors, and gaps in the seqs of the
+notifications that share the STM32's notify counter: the channel drops a
+frame whole when the probe falls behind, and that is where it shows.
+Standard library only.
+"""
+
+import argparse
+import collections
+import socket
+import struct
+import sys
+import time
+
+HEADER = struct.Struct("<BBBBH")
+HEADER_SIZE = HEADER.size
+
+PACKET_TYPE_CMD = 0x01
+PACKET_TYPE_NOTIFY = 0x03
+PACKET_TYPE_MASK = 0x7F
+
+CMD_START_MEASUREMENT = 0x02
+CMD_STOP_MEASUREMENT = 0x03
+CMD_HELLO = 0x1B
+
+HOST_VERSION = 3
+HOST_MAX_PAYLOAD = 500
+HOST_FEATURES = 0xFFFFFFFF      # Take whatever the STM32 offers
+
+# Bulk and loopback frames carry their command's seq, not the notify counter
+COMMAND_SEQ_NOTIFY = range(0x81, 0x87)
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for byte in data:
+        if byte == 0:
+            out.append(len(block) + 1)
+            out += block
+            block.clear()
+            continue
+        block.append(byte)
+        if len(block) == 254:
+            out.append(255)
+            out += block
+            block.clear()
+    out.append(len(block) + 1)
+    out += block
+    return bytes(out)
+
+
+def cobs_decode(frame):
+    """Decoded bytes, or None if the frame is malformed."""
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame):
+            return None
+        out += frame[i + 1:i + code]
+        i += code
+        if code != 255 and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def frame_packet(packet):
+    crc = crc16_ccitt(packet)
+    return cobs_encode(packet + bytes([crc >> 8, crc & 0xFF])) + b"\0"
+
+
+def command(cmd_id, seq, payload=b""):
+    return frame_packet(HEADER.pack(PACKET_TYPE_CMD, cmd_id, seq, 0, len(payload)) + payload)
+
+
+class Capture:
+    """Splits the byte stream into frames and checks them."""
+
+    def __init__(self, out, verbose):
+        self.out = out
+        self.verbose = verbose
+        self.pending = bytearray()
+        self.bytes = 0
+        self.packets = collections.Counter()
+        self.crc_errors = 0
+        self.framing_errors = 0
+        self.seq_gaps = 0
+        self.notify_seq = None
+
+    def feed(self, data):
+        self.bytes += len(data)
+        self.pending += data
+        *frames, rest = self.pending.split(b"\0")
+        self.pending = bytearray(rest)
+        for frame in frames:
+            if frame:
+                self.frame(bytes(frame))
+
+    def frame(self, frame):
+        decoded = cobs_decode(frame)
+        if decoded is None or len(decoded) < HEADER_SIZE + 2:
+            self.framing_errors += 1
+            return
+        if crc16_ccitt(decoded) != 0:
+            self.crc_errors += 1
+            return
+        packet = decoded[:-2]
+        ptype, cmd_id, seq, status, length = HEADER.unpack_from(packet)
+        if length != len(packet) - HEADER_SIZE:
+            self.framing_errors += 1
+            return
+
+        self.packets[cmd_id] += 1
+        if (ptype & PACKET_TYPE_MASK) == PACKET_TYPE_NOTIFY and cmd_id not in COMMAND_SEQ_NOTIFY:
+            if self.notify_seq is not None and seq != (self.notify_seq + 1) & 0xFF:
+                self.seq_gaps += 1
+            self.notify_seq = seq
+        if self.verbose:
+            print(f"type=0x{ptype:02X} cmd=0x{cmd_id:02X} seq={seq} status={status} "
+                  f"len={length} {packet[HEADER_SIZE:HEADER_SIZE + 16].hex()}")
+        if self.out is not None:
+            self.out.write(struct.pack("<H", len(packet)) + packet)
+
+    def report(self, seconds):
+        total = sum(self.packets.values())
+        rate = f", {self.bytes / seconds / 1024:.1f} KB/s" if seconds > 0 else ""
+        print(f"{self.bytes} bytes, {total} packets{rate}", file=sys.stderr)
+        for cmd_id, count in sorted(self.packets.items()):
+            print(f"  0x{cmd_id:02X}: {count}", file=sys.stderr)
+        print(f"crc errors {self.crc_errors}, framing errors {self.framing_errors}, "
+              f"notify seq gaps {self.seq_gaps}", file=sys.stderr)
+
+
+def parse_endpoint(text):
+    host, _, port = text.rpartition(":")
+    return (host or "localhost", int(port))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", nargs="?", help="recorded up-channel bytes (JLinkRTTLogger)")
+    parser.add_argument("--tcp", metavar="HOST:PORT", help="RTT channel 4 server to connect to")
+    parser.add_argument("-o", "--output", help="write packets (u16 length + packet) here")
+    parser.add_argument("--hello", action="store_true", help="send CMD_HELLO first")
+    parser.add_argument("--start", type=int, metavar="MS", help="send CMD_START_MEASUREMENT")
+    parser.add_argument("--stop", action="store_true", help="send CMD_STOP_MEASUREMENT at the end")
+    parser.add_argument("--seconds", type=float, help="stop the live capture after this long")
+    parser.add_argument("-v", "--verbose", action="store_true", help="print every packet")
+    args = parser.parse_args()
+
+    if (args.input is None) == (args.tcp is None):
+        parser.error("give either a recorded file or --tcp")
+    if args.input is not None and (args.hello or args.start is not None or args.stop):
+        parser.error("commands need the --tcp connection")
+
+    out = open(args.output, "wb") if args.output else None
+    capture = Capture(out, args.verbose)
+    started = time.monotonic()
+
+    try:
+        if args.input is not None:
+            with open(args.input, "rb") as f:
+                while True:
+                    chunk = f.read(65536)
+                    if not chunk:
+                        break
+                    capture.feed(chunk)
+        else:
+            with socket.create_connection(parse_endpoint(args.tcp)) as sock:
+                seq = 0
+                if args.hello:
+                    sock.sendall(command(CMD_HELLO, seq, struct.pack(
+                        "<BHI", HOST_VERSION, HOST_MAX_PAYLOAD, HOST_FEATURES)))
+                    seq += 1
+                if args.start is not None:
+                    sock.sendall(command(CMD_START_MEASUREMENT, seq, struct.pack("<I", args.start)))
+                    seq += 1
+                sock.settimeout(0.5)
+                try:
+                    while args.seconds is None or time.monotonic() - started < args.seconds:
+                        try:
+                            chunk = sock.recv(65536)
+                        except socket.timeout:
+                            continue
+                        if not chunk:
+                            break
+                        capture.feed(chunk)
+                except KeyboardInterrupt:
+                    pass
+                if args.stop:
+                    sock.sendall(command(CMD_STOP_MEASUREMENT, seq))
+    finally:
+        if out is not None:
+            out.close()
+
+    capture.report(time.monotonic() - started if args.tcp else 0)
+    return 0 if capture.crc_errors == 0 and capture.framing_errors == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,282 @@
+#!/usr/bin/env python3
+"""Worst-case stack per task from GCC's -fstack-usage / -fcallgraph-info output.
+
+Configure with -DFIRMWARE_STACK_USAGE=ON; every object then gets a .su file
+(frame size per function) and a .ci file (call graph). The stack_report
+target runs this on the build directory:
+
+    cmake --build build/Debug --target stack_report
+
+or by hand, with the soak figures of perf_print_stack_recommendations()
+from a captured log next to the static ones:
+
+    tools/stack_report.py build/Debug
+    tools/stack_report.py build/Debug --elf build/Debug/stm32_development.elf --log soak.log
+    tools/stack_report.py build/Debug --task display=render_task --task current=periodic_task+current_monitor_process
+
+The worst case of a function is its frame plus the deepest of its callees.
+It is a lower bound ("+") when the path holds recursion, an indirect call,
+a dynamic frame or a function without stack figures (assembly, libraries
+built without -fstack-usage). Function pointers are the usual gap: give
+the targets of a task after "+" in --task (periodic tasks, event bus
+callbacks). Task figures add TASK_CONTEXT_BYTES for the exception frame
+and the context switch; interrupts run on the main stack and are listed
+apart.
+
+Soak lines ("stack <name>: size N, min free N, used N, recommend N, entry
+0x...") map tasks to entry functions through --elf; without it tasks are
+matched by TASK_ENTRIES. Standard library only.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Cortex-M7 with the FPU: hardware frame with FP state (26 words) plus the
+# registers the FreeRTOS port saves on PendSV (r4-r11, lr, s16-s31)
+TASK_CONTEXT_BYTES = 104 + 100
+
+MARGIN_PERCENT = 25     # As PERF_STACK_MARGIN_PERCENT
+MIN_SLACK_BYTES = 256   # As PERF_STACK_MIN_SLACK_BYTES
+ROUND_BYTES = 64
+
+# Task name -> entry function, then the functions it reaches through pointers
+TASK_ENTRIES = {
+    "defaultTask": ["StartDefaultTask"],
+    "IDLE": ["prvIdleTask"],
+    "Tmr Svc": ["prvTimerTask"],
+    "PerfMon": ["perf_monitor_task"],
+    "event_bus": ["event_dispatch_task"],
+    "event_bus_bg": ["event_dispatch_task"],
+    "uart_evt": ["uart_event_task"],
+    "stm32_rx": ["rx_task"],
+    "proto_cmd": ["command_task"],
+    "proto_events": ["forward_task"],
+    "proto_stream": ["stream_task"],
+    "display": ["render_task"],
+    "current": ["periodic_task", "current_monitor_process"],
+    "temperature": ["periodic_task", "temperature_sensor_run"],
+}
+
+NODE = re.compile(r'node:\s*\{\s*title:\s*"([^"]*)"\s*label:\s*"([^"]*)"')
+EDGE = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]*)"\s*targetname:\s*"([^"]*)"')
+FRAME = re.compile(r"(\d+) bytes \(([^)]*)\)")
+SU_LINE = re.compile(r"^(.*):(\d+):(\d+):(\S+)\t(\d+)\t(\S+)")
+SOAK = re.compile(r"stack (.+?): size (\d+), min free (\d+), used (\d+), recommend (\d+)"
+                  r"(?:, entry (0x[0-9a-fA-F]+))?")
+INDIRECT = "__indirect_call"
+
+
+def recommend(used):
+    slack = max(used * MARGIN_PERCENT // 100, MIN_SLACK_BYTES)
+    return (used + slack + ROUND_BYTES - 1) // ROUND_BYTES * ROUND_BYTES
+
+
+class CallGraph:
+    """Frames and call edges of all translation units of a build."""
+
+    def __init__(self):
+        self.frames = {}        # title -> (bytes, qualifier)
+        self.calls = {}         # title -> set of titles
+        self.names = {}         # plain name -> titles (static functions are file:name)
+
+    def add_frame(self, title, size, qualifier):
+        self.frames[title] = (size, qualifier)
+        self.names.setdefault(title.rsplit(":", 1)[-1], set()).add(title)
+
+    def load_ci(self, path):
+        with open(path, errors="replace") as f:
+            text = f.read()
+        for title, label in NODE.findall(text):
+            frame = FRAME.search(label)
+            if frame:
+                self.add_frame(title, int(frame.group(1)), frame.group(2))
+            self.calls.setdefault(title, set())
+        for source, target in EDGE.findall(text):
+            self.calls.setdefault(source, set()).add(target)
+
+    def load_su(self, path):
+        with open(path, errors="replace") as f:
+            for line in f:
+                match = SU_LINE.match(line)
+                if match:
+                    _, _, _, name, size, qualifier = match.groups()
+                    self.add_frame(name, int(size), qualifier)
+
+    def resolve(self, name):
+        """Title of a function given by plain name (the only one, or the global one)."""
+        if name in self.frames:
+            return name
+        titles = self.names.get(name, set())
+        return next(iter(titles)) if len(titles) == 1 else None
+
+    def worst(self, title, memo, active):
+        """(bytes, lower_bound, path) of the deepest call chain from title."""
+        if title in memo:
+            return memo[title]
+        if title == INDIRECT:
+            return 0, True, [INDIRECT]
+        if title in active:
+            return 0, True, [title + " (recursion)"]
+        frame = self.frames.get(title)
+        if frame is None:
+            return 0, True, [title + " (no figures)"]
+
+        size, qualifier = frame
+        lower = qualifier.startswith("dynamic") and "bounded" not in qualifier
+        active.add(title)
+        deepest = (0, False, [])
+        for callee in self.calls.get(title, ()):
+            result = self.worst(callee, memo, active)
+            lower = lower or result[1]
+            if result[0] > deepest[0] or (result[0] == deepest[0] and not deepest[2]):
+                deepest = result
+        active.discard(title)
+
+        result = (size + deepest[0], lower, [title] + deepest[2])
+        memo[title] = result
+        return result
+
+    def roots(self):
+        called = set()
+        for callees in self.calls.values():
+            called |= callees
+        return [title for title in self.frames if title not in called]
+
+
+def load(build_dir):
+    graph = CallGraph()
+    ci_files, su_files = [], []
+    for root, _, files in os.walk(build_dir):
+        for name in files:
+            if name.endswith(".ci"):
+                ci_files.append(os.path.join(root, name))
+            elif name.endswith(".su"):
+                su_files.append(os.path.join(root, name))
+    # The .ci labels carry the frames as well; .su alone gives no call graph
+    for path in sorted(ci_files) or sorted(su_files):
+        (graph.load_ci if ci_files else graph.load_su)(path)
+    return graph, bool(ci_files), len(ci_files or su_files)
+
+
+def parse_soak(path):
+    """Last soak line per task: name -> (size, min_free, used, recommend, entry)."""
+    tasks = {}
+    with open(path, errors="replace") as f:
+        for line in f:
+            match = SOAK.search(line)
+            if match:
+                name, size, min_free, used, rec, entry = match.groups()
+                tasks[name] = (int(size), int(min_free), int(used), int(rec),
+                               int(entry, 16) if entry else 0)
+    return tasks
+
+
+def entry_names(soak, elf):
+    """Entry function per soak task, from the ELF symbols."""
+    if not elf:
+        return {}
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    from pc_profile import Symbols
+    symbols = Symbols(elf)
+    names = {}
+    for task, (_, _, _, _, entry) in soak.items():
+        if entry:
+            name = symbols.function(entry)
+            if not name.startswith("0x"):
+                names[task] = [name]
+    return names
+
+
+def task_depth(graph, functions, memo):
+    """Entry worst case plus the worst of the functions it calls through pointers."""
+    total, lower, path = 0, False, []
+    for name in functions:
+        title = graph.resolve(name)
+        if title is None:
+            return None, True, [name + " (not found)"]
+        depth, bound, chain = graph.worst(title, memo, set())
+        total += depth
+        lower = lower or bound
+        path += chain if not path else ["->"] + chain
+    return total, lower, path
+
+
+def fmt(depth, lower):
+    return "?" if depth is None else "%d%s" % (depth, "+" if lower else "")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("build_dir", help="build directory holding the .ci / .su files")
+    parser.add_argument("--elf", help="firmware ELF, to map soak entry addresses to functions")
+    parser.add_argument("--log", help="log with perf_print_stack_recommendations() lines")
+    parser.add_argument("--task", action="append", default=[], metavar="NAME=FUNC[+FUNC]",
+                        help="entry function of a task, plus functions it calls through pointers")
+    parser.add_argument("--top", type=int, default=15, help="deepest roots and frames to list")
+    parser.add_argument("--paths", action="store_true", help="print the deepest call chain per task")
+    options = parser.parse_args()
+
+    graph, have_graph, files = load(options.build_dir)
+    if not files:
+        sys.exit("no .ci or .su files under %s (configure with -DFIRMWARE_STACK_USAGE=ON)"
+                 % options.build_dir)
+
+    soak = parse_soak(options.log) if options.log else {}
+    entries = dict(TASK_ENTRIES)
+    for task, functions in entry_names(soak, options.elf).items():
+        entries[task] = functions + entries.get(task, [])[1:]
+    explicit = set()
+    for spec in options.task:
+        task, _, functions = spec.partition("=")
+        entries[task] = functions.split("+")
+        explicit.add(task)
+
+    out = sys.stdout
+    memo = {}
+    out.write("%d files, %d functions%s\n\n" % (files, len(graph.frames),
+              "" if have_graph else " (no call graph: frames only)"))
+
+    if have_graph:
+        tasks = sorted(set(entries) | set(soak))
+        out.write("%-14s %7s %7s %8s %10s  %s\n"
+                  % ("task", "size", "soak", "static", "recommend", "entry"))
+        for task in tasks:
+            size, used, rec = "-", "-", None
+            if task in soak:
+                size, _, used_bytes, _, _ = soak[task]
+                used = str(used_bytes)
+                rec = recommend(used_bytes)
+            depth, lower, path = (None, True, [])
+            if task in entries:
+                depth, lower, path = task_depth(graph, entries[task], memo)
+            if depth is None and task not in soak and task not in explicit:
+                continue    # Default entry not in this build
+            if depth is not None:
+                depth += TASK_CONTEXT_BYTES
+                rec = max(rec or 0, recommend(depth))
+            out.write("%-14s %7s %7s %8s %10s  %s\n"
+                      % (task, size, used, fmt(depth, lower), rec if rec else "-",
+                         "+".join(entries.get(task, ["?"]))))
+            if options.paths and path:
+                out.write("%14s  %s\n" % ("", " > ".join(path)))
+        out.write("\nsoak: worst use seen on target; static: call graph worst case plus %d bytes "
+                  "of context;\n'+' marks a lower bound (recursion, pointers, unknown callees)\n\n"
+                  % TASK_CONTEXT_BYTES)
+
+        out.write("Deepest roots (tasks, interrupts on the main stack, unused functions):\n")
+        roots = [(graph.worst(title, memo, set()), title) for title in graph.roots()]
+        roots.sort(key=lambda item: -item[0][0])
+        for (depth, lower, _), title in roots[:options.top]:
+            out.write("%8s  %s\n" % (fmt(depth, lower), title))
+        out.write("\n")
+
+    out.write("Largest frames:\n")
+    frames = sorted(graph.frames.items(), key=lambda item: -item[1][0])
+    for title, (size, qualifier) in frames[:options.top]:
+        out.write("%8d  %-40s %s\n" % (size, title, qualifier))
+
+
+if __name__ == "__main__":
+    main()